@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+
+namespace Microsoft.ML.OnnxRuntime
+{
+    /// <summary>
+    /// A list of input or output names converted once to zero terminated UTF-8 in native memory,
+    /// so that InferenceSession.Run() overloads taking it do not convert and pin the names on every call.
+    /// Create it once per set of names and reuse it for all the runs. The instance must be disposed of
+    /// to release the native memory.
+    /// </summary>
+    public class EncodedNames : SafeHandle
+    {
+        private readonly IntPtr[] _pointers;
+
+        /// <summary>
+        /// Encodes the names
+        /// </summary>
+        /// <param name="names">input or output names of the model</param>
+        public EncodedNames(IReadOnlyList<string> names)
+            : base(IntPtr.Zero, true)
+        {
+            var encoded = new byte[names.Count][];
+            int totalLength = 0;
+            for (int i = 0; i < names.Count; ++i)
+            {
+                encoded[i] = NativeOnnxValueHelper.StringToZeroTerminatedUtf8(names[i]);
+                totalLength += encoded[i].Length;
+            }
+
+            // a single allocation holds all the names
+            handle = Marshal.AllocHGlobal(Math.Max(totalLength, 1));
+            _pointers = new IntPtr[names.Count];
+            int offset = 0;
+            for (int i = 0; i < names.Count; ++i)
+            {
+                _pointers[i] = IntPtr.Add(handle, offset);
+                Marshal.Copy(encoded[i], 0, _pointers[i], encoded[i].Length);
+                offset += encoded[i].Length;
+            }
+
+            Names = new List<string>(names);
+        }
+
+        /// <summary>
+        /// The names in the order they were encoded
+        /// </summary>
+        public IReadOnlyList<string> Names { get; private set; }
+
+        /// <summary>
+        /// The number of names
+        /// </summary>
+        public int Count { get { return _pointers.Length; } }
+
+        /// <summary>
+        /// Pointers to the zero terminated UTF-8 names, valid until the instance is disposed of
+        /// </summary>
+        internal IntPtr[] Pointers { get { return _pointers; } }
+
+        /// <summary>
+        /// Overrides SafeHandle.IsInvalid
+        /// </summary>
+        /// <value>returns true if handle is equal to Zero</value>
+        public override bool IsInvalid { get { return handle == IntPtr.Zero; } }
+
+        #region SafeHandle
+        /// <summary>
+        /// Overrides SafeHandle.ReleaseHandle() to free the native memory of the names
+        /// </summary>
+        /// <returns>always returns true</returns>
+        protected override bool ReleaseHandle()
+        {
+            Marshal.FreeHGlobal(handle);
+            handle = IntPtr.Zero;
+            return true;
+        }
+        #endregion
+    }
+}
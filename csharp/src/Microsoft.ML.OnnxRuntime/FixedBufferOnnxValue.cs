@@ -14,7 +14,11 @@ namespace Microsoft.ML.OnnxRuntime
     {
         private bool _disposed = false;
         internal MemoryHandle PinnedMemory { get; private set; }
-        internal OrtValue Value { get; private set; }
+        /// <summary>
+        /// The OrtValue on top of the pinned buffer, e.g. to pass to the InferenceSession.Run() overloads taking OrtValues.
+        /// It is owned by this instance.
+        /// </summary>
+        public OrtValue Value { get; private set; }
         internal OnnxValueType OnnxValueType { get; private set; }
         internal TensorElementType ElementType { get; private set; }
 
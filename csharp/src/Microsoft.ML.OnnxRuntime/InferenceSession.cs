@@ -6,6 +6,7 @@ using System.Runtime.InteropServices;
 using System.Collections.Generic;
 using System.IO;
 using System.Linq;
+using System.Threading.Tasks;
 using Microsoft.ML.OnnxRuntime.Tensors;
 using System.Buffers;
 
@@ -154,6 +155,59 @@ namespace Microsoft.ML.OnnxRuntime
             }
         }
 
+        /// <summary>
+        /// Runs the loaded model for the given inputs without blocking the calling thread, and fetches all the outputs.
+        /// </summary>
+        /// <param name="inputs">Specify a collection of <see cref="NamedOnnxValue"/> that indicates the input values.</param>
+        /// <returns>A task that completes with the output Tensors in a Collection of NamedOnnxValue. User must dispose the output.</returns>
+        public Task<IDisposableReadOnlyCollection<DisposableNamedOnnxValue>> RunAsync(IReadOnlyCollection<NamedOnnxValue> inputs)
+        {
+            string[] outputNames = new string[_outputMetadata.Count];
+            _outputMetadata.Keys.CopyTo(outputNames, 0);
+            return RunAsync(inputs, outputNames, _builtInRunOptions);
+        }
+
+        /// <summary>
+        /// Runs the loaded model for the given inputs without blocking the calling thread, and fetches the outputs
+        /// specified in <paramref name="outputNames"/>. The run is executed on the intra-op thread pool of the session,
+        /// which must have at least 2 threads (see <see cref="SessionOptions.IntraOpNumThreads"/>).
+        /// The inputs must not be modified until the returned task completes.
+        /// </summary>
+        /// <param name="inputs">Specify a collection of <see cref="NamedOnnxValue"/> that indicates the input values.</param>
+        /// <param name="outputNames">Specify a collection of string that indicates the output names to fetch.</param>
+        /// <param name="options">Must not be disposed until the returned task completes. Can be used to terminate the run.</param>
+        /// <returns>A task that completes with the output Tensors in a Collection of NamedOnnxValue. User must dispose the output.</returns>
+        public Task<IDisposableReadOnlyCollection<DisposableNamedOnnxValue>> RunAsync(IReadOnlyCollection<NamedOnnxValue> inputs, IReadOnlyCollection<string> outputNames, RunOptions options)
+        {
+            var state = new RunAsyncState(this, options, outputNames);
+            try
+            {
+                var inputNamesArray = ConvertNamesToUtf8(inputs, v => v.Name, state.CleanupList);
+                var inputValuesArray = GetOrtValuesHandles(inputs, state.CleanupList);
+                var outputNamesArray = ConvertNamesToUtf8(outputNames, n => n, state.CleanupList);
+
+                NativeApiStatus.VerifySuccess(NativeMethods.OrtRunAsync(
+                                                    _nativeHandle,
+                                                    options.Handle,
+                                                    inputNamesArray,
+                                                    inputValuesArray,
+                                                    (UIntPtr)inputNamesArray.Length,
+                                                    outputNamesArray,
+                                                    (UIntPtr)outputNamesArray.Length,
+                                                    state.OutputValues,
+                                                    _runAsyncCallback,
+                                                    state.UserData
+                                                    ));
+            }
+            catch
+            {
+                // the callback is not invoked if the run could not be scheduled
+                state.Dispose();
+                throw;
+            }
+            return state.Task;
+        }
+
         /// <summary>
         /// Runs the loaded model for the given inputs, and fetches all the outputs.
         /// </summary>
@@ -451,6 +505,87 @@ namespace Microsoft.ML.OnnxRuntime
             }
         }
 
+        /// <summary>
+        /// Runs the loaded model for the given inputs and outputs without converting the names
+        /// or allocating managed objects per call.
+        ///
+        /// Outputs need to be created with correct type and dimension to receive the fetched data,
+        /// e.g. with <see cref="FixedBufferOnnxValue.CreateFromMemory{T}"/> on top of a caller provided Memory{T}.
+        /// </summary>
+        /// <param name="inputNames">Specify the <see cref="EncodedNames"/> of the inputs. Should match <paramref name="inputValues"/>.</param>
+        /// <param name="inputValues">Specify the input values.</param>
+        /// <param name="outputNames">Specify the <see cref="EncodedNames"/> of the outputs. Should match <paramref name="outputValues"/>.</param>
+        /// <param name="outputValues">Specify the pre-allocated output values the run writes into.</param>
+        public void Run(
+            EncodedNames inputNames,
+            ReadOnlySpan<OrtValue> inputValues,
+            EncodedNames outputNames,
+            ReadOnlySpan<OrtValue> outputValues)
+        {
+            Run(inputNames, inputValues, outputNames, outputValues, _builtInRunOptions);
+        }
+
+        /// <summary>
+        /// Runs the loaded model for the given inputs and outputs without converting the names
+        /// or allocating managed objects per call. Uses the given RunOptions for this run.
+        ///
+        /// Outputs need to be created with correct type and dimension to receive the fetched data,
+        /// e.g. with <see cref="FixedBufferOnnxValue.CreateFromMemory{T}"/> on top of a caller provided Memory{T}.
+        /// </summary>
+        /// <param name="inputNames">Specify the <see cref="EncodedNames"/> of the inputs. Should match <paramref name="inputValues"/>.</param>
+        /// <param name="inputValues">Specify the input values.</param>
+        /// <param name="outputNames">Specify the <see cref="EncodedNames"/> of the outputs. Should match <paramref name="outputValues"/>.</param>
+        /// <param name="outputValues">Specify the pre-allocated output values the run writes into.</param>
+        /// <param name="options"></param>
+        public void Run(
+            EncodedNames inputNames,
+            ReadOnlySpan<OrtValue> inputValues,
+            EncodedNames outputNames,
+            ReadOnlySpan<OrtValue> outputValues,
+            RunOptions options)
+        {
+            if (inputNames.Count != inputValues.Length)
+            {
+                throw new ArgumentException($"Length of {nameof(inputNames)} ({inputNames.Count}) must match that of {nameof(inputValues)} ({inputValues.Length}).");
+            }
+            if (outputNames.Count != outputValues.Length)
+            {
+                throw new ArgumentException($"Length of {nameof(outputNames)} ({outputNames.Count}) must match that of {nameof(outputValues)} ({outputValues.Length}).");
+            }
+
+            // the native call only reads the first Count entries of the pooled arrays
+            var pool = ArrayPool<IntPtr>.Shared;
+            IntPtr[] inputValuesArray = pool.Rent(Math.Max(inputValues.Length, 1));
+            IntPtr[] outputValuesArray = pool.Rent(Math.Max(outputValues.Length, 1));
+            try
+            {
+                for (int i = 0; i < inputValues.Length; ++i)
+                {
+                    inputValuesArray[i] = inputValues[i].Handle;
+                }
+                for (int i = 0; i < outputValues.Length; ++i)
+                {
+                    outputValuesArray[i] = outputValues[i].Handle;
+                }
+
+                NativeApiStatus.VerifySuccess(NativeMethods.OrtRun(
+                                                    _nativeHandle,
+                                                    options.Handle,
+                                                    inputNames.Pointers,
+                                                    inputValuesArray,
+                                                    (UIntPtr)inputValues.Length,
+                                                    outputNames.Pointers,
+                                                    (UIntPtr)outputValues.Length,
+                                                    outputValuesArray /* pointers to Pre-allocated OrtValue instances */
+                                                    ));
+            }
+            finally
+            {
+                pool.Return(inputValuesArray);
+                pool.Return(outputValuesArray);
+            }
+        }
+
         /// <summary>
         /// Create OrtIoBinding instance to bind pre-allocated buffers
         /// to input/output
@@ -634,6 +769,99 @@ namespace Microsoft.ML.OnnxRuntime
             return ortValues;
         }
 
+        /// <summary>
+        /// State of a RunAsync call that must stay alive until the native callback is invoked
+        /// </summary>
+        private class RunAsyncState : IDisposable
+        {
+            private readonly InferenceSession _session;
+            private readonly RunOptions _options;
+            private readonly IReadOnlyCollection<string> _outputNames;
+            private readonly IntPtr[] _outputValues;
+            private GCHandle _outputValuesHandle;
+            private GCHandle _handle;
+            private readonly TaskCompletionSource<IDisposableReadOnlyCollection<DisposableNamedOnnxValue>> _completion =
+                new TaskCompletionSource<IDisposableReadOnlyCollection<DisposableNamedOnnxValue>>();
+
+            public RunAsyncState(InferenceSession session, RunOptions options, IReadOnlyCollection<string> outputNames)
+            {
+                _session = session;
+                _options = options;
+                _outputNames = outputNames;
+                // Empty array is passed in to receive output OrtValue pointers. It is written to after OrtRunAsync returns.
+                _outputValues = new IntPtr[outputNames.Count];
+                _outputValuesHandle = GCHandle.Alloc(_outputValues, GCHandleType.Pinned);
+                CleanupList = new DisposableList<IDisposable>();
+                _handle = GCHandle.Alloc(this);
+            }
+
+            public DisposableList<IDisposable> CleanupList { get; }
+            public IntPtr UserData { get { return GCHandle.ToIntPtr(_handle); } }
+            public IntPtr OutputValues { get { return _outputValuesHandle.AddrOfPinnedObject(); } }
+            public Task<IDisposableReadOnlyCollection<DisposableNamedOnnxValue>> Task { get { return _completion.Task; } }
+
+            public void Complete(IntPtr status)
+            {
+                IDisposableReadOnlyCollection<DisposableNamedOnnxValue> result = null;
+                Exception error = null;
+                try
+                {
+                    NativeApiStatus.VerifySuccess(status);
+                    var ortValues = new DisposableList<OrtValue>(_outputValues.Length);
+                    CleanupList.Add(ortValues);
+                    foreach (var v in _outputValues)
+                    {
+                        ortValues.Add(new OrtValue(v));
+                    }
+                    result = _session.CreateDisposableResult(ortValues, _outputNames);
+                }
+                catch (Exception e)
+                {
+                    error = e;
+                }
+                finally
+                {
+                    Dispose();
+                }
+
+                // complete the task on a thread pool thread so continuations don't run on the onnxruntime thread
+                System.Threading.Tasks.Task.Run(() =>
+                {
+                    if (error != null)
+                    {
+                        _completion.SetException(error);
+                    }
+                    else
+                    {
+                        _completion.SetResult(result);
+                    }
+                });
+            }
+
+            public void Dispose()
+            {
+                CleanupList.Dispose();
+                if (_outputValuesHandle.IsAllocated)
+                {
+                    _outputValuesHandle.Free();
+                }
+                if (_handle.IsAllocated)
+                {
+                    _handle.Free();
+                }
+                GC.KeepAlive(_options);
+            }
+        }
+
+        private static void RunAsyncCallback(IntPtr userData, IntPtr outputValues, UIntPtr outputCount, IntPtr status)
+        {
+            var state = (RunAsyncState)GCHandle.FromIntPtr(userData).Target;
+            state.Complete(status);
+        }
+
+        // kept in a static field so the delegate is not collected while native code holds a pointer to it
+        private static readonly NativeMethods.DOrtRunAsyncCallback _runAsyncCallback = RunAsyncCallback;
+
         IDisposableReadOnlyCollection<DisposableNamedOnnxValue> CreateDisposableResult(List<OrtValue> ortValues,
             IReadOnlyCollection<string> outputNames)
         {
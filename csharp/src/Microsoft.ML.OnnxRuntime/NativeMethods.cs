@@ -189,6 +189,8 @@ namespace Microsoft.ML.OnnxRuntime
         public IntPtr CreateArenaCfg;
         public IntPtr ReleaseArenaCfg;
         public IntPtr ModelMetadataGetGraphDescription;
+        public IntPtr CreateArenaCfgV2;
+        public IntPtr RunAsync;
     }
 
     internal static class NativeMethods
@@ -219,6 +221,7 @@ namespace Microsoft.ML.OnnxRuntime
             OrtCreateSession = (DOrtCreateSession)Marshal.GetDelegateForFunctionPointer(api_.CreateSession, typeof(DOrtCreateSession));
             OrtCreateSessionFromArray = (DOrtCreateSessionFromArray)Marshal.GetDelegateForFunctionPointer(api_.CreateSessionFromArray, typeof(DOrtCreateSessionFromArray));
             OrtRun = (DOrtRun)Marshal.GetDelegateForFunctionPointer(api_.Run, typeof(DOrtRun));
+            OrtRunAsync = (DOrtRunAsync)Marshal.GetDelegateForFunctionPointer(api_.RunAsync, typeof(DOrtRunAsync));
             OrtRunWithBinding = (DOrtRunWithBinding)Marshal.GetDelegateForFunctionPointer(api_.RunWithBinding, typeof(DOrtRunWithBinding));
             OrtSessionGetInputCount = (DOrtSessionGetInputCount)Marshal.GetDelegateForFunctionPointer(api_.SessionGetInputCount, typeof(DOrtSessionGetInputCount));
             OrtSessionGetOutputCount = (DOrtSessionGetOutputCount)Marshal.GetDelegateForFunctionPointer(api_.SessionGetOutputCount, typeof(DOrtSessionGetOutputCount));
@@ -400,6 +403,30 @@ namespace Microsoft.ML.OnnxRuntime
                                                 );
         public static DOrtRun OrtRun;
 
+        /// <summary>
+        /// Invoked by OrtRunAsync when the run completes. status is IntPtr.Zero on success,
+        /// otherwise it must be released by the callback.
+        /// </summary>
+        public delegate void DOrtRunAsyncCallback(
+                                                IntPtr /* (void*) */ userData,
+                                                IntPtr /* (OrtValue**) */ outputValues,
+                                                UIntPtr outputCount,
+                                                IntPtr /* (OrtStatus*) */ status);
+
+        public delegate IntPtr /*(ONNStatus*)*/ DOrtRunAsync(
+                                                IntPtr /*(OrtSession*)*/ session,
+                                                IntPtr /*(OrtSessionRunOptions*)*/ runOptions,  // can be null to use the default options
+                                                IntPtr[] inputNames,
+                                                IntPtr[] /* (OrtValue*[])*/ inputValues,
+                                                UIntPtr inputCount,
+                                                IntPtr[] outputNames,
+                                                UIntPtr outputCount,
+                                                IntPtr /* (OrtValue**) */ outputValues, /* Pinned array that must stay valid until the callback is invoked */
+                                                DOrtRunAsyncCallback callback,
+                                                IntPtr /* (void*) */ userData
+                                                );
+        public static DOrtRunAsync OrtRunAsync;
+
         public delegate IntPtr /*(ONNStatus*)*/ DOrtRunWithBinding(
                                                 IntPtr /*(OrtSession*)*/ session,
                                                 IntPtr /*(OrtSessionRunOptions*)*/ runOptions, // can not be null
@@ -29,6 +29,8 @@ namespace Microsoft.ML.OnnxRuntime
     {
         ORT_SEQUENTIAL = 0,
         ORT_PARALLEL = 1,
+        ORT_PARALLEL_WORK_STEALING = 2,
+        ORT_PARALLEL_HETEROGENEOUS = 3,
     }
 
     /// <summary>
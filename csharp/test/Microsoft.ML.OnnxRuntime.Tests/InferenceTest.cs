@@ -331,6 +331,22 @@ namespace Microsoft.ML.OnnxRuntime.Tests
 
                     session.Run(inputNames, pinnedInputs, outputNames, pinnedOutputs);
                     Assert.Equal(expectedOutput, outputBuffer, new floatComparer());
+
+                    // Run again with pre-encoded names and spans of the values, reusing the output buffer
+                    using (var encodedInputNames = new EncodedNames(inputNames))
+                    using (var encodedOutputNames = new EncodedNames(outputNames))
+                    {
+                        var inputValues = pinnedInputs.Select(v => v.Value).ToArray();
+                        var outputValues = pinnedOutputs.Select(v => v.Value).ToArray();
+                        for (int i = 0; i < 2; ++i)
+                        {
+                            Array.Clear(outputBuffer, 0, outputBuffer.Length);
+                            session.Run(encodedInputNames, inputValues, encodedOutputNames, outputValues);
+                            Assert.Equal(expectedOutput, outputBuffer, new floatComparer());
+                        }
+
+                        Assert.Throws<ArgumentException>(() => session.Run(encodedInputNames, new OrtValue[0], encodedOutputNames, outputValues));
+                    }
                 }
 
                 // Run inference with named inputs and named outputs
@@ -428,6 +444,45 @@ namespace Microsoft.ML.OnnxRuntime.Tests
 
         }
 
+        [Fact]
+        public async Task CanRunInferenceAsync()
+        {
+            string modelPath = Path.Combine(Directory.GetCurrentDirectory(), "squeezenet.onnx");
+
+            using (var options = new SessionOptions())
+            {
+                // RunAsync requires an intra-op thread pool with at least 2 threads
+                options.IntraOpNumThreads = 2;
+                using (var session = new InferenceSession(modelPath, options))
+                {
+                    var inputMeta = session.InputMetadata;
+                    var container = new List<NamedOnnxValue>();
+
+                    float[] inputData = LoadTensorFromFile(@"bench.in"); // this is the data for only one input tensor for this model
+
+                    foreach (var name in inputMeta.Keys)
+                    {
+                        var tensor = new DenseTensor<float>(inputData, inputMeta[name].Dimensions);
+                        container.Add(NamedOnnxValue.CreateFromTensor<float>(name, tensor));
+                    }
+
+                    var tasks = new[] { session.RunAsync(container), session.RunAsync(container) };
+                    foreach (var task in tasks)
+                    {
+                        using (var results = await task)
+                        {
+                            validateRunResults(results);
+                        }
+                    }
+
+                    // errors during the run fault the task
+                    var ex = await Assert.ThrowsAsync<OnnxRuntimeException>(
+                        () => session.RunAsync(container, new[] { "invalid" }, new RunOptions()));
+                    Assert.Contains("Invalid Output Name", ex.Message);
+                }
+            }
+        }
+
         [Fact]
         public void InferenceSessionGetProfilingStartTimeNs()
         {
@@ -55,6 +55,7 @@ namespace profiling {
 enum EventCategory {
   SESSION_EVENT = 0,
   NODE_EVENT,
+  MEMORY_EVENT,
   EVENT_CATEGORY_MAX
 };
 
@@ -63,7 +64,8 @@ Event descriptions for the above session events.
 */
 static constexpr const char* event_categor_names_[EVENT_CATEGORY_MAX] = {
     "Session",
-    "Node"};
+    "Node",
+    "Memory"};
 
 /*
 Timing record for all events.
@@ -89,6 +91,8 @@ struct EventRecord {
   long long ts;
   long long dur;
   std::unordered_map<std::string, std::string> args;
+  // the phase in the chrome tracing format. 'X' for a complete event, 'C' for a counter event whose args are numbers.
+  char phase = 'X';
 };
 }  // namespace profiling
 
@@ -258,13 +262,13 @@ class Logger {
      Get the minimum severity level for log messages to be output.
      @returns The severity.
   */
-  Severity GetSeverity() const noexcept { return min_severity_; }
+  Severity GetSeverity() const noexcept { return min_severity_.load(std::memory_order_relaxed); }
 
   /**
      Change the minimum severity level for log messages to be output.
      @param severity The severity.
   */
-  void SetSeverity(Severity severity) noexcept { min_severity_ = severity; }
+  void SetSeverity(Severity severity) noexcept { min_severity_.store(severity, std::memory_order_relaxed); }
 
   /**
      Check if output is enabled for the provided LogSeverity and DataType values.
@@ -273,7 +277,8 @@ class Logger {
      @returns True if a message with these values will be logged.
   */
   bool OutputIsEnabled(Severity severity, DataType data_type) const noexcept {
-    return (severity >= min_severity_ && (data_type != DataType::USER || !filter_user_data_));
+    return (severity >= min_severity_.load(std::memory_order_relaxed) &&
+            (data_type != DataType::USER || !filter_user_data_));
   }
 
   /**
@@ -302,7 +307,8 @@ class Logger {
  private:
   const LoggingManager* logging_manager_;
   const std::string id_;
-  Severity min_severity_;
+  // atomic as the severity can be changed while other threads log. a relaxed load is as cheap as a plain one.
+  std::atomic<Severity> min_severity_;
   const bool filter_user_data_;
   const int max_vlog_level_;
 };
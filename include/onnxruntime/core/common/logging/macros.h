@@ -7,6 +7,11 @@
 #define CREATE_MESSAGE(logger, severity, category, datatype)            \
   ::onnxruntime::logging::Capture(logger, ::onnxruntime::logging::Severity::k##severity, category, datatype, ORT_WHERE)
 
+// A compile time constant, so that the check of the logger and the message are removed for a severity that is below
+// ORT_MINIMUM_LOG_SEVERITY. The logger expression isn't evaluated in that case either.
+#define LOG_SEVERITY_COMPILED_IN(severity) \
+  (::onnxruntime::logging::Severity::k##severity >= ::onnxruntime::logging::kMinimumCompiledSeverity)
+
 /*
   Both printf and stream style logging are supported.
   Not that printf currently has a 2K limit to the message size.
@@ -47,20 +52,20 @@
 
 // iostream style logging. Capture log info in Message, and push to the logger in ~Message.
 #define LOGS_CATEGORY(logger, severity, category)                       \
-  if ((logger).OutputIsEnabled(::onnxruntime::logging::Severity::k##severity, ::onnxruntime::logging::DataType::SYSTEM)) \
+  if (LOG_SEVERITY_COMPILED_IN(severity) && (logger).OutputIsEnabled(::onnxruntime::logging::Severity::k##severity, ::onnxruntime::logging::DataType::SYSTEM)) \
     CREATE_MESSAGE(logger, severity, category, ::onnxruntime::logging::DataType::SYSTEM).Stream()
 
 #define LOGS_USER_CATEGORY(logger, severity, category)                  \
-    if ((logger).OutputIsEnabled(::onnxruntime::logging::Severity::k##severity, ::onnxruntime::logging::DataType::USER)) \
+    if (LOG_SEVERITY_COMPILED_IN(severity) && (logger).OutputIsEnabled(::onnxruntime::logging::Severity::k##severity, ::onnxruntime::logging::DataType::USER)) \
       CREATE_MESSAGE(logger, severity, category, ::onnxruntime::logging::DataType::USER).Stream()
 
     // printf style logging. Capture log info in Message, and push to the logger in ~Message.
 #define LOGF_CATEGORY(logger, severity, category, format_str, ...)      \
-    if ((logger).OutputIsEnabled(::onnxruntime::logging::Severity::k##severity, ::onnxruntime::logging::DataType::SYSTEM)) \
+    if (LOG_SEVERITY_COMPILED_IN(severity) && (logger).OutputIsEnabled(::onnxruntime::logging::Severity::k##severity, ::onnxruntime::logging::DataType::SYSTEM)) \
       CREATE_MESSAGE(logger, severity, category, ::onnxruntime::logging::DataType::SYSTEM).CapturePrintf(format_str, ##__VA_ARGS__)
 
 #define LOGF_USER_CATEGORY(logger, severity, category, format_str, ...) \
-    if ((logger).OutputIsEnabled(::onnxruntime::logging::Severity::k##severity, ::onnxruntime::logging::DataType::USER)) \
+    if (LOG_SEVERITY_COMPILED_IN(severity) && (logger).OutputIsEnabled(::onnxruntime::logging::Severity::k##severity, ::onnxruntime::logging::DataType::USER)) \
       CREATE_MESSAGE(logger, severity, category, ::onnxruntime::logging::DataType::USER).CapturePrintf(format_str, ##__VA_ARGS__)
 
     // Logging with category of "onnxruntime"
@@ -180,19 +185,19 @@
   Use the _USER variants for VLOG statements involving user data that may need to be filtered.
 */
 #define VLOGS(logger, level)                                            \
-  if (::onnxruntime::logging::vlog_enabled && level <= (logger).VLOGMaxLevel()) \
+  if (::onnxruntime::logging::vlog_enabled && LOG_SEVERITY_COMPILED_IN(VERBOSE) && level <= (logger).VLOGMaxLevel()) \
     LOGS_CATEGORY(logger, VERBOSE, "VLOG" #level)
 
 #define VLOGS_USER(logger, level)                                       \
-  if (::onnxruntime::logging::vlog_enabled && level <= (logger).VLOGMaxLevel()) \
+  if (::onnxruntime::logging::vlog_enabled && LOG_SEVERITY_COMPILED_IN(VERBOSE) && level <= (logger).VLOGMaxLevel()) \
     LOGS_USER_CATEGORY(logger, VERBOSE, "VLOG" #level)
 
 #define VLOGF(logger, level, format_str, ...)                           \
-  if (::onnxruntime::logging::vlog_enabled && level <= (logger).VLOGMaxLevel()) \
+  if (::onnxruntime::logging::vlog_enabled && LOG_SEVERITY_COMPILED_IN(VERBOSE) && level <= (logger).VLOGMaxLevel()) \
     LOGF_CATEGORY(logger, VERBOSE, "VLOG" #level, format_str, ##__VA_ARGS__)
 
 #define VLOGF_USER(logger, level, format_str, ...)                      \
-    if (::onnxruntime::logging::vlog_enabled && level <= (logger).VLOGMaxLevel()) \
+    if (::onnxruntime::logging::vlog_enabled && LOG_SEVERITY_COMPILED_IN(VERBOSE) && level <= (logger).VLOGMaxLevel()) \
       LOGF_USER_CATEGORY(logger, VERBOSE, "VLOG" #level, format_str, ##__VA_ARGS__)
 
     // Default logger variants
@@ -18,5 +18,17 @@ enum class Severity {
 
 constexpr const char* SEVERITY_PREFIX = "VIWEF";
 
+// Messages with a lower severity than this are compiled out of the logging macros, so that they cost nothing in
+// builds that never output them. Set with the onnxruntime_MINIMUM_LOG_SEVERITY CMake option. The default keeps all
+// messages, leaving the filtering to the severity of the logger.
+#ifndef ORT_MINIMUM_LOG_SEVERITY
+#define ORT_MINIMUM_LOG_SEVERITY 0
+#endif
+
+static_assert(ORT_MINIMUM_LOG_SEVERITY >= 0 && ORT_MINIMUM_LOG_SEVERITY <= 3,
+              "ORT_MINIMUM_LOG_SEVERITY must be between 0 (VERBOSE) and 3 (ERROR)");
+
+constexpr Severity kMinimumCompiledSeverity = static_cast<Severity>(ORT_MINIMUM_LOG_SEVERITY);
+
 }  // namespace logging
 }  // namespace onnxruntime
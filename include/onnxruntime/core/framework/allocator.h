@@ -16,6 +16,8 @@ struct OrtArenaCfg {
   int arena_extend_strategy;     // use -1 to allow ORT to choose the default, 0 = kNextPowerOfTwo, 1 = kSameAsRequested
   int initial_chunk_size_bytes;  // use -1 to allow ORT to choose the default
   int max_dead_bytes_per_chunk;  // use -1 to allow ORT to choose the default
+  size_t max_thread_cache_bytes;  // per-thread cache of small free chunks. use 0 to disable (default)
+  int arena_type;                 // use -1 to allow ORT to choose the default, 0 = BFC arena, 1 = mimalloc arena
 };
 
 namespace onnxruntime {
@@ -69,6 +69,14 @@ class KernelDef {
     return variadic_alias_offsets_;
   }
 
+  const std::vector<std::pair<int, int>>& MayOutputView() const {
+    return view_map_;
+  }
+
+  const optional<std::pair<int, int>>& VariadicMayOutputView() const {
+    return variadic_view_offsets_;
+  }
+
   OrtMemType InputMemoryType(size_t input_index) const {
     auto it = input_memory_type_args_.find(input_index);
     if (it == input_memory_type_args_.end())
@@ -140,6 +148,13 @@ class KernelDef {
   // output 'i + output_offset' is an alias of input 'i + input_offset' for all i >= 0
   optional<std::pair<int, int>> variadic_alias_offsets_;
 
+  // An element <i, j> means that output j may be created as a view of (a contiguous block of) input i.
+  std::vector<std::pair<int, int>> view_map_;
+
+  // This variable stores <input_index, output_offset> for the variadic view mapping
+  // output 'i + output_offset' may be a view of input 'input_index' for all i >= 0
+  optional<std::pair<int, int>> variadic_view_offsets_;
+
   // Require input tensors to be allocated contiguously.
   bool allocate_inputs_contiguously_ = false;
 
@@ -235,6 +250,21 @@ class KernelDefBuilder {
   */
   KernelDefBuilder& VariadicAlias(int input_offset, int output_offset);
 
+  /**
+     Outputs that may be created as a view of an input, i.e. a contiguous block of the input's buffer
+     starting at some offset, instead of a copy. Different from Alias that the decision is made by the
+     kernel at execution time (see OpKernelContext::OutputView) and that the kernel materializes the
+     output in its own buffer whenever a view isn't possible. This is to take care of operators
+     such as Slice and Split.
+  */
+  KernelDefBuilder& MayOutputView(int input_index, int output_index);
+
+  /**
+     Apply variadic number of view mapping from an input to outputs.
+     This is effectively applying MayOutputView(input_index, i + output_offset) for i >= 0
+  */
+  KernelDefBuilder& VariadicMayOutputView(int input_index, int output_offset);
+
   /**
      Specify that this kernel requires input tensors to be allocated
      contiguously. This allows kernels to execute as a single large
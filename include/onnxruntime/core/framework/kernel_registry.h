@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <vector>
+
 #include "core/framework/op_kernel.h"
 
 namespace onnxruntime {
@@ -59,6 +62,9 @@ class KernelRegistry {
 #endif
 
  private:
+  // the lookup index points to the kernels in kernel_creator_fn_map_
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(KernelRegistry);
+
 #if !defined(ORT_MINIMAL_BUILD)
   // Check whether the types of inputs/outputs of the given node match the extra
   // type-constraints of the given kernel. This serves two purposes: first, to
@@ -74,11 +80,35 @@ class KernelRegistry {
   // if this function is called before graph partition, then node.provider is not set.
   // In this case, kernel_def.provider must equal to exec_provider
   // otherwise, kernel_def.provider must equal to node.provider. exec_provider is ignored.
+  //
+  // error_str is only set if it is not null, so that checking kernels that don't match a node doesn't need the cost
+  // of formatting a message unless no kernel matches.
+  struct KernelLookupEntry;
   static bool VerifyKernelDef(const onnxruntime::Node& node,
-                              const KernelDef& kernel_def,
-                              std::string& error_str);
+                              const KernelLookupEntry& entry,
+                              std::string* error_str);
+
+  // A type constraint of a kernel, with the bitset of the allowed tensor element types
+  // (bit i is set if ONNX TensorProto::DataType i is allowed) if all the allowed types are tensors,
+  // so that checking the type of a node is a bit test instead of a comparison with each allowed type.
+  struct TypeConstraintLookup {
+    const std::string* name;
+    const std::vector<MLDataType>* allowed_types;
+    bool tensor_types_only;
+    uint64_t tensor_element_types;
+  };
 #endif
 
+  // A registered kernel with the values precomputed at registration to match it with a node.
+  struct KernelLookupEntry {
+    const KernelCreateInfo* create_info;
+#if !defined(ORT_MINIMAL_BUILD)
+    std::vector<TypeConstraintLookup> type_constraints;
+#endif
+  };
+
+  void AddToLookupIndex(const std::string& key, const KernelCreateInfo& create_info);
+
   static std::string GetMapKey(const std::string& op_name, const std::string& domain, const std::string& provider) {
     std::string key(op_name);
     key.append(1, ' ').append(domain.empty() ? kOnnxDomainAlias : domain).append(1, ' ').append(provider);
@@ -91,5 +121,10 @@ class KernelRegistry {
   // Kernel create function map from op name to kernel creation info.
   // key is opname+domain_name+provider_name
   KernelCreateMap kernel_creator_fn_map_;
+
+  // Hash index of the kernels in kernel_creator_fn_map_ with the same key, in the order they were registered.
+  // The index is built as kernels are registered, so a registry that is shared by the sessions of a provider
+  // (e.g. the static CPU kernel registry) builds it once.
+  std::unordered_map<std::string, std::vector<KernelLookupEntry>> kernel_lookup_index_;
 };
 }  // namespace onnxruntime
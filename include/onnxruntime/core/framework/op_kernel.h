@@ -15,6 +15,7 @@
 #include "core/framework/ml_value.h"
 #include "core/framework/op_kernel_info.h"
 #include "core/framework/op_node_proto_helper.h"
+#include "core/framework/prepacked_weights.h"
 #include "core/framework/tensor.h"
 #include "core/framework/sparse_tensor.h"
 #include "core/graph/constants.h"
@@ -53,25 +54,67 @@ class OpKernel {
 
   // Override this function to PrePack initialized constant tensor to the format as needed.
   // For example, MatMul kernel can pack the input B if it is constant like code below.
-  //   Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override {
+  //   Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+  //                  PrePackedWeights* prepacked_weights) override {
   //     is_packed = false;
   //     if (input_idx == 1) {
-  //       this.Pack(tensor, this.buffer_);
+  //       this.Pack(tensor, alloc, this.buffer_);
   //       is_packed = true;
+  //       if (prepacked_weights) {
+  //         prepacked_weights->buffers_.push_back(std::move(this.buffer_));
+  //         prepacked_weights->buffer_sizes_.push_back(this.buffer_size_);
+  //       }
   //     }
   //     return Status::OK();
   //   }
   // Please refer to MatMulIntegerToFloatBase for a complete example
   // @param tesnor: The initialized constant tensor
   // @param input_idx: The input index of the tensor in this kernel
+  // @param alloc: The allocator to allocate the packed buffers with
   // @param is_packed: Set it to true if the kernel packed the tensor or to false
   //                   The kernel is responsible keep the packed data and related metadata if is_packed is set to true
   //                   And the original intialized constant tensor will be released and not accessible anymore in Compute function.
-  virtual Status PrePack(const Tensor& /*tensor*/, int /*input_idx*/, bool& is_packed) {
+  // @param prepacked_weights: If not nullptr, the packed buffers may be shared with other kernel instances.
+  //                           A kernel that supports this moves the packed buffers into prepacked_weights, and
+  //                           is given the buffers to use in UseSharedPrePackedBuffers.
+  //                           A kernel that doesn't support it can ignore this and keep its packed buffers.
+  virtual Status PrePack(const Tensor& /*tensor*/, int /*input_idx*/, AllocatorPtr /*alloc*/, bool& is_packed,
+                         /*out*/ PrePackedWeights* /*prepacked_weights*/) {
     is_packed = false;
     return Status::OK();
   }
 
+  // Override this function to use the buffers that were moved into PrePackedWeights by PrePack.
+  // This is called after PrePack with the buffers to use, which are either the ones the kernel created or identical
+  // buffers created by another kernel instance. The buffers are owned by the caller and remain valid for the
+  // lifetime of the kernel, so the kernel must not free them.
+  // @param prepacked_buffers: The pre-packed buffers, in the order they were added to PrePackedWeights::buffers_
+  // @param input_idx: The input index of the tensor in this kernel
+  // @param used_shared_buffers: Set it to true if the kernel is using the buffers
+  virtual Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                           int /*input_idx*/,
+                                           /*out*/ bool& used_shared_buffers) {
+    used_shared_buffers = false;
+    return Status::OK();
+  }
+
+  // Override this function to use pre-packed buffers saved by an earlier session of the model instead of calling
+  // PrePack, e.g. the ones saved with the initialization cache. The buffers are the ones a kernel for the same node
+  // moved into PrePackedWeights in PrePack, on the same machine, so the kernel only needs to restore the metadata it
+  // keeps with them. They are owned by the caller, remain valid for the lifetime of the kernel and must not be
+  // modified.
+  // @param tensor: The initialized constant tensor that was pre-packed
+  // @param input_idx: The input index of the tensor in this kernel
+  // @param prepacked_weights: The saved pre-packed buffers and their sizes
+  // @param used_cached_buffers: Set it to true if the kernel is using the buffers, in which case the tensor will be
+  //                             released as if it was pre-packed. Otherwise PrePack is called.
+  virtual Status UseCachedPrePackedBuffers(const Tensor& /*tensor*/, int /*input_idx*/,
+                                           PrePackedWeights& /*prepacked_weights*/,
+                                           /*out*/ bool& used_cached_buffers) {
+    used_cached_buffers = false;
+    return Status::OK();
+  }
+
   const OrtMemoryInfo& Allocator(int id, OrtMemType mem_type) const {
     return op_kernel_info_.GetMemoryInfo(id, mem_type);
   }
@@ -138,6 +181,13 @@ class OpKernelContext {
   Tensor* Output(int index, const std::vector<int64_t>& shape);
   Tensor* Output(int index, const std::initializer_list<int64_t>& shape);
 
+  // Create the output tensor as a view of the data of the input tensor at input_index, with the given shape and
+  // starting byte_offset bytes into the input's data. The view must fit in the input's data.
+  // The kernel must declare that the output may be a view of the input (see KernelDefBuilder::MayOutputView).
+  // Return nullptr if the output can't be a view in this execution (e.g. it is a graph output), in which case the
+  // kernel must create the output with Output() and fill it in.
+  Tensor* OutputView(int index, int input_index, const TensorShape& shape, ptrdiff_t byte_offset);
+
   // Fetch a required tensor output, enforcing that it is present.
   Tensor& RequiredOutput(int index, const TensorShape& shape) {
     Tensor* output_ptr = Output(index, shape);
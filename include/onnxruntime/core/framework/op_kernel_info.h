@@ -27,7 +27,8 @@ class OpKernelInfo : public OpNodeProtoHelper<ProtoHelperNodeContext> {
                         const std::unordered_map<int, OrtValue>& constant_initialized_tensors,
                         const OrtValueNameIdxMap& mlvalue_name_idx_map,
                         const FuncManager& funcs_mgr,
-                        const DataTransferManager& data_transfer_mgr);
+                        const DataTransferManager& data_transfer_mgr,
+                        const std::unordered_map<std::string, std::string>* session_configurations = nullptr);
 
   OpKernelInfo(const OpKernelInfo& other);
 
@@ -47,6 +48,10 @@ class OpKernelInfo : public OpNodeProtoHelper<ProtoHelperNodeContext> {
 
   common::Status GetFusedFuncs(NodeComputeInfo*& compute_info) const;
 
+  // Get a configuration entry of the session creating the kernel, see onnxruntime_session_options_config_keys.h.
+  // Returns default_value if the entry is not set, or if the kernel is not created by a session.
+  std::string GetConfigOrDefault(const std::string& config_key, const std::string& default_value) const;
+
  private:
   ORT_DISALLOW_MOVE(OpKernelInfo);
   ORT_DISALLOW_ASSIGNMENT(OpKernelInfo);
@@ -60,6 +65,7 @@ class OpKernelInfo : public OpNodeProtoHelper<ProtoHelperNodeContext> {
   const OrtValueNameIdxMap& ort_value_name_idx_map_;
   const FuncManager& funcs_mgr_;
   const DataTransferManager& data_transfer_mgr_;
+  const std::unordered_map<std::string, std::string>* session_configurations_;
   ProtoHelperNodeContext proto_helper_context_;
 };
 
@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/tensor.h"
+
+namespace onnxruntime {
+
+// The buffers produced by OpKernel::PrePack for one initializer.
+// When pre-packed weights are shared, the kernel moves its buffers in here so they can be stored in a
+// PrepackedWeightsContainer, and is given them back (or an identical copy created by another kernel instance)
+// through OpKernel::UseSharedPrePackedBuffers.
+struct PrePackedWeights final {
+  // Buffers that together make up the pre-packed form of the initializer, and the size in bytes of each.
+  // A buffer may be null if it is not used by the packing format that was chosen, in which case its size is 0.
+  std::vector<BufferUniquePtr> buffers_;
+  std::vector<size_t> buffer_sizes_;
+
+  // Hash of the contents of all the buffers.
+  uint64_t GetHash() const;
+
+  // Returns true if both instances have buffers with the same sizes and contents.
+  bool HasSameContents(const PrePackedWeights& other) const;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/framework/prepacked_weights.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+ * Container for pre-packed weights that can be shared between kernel instances, including kernels in different
+ * sessions of the same model.
+ *
+ * Entries are reference counted. Each user holds the shared_ptr returned by GetOrAdd and an entry is freed once
+ * the last user releases it. The container only refers to the entries, so it does not extend their lifetime.
+ *
+ * Buffers that may be added to the container should be allocated with GetAllocator() so that they don't keep
+ * the allocator of the session that created them alive.
+ */
+class PrepackedWeightsContainer final {
+ public:
+  PrepackedWeightsContainer();
+
+  AllocatorPtr GetAllocator() const { return allocator_; }
+
+  /**
+  Get the shared pre-packed weights for a key, adding `weights` if there is no entry for the key.
+  If there is an entry for the key but its contents differ from `weights` (i.e. a hash collision), `weights` is
+  returned without being added so it won't be shared.
+  @param key Key identifying the kernel type, the input and the hash of the pre-packed buffers.
+  */
+  std::shared_ptr<const PrePackedWeights> GetOrAdd(const std::string& key, PrePackedWeights&& weights);
+
+  // Number of entries that are currently in use.
+  size_t GetNumberOfElements() const;
+
+  // Number of calls to GetOrAdd that returned an existing entry.
+  size_t GetNumberOfSharedUses() const;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsContainer);
+
+  AllocatorPtr allocator_;
+
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::string, std::weak_ptr<const PrePackedWeights>> weights_;
+  size_t num_shared_uses_{0};
+};
+
+}  // namespace onnxruntime
@@ -5,8 +5,13 @@
 
 #include <string>
 #include <atomic>
+#include <memory>
 #include "core/session/onnxruntime_c_api.h"
 
+namespace onnxruntime {
+class RunLatencyBreakdownRecord;
+}
+
 /**
  * Configuration information for a Run call.
  */
@@ -26,6 +31,20 @@ struct OrtRunOptions {
   // So it is possible that only some of the nodes are executed.
   bool only_execute_path_to_fetches = false;
 
+  // Maximum number of intra-op threads, including the calling thread, that the kernels of this Run() may use.
+  // Default = 0 (use all the threads of the intra-op thread pool).
+  // Applies to the kernels run on the calling thread, i.e. with the sequential execution mode.
+  int intra_op_num_threads = 0;
+
+  // Maximum duration in milliseconds of a Run() call using this. Once it passes the call fails between two nodes,
+  // and a call predicted to take longer while other calls are running on the session is rejected before it runs.
+  // Default = 0 (no deadline).
+  int64_t timeout_ms = 0;
+
+  // Set to collect the latency breakdown of the Run() calls using this, which stores the breakdown of the last
+  // completed call. Default = null (not collected).
+  std::shared_ptr<onnxruntime::RunLatencyBreakdownRecord> latency_breakdown;
+
 #ifdef ENABLE_TRAINING
   // Set to 'true' to run in training mode.
   bool training_mode = true;
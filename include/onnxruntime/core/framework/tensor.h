@@ -195,6 +195,13 @@ class Tensor final {
     shape_ = new_shape;
   }
 
+  /**
+   * Point the tensor at a new buffer with a new shape, reusing the storage of the current shape.
+   * The tensor must not own its buffer and the caller must make sure the buffer is large enough for the shape.
+   * @warning this function is NOT thread-safe.
+   */
+  void SetExternalData(void* p_data, const int64_t* dims, size_t num_dims);
+
   /**
    * Get the byte offset with respect to the p_data
    * @warning this is a temporary solution for reusing the buffer bigger than needed.
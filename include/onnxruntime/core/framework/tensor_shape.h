@@ -72,6 +72,13 @@ class TensorShape : private std::vector<int64_t> {
     memcpy(dims, data(), sizeof(value_type) * std::min(num_dims, NumDimensions()));
   }
 
+  /**
+     Replace the dims with the given ones. The storage of the shape is reused if it has enough capacity.
+  */
+  void Assign(const int64_t* dimension_sizes, size_t dimension_count) {
+    assign(dimension_sizes, dimension_sizes + dimension_count);
+  }
+
   /**
      Return underlying vector representation.
   */
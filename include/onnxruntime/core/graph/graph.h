@@ -40,6 +40,7 @@ namespace fbs {
 struct Graph;
 struct Node;
 struct NodeEdge;
+enum class TensorDataCompression : int32_t;
 }  // namespace fbs
 }  // namespace experimental
 
@@ -218,20 +219,26 @@ class Node {
   /** Gets a modifiable count of arguments for each of the Node's explicit inputs.
   @todo This should be removed in favor of a method that updates the input args and the count.
         Currently these operations are separate which is not a good setup. */
-  std::vector<int>& MutableInputArgsCount() { return definitions_.input_arg_count; }
+  std::vector<int>& MutableInputArgsCount() {
+    type_and_shape_inference_needed_ = true;
+    return definitions_.input_arg_count;
+  }
 
   /** Gets a modifiable collection of the Node's input definitions. */
   std::vector<NodeArg*>& MutableInputDefs() noexcept {
+    type_and_shape_inference_needed_ = true;
     return definitions_.input_defs;
   }
 
   /** Gets a modifiable collection of the Node's implicit input definitions. */
   std::vector<NodeArg*>& MutableImplicitInputDefs() noexcept {
+    type_and_shape_inference_needed_ = true;
     return definitions_.implicit_input_defs;
   }
 
   /** Gets a modifiable collection of the Node's output definitions. */
   std::vector<NodeArg*>& MutableOutputDefs() noexcept {
+    type_and_shape_inference_needed_ = true;
     return definitions_.output_defs;
   }
 #endif  // !defined(ORT_MINIMAL_BUILD)
@@ -334,7 +341,10 @@ class Node {
   bool ClearAttribute(const std::string& attr_name);
 
   /** Gets the Node's mutable attributes. */
-  NodeAttributes& GetMutableAttributes() noexcept { return attributes_; }
+  NodeAttributes& GetMutableAttributes() noexcept {
+    type_and_shape_inference_needed_ = true;
+    return attributes_;
+  }
 
   /** Gets the Graph instance that is instantiated from a GraphProto attribute during Graph::Resolve.
   @param attr_name Attribute name for the GraphProto attribute.
@@ -397,8 +407,10 @@ class Node {
   */
   void ToProto(ONNX_NAMESPACE::NodeProto& proto, bool update_subgraphs = false) const;
 
+  // The raw data of the initializers of the subgraphs is compressed with initializer_compression.
   Status SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
-                         flatbuffers::Offset<onnxruntime::experimental::fbs::Node>& fbs_node) const;
+                         flatbuffers::Offset<onnxruntime::experimental::fbs::Node>& fbs_node,
+                         onnxruntime::experimental::fbs::TensorDataCompression initializer_compression) const;
 
   flatbuffers::Offset<onnxruntime::experimental::fbs::NodeEdge>
   SaveEdgesToOrtFormat(flatbuffers::FlatBufferBuilder& builder) const;
@@ -530,6 +542,10 @@ class Node {
   const ONNX_NAMESPACE::OpSchema* op_ = nullptr;
 #endif
 
+  // Whether the definitions or attributes changed since the last Graph::Resolve, in which case the node needs
+  // type and shape inferencing again.
+  bool type_and_shape_inference_needed_ = true;
+
   // Execution priority, lower value for higher priority
   int priority_ = 0;
 
@@ -731,6 +747,15 @@ class Graph {
   */
   int NumberOfNodes() const noexcept { return num_of_nodes_; }
 
+  /** Gets the number of valid Nodes in the Graph with the specified op type, in any domain.
+  @remarks Nodes in subgraphs are not included. The count is maintained as Nodes are added and removed,
+           so this is cheap enough to check whether an optimization applies to the Graph at all. */
+  size_t NumberOfNodesOfOpType(const std::string& op_type) const noexcept;
+
+  /** Gets the indexes of the valid Nodes in the Graph with the specified op type, in any domain, in ascending order.
+  @remarks Nodes in subgraphs are not included. */
+  std::vector<NodeIndex> GetNodeIndexesOfOpType(const std::string& op_type) const;
+
   /** Gets the mutable NodeArg with the provided name.
   @returns Pointer to NodeArg if found, nullptr if not. */
   NodeArg* GetNodeArg(const std::string& name) {
@@ -1055,6 +1080,13 @@ class Graph {
   common::Status SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
                                  flatbuffers::Offset<onnxruntime::experimental::fbs::Graph>& fbs_graph) const;
 
+  // Save with the raw data of the initializers, including the ones of the subgraphs, compressed with
+  // initializer_compression where it makes them smaller.
+  common::Status SaveToOrtFormat(
+      flatbuffers::FlatBufferBuilder& builder,
+      flatbuffers::Offset<onnxruntime::experimental::fbs::Graph>& fbs_graph,
+      onnxruntime::experimental::fbs::TensorDataCompression initializer_compression) const;
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
   /** Returns the Node containing the GraphProto for this Graph instance if IsSubgraph is true */
@@ -1193,6 +1225,9 @@ class Graph {
   // Initialize overridable initializers container
   void ComputeOverridableInitializers();
 
+  // Record that an initializer was added, removed or replaced so that its consumers are inferred again
+  void InitializerChanged(const std::string& name);
+
 #if !defined(ORT_MINIMAL_BUILD)
   // Build and verify node connection (edges).
   // Verify NodeArg name/type/shape matching correctly.
@@ -1230,8 +1265,13 @@ class Graph {
 
   // Infer and set type information across <*this> graph if needed, and verify type/attribute
   // information matches between node and op.
+  // After the first Resolve of the top level graph, only the nodes that changed, or that consume a value whose
+  // type or shape changed, are inferred again.
   common::Status VerifyNodeAndOpMatch(const ResolveOptions& options);
 
+  // Whether the node changed, or consumes a value whose type or shape changed, since the last Resolve
+  static bool NeedsTypeAndShapeInference(const Node& node);
+
   // Set graph inputs/outputs when resolving a graph..
   common::Status SetGraphInputsOutputs();
 
@@ -1331,6 +1371,9 @@ class Graph {
   // or some elements may be merged, etc.
   int num_of_nodes_ = 0;
 
+  // Indexes of the valid nodes of each op type, in any domain.
+  std::unordered_map<std::string, std::unordered_set<NodeIndex>> op_type_to_node_indexes_;
+
   // A flag indicates whether <*this> graph needs to be resolved.
   bool graph_resolve_needed_ = false;
 
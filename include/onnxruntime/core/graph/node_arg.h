@@ -112,5 +112,9 @@ class NodeArg {
 
   // Flag indicates whether <*this> node arg exists or not.
   bool exists_;
+
+  // Flag indicates whether the type or shape changed since the last Graph::Resolve, in which case the
+  // nodes consuming <*this> node arg need type and shape inferencing again.
+  bool type_or_shape_changed_ = true;
 };
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #pragma once
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "core/common/common.h"
 #include "core/graph/graph_viewer.h"
@@ -41,6 +42,11 @@ class GraphTransformer {
 
   virtual bool ShouldOnlyApplyOnce() const { return false; }
 
+  /** Gets the op types of the nodes this transformer applies to, in any domain.
+  Apply skips a Graph that has no node of these op types, including in its subgraphs, without calling ApplyImpl.
+  @returns The op types, or an empty vector if the transformer may apply to a node of any op type. */
+  virtual std::vector<std::string> TargetOpTypes() const { return {}; }
+
  protected:
   /** Helper method to call ApplyImpl on any subgraphs in the Node. */
   common::Status Recurse(Node& node, bool& modified, int graph_level, const logging::Logger& logger) const {
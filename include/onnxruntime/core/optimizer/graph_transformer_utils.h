@@ -23,11 +23,16 @@ std::vector<std::unique_ptr<RewriteRule>> GenerateRewriteRules(TransformerLevel
 
 /** Generates all predefined (both rule-based and non-rule-based) transformers for this level.
     If transformers_and_rules_to_enable is not empty, it returns the intersection between the predefined transformers/rules 
-    and the transformers_and_rules_to_enable. */
+    and the transformers_and_rules_to_enable.
+    Constant folding skips nodes with an output larger than constant_folding_max_output_bytes, unless it is 0.
+    If enable_qdq_fusion is true, the DequantizeLinear nodes are not constant folded and the DequantizeLinear,
+    op, QuantizeLinear groups are fused into the integer kernels at level 2. */
 std::vector<std::unique_ptr<GraphTransformer>> GenerateTransformers(TransformerLevel level,
                                                                     gsl::span<const FreeDimensionOverride> free_dimension_overrides,
                                                                     const IExecutionProvider& execution_provider /*required by constant folding*/,
-                                                                    const std::vector<std::string>& rules_and_transformers_to_enable = {});
+                                                                    const std::vector<std::string>& rules_and_transformers_to_enable = {},
+                                                                    size_t constant_folding_max_output_bytes = 0,
+                                                                    bool enable_qdq_fusion = false);
 
 /** Given a TransformerLevel, this method generates a name for the rule-based graph transformer of that level. */
 std::string GenerateRuleBasedTransformerName(TransformerLevel level);
@@ -53,6 +53,10 @@ class RuleBasedGraphTransformer : public GraphTransformer {
   /** Returns the total number of rules that are registered in this transformer. */
   size_t RulesCount() const;
 
+  /** Gets the op types that the registered rules are triggered on,
+      or an empty vector if there is a rule that is evaluated on all nodes. */
+  std::vector<std::string> TargetOpTypes() const override;
+
  protected:
   /** Applies the given set of rewrite rules on the Node of this Graph.
       @param[in] graph The Graph.
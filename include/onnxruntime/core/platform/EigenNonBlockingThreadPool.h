@@ -12,6 +12,7 @@
 #include <type_traits>
 
 #pragma once
+#include <chrono>
 #include "onnxruntime_config.h"
 // build/external/eigen/unsupported/Eigen/CXX11/src/Tensor/TensorEvaluator.h:162:71:
 // error: ignoring attributes on template argument "Eigen::PacketType<const float, Eigen::DefaultDevice>::type {aka
@@ -254,6 +255,120 @@ class ThreadPoolLoop {
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadPoolLoop);
 };
 
+// Work item held in the run queues.  This is a move-only void() callable
+// which stores closures of up to kInlineSize bytes, including a
+// std::function and the wrappers created in SummonWorkers, without a
+// heap allocation.  Larger closures are moved to the heap.
+
+class Task {
+ public:
+  Task() noexcept = default;
+
+  template <typename F,
+            typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, Task>::value>::type>
+  Task(F&& f) {  // NOLINT(google-explicit-constructor): work items are built from any callable
+    using Fn = typename std::decay<F>::type;
+    Init<Fn>(std::forward<F>(f), std::integral_constant<bool, FitsInline<Fn>()>());
+  }
+
+  Task(Task&& other) noexcept {
+    MoveFrom(other);
+  }
+
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  ~Task() {
+    Reset();
+  }
+
+  explicit operator bool() const noexcept {
+    return ops_ != nullptr;
+  }
+
+  void operator()() {
+    ops_->invoke(&storage_);
+  }
+
+ private:
+  static constexpr size_t kInlineSize = 48;
+  using Storage = typename std::aligned_storage<kInlineSize, alignof(std::max_align_t)>::type;
+
+  struct Ops {
+    void (*invoke)(void*);
+    void (*move)(void* dst, void* src);
+    void (*destroy)(void*);
+  };
+
+  template <typename Fn>
+  static constexpr bool FitsInline() {
+    return sizeof(Fn) <= sizeof(Storage) && alignof(Fn) <= alignof(Storage) &&
+           std::is_nothrow_move_constructible<Fn>::value;
+  }
+
+  template <typename Fn>
+  struct InlineOps {
+    static void Invoke(void* p) { (*static_cast<Fn*>(p))(); }
+    static void Move(void* dst, void* src) {
+      new (dst) Fn(std::move(*static_cast<Fn*>(src)));
+      static_cast<Fn*>(src)->~Fn();
+    }
+    static void Destroy(void* p) { static_cast<Fn*>(p)->~Fn(); }
+    static constexpr Ops ops{&Invoke, &Move, &Destroy};
+  };
+
+  template <typename Fn>
+  struct HeapOps {
+    static void Invoke(void* p) { (**static_cast<Fn**>(p))(); }
+    static void Move(void* dst, void* src) { *static_cast<Fn**>(dst) = *static_cast<Fn**>(src); }
+    static void Destroy(void* p) { delete *static_cast<Fn**>(p); }
+    static constexpr Ops ops{&Invoke, &Move, &Destroy};
+  };
+
+  template <typename Fn, typename F>
+  void Init(F&& f, std::true_type /* fits inline */) {
+    new (&storage_) Fn(std::forward<F>(f));
+    ops_ = &InlineOps<Fn>::ops;
+  }
+
+  template <typename Fn, typename F>
+  void Init(F&& f, std::false_type /* fits inline */) {
+    *reinterpret_cast<Fn**>(&storage_) = new Fn(std::forward<F>(f));
+    ops_ = &HeapOps<Fn>::ops;
+  }
+
+  void MoveFrom(Task& other) noexcept {
+    if (other.ops_) {
+      other.ops_->move(&storage_, &other.storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  void Reset() noexcept {
+    if (ops_) {
+      ops_->destroy(&storage_);
+      ops_ = nullptr;
+    }
+  }
+
+  Storage storage_;
+  const Ops* ops_{nullptr};
+
+  ORT_DISALLOW_COPY_AND_ASSIGNMENT(Task);
+};
+
+template <typename Fn>
+constexpr Task::Ops Task::InlineOps<Fn>::ops;
+
+template <typename Fn>
+constexpr Task::Ops Task::HeapOps<Fn>::ops;
+
 template <typename Work, typename Tag, unsigned kSize>
 class RunQueue {
  public:
@@ -322,19 +437,8 @@ class RunQueue {
   // PushBack adds w at the end of the queue.
   // If queue is full returns w, otherwise returns default-constructed Work.
   Work PushBack(Work w) {
-    std::unique_lock<OrtMutex> lock(mutex_);
-    unsigned back = back_.load(std::memory_order_relaxed);
-    Elem& e = array_[(back - 1) & kMask];
-    ElemState s = e.state.load(std::memory_order_relaxed);
-    if (s != ElemState::kEmpty ||
-        !e.state.compare_exchange_strong(s, ElemState::kBusy, std::memory_order_acquire))
-      return w;
-    back = ((back - 1) & kMask2) | (back & ~kMask2);
-    back_.store(back, std::memory_order_relaxed);
-    e.w = std::move(w);
-    e.tag = Tag();
-    e.state.store(ElemState::kReady, std::memory_order_release);
-    return Work();
+    unsigned w_idx;
+    return PushBackWithTag(std::move(w), Tag(), w_idx);
   }
 
   // PushBackWithTag adds w at the end of the queue.  The tag value can be used on a 
@@ -343,21 +447,47 @@ class RunQueue {
   // submitted from different threads.
   //
   // If the queue is full, returns w, otherwise returns default-constructed work.
+  //
+  // Pushes do not take the queue's mutex.  A pusher claims the slot before
+  // the back of the queue by moving it from kEmpty to kBusy, and then
+  // publishes it by a CAS on back_.  If the CAS fails (another push, a
+  // PopBack, or a revocation moved the back) the slot is released and the
+  // push retried.  The operations that move the back in the other direction
+  // (PopBack, RevokeWithTag) still hold the mutex between themselves, and
+  // also update back_ by CAS so that they see concurrent pushes.
   Work PushBackWithTag(Work w, Tag tag, unsigned &w_idx) {
-    std::unique_lock<OrtMutex> lock(mutex_);
-    unsigned back = back_.load(std::memory_order_relaxed);
-    w_idx = (back-1) & kMask;
-    Elem& e = array_[w_idx];
-    ElemState s = e.state.load(std::memory_order_relaxed);
-    if (s != ElemState::kEmpty ||
-        !e.state.compare_exchange_strong(s, ElemState::kBusy, std::memory_order_acquire))
-      return w;
-    back = ((back - 1) & kMask2) | (back & ~kMask2);
-    back_.store(back, std::memory_order_relaxed);
-    e.w = std::move(w);
-    e.tag = tag;
-    e.state.store(ElemState::kReady, std::memory_order_release);
-    return Work();
+    for (;;) {
+      unsigned back = back_.load(std::memory_order_relaxed);
+      w_idx = (back - 1) & kMask;
+      Elem& e = array_[w_idx];
+      ElemState s = e.state.load(std::memory_order_relaxed);
+      if (s == ElemState::kBusy) {
+        // Another push has claimed the slot, or the owner is popping it from
+        // the front of a full queue.
+        onnxruntime::concurrency::SpinPause();
+        continue;
+      }
+      if (s != ElemState::kEmpty) {
+        if (back_.load(std::memory_order_relaxed) != back) {
+          // Stale view of the back, e.g. another push just filled the slot
+          continue;
+        }
+        // Queue is full
+        return w;
+      }
+      if (!e.state.compare_exchange_strong(s, ElemState::kBusy, std::memory_order_acquire)) {
+        continue;
+      }
+      unsigned new_back = ((back - 1) & kMask2) | (back & ~kMask2);
+      if (!back_.compare_exchange_strong(back, new_back, std::memory_order_relaxed)) {
+        e.state.store(ElemState::kEmpty, std::memory_order_release);
+        continue;
+      }
+      e.w = std::move(w);
+      e.tag = tag;
+      e.state.store(ElemState::kReady, std::memory_order_release);
+      return Work();
+    }
   }
 
   // PopBack removes and returns the last elements in the queue.
@@ -370,26 +500,38 @@ class RunQueue {
     ElemState s;
 
     // Drain revoked items from the back of the queue.  CAS to busy to synchronize with
-    // any attempt to take the same item from the front of the queue.
-    do {
+    // any attempt to take the same item from the front of the queue.  If a concurrent
+    // push moves the back while we hold an item, the item is no longer at the back:
+    // restore it and retry.
+    for (;;) {
       back = back_.load(std::memory_order_relaxed);
       e = &array_[back & kMask];
       s = e->state.load(std::memory_order_relaxed);
       if (s == ElemState::kRevoked &&
           e->state.compare_exchange_strong(s, ElemState::kBusy, std::memory_order_acquire)) {
-        e->state.store(ElemState::kEmpty, std::memory_order_release);
-        back_.store(back + 1 + (kSize << 1), std::memory_order_relaxed);
+        if (back_.compare_exchange_strong(back, back + 1 + (kSize << 1), std::memory_order_relaxed)) {
+          e->state.store(ElemState::kEmpty, std::memory_order_release);
+        } else {
+          e->state.store(ElemState::kRevoked, std::memory_order_release);
+        }
+        continue;
+      }
+      if (s == ElemState::kRevoked) {
+        continue;
       }
-    } while (s == ElemState::kRevoked);
 
-    if (s != ElemState::kReady ||
-        !e->state.compare_exchange_strong(s, ElemState::kBusy, std::memory_order_acquire))
-      return Work();
-    Work w = std::move(e->w);
-    e->tag = Tag();
-    e->state.store(ElemState::kEmpty, std::memory_order_release);
-    back_.store(back + 1 + (kSize << 1), std::memory_order_relaxed);
-    return w;
+      if (s != ElemState::kReady ||
+          !e->state.compare_exchange_strong(s, ElemState::kBusy, std::memory_order_acquire))
+        return Work();
+      if (!back_.compare_exchange_strong(back, back + 1 + (kSize << 1), std::memory_order_relaxed)) {
+        e->state.store(ElemState::kReady, std::memory_order_release);
+        continue;
+      }
+      Work w = std::move(e->w);
+      e->tag = Tag();
+      e->state.store(ElemState::kEmpty, std::memory_order_release);
+      return w;
+    }
   }
 
   // RevokeItem removes a work item from the queue.  Items are identified positionally,
@@ -419,21 +561,19 @@ class RunQueue {
       if (e.tag == tag) {
         unsigned back = back_.load(std::memory_order_relaxed);
         unsigned back_idx = back & kMask;
-        if (back_idx != w_idx) {
-          // Item is not at the back of the queue, mark it in-place as revoked
-          e.tag = Tag();
-          e.w = Work();
-          e.state.store(ElemState::kRevoked, std::memory_order_release);
-          revoked = true;
-        } else {
+        e.tag = Tag();
+        e.w = Work();
+        if (back_idx == w_idx &&
+            back_.compare_exchange_strong(back, back + 1 + (kSize << 1), std::memory_order_relaxed)) {
           // Item being removed as still at the back; shift the back pointer over it,
           // and bump the version number.
-          e.tag = Tag();
-          e.w = Work();
           e.state.store(ElemState::kEmpty, std::memory_order_release);
-          back_.store(back + 1 + (kSize << 1), std::memory_order_relaxed);
-          revoked = true;
+        } else {
+          // Item is not at the back of the queue (or a concurrent push has just moved
+          // the back past it), mark it in-place as revoked
+          e.state.store(ElemState::kRevoked, std::memory_order_release);
         }
+        revoked = true;
       } else {
         // Tag mismatch, i.e. work queue slot re-used
         e.state.store(ElemState::kReady, std::memory_order_release);
@@ -596,7 +736,6 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     uint32_t v_ = 0;
   };
 
-  typedef std::function<void()> Task;
   typedef RunQueue<Task, Tag, 1024> Queue;
 #ifdef _WIN32
   using CHAR_TYPE = wchar_t;
@@ -609,6 +748,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         num_threads_(num_threads),
         allow_spinning_(allow_spinning),
         set_denormal_as_zero_(thread_options.set_denormal_as_zero),
+        spin_policy_(thread_options.spin_policy),
         worker_data_(num_threads),
         all_coprimes_(num_threads),
         blocked_(0),
@@ -659,6 +799,26 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     for (size_t i = 0; i < worker_data_.size(); ++i) worker_data_[i].thread.reset();
   }
 
+  // Restrict the workers that the parallel loops of the calling thread push
+  // tasks to, to [begin, end).  An empty range lifts the restriction.
+  void SetCallerWorkerRange(unsigned begin, unsigned end) {
+    PerThread* pt = GetPerThread();
+    pt->worker_range_begin = begin;
+    pt->worker_range_end = std::min(end, static_cast<unsigned>(num_threads_));
+  }
+
+  // Number of times an idle worker found work while spinning (hits), and gave up spinning
+  // and tried to block (misses).
+  void GetSpinCounters(uint64_t& hits, uint64_t& misses) const {
+    hits = spin_hits_.load(std::memory_order_relaxed);
+    misses = spin_misses_.load(std::memory_order_relaxed);
+  }
+
+  // Number of tasks that idle workers stole from the queues of other workers.
+  uint64_t GetStealCount() const {
+    return steals_.load(std::memory_order_relaxed);
+  }
+
   // Run fn().  Ordinarily, the function will be added to the thread pool and executed
   // by a worker thread.  If the thread pool rejects the work then fn() will instead
   // execute synchronously during Schedule(fn).  Currently the thread pool will only
@@ -666,25 +826,26 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 
   void Schedule(std::function<void()> fn) override {
     PerThread* pt = GetPerThread();
+    Task t;
     if (pt->pool == this) {
       // Worker thread of this pool, push onto the thread's queue.
       Queue& q = worker_data_[pt->thread_id].queue;
-      fn = q.PushFront(std::move(fn));
+      t = q.PushFront(std::move(fn));
     } else {
       // A free-standing thread (or worker of another pool), push onto a random
       // queue.
       int q_idx = Rand(&pt->rand) % num_threads_;
       WorkerData &td = worker_data_[q_idx];
       Queue& q = td.queue;
-      fn = q.PushBack(std::move(fn));
-      if (!fn) {
+      t = q.PushBack(std::move(fn));
+      if (!t) {
         // The queue accepted the work; ensure that the thread will pick it up
         td.EnsureAwake();
       }
     }
 
     // Run the work directly if the queue rejected the work
-    if (fn) fn();
+    if (t) t();
   }
 
 // The thread pool maintains a set of hints for which threads will be good to distribute
@@ -881,15 +1042,27 @@ void SummonWorkers(PerThread &pt,
 
     // Obtain hints for which worker threads to push the tasks to.
     // This uses a best-effort assessment of which threads are
-    // spinning.
+    // spinning.  A caller restricted to a range of workers uses
+    // those in order instead.
+    const unsigned range_begin = pt.worker_range_begin;
+    const unsigned range_end = pt.worker_range_end;
+    const bool use_range = range_end > range_begin;
     std::vector<unsigned> good_hints, alt_hints;
-    GetGoodWorkerHints(extra_needed, good_hints, alt_hints);
+    if (!use_range) {
+      GetGoodWorkerHints(extra_needed, good_hints, alt_hints);
+    }
 
-    // Create the additional tasks, and push them to workers.
+    // Create the additional tasks, and push them to workers.  Wake-ups
+    // are deferred until all the tasks are in the queues: waking a
+    // blocked worker is a system call, and the tasks pushed to the
+    // spinning workers can start in the meantime.
+    const size_t first_new_task = ps.tasks.size();
     for (auto i = 0u; i < extra_needed; i++) {
       Task t;
       int q_idx;
-      if (i < good_hints.size()) {
+      if (use_range) {
+        q_idx = range_begin + (current_dop - 1 + i) % (range_end - range_begin);
+      } else if (i < good_hints.size()) {
         q_idx = good_hints[i];
       } else {
         auto alt_i = i - static_cast<unsigned>(good_hints.size());
@@ -912,9 +1085,11 @@ void SummonWorkers(PerThread &pt,
       t = q.PushBackWithTag(call_worker_fn, pt.tag, w_idx);
       if (!t) {
         ps.tasks.push_back({q_idx, w_idx});
-        td.EnsureAwake();
       }
     }
+    for (size_t i = first_new_task; i < ps.tasks.size(); i++) {
+      worker_data_[ps.tasks[i].first].EnsureAwake();
+    }
   }
 }
 
@@ -1071,6 +1246,8 @@ int CurrentThreadId() const EIGEN_FINAL {
     int thread_id{-1};                // Worker thread index in pool.
     Tag tag{};                        // Work item tag used to identify this thread.
     bool leading_par_section{false};  // Leading a parallel section (used only for asserts)
+    unsigned worker_range_begin{0};   // Workers to push parallel loop tasks to,
+    unsigned worker_range_end{0};     // or any worker if the range is empty.
   };
 
   static_assert(std::is_trivially_destructible<PerThread>::value,
@@ -1172,6 +1349,14 @@ int CurrentThreadId() const EIGEN_FINAL {
   const int num_threads_;
   const bool allow_spinning_;
   const bool set_denormal_as_zero_;
+  const onnxruntime::SpinPolicy spin_policy_;
+
+  // Moving average of the time workers stay idle between work items, used to size the spin
+  // window of the adaptive spin policies.
+  std::atomic<int64_t> idle_gap_ns_{0};
+  std::atomic<uint64_t> spin_hits_{0};
+  std::atomic<uint64_t> spin_misses_{0};
+  std::atomic<uint64_t> steals_{0};
   Eigen::MaxSizeVector<WorkerData> worker_data_;
   Eigen::MaxSizeVector<Eigen::MaxSizeVector<unsigned>> all_coprimes_;
   std::atomic<unsigned> blocked_;  // Count of blocked workers, used as a termination condition
@@ -1200,6 +1385,27 @@ int CurrentThreadId() const EIGEN_FINAL {
     }
   }
 
+  // Returns how long an idle worker spins before blocking under an adaptive spin policy.
+  // We spin for twice the typical idle gap so that back-to-back parallel sections are picked
+  // up without a wake-up, but only block almost immediately when the gaps are longer than
+  // the maximum window: spinning through them would just burn the CPU.
+  int64_t AdaptiveSpinWindowNs() const {
+    const bool latency = spin_policy_ == onnxruntime::SpinPolicy::kLatency;
+    const int64_t min_window_ns = latency ? 50 * 1000 : 0;
+    const int64_t max_window_ns = latency ? 10 * 1000 * 1000 : 200 * 1000;
+    const int64_t window_ns = 2 * idle_gap_ns_.load(std::memory_order_relaxed);
+    if (window_ns > max_window_ns) {
+      return min_window_ns;
+    }
+    return std::max(window_ns, min_window_ns);
+  }
+
+  void RecordIdleGap(int64_t gap_ns) {
+    // Racy read-modify-write across workers; an approximate average is enough here.
+    int64_t avg_ns = idle_gap_ns_.load(std::memory_order_relaxed);
+    idle_gap_ns_.store(avg_ns + (gap_ns - avg_ns) / 8, std::memory_order_relaxed);
+  }
+
   // Main worker thread loop.
   void WorkerLoop(int thread_id) {
     PerThread* pt = GetPerThread();
@@ -1214,8 +1420,11 @@ int CurrentThreadId() const EIGEN_FINAL {
     SetGoodWorkerHint(thread_id, true /* Is good */);
 
     const int log2_spin = 20;
+    const bool adaptive_spin = allow_spinning_ && spin_policy_ != onnxruntime::SpinPolicy::kFixed;
     const int spin_count = allow_spinning_ ? (1ull<<log2_spin) : 0;
-    const int steal_count = spin_count/100;
+    const int steal_count = (1 << log2_spin) / 100;
+    bool idle = false;
+    std::chrono::steady_clock::time_point idle_start;
 
     SetDenormalAsZero(set_denormal_as_zero_);
 
@@ -1227,12 +1436,33 @@ int CurrentThreadId() const EIGEN_FINAL {
           // In addition, priodically make a best-effort attempt to steal from other
           // threads which are not themselves spinning.
 
+          if (adaptive_spin && !idle) {
+            idle = true;
+            idle_start = std::chrono::steady_clock::now();
+          }
           SetGoodWorkerHint(thread_id, true);
-          for (int i = 0; i < spin_count && !t && !cancelled_ && !done_; i++) {
-            t = ((i+1)%steal_count == 0) ? TrySteal() : q.PopFront();
-            onnxruntime::concurrency::SpinPause();
+          if (adaptive_spin) {
+            // Spin until the window derived from the recent idle gaps runs out, checking the
+            // clock only every 64 iterations to keep its cost out of the spin loop.
+            const auto spin_end = std::chrono::steady_clock::now() +
+                                  std::chrono::nanoseconds(AdaptiveSpinWindowNs());
+            for (int i = 0; !t && !cancelled_ && !done_; i++) {
+              t = ((i+1)%steal_count == 0) ? TrySteal() : q.PopFront();
+              onnxruntime::concurrency::SpinPause();
+              if ((i & 63) == 63 && std::chrono::steady_clock::now() >= spin_end) {
+                break;
+              }
+            }
+          } else {
+            for (int i = 0; i < spin_count && !t && !cancelled_ && !done_; i++) {
+              t = ((i+1)%steal_count == 0) ? TrySteal() : q.PopFront();
+              onnxruntime::concurrency::SpinPause();
+            }
           }
           SetGoodWorkerHint(thread_id, false);
+          if (allow_spinning_) {
+            (t ? spin_hits_ : spin_misses_).fetch_add(1, std::memory_order_relaxed);
+          }
 
           if (!t) {
             // No work passed to us while spinning; make a further full attempt to
@@ -1252,6 +1482,9 @@ int CurrentThreadId() const EIGEN_FINAL {
                       should_block = false;
                       if (!cancelled_) {
                         t = worker_data_[victim].queue.PopBack();
+                        if (t && victim != thread_id) {
+                          steals_.fetch_add(1, std::memory_order_relaxed);
+                        }
                       }
                     }
                     // Number of blocked threads is used as termination condition.
@@ -1289,6 +1522,12 @@ int CurrentThreadId() const EIGEN_FINAL {
           }
         }
         if (t) {
+          if (idle) {
+            idle = false;
+            RecordIdleGap(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - idle_start)
+                              .count());
+          }
           td.SetActive();
           t();
           td.SetSpinning();
@@ -1329,6 +1568,7 @@ int CurrentThreadId() const EIGEN_FINAL {
             worker_data_[victim].GetStatus() == WorkerData::ThreadStatus::Active) {
           Task t = worker_data_[victim].queue.PopBack();
           if (t) {
+            steals_.fetch_add(1, std::memory_order_relaxed);
             return t;
           }
         }
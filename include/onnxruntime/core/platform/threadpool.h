@@ -16,6 +16,7 @@ limitations under the License.
 /* Modifications Copyright (c) Microsoft. */
 
 #pragma once
+#include <atomic>
 #include <string>
 #include <vector>
 #include <functional>
@@ -136,6 +137,23 @@ class ThreadPoolTempl;
 class ExtendedThreadPoolInterface;
 class LoopCounter;
 class ThreadPoolParallelSection;
+class ThreadPoolStats;
+
+// Statistics of the parallel loops that one call site ran on the thread pool while ThreadPool::EnableStats is on.
+// The times are sums over the loops, in nanoseconds; divide them by calls for the means.
+struct ParallelForStats {
+  uint64_t calls = 0;          // loops run in parallel
+  uint64_t shards = 0;         // blocks of iterations run
+  uint64_t workers = 0;        // threads that took part in the loops, including the calling threads
+  uint64_t shard_steals = 0;   // blocks claimed from the shard of another thread once a thread's own was done
+  uint64_t wall_ns = 0;        // durations of the loops in the calling threads
+  uint64_t busy_ns = 0;        // time the threads spent running the loops
+  uint64_t tail_ns = 0;        // time between the first and the last thread finishing a loop
+  uint64_t max_tail_ns = 0;
+  uint64_t wakeup_ns = 0;      // time until the helping threads started a loop, i.e. queueing and wake-up
+  uint64_t max_wakeup_ns = 0;
+  double imbalance = 0;        // the busy time of the busiest thread of a loop over the mean busy time
+};
 
 class ThreadPool {
  public:
@@ -163,6 +181,47 @@ class ThreadPool {
   // set of threads.
   ~ThreadPool();
 
+  // Returns the number of times idle threads found work while spinning (hits) and
+  // gave up spinning and blocked (misses). Both are 0 if the pool has no threads of
+  // its own.
+  void GetSpinCounters(uint64_t& hits, uint64_t& misses) const;
+
+  // Returns the number of tasks that idle threads stole from the queues of other threads.
+  uint64_t GetStealCount() const;
+
+  // Collect the ParallelForStats of the parallel loops run on the pool, per call site. This costs two clock reads
+  // per thread and a lock per loop, so it is off by default.
+  void EnableStats(bool enable);
+
+  bool StatsEnabled() const {
+    return stats_enabled_.load(std::memory_order_relaxed);
+  }
+
+  // Returns the statistics collected since EnableStats or the last reset, sorted by call site. The statistics are
+  // cleared if reset is true.
+  std::vector<std::pair<std::string, ParallelForStats>> GetParallelForStats(bool reset);
+
+  // Names the call site of the parallel loops that the calling thread starts while the scope is alive, e.g. the
+  // op type of the kernel being run, for ParallelForStats. The name must outlive the scope. Loops started outside
+  // a scope are attributed to an empty name.
+  class CallSiteScope {
+  public:
+    explicit CallSiteScope(const char* name) : prev_call_site_(current_call_site) {
+      current_call_site = name;
+    }
+    ~CallSiteScope() {
+      current_call_site = prev_call_site_;
+    }
+
+  private:
+    friend class ThreadPool;
+
+    const char* prev_call_site_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CallSiteScope);
+
+    static thread_local const char* current_call_site;
+  };
+
   // Start and end a multi-loop parallel section.  Parallel loops can
   // be executed directly (without using this API), but entering a
   // parallel section allows the runtime system to amortize loop
@@ -222,6 +281,40 @@ class ThreadPool {
                   "Per-thread state should be trivially destructible");
   };
 
+  // Limits the worker threads that parallel loops entered by the calling
+  // thread may use while the scope is alive, e.g. for the duration of an
+  // InferenceSession::Run.  max_dop caps the degree of parallelism,
+  // including the calling thread; 0 means no cap.
+  //
+  // If partition is true, the scopes alive at the same time on the same
+  // pool use disjoint subsets of its worker threads.  The subsets are
+  // recomputed on entry to each parallel loop, so a scope picks up the
+  // workers released by scopes that ended.  Up to 64 scopes are
+  // partitioned at a time; further scopes may use all the workers.
+  //
+  // Scopes only affect the thread that created them, and have no effect
+  // when using OpenMP.
+
+  class RunScope {
+  public:
+    RunScope(ThreadPool* tp, int max_dop, bool partition);
+    ~RunScope();
+
+  private:
+    friend class ThreadPool;
+
+    ThreadPool* tp_;
+    int max_dop_;
+    // Bit of the scope in ThreadPool::partition_slots_, or -1.
+    int slot_ = -1;
+    RunScope* prev_run_scope_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunScope);
+
+    // Non-owning reference to the current thread's innermost scope
+    // (or nullptr outside scopes).
+    static thread_local RunScope* current_run_scope;
+  };
+
   // Schedules fn() for execution in the pool of threads.  The function may run
   // synchronously if it cannot be enqueued.  This will occur if the thread pool's
   // degree-of-parallelism is 1, but it may also occur for implementation-dependent
@@ -280,7 +373,7 @@ class ThreadPool {
 
   /**
    * Tries to call the given function in parallel, with calls split into (num_batches) batches.
-   *\param num_batches If it is zero, it will be replaced to the value of DegreeOfParallelism().
+   *\param num_batches If it is zero, it will be replaced to the value of DefaultNumBatches().
    *\param fn A std::function or STL style functor with signature of "void f(int32_t);"
    * Pitfall: Caller should cap `num_batches` to a reasonable value based on the cost of `fn` and the value of `total`.
    *For example, if fn is as simple as: int sum=0; fn = [&](int i){sum +=i;} and `total` is 100, then num_batches should
@@ -314,7 +407,7 @@ class ThreadPool {
     }
 
     if (num_batches <= 0) {
-      num_batches = std::min<ptrdiff_t>(total, DegreeOfParallelism(tp));
+      num_batches = DefaultNumBatches(tp, total);
     }
 
     if (num_batches <= 1) {
@@ -378,6 +471,12 @@ class ThreadPool {
   // working in combination with the thread initiating the loop.
   static int DegreeOfParallelism(const ThreadPool* tp);
 
+  // Return the number of batches that TryBatchParallelFor splits "total" units
+  // of work into by default.  This is the degree of parallelism, or a multiple
+  // of it on processors with cores of different speeds, so that the faster
+  // cores can pick up more batches.
+  static std::ptrdiff_t DefaultNumBatches(const ThreadPool* tp, std::ptrdiff_t total);
+
   ORT_DISALLOW_COPY_AND_ASSIGNMENT(ThreadPool);
 
  private:
@@ -387,6 +486,10 @@ class ThreadPool {
   // value returned by DegreeOfParallelism to code using the pool.
   int NumThreads() const;
 
+  // If the calling thread is in a partitioned RunScope of this pool, sets
+  // [begin, end) to the worker threads of its partition and returns true.
+  bool GetCallerWorkerRange(unsigned& begin, unsigned& end) const;
+
   // Returns current thread id between 0 and NumThreads() - 1, if called from a
   // thread in the pool. Returns -1 otherwise.
   int CurrentThreadId() const;
@@ -435,6 +538,13 @@ class ThreadPool {
 
   // If used, underlying_threadpool_ is instantiated and owned by the ThreadPool.
   std::unique_ptr<ThreadPoolTempl<Env> > extended_eigen_threadpool_;
+
+  // Bitmask of the partition slots taken by the partitioned RunScopes.
+  std::atomic<uint64_t> partition_slots_{0};
+
+  // The ParallelForStats per call site.
+  std::atomic<bool> stats_enabled_{false};
+  std::unique_ptr<ThreadPoolStats> stats_;
 };
 
 }  // namespace concurrency
@@ -30,6 +30,14 @@ extern "C" {
 
 ORT_API_STATUS(OrtSessionOptionsAppendExecutionProvider_Nnapi, _In_ OrtSessionOptions* options, uint32_t nnapi_flags);
 
+/**
+ * Same as OrtSessionOptionsAppendExecutionProvider_Nnapi, and additionally caches the NNAPI compilations in cache_dir,
+ * so that later sessions using the same model on the same device skip the compilation.
+ * The directory must exist and be writable by the application. NNAPI compilation caching needs Android API level 29+.
+ */
+ORT_API_STATUS(OrtSessionOptionsAppendExecutionProviderEx_Nnapi, _In_ OrtSessionOptions* options, uint32_t nnapi_flags,
+               _In_ const char* cache_dir);
+
 #ifdef __cplusplus
 }
 #endif
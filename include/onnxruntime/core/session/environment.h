@@ -10,6 +10,7 @@
 #include "core/platform/threadpool.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocator.h"
+#include "core/framework/prepacked_weights_container.h"
 
 struct OrtThreadingOptions;
 namespace onnxruntime {
@@ -74,6 +75,14 @@ class Environment {
     return shared_allocators_;
   }
 
+  /**
+   * Returns the container used to share pre-packed weights between sessions created with this env.
+   * Sessions only use it if kOrtSessionOptionsConfigUseEnvPrepackedWeights is set in their session options.
+  */
+  PrepackedWeightsContainer* GetPrepackedWeightsContainer() const {
+    return prepacked_weights_container_.get();
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Environment);
 
@@ -87,5 +96,6 @@ class Environment {
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
   bool create_global_thread_pools_{false};
   std::vector<AllocatorPtr> shared_allocators_;
+  std::unique_ptr<PrepackedWeightsContainer> prepacked_weights_container_;
 };
 }  // namespace onnxruntime
@@ -33,6 +33,7 @@ extern "C" {
 #define _Inout_updates_all_(X)
 #define _Out_writes_bytes_all_(X)
 #define _Out_writes_all_(X)
+#define _Out_writes_(X)
 #define _Success_(X)
 #define _Outptr_result_buffer_maybenull_(X)
 #define ORT_ALL_ARGS_NONNULL __attribute__((nonnull))
@@ -165,6 +166,7 @@ ORT_RUNTIME_CLASS(ModelMetadata);
 ORT_RUNTIME_CLASS(ThreadPoolParams);
 ORT_RUNTIME_CLASS(ThreadingOptions);
 ORT_RUNTIME_CLASS(ArenaCfg);
+ORT_RUNTIME_CLASS(RunHandle);
 
 #ifdef _WIN32
 typedef _Return_type_success_(return == 0) OrtStatus* OrtStatusPtr;
@@ -201,6 +203,14 @@ typedef void(ORT_API_CALL* OrtLoggingFunction)(
     void* param, OrtLoggingLevel severity, const char* category, const char* logid, const char* code_location,
     const char* message);
 
+// Invoked by RunAsync when the run completes. 'outputs' is the output array passed to RunAsync.
+// 'status' is nullptr on success. Otherwise it contains the error and must be released by the callback.
+typedef void(ORT_API_CALL* RunAsyncCallbackFn)(_In_opt_ void* user_data, _In_ OrtValue** outputs, size_t num_outputs,
+                                                _In_opt_ OrtStatusPtr status);
+
+// Invoked by KernelContext_ParallelFor for the iterations [begin, end), possibly concurrently on several threads.
+typedef void(ORT_API_CALL* OrtParallelForFn)(_In_opt_ void* user_data, size_t begin, size_t end);
+
 // Set Graph optimization level.
 // Refer https://github.com/microsoft/onnxruntime/blob/master/docs/ONNX_Runtime_Graph_Optimizations.md
 // for in-depth undersrtanding of Graph Optimizations in ORT
@@ -214,6 +224,12 @@ typedef enum GraphOptimizationLevel {
 typedef enum ExecutionMode {
   ORT_SEQUENTIAL = 0,
   ORT_PARALLEL = 1,
+  // Parallel execution where dependency tracking is lock-free, a thread continues with a ready successor of the node
+  // it just ran, and cheap nodes are run inline instead of being scheduled on the inter-op thread pool.
+  ORT_PARALLEL_WORK_STEALING = 2,
+  // Parallel execution for models partitioned between a device execution provider and the CPU. The CPU nodes are run
+  // on the inter-op thread pool while the thread calling Run launches the device nodes, so the two can overlap.
+  ORT_PARALLEL_HETEROGENEOUS = 3,
 } ExecutionMode;
 
 // Set the language projection, default is C, which means it will classify the language not in the list to C also.
@@ -273,12 +289,13 @@ typedef struct OrtCUDAProviderOptions {
 /// </summary>
 typedef struct OrtOpenVINOProviderOptions {
 #ifdef __cplusplus
-  OrtOpenVINOProviderOptions() : device_type{}, enable_vpu_fast_compile{}, device_id{}, num_of_threads{} {}
+  OrtOpenVINOProviderOptions() : device_type{}, enable_vpu_fast_compile{}, device_id{}, num_of_threads{}, num_streams{} {}
 #endif
   const char* device_type;                // CPU_FP32, GPU_FP32, GPU_FP16, MYRIAD_FP16, VAD-M_FP16 or VAD-F_FP32
   unsigned char enable_vpu_fast_compile;  // 0 = false, nonzero = true
   const char* device_id;
   size_t num_of_threads;  // 0 uses default number of threads
+  size_t num_streams;     // CPU/GPU throughput streams, 0 uses the device default
 } OrtOpenVINOProviderOptions;
 
 struct OrtApi;
@@ -1146,6 +1163,198 @@ struct OrtApi {
   */
   ORT_API2_STATUS(ModelMetadataGetGraphDescription, _In_ const OrtModelMetadata* model_metadata,
                   _Inout_ OrtAllocator* allocator, _Outptr_ char** value);
+
+  /**
+  * Use this API to create the configuration of an arena from key/value pairs. Keys that are not supplied
+  * use the ORT default.
+  * Supported keys are "max_mem", "arena_extend_strategy", "initial_chunk_size_bytes", "max_dead_bytes_per_chunk",
+  * "max_thread_cache_bytes" and "arena_type".
+  * \param arena_config_keys - keys to configure
+  * \param arena_config_values - the value for each key
+  * \param num_keys - number of keys
+  * \param out - a pointer to an OrtArenaCfg instance
+  * See docs/C_API.md for details on what the keys mean and how to choose their values
+  */
+  ORT_API2_STATUS(CreateArenaCfgV2, _In_reads_(num_keys) const char* const* arena_config_keys,
+                  _In_reads_(num_keys) const size_t* arena_config_values, _In_ size_t num_keys,
+                  _Outptr_ OrtArenaCfg** out);
+
+  /**
+  * Run the model without blocking the calling thread. The run is executed on a thread of the session's intra-op
+  * thread pool, which must have at least 2 threads, and run_async_callback is invoked on that thread when the run
+  * completes or fails. The callback is only invoked if this function returns nullptr.
+  * The input and output names and the input OrtValues are referenced by this call and may be released after it
+  * returns, however the data of the input tensors must remain valid until the callback is invoked.
+  * \param run_options - if not null it must remain valid until the callback is invoked.
+  *                      RunOptionsSetTerminate can be used to cancel the run.
+  * \param output - must remain valid until the callback is invoked. Null entries are allocated by the run
+  *                 and filled in before the callback is invoked.
+  * \param run_async_callback - must not release the session.
+  */
+  ORT_API2_STATUS(RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Inout_updates_all_(output_names_len) OrtValue** output,
+                  _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data);
+
+  /**
+  * Limit the number of intra-op threads, including the calling thread, that the kernels of Run calls using these
+  * run options may use. The default is 0, which uses all the threads of the session's intra-op thread pool.
+  * Only the kernels run on the calling thread are limited, i.e. with the sequential execution mode.
+  * See also the "session.intra_op.partition_concurrent_runs" session config key.
+  */
+  ORT_API2_STATUS(RunOptionsSetIntraOpNumThreads, _Inout_ OrtRunOptions* options, int intra_op_num_threads);
+
+  /**
+  * Run the model for batch_size independent requests in one call. The inputs of the requests are not concatenated,
+  * so they may have different shapes, and the requests are executed concurrently on the session's intra-op thread
+  * pool if it has threads.
+  * \param inputs - batch_size * input_len values. The inputs of request r are inputs[r * input_len + i].
+  * \param outputs - batch_size * output_names_len values laid out the same way. Null entries are allocated.
+  * Returns the status of the first request that failed, if any.
+  */
+  ORT_API2_STATUS(RunBatch, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(batch_size* input_len) const OrtValue* const* inputs, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  size_t batch_size, _Inout_updates_all_(batch_size* output_names_len) OrtValue** outputs);
+
+  /**
+  * Get the kernel latency statistics of the runs sampled with the "session.profiling.sample_interval_runs" session
+  * config key, as JSON: the number of sampled runs, and for each node and op type the number of samples and the
+  * mean, p50 and p99 latencies in microseconds. Fails if sampling is disabled.
+  * \param reset - if not 0 the statistics are cleared after they are read.
+  * \param out - a null-terminated string allocated with allocator. The caller frees it.
+  */
+  ORT_API2_STATUS(SessionGetLatencyStats, _In_ const OrtSession* sess, int reset, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /**
+  * Collect where the time of the Run and RunAsync calls using these run options goes, without enabling profiling.
+  * The cost is a clock read per node. See RunOptionsGetLatencyBreakdown.
+  * \param enable - 0 to stop collecting.
+  */
+  ORT_API2_STATUS(RunOptionsEnableLatencyBreakdown, _Inout_ OrtRunOptions* options, int enable);
+
+  /**
+  * Get the latency breakdown of the last completed Run or RunAsync call using these run options, as JSON, with the
+  * durations in microseconds: queue_us (RunAsync only), total_us, validation_us, input_copy_us, frame_setup_us,
+  * kernel_us, kernel_us_per_provider, memcpy_us, memcpy_nodes, output_copy_us and inter_op_wait_us (parallel
+  * execution modes). For RunAsync it is available when the callback is invoked.
+  * Fails if the breakdown is not enabled or no call completed yet.
+  * \param out - a null-terminated string allocated with allocator. The caller frees it.
+  */
+  ORT_API2_STATUS(RunOptionsGetLatencyBreakdown, _In_ const OrtRunOptions* options, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /**
+  * Create a session sharing the model, the kernels and the initializers (including the pre-packed weights) of an
+  * initialized session, without loading the model again. The clone owns its thread pools, logger and profiler.
+  * It uses the options of the source session, except for the logging, profiling and thread pool options, which it
+  * takes from options. The kernel events of the runs of the clone are recorded by the profiler of the source session.
+  * The source session must be released after its clones.
+  * \param options - may be null to use the default logging, profiling and thread pool options.
+  * \param out - the cloned session. Release it with ReleaseSession.
+  */
+  ORT_API2_STATUS(CloneSession, _In_ const OrtSession* session, _In_opt_ const OrtSessionOptions* options,
+                  _Outptr_ OrtSession** out);
+
+  /**
+  * Run the iterations [0, total) of a custom op kernel on the intra-op thread pool of the session, including the
+  * calling thread, and wait for them to complete. The iterations are split into ranges whose size is picked from
+  * cost_per_iteration, so cheap loops run in a few large ranges and small loops run inline.
+  * Must only be called from KernelCompute. fn must not throw.
+  * \param cost_per_iteration - the estimated number of CPU cycles each iteration takes.
+  */
+  ORT_API2_STATUS(KernelContext_ParallelFor, _In_ const OrtKernelContext* context, _In_ OrtParallelForFn fn,
+                  _In_opt_ void* user_data, size_t total, double cost_per_iteration);
+
+  /**
+  * Get the allocator for the scratch memory of a custom op kernel, which is the arena of its execution provider
+  * when the arena is enabled. The memory should be freed before KernelCompute returns.
+  * \param out - release it with ReleaseAllocator.
+  */
+  ORT_API2_STATUS(KernelContext_GetScratchAllocator, _In_ const OrtKernelContext* context,
+                  _Outptr_ OrtAllocator** out);
+
+  /**
+  * Set the maximum duration of the Run calls using these run options. A call fails before the next node once its
+  * timeout has passed. While other calls are running on the session, a call is rejected before it runs if the
+  * successful calls of the session took longer than its timeout on average, so that an overloaded session sheds
+  * the calls that would miss their deadline instead of slowing down all of them. A RunAsync call that waited longer
+  * than its timeout for a thread is not run.
+  * \param timeout_ms - 0, the default, for no timeout.
+  */
+  ORT_API2_STATUS(RunOptionsSetTimeout, _Inout_ OrtRunOptions* options, int64_t timeout_ms);
+
+  /**
+  * Get the calibration statistics of quantization of the tensors of the "session.calibration.tensor_names" session
+  * config key, recorded by the runs of the session, as JSON: for each recorded tensor its name, the number of values,
+  * min, max, the range and bin counts of the histogram of its absolute values, and the entropy calibrated threshold.
+  * Fails if the collection is disabled.
+  * \param reset - if not 0 the statistics are cleared after they are read.
+  * \param out - a null-terminated string allocated with allocator. The caller frees it.
+  */
+  ORT_API2_STATUS(SessionGetCalibrationStats, _In_ const OrtSession* sess, int reset, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
+
+  /**
+  * Create a handle of input and output names for RunWithHandle calls, which pass the input and output values by
+  * position. The names are validated and resolved once by this call, so that a run with the handle only checks the
+  * types and shapes of the inputs. The handle may be used by concurrent calls and must be released before the session.
+  * \param out - release it with ReleaseRunHandle.
+  */
+  ORT_API2_STATUS(CreateRunHandle, _In_ const OrtSession* sess,
+                  _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Outptr_ OrtRunHandle** out);
+
+  ORT_CLASS_RELEASE(RunHandle);
+
+  /**
+  * Run the model with the inputs and outputs of a handle created by CreateRunHandle for this session.
+  * \param input - the input values in the order of the input names of the handle.
+  * \param output - the output values in the order of the output names of the handle. Null entries are allocated.
+  */
+  ORT_API2_STATUS(RunWithHandle, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                  _In_ const OrtRunHandle* run_handle,
+                  _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                  _Inout_updates_all_(output_len) OrtValue** output, size_t output_len);
+
+  /**
+  * Point a tensor created by CreateTensorWithDataAsOrtValue at another buffer with another shape, so that the value
+  * can be reused across runs instead of being created and released for each of them. The element type and the
+  * memory info of the tensor are unchanged, and the storage of the shape is reused when the rank doesn't grow.
+  * The value must not be in use by a running session while it is updated. String tensors are not supported.
+  * \param p_data_len - the size of the buffer in bytes, which must be large enough for the shape.
+  */
+  ORT_API2_STATUS(UpdateTensorData, _Inout_ OrtValue* value, _Inout_ void* p_data, size_t p_data_len,
+                  _In_ const int64_t* shape, size_t shape_len);
+
+  /**
+  * Get the element types and the shapes of several tensors at once without allocating an OrtTensorTypeAndShapeInfo
+  * for each of them.
+  * \param element_types - receives the element type of each value.
+  * \param ranks - receives the number of dimensions of each value.
+  * \param dims - receives the dimensions of all the values one after another, in the order of the values.
+  * \param dims_len - the number of elements of dims, which must be at least the sum of the ranks.
+  */
+  ORT_API2_STATUS(GetTensorTypesAndShapes, _In_reads_(num_values) const OrtValue* const* values, size_t num_values,
+                  _Out_writes_(num_values) ONNXTensorElementDataType* element_types,
+                  _Out_writes_(num_values) size_t* ranks, _Out_writes_(dims_len) int64_t* dims, size_t dims_len);
+
+  /**
+  * Get the statistics of the parallel loops run on the thread pools of the session, collected with the
+  * "session.profiling.thread_pool_stats" session config key, as JSON: for the intra-op and inter-op thread pools
+  * their steal and spin counters, and for each op type that ran parallel loops the number of loops, shards, threads
+  * and shard steals, and the mean and max wall, busy, tail and wake-up times in microseconds and the mean imbalance
+  * between the threads. Fails if the collection is disabled.
+  * \param reset - if not 0 the loop statistics are cleared after they are read.
+  * \param out - a null-terminated string allocated with allocator. The caller frees it.
+  */
+  ORT_API2_STATUS(SessionGetThreadPoolStats, _In_ const OrtSession* sess, int reset, _Inout_ OrtAllocator* allocator,
+                  _Outptr_ char** out);
 };
 
 /*
@@ -1182,6 +1391,14 @@ struct OrtCustomOp {
   // Op kernel callbacks
   void(ORT_API_CALL* KernelCompute)(_In_ void* op_kernel, _In_ OrtKernelContext* context);
   void(ORT_API_CALL* KernelDestroy)(_In_ void* op_kernel);
+
+  // Optional, may be nullptr. Requires version 7. Called during session initialization for each input of the kernel
+  // that is a constant initializer, so the kernel can pre-pack it into the format its KernelCompute uses.
+  // The tensor is only valid during the call. Set *is_packed to 1 if KernelCompute no longer reads the input, which
+  // lets the session free the initializer.
+  // allocator remains valid until the kernel is destroyed, and the kernel must free what it allocates with it.
+  OrtStatusPtr(ORT_API_CALL* KernelPrePack)(_In_ void* op_kernel, _In_ const OrtValue* tensor, int input_index,
+                                            _Inout_ OrtAllocator* allocator, _Out_ int* is_packed);
 };
 
 /*
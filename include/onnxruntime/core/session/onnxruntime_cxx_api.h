@@ -22,6 +22,7 @@
 #include <vector>
 #include <utility>
 #include <type_traits>
+#include <unordered_map>
 
 #ifdef ORT_NO_EXCEPTIONS
 #include <iostream>
@@ -99,6 +100,7 @@ ORT_DEFINE_RELEASE(ModelMetadata);
 ORT_DEFINE_RELEASE(ThreadingOptions);
 ORT_DEFINE_RELEASE(IoBinding);
 ORT_DEFINE_RELEASE(ArenaCfg);
+ORT_DEFINE_RELEASE(RunHandle);
 
 /*! \class Ort::Float16_t
   * \brief it is a structure that represents float16 data.
@@ -288,6 +290,17 @@ struct RunOptions : Base<OrtRunOptions> {
   RunOptions& SetTerminate();
   // unset the terminate flag so this RunOptions instance can be used in a new Session::Run call
   RunOptions& UnsetTerminate();
+
+  // limit the intra-op threads used by Session::Run calls made using this RunOptions instance
+  RunOptions& SetIntraOpNumThreads(int intra_op_num_threads);
+
+  // fail or reject the Session::Run calls made using this RunOptions instance that take longer than timeout_ms
+  RunOptions& SetTimeout(int64_t timeout_ms);
+
+  // collect the latency breakdown of the Session::Run calls made using this RunOptions instance
+  RunOptions& EnableLatencyBreakdown(bool enable = true);
+  // the latency breakdown of the last completed call as JSON. see OrtApi::RunOptionsGetLatencyBreakdown
+  char* GetLatencyBreakdown(OrtAllocator* allocator) const;
 };
 
 struct SessionOptions : Base<OrtSessionOptions> {
@@ -356,6 +369,25 @@ struct Session : Base<OrtSession> {
 
   void Run(const RunOptions& run_options, const struct IoBinding&);
 
+  // Run without blocking the calling thread. See OrtApi::RunAsync. output_values must remain valid until the
+  // callback is invoked. Null entries in output_values are filled in by the run.
+  void RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                const char* const* output_names, Value* output_values, size_t output_count,
+                RunAsyncCallbackFn callback, void* user_data);
+
+  // Run batch_size independent requests in one call. See OrtApi::RunBatch. input_values and output_values hold
+  // batch_size * input_count and batch_size * output_count values, request after request.
+  void RunBatch(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                const char* const* output_names, Value* output_values, size_t output_count, size_t batch_size);
+
+  // Run with the inputs and outputs of a handle created for this session. See OrtApi::RunWithHandle.
+  // Null entries in output_values are filled in by the run.
+  void Run(const RunOptions& run_options, const struct RunHandle& run_handle, const Value* input_values,
+           size_t input_count, Value* output_values, size_t output_count);
+
+  // Create a session sharing the model, kernels and weights of this one. See OrtApi::CloneSession.
+  Session Clone(const SessionOptions& options) const;
+
   size_t GetInputCount() const;
   size_t GetOutputCount() const;
   size_t GetOverridableInitializerCount() const;
@@ -454,6 +486,15 @@ struct Value : Base<OrtValue> {
   TypeInfo GetTypeInfo() const;
   TensorTypeAndShapeInfo GetTensorTypeAndShapeInfo() const;
 
+  // Point a tensor created on user data at another buffer with another shape. See OrtApi::UpdateTensorData.
+  template <typename T>
+  void UpdateTensorData(T* p_data, size_t p_data_element_count, const int64_t* shape, size_t shape_len);
+  void UpdateTensorData(void* p_data, size_t p_data_byte_count, const int64_t* shape, size_t shape_len);
+
+  // Get the element types and shapes of several tensors at once. See OrtApi::GetTensorTypesAndShapes.
+  static void GetTensorTypesAndShapes(const Value* values, size_t num_values, ONNXTensorElementDataType* element_types,
+                                      size_t* ranks, int64_t* dims, size_t dims_len);
+
   size_t GetStringTensorElementLength(size_t element_index) const;
   void GetStringTensorElement(size_t buffer_length, size_t element_index, void* buffer) const;
 
@@ -553,6 +594,13 @@ struct IoBinding : public Base<OrtIoBinding> {
   void ClearBoundOutputs();
 };
 
+// The input and output names of Session::Run calls that pass the values by position. See OrtApi::CreateRunHandle.
+struct RunHandle : Base<OrtRunHandle> {
+  explicit RunHandle(std::nullptr_t) {}
+  RunHandle(const Session& session, const char* const* input_names, size_t input_count,
+            const char* const* output_names, size_t output_count);
+};
+
 /*! \struct Ort::ArenaCfg
   * \brief it is a structure that represents the configuration of an arena based allocator
   * \details Please see docs/C_API.md for details
@@ -568,6 +616,14 @@ struct ArenaCfg : Base<OrtArenaCfg> {
   * See docs/C_API.md for details on what the following parameters mean and how to choose these values
   */
   ArenaCfg(size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes, int max_dead_bytes_per_chunk);
+
+  /**
+  * \param arena_config - map of arena config keys ("max_mem", "arena_extend_strategy", "initial_chunk_size_bytes",
+  * "max_dead_bytes_per_chunk", "max_thread_cache_bytes", "arena_type") to values. Keys that are not supplied use
+  * the default.
+  * \return an instance of ArenaCfg
+  */
+  explicit ArenaCfg(const std::unordered_map<std::string, size_t>& arena_config);
 };
 
 //
@@ -598,6 +654,10 @@ struct CustomOpApi {
   const OrtValue* KernelContext_GetInput(const OrtKernelContext* context, _In_ size_t index);
   size_t KernelContext_GetOutputCount(const OrtKernelContext* context);
   OrtValue* KernelContext_GetOutput(OrtKernelContext* context, _In_ size_t index, _In_ const int64_t* dim_values, size_t dim_count);
+  void KernelContext_ParallelFor(const OrtKernelContext* context, OrtParallelForFn fn, void* user_data, size_t total,
+                                 double cost_per_iteration);
+  OrtAllocator* KernelContext_GetScratchAllocator(const OrtKernelContext* context);
+  void ReleaseAllocator(OrtAllocator* allocator);
 
   void ThrowOnError(OrtStatus* result);
 
@@ -622,6 +682,9 @@ struct CustomOpBase : OrtCustomOp {
 
     OrtCustomOp::KernelCompute = [](void* op_kernel, OrtKernelContext* context) { static_cast<TKernel*>(op_kernel)->Compute(context); };
     OrtCustomOp::KernelDestroy = [](void* op_kernel) { delete static_cast<TKernel*>(op_kernel); };
+
+    // Optional, a custom op whose kernel implements PrePack may set it in its constructor
+    OrtCustomOp::KernelPrePack = nullptr;
   }
 
   // Default implementation of GetExecutionProviderType that returns nullptr to default to the CPU provider
@@ -294,6 +294,19 @@ inline ArenaCfg::ArenaCfg(size_t max_mem, int arena_extend_strategy, int initial
   ThrowOnError(GetApi().CreateArenaCfg(max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk, &p_));
 }
 
+inline ArenaCfg::ArenaCfg(const std::unordered_map<std::string, size_t>& arena_config) {
+  std::vector<const char*> keys;
+  std::vector<size_t> values;
+  keys.reserve(arena_config.size());
+  values.reserve(arena_config.size());
+  for (const auto& entry : arena_config) {
+    keys.push_back(entry.first.c_str());
+    values.push_back(entry.second);
+  }
+
+  ThrowOnError(GetApi().CreateArenaCfgV2(keys.data(), values.data(), keys.size(), &p_));
+}
+
 inline Env::Env(OrtLoggingLevel logging_level, _In_ const char* logid) {
   ThrowOnError(GetApi().CreateEnv(logging_level, logid, &p_));
   if (strcmp(logid, "onnxruntime-node") == 0) {
@@ -395,6 +408,27 @@ inline RunOptions& RunOptions::UnsetTerminate() {
   return *this;
 }
 
+inline RunOptions& RunOptions::SetIntraOpNumThreads(int intra_op_num_threads) {
+  ThrowOnError(GetApi().RunOptionsSetIntraOpNumThreads(p_, intra_op_num_threads));
+  return *this;
+}
+
+inline RunOptions& RunOptions::SetTimeout(int64_t timeout_ms) {
+  ThrowOnError(GetApi().RunOptionsSetTimeout(p_, timeout_ms));
+  return *this;
+}
+
+inline RunOptions& RunOptions::EnableLatencyBreakdown(bool enable) {
+  ThrowOnError(GetApi().RunOptionsEnableLatencyBreakdown(p_, enable ? 1 : 0));
+  return *this;
+}
+
+inline char* RunOptions::GetLatencyBreakdown(OrtAllocator* allocator) const {
+  char* out;
+  ThrowOnError(GetApi().RunOptionsGetLatencyBreakdown(p_, allocator, &out));
+  return out;
+}
+
 inline SessionOptions::SessionOptions() {
   ThrowOnError(GetApi().CreateSessionOptions(&p_));
 }
@@ -524,6 +558,42 @@ inline void Session::Run(const RunOptions& run_options, const IoBinding& io_bind
   ThrowOnError(GetApi().RunWithBinding(p_, run_options, io_binding));
 }
 
+inline void Session::RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                              const char* const* output_names, Value* output_values, size_t output_count,
+                              RunAsyncCallbackFn callback, void* user_data) {
+  auto ort_input_values = reinterpret_cast<const OrtValue**>(const_cast<Value*>(input_values));
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(GetApi().RunAsync(p_, run_options, input_names, ort_input_values, input_count, output_names, output_count,
+                                 ort_output_values, callback, user_data));
+}
+
+inline void Session::RunBatch(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                              const char* const* output_names, Value* output_values, size_t output_count, size_t batch_size) {
+  auto ort_input_values = reinterpret_cast<const OrtValue**>(const_cast<Value*>(input_values));
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(GetApi().RunBatch(p_, run_options, input_names, ort_input_values, input_count, output_names, output_count,
+                                 batch_size, ort_output_values));
+}
+
+inline void Session::Run(const RunOptions& run_options, const RunHandle& run_handle, const Value* input_values,
+                         size_t input_count, Value* output_values, size_t output_count) {
+  auto ort_input_values = reinterpret_cast<const OrtValue**>(const_cast<Value*>(input_values));
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(GetApi().RunWithHandle(p_, run_options, run_handle, ort_input_values, input_count, ort_output_values,
+                                      output_count));
+}
+
+inline RunHandle::RunHandle(const Session& session, const char* const* input_names, size_t input_count,
+                            const char* const* output_names, size_t output_count) {
+  ThrowOnError(GetApi().CreateRunHandle(session, input_names, input_count, output_names, output_count, &p_));
+}
+
+inline Session Session::Clone(const SessionOptions& options) const {
+  Session clone{nullptr};
+  ThrowOnError(GetApi().CloneSession(p_, options, &clone.p_));
+  return clone;
+}
+
 inline size_t Session::GetInputCount() const {
   size_t out;
   ThrowOnError(GetApi().SessionGetInputCount(p_, &out));
@@ -847,6 +917,23 @@ inline TensorTypeAndShapeInfo Value::GetTensorTypeAndShapeInfo() const {
   return TensorTypeAndShapeInfo{output};
 }
 
+template <typename T>
+inline void Value::UpdateTensorData(T* p_data, size_t p_data_element_count, const int64_t* shape, size_t shape_len) {
+  UpdateTensorData(p_data, p_data_element_count * sizeof(T), shape, shape_len);
+}
+
+inline void Value::UpdateTensorData(void* p_data, size_t p_data_byte_count, const int64_t* shape, size_t shape_len) {
+  ThrowOnError(GetApi().UpdateTensorData(p_, p_data, p_data_byte_count, shape, shape_len));
+}
+
+inline void Value::GetTensorTypesAndShapes(const Value* values, size_t num_values,
+                                           ONNXTensorElementDataType* element_types, size_t* ranks, int64_t* dims,
+                                           size_t dims_len) {
+  static_assert(sizeof(Value) == sizeof(OrtValue*), "Value is really just an array of OrtValue* in memory, so we can reinterpret_cast safely");
+  auto ort_values = reinterpret_cast<const OrtValue* const*>(values);
+  ThrowOnError(GetApi().GetTensorTypesAndShapes(ort_values, num_values, element_types, ranks, dims, dims_len));
+}
+
 //
 // Custom OP API Inlines
 //
@@ -965,6 +1052,21 @@ inline OrtValue* CustomOpApi::KernelContext_GetOutput(OrtKernelContext* context,
   return out;
 }
 
+inline void CustomOpApi::KernelContext_ParallelFor(const OrtKernelContext* context, OrtParallelForFn fn,
+                                                   void* user_data, size_t total, double cost_per_iteration) {
+  ThrowOnError(api_.KernelContext_ParallelFor(context, fn, user_data, total, cost_per_iteration));
+}
+
+inline OrtAllocator* CustomOpApi::KernelContext_GetScratchAllocator(const OrtKernelContext* context) {
+  OrtAllocator* out;
+  ThrowOnError(api_.KernelContext_GetScratchAllocator(context, &out));
+  return out;
+}
+
+inline void CustomOpApi::ReleaseAllocator(OrtAllocator* allocator) {
+  api_.ReleaseAllocator(allocator);
+}
+
 inline SessionOptions& SessionOptions::DisablePerSessionThreads() {
   ThrowOnError(GetApi().DisablePerSessionThreads(p_));
   return *this;
@@ -24,6 +24,19 @@ static const char* const kOrtSessionOptionsConfigDisablePrepacking = "session.di
 // will be used. Use this to override the usage of env allocators on a per session level.
 static const char* const kOrtSessionOptionsConfigUseEnvAllocators = "session.use_env_allocators";
 
+// A value of "1" means pre-packed weights are shared with other sessions created with the same env that also set
+// this, e.g. when creating several sessions of the same model. The default is "0".
+// Identical pre-packed buffers created by kernels of the same type are stored once and freed when the last session
+// using them is released. This has no effect if pre-packing is disabled.
+static const char* const kOrtSessionOptionsConfigUseEnvPrepackedWeights = "session.use_env_prepacked_weights";
+
+// The precision the float Gemm and MatMul kernels of the CPU execution provider store their pre-packed constant weights
+// in: "FP32" (default), "FP16" or "BF16". The half precision formats halve the memory of the weights; the weights are
+// rounded when they are pre-packed and expanded to single precision block by block during the multiplication, so the
+// activations and the accumulation stay in single precision. FP16 keeps more mantissa bits but is limited to
+// magnitudes below 65504, while BF16 keeps the range of single precision. This has no effect if pre-packing is disabled.
+static const char* const kOrtSessionOptionsConfigCpuGemmWeightPrecision = "session.cpu_gemm_weight_precision";
+
 // Set to 'ORT' (case sensitive) to load an ORT format model.
 // If unset, model type will default to ONNX unless inferred from filename ('.ort' == ORT format) or bytes to be ORT
 static const char* const kOrtSessionOptionsConfigLoadModelFormat = "session.load_model_format";
@@ -32,6 +45,13 @@ static const char* const kOrtSessionOptionsConfigLoadModelFormat = "session.load
 // If unset, format will default to ONNX unless optimized_model_filepath ends in '.ort'.
 static const char* const kOrtSessionOptionsConfigSaveModelFormat = "session.save_model_format";
 
+// Compression of the initializers of a model saved in ORT format, to make the file smaller and faster to read.
+// 'NONE' (default), 'LZ4', or 'BYTE_SHUFFLE_LZ4' which groups the bytes of the elements before compressing them and
+// usually compresses float data better. Only initializers of 1KB or more that become smaller are compressed. The
+// initializers are decompressed when the model is loaded, so it requires a build that supports ORT format version 4.
+static const char* const kOrtSessionOptionsConfigOrtFormatInitializerCompression =
+    "session.ort_format_initializer_compression";
+
 // If a value is "1", flush-to-zero and denormal-as-zero are applied. The default is "0".
 // When multiple sessions are created, a main thread doesn't override changes from succeeding session options,
 // but threads in session thread pools follow option changes.
@@ -40,3 +60,207 @@ static const char* const kOrtSessionOptionsConfigSaveModelFormat = "session.save
 // Note that an alternative way not using this option at runtime is to train and export a model without denormals
 // and that's recommended because turning this option on may hurt model accuracy.
 static const char* const kOrtSessionOptionsConfigSetDenormalAsZero = "session.set_denormal_as_zero";
+
+// Maximum number of memory patterns to cache per graph when memory pattern optimization is enabled.
+// The least recently used pattern is evicted when the limit is exceeded. The default is "0" (unlimited).
+// Set this for models with dynamic input shapes to bound the memory used by the cache.
+static const char* const kOrtSessionOptionsConfigMemoryPatternCacheMaxEntries = "session.mem_pattern_cache.max_entries";
+
+// If set to a value greater than "1", input dimensions are rounded up to a multiple of this value when looking up a
+// cached memory pattern, e.g. with "32" all sequence lengths from 33 to 64 share one memory pattern.
+// A shared pattern is re-generated if it is too small for a later set of input shapes, so it grows to fit the largest
+// shapes seen in the bucket. The default is "0" (the exact input shapes are used).
+static const char* const kOrtSessionOptionsConfigMemoryPatternCacheDimBucketSize =
+    "session.mem_pattern_cache.dim_bucket_size";
+
+// A file to persist the memory patterns of the main graph in, e.g. next to the model file. The patterns saved in it
+// are loaded when the session is created, so the first run with a set of input shapes that was seen by an earlier
+// process allocates the intermediate tensors from a single block per device instead of tracing them. The file is
+// rewritten whenever a pattern for new input shapes is added. It is ignored with a warning if it was saved for a
+// different model, set of execution providers or dimension bucket size. A file that does not exist has no patterns.
+static const char* const kOrtSessionOptionsConfigMemoryPatternCacheFile = "session.mem_pattern_cache.file";
+
+// If set to "1" (the default), initializers with external data that are used on CPU are backed directly by a
+// copy-on-write memory mapping of the external data file. The pages are loaded lazily and are shared with other
+// processes mapping the same file, and no session memory is planned for these initializers.
+// Set to "0" to copy the external data into memory allocated by the session instead.
+// Initializers that are pre-packed by a kernel release their mapping once pre-packing is complete.
+static const char* const kOrtSessionOptionsConfigUseMmapForExternalInitializers =
+    "session.use_mmap_for_external_initializers";
+
+// If set to "1", each constant initializer on CPU is allocated on its own rather than in the memory planned for all the
+// initializers, so that its memory is freed as soon as the kernels consuming it have pre-packed it. This lowers the
+// memory used by models whose weights are mostly pre-packed, e.g. by MatMul, Gemm, Conv or LSTM, at the cost of an
+// allocation per initializer. The default is "0".
+// Kernels read constant inputs when they are created, so the initializers are still all deserialized when the session
+// is initialized.
+static const char* const kOrtSessionOptionsConfigFreePrepackedInitializers = "session.free_prepacked_initializers";
+
+// If set to "1", an ORT format model loaded from a file is memory mapped instead of being read into a buffer.
+// The default is "0".
+static const char* const kOrtSessionOptionsConfigUseMmapForOrtModel = "session.use_mmap_for_ort_model";
+
+// Directory of an initialization cache for ONNX models loaded from a file. The default is "" (no cache).
+// After the first initialization the optimized graph and its kernel assignments are saved to the directory in ORT
+// format, keyed by a hash of the model file, the ORT version, the execution providers, the session options and the
+// CPU features. A later session with the same key loads the cached graph and skips the graph optimizations and
+// partitioning. The weights pre-packed by the kernels that support it, e.g. MatMul and Gemm, are saved next to the entry
+// in a memory mapped file, and the later session uses them instead of pre-packing its initializers again.
+// The cache is skipped if the model is loaded from memory, if optimized_model_filepath is set, or if an execution
+// provider compiles nodes. Changes to external data files of the model are not detected.
+static const char* const kOrtSessionOptionsConfigInitializationCacheDir = "session.initialization_cache_dir";
+
+// Enable the fusion of chains of float elementwise nodes on the CPU and CUDA execution providers into FusedElementwise
+// nodes, which compute the whole chain in one pass over the data. The default is "0".
+// "0": disable. (default)
+// "1": fuse all chains of two or more nodes. Ignored if "session.profile_guided_fusion.trace_file" is set.
+static const char* const kOrtSessionOptionsConfigEnableElementwiseChainFusion =
+    "session.enable_elementwise_chain_fusion";
+
+// Path of a profile trace written by an earlier session of the model with profiling enabled. The default is "".
+// If set, chains of float elementwise nodes on the CPU or CUDA execution providers whose kernel time in the trace is at
+// least "session.profile_guided_fusion.min_time_percent" of the total kernel time are fused into a FusedElementwise
+// node.
+// The profile should come from a session with the same graph optimization level so the node names match.
+static const char* const kOrtSessionOptionsConfigProfileGuidedFusionTraceFile =
+    "session.profile_guided_fusion.trace_file";
+
+// The minimum share, in percent, of the total kernel time in the profile trace for an elementwise chain to be fused.
+// The default is "1". A value of "0" fuses all chains, including those that don't appear in the trace.
+static const char* const kOrtSessionOptionsConfigProfileGuidedFusionMinTimePercent =
+    "session.profile_guided_fusion.min_time_percent";
+
+// Key for disabling the optional in-place reuse of input buffers in the allocation planner.
+// Kernels that declare an input that may be updated in place (e.g. elementwise and activation kernels) write their
+// output to the buffer of that input when this node is its last consumer and the sizes match.
+// If the config value is set to "1" this reuse is disabled, otherwise it is enabled (default value).
+// Kernels whose output must alias an input (e.g. Reshape) are not affected.
+static const char* const kOrtSessionOptionsConfigDisableInplaceReuse = "session.disable_inplace_reuse";
+
+// The maximum size in bytes of an output of a node that is constant folded. Folding e.g. an Expand or Tile of a small
+// constant can create a large initializer, which increases the load time and the memory usage of the model.
+// The default is "0", which means there is no limit.
+static const char* const kOrtSessionOptionsConfigConstantFoldingMaxOutputBytes =
+    "session.constant_folding.max_output_bytes";
+
+// The maximum number of nodes in a group of connected nodes that the graph partitioner moves from another execution
+// provider to the CPU execution provider. A group is moved if all of its nodes have a CPU kernel and running it on
+// CPU needs fewer copies between devices, e.g. a single Shape or Cast node of a GPU provider between CPU nodes.
+// The default is "0", which disables moving nodes after the partitioning.
+static const char* const kOrtSessionOptionsConfigPartitionMaxCpuIslandSize = "session.partition.max_cpu_island_size";
+
+// The NUMA node to pin the threads of the per session intra-op thread pool to. The default is "-1", which doesn't pin
+// the threads. If set and the intra-op thread count is 0, the pool gets one thread per logical processor of the node.
+// Memory that the pool threads touch first, such as the arena chunks of large activations, is then allocated on the
+// node, so running one session per NUMA node avoids remote memory accesses. Only supported on Linux.
+static const char* const kOrtSessionOptionsConfigIntraOpNumaNode = "session.intra_op.numa_node";
+
+// How the idle threads of the per session thread pools wait for work when spinning is allowed. The default is "fixed".
+// "fixed": spin for a fixed number of iterations before blocking.
+// "latency": spin for about twice the recently observed gap between work items, up to 10ms, so parallel sections
+//            that follow each other closely don't have to wake the threads.
+// "efficiency": like "latency" but up to 0.2ms, so idle sessions stop using the CPU soon after the last request.
+// The spin hits and misses of the intra-op thread pool are logged at the INFO level when the session is destroyed.
+static const char* const kOrtSessionOptionsConfigThreadPoolSpinPolicy = "session.thread_pool.spin_policy";
+
+// If set to "1", the Run() calls that execute at the same time use disjoint subsets of the threads of the session's
+// intra-op thread pool, so concurrent requests don't compete for the same threads and caches. The subsets are
+// re-split as Run() calls start and finish. The default is "0", where every Run() may use all the threads.
+// Combine with OrtApi::RunOptionsSetIntraOpNumThreads to also cap the threads of a single request.
+static const char* const kOrtSessionOptionsConfigIntraOpPartitionConcurrentRuns =
+    "session.intra_op.partition_concurrent_runs";
+
+// Shrink the arenas of the session's execution providers after the first Run() and then every N runs, where N is
+// the value of this config. The default is "0", which never shrinks the arenas.
+// Each shrink returns the arena regions without chunks in use to the device, and replaces them with a single region
+// holding the peak memory usage since the previous shrink. The first shrink consolidates the regions the arena grew
+// by during the warmup run, so later runs with similar shapes are served from one region, and later ones release the
+// memory when the usage drops, e.g. after a request with an unusually large input.
+// The number of shrinks and the released bytes are reported in the AllocatorStats of the arena.
+static const char* const kOrtSessionOptionsConfigArenaShrinkIntervalRuns = "session.arena.shrink_interval_runs";
+
+// The arena used by the CPU execution provider that is added to the session by default. The default is "bfc".
+// "bfc": the best-fit with coalescing arena, see onnxruntime/core/framework/bfc_arena.h.
+// "mimalloc": an arena that serves each thread from its own mimalloc heap, which is usually faster for graphs with
+//             many small tensors. Only available in builds with mimalloc arena support, the BFC arena is used
+//             otherwise. Combine with session.arena.shrink_interval_runs set to "1" to return the memory freed by a
+//             Run() to the OS at its end.
+// Use OrtApi::CreateAndRegisterAllocator with the "arena_type" key of OrtApi::CreateArenaCfgV2 to select the arena
+// of an allocator shared between sessions.
+static const char* const kOrtSessionOptionsConfigCpuArenaType = "session.cpu_arena_type";
+
+// The size in bytes of a slab that each Run() allocates once from the CPU allocator to serve the small intermediate
+// tensors of the CPU execution provider, e.g. scalars, shapes and masks. The tensors are placed in the slab one after
+// the other without taking a lock and without freeing them, and the whole slab is freed when the Run() ends.
+// Tensors are allocated individually once the slab is full, and graph outputs are never placed in the slab.
+// The default is "0", which disables the slab. Also applies to the executions of subgraphs, e.g. of a Loop body.
+static const char* const kOrtSessionOptionsConfigSmallTensorSlabBytes = "session.small_tensor_slab_bytes";
+
+// The maximum size in bytes of a tensor that is allocated from the slab of session.small_tensor_slab_bytes.
+// The size includes the padding to the 256 byte alignment of tensor buffers. The default is "1024".
+static const char* const kOrtSessionOptionsConfigSmallTensorMaxBytes = "session.small_tensor_max_bytes";
+
+// Record the kernel latencies of 1 in N runs of the main graph, aggregated per node and per op type into histograms
+// of a fixed size, so it can be left enabled in production. Only the sequential execution mode is sampled.
+// The statistics are queried with OrtApi::SessionGetLatencyStats. The default is "0", which disables the sampling.
+// This is independent of the profiling enabled with OrtApi::EnableProfiling, which records every event of every run
+// to a trace file and can be started and ended on demand with InferenceSession::StartProfiling and EndProfiling.
+static const char* const kOrtSessionOptionsConfigProfilingSampleIntervalRuns = "session.profiling.sample_interval_runs";
+
+// Record the memory usage of each Run() to the profiling output while profiling is enabled with
+// OrtApi::EnableProfiling. "1" enables it, the default is "0".
+// The output has an event per allocation and release of a tensor with the decision of the allocation planner, an
+// event per node with the peak bytes of the live tensors during the node, and counters of the live tensor bytes per
+// device and of the bytes in use, the reserved bytes and the largest free chunk of each arena after each node.
+// Only the sequential execution mode records the per node events.
+static const char* const kOrtSessionOptionsConfigEnableMemoryProfiling = "session.enable_memory_profiling";
+
+// Count the instructions, cycles, cache references and cache misses of each node while profiling is enabled with
+// OrtApi::EnableProfiling, and add them to the profiling output along with the instructions per cycle, the memory
+// bandwidth estimated from the cache misses and, for MatMul, Gemm and Conv, the FLOP/s achieved for the FLOP count
+// estimated from the shapes. "1" enables it, the default is "0".
+// The counters include the thread pool threads that run the parallel loops of the node. Only the sequential execution
+// mode records them, and only on Linux if the process is permitted to use perf_event_open, i.e. if
+// /proc/sys/kernel/perf_event_paranoid is 2 or less. A warning is logged if they are not available.
+static const char* const kOrtSessionOptionsConfigProfilingHardwareCounters = "session.profiling.hardware_counters";
+
+// Collect statistics of the parallel loops run on the intra-op and inter-op thread pools of the session, per op type:
+// the number of loops, shards and threads, the busy time of the threads and the imbalance between them, the time
+// between the first and the last thread finishing, the blocks taken from the shards of other threads, and the time
+// until the helping threads start, i.e. their queueing and wake-up latency. "1" enables it, the default is "0".
+// The statistics are queried with OrtApi::SessionGetThreadPoolStats, and added to the profiling output when profiling
+// is enabled with OrtApi::EnableProfiling. The global thread pools of an env collect the loops of all its sessions
+// once a session enabled it. The cost is two clock reads per thread and a lock per parallel loop.
+static const char* const kOrtSessionOptionsConfigProfilingThreadPoolStats = "session.profiling.thread_pool_stats";
+
+// A tuning database file with the implementations chosen by kernels that benchmark alternatives, e.g. the MLAS
+// convolution algorithm for a shape and number of threads, or the cuDNN convolution algorithm found by the
+// exhaustive search. The records are loaded when the session is created and are used instead of the default
+// heuristics or searches. A file that does not exist has no records. The file is specific to the machine and the
+// versions it was tuned with. The records are shared by the sessions of the process.
+static const char* const kOrtSessionOptionsConfigTuningDatabaseFile = "session.tuning_database_file";
+
+// Benchmark the alternative implementations of kernels for the problems without a record in the tuning database,
+// and record the fastest, saving the database to session.tuning_database_file if it is set. "1" enables it, the
+// default is "0". The benchmark runs the first time a kernel sees a problem, so it slows down the warmup runs.
+// Tuning stays enabled for all the sessions of the process once a session enabled it.
+static const char* const kOrtSessionOptionsConfigEnableTuning = "session.enable_tuning";
+
+// If set to "1", the QDQ format of quantized models, i.e. the DequantizeLinear, op, QuantizeLinear groups exported by
+// quantization-aware training, is run as is with the float kernels. The default is "0": with the level 2 graph
+// optimizations enabled, the groups are fused into the integer kernels of the CPU execution provider, e.g.
+// QLinearConv and QLinearMatMul, and DequantizeLinear nodes are not constant folded so that the quantized weights
+// are kept.
+static const char* const kOrtSessionOptionsConfigDisableQuantQDQ = "session.disable_quant_qdq";
+
+// Collect the calibration statistics of quantization while the main graph runs, without adding outputs to the model:
+// the min, max, histogram of the absolute values and entropy calibrated threshold of the listed float and float16
+// graph inputs and node outputs. The value is a ';' separated list of tensor names, or "*" for all of them.
+// Only the sequential execution mode collects them. Tensors on other devices than the CPU are copied to the CPU to be
+// recorded. The statistics are queried with OrtApi::SessionGetCalibrationStats. The default is "", which disables the
+// collection.
+static const char* const kOrtSessionOptionsConfigCalibrationTensorNames = "session.calibration.tensor_names";
+
+// The number of bins of the histograms of session.calibration.tensor_names. Must be even and at least 256.
+// The default is "2048".
+static const char* const kOrtSessionOptionsConfigCalibrationHistogramBins = "session.calibration.histogram_bins";
@@ -15,6 +15,7 @@ import java.util.List;
 import java.util.Map;
 import java.util.Optional;
 import java.util.Set;
+import java.util.concurrent.CompletableFuture;
 import java.util.logging.Logger;
 
 /**
@@ -248,42 +249,94 @@ public class OrtSession implements AutoCloseable {
       Map<String, OnnxTensor> inputs, Set<String> requestedOutputs, RunOptions runOptions)
       throws OrtException {
     if (!closed) {
-      if (inputs.isEmpty() || (inputs.size() > numInputs)) {
-        throw new OrtException(
-            "Unexpected number of inputs, expected [1," + numInputs + ") found " + inputs.size());
-      }
-      if (requestedOutputs.isEmpty() || (requestedOutputs.size() > numOutputs)) {
+      long[] inputHandles = new long[inputs.size()];
+      String[] inputNamesArray = collectInputs(inputs, inputHandles);
+      String[] outputNamesArray = collectOutputNames(requestedOutputs);
+      long runOptionsHandle = runOptions == null ? 0 : runOptions.nativeHandle;
+
+      OnnxValue[] outputValues =
+          run(
+              OnnxRuntime.ortApiHandle,
+              nativeHandle,
+              allocator.handle,
+              inputNamesArray,
+              inputHandles,
+              inputNamesArray.length,
+              outputNamesArray,
+              new long[outputNamesArray.length],
+              outputNamesArray.length,
+              runOptionsHandle);
+      return new Result(outputNamesArray, outputValues);
+    } else {
+      throw new IllegalStateException("Trying to score a closed OrtSession.");
+    }
+  }
+
+  /**
+   * Scores an input feed dict, writing the inferred outputs into the supplied tensors.
+   *
+   * <p>See {@link #run(Map, Set, Map, RunOptions)}.
+   *
+   * @param inputs The inputs to score.
+   * @param pinnedOutputs The tensors to write the outputs into.
+   * @param runOptions The (possibly null) RunOptions to control this run.
+   * @return The inferred outputs, which are the supplied tensors.
+   * @throws OrtException If there was an error in native code, the input or output names are
+   *     invalid, or if there are zero or too many inputs or outputs.
+   */
+  public Result run(
+      Map<String, OnnxTensor> inputs, Map<String, OnnxTensor> pinnedOutputs, RunOptions runOptions)
+      throws OrtException {
+    return run(inputs, pinnedOutputs.keySet(), pinnedOutputs, runOptions);
+  }
+
+  /**
+   * Scores an input feed dict, returning the map of requested inferred outputs, and writing the
+   * outputs in pinnedOutputs into the supplied tensors rather than allocating new ones.
+   *
+   * <p>A pinned output must have the type and shape the model produces for these inputs. Create it
+   * with a direct buffer (e.g. {@link OnnxTensor#createTensor(OrtEnvironment, java.nio.FloatBuffer,
+   * long[])} with {@link java.nio.ByteBuffer#allocateDirect}) to read the output from the buffer
+   * without a copy, and reuse it across runs to avoid allocating an output per run. Direct buffers
+   * used as inputs are also used without a copy.
+   *
+   * <p>Closing the returned Result doesn't close the pinned outputs, which remain owned by the
+   * caller.
+   *
+   * @param inputs The inputs to score.
+   * @param requestedOutputs The requested outputs, which must contain the pinned outputs.
+   * @param pinnedOutputs The tensors to write the outputs with the same name into.
+   * @param runOptions The (possibly null) RunOptions to control this run.
+   * @return The inferred outputs.
+   * @throws OrtException If there was an error in native code, the input or output names are
+   *     invalid, or if there are zero or too many inputs or outputs.
+   */
+  public Result run(
+      Map<String, OnnxTensor> inputs,
+      Set<String> requestedOutputs,
+      Map<String, OnnxTensor> pinnedOutputs,
+      RunOptions runOptions)
+      throws OrtException {
+    if (!closed) {
+      if (!requestedOutputs.containsAll(pinnedOutputs.keySet())) {
         throw new OrtException(
-            "Unexpected number of requestedOutputs, expected [1,"
-                + numOutputs
-                + ") found "
-                + requestedOutputs.size());
+            "Pinned outputs "
+                + pinnedOutputs.keySet()
+                + " must be a subset of the requested outputs "
+                + requestedOutputs);
       }
-      String[] inputNamesArray = new String[inputs.size()];
       long[] inputHandles = new long[inputs.size()];
-      int i = 0;
-      for (Map.Entry<String, OnnxTensor> t : inputs.entrySet()) {
-        if (inputNames.contains(t.getKey())) {
-          inputNamesArray[i] = t.getKey();
-          inputHandles[i] = t.getValue().getNativeHandle();
-          i++;
-        } else {
-          throw new OrtException(
-              "Unknown input name " + t.getKey() + ", expected one of " + inputNames.toString());
-        }
-      }
-      String[] outputNamesArray = new String[requestedOutputs.size()];
-      i = 0;
-      for (String s : requestedOutputs) {
-        if (outputNames.contains(s)) {
-          outputNamesArray[i] = s;
-          i++;
-        } else {
-          throw new OrtException(
-              "Unknown output name " + s + ", expected one of " + outputNames.toString());
+      String[] inputNamesArray = collectInputs(inputs, inputHandles);
+      String[] outputNamesArray = collectOutputNames(requestedOutputs);
+      long runOptionsHandle = runOptions == null ? 0 : runOptions.nativeHandle;
+
+      long[] outputHandles = new long[outputNamesArray.length];
+      for (int i = 0; i < outputNamesArray.length; i++) {
+        OnnxTensor pinned = pinnedOutputs.get(outputNamesArray[i]);
+        if (pinned != null) {
+          outputHandles[i] = pinned.getNativeHandle();
         }
       }
-      long runOptionsHandle = runOptions == null ? 0 : runOptions.nativeHandle;
 
       OnnxValue[] outputValues =
           run(
@@ -294,14 +347,141 @@ public class OrtSession implements AutoCloseable {
               inputHandles,
               inputNamesArray.length,
               outputNamesArray,
+              outputHandles,
               outputNamesArray.length,
               runOptionsHandle);
-      return new Result(outputNamesArray, outputValues);
+      boolean[] owned = new boolean[outputNamesArray.length];
+      for (int i = 0; i < outputNamesArray.length; i++) {
+        OnnxTensor pinned = pinnedOutputs.get(outputNamesArray[i]);
+        if (pinned != null) {
+          outputValues[i] = pinned;
+        } else {
+          owned[i] = true;
+        }
+      }
+      return new Result(outputNamesArray, outputValues, owned);
+    } else {
+      throw new IllegalStateException("Trying to score a closed OrtSession.");
+    }
+  }
+
+  /**
+   * Scores an input feed dict without blocking the calling thread, returning a future of the map of
+   * all inferred outputs.
+   *
+   * <p>See {@link #runAsync(Map, Set, RunOptions)}.
+   *
+   * @param inputs The inputs to score.
+   * @return A future which completes with the inferred outputs.
+   * @throws OrtException If the input names are invalid, if there are zero or too many inputs, or
+   *     if the run could not be started.
+   */
+  public CompletableFuture<Result> runAsync(Map<String, OnnxTensor> inputs) throws OrtException {
+    return runAsync(inputs, outputNames, null);
+  }
+
+  /**
+   * Scores an input feed dict without blocking the calling thread, returning a future of the map of
+   * requested inferred outputs.
+   *
+   * <p>The run executes on the session's intra-op thread pool, which must have at least 2 threads
+   * (see {@link SessionOptions#setIntraOpNumThreads(int)}). The future is completed on that thread,
+   * so dependent actions should not block. The inputs and run options must not be closed until the
+   * future completes. Errors during the run complete the future exceptionally with an {@link
+   * OrtException}.
+   *
+   * @param inputs The inputs to score.
+   * @param requestedOutputs The requested outputs.
+   * @param runOptions The (possibly null) RunOptions to control this run.
+   * @return A future which completes with the inferred outputs.
+   * @throws OrtException If the input or output names are invalid, if there are zero or too many
+   *     inputs or outputs, or if the run could not be started.
+   */
+  public CompletableFuture<Result> runAsync(
+      Map<String, OnnxTensor> inputs, Set<String> requestedOutputs, RunOptions runOptions)
+      throws OrtException {
+    if (!closed) {
+      long[] inputHandles = new long[inputs.size()];
+      String[] inputNamesArray = collectInputs(inputs, inputHandles);
+      String[] outputNamesArray = collectOutputNames(requestedOutputs);
+      long runOptionsHandle = runOptions == null ? 0 : runOptions.nativeHandle;
+
+      RunAsyncCallback callback =
+          new RunAsyncCallback(allocator.handle, outputNamesArray, inputs, runOptions);
+      runAsync(
+          OnnxRuntime.ortApiHandle,
+          nativeHandle,
+          inputNamesArray,
+          inputHandles,
+          inputNamesArray.length,
+          outputNamesArray,
+          outputNamesArray.length,
+          runOptionsHandle,
+          callback);
+      return callback.future;
     } else {
       throw new IllegalStateException("Trying to score a closed OrtSession.");
     }
   }
 
+  /**
+   * Checks the inputs against the model and extracts their names and native handles.
+   *
+   * @param inputs The inputs to score.
+   * @param inputHandles Output array for the native handles, must have inputs.size() elements.
+   * @return The input names in the same order as inputHandles.
+   * @throws OrtException If the input names are invalid, or if there are zero or too many inputs.
+   */
+  private String[] collectInputs(Map<String, OnnxTensor> inputs, long[] inputHandles)
+      throws OrtException {
+    if (inputs.isEmpty() || (inputs.size() > numInputs)) {
+      throw new OrtException(
+          "Unexpected number of inputs, expected [1," + numInputs + ") found " + inputs.size());
+    }
+    String[] inputNamesArray = new String[inputs.size()];
+    int i = 0;
+    for (Map.Entry<String, OnnxTensor> t : inputs.entrySet()) {
+      if (inputNames.contains(t.getKey())) {
+        inputNamesArray[i] = t.getKey();
+        inputHandles[i] = t.getValue().getNativeHandle();
+        i++;
+      } else {
+        throw new OrtException(
+            "Unknown input name " + t.getKey() + ", expected one of " + inputNames.toString());
+      }
+    }
+    return inputNamesArray;
+  }
+
+  /**
+   * Checks the requested outputs against the model.
+   *
+   * @param requestedOutputs The requested outputs.
+   * @return The output names in the set traversal order.
+   * @throws OrtException If the output names are invalid, or if there are zero or too many outputs.
+   */
+  private String[] collectOutputNames(Set<String> requestedOutputs) throws OrtException {
+    if (requestedOutputs.isEmpty() || (requestedOutputs.size() > numOutputs)) {
+      throw new OrtException(
+          "Unexpected number of requestedOutputs, expected [1,"
+              + numOutputs
+              + ") found "
+              + requestedOutputs.size());
+    }
+    String[] outputNamesArray = new String[requestedOutputs.size()];
+    int i = 0;
+    for (String s : requestedOutputs) {
+      if (outputNames.contains(s)) {
+        outputNamesArray[i] = s;
+        i++;
+      } else {
+        throw new OrtException(
+            "Unknown output name " + s + ", expected one of " + outputNames.toString());
+      }
+    }
+    return outputNamesArray;
+  }
+
   /**
    * Gets the metadata for the currently loaded model.
    *
@@ -407,9 +587,11 @@ public class OrtSession implements AutoCloseable {
    * @param inputs The input tensors.
    * @param numInputs The number of inputs.
    * @param outputNamesArray The requested output names.
+   * @param outputs The pointers to the preallocated output tensors, zero for the outputs the run
+   *     allocates.
    * @param numOutputs The number of requested outputs.
    * @param runOptionsHandle The (possibly null) pointer to the run options.
-   * @return The OnnxValues produced by this run.
+   * @return The OnnxValues produced by this run, null for the preallocated outputs.
    * @throws OrtException If the native call failed in some way.
    */
   private native OnnxValue[] run(
@@ -420,10 +602,51 @@ public class OrtSession implements AutoCloseable {
       long[] inputs,
       long numInputs,
       String[] outputNamesArray,
+      long[] outputs,
       long numOutputs,
       long runOptionsHandle)
       throws OrtException;
 
+  /**
+   * The native async run call. Returns once the run is scheduled, callback.complete is invoked from
+   * a native thread when it finishes. runOptionsHandle can be zero (i.e. the null pointer), but all
+   * other handles must be valid pointers.
+   *
+   * @param apiHandle The pointer to the api.
+   * @param nativeHandle The pointer to the session.
+   * @param inputNamesArray The input names.
+   * @param inputs The input tensors.
+   * @param numInputs The number of inputs.
+   * @param outputNamesArray The requested output names.
+   * @param numOutputs The number of requested outputs.
+   * @param runOptionsHandle The (possibly null) pointer to the run options.
+   * @param callback The callback to complete.
+   * @throws OrtException If the run could not be scheduled.
+   */
+  private native void runAsync(
+      long apiHandle,
+      long nativeHandle,
+      String[] inputNamesArray,
+      long[] inputs,
+      long numInputs,
+      String[] outputNamesArray,
+      long numOutputs,
+      long runOptionsHandle,
+      RunAsyncCallback callback)
+      throws OrtException;
+
+  /**
+   * Converts the native output values of an async run into OnnxValues, taking ownership of them.
+   *
+   * @param apiHandle The pointer to the api.
+   * @param allocatorHandle The pointer to the allocator.
+   * @param outputHandles The pointers to the output values, zero for outputs that were not produced.
+   * @return The OnnxValues.
+   * @throws OrtException If the conversion failed.
+   */
+  private static native OnnxValue[] convertOutputs(
+      long apiHandle, long allocatorHandle, long[] outputHandles) throws OrtException;
+
   private native long getProfilingStartTimeInNs(long apiHandle, long nativeHandle)
       throws OrtException;
 
@@ -1088,6 +1311,47 @@ public class OrtSession implements AutoCloseable {
    * reference to a value after this object has been closed it will throw an {@link
    * IllegalStateException} upon access.
    */
+  /** Completes the future of a {@link #runAsync} call. Invoked from native code. */
+  private static final class RunAsyncCallback {
+    final CompletableFuture<Result> future = new CompletableFuture<>();
+    private final long allocatorHandle;
+    private final String[] outputNames;
+    // Referenced so they are not collected while the run is in flight.
+    private final Map<String, OnnxTensor> inputs;
+    private final RunOptions runOptions;
+
+    RunAsyncCallback(
+        long allocatorHandle,
+        String[] outputNames,
+        Map<String, OnnxTensor> inputs,
+        RunOptions runOptions) {
+      this.allocatorHandle = allocatorHandle;
+      this.outputNames = outputNames;
+      this.inputs = inputs;
+      this.runOptions = runOptions;
+    }
+
+    /**
+     * Called by the native callback when the run finishes.
+     *
+     * @param outputHandles The pointers to the output values.
+     * @param errorCode The error code if the run failed.
+     * @param message The error message, null if the run succeeded.
+     */
+    void complete(long[] outputHandles, int errorCode, String message) {
+      if (message != null) {
+        future.completeExceptionally(new OrtException(errorCode, message));
+        return;
+      }
+      try {
+        OnnxValue[] values = convertOutputs(OnnxRuntime.ortApiHandle, allocatorHandle, outputHandles);
+        future.complete(new Result(outputNames, values));
+      } catch (OrtException | RuntimeException e) {
+        future.completeExceptionally(e);
+      }
+    }
+  }
+
   public static class Result implements AutoCloseable, Iterable<Map.Entry<String, OnnxValue>> {
 
     private static final Logger logger = Logger.getLogger(Result.class.getName());
@@ -1096,6 +1360,9 @@ public class OrtSession implements AutoCloseable {
 
     private final List<OnnxValue> list;
 
+    /** The values closed by {@link #close}, i.e. all but the pinned outputs. */
+    private final List<OnnxValue> ownedValues;
+
     private boolean closed;
 
     /**
@@ -1105,6 +1372,18 @@ public class OrtSession implements AutoCloseable {
      * @param values The output values.
      */
     Result(String[] names, OnnxValue[] values) {
+      this(names, values, null);
+    }
+
+    /**
+     * Creates a Result from the names and values produced by {@link OrtSession#run(Map, Set, Map,
+     * RunOptions)}.
+     *
+     * @param names The output names.
+     * @param values The output values.
+     * @param owned Whether this Result owns the value at each index, null if it owns them all.
+     */
+    Result(String[] names, OnnxValue[] values, boolean[] owned) {
       map = new LinkedHashMap<>();
       list = new ArrayList<>();
 
@@ -1116,9 +1395,13 @@ public class OrtSession implements AutoCloseable {
                 + values.length);
       }
 
+      ownedValues = new ArrayList<>();
       for (int i = 0; i < names.length; i++) {
         map.put(names[i], values[i]);
         list.add(values[i]);
+        if (owned == null || owned[i]) {
+          ownedValues.add(values[i]);
+        }
       }
       this.closed = false;
     }
@@ -1127,7 +1410,7 @@ public class OrtSession implements AutoCloseable {
     public void close() {
       if (!closed) {
         closed = true;
-        for (OnnxValue t : map.values()) {
+        for (OnnxValue t : ownedValues) {
           t.close();
         }
       } else {
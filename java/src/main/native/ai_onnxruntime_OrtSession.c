@@ -3,6 +3,7 @@
  * Licensed under the MIT License.
  */
 #include <jni.h>
+#include <stdlib.h>
 #include <string.h>
 #include "onnxruntime/core/session/onnxruntime_c_api.h"
 #include "OrtJniUtil.h"
@@ -239,7 +240,7 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_getOutputInfo
  * private native OnnxValue[] run(long apiHandle, long nativeHandle, long allocatorHandle, String[] inputNamesArray, long[] inputs, long numInputs, String[] outputNamesArray, long numOutputs)
  */
 JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run
-  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong sessionHandle, jlong allocatorHandle, jobjectArray inputNamesArr, jlongArray tensorArr, jlong numInputs, jobjectArray outputNamesArr, jlong numOutputs, jlong runOptionsHandle) {
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong sessionHandle, jlong allocatorHandle, jobjectArray inputNamesArr, jlongArray tensorArr, jlong numInputs, jobjectArray outputNamesArr, jlongArray outputTensorArr, jlong numOutputs, jlong runOptionsHandle) {
     (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
     const OrtApi* api = (const OrtApi*) apiHandle;
     OrtAllocator* allocator = (OrtAllocator*) allocatorHandle;
@@ -266,12 +267,14 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run
     jlong* inputTensors = (*jniEnv)->GetLongArrayElements(jniEnv,tensorArr,NULL);
 
     // Extract the names of the output values, and allocate their output array.
+    // The non-zero output handles are preallocated tensors owned by Java which the run writes into.
+    jlong* preallocatedOutputs = (*jniEnv)->GetLongArrayElements(jniEnv,outputTensorArr,NULL);
     OrtValue** outputValues;
     checkOrtStatus(jniEnv,api,api->AllocatorAlloc(allocator,sizeof(OrtValue*)*numOutputs,(void**)&outputValues));
     for (int i = 0; i < numOutputs; i++) {
         javaOutputStrings[i] = (*jniEnv)->GetObjectArrayElement(jniEnv,outputNamesArr,i);
         outputNames[i] = (*jniEnv)->GetStringUTFChars(jniEnv,javaOutputStrings[i],NULL);
-        outputValues[i] = NULL;
+        outputValues[i] = (OrtValue*) preallocatedOutputs[i];
     }
 
     // Actually score the inputs.
@@ -287,14 +290,16 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run
     jobjectArray outputArray = (*jniEnv)->NewObjectArray(jniEnv,safecast_int64_to_jsize(numOutputs), onnxValueClass, NULL);
 
     // Convert the output tensors into ONNXValues and release the output strings.
+    // The preallocated outputs are already wrapped by OnnxTensors, their entries are left null.
     for (int i = 0; i < numOutputs; i++) {
-        if (outputValues[i] != NULL) {
+        if (outputValues[i] != NULL && preallocatedOutputs[i] == 0) {
             jobject onnxValue = convertOrtValueToONNXValue(jniEnv,api,allocator,outputValues[i]);
             (*jniEnv)->SetObjectArrayElement(jniEnv,outputArray,i,onnxValue);
         }
         (*jniEnv)->ReleaseStringUTFChars(jniEnv,javaOutputStrings[i],outputNames[i]);
     }
     checkOrtStatus(jniEnv,api,api->AllocatorFree(allocator,outputValues));
+    (*jniEnv)->ReleaseLongArrayElements(jniEnv,outputTensorArr,preallocatedOutputs,JNI_ABORT);
 
     // Release the Java input strings
     for (int i = 0; i < numInputs; i++) {
@@ -311,6 +316,177 @@ JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_run
 }
 
 
+/*
+ * State of an async run, owned by runAsyncCallback once RunAsync succeeds.
+ */
+typedef struct RunAsyncContext {
+    JavaVM* jvm;
+    const OrtApi* api;
+    jobject callback; // global reference to the OrtSession.RunAsyncCallback
+    OrtValue** outputValues;
+} RunAsyncContext;
+
+static void releaseRunAsyncContext(JNIEnv* jniEnv, RunAsyncContext* context) {
+    (*jniEnv)->DeleteGlobalRef(jniEnv, context->callback);
+    free(context->outputValues);
+    free(context);
+}
+
+/*
+ * Invoked by onnxruntime on the thread which executed the run, hands the outputs or the error to
+ * RunAsyncCallback.complete.
+ */
+static void ORT_API_CALL runAsyncCallback(void* userData, OrtValue** outputs, size_t numOutputs, OrtStatusPtr status) {
+    RunAsyncContext* context = (RunAsyncContext*) userData;
+    const OrtApi* api = context->api;
+    JavaVM* jvm = context->jvm;
+
+    // The run executes on an onnxruntime thread, which needs to be attached to the JVM.
+    // It's attached for the duration of the callback as the thread may exit without notifying us.
+    JNIEnv* jniEnv = NULL;
+    int attached = 0;
+    if ((*jvm)->GetEnv(jvm, (void**)&jniEnv, JNI_VERSION_1_6) == JNI_EDETACHED) {
+#ifdef __ANDROID__
+        jint result = (*jvm)->AttachCurrentThread(jvm, &jniEnv, NULL);
+#else
+        jint result = (*jvm)->AttachCurrentThread(jvm, (void**)&jniEnv, NULL);
+#endif
+        if (result != JNI_OK) {
+            // Can't deliver the result, release the outputs so they don't leak.
+            if (status != NULL) {
+                api->ReleaseStatus(status);
+            } else {
+                for (size_t i = 0; i < numOutputs; i++) {
+                    api->ReleaseValue(outputs[i]);
+                }
+            }
+            return;
+        }
+        attached = 1;
+    }
+
+    jsize count = safecast_size_t_to_jsize(numOutputs);
+    jlongArray outputHandles = (*jniEnv)->NewLongArray(jniEnv, count);
+    jint errorCode = 0;
+    jstring message = NULL;
+    if (status != NULL) {
+        errorCode = convertErrorCode(api->GetErrorCode(status));
+        message = (*jniEnv)->NewStringUTF(jniEnv, api->GetErrorMessage(status));
+        api->ReleaseStatus(status);
+    } else {
+        for (jsize i = 0; i < count; i++) {
+            jlong handle = (jlong) outputs[i];
+            (*jniEnv)->SetLongArrayRegion(jniEnv, outputHandles, i, 1, &handle);
+        }
+    }
+
+    jclass callbackClass = (*jniEnv)->GetObjectClass(jniEnv, context->callback);
+    jmethodID complete = (*jniEnv)->GetMethodID(jniEnv, callbackClass, "complete", "([JILjava/lang/String;)V");
+    (*jniEnv)->CallVoidMethod(jniEnv, context->callback, complete, outputHandles, errorCode, message);
+    if ((*jniEnv)->ExceptionCheck(jniEnv)) {
+        // There is no Java caller to propagate this to.
+        (*jniEnv)->ExceptionDescribe(jniEnv);
+        (*jniEnv)->ExceptionClear(jniEnv);
+    }
+
+    (*jniEnv)->DeleteLocalRef(jniEnv, callbackClass);
+    (*jniEnv)->DeleteLocalRef(jniEnv, outputHandles);
+    if (message != NULL) {
+        (*jniEnv)->DeleteLocalRef(jniEnv, message);
+    }
+    releaseRunAsyncContext(jniEnv, context);
+
+    if (attached) {
+        (*jvm)->DetachCurrentThread(jvm);
+    }
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession
+ * Method:    runAsync
+ * Signature: (JJ[Ljava/lang/String;[JJ[Ljava/lang/String;JJLai/onnxruntime/OrtSession$RunAsyncCallback;)V
+ * private native void runAsync(long apiHandle, long nativeHandle, String[] inputNamesArray, long[] inputs, long numInputs, String[] outputNamesArray, long numOutputs, long runOptionsHandle, RunAsyncCallback callback)
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtSession_runAsync
+  (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong sessionHandle, jobjectArray inputNamesArr, jlongArray tensorArr, jlong numInputs, jobjectArray outputNamesArr, jlong numOutputs, jlong runOptionsHandle, jobject callback) {
+    (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    OrtSession* session = (OrtSession*) sessionHandle;
+    OrtRunOptions* runOptions = (OrtRunOptions*) runOptionsHandle;
+
+    // RunAsync copies the names and the input values, so these buffers are released once it returns.
+    const char** inputNames = malloc(sizeof(char*)*numInputs);
+    jobject* javaInputStrings = malloc(sizeof(jobject)*numInputs);
+    for (int i = 0; i < numInputs; i++) {
+        javaInputStrings[i] = (*jniEnv)->GetObjectArrayElement(jniEnv,inputNamesArr,i);
+        inputNames[i] = (*jniEnv)->GetStringUTFChars(jniEnv,javaInputStrings[i],NULL);
+    }
+    const char** outputNames = malloc(sizeof(char*)*numOutputs);
+    jobject* javaOutputStrings = malloc(sizeof(jobject)*numOutputs);
+    for (int i = 0; i < numOutputs; i++) {
+        javaOutputStrings[i] = (*jniEnv)->GetObjectArrayElement(jniEnv,outputNamesArr,i);
+        outputNames[i] = (*jniEnv)->GetStringUTFChars(jniEnv,javaOutputStrings[i],NULL);
+    }
+    jlong* inputTensors = (*jniEnv)->GetLongArrayElements(jniEnv,tensorArr,NULL);
+
+    // The output array must stay valid until the callback is invoked.
+    RunAsyncContext* context = malloc(sizeof(RunAsyncContext));
+    (*jniEnv)->GetJavaVM(jniEnv, &context->jvm);
+    context->api = api;
+    context->callback = (*jniEnv)->NewGlobalRef(jniEnv, callback);
+    context->outputValues = calloc(numOutputs == 0 ? 1 : numOutputs, sizeof(OrtValue*));
+
+    OrtStatus* status = api->RunAsync(session, runOptions, (const char* const*) inputNames, (const OrtValue* const*) inputTensors, numInputs,
+                                      (const char* const*) outputNames, numOutputs, context->outputValues, runAsyncCallback, context);
+
+    (*jniEnv)->ReleaseLongArrayElements(jniEnv,tensorArr,inputTensors,JNI_ABORT);
+    for (int i = 0; i < numInputs; i++) {
+        (*jniEnv)->ReleaseStringUTFChars(jniEnv,javaInputStrings[i],inputNames[i]);
+    }
+    for (int i = 0; i < numOutputs; i++) {
+        (*jniEnv)->ReleaseStringUTFChars(jniEnv,javaOutputStrings[i],outputNames[i]);
+    }
+    free((void*)inputNames);
+    free(javaInputStrings);
+    free((void*)outputNames);
+    free(javaOutputStrings);
+
+    if (status != NULL) {
+        // The callback is only invoked if the run was scheduled.
+        releaseRunAsyncContext(jniEnv, context);
+        checkOrtStatus(jniEnv, api, status);
+    }
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtSession
+ * Method:    convertOutputs
+ * Signature: (JJ[J)[Lai/onnxruntime/OnnxValue;
+ */
+JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtSession_convertOutputs
+  (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle, jlong allocatorHandle, jlongArray outputHandles) {
+    (void) jclazz; // Required JNI parameter not needed by functions which don't need to access their host object.
+    const OrtApi* api = (const OrtApi*) apiHandle;
+    OrtAllocator* allocator = (OrtAllocator*) allocatorHandle;
+
+    jsize numOutputs = (*jniEnv)->GetArrayLength(jniEnv, outputHandles);
+    jlong* outputValues = (*jniEnv)->GetLongArrayElements(jniEnv, outputHandles, NULL);
+
+    char *onnxValueClassName = "ai/onnxruntime/OnnxValue";
+    jclass onnxValueClass = (*jniEnv)->FindClass(jniEnv, onnxValueClassName);
+    jobjectArray outputArray = (*jniEnv)->NewObjectArray(jniEnv, numOutputs, onnxValueClass, NULL);
+
+    for (jsize i = 0; i < numOutputs; i++) {
+        if (outputValues[i] != 0) {
+            jobject onnxValue = convertOrtValueToONNXValue(jniEnv,api,allocator,(OrtValue*)outputValues[i]);
+            (*jniEnv)->SetObjectArrayElement(jniEnv,outputArray,i,onnxValue);
+        }
+    }
+    (*jniEnv)->ReleaseLongArrayElements(jniEnv, outputHandles, outputValues, JNI_ABORT);
+
+    return outputArray;
+}
+
 /*
  * Class:     ai_onnxruntime_OrtSession
  * Method:    getProfilingStartTimeInNs
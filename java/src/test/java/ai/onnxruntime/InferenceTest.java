@@ -8,6 +8,7 @@ import static org.junit.jupiter.api.Assertions.assertArrayEquals;
 import static org.junit.jupiter.api.Assertions.assertEquals;
 import static org.junit.jupiter.api.Assertions.assertFalse;
 import static org.junit.jupiter.api.Assertions.assertNotNull;
+import static org.junit.jupiter.api.Assertions.assertSame;
 import static org.junit.jupiter.api.Assertions.assertTrue;
 import static org.junit.jupiter.api.Assertions.fail;
 
@@ -33,6 +34,7 @@ import java.nio.file.Path;
 import java.nio.file.Paths;
 import java.util.ArrayList;
 import java.util.Arrays;
+import java.util.Collections;
 import java.util.EnumSet;
 import java.util.HashMap;
 import java.util.HashSet;
@@ -40,6 +42,8 @@ import java.util.Iterator;
 import java.util.List;
 import java.util.Map;
 import java.util.Set;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutionException;
 import java.util.concurrent.ExecutorService;
 import java.util.concurrent.Executors;
 import java.util.concurrent.TimeUnit;
@@ -525,6 +529,42 @@ public class InferenceTest {
     }
   }
 
+  @Test
+  public void runAsyncTest() throws OrtException, InterruptedException, ExecutionException {
+    String modelPath = getResourcePath("/squeezenet.onnx").toString();
+
+    try (OrtEnvironment env = OrtEnvironment.getEnvironment("runAsyncTest");
+        SessionOptions options = new SessionOptions()) {
+      // runAsync requires an intra-op thread pool with at least 2 threads
+      options.setIntraOpNumThreads(2);
+
+      try (OrtSession session = env.createSession(modelPath, options)) {
+        NodeInfo inputMeta = session.getInputInfo().values().iterator().next();
+        float[] inputData = loadTensorFromFile(getResourcePath("/bench.in"));
+        Object tensorData =
+            OrtUtil.reshape(inputData, ((TensorInfo) inputMeta.getInfo()).getShape());
+        try (OnnxTensor inputTensor = OnnxTensor.createTensor(env, tensorData)) {
+          Map<String, OnnxTensor> container = new HashMap<>();
+          container.put(inputMeta.getName(), inputTensor);
+
+          List<CompletableFuture<Result>> futures = new ArrayList<>();
+          futures.add(session.runAsync(container));
+          futures.add(session.runAsync(container));
+
+          float[] expectedOutput = loadTensorFromFile(getResourcePath("/bench.expected_out"));
+          for (CompletableFuture<Result> future : futures) {
+            try (Result results = future.get()) {
+              assertEquals(1, results.size());
+              OnnxTensor resultTensor = (OnnxTensor) results.get(0);
+              float[] resultArray = TestHelpers.flattenFloat(resultTensor.getValue());
+              assertArrayEquals(expectedOutput, resultArray, 1e-6f);
+            }
+          }
+        }
+      }
+    }
+  }
+
   @Test
   public void throwWrongInputName() throws OrtException {
     SqueezeNetTuple tuple = openSessionSqueezeNet();
@@ -971,6 +1011,43 @@ public class InferenceTest {
     }
   }
 
+  @Test
+  public void testPinnedOutputs() throws OrtException {
+    // model takes 1x5 input of fixed type, echoes back
+    String modelPath = getResourcePath("/test_types_FLOAT.pb").toString();
+
+    try (OrtEnvironment env = OrtEnvironment.getEnvironment("testPinnedOutputs");
+        SessionOptions options = new SessionOptions();
+        OrtSession session = env.createSession(modelPath, options)) {
+      String inputName = session.getInputNames().iterator().next();
+      String outputName = session.getOutputNames().iterator().next();
+      long[] shape = new long[] {1, 5};
+      FloatBuffer inputBuffer =
+          ByteBuffer.allocateDirect(5 * 4).order(ByteOrder.nativeOrder()).asFloatBuffer();
+      FloatBuffer outputBuffer =
+          ByteBuffer.allocateDirect(5 * 4).order(ByteOrder.nativeOrder()).asFloatBuffer();
+
+      try (OnnxTensor input = OnnxTensor.createTensor(env, inputBuffer, shape);
+          OnnxTensor output = OnnxTensor.createTensor(env, outputBuffer, shape)) {
+        Map<String, OnnxTensor> inputs = Collections.singletonMap(inputName, input);
+        Map<String, OnnxTensor> outputs = Collections.singletonMap(outputName, output);
+        // the buffers are reused across the runs
+        for (int i = 0; i < 3; i++) {
+          float[] inputArr = new float[] {i, -2.0f * i, 3.0f, -4.0f, 5.0f + i};
+          inputBuffer.put(inputArr);
+          inputBuffer.rewind();
+          try (OrtSession.Result res = session.run(inputs, outputs, null)) {
+            assertSame(output, res.get(0));
+            float[] resultArray = new float[5];
+            outputBuffer.get(resultArray);
+            outputBuffer.rewind();
+            assertArrayEquals(inputArr, resultArray, 1e-6f);
+          }
+        }
+      }
+    }
+  }
+
   @Test
   public void testRunOptions() throws OrtException {
     // model takes 1x5 input of fixed type, echoes back
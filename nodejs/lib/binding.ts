@@ -5,7 +5,7 @@ import {InferenceSession as InferenceSessionInterface} from './inference-session
 import {OnnxValue} from './onnx-value';
 
 /**
- * Binding exports a simple synchronized inference session object wrap.
+ * Binding exports a simple inference session object wrap. run() executes on the libuv thread pool.
  */
 export declare namespace Binding {
   export interface InferenceSession {
@@ -18,7 +18,7 @@ export declare namespace Binding {
     readonly outputNames: string[];
 
     run(feeds: InferenceSession.FeedsType, fetches: InferenceSession.FetchesType,
-        options: InferenceSession.RunOptions): InferenceSession.ReturnType;
+        options: InferenceSession.RunOptions): Promise<InferenceSession.ReturnType>;
   }
 
   export namespace InferenceSession {
@@ -107,23 +107,20 @@ class InferenceSession implements InferenceSessionInterface {
 
     // feeds, fetches and options are prepared
 
-    // promise start here
-    //
-    //
-    return new Promise((resolve, reject) => {
-      process.nextTick(() => {
-        try {
-          const returnValue: {[name: string]: OnnxValue} = {};
-          const results = this.#session.run(feeds, fetches, options);
-          for (const key in results) {
-            returnValue[key] = new Tensor(results[key].type, results[key].data, results[key].dims);
-          }
-          resolve(returnValue);
-        } catch (e) {
-          // reject if any error is thrown
-          reject(e);
-        }
-      });
+    // the run executes on the libuv thread pool, the JS thread is not blocked
+    let run: Promise<Binding.InferenceSession.ReturnType>;
+    try {
+      run = this.#session.run(feeds, fetches, options);
+    } catch (e) {
+      // reject if the feeds or fetches can't be converted
+      return Promise.reject(e);
+    }
+    return run.then(results => {
+      const returnValue: {[name: string]: OnnxValue} = {};
+      for (const key in results) {
+        returnValue[key] = new Tensor(results[key].type, results[key].data, results[key].dims);
+      }
+      return returnValue;
     });
   }
 
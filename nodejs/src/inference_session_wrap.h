@@ -41,11 +41,12 @@ private:
   Napi::Value GetOutputNames(const Napi::CallbackInfo &info);
 
   /**
-   * [sync] run the model.
+   * [async] run the model on the libuv thread pool. input and pre-allocated output tensors use the memory of their
+   * typed arrays without a copy, and the typed arrays of the other outputs are backed by the memory of the output.
    * @param arg0 input object: all keys must present, value is object
    * @param arg1 output object: at least one key must present, value can be null.
-   * @returns an object that every output specified will present and value must be object
-   * @throw error if status code != 0
+   * @returns a promise of an object that every output specified will present and value must be object
+   * @throw error if the inputs or outputs are invalid. the promise is rejected if status code != 0
    */
   Napi::Value Run(const Napi::CallbackInfo &info);
 
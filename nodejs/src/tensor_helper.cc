@@ -247,10 +247,17 @@ Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value &value) {
     returnValue.Set("data", Napi::Value(env, stringArray));
   } else {
     // number data
-    // TODO: optimize memory
-    auto arrayBuffer = Napi::ArrayBuffer::New(env, size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType]);
-    if (size > 0) {
-      memcpy(arrayBuffer.Data(), value.GetTensorMutableData<void>(), size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType]);
+    // the ArrayBuffer takes over the tensor and releases it when it is collected, so the data is not copied
+    size_t byteLength = size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType];
+    Napi::ArrayBuffer arrayBuffer;
+    if (byteLength > 0) {
+      std::unique_ptr<Ort::Value> ownedValue(new Ort::Value(std::move(value)));
+      arrayBuffer = Napi::ArrayBuffer::New(
+          env, ownedValue->GetTensorMutableData<void>(), byteLength,
+          [](Napi::Env /*env*/, void * /*data*/, Ort::Value *hint) { delete hint; }, ownedValue.get());
+      ownedValue.release();
+    } else {
+      arrayBuffer = Napi::ArrayBuffer::New(env, 0);
     }
     napi_value typedArrayData;
     napi_status status =
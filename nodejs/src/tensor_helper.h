@@ -11,5 +11,6 @@
 // convert a Javascript OnnxValue object to an OrtValue object
 Ort::Value NapiValueToOrtValue(Napi::Env env, Napi::Value value);
 
-// convert an OrtValue object to a Javascript OnnxValue object
+// convert an OrtValue object to a Javascript OnnxValue object.
+// the typed array of a numeric tensor takes over the OrtValue, which is left empty.
 Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value &value);
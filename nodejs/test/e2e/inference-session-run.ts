@@ -23,4 +23,20 @@ describe('E2E Tests - InferenceSession.run()', async () => {
       assertTensorEqual(result.softmaxout_1, expectedOutput0);
     }
   }).timeout('120s');
+
+  it('concurrent run() calls', async () => {
+    const results = await Promise.all(
+        Array.from({length: 16}, () => session!.run({'data_0': input0}, ['softmaxout_1'])));
+    for (const result of results) {
+      assertTensorEqual(result.softmaxout_1, expectedOutput0);
+    }
+  }).timeout('120s');
+
+  it('run() into a pre-allocated output', async () => {
+    const output0 = new Tensor('float32', new Float32Array(1000), [1, 1000, 1, 1]);
+    const result = await session!.run({'data_0': input0}, {'softmaxout_1': output0});
+    // the output is written into the typed array of the pre-allocated tensor
+    assertTensorEqual(output0, expectedOutput0);
+    assertTensorEqual(result.softmaxout_1, expectedOutput0);
+  }).timeout('120s');
 });
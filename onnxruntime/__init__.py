@@ -26,7 +26,8 @@ from onnxruntime.capi._pybind_state import get_all_providers, get_available_prov
     NodeArg, ModelMetadata, GraphOptimizationLevel, ExecutionMode, ExecutionOrder, OrtDevice, SessionIOBinding, \
     OrtAllocatorType, OrtMemType, OrtArenaCfg, OrtMemoryInfo, create_and_register_allocator
 
-from onnxruntime.capi.onnxruntime_inference_collection import InferenceSession, IOBinding, OrtValue
+from onnxruntime.capi.onnxruntime_inference_collection import InferenceSession, IOBinding, OrtValue, \
+    ReplicatedInferenceSession
 from onnxruntime.capi import onnxruntime_validation
 
 from onnxruntime.capi.training import *  # noqa: F403
@@ -8,6 +8,7 @@
 #include <memory.h>
 
 using onnxruntime::rnn::detail::Allocate;
+using onnxruntime::rnn::detail::GemmWeights;
 
 namespace onnxruntime {
 namespace contrib {
@@ -20,6 +21,7 @@ BahdanauAttention<T>::BahdanauAttention(AllocatorPtr allocator, const logging::L
   values_ = Allocate(allocator_, batch_size_ * max_memory_steps_ * memory_depth_, values_ptr_, true);
   keys_ = Allocate(allocator_, batch_size_ * max_memory_steps_ * attn_depth_, keys_ptr_, true);
   processed_query_ = Allocate(allocator_, batch_size_ * attn_depth_, processed_query_ptr_, true);
+  scores_ = Allocate(allocator_, batch_size_ * max_memory_steps_ * attn_depth_, scores_ptr_, false);
   mem_seq_lengths_ = Allocate(allocator_, batch_size_, mem_seq_lengths_ptr_, true);
 
   ORT_ENFORCE(!normalize_, "not support normalize yet.");
@@ -28,13 +30,24 @@ BahdanauAttention<T>::BahdanauAttention(AllocatorPtr allocator, const logging::L
 template <typename T>
 void BahdanauAttention<T>::SetWeights(
     const gsl::span<const T>& attn_weights,
-    const gsl::span<const T>& query_layer_weights,
-    const gsl::span<const T>& memory_layer_weights) {
+    const GemmWeights<T>& query_layer_weights,
+    const GemmWeights<T>& memory_layer_weights) {
   attention_v_ = attn_weights;                   //[attn_depth_]
   query_layer_weights_ = query_layer_weights;    //[query_depth_, attn_depth_]
   memory_layer_weights_ = memory_layer_weights;  //[memory_depth_, attn_depth_]
 }
 
+// C[M, N] = A[M, K] * weights[K, N], with the weights packed by MlasGemmPackB when they are prepacked.
+static void ProjectLayer(int M, int N, int K, const float* A, const GemmWeights<float>& weights, float* C,
+                         concurrency::ThreadPool* thread_pool) {
+  if (weights.is_prepacked_) {
+    MlasGemm(CblasNoTrans, M, N, K, 1.0f, A, K, weights.buffer_, 0.0f, C, N, thread_pool);
+  } else {
+    math::GemmEx<float>(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A, K,
+                        static_cast<const float*>(weights.buffer_), N, 0.0f, C, N, thread_pool);
+  }
+}
+
 template <typename T>
 const gsl::span<const T> BahdanauAttention<T>::Values() const {
   return values_;
@@ -72,35 +85,8 @@ void BahdanauAttention<T>::PrepareMemory(
                 "Real memory steps ", mem_steps, " is not in (0, ", max_memory_steps_, "]");
   }
 
-  math::GemmEx<T>(CblasNoTrans, CblasNoTrans,
-                  batch_size_ * max_memory_steps_, attn_depth_, memory_depth_, T{1.0},
-                  memory.data(), memory_depth_,
-                  memory_layer_weights_.data(), attn_depth_, T{0.0},
-                  keys_.data(), attn_depth_, ttp_);
-}
-
-template <typename T>
-static void SoftmaxInplace(const gsl::span<T>& alignments) {
-  T* x = alignments.data();
-  size_t len = alignments.size();
-
-  double sum = 0.0;
-
-  for (size_t i = 0; i < len; i++) {
-    T e = exp(x[i]);
-    sum += e;
-    x[i] = e;
-  }
-
-  if (sum == 0.0) {
-    for (size_t i = 0; i < len; i++) {
-      x[i] = static_cast<T>(1.0 / len);
-    }
-  } else {
-    for (size_t i = 0; i < len; i++) {
-      x[i] = static_cast<T>(x[i] / sum);
-    }
-  }
+  ProjectLayer(batch_size_ * max_memory_steps_, attn_depth_, memory_depth_,
+               memory.data(), memory_layer_weights_, keys_.data(), ttp_);
 }
 
 /**
@@ -115,43 +101,43 @@ void BahdanauAttention<T>::Compute(
     const gsl::span<T>& output,
     const gsl::span<T>& aligns) const {
   //process query in dense query layer without bias
-  math::GemmEx<T>(CblasNoTrans, CblasNoTrans,
-                  batch_size_, attn_depth_, query_depth_, T{1.0},
-                  queries.data(), query_depth_,
-                  query_layer_weights_.data(), attn_depth_, T{0.0},
-                  processed_query_.data(), attn_depth_, ttp_);
+  ProjectLayer(batch_size_, attn_depth_, query_depth_, queries.data(), query_layer_weights_,
+               processed_query_.data(), ttp_);
 
   std::fill(aligns.begin(), aligns.end(), T{});
 
-  // return math_ops.reduce_sum(v * math_ops.tanh(keys + processed_query), [2])
-  for (int b = 0; b < batch_size_; b++) {
-    T* alignments = aligns.data() + b * max_memory_steps_;
-    const T* keys = keys_.data() + b * max_memory_steps_ * attn_depth_;
-    const T* query = processed_query_.data() + b * attn_depth_;
-
-    int mem_steps = mem_seq_lengths_[b];
-    for (int step = 0; step < mem_steps; step++) {
-      const T* keys_on_step = keys + step * attn_depth_;
-      T* dest = alignments + step;
-
-      // reduce_sum(v * tanh(keys[step] + query)) on last dimension
-      *dest = T(0.0);
-      for (int i = 0; i < attn_depth_; i++) {
-        *dest += (attention_v_[i] * tanh(keys_on_step[i] + query[i]));
+  // The batches are scored in parallel, each on a single thread.
+  const double cost = static_cast<double>(max_memory_steps_) * (attn_depth_ * 4 + memory_depth_ * 2);
+
+  concurrency::ThreadPool::TryParallelFor(ttp_, batch_size_, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (std::ptrdiff_t b = first; b < last; b++) {
+      T* alignments = aligns.data() + b * max_memory_steps_;
+      const T* keys = keys_.data() + b * max_memory_steps_ * attn_depth_;
+      const T* query = processed_query_.data() + b * attn_depth_;
+      T* scores = scores_.data() + b * max_memory_steps_ * attn_depth_;
+      const int mem_steps = mem_seq_lengths_[b];
+
+      // return math_ops.reduce_sum(v * math_ops.tanh(keys + processed_query), [2])
+      for (int step = 0; step < mem_steps; step++) {
+        const T* keys_on_step = keys + step * attn_depth_;
+        T* scores_on_step = scores + step * attn_depth_;
+        for (int i = 0; i < attn_depth_; i++) {
+          scores_on_step[i] = keys_on_step[i] + query[i];
+        }
       }
-    }
+      MlasComputeTanh(scores, scores, static_cast<size_t>(mem_steps) * attn_depth_);
+      math::Gemv<T, CPUMathUtil>(CblasNoTrans, mem_steps, attn_depth_, 1.0f, scores, attention_v_.data(),
+                                 0.0f, alignments, &CPUMathUtil::Instance());
 
-    SoftmaxInplace(gsl::span<T>{alignments, gsl::narrow_cast<gsl::index>(mem_steps)});
+      MlasComputeSoftmax(alignments, alignments, 1, mem_steps, false, nullptr);
 
-    // Calculate the context
-    auto outspan = output.subspan(b * memory_depth_);
-    auto values = values_.subspan(b * max_memory_steps_ * memory_depth_);
-    math::GemmEx<T>(CblasNoTrans, CblasNoTrans,
-                    1, memory_depth_, max_memory_steps_, T{1.0},
-                    alignments, max_memory_steps_,
-                    values.data(), memory_depth_, T{0.0},
-                    outspan.data(), memory_depth_, ttp_);
-  }
+      // Calculate the context from the steps in the memory, the alignments of the padding steps are zero.
+      T* context = output.data() + b * memory_depth_;
+      const T* values = values_.data() + b * max_memory_steps_ * memory_depth_;
+      math::Gemv<T, CPUMathUtil>(CblasTrans, mem_steps, memory_depth_, 1.0f, values, alignments,
+                                 0.0f, context, &CPUMathUtil::Instance());
+    }
+  });
 }
 
 template class BahdanauAttention<float>;
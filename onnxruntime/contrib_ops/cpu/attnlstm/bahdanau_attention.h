@@ -25,10 +25,11 @@ class BahdanauAttention : public IAttentionMechanism<T> {
       int attn_depth,
       bool normalize, concurrency::ThreadPool* threadpool);
 
+  // The query and memory layer weights are each either the [depth, attn_depth] matrix or its MLAS packed form.
   void SetWeights(
       const gsl::span<const T>& attn_weights,
-      const gsl::span<const T>& query_layer_weights,
-      const gsl::span<const T>& memory_layer_weights);
+      const rnn::detail::GemmWeights<T>& query_layer_weights,
+      const rnn::detail::GemmWeights<T>& memory_layer_weights);
 
   ~BahdanauAttention() override = default;
 
@@ -61,8 +62,8 @@ class BahdanauAttention : public IAttentionMechanism<T> {
   int attn_depth_;
 
   gsl::span<const T> attention_v_;
-  gsl::span<const T> query_layer_weights_;
-  gsl::span<const T> memory_layer_weights_;
+  rnn::detail::GemmWeights<T> query_layer_weights_;
+  rnn::detail::GemmWeights<T> memory_layer_weights_;
 
   IAllocatorUniquePtr<T> keys_ptr_;
   gsl::span<T> keys_;
@@ -73,6 +74,10 @@ class BahdanauAttention : public IAttentionMechanism<T> {
   IAllocatorUniquePtr<T> processed_query_ptr_;
   gsl::span<T> processed_query_;
 
+  // tanh(keys + processed_query) of each batch, [batch_size_, max_memory_step_, attn_depth_]
+  IAllocatorUniquePtr<T> scores_ptr_;
+  gsl::span<T> scores_;
+
   IAllocatorUniquePtr<int> mem_seq_lengths_ptr_;
   gsl::span<int> mem_seq_lengths_;
 
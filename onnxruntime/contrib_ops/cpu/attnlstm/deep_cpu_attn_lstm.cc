@@ -30,6 +30,82 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<int32_t>()),
     DeepCpuAttnLstmOp);
 
+using ::onnxruntime::rnn::detail::GemmWeights;
+using ::onnxruntime::rnn::detail::PackedWeights;
+
+Status DeepCpuAttnLstmOp::TryPackWeights(const Tensor& weights, PackedWeights& packed_weights, bool& is_packed,
+                                         AllocatorPtr alloc) {
+  const auto& shape = weights.Shape();
+  if (shape.NumDimensions() != 3 || shape[0] != num_directions_) {
+    return Status::OK();
+  }
+
+  // query layer weights: [num_directions, query_depth, am_attn_size]
+  // memory layer weights: [num_directions, memory_depth, am_attn_size]
+  const size_t K = static_cast<size_t>(shape[1]);
+  const size_t N = static_cast<size_t>(shape[2]);
+
+  const size_t packed_weights_size = MlasGemmPackBSize(N, K);
+  if (packed_weights_size == 0) {
+    return Status::OK();
+  }
+
+  auto* packed_weights_data = alloc->Alloc(SafeInt<size_t>(packed_weights_size) * num_directions_);
+  packed_weights.buffer_ = BufferUniquePtr(packed_weights_data, BufferDeleter(alloc));
+  packed_weights.weights_size_ = packed_weights_size;
+  packed_weights.shape_ = shape;
+
+  const auto* weights_data = weights.Data<float>();
+  for (int i = 0; i < num_directions_; i++) {
+    MlasGemmPackB(CblasNoTrans, N, K, weights_data, N, packed_weights_data);
+    packed_weights_data = static_cast<uint8_t*>(packed_weights_data) + packed_weights_size;
+    weights_data += N * K;
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+Status DeepCpuAttnLstmOp::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                                  /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  if (tensor.IsDataType<float>()) {
+    PackedWeights* packed_weights = nullptr;
+    if (input_idx == 8) {
+      packed_weights = &packed_query_layer_weights_;
+    } else if (input_idx == 9) {
+      packed_weights = &packed_memory_layer_weights_;
+    }
+
+    if (packed_weights != nullptr) {
+      ORT_RETURN_IF_ERROR(TryPackWeights(tensor, *packed_weights, is_packed, alloc));
+      if (is_packed && prepacked_weights != nullptr) {
+        prepacked_weights->buffers_.push_back(std::move(packed_weights->buffer_));
+        prepacked_weights->buffer_sizes_.push_back(packed_weights->weights_size_ * num_directions_);
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+Status DeepCpuAttnLstmOp::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                    int input_idx,
+                                                    /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 8) {
+    used_shared_buffers = true;
+    packed_query_layer_weights_.buffer_ = std::move(prepacked_buffers[0]);
+  } else if (input_idx == 9) {
+    used_shared_buffers = true;
+    packed_memory_layer_weights_.buffer_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
 Status
 DeepCpuAttnLstmOp::Compute(OpKernelContext* context) const {
   const Tensor& X = *context->Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
@@ -97,22 +173,30 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
 
   // Processing attention wrapper
   const int first_attn_input = 8;
-  const Tensor& am_query_layer_weights = *context.Input<Tensor>(first_attn_input + 0);   // [num_directions, query_depth(hidden_size of lstm), am_attn_size]
-  const Tensor& am_memory_layer_weights = *context.Input<Tensor>(first_attn_input + 1);  // [num_directions, memory_depth, am_attn_size]
+  // the query and memory layer weights are not inputs once they are prepacked
+  const Tensor* am_query_layer_weights =
+      packed_query_layer_weights_.buffer_ ? nullptr : context.Input<Tensor>(first_attn_input + 0);  // [num_directions, query_depth(hidden_size of lstm), am_attn_size]
+  const Tensor* am_memory_layer_weights =
+      packed_memory_layer_weights_.buffer_ ? nullptr : context.Input<Tensor>(first_attn_input + 1);  // [num_directions, memory_depth, am_attn_size]
   const Tensor& am_v_weights = *context.Input<Tensor>(first_attn_input + 2);             // [num_directions, am_attn_size]
   const Tensor& attn_memory = *context.Input<Tensor>(first_attn_input + 3);              // [batch_size, max_memory_step, memory_depth_]
   const Tensor* attn_memory_seq_lens = context.Input<Tensor>(first_attn_input + 4);      // [batch_size], int value
   const Tensor* attn_layer_weights = context.Input<Tensor>(first_attn_input + 5);        // [num_directions, memory_depth+cell_hidden_size, aw_attn_size]
 
+  const auto& am_query_layer_shape =
+      (am_query_layer_weights != nullptr) ? am_query_layer_weights->Shape() : packed_query_layer_weights_.shape_;
+  const auto& am_memory_layer_shape =
+      (am_memory_layer_weights != nullptr) ? am_memory_layer_weights->Shape() : packed_memory_layer_weights_.shape_;
+
   Status status = ValidateInputs(
       X, W, R, B, sequence_lens, initial_h, initial_c, P, batch_size,
-      am_query_layer_weights, am_memory_layer_weights, am_v_weights, attn_memory, attn_memory_seq_lens, attn_layer_weights);
+      am_query_layer_shape, am_memory_layer_shape, am_v_weights, attn_memory, attn_memory_seq_lens, attn_layer_weights);
   ORT_RETURN_IF_ERROR(status);
 
   const int max_memory_step = gsl::narrow<int>(attn_memory.Shape()[1]);
-  const int memory_depth = gsl::narrow<int>(am_memory_layer_weights.Shape()[1]);
-  const int am_attn_size = gsl::narrow<int>(am_memory_layer_weights.Shape()[2]);
-  const int query_depth = gsl::narrow<int>(am_query_layer_weights.Shape()[1]);  // it is equal to hidden_size
+  const int memory_depth = gsl::narrow<int>(am_memory_layer_shape[1]);
+  const int am_attn_size = gsl::narrow<int>(am_memory_layer_shape[2]);
+  const int query_depth = gsl::narrow<int>(am_query_layer_shape[1]);  // it is equal to hidden_size
   const bool has_attention_layer = attn_layer_weights != nullptr;
   const int attn_layer_depth = has_attention_layer ? gsl::narrow<int>(attn_layer_weights->Shape()[2]) : 0;
   const int attention_size = has_attention_layer ? attn_layer_depth : memory_depth;
@@ -120,6 +204,11 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
   const gsl::span<const T> attn_layer_weights_span = (has_attention_layer) ? attn_layer_weights->DataAsSpan<T>() : gsl::span<const T>();
   const gsl::span<const int> memory_seq_lens_span = (attn_memory_seq_lens != nullptr) ? attn_memory_seq_lens->DataAsSpan<int>() : gsl::span<const int>();
 
+  const T* query_layer_weights = (am_query_layer_weights != nullptr) ? am_query_layer_weights->Data<T>() : nullptr;
+  const T* memory_layer_weights = (am_memory_layer_weights != nullptr) ? am_memory_layer_weights->Data<T>() : nullptr;
+  const size_t query_layer_weights_size_per_direction = static_cast<size_t>(query_depth) * am_attn_size;
+  const size_t memory_layer_weights_size_per_direction = static_cast<size_t>(memory_depth) * am_attn_size;
+
   // LSTM outputs are optional but must be in the same order
   std::vector<int64_t> Y_dims{seq_length, num_directions_, batch_size, hidden_size_};
   Tensor* Y = context.Output(/*index*/ 0, Y_dims);
@@ -208,6 +297,11 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
   concurrency::ThreadPool* thread_pool = context.GetOperatorThreadPool();
 
   if (direction_ == Direction::kBidirectional) {
+    // The directions are independent. When the pool has no more threads than there are directions, a thread for each
+    // direction does better than splitting the small GEMMs of each step between the threads.
+    const bool parallel_directions = concurrency::ThreadPool::DegreeOfParallelism(thread_pool) <= num_directions_;
+    concurrency::ThreadPool* direction_thread_pool = parallel_directions ? nullptr : thread_pool;
+
     // spans for second direction
     gsl::span<const T> input_weights_2 = input_weights.subspan(input_weights_size_per_direction,
                                                                input_weights_size_per_direction);
@@ -243,12 +337,12 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
         memory_depth,
         query_depth,
         am_attn_size,
-        false, thread_pool);
+        false, direction_thread_pool);
 
     fam.SetWeights(
         FirstHalfSpan(am_v_weights.DataAsSpan<T>()),
-        FirstHalfSpan(am_query_layer_weights.DataAsSpan<T>()),
-        FirstHalfSpan(am_memory_layer_weights.DataAsSpan<T>()));
+        GemmWeights<T>(0, query_layer_weights, query_layer_weights_size_per_direction, packed_query_layer_weights_),
+        GemmWeights<T>(0, memory_layer_weights, memory_layer_weights_size_per_direction, packed_memory_layer_weights_));
     fam.PrepareMemory(attn_memory.DataAsSpan<T>(), memory_seq_lens_span);
 
     AttentionWrapper<T> faw(
@@ -259,7 +353,7 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
         attn_layer_depth,
         hidden_size_,
         has_attention_layer,
-        fam, thread_pool);
+        fam, direction_thread_pool);
     faw.SetWeights(FirstHalfSpan(attn_layer_weights_span));
 
     UniDirectionalAttnLstm<T> fw(
@@ -270,7 +364,7 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
         activation_funcs_.Entries()[0],
         activation_funcs_.Entries()[1],
         activation_funcs_.Entries()[2],
-        clip_, thread_pool);
+        clip_, direction_thread_pool);
 
     BahdanauAttention<T> bam(
         alloc,
@@ -280,11 +374,11 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
         memory_depth,
         query_depth,
         am_attn_size,
-        false, thread_pool);
+        false, direction_thread_pool);
     bam.SetWeights(
         SecondHalfSpan(am_v_weights.DataAsSpan<T>()),
-        SecondHalfSpan(am_query_layer_weights.DataAsSpan<T>()),
-        SecondHalfSpan(am_memory_layer_weights.DataAsSpan<T>()));
+        GemmWeights<T>(1, query_layer_weights, query_layer_weights_size_per_direction, packed_query_layer_weights_),
+        GemmWeights<T>(1, memory_layer_weights, memory_layer_weights_size_per_direction, packed_memory_layer_weights_));
     bam.PrepareMemory(attn_memory.DataAsSpan<T>(), memory_seq_lens_span);
 
     AttentionWrapper<T> baw(
@@ -295,7 +389,7 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
         attn_layer_depth,
         hidden_size_,
         has_attention_layer,
-        bam, thread_pool);
+        bam, direction_thread_pool);
     baw.SetWeights(SecondHalfSpan(attn_layer_weights_span));
 
     UniDirectionalAttnLstm<T> bw(
@@ -306,10 +400,20 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
         activation_funcs_.Entries()[3],
         activation_funcs_.Entries()[4],
         activation_funcs_.Entries()[5],
-        clip_, thread_pool);
-
-    fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
-    bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2, output_2, hidden_output_2, last_cell_2);
+        clip_, direction_thread_pool);
+
+    if (parallel_directions) {
+      concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, num_directions_, [&](std::ptrdiff_t direction) {
+        if (direction == 0) {
+          fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
+        } else {
+          bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2, output_2, hidden_output_2, last_cell_2);
+        }
+      });
+    } else {
+      fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1, output_1, hidden_output_1, last_cell_1);
+      bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, hidden_weights_2, output_2, hidden_output_2, last_cell_2);
+    }
 
   } else {
     BahdanauAttention<T> fam(
@@ -324,8 +428,8 @@ Status DeepCpuAttnLstmOp::ComputeImpl(OpKernelContext& context) const {
 
     fam.SetWeights(
         am_v_weights.DataAsSpan<T>(),
-        am_query_layer_weights.DataAsSpan<T>(),
-        am_memory_layer_weights.DataAsSpan<T>());
+        GemmWeights<T>(0, query_layer_weights, query_layer_weights_size_per_direction, packed_query_layer_weights_),
+        GemmWeights<T>(0, memory_layer_weights, memory_layer_weights_size_per_direction, packed_memory_layer_weights_));
     fam.PrepareMemory(attn_memory.DataAsSpan<T>(), memory_seq_lens_span);
 
     AttentionWrapper<T> faw(
@@ -448,7 +552,7 @@ Status DeepCpuAttnLstmOp::ValidateInputs(
     const Tensor& X, const Tensor& W, const Tensor& R, const Tensor* B,
     const Tensor* sequence_lens, const Tensor* initial_h, const Tensor* initial_c,
     const Tensor* P, int batch_size,
-    const Tensor& am_query_layer_weights, const Tensor& am_memory_layer_weights, const Tensor& am_v_weights,
+    const TensorShape& am_query_layer_shape, const TensorShape& am_memory_layer_shape, const Tensor& am_v_weights,
     const Tensor& attn_memory, const Tensor* attn_memory_seq_lens, const Tensor* attn_layer_weights) const {
   // Check memory of [batch_size, max_memory_step, memory_depth_], its sequence length of [batch_size]
   auto memory_shape = attn_memory.Shape();
@@ -478,7 +582,7 @@ Status DeepCpuAttnLstmOp::ValidateInputs(
   }
 
   // Check memory layer weights of [num_directions, memory_depth, am_attn_size]
-  auto memory_layer_shape = am_memory_layer_weights.Shape();
+  const auto& memory_layer_shape = am_memory_layer_shape;
   if (memory_layer_shape.NumDimensions() != 3 ||
       memory_layer_shape[0] != num_directions_ ||
       memory_layer_shape[1] != memory_depth) {
@@ -489,7 +593,7 @@ Status DeepCpuAttnLstmOp::ValidateInputs(
   const int am_attn_size = gsl::narrow<int>(memory_layer_shape[2]);
 
   // check query layer weights of [num_directions, query_depth(hidden_size of lstm), am_attn_size]
-  auto query_layer_shape = am_query_layer_weights.Shape();
+  const auto& query_layer_shape = am_query_layer_shape;
   if (query_layer_shape.NumDimensions() != 3 ||
       query_layer_shape[0] != num_directions_ ||
       query_layer_shape[1] != hidden_size_ ||
@@ -59,11 +59,21 @@ class DeepCpuAttnLstmOp final : public OpKernel {
                                         activation_func_betas);
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
   ~DeepCpuAttnLstmOp() override = default;
 
  private:
+  Status TryPackWeights(const Tensor& weights, rnn::detail::PackedWeights& packed_weights, bool& is_packed,
+                        AllocatorPtr alloc);
+
   template <typename T>
   Status ComputeImpl(OpKernelContext& context) const;
 
@@ -76,8 +86,8 @@ class DeepCpuAttnLstmOp final : public OpKernel {
                         const Tensor* initial_c,
                         const Tensor* P,
                         int batch_size,
-                        const Tensor& am_query_layer_weights,
-                        const Tensor& am_memory_layer_weights,
+                        const TensorShape& am_query_layer_shape,
+                        const TensorShape& am_memory_layer_shape,
                         const Tensor& am_v_weights,
                         const Tensor& attn_memory,
                         const Tensor* attn_memory_seq_lens,
@@ -91,6 +101,10 @@ class DeepCpuAttnLstmOp final : public OpKernel {
   bool input_forget_ = false;
 
   ActivationFuncs activation_funcs_;
+
+  // the query and memory layer weights of the attention mechanism, packed for MlasGemm
+  rnn::detail::PackedWeights packed_query_layer_weights_;
+  rnn::detail::PackedWeights packed_memory_layer_weights_;
 };
 
 }  // namespace contrib
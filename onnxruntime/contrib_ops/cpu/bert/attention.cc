@@ -21,7 +21,12 @@ class Attention : public OpKernel, public AttentionCPUBase {
   explicit Attention(const OpKernelInfo& info);
 
   Status Compute(OpKernelContext* context) const override;
-  Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override;
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
 
  private:
   BufferUniquePtr packed_weights_;
@@ -180,7 +185,8 @@ Attention<T>::Attention(const OpKernelInfo& info) : OpKernel(info), AttentionCPU
 }
 
 template <typename T>
-Status Attention<T>::PrePack(const Tensor& weights, int input_idx, bool& is_packed) {
+Status Attention<T>::PrePack(const Tensor& weights, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                             /*out*/ PrePackedWeights* prepacked_weights) {
   is_packed = false;
 
   if (1 != input_idx) {
@@ -210,7 +216,6 @@ Status Attention<T>::PrePack(const Tensor& weights, int input_idx, bool& is_pack
   }
 
   const size_t loop_len = static_cast<size_t>(3) * num_heads_;
-  auto alloc = Info().GetAllocator(0, OrtMemTypeDefault);
   auto* packed_weights_data = static_cast<uint8_t*>(alloc->AllocArray(packed_weights_size_, loop_len));
   packed_weights_ = BufferUniquePtr(packed_weights_data, BufferDeleter(alloc));
 
@@ -221,6 +226,27 @@ Status Attention<T>::PrePack(const Tensor& weights, int input_idx, bool& is_pack
   }
 
   is_packed = true;
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(packed_weights_));
+    prepacked_weights->buffer_sizes_.push_back(packed_weights_size_ * loop_len);
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status Attention<T>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                               int input_idx,
+                                               /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (1 != input_idx) {
+    return Status::OK();
+  }
+
+  used_shared_buffers = true;
+  packed_weights_ = std::move(prepacked_buffers[0]);
+
   return Status::OK();
 }
 
@@ -268,66 +294,61 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
     const auto* weights_data = weights ? weights->template Data<T>() : nullptr;
     const auto* bias_data = bias->template Data<T>();
 
-    const double cost =
-        static_cast<double>(sequence_length) * static_cast<double>(head_size) * static_cast<double>(hidden_size);
-    ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    // broadcast 3NH -> (3.B.N.S.H)
+    const double broadcast_cost = static_cast<double>(sequence_length) * static_cast<double>(head_size);
+    ThreadPool::TryParallelFor(tp, loop_len, broadcast_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
       for (std::ptrdiff_t i = begin; i != end; ++i) {
         const int batch_index = static_cast<int>((i / 3) / num_heads_);
         const int head_index = static_cast<int>((i / 3) % num_heads_);
         const int qkv_index = static_cast<int>(i % 3);
 
-        int input_offset = batch_index * sequence_length * hidden_size;
         int weights_offset = qkv_index * hidden_size + head_index * head_size;
-        T* qkv_dest = QKV[qkv_index];
         int qkv_offset = (batch_index * num_heads_ + head_index) * (sequence_length * head_size);
 
-        // broadcast 3NH -> (3.B.N.S.H)
         const T* broadcast_data_src = bias_data + weights_offset;
         T* broadcast_data_dest = QKV[qkv_index] + qkv_offset;
         for (int seq_index = 0; seq_index < sequence_length; seq_index++) {
           memcpy(broadcast_data_dest, broadcast_data_src, head_size * sizeof(T));
           broadcast_data_dest += head_size;
         }
-
-        //                   original           transposed            iteration
-        // A: input          (BxSxNxH)          (B.)S x NH            S x NH
-        // B: weights        (NxHx3xNxH)        NH  x (3.N.)H         NH x H
-        // C: QKV[qkv_index] (3xBxNxSxH)        (3.B.N.)S x H         S x H
-        if (packed_weights_) {
-          const auto* packed_weight =
-              static_cast<const uint8_t*>(packed_weights_.get()) + packed_weights_size_ * (weights_offset / head_size);
-          MlasGemm(
-              CblasNoTrans,               // TransA = no
-              sequence_length,            // M      = S
-              head_size,                  // N      = H
-              hidden_size,                // K      = NH
-              1.0f,                       // alpha
-              input_data + input_offset,  // A
-              hidden_size,                // lda    = NH
-              packed_weight,              // B
-              1.0f,                       // beta
-              qkv_dest + qkv_offset,      // C
-              head_size,                  // ldc
-              nullptr);                   // use single-thread
-        } else {
-          math::GemmEx<float, ThreadPool>(CblasNoTrans,                   // TransA = no
-                                          CblasNoTrans,                   // TransB = no
-                                          sequence_length,                // M      = S
-                                          head_size,                      // N      = H
-                                          hidden_size,                    // K      = NH
-                                          1.0f,                           // alpha
-                                          input_data + input_offset,      // A
-                                          hidden_size,                    // lda    = NH
-                                          weights_data + weights_offset,  // B
-                                          3 * hidden_size,                // ldb    = 3NH
-                                          1.0f,                           // beta
-                                          qkv_dest + qkv_offset,          // C
-                                          head_size,                      // ldc
-                                          nullptr                         // use single-thread
-          );
-        }
       }
     });
+
+    //                   original           transposed            iteration
+    // A: input          (BxSxNxH)          (B.)S x NH            S x NH
+    // B: weights        (NxHx3xNxH)        NH  x (3.N.)H         NH x H
+    // C: QKV[qkv_index] (3xBxNxSxH)        (3.B.N.)S x H         S x H
+    //
+    // All the projections are run as one batch so that the thread pool
+    // partitions the combined work once.
+    std::vector<MLAS_SGEMM_DATA_PARAMS> gemm_params(static_cast<size_t>(loop_len));
+    for (int i = 0; i < loop_len; ++i) {
+      const int batch_index = (i / 3) / num_heads_;
+      const int head_index = (i / 3) % num_heads_;
+      const int qkv_index = i % 3;
+
+      int input_offset = batch_index * sequence_length * hidden_size;
+      int weights_offset = qkv_index * hidden_size + head_index * head_size;
+      int qkv_offset = (batch_index * num_heads_ + head_index) * (sequence_length * head_size);
+
+      auto& params = gemm_params[i];
+      params.A = input_data + input_offset;
+      params.lda = hidden_size;
+      if (packed_weights_) {
+        params.B = static_cast<const uint8_t*>(packed_weights_.get()) + packed_weights_size_ * (weights_offset / head_size);
+        params.BIsPacked = true;
+      } else {
+        params.B = weights_data + weights_offset;
+        params.ldb = 3 * hidden_size;
+      }
+      params.C = QKV[qkv_index] + qkv_offset;
+      params.ldc = head_size;
+      params.alpha = 1.0f;
+      params.beta = 1.0f;
+    }
+
+    MlasGemmBatch(CblasNoTrans, CblasNoTrans, sequence_length, head_size, hidden_size,
+                  gemm_params.data(), gemm_params.size(), tp);
   }
 
   // Compute the attention score and apply the score to V
@@ -72,8 +72,8 @@ class AttentionCPUBase : public AttentionBase {
     BufferUniquePtr out_tmp_buffer(out_tmp_data, BufferDeleter(allocator));
 
     ComputeVxAttentionScore(output->template MutableData<T>(), static_cast<T*>(out_tmp_data), static_cast<T*>(attention_probs), V,
-                            batch_size, sequence_length, past_sequence_length, head_size, hidden_size,
-                            past_data, present_data, tp);
+                            mask_index_data, mask_index_dims, batch_size, sequence_length, past_sequence_length,
+                            head_size, hidden_size, past_data, present_data, tp);
 
     return Status::OK();
   }
@@ -83,6 +83,8 @@ class AttentionCPUBase : public AttentionBase {
   //  I. attention_probs(B, N, S, S*) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S*, H -> B, N, H, S*) +
   //                                    1 x mask_data(B, N, S, S*)
   //  II.attention_probs(B, N, S, S*) = Softmax(attention_probs)
+  // When a 1D mask_index masks the trailing keys of a batch, only its first L keys are computed (see
+  // GetAttentionKeyLength), and the probs of each head are stored compactly as SxL at the start of its SxS* chunk.
   template <typename T>
   void ComputeAttentionProbs(T* attention_probs,                           // output buffer for the attention probs. Its size is BxNxSxS
                              const T* Q,                                   // Q data. Its size is BxNxSxH
@@ -112,18 +114,26 @@ class AttentionCPUBase : public AttentionBase {
       const int loop_len = batch_size * num_heads_;
       const float alpha = 1.0f / sqrt(static_cast<float>(head_size));
 
-      // The cost of Gemm
-      const double cost = static_cast<double>(head_size) * sequence_length * all_sequence_length;
+      // The cost of Gemm and Softmax
+      const double cost = static_cast<double>(head_size + 2) * sequence_length * all_sequence_length;
 
       ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
         for (std::ptrdiff_t i = begin; i != end; ++i) {
-          const std::ptrdiff_t batch_index = i / num_heads_;
+          const int batch_index = static_cast<int>(i / num_heads_);
+          const int key_length = GetAttentionKeyLength(mask_index, mask_index_dims, batch_index, batch_size,
+                                                       all_sequence_length);
+          T* probs = reinterpret_cast<T*>(attention_probs) + sequence_length * all_sequence_length * i;
 
-          // broadcast mask data: (Bx)SxS* -> (BxNx)SxS*
+          // broadcast mask data: (Bx)SxS* -> (BxNx)SxL
           if (mask_data != nullptr) {
             const T* broadcast_data_src = reinterpret_cast<T*>(mask_data) + batch_index * sequence_length * all_sequence_length;
-            T* broadcast_data_dest = reinterpret_cast<T*>(attention_probs) + sequence_length * all_sequence_length * i;
-            memcpy(broadcast_data_dest, broadcast_data_src, sequence_length * all_sequence_length * sizeof(T));
+            if (key_length == all_sequence_length) {
+              memcpy(probs, broadcast_data_src, sequence_length * all_sequence_length * sizeof(T));
+            } else {
+              for (int s_i = 0; s_i < sequence_length; s_i++) {
+                memcpy(probs + s_i * key_length, broadcast_data_src + s_i * all_sequence_length, key_length * sizeof(T));
+              }
+            }
           }
 
           const T* k = K + input_chunk_length * i;
@@ -136,20 +146,15 @@ class AttentionCPUBase : public AttentionBase {
           //                     original                 transposed             each iteration
           // A: Q                (B x N x) S x H          (B x N x) S x H        S x H
           // B: K'               (B x N x) S* x H         (B x N x) H x S*       H x S*
-          // C: attention_probs  (B x N x) S x S*         (B x N x) S x S*       S x S*
-          math::Gemm<T, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, all_sequence_length, head_size, alpha,
-                                    Q + input_chunk_length * i, k, 1.0,
-                                    reinterpret_cast<T*>(attention_probs) + sequence_length * all_sequence_length * i, nullptr);
+          // C: attention_probs  (B x N x) S x S*         (B x N x) S x S*       S x L
+          math::Gemm<T, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, key_length, head_size, alpha,
+                                    Q + input_chunk_length * i, k, 1.0, probs, nullptr);
+
+          //  attention_probs(B, N, S, L) = Softmax(attention_probs)
+          ComputeAttentionSoftmaxInplace(probs, sequence_length, key_length, nullptr);
         }
       });
     }
-
-    //  attention_probs(B, N, S, S*) = Softmax(attention_probs)
-    {
-      const int N = batch_size * num_heads_ * sequence_length;
-      const int D = all_sequence_length;
-      ComputeAttentionSoftmaxInplace(attention_probs, N, D, tp);
-    }
   }
 
   template <typename T>
@@ -157,6 +162,8 @@ class AttentionCPUBase : public AttentionBase {
                                T* tmp_buffer,             // buffer for temp use with size is BxNxSxH
                                const T* attention_probs,  // Attention probs with size BxNxSxS*
                                const T* V,                // V value with size BxNxSxH
+                               const int32_t* mask_index,                    // mask index. nullptr if no mask
+                               const std::vector<int64_t>* mask_index_dims,  // mask index shape
                                int batch_size,            // batch size
                                int sequence_length,       // sequence length
                                int past_sequence_length,  // sequence length in past state
@@ -189,13 +196,17 @@ class AttentionCPUBase : public AttentionBase {
           v = ConcatStateChunk(past, v, present, past_chunk_length, present_chunk_length, i);
         }
 
+        // Only the first L keys have non-zero probs, and their probs are stored as SxL.
+        const int batch_index = static_cast<int>(i / num_heads_);
+        const int key_length = GetAttentionKeyLength(mask_index, mask_index_dims, batch_index, batch_size,
+                                                     all_sequence_length);
+
         T* current_tmp_data = reinterpret_cast<T*>(tmp_buffer) + input_chunk_length * i;
-        math::MatMul<T>(sequence_length, head_size, all_sequence_length,
+        math::MatMul<T>(sequence_length, head_size, key_length,
                         attention_probs + sequence_length * all_sequence_length * i,
                         v, current_tmp_data, nullptr);
 
         // transpose: out(B, S, N, H) = transpose out_tmp(B, N, S, H)
-        const int batch_index = static_cast<int>(i / num_heads_);
         const int head_index = static_cast<int>(i % num_heads_);
         T* src = current_tmp_data;
         T* dest = output + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
@@ -141,6 +141,31 @@ void PrepareMask(const int32_t* mask_index,
   }
 }
 
+// Returns the number of leading keys that a batch needs to attend to. Keys at or after the end position of a 1D
+// mask_index get -10000.0 for every query, so their softmax probabilities underflow to zero and they can be skipped.
+// All keys are used when every key is masked, since softmax then falls back to a uniform distribution over them.
+inline int GetAttentionKeyLength(const int32_t* mask_index,
+                                 const std::vector<int64_t>* mask_index_dims,
+                                 int batch_index,
+                                 int batch_size,
+                                 int all_sequence_length) {
+  if (nullptr == mask_index || mask_index_dims->size() != 1) {
+    return all_sequence_length;
+  }
+
+  const int end_position = mask_index[batch_index];
+  if (end_position <= 0 || end_position >= all_sequence_length) {
+    return all_sequence_length;
+  }
+
+  const bool has_mask_start_position = static_cast<int>(mask_index_dims->at(0)) == 2 * batch_size;
+  if (has_mask_start_position && mask_index[batch_index + batch_size] >= end_position) {
+    return all_sequence_length;
+  }
+
+  return end_position;
+}
+
 // Concatenate a past state chunk S'xH with input state chunk SxH into present state chunk S*xH
 // Returns a pointer to the start of present state chunk.
 template <typename T>
@@ -74,14 +74,29 @@ Status BiasGelu<T, use_approximation>::Compute(OpKernelContext* context) const {
   const T* bias_data = bias->template Data<T>();
   int64_t bias_len = bias->Shape().Size();
 
+  int64_t task_count = elem_count / bias_len;
+
+  if (!use_approximation) {
+    // The erf based GELU is computed by MLAS in blocks, so no temporary buffer is needed.
+    concurrency::ThreadPool::TryBatchParallelFor(
+        context->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
+        [&](ptrdiff_t task_idx) {
+          const T* p_input = input_data + task_idx * bias_len;
+          T* p_output = output_data + task_idx * bias_len;
+
+          MlasComputeBiasGelu(p_input, bias_data, p_output, static_cast<size_t>(bias_len));
+        },
+        0);
+
+    return Status::OK();
+  }
+
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
   BufferUniquePtr buffer = BufferUniquePtr(alloc->Alloc(SafeInt<size_t>(sizeof(T)) * elem_count),
                                            BufferDeleter(alloc));
   T* tmp_data = static_cast<T*>(buffer.get());
 
-  int64_t task_count = elem_count / bias_len;
-
   concurrency::ThreadPool::TryBatchParallelFor(
       context->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
       [&](ptrdiff_t task_idx) {
@@ -112,17 +127,8 @@ void BiasGelu<T, use_approximation>::AddBiasGelu(
       output[i] = temp[i] * (output[i] + 1.0f);
     }
   } else {  // BiasGelu
-    for (int64_t i = 0; i < count; i++) {
-      T value = input[i] + bias[i];
-      output[i] = value * static_cast<T>(M_SQRT1_2);
-      temp[i] = value * 0.5f;
-    }
-
-    MlasComputeErf(output, output, count);
-
-    for (int64_t i = 0; i < count; i++) {
-      output[i] = temp[i] * (output[i] + 1.0f);
-    }
+    ORT_UNUSED_PARAMETER(temp);
+    MlasComputeBiasGelu(input, bias, output, static_cast<size_t>(count));
   }
 }
 
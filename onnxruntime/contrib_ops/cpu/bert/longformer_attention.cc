@@ -0,0 +1,341 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "longformer_attention.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    LongformerAttention,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    LongformerAttention<float>);
+
+namespace {
+
+// qkv(BS, 3NH) = input(BS, NH) x weights(NH, 3NH) + bias(3NH)
+void ComputeProjection(const float* input, const float* weights, const float* bias, float* qkv,
+                       int rows, int hidden_size, ThreadPool* tp) {
+  const int hidden_size_x3 = 3 * hidden_size;
+
+  float* row = qkv;
+  for (int r = 0; r < rows; r++) {
+    memcpy(row, bias, hidden_size_x3 * sizeof(float));
+    row += hidden_size_x3;
+  }
+
+  MlasGemm(CblasNoTrans, CblasNoTrans, rows, hidden_size_x3, hidden_size, 1.0f,
+           input, hidden_size, weights, hidden_size_x3, 1.0f, qkv, hidden_size_x3, tp);
+}
+
+// Softmax of the 'count' scores in 'row' where valid(j) is true. The other entries are set to zero so that they
+// can take part in the multiplication with V.
+template <typename TValid>
+void MaskedSoftmaxInplace(float* row, int count, TValid valid) {
+  float max = std::numeric_limits<float>::lowest();
+  for (int j = 0; j < count; j++) {
+    if (valid(j) && row[j] > max) {
+      max = row[j];
+    }
+  }
+
+  float sum = 0.0f;
+  for (int j = 0; j < count; j++) {
+    if (valid(j)) {
+      row[j] = std::exp(row[j] - max);
+      sum += row[j];
+    } else {
+      row[j] = 0.0f;
+    }
+  }
+
+  if (sum > 0.0f) {
+    const float scale = 1.0f / sum;
+    for (int j = 0; j < count; j++) {
+      row[j] *= scale;
+    }
+  }
+}
+
+// Denote: batch size (B), sequence length (S), number of heads (N), dimension per head (H), one sided window (W),
+// number of global tokens in a batch (G).
+//
+// qkv and global_qkv are the projections with shape (B, S, 3, N, H), and output has shape (B, S, N, H).
+//
+// A local token attends to the tokens within W of itself and to all global tokens. A global token attends to all
+// tokens, using the global projections. The rows of masked tokens are zero.
+//
+// The local attention is computed in blocks of W query rows. The keys of a block are the W rows before it, the block
+// itself and the W rows after it, so the banded Q*K' and P*V products are dense Wx3W and WxH GEMMs. The scores for
+// the global keys are appended to the scores of the window. Global keys are excluded from the window part so they are
+// counted once.
+void ComputeLongformerAttention(const float* qkv,
+                                const float* global_qkv,
+                                const float* mask,
+                                const int* global_attention,
+                                float* output,
+                                int batch_size,
+                                int sequence_length,
+                                int num_heads,
+                                int head_size,
+                                int window,
+                                ThreadPool* tp) {
+  const int hidden_size = num_heads * head_size;
+  const size_t ld_qkv = static_cast<size_t>(3) * hidden_size;
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+
+  std::vector<std::vector<int>> global_index(batch_size);
+  for (int b = 0; b < batch_size; b++) {
+    for (int s = 0; s < sequence_length; s++) {
+      if (global_attention[b * sequence_length + s] != 0) {
+        global_index[b].push_back(s);
+      }
+    }
+  }
+
+  // offset of the Q (0), K (1) or V (2) values of a token in a head
+  auto qkv_offset = [&](int b, int s, int n, int qkv_index) {
+    return (static_cast<size_t>(b) * sequence_length + s) * ld_qkv + static_cast<size_t>(qkv_index) * hidden_size +
+           static_cast<size_t>(n) * head_size;
+  };
+
+  const int num_blocks = sequence_length / window;
+  const int max_keys = 3 * window;
+
+  // Local attention, for each block of W query rows in every head.
+  const double block_cost = static_cast<double>(window) * max_keys * head_size * 2;
+  ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size) * num_heads * num_blocks, block_cost,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<float> scores;
+        std::vector<float> global_k;
+        std::vector<float> global_v;
+
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          const int b = static_cast<int>(i / (num_heads * num_blocks));
+          const int n = static_cast<int>((i / num_blocks) % num_heads);
+          const int row_start = static_cast<int>(i % num_blocks) * window;
+
+          const int key_start = std::max(0, row_start - window);
+          const int key_end = std::min(sequence_length, row_start + 2 * window);
+          const int num_keys = key_end - key_start;
+
+          const std::vector<int>& globals = global_index[b];
+          const int num_global = static_cast<int>(globals.size());
+          const int ld_scores = num_keys + num_global;
+
+          const float* mask_data = mask + static_cast<size_t>(b) * sequence_length;
+          const int* global_data = global_attention + static_cast<size_t>(b) * sequence_length;
+
+          scores.resize(static_cast<size_t>(window) * ld_scores);
+
+          // scores[:, :num_keys] = Q[block] x K[window]'
+          MlasGemm(CblasNoTrans, CblasTrans, window, num_keys, head_size, scale,
+                   qkv + qkv_offset(b, row_start, n, 0), ld_qkv,
+                   qkv + qkv_offset(b, key_start, n, 1), ld_qkv,
+                   0.0f, scores.data(), ld_scores, nullptr);
+
+          if (num_global > 0) {
+            global_k.resize(static_cast<size_t>(num_global) * head_size);
+            global_v.resize(static_cast<size_t>(num_global) * head_size);
+            for (int g = 0; g < num_global; g++) {
+              memcpy(global_k.data() + g * head_size, qkv + qkv_offset(b, globals[g], n, 1), head_size * sizeof(float));
+              memcpy(global_v.data() + g * head_size, qkv + qkv_offset(b, globals[g], n, 2), head_size * sizeof(float));
+            }
+
+            // scores[:, num_keys:] = Q[block] x K[globals]'
+            MlasGemm(CblasNoTrans, CblasTrans, window, num_global, head_size, scale,
+                     qkv + qkv_offset(b, row_start, n, 0), ld_qkv,
+                     global_k.data(), head_size,
+                     0.0f, scores.data() + num_keys, ld_scores, nullptr);
+          }
+
+          for (int t = 0; t < window; t++) {
+            const int row = row_start + t;
+            float* row_scores = scores.data() + static_cast<size_t>(t) * ld_scores;
+
+            if (mask_data[row] < 0.0f) {
+              std::fill_n(row_scores, ld_scores, 0.0f);
+              continue;
+            }
+
+            for (int j = 0; j < num_keys; j++) {
+              row_scores[j] += mask_data[key_start + j];
+            }
+            for (int g = 0; g < num_global; g++) {
+              row_scores[num_keys + g] += mask_data[globals[g]];
+            }
+
+            MaskedSoftmaxInplace(row_scores, ld_scores, [&](int j) {
+              if (j >= num_keys) {
+                return true;
+              }
+              const int key = key_start + j;
+              return std::abs(key - row) <= window && global_data[key] == 0;
+            });
+          }
+
+          // output[block] = P[:, :num_keys] x V[window] + P[:, num_keys:] x V[globals]
+          float* out = output + (static_cast<size_t>(b) * sequence_length + row_start) * hidden_size +
+                       static_cast<size_t>(n) * head_size;
+          MlasGemm(CblasNoTrans, CblasNoTrans, window, head_size, num_keys, 1.0f,
+                   scores.data(), ld_scores,
+                   qkv + qkv_offset(b, key_start, n, 2), ld_qkv,
+                   0.0f, out, hidden_size, nullptr);
+
+          if (num_global > 0) {
+            MlasGemm(CblasNoTrans, CblasNoTrans, window, head_size, num_global, 1.0f,
+                     scores.data() + num_keys, ld_scores,
+                     global_v.data(), head_size,
+                     1.0f, out, hidden_size, nullptr);
+          }
+        }
+      });
+
+  if (global_qkv == nullptr) {
+    return;
+  }
+
+  // Global attention. This overwrites the rows of the global tokens written by the local attention above.
+  const double head_cost = static_cast<double>(sequence_length) * sequence_length * head_size * 2;
+  ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size) * num_heads, head_cost,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<float> global_q;
+        std::vector<float> scores;
+        std::vector<float> context;
+
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          const int b = static_cast<int>(i / num_heads);
+          const int n = static_cast<int>(i % num_heads);
+
+          const std::vector<int>& globals = global_index[b];
+          const int num_global = static_cast<int>(globals.size());
+          if (num_global == 0) {
+            continue;
+          }
+
+          const float* mask_data = mask + static_cast<size_t>(b) * sequence_length;
+
+          global_q.resize(static_cast<size_t>(num_global) * head_size);
+          for (int g = 0; g < num_global; g++) {
+            memcpy(global_q.data() + g * head_size, global_qkv + qkv_offset(b, globals[g], n, 0),
+                   head_size * sizeof(float));
+          }
+
+          // scores = global_Q[globals] x global_K'
+          scores.resize(static_cast<size_t>(num_global) * sequence_length);
+          MlasGemm(CblasNoTrans, CblasTrans, num_global, sequence_length, head_size, scale,
+                   global_q.data(), head_size,
+                   global_qkv + qkv_offset(b, 0, n, 1), ld_qkv,
+                   0.0f, scores.data(), sequence_length, nullptr);
+
+          for (int g = 0; g < num_global; g++) {
+            float* row_scores = scores.data() + static_cast<size_t>(g) * sequence_length;
+            if (mask_data[globals[g]] < 0.0f) {
+              std::fill_n(row_scores, sequence_length, 0.0f);
+              continue;
+            }
+
+            for (int j = 0; j < sequence_length; j++) {
+              row_scores[j] += mask_data[j];
+            }
+            MaskedSoftmaxInplace(row_scores, sequence_length, [](int) { return true; });
+          }
+
+          // context = P x global_V
+          context.resize(static_cast<size_t>(num_global) * head_size);
+          MlasGemm(CblasNoTrans, CblasNoTrans, num_global, head_size, sequence_length, 1.0f,
+                   scores.data(), sequence_length,
+                   global_qkv + qkv_offset(b, 0, n, 2), ld_qkv,
+                   0.0f, context.data(), head_size, nullptr);
+
+          for (int g = 0; g < num_global; g++) {
+            float* out = output + (static_cast<size_t>(b) * sequence_length + globals[g]) * hidden_size +
+                         static_cast<size_t>(n) * head_size;
+            memcpy(out, context.data() + g * head_size, head_size * sizeof(float));
+          }
+        }
+      });
+}
+
+}  // namespace
+
+template <typename T>
+LongformerAttention<T>::LongformerAttention(const OpKernelInfo& info) : OpKernel(info), LongformerAttentionBase(info) {}
+
+template <typename T>
+Status LongformerAttention<T>::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* weights = context->Input<Tensor>(1);
+  const Tensor* bias = context->Input<Tensor>(2);
+  const Tensor* mask = context->Input<Tensor>(3);
+  const Tensor* global_weights = context->Input<Tensor>(4);
+  const Tensor* global_bias = context->Input<Tensor>(5);
+  const Tensor* global_attention = context->Input<Tensor>(6);
+  ORT_RETURN_IF_ERROR(CheckInputs(input->Shape(), weights->Shape(), bias->Shape(), mask->Shape(),
+                                  global_weights->Shape(), global_bias->Shape(), global_attention->Shape()));
+
+  // Input and output shapes:
+  //   Input 0 - input       : (batch_size, sequence_length, hidden_size)
+  //   Output 0 - output     : (batch_size, sequence_length, hidden_size)
+  const auto& shape = input->Shape();
+  const int batch_size = static_cast<int>(shape[0]);
+  const int sequence_length = static_cast<int>(shape[1]);
+  const int hidden_size = static_cast<int>(shape[2]);
+  const int head_size = hidden_size / num_heads_;
+
+  Tensor* output = context->Output(0, shape);
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+
+  auto* tp = context->GetOperatorThreadPool();
+
+  const int rows = batch_size * sequence_length;
+  const size_t qkv_bytes = SafeInt<size_t>(rows) * 3 * hidden_size * sizeof(T);
+
+  auto qkv_data = allocator->Alloc(qkv_bytes);
+  BufferUniquePtr qkv_buffer(qkv_data, BufferDeleter(allocator));
+  ComputeProjection(input->template Data<T>(), weights->template Data<T>(), bias->template Data<T>(),
+                    reinterpret_cast<T*>(qkv_data), rows, hidden_size, tp);
+
+  // The global projection is only needed when there is any global token.
+  const int* global_data = global_attention->template Data<int>();
+  const bool has_global = std::any_of(global_data, global_data + rows, [](int global) { return global != 0; });
+
+  BufferUniquePtr global_qkv_buffer;
+  T* global_qkv_data = nullptr;
+  if (has_global) {
+    global_qkv_data = reinterpret_cast<T*>(allocator->Alloc(qkv_bytes));
+    global_qkv_buffer = BufferUniquePtr(global_qkv_data, BufferDeleter(allocator));
+    ComputeProjection(input->template Data<T>(), global_weights->template Data<T>(),
+                      global_bias->template Data<T>(), global_qkv_data, rows, hidden_size, tp);
+  }
+
+  ComputeLongformerAttention(reinterpret_cast<const T*>(qkv_data), global_qkv_data, mask->template Data<T>(),
+                             global_data, output->template MutableData<T>(),
+                             batch_size, sequence_length, num_heads_, head_size, window_, tp);
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
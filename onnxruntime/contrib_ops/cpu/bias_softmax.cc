@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "bias_softmax.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/common.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    BiasSoftmax,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .MayInplace(0, 0)
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    BiasSoftmax);
+
+Status BiasSoftmax::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* B = context->Input<Tensor>(1);
+  const auto& X_shape = X->Shape();
+  Tensor* Y = context->Output(0, X_shape);
+  if (X_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  const size_t rank = X_shape.NumDimensions();
+  const size_t softmax_axis = static_cast<size_t>(HandleNegativeAxis(softmax_axis_, rank));
+  const size_t broadcast_axis = static_cast<size_t>(HandleNegativeAxis(broadcast_axis_, rank));
+  if (broadcast_axis > softmax_axis) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "BiasSoftmax: broadcast_axis ", broadcast_axis_,
+                           " must not be after softmax_axis ", softmax_axis_);
+  }
+
+  // the bias has a row of D elements for each of the N / broadcast_size batches of rows of the input
+  const int64_t N = X_shape.SizeToDimension(softmax_axis);
+  const int64_t D = X_shape.SizeFromDimension(softmax_axis);
+  const int64_t broadcast_size = N / X_shape.SizeToDimension(broadcast_axis);
+  if (B->Shape().Size() != N / broadcast_size * D) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "BiasSoftmax: bias of shape ", B->Shape(),
+                           " can't be broadcast to data of shape ", X_shape, " along the dims [", broadcast_axis,
+                           ", ", softmax_axis, ")");
+  }
+
+  const float* X_data = X->Data<float>();
+  const float* B_data = B->Data<float>();
+  float* Y_data = Y->MutableData<float>();
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), N,
+      TensorOpCost{static_cast<double>(2 * D * sizeof(float)), static_cast<double>(D * sizeof(float)),
+                   static_cast<double>(D * 8)},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t n = begin; n < end; ++n) {
+          float* y = Y_data + n * D;
+          EigenVectorArrayMap<float>(y, D) = ConstEigenVectorArrayMap<float>(X_data + n * D, D) +
+                                             ConstEigenVectorArrayMap<float>(B_data + n / broadcast_size * D, D);
+          // a single row runs on the calling thread
+          MlasComputeSoftmax(y, y, 1, static_cast<size_t>(D), false, nullptr);
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Softmax(data + bias) with the bias broadcast along the dims [broadcast_axis, softmax_axis) of data, computed a row
+// at a time so the sum stays in cache for the softmax.
+class BiasSoftmax final : public OpKernel {
+ public:
+  explicit BiasSoftmax(const OpKernelInfo& info) : OpKernel(info) {
+    softmax_axis_ = info.GetAttrOrDefault<int64_t>("softmax_axis", 1);
+    broadcast_axis_ = info.GetAttrOrDefault<int64_t>("broadcast_axis", 1);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t softmax_axis_;
+  int64_t broadcast_axis_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -2,11 +2,16 @@
 // Licensed under the MIT License.
 
 #include "cdist.h"
+
+#include <algorithm>
+#include <vector>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 namespace contrib {
@@ -17,8 +22,46 @@ namespace contrib {
 DEFINE_KERNEL(float);
 DEFINE_KERNEL(double);
 
+// The output is computed in tiles of rows of A and rows of B, in parallel. The GEMM of a tile is small enough that
+// its output is still in the cache when the norms are added to it.
+static constexpr int64_t kTileRows = 64;
+static constexpr int64_t kTileColumns = 256;
+
+// C[m, n] (with ldc) = -2 * A[m, k] * B[n, k]^T
+static void GemmTile(int64_t m, int64_t n, int64_t k, const float* a, const float* b, float* c, int64_t ldc) {
+  MlasGemm(CblasNoTrans, CblasTrans, m, n, k, -2.f, a, k, b, k, 0.f, c, ldc, nullptr);
+}
+
+static void GemmTile(int64_t m, int64_t n, int64_t k, const double* a, const double* b, double* c, int64_t ldc) {
+// use MLAS on 64-bit (no 32-bit dgemm)
+#ifdef MLAS_SUPPORTS_GEMM_DOUBLE
+  MlasGemm(CblasNoTrans, CblasTrans, m, n, k, -2., a, k, b, k, 0., c, ldc, nullptr);
+#else
+  // https://eigen.tuxfamily.org/dox/TopicWritingEfficientProductExpression.html
+  auto out_map = EigenMatrixMapRowMajorOuterStride<double>(c, m, n, Eigen::OuterStride<>(ldc));
+  out_map.noalias() = -2. * (ConstEigenMatrixMapRowMajor<double>(a, m, k) *
+                             ConstEigenMatrixMapRowMajor<double>(b, n, k).transpose());
+#endif
+}
+
+// ReduceSumSquare of the rows of the matrix of {rows, k}
+template <typename T>
+static std::vector<T> SumSquares(const T* data, int64_t rows, int64_t k, concurrency::ThreadPool* threadpool) {
+  std::vector<T> sum_squares(static_cast<size_t>(rows));
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, rows, TensorOpCost{static_cast<double>(k * sizeof(T)), static_cast<double>(sizeof(T)),
+                                     static_cast<double>(k * 2)},
+      [data, k, &sum_squares](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          sum_squares[i] = ConstEigenVectorMap<T>(data + i * k, k).squaredNorm();
+        }
+      });
+  return sum_squares;
+}
+
 template <typename T>
-static void CalculateSqeuclidean(const Tensor& a, const Tensor& b, Tensor& c, concurrency::ThreadPool* threadpool) {
+static void CalculateDistance(const Tensor& a, const Tensor& b, Tensor& c, bool euclidean,
+                              concurrency::ThreadPool* threadpool) {
   // input shapes have already been validated
   const auto& shape_a = a.Shape().GetDims();  // {m, k}
   const auto& shape_b = b.Shape().GetDims();  // {n, k}
@@ -33,60 +76,42 @@ static void CalculateSqeuclidean(const Tensor& a, const Tensor& b, Tensor& c, co
   const auto* b_data = b.Data<T>();
   auto* c_data = c.MutableData<T>();
 
-  // ReduceSumSquare for A
-  std::vector<T> a_ss;
-  a_ss.resize(m);
-  const auto* cur_a = a_data;
-  for (int64_t i = 0; i < m; ++i) {
-    a_ss[i] = ConstEigenVectorMap<T>(cur_a, k).squaredNorm();
-    cur_a += k;
-  }
-
-  // ReduceSumSquare for B
-  std::vector<T> b_ss;
-  b_ss.resize(n);
-  const auto* cur_b = b_data;
-  for (int64_t i = 0; i < n; ++i) {
-    b_ss[i] = ConstEigenVectorMap<T>(cur_b, k).squaredNorm();
-    cur_b += k;
-  }
+  const std::vector<T> a_ss = SumSquares(a_data, m, k, threadpool);
+  const std::vector<T> b_ss = SumSquares(b_data, n, k, threadpool);
 
   // NOTE: We want to avoid subtracting two numbers that are very close to each other as that can lead to
   // 'catastrophic cancellation'. (sum_k(Xik**2) + sum_k(Yjk**2)) would be close to 2*sum_k(Xik*Yjk) if the values
   // in Xij and Yjk are very similar, so subtracting can be problematic.
   // Due to that we calculate -2*sum_k(Xik*Yjk) using GEMM, add sum_k(Xik**2) next, and add sum_k(Yjk**2) last.
-
-// use MLAS on 64-bit (no 32-bit dgemm)
-#if defined(_M_AMD64) || defined(__x86_64__)
-  // Use GEMM of A and B^T with -2 as alpha to calculate -2*sum_k(Xik*Yjk)
-  math::Gemm<T>(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
-                m, n, k,
-                static_cast<T>(-2.), a_data, b_data, static_cast<T>(0.),
-                c_data,
-                threadpool);
-#else
-  // the performance of this isn't great as the eigen matmul is single threaded by default
-  // if you're on x86 and care about performance try MKL first. if there's a good enough argument for optimising this
-  // we can look into it in the future.
-  ORT_UNUSED_PARAMETER(threadpool);
-
-  // https://eigen.tuxfamily.org/dox/TopicWritingEfficientProductExpression.html
-  auto out_map = EigenMatrixMapRowMajor<T>(c_data, m, n);
-  out_map.noalias() = static_cast<T>(-2.) *
-                      (ConstEigenMatrixMapRowMajor<T>(a_data, m, k) *
-                       ConstEigenMatrixMapRowMajor<T>(b_data, n, k).transpose());
-#endif
-
-  // add a_ss and b_ss, with broadcast
-  // output shape is {m, n}
-  auto* cur_out = c_data;
-  for (int64_t i = 0; i < m; ++i) {
-    T a_val = a_ss[i];
-    for (int64_t j = 0; j < n; ++j) {
-      *cur_out = (*cur_out + a_val) + b_ss[j];
-      ++cur_out;
-    }
-  }
+  const int64_t row_tiles = (m + kTileRows - 1) / kTileRows;
+  const int64_t column_tiles = (n + kTileColumns - 1) / kTileColumns;
+  const double tile_cost = static_cast<double>(kTileRows * kTileColumns) * static_cast<double>(k * 2 + 4);
+
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, row_tiles * column_tiles, tile_cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t tile = first; tile < last; ++tile) {
+          const int64_t row_begin = (tile / column_tiles) * kTileRows;
+          const int64_t column_begin = (tile % column_tiles) * kTileColumns;
+          const int64_t rows = std::min(kTileRows, m - row_begin);
+          const int64_t columns = std::min(kTileColumns, n - column_begin);
+
+          T* c_tile = c_data + row_begin * n + column_begin;
+          GemmTile(rows, columns, k, a_data + row_begin * k, b_data + column_begin * k, c_tile, n);
+
+          // add a_ss and b_ss, with broadcast.
+          // because we use GEMM there's a slight chance a number extremely close to zero could be negative, so we
+          // need to run abs() to avoid NaN's in the results.
+          const auto b_ss_tile = ConstEigenVectorArrayMap<T>(b_ss.data() + column_begin, columns);
+          for (int64_t i = 0; i < rows; ++i) {
+            auto out_row = EigenVectorArrayMap<T>(c_tile + i * n, columns);
+            if (euclidean) {
+              out_row = ((out_row + a_ss[row_begin + i]) + b_ss_tile).abs().sqrt();
+            } else {
+              out_row = ((out_row + a_ss[row_begin + i]) + b_ss_tile).abs();
+            }
+          }
+        }
+      });
 }
 
 template <typename T>
@@ -111,18 +136,8 @@ common::Status CDist<T>::Compute(OpKernelContext* context) const {
 
   TensorShape output_shape = {shape_a[0], shape_b[0]};
   Tensor* C = context->Output(0, output_shape);
-  T* output = C->MutableData<T>();
-
-  CalculateSqeuclidean<T>(*A, *B, *C, tp);
-  auto map_out = EigenVectorArrayMap<T>(output, output_shape.Size());
 
-  // because we use GEMM in CalculateSqeuclidean there's a slight chance a number extremely close to zero
-  // could be negative, so we need to run abs() to avoid NaN's in the results.
-  if (mode_ == Mode::EUCLIDEAN) {
-    map_out = map_out.abs().sqrt();  // do both abs and sqrt in one call so Eigen has a chance to combine
-  } else if (mode_ == Mode::SQEUCLIDEAN) {
-    map_out = map_out.abs();
-  }
+  CalculateDistance<T>(*A, *B, *C, mode_ == Mode::EUCLIDEAN, tp);
 
   return Status::OK();
 }
@@ -16,6 +16,7 @@ limitations under the License.
 
 #include "contrib_ops/cpu/crop_and_resize.h"
 
+#include <algorithm>
 #include <cmath>
 #include "core/util/math_cpuonly.h"
 #include "core/common/common.h"
@@ -42,6 +43,48 @@ namespace contrib {
 
 ADD_TYPED_CROPANDRESIZE_OP(float);
 
+namespace {
+// The sampling coefficients of an output row or column of a crop, shared by the channels
+struct CropAndResizeCoefficients {
+  bool in_bounds;  // false for the samples outside of the image, which get the extrapolation value
+  int64_t low;
+  int64_t high;
+  int64_t nearest;
+  float lerp;
+};
+
+template <typename T>
+void ComputeCropAndResizeCoefficients(T roi_start, T roi_end, int64_t size, int64_t pooled_size,
+                                      std::vector<CropAndResizeCoefficients>& coefficients) {
+  coefficients.resize(pooled_size);
+  T scale = (pooled_size > 1) ? (roi_end - roi_start) * (size - 1) / (pooled_size - 1) : 0;
+  for (int64_t p = 0; p < pooled_size; p++) {
+    T in = static_cast<T>((pooled_size > 1)
+                              ? roi_start * (size - 1) + p * scale
+                              : 0.5 * (roi_start + roi_end) * (size - 1));
+    if (p == pooled_size - 1) {
+      in = static_cast<T>((pooled_size > 1)
+                              ? roi_end * (size - 1)
+                              : 0.5 * (roi_start + roi_end) * (size - 1));
+    }
+    if (p == 0) {
+      in = static_cast<T>((pooled_size > 1)
+                              ? roi_start * (size - 1)
+                              : 0.5 * (roi_start + roi_end) * (size - 1));
+    }
+
+    auto& c = coefficients[p];
+    c.in_bounds = !(in < 0 || in > size - 1);
+    if (c.in_bounds) {
+      c.low = static_cast<int>(floorf(static_cast<float>(in)));
+      c.high = static_cast<int>(ceilf(static_cast<float>(in)));
+      c.nearest = static_cast<int>(roundf(static_cast<float>(in)));
+      c.lerp = static_cast<float>(in - c.low);
+    }
+  }
+}
+}  // namespace
+
 template <typename T>
 void CropAndResizeForward(const TensorShape& output_shape,
                           const T* bottom_data,
@@ -58,117 +101,79 @@ void CropAndResizeForward(const TensorShape& output_shape,
   int64_t channels = output_shape[1];
   int64_t pooled_height = output_shape[2];
   int64_t pooled_width = output_shape[3];
-
-  ThreadPool::TryBatchParallelFor(ttp, static_cast<int32_t>(n_rois), [&](ptrdiff_t n) {
-    int64_t index_n = n * channels * pooled_width * pooled_height;
-
-    const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
-    const auto roi_batch_ind = batch_indices_ptr[n];
-
-    T roi_start_w = offset_bottom_rois[1];
-    T roi_start_h = offset_bottom_rois[0];
-    T roi_end_w = offset_bottom_rois[3];
-    T roi_end_h = offset_bottom_rois[2];
-
-    T height_scale = (pooled_height > 1)
-                         ? (roi_end_h - roi_start_h) * (height - 1) / (pooled_height - 1)
-                         : 0;
-    T width_scale = (pooled_width > 1)
-                        ? (roi_end_w - roi_start_w) * (width - 1) / (pooled_width - 1)
-                        : 0;
-
-    for (auto ph = 0; ph < pooled_height; ph++) {
-      T in_y = static_cast<T>((pooled_height > 1)
-                                  ? roi_start_h * (height - 1) + ph * height_scale
-                                  : 0.5 * (roi_start_h + roi_end_h) * (height - 1));
-      if (ph == pooled_height - 1) {
-        in_y = static_cast<T>((pooled_height > 1)
-                                  ? roi_end_h * (height - 1)
-                                  : 0.5 * (roi_start_h + roi_end_h) * (height - 1));
-      }
-      if (ph == 0) {
-        in_y = static_cast<T>((pooled_height > 1)
-                                  ? roi_start_h * (height - 1)
-                                  : 0.5 * (roi_start_h + roi_end_h) * (height - 1));
-      }
-      if (in_y < 0 || in_y > height - 1) {
-        for (int64_t pw = 0; pw < pooled_width; pw++) {
-          for (int64_t c = 0; c < channels; c++) {
-            int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-            int64_t index = index_n_c + ph * pooled_width + pw;
-            top_data[index] = extrapolation_value;
-          }
-        }
-        continue;
+  const bool bilinear = mode == "bilinear";
+
+  // the work is partitioned over the crops and blocks of their channels. a work range computes the coefficients of
+  // the rows and columns of a crop once for all of its channels, which then write their output rows in order.
+  constexpr int64_t channel_block_size = 16;
+  const int64_t channel_blocks = (channels + channel_block_size - 1) / channel_block_size;
+  const double cost = static_cast<double>(std::min(channels, channel_block_size) * pooled_width * pooled_height *
+                                          (bilinear ? 16 : 4));
+
+  ThreadPool::TryParallelFor(ttp, static_cast<ptrdiff_t>(n_rois * channel_blocks), cost,
+                             [&](ptrdiff_t work, ptrdiff_t end) {
+    std::vector<CropAndResizeCoefficients> y_coefficients;
+    std::vector<CropAndResizeCoefficients> x_coefficients;
+    int64_t coefficients_n = -1;
+
+    for (; work != end; ++work) {
+      const int64_t n = work / channel_blocks;
+      const int64_t channel_begin = (work % channel_blocks) * channel_block_size;
+      const int64_t channel_end = std::min(channel_begin + channel_block_size, channels);
+
+      if (n != coefficients_n) {
+        const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
+        // the boxes are [y1, x1, y2, x2]
+        ComputeCropAndResizeCoefficients(offset_bottom_rois[0], offset_bottom_rois[2], height, pooled_height,
+                                         y_coefficients);
+        ComputeCropAndResizeCoefficients(offset_bottom_rois[1], offset_bottom_rois[3], width, pooled_width,
+                                         x_coefficients);
+        coefficients_n = n;
       }
 
-      const int top_y_index = static_cast<int>(floorf(static_cast<float>(in_y)));
-      const int bottom_y_index = static_cast<int>(ceilf(static_cast<float>(in_y)));
-      const float y_lerp = static_cast<float>(in_y - top_y_index);
-
-      for (auto pw = 0; pw < pooled_width; pw++) {
-        T in_x = static_cast<T>((pooled_width > 1)
-                                    ? roi_start_w * (width - 1) + pw * width_scale
-                                    : 0.5 * (roi_start_w + roi_end_w) * (width - 1));
-        if (pw == pooled_width - 1) {
-          in_x = static_cast<T>((pooled_width > 1)
-                                    ? roi_end_w * (width - 1)
-                                    : 0.5 * (roi_start_w + roi_end_w) * (width - 1));
-        }
-        if (pw == 0) {
-          in_x = static_cast<T>((pooled_width > 1)
-                                    ? roi_start_w * (width - 1)
-                                    : 0.5 * (roi_start_w + roi_end_w) * (width - 1));
-        }
-        if (in_x < 0 || in_x > width - 1) {
-          for (int64_t c = 0; c < channels; c++) {
-            int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-            int64_t index = index_n_c + ph * pooled_width + pw;
-            top_data[index] = extrapolation_value;
+      const auto roi_batch_ind = batch_indices_ptr[n];
+      for (int64_t c = channel_begin; c < channel_end; c++) {
+        const T* offset_bottom_data =
+            bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
+        T* offset_top_data = top_data + (n * channels + c) * pooled_height * pooled_width;
+
+        for (int64_t ph = 0; ph < pooled_height; ph++) {
+          const auto& y = y_coefficients[ph];
+          T* top_row = offset_top_data + ph * pooled_width;
+          if (!y.in_bounds) {
+            std::fill_n(top_row, pooled_width, static_cast<T>(extrapolation_value));
+            continue;
           }
-          continue;
-        }
-
-        T output_val = extrapolation_value;
-        if (mode == "bilinear") {
-          const int left_x_index = static_cast<int>(floorf(static_cast<float>(in_x)));
-          const int right_x_index = static_cast<int>(ceilf(static_cast<float>(in_x)));
-          const float x_lerp = static_cast<float>(in_x - left_x_index);
-          auto top_left_index = top_y_index * width + left_x_index;
-          auto top_right_index = top_y_index * width + right_x_index;
-          auto bottom_left_index = bottom_y_index * width + left_x_index;
-          auto bottom_right_index = bottom_y_index * width + right_x_index;
-
-          for (auto c = 0; c < channels; c++) {
-            int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-            int64_t index = index_n_c + ph * pooled_width + pw;
-            const T* offset_bottom_data =
-                bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
-            const float top_left(static_cast<float>(offset_bottom_data[top_left_index]));
-            const float top_right(static_cast<float>(offset_bottom_data[top_right_index]));
-            const float bottom_left(static_cast<float>(offset_bottom_data[bottom_left_index]));
-            const float bottom_right(static_cast<float>(offset_bottom_data[bottom_right_index]));
-            const float top = top_left + (top_right - top_left) * x_lerp;
-            const float bottom = bottom_left + (bottom_right - bottom_left) * x_lerp;
-            output_val = top + (bottom - top) * y_lerp;
-            top_data[index] = output_val;
-          }
-        } else {  // mode == "nearest"
-          const int closest_x_index = static_cast<int>(roundf(static_cast<float>(in_x)));
-          const int closest_y_index = static_cast<int>(roundf(static_cast<float>(in_y)));
-          auto closest_index = closest_y_index * width + closest_x_index;
-
-          for (auto c = 0; c < channels; c++) {
-            int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-            int64_t index = index_n_c + ph * pooled_width + pw;
-            const T* offset_bottom_data =
-                bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
-            top_data[index] = static_cast<float>(offset_bottom_data[closest_index]);
+
+          if (bilinear) {
+            const T* bottom_top_row = offset_bottom_data + y.low * width;
+            const T* bottom_bottom_row = offset_bottom_data + y.high * width;
+            for (int64_t pw = 0; pw < pooled_width; pw++) {
+              const auto& x = x_coefficients[pw];
+              if (!x.in_bounds) {
+                top_row[pw] = extrapolation_value;
+                continue;
+              }
+
+              const float top_left(static_cast<float>(bottom_top_row[x.low]));
+              const float top_right(static_cast<float>(bottom_top_row[x.high]));
+              const float bottom_left(static_cast<float>(bottom_bottom_row[x.low]));
+              const float bottom_right(static_cast<float>(bottom_bottom_row[x.high]));
+              const float top = top_left + (top_right - top_left) * x.lerp;
+              const float bottom = bottom_left + (bottom_right - bottom_left) * x.lerp;
+              top_row[pw] = top + (bottom - top) * y.lerp;
+            }
+          } else {  // mode == "nearest"
+            const T* bottom_row = offset_bottom_data + y.nearest * width;
+            for (int64_t pw = 0; pw < pooled_width; pw++) {
+              const auto& x = x_coefficients[pw];
+              top_row[pw] = x.in_bounds ? static_cast<float>(bottom_row[x.nearest]) : extrapolation_value;
+            }
           }
-        }
-      }  // for pw
-    }    // for ph
-  }, 0);    // for n
+        }  // for ph
+      }    // for c
+    }      // for work
+  });
 }
 
 template <typename T>
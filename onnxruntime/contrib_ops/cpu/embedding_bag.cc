@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "embedding_bag.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    EmbeddingBag,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("Tind", std::vector<MLDataType>{DataTypeImpl::GetTensorType<int32_t>(),
+                                                        DataTypeImpl::GetTensorType<int64_t>()}),
+    EmbeddingBag<float>);
+
+template <typename T>
+EmbeddingBag<T>::EmbeddingBag(const OpKernelInfo& info) : OpKernel(info) {
+  std::string mode = info.GetAttrOrDefault<std::string>("mode", "sum");
+  if (mode == "sum") {
+    mode_ = Mode::Sum;
+  } else if (mode == "mean") {
+    mode_ = Mode::Mean;
+  } else if (mode == "max") {
+    mode_ = Mode::Max;
+  } else {
+    ORT_THROW("EmbeddingBag: unsupported mode '", mode, "'. Expected 'sum', 'mean' or 'max'.");
+  }
+}
+
+template <typename T>
+template <typename Tind>
+Status EmbeddingBag<T>::ComputeImpl(const Tensor& weight, const Tensor& indices, Tensor& output,
+                                    concurrency::ThreadPool* tp) const {
+  const int64_t num_embeddings = weight.Shape()[0];
+  const int64_t embedding_dim = weight.Shape()[1];
+  const int64_t num_bags = indices.Shape()[0];
+  const int64_t bag_size = indices.Shape()[1];
+
+  const T* weight_data = weight.template Data<T>();
+  const Tind* indices_data = indices.template Data<Tind>();
+  T* output_data = output.template MutableData<T>();
+
+  // Validate all of the indices up front so that the bags can be reduced in parallel
+  // without any error handling. The offending index is only searched for on failure.
+  const int64_t num_indices = num_bags * bag_size;
+  bool indices_in_bounds = true;
+  for (int64_t i = 0; i < num_indices; ++i) {
+    int64_t idx = static_cast<int64_t>(indices_data[i]);
+    indices_in_bounds &= (idx >= -num_embeddings) & (idx < num_embeddings);
+  }
+  if (!indices_in_bounds) {
+    for (int64_t i = 0; i < num_indices; ++i) {
+      int64_t idx = static_cast<int64_t>(indices_data[i]);
+      if (idx < -num_embeddings || idx >= num_embeddings) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "EmbeddingBag: indices element out of data bounds, idx=", idx,
+                               " must be within the inclusive range [", -num_embeddings, ",", num_embeddings - 1, "]");
+      }
+    }
+  }
+
+  const Mode mode = mode_;
+
+  auto reduce_bags = [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (std::ptrdiff_t bag = first; bag < last; ++bag) {
+      const Tind* bag_indices = indices_data + bag * bag_size;
+      EigenVectorArrayMap<T> out(output_data + bag * embedding_dim, embedding_dim);
+
+      if (bag_size == 0) {
+        out.setZero();
+        continue;
+      }
+
+      auto row = [&](int64_t j) {
+        int64_t idx = static_cast<int64_t>(bag_indices[j]);
+        idx = idx < 0 ? idx + num_embeddings : idx;
+        return ConstEigenVectorArrayMap<T>(weight_data + idx * embedding_dim, embedding_dim);
+      };
+
+      out = row(0);
+
+      if (mode == Mode::Max) {
+        for (int64_t j = 1; j < bag_size; ++j) {
+          out = out.max(row(j));
+        }
+      } else {
+        for (int64_t j = 1; j < bag_size; ++j) {
+          out += row(j);
+        }
+        if (mode == Mode::Mean) {
+          out *= static_cast<T>(1) / static_cast<T>(bag_size);
+        }
+      }
+    }
+  };
+
+  const double bag_bytes = static_cast<double>(bag_size * embedding_dim * sizeof(T));
+  concurrency::ThreadPool::TryParallelFor(tp, num_bags,
+                                          TensorOpCost{bag_bytes + static_cast<double>(bag_size * sizeof(Tind)),
+                                                       static_cast<double>(embedding_dim * sizeof(T)),
+                                                       static_cast<double>(bag_size * embedding_dim)},
+                                          reduce_bags);
+
+  return Status::OK();
+}
+
+template <typename T>
+Status EmbeddingBag<T>::Compute(OpKernelContext* context) const {
+  const Tensor* weight = context->Input<Tensor>(0);
+  const Tensor* indices = context->Input<Tensor>(1);
+
+  const auto& weight_shape = weight->Shape();
+  const auto& indices_shape = indices->Shape();
+
+  if (weight_shape.NumDimensions() != 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "EmbeddingBag: weight is expected to have 2 dimensions, got ", weight_shape.NumDimensions());
+  }
+  if (indices_shape.NumDimensions() != 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "EmbeddingBag: indices is expected to have 2 dimensions, got ", indices_shape.NumDimensions());
+  }
+
+  Tensor* output = context->Output(0, {indices_shape[0], weight_shape[1]});
+  if (output->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+
+  if (indices->IsDataType<int32_t>()) {
+    return ComputeImpl<int32_t>(*weight, *indices, *output, tp);
+  }
+  return ComputeImpl<int64_t>(*weight, *indices, *output, tp);
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
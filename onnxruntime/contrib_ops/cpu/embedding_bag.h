@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+template <typename T>
+class EmbeddingBag final : public OpKernel {
+ public:
+  explicit EmbeddingBag(const OpKernelInfo& info);
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  enum class Mode {
+    Sum,
+    Mean,
+    Max,
+  };
+
+  template <typename Tind>
+  Status ComputeImpl(const Tensor& weight, const Tensor& indices, Tensor& output,
+                     concurrency::ThreadPool* tp) const;
+
+  Mode mode_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,298 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "fused_elementwise.h"
+
+#include <algorithm>
+
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .MayInplace(0, 0)
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  static const std::unordered_map<std::string, OpKind> op_kinds = {
+      {"Relu", OpKind::Relu},
+      {"Sigmoid", OpKind::Sigmoid},
+      {"Tanh", OpKind::Tanh},
+      {"Neg", OpKind::Neg},
+      {"Abs", OpKind::Abs},
+      {"Exp", OpKind::Exp},
+      {"Log", OpKind::Log},
+      {"Sqrt", OpKind::Sqrt},
+      {"Reciprocal", OpKind::Reciprocal},
+      {"Erf", OpKind::Erf},
+      {"Add", OpKind::Add},
+      {"Sub", OpKind::Sub},
+      {"Mul", OpKind::Mul},
+      {"Div", OpKind::Div},
+  };
+
+  std::vector<std::string> ops;
+  ORT_ENFORCE(info.GetAttrs<std::string>("ops", ops).IsOK() && !ops.empty(),
+              "FusedElementwise: the 'ops' attribute must list at least one operation.");
+
+  std::vector<int64_t> operands = info.GetAttrsOrDefault<int64_t>("operands");
+  std::vector<float> scalars = info.GetAttrsOrDefault<float>("scalars");
+  std::vector<int64_t> operand_first = info.GetAttrsOrDefault<int64_t>("operand_first");
+  ORT_ENFORCE(operands.empty() || operands.size() == ops.size(),
+              "FusedElementwise: 'operands' must have one value per operation.");
+  ORT_ENFORCE(scalars.empty() || scalars.size() == ops.size(),
+              "FusedElementwise: 'scalars' must have one value per operation.");
+  ORT_ENFORCE(operand_first.empty() || operand_first.size() == ops.size(),
+              "FusedElementwise: 'operand_first' must have one value per operation.");
+
+  input_count_ = static_cast<size_t>(info.GetInputCount());
+  value_is_operand_.assign(input_count_ + ops.size(), false);
+
+  steps_.reserve(ops.size());
+  for (size_t i = 0; i < ops.size(); ++i) {
+    auto op_kind = op_kinds.find(ops[i]);
+    if (op_kind == op_kinds.end()) {
+      ORT_THROW("FusedElementwise: unsupported operation '", ops[i], "'.");
+    }
+
+    Step step{op_kind->second, -1, 0.0f, false};
+
+    if (op_kind->second >= OpKind::Add) {
+      step.operand = operands.empty() ? -1 : operands[i];
+      if (step.operand < 0) {
+        ORT_ENFORCE(!scalars.empty(), "FusedElementwise: the binary operation '", ops[i], "' requires 'scalars'.");
+        step.scalar = scalars[i];
+      } else {
+        // a step can only use the inputs and the results of the steps before it
+        ORT_ENFORCE(static_cast<size_t>(step.operand) < input_count_ + i,
+                    "FusedElementwise: operation ", i, " uses the undefined value ", step.operand, ".");
+        value_is_operand_[static_cast<size_t>(step.operand)] = true;
+      }
+      step.operand_first = !operand_first.empty() && operand_first[i] != 0;
+    }
+
+    steps_.push_back(step);
+  }
+}
+
+void FusedElementwise::ApplyStep(const Step& step, const float* input, const float* operand, float* output,
+                                 size_t count) {
+  ConstEigenVectorArrayMap<float> x(input, count);
+  EigenVectorArrayMap<float> y(output, count);
+
+  switch (step.kind) {
+    case OpKind::Relu:
+      y = x.cwiseMax(0.0f);
+      return;
+    case OpKind::Sigmoid:
+      MlasComputeLogistic(input, output, count);
+      return;
+    case OpKind::Tanh:
+      MlasComputeTanh(input, output, count);
+      return;
+    case OpKind::Neg:
+      y = -x;
+      return;
+    case OpKind::Abs:
+      y = x.abs();
+      return;
+    case OpKind::Exp:
+      MlasComputeExp(input, output, count);
+      return;
+    case OpKind::Log:
+      y = x.log();
+      return;
+    case OpKind::Sqrt:
+      y = x.sqrt();
+      return;
+    case OpKind::Reciprocal:
+      y = x.inverse();
+      return;
+    case OpKind::Erf:
+      MlasComputeErf(input, output, count);
+      return;
+    default:
+      break;
+  }
+
+  if (operand == nullptr) {
+    switch (step.kind) {
+      case OpKind::Add:
+        y = x + step.scalar;
+        break;
+      case OpKind::Sub:
+        if (step.operand_first) {
+          y = step.scalar - x;
+        } else {
+          y = x - step.scalar;
+        }
+        break;
+      case OpKind::Mul:
+        y = x * step.scalar;
+        break;
+      case OpKind::Div:
+        if (step.operand_first) {
+          y = step.scalar / x;
+        } else {
+          y = x / step.scalar;
+        }
+        break;
+      default:
+        break;
+    }
+    return;
+  }
+
+  ConstEigenVectorArrayMap<float> b(operand, count);
+
+  switch (step.kind) {
+    case OpKind::Add:
+      y = x + b;
+      break;
+    case OpKind::Sub:
+      if (step.operand_first) {
+        y = b - x;
+      } else {
+        y = x - b;
+      }
+      break;
+    case OpKind::Mul:
+      y = x * b;
+      break;
+    case OpKind::Div:
+      if (step.operand_first) {
+        y = b / x;
+      } else {
+        y = x / b;
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  // Number of elements processed by all of the operations before moving to the next block.
+  // The block is small enough to stay in the L1 cache between the operations.
+  constexpr std::ptrdiff_t block_size = 4096;
+
+  const auto* X = context->Input<Tensor>(0);
+  const auto& x_shape = X->Shape();
+  auto* Y = context->Output(0, x_shape);
+
+  const float* x_data = X->Data<float>();
+  float* y_data = Y->MutableData<float>();
+
+  const std::ptrdiff_t element_count = static_cast<std::ptrdiff_t>(x_shape.Size());
+  const std::ptrdiff_t block_count = (element_count + block_size - 1) / block_size;
+
+  // The other inputs are broadcast to the shape of X, so without the leading ones their shape is a suffix of
+  // the shape of X and the element at an offset into X is the element at that offset modulo their size.
+  std::vector<const float*> input_data(input_count_);
+  std::vector<std::ptrdiff_t> input_sizes(input_count_);
+  input_data[0] = x_data;
+  input_sizes[0] = element_count;
+
+  for (size_t i = 1; i < input_count_; ++i) {
+    const auto* input = context->Input<Tensor>(static_cast<int>(i));
+    const auto& input_shape = input->Shape();
+
+    size_t leading_ones = 0;
+    while (leading_ones < input_shape.NumDimensions() && input_shape[leading_ones] == 1) {
+      ++leading_ones;
+    }
+
+    const size_t rank = input_shape.NumDimensions() - leading_ones;
+    bool is_suffix = rank <= x_shape.NumDimensions();
+    for (size_t d = 0; is_suffix && d < rank; ++d) {
+      is_suffix = input_shape[leading_ones + d] == x_shape[x_shape.NumDimensions() - rank + d];
+    }
+
+    if (!is_suffix) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedElementwise: input ", i, " with shape ",
+                             input_shape, " can't be broadcast to the shape of the first input ", x_shape, ".");
+    }
+
+    input_data[i] = input->Data<float>();
+    input_sizes[i] = static_cast<std::ptrdiff_t>(input_shape.Size());
+  }
+
+  // Values that are used as operands are kept in a buffer for the block, except for inputs that don't need to
+  // be broadcast. The first input also has to be copied if the output is written over it.
+  std::vector<bool> value_is_buffered(value_is_operand_.size(), false);
+  size_t buffer_count = 0;
+  for (size_t i = 0; i < value_is_operand_.size(); ++i) {
+    if (value_is_operand_[i]) {
+      if (i >= input_count_ || input_sizes[i] != element_count || (i == 0 && x_data == y_data)) {
+        value_is_buffered[i] = true;
+        ++buffer_count;
+      }
+    }
+  }
+
+  const double block_bytes = static_cast<double>(block_size * sizeof(float));
+  const double block_cost = static_cast<double>(block_size * steps_.size());
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), block_count,
+      TensorOpCost{block_bytes * static_cast<double>(input_count_), block_bytes, block_cost},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> buffers(static_cast<size_t>(block_size) * buffer_count);
+        std::vector<const float*> values(value_is_operand_.size(), nullptr);
+
+        for (std::ptrdiff_t block = first; block < last; ++block) {
+          const std::ptrdiff_t offset = block * block_size;
+          const auto count = static_cast<size_t>(std::min(block_size, element_count - offset));
+          float* y_block = y_data + offset;
+          float* buffer = buffers.data();
+
+          for (size_t i = 0; i < input_count_; ++i) {
+            if (value_is_buffered[i]) {
+              // gather the elements of the block, which repeat if the input is broadcast
+              const float* data = input_data[i];
+              const std::ptrdiff_t size = input_sizes[i];
+              std::ptrdiff_t index = offset % size;
+              for (size_t j = 0; j < count; ++j) {
+                buffer[j] = data[index];
+                if (++index == size) {
+                  index = 0;
+                }
+              }
+              values[i] = buffer;
+              buffer += block_size;
+            } else {
+              values[i] = input_data[i] + offset;
+            }
+          }
+
+          const float* input = values[0];
+          for (size_t i = 0; i < steps_.size(); ++i) {
+            const Step& step = steps_[i];
+            const float* operand = step.operand >= 0 ? values[static_cast<size_t>(step.operand)] : nullptr;
+            ApplyStep(step, input, operand, y_block, count);
+            input = y_block;
+
+            const size_t value = input_count_ + i;
+            if (value_is_buffered[value]) {
+              std::copy_n(y_block, count, buffer);
+              values[value] = buffer;
+              buffer += block_size;
+            }
+          }
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Applies a chain of elementwise operations to a float tensor one cache sized block at a time,
+// so the intermediate results of the chain are never written to memory. The other operand of a
+// binary operation is a scalar, a value computed earlier in the chain or another input tensor that
+// is broadcast to the shape of the first input.
+class FusedElementwise final : public OpKernel {
+ public:
+  explicit FusedElementwise(const OpKernelInfo& info);
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  enum class OpKind {
+    Relu,
+    Sigmoid,
+    Tanh,
+    Neg,
+    Abs,
+    Exp,
+    Log,
+    Sqrt,
+    Reciprocal,
+    Erf,
+    Add,
+    Sub,
+    Mul,
+    Div,
+  };
+
+  struct Step {
+    OpKind kind;
+    // the other operand of a binary operation is the value at this index or the scalar if negative
+    int64_t operand;
+    float scalar;
+    bool operand_first;
+  };
+
+  static void ApplyStep(const Step& step, const float* input, const float* operand, float* output, size_t count);
+
+  std::vector<Step> steps_;
+  // number of inputs, which are the values before the results of the steps
+  size_t input_count_;
+  // whether each value is used as the operand of a later step
+  std::vector<bool> value_is_operand_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,130 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/fused_scaler.h"
+
+#include <cmath>
+#include "core/framework/data_types_internal.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedScaler,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", std::vector<MLDataType>{DataTypeImpl::GetTensorType<float>(),
+                                                     DataTypeImpl::GetTensorType<double>(),
+                                                     DataTypeImpl::GetTensorType<int64_t>(),
+                                                     DataTypeImpl::GetTensorType<int32_t>()})
+        .MayInplace(0, 0),
+    FusedScaler);
+
+FusedScaler::FusedScaler(const OpKernelInfo& info)
+    : OpKernel(info),
+      imputed_values_(info.GetAttrsOrDefault<float>("imputed_values")),
+      replaced_value_(info.GetAttrOrDefault<float>("replaced_value", 0.f)),
+      scale_(info.GetAttrsOrDefault<float>("scale")),
+      offset_(info.GetAttrsOrDefault<float>("offset")) {
+  ORT_ENFORCE(scale_.size() == offset_.size(),
+              "Scale size: (" + std::to_string(scale_.size()) + ") != (" + std::to_string(offset_.size()) + ")");
+  std::string norm = info.GetAttrOrDefault<std::string>("norm", "");
+  if (!norm.empty()) {
+    normalize_ = true;
+    normalization_ = ml::MakeNormalize(norm);
+  }
+}
+
+template <typename T>
+Status FusedScaler::ComputeImpl(OpKernelContext* context) const {
+  const Tensor& X = *context->Input<Tensor>(0);
+  const TensorShape& x_shape = X.Shape();
+  if (x_shape.NumDimensions() == 0 || x_shape.NumDimensions() > 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedScaler: input is expected to have 1 or 2 dimensions, got ",
+                           x_shape.NumDimensions());
+  }
+
+  const auto& x_dims = x_shape.GetDims();
+  const int64_t num_rows = x_dims.size() == 1 ? 1 : x_dims[0];
+  const int64_t num_features = x_dims.size() == 1 ? x_dims[0] : x_dims[1];
+
+  const bool impute = !imputed_values_.empty();
+  if (impute && imputed_values_.size() != 1 && static_cast<int64_t>(imputed_values_.size()) != num_features) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedScaler: imputed_values can be of feature size (",
+                           num_features, ") or 1");
+  }
+  const bool scale = !scale_.empty();
+  if (scale && scale_.size() != 1 && static_cast<int64_t>(scale_.size()) != num_features) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedScaler: either both scale and offset can be of feature size (",
+                           num_features, ") or 1");
+  }
+
+  Tensor* Y = context->Output(0, x_shape);
+  if (num_features == 0) {
+    return Status::OK();
+  }
+
+  const T* x_data = X.template Data<T>();
+  float* y_data = Y->MutableData<float>();
+
+  // a size of 1 is broadcast to all the features by a stride of 0
+  const float* imputed_values = imputed_values_.data();
+  const size_t imputed_stride = imputed_values_.size() == 1 ? 0 : 1;
+  const bool replaced_is_nan = std::isnan(replaced_value_);
+  const T replaced_value = static_cast<T>(replaced_is_nan ? 0.f : replaced_value_);
+  const float* scale_data = scale_.data();
+  const float* offset_data = offset_.data();
+  const size_t scale_stride = scale_.size() == 1 ? 0 : 1;
+  const bool normalize = normalize_;
+  const ml::NORMALIZE normalization = normalization_;
+
+  // each row is imputed and scaled into the output, reading each value before writing it for in-place use,
+  // and then normalized in place, while it is still in cache.
+  auto transform_rows = [=](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (std::ptrdiff_t row = first; row < last; ++row) {
+      const T* x = x_data + row * num_features;
+      float* y = y_data + row * num_features;
+      for (int64_t i = 0; i < num_features; ++i) {
+        T value = x[i];
+        if (impute) {
+          const bool replace = replaced_is_nan ? std::isnan(static_cast<float>(value)) : value == replaced_value;
+          value = replace ? static_cast<T>(imputed_values[i * imputed_stride]) : value;
+        }
+        y[i] = scale ? static_cast<float>((value - offset_data[i * scale_stride]) * scale_data[i * scale_stride])
+                     : static_cast<float>(value);
+      }
+      if (normalize) {
+        ml::NormalizeRow(normalization, y, y, num_features);
+      }
+    }
+  };
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), num_rows,
+      TensorOpCost{static_cast<double>(num_features * sizeof(T)), static_cast<double>(num_features * sizeof(float)),
+                   static_cast<double>(num_features * 8)},
+      transform_rows);
+
+  return Status::OK();
+}
+
+template <class T>
+struct FusedScaler::CallComputeImpl {
+  Status operator()(const FusedScaler* kernel, OpKernelContext* ctx) const {
+    return kernel->ComputeImpl<T>(ctx);
+  }
+};
+
+Status FusedScaler::Compute(OpKernelContext* context) const {
+  const auto& X = *context->Input<Tensor>(0);
+
+  utils::MLTypeCallDispatcherRet<Status, CallComputeImpl, float, double, int64_t, int32_t>
+      t_disp(X.GetElementType());
+  return t_disp.Invoke(this, context);
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
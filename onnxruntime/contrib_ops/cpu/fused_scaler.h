@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/providers/cpu/ml/ml_common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// An ai.onnx.ml Scaler fused with the Imputer before it and the Normalizer after it, each of them optional.
+// The rows of features are imputed, scaled and normalized in one pass, on the thread pool.
+class FusedScaler final : public OpKernel {
+ public:
+  explicit FusedScaler(const OpKernelInfo& info);
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename T>
+  Status ComputeImpl(OpKernelContext* context) const;
+
+  template <class>
+  struct CallComputeImpl;
+
+  std::vector<float> imputed_values_;
+  float replaced_value_;
+  std::vector<float> scale_;
+  std::vector<float> offset_;
+  bool normalize_{false};
+  ml::NORMALIZE normalization_{ml::NORMALIZE::NMAX};
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
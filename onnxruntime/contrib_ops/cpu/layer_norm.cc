@@ -5,6 +5,7 @@
 
 #include "core/common/safeint.h"
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
@@ -35,6 +36,58 @@ namespace contrib {
 REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(double)
 
+namespace {
+
+template <typename T>
+void ComputeLayerNormRow(const T* p_input, T* p_output, const T* scale_data, const T* bias_data,
+                         int64_t norm_size, float epsilon, bool simplified, T& mean, T& inv_std_var) {
+  mean = 0;
+  T mean_square = 0;
+
+  for (int64_t h = 0; h < norm_size; h++) {
+    mean += p_input[h];
+    mean_square += p_input[h] * p_input[h];
+  }
+
+  mean = mean / norm_size;
+  if (simplified) {
+    mean_square = sqrt(mean_square / norm_size + epsilon);
+  } else {
+    mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon);
+  }
+
+  for (int64_t h = 0; h < norm_size; h++) {
+    if (simplified) {
+      p_output[h] = p_input[h] / mean_square * scale_data[h];
+    } else {
+      p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
+    }
+  }
+
+  inv_std_var = 1 / mean_square;
+}
+
+// The float version computes the statistics in one vectorized pass over the row and
+// then normalizes the row in a second vectorized pass.
+void ComputeLayerNormRow(const float* p_input, float* p_output, const float* scale_data, const float* bias_data,
+                         int64_t norm_size, float epsilon, bool simplified, float& mean, float& inv_std_var) {
+  float mean_square;
+  MlasComputeMeanAndMeanSquare(p_input, nullptr, nullptr, nullptr, static_cast<size_t>(norm_size),
+                               &mean, &mean_square);
+
+  if (simplified) {
+    inv_std_var = 1.0f / std::sqrt(mean_square + epsilon);
+    MlasComputeNormalizeScaleShift(p_input, p_output, static_cast<size_t>(norm_size), 0.0f, inv_std_var,
+                                   scale_data, nullptr);
+  } else {
+    inv_std_var = 1.0f / std::sqrt(mean_square - mean * mean + epsilon);
+    MlasComputeNormalizeScaleShift(p_input, p_output, static_cast<size_t>(norm_size), mean, inv_std_var,
+                                   scale_data, bias_data);
+  }
+}
+
+}  // namespace
+
 template <typename T, bool simplified>
 LayerNorm<T, simplified>::LayerNorm(const OpKernelInfo& op_kernel_info)
     : OpKernel(op_kernel_info) {
@@ -106,33 +159,15 @@ Status LayerNorm<T, simplified>::Compute(OpKernelContext* p_ctx) const {
                                                  const T* p_input = X_data + task_idx * norm_size;
                                                  T* p_output = Y_data + task_idx * norm_size;
 
-                                                 T mean = 0;
-                                                 T mean_square = 0;
-
-                                                 for (int64_t h = 0; h < norm_size; h++) {
-                                                   mean += p_input[h];
-                                                   mean_square += p_input[h] * p_input[h];
-                                                 }
-
-                                                 mean = mean / norm_size;
-                                                 if (simplified) {
-                                                   mean_square = sqrt(mean_square / norm_size + epsilon_);
-                                                 } else {
-                                                   mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon_);
-                                                 }
-
-                                                 for (int64_t h = 0; h < norm_size; h++) {
-                                                   if (simplified) {
-                                                     p_output[h] = p_input[h] / mean_square * scale_data[h];
-                                                   } else {
-                                                     p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
-                                                   }
-                                                 }
+                                                 T row_mean;
+                                                 T row_inv_std_var;
+                                                 ComputeLayerNormRow(p_input, p_output, scale_data, bias_data, norm_size,
+                                                                     epsilon_, simplified, row_mean, row_inv_std_var);
 
                                                  if (mean_data != nullptr) {
-                                                   mean_data[task_idx] = mean;
+                                                   mean_data[task_idx] = row_mean;
                                                  }
-                                                 inv_std_var_data[task_idx] = 1 / mean_square;
+                                                 inv_std_var_data[task_idx] = row_inv_std_var;
                                                }, 0);
 
   return Status::OK();
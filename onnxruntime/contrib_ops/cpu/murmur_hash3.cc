@@ -9,6 +9,9 @@
 
 #include "contrib_ops/cpu/murmur_hash3.h"
 
+#include <algorithm>
+#include "core/platform/threadpool.h"
+
 // Platform-specific functions and macros
 
 // Microsoft Visual Studio
@@ -92,27 +95,38 @@ FORCE_INLINE uint64_t fmix(uint64_t k) {
   return k;
 }
 
+//-----------------------------------------------------------------------------
+// Mix a 32 bit block of the key into the hash
+
+FORCE_INLINE uint32_t mix_block(uint32_t h1, uint32_t k1) {
+  const uint32_t c1 = 0xcc9e2d51;
+  const uint32_t c2 = 0x1b873593;
+
+  k1 *= c1;
+  k1 = ROTL32(k1, 15);
+  k1 *= c2;
+
+  h1 ^= k1;
+  h1 = ROTL32(h1, 13);
+  return h1 * 5 + 0xe6546b64;
+}
+
 namespace onnxruntime {
 namespace contrib {
 
-ONNX_OPERATOR_KERNEL_EX(
-    MurmurHash3,
-    kMSDomain,
-    1,
-    kCpuExecutionProvider,
-    KernelDefBuilder()
-        .TypeConstraint("T1", std::vector<MLDataType>{DataTypeImpl::GetTensorType<int32_t>(),
-                                                      DataTypeImpl::GetTensorType<uint32_t>(),
-                                                      DataTypeImpl::GetTensorType<int64_t>(),
-                                                      DataTypeImpl::GetTensorType<uint64_t>(),
-                                                      DataTypeImpl::GetTensorType<float>(),
-                                                      DataTypeImpl::GetTensorType<double>(),
-                                                      DataTypeImpl::GetTensorType<std::string>()})
-        .TypeConstraint("T2", std::vector<MLDataType>{DataTypeImpl::GetTensorType<int32_t>(),
-                                                      DataTypeImpl::GetTensorType<uint32_t>()}),
-    MurmurHash3);
+namespace {
+
+std::vector<MLDataType> MurmurHash3KeyTypes() {
+  return std::vector<MLDataType>{DataTypeImpl::GetTensorType<int32_t>(),
+                                 DataTypeImpl::GetTensorType<uint32_t>(),
+                                 DataTypeImpl::GetTensorType<int64_t>(),
+                                 DataTypeImpl::GetTensorType<uint64_t>(),
+                                 DataTypeImpl::GetTensorType<float>(),
+                                 DataTypeImpl::GetTensorType<double>(),
+                                 DataTypeImpl::GetTensorType<std::string>()};
+}
 
-void MurmurHash3::MurmurHash3_x86_32(const void* key, int len, uint32_t seed, void* out) const {
+uint32_t MurmurHash3_x86_32(const void* key, int len, uint32_t seed) {
   const uint8_t* data = reinterpret_cast<const uint8_t*>(key);
   const int nblocks = len / 4;
   uint32_t h1 = seed;
@@ -124,15 +138,7 @@ void MurmurHash3::MurmurHash3_x86_32(const void* key, int len, uint32_t seed, vo
   const uint32_t* blocks = reinterpret_cast<const uint32_t*>(data + static_cast<int64_t>(nblocks) * 4);
 
   for (int i = -nblocks; i; i++) {
-    uint32_t k1 = getblock(blocks, i);
-
-    k1 *= c1;
-    k1 = ROTL32(k1, 15);
-    k1 *= c2;
-
-    h1 ^= k1;
-    h1 = ROTL32(h1, 13);
-    h1 = h1 * 5 + 0xe6546b64;
+    h1 = mix_block(h1, getblock(blocks, i));
   }
 
   //----------
@@ -158,15 +164,84 @@ void MurmurHash3::MurmurHash3_x86_32(const void* key, int len, uint32_t seed, vo
   // finalization
   h1 ^= len;
 
-  h1 = fmix(h1);
+  return fmix(h1);
+}
+
+// MurmurHash3_x86_32 of a key of one or two 32 bit blocks. The length is known at compile time, so there is no
+// tail and the loops over the keys below are vectorized by the compiler across the keys.
+template <typename TKey>
+uint32_t HashFixedWidthKey(const uint32_t* key, uint32_t seed);
+
+template <>
+FORCE_INLINE uint32_t HashFixedWidthKey<uint32_t>(const uint32_t* key, uint32_t seed) {
+  return fmix(mix_block(seed, key[0]) ^ 4u);
+}
+
+template <>
+FORCE_INLINE uint32_t HashFixedWidthKey<uint64_t>(const uint32_t* key, uint32_t seed) {
+  return fmix(mix_block(mix_block(seed, key[0]), key[1]) ^ 8u);
+}
+
+template <typename TKey>
+void HashFixedWidthKeys(const void* keys, uint32_t seed, ptrdiff_t first, ptrdiff_t last, uint32_t* hashes) {
+  constexpr ptrdiff_t num_blocks = sizeof(TKey) / sizeof(uint32_t);
+  const uint32_t* input = reinterpret_cast<const uint32_t*>(keys) + first * num_blocks;
+  const ptrdiff_t count = last - first;
+  for (ptrdiff_t i = 0; i < count; ++i) {
+    hashes[i] = HashFixedWidthKey<TKey>(input + i * num_blocks, seed);
+  }
+}
 
-  if (is_positive_) {
-    *(uint32_t*)out = h1;
+// Writes the hashes of the keys in [first, last) to hashes[0, last - first).
+void HashKeys(const Tensor& keys, uint32_t seed, ptrdiff_t first, ptrdiff_t last, uint32_t* hashes) {
+  if (keys.IsDataTypeString()) {
+    const std::string* input = keys.Data<std::string>();
+    for (ptrdiff_t i = first; i < last; ++i) {
+      *hashes++ = MurmurHash3_x86_32(input[i].c_str(), static_cast<int>(input[i].length()), seed);
+    }
+  } else if (keys.DataType()->Size() == sizeof(uint32_t)) {
+    HashFixedWidthKeys<uint32_t>(keys.DataRaw(), seed, first, last, hashes);
   } else {
-    *(int32_t*)out = h1;
+    // input element size is 4 or 8 bytes, less than 4 bytes is not allowed
+    ORT_ENFORCE(keys.DataType()->Size() == sizeof(uint64_t), "Invalid input element size");
+    HashFixedWidthKeys<uint64_t>(keys.DataRaw(), seed, first, last, hashes);
   }
 }
 
+// The cost of hashing one key. The lengths of string keys aren't looked at up front; they are
+// assumed to be short, as in feature hashing.
+TensorOpCost HashCost(const Tensor& keys) {
+  if (keys.IsDataTypeString()) {
+    return TensorOpCost{static_cast<double>(sizeof(std::string) + 16), static_cast<double>(sizeof(uint32_t)), 64.0};
+  }
+  const auto key_bytes = keys.DataType()->Size();
+  return TensorOpCost{static_cast<double>(key_bytes), static_cast<double>(sizeof(uint32_t)),
+                      static_cast<double>(2 * key_bytes + 8)};
+}
+
+}  // namespace
+
+ONNX_OPERATOR_KERNEL_EX(
+    MurmurHash3,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", MurmurHash3KeyTypes())
+        .TypeConstraint("T2", std::vector<MLDataType>{DataTypeImpl::GetTensorType<int32_t>(),
+                                                      DataTypeImpl::GetTensorType<uint32_t>()}),
+    MurmurHash3);
+
+ONNX_OPERATOR_KERNEL_EX(
+    MurmurHash3Bucket,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", MurmurHash3KeyTypes())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<int64_t>()),
+    MurmurHash3Bucket);
+
 Status MurmurHash3::Compute(OpKernelContext* ctx) const {
   const Tensor* keys = ctx->Input<Tensor>(0);
   ORT_ENFORCE(keys);
@@ -174,43 +249,59 @@ Status MurmurHash3::Compute(OpKernelContext* ctx) const {
   const TensorShape& input_shape = keys->Shape();
   Tensor* output_tensor = ctx->Output(0, input_shape);
 
-  const bool is_string = keys->IsDataTypeString();
-
-  const auto input_element_bytes = keys->DataType()->Size();
   const auto output_element_bytes = output_tensor->DataType()->Size();
-  const int64_t input_count = input_shape.Size();
   // Output type is inferred by the inference function and it can be of two types int32_t and uint32_t
   // however, all is needed is a ptr that can step 4 bytes at a time and for that reason we choose
   // raw data casted to a type of choice.
   ORT_ENFORCE(sizeof(uint32_t) == output_element_bytes, "Invalid assumption of output element size");
   auto output = reinterpret_cast<uint32_t*>(output_tensor->MutableDataRaw());
 
-  if (is_string) {
-    auto input = keys->Data<std::string>();
-    const auto input_end = input + input_count;
-    while (input != input_end) {
-      MurmurHash3_x86_32(input->c_str(),
-                         static_cast<int>(input->length()),
-                         seed_,
-                         output);
-      ++input;
-      ++output;
-    }
-  } else {
-    auto input = reinterpret_cast<const unsigned char*>(keys->DataRaw());
-    //input_element_bytes is 4, 8,.. less than 4 bytes is not allowed
-    int input_num_bytes = static_cast<int>(input_element_bytes);
-    ORT_ENFORCE(input_num_bytes % 4 == 0);
-    const auto input_end = input + input_count * input_num_bytes;
-    while (input != input_end) {
-      MurmurHash3_x86_32(input,
-                         input_num_bytes,
-                         seed_,
-                         output);
-      input += input_num_bytes;
-      ++output;
+  const uint32_t seed = seed_;
+  concurrency::ThreadPool::TryParallelFor(ctx->GetOperatorThreadPool(), input_shape.Size(), HashCost(*keys),
+                                          [keys, seed, output](ptrdiff_t first, ptrdiff_t last) {
+                                            HashKeys(*keys, seed, first, last, output + first);
+                                          });
+  return Status::OK();
+}
+
+Status MurmurHash3Bucket::Compute(OpKernelContext* ctx) const {
+  const Tensor* keys = ctx->Input<Tensor>(0);
+  ORT_ENFORCE(keys);
+
+  const TensorShape& input_shape = keys->Shape();
+  Tensor* output_tensor = ctx->Output(0, input_shape);
+  auto output = output_tensor->MutableData<int64_t>();
+
+  TensorOpCost cost = HashCost(*keys);
+  cost.bytes_stored = static_cast<double>(sizeof(int64_t));
+  cost.compute_cycles += 24.0;  // the division of the bucketing
+
+  const uint32_t seed = seed_;
+  const bool is_positive = is_positive_;
+  const int64_t num_buckets = num_buckets_;
+  auto hash_to_buckets = [keys, seed, is_positive, num_buckets, output](ptrdiff_t first, ptrdiff_t last) {
+    // The keys are hashed a chunk at a time into a local buffer so that the hashing loop stays vectorizable.
+    constexpr ptrdiff_t chunk_size = 256;
+    uint32_t hashes[chunk_size];
+    for (ptrdiff_t chunk_begin = first; chunk_begin < last; chunk_begin += chunk_size) {
+      const ptrdiff_t chunk_end = std::min(chunk_begin + chunk_size, last);
+      HashKeys(*keys, seed, chunk_begin, chunk_end, hashes);
+      int64_t* out = output + chunk_begin;
+      const ptrdiff_t count = chunk_end - chunk_begin;
+      if (is_positive) {
+        for (ptrdiff_t i = 0; i < count; ++i) {
+          out[i] = static_cast<int64_t>(hashes[i]) % num_buckets;
+        }
+      } else {
+        // the absolute value of the signed hash, as scikit-learn's FeatureHasher and HashingVectorizer
+        for (ptrdiff_t i = 0; i < count; ++i) {
+          const int64_t hash = static_cast<int32_t>(hashes[i]);
+          out[i] = (hash < 0 ? -hash : hash) % num_buckets;
+        }
+      }
     }
-  }
+  };
+  concurrency::ThreadPool::TryParallelFor(ctx->GetOperatorThreadPool(), input_shape.Size(), cost, hash_to_buckets);
   return Status::OK();
 }
 
@@ -13,17 +13,33 @@ class MurmurHash3 final : public OpKernel {
  public:
   MurmurHash3(const OpKernelInfo& info) : OpKernel(info) {
     seed_ = static_cast<uint32_t>(info.GetAttrOrDefault<int64_t>("seed", 0));
-    is_positive_ = info.GetAttrOrDefault<int64_t>("positive", 1) == 1;
   }
 
   Status Compute(OpKernelContext* context) const override;
 
-private:
-  void MurmurHash3_x86_32(const void* key, int len, uint32_t seed, void* out) const;
+ private:
+  // the "positive" attribute only selects the output type, the bits of the hashes are the same
+  uint32_t seed_;
+};
 
-private :
+// Hashes the keys like MurmurHash3 and maps each hash to a bucket in [0, num_buckets), the feature hashing trick.
+// The int64 bucket ids can be consumed directly by OneHot, Gather or EmbeddingBag.
+class MurmurHash3Bucket final : public OpKernel {
+ public:
+  MurmurHash3Bucket(const OpKernelInfo& info) : OpKernel(info) {
+    seed_ = static_cast<uint32_t>(info.GetAttrOrDefault<int64_t>("seed", 0));
+    is_positive_ = info.GetAttrOrDefault<int64_t>("positive", 1) == 1;
+    ORT_ENFORCE(info.GetAttr<int64_t>("num_buckets", &num_buckets_).IsOK() && num_buckets_ > 0,
+                "num_buckets must be a positive integer");
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
   uint32_t seed_;
   bool is_positive_{true};
+  int64_t num_buckets_;
 };
+
 }  // namespace contrib
 }  // namespace onnxruntime
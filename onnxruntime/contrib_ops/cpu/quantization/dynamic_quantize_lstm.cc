@@ -12,7 +12,12 @@ class DynamicQuantizeLSTM : public OpKernel, public LSTMBase {
   DynamicQuantizeLSTM(const OpKernelInfo& info) : OpKernel(info), LSTMBase(info) {}
 
 #ifdef MLAS_SUPPORTS_PACKED_GEMM_U8X8
-  Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override;
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
 #endif
 
   Status Compute(OpKernelContext* context) const override;
@@ -21,7 +26,8 @@ class DynamicQuantizeLSTM : public OpKernel, public LSTMBase {
 
  private:
 #ifdef MLAS_SUPPORTS_PACKED_GEMM_U8X8
-  Status TryPackWeights(const Tensor& weights, PackedWeights& packed_weights, bool& is_packed, bool& is_weight_signed);
+  Status TryPackWeights(const Tensor& weights, PackedWeights& packed_weights, bool& is_packed, bool& is_weight_signed,
+                        AllocatorPtr alloc);
 #endif
 
   template <typename T>
@@ -34,7 +40,8 @@ class DynamicQuantizeLSTM : public OpKernel, public LSTMBase {
 };
 
 #ifdef MLAS_SUPPORTS_PACKED_GEMM_U8X8
-Status DynamicQuantizeLSTM::TryPackWeights(const Tensor& weights, PackedWeights& packed_weights, bool& is_packed, bool& is_weight_signed) {
+Status DynamicQuantizeLSTM::TryPackWeights(const Tensor& weights, PackedWeights& packed_weights, bool& is_packed, bool& is_weight_signed,
+                                           AllocatorPtr alloc) {
   const auto& shape = weights.Shape();
   if (shape.NumDimensions() != 3) {
     return Status::OK();
@@ -55,7 +62,6 @@ Status DynamicQuantizeLSTM::TryPackWeights(const Tensor& weights, PackedWeights&
     return Status::OK();
   }
 
-  auto alloc = Info().GetAllocator(0, OrtMemTypeDefault);
   auto* packed_weights_data = alloc->Alloc(SafeInt<size_t>(packed_weights_size) * num_directions_);
   packed_weights.buffer_ = BufferUniquePtr(packed_weights_data, BufferDeleter(alloc));
   packed_weights.weights_size_ = packed_weights_size;
@@ -72,13 +78,38 @@ Status DynamicQuantizeLSTM::TryPackWeights(const Tensor& weights, PackedWeights&
   return Status::OK();
 }
 
-Status DynamicQuantizeLSTM::PrePack(const Tensor& tensor, int input_idx, bool& is_packed) {
+Status DynamicQuantizeLSTM::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                                    /*out*/ PrePackedWeights* prepacked_weights) {
   is_packed = false;
 
+  PackedWeights* packed_weights = nullptr;
+  if (input_idx == 1) {
+    packed_weights = &packed_W_;
+    ORT_RETURN_IF_ERROR(TryPackWeights(tensor, packed_W_, is_packed, is_W_signed_, alloc));
+  } else if (input_idx == 2) {
+    packed_weights = &packed_R_;
+    ORT_RETURN_IF_ERROR(TryPackWeights(tensor, packed_R_, is_packed, is_R_signed_, alloc));
+  }
+
+  if (is_packed && prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(packed_weights->buffer_));
+    prepacked_weights->buffer_sizes_.push_back(packed_weights->weights_size_ * num_directions_);
+  }
+
+  return Status::OK();
+}
+
+Status DynamicQuantizeLSTM::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                      int input_idx,
+                                                      /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
   if (input_idx == 1) {
-    return TryPackWeights(tensor, packed_W_, is_packed, is_W_signed_);
+    used_shared_buffers = true;
+    packed_W_.buffer_ = std::move(prepacked_buffers[0]);
   } else if (input_idx == 2) {
-    return TryPackWeights(tensor, packed_R_, is_packed, is_R_signed_);
+    used_shared_buffers = true;
+    packed_R_.buffer_ = std::move(prepacked_buffers[0]);
   }
 
   return Status::OK();
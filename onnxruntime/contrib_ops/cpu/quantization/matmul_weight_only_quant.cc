@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class MatMulWeightOnlyQuant final : public OpKernel {
+ public:
+  MatMulWeightOnlyQuant(const OpKernelInfo& info) : OpKernel(info) {
+    ORT_ENFORCE(info.GetAttr<int64_t>("K", &K_).IsOK() && K_ > 0, "Attribute K must be positive");
+    ORT_ENFORCE(info.GetAttr<int64_t>("N", &N_).IsOK() && N_ > 0, "Attribute N must be positive");
+    bits_ = info.GetAttrOrDefault<int64_t>("bits", 4);
+    block_size_ = info.GetAttrOrDefault<int64_t>("block_size", 32);
+    ORT_ENFORCE(MlasIsBlockQuantGemmAvailable(static_cast<size_t>(bits_), static_cast<size_t>(block_size_)),
+                "Unsupported block quantization with bits=", bits_, " and block_size=", block_size_);
+  }
+
+  Status Compute(OpKernelContext* ctx) const override;
+
+ private:
+  int64_t K_;
+  int64_t N_;
+  int64_t bits_;
+  int64_t block_size_;
+};
+
+Status MatMulWeightOnlyQuant::Compute(OpKernelContext* ctx) const {
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = ctx->Input<Tensor>(1);
+  const Tensor* scales = ctx->Input<Tensor>(2);
+  const Tensor* zero_points = ctx->Input<Tensor>(3);
+  const Tensor* bias = ctx->Input<Tensor>(4);
+
+  const size_t K = static_cast<size_t>(K_);
+  const size_t N = static_cast<size_t>(N_);
+  const size_t bits = static_cast<size_t>(bits_);
+  const size_t block_size = static_cast<size_t>(block_size_);
+  const int64_t block_count = N_ * ((K_ + block_size_ - 1) / block_size_);
+
+  const auto& a_shape = a->Shape();
+  ORT_RETURN_IF_NOT(a_shape.NumDimensions() >= 1 && a_shape[a_shape.NumDimensions() - 1] == K_,
+                    "The last dimension of A must be K=", K_, ", got shape ", a_shape);
+  ORT_RETURN_IF_NOT(static_cast<size_t>(b->Shape().Size()) == MlasBlockQuantBSize(N, K, bits, block_size),
+                    "The quantized weights B have ", b->Shape().Size(), " bytes, expected ",
+                    MlasBlockQuantBSize(N, K, bits, block_size));
+  ORT_RETURN_IF_NOT(scales->Shape().Size() == block_count,
+                    "The scales must have ", block_count, " elements, got ", scales->Shape().Size());
+  ORT_RETURN_IF_NOT(zero_points == nullptr || zero_points->Shape().Size() == block_count,
+                    "The zero points must have ", block_count, " elements, got ", zero_points->Shape().Size());
+  ORT_RETURN_IF_NOT(bias == nullptr || bias->Shape().Size() == N_,
+                    "The bias must have ", N_, " elements, got ", bias->Shape().Size());
+
+  std::vector<int64_t> y_dims = a_shape.GetDims();
+  y_dims.back() = N_;
+  Tensor* y = ctx->Output(0, y_dims);
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  const size_t M = static_cast<size_t>(a_shape.SizeToDimension(a_shape.NumDimensions() - 1));
+
+  MlasBlockQuantGemm(M, N, K, bits, block_size,
+                     a->Data<float>(), K,
+                     b->Data<uint8_t>(),
+                     scales->Data<float>(),
+                     zero_points != nullptr ? zero_points->Data<uint8_t>() : nullptr,
+                     bias != nullptr ? bias->Data<float>() : nullptr,
+                     y->MutableData<float>(), N,
+                     ctx->GetOperatorThreadPool());
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    MatMulWeightOnlyQuant,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>()),
+    MatMulWeightOnlyQuant);
+
+}  // namespace contrib
+}  // namespace onnxruntime
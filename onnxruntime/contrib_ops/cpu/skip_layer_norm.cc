@@ -3,6 +3,7 @@
 
 #include "core/framework/tensor.h"
 #include "core/util/math_cpuonly.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/common.h"
 #include "core/platform/threadpool.h"
 #include "skip_layer_norm.h"
@@ -24,6 +25,49 @@ namespace contrib {
 REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(double)
 
+namespace {
+
+template <typename T>
+void ComputeSkipLayerNormRow(const T* p_input, const T* p_skip, const T* gamma_data, const T* beta_data,
+                             const T* bias_data, T* p_output, int64_t hidden_size, float epsilon) {
+  T mean = 0;
+  T mean_square = 0;
+
+  for (int64_t h = 0; h < hidden_size; h++) {
+    T value = p_input[h] + p_skip[h];
+    if (nullptr != bias_data) {
+      value += bias_data[h];
+    }
+    p_output[h] = value;
+    mean += value;
+    mean_square += value * value;
+  }
+
+  mean = mean / hidden_size;
+  mean_square = sqrt(mean_square / hidden_size - mean * mean + epsilon);
+
+  for (int64_t h = 0; h < hidden_size; h++) {
+    p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h] + beta_data[h];
+  }
+}
+
+// The float version sums the input, skip and bias while computing the statistics in
+// one vectorized pass and then normalizes the row in place in a second pass.
+void ComputeSkipLayerNormRow(const float* p_input, const float* p_skip, const float* gamma_data,
+                             const float* beta_data, const float* bias_data, float* p_output,
+                             int64_t hidden_size, float epsilon) {
+  float mean;
+  float mean_square;
+  MlasComputeMeanAndMeanSquare(p_input, p_skip, bias_data, p_output, static_cast<size_t>(hidden_size),
+                               &mean, &mean_square);
+
+  float inv_std_dev = 1.0f / std::sqrt(mean_square - mean * mean + epsilon);
+  MlasComputeNormalizeScaleShift(p_output, p_output, static_cast<size_t>(hidden_size), mean, inv_std_dev,
+                                 gamma_data, beta_data);
+}
+
+}  // namespace
+
 template <typename T>
 SkipLayerNorm<T>::SkipLayerNorm(const OpKernelInfo& op_kernel_info)
     : OpKernel(op_kernel_info) {
@@ -102,25 +146,8 @@ Status SkipLayerNorm<T>::Compute(OpKernelContext* p_ctx) const {
                                                  const T* p_skip = skip_data + task_idx * hidden_size;
                                                  T* p_output = output_data + task_idx * hidden_size;
 
-                                                 T mean = 0;
-                                                 T mean_square = 0;
-
-                                                 for (int64_t h = 0; h < hidden_size; h++) {
-                                                   T value = p_input[h] + p_skip[h];
-                                                   if (nullptr != bias_data) {
-                                                     value += bias_data[h];
-                                                   }
-                                                   p_output[h] = value;
-                                                   mean += value;
-                                                   mean_square += value * value;
-                                                 }
-
-                                                 mean = mean / hidden_size;
-                                                 mean_square = sqrt(mean_square / hidden_size - mean * mean + epsilon_);
-
-                                                 for (int64_t h = 0; h < hidden_size; h++) {
-                                                   p_output[h] = (p_output[h] - mean) / mean_square * gamma_data[h] + beta_data[h];
-                                                 }
+                                                 ComputeSkipLayerNormRow(p_input, p_skip, gamma_data, beta_data, bias_data,
+                                                                         p_output, hidden_size, epsilon_);
                                                }, 0);
 
   return Status::OK();
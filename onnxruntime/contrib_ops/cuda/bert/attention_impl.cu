@@ -54,8 +54,9 @@ size_t GetAttentionWorkspaceSize(
     int head_size,
     int sequence_length,
     int past_sequence_length) {
+  // The softmax runs in place on the attention scores, so a single BxNxSxS* scratch buffer is needed.
   size_t qkv_size = 3 * batch_size * sequence_length * num_heads * head_size * element_size;
-  return qkv_size + 2 * GetAttentionScratchSize(element_size, batch_size, num_heads, sequence_length, past_sequence_length + sequence_length);
+  return qkv_size + GetAttentionScratchSize(element_size, batch_size, num_heads, sequence_length, past_sequence_length + sequence_length);
 }
 
 template <typename T>
@@ -68,8 +69,7 @@ bool QkvToContext(
   const int all_sequence_length = past_sequence_length + sequence_length;
   const size_t bytes = GetAttentionScratchSize(element_size, batch_size, num_heads, sequence_length, all_sequence_length);
   T* scratch1 = workspace;
-  T* scratch2 = scratch1 + (bytes / element_size);
-  T* scratch3 = scratch2 + (bytes / element_size);
+  T* scratch3 = scratch1 + (bytes / element_size);
 
   // input should be BxSx3xNxH => scratch3: 3xBxNxSxH
   if (!LaunchTransQkv(stream, sequence_length, batch_size, head_size, num_heads, input, scratch3)) {
@@ -117,20 +117,22 @@ bool QkvToContext(
     return false;
   }
 
-  // apply softmax and store result P to scratch2: BxNxSxS*
+  // apply softmax in place and store result P to scratch1: BxNxSxS*
+  // Every softmax kernel reads an element of a row before the reductions, and only the thread that read it writes
+  // the result back, so the input and output can alias.
   if (use_raw_attention_mask) {  // 2d or 3d attention mask
-    if (!ComputeSoftmaxWithRawMask<T>(stream, all_sequence_length, sequence_length, batch_size, num_heads, mask_index, scratch1, scratch2, is_unidirectional, rsqrt_head_size, static_cast<int>(mask_index_dims->size()))) {
+    if (!ComputeSoftmaxWithRawMask<T>(stream, all_sequence_length, sequence_length, batch_size, num_heads, mask_index, scratch1, scratch1, is_unidirectional, rsqrt_head_size, static_cast<int>(mask_index_dims->size()))) {
       return false;
     }
   } else if (nullptr != mask_index) {  // 1d mask index
     ORT_ENFORCE(nullptr != mask_index_dims && mask_index_dims->size() == 1);
     // mask_index has 1D shape: either (batch_size) or (2*batch_size). Only the later one has start postions.
     const int* mask_start = (mask_index_dims->at(0) > batch_size) ? mask_index + batch_size : nullptr;
-    if (!ComputeSoftmaxWithMask1D<T>(stream, all_sequence_length, sequence_length, batch_size, num_heads, mask_index, mask_start, scratch1, scratch2, is_unidirectional)) {
+    if (!ComputeSoftmaxWithMask1D<T>(stream, all_sequence_length, sequence_length, batch_size, num_heads, mask_index, mask_start, scratch1, scratch1, is_unidirectional)) {
       return false;
     }
   } else {  // no mask
-    if (!ComputeSoftmax<T>(stream, all_sequence_length, sequence_length, batch_size, num_heads, scratch1, scratch2, is_unidirectional)) {
+    if (!ComputeSoftmax<T>(stream, all_sequence_length, sequence_length, batch_size, num_heads, scratch1, scratch1, is_unidirectional)) {
       return false;
     }
   }
@@ -138,7 +140,7 @@ bool QkvToContext(
   // compute P*V (as V*P), and store in scratch3: BxNxSxH
   if (!CUBLAS_CALL(CublasGemmStridedBatched(
           cublas, CUBLAS_OP_N, CUBLAS_OP_N, head_size, sequence_length, all_sequence_length, 1.f, v, head_size, present_size_per_batch,
-          scratch2, all_sequence_length, temp_matrix_size, 0.f, scratch3, head_size, size_per_batch, batches))) {
+          scratch1, all_sequence_length, temp_matrix_size, 0.f, scratch3, head_size, size_per_batch, batches))) {
     return false;
   }
 
@@ -0,0 +1,103 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/math/gemm.h"
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/activation/activations_impl.h"
+#include "contrib_ops/cuda/activation/activations_impl.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Gemm followed by an activation. The activation runs in place on the Gemm output, so the intermediate tensor
+// between the two nodes is not allocated.
+template <typename T>
+class FusedGemm final : public onnxruntime::cuda::Gemm<T> {
+ public:
+  using Base = onnxruntime::cuda::Gemm<T>;
+  FusedGemm(const OpKernelInfo& info) : onnxruntime::cuda::Gemm<T>(info) {
+    activation_ = info.GetAttrOrDefault<std::string>("activation", "");
+    ORT_ENFORCE(activation_ == "Relu" || activation_ == "Sigmoid" || activation_ == "Tanh" ||
+                    activation_ == "Softplus" || activation_ == "Softsign" || activation_ == "Elu" ||
+                    activation_ == "LeakyRelu" || activation_ == "ThresholdedRelu" || activation_ == "HardSigmoid" ||
+                    activation_ == "Selu" || activation_ == "ScaledTanh" || activation_ == "ParametricSoftplus",
+                "Unsupported activation ", activation_, " for FusedGemm");
+
+    // The attributes of the activation are prefixed with activation_ by GemmActivationFusion.
+    activation_alpha_ = info.GetAttrOrDefault<float>("activation_alpha", 0.0f);
+    activation_beta_ = info.GetAttrOrDefault<float>("activation_beta", 0.0f);
+    activation_gamma_ = info.GetAttrOrDefault<float>("activation_gamma", 0.0f);
+  }
+
+  Status ComputeInternal(OpKernelContext* context) const override {
+    typedef typename ToCudaType<T>::MappedType CudaT;
+
+    ORT_RETURN_IF_ERROR(Base::ComputeInternal(context));
+
+    Tensor* Y = context->Output<Tensor>(0);
+    const size_t count = static_cast<size_t>(Y->Shape().Size());
+    if (count == 0) {
+      return Status::OK();
+    }
+
+    CudaT* y_data = reinterpret_cast<CudaT*>(Y->template MutableData<T>());
+    onnxruntime::cuda::CtxAlpha ctx_alpha{activation_alpha_};
+    onnxruntime::cuda::CtxAlphaBeta ctx_alpha_beta{activation_alpha_, activation_beta_};
+    onnxruntime::cuda::CtxAlphaGamma ctx_alpha_gamma{activation_alpha_, activation_gamma_};
+    onnxruntime::cuda::CtxNull ctx_null;
+
+    if (activation_ == "Relu") {
+      onnxruntime::cuda::Impl_Relu<CudaT>(y_data, y_data, &ctx_null, count);
+    } else if (activation_ == "Sigmoid") {
+      onnxruntime::cuda::Impl_Sigmoid<CudaT>(y_data, y_data, &ctx_null, count);
+    } else if (activation_ == "Tanh") {
+      onnxruntime::cuda::Impl_Tanh<CudaT>(y_data, y_data, &ctx_null, count);
+    } else if (activation_ == "Softplus") {
+      onnxruntime::cuda::Impl_Softplus<CudaT>(y_data, y_data, &ctx_null, count);
+    } else if (activation_ == "Softsign") {
+      onnxruntime::cuda::Impl_Softsign<CudaT>(y_data, y_data, &ctx_null, count);
+    } else if (activation_ == "Elu") {
+      onnxruntime::cuda::Impl_Elu<CudaT>(y_data, y_data, &ctx_alpha, count);
+    } else if (activation_ == "LeakyRelu") {
+      onnxruntime::cuda::Impl_LeakyRelu<CudaT>(y_data, y_data, &ctx_alpha, count);
+    } else if (activation_ == "ThresholdedRelu") {
+      onnxruntime::cuda::Impl_ThresholdedRelu<CudaT>(y_data, y_data, &ctx_alpha, count);
+    } else if (activation_ == "HardSigmoid") {
+      onnxruntime::cuda::Impl_HardSigmoid<CudaT>(y_data, y_data, &ctx_alpha_beta, count);
+    } else if (activation_ == "Selu") {
+      onnxruntime::cuda::Impl_Selu<CudaT>(y_data, y_data, &ctx_alpha_gamma, count);
+    } else if (activation_ == "ScaledTanh") {
+      Impl_ScaledTanh<CudaT>(y_data, y_data, &ctx_alpha_beta, count);
+    } else {
+      Impl_ParametricSoftplus<CudaT>(y_data, y_data, &ctx_alpha_beta, count);
+    }
+
+    return Status::OK();
+  }
+
+ private:
+  std::string activation_;
+  float activation_alpha_;
+  float activation_beta_;
+  float activation_gamma_;
+};
+
+#define REGISTER_KERNEL_TYPED(T)                                  \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                  \
+      FusedGemm,                                                  \
+      kMSDomain,                                                  \
+      1,                                                          \
+      T,                                                          \
+      kCudaExecutionProvider,                                     \
+      KernelDefBuilder()                                          \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      FusedGemm<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(double)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,128 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "fused_elementwise.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCudaExecutionProvider,
+    KernelDefBuilder()
+        .MayInplace(0, 0)
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : CudaKernel(info), params_{} {
+  static const std::unordered_map<std::string, FusedElementwiseOp> ops_by_name = {
+      {"Relu", FusedElementwiseOp::Relu},
+      {"Sigmoid", FusedElementwiseOp::Sigmoid},
+      {"Tanh", FusedElementwiseOp::Tanh},
+      {"Neg", FusedElementwiseOp::Neg},
+      {"Abs", FusedElementwiseOp::Abs},
+      {"Exp", FusedElementwiseOp::Exp},
+      {"Log", FusedElementwiseOp::Log},
+      {"Sqrt", FusedElementwiseOp::Sqrt},
+      {"Reciprocal", FusedElementwiseOp::Reciprocal},
+      {"Erf", FusedElementwiseOp::Erf},
+      {"Add", FusedElementwiseOp::Add},
+      {"Sub", FusedElementwiseOp::Sub},
+      {"Mul", FusedElementwiseOp::Mul},
+      {"Div", FusedElementwiseOp::Div},
+  };
+
+  std::vector<std::string> ops;
+  ORT_ENFORCE(info.GetAttrs<std::string>("ops", ops).IsOK() && !ops.empty(),
+              "FusedElementwise: the 'ops' attribute must list at least one operation.");
+  ORT_ENFORCE(ops.size() <= static_cast<size_t>(kFusedElementwiseMaxSteps),
+              "FusedElementwise: at most ", kFusedElementwiseMaxSteps, " operations are supported on CUDA.");
+
+  std::vector<int64_t> operands = info.GetAttrsOrDefault<int64_t>("operands");
+  std::vector<float> scalars = info.GetAttrsOrDefault<float>("scalars");
+  std::vector<int64_t> operand_first = info.GetAttrsOrDefault<int64_t>("operand_first");
+  ORT_ENFORCE(operands.empty() || operands.size() == ops.size(),
+              "FusedElementwise: 'operands' must have one value per operation.");
+  ORT_ENFORCE(scalars.empty() || scalars.size() == ops.size(),
+              "FusedElementwise: 'scalars' must have one value per operation.");
+  ORT_ENFORCE(operand_first.empty() || operand_first.size() == ops.size(),
+              "FusedElementwise: 'operand_first' must have one value per operation.");
+
+  const int input_count = static_cast<int>(info.GetInputCount());
+  ORT_ENFORCE(input_count <= kFusedElementwiseMaxInputs,
+              "FusedElementwise: at most ", kFusedElementwiseMaxInputs, " inputs are supported on CUDA.");
+  params_.input_count = input_count;
+  params_.step_count = static_cast<int>(ops.size());
+
+  for (size_t i = 0; i < ops.size(); ++i) {
+    auto op = ops_by_name.find(ops[i]);
+    if (op == ops_by_name.end()) {
+      ORT_THROW("FusedElementwise: unsupported operation '", ops[i], "'.");
+    }
+
+    FusedElementwiseStep& step = params_.steps[i];
+    step = {op->second, -1, 0.0f, false, false};
+
+    if (op->second >= FusedElementwiseOp::Add) {
+      step.operand = operands.empty() ? -1 : static_cast<int>(operands[i]);
+      if (step.operand < 0) {
+        ORT_ENFORCE(!scalars.empty(), "FusedElementwise: the binary operation '", ops[i], "' requires 'scalars'.");
+        step.scalar = scalars[i];
+      } else {
+        // a step can only use the inputs and the results of the steps before it
+        ORT_ENFORCE(static_cast<size_t>(step.operand) < static_cast<size_t>(input_count) + i,
+                    "FusedElementwise: operation ", i, " uses the undefined value ", step.operand, ".");
+        if (step.operand >= input_count) {
+          params_.steps[step.operand - input_count].result_is_operand = true;
+        }
+      }
+      step.operand_first = !operand_first.empty() && operand_first[i] != 0;
+    }
+  }
+}
+
+Status FusedElementwise::ComputeInternal(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const auto& x_shape = X->Shape();
+  auto* Y = context->Output(0, x_shape);
+
+  FusedElementwiseParams params = params_;
+  params.inputs[0] = X->Data<float>();
+  params.input_sizes[0] = static_cast<CUDA_LONG>(x_shape.Size());
+
+  // The other inputs are broadcast to the shape of X, so without the leading ones their shape is a suffix of
+  // the shape of X.
+  for (int i = 1; i < params.input_count; ++i) {
+    const auto* input = context->Input<Tensor>(i);
+    const auto& input_shape = input->Shape();
+
+    size_t leading_ones = 0;
+    while (leading_ones < input_shape.NumDimensions() && input_shape[leading_ones] == 1) {
+      ++leading_ones;
+    }
+
+    const size_t rank = input_shape.NumDimensions() - leading_ones;
+    bool is_suffix = rank <= x_shape.NumDimensions();
+    for (size_t d = 0; is_suffix && d < rank; ++d) {
+      is_suffix = input_shape[leading_ones + d] == x_shape[x_shape.NumDimensions() - rank + d];
+    }
+
+    if (!is_suffix) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedElementwise: input ", i, " with shape ",
+                             input_shape, " can't be broadcast to the shape of the first input ", x_shape, ".");
+    }
+
+    params.inputs[i] = input->Data<float>();
+    params.input_sizes[i] = static_cast<CUDA_LONG>(input_shape.Size());
+  }
+
+  FusedElementwiseImpl(params, Y->MutableData<float>(), static_cast<size_t>(x_shape.Size()));
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/providers/cuda/cuda_kernel.h"
+#include "fused_elementwise_impl.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+using namespace ::onnxruntime::cuda;
+
+// Applies a chain of elementwise operations to a float tensor in a single kernel, see the CPU FusedElementwise.
+class FusedElementwise final : public CudaKernel {
+ public:
+  explicit FusedElementwise(const OpKernelInfo& info);
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  // the steps of the chain, the inputs are set for each run
+  FusedElementwiseParams params_;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
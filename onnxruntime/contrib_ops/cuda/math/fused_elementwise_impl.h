@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// The parameters of the kernel are passed by value, which bounds the length of the chain.
+constexpr int kFusedElementwiseMaxSteps = 16;
+constexpr int kFusedElementwiseMaxInputs = kFusedElementwiseMaxSteps + 1;
+
+enum class FusedElementwiseOp : int {
+  Relu,
+  Sigmoid,
+  Tanh,
+  Neg,
+  Abs,
+  Exp,
+  Log,
+  Sqrt,
+  Reciprocal,
+  Erf,
+  Add,
+  Sub,
+  Mul,
+  Div,
+};
+
+struct FusedElementwiseStep {
+  FusedElementwiseOp op;
+  // the other operand of a binary operation is the value at this index or the scalar if negative
+  int operand;
+  float scalar;
+  bool operand_first;
+  // whether the result is the operand of a later step
+  bool result_is_operand;
+};
+
+struct FusedElementwiseParams {
+  int step_count;
+  FusedElementwiseStep steps[kFusedElementwiseMaxSteps];
+  int input_count;
+  const float* inputs[kFusedElementwiseMaxInputs];
+  // the element at an offset into the first input is the element at that offset modulo the size of the input
+  CUDA_LONG input_sizes[kFusedElementwiseMaxInputs];
+};
+
+void FusedElementwiseImpl(const FusedElementwiseParams& params, float* output_data, size_t count);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -50,6 +50,7 @@ CPUIDInfo::CPUIDInfo() noexcept {
   int num_IDs = data[0];
   if (num_IDs >= 1) {
     GetCPUID(1, data);
+    has_sse4_2_ = (data[2] & (1 << 20)) != 0;
     if (data[2] & (1 << 27)) {
       const int AVX_MASK = 0x6;
       const int AVX512_MASK = 0xE6;
@@ -70,6 +71,10 @@ CPUIDInfo::CPUIDInfo() noexcept {
         has_avx512_skylake_ = has_avx512 && (data[1] & ((1 << 16) | (1 << 17) | (1 << 28) | (1 << 30) | (1 << 31)));
       }
     }
+    if (num_IDs >= 7) {
+      GetCPUID(7, data);
+      is_hybrid_ = (data[3] & (1 << 15)) != 0;
+    }
   }
 #endif
 }
@@ -18,6 +18,9 @@ class CPUIDInfo {
   bool HasAVX512Skylake() const { return has_avx512_skylake_; }
   bool HasF16C() const { return has_f16c_; }
   bool HasSSE3() const { return has_sse3_; }
+  bool HasSSE4_2() const { return has_sse4_2_; }
+  // The processor has cores of different types, e.g. performance and efficiency cores.
+  bool IsHybrid() const { return is_hybrid_; }
 
  private:
   CPUIDInfo() noexcept;
@@ -27,6 +30,8 @@ class CPUIDInfo {
   bool has_avx512_skylake_{false};
   bool has_f16c_{false};
   bool has_sse3_{false};
+  bool has_sse4_2_{false};
+  bool is_hybrid_{false};
 };
 
 }  // namespace onnxruntime
@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/latency_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace onnxruntime {
+namespace profiling {
+
+constexpr int LatencyHistogram::kSubBucketBits;
+constexpr int LatencyHistogram::kSubBuckets;
+constexpr int LatencyHistogram::kNumBuckets;
+
+static int FloorLog2(uint64_t value) {
+  int result = 0;
+  for (int shift = 32; shift > 0; shift /= 2) {
+    if (value >> shift) {
+      value >>= shift;
+      result += shift;
+    }
+  }
+  return result;
+}
+
+LatencyHistogram::LatencyHistogram() noexcept {
+  for (auto& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+// values below 2 * kSubBuckets have a bucket each. above that each power of two is split into kSubBuckets buckets
+// using the bits that follow the most significant one.
+int LatencyHistogram::BucketIndex(uint64_t value) {
+  if (value < 2 * kSubBuckets) {
+    return static_cast<int>(value);
+  }
+
+  const int log2 = FloorLog2(value);
+  const int sub_bucket = static_cast<int>(value >> (log2 - kSubBucketBits)) & (kSubBuckets - 1);
+  return (log2 - kSubBucketBits + 1) * kSubBuckets + sub_bucket;
+}
+
+uint64_t LatencyHistogram::BucketLowerBound(int index) {
+  if (index < 2 * kSubBuckets) {
+    return static_cast<uint64_t>(index);
+  }
+
+  const int log2 = index / kSubBuckets + kSubBucketBits - 1;
+  const uint64_t sub_bucket = static_cast<uint64_t>(index % kSubBuckets);
+  return (kSubBuckets + sub_bucket) << (log2 - kSubBucketBits);
+}
+
+uint64_t LatencyHistogram::Percentile(double fraction) const {
+  uint64_t counts[kNumBuckets];
+  uint64_t total = 0;
+  for (int i = 0; i < kNumBuckets; ++i) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+
+  if (total == 0) {
+    return 0;
+  }
+
+  fraction = std::min(std::max(fraction, 0.0), 1.0);
+  const uint64_t rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(fraction * total)), 1);
+
+  uint64_t seen = 0;
+  for (int i = 0; i < kNumBuckets; ++i) {
+    seen += counts[i];
+    if (seen >= rank) {
+      // report the middle of the bucket
+      const uint64_t lower = BucketLowerBound(i);
+      const uint64_t upper = i + 1 < kNumBuckets ? BucketLowerBound(i + 1) - 1 : UINT64_MAX;
+      return lower + (upper - lower) / 2;
+    }
+  }
+
+  return BucketLowerBound(kNumBuckets - 1);
+}
+
+void LatencyHistogram::Reset() {
+  for (auto& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  sum_ns_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace profiling {
+
+/**
+ * A histogram of latencies in nanoseconds that can be recorded into from any number of threads without locking.
+ * The buckets are spaced logarithmically with kSubBuckets buckets per power of two, so a percentile is
+ * reported with a relative error of at most 1 / kSubBuckets.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBucketBits = 2;
+  static constexpr int kSubBuckets = 1 << kSubBucketBits;
+  static constexpr int kNumBuckets = (64 - kSubBucketBits + 1) * kSubBuckets;
+
+  LatencyHistogram() noexcept;
+
+  void Record(uint64_t duration_ns) {
+    buckets_[BucketIndex(duration_ns)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_ns_.fetch_add(duration_ns, std::memory_order_relaxed);
+  }
+
+  uint64_t Count() const { return count_.load(std::memory_order_relaxed); }
+
+  uint64_t SumNs() const { return sum_ns_.load(std::memory_order_relaxed); }
+
+  /**
+   * Returns the latency in nanoseconds below which the given fraction (0 to 1) of the recorded latencies fall,
+   * or 0 if nothing was recorded. Recording concurrently with this call may or may not be taken into account.
+   */
+  uint64_t Percentile(double fraction) const;
+
+  void Reset();
+
+  static int BucketIndex(uint64_t value);
+
+  /** The smallest value that falls into the bucket. */
+  static uint64_t BucketLowerBound(int index);
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(LatencyHistogram);
+
+  std::atomic<uint64_t> buckets_[kNumBuckets];
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_ns_{0};
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
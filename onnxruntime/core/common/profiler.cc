@@ -68,13 +68,33 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
 
   EventRecord event(category, logging::GetProcessId(),
                     logging::GetThreadId(), event_name, ts, dur, {event_args.begin(), event_args.end()});
+  AddEvent(std::move(event));
+}
+
+void Profiler::RecordCounterEvent(EventCategory category,
+                                  const std::string& counter_name,
+                                  const std::vector<std::pair<std::string, int64_t>>& values) {
+  long long ts = TimeDiffMicroSeconds(profiling_start_time_);
+
+  std::unordered_map<std::string, std::string> event_args;
+  for (const auto& value : values) {
+    event_args.emplace(value.first, std::to_string(value.second));
+  }
+
+  EventRecord event(category, logging::GetProcessId(), logging::GetThreadId(), counter_name, ts, 0,
+                    std::move(event_args));
+  event.phase = 'C';
+  AddEvent(std::move(event));
+}
+
+void Profiler::AddEvent(EventRecord&& event) {
   if (profile_with_logger_) {
     custom_logger_->SendProfileEvent(event);
   } else {
     //TODO: sync_gpu if needed.
     std::lock_guard<OrtMutex> lock(mutex_);
     if (events_.size() < max_num_events_) {
-      events_.emplace_back(event);
+      events_.emplace_back(std::move(event));
     } else {
       if (session_logger_ && !max_events_reached) {
         LOGS(*session_logger_, ERROR)
@@ -108,13 +128,15 @@ std::string Profiler::EndProfiling() {
     profile_stream_ << "\"tid\" :" << rec.tid << ",";
     profile_stream_ << "\"dur\" :" << rec.dur << ",";
     profile_stream_ << "\"ts\" :" << rec.ts << ",";
-    profile_stream_ << R"("ph" : "X",)";
+    profile_stream_ << R"("ph" : ")" << rec.phase << "\",";
     profile_stream_ << R"("name" :")" << rec.name << "\",";
     profile_stream_ << "\"args\" : {";
+    // the values of a counter event must be numbers
+    const char* quote = rec.phase == 'C' ? "" : "\"";
     bool is_first_arg = true;
     for (std::pair<std::string, std::string> event_arg : rec.args) {
       if (!is_first_arg) profile_stream_ << ",";
-      profile_stream_ << "\"" << event_arg.first << "\" : \"" << event_arg.second << "\"";
+      profile_stream_ << "\"" << event_arg.first << "\" : " << quote << event_arg.second << quote;
       is_first_arg = false;
     }
     profile_stream_ << "}";
@@ -8,6 +8,7 @@
 #include <initializer_list>
 #include <iostream>
 #include <tuple>
+#include <vector>
 
 #include "core/common/logging/logging.h"
 #include "core/platform/ort_mutex.h"
@@ -78,6 +79,14 @@ class Profiler {
                              const std::initializer_list<std::pair<std::string, std::string>>& event_args = {},
                              bool sync_gpu = false);
 
+  /*
+  Record a counter event at the current time. The trace viewer plots each of the values over time in a track named
+  after the counter.
+  */
+  void RecordCounterEvent(EventCategory category,
+                          const std::string& counter_name,
+                          const std::vector<std::pair<std::string, int64_t>>& values);
+
   /*
   Write profile data to the given stream in chrome format defined below.
   https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/preview#
@@ -111,6 +120,8 @@ class Profiler {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Profiler);
 
+  void AddEvent(EventRecord&& event);
+
   /**
    * The maximum number of profiler records to collect.
    * This value is used to initialize the per-profiler maximum.
@@ -13,12 +13,20 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
+#include <bitset>
+#include <chrono>
+#include <limits>
+#include <map>
 #include <memory>
 
 #include "core/platform/threadpool.h"
 #include "core/common/common.h"
+#include "core/common/cpuid_info.h"
 #include "core/common/eigen_common_wrapper.h"
+#include "core/common/trace_sink.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
+#include "core/platform/hardware_counters.h"
 #include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
@@ -151,12 +159,87 @@ private:
 #pragma warning(pop) /* Padding added in LoopCounterShard, LoopCounter */
 #endif
 
+// The times of a thread that took part in a parallel loop, relative to the start of the loop in the calling thread.
+struct ParallelForWorkerTimes {
+  bool ran = false;
+  uint64_t start_ns = 0;
+  uint64_t end_ns = 0;
+  uint64_t shards = 0;
+  uint64_t shard_steals = 0;
+};
+
+class ThreadPoolStats {
+ public:
+  void Record(const char* call_site, uint64_t wall_ns, const std::vector<ParallelForWorkerTimes>& workers) {
+    ParallelForStats loop;
+    loop.calls = 1;
+    loop.wall_ns = wall_ns;
+    uint64_t max_busy_ns = 0;
+    uint64_t first_end_ns = std::numeric_limits<uint64_t>::max();
+    uint64_t last_end_ns = 0;
+    for (size_t idx = 0; idx < workers.size(); idx++) {
+      const auto& worker = workers[idx];
+      if (!worker.ran) {
+        continue;
+      }
+      const uint64_t busy_ns = worker.end_ns - worker.start_ns;
+      loop.workers++;
+      loop.shards += worker.shards;
+      loop.shard_steals += worker.shard_steals;
+      loop.busy_ns += busy_ns;
+      max_busy_ns = std::max(max_busy_ns, busy_ns);
+      first_end_ns = std::min(first_end_ns, worker.end_ns);
+      last_end_ns = std::max(last_end_ns, worker.end_ns);
+      // the worker with index 0 is the calling thread
+      if (idx != 0) {
+        loop.wakeup_ns += worker.start_ns;
+        loop.max_wakeup_ns = std::max(loop.max_wakeup_ns, worker.start_ns);
+      }
+    }
+    if (loop.workers == 0) {
+      return;
+    }
+    loop.tail_ns = last_end_ns - first_end_ns;
+    loop.max_tail_ns = loop.tail_ns;
+    loop.imbalance = loop.busy_ns == 0 ? 1.0 : static_cast<double>(max_busy_ns) * loop.workers / loop.busy_ns;
+
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto& stats = call_sites_[call_site != nullptr ? call_site : ""];
+    stats.calls += loop.calls;
+    stats.shards += loop.shards;
+    stats.workers += loop.workers;
+    stats.shard_steals += loop.shard_steals;
+    stats.wall_ns += loop.wall_ns;
+    stats.busy_ns += loop.busy_ns;
+    stats.tail_ns += loop.tail_ns;
+    stats.max_tail_ns = std::max(stats.max_tail_ns, loop.max_tail_ns);
+    stats.wakeup_ns += loop.wakeup_ns;
+    stats.max_wakeup_ns = std::max(stats.max_wakeup_ns, loop.max_wakeup_ns);
+    stats.imbalance += loop.imbalance;
+  }
+
+  std::vector<std::pair<std::string, ParallelForStats>> Get(bool reset) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    std::vector<std::pair<std::string, ParallelForStats>> result(call_sites_.begin(), call_sites_.end());
+    if (reset) {
+      call_sites_.clear();
+    }
+    return result;
+  }
+
+ private:
+  OrtMutex mutex_;
+  std::map<std::string, ParallelForStats> call_sites_;
+};
+
+thread_local const char* ThreadPool::CallSiteScope::current_call_site{nullptr};
+
 ThreadPool::ThreadPool(Env* env,
                        const ThreadOptions& thread_options,
                        const NAME_CHAR_TYPE* name,
                        int degree_of_parallelism,
                        bool low_latency_hint)
-    : thread_options_(thread_options) {
+    : thread_options_(thread_options), stats_(onnxruntime::make_unique<ThreadPoolStats>()) {
   // In the current implementation, a thread pool with degree_of_parallelism==1 uses
   // the caller as one of the threads for executing work.  Hence we only create
   // additional thread(s) for degree_of_parallelism>=2.
@@ -175,6 +258,26 @@ ThreadPool::ThreadPool(Env* env,
 
 ThreadPool::~ThreadPool() = default;
 
+void ThreadPool::GetSpinCounters(uint64_t& hits, uint64_t& misses) const {
+  hits = 0;
+  misses = 0;
+  if (extended_eigen_threadpool_) {
+    extended_eigen_threadpool_->GetSpinCounters(hits, misses);
+  }
+}
+
+uint64_t ThreadPool::GetStealCount() const {
+  return extended_eigen_threadpool_ ? extended_eigen_threadpool_->GetStealCount() : 0;
+}
+
+void ThreadPool::EnableStats(bool enable) {
+  stats_enabled_.store(enable, std::memory_order_relaxed);
+}
+
+std::vector<std::pair<std::string, ParallelForStats>> ThreadPool::GetParallelForStats(bool reset) {
+  return stats_->Get(reset);
+}
+
 // Base case for parallel loops, running iterations 0..total, divided into blocks
 // of block_size iterations, and calling into a function that takes a start..end
 // range of indices to run.
@@ -196,14 +299,37 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
   int num_work_items = static_cast<int>(std::min(static_cast<std::ptrdiff_t>(d_of_p), num_blocks));
   assert(num_work_items > 0);
 
+  // With the stats enabled, each thread records its times into its own entry, which are read once RunInParallel
+  // has synchronized with the threads.
+  const bool collect_stats = StatsEnabled();
+  std::vector<ParallelForWorkerTimes> worker_times;
+  std::chrono::steady_clock::time_point loop_start;
+  if (collect_stats) {
+    worker_times.resize(num_work_items);
+    loop_start = std::chrono::steady_clock::now();
+  }
+  auto ns_since_loop_start = [&loop_start]() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - loop_start)
+                                     .count());
+  };
+
   LoopCounter lc(total, d_of_p, block_size);
   std::function<void(unsigned)> run_work = [&](unsigned idx) {
+    const uint64_t start_ns = collect_stats ? ns_since_loop_start() : 0;
+    uint64_t shards = 0;
+    uint64_t shard_steals = 0;
     unsigned my_home_shard = lc.GetHomeShard(idx);
     unsigned my_shard = my_home_shard;
     uint64_t my_iter_start, my_iter_end;
     while (lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end)) {
       fn(static_cast<std::ptrdiff_t>(my_iter_start),
          static_cast<std::ptrdiff_t>(my_iter_end));
+      shards++;
+      shard_steals += my_shard != my_home_shard;
+    }
+    if (collect_stats && idx < worker_times.size()) {
+      worker_times[idx] = {true, start_ns, ns_since_loop_start(), shards, shard_steals};
     }
   };
 
@@ -211,6 +337,10 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
   // threads is handled within RunInParallel, hence we can deallocate lc and other state captured by
   // run_work.
   RunInParallel(run_work, num_work_items);
+
+  if (collect_stats) {
+    stats_->Record(CallSiteScope::current_call_site, ns_since_loop_start(), worker_times);
+  }
 }
 
 void ThreadPool::SimpleParallelFor(std::ptrdiff_t total, const std::function<void(std::ptrdiff_t)>& fn) {
@@ -243,6 +373,9 @@ ThreadPool::ParallelSection::ParallelSection(ThreadPool *tp) {
     ps_ = tp->underlying_threadpool_->AllocateParallelSection();
     tp_->underlying_threadpool_->StartParallelSection(*ps_.get());
     current_parallel_section = this;
+    if (auto* sink = tracing::GetTraceSink()) {
+      sink->Begin(tracing::Category::kParallelSection, "parallel_section", nullptr);
+    }
   }
 #endif
 }
@@ -252,6 +385,9 @@ ThreadPool::ParallelSection::~ParallelSection() {
   // Nothing
 #else
   if (current_parallel_section) {
+    if (auto* sink = tracing::GetTraceSink()) {
+      sink->End(tracing::Category::kParallelSection, "parallel_section");
+    }
     tp_->underlying_threadpool_->EndParallelSection(*ps_.get());
     ps_.reset();
     current_parallel_section = nullptr;
@@ -259,8 +395,77 @@ ThreadPool::ParallelSection::~ParallelSection() {
 #endif
 }
 
+thread_local ThreadPool::RunScope* ThreadPool::RunScope::current_run_scope{nullptr};
+
+ThreadPool::RunScope::RunScope(ThreadPool* tp, int max_dop, bool partition)
+    : tp_(tp), max_dop_(max_dop), prev_run_scope_(current_run_scope) {
+#ifdef _OPENMP
+  ORT_UNUSED_PARAMETER(partition);
+#else
+  if (tp && partition) {
+    // Take the lowest free slot, if any.
+    uint64_t saw = tp->partition_slots_.load();
+    while (~saw != 0) {
+      int slot = 0;
+      while (saw & (1ull << slot)) {
+        slot++;
+      }
+      if (tp->partition_slots_.compare_exchange_weak(saw, saw | (1ull << slot))) {
+        slot_ = slot;
+        break;
+      }
+    }
+  }
+  current_run_scope = this;
+#endif
+}
+
+ThreadPool::RunScope::~RunScope() {
+#ifndef _OPENMP
+  if (slot_ >= 0) {
+    tp_->partition_slots_.fetch_and(~(1ull << slot_));
+  }
+  current_run_scope = prev_run_scope_;
+#endif
+}
+
+bool ThreadPool::GetCallerWorkerRange(unsigned& begin, unsigned& end) const {
+  const RunScope* scope = RunScope::current_run_scope;
+  if (!scope || scope->tp_ != this || scope->slot_ < 0) {
+    return false;
+  }
+  const unsigned num_threads = static_cast<unsigned>(NumThreads());
+  const uint64_t slots = partition_slots_.load(std::memory_order_relaxed);
+  const unsigned num_partitions = static_cast<unsigned>(std::bitset<64>(slots).count());
+  if (num_threads == 0 || num_partitions <= 1) {
+    return false;
+  }
+  // Split the workers evenly between the partitions in slot order.  With more
+  // partitions than workers, each partition gets one worker, shared with others.
+  const unsigned rank = static_cast<unsigned>(std::bitset<64>(slots & ((1ull << scope->slot_) - 1)).count());
+  begin = rank * num_threads / num_partitions;
+  end = (rank + 1) * num_threads / num_partitions;
+  if (begin == end) {
+    begin = rank % num_threads;
+    end = begin + 1;
+  }
+  return true;
+}
+
 void ThreadPool::RunInParallel(std::function<void(unsigned idx)> fn, unsigned n) {
   if (underlying_threadpool_) {
+    tracing::TraceRange trace_range(tracing::Category::kParallelFor, "parallel_for");
+    if (HardwareCountersEnabled()) {
+      // count the work of the threads that run the loop, so it is attributed to the kernel that started it
+      fn = [inner_fn = std::move(fn)](unsigned idx) {
+        RegisterThreadForHardwareCounters();
+        inner_fn(idx);
+      };
+    }
+    unsigned worker_begin = 0;
+    unsigned worker_end = 0;
+    GetCallerWorkerRange(worker_begin, worker_end);
+    extended_eigen_threadpool_->SetCallerWorkerRange(worker_begin, worker_end);
     if (ThreadPool::ParallelSection::current_parallel_section) {
       underlying_threadpool_->RunInParallelSection(*(ThreadPool::ParallelSection::current_parallel_section->ps_.get()),
                                                    std::move(fn),
@@ -300,14 +505,24 @@ using CostModel = Eigen::TensorCostModel<Eigen::ThreadPoolDevice>;
 // overheads; not too large to mitigate tail effect and potential load
 // imbalance and we also want number of blocks to be evenly dividable across
 // threads.
+// On processors with cores of different speeds, an even split of the work leaves the fast cores
+// waiting for the slow ones at the end of each loop.  We then create more, smaller blocks, and rely
+// on the threads claiming blocks dynamically from the loop counter so the fast cores run more of them.
+static bool UseFineGrainedBlocks() {
+  static const bool hybrid = CPUIDInfo::GetCPUIDInfo().IsHybrid();
+  return hybrid;
+}
+
 static ptrdiff_t CalculateParallelForBlock(const ptrdiff_t n, const Eigen::TensorOpCost& cost,
                                            std::function<ptrdiff_t(ptrdiff_t)> block_align, int num_threads) {
   const double block_size_f = 1.0 / CostModel::taskSize(1, cost);
-  const ptrdiff_t max_oversharding_factor = 4;
+  const bool fine_grained = UseFineGrainedBlocks();
+  const ptrdiff_t max_oversharding_factor = fine_grained ? 16 : 4;
   ptrdiff_t block_size = Eigen::numext::mini(
       n,
       Eigen::numext::maxi<ptrdiff_t>(Eigen::divup<ptrdiff_t>(n, max_oversharding_factor * num_threads), static_cast<ptrdiff_t>(block_size_f)));
-  const ptrdiff_t max_block_size = Eigen::numext::mini(n, 2 * block_size);
+  // Coarsening the blocks to a multiple of the thread count assumes threads of equal speed.
+  const ptrdiff_t max_block_size = fine_grained ? block_size : Eigen::numext::mini(n, 2 * block_size);
 
   if (block_align) {
     ptrdiff_t new_block_size = block_align(block_size);
@@ -375,6 +590,14 @@ void ThreadPool::ParallelFor(std::ptrdiff_t total, double cost_per_unit,
   ParallelFor(total, TensorOpCost{0, 0, static_cast<double>(cost_per_unit)}, fn);
 }
 
+std::ptrdiff_t ThreadPool::DefaultNumBatches(const ThreadPool* tp, std::ptrdiff_t total) {
+  std::ptrdiff_t num_batches = DegreeOfParallelism(tp);
+  if (UseFineGrainedBlocks()) {
+    num_batches *= 4;
+  }
+  return std::min<std::ptrdiff_t>(total, num_batches);
+}
+
 bool ThreadPool::ShouldParallelize(const concurrency::ThreadPool* tp) {
   return (DegreeOfParallelism(tp) != 1);
 }
@@ -389,8 +612,24 @@ int ThreadPool::DegreeOfParallelism(const concurrency::ThreadPool* tp) {
   return (omp_get_num_threads() == 1) ? omp_get_max_threads() : 1;
 #else
   // When not using OpenMP, we parallelise over the N threads created by the pool
-  // tp, plus 1 for the thread entering a loop.
-  return tp ? (tp->NumThreads()+1) : 1;
+  // tp, plus 1 for the thread entering a loop, unless the caller's RunScope
+  // limits it to fewer.
+  if (!tp) {
+    return 1;
+  }
+  int d_of_p = tp->NumThreads() + 1;
+  const RunScope* scope = RunScope::current_run_scope;
+  if (scope && scope->tp_ == tp) {
+    if (scope->max_dop_ > 0) {
+      d_of_p = std::min(d_of_p, scope->max_dop_);
+    }
+    unsigned worker_begin = 0;
+    unsigned worker_end = 0;
+    if (tp->GetCallerWorkerRange(worker_begin, worker_end)) {
+      d_of_p = std::min(d_of_p, static_cast<int>(worker_end - worker_begin) + 1);
+    }
+  }
+  return d_of_p;
 #endif
 }
 
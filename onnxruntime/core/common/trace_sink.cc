@@ -0,0 +1,149 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/trace_sink.h"
+
+#include <chrono>
+#include <fstream>
+#include <vector>
+
+#include "core/common/logging/logging.h"
+#include "core/common/make_unique.h"
+#include "core/platform/ort_mutex.h"
+
+#ifdef ORT_USE_USDT_TRACING
+#include <sys/sdt.h>
+#endif
+
+namespace onnxruntime {
+namespace tracing {
+
+namespace detail {
+std::atomic<ITraceSink*> current_trace_sink{nullptr};
+}  // namespace detail
+
+const char* CategoryName(Category category) {
+  switch (category) {
+    case Category::kNode:
+      return "node";
+    case Category::kParallelSection:
+      return "parallel_section";
+    case Category::kParallelFor:
+      return "parallel_for";
+    case Category::kArena:
+      return "arena";
+  }
+  return "unknown";
+}
+
+namespace {
+// owns every sink that was set. the current sink is cleared before they are destroyed at exit.
+struct TraceSinks {
+  ~TraceSinks() {
+    detail::current_trace_sink.store(nullptr, std::memory_order_release);
+  }
+
+  OrtMutex mutex;
+  std::vector<std::unique_ptr<ITraceSink>> sinks;
+};
+
+TraceSinks& GetTraceSinks() {
+  static TraceSinks trace_sinks;
+  return trace_sinks;
+}
+
+class ChromeTraceSink : public ITraceSink {
+ public:
+  explicit ChromeTraceSink(const std::string& file_path)
+      : stream_(file_path, std::ios::out | std::ios::trunc),
+        start_time_(std::chrono::steady_clock::now()),
+        pid_(logging::GetProcessId()) {
+    ORT_ENFORCE(stream_.good(), "Failed to open trace file ", file_path);
+    // the trace viewer accepts a JSON array without the closing bracket, so events are appended as they come
+    stream_ << "[\n";
+  }
+
+  void Begin(Category category, const char* name, const char* detail) override {
+    WriteEvent('B', category, name, detail, nullptr);
+  }
+
+  void End(Category category, const char* name) override {
+    WriteEvent('E', category, name, nullptr, nullptr);
+  }
+
+  void Instant(Category category, const char* name, int64_t value) override {
+    WriteEvent('i', category, name, nullptr, &value);
+  }
+
+ private:
+  void WriteEvent(char phase, Category category, const char* name, const char* detail, const int64_t* value) {
+    const auto ts = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                                          start_time_)
+                        .count();
+    const auto tid = logging::GetThreadId();
+
+    std::lock_guard<OrtMutex> lock(mutex_);
+    stream_ << R"({"cat" : ")" << CategoryName(category) << R"(", "name" : ")" << (name ? name : "")
+            << R"(", "ph" : ")" << phase << R"(", "ts" : )" << ts << R"(, "pid" : )" << pid_
+            << R"(, "tid" : )" << tid;
+    if (phase == 'i') {
+      stream_ << R"(, "s" : "t")";
+    }
+    if (detail != nullptr) {
+      stream_ << R"(, "args" : {"detail" : ")" << detail << R"("})";
+    } else if (value != nullptr) {
+      stream_ << R"(, "args" : {"value" : )" << *value << "}";
+    }
+    stream_ << "},\n";
+  }
+
+  OrtMutex mutex_;
+  std::ofstream stream_;
+  const std::chrono::steady_clock::time_point start_time_;
+  const unsigned int pid_;
+};
+
+#ifdef ORT_USE_USDT_TRACING
+// the probes can be listed with `perf list sdt_onnxruntime:*` after `perf buildid-cache --add <library>`,
+// or attached to with bpftrace, e.g. `usdt:<library>:onnxruntime:begin`.
+class UsdtTraceSink : public ITraceSink {
+ public:
+  void Begin(Category category, const char* name, const char* detail) override {
+    DTRACE_PROBE3(onnxruntime, begin, static_cast<int>(category), name, detail);
+  }
+
+  void End(Category category, const char* name) override {
+    DTRACE_PROBE2(onnxruntime, end, static_cast<int>(category), name);
+  }
+
+  void Instant(Category category, const char* name, int64_t value) override {
+    DTRACE_PROBE3(onnxruntime, instant, static_cast<int>(category), name, value);
+  }
+};
+#endif
+}  // namespace
+
+void SetTraceSink(std::unique_ptr<ITraceSink> sink) {
+  auto& trace_sinks = GetTraceSinks();
+  std::lock_guard<OrtMutex> lock(trace_sinks.mutex);
+  ITraceSink* current = sink.get();
+  if (sink) {
+    trace_sinks.sinks.push_back(std::move(sink));
+  }
+  detail::current_trace_sink.store(current, std::memory_order_release);
+}
+
+std::unique_ptr<ITraceSink> CreateChromeTraceSink(const std::string& file_path) {
+  return onnxruntime::make_unique<ChromeTraceSink>(file_path);
+}
+
+std::unique_ptr<ITraceSink> CreateUsdtTraceSink() {
+#ifdef ORT_USE_USDT_TRACING
+  return onnxruntime::make_unique<UsdtTraceSink>();
+#else
+  return nullptr;
+#endif
+}
+
+}  // namespace tracing
+}  // namespace onnxruntime
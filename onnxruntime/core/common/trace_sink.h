@@ -0,0 +1,98 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+namespace tracing {
+
+/**
+ * Categories of the events reported to the trace sink.
+ */
+enum class Category : uint8_t {
+  kNode = 0,         // the Compute call of a kernel. name is the node name, detail the op type.
+  kParallelSection,  // a thread pool parallel section
+  kParallelFor,      // a thread pool parallel loop, on the thread that runs it
+  kArena,            // an arena event, e.g. an extend. value is the size in bytes.
+};
+
+const char* CategoryName(Category category);
+
+/**
+ * Receives the tracing events of the whole process, so node execution, thread pool activity and arena extends can be
+ * correlated with external tools, e.g. perf through USDT probes or Nsight through NVTX ranges.
+ * Begin and End of a range are called on the same thread and ranges on a thread are nested.
+ * The methods are called concurrently from many threads.
+ */
+class ITraceSink {
+ public:
+  virtual ~ITraceSink() = default;
+
+  virtual void Begin(Category category, const char* name, const char* detail) = 0;
+  virtual void End(Category category, const char* name) = 0;
+  virtual void Instant(Category category, const char* name, int64_t value) = 0;
+};
+
+namespace detail {
+extern std::atomic<ITraceSink*> current_trace_sink;
+}  // namespace detail
+
+/**
+ * The current sink, or nullptr if tracing is disabled. Checking it is the only cost of the tracing points when
+ * tracing is disabled.
+ */
+inline ITraceSink* GetTraceSink() {
+  return detail::current_trace_sink.load(std::memory_order_acquire);
+}
+
+/**
+ * Set the process wide trace sink, or disable tracing with nullptr. Sinks that were set are kept alive until the
+ * process exits, as other threads may still be reporting events to a sink after it was replaced.
+ */
+void SetTraceSink(std::unique_ptr<ITraceSink> sink);
+
+/** A sink that streams the events to a file in the Chrome trace event format. */
+std::unique_ptr<ITraceSink> CreateChromeTraceSink(const std::string& file_path);
+
+/** A sink that fires USDT probes, or nullptr if the build does not support them. */
+std::unique_ptr<ITraceSink> CreateUsdtTraceSink();
+
+/** Reports a range to the current sink, if any, for the lifetime of the object. */
+class TraceRange {
+ public:
+  TraceRange(Category category, const char* name, const char* detail = nullptr)
+      : sink_(GetTraceSink()), category_(category), name_(name) {
+    if (sink_) {
+      sink_->Begin(category_, name_, detail);
+    }
+  }
+
+  ~TraceRange() {
+    if (sink_) {
+      sink_->End(category_, name_);
+    }
+  }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(TraceRange);
+
+  ITraceSink* const sink_;
+  const Category category_;
+  const char* const name_;
+};
+
+inline void TraceInstant(Category category, const char* name, int64_t value) {
+  if (auto* sink = GetTraceSink()) {
+    sink->Instant(category, name, value);
+  }
+}
+
+}  // namespace tracing
+}  // namespace onnxruntime
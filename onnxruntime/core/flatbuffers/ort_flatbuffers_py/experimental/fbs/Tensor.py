@@ -119,7 +119,21 @@ class Tensor(object):
         o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(14))
         return o == 0
 
-def TensorStart(builder): builder.StartObject(6)
+    # Tensor
+    def RawDataCompression(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(16))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Int32Flags, o + self._tab.Pos)
+        return 0
+
+    # Tensor
+    def RawDataUncompressedSize(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(18))
+        if o != 0:
+            return self._tab.Get(flatbuffers.number_types.Uint64Flags, o + self._tab.Pos)
+        return 0
+
+def TensorStart(builder): builder.StartObject(8)
 def TensorAddName(builder, name): builder.PrependUOffsetTRelativeSlot(0, flatbuffers.number_types.UOffsetTFlags.py_type(name), 0)
 def TensorAddDocString(builder, docString): builder.PrependUOffsetTRelativeSlot(1, flatbuffers.number_types.UOffsetTFlags.py_type(docString), 0)
 def TensorAddDims(builder, dims): builder.PrependUOffsetTRelativeSlot(2, flatbuffers.number_types.UOffsetTFlags.py_type(dims), 0)
@@ -129,4 +143,6 @@ def TensorAddRawData(builder, rawData): builder.PrependUOffsetTRelativeSlot(4, f
 def TensorStartRawDataVector(builder, numElems): return builder.StartVector(1, numElems, 1)
 def TensorAddStringData(builder, stringData): builder.PrependUOffsetTRelativeSlot(5, flatbuffers.number_types.UOffsetTFlags.py_type(stringData), 0)
 def TensorStartStringDataVector(builder, numElems): return builder.StartVector(4, numElems, 4)
+def TensorAddRawDataCompression(builder, rawDataCompression): builder.PrependInt32Slot(6, rawDataCompression, 0)
+def TensorAddRawDataUncompressedSize(builder, rawDataUncompressedSize): builder.PrependUint64Slot(7, rawDataUncompressedSize, 0)
 def TensorEnd(builder): return builder.EndObject()
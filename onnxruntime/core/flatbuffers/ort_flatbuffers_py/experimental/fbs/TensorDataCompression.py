@@ -0,0 +1,9 @@
+# automatically generated by the FlatBuffers compiler, do not modify
+
+# namespace: fbs
+
+class TensorDataCompression(object):
+    NONE = 0
+    LZ4 = 1
+    BYTE_SHUFFLE_LZ4 = 2
+
@@ -328,6 +328,39 @@ template<> struct TypeInfoValueTraits<onnxruntime::experimental::fbs::MapType> {
 bool VerifyTypeInfoValue(flatbuffers::Verifier &verifier, const void *obj, TypeInfoValue type);
 bool VerifyTypeInfoValueVector(flatbuffers::Verifier &verifier, const flatbuffers::Vector<flatbuffers::Offset<void>> *values, const flatbuffers::Vector<uint8_t> *types);
 
+enum class TensorDataCompression : int32_t {
+  NONE = 0,
+  LZ4 = 1,
+  BYTE_SHUFFLE_LZ4 = 2,
+  MIN = NONE,
+  MAX = BYTE_SHUFFLE_LZ4
+};
+
+inline const TensorDataCompression (&EnumValuesTensorDataCompression())[3] {
+  static const TensorDataCompression values[] = {
+    TensorDataCompression::NONE,
+    TensorDataCompression::LZ4,
+    TensorDataCompression::BYTE_SHUFFLE_LZ4
+  };
+  return values;
+}
+
+inline const char * const *EnumNamesTensorDataCompression() {
+  static const char * const names[4] = {
+    "NONE",
+    "LZ4",
+    "BYTE_SHUFFLE_LZ4",
+    nullptr
+  };
+  return names;
+}
+
+inline const char *EnumNameTensorDataCompression(TensorDataCompression e) {
+  if (flatbuffers::IsOutRange(e, TensorDataCompression::NONE, TensorDataCompression::BYTE_SHUFFLE_LZ4)) return "";
+  const size_t index = static_cast<size_t>(e);
+  return EnumNamesTensorDataCompression()[index];
+}
+
 FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) EdgeEnd FLATBUFFERS_FINAL_CLASS {
  private:
   uint32_t node_index_;
@@ -1244,7 +1277,9 @@ struct Tensor FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
     VT_DIMS = 8,
     VT_DATA_TYPE = 10,
     VT_RAW_DATA = 12,
-    VT_STRING_DATA = 14
+    VT_STRING_DATA = 14,
+    VT_RAW_DATA_COMPRESSION = 16,
+    VT_RAW_DATA_UNCOMPRESSED_SIZE = 18
   };
   const flatbuffers::String *name() const {
     return GetPointer<const flatbuffers::String *>(VT_NAME);
@@ -1264,6 +1299,12 @@ struct Tensor FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *string_data() const {
     return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *>(VT_STRING_DATA);
   }
+  onnxruntime::experimental::fbs::TensorDataCompression raw_data_compression() const {
+    return static_cast<onnxruntime::experimental::fbs::TensorDataCompression>(GetField<int32_t>(VT_RAW_DATA_COMPRESSION, 0));
+  }
+  uint64_t raw_data_uncompressed_size() const {
+    return GetField<uint64_t>(VT_RAW_DATA_UNCOMPRESSED_SIZE, 0);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_NAME) &&
@@ -1278,6 +1319,8 @@ struct Tensor FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            VerifyOffset(verifier, VT_STRING_DATA) &&
            verifier.VerifyVector(string_data()) &&
            verifier.VerifyVectorOfStrings(string_data()) &&
+           VerifyField<int32_t>(verifier, VT_RAW_DATA_COMPRESSION) &&
+           VerifyField<uint64_t>(verifier, VT_RAW_DATA_UNCOMPRESSED_SIZE) &&
            verifier.EndTable();
   }
 };
@@ -1304,6 +1347,12 @@ struct TensorBuilder {
   void add_string_data(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> string_data) {
     fbb_.AddOffset(Tensor::VT_STRING_DATA, string_data);
   }
+  void add_raw_data_compression(onnxruntime::experimental::fbs::TensorDataCompression raw_data_compression) {
+    fbb_.AddElement<int32_t>(Tensor::VT_RAW_DATA_COMPRESSION, static_cast<int32_t>(raw_data_compression), 0);
+  }
+  void add_raw_data_uncompressed_size(uint64_t raw_data_uncompressed_size) {
+    fbb_.AddElement<uint64_t>(Tensor::VT_RAW_DATA_UNCOMPRESSED_SIZE, raw_data_uncompressed_size, 0);
+  }
   explicit TensorBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -1323,8 +1372,12 @@ inline flatbuffers::Offset<Tensor> CreateTensor(
     flatbuffers::Offset<flatbuffers::Vector<int64_t>> dims = 0,
     onnxruntime::experimental::fbs::TensorDataType data_type = onnxruntime::experimental::fbs::TensorDataType::UNDEFINED,
     flatbuffers::Offset<flatbuffers::Vector<uint8_t>> raw_data = 0,
-    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> string_data = 0) {
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> string_data = 0,
+    onnxruntime::experimental::fbs::TensorDataCompression raw_data_compression = onnxruntime::experimental::fbs::TensorDataCompression::NONE,
+    uint64_t raw_data_uncompressed_size = 0) {
   TensorBuilder builder_(_fbb);
+  builder_.add_raw_data_uncompressed_size(raw_data_uncompressed_size);
+  builder_.add_raw_data_compression(raw_data_compression);
   builder_.add_string_data(string_data);
   builder_.add_raw_data(raw_data);
   builder_.add_data_type(data_type);
@@ -1341,7 +1394,9 @@ inline flatbuffers::Offset<Tensor> CreateTensorDirect(
     const std::vector<int64_t> *dims = nullptr,
     onnxruntime::experimental::fbs::TensorDataType data_type = onnxruntime::experimental::fbs::TensorDataType::UNDEFINED,
     const std::vector<uint8_t> *raw_data = nullptr,
-    const std::vector<flatbuffers::Offset<flatbuffers::String>> *string_data = nullptr) {
+    const std::vector<flatbuffers::Offset<flatbuffers::String>> *string_data = nullptr,
+    onnxruntime::experimental::fbs::TensorDataCompression raw_data_compression = onnxruntime::experimental::fbs::TensorDataCompression::NONE,
+    uint64_t raw_data_uncompressed_size = 0) {
   auto name__ = name ? _fbb.CreateString(name) : 0;
   auto doc_string__ = doc_string ? _fbb.CreateString(doc_string) : 0;
   auto dims__ = dims ? _fbb.CreateVector<int64_t>(*dims) : 0;
@@ -1354,7 +1409,9 @@ inline flatbuffers::Offset<Tensor> CreateTensorDirect(
       dims__,
       data_type,
       raw_data__,
-      string_data__);
+      string_data__,
+      raw_data_compression,
+      raw_data_uncompressed_size);
 }
 
 struct SparseTensor FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
@@ -0,0 +1,264 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/flatbuffers/tensor_compression.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include "core/common/common.h"
+#include "core/flatbuffers/schema/ort.fbs.h"
+
+namespace onnxruntime {
+namespace experimental {
+namespace utils {
+
+namespace {
+
+// LZ4 block format constants. See https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md
+constexpr size_t kMinMatch = 4;
+constexpr size_t kLastLiterals = 5;      // the last 5 bytes are always literals
+constexpr size_t kMatchStartLimit = 12;  // the last match starts at least 12 bytes before the end
+constexpr size_t kMaxOffset = 65535;
+constexpr size_t kLengthMask = 15;
+constexpr int kHashLog = 16;
+
+uint32_t Read32(const uint8_t* p) {
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+uint32_t Hash(uint32_t sequence) {
+  return (sequence * 2654435761U) >> (32 - kHashLog);
+}
+
+uint8_t* WriteLength(uint8_t* op, size_t length) {
+  for (; length >= 255; length -= 255) {
+    *op++ = 255;
+  }
+  *op++ = static_cast<uint8_t>(length);
+  return op;
+}
+
+// Writes the literals followed by a match, or only the literals if match_length is 0 for the last sequence
+uint8_t* WriteSequence(uint8_t* op, const uint8_t* literals, size_t num_literals, size_t offset, size_t match_length) {
+  uint8_t* token = op++;
+  *token = static_cast<uint8_t>(std::min(num_literals, kLengthMask) << 4);
+  if (num_literals >= kLengthMask) {
+    op = WriteLength(op, num_literals - kLengthMask);
+  }
+  std::memcpy(op, literals, num_literals);
+  op += num_literals;
+
+  if (match_length == 0) {
+    return op;
+  }
+
+  *op++ = static_cast<uint8_t>(offset & 0xff);
+  *op++ = static_cast<uint8_t>(offset >> 8);
+  const size_t length = match_length - kMinMatch;
+  *token |= static_cast<uint8_t>(std::min(length, kLengthMask));
+  if (length >= kLengthMask) {
+    op = WriteLength(op, length - kLengthMask);
+  }
+  return op;
+}
+
+size_t Lz4CompressBound(size_t size) {
+  return size + size / 255 + 16;
+}
+
+// Greedy compression matching the 4 byte sequences seen last
+size_t Lz4Compress(const uint8_t* src, size_t size, uint8_t* dst) {
+  const uint8_t* const end = src + size;
+  const uint8_t* anchor = src;
+  uint8_t* op = dst;
+
+  if (size > kMatchStartLimit) {
+    // the positions are stored offset by 1 so 0 is an empty entry
+    std::vector<size_t> table(size_t{1} << kHashLog, 0);
+    const uint8_t* const match_start_limit = end - kMatchStartLimit;
+    const uint8_t* const match_end_limit = end - kLastLiterals;
+
+    const uint8_t* ip = src;
+    while (ip < match_start_limit) {
+      const uint32_t sequence = Read32(ip);
+      size_t& entry = table[Hash(sequence)];
+      const uint8_t* ref = entry == 0 ? nullptr : src + entry - 1;
+      entry = static_cast<size_t>(ip - src) + 1;
+
+      if (ref == nullptr || static_cast<size_t>(ip - ref) > kMaxOffset || Read32(ref) != sequence) {
+        ++ip;
+        continue;
+      }
+
+      const uint8_t* match_end = ip + kMinMatch;
+      const uint8_t* ref_end = ref + kMinMatch;
+      while (match_end < match_end_limit && *match_end == *ref_end) {
+        ++match_end;
+        ++ref_end;
+      }
+
+      while (ip > anchor && ref > src && ip[-1] == ref[-1]) {
+        --ip;
+        --ref;
+      }
+
+      op = WriteSequence(op, anchor, static_cast<size_t>(ip - anchor), static_cast<size_t>(ip - ref),
+                         static_cast<size_t>(match_end - ip));
+      ip = match_end;
+      anchor = ip;
+    }
+  }
+
+  op = WriteSequence(op, anchor, static_cast<size_t>(end - anchor), 0, 0);
+  return static_cast<size_t>(op - dst);
+}
+
+Status Lz4Decompress(const uint8_t* src, size_t src_size, uint8_t* dst, size_t dst_size) {
+  const uint8_t* ip = src;
+  const uint8_t* const iend = src + src_size;
+  uint8_t* op = dst;
+  uint8_t* const oend = dst + dst_size;
+
+  auto read_length = [&ip, iend](size_t& length) {
+    uint8_t byte;
+    do {
+      if (ip == iend) {
+        return false;
+      }
+      byte = *ip++;
+      length += byte;
+    } while (byte == 255);
+    return true;
+  };
+
+  constexpr const char* kCorrupt = "The compressed initializer data is invalid.";
+  for (;;) {
+    ORT_RETURN_IF(ip == iend, kCorrupt);
+    const uint8_t token = *ip++;
+
+    size_t num_literals = token >> 4;
+    if (num_literals == kLengthMask) {
+      ORT_RETURN_IF_NOT(read_length(num_literals), kCorrupt);
+    }
+    ORT_RETURN_IF(num_literals > static_cast<size_t>(iend - ip) || num_literals > static_cast<size_t>(oend - op),
+                  kCorrupt);
+    std::memcpy(op, ip, num_literals);
+    op += num_literals;
+    ip += num_literals;
+
+    // the last sequence has no match
+    if (ip == iend) {
+      break;
+    }
+
+    ORT_RETURN_IF(iend - ip < 2, kCorrupt);
+    const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+    ip += 2;
+    ORT_RETURN_IF(offset == 0 || offset > static_cast<size_t>(op - dst), kCorrupt);
+
+    size_t match_length = token & kLengthMask;
+    if (match_length == kLengthMask) {
+      ORT_RETURN_IF_NOT(read_length(match_length), kCorrupt);
+    }
+    match_length += kMinMatch;
+    ORT_RETURN_IF(match_length > static_cast<size_t>(oend - op), kCorrupt);
+
+    const uint8_t* match = op - offset;
+    if (offset >= match_length) {
+      std::memcpy(op, match, match_length);
+      op += match_length;
+    } else {
+      // the match overlaps the output, repeating the last offset bytes
+      for (size_t i = 0; i < match_length; ++i) {
+        *op++ = *match++;
+      }
+    }
+  }
+
+  ORT_RETURN_IF(op != oend, "The compressed initializer data decompresses to ", op - dst, " bytes instead of ",
+                dst_size);
+  return Status::OK();
+}
+
+// Groups byte j of each element, i.e. dst[j * num_elements + i] = src[i * element_size + j]
+void ShuffleBytes(const uint8_t* src, size_t size, size_t element_size, uint8_t* dst) {
+  const size_t num_elements = size / element_size;
+  for (size_t i = 0; i < num_elements; ++i) {
+    for (size_t j = 0; j < element_size; ++j) {
+      dst[j * num_elements + i] = src[i * element_size + j];
+    }
+  }
+  // the trailing bytes of a size that isn't a multiple of element_size are not shuffled
+  std::memcpy(dst + num_elements * element_size, src + num_elements * element_size, size % element_size);
+}
+
+void UnshuffleBytes(const uint8_t* src, size_t size, size_t element_size, uint8_t* dst) {
+  const size_t num_elements = size / element_size;
+  for (size_t i = 0; i < num_elements; ++i) {
+    for (size_t j = 0; j < element_size; ++j) {
+      dst[i * element_size + j] = src[j * num_elements + i];
+    }
+  }
+  std::memcpy(dst + num_elements * element_size, src + num_elements * element_size, size % element_size);
+}
+
+bool IsShuffled(fbs::TensorDataCompression compression, size_t element_size) {
+  return compression == fbs::TensorDataCompression::BYTE_SHUFFLE_LZ4 && element_size > 1;
+}
+
+}  // namespace
+
+bool CompressTensorData(const uint8_t* data, size_t size, fbs::TensorDataCompression compression, size_t element_size,
+                        std::vector<uint8_t>& compressed) {
+  ORT_ENFORCE(compression == fbs::TensorDataCompression::LZ4 ||
+                  compression == fbs::TensorDataCompression::BYTE_SHUFFLE_LZ4,
+              "Unsupported tensor data compression ", static_cast<int32_t>(compression));
+
+  if (size == 0) {
+    return false;
+  }
+
+  std::unique_ptr<uint8_t[]> shuffled;
+  if (IsShuffled(compression, element_size)) {
+    shuffled.reset(new uint8_t[size]);
+    ShuffleBytes(data, size, element_size, shuffled.get());
+    data = shuffled.get();
+  }
+
+  compressed.resize(Lz4CompressBound(size));
+  compressed.resize(Lz4Compress(data, size, compressed.data()));
+  return compressed.size() < size;
+}
+
+Status DecompressTensorData(const uint8_t* compressed, size_t compressed_size, fbs::TensorDataCompression compression,
+                            size_t element_size, uint8_t* data, size_t size) {
+  switch (compression) {
+    case fbs::TensorDataCompression::NONE:
+      ORT_RETURN_IF(compressed_size != size, "The initializer data has ", compressed_size, " bytes instead of ", size);
+      std::memcpy(data, compressed, size);
+      return Status::OK();
+    case fbs::TensorDataCompression::LZ4:
+    case fbs::TensorDataCompression::BYTE_SHUFFLE_LZ4:
+      break;
+    default:
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported tensor data compression ",
+                             static_cast<int32_t>(compression), ". Invalid ORT format model.");
+  }
+
+  if (!IsShuffled(compression, element_size)) {
+    return Lz4Decompress(compressed, compressed_size, data, size);
+  }
+
+  std::unique_ptr<uint8_t[]> shuffled(new uint8_t[size]);
+  ORT_RETURN_IF_ERROR(Lz4Decompress(compressed, compressed_size, shuffled.get(), size));
+  UnshuffleBytes(shuffled.get(), size, element_size, data);
+  return Status::OK();
+}
+
+}  // namespace utils
+}  // namespace experimental
+}  // namespace onnxruntime
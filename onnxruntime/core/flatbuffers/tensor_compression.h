@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/common/status.h"
+
+namespace onnxruntime {
+
+namespace experimental {
+
+namespace fbs {
+enum class TensorDataCompression : int32_t;
+}  // namespace fbs
+
+namespace utils {
+
+/**
+Compress the raw data of a tensor for the ORT format.
+The data is compressed with the LZ4 block format, which is fast to decompress. With BYTE_SHUFFLE_LZ4, the bytes of
+the elements of element_size bytes are grouped by their position within the element first.
+@param compressed Set to the compressed data.
+@returns false if the compressed data isn't smaller than the data, in which case it should be saved uncompressed.
+*/
+bool CompressTensorData(const uint8_t* data, size_t size, fbs::TensorDataCompression compression, size_t element_size,
+                        std::vector<uint8_t>& compressed);
+
+/**
+Decompress the raw data of a tensor saved with CompressTensorData into the size bytes at data.
+Fails if the compressed data is invalid or doesn't decompress to size bytes.
+*/
+onnxruntime::common::Status DecompressTensorData(const uint8_t* compressed, size_t compressed_size,
+                                                 fbs::TensorDataCompression compression, size_t element_size,
+                                                 uint8_t* data, size_t size);
+
+}  // namespace utils
+}  // namespace experimental
+}  // namespace onnxruntime
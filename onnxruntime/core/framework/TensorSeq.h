@@ -3,13 +3,17 @@
 
 #pragma once
 
+#include "core/framework/ml_value.h"
 #include "core/framework/tensor.h"
+#include <iterator>
 #include <vector>
 #include <utility>
 
 namespace onnxruntime {
 // Put this in a separate file to avoid circular dependency between tensor.h and data_types.h
-// Data type to represent a sequence of tensors of the same type
+// Data type to represent a sequence of tensors of the same type.
+// Each tensor is held by an OrtValue so the sequence ops can share a tensor between the input and output sequences
+// instead of copying it. The tensors are never modified once added to a sequence.
 class TensorSeq {
  public:
   TensorSeq() = default;
@@ -17,7 +21,37 @@ class TensorSeq {
     SetType(elem_type);
   }
 
-  using const_iterator = std::vector<Tensor>::const_iterator;
+  // Iterates over the tensors of the sequence
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Tensor;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Tensor*;
+    using reference = const Tensor&;
+
+    explicit const_iterator(std::vector<OrtValue>::const_iterator it) noexcept : it_(it) {}
+
+    reference operator*() const { return it_->Get<Tensor>(); }
+    pointer operator->() const { return &it_->Get<Tensor>(); }
+
+    const_iterator& operator++() noexcept {
+      ++it_;
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept {
+      const_iterator prev = *this;
+      ++it_;
+      return prev;
+    }
+
+    bool operator==(const const_iterator& o) const noexcept { return it_ == o.it_; }
+    bool operator!=(const const_iterator& o) const noexcept { return it_ != o.it_; }
+
+   private:
+    std::vector<OrtValue>::const_iterator it_;
+  };
 
   // Sets the element type after construction.
   // Expects sequence to be empty at the time.
@@ -32,7 +66,28 @@ class TensorSeq {
     // (1) `elem_type` is set before invoking this method
     // (2) All tensors contain elements of the same primitive data type
     assert(tensors_.empty());
-    tensors_ = std::move(tensors);
+    tensors_.reserve(tensors.size());
+    for (auto& tensor : tensors) {
+      Add(std::move(tensor));
+    }
+  }
+
+  void Reserve(size_t capacity) {
+    tensors_.reserve(capacity);
+  }
+
+  // Add a tensor to the end of the sequence, taking ownership of it.
+  void Add(Tensor&& tensor) {
+    auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+    tensors_.emplace_back(new Tensor(std::move(tensor)), ml_tensor, ml_tensor->GetDeleteFunc());
+  }
+
+  // Add a tensor to the end of the sequence, sharing it with the OrtValue.
+  // The tensor must own its buffer, or the buffer must outlive the sequence.
+  void Add(const OrtValue& tensor) {
+    ORT_ENFORCE(tensor.IsTensor(), "Only tensors can be added to a tensor sequence");
+    ORT_ENFORCE(IsSameDataType(tensor.Get<Tensor>()), "All tensors in a sequence must have the same data type");
+    tensors_.push_back(tensor);
   }
 
   MLDataType DataType() const noexcept { return elem_type_; }
@@ -49,15 +104,20 @@ class TensorSeq {
 
   // Suitable for for range loop
   const_iterator begin() const noexcept {
-    return tensors_.cbegin();
+    return const_iterator(tensors_.cbegin());
   }
 
   const_iterator end() const noexcept {
-    return tensors_.cend();
+    return const_iterator(tensors_.cend());
   }
 
   // Get by index
   const Tensor& Get(size_t i) const {
+    return GetAt(i).Get<Tensor>();
+  }
+
+  // Get the OrtValue holding the tensor at an index, which can be added to another sequence to share the tensor
+  const OrtValue& GetAt(size_t i) const {
     ORT_ENFORCE(i < tensors_.size());
     return tensors_[i];
   }
@@ -72,7 +132,7 @@ class TensorSeq {
 
   // TODO: optimization opportunity - if all tensors in the seq are scalars, we can potentially represent them
   // as vector<primitive type>
-  std::vector<Tensor> tensors_;
+  std::vector<OrtValue> tensors_;
 };
 
 }  // namespace onnxruntime
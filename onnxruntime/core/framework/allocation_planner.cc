@@ -4,6 +4,7 @@
 #include "core/framework/allocation_planner.h"
 #include <list>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 #include <sstream>
 #include "core/common/exceptions.h"
@@ -72,6 +73,8 @@ std::ostream& operator<<(std::ostream& out, std::pair<const SequentialExecutionP
 
       if (elt_plan.create_fence_if_async) out << ", use fence when async";
 
+      if (elt_plan.may_be_view) out << ", may be a view";
+
     } else {
       out << "Index out-of-range!";
     }
@@ -157,6 +160,8 @@ class PlannerImpl {
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     OrtValueIndex inplace_reused_buffer_index = -1;  // index of original buffer to reuse inplace
 #endif
+    // index of the buffer kept alive for as long as the buffer of this OrtValue, as the OrtValue may be a view of it
+    OrtValueIndex view_source_buffer_index = -1;
   };
 
   // ort_value_info_ is indexed by an OrtValueIndex
@@ -220,6 +225,7 @@ class PlannerImpl {
     OrtValueInfo& info = ort_value_info_[id];
     info.usecount = 0;
     info.reused_buffer_index = id;  // initially, no reuse; the ml-value uses its own buffer
+    info.view_source_buffer_index = -1;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     info.inplace_reused_buffer_index = id;  // initially, no reuse; the ml-value uses its own buffer
 #endif
@@ -291,6 +297,10 @@ class PlannerImpl {
       }
     }
 
+    if (!context_.IsInplaceReuseEnabled()) {
+      return false;
+    }
+
     const std::vector<std::pair<int, int>>& inplace_map = ci.kernel_def->MayInplace();
     for (auto pair : inplace_map) {
       if (pair.second == output_arg_num) {
@@ -299,7 +309,8 @@ class PlannerImpl {
           if (p_input_arg->Exists()) {
             auto input_arg_index = Index(p_input_arg->Name());
             auto original = Buffer(input_arg_index);
-            if (1 == UseCount(original)) {
+            // a buffer that may be a view of another buffer must not be written to
+            if (1 == UseCount(original) && !AllocPlan(original).may_be_view) {
               if (SameSize(*p_input_arg, *p_output_arg)) {
                 // we can reuse this input since it is its last use and permitted for in-place update
                 *reusable_input = input_arg_index;  // or original; both should be okay
@@ -313,6 +324,40 @@ class PlannerImpl {
     return false;
   }
 
+  // Find if the output_arg_num-th output of the node may be created as a view of one of the node's inputs.
+  bool FindViewSource(const onnxruntime::Node& node, int output_arg_num, OrtValueIndex* view_source) {
+    const KernelCreateInfo& ci = GetKernelCreateInfo(kernel_create_info_map_, node.Index());
+
+    if (ci.kernel_def == nullptr) {
+      return false;
+    }
+
+    auto input_args = node.InputDefs();
+    auto get_input = [&](int input_index) {
+      if ((0 <= input_index) && (static_cast<size_t>(input_index) < input_args.size())) {
+        auto p_input_arg = input_args[input_index];
+        if (p_input_arg->Exists()) {
+          *view_source = Index(p_input_arg->Name());
+          return true;
+        }
+      }
+      return false;
+    };
+
+    for (auto pair : ci.kernel_def->MayOutputView()) {
+      if (pair.second == output_arg_num && get_input(pair.first)) {
+        return true;
+      }
+    }
+
+    const optional<std::pair<int, int>>& variadic_view_offsets = ci.kernel_def->VariadicMayOutputView();
+    if (variadic_view_offsets.has_value() && output_arg_num >= variadic_view_offsets.value().second) {
+      return get_input(variadic_view_offsets.value().first);
+    }
+
+    return false;
+  }
+
   static bool SameShape(const TensorShapeProto& shape1, const TensorShapeProto& shape2) {
     // TODO: This should probably be defined to be the equality operator on TensorShapeProto.
     namespace on = ONNX_NAMESPACE;
@@ -398,6 +443,8 @@ class PlannerImpl {
         // TODO this should be an error case, needs more investigation
         continue;
       }
+      // the buffer of a value that may be a view of another buffer can't be handed out
+      if (AllocPlan(p_node_arg->Name()).may_be_view) continue;
       auto& available_memory_info = AllocPlan(p_node_arg->Name()).location;
       if (!(available_memory_info == required_memory_info)) continue;
       auto p_available_buffer_shape = context_.GetShape(*p_node_arg);
@@ -547,6 +594,9 @@ class PlannerImpl {
 
     const KernelCreateInfo& kernel_create_info = GetKernelCreateInfo(kernel_create_info_map_, node.Index());
 
+    if (kernel_create_info.kernel_def->InputMemoryType(input_index) == OrtMemTypeCPUOutput)
+      // weights the kernel accesses in host memory of the provider, e.g. CUDA pinned memory read by a CUDA kernel
+      return p_provider->GetAllocator(0, OrtMemTypeCPUOutput)->Info();
     if (kernel_create_info.kernel_def->IsInputOnCpu(input_index))
       // weights are not output from any node, so it's OK to put its location on CPU provider
       return execution_providers_.GetDefaultCpuMemoryInfo();
@@ -601,6 +651,20 @@ class PlannerImpl {
   }
 
   // Should only be used after ProcessDef()
+  // The buffer of `original` becomes free after the program_counter-th step of the execution plan
+  void FreeBuffer(OrtValueIndex original, size_t program_counter) {
+    freelist_.push_front(FreeBufferInfo(original, program_counter));
+    if (AllocPlan(original).alloc_kind == AllocKind::kAllocate) {
+      AllocPlan(original).program_counter.AddEnd(program_counter);
+    }
+
+    // release the buffer that was kept alive in case `original` is a view of it
+    OrtValueIndex view_source = ort_value_info_[original].view_source_buffer_index;
+    if ((view_source != -1) && (0 == DecrementUseCount(view_source))) {
+      FreeBuffer(view_source, program_counter);
+    }
+  }
+
   Status ComputeReusePlan() {
     std::vector<SequentialExecutionPlan::NodeExecutionPlan>& execution_plan(plan_.execution_plan);
     //copy the usecounts to an vector, before computing reuse
@@ -712,6 +776,18 @@ class PlannerImpl {
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
           InplaceReuse(reused, current);
 #endif
+        } else if (FindViewSource(*pnode, static_cast<int>(output_arg_def_index), &reused)) {
+          // The kernel may create this output as a view of one of its inputs at execution time.
+          // Allocate a buffer of its own for when it doesn't, and keep the input's buffer alive for as
+          // long as this output could be a view of it.
+          AllocPlan(current).alloc_kind = AllocKind::kAllocate;
+          AllocPlan(current).may_be_view = true;
+          AllocPlan(current).program_counter.AddStart(program_counter);
+          OrtValueIndex original = Buffer(reused);
+          if (original != -1) {
+            UseCount(original)++;
+            ort_value_info_[current].view_source_buffer_index = original;
+          }
         } else if (!context_.IsParallelExecutionEnabled() &&
                    FindReusableTensor(*node_output, &reused)) {
           // Reuse an available (dead) buffer for this output, this is only for sequential execution.
@@ -742,10 +818,7 @@ class PlannerImpl {
           }
 #endif
           if ((original != -1) && (0 == DecrementUseCount(original))) {
-            freelist_.push_front(FreeBufferInfo(original, program_counter));
-            if (AllocPlan(original).alloc_kind == AllocKind::kAllocate) {
-              AllocPlan(original).program_counter.AddEnd(program_counter);
-            }
+            FreeBuffer(original, program_counter);
           }
         }
       }
@@ -764,10 +837,7 @@ class PlannerImpl {
           }
 #endif
           if ((original != -1) && (0 == DecrementUseCount(original))) {
-            freelist_.push_front(FreeBufferInfo(original, program_counter));
-            if (AllocPlan(original).alloc_kind == AllocKind::kAllocate) {
-              AllocPlan(original).program_counter.AddEnd(program_counter);
-            }
+            FreeBuffer(original, program_counter);
           }
         }
       }
@@ -786,10 +856,7 @@ class PlannerImpl {
           }
 #endif
           if (0 == DecrementUseCount(original)) {
-            freelist_.push_front(FreeBufferInfo(original, program_counter));
-            if (AllocPlan(original).alloc_kind == AllocKind::kAllocate) {
-              AllocPlan(original).program_counter.AddEnd(program_counter);
-            }
+            FreeBuffer(original, program_counter);
           }
         }
       }
@@ -949,6 +1016,188 @@ class PlannerImpl {
     return !utils::HasTensorType(type_proto);
   }
 
+  // Returns the size of a tensor with a static shape, or 0 if the size isn't known before execution.
+  size_t GetStaticSizeInBytes(const onnxruntime::NodeArg& arg) const {
+    if (!arg.Exists() || IsNonTensor(arg)) return 0;
+    auto p_shape = context_.GetShape(arg);
+    if (nullptr == p_shape) return 0;
+
+    size_t size = GetElementSize(arg.Type());
+    for (const auto& dim : p_shape->dim()) {
+      if (!utils::HasDimValue(dim) || dim.dim_value() < 0) return 0;
+      size *= static_cast<size_t>(dim.dim_value());
+    }
+    return size;
+  }
+
+  // Estimate the peak size of the values produced by the nodes when the nodes are executed in the given order,
+  // with each value freed after its last use. Values without a static size are ignored.
+  size_t EstimatePeakBytes(const std::vector<NodeIndex>& order) const {
+    std::unordered_set<const NodeArg*> graph_outputs(graph_viewer_.GetOutputs().cbegin(),
+                                                     graph_viewer_.GetOutputs().cend());
+    std::unordered_map<const NodeArg*, int> remaining_uses;
+    for (auto node_index : order) {
+      const auto* pnode = graph_viewer_.GetNode(node_index);
+      for (auto node_input : pnode->InputDefs()) ++remaining_uses[node_input];
+      for (auto node_input : pnode->ImplicitInputDefs()) ++remaining_uses[node_input];
+    }
+
+    std::unordered_set<const NodeArg*> produced;
+    size_t live_bytes = 0;
+    size_t peak_bytes = 0;
+
+    auto release = [&](const NodeArg* arg) {
+      if (produced.count(arg) != 0 && graph_outputs.count(arg) == 0) {
+        live_bytes -= GetStaticSizeInBytes(*arg);
+      }
+    };
+
+    for (auto node_index : order) {
+      const auto* pnode = graph_viewer_.GetNode(node_index);
+      for (auto node_output : pnode->OutputDefs()) {
+        if (node_output->Exists()) {
+          produced.insert(node_output);
+          live_bytes += GetStaticSizeInBytes(*node_output);
+        }
+      }
+      peak_bytes = std::max(peak_bytes, live_bytes);
+
+      for (auto node_input : pnode->InputDefs()) {
+        if (0 == --remaining_uses[node_input]) release(node_input);
+      }
+      for (auto node_input : pnode->ImplicitInputDefs()) {
+        if (0 == --remaining_uses[node_input]) release(node_input);
+      }
+      for (auto node_output : pnode->OutputDefs()) {
+        if (node_output->Exists() && remaining_uses[node_output] == 0) release(node_output);
+      }
+    }
+
+    return peak_bytes;
+  }
+
+  // Compute an execution order that reduces the peak size of the values produced by the nodes, given their static
+  // sizes. This generalizes the ordering of Sethi and Ullman for expression trees: the producers of the inputs of a
+  // node are executed depth first, in the order of decreasing difference between the peak size while computing the
+  // input and the size of the input, which is optimal if the graph is a tree. Values shared by several nodes make
+  // this a heuristic, so the order is only used if its estimated peak is lower than the one of the default order.
+  std::vector<NodeIndex> ComputeMemoryEfficientOrder(const std::vector<NodeIndex>& default_order) const {
+    std::unordered_map<NodeIndex, size_t> positions;
+    for (size_t i = 0; i < default_order.size(); ++i) {
+      positions[default_order[i]] = i;
+    }
+
+    // result_bytes is the size of the outputs of a node and peak_bytes the estimated peak size while computing them
+    std::unordered_map<NodeIndex, size_t> result_bytes;
+    std::unordered_map<NodeIndex, size_t> peak_bytes;
+    std::unordered_map<NodeIndex, std::vector<NodeIndex>> input_nodes;
+    std::vector<NodeIndex> sink_nodes;
+
+    auto by_decreasing_retained_bytes = [&](NodeIndex n1, NodeIndex n2) {
+      const size_t retained1 = peak_bytes[n1] - result_bytes[n1];
+      const size_t retained2 = peak_bytes[n2] - result_bytes[n2];
+      if (retained1 != retained2) return retained1 > retained2;
+      return positions[n1] < positions[n2];
+    };
+
+    for (auto node_index : default_order) {
+      const auto* pnode = graph_viewer_.GetNode(node_index);
+
+      size_t outputs_bytes = 0;
+      for (auto node_output : pnode->OutputDefs()) {
+        outputs_bytes += GetStaticSizeInBytes(*node_output);
+      }
+
+      auto& inputs = input_nodes[node_index];
+      for (auto it = pnode->InputNodesBegin(), end = pnode->InputNodesEnd(); it != end; ++it) {
+        const NodeIndex input_index = it->Index();
+        if (positions.count(input_index) != 0 && std::find(inputs.begin(), inputs.end(), input_index) == inputs.end()) {
+          inputs.push_back(input_index);
+        }
+      }
+      std::sort(inputs.begin(), inputs.end(), by_decreasing_retained_bytes);
+
+      size_t inputs_bytes = 0;
+      size_t peak = 0;
+      for (auto input_index : inputs) {
+        peak = std::max(peak, inputs_bytes + peak_bytes[input_index]);
+        inputs_bytes += result_bytes[input_index];
+      }
+
+      result_bytes[node_index] = outputs_bytes;
+      peak_bytes[node_index] = std::max(peak, inputs_bytes + outputs_bytes);
+
+      bool is_sink = true;
+      for (auto it = pnode->OutputNodesBegin(), end = pnode->OutputNodesEnd(); it != end && is_sink; ++it) {
+        is_sink = positions.count(it->Index()) == 0;
+      }
+      if (is_sink) {
+        sink_nodes.push_back(node_index);
+      }
+    }
+
+    std::sort(sink_nodes.begin(), sink_nodes.end(), by_decreasing_retained_bytes);
+
+    // emit the nodes in post order of a depth first traversal of the inputs, starting from the sinks
+    std::vector<NodeIndex> order;
+    order.reserve(default_order.size());
+    std::unordered_set<NodeIndex> visited;
+    std::vector<std::pair<NodeIndex, size_t>> stack;
+
+    for (auto sink_index : sink_nodes) {
+      if (!visited.insert(sink_index).second) continue;
+      stack.emplace_back(sink_index, 0);
+
+      while (!stack.empty()) {
+        const NodeIndex node_index = stack.back().first;
+        const auto& inputs = input_nodes[node_index];
+        if (stack.back().second < inputs.size()) {
+          const NodeIndex input_index = inputs[stack.back().second++];
+          if (visited.insert(input_index).second) {
+            stack.emplace_back(input_index, 0);
+          }
+        } else {
+          order.push_back(node_index);
+          stack.pop_back();
+        }
+      }
+    }
+
+    if (order.size() != default_order.size() || EstimatePeakBytes(order) >= EstimatePeakBytes(default_order)) {
+      return default_order;
+    }
+
+    return order;
+  }
+
+  // Compute the peak size of the buffers allocated by the plan for node outputs, given their static sizes.
+  void ComputePlannedPeakBytes() {
+    size_t live_bytes = 0;
+    size_t peak_bytes = 0;
+
+    for (const auto& step : plan_.execution_plan) {
+      const auto* pnode = graph_viewer_.GetNode(step.node_index);
+      for (auto node_output : pnode->OutputDefs()) {
+        if (!node_output->Exists()) continue;
+        AllocKind alloc_kind = AllocPlan(Index(node_output->Name())).alloc_kind;
+        if (alloc_kind == AllocKind::kAllocate || alloc_kind == AllocKind::kAllocateOutput) {
+          live_bytes += GetStaticSizeInBytes(*node_output);
+        }
+      }
+      peak_bytes = std::max(peak_bytes, live_bytes);
+
+      for (int index = step.free_from_index; index <= step.free_to_index; ++index) {
+        auto ml_value_idx = plan_.to_be_freed[index];
+        const NodeArg* p_def_site = ort_value_info_[ml_value_idx].p_def_site;
+        if (AllocPlan(ml_value_idx).alloc_kind == AllocKind::kAllocate && p_def_site != nullptr) {
+          live_bytes -= std::min(live_bytes, GetStaticSizeInBytes(*p_def_site));
+        }
+      }
+    }
+
+    plan_.planned_peak_bytes = peak_bytes;
+  }
+
   //For in-place reuse tensors, the lifetime is the union of all the tensors that tensors that use that buffer
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   void AdjustInplaceLifeIntervals() {
@@ -975,14 +1224,21 @@ class PlannerImpl {
 };  // namespace onnxruntime
 
 Status PlannerImpl::CreatePlan() {
-  auto& p_graph_nodes = graph_viewer_.GetNodesInTopologicalOrder(context_.GetExecutionOrder());
+  // Determine execution order: the memory efficient order is computed from the static sizes of the values,
+  // the other orders only depend on the graph.
+  std::vector<NodeIndex> memory_efficient_order;
+  if (context_.GetExecutionOrder() == ExecutionOrder::MEMORY_EFFICIENT) {
+    memory_efficient_order = ComputeMemoryEfficientOrder(graph_viewer_.GetNodesInTopologicalOrder());
+  }
+
+  auto& p_graph_nodes = context_.GetExecutionOrder() == ExecutionOrder::MEMORY_EFFICIENT
+                            ? memory_efficient_order
+                            : graph_viewer_.GetNodesInTopologicalOrder(context_.GetExecutionOrder());
 
   int num_ml_values = ort_value_name_idx_map_.MaxIdx() + 1;
 
   Initialize(p_graph_nodes.size(), static_cast<size_t>(num_ml_values));
 
-  // Determine execution order: we use the default topological sort order for now. We can later
-  // explore more efficient orderings (from a memory usage perspective).
   for (auto n : p_graph_nodes) {
     plan_.execution_plan.emplace_back(n);
   }
@@ -1009,6 +1265,8 @@ Status PlannerImpl::CreatePlan() {
   // convert information in the freelist_ into a deallocation plan in required format
   GenerateDeallocationPlan();
 
+  ComputePlannedPeakBytes();
+
   // Ensure Memory-Time schedule is valid. This should be called at the end because memory start/end timestamps
   // are updated until GenerateDeallocationPlan is finished.
   VerifyMemoryTimeSchedule();
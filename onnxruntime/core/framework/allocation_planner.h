@@ -30,26 +30,35 @@ class ISequentialPlannerContext {
   virtual bool IsParallelExecutionEnabled() const { return false; }
 
   virtual ExecutionOrder GetExecutionOrder() const { return ExecutionOrder::DEFAULT; }
+
+  // If it returns false, planner won't reuse an input buffer for an output that the kernel declares as
+  // MayInplace. Mandatory aliases (KernelDef::Alias) are always honored.
+  virtual bool IsInplaceReuseEnabled() const { return true; }
 };
 
 class SequentialPlannerContext : public ISequentialPlannerContext {
  public:
-  SequentialPlannerContext(ExecutionMode execution_mode, ExecutionOrder execution_order)
+  SequentialPlannerContext(ExecutionMode execution_mode, ExecutionOrder execution_order,
+                           bool enable_inplace_reuse = true)
       : execution_mode_(execution_mode),
-        exection_order_(execution_order) {
+        exection_order_(execution_order),
+        enable_inplace_reuse_(enable_inplace_reuse) {
   }
 
   const ONNX_NAMESPACE::TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
     return arg.Shape();
   }
 
-  bool IsParallelExecutionEnabled() const override { return execution_mode_ == ExecutionMode::ORT_PARALLEL; }
+  bool IsParallelExecutionEnabled() const override { return execution_mode_ != ExecutionMode::ORT_SEQUENTIAL; }
 
   ExecutionOrder GetExecutionOrder() const override { return exection_order_; }
 
+  bool IsInplaceReuseEnabled() const override { return enable_inplace_reuse_; }
+
  private:
   ExecutionMode execution_mode_ = ExecutionMode::ORT_SEQUENTIAL;
   ExecutionOrder exection_order_ = ExecutionOrder::DEFAULT;
+  bool enable_inplace_reuse_ = true;
 };
 
 class SequentialPlanner {
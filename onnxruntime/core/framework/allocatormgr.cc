@@ -45,17 +45,30 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
         return nullptr;
     }
 
-#ifdef USE_MIMALLOC
-    return std::shared_ptr<IArenaAllocator>(
-        onnxruntime::make_unique<MiMallocArena>(std::move(device_allocator), max_mem));
+    switch (info.arena_cfg.arena_type) {
+      case -1:  // default value supplied by user
+      case static_cast<int>(ArenaType::kBFCArena):
+        break;
+      case static_cast<int>(ArenaType::kMiMallocArena):
+#if defined(USE_MIMALLOC_ARENA_ALLOCATOR)
+        return std::shared_ptr<IArenaAllocator>(
+            onnxruntime::make_unique<MiMallocArena>(std::move(device_allocator), max_mem));
 #else
+        LOGS_DEFAULT(WARNING) << "The mimalloc arena is not enabled in this build. Using the BFC arena.";
+        break;
+#endif
+      default:
+        LOGS_DEFAULT(ERROR) << "Received invalid value of arena_type " << info.arena_cfg.arena_type;
+        return nullptr;
+    }
+
     return std::shared_ptr<IArenaAllocator>(
         onnxruntime::make_unique<BFCArena>(std::move(device_allocator),
                                            max_mem,
                                            arena_extend_str,
                                            initial_chunk_size_bytes,
-                                           max_dead_bytes_per_chunk));
-#endif
+                                           max_dead_bytes_per_chunk,
+                                           info.arena_cfg.max_thread_cache_bytes));
   }
 
   return AllocatorPtr(std::move(device_allocator));
@@ -22,7 +22,7 @@ struct AllocatorCreationInfo {
   AllocatorCreationInfo(AllocatorFactory device_alloc_factory0,
                         OrtDevice::DeviceId device_id0 = 0,
                         bool use_arena0 = true,
-                        OrtArenaCfg arena_cfg0 = {0, -1, -1, -1})
+                        OrtArenaCfg arena_cfg0 = {0, -1, -1, -1, 0, -1})
       : device_alloc_factory(device_alloc_factory0),
         device_id(device_id0),
         use_arena(use_arena0),
@@ -36,7 +36,8 @@ struct AllocatorCreationInfo {
 };
 
 // Returns an allocator based on the creation info provided.
-// Returns nullptr if an invalid value of info.arena_cfg.arena_extend_strategy is supplied.
+// Returns nullptr if an invalid value of info.arena_cfg.arena_extend_strategy or info.arena_cfg.arena_type is
+// supplied. The BFC arena is used if the mimalloc arena is requested but not enabled in this build.
 // Valid values can be found in onnxruntime_c_api.h.
 AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info);
 
@@ -9,6 +9,14 @@
 #include "core/framework/allocator.h"
 
 namespace onnxruntime {
+// The arena implementations that can be selected with OrtArenaCfg::arena_type.
+enum class ArenaType : int32_t {
+  kBFCArena = 0,
+  kMiMallocArena,  // only available if built with USE_MIMALLOC_ARENA_ALLOCATOR
+};
+
+struct AllocatorStats;
+
 // The interface for arena which manage memory allocations
 // Arena will hold a pool of pre-allocate memories and manage their lifecycle.
 // Need an underline IResourceAllocator to allocate memories.
@@ -27,6 +35,11 @@ class IArenaAllocator : public IAllocator {
   void Free(void* p) override = 0;
   virtual size_t Used() const = 0;
   virtual size_t Max() const = 0;
+  // Return the memory that is not in use to the device, keeping enough for the peak usage since the last call.
+  // Shrink call need to be thread safe.
+  virtual Status Shrink() { return Status::OK(); }
+  // Get the statistics of the allocations. Arenas that don't collect them report all zeros.
+  virtual void GetStats(AllocatorStats* stats);
   // allocate host pinned memory?
 };
 
@@ -43,6 +56,13 @@ struct AllocatorStats {
                                   // is known. Certain allocator may return 0 to indicate the limit is
                                   // unknown.
   int64_t bytes_limit;
+  int64_t num_thread_cache_hits;    // Number of allocations served from a thread cache.
+  int64_t num_thread_cache_misses;  // Number of cacheable allocations that had to go to the arena.
+  int64_t thread_cache_bytes;       // Number of bytes currently held in thread caches.
+  int64_t num_shrinks;              // Number of calls to Shrink that changed the arena.
+  int64_t total_released_bytes;     // The total number of bytes returned to the device by Shrink.
+  int64_t largest_free_chunk;       // The size of the largest free chunk, i.e. the largest allocation that can be
+                                    // served without extending the arena. 0 if it is not known.
 
   AllocatorStats() { Clear(); }
 
@@ -53,6 +73,12 @@ struct AllocatorStats {
     this->max_alloc_size = 0;
     this->bytes_limit = 0;
     this->total_allocated_bytes = 0;
+    this->num_thread_cache_hits = 0;
+    this->num_thread_cache_misses = 0;
+    this->thread_cache_bytes = 0;
+    this->num_shrinks = 0;
+    this->total_released_bytes = 0;
+    this->largest_free_chunk = 0;
   }
 
   std::string DebugString() const {
@@ -62,8 +88,16 @@ struct AllocatorStats {
        << "TotalAllocated: " << this->total_allocated_bytes << "\n"
        << "MaxInUse:       " << this->max_bytes_in_use << "\n"
        << "NumAllocs:      " << this->num_allocs << "\n"
-       << "MaxAllocSize:   " << this->max_alloc_size << "\n";
+       << "MaxAllocSize:   " << this->max_alloc_size << "\n"
+       << "ThreadCacheHits:   " << this->num_thread_cache_hits << "\n"
+       << "ThreadCacheMisses: " << this->num_thread_cache_misses << "\n"
+       << "ThreadCacheBytes:  " << this->thread_cache_bytes << "\n"
+       << "NumShrinks:        " << this->num_shrinks << "\n"
+       << "ReleasedBytes:     " << this->total_released_bytes << "\n"
+       << "LargestFreeChunk:  " << this->largest_free_chunk << "\n";
     return ss.str();
   }
 };
+
+inline void IArenaAllocator::GetStats(AllocatorStats* stats) { stats->Clear(); }
 }  // namespace onnxruntime
@@ -3,13 +3,21 @@
 
 #include "core/framework/bfc_arena.h"
 #include <type_traits>
+#include "core/common/trace_sink.h"
 
 namespace onnxruntime {
+
+namespace {
+// ids are never reused so a stale entry in a thread's cache map can't be mistaken for a newer arena
+std::atomic<uint64_t> next_arena_id{1};
+}  // namespace
+
 BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    size_t total_memory,
                    ArenaExtendStrategy arena_extend_strategy,
                    int initial_chunk_size_bytes,
-                   int max_dead_bytes_per_chunk)
+                   int max_dead_bytes_per_chunk,
+                   size_t max_thread_cache_bytes)
     : IArenaAllocator(OrtMemoryInfo(resource_allocator->Info().name,
                                     OrtAllocatorType::OrtArenaAllocator,
                                     resource_allocator->Info().device,
@@ -19,12 +27,15 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       free_chunks_list_(kInvalidChunkHandle),
       next_allocation_id_(1),
       initial_chunk_size_bytes_(initial_chunk_size_bytes),
-      max_dead_bytes_per_chunk_(max_dead_bytes_per_chunk) {
+      max_dead_bytes_per_chunk_(max_dead_bytes_per_chunk),
+      max_thread_cache_bytes_(max_thread_cache_bytes),
+      arena_id_(next_arena_id++) {
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name
                      << " with following configs: initial_chunk_size_bytes: " << initial_chunk_size_bytes_
                      << " max_dead_bytes_per_chunk: " << max_dead_bytes_per_chunk_
                      << " memory limit: " << total_memory
-                     << " arena_extend_strategy " << static_cast<int32_t>(arena_extend_strategy);
+                     << " arena_extend_strategy " << static_cast<int32_t>(arena_extend_strategy)
+                     << " max_thread_cache_bytes: " << max_thread_cache_bytes_;
   // static_cast<std::underlying_type_t<ArenaExtendStrategy>>(arena_extend_strategy); doesn't work on this compiler
 
   curr_region_allocation_bytes_ = RoundedBytes(std::min(total_memory, static_cast<size_t>(initial_chunk_size_bytes_)));
@@ -83,28 +94,6 @@ Status BFCArena::Extend(size_t rounded_bytes) {
                            " is smaller than requested bytes of ", rounded_bytes);
   }
 
-  auto safe_alloc = [this](size_t alloc_bytes) {
-    void* new_mem = nullptr;
-    ORT_TRY {
-      new_mem = device_allocator_->Alloc(alloc_bytes);
-    }
-    ORT_CATCH(const std::bad_alloc&) {
-      // attempted allocation can throw std::bad_alloc. we want to treat this the same as if it returned nullptr
-      // so swallow the exception
-    }
-    ORT_CATCH(const OnnxRuntimeException& ort_exception) {
-      // swallow if exception is our throw from a failed cudaMalloc call.
-      // re-throw otherwise.
-      ORT_HANDLE_EXCEPTION([&ort_exception]() {
-        if (std::string(ort_exception.what()).find("cudaMalloc") == std::string::npos &&
-            std::string(ort_exception.what()).find("hipMalloc") == std::string::npos) {
-          ORT_RETHROW;
-        }
-      });
-    }
-    return new_mem;
-  };
-
   auto get_extend_bytes = [this, available_bytes](const size_t bytes) -> size_t {
     size_t extend_bytes = 0;
     if (arena_extend_strategy_ == ArenaExtendStrategy::kNextPowerOfTwo) {
@@ -138,7 +127,7 @@ Status BFCArena::Extend(size_t rounded_bytes) {
 
   size_t bytes = get_extend_bytes(rounded_bytes);
   // Try allocating.
-  void* mem_addr = safe_alloc(bytes);
+  void* mem_addr = SafeAlloc(bytes);
 
   static constexpr float kBackpedalFactor = 0.9f;
   // Try allocating less memory.
@@ -154,7 +143,7 @@ Status BFCArena::Extend(size_t rounded_bytes) {
     if (bytes < rounded_bytes || bytes < 8 * 1024)
       break;
 
-    mem_addr = safe_alloc(bytes);
+    mem_addr = SafeAlloc(bytes);
   }
 
   if (mem_addr == nullptr) {
@@ -163,7 +152,35 @@ Status BFCArena::Extend(size_t rounded_bytes) {
   }
 
   LOGS_DEFAULT(INFO) << "Extended allocation by " << bytes << " bytes.";
+  tracing::TraceInstant(tracing::Category::kArena, "arena_extend", static_cast<int64_t>(bytes));
+  AddRegion(mem_addr, bytes);
+
+  return Status::OK();
+}
 
+void* BFCArena::SafeAlloc(size_t bytes) {
+  void* new_mem = nullptr;
+  ORT_TRY {
+    new_mem = device_allocator_->Alloc(bytes);
+  }
+  ORT_CATCH(const std::bad_alloc&) {
+    // attempted allocation can throw std::bad_alloc. we want to treat this the same as if it returned nullptr
+    // so swallow the exception
+  }
+  ORT_CATCH(const OnnxRuntimeException& ort_exception) {
+    // swallow if exception is our throw from a failed cudaMalloc call.
+    // re-throw otherwise.
+    ORT_HANDLE_EXCEPTION([&ort_exception]() {
+      if (std::string(ort_exception.what()).find("cudaMalloc") == std::string::npos &&
+          std::string(ort_exception.what()).find("hipMalloc") == std::string::npos) {
+        ORT_RETHROW;
+      }
+    });
+  }
+  return new_mem;
+}
+
+void BFCArena::AddRegion(void* mem_addr, size_t bytes) {
   stats_.total_allocated_bytes += bytes;
   LOGS_DEFAULT(INFO) << "Total allocated bytes: "
                      << stats_.total_allocated_bytes;
@@ -190,8 +207,6 @@ Status BFCArena::Extend(size_t rounded_bytes) {
 
   // Insert the chunk into the right bin.
   InsertFreeChunkIntoBin(h);
-
-  return Status::OK();
 }
 
 BFCArena::ChunkHandle BFCArena::AllocateChunk() {
@@ -222,6 +237,10 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
 }
 
 void* BFCArena::Alloc(size_t size) {
+  if (UseThreadCache(size)) {
+    return AllocateFromThreadCache(size);
+  }
+
   return AllocateRawInternal(size, false);
 }
 
@@ -268,10 +287,13 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   // so all memory addresses are nicely byte aligned.
   size_t rounded_bytes = RoundedBytes(num_bytes);
 
+  std::lock_guard<OrtMutex> lock(lock_);
+  return AllocateRawLocked(rounded_bytes, num_bytes, dump_log_on_failure);
+}
+
+void* BFCArena::AllocateRawLocked(size_t rounded_bytes, size_t num_bytes, bool dump_log_on_failure) {
   // The BFC allocator tries to find the best fit first.
   BinNum bin_num = BinNumForSize(rounded_bytes);
-
-  std::lock_guard<OrtMutex> lock(lock_);
   void* ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
   if (ptr != nullptr) {
     return ptr;
@@ -293,6 +315,15 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
     }
   }
 
+  // Free chunks may be held in the thread caches. Return them to the arena and retry.
+  if (!thread_caches_.empty()) {
+    FlushThreadCachesLocked();
+    ptr = FindChunkPtr(bin_num, rounded_bytes, num_bytes);
+    if (ptr != nullptr) {
+      return ptr;
+    }
+  }
+
   // We searched all bins for an existing free chunk to use and
   // couldn't find one.  This means we must have run out of memory,
   // Dump the memory log for analysis.
@@ -308,6 +339,246 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<OrtMutex> lock(lock_);
   *stats = stats_;
+  stats->num_thread_cache_hits = thread_cache_hits_;
+  stats->num_thread_cache_misses = thread_cache_misses_;
+  stats->thread_cache_bytes = thread_cache_bytes_;
+
+  // the chunks of a bin are sorted by size, so the largest free chunk is the last one of the largest non-empty bin
+  stats->largest_free_chunk = 0;
+  for (BinNum b = kNumBins - 1; b >= 0; --b) {
+    const Bin* bin = BinFromIndex(b);
+    if (!bin->free_chunks.empty()) {
+      stats->largest_free_chunk = static_cast<int64_t>(ChunkFromHandle(*bin->free_chunks.rbegin())->size);
+      break;
+    }
+  }
+}
+
+Status BFCArena::Shrink() {
+  std::lock_guard<OrtMutex> lock(lock_);
+  if (!thread_caches_.empty()) {
+    FlushThreadCachesLocked();
+  }
+
+  const size_t target_bytes = RoundedBytes(peak_chunk_bytes_in_use_);
+  peak_chunk_bytes_in_use_ = chunk_bytes_in_use_;
+
+  size_t region_bytes = 0;
+  size_t free_region_bytes = 0;
+  std::vector<std::pair<void*, size_t>> free_regions;
+  for (const auto& region : region_manager_.regions()) {
+    region_bytes += region.memory_size();
+    const Chunk* c = ChunkFromHandle(region_manager_.get_handle(region.ptr()));
+    if (!c->in_use() && c->size == region.memory_size()) {
+      free_regions.emplace_back(region.ptr(), region.memory_size());
+      free_region_bytes += region.memory_size();
+    }
+  }
+
+  // nothing to do if the arena holds no more than the peak and the free memory isn't split across regions
+  if (free_regions.empty() || (free_regions.size() == 1 && region_bytes <= target_bytes)) {
+    return Status::OK();
+  }
+
+  for (const auto& region : free_regions) {
+    ChunkHandle h = region_manager_.get_handle(region.first);
+    RemoveFreeChunkFromBin(h);
+    DeleteChunk(h);
+    region_manager_.RemoveAllocationRegion(region.first);
+    device_allocator_->Free(region.first);
+    stats_.total_allocated_bytes -= region.second;
+  }
+
+  // the next extension of the arena starts small again
+  curr_region_allocation_bytes_ = RoundedBytes(std::min(memory_limit_, static_cast<size_t>(initial_chunk_size_bytes_)));
+
+  const size_t kept_bytes = region_bytes - free_region_bytes;
+  const size_t new_region_bytes = target_bytes > kept_bytes ? target_bytes - kept_bytes : 0;
+  if (new_region_bytes > 0) {
+    void* mem_addr = SafeAlloc(new_region_bytes);
+    if (mem_addr == nullptr) {
+      // the arena is still usable, it will be extended again when needed
+      stats_.total_released_bytes += static_cast<int64_t>(free_region_bytes);
+      ++stats_.num_shrinks;
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to allocate a region of ", new_region_bytes,
+                             " bytes while shrinking the arena.");
+    }
+
+    AddRegion(mem_addr, new_region_bytes);
+  }
+
+  const size_t released_bytes = free_region_bytes > new_region_bytes ? free_region_bytes - new_region_bytes : 0;
+  stats_.total_released_bytes += static_cast<int64_t>(released_bytes);
+  ++stats_.num_shrinks;
+  LOGS_DEFAULT(INFO) << "Shrank BFCArena for " << device_allocator_->Info().name << " to "
+                     << stats_.total_allocated_bytes << " bytes. Released " << released_bytes << " bytes.";
+
+  return Status::OK();
+}
+
+int BFCArena::ThreadCacheSizeClass(size_t num_bytes) {
+  int size_class = 0;
+  while (ThreadCacheSizeClassBytes(size_class) < num_bytes) {
+    ++size_class;
+  }
+
+  ORT_ENFORCE(size_class < kNumThreadCacheSizeClasses);
+  return size_class;
+}
+
+BFCArena::ThreadCache& BFCArena::GetThreadCache() {
+  // the caches are owned by the arena. the map only provides a lock-free way to find the one for this thread.
+  thread_local std::unordered_map<uint64_t, ThreadCache*> thread_caches;
+
+  auto entry = thread_caches.find(arena_id_);
+  if (entry != thread_caches.end()) {
+    return *entry->second;
+  }
+
+  auto cache = onnxruntime::make_unique<ThreadCache>();
+  ThreadCache* cache_ptr = cache.get();
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    thread_caches_.push_back(std::move(cache));
+  }
+
+  thread_caches[arena_id_] = cache_ptr;
+  return *cache_ptr;
+}
+
+BFCArena::CachedPtrShard& BFCArena::CachedPtrShardFor(const void* p) {
+  const auto addr = reinterpret_cast<uintptr_t>(p) >> kMinAllocationBits;
+  return cached_ptr_shards_[addr % kNumCachedPtrShards];
+}
+
+int BFCArena::FindCachedPtr(const void* p) {
+  auto& shard = CachedPtrShardFor(p);
+  std::lock_guard<OrtMutex> lock(shard.mutex);
+  auto entry = shard.size_classes.find(p);
+  return entry != shard.size_classes.end() ? entry->second : -1;
+}
+
+void* BFCArena::AllocateFromThreadCache(size_t num_bytes) {
+  const int size_class = ThreadCacheSizeClass(num_bytes);
+  const size_t class_bytes = ThreadCacheSizeClassBytes(size_class);
+  ThreadCache& cache = GetThreadCache();
+
+  {
+    std::lock_guard<OrtMutex> cache_lock(cache.mutex);
+    auto& free_list = cache.free_lists[size_class];
+    if (!free_list.empty()) {
+      void* ptr = free_list.back();
+      free_list.pop_back();
+      cache.cached_bytes -= class_bytes;
+      thread_cache_bytes_ -= static_cast<int64_t>(class_bytes);
+      ++thread_cache_hits_;
+      return ptr;
+    }
+  }
+
+  ++thread_cache_misses_;
+
+  // Refill in a batch so the arena lock is taken once for multiple allocations.
+  // Limit the batch so the refill uses at most half of the cache budget.
+  const size_t batch_size = std::max<size_t>(1, std::min(max_thread_cache_bytes_ / (2 * class_bytes),
+                                                         static_cast<size_t>(kThreadCacheBatchSize)));
+  std::vector<void*> ptrs;
+  ptrs.reserve(batch_size);
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    // the first allocation may extend the arena. the others only use chunks that are already free.
+    ptrs.push_back(AllocateRawLocked(class_bytes, class_bytes, false));
+
+    const BinNum bin_num = BinNumForSize(class_bytes);
+    while (ptrs.size() < batch_size) {
+      void* ptr = FindChunkPtr(bin_num, class_bytes, class_bytes);
+      if (ptr == nullptr) {
+        break;
+      }
+
+      ptrs.push_back(ptr);
+    }
+
+    for (void* ptr : ptrs) {
+      auto& shard = CachedPtrShardFor(ptr);
+      std::lock_guard<OrtMutex> shard_lock(shard.mutex);
+      shard.size_classes[ptr] = size_class;
+    }
+  }
+
+  if (ptrs.size() > 1) {
+    std::lock_guard<OrtMutex> cache_lock(cache.mutex);
+    auto& free_list = cache.free_lists[size_class];
+    free_list.insert(free_list.end(), ptrs.begin() + 1, ptrs.end());
+    const size_t added_bytes = (ptrs.size() - 1) * class_bytes;
+    cache.cached_bytes += added_bytes;
+    thread_cache_bytes_ += static_cast<int64_t>(added_bytes);
+  }
+
+  return ptrs.front();
+}
+
+void BFCArena::FreeToThreadCache(void* p, int size_class) {
+  ThreadCache& cache = GetThreadCache();
+  std::vector<void*> to_return;
+
+  {
+    std::lock_guard<OrtMutex> cache_lock(cache.mutex);
+    const size_t class_bytes = ThreadCacheSizeClassBytes(size_class);
+    cache.free_lists[size_class].push_back(p);
+    cache.cached_bytes += class_bytes;
+    thread_cache_bytes_ += static_cast<int64_t>(class_bytes);
+
+    // Over budget. Return chunks, largest first, until the cache is at half its budget so we don't bounce
+    // between the cache and the arena on every free.
+    if (cache.cached_bytes > max_thread_cache_bytes_) {
+      const size_t target_bytes = max_thread_cache_bytes_ / 2;
+      for (int c = kNumThreadCacheSizeClasses - 1; c >= 0 && cache.cached_bytes > target_bytes; --c) {
+        auto& free_list = cache.free_lists[c];
+        const size_t bytes = ThreadCacheSizeClassBytes(c);
+        while (!free_list.empty() && cache.cached_bytes > target_bytes) {
+          to_return.push_back(free_list.back());
+          free_list.pop_back();
+          cache.cached_bytes -= bytes;
+          thread_cache_bytes_ -= static_cast<int64_t>(bytes);
+        }
+      }
+    }
+  }
+
+  // the cache lock must not be held when taking lock_ as FlushThreadCachesLocked acquires them in that order
+  if (!to_return.empty()) {
+    std::lock_guard<OrtMutex> lock(lock_);
+    ReturnThreadCacheChunksLocked(to_return);
+  }
+}
+
+void BFCArena::ReturnThreadCacheChunksLocked(const std::vector<void*>& ptrs) {
+  for (void* ptr : ptrs) {
+    {
+      auto& shard = CachedPtrShardFor(ptr);
+      std::lock_guard<OrtMutex> shard_lock(shard.mutex);
+      shard.size_classes.erase(ptr);
+    }
+
+    DeallocateRawInternal(ptr);
+  }
+}
+
+void BFCArena::FlushThreadCachesLocked() {
+  std::vector<void*> ptrs;
+  for (auto& cache : thread_caches_) {
+    std::lock_guard<OrtMutex> cache_lock(cache->mutex);
+    for (auto& free_list : cache->free_lists) {
+      ptrs.insert(ptrs.end(), free_list.begin(), free_list.end());
+      free_list.clear();
+    }
+
+    thread_cache_bytes_ -= static_cast<int64_t>(cache->cached_bytes);
+    cache->cached_bytes = 0;
+  }
+
+  ReturnThreadCacheChunksLocked(ptrs);
 }
 
 void* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
@@ -330,8 +601,11 @@ void* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
         // If we can break the size of the chunk into two reasonably large
         // pieces, do so.  In any case don't waste more than
         // max_dead_bytes_per_chunk bytes on padding this alloc.
+        // Chunks for the thread caches are always split, as the caches only use the size of their size class and
+        // account for the chunks by that size.
         if (chunk->size >= rounded_bytes * 2 ||
-            static_cast<int64_t>(chunk->size) - static_cast<int64_t>(rounded_bytes) >= max_dead_bytes_per_chunk_) {
+            static_cast<int64_t>(chunk->size) - static_cast<int64_t>(rounded_bytes) >= max_dead_bytes_per_chunk_ ||
+            (chunk->size > rounded_bytes && UseThreadCache(num_bytes))) {
           SplitChunk(h, rounded_bytes);
           chunk = ChunkFromHandle(h);  // Update chunk pointer in case it moved
         }
@@ -345,6 +619,8 @@ void* BFCArena::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
         // Update stats.
         ++stats_.num_allocs;
         stats_.bytes_in_use += chunk->size;
+        chunk_bytes_in_use_ += chunk->size;
+        peak_chunk_bytes_in_use_ = std::max(peak_chunk_bytes_in_use_, chunk_bytes_in_use_);
         stats_.max_bytes_in_use =
             std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
         stats_.max_alloc_size =
@@ -395,6 +671,15 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+
+  if (max_thread_cache_bytes_ != 0) {
+    const int size_class = FindCachedPtr(p);
+    if (size_class != -1) {
+      FreeToThreadCache(p, size_class);
+      return;
+    }
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -491,6 +776,7 @@ void BFCArena::FreeAndMaybeCoalesce(BFCArena::ChunkHandle h) {
 
   // Updates the stats.
   stats_.bytes_in_use -= c->size;
+  chunk_bytes_in_use_ -= c->size;
 
   // This chunk is no longer in-use, consider coalescing the chunk
   // with adjacent chunks.
@@ -16,9 +16,12 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
 #include "onnxruntime_config.h"
 
@@ -56,12 +59,23 @@ class BFCArena : public IArenaAllocator {
   static const int DEFAULT_INITIAL_CHUNK_SIZE_BYTES = 1048576;
   static const int DEFAULT_MAX_DEAD_BYTES_PER_CHUNK = 128 * 1024 * 1024;
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
+  static const size_t DEFAULT_MAX_THREAD_CACHE_BYTES = 0;
 
+  // Allocations larger than this are never served from a thread cache.
+  static const size_t kThreadCacheMaxAllocationSize = 64 * 1024;
+
+  /**
+  @param max_thread_cache_bytes If not 0, each thread that uses the arena gets a cache of free chunks for
+  allocations of up to kThreadCacheMaxAllocationSize, holding at most this many bytes. Cached allocations are
+  served without taking the arena lock. Chunks are moved between the thread caches and the arena in batches.
+  Allocations served from the cache are rounded up to a power of 2.
+  */
   BFCArena(std::unique_ptr<IAllocator> resource_allocator,
            size_t total_memory,
            ArenaExtendStrategy arena_extend_strategy = DEFAULT_ARENA_EXTEND_STRATEGY,
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
-           int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK);
+           int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+           size_t max_thread_cache_bytes = DEFAULT_MAX_THREAD_CACHE_BYTES);
 
   ~BFCArena() override;
 
@@ -88,7 +102,14 @@ class BFCArena : public IArenaAllocator {
     return device_allocator_->CreateFence(session_state);
   }
 
-  void GetStats(AllocatorStats* stats);
+  // Chunks held by the thread caches are included in bytes_in_use, and are also reported in thread_cache_bytes.
+  void GetStats(AllocatorStats* stats) override;
+
+  // Free the regions that have no chunks in use, and replace them with a single region so that the arena holds the
+  // peak number of bytes in use since the last call. The first call after a warmup run consolidates the regions the
+  // arena was extended by during the run, and later calls release memory after the usage dropped.
+  // Free chunks held by the thread caches are returned to the arena first.
+  Status Shrink() override;
 
   size_t RequestedSize(const void* ptr);
 
@@ -96,8 +117,51 @@ class BFCArena : public IArenaAllocator {
 
  private:
   void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure);
+  // Allocate a chunk of at least rounded_bytes. lock_ must be held.
+  void* AllocateRawLocked(size_t rounded_bytes, size_t num_bytes, bool dump_log_on_failure);
   void DeallocateRawInternal(void* ptr);
 
+  static const int kNumThreadCacheSizeClasses = 9;  // 256 bytes to kThreadCacheMaxAllocationSize
+  static const size_t kThreadCacheBatchSize = 8;
+  static const int kNumCachedPtrShards = 16;
+
+  // Free chunks cached for one thread, for each power of 2 size class.
+  // The mutex is only contended if the arena flushes the cache when it runs out of memory.
+  struct ThreadCache {
+    OrtMutex mutex;
+    std::array<std::vector<void*>, kNumThreadCacheSizeClasses> free_lists;
+    size_t cached_bytes = 0;
+  };
+
+  // Map from the pointers owned by the thread caching layer to their size class. A pointer is owned from the time
+  // it is allocated from the arena for a thread cache until it is returned to the arena, including while it is
+  // in use. Sharded to reduce contention.
+  struct CachedPtrShard {
+    OrtMutex mutex;
+    std::unordered_map<const void*, int> size_classes;
+  };
+
+  bool UseThreadCache(size_t num_bytes) const {
+    return max_thread_cache_bytes_ != 0 && num_bytes != 0 && num_bytes <= kThreadCacheMaxAllocationSize;
+  }
+
+  static int ThreadCacheSizeClass(size_t num_bytes);
+  static size_t ThreadCacheSizeClassBytes(int size_class) { return kMinAllocationSize << size_class; }
+
+  ThreadCache& GetThreadCache();
+  void* AllocateFromThreadCache(size_t num_bytes);
+  void FreeToThreadCache(void* p, int size_class);
+
+  CachedPtrShard& CachedPtrShardFor(const void* p);
+  // Returns the size class of p if it is owned by the thread caching layer, or -1 if it isn't.
+  int FindCachedPtr(const void* p);
+
+  // Return the chunks to the arena. lock_ must be held.
+  void ReturnThreadCacheChunksLocked(const std::vector<void*>& ptrs);
+
+  // Return all the chunks in all the thread caches to the arena. lock_ must be held.
+  void FlushThreadCachesLocked();
+
   // A ChunkHandle is an index into the chunks_ vector in BFCAllocator
   // kInvalidChunkHandle means an invalid chunk
   using ChunkHandle = size_t;
@@ -280,6 +344,13 @@ class BFCArena : public IArenaAllocator {
       regions_.insert(entry, AllocationRegion(ptr, memory_size));
     }
 
+    void RemoveAllocationRegion(void* ptr) {
+      auto entry =
+          std::upper_bound(regions_.begin(), regions_.end(), ptr, &Comparator);
+      ORT_ENFORCE(entry != regions_.end() && entry->ptr() == ptr, "Could not find Region for ", ptr);
+      regions_.erase(entry);
+    }
+
     ChunkHandle get_handle(const void* p) const {
       return RegionFor(p)->get_handle(p);
     }
@@ -325,6 +396,12 @@ class BFCArena : public IArenaAllocator {
   // 'rounded_bytes' bytes.
   Status Extend(size_t rounded_bytes);
 
+  // Allocate from the device allocator, returning nullptr if it fails.
+  void* SafeAlloc(size_t bytes);
+
+  // Add the device memory at mem_addr as a new region containing one free chunk.
+  void AddRegion(void* mem_addr, size_t bytes);
+
   // Returns a pointer to an underlying allocated chunk of size
   // 'rounded_bytes'.
   void* FindChunkPtr(BinNum bin_num, size_t rounded_bytes, size_t num_bytes);
@@ -448,9 +525,24 @@ class BFCArena : public IArenaAllocator {
 
   std::unordered_map<void*, size_t> reserved_chunks_;
 
+  // Bytes of the chunks in use, which unlike stats_.bytes_in_use excludes the reserved chunks, and its peak since
+  // the last call to Shrink.
+  size_t chunk_bytes_in_use_ = 0;
+  size_t peak_chunk_bytes_in_use_ = 0;
+
   const int initial_chunk_size_bytes_;
   const int max_dead_bytes_per_chunk_;
 
+  // thread caching. disabled if max_thread_cache_bytes_ is 0.
+  const size_t max_thread_cache_bytes_;
+  // unique id used to find the thread caches for this instance in thread local storage.
+  const uint64_t arena_id_;
+  std::vector<std::unique_ptr<ThreadCache>> thread_caches_;  // protected by lock_
+  std::array<CachedPtrShard, kNumCachedPtrShards> cached_ptr_shards_;
+  std::atomic<int64_t> thread_cache_hits_{0};
+  std::atomic<int64_t> thread_cache_misses_{0};
+  std::atomic<int64_t> thread_cache_bytes_{0};
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BFCArena);
 };
 #ifdef __GNUC__
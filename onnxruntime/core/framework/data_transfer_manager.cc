@@ -3,6 +3,8 @@
 
 #include "core/framework/data_transfer_manager.h"
 
+#include <algorithm>
+
 namespace onnxruntime {
 using namespace common;
 
@@ -54,48 +56,40 @@ common::Status DataTransferManager::CopyTensors(const std::vector<IDataTransfer:
   if (src_dst_pairs.empty())
     return Status::OK();
 
-  const auto& first_pair = src_dst_pairs.front();
-  const OrtDevice& src_device = first_pair.src.get().Location().device;
-  const OrtDevice& dst_device = first_pair.dst.get().Location().device;
-
-  bool all_same = std::all_of(src_dst_pairs.cbegin() + 1, src_dst_pairs.cend(),
-                              [&src_device, &dst_device](const IDataTransfer::SrcDstPair& pair) {
-                                return pair.src.get().Location().device == src_device &&
-                                       pair.dst.get().Location().device == dst_device;
-                              });
-
-  IDataTransfer* first_dt = nullptr;
-
-  for (auto& data_transfer : datatransfers_) {
-    if (data_transfer->CanCopy(src_device, dst_device)) {
-      first_dt = data_transfer.get();
-      break;
+  // group the copies by the IDataTransfer that does them, keeping their order, so that each IDataTransfer can issue
+  // its copies as one batch, e.g. asynchronously, even when the copies are between a mix of devices.
+  std::vector<std::pair<const IDataTransfer*, std::vector<IDataTransfer::SrcDstPair>>> batches;
+  for (const auto& pair : src_dst_pairs) {
+    const OrtDevice& src_device = pair.src.get().Location().device;
+    const OrtDevice& dst_device = pair.dst.get().Location().device;
+    const IDataTransfer* data_transfer = GetDataTransfer(src_device, dst_device);
+    if (data_transfer == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME,
+                             FAIL,
+                             "There's no data transfer registered for copying tensors from ",
+                             src_device.ToString(),
+                             " to ",
+                             dst_device.ToString());
     }
-  }
 
-  if (first_dt == nullptr) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME,
-                           FAIL,
-                           "There's no data transfer registered for copying tensors from ",
-                           src_device.ToString(),
-                           " to ",
-                           dst_device.ToString());
-  }
+    if (pair.src.get().Shape().Size() != pair.dst.get().Shape().Size()) {
+      return Status(ONNXRUNTIME, FAIL, "Tensor size mismatch");
+    }
 
-  // all copies are between the same devices so we can do them all at once
-  if (all_same) {
-    return first_dt->CopyTensors(src_dst_pairs);
+    auto batch = std::find_if(batches.begin(), batches.end(),
+                              [data_transfer](const std::pair<const IDataTransfer*,
+                                                              std::vector<IDataTransfer::SrcDstPair>>& entry) {
+                                return entry.first == data_transfer;
+                              });
+    if (batch == batches.end()) {
+      batches.emplace_back(data_transfer, std::vector<IDataTransfer::SrcDstPair>{});
+      batch = batches.end() - 1;
+    }
+    batch->second.push_back(pair);
   }
 
-  // there are a mix of devices requiring copies. we don't expect this to happen, so just iterate the pairs
-  // copying one at a time. if this becomes expected we could create a list for each IDataTransfer instance so we
-  // batch as much as possible.
-
-  // copy the first one as we already did the IDataTransfer lookup
-  ORT_RETURN_IF_ERROR(first_dt->CopyTensor(first_pair.src.get(), first_pair.dst.get(), first_pair.exec_queue_id));
-
-  for (auto cur_pair = src_dst_pairs.cbegin() + 1, end_pair = src_dst_pairs.cend(); cur_pair != end_pair; ++cur_pair) {
-    ORT_RETURN_IF_ERROR(CopyTensor(cur_pair->src, cur_pair->dst, cur_pair->exec_queue_id));
+  for (const auto& batch : batches) {
+    ORT_RETURN_IF_ERROR(batch.first->CopyTensors(batch.second));
   }
 
   return Status::OK();
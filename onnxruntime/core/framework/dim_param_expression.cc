@@ -0,0 +1,217 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/dim_param_expression.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace onnxruntime {
+
+namespace {
+
+// Recursive descent parser that evaluates the expression while parsing it.
+//
+//   expression := term (('+' | '-') term)*
+//   term       := unary (('*' | '/') unary)*
+//   unary      := ('+' | '-') unary | power
+//   power      := primary ('**' unary)?
+//   primary    := number | name | name '(' expression (',' expression)* ')' | '(' expression ')'
+//
+// Values are evaluated as doubles so that sympy style expressions like "floor(seq/2)" or "floor(0.5*seq)" work.
+// This is exact for the magnitudes of tensor dimensions.
+class DimParamExpressionEvaluator {
+ public:
+  DimParamExpressionEvaluator(const std::string& expression, const std::unordered_map<std::string, int64_t>& values)
+      : expression_(expression), values_(values) {}
+
+  Status Evaluate(double& result) {
+    ORT_RETURN_IF_ERROR(ParseExpression(result));
+    SkipSpaces();
+    ORT_RETURN_IF_NOT(pos_ == expression_.size(), "Unexpected character at position ", pos_,
+                      " in dim_param expression '", expression_, "'");
+    return Status::OK();
+  }
+
+ private:
+  void SkipSpaces() {
+    while (pos_ < expression_.size() && std::isspace(static_cast<unsigned char>(expression_[pos_]))) {
+      ++pos_;
+    }
+  }
+
+  // Consumes token if it's next in the expression.
+  bool Accept(const char* token) {
+    SkipSpaces();
+    const size_t length = std::char_traits<char>::length(token);
+    if (expression_.compare(pos_, length, token) == 0) {
+      pos_ += length;
+      return true;
+    }
+
+    return false;
+  }
+
+  Status ParseExpression(double& result) {
+    ORT_RETURN_IF_ERROR(ParseTerm(result));
+    for (;;) {
+      double rhs;
+      if (Accept("+")) {
+        ORT_RETURN_IF_ERROR(ParseTerm(rhs));
+        result += rhs;
+      } else if (Accept("-")) {
+        ORT_RETURN_IF_ERROR(ParseTerm(rhs));
+        result -= rhs;
+      } else {
+        return Status::OK();
+      }
+    }
+  }
+
+  Status ParseTerm(double& result) {
+    ORT_RETURN_IF_ERROR(ParseUnary(result));
+    for (;;) {
+      double rhs;
+      // '**' is the power operator so it must not be mistaken for a multiplication
+      SkipSpaces();
+      if (expression_.compare(pos_, 2, "**") != 0 && Accept("*")) {
+        ORT_RETURN_IF_ERROR(ParseUnary(rhs));
+        result *= rhs;
+      } else if (Accept("/")) {
+        ORT_RETURN_IF_ERROR(ParseUnary(rhs));
+        ORT_RETURN_IF(rhs == 0, "Division by zero in dim_param expression '", expression_, "'");
+        result /= rhs;
+      } else {
+        return Status::OK();
+      }
+    }
+  }
+
+  Status ParseUnary(double& result) {
+    if (Accept("-")) {
+      ORT_RETURN_IF_ERROR(ParseUnary(result));
+      result = -result;
+      return Status::OK();
+    }
+
+    if (Accept("+")) {
+      return ParseUnary(result);
+    }
+
+    return ParsePower(result);
+  }
+
+  Status ParsePower(double& result) {
+    ORT_RETURN_IF_ERROR(ParsePrimary(result));
+    if (Accept("**")) {
+      double exponent;
+      ORT_RETURN_IF_ERROR(ParseUnary(exponent));
+      result = std::pow(result, exponent);
+    }
+
+    return Status::OK();
+  }
+
+  Status ParsePrimary(double& result) {
+    SkipSpaces();
+    ORT_RETURN_IF(pos_ == expression_.size(), "Unexpected end of dim_param expression '", expression_, "'");
+
+    if (Accept("(")) {
+      ORT_RETURN_IF_ERROR(ParseExpression(result));
+      ORT_RETURN_IF_NOT(Accept(")"), "Missing ')' in dim_param expression '", expression_, "'");
+      return Status::OK();
+    }
+
+    const char c = expression_[pos_];
+    if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+      const char* begin = expression_.c_str() + pos_;
+      char* end = nullptr;
+      result = std::strtod(begin, &end);
+      ORT_RETURN_IF(end == begin, "Invalid number at position ", pos_, " in dim_param expression '", expression_, "'");
+      pos_ += static_cast<size_t>(end - begin);
+      return Status::OK();
+    }
+
+    ORT_RETURN_IF_NOT(std::isalpha(static_cast<unsigned char>(c)) || c == '_',
+                      "Unexpected character at position ", pos_, " in dim_param expression '", expression_, "'");
+    const size_t begin = pos_;
+    while (pos_ < expression_.size() &&
+           (std::isalnum(static_cast<unsigned char>(expression_[pos_])) || expression_[pos_] == '_')) {
+      ++pos_;
+    }
+
+    const std::string name = expression_.substr(begin, pos_ - begin);
+    if (Accept("(")) {
+      return ParseFunction(name, result);
+    }
+
+    auto it = values_.find(name);
+    ORT_RETURN_IF(it == values_.end(), "Unknown symbolic dimension '", name, "' in dim_param expression '",
+                  expression_, "'");
+    result = static_cast<double>(it->second);
+    return Status::OK();
+  }
+
+  // Parses the arguments of a function call after the opening parenthesis and applies the function.
+  Status ParseFunction(const std::string& name, double& result) {
+    std::vector<double> args;
+    do {
+      double arg;
+      ORT_RETURN_IF_ERROR(ParseExpression(arg));
+      args.push_back(arg);
+    } while (Accept(","));
+    ORT_RETURN_IF_NOT(Accept(")"), "Missing ')' after the arguments of ", name, " in dim_param expression '",
+                      expression_, "'");
+
+    const size_t num_args = args.size();
+    if (name == "floor" && num_args == 1) {
+      result = std::floor(args[0]);
+    } else if (name == "ceiling" && num_args == 1) {
+      result = std::ceil(args[0]);
+    } else if (name == "Max") {
+      result = *std::max_element(args.begin(), args.end());
+    } else if (name == "Min") {
+      result = *std::min_element(args.begin(), args.end());
+    } else if (name == "Mod" && num_args == 2) {
+      ORT_RETURN_IF(args[1] == 0, "Division by zero in dim_param expression '", expression_, "'");
+      // sympy uses the sign of the divisor like Python
+      result = args[0] - args[1] * std::floor(args[0] / args[1]);
+    } else {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported function ", name, " with ", num_args,
+                             " arguments in dim_param expression '", expression_, "'");
+    }
+
+    return Status::OK();
+  }
+
+  const std::string& expression_;
+  const std::unordered_map<std::string, int64_t>& values_;
+  size_t pos_{0};
+};
+
+}  // namespace
+
+Status EvaluateDimParam(const std::string& dim_param, const std::unordered_map<std::string, int64_t>& values,
+                        int64_t& result) {
+  auto it = values.find(dim_param);
+  if (it != values.end()) {
+    result = it->second;
+    return Status::OK();
+  }
+
+  double value = 0;
+  ORT_RETURN_IF_ERROR(DimParamExpressionEvaluator(dim_param, values).Evaluate(value));
+
+  const double rounded = std::round(value);
+  ORT_RETURN_IF_NOT(std::abs(value - rounded) <= 1e-6 * std::max(1.0, std::abs(value)) && rounded >= 0 &&
+                        rounded < 9007199254740992.0,  // 2^53
+                    "dim_param expression '", dim_param, "' evaluated to ", value,
+                    " which is not a valid dimension value");
+  result = static_cast<int64_t>(rounded);
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
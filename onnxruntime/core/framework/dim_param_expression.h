@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+/**
+ * Evaluates a symbolic dimension given the values of the dim_params bound from the graph inputs.
+ *
+ * A dim_param can be a plain name, or an arithmetic expression over other dim_params as written by the symbolic
+ * shape inference tool (onnxruntime/python/tools/symbolic_shape_infer.py), e.g. "batch*seq", "seq + 1" or
+ * "floor((seq - 1)/2) + 1". This allows the shapes of intermediate values to be resolved when the input shapes of
+ * a run are known, so the memory pattern can be computed before the first execution with those shapes.
+ *
+ * Supported are integer and decimal literals, names, the operators + - * / ** and parentheses, and the functions
+ * floor, ceiling, Max, Min and Mod. A name is looked up in values before the expression is parsed, so names
+ * containing other characters are fine as long as they aren't part of an expression.
+ *
+ * Returns an error if the expression is malformed, references a name without a value, or doesn't evaluate to a
+ * non-negative integer.
+ */
+Status EvaluateDimParam(const std::string& dim_param, const std::unordered_map<std::string, int64_t>& values,
+                        int64_t& result);
+
+}  // namespace onnxruntime
@@ -6,6 +6,7 @@
 #include <sstream>
 
 #include "core/framework/mem_pattern_planner.h"
+#include "core/framework/memory_profiler.h"
 #include "core/framework/execution_plan_base.h"
 #include "core/framework/sequential_execution_plan.h"
 #include "core/framework/ort_value_pattern_planner.h"
@@ -76,6 +77,40 @@ Status IExecutionFrame::GetOrCreateNodeOutputMLValue(int index, const TensorShap
   return status;
 }
 
+Status IExecutionFrame::TryCreateNodeOutputMLValueView(int index, int source_index, const TensorShape& shape,
+                                                       ptrdiff_t byte_offset, OrtValue*& p_ort_value) {
+  p_ort_value = nullptr;
+  int ort_value_idx = GetNodeIdxToMLValueIdx(index);
+  int source_ort_value_idx = GetNodeIdxToMLValueIdx(source_index);
+
+  if (ort_value_idx == NodeIndexInfo::kInvalidEntry || source_ort_value_idx == NodeIndexInfo::kInvalidEntry ||
+      !IsViewAllowed(ort_value_idx)) {
+    return Status::OK();
+  }
+
+  OrtValue& ort_value = all_values_[ort_value_idx];
+  if (ort_value.IsAllocated()) {
+    // e.g. the output was provided by the caller
+    return Status::OK();
+  }
+
+  const Tensor& source = GetMLValue(source_ort_value_idx).Get<Tensor>();
+  ORT_RETURN_IF_NOT(byte_offset >= 0 &&
+                        static_cast<size_t>(byte_offset) + shape.Size() * source.DataType()->Size() <=
+                            source.SizeInBytes(),
+                    "The view of shape ", shape, " at byte offset ", byte_offset,
+                    " is out of the bounds of its source of shape ", source.Shape());
+
+  // the allocation plan keeps the buffer of the source alive for as long as the view
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  auto p_tensor = onnxruntime::make_unique<Tensor>(source.DataType(), shape, const_cast<void*>(source.DataRaw()),
+                                                   source.Location(), byte_offset);
+  ort_value.Init(p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+
+  p_ort_value = &ort_value;
+  return Status::OK();
+}
+
 bool IExecutionFrame::TryGetInferredShape(int /*index*/, TensorShape& /*shape*/) const {
   // By default, there is not information about inferred shape, so this default
   // implementation always returns false. The derived class of IExecutionFrame
@@ -217,6 +252,10 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
   MemoryInfo::IncreaseIteration();
 #endif
 
+  if (session_state.IsMemoryProfilingEnabled() && session_state.Profiler().IsEnabled()) {
+    memory_profiler_ = onnxruntime::make_unique<MemoryProfiler>(session_state);
+  }
+
   // map the custom allocators to ort_value_idx entries
   if (!fetch_allocators.empty()) {
     for (size_t idx = 0, end = fetch_mlvalue_idxs.size(); idx < end; ++idx) {
@@ -229,6 +268,17 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
     }
   }
 
+  if (session_state.GetSmallTensorSlabBytes() > 0) {
+    AllocatorPtr alloc = GetAllocator(session_state.GetExecutionProviders().GetDefaultCpuMemoryInfo());
+    void* slab = alloc->Alloc(session_state.GetSmallTensorSlabBytes());
+    if (slab != nullptr) {
+      small_tensor_slab_ = BufferUniquePtr(slab, alloc);
+      small_tensor_slab_location_ = &alloc->Info();
+      small_tensor_slab_bytes_ = session_state.GetSmallTensorSlabBytes();
+      small_tensor_max_bytes_ = session_state.GetSmallTensorMaxBytes();
+    }
+  }
+
   // If the session enable memory pattern optimization
   // and we have execution plan generated, try to setup
   // memory pattern optimization.
@@ -316,6 +366,17 @@ ExecutionFrame::ExecutionFrame(const std::vector<int>& feed_mlvalue_idxs, const
 
 ExecutionFrame::~ExecutionFrame() = default;
 
+void* ExecutionFrame::AllocateFromSmallTensorSlab(size_t size) {
+  // the offset keeps growing once the slab is full, so a small tensor that would still fit may be allocated
+  // individually. it can't overflow as the sizes are limited to small_tensor_max_bytes_.
+  const size_t offset = small_tensor_slab_offset_.fetch_add(size, std::memory_order_relaxed);
+  if (offset + size > small_tensor_slab_bytes_) {
+    return nullptr;
+  }
+
+  return static_cast<char*>(small_tensor_slab_.get()) + offset;
+}
+
 Status ExecutionFrame::CopyTensor(const Tensor& src, Tensor& dest) const {
   return session_state_.GetDataTransferMgr().CopyTensor(src, dest);
 }
@@ -372,8 +433,10 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
       if (block) {
         auto it = buffers_.find(location);
         if (it != buffers_.end()) {
-          // if the block is not correct, log message then fall back to default behavior
-          if (block->size_ == size) {
+          // if the block is not correct, log message then fall back to default behavior.
+          // a pattern shared by a bucket of input shapes may have been traced with larger shapes, so any block
+          // that is large enough can be used in that case.
+          if (block->size_ == size || (session_state_.IsMemoryPatternCacheBucketed() && block->size_ >= size)) {
             void* buffer = it->second.get();
             auto status = AllocateTensorWithPreAllocateBufferHelper(
                 ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
@@ -388,6 +451,15 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
                                                    << ", block in memory pattern size is: " << block->size_
                                                    << " but the actually size is: " << size
                                                    << ", fall back to default allocation behavior";
+            if (session_state_.IsMemoryPatternCacheBucketed() && block->size_ < size) {
+              mem_pattern_needs_regeneration_ = true;
+            }
+
+            // the shapes in the graph don't match the actual shapes, so trace the patterns from now on
+            if (mem_patterns_->from_graph_shapes) {
+              session_state_.DisableMemoryPatternsFromGraphShapes();
+              mem_pattern_needs_regeneration_ = true;
+            }
           }
         }
         // else { we couldn't allocate the large block for the buffer so we didn't insert an entry }
@@ -395,6 +467,17 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
     }
   }
 
+  // small intermediate tensors on CPU are allocated from the slab, as they don't outlive the execution.
+  // string tensors are excluded as the strings need to be constructed and destroyed.
+  if (small_tensor_slab_ && size != 0 && size <= small_tensor_max_bytes_ && !create_fence &&
+      per_alloc_plan.alloc_kind != AllocKind::kAllocateOutput && location == *small_tensor_slab_location_ &&
+      !utils::IsDataTypeString(element_type)) {
+    void* buffer = AllocateFromSmallTensorSlab(size);
+    if (buffer != nullptr) {
+      return AllocateTensorWithPreAllocateBufferHelper(ort_value, buffer, element_type, location, shape);
+    }
+  }
+
   //no memory pattern, or the pattern is not correct.
   if (!alloc) alloc = GetAllocator(location);
   std::unique_ptr<Tensor> p_tensor = onnxruntime::make_unique<Tensor>(element_type, shape, alloc);
@@ -438,21 +521,25 @@ Status ExecutionFrame::AllocateMLValueTensorPreAllocateBuffer(OrtValue& ort_valu
   if (buffer_num_elements != required_num_elements) {
     // could be an allocation planner bug (less likely) or the model incorrectly uses something like 'None'
     // as a dim_param, or -1 in dim_value in multiple places making the planner think those shapes are equal.
-    auto message = onnxruntime::MakeString(
-        "Shape mismatch attempting to re-use buffer. ",
-        reuse_tensor->Shape(), " != ", shape,
-        ". Validate usage of dim_value (values should be > 0) and "
-        "dim_param (all values with the same string should equate to the same size) in shapes in the model.");
+    // the message is only formatted if it is used, as a reused buffer that is larger is expected with some models
+    // and happens on every execution
+    auto make_message = [&]() {
+      return onnxruntime::MakeString(
+          "Shape mismatch attempting to re-use buffer. ",
+          reuse_tensor->Shape(), " != ", shape,
+          ". Validate usage of dim_value (values should be > 0) and "
+          "dim_param (all values with the same string should equate to the same size) in shapes in the model.");
+    };
 
     // be generous and use the buffer if it's large enough. log a warning though as it indicates a bad model
     if (buffer_num_elements >= required_num_elements) {
       // View Operator is reusing the buffer bigger than the required size.
       // Disabling warning message for now. The op is in the process of being deprecated.
 #ifndef ENABLE_TRAINING
-      LOGS(session_state_.Logger(), WARNING) << message;
+      LOGS(session_state_.Logger(), WARNING) << make_message();
 #endif
     } else {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, message);
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, make_message());
     }
   }
 
@@ -536,6 +623,10 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_
     bool allocated = false;
     // see if custom allocator can handle allocation
     auto status = (custom_alloc_entry->second)(*shape, alloc_info, ort_value, allocated);
+    if (allocated && status.IsOK() && memory_profiler_ && ort_value.IsTensor()) {
+      const auto& tensor = ort_value.Get<Tensor>();
+      memory_profiler_->RecordAllocation(ort_value_index, tensor.Location(), tensor.SizeInBytes());
+    }
     if (allocated || !status.IsOK())
       return status;
   }
@@ -587,6 +678,12 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_
     MemoryInfo::RecordActivationAllocInfo(ort_value_index, ort_value);
 #endif
 
+    if (memory_profiler_) {
+      const bool owns_buffer = alloc_kind == AllocKind::kAllocate || alloc_kind == AllocKind::kAllocateOutput;
+      memory_profiler_->RecordAllocation(ort_value_index, alloc_info,
+                                         owns_buffer ? ort_value.Get<Tensor>().SizeInBytes() : 0);
+    }
+
     return Status::OK();
   } else if (ml_type->IsSparseTensorType()) {
     return AllocateSparseTensor(ort_value, *ml_type, GetAllocator(alloc_info),
@@ -602,6 +699,14 @@ AllocatorPtr ExecutionFrame::GetAllocatorImpl(const OrtMemoryInfo& info) const {
   return session_state_.GetAllocator(info);
 }
 
+bool ExecutionFrame::IsViewAllowed(int ort_value_idx) const {
+  const SequentialExecutionPlan* p_seq_exec_plan = session_state_.GetExecutionPlan();
+  const auto& alloc_plan = p_seq_exec_plan->allocation_plan;
+  ORT_ENFORCE(ort_value_idx >= 0 && static_cast<size_t>(ort_value_idx) < alloc_plan.size());
+  return alloc_plan[ort_value_idx].may_be_view && !IsOutput(ort_value_idx) &&
+         custom_allocators_.find(ort_value_idx) == custom_allocators_.cend();
+}
+
 // This method is not thread safe!
 // Return S_OK and nullptr if index map to an value that is an unused optional input/output
 Status ExecutionFrame::CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_value_idx,
@@ -612,6 +717,9 @@ Status ExecutionFrame::CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_
 Status ExecutionFrame::ReleaseMLValueImpl(int ort_value_idx) {
   ORT_RETURN_IF_ERROR(IExecutionFrame::ReleaseMLValueImpl(ort_value_idx));
   TraceFree(ort_value_idx);
+  if (memory_profiler_) {
+    memory_profiler_->RecordRelease(ort_value_idx);
+  }
   return Status::OK();
 }
 
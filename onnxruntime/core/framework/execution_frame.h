@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <vector>
 #include <unordered_map>
@@ -19,6 +20,7 @@
 
 namespace onnxruntime {
 
+class MemoryProfiler;
 class SessionState;
 class OrtValueNameIdxMap;
 class OrtValuePatternPlanner;
@@ -55,6 +57,12 @@ class IExecutionFrame {
   // Shape is required for tensors but not traditional ML values.
   Status GetOrCreateNodeOutputMLValue(int index, const TensorShape* shape, OrtValue*& p_ort_value, size_t nnz = 0);
 
+  // Create the output value at `index` as a tensor of `shape` viewing the data of the tensor at `source_index`
+  // from `byte_offset` bytes onwards, if the allocation plan allows the output to be a view.
+  // Return S_OK and nullptr otherwise, in which case the output must be created by GetOrCreateNodeOutputMLValue.
+  Status TryCreateNodeOutputMLValueView(int index, int source_index, const TensorShape& shape, ptrdiff_t byte_offset,
+                                        OrtValue*& p_ort_value);
+
   // This function try retrieve the inferred shapes for the given NodeArg index.
   // If the retrival is sucessful, this function returns true and false otherwise.
   virtual bool TryGetInferredShape(int index, TensorShape& shape) const;
@@ -95,6 +103,9 @@ class IExecutionFrame {
 
   virtual Status CopyTensor(const Tensor& src, Tensor& dest) const = 0;
 
+  // returns true if the allocation plan allows the value to be created as a view of another value
+  virtual bool IsViewAllowed(int /*ort_value_idx*/) const { return false; }
+
   const NodeIndexInfo& node_index_info_;
 
   // All the intermediate values for the entire graph.
@@ -135,10 +146,20 @@ class ExecutionFrame final : public IExecutionFrame {
     return planner_ != nullptr;
   }
 
+  // Returns true if a block in a memory pattern from a bucketed cache entry was too small for a tensor, or a block in
+  // a memory pattern computed from the shapes in the graph didn't match the size of its tensor. In either case the
+  // cached pattern should be re-generated using the current input shapes.
+  bool MemoryPatternNeedsRegeneration() const {
+    return mem_pattern_needs_regeneration_.load();
+  }
+
   // This function try retrieve the inferred shapes for the given NodeArg index.
   // If the retrival is sucessful, this function returns true and false otherwise.
   bool TryGetInferredShape(int index, TensorShape& shape) const override;
 
+  // Returns the recorder of the memory usage of this execution, or nullptr if memory profiling is disabled.
+  MemoryProfiler* GetMemoryProfiler() const { return memory_profiler_.get(); }
+
   // Return the size of virtual memory allocated in runtime.
   // The memory is usually used for activations in forward and backward passes.
   const std::unordered_map<std::string, size_t>& GetDynamicMemorySizeInfo() {
@@ -166,6 +187,7 @@ class ExecutionFrame final : public IExecutionFrame {
   Status ReleaseMLValueImpl(int ort_value_idx) override;
   Status CreateNodeOutputMLValueImpl(OrtValue& ort_value, int ort_value_idx, const TensorShape* shape, size_t nnz) override;
   Status CopyTensor(const Tensor& src, Tensor& dest) const override;
+  bool IsViewAllowed(int ort_value_idx) const override;
 
   common::Status AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_value_index, const TensorShape* shape,
                                              size_t nnz);
@@ -177,6 +199,9 @@ class ExecutionFrame final : public IExecutionFrame {
   Status AllocateTensorWithPreAllocateBufferHelper(OrtValue& ort_value, void* pBuffer, MLDataType element_type,
                                                    const OrtMemoryInfo& location, const TensorShape& shape);
 
+  // Returns a buffer of size bytes from the small tensor slab, or nullptr if the slab is full. Thread-safe.
+  void* AllocateFromSmallTensorSlab(size_t size);
+
   void TraceAllocate(int ort_value_idx, size_t size);
   void TraceFree(int ort_value_idx);
 
@@ -190,7 +215,12 @@ class ExecutionFrame final : public IExecutionFrame {
   // If we already have cached memory pattern on these input shapes
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
-  const MemoryPatternGroup* mem_patterns_;
+  std::shared_ptr<const MemoryPatternGroup> mem_patterns_;
+
+  // Set if a block from a bucketed memory pattern was smaller than the tensor being allocated, or a block from a
+  // memory pattern computed from the shapes in the graph didn't match the size of the tensor being allocated.
+  // Atomic as the parallel executor may allocate from multiple threads.
+  std::atomic<bool> mem_pattern_needs_regeneration_{false};
 
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
@@ -199,6 +229,14 @@ class ExecutionFrame final : public IExecutionFrame {
   // Big chunks on different locations that will be used by mem_pattern.
   std::map<OrtMemoryInfo, BufferUniquePtr> buffers_;
 
+  // Slab the small intermediate tensors on CPU are allocated from, if enabled by the session options.
+  // The tensors are not freed individually. The slab is freed with the frame at the end of the execution.
+  BufferUniquePtr small_tensor_slab_;
+  const OrtMemoryInfo* small_tensor_slab_location_ = nullptr;  // owned by the allocator of the slab
+  size_t small_tensor_slab_bytes_ = 0;
+  size_t small_tensor_max_bytes_ = 0;
+  std::atomic<size_t> small_tensor_slab_offset_{0};
+
   // Given the input shapes of the executed graph, ExecutionFrame tries inferring
   // all symbolic shapes. inferred_shapes_[i] is the shape of OrtValue indexed
   // by i, if the key i exists.
@@ -216,6 +254,9 @@ class ExecutionFrame final : public IExecutionFrame {
   // dynamic_activation_memory_sizes_in_byte_[location] is the dynamic memory consumption on "location".
   std::unordered_map<std::string, size_t> dynamic_activation_memory_sizes_in_byte_;
 
+  // Set if the session profiler is enabled and memory profiling is enabled in the session options.
+  std::unique_ptr<MemoryProfiler> memory_profiler_;
+
   // Mutex which should be acquired when executing non-thread-safe member functions.
   // A current example is the tracker of dynamic memory allocation.
   mutable std::mutex mtx_;
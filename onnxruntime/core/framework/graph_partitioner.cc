@@ -4,6 +4,11 @@
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
 #include "core/framework/graph_partitioner.h"
+
+#include <map>
+#include <unordered_set>
+
+#include "core/common/logging/logging.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/graph/function.h"
 #include "core/graph/graph_viewer.h"
@@ -362,6 +367,159 @@ static Status InlineNodes(Graph& graph, bool& modified_graph) {
   return Status::OK();
 }
 
+// Counts the values that are copied between devices at the boundary of the island if all of its nodes are run by
+// provider_type. Initializers are not counted as they are copied to the device once when the session is created.
+// Inputs and outputs of the main graph are located on CPU.
+static size_t CountIslandCopies(const Graph& graph, const std::unordered_set<NodeIndex>& island,
+                                const std::string& provider_type) {
+  std::unordered_set<const NodeArg*> copied_inputs;
+  size_t copies = 0;
+
+  for (auto index : island) {
+    const Node& node = *graph.GetNode(index);
+
+    for (const auto* input : node.InputDefs()) {
+      if (!input->Exists()) {
+        continue;
+      }
+
+      std::string location;
+      const Node* producer = graph.GetProducerNode(input->Name());
+      if (producer != nullptr) {
+        if (island.count(producer->Index()) != 0) {
+          continue;
+        }
+        location = producer->GetExecutionProviderType();
+      } else if (graph.IsInitializedTensor(input->Name()) || graph.IsSubgraph()) {
+        continue;
+      } else {
+        location = kCpuExecutionProvider;
+      }
+
+      if (location != provider_type && copied_inputs.insert(input).second) {
+        ++copies;
+      }
+    }
+
+    for (const auto* output : node.OutputDefs()) {
+      if (!output->Exists()) {
+        continue;
+      }
+
+      // the value is copied once for each other device it is consumed on
+      std::unordered_set<std::string> consumer_locations;
+      for (const auto* consumer : graph.GetConsumerNodes(output->Name())) {
+        if (island.count(consumer->Index()) == 0) {
+          consumer_locations.insert(consumer->GetExecutionProviderType());
+        }
+      }
+      if (!graph.IsSubgraph() && graph.IsOutput(output)) {
+        consumer_locations.insert(kCpuExecutionProvider);
+      }
+
+      copies += consumer_locations.size() - consumer_locations.count(provider_type);
+    }
+  }
+
+  return copies;
+}
+
+// Greedy partitioning can leave small groups of nodes on a device in the middle of nodes that run on CPU, e.g. when
+// a device provider claims a Shape or Cast node between CPU nodes. Each group of up to max_island_size connected nodes
+// that are assigned to the same non-CPU provider is moved to the CPU provider if that needs fewer copies between
+// devices and all of its nodes have a CPU kernel.
+static void MoveIslandsToCpu(Graph& graph, const KernelRegistryManager& kernel_registry_mgr, size_t max_island_size) {
+  for (auto& node : graph.Nodes()) {
+    for (auto& entry : node.GetAttributeNameToMutableSubgraphMap()) {
+      MoveIslandsToCpu(*entry.second, kernel_registry_mgr, max_island_size);
+    }
+  }
+
+  std::unordered_set<NodeIndex> visited;
+  for (auto& node : graph.Nodes()) {
+    // copy the provider type as it changes if the island is moved
+    const std::string provider_type = node.GetExecutionProviderType();
+    if (provider_type.empty() || provider_type == kCpuExecutionProvider || !visited.insert(node.Index()).second) {
+      continue;
+    }
+
+    // collect the connected nodes assigned to the same provider
+    std::unordered_set<NodeIndex> island{node.Index()};
+    std::vector<const Node*> to_visit{&node};
+    bool can_move = true;
+    while (!to_visit.empty()) {
+      const Node* current = to_visit.back();
+      to_visit.pop_back();
+
+      // compiled nodes and control flow nodes stay with the provider
+      if (current->NodeType() == Node::Type::Fused || current->ContainsSubgraph()) {
+        can_move = false;
+      }
+
+      auto visit = [&](const Node& neighbor) {
+        if (neighbor.GetExecutionProviderType() == provider_type && island.insert(neighbor.Index()).second) {
+          visited.insert(neighbor.Index());
+          to_visit.push_back(&neighbor);
+        }
+      };
+
+      for (auto it = current->InputNodesBegin(), end = current->InputNodesEnd(); it != end; ++it) {
+        visit(*it);
+      }
+      for (auto it = current->OutputNodesBegin(), end = current->OutputNodesEnd(); it != end; ++it) {
+        visit(*it);
+      }
+    }
+
+    if (!can_move || island.size() > max_island_size ||
+        CountIslandCopies(graph, island, kCpuExecutionProvider) >= CountIslandCopies(graph, island, provider_type)) {
+      continue;
+    }
+
+    // the kernel lookup uses the provider the node is assigned to
+    bool has_cpu_kernels = true;
+    for (auto index : island) {
+      Node& island_node = *graph.GetNode(index);
+      island_node.SetExecutionProviderType(kCpuExecutionProvider);
+      if (!KernelRegistryManager::HasImplementationOf(kernel_registry_mgr, island_node, kCpuExecutionProvider)) {
+        has_cpu_kernels = false;
+      }
+    }
+
+    if (has_cpu_kernels) {
+      LOGS_DEFAULT(VERBOSE) << "Moved " << island.size() << " node(s) starting with " << node.OpType() << " ("
+                            << node.Name() << ") from " << provider_type << " to " << kCpuExecutionProvider;
+    } else {
+      for (auto index : island) {
+        graph.GetNode(index)->SetExecutionProviderType(provider_type);
+      }
+    }
+  }
+}
+
+// Logs the number of nodes assigned to each provider and the number of edges between nodes of different providers,
+// which need a copy between devices if the providers don't share memory.
+static void LogPartitionReport(const Graph& graph) {
+  std::map<std::string, size_t> nodes_per_provider;
+  size_t edges_between_providers = 0;
+  for (const auto& node : graph.Nodes()) {
+    ++nodes_per_provider[node.GetExecutionProviderType()];
+    for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+      if (it->GetNode().GetExecutionProviderType() != node.GetExecutionProviderType()) {
+        ++edges_between_providers;
+      }
+    }
+  }
+
+  std::ostringstream oss;
+  oss << "Partitioning of graph '" << graph.Name() << "':";
+  for (const auto& entry : nodes_per_provider) {
+    oss << " [" << (entry.first.empty() ? "unassigned" : entry.first) << "]: " << entry.second << " nodes,";
+  }
+  oss << " " << edges_between_providers << " edges between providers";
+  LOGS_DEFAULT(INFO) << oss.str();
+}
+
 Status GraphPartitioner::PartitionOnnxFormatModel(Graph& graph, bool export_dll, FuncManager& func_mgr,
                                                   KernelRegistry& fused_kernel_registry, Mode mode,
                                                   int& fused_node_unique_id) const {
@@ -384,6 +542,13 @@ Status GraphPartitioner::PartitionOnnxFormatModel(Graph& graph, bool export_dll,
     }
   } while (modified_graph);
 
+  // nodes assigned in kAssignOnly mode must stay with the provider that may compile them when the model is loaded
+  if (mode == Mode::kNormal && max_cpu_island_size_ > 0 && providers_.Get(kCpuExecutionProvider) != nullptr) {
+    MoveIslandsToCpu(graph, kernel_registry_mgr_, max_cpu_island_size_);
+  }
+
+  LogPartitionReport(graph);
+
   return Status::OK();
 }
 
@@ -25,9 +25,13 @@ class GraphPartitioner {
   };
 
   //The order of providers represents the user preference.
-  GraphPartitioner(KernelRegistryManager& kernel_registry_mgr, const ExecutionProviders& providers)
+  //If max_cpu_island_size is not 0, groups of up to that many connected nodes assigned to another provider are moved
+  //to the CPU provider after the partitioning if that reduces the number of copies between devices.
+  GraphPartitioner(KernelRegistryManager& kernel_registry_mgr, const ExecutionProviders& providers,
+                   size_t max_cpu_island_size = 0)
       : kernel_registry_mgr_(kernel_registry_mgr),
-        providers_(providers) {
+        providers_(providers),
+        max_cpu_island_size_(max_cpu_island_size) {
   }
 
   // Run partitioning. Provide compiled_kernel_hashes if mode is kOrtFormatLoad.
@@ -49,6 +53,7 @@ class GraphPartitioner {
 
   KernelRegistryManager& kernel_registry_mgr_;
   const ExecutionProviders& providers_;
+  const size_t max_cpu_island_size_;
 };
 }  // namespace onnxruntime
 
@@ -0,0 +1,427 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/heterogeneous_executor.h"
+
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/common/trace_sink.h"
+#include "core/framework/allocation_planner.h"
+#include "core/framework/execution_frame.h"
+#include "core/framework/session_state.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/run_latency_breakdown.h"
+#include "core/framework/utils.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+namespace {
+constexpr size_t kNoContinuation = std::numeric_limits<size_t>::max();
+}  // namespace
+
+bool HeterogeneousExecutor::IsDeviceNode(const Node& node) {
+  return node.GetExecutionProviderType() != kCpuExecutionProvider;
+}
+
+HeterogeneousExecutor::HeterogeneousExecutor(const SessionState& session_state, const bool& terminate_flag)
+    : terminate_flag_(terminate_flag) {
+  const auto& graph_viewer = session_state.GetGraphViewer();
+  node_refs_ = onnxruntime::make_unique<std::atomic<int>[]>(graph_viewer.MaxNodeIndex());
+  is_device_node_.resize(graph_viewer.MaxNodeIndex(), false);
+  for (auto& node : graph_viewer.Nodes()) {
+    node_refs_[node.Index()].store(static_cast<int>(node.GetInputEdgesCount()), std::memory_order_relaxed);
+    is_device_node_[node.Index()] = IsDeviceNode(node);
+  }
+}
+
+Status HeterogeneousExecutor::Execute(const SessionState& session_state, const std::vector<int>& feed_mlvalue_idxs,
+                                      const std::vector<OrtValue>& feeds, const std::vector<int>& fetch_mlvalue_idxs,
+                                      std::vector<OrtValue>& fetches,
+                                      const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
+                                      const logging::Logger& logger) {
+  executor_pool_ = thread_pools_ ? thread_pools_->inter_op_thread_pool : session_state.GetInterOpThreadPool();
+
+  TimePoint tp;
+  const bool is_profiler_enabled = session_state.Profiler().IsEnabled();
+  if (is_profiler_enabled) {
+    tp = session_state.Profiler().StartTime();
+  }
+
+  const auto frame_begin_time = std::chrono::steady_clock::now();
+  root_frame_ = onnxruntime::make_unique<ExecutionFrame>(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches,
+                                                         fetch_allocators, session_state);
+  if (latency_breakdown_) {
+    latency_breakdown_->frame_setup_ns += RunLatencyBreakdown::ElapsedNs(frame_begin_time);
+  }
+
+  const auto& graph_viewer = session_state.GetGraphViewer();
+  for (auto node_index : graph_viewer.GetRootNodes()) {
+    if (!session_state.GetKernel(node_index)) {
+      continue;
+    }
+
+    if (is_device_node_[node_index]) {
+      EnqueueDeviceNode(node_index);
+    } else {
+      ScheduleCpuNode(node_index, session_state, logger);
+    }
+  }
+
+  // this thread runs the device nodes. the CPU tasks must not outlive the frame so this can't return before they are
+  // all done, even if it throws.
+  Status device_status;
+  ORT_TRY {
+    device_status = RunDeviceQueue(session_state, logger);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      device_status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+    });
+  }
+  ORT_CATCH(...) {
+    device_status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unknown exception was caught by catch-all handler.");
+  }
+
+  if (!device_status.IsOK()) {
+    RecordError(device_status);
+  }
+
+  // Wait for finish.
+  {
+    const auto wait_begin_time = std::chrono::steady_clock::now();
+    std::unique_lock<OrtMutex> lock(mutex_);
+    while (out_standings_.load() > 0) cv_.wait(lock);
+    if (latency_breakdown_) {
+      latency_breakdown_->inter_op_wait_ns += RunLatencyBreakdown::ElapsedNs(wait_begin_time);
+    }
+  }
+
+  Status status = Status::OK();
+
+  if (!errors_.empty()) {
+    if (errors_.size() == 1)
+      status = errors_.front();
+    else {
+      std::stringstream ss;
+      ss << "Multiple errors were found.";
+      for (const auto& s : errors_) {
+        ss << '\n'
+           << s;
+      }
+
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ss.str());
+    }
+
+    LOGS(logger, ERROR) << status;
+    return status;
+  }
+
+  VLOGS(logger, 1) << "Fetching output.";
+  // ExecutionFrame::Finalize will update 'fetches' with the final output
+  ORT_RETURN_IF_ERROR(root_frame_->GetOutputs(fetches));
+  VLOGS(logger, 1) << "Done execution.";
+
+  if (is_profiler_enabled) {
+    session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "HeterogeneousExecutor::Execute", tp);
+  }
+
+  return Status::OK();
+}
+
+Status HeterogeneousExecutor::RunDeviceQueue(const SessionState& session_state, const logging::Logger& logger) {
+  while (true) {
+    size_t node_index;
+    {
+      // wait for a device node to be ready. if the queue is empty and no CPU tasks are left nothing else can become
+      // ready, as every CPU task queues or schedules the successors it releases before it ends.
+      const auto wait_begin_time = std::chrono::steady_clock::now();
+      std::unique_lock<OrtMutex> lock(mutex_);
+      while (device_nodes_.empty() && out_standings_.load() > 0 && !has_errors_.load()) cv_.wait(lock);
+      if (latency_breakdown_) {
+        latency_breakdown_->inter_op_wait_ns += RunLatencyBreakdown::ElapsedNs(wait_begin_time);
+      }
+
+      if (device_nodes_.empty() || has_errors_.load()) {
+        break;
+      }
+
+      node_index = device_nodes_.front();
+      device_nodes_.pop_front();
+    }
+
+    ORT_RETURN_IF_ERROR(RunNode(node_index, session_state, logger));
+    ReleaseSuccessors(node_index, session_state, logger, nullptr);
+  }
+
+  return Status::OK();
+}
+
+Status HeterogeneousExecutor::RunCpuNodes(size_t node_index, const SessionState& session_state,
+                                          const logging::Logger& logger) {
+  while (node_index != kNoContinuation) {
+    if (has_errors_.load(std::memory_order_relaxed)) {
+      // another thread failed so there's no point running more nodes
+      break;
+    }
+
+    ORT_RETURN_IF_ERROR(RunNode(node_index, session_state, logger));
+
+    size_t continuation = kNoContinuation;
+    ReleaseSuccessors(node_index, session_state, logger, &continuation);
+    node_index = continuation;
+  }
+
+  return Status::OK();
+}
+
+void HeterogeneousExecutor::ReleaseSuccessors(size_t node_index, const SessionState& session_state,
+                                              const logging::Logger& logger, size_t* continuation) {
+  const auto& node = *session_state.GetGraphViewer().GetNode(node_index);
+  for (auto it = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); it != end; ++it) {
+    const auto idx = it->GetNode().Index();
+    if (node_refs_[idx].fetch_sub(1, std::memory_order_acq_rel) != 1) {
+      continue;
+    }
+
+    if (is_device_node_[idx]) {
+      EnqueueDeviceNode(idx);
+    } else if (continuation != nullptr && *continuation == kNoContinuation) {
+      *continuation = idx;
+    } else {
+      ScheduleCpuNode(idx, session_state, logger);
+    }
+  }
+}
+
+Status HeterogeneousExecutor::RunNode(size_t node_index, const SessionState& session_state,
+                                      const logging::Logger& logger) {
+  if (terminate_flag_) {
+    LOGS(logger, WARNING) << "Exiting due to terminate flag being set to true.";
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+  }
+
+  if (IsDeadlinePassed()) {
+    LOGS(logger, WARNING) << "Exiting due to the run deadline being passed.";
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to the run deadline being passed.");
+  }
+
+  const auto& graph_viewer = session_state.GetGraphViewer();
+  const SequentialExecutionPlan& exec_plan = *session_state.GetExecutionPlan();
+  const bool f_profiler_enabled = session_state.Profiler().IsEnabled();
+  TimePoint sync_time_begin;
+  TimePoint kernel_begin_time;
+
+  const auto* p_op_kernel = session_state.GetKernel(node_index);
+  const auto& node = *graph_viewer.GetNode(node_index);
+
+  // if a kernel has been added in the session state, it better be NON-null.
+  if (p_op_kernel == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Got nullptr from GetKernel for node: ", node.Name());
+  }
+
+  OpKernelContextInternal op_kernel_context(session_state, *root_frame_, *p_op_kernel, logger, terminate_flag_,
+                                            thread_pools_);
+
+  if (f_profiler_enabled) {
+    sync_time_begin = session_state.Profiler().StartTime();
+  }
+
+  // sync before compute
+  int queue_id = p_op_kernel->KernelDef().ExecQueueId();
+  const bool node_has_fence = exec_plan.NodeHasFence(node_index);
+  if (node_has_fence) {
+    for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
+      Fence_t fence = op_kernel_context.InputFence(input_index);
+      if (fence) {
+        auto execution_provider_type = node.GetExecutionProviderType();
+        if (OrtMemTypeCPUInput == p_op_kernel->KernelDef().InputMemoryType(input_index)) {
+          execution_provider_type = kCpuExecutionProvider;
+        }
+        fence->BeforeUsingAsInput(execution_provider_type, queue_id);
+      }
+    }
+
+    for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
+      Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
+      if (fence) {
+        auto execution_provider_type = node.GetExecutionProviderType();
+        if (OrtMemTypeCPUInput == p_op_kernel->KernelDef().InputMemoryType(input_index)) {
+          execution_provider_type = kCpuExecutionProvider;
+        }
+        fence->BeforeUsingAsInput(execution_provider_type, queue_id);
+      }
+    }
+
+    for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
+      Fence_t fence = op_kernel_context.OutputFence(output_index);
+      if (fence) {
+        fence->BeforeUsingAsOutput(node.GetExecutionProviderType(), queue_id);
+      }
+    }
+  }
+
+  if (f_profiler_enabled) {
+    session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                   node.Name() + "_fence_before",
+                                                   sync_time_begin,
+                                                   {{"op_name", p_op_kernel->KernelDef().OpName()}});
+
+    kernel_begin_time = session_state.Profiler().StartTime();
+  }
+
+  VLOGS(logger, 1) << "Computing kernel: " << node.Name();
+
+  std::chrono::steady_clock::time_point compute_begin_time;
+  if (latency_breakdown_) {
+    compute_begin_time = std::chrono::steady_clock::now();
+  }
+
+  Status status;
+  ORT_TRY {
+#ifdef ENABLE_TRAINING
+    if (p_op_kernel->KernelDef().AllocateInputsContiguously()) {
+      ORT_RETURN_IF_ERROR(utils::VerifyInputTensorsAllocatedContiguously(&op_kernel_context));
+    }
+#endif
+
+    tracing::TraceRange trace_range(tracing::Category::kNode, node.Name().c_str(), node.OpType().c_str());
+    concurrency::ThreadPool::CallSiteScope call_site(node.OpType().c_str());
+    status = p_op_kernel->Compute(&op_kernel_context);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+    });
+  }
+
+  if (!status.IsOK()) {
+    std::ostringstream ss;
+    ss << "Non-zero status code returned while running " << node.OpType() << " node. Name:'" << node.Name()
+       << "' Status Message: " << status.ErrorMessage();
+    const auto msg_string = ss.str();
+    LOGS(logger, ERROR) << msg_string;
+    return Status(status.Category(), status.Code(), msg_string);
+  }
+
+  if (latency_breakdown_) {
+    const int64_t duration_ns = RunLatencyBreakdown::ElapsedNs(compute_begin_time);
+    std::lock_guard<OrtMutex> lock(latency_breakdown_mutex_);
+    latency_breakdown_->RecordNode(node.OpType(), node.GetExecutionProviderType(), duration_ns);
+  }
+
+  if (f_profiler_enabled) {
+    session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                   node.Name() + "_kernel_time",
+                                                   kernel_begin_time,
+                                                   {{"op_name", p_op_kernel->KernelDef().OpName()},
+                                                    {"provider", p_op_kernel->KernelDef().Provider()}});
+
+    sync_time_begin = session_state.Profiler().StartTime();
+  }
+
+  // sync after compute for outputs
+  if (node_has_fence) {
+    for (int input_index = 0; input_index < op_kernel_context.InputCount(); ++input_index) {
+      Fence_t fence = op_kernel_context.InputFence(input_index);
+      if (fence) {
+        fence->AfterUsedAsInput(queue_id);
+      }
+    }
+
+    for (int input_index = 0; input_index < op_kernel_context.ImplicitInputCount(); ++input_index) {
+      Fence_t fence = op_kernel_context.ImplicitInputFence(input_index);
+      if (fence) {
+        fence->AfterUsedAsInput(queue_id);
+      }
+    }
+
+    for (int output_index = 0; output_index < op_kernel_context.OutputCount(); ++output_index) {
+      Fence_t fence = op_kernel_context.OutputFence(output_index);
+      if (fence) {
+        fence->AfterUsedAsOutput(queue_id);
+      }
+    }
+  }
+
+  if (f_profiler_enabled) {
+    session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                                   node.Name() + "_fence_after",
+                                                   sync_time_begin,
+                                                   {{"op_name", p_op_kernel->KernelDef().OpName()}});
+  }
+
+  return Status::OK();
+}
+
+void HeterogeneousExecutor::EnqueueDeviceNode(size_t node_index) {
+  // if there are errors there's no point queuing more work
+  if (has_errors_.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  device_nodes_.push_back(node_index);
+  cv_.notify_all();
+}
+
+void HeterogeneousExecutor::ScheduleCpuNode(size_t node_index, const SessionState& session_state,
+                                            const logging::Logger& logger) {
+  // if there are errors there's no point queuing more work
+  if (has_errors_.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  out_standings_.fetch_add(1, std::memory_order_relaxed);
+
+  onnxruntime::concurrency::ThreadPool::Schedule(executor_pool_, [this, node_index, &session_state, &logger]() {
+    auto create_exception_message = [node_index, &session_state](const std::exception* ex) {
+      const auto* node = session_state.GetGraphViewer().GetNode(node_index);
+
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exception running nodes starting at ", node->OpType(),
+                             " node '", node->Name(), "'. ",
+                             ex ? ex->what() : "Unknown exception was caught by catch-all handler.");
+    };
+
+    Status status;
+    ORT_TRY {
+      status = RunCpuNodes(node_index, session_state, logger);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = create_exception_message(&ex);
+      });
+    }
+    ORT_CATCH(...) {
+      // catch node processing failure exceptions here to prevent app crash.
+      status = create_exception_message(nullptr);
+    }
+
+    FinishTask(status);
+  });
+}
+
+void HeterogeneousExecutor::FinishTask(const Status& status) {
+  if (!status.IsOK()) {
+    RecordError(status);
+  }
+
+  if (out_standings_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    // take the lock so the notification can't be missed by the thread calling Execute if it has checked
+    // out_standings_ but not yet started waiting
+    std::lock_guard<OrtMutex> lock(mutex_);
+    cv_.notify_all();
+  }
+}
+
+void HeterogeneousExecutor::RecordError(const Status& status) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  errors_.push_back(status);
+  has_errors_.store(true);
+  cv_.notify_all();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/iexecutor.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/ml_value.h"
+#include "core/framework/session_state.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class ExecutionFrame;
+
+/**
+Inter-op parallel executor used for ExecutionMode::ORT_PARALLEL_HETEROGENEOUS.
+
+Intended for models that are partitioned between a device execution provider (e.g. CUDA) and the CPU execution
+provider, where the sequential executor can't overlap the work of the two and the ParallelExecutor doesn't support the
+device providers:
+  - nodes assigned to the CPU execution provider are run on the inter-op thread pool. A thread that finishes a CPU
+    node continues with the first of its CPU successors that becomes ready.
+  - nodes assigned to any other execution provider are put on a device queue that is drained in ready order by the
+    thread calling Execute. Device kernels are launched asynchronously on the provider's stream, so a single thread
+    keeps the device busy, and as it is the thread that called OnRunStart the provider's per-thread state is used.
+  - data produced by one provider and consumed by another is synchronized with the Fence of the OrtValue, as in the
+    other executors, in addition to the dependency counts of the nodes.
+*/
+class HeterogeneousExecutor : public IExecutor {
+ public:
+  HeterogeneousExecutor(const SessionState& session_state, const bool& terminate_flag = false);
+
+  common::Status Execute(const SessionState& session_state, const std::vector<int>& feed_mlvalue_idxs,
+                         const std::vector<OrtValue>& feeds, const std::vector<int>& fetch_mlvalue_idxs,
+                         std::vector<OrtValue>& fetches,
+                         const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
+                         const logging::Logger& logger) override;
+
+  // Returns true if the node is run from the device queue rather than on the inter-op thread pool.
+  static bool IsDeviceNode(const Node& node);
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(HeterogeneousExecutor);
+
+  // Run the nodes on the device queue until there are no device nodes left and no CPU tasks are running.
+  Status RunDeviceQueue(const SessionState& session_state, const logging::Logger& logger);
+
+  // Run a chain of CPU nodes starting at node_index.
+  Status RunCpuNodes(size_t node_index, const SessionState& session_state, const logging::Logger& logger);
+
+  Status RunNode(size_t node_index, const SessionState& session_state, const logging::Logger& logger);
+
+  // Update the dependency counts of the successors of node_index. Device successors that become ready are put on
+  // the device queue and CPU successors are scheduled, except for the first one if continuation is not null, which
+  // is returned in it instead.
+  void ReleaseSuccessors(size_t node_index, const SessionState& session_state, const logging::Logger& logger,
+                         size_t* continuation);
+
+  void EnqueueDeviceNode(size_t node_index);
+
+  void ScheduleCpuNode(size_t node_index, const SessionState& session_state, const logging::Logger& logger);
+
+  void FinishTask(const Status& status);
+
+  void RecordError(const Status& status);
+
+  std::unique_ptr<ExecutionFrame> root_frame_;
+
+  // number of inputs edges for each node that are not yet satisfied
+  std::unique_ptr<std::atomic<int>[]> node_refs_;
+  std::vector<bool> is_device_node_;
+
+  // number of CPU tasks running or scheduled
+  std::atomic<int> out_standings_{0};
+  std::atomic<bool> has_errors_{false};
+
+  OrtMutex mutex_;
+  OrtCondVar cv_;                     // signaled when a device node is queued, an error occurs or a CPU task ends
+  std::deque<size_t> device_nodes_;   // protected by mutex_
+  std::vector<Status> errors_;        // protected by mutex_
+  OrtMutex latency_breakdown_mutex_;  // the nodes record their kernel times concurrently
+
+  const bool& terminate_flag_;
+  onnxruntime::concurrency::ThreadPool* executor_pool_{};
+};
+}  // namespace onnxruntime
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -14,9 +15,20 @@ struct OrtValue;
 namespace onnxruntime {
 class SessionState;
 class TensorShape;
+struct RunLatencyBreakdown;
 namespace logging {
 class Logger;
 }
+namespace concurrency {
+class ThreadPool;
+}
+
+// The thread pools to run the kernels of a session state on, when they differ from the ones it was created with.
+// A cloned session runs the kernels of the session state it shares with its source on its own thread pools.
+struct ExecutionThreadPools {
+  concurrency::ThreadPool* intra_op_thread_pool;
+  concurrency::ThreadPool* inter_op_thread_pool;
+};
 
 class IExecutor {
  public:
@@ -44,5 +56,21 @@ class IExecutor {
                                  // optional custom allocators. key is index in fetches
                                  const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
                                  const logging::Logger& logger) = 0;
+
+  // Adds the frame setup, kernel and wait times of the Execute calls to latency_breakdown if it is not null.
+  void SetLatencyBreakdown(RunLatencyBreakdown* latency_breakdown) { latency_breakdown_ = latency_breakdown; }
+
+  // Runs the kernels on thread_pools instead of the thread pools of the session state if it is not null.
+  void SetThreadPools(const ExecutionThreadPools* thread_pools) { thread_pools_ = thread_pools; }
+
+  // Fails the Execute calls before the next node once deadline has passed if it is not null.
+  void SetDeadline(const std::chrono::steady_clock::time_point* deadline) { deadline_ = deadline; }
+
+ protected:
+  bool IsDeadlinePassed() const { return deadline_ != nullptr && std::chrono::steady_clock::now() > *deadline_; }
+
+  RunLatencyBreakdown* latency_breakdown_ = nullptr;
+  const ExecutionThreadPools* thread_pools_ = nullptr;
+  const std::chrono::steady_clock::time_point* deadline_ = nullptr;
 };
 }  // namespace onnxruntime
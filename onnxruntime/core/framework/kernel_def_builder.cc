@@ -213,4 +213,15 @@ KernelDefBuilder& KernelDefBuilder::VariadicAlias(int input_offset, int output_o
   return *this;
 }
 
+KernelDefBuilder& KernelDefBuilder::MayOutputView(int input_index, int output_index) {
+  kernel_def_->view_map_.emplace_back(input_index, output_index);
+  return *this;
+}
+
+KernelDefBuilder& KernelDefBuilder::VariadicMayOutputView(int input_index, int output_offset) {
+  ORT_ENFORCE(input_index >= 0 && output_offset >= 0);
+  kernel_def_->variadic_view_offsets_ = std::make_pair(input_index, output_offset);
+  return *this;
+}
+
 }  // namespace onnxruntime
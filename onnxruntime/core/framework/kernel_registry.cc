@@ -115,8 +115,10 @@ class TypeBindingResolver {
 };  // namespace
 
 bool KernelRegistry::VerifyKernelDef(const onnxruntime::Node& node,
-                                     const KernelDef& kernel_def,
-                                     std::string& error_str) {
+                                     const KernelLookupEntry& entry,
+                                     std::string* error_str) {
+  const KernelDef& kernel_def = *entry.create_info->kernel_def;
+
   // check if version matches
   int kernel_start_version;
   int kernel_end_version;
@@ -137,6 +139,10 @@ bool KernelRegistry::VerifyKernelDef(const onnxruntime::Node& node,
   bool valid_version = kernel_start_version == node_since_version  // the idea case this branch should be kernel_start_version >= node_version && kernel_start_version <= until_version
                        || (kernel_start_version < node_since_version && kernel_end_version != INT_MAX && kernel_end_version >= node_since_version);
   if (!valid_version) {
+    if (error_str == nullptr) {
+      return false;
+    }
+
     std::ostringstream ostr;
     ostr << "Op with name (" << node.Name() << ")"
          << " and type (" << node.OpType() << ")"
@@ -144,12 +150,12 @@ bool KernelRegistry::VerifyKernelDef(const onnxruntime::Node& node,
          << " node_version: " << node_since_version
          << " kernel start version: " << kernel_start_version
          << " kernel_end_version: " << kernel_end_version;
-    error_str = ostr.str();
+    *error_str = ostr.str();
     return false;
   }
 
   // check if type matches
-  auto& kernel_type_constraints = kernel_def.TypeConstraints();
+  const auto& kernel_type_constraints = entry.type_constraints;
 
   // Note: The number of formal input/output parameters is N and the number of
   // type constraints is M. We select between an O(N*M) and an O(N+M) approach.
@@ -161,9 +167,9 @@ bool KernelRegistry::VerifyKernelDef(const onnxruntime::Node& node,
                                kTypeBindingResolverComplexityThreshold);
   TypeBindingResolver type_binding_resolver{node, use_lookup_map};
 
-  for (auto& constraint : kernel_type_constraints) {
-    const std::string& name = constraint.first;
-    const std::vector<MLDataType>& allowed_types = constraint.second;
+  for (const auto& constraint : kernel_type_constraints) {
+    const std::string& name = *constraint.name;
+    const std::vector<MLDataType>& allowed_types = *constraint.allowed_types;
     const ONNX_NAMESPACE::TypeProto* actual_type = type_binding_resolver.Resolve(name);
 
     // If actual_type is null, this represents a type-constraint on a
@@ -171,12 +177,27 @@ bool KernelRegistry::VerifyKernelDef(const onnxruntime::Node& node,
     // TODO: We should check that names specified in kernel_type_constraints are
     // valid names (of types or parameters) at the time that kernels are registered.
     if (nullptr != actual_type) {
-      bool is_type_compatible = std::any_of(allowed_types.begin(), allowed_types.end(),
-                                            [actual_type](const DataTypeImpl* expected_type) {
-                                              bool rc = expected_type->IsCompatible(*actual_type);  // for easier debugging
-                                              return rc;
-                                            });
+      bool is_type_compatible;
+      if (constraint.tensor_types_only) {
+        // equivalent to TensorTypeBase::IsCompatible for each allowed type
+        const int32_t elem_type = actual_type->value_case() == ONNX_NAMESPACE::TypeProto::kTensorType
+                                      ? actual_type->tensor_type().elem_type()
+                                      : -1;
+        is_type_compatible = elem_type >= 0 && elem_type < 64 &&
+                             (constraint.tensor_element_types & (uint64_t{1} << elem_type)) != 0;
+      } else {
+        is_type_compatible = std::any_of(allowed_types.begin(), allowed_types.end(),
+                                         [actual_type](const DataTypeImpl* expected_type) {
+                                           bool rc = expected_type->IsCompatible(*actual_type);  // for easier debugging
+                                           return rc;
+                                         });
+      }
+
       if (!is_type_compatible) {
+        if (error_str == nullptr) {
+          return false;
+        }
+
         std::ostringstream ostr;
         ostr << "Found kernel for Op with name (" << node.Name() << ")"
              << " and type (" << node.OpType() << ")"
@@ -192,7 +213,7 @@ bool KernelRegistry::VerifyKernelDef(const onnxruntime::Node& node,
         ostr << "),";
         const char* actual_type_str = DataTypeImpl::ToString(DataTypeImpl::TypeFromProto(*actual_type));
         ostr << " but the node in the model has the following type (" << actual_type_str << ")";
-        error_str = ostr.str();
+        *error_str = ostr.str();
         return false;
       }
     }
@@ -246,14 +267,16 @@ Status KernelRegistry::TryFindKernel(const onnxruntime::Node& node,
   const auto& node_provider = node.GetExecutionProviderType();
   const auto& expected_provider = (node_provider.empty() ? exec_provider : node_provider);
 
-  auto range = kernel_creator_fn_map_.equal_range(GetMapKey(node.OpType(), node.Domain(), expected_provider));
+  static const std::vector<KernelLookupEntry> no_entries;
+  auto index_entry = kernel_lookup_index_.find(GetMapKey(node.OpType(), node.Domain(), expected_provider));
+  const auto& entries = index_entry != kernel_lookup_index_.end() ? index_entry->second : no_entries;
   *out = nullptr;
 
   // if we have a hash (ORT format model) use only that.
   if (kernel_def_hash != 0) {
-    for (auto i = range.first; i != range.second; ++i) {
-      if (i->second.kernel_def->GetHash() == kernel_def_hash) {
-        *out = &i->second;
+    for (const auto& entry : entries) {
+      if (entry.create_info->kernel_def->GetHash() == kernel_def_hash) {
+        *out = entry.create_info;
         return Status::OK();
       }
     }
@@ -268,18 +291,22 @@ Status KernelRegistry::TryFindKernel(const onnxruntime::Node& node,
   }
 #if !defined(ORT_MINIMAL_BUILD)
   else {
-    std::vector<std::string> verify_kernel_def_error_strs;
-
-    for (auto i = range.first; i != range.second; ++i) {
-      std::string error_str;
-      if (VerifyKernelDef(node, *i->second.kernel_def, error_str)) {
-        *out = &i->second;
+    for (const auto& entry : entries) {
+      if (VerifyKernelDef(node, entry, nullptr)) {
+        *out = entry.create_info;
         return Status::OK();
       }
-      verify_kernel_def_error_strs.push_back(error_str);
     }
 
-    if (!verify_kernel_def_error_strs.empty()) {
+    // no kernel matches, so check them again to report why
+    if (!entries.empty()) {
+      std::vector<std::string> verify_kernel_def_error_strs;
+      for (const auto& entry : entries) {
+        std::string error_str;
+        ORT_IGNORE_RETURN_VALUE(VerifyKernelDef(node, entry, &error_str));
+        verify_kernel_def_error_strs.push_back(error_str);
+      }
+
       std::ostringstream oss;
       oss << "Op with name (" << node.Name() << ")"
           << " and type (" << node.OpType() << ")"
@@ -307,20 +334,50 @@ Status KernelRegistry::Register(KernelCreateInfo&& create_info) {
   }
   std::string key = GetMapKey(*create_info.kernel_def);
   // Check op version conflicts.
-  auto range = kernel_creator_fn_map_.equal_range(key);
-  for (auto i = range.first; i != range.second; ++i) {
-    if (i->second.kernel_def &&
-        i->second.kernel_def->IsConflict(*create_info.kernel_def)) {
-      return Status(ONNXRUNTIME, FAIL,
-                    "Failed to add kernel for " + key +
-                        ": Conflicting with a registered kernel with op versions.");
+  auto index_entry = kernel_lookup_index_.find(key);
+  if (index_entry != kernel_lookup_index_.end()) {
+    for (const auto& entry : index_entry->second) {
+      if (entry.create_info->kernel_def->IsConflict(*create_info.kernel_def)) {
+        return Status(ONNXRUNTIME, FAIL,
+                      "Failed to add kernel for " + key +
+                          ": Conflicting with a registered kernel with op versions.");
+      }
     }
   }
 
   // Register the kernel.
   // Ownership of the KernelDef is transferred to the map.
-  kernel_creator_fn_map_.emplace(key, std::move(create_info));
+  auto registered = kernel_creator_fn_map_.emplace(key, std::move(create_info));
+  AddToLookupIndex(key, registered->second);
   return Status::OK();
 }
 
+void KernelRegistry::AddToLookupIndex(const std::string& key, const KernelCreateInfo& create_info) {
+  KernelLookupEntry entry{&create_info};
+
+#if !defined(ORT_MINIMAL_BUILD)
+  const auto& type_constraints = create_info.kernel_def->TypeConstraints();
+  entry.type_constraints.reserve(type_constraints.size());
+  for (const auto& constraint : type_constraints) {
+    TypeConstraintLookup lookup{&constraint.first, &constraint.second, true, 0};
+    for (const auto* allowed_type : constraint.second) {
+      const auto* type_proto = allowed_type->IsTensorType() ? allowed_type->GetTypeProto() : nullptr;
+      const int32_t elem_type = type_proto != nullptr && type_proto->value_case() == ONNX_NAMESPACE::TypeProto::kTensorType
+                                    ? type_proto->tensor_type().elem_type()
+                                    : 0;
+      if (elem_type <= 0 || elem_type >= 64) {
+        lookup.tensor_types_only = false;
+        break;
+      }
+
+      lookup.tensor_element_types |= uint64_t{1} << elem_type;
+    }
+
+    entry.type_constraints.push_back(lookup);
+  }
+#endif
+
+  kernel_lookup_index_[key].push_back(std::move(entry));
+}
+
 }  // namespace onnxruntime
@@ -16,12 +16,15 @@ namespace onnxruntime {
 std::unique_ptr<OpKernel> KernelRegistryManager::CreateKernel(const onnxruntime::Node& node,
                                                               const IExecutionProvider& execution_provider,
                                                               const SessionState& session_state,
-                                                              const KernelCreateInfo& kernel_create_info) const {
+                                                              const KernelCreateInfo& kernel_create_info,
+                                                              const std::unordered_map<std::string, std::string>*
+                                                                  session_configurations) const {
   OpKernelInfo kernel_info(node, *kernel_create_info.kernel_def, execution_provider,
                            session_state.GetConstantInitializedTensors(),
                            session_state.GetOrtValueNameIdxMap(),
                            session_state.GetFuncMgr(),
-                           session_state.GetDataTransferMgr());
+                           session_state.GetDataTransferMgr(),
+                           session_configurations);
 
   // OpKernel is abstract base class so can't use make_unique
   return std::unique_ptr<OpKernel>(kernel_create_info.kernel_create_func(kernel_info));
@@ -78,7 +78,9 @@ class KernelRegistryManager {
   std::unique_ptr<OpKernel> CreateKernel(const onnxruntime::Node& node,
                                          const IExecutionProvider& execution_provider,
                                          const SessionState& session_state,
-                                         const KernelCreateInfo& kernel_create_info) const ORT_MUST_USE_RESULT;
+                                         const KernelCreateInfo& kernel_create_info,
+                                         const std::unordered_map<std::string, std::string>* session_configurations =
+                                             nullptr) const ORT_MUST_USE_RESULT;
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(KernelRegistryManager);
 
@@ -19,6 +19,7 @@ struct MemoryBlock {
 
 class MemoryPattern {
   friend class MemPatternPlanner;
+  friend class MemoryPatternCache;
 
  public:
   MemoryPattern() = default;
@@ -61,6 +62,10 @@ struct MemoryPatternGroup {
   std::vector<OrtMemoryInfo> locations;
   std::vector<MemoryPattern> patterns;
 
+  // true if the patterns were computed from the shapes in the graph before execution rather than traced. a block
+  // that doesn't match the size of its tensor then means the shapes in the graph are wrong.
+  bool from_graph_shapes{false};
+
   const MemoryPattern* GetPatterns(const OrtMemoryInfo& location) const {
     for (size_t i = 0; i < locations.size(); i++)
       if (locations[i] == location) {
@@ -0,0 +1,279 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/mem_pattern_cache.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <locale>
+#include <sstream>
+
+namespace onnxruntime {
+
+namespace {
+constexpr const char* kFileHeader = "# onnxruntime memory pattern cache v1";
+
+bool HasWhitespace(const char* name) {
+  return std::any_of(name, name + strlen(name), [](char c) { return std::isspace(static_cast<unsigned char>(c)); });
+}
+}  // namespace
+
+Status MemoryPatternCache::Configure(size_t max_entries, int64_t dim_bucket_size) {
+  ORT_RETURN_IF_NOT(dim_bucket_size >= 0, "Memory pattern cache dimension bucket size must be >= 0. Got ",
+                    dim_bucket_size);
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  max_entries_ = max_entries;
+  dim_bucket_size_ = dim_bucket_size;
+  lru_.clear();
+  entries_.clear();
+
+  return Status::OK();
+}
+
+MemoryPatternCache::Key MemoryPatternCache::CreateKey(
+    const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes) const {
+  Key key;
+  size_t key_size = input_shapes.size();
+  for (const auto& shape : input_shapes) {
+    key_size += shape.get().NumDimensions();
+  }
+
+  key.reserve(key_size);
+  for (const auto& shape : input_shapes) {
+    const auto& dims = shape.get().GetDims();
+    // include the rank so that e.g. {2, 3} + {4} and {2} + {3, 4} differ
+    key.push_back(static_cast<int64_t>(dims.size()));
+    for (auto dim : dims) {
+      if (IsBucketed() && dim > 0) {
+        dim = ((dim + dim_bucket_size_ - 1) / dim_bucket_size_) * dim_bucket_size_;
+      }
+
+      key.push_back(dim);
+    }
+  }
+
+  return key;
+}
+
+std::shared_ptr<const MemoryPatternCache::Entry> MemoryPatternCache::Find(const Key& key) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    ++stats_.misses;
+    return nullptr;
+  }
+
+  ++stats_.hits;
+  lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+  return it->second.entry;
+}
+
+bool MemoryPatternCache::Insert(const Key& key, std::shared_ptr<const Entry> entry) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (entries_.find(key) != entries_.end()) {
+    return false;
+  }
+
+  lru_.push_front(key);
+  entries_.emplace(key, CacheValue{std::move(entry), lru_.begin()});
+  ++stats_.insertions;
+
+  if (max_entries_ > 0) {
+    while (entries_.size() > max_entries_) {
+      entries_.erase(lru_.back());
+      lru_.pop_back();
+      ++stats_.evictions;
+    }
+  }
+
+  return true;
+}
+
+void MemoryPatternCache::Erase(const Key& key) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    lru_.erase(it->second.lru_position);
+    entries_.erase(it);
+  }
+}
+
+size_t MemoryPatternCache::Size() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return entries_.size();
+}
+
+MemoryPatternCache::Stats MemoryPatternCache::GetStats() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return stats_;
+}
+
+Status MemoryPatternCache::Load(const std::string& file_path, uint64_t fingerprint,
+                                const std::vector<OrtMemoryInfo>& locations) {
+  std::ifstream stream(file_path);
+  if (!stream.is_open()) {
+    // nothing was saved yet
+    return Status::OK();
+  }
+
+  stream.imbue(std::locale::classic());
+  std::string header;
+  ORT_RETURN_IF_NOT(std::getline(stream, header) && header == kFileHeader, file_path,
+                    " is not a memory pattern cache file.");
+
+  std::string tag;
+  uint64_t file_fingerprint = 0;
+  int64_t file_dim_bucket_size = 0;
+  ORT_RETURN_IF_NOT(stream >> tag >> file_fingerprint >> file_dim_bucket_size && tag == "fingerprint",
+                    "Invalid memory pattern cache file ", file_path);
+  ORT_RETURN_IF_NOT(file_fingerprint == fingerprint,
+                    "The memory pattern cache file ", file_path, " was saved for a different graph or allocation plan.");
+  ORT_RETURN_IF_NOT(file_dim_bucket_size == dim_bucket_size_, "The memory pattern cache file ", file_path,
+                    " was saved with a dimension bucket size of ", file_dim_bucket_size, " instead of ",
+                    dim_bucket_size_);
+
+  // parse the whole file before adding any entry, so a file that is rejected adds nothing
+  std::vector<std::pair<Key, std::shared_ptr<Entry>>> loaded_entries;
+  while (stream >> tag) {
+    ORT_RETURN_IF_NOT(tag == "entry", "Expected an entry in the memory pattern cache file ", file_path, ", got ", tag);
+
+    int from_graph_shapes = 0;
+    size_t num_locations = 0;
+    size_t num_shapes = 0;
+    size_t key_size = 0;
+    stream >> from_graph_shapes >> num_locations >> num_shapes >> key_size;
+    Key key(key_size);
+    for (auto& value : key) {
+      stream >> value;
+    }
+
+    auto entry = std::make_shared<Entry>();
+    entry->patterns.from_graph_shapes = from_graph_shapes != 0;
+    for (size_t i = 0; i < num_locations && stream; ++i) {
+      std::string name;
+      int id = 0;
+      int mem_type = 0;
+      int alloc_type = 0;
+      int device_type = 0;
+      int device_mem_type = 0;
+      int device_id = 0;
+      size_t peak_size = 0;
+      size_t num_blocks = 0;
+      stream >> tag >> name >> id >> mem_type >> alloc_type >> device_type >> device_mem_type >> device_id >>
+          peak_size >> num_blocks;
+      ORT_RETURN_IF_NOT(stream && tag == "location", "Invalid location in the memory pattern cache file ", file_path);
+
+      auto location = std::find_if(locations.begin(), locations.end(), [&](const OrtMemoryInfo& info) {
+        return name == info.name && id == info.id && mem_type == info.mem_type && alloc_type == info.alloc_type &&
+               device_type == info.device.Type() && device_mem_type == info.device.MemType() &&
+               device_id == info.device.Id();
+      });
+      ORT_RETURN_IF(location == locations.end(), "The memory pattern cache file ", file_path,
+                    " has patterns for the location ", name, " that is not used by the allocation plan.");
+
+      MemoryPattern pattern;
+      pattern.peak_size_ = peak_size;
+      for (size_t j = 0; j < num_blocks; ++j) {
+        int ort_value_idx = 0;
+        size_t offset = 0;
+        size_t size = 0;
+        stream >> tag >> ort_value_idx >> offset >> size;
+        ORT_RETURN_IF_NOT(stream && tag == "block" && offset <= peak_size && size <= peak_size - offset,
+                          "Invalid block in the memory pattern cache file ", file_path);
+        pattern.patterns_[ort_value_idx] = MemoryBlock(offset, size);
+      }
+
+      entry->patterns.locations.push_back(*location);
+      entry->patterns.patterns.push_back(std::move(pattern));
+    }
+
+    for (size_t i = 0; i < num_shapes && stream; ++i) {
+      int ort_value_idx = 0;
+      size_t rank = 0;
+      stream >> tag >> ort_value_idx >> rank;
+      std::vector<int64_t> dims(rank);
+      for (auto& dim : dims) {
+        stream >> dim;
+      }
+      ORT_RETURN_IF_NOT(stream && tag == "shape", "Invalid shape in the memory pattern cache file ", file_path);
+      entry->inferred_shapes[ort_value_idx] = TensorShape(dims);
+    }
+
+    ORT_RETURN_IF_NOT(stream, "Invalid entry in the memory pattern cache file ", file_path);
+    loaded_entries.emplace_back(std::move(key), std::move(entry));
+  }
+
+  // the entries were saved from the least recently used, so the most recently used one ends up first again
+  for (auto& loaded_entry : loaded_entries) {
+    Insert(loaded_entry.first, std::move(loaded_entry.second));
+  }
+
+  return Status::OK();
+}
+
+Status MemoryPatternCache::Save(const std::string& file_path, uint64_t fingerprint) const {
+  std::vector<std::pair<Key, std::shared_ptr<const Entry>>> entries;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    entries.reserve(entries_.size());
+    for (auto key = lru_.rbegin(); key != lru_.rend(); ++key) {
+      entries.emplace_back(*key, entries_.at(*key).entry);
+    }
+  }
+
+  // write a temporary file and rename it, so a process loading the cache never sees a partial file
+  const std::string temp_file_path = file_path + ".tmp";
+  {
+    std::ofstream stream(temp_file_path, std::ios::out | std::ios::trunc);
+    ORT_RETURN_IF_NOT(stream.is_open(), "Failed to open ", temp_file_path, " to save the memory pattern cache");
+    stream.imbue(std::locale::classic());
+    stream << kFileHeader << "\n"
+           << "fingerprint " << fingerprint << " " << dim_bucket_size_ << "\n";
+
+    for (const auto& key_and_entry : entries) {
+      const auto& key = key_and_entry.first;
+      const auto& entry = *key_and_entry.second;
+      stream << "entry " << (entry.patterns.from_graph_shapes ? 1 : 0) << " " << entry.patterns.locations.size()
+             << " " << entry.inferred_shapes.size() << " " << key.size();
+      for (auto value : key) {
+        stream << " " << value;
+      }
+      stream << "\n";
+
+      for (size_t i = 0; i < entry.patterns.locations.size(); ++i) {
+        const auto& location = entry.patterns.locations[i];
+        const auto& pattern = entry.patterns.patterns[i];
+        ORT_RETURN_IF(HasWhitespace(location.name), "Can't save the memory patterns of the location '",
+                      location.name, "'");
+        stream << "location " << location.name << " " << location.id << " " << location.mem_type << " "
+               << location.alloc_type << " " << static_cast<int>(location.device.Type()) << " "
+               << static_cast<int>(location.device.MemType()) << " " << location.device.Id() << " "
+               << pattern.PeakSize() << " " << pattern.GetPatternsMap().size() << "\n";
+        for (const auto& block : pattern.GetPatternsMap()) {
+          stream << "block " << block.first << " " << block.second.offset_ << " " << block.second.size_ << "\n";
+        }
+      }
+
+      for (const auto& shape : entry.inferred_shapes) {
+        const auto& dims = shape.second.GetDims();
+        stream << "shape " << shape.first << " " << dims.size();
+        for (auto dim : dims) {
+          stream << " " << dim;
+        }
+        stream << "\n";
+      }
+    }
+    ORT_RETURN_IF_NOT(stream.good(), "Failed to write the memory pattern cache to ", temp_file_path);
+  }
+
+  std::remove(file_path.c_str());
+  ORT_RETURN_IF_NOT(std::rename(temp_file_path.c_str(), file_path.c_str()) == 0,
+                    "Failed to rename ", temp_file_path, " to ", file_path);
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
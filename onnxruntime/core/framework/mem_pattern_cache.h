@@ -0,0 +1,124 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/mem_pattern.h"
+#include "core/framework/tensor_shape.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+ * Cache of the memory patterns traced by ExecutionFrame, keyed by the signature of the input shapes.
+ *
+ * The key contains the rank and every dimension of every input so different shapes never share an entry.
+ * Optionally each dimension can be rounded up to a multiple of dim_bucket_size when creating the key, so that
+ * e.g. all sequence lengths in [33, 64] share one entry. A pattern in a bucketed entry was traced using one specific
+ * set of input shapes, so ExecutionFrame will only use a block from it if the block is large enough.
+ *
+ * Once max_entries is exceeded the least recently used entry is evicted. A value of 0 means unlimited.
+ *
+ * The entries can be saved to a file and loaded by another process, so that even the first execution with a set of
+ * input shapes uses the patterns. The file is a text file with a header line, followed by a line per entry:
+ *   entry <from_graph_shapes> <number of locations> <number of inferred shapes> <key size> <key values>
+ * and after it a line per location and its blocks, and a line per inferred shape:
+ *   location <name> <id> <mem_type> <alloc_type> <device type> <device memory type> <device id> <peak size> <blocks>
+ *   block <OrtValue index> <offset> <size>
+ *   shape <OrtValue index> <rank> <dims>
+ * The OrtValue indices are only meaningful for the graph and allocation plan the file was saved with, so the file
+ * records a fingerprint of them, and the dimension bucket size the keys were created with.
+ */
+class MemoryPatternCache {
+ public:
+  struct Entry {
+    MemoryPatternGroup patterns;
+
+    // Shapes inferred when generating the patterns. These are only valid for the exact input shapes the patterns
+    // were generated with so are left empty for a bucketed cache.
+    std::unordered_map<int, TensorShape> inferred_shapes;
+  };
+
+  struct Stats {
+    size_t hits{0};
+    size_t misses{0};
+    size_t insertions{0};
+    size_t evictions{0};
+  };
+
+  using Key = std::vector<int64_t>;
+
+  MemoryPatternCache() = default;
+
+  /**
+  Set the cache limits. Any existing entries are discarded.
+  @param max_entries Maximum number of entries to keep. 0 for unlimited.
+  @param dim_bucket_size Round dimensions up to a multiple of this value when creating the key. 0 or 1 to disable.
+  */
+  Status Configure(size_t max_entries, int64_t dim_bucket_size);
+
+  Key CreateKey(const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes) const;
+
+  bool IsBucketed() const noexcept { return dim_bucket_size_ > 1; }
+
+  // Returns nullptr if not found. The entry remains valid for as long as the caller holds the returned pointer,
+  // even if it is evicted from the cache in the meantime.
+  std::shared_ptr<const Entry> Find(const Key& key);
+
+  // Add an entry. If an entry with the same key already exists the existing entry is kept and false is returned.
+  bool Insert(const Key& key, std::shared_ptr<const Entry> entry);
+
+  // Remove an entry so that the patterns for the key are re-generated on the next request.
+  void Erase(const Key& key);
+
+  size_t Size() const;
+
+  Stats GetStats() const;
+
+  /**
+  Add the entries of a file written by Save. A file that does not exist has no entries.
+  @param fingerprint Identifies the graph and allocation plan. A file saved with a different fingerprint or dimension
+                     bucket size is rejected without adding any entry.
+  @param locations The memory locations of the allocation plan. The locations in the file are resolved to these, and
+                   a file with any other location is rejected.
+  */
+  Status Load(const std::string& file_path, uint64_t fingerprint, const std::vector<OrtMemoryInfo>& locations);
+
+  /** Write all the entries to a file, replacing it. */
+  Status Save(const std::string& file_path, uint64_t fingerprint) const;
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const noexcept {
+      size_t hash = key.size();
+      for (auto value : key) {
+        hash ^= std::hash<int64_t>{}(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      }
+      return hash;
+    }
+  };
+
+  struct CacheValue {
+    std::shared_ptr<const Entry> entry;
+    std::list<Key>::iterator lru_position;
+  };
+
+  size_t max_entries_{0};
+  int64_t dim_bucket_size_{0};
+
+  mutable OrtMutex mutex_;
+  // most recently used key is at the front
+  std::list<Key> lru_;
+  std::unordered_map<Key, CacheValue, KeyHash> entries_;
+  Stats stats_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,121 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/memory_profiler.h"
+
+#include <algorithm>
+
+#include "core/framework/arena.h"
+#include "core/framework/session_state.h"
+
+namespace onnxruntime {
+
+static std::string LocationName(const OrtMemoryInfo& location) {
+  return MakeString(location.name, ":", location.id);
+}
+
+MemoryProfiler::MemoryProfiler(const SessionState& session_state) : session_state_(session_state) {
+  // an allocator can be shared by multiple execution providers
+  for (const auto& provider : session_state_.GetExecutionProviders()) {
+    for (const auto& allocator : provider->GetAllocators()) {
+      auto* arena = allocator->Info().alloc_type == OrtArenaAllocator
+                        ? static_cast<IArenaAllocator*>(allocator.get())
+                        : nullptr;
+      if (arena != nullptr && std::find(arenas_.begin(), arenas_.end(), arena) == arenas_.end()) {
+        arenas_.push_back(arena);
+      }
+    }
+  }
+}
+
+std::string MemoryProfiler::GetValueName(int ort_value_idx) const {
+  std::string name;
+  if (!session_state_.GetOrtValueNameIdxMap().GetName(ort_value_idx, name).IsOK()) {
+    name = std::to_string(ort_value_idx);
+  }
+  return name;
+}
+
+void MemoryProfiler::RecordAllocation(int ort_value_idx, const OrtMemoryInfo& location, size_t bytes) {
+  auto& profiler = session_state_.Profiler();
+  const auto& per_alloc_plan = session_state_.GetExecutionPlan()->allocation_plan[ort_value_idx];
+  const std::string location_name = LocationName(location);
+
+  if (bytes > 0) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto location_entry = live_bytes_.emplace(location_name, 0).first;
+    location_entry->second += static_cast<int64_t>(bytes);
+    total_live_bytes_ += static_cast<int64_t>(bytes);
+    peak_live_bytes_ = std::max(peak_live_bytes_, total_live_bytes_);
+    live_values_[ort_value_idx] = LiveValue{location_entry, bytes};
+  }
+
+  const bool is_reuse = per_alloc_plan.alloc_kind == AllocKind::kReuse ||
+                        per_alloc_plan.alloc_kind == AllocKind::kShare;
+  profiler.EndTimeAndRecordEvent(profiling::MEMORY_EVENT,
+                                 GetValueName(ort_value_idx) + "_alloc",
+                                 profiler.StartTime(),
+                                 {{"size", std::to_string(bytes)},
+                                  {"location", location_name},
+                                  {"alloc_kind", MakeString(per_alloc_plan.alloc_kind)},
+                                  {"reused_buffer", is_reuse ? GetValueName(per_alloc_plan.reused_buffer) : ""}});
+}
+
+void MemoryProfiler::RecordRelease(int ort_value_idx) {
+  std::string location_name;
+  size_t bytes = 0;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto entry = live_values_.find(ort_value_idx);
+    if (entry == live_values_.end()) {
+      return;
+    }
+
+    location_name = entry->second.location->first;
+    bytes = entry->second.bytes;
+    entry->second.location->second -= static_cast<int64_t>(bytes);
+    total_live_bytes_ -= static_cast<int64_t>(bytes);
+    live_values_.erase(entry);
+  }
+
+  auto& profiler = session_state_.Profiler();
+  profiler.EndTimeAndRecordEvent(profiling::MEMORY_EVENT,
+                                 GetValueName(ort_value_idx) + "_free",
+                                 profiler.StartTime(),
+                                 {{"size", std::to_string(bytes)},
+                                  {"location", location_name}});
+}
+
+void MemoryProfiler::RecordNode(const std::string& node_name, const std::string& op_type,
+                                const TimePoint& start_time) {
+  std::vector<std::pair<std::string, int64_t>> live_bytes;
+  int64_t peak_live_bytes = 0;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    live_bytes.assign(live_bytes_.begin(), live_bytes_.end());
+    peak_live_bytes = peak_live_bytes_;
+    peak_live_bytes_ = total_live_bytes_;
+  }
+
+  auto& profiler = session_state_.Profiler();
+  profiler.EndTimeAndRecordEvent(profiling::MEMORY_EVENT,
+                                 node_name + "_memory",
+                                 start_time,
+                                 {{"op_name", op_type},
+                                  {"peak_live_bytes", std::to_string(peak_live_bytes)}});
+
+  if (!live_bytes.empty()) {
+    profiler.RecordCounterEvent(profiling::MEMORY_EVENT, "live_bytes", live_bytes);
+  }
+
+  for (auto* arena : arenas_) {
+    AllocatorStats stats;
+    arena->GetStats(&stats);
+    profiler.RecordCounterEvent(profiling::MEMORY_EVENT, "arena_" + LocationName(arena->Info()),
+                                {{"in_use_bytes", stats.bytes_in_use},
+                                 {"reserved_bytes", stats.total_allocated_bytes},
+                                 {"largest_free_chunk", stats.largest_free_chunk}});
+  }
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/allocator.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+class IArenaAllocator;
+class SessionState;
+
+/**
+ * Records the memory usage of an execution to the profiler of the session, if memory profiling is enabled with
+ * session.enable_memory_profiling:
+ * - an event for each allocation and release of a tensor with the decision of the allocation planner,
+ * - the bytes of the live tensors per device after each node, as a counter, and their peak during the node,
+ * - the bytes in use, the reserved bytes and the largest free chunk of each arena after each node, as a counter.
+ * The events are written with the other profiling events, so they are shown in the same trace viewer.
+ * Thread-safe, as the parallel executor allocates from multiple threads.
+ */
+class MemoryProfiler {
+ public:
+  explicit MemoryProfiler(const SessionState& session_state);
+
+  /**
+   * Record the allocation of the tensor of an OrtValue. bytes is the size of the buffer owned by the tensor, or 0 if
+   * the planner reuses or shares the buffer of another OrtValue.
+   */
+  void RecordAllocation(int ort_value_idx, const OrtMemoryInfo& location, size_t bytes);
+
+  /** Record the release of an OrtValue. Ignored if the OrtValue doesn't own an allocation that was recorded. */
+  void RecordRelease(int ort_value_idx);
+
+  /**
+   * Record the peak of the live bytes since the previous node, and the arena statistics. Called after the node
+   * was computed, before its inputs are released. node_name is the name of the node in the other profiling events.
+   */
+  void RecordNode(const std::string& node_name, const std::string& op_type, const TimePoint& start_time);
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MemoryProfiler);
+
+  std::string GetValueName(int ort_value_idx) const;
+
+  const SessionState& session_state_;
+
+  // the arenas of the execution providers, each once
+  std::vector<IArenaAllocator*> arenas_;
+
+  OrtMutex mutex_;
+
+  struct LiveValue {
+    std::map<std::string, int64_t>::iterator location;  // entry in live_bytes_
+    size_t bytes;
+  };
+
+  std::unordered_map<int, LiveValue> live_values_;
+  // the live bytes per location, e.g. "Cpu:0". sorted so the values are in the same order in each counter event.
+  std::map<std::string, int64_t> live_bytes_;
+  int64_t total_live_bytes_ = 0;
+  // the peak of total_live_bytes_ since the previous node
+  int64_t peak_live_bytes_ = 0;
+};
+
+}  // namespace onnxruntime
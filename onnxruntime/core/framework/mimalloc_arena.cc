@@ -24,6 +24,12 @@ void* MiMallocArena::Reserve(size_t size) {
   return mi_malloc(size);
 }
 
+Status MiMallocArena::Shrink() {
+  mi_collect(true);
+  ++num_shrinks_;
+  return Status::OK();
+}
+
 // mimalloc only maintains stats when compiled under debug (which in turn sets MI_STAT)
 void MiMallocArena::GetStats(AllocatorStats* stats) {
 #if (MI_STAT > 1)
@@ -33,6 +39,7 @@ void MiMallocArena::GetStats(AllocatorStats* stats) {
   stats_.max_bytes_in_use = current_stats.reserved.peak;
 #endif
   *stats = stats_;
+  stats->num_shrinks = num_shrinks_;
 }
 
 size_t MiMallocArena::Used() const {
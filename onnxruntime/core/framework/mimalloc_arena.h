@@ -1,9 +1,13 @@
 #if defined(USE_MIMALLOC_ARENA_ALLOCATOR)
+#include <atomic>
+
 #include "core/common/common.h"
 #include "core/framework/arena.h"
 #include "onnxruntime_config.h"
 
 namespace onnxruntime {
+// An arena backed by mimalloc. Each thread, e.g. each intra-op worker, allocates from its own mimalloc heap without
+// taking a lock, and memory freed by another thread is returned to the heap of the thread that allocated it.
 class MiMallocArena : public IArenaAllocator {
  public:
   MiMallocArena(std::unique_ptr<IAllocator> resource_allocator, size_t total_memory);
@@ -13,10 +17,14 @@ class MiMallocArena : public IArenaAllocator {
   void Free(void* p) override;
 
   // mimalloc only maintains stats when compiled under debug, or when MI_STAT >= 2
-  void GetStats(AllocatorStats* stats);
+  void GetStats(AllocatorStats* stats) override;
 
   void* Reserve(size_t size) override;
 
+  // Returns the free pages of the calling thread's heap to the OS. Set the session config
+  // session.arena.shrink_interval_runs to "1" to do so at the end of every Run().
+  Status Shrink() override;
+
   size_t Used() const override;
 
   size_t Max() const override {
@@ -31,6 +39,7 @@ class MiMallocArena : public IArenaAllocator {
 
   OrtMemoryInfo info_;
   AllocatorStats stats_;
+  std::atomic<int64_t> num_shrinks_{0};
 };
 }  // namespace onnxruntime
 #endif
@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/node_latency_stats.h"
+
+#include <sstream>
+#include <unordered_map>
+
+#include "core/common/make_unique.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+NodeLatencyStats::NodeLatencyStats(const GraphViewer& graph_viewer, uint64_t sample_interval_runs)
+    : sample_interval_runs_(sample_interval_runs) {
+  ORT_ENFORCE(sample_interval_runs_ > 0, "The sample interval must be positive.");
+
+  std::unordered_map<std::string, size_t> op_type_indexes;
+  nodes_.resize(static_cast<size_t>(graph_viewer.MaxNodeIndex()));
+  for (const auto& node : graph_viewer.Nodes()) {
+    auto entry = op_type_indexes.find(node.OpType());
+    if (entry == op_type_indexes.end()) {
+      entry = op_type_indexes.emplace(node.OpType(), op_types_.size()).first;
+      op_types_.push_back(onnxruntime::make_unique<OpTypeEntry>());
+      op_types_.back()->op_type = node.OpType();
+    }
+
+    auto node_entry = onnxruntime::make_unique<NodeEntry>();
+    node_entry->name = node.Name().empty() ? node.OpType() + "_" + std::to_string(node.Index()) : node.Name();
+    node_entry->op_type_index = entry->second;
+    nodes_[node.Index()] = std::move(node_entry);
+  }
+}
+
+static void WriteHistogram(std::ostream& os, const profiling::LatencyHistogram& histogram) {
+  const uint64_t count = histogram.Count();
+  os << "\"count\" : " << count
+     << ", \"mean_us\" : " << (count == 0 ? 0.0 : histogram.SumNs() / 1000.0 / count)
+     << ", \"p50_us\" : " << histogram.Percentile(0.5) / 1000.0
+     << ", \"p99_us\" : " << histogram.Percentile(0.99) / 1000.0;
+}
+
+std::string NodeLatencyStats::ToJson() const {
+  const uint64_t num_runs = run_counter_.load(std::memory_order_relaxed);
+
+  std::ostringstream os;
+  os << "{\"sampled_runs\" : " << (num_runs + sample_interval_runs_ - 1) / sample_interval_runs_;
+
+  os << ", \"nodes\" : [";
+  bool is_first = true;
+  for (const auto& node : nodes_) {
+    if (!node || node->histogram.Count() == 0) {
+      continue;
+    }
+
+    os << (is_first ? "" : ", ") << "{\"name\" : \"" << node->name << "\", \"op_type\" : \""
+       << op_types_[node->op_type_index]->op_type << "\", ";
+    WriteHistogram(os, node->histogram);
+    os << "}";
+    is_first = false;
+  }
+
+  os << "], \"op_types\" : [";
+  is_first = true;
+  for (const auto& op_type : op_types_) {
+    if (op_type->histogram.Count() == 0) {
+      continue;
+    }
+
+    os << (is_first ? "" : ", ") << "{\"op_type\" : \"" << op_type->op_type << "\", ";
+    WriteHistogram(os, op_type->histogram);
+    os << "}";
+    is_first = false;
+  }
+
+  os << "]}";
+  return os.str();
+}
+
+void NodeLatencyStats::Reset() {
+  run_counter_.store(0, std::memory_order_relaxed);
+  for (auto& node : nodes_) {
+    if (node) {
+      node->histogram.Reset();
+    }
+  }
+
+  for (auto& op_type : op_types_) {
+    op_type->histogram.Reset();
+  }
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/latency_histogram.h"
+#include "core/graph/basic_types.h"
+
+namespace onnxruntime {
+class GraphViewer;
+
+/**
+ * Aggregated kernel latencies of the nodes of a graph, per node and per op type, collected from 1 in N runs.
+ * The set of nodes is fixed at construction so recording takes no lock and uses a bounded amount of memory
+ * regardless of how many runs are sampled.
+ */
+class NodeLatencyStats {
+ public:
+  NodeLatencyStats(const GraphViewer& graph_viewer, uint64_t sample_interval_runs);
+
+  /** Called once per run. Returns true if the kernel latencies of this run should be recorded. */
+  bool SampleRun() {
+    return run_counter_.fetch_add(1, std::memory_order_relaxed) % sample_interval_runs_ == 0;
+  }
+
+  void Record(NodeIndex node_index, uint64_t duration_ns) {
+    if (node_index >= nodes_.size() || !nodes_[node_index]) {
+      return;
+    }
+
+    NodeEntry& entry = *nodes_[node_index];
+    entry.histogram.Record(duration_ns);
+    op_types_[entry.op_type_index]->histogram.Record(duration_ns);
+  }
+
+  /**
+   * Returns the statistics as JSON: the number of sampled runs, and for each node and op type that was sampled the
+   * number of samples and the mean, p50 and p99 latencies in microseconds.
+   */
+  std::string ToJson() const;
+
+  void Reset();
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(NodeLatencyStats);
+
+  struct NodeEntry {
+    std::string name;
+    size_t op_type_index;
+    profiling::LatencyHistogram histogram;
+  };
+
+  struct OpTypeEntry {
+    std::string op_type;
+    profiling::LatencyHistogram histogram;
+  };
+
+  const uint64_t sample_interval_runs_;
+  std::atomic<uint64_t> run_counter_{0};
+
+  // indexed by NodeIndex. null for the indexes of removed nodes.
+  std::vector<std::unique_ptr<NodeEntry>> nodes_;
+  std::vector<std::unique_ptr<OpTypeEntry>> op_types_;
+};
+
+}  // namespace onnxruntime
@@ -33,6 +33,18 @@ Tensor* OpKernelContext::Output(int index, const std::initializer_list<int64_t>&
   return Output(index, TensorShape(shape));
 }
 
+Tensor* OpKernelContext::OutputView(int index, int input_index, const TensorShape& shape, ptrdiff_t byte_offset) {
+  if (index < 0 || index >= OutputCount() || input_index < 0 || input_index >= InputCount())
+    return nullptr;
+
+  OrtValue* p_ml_value = nullptr;
+  Status status = execution_frame_->TryCreateNodeOutputMLValueView(GetOutputArgIndex(index),
+                                                                   GetInputArgIndex(input_index),
+                                                                   shape, byte_offset, p_ml_value);
+  ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
+  return p_ml_value ? p_ml_value->GetMutable<Tensor>() : nullptr;
+}
+
 SparseTensor* OpKernelContext::Output(int index, size_t nnz, const TensorShape& shape) {
   auto p_ml_value = OutputMLValue(index, shape, nnz);
   return p_ml_value ? p_ml_value->GetMutable<SparseTensor>() : nullptr;
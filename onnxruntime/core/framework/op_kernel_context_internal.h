@@ -4,6 +4,7 @@
 #pragma once
 
 #include <functional>
+#include "core/framework/iexecutor.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
 #include "core/session/onnxruntime_c_api.h"
@@ -21,10 +22,13 @@ class OpKernelContextInternal : public OpKernelContext {
                                    IExecutionFrame& frame,
                                    const OpKernel& kernel,
                                    const logging::Logger& logger,
-                                   const bool& terminate_flag)
-      : OpKernelContext(&frame, &kernel, session_state.GetThreadPool(), logger),
+                                   const bool& terminate_flag,
+                                   const ExecutionThreadPools* thread_pools = nullptr)
+      : OpKernelContext(&frame, &kernel,
+                        thread_pools ? thread_pools->intra_op_thread_pool : session_state.GetThreadPool(), logger),
         session_state_(session_state),
-        terminate_flag_(terminate_flag) {
+        terminate_flag_(terminate_flag),
+        thread_pools_(thread_pools) {
     const auto& implicit_inputs = kernel.Node().ImplicitInputDefs();
     int num_implicit_inputs = static_cast<int>(implicit_inputs.size());
     implicit_input_values_.reserve(num_implicit_inputs);
@@ -64,9 +68,13 @@ class OpKernelContextInternal : public OpKernelContext {
 
   const bool& GetTerminateFlag() const noexcept { return terminate_flag_; }
 
+  // The thread pools the kernel runs on if they are not the ones of the session state, so subgraphs run on them too.
+  const ExecutionThreadPools* GetThreadPools() const noexcept { return thread_pools_; }
+
  private:
   const SessionState& session_state_;
   const bool& terminate_flag_;
+  const ExecutionThreadPools* thread_pools_;
   std::vector<const OrtValue*> implicit_input_values_;
 };
 
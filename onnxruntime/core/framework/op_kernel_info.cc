@@ -14,7 +14,8 @@ OpKernelInfo::OpKernelInfo(const onnxruntime::Node& node,
                            const std::unordered_map<int, OrtValue>& constant_initialized_tensors,
                            const OrtValueNameIdxMap& ort_value_name_idx_map,
                            const FuncManager& funcs_mgr,
-                           const DataTransferManager& data_transfer_mgr)
+                           const DataTransferManager& data_transfer_mgr,
+                           const std::unordered_map<std::string, std::string>* session_configurations)
     : OpNodeProtoHelper(&proto_helper_context_),
       node_(node),
       kernel_def_(kernel_def),
@@ -23,11 +24,13 @@ OpKernelInfo::OpKernelInfo(const onnxruntime::Node& node,
       ort_value_name_idx_map_(ort_value_name_idx_map),
       funcs_mgr_(funcs_mgr),
       data_transfer_mgr_(data_transfer_mgr),
+      session_configurations_(session_configurations),
       proto_helper_context_(node) {}
 
 OpKernelInfo::OpKernelInfo(const OpKernelInfo& other)
     : OpKernelInfo(other.node_, other.kernel_def_, *other.execution_provider_, other.constant_initialized_tensors_,
-                   other.ort_value_name_idx_map_, other.funcs_mgr_, other.data_transfer_mgr_) {}
+                   other.ort_value_name_idx_map_, other.funcs_mgr_, other.data_transfer_mgr_,
+                   other.session_configurations_) {}
 
 const OrtMemoryInfo& OpKernelInfo::GetMemoryInfo(int device_id, OrtMemType mem_type) const {
   AllocatorPtr alloc = GetAllocator(device_id, mem_type);
@@ -82,4 +85,13 @@ bool OpKernelInfo::TryGetConstantInput(int input_index, const Tensor** constant_
 common::Status OpKernelInfo::GetFusedFuncs(NodeComputeInfo*& compute_info) const {
   return funcs_mgr_.GetFuncs(node_.Name(), compute_info);
 }
+
+std::string OpKernelInfo::GetConfigOrDefault(const std::string& config_key, const std::string& default_value) const {
+  if (session_configurations_ == nullptr) {
+    return default_value;
+  }
+
+  auto entry = session_configurations_->find(config_key);
+  return entry != session_configurations_->cend() ? entry->second : default_value;
+}
 }  // namespace onnxruntime
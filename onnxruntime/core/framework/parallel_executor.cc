@@ -9,17 +9,19 @@
 #include <vector>
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
+#include "core/common/trace_sink.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_frame.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/run_latency_breakdown.h"
 #include "core/framework/utils.h"
 #include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
 ParallelExecutor::ParallelExecutor(const SessionState& session_state, const bool& terminate_flag)
-    : out_standings_(0), terminate_flag_(terminate_flag), executor_pool_(session_state.GetInterOpThreadPool()) {
+    : out_standings_(0), terminate_flag_(terminate_flag) {
   const auto& graph_viewer = session_state.GetGraphViewer();
   node_refs_.resize(graph_viewer.MaxNodeIndex());
   for (auto& node : graph_viewer.Nodes()) {
@@ -32,14 +34,20 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
                                  std::vector<OrtValue>& fetches,
                                  const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
                                  const logging::Logger& logger) {
+  executor_pool_ = thread_pools_ ? thread_pools_->inter_op_thread_pool : session_state.GetInterOpThreadPool();
+
   TimePoint tp;
   const bool is_profiler_enabled = session_state.Profiler().IsEnabled();
   if (is_profiler_enabled) {
     tp = session_state.Profiler().StartTime();
   }
 
+  const auto frame_begin_time = std::chrono::steady_clock::now();
   root_frame_ = onnxruntime::make_unique<ExecutionFrame>(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches,
                                                          fetch_allocators, session_state);
+  if (latency_breakdown_) {
+    latency_breakdown_->frame_setup_ns += RunLatencyBreakdown::ElapsedNs(frame_begin_time);
+  }
   //std::cout << "start nodes:" << std::endl;
   for (auto node_index : session_state.GetGraphViewer().GetRootNodes()) {
     auto p_op_kernel = session_state.GetKernel(node_index);
@@ -52,8 +60,12 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
 
   // Wait for finish.
   {
+    const auto wait_begin_time = std::chrono::steady_clock::now();
     std::unique_lock<OrtMutex> lock(complete_mutex_);
     while (out_standings_ > 0) complete_cv_.wait(lock);
+    if (latency_breakdown_) {
+      latency_breakdown_->inter_op_wait_ns += RunLatencyBreakdown::ElapsedNs(wait_begin_time);
+    }
   }
 
   Status status = Status::OK();
@@ -81,7 +93,7 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
   ORT_RETURN_IF_ERROR(root_frame_->GetOutputs(fetches));
   VLOGS(logger, 1) << "Done execution.";
 
-  if (root_frame_->HasMemoryPatternPlanner()) {
+  if (root_frame_->HasMemoryPatternPlanner() || root_frame_->MemoryPatternNeedsRegeneration()) {
     std::vector<std::reference_wrapper<const TensorShape>> input_shapes;
     bool all_tensors = true;
     for (const auto& feed : feeds) {
@@ -94,9 +106,15 @@ Status ParallelExecutor::Execute(const SessionState& session_state, const std::v
     }
 
     if (all_tensors) {
-      auto mem_patterns = onnxruntime::make_unique<MemoryPatternGroup>();
-      ORT_RETURN_IF_ERROR(root_frame_->GeneratePatterns(mem_patterns.get()));
-      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, std::move(mem_patterns)));
+      if (root_frame_->HasMemoryPatternPlanner()) {
+        auto mem_patterns = onnxruntime::make_unique<MemoryPatternGroup>();
+        ORT_RETURN_IF_ERROR(root_frame_->GeneratePatterns(mem_patterns.get()));
+        ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, std::move(mem_patterns)));
+      } else {
+        // the cached pattern for these shapes doesn't fit the actual tensor sizes. drop it so the next execution
+        // generates a new pattern with the current shapes.
+        session_state.InvalidateMemoryPatternGroup(input_shapes);
+      }
     }
   }
 
@@ -131,6 +149,11 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
       ORT_THROW("Exiting due to terminate flag being set to true.");
     }
 
+    if (IsDeadlinePassed()) {
+      LOGS(logger, WARNING) << "Exiting due to the run deadline being passed.";
+      ORT_THROW("Exiting due to the run deadline being passed.");
+    }
+
     const auto* p_op_kernel = session_state.GetKernel(node_index);
     const auto& node = *graph_viewer.GetNode(node_index);
 
@@ -139,7 +162,8 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
       ORT_THROW("Got nullptr from GetKernel for node: ", node.Name());
     }
 
-    OpKernelContextInternal op_kernel_context(session_state, *root_frame_, *p_op_kernel, logger, terminate_flag_);
+    OpKernelContextInternal op_kernel_context(session_state, *root_frame_, *p_op_kernel, logger, terminate_flag_,
+                                              thread_pools_);
 
     if (f_profiler_enabled) {
       sync_time_begin = session_state.Profiler().StartTime();
@@ -189,6 +213,11 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
     // call compute on the kernel
     VLOGS(logger, 1) << "Computing kernel: " << node.Name();
 
+    std::chrono::steady_clock::time_point compute_begin_time;
+    if (latency_breakdown_) {
+      compute_begin_time = std::chrono::steady_clock::now();
+    }
+
     // Execute the kernel.
     ORT_TRY {
 #ifdef ENABLE_TRAINING
@@ -197,6 +226,8 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
       }
 #endif
 
+      tracing::TraceRange trace_range(tracing::Category::kNode, node.Name().c_str(), node.OpType().c_str());
+      concurrency::ThreadPool::CallSiteScope call_site(node.OpType().c_str());
       status = p_op_kernel->Compute(&op_kernel_context);
     }
     ORT_CATCH(const std::exception& ex) {
@@ -215,6 +246,12 @@ Status ParallelExecutor::RunNodeAsync(size_t p_node_index,
       break;
     }
 
+    if (latency_breakdown_) {
+      const int64_t duration_ns = RunLatencyBreakdown::ElapsedNs(compute_begin_time);
+      std::lock_guard<OrtMutex> lock(latency_breakdown_mutex_);
+      latency_breakdown_->RecordNode(node.OpType(), node.GetExecutionProviderType(), duration_ns);
+    }
+
     if (f_profiler_enabled) {
       session_state.Profiler().EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                                      node.Name() + "_kernel_time",
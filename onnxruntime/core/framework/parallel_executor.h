@@ -58,9 +58,10 @@ class ParallelExecutor : public IExecutor {
   OrtMutex complete_mutex_;
   OrtCondVar complete_cv_;
   std::vector<Status> errors_;
+  OrtMutex latency_breakdown_mutex_;  // the nodes record their kernel times concurrently
 
   const bool& terminate_flag_;
   // TODO: Temporary threadpool for the executor.  This is a costly way to handle the problem.
-  onnxruntime::concurrency::ThreadPool* const executor_pool_{};
+  onnxruntime::concurrency::ThreadPool* executor_pool_{};
 };
 }  // namespace onnxruntime
@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "core/framework/murmurhash3.h"
+
+namespace onnxruntime {
+
+uint64_t PrePackedWeights::GetHash() const {
+  ORT_ENFORCE(buffers_.size() == buffer_sizes_.size());
+
+  uint32_t hash[4] = {0, 0, 0, 0};
+
+  auto hash_bytes = [&hash](const void* data, size_t len) {
+    // MurmurHash3 takes an int length so hash large buffers in chunks
+    constexpr size_t max_chunk = static_cast<size_t>(std::numeric_limits<int>::max());
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    do {
+      const size_t chunk = std::min(len, max_chunk);
+      MurmurHash3::x86_128(bytes, static_cast<int>(chunk), hash[0], &hash);
+      bytes += chunk;
+      len -= chunk;
+    } while (len > 0);
+  };
+
+  for (size_t i = 0; i < buffers_.size(); ++i) {
+    const size_t size = buffer_sizes_[i];
+    hash_bytes(&size, sizeof(size));
+    if (buffers_[i] != nullptr && size != 0) {
+      hash_bytes(buffers_[i].get(), size);
+    }
+  }
+
+  return static_cast<uint64_t>(hash[0]) | (static_cast<uint64_t>(hash[1]) << 32);
+}
+
+bool PrePackedWeights::HasSameContents(const PrePackedWeights& other) const {
+  if (buffer_sizes_ != other.buffer_sizes_ || buffers_.size() != other.buffers_.size()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < buffers_.size(); ++i) {
+    const void* a = buffers_[i].get();
+    const void* b = other.buffers_[i].get();
+    if ((a == nullptr) != (b == nullptr)) {
+      return false;
+    }
+
+    if (a != nullptr && a != b && std::memcmp(a, b, buffer_sizes_[i]) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace onnxruntime
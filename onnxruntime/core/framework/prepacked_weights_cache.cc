@@ -0,0 +1,188 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_cache.h"
+
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <vector>
+
+namespace onnxruntime {
+
+namespace {
+
+constexpr char kMagic[8] = {'O', 'R', 'T', 'P', 'P', 'W', '\0', '\0'};
+constexpr uint32_t kFormatVersion = 1;
+constexpr uint64_t kBufferAlignment = 64;
+
+uint64_t AlignBufferOffset(uint64_t offset) {
+  return (offset + kBufferAlignment - 1) / kBufferAlignment * kBufferAlignment;
+}
+
+// Reads the values of the index of the file, checking that they are within its bounds
+class IndexReader {
+ public:
+  IndexReader(const char* data, size_t length) : data_(data), length_(length) {}
+
+  template <typename T>
+  bool Read(T& value) {
+    if (length_ - offset_ < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, data_ + offset_, sizeof(T));
+    offset_ += sizeof(T);
+    return true;
+  }
+
+  bool Read(std::string& value, size_t length) {
+    if (length_ - offset_ < length) {
+      return false;
+    }
+    value.assign(data_ + offset_, length);
+    offset_ += length;
+    return true;
+  }
+
+ private:
+  const char* data_;
+  size_t length_;
+  size_t offset_{0};
+};
+
+}  // namespace
+
+Status PrePackedWeightsCache::Load(const PathString& file_path, std::unique_ptr<PrePackedWeightsCache>& cache) {
+  size_t length = 0;
+  ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(file_path.c_str(), length));
+  ORT_RETURN_IF(length < sizeof(kMagic), "The pre-packed weights file is truncated.");
+
+  auto loaded = onnxruntime::make_unique<PrePackedWeightsCache>();
+  ORT_RETURN_IF_ERROR(Env::Default().MapFileIntoMemory(file_path.c_str(), 0, length, loaded->mapped_memory_));
+  const char* data = loaded->mapped_memory_.get();
+
+  IndexReader reader(data, length);
+  char magic[sizeof(kMagic)];
+  uint32_t version = 0;
+  uint32_t num_entries = 0;
+  for (char& c : magic) {
+    ORT_RETURN_IF_NOT(reader.Read(c), "The pre-packed weights file is truncated.");
+  }
+  ORT_RETURN_IF(std::memcmp(magic, kMagic, sizeof(kMagic)) != 0, "The file doesn't contain pre-packed weights.");
+  ORT_RETURN_IF_NOT(reader.Read(version) && reader.Read(num_entries), "The pre-packed weights file is truncated.");
+  ORT_RETURN_IF(version != kFormatVersion, "Unsupported pre-packed weights file format version ", version);
+
+  for (uint32_t i = 0; i < num_entries; ++i) {
+    uint32_t key_length = 0;
+    std::string key;
+    uint32_t num_buffers = 0;
+    ORT_RETURN_IF_NOT(reader.Read(key_length) && reader.Read(key, key_length) && reader.Read(num_buffers),
+                      "The pre-packed weights file is truncated.");
+
+    std::vector<BufferView> buffers;
+    buffers.reserve(num_buffers);
+    for (uint32_t j = 0; j < num_buffers; ++j) {
+      uint64_t offset = 0;
+      uint64_t size = 0;
+      ORT_RETURN_IF_NOT(reader.Read(offset) && reader.Read(size), "The pre-packed weights file is truncated.");
+      ORT_RETURN_IF(offset > length || size > length - offset, "The pre-packed weights file is truncated.");
+      buffers.push_back(BufferView{size == 0 ? nullptr : data + offset, static_cast<size_t>(size)});
+    }
+
+    loaded->loaded_weights_[key] = std::move(buffers);
+  }
+
+  cache = std::move(loaded);
+  return Status::OK();
+}
+
+void PrePackedWeightsCache::Add(const std::string& key, std::shared_ptr<const PrePackedWeights> weights) {
+  ORT_ENFORCE(!IsLoaded(), "Pre-packed weights can't be added to loaded weights.");
+  added_weights_[key] = std::move(weights);
+}
+
+bool PrePackedWeightsCache::Get(const std::string& key, PrePackedWeights& weights) const {
+  auto entry = loaded_weights_.find(key);
+  if (entry == loaded_weights_.end()) {
+    return false;
+  }
+
+  weights.buffers_.clear();
+  weights.buffer_sizes_.clear();
+  for (const auto& buffer : entry->second) {
+    // the kernels don't modify the pre-packed buffers, and the mapping is copy-on-write
+    weights.buffers_.emplace_back(const_cast<void*>(buffer.data), BufferDeleter());
+    weights.buffer_sizes_.push_back(buffer.size);
+  }
+
+  return true;
+}
+
+Status PrePackedWeightsCache::Save(const PathString& file_path) const {
+  // the entries are sorted so that the same weights always produce the same file
+  const std::map<std::string, const PrePackedWeights*> entries = [this]() {
+    std::map<std::string, const PrePackedWeights*> sorted_entries;
+    for (const auto& entry : added_weights_) {
+      sorted_entries.emplace(entry.first, entry.second.get());
+    }
+    return sorted_entries;
+  }();
+
+  uint64_t index_size = sizeof(kMagic) + 2 * sizeof(uint32_t);
+  for (const auto& entry : entries) {
+    index_size += 2 * sizeof(uint32_t) + entry.first.size() + entry.second->buffers_.size() * 2 * sizeof(uint64_t);
+  }
+
+  std::ofstream file(file_path, std::ios::binary);
+  ORT_RETURN_IF_NOT(file, "Failed to open the pre-packed weights file for writing.");
+
+  auto write = [&file](const void* data, size_t size) {
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+  };
+
+  const uint32_t num_entries = static_cast<uint32_t>(entries.size());
+  write(kMagic, sizeof(kMagic));
+  write(&kFormatVersion, sizeof(kFormatVersion));
+  write(&num_entries, sizeof(num_entries));
+
+  uint64_t offset = AlignBufferOffset(index_size);
+  for (const auto& entry : entries) {
+    const PrePackedWeights& weights = *entry.second;
+    ORT_RETURN_IF_NOT(weights.buffers_.size() == weights.buffer_sizes_.size(),
+                      "Invalid pre-packed weights for ", entry.first);
+
+    const uint32_t key_length = static_cast<uint32_t>(entry.first.size());
+    const uint32_t num_buffers = static_cast<uint32_t>(weights.buffers_.size());
+    write(&key_length, sizeof(key_length));
+    write(entry.first.data(), entry.first.size());
+    write(&num_buffers, sizeof(num_buffers));
+    for (size_t i = 0; i < weights.buffers_.size(); ++i) {
+      const uint64_t size = weights.buffers_[i] != nullptr ? weights.buffer_sizes_[i] : 0;
+      write(&offset, sizeof(offset));
+      write(&size, sizeof(size));
+      offset = AlignBufferOffset(offset + size);
+    }
+  }
+
+  uint64_t written = index_size;
+  const char padding[kBufferAlignment] = {};
+  for (const auto& entry : entries) {
+    const PrePackedWeights& weights = *entry.second;
+    for (size_t i = 0; i < weights.buffers_.size(); ++i) {
+      if (weights.buffers_[i] == nullptr) {
+        continue;
+      }
+
+      write(padding, static_cast<size_t>(AlignBufferOffset(written) - written));
+      written = AlignBufferOffset(written);
+      write(weights.buffers_[i].get(), weights.buffer_sizes_[i]);
+      written += weights.buffer_sizes_[i];
+    }
+  }
+
+  file.flush();
+  ORT_RETURN_IF_NOT(file, "Failed to write the pre-packed weights file.");
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
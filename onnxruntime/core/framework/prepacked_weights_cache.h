@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/common/path_string.h"
+#include "core/framework/prepacked_weights.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+/**
+ * The pre-packed weights of the kernels of a session, saved to a file so that a later session of the same model
+ * can use them instead of pre-packing its initializers again.
+ *
+ * An instance either collects the pre-packed weights of a session with Add so they can be saved, or refers to the
+ * weights of a loaded file. The file is memory mapped, and the loaded buffers point into the mapping, so an instance
+ * with loaded weights must outlive the kernels using them.
+ *
+ * File format, in the native byte order as the packed formats are specific to the machine:
+ *   char[8] magic "ORTPPW\0\0", uint32 format version, uint32 number of entries,
+ *   for each entry: uint32 key length, key, uint32 number of buffers, for each buffer: uint64 offset, uint64 size,
+ *   followed by the contents of the buffers at their offsets from the start of the file, each aligned to 64 bytes.
+ */
+class PrePackedWeightsCache final {
+ public:
+  PrePackedWeightsCache() = default;
+
+  /**
+  Load the pre-packed weights saved to a file.
+  Fails if the file can't be mapped or doesn't have the expected format.
+  */
+  static common::Status Load(const PathString& file_path, std::unique_ptr<PrePackedWeightsCache>& cache);
+
+  // Whether the instance refers to the weights of a loaded file, or collects the weights to save.
+  bool IsLoaded() const noexcept { return mapped_memory_ != nullptr; }
+
+  // Add the pre-packed weights of the session for a key. The weights must remain valid until Save is called.
+  void Add(const std::string& key, std::shared_ptr<const PrePackedWeights> weights);
+
+  /**
+  Get the loaded pre-packed weights for a key.
+  @param weights Set to non-owning pointers to the loaded buffers.
+  @returns false if there are no weights for the key.
+  */
+  bool Get(const std::string& key, PrePackedWeights& weights) const;
+
+  // Save the weights that were added.
+  common::Status Save(const PathString& file_path) const;
+
+  size_t GetNumberOfEntries() const noexcept {
+    return IsLoaded() ? loaded_weights_.size() : added_weights_.size();
+  }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrePackedWeightsCache);
+
+  struct BufferView {
+    const void* data;
+    size_t size;
+  };
+
+  std::unordered_map<std::string, std::shared_ptr<const PrePackedWeights>> added_weights_;
+
+  Env::MappedMemoryPtr mapped_memory_;
+  std::unordered_map<std::string, std::vector<BufferView>> loaded_weights_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_container.h"
+
+namespace onnxruntime {
+
+// use a plain CPU allocator rather than an arena so the memory is returned as soon as an entry is released
+PrepackedWeightsContainer::PrepackedWeightsContainer() : allocator_(std::make_shared<TAllocator>()) {
+}
+
+std::shared_ptr<const PrePackedWeights> PrepackedWeightsContainer::GetOrAdd(const std::string& key,
+                                                                            PrePackedWeights&& weights) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  auto it = weights_.find(key);
+  if (it != weights_.end()) {
+    auto existing = it->second.lock();
+    if (existing) {
+      if (existing->HasSameContents(weights)) {
+        ++num_shared_uses_;
+        return existing;
+      }
+
+      return std::make_shared<const PrePackedWeights>(std::move(weights));
+    }
+  }
+
+  // drop entries that are no longer in use
+  for (auto cur = weights_.begin(); cur != weights_.end();) {
+    if (cur->second.expired()) {
+      cur = weights_.erase(cur);
+    } else {
+      ++cur;
+    }
+  }
+
+  auto added = std::make_shared<const PrePackedWeights>(std::move(weights));
+  weights_[key] = added;
+  return added;
+}
+
+size_t PrepackedWeightsContainer::GetNumberOfElements() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  size_t num_elements = 0;
+  for (const auto& entry : weights_) {
+    if (!entry.second.expired()) {
+      ++num_elements;
+    }
+  }
+
+  return num_elements;
+}
+
+size_t PrepackedWeightsContainer::GetNumberOfSharedUses() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return num_shared_uses_;
+}
+
+}  // namespace onnxruntime
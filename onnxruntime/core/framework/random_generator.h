@@ -7,8 +7,6 @@
 #include <stdint.h>
 #include <utility>
 
-#include "core/platform/ort_mutex.h"
-
 namespace onnxruntime {
 
 /**
@@ -47,29 +45,29 @@ class RandomGenerator {
 /**
  * Philox pseudo-random number generator.  Philox uses a counter-based design.
  * This generator provides the seed and counter to initialize a Philox random
- * engine such as the CUDA Philox_4x32_10 generator.
+ * engine such as the CUDA Philox_4x32_10 generator or Philox4x32 on the CPU.
+ * The counters are reserved without a lock, so kernels sharing a generator can
+ * run concurrently and generate their values in parallel.
  */
 class PhiloxGenerator {
  public:
   explicit PhiloxGenerator(uint64_t seed) : seed_(seed), offset_(0) {}
 
   /**
-   * Resets the seed and offset.
+   * Resets the seed and offset. Not meant to be called while other threads
+   * get seeds from the generator.
    */
   void SetSeed(uint64_t seed) {
-    std::lock_guard<OrtMutex> lock(mutex_);
-    seed_ = seed;
-    offset_ = 0;
+    seed_.store(seed);
+    offset_.store(0);
   }
 
   /**
    * Gets the seed and offset pair, incrementing the offset by the specified count.
    */
   std::pair<uint64_t, uint64_t> NextPhiloxSeeds(uint64_t count) {
-    std::lock_guard<OrtMutex> lock(mutex_);
-    auto seeds = std::make_pair(seed_, offset_);
-    offset_ += count;
-    return seeds;
+    const uint64_t offset = offset_.fetch_add(count);
+    return std::make_pair(seed_.load(), offset);
   }
 
   /**
@@ -79,9 +77,8 @@ class PhiloxGenerator {
   static PhiloxGenerator& Default();
 
  private:
-  OrtMutex mutex_;
-  uint64_t seed_;
-  uint64_t offset_;
+  std::atomic<uint64_t> seed_;
+  std::atomic<uint64_t> offset_;
 };
 
 }  // namespace onnxruntime
@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/run_latency_breakdown.h"
+
+#include <sstream>
+
+namespace onnxruntime {
+
+std::string RunLatencyBreakdown::ToJson() const {
+  const auto us = [](int64_t ns) { return ns / 1000.0; };
+
+  int64_t total_kernel_ns = 0;
+  for (const auto& entry : kernel_ns) {
+    total_kernel_ns += entry.second;
+  }
+
+  std::ostringstream os;
+  os << "{\"queue_us\" : " << us(queue_ns)
+     << ", \"total_us\" : " << us(total_ns)
+     << ", \"validation_us\" : " << us(validation_ns)
+     << ", \"input_copy_us\" : " << us(input_copy_ns)
+     << ", \"frame_setup_us\" : " << us(frame_setup_ns)
+     << ", \"kernel_us\" : " << us(total_kernel_ns)
+     << ", \"kernel_us_per_provider\" : {";
+  bool is_first = true;
+  for (const auto& entry : kernel_ns) {
+    os << (is_first ? "" : ", ") << "\"" << entry.first << "\" : " << us(entry.second);
+    is_first = false;
+  }
+  os << "}"
+     << ", \"memcpy_us\" : " << us(memcpy_ns)
+     << ", \"memcpy_nodes\" : " << num_memcpy_nodes
+     << ", \"output_copy_us\" : " << us(output_copy_ns)
+     << ", \"inter_op_wait_us\" : " << us(inter_op_wait_ns)
+     << "}";
+  return os.str();
+}
+
+}  // namespace onnxruntime
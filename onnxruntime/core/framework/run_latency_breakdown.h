@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+ * Where the time of a single Run call went. Collected when the run options request it, which costs a clock read
+ * per phase and per node rather than what full profiling costs. The durations are in nanoseconds.
+ */
+struct RunLatencyBreakdown {
+  // RunAsync: from the call to the start of the run on the thread pool
+  int64_t queue_ns{0};
+  // the whole Run call, excluding queue_ns
+  int64_t total_ns{0};
+  // validation of the feeds and fetches against the model, and the setup of the feeds/fetches manager
+  int64_t validation_ns{0};
+  // the copies of the feeds to the devices the nodes consuming them run on
+  int64_t input_copy_ns{0};
+  // the creation of the execution frame, i.e. the OrtValues of the run and the memory pattern allocation
+  int64_t frame_setup_ns{0};
+  // the Compute calls of the nodes other than the memcpy nodes, per execution provider
+  std::map<std::string, int64_t> kernel_ns;
+  // the Compute calls of the MemcpyFromHost/MemcpyToHost nodes inserted between the execution providers
+  int64_t memcpy_ns{0};
+  int64_t num_memcpy_nodes{0};
+  // the copies of the fetches to the devices the caller requested
+  int64_t output_copy_ns{0};
+  // parallel execution modes: the time the calling thread waited for the nodes run by the inter-op thread pool
+  int64_t inter_op_wait_ns{0};
+
+  void RecordNode(const std::string& op_type, const std::string& execution_provider, int64_t duration_ns) {
+    if (op_type == "MemcpyFromHost" || op_type == "MemcpyToHost") {
+      memcpy_ns += duration_ns;
+      ++num_memcpy_nodes;
+    } else {
+      kernel_ns[execution_provider] += duration_ns;
+    }
+  }
+
+  /** Returns the breakdown as JSON, with the durations in microseconds. */
+  std::string ToJson() const;
+
+  static int64_t ElapsedNs(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+  }
+};
+
+/**
+ * The breakdown of the last run made with a RunOptions instance that requested one. Each run collects its
+ * breakdown separately and stores it on completion, so runs sharing the run options do not corrupt each other.
+ */
+class RunLatencyBreakdownRecord {
+ public:
+  RunLatencyBreakdownRecord() = default;
+
+  void Set(RunLatencyBreakdown breakdown) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    breakdown_ = std::move(breakdown);
+    has_breakdown_ = true;
+  }
+
+  /** Returns false if no run completed yet. */
+  bool Get(RunLatencyBreakdown& breakdown) const {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    breakdown = breakdown_;
+    return has_breakdown_;
+  }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunLatencyBreakdownRecord);
+
+  mutable OrtMutex mutex_;
+  RunLatencyBreakdown breakdown_;
+  bool has_breakdown_{false};
+};
+
+}  // namespace onnxruntime
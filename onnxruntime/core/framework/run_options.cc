@@ -2,9 +2,11 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 #include "core/framework/run_options.h"
+#include <cstring>
 #include "core/session/onnxruntime_c_api.h"
 #include "core/session/ort_apis.h"
 #include "core/framework/error_code_helper.h"
+#include "core/framework/run_latency_breakdown.h"
 
 ORT_API_STATUS_IMPL(OrtApis::CreateRunOptions, _Outptr_ OrtRunOptions** out) {
   API_IMPL_BEGIN
@@ -53,3 +55,51 @@ ORT_API_STATUS_IMPL(OrtApis::RunOptionsUnsetTerminate, _Inout_ OrtRunOptions* op
   options->terminate = false;
   return nullptr;
 }
+
+ORT_API_STATUS_IMPL(OrtApis::RunOptionsSetIntraOpNumThreads, _Inout_ OrtRunOptions* options,
+                    int intra_op_num_threads) {
+  if (intra_op_num_threads < 0) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "intra_op_num_threads must not be negative");
+  }
+  options->intra_op_num_threads = intra_op_num_threads;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunOptionsSetTimeout, _Inout_ OrtRunOptions* options, int64_t timeout_ms) {
+  if (timeout_ms < 0) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "timeout_ms must not be negative");
+  }
+  options->timeout_ms = timeout_ms;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunOptionsEnableLatencyBreakdown, _Inout_ OrtRunOptions* options, int enable) {
+  API_IMPL_BEGIN
+  if (!enable) {
+    options->latency_breakdown.reset();
+  } else if (!options->latency_breakdown) {
+    options->latency_breakdown = std::make_shared<onnxruntime::RunLatencyBreakdownRecord>();
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunOptionsGetLatencyBreakdown, _In_ const OrtRunOptions* options,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  if (!options->latency_breakdown) {
+    return OrtApis::CreateStatus(ORT_FAIL, "The latency breakdown is not enabled for these run options.");
+  }
+
+  onnxruntime::RunLatencyBreakdown breakdown;
+  if (!options->latency_breakdown->Get(breakdown)) {
+    return OrtApis::CreateStatus(ORT_FAIL, "No run using these run options completed yet.");
+  }
+
+  const std::string json = breakdown.ToJson();
+  char* result = reinterpret_cast<char*>(allocator->Alloc(allocator, json.size() + 1));
+  memcpy(result, json.c_str(), json.size() + 1);
+  *out = result;
+  return nullptr;
+  API_IMPL_END
+}
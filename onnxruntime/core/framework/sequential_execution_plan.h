@@ -35,6 +35,10 @@ struct AllocPlanPerValue {
   // if the value is used in async kernel, a fence object would be created
   // note the fence object would be shared between MLValues reusing the same buffer
   bool create_fence_if_async{false};
+  // if set, the kernel producing the value may create it as a view of (a block of) one of its inputs at
+  // execution time instead of allocating it. The planner keeps the buffer of that input alive for as long as
+  // the value, and doesn't hand out the value's buffer for reuse (in-place or otherwise).
+  bool may_be_view{false};
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE) 
   IntervalT life_interval{0, 0};
   IntervalT allocate_interval{0, 0};
@@ -118,6 +122,10 @@ struct SequentialExecutionPlan : public ExecutionPlanBase {
   // to_be_freed: vector elements represent indices of ml-values to be freed (as described above)
   std::vector<OrtValueIndex> to_be_freed;
 
+  // Peak size in bytes of the buffers the plan allocates for node outputs, given the static shapes of the outputs.
+  // Outputs whose shape isn't known before execution aren't included.
+  size_t planned_peak_bytes{0};
+
   const OrtMemoryInfo& GetLocation(size_t ort_value_index) const override {
     return allocation_plan[ort_value_index].location;
   }
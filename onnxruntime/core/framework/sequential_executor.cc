@@ -9,11 +9,16 @@
 #include <sstream>
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
+#include "core/common/trace_sink.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/execution_frame.h"
+#include "core/framework/memory_profiler.h"
 #include "core/framework/session_state.h"
 #include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/run_latency_breakdown.h"
 #include "core/framework/utils.h"
+#include "core/platform/hardware_counters.h"
+#include "core/platform/threadpool.h"
 
 #if defined DEBUG_NODE_INPUTS_OUTPUTS
 #include "core/framework/debug_node_inputs_outputs_utils.h"
@@ -78,6 +83,70 @@ static void CalculateTotalOutputSizes(OpKernelContextInternal* op_kernel_context
   }
 }
 
+// Estimate the floating point operations of the kernels whose cost is dominated by multiply-adds from the shapes of
+// their inputs and output. Returns 0 for other kernels.
+static int64_t EstimateFlops(OpKernelContextInternal& op_kernel_context, const Node& node) {
+  const auto& op_type = node.OpType();
+  const bool is_matmul = op_type == "MatMul";
+  const bool is_gemm = op_type == "Gemm" || op_type == "FusedGemm";
+  const bool is_conv = op_type == "Conv" || op_type == "FusedConv";
+  if (!(is_matmul || is_gemm || is_conv) || op_kernel_context.InputCount() < 2 ||
+      op_kernel_context.OutputCount() < 1) {
+    return 0;
+  }
+
+  const auto* a = op_kernel_context.Input<Tensor>(0);
+  const auto* b = op_kernel_context.Input<Tensor>(1);
+  const OrtValue* p_output = op_kernel_context.GetOutputMLValue(0);
+  if (a == nullptr || b == nullptr || p_output == nullptr || !p_output->IsTensor()) {
+    return 0;
+  }
+
+  const TensorShape& output_shape = p_output->Get<Tensor>().Shape();
+  const int64_t output_size = output_shape.Size();
+  int64_t multiply_adds_per_output = 0;
+  if (is_matmul && a->Shape().NumDimensions() > 0) {
+    multiply_adds_per_output = a->Shape()[a->Shape().NumDimensions() - 1];
+  } else if (is_gemm && output_shape.NumDimensions() == 2 && output_shape[0] > 0) {
+    // A is M x K or K x M
+    multiply_adds_per_output = a->Shape().Size() / output_shape[0];
+  } else if (is_conv && b->Shape().NumDimensions() > 0 && b->Shape()[0] > 0) {
+    // W is M x C/group x kH x kW...
+    multiply_adds_per_output = b->Shape().Size() / b->Shape()[0];
+  }
+
+  return 2 * output_size * multiply_adds_per_output;
+}
+
+// Record the hardware counters of a node with the metrics derived from them.
+static void RecordHardwareCounters(profiling::Profiler& profiler, const std::string& node_name,
+                                   const TimePoint& begin_time, const HardwareCounterValues& counters,
+                                   int64_t flops) {
+  const long long duration_us = TimeDiffMicroSeconds(begin_time);
+  const double duration_ns = static_cast<double>(duration_us) * 1000;
+  // every miss of the last level cache transfers a cache line from memory
+  constexpr uint64_t kCacheLineBytes = 64;
+  const uint64_t memory_bytes = counters.cache_misses * kCacheLineBytes;
+  const double ipc = counters.cycles == 0 ? 0 : static_cast<double>(counters.instructions) / counters.cycles;
+  // bytes per ns and FLOP per ns are GB/s and GFLOP/s
+  const double memory_gb_per_s = duration_ns == 0 ? 0 : memory_bytes / duration_ns;
+  const double gflop_per_s = duration_ns == 0 ? 0 : flops / duration_ns;
+
+  profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT,
+                                 node_name + "_hw_counters",
+                                 begin_time,
+                                 {
+                                     {"instructions", std::to_string(counters.instructions)},
+                                     {"cycles", std::to_string(counters.cycles)},
+                                     {"cache_references", std::to_string(counters.cache_references)},
+                                     {"cache_misses", std::to_string(counters.cache_misses)},
+                                     {"ipc", std::to_string(ipc)},
+                                     {"memory_gb_per_s", std::to_string(memory_gb_per_s)},
+                                     {"flops", std::to_string(flops)},
+                                     {"gflop_per_s", std::to_string(gflop_per_s)},
+                                 });
+}
+
 static void CalculateTotalInputSizes(const OpKernelContextInternal* op_kernel_context,
                                      const onnxruntime::OpKernel* p_op_kernel,
                                      size_t& input_activation_sizes, size_t& input_parameter_sizes,
@@ -139,7 +208,18 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
     tp = session_state.Profiler().StartTime();
   }
 
+  const bool count_hardware_events = is_profiler_enabled && session_state.IsHardwareCounterProfilingEnabled();
+  HardwareCounterValues hardware_counters_begin;
+  if (count_hardware_events) {
+    RegisterThreadForHardwareCounters();
+  }
+
+  const auto frame_begin_time = std::chrono::steady_clock::now();
   ExecutionFrame frame{feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators, session_state};
+  if (latency_breakdown_) {
+    latency_breakdown_->frame_setup_ns += RunLatencyBreakdown::ElapsedNs(frame_begin_time);
+  }
+
   const std::unordered_set<NodeIndex>* to_be_executed_nodes = nullptr;
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -164,9 +244,25 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
   std::cout << std::make_pair(&seq_exec_plan, &session_state) << std::endl;
 #endif
 
-  const auto& graph_viewer = session_state.GetGraphViewer();
+  // the kernels are resolved once when the session state is finalized
+  const auto& exec_plan_kernels = session_state.GetExecutionPlanKernels();
+
+  TensorCalibrationStats* calibration_stats = session_state.GetTensorCalibrationStats();
+  if (calibration_stats) {
+    for (size_t i = 0, end = feeds.size(); i < end; ++i) {
+      ORT_RETURN_IF_ERROR(calibration_stats->Record(feed_mlvalue_idxs[i], feeds[i], session_state));
+    }
+  }
+
+  NodeLatencyStats* node_latency_stats = session_state.GetNodeLatencyStats();
+  const bool sample_latencies = node_latency_stats != nullptr && node_latency_stats->SampleRun();
+  // both the sampled latencies and the latency breakdown time the Compute calls
+  const bool time_kernels = sample_latencies || latency_breakdown_ != nullptr;
+  std::chrono::steady_clock::time_point sample_begin_time;
 
 #ifdef CONCURRENCY_VISUALIZER
+  const auto& graph_viewer = session_state.GetGraphViewer();
+
   // need unique name for the series. number of nodes should be good enough for a subgraph
   char series_name[MaxSeriesNameLengthInChars] = "MainGraph";
   if (graph_viewer->IsSubgraph()) {
@@ -188,12 +284,18 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
       profile::Color::Black);
 #endif
 
-  for (const auto& node_exec_plan : exec_plan_vec) {
+  for (size_t step = 0, num_steps = exec_plan_vec.size(); step < num_steps; ++step) {
+    const auto& node_exec_plan = exec_plan_vec[step];
     if (terminate_flag_) {
       LOGS(logger, WARNING) << "Exiting due to terminate flag being set to true.";
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
     }
 
+    if (IsDeadlinePassed()) {
+      LOGS(logger, WARNING) << "Exiting due to the run deadline being passed.";
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to the run deadline being passed.");
+    }
+
     auto node_index = node_exec_plan.node_index;
 
     // If it is not necessary to execute the node.
@@ -201,7 +303,8 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
       continue;
     }
 
-    const auto& node = *graph_viewer.GetNode(node_exec_plan.node_index);
+    const auto* p_op_kernel = exec_plan_kernels[step];
+    const auto& node = p_op_kernel->Node();
 
 #ifdef CONCURRENCY_VISUALIZER
     series.write_flag(node.Name().c_str());
@@ -219,20 +322,14 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
     }
 #endif
 
-    auto p_op_kernel = session_state.GetKernel(node_index);
-
-    // if a kernel has been added in the session state, it better be NON-null.
-    if (p_op_kernel == nullptr)
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Got nullptr from GetKernel for node: ",
-                             node.Name());
-
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
     LARGE_INTEGER kernel_start;
     QueryPerformanceCounter(&kernel_start);
 #endif
     // construct OpKernelContext
     // TODO: log kernel inputs?
-    OpKernelContextInternal op_kernel_context(session_state, frame, *p_op_kernel, logger, terminate_flag_);
+    OpKernelContextInternal op_kernel_context(session_state, frame, *p_op_kernel, logger, terminate_flag_,
+                                              thread_pools_);
     // TODO: log kernel outputs?
     if (is_profiler_enabled) {
       sync_time_begin = session_state.Profiler().StartTime();
@@ -296,8 +393,18 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
                                input_activation_sizes, input_parameter_sizes, node_name_for_profiling);
     }
 
+    if (time_kernels) {
+      sample_begin_time = std::chrono::steady_clock::now();
+    }
+
+    if (count_hardware_events) {
+      hardware_counters_begin = ReadHardwareCounters();
+    }
+
     Status compute_status;
     {
+      tracing::TraceRange trace_range(tracing::Category::kNode, node.Name().c_str(), node.OpType().c_str());
+      concurrency::ThreadPool::CallSiteScope call_site(node.OpType().c_str());
 #ifdef CONCURRENCY_VISUALIZER
       diagnostic::span span(series, "%s.%d", node.OpType().c_str(), node.Index());
 #endif
@@ -340,6 +447,27 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
       return Status(compute_status.Category(), compute_status.Code(), msg_string);
     }
 
+    if (time_kernels) {
+      const int64_t duration_ns = RunLatencyBreakdown::ElapsedNs(sample_begin_time);
+      if (sample_latencies) {
+        node_latency_stats->Record(node_index, static_cast<uint64_t>(duration_ns));
+      }
+      if (latency_breakdown_) {
+        latency_breakdown_->RecordNode(node.OpType(), node.GetExecutionProviderType(), duration_ns);
+      }
+    }
+
+    if (count_hardware_events) {
+      HardwareCounterValues counters = ReadHardwareCounters();
+      counters -= hardware_counters_begin;
+      RecordHardwareCounters(session_state.Profiler(), node_name_for_profiling, kernel_begin_time, counters,
+                             EstimateFlops(op_kernel_context, node));
+    }
+
+    if (calibration_stats) {
+      ORT_RETURN_IF_ERROR(calibration_stats->RecordNodeOutputs(node_index, op_kernel_context, session_state));
+    }
+
     if (is_profiler_enabled) {
       // Calculate total output sizes for this operation.
       CalculateTotalOutputSizes(&op_kernel_context, total_output_sizes, node_name_for_profiling);
@@ -371,6 +499,10 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
                                                          {"output_size", std::to_string(total_output_sizes)},
                                                      });
 
+      if (auto* memory_profiler = frame.GetMemoryProfiler()) {
+        memory_profiler->RecordNode(node_name_for_profiling, node.OpType(), kernel_begin_time);
+      }
+
       sync_time_begin = session_state.Profiler().StartTime();
     }
 
@@ -454,7 +586,7 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
   MemoryInfo::MemoryInfoProfile::Clear();
 #endif
 
-  if (frame.HasMemoryPatternPlanner()) {
+  if (frame.HasMemoryPatternPlanner() || frame.MemoryPatternNeedsRegeneration()) {
     std::vector<std::reference_wrapper<const TensorShape>> input_shapes;
     bool all_tensors = true;
     for (const auto& feed : feeds) {
@@ -467,9 +599,15 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
     }
 
     if (all_tensors) {
-      auto mem_patterns = onnxruntime::make_unique<MemoryPatternGroup>();
-      ORT_RETURN_IF_ERROR(frame.GeneratePatterns(mem_patterns.get()));
-      ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, std::move(mem_patterns)));
+      if (frame.HasMemoryPatternPlanner()) {
+        auto mem_patterns = onnxruntime::make_unique<MemoryPatternGroup>();
+        ORT_RETURN_IF_ERROR(frame.GeneratePatterns(mem_patterns.get()));
+        ORT_RETURN_IF_ERROR(session_state.UpdateMemoryPatternGroupCache(input_shapes, std::move(mem_patterns)));
+      } else {
+        // the cached pattern for these shapes doesn't fit the actual tensor sizes. drop it so the next execution
+        // generates a new pattern with the current shapes.
+        session_state.InvalidateMemoryPatternGroup(input_shapes);
+      }
     }
   }
 
@@ -477,14 +615,17 @@ Status SequentialExecutor::Execute(const SessionState& session_state, const std:
     session_state.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", tp);
   }
 
-  for (auto i : frame.GetStaticMemorySizeInfo()) {
-    LOGS(logger, INFO) << "[Memory] ExecutionFrame statically allocates "
-                       << i.second << " bytes for " << i.first << std::endl;
-  }
+  // this runs for every execution, so skip iterating the sizes unless they are logged
+  if (LOG_SEVERITY_COMPILED_IN(INFO) && logger.OutputIsEnabled(logging::Severity::kINFO, logging::DataType::SYSTEM)) {
+    for (const auto& i : frame.GetStaticMemorySizeInfo()) {
+      LOGS(logger, INFO) << "[Memory] ExecutionFrame statically allocates "
+                         << i.second << " bytes for " << i.first << std::endl;
+    }
 
-  for (auto i : frame.GetDynamicMemorySizeInfo()) {
-    LOGS(logger, INFO) << "[Memory] ExecutionFrame dynamically allocates "
-                       << i.second << " bytes for " << i.first << std::endl;
+    for (const auto& i : frame.GetDynamicMemorySizeInfo()) {
+      LOGS(logger, INFO) << "[Memory] ExecutionFrame dynamically allocates "
+                         << i.second << " bytes for " << i.first << std::endl;
+    }
   }
 
   return Status::OK();
@@ -3,17 +3,23 @@
 
 #include "core/framework/session_state.h"
 
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
 #include "core/common/safeint.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/allocator.h"
+#include "core/framework/dim_param_expression.h"
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/session_state_utils.h"
+#include "core/framework/tuning_database.h"
 #include "core/framework/utils.h"
+#include "core/platform/hardware_counters.h"
 #include "core/providers/cpu/controlflow/utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 
@@ -165,7 +171,8 @@ const KernelCreateInfo& SessionState::GetNodeKernelCreateInfo(NodeIndex node_ind
   return *entry->second;
 }
 
-Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager) {
+Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_manager,
+                                   const SessionOptions& session_options) {
   const auto& nodes = graph_viewer_->Nodes();
   if (!nodes.empty()) {
     size_t max_nodeid = 0;
@@ -182,7 +189,8 @@ Status SessionState::CreateKernels(const KernelRegistryManager& kernel_registry_
       onnxruntime::ProviderType exec_provider_name = node.GetExecutionProviderType();
       const IExecutionProvider& exec_provider = *execution_providers_.Get(exec_provider_name);
 
-      auto op_kernel = kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci);
+      auto op_kernel = kernel_registry_manager.CreateKernel(node, exec_provider, *this, kci,
+                                                            &session_options.session_configurations);
 
       // assumes vector is already resize()'ed to the number of nodes in the graph
       session_kernels_[node.Index()] = op_kernel.release();
@@ -275,11 +283,69 @@ Status SessionState::PrepackConstantInitializedTensors(std::unordered_map<std::s
             if (constant_initialized_tensors.count(ort_value_idx)) {
               bool is_packed = false;
               const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
-              ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, is_packed));
+
+              // the kernels of the main graph use the weights pre-packed by an earlier session if they are cached,
+              // or add the weights they pre-pack to the cache so they can be saved
+              std::string cache_key;
+              const bool save_prepacked_weights =
+                  prepacked_weights_cache_ != nullptr && !prepacked_weights_cache_->IsLoaded();
+              if (prepacked_weights_cache_ != nullptr) {
+                const auto& kernel_def = kernel->KernelDef();
+                std::ostringstream key;
+                key << node.Index() << ":" << kernel_def.Domain() << ":" << kernel_def.OpName() << ":"
+                    << kernel_def.Provider() << ":" << input_idx;
+                cache_key = key.str();
+
+                PrePackedWeights cached_weights;
+                if (prepacked_weights_cache_->IsLoaded() && prepacked_weights_cache_->Get(cache_key, cached_weights)) {
+                  ORT_RETURN_IF_ERROR(kernel->UseCachedPrePackedBuffers(const_initialized_tensor, input_idx,
+                                                                        cached_weights, is_packed));
+                }
+              }
+
+              // the packed buffers can only be shared if they are in CPU memory, as that's what the container
+              // allocates
+              AllocatorPtr session_allocator = kernel->Info().GetAllocator(0, OrtMemTypeDefault);
+              const bool share_prepacked_weights =
+                  prepacked_weights_container_ != nullptr &&
+                  session_allocator->Info().device.Type() == OrtDevice::CPU;
+
+              PrePackedWeights weights_to_be_filled_in;
+              if (!is_packed) {
+                ORT_RETURN_IF_ERROR(kernel->PrePack(
+                    const_initialized_tensor, input_idx,
+                    share_prepacked_weights ? prepacked_weights_container_->GetAllocator() : session_allocator,
+                    is_packed,
+                    share_prepacked_weights || save_prepacked_weights ? &weights_to_be_filled_in : nullptr));
+
+                if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
+                  if (share_prepacked_weights) {
+                    ORT_RETURN_IF_ERROR(
+                        UseSharedPrePackedWeights(*kernel, input_idx, std::move(weights_to_be_filled_in)));
+                    if (save_prepacked_weights) {
+                      prepacked_weights_cache_->Add(cache_key, shared_prepacked_weights_.back());
+                    }
+                  } else {
+                    // the cache owns the buffers the kernel created
+                    auto saved_weights = std::make_shared<const PrePackedWeights>(std::move(weights_to_be_filled_in));
+                    ORT_RETURN_IF_ERROR(UseNonOwningPrePackedBuffers(*kernel, input_idx, *saved_weights));
+                    prepacked_weights_cache_->Add(cache_key, std::move(saved_weights));
+                  }
+                }
+              }
+
               if (is_packed && constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
                 // release the constant initialized tensor
                 st->initialized_tensors_.erase(ort_value_idx);
                 constant_initialized_tensors.erase(ort_value_idx);
+
+                // and any resources backing it, such as a memory mapping of external data, now that nothing
+                // refers to the tensor
+                auto deleter = st->deleter_for_initialized_tensors_.find(ort_value_idx);
+                if (deleter != st->deleter_for_initialized_tensors_.end()) {
+                  deleter->second.f(deleter->second.param);
+                  st->deleter_for_initialized_tensors_.erase(deleter);
+                }
               }
             }
             // stop searching in 2 cases:
@@ -299,15 +365,42 @@ Status SessionState::PrepackConstantInitializedTensors(std::unordered_map<std::s
   return Status::OK();
 }
 
-static int64_t CalculateMemoryPatternsKey(const std::vector<std::reference_wrapper<const TensorShape>>& shapes) {
-  int64_t key = 0;
-  for (auto shape : shapes) {
-    for (auto dim : shape.get().GetDims()) key ^= dim;
+Status SessionState::UseSharedPrePackedWeights(OpKernel& kernel, int input_idx, PrePackedWeights&& prepacked_weights) {
+  ORT_RETURN_IF_NOT(prepacked_weights.buffers_.size() == prepacked_weights.buffer_sizes_.size(),
+                    "Kernel for ", kernel.Node().OpType(), " provided ", prepacked_weights.buffers_.size(),
+                    " pre-packed buffers but ", prepacked_weights.buffer_sizes_.size(), " buffer sizes.");
+
+  // the hash covers the contents and the packing format. the kernel type is included as the same bytes may be
+  // interpreted differently by another kernel.
+  const auto& kernel_def = kernel.KernelDef();
+  std::ostringstream key;
+  key << kernel_def.Domain() << ":" << kernel_def.OpName() << ":" << kernel_def.Provider() << ":" << input_idx
+      << ":" << prepacked_weights.GetHash();
+
+  auto shared_weights = prepacked_weights_container_->GetOrAdd(key.str(), std::move(prepacked_weights));
+
+  // the shared instance is kept alive by this session state
+  ORT_RETURN_IF_ERROR(UseNonOwningPrePackedBuffers(kernel, input_idx, *shared_weights));
+
+  shared_prepacked_weights_.push_back(std::move(shared_weights));
+  return Status::OK();
+}
+
+Status SessionState::UseNonOwningPrePackedBuffers(OpKernel& kernel, int input_idx,
+                                                  const PrePackedWeights& prepacked_weights) {
+  std::vector<BufferUniquePtr> buffers;
+  buffers.reserve(prepacked_weights.buffers_.size());
+  for (const auto& buffer : prepacked_weights.buffers_) {
+    buffers.emplace_back(buffer.get(), BufferDeleter());
   }
-  return key;
+
+  bool used_shared_buffers = false;
+  ORT_RETURN_IF_ERROR(kernel.UseSharedPrePackedBuffers(buffers, input_idx, used_shared_buffers));
+  ORT_RETURN_IF_NOT(used_shared_buffers, "Kernel for ", kernel.Node().OpType(),
+                    " provided pre-packed buffers for sharing but did not use the shared buffers.");
+  return Status::OK();
 }
 
-#ifdef ENABLE_TRAINING
 namespace {
 Status ResolveDimParams(const GraphViewer& graph,
                         const std::map<std::string, TensorShape>& feeds,
@@ -353,12 +446,11 @@ Status TryResolveShape(
   SafeInt<size_t> safe_size = 1;
   for (auto& dim : arg->Shape()->dim()) {
     if (dim.has_dim_param()) {
-      auto it = symbolic_dimensions.find(dim.dim_param());
-      if (it == symbolic_dimensions.end()) {
-        return Status(ONNXRUNTIME, FAIL, "Unknown symbolic dimension, " + dim.dim_param() + ", found in memory pattern compute.");
-      }
-      safe_size *= it->second;
-      shape.push_back(it->second);
+      // the dim_param may also be an expression over the dim_params of the graph inputs (e.g. "batch*seq")
+      int64_t value = 0;
+      ORT_RETURN_IF_ERROR(EvaluateDimParam(dim.dim_param(), symbolic_dimensions, value));
+      safe_size *= value;
+      shape.push_back(value);
     } else if (dim.has_dim_value() && dim.dim_value() > 0) {
       safe_size *= dim.dim_value();
       shape.push_back(dim.dim_value());
@@ -491,6 +583,16 @@ Status SessionState::GeneratePatternGroupCache(const std::vector<std::reference_
       size_t size = 0;
       TryCalculateSizeFromResolvedShape(ml_value_idx, resolved_shapes, size);
 
+#if !defined(ENABLE_TRAINING)
+      // a pattern traced from the first execution covers every tensor, so prefer that over a partial pattern
+      if (exe_plan->allocation_plan[ml_value_idx].alloc_kind == AllocKind::kAllocate &&
+          ml_data_type != DataTypeImpl::GetType<std::string>() && size == 0) {
+        std::string node_name;
+        ORT_RETURN_IF_ERROR(this->ort_value_name_idx_map_.GetName(ml_value_idx, node_name));
+        return Status(ONNXRUNTIME, FAIL, "Unknown shape found in memory pattern compute, node name is : " + node_name);
+      }
+#endif
+
       // Plan memory if conditions are met.
       if (exe_plan->allocation_plan[ml_value_idx].alloc_kind == AllocKind::kAllocate &&
           ml_data_type != DataTypeImpl::GetType<std::string>() && size != 0) {
@@ -524,34 +626,44 @@ Status SessionState::GeneratePatternGroupCache(const std::vector<std::reference_
   }
   return Status::OK();
 }
+
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(
+    const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
+    const std::vector<int>& feed_mlvalue_idxs,
+    std::unordered_map<int, TensorShape>& inferred_shapes) const {
+  const auto key = mem_pattern_cache_.CreateKey(input_shapes);
+
+  auto entry = mem_pattern_cache_.Find(key);
+  if (!entry) {
+    if (!use_graph_shapes_for_mem_patterns_) {
+      return nullptr;
+    }
+
+    // if the shapes of all the tensors can be resolved from the input shapes there's no need to trace the patterns
+    // during an execution, so even the first execution with these input shapes can use the patterns.
+    auto new_entry = std::make_shared<MemoryPatternCache::Entry>();
+    if (GeneratePatternGroupCache(input_shapes, feed_mlvalue_idxs, &new_entry->patterns, inferred_shapes).IsOK()) {
+#if !defined(ENABLE_TRAINING)
+      // training relies on the inferred shapes so keeps using these patterns if the shapes in the graph are wrong
+      new_entry->patterns.from_graph_shapes = true;
 #endif
 
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
-                                                              const std::vector<int>& feed_mlvalue_idxs,
-                                                              std::unordered_map<int, TensorShape>& inferred_shapes) const {
-  int64_t key = CalculateMemoryPatternsKey(input_shapes);
+      // the inferred shapes are specific to the exact input shapes so can't be shared by a bucketed entry
+      if (!mem_pattern_cache_.IsBucketed()) {
+        new_entry->inferred_shapes = inferred_shapes;
+      }
 
-  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
-#ifdef ENABLE_TRAINING
-    auto mem_patterns = onnxruntime::make_unique<MemoryPatternGroup>();
-    if (GeneratePatternGroupCache(input_shapes, feed_mlvalue_idxs, mem_patterns.get(), inferred_shapes).IsOK()) {
-      key = CalculateMemoryPatternsKey(input_shapes);
-      auto ptr = mem_patterns.get();
-      mem_patterns_[key] = std::move(mem_patterns);
-      shape_patterns_[key] = inferred_shapes;
-      return ptr;
+      if (mem_pattern_cache_.Insert(key, new_entry)) {
+        SaveMemoryPatternCache();
+      }
+      return std::shared_ptr<const MemoryPatternGroup>(new_entry, &new_entry->patterns);
     }
+
     return nullptr;
-#else
-    ORT_UNUSED_PARAMETER(feed_mlvalue_idxs);
-    return nullptr;
-#endif
   }
 
-  inferred_shapes = shape_patterns_[key];
-  return it->second.get();
+  inferred_shapes = entry->inferred_shapes;
+  return std::shared_ptr<const MemoryPatternGroup>(entry, &entry->patterns);
 }
 
 void SessionState::ResolveMemoryPatternFlag() {
@@ -567,17 +679,33 @@ void SessionState::ResolveMemoryPatternFlag() {
 
 Status SessionState::UpdateMemoryPatternGroupCache(const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
                                                    std::unique_ptr<MemoryPatternGroup> mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(input_shapes);
-
-  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
-    mem_patterns_[key] = std::move(mem_patterns);
+  auto entry = std::make_shared<MemoryPatternCache::Entry>();
+  entry->patterns = std::move(*mem_patterns);
+  if (mem_pattern_cache_.Insert(mem_pattern_cache_.CreateKey(input_shapes), std::move(entry))) {
+    SaveMemoryPatternCache();
   }
 
   return Status::OK();
 }
 
+void SessionState::SaveMemoryPatternCache() const {
+  if (mem_pattern_cache_file_.empty()) {
+    return;
+  }
+
+  // patterns for new input shapes are rare, so the whole file is rewritten every time
+  std::lock_guard<OrtMutex> lock(mem_pattern_cache_file_mutex_);
+  auto status = mem_pattern_cache_.Save(mem_pattern_cache_file_, mem_pattern_cache_fingerprint_);
+  if (!status.IsOK()) {
+    LOGS(logger_, WARNING) << status.ErrorMessage();
+  }
+}
+
+void SessionState::InvalidateMemoryPatternGroup(
+    const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes) const {
+  mem_pattern_cache_.Erase(mem_pattern_cache_.CreateKey(input_shapes));
+}
+
 bool SessionState::GetEnableMemoryPattern() const { return enable_mem_pattern_; }
 
 common::Status SessionState::AddInputNameToNodeInfoMapping(const std::string& input_name, const NodeInfo& node_info) {
@@ -808,7 +936,8 @@ Status SessionState::CreateSubgraphSessionState() {
       auto subgraph_session_state =
           onnxruntime::make_unique<SessionState>(*subgraph, execution_providers_, enable_mem_pattern_,
                                                  thread_pool_, inter_op_thread_pool_, data_transfer_mgr_,
-                                                 logger_, profiler_);
+                                                 logger_, profiler_, use_deterministic_compute_,
+                                                 prepacked_weights_container_);
 
       // Pass fused function manager to subgraph
       subgraph_session_state->fused_funcs_mgr_.SetFusedFuncs(fused_funcs_mgr_);
@@ -969,6 +1098,41 @@ Status SessionState::FinalizeSessionState(const std::basic_string<PATH_CHAR_TYPE
                                   remove_initializers, constant_initializers_use_count);
 }
 
+// FNV-1a hash of the names and planned locations of the OrtValues, which the indices in a saved memory pattern cache
+// refer to. Also returns the distinct planned locations.
+static uint64_t MemoryPatternFingerprint(const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                         const SequentialExecutionPlan& plan,
+                                         std::vector<OrtMemoryInfo>& locations) {
+  uint64_t hash = 14695981039346656037ULL;
+  auto add = [&hash](const void* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+      hash = (hash ^ static_cast<const unsigned char*>(data)[i]) * 1099511628211ULL;
+    }
+  };
+
+  for (size_t idx = 0; idx < plan.allocation_plan.size(); ++idx) {
+    const auto& value_plan = plan.allocation_plan[idx];
+    std::string name;
+    if (ort_value_name_idx_map.GetName(static_cast<int>(idx), name).IsOK()) {
+      add(name.data(), name.size() + 1);
+    }
+
+    const auto& location = value_plan.location;
+    const int alloc_kind = static_cast<int>(value_plan.alloc_kind);
+    add(&alloc_kind, sizeof(alloc_kind));
+    if (location.name != nullptr) {
+      add(location.name, strlen(location.name) + 1);
+      add(&location.id, sizeof(location.id));
+      add(&location.mem_type, sizeof(location.mem_type));
+      if (std::find(locations.begin(), locations.end(), location) == locations.end()) {
+        locations.push_back(location);
+      }
+    }
+  }
+
+  return hash;
+}
+
 Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_TYPE>& graph_location,
                                               KernelRegistryManager& kernel_registry_manager,
                                               _In_opt_ const Node* parent_node,
@@ -992,10 +1156,84 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
                   });
   }
 
-  SequentialPlannerContext context(session_options.execution_mode, session_options.execution_order);
+  if (enable_mem_pattern_) {
+    size_t max_entries = 0;
+    int64_t dim_bucket_size = 0;
+    ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(
+        session_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternCacheMaxEntries, "0"), max_entries));
+    ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(
+        session_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternCacheDimBucketSize, "0"),
+        dim_bucket_size));
+    ORT_RETURN_IF_ERROR(mem_pattern_cache_.Configure(max_entries, dim_bucket_size));
+  }
+
+  ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(
+      session_options.GetConfigOrDefault(kOrtSessionOptionsConfigSmallTensorSlabBytes, "0"),
+      small_tensor_slab_bytes_));
+  ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(
+      session_options.GetConfigOrDefault(kOrtSessionOptionsConfigSmallTensorMaxBytes, "1024"),
+      small_tensor_max_bytes_));
+
+  enable_memory_profiling_ =
+      session_options.GetConfigOrDefault(kOrtSessionOptionsConfigEnableMemoryProfiling, "0") == "1";
+
+  if (session_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfilingHardwareCounters, "0") == "1") {
+    enable_hardware_counters_ = EnableHardwareCounters();
+    if (!enable_hardware_counters_ && parent_node == nullptr) {
+      LOGS(logger_, WARNING) << "Hardware counters are not available on this platform, or the process is not "
+                                "permitted to open them. The profiling output will not include them.";
+    }
+  }
+
+  if (parent_node == nullptr) {
+    const std::string tuning_database_file =
+        session_options.GetConfigOrDefault(kOrtSessionOptionsConfigTuningDatabaseFile, "");
+    if (!tuning_database_file.empty()) {
+      ORT_RETURN_IF_ERROR(tuning::GetTuningDatabase().Load(tuning_database_file));
+    }
+    if (session_options.GetConfigOrDefault(kOrtSessionOptionsConfigEnableTuning, "0") == "1") {
+      tuning::EnableTuning(tuning_database_file);
+    }
+
+    uint64_t sample_interval_runs = 0;
+    ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(
+        session_options.GetConfigOrDefault(kOrtSessionOptionsConfigProfilingSampleIntervalRuns, "0"),
+        sample_interval_runs));
+    if (sample_interval_runs > 0) {
+      node_latency_stats_ = onnxruntime::make_unique<NodeLatencyStats>(*graph_viewer_, sample_interval_runs);
+    }
+
+    std::unordered_set<std::string> calibration_tensor_names;
+    std::istringstream calibration_tensor_names_stream(
+        session_options.GetConfigOrDefault(kOrtSessionOptionsConfigCalibrationTensorNames, ""));
+    for (std::string name; std::getline(calibration_tensor_names_stream, name, ';');) {
+      if (!name.empty()) {
+        calibration_tensor_names.insert(name);
+      }
+    }
+    if (!calibration_tensor_names.empty()) {
+      size_t num_histogram_bins = 0;
+      ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(
+          session_options.GetConfigOrDefault(kOrtSessionOptionsConfigCalibrationHistogramBins, "2048"),
+          num_histogram_bins));
+      ORT_RETURN_IF_NOT(
+          num_histogram_bins >= 2 * TensorCalibrationStats::kNumQuantizedBins && num_histogram_bins % 2 == 0,
+          kOrtSessionOptionsConfigCalibrationHistogramBins, " must be even and at least ",
+          2 * TensorCalibrationStats::kNumQuantizedBins, ", got ", num_histogram_bins);
+      tensor_calibration_stats_ = onnxruntime::make_unique<TensorCalibrationStats>(
+          *graph_viewer_, ort_value_name_idx_map_, calibration_tensor_names, num_histogram_bins);
+    }
+  }
+
+  const bool enable_inplace_reuse =
+      session_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisableInplaceReuse, "0") != "1";
+  SequentialPlannerContext context(session_options.execution_mode, session_options.execution_order,
+                                   enable_inplace_reuse);
   ORT_RETURN_IF_ERROR(SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
                                                     execution_providers_, kernel_create_info_map_,
                                                     ort_value_name_idx_map_, context, p_seq_exec_plan_));
+  LOGS(logger_, INFO) << "Planned peak memory of the node outputs: " << p_seq_exec_plan_->planned_peak_bytes
+                      << " bytes, excluding outputs with a dynamic shape.";
   //Record the allocation plan
 
   // Uncomment the below to dump the allocation plan to std::cout
@@ -1004,6 +1242,33 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   MemoryInfo::GenerateTensorMap(GetExecutionPlan(), GetOrtValueNameIdxMap());
 #endif
 
+  if (enable_mem_pattern_ && parent_node == nullptr) {
+    mem_pattern_cache_file_ = session_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryPatternCacheFile, "");
+    if (!mem_pattern_cache_file_.empty()) {
+      std::vector<OrtMemoryInfo> locations;
+      mem_pattern_cache_fingerprint_ = MemoryPatternFingerprint(ort_value_name_idx_map_, *p_seq_exec_plan_, locations);
+      auto status = mem_pattern_cache_.Load(mem_pattern_cache_file_, mem_pattern_cache_fingerprint_, locations);
+      if (!status.IsOK()) {
+        // the file is replaced with the patterns of this session the next time one is added
+        LOGS(logger_, WARNING) << "Ignoring the saved memory patterns. " << status.ErrorMessage();
+      } else {
+        LOGS(logger_, INFO) << "Loaded " << mem_pattern_cache_.Size() << " memory patterns from "
+                            << mem_pattern_cache_file_;
+      }
+    }
+  }
+
+  // logs the duration of a phase of the finalization, and records it in the profile if profiling is enabled
+  TimePoint phase_start_time = std::chrono::high_resolution_clock::now();
+  auto end_phase = [this, &phase_start_time](const char* phase) {
+    LOGS(logger_, INFO) << "Session state finalization phase " << phase << " took "
+                        << TimeDiffMicroSeconds(phase_start_time) << " us.";
+    if (profiler_.IsEnabled()) {
+      profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, phase, phase_start_time);
+    }
+    phase_start_time = std::chrono::high_resolution_clock::now();
+  };
+
   std::unique_ptr<ITensorAllocator> tensor_allocator(
       ITensorAllocator::Create(enable_mem_pattern_, *p_seq_exec_plan_, *this, weights_buffers_));
 
@@ -1018,7 +1283,8 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
           [this](int idx, const OrtValue& value, const OrtCallback& d, bool constant) -> Status {
             return AddInitializedTensor(idx, value, &d, constant);
           },
-          logger_, data_transfer_mgr_, *p_seq_exec_plan_.get(), session_options));
+          logger_, data_transfer_mgr_, *p_seq_exec_plan_.get(), session_options, thread_pool_));
+  end_phase("initializer_deserialization");
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   //Record Weight allocation info on device
   MemoryInfo::RecordInitializerAllocInfo(GetInitializedTensors());
@@ -1031,13 +1297,23 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
     CleanInitializedTensorsFromGraph();
   }
 
-  ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
+  ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager, session_options));
+  end_phase("kernel_creation");
+
+  execution_plan_kernels_.clear();
+  execution_plan_kernels_.reserve(p_seq_exec_plan_->execution_plan.size());
+  for (const auto& node_exec_plan : p_seq_exec_plan_->execution_plan) {
+    const OpKernel* kernel = GetKernel(node_exec_plan.node_index);
+    ORT_RETURN_IF(kernel == nullptr, "No kernel was created for the node with index ", node_exec_plan.node_index);
+    execution_plan_kernels_.push_back(kernel);
+  }
 
   const auto disable_prepacking =
       session_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisablePrepacking, "0");
 
   if (disable_prepacking != "1") {
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count));
+    end_phase("weight_prepacking");
   }
 
   ORT_RETURN_IF_ERROR(
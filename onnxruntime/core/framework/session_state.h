@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <map>
 #include <unordered_map>
@@ -22,10 +23,15 @@
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
+#include "core/framework/mem_pattern_cache.h"
 #include "core/framework/ml_value.h"
 #include "core/framework/node_index_info.h"
+#include "core/framework/node_latency_stats.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/prepacked_weights_cache.h"
+#include "core/framework/prepacked_weights_container.h"
+#include "core/framework/tensor_calibration_stats.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/onnx_protobuf.h"
 #include "core/platform/ort_mutex.h"
@@ -86,7 +92,8 @@ class SessionState {
                const DataTransferManager& data_transfer_mgr,
                const logging::Logger& logger,
                profiling::Profiler& profiler,
-               bool use_deterministic_compute = false)
+               bool use_deterministic_compute = false,
+               PrepackedWeightsContainer* prepacked_weights_container = nullptr)
       : graph_(graph),
         execution_providers_(execution_providers),
         logger_(logger),
@@ -95,7 +102,8 @@ class SessionState {
         thread_pool_(thread_pool),
         inter_op_thread_pool_(inter_op_thread_pool),
         data_transfer_mgr_(data_transfer_mgr),
-        use_deterministic_compute_(use_deterministic_compute) {
+        use_deterministic_compute_(use_deterministic_compute),
+        prepacked_weights_container_(prepacked_weights_container) {
     SetupAllocators();
   }
 
@@ -122,6 +130,10 @@ class SessionState {
     return (node_id < session_kernels_.size()) ? session_kernels_[node_id] : nullptr;
   }
 
+  // Get the kernels in the order of the sequential execution plan. Entry i is the kernel of the node of
+  // GetExecutionPlan()->execution_plan[i]. Available after FinalizeSessionState.
+  const std::vector<const OpKernel*>& GetExecutionPlanKernels() const noexcept { return execution_plan_kernels_; }
+
   const ExecutionProviders& GetExecutionProviders() const noexcept { return execution_providers_; }
 
   /**
@@ -191,9 +203,10 @@ class SessionState {
   profiling::Profiler& Profiler() const noexcept { return profiler_; }
 
   /**
-  Get cached memory pattern based on input shapes
+  Get cached memory pattern based on input shapes.
+  The returned pattern remains valid while the caller holds it, even if it is evicted from the cache.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(
       const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
       const std::vector<int>& feed_mlvalue_idxs,
       std::unordered_map<int, TensorShape>& inferred_shapes) const;
@@ -205,6 +218,64 @@ class SessionState {
   Status UpdateMemoryPatternGroupCache(const std::vector<std::reference_wrapper<const TensorShape>>& input_shape,
                                        std::unique_ptr<MemoryPatternGroup> mem_patterns) const;
 
+  /**
+  Remove the cached memory pattern for the given input shapes so it is re-generated by the next execution.
+  Used when a pattern from a bucketed cache entry was too small for the current input shapes.
+  */
+  void InvalidateMemoryPatternGroup(const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes) const;
+
+  /**
+  Returns true if cached memory patterns may have been generated with different input shapes than the
+  shapes they are used with, in which case a block may be used for a tensor smaller than the block.
+  */
+  bool IsMemoryPatternCacheBucketed() const noexcept { return mem_pattern_cache_.IsBucketed(); }
+
+  /**
+  Stop computing memory patterns from the shapes in the graph and trace them from an execution instead.
+  Used when a tensor's size didn't match the size computed from its shape in the graph.
+  */
+  void DisableMemoryPatternsFromGraphShapes() const { use_graph_shapes_for_mem_patterns_ = false; }
+
+  /**
+  Save the cached memory patterns to the file set by the session.mem_pattern_cache.file config, if any.
+  Failures are logged as a warning, as the patterns are only an optimization.
+  */
+  void SaveMemoryPatternCache() const;
+
+  /** Get the hit/miss/eviction counters for the memory pattern cache. */
+  MemoryPatternCache::Stats GetMemoryPatternCacheStats() const { return mem_pattern_cache_.GetStats(); }
+
+  /**
+  Get the size of the slab each execution allocates small CPU tensors from, or 0 if small tensors are allocated
+  individually, and the maximum size of a tensor allocated from the slab. Set in FinalizeSessionState.
+  */
+  size_t GetSmallTensorSlabBytes() const noexcept { return small_tensor_slab_bytes_; }
+  size_t GetSmallTensorMaxBytes() const noexcept { return small_tensor_max_bytes_; }
+
+  /**
+  Get the kernel latency statistics of the sampled runs, or nullptr if sampling is disabled or this is the
+  session state of a subgraph. Set in FinalizeSessionState.
+  */
+  NodeLatencyStats* GetNodeLatencyStats() const noexcept { return node_latency_stats_.get(); }
+
+  /**
+  Get the calibration statistics of the tensors of session.calibration.tensor_names, or nullptr if the collection is
+  disabled or this is the session state of a subgraph. Set in FinalizeSessionState.
+  */
+  TensorCalibrationStats* GetTensorCalibrationStats() const noexcept { return tensor_calibration_stats_.get(); }
+
+  /**
+  Whether the executions record their memory usage to the profiler while profiling is enabled.
+  Set in FinalizeSessionState from session.enable_memory_profiling.
+  */
+  bool IsMemoryProfilingEnabled() const noexcept { return enable_memory_profiling_; }
+
+  /**
+  Whether the executions count the hardware events of each node while profiling is enabled.
+  Set in FinalizeSessionState from session.profiling.hardware_counters, if the platform supports the counters.
+  */
+  bool IsHardwareCounterProfilingEnabled() const noexcept { return enable_hardware_counters_; }
+
   bool GetUseDeterministicCompute() const { return use_deterministic_compute_; }
 
   /**
@@ -294,6 +365,21 @@ class SessionState {
     return parent_;
   }
 
+  // Number of pre-packed weights in this session state (excluding subgraphs) that are shared using the
+  // PrepackedWeightsContainer, including ones that were created by this session state.
+  size_t GetNumberOfSharedPrePackedWeights() const noexcept { return shared_prepacked_weights_.size(); }
+
+  /**
+  Set the cache of the pre-packed weights of the kernels of the main graph. Must be called before
+  FinalizeSessionState. If the cache refers to loaded weights, the kernels use them instead of pre-packing their
+  initializers where they can. Otherwise the weights pre-packed by the kernels are added to it so it can be saved.
+  */
+  void SetPrePackedWeightsCache(std::unique_ptr<PrePackedWeightsCache> cache) {
+    prepacked_weights_cache_ = std::move(cache);
+  }
+
+  const PrePackedWeightsCache* GetPrePackedWeightsCache() const noexcept { return prepacked_weights_cache_.get(); }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SessionState);
 
@@ -303,7 +389,7 @@ class SessionState {
   void CreateGraphInfo();
 
   // create kernels using info in kernel_create_info_map_
-  Status CreateKernels(const KernelRegistryManager& custom_registry_manager);
+  Status CreateKernels(const KernelRegistryManager& custom_registry_manager, const SessionOptions& session_options);
 
   // remove TensorProto versions of initializers from Graph instance
   // (replaced byOrtValue instances in initialized_tensors_)
@@ -315,6 +401,12 @@ class SessionState {
   */
   Status PrepackConstantInitializedTensors(std::unordered_map<std::string, size_t>& constant_initializers_use_count);
 
+  // Replace the pre-packed buffers created by the kernel with the shared instance from prepacked_weights_container_.
+  Status UseSharedPrePackedWeights(OpKernel& kernel, int input_idx, PrePackedWeights&& prepacked_weights);
+
+  // Give the kernel non-owning pointers to the pre-packed buffers in place of the ones it created.
+  static Status UseNonOwningPrePackedBuffers(OpKernel& kernel, int input_idx, const PrePackedWeights& prepacked_weights);
+
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
   Status CreateSubgraphSessionState();
@@ -333,13 +425,13 @@ class SessionState {
                                   bool remove_initializers,
                                   std::unordered_map<std::string, size_t>& constant_initializers_use_count);
 
-#ifdef ENABLE_TRAINING
+  // Compute the memory patterns for the given input shapes from the shapes of the node outputs in the graph,
+  // binding the dim_params of the graph inputs to the input shapes.
   Status GeneratePatternGroupCache(
       const std::vector<std::reference_wrapper<const TensorShape>>& input_shape,
       const std::vector<int>& feed_mlvalue_idxs,
       MemoryPatternGroup* output,
       std::unordered_map<int, TensorShape>& inferred_shapes) const;
-#endif
 
   // the SessionState for the main Graph contains the compiled kernel hashes for the entire model
   const std::unordered_map<std::string, uint64_t>& GetCompiledKernelHashes() const {
@@ -355,6 +447,9 @@ class SessionState {
 
   // cache of the constructed kernels to avoid spending construction time per executor
   std::vector<OpKernel*> session_kernels_;
+
+  // kernels of the execution plan steps so the executors don't look up the node and kernel of each step per run
+  std::vector<const OpKernel*> execution_plan_kernels_;
   Graph& graph_;
   std::unique_ptr<GraphViewer> graph_viewer_;  // GraphViewer for const access to Graph
 
@@ -413,12 +508,34 @@ class SessionState {
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_;
 
-  // lock for the mem_patterns_
-  mutable OrtMutex mem_patterns_lock_;
+  // see GetSmallTensorSlabBytes
+  size_t small_tensor_slab_bytes_ = 0;
+  size_t small_tensor_max_bytes_ = 0;
+
+  // see GetNodeLatencyStats
+  std::unique_ptr<NodeLatencyStats> node_latency_stats_;
+
+  // see GetTensorCalibrationStats
+  std::unique_ptr<TensorCalibrationStats> tensor_calibration_stats_;
+
+  // see IsMemoryProfilingEnabled
+  bool enable_memory_profiling_ = false;
+
+  // see IsHardwareCounterProfilingEnabled
+  bool enable_hardware_counters_ = false;
 
   // cache for the generated mem_patterns. key is calculated based on input shapes.
-  mutable std::map<int64_t, std::unique_ptr<MemoryPatternGroup>> mem_patterns_;
-  mutable std::map<int64_t, std::unordered_map<int, TensorShape>> shape_patterns_;
+  // configured from the session options in FinalizeSessionState.
+  mutable MemoryPatternCache mem_pattern_cache_;
+
+  // see SaveMemoryPatternCache. the fingerprint of the graph and allocation plan is computed with the plan.
+  std::string mem_pattern_cache_file_;
+  uint64_t mem_pattern_cache_fingerprint_ = 0;
+  mutable OrtMutex mem_pattern_cache_file_mutex_;  // serializes the writers of the file
+
+  // whether memory patterns are computed from the shapes in the graph when the input shapes of a run are known.
+  // if false they are traced during the first execution with the input shapes.
+  mutable std::atomic<bool> use_graph_shapes_for_mem_patterns_{true};
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -439,6 +556,13 @@ class SessionState {
 
   bool use_deterministic_compute_;
 
+  // optional container to share pre-packed weights with other sessions. not owned.
+  PrepackedWeightsContainer* const prepacked_weights_container_{};
+  // the shared pre-packed weights used by the kernels of this session state
+  std::vector<std::shared_ptr<const PrePackedWeights>> shared_prepacked_weights_;
+  // see SetPrePackedWeightsCache. only used by the session state of the main graph.
+  std::unique_ptr<PrePackedWeightsCache> prepacked_weights_cache_;
+
   std::unique_ptr<NodeIndexInfo> node_index_info_;
   std::multimap<int, std::unique_ptr<FeedsFetchesManager>> cached_feeds_fetches_managers_;
 
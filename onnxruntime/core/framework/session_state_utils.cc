@@ -4,6 +4,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/framework/session_state_utils.h"
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <core/common/status.h>
@@ -23,6 +24,8 @@
 #include "core/framework/utils.h"
 #include "core/framework/mem_buffer.h"
 #include "core/framework/tensor_allocator.h"
+#include "core/platform/threadpool.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
 #endif
@@ -30,14 +33,36 @@
 namespace onnxruntime {
 namespace session_state_utils {
 
+static bool IsCpuLocation(const OrtMemoryInfo& location) {
+  return strcmp(location.name, CPU) == 0 || location.mem_type == OrtMemTypeCPUOutput;
+}
+
+// Returns true if an initializer at the location can use memory mapped external data, which excludes the host memory
+// of a provider, e.g. pinned memory, since the tensor must be in the memory of the provider allocator.
+static bool IsMappableLocation(const OrtMemoryInfo& location) {
+  return strcmp(location.name, CPU) == 0;
+}
+
+// Returns true if TensorProtoToMLValue will use the external data of the initializer directly, rather than
+// copying it into a preallocated buffer.
+static bool IsMappedExternalInitializer(const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                        const OrtMemoryInfo& location) {
+  return endian::native == endian::little &&
+         IsMappableLocation(location) &&
+         utils::HasExternalData(tensor_proto) &&
+         tensor_proto.data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING;
+}
+
 static common::Status DeserializeTensorProto(const Env& env, const std::basic_string<PATH_CHAR_TYPE>& proto_path,
                                              const ONNX_NAMESPACE::TensorProto& tensor_proto, const MemBuffer& m,
                                              const OrtMemoryInfo& default_cpu_memory_info, OrtValue& ort_value,
                                              OrtCallback& deleter,
-                                             const DataTransferManager& data_transfer_mgr) {
+                                             const DataTransferManager& data_transfer_mgr,
+                                             bool use_mmap_for_external_data) {
   const OrtMemoryInfo& alloc_info = m.GetAllocInfo();
-  if (strcmp(alloc_info.name, CPU) == 0 || alloc_info.mem_type == OrtMemTypeCPUOutput) {
-    // deserialize directly to CPU tensor
+  if (IsCpuLocation(alloc_info) &&
+      ((use_mmap_for_external_data && IsMappableLocation(alloc_info)) || !utils::HasExternalData(tensor_proto))) {
+    // deserialize directly to CPU tensor. external data will be memory mapped.
     return utils::TensorProtoToMLValue(env, proto_path.c_str(), tensor_proto, m, ort_value, deleter);
   }
 
@@ -99,7 +124,8 @@ common::Status SaveInitializedTensors(
     const std::function<Status(int idx, const OrtValue& value, const OrtCallback& d, bool constant)>& save_tensor_func,
     const logging::Logger& logger, const DataTransferManager& data_transfer_mgr,
     const ExecutionPlanBase& exec_plan,
-    const SessionOptions& session_options) {
+    const SessionOptions& session_options,
+    concurrency::ThreadPool* thread_pool) {
   LOGS(logger, INFO) << "Saving initialized tensors.";
   ORT_ENFORCE(ort_value_name_idx_map.MaxIdx() > -1, "OrtValue indexes should have been populated.");
 
@@ -132,15 +158,31 @@ common::Status SaveInitializedTensors(
     return retval;
   };
 
+  const bool use_mmap_for_external_data =
+      session_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseMmapForExternalInitializers, "1") == "1";
+  const bool free_prepacked_initializers =
+      session_options.GetConfigOrDefault(kOrtSessionOptionsConfigFreePrepackedInitializers, "0") == "1";
+
   //1. first plan the memory
   const onnxruntime::InitializedTensorSet& initialized_tensor_set = graph.GetAllInitializedTensors();
   std::unordered_map<int, const ONNX_NAMESPACE::TensorProto*> id_to_initialized_tensor;
   std::set<int> user_supplied_initializer_ids;  // set containing the ort value ids of all user supplied initializers
+  // ort value ids of initializers backed by a mapping of their external data file, which don't need planned memory
+  std::set<int> mapped_initializer_ids;
+  // ort value ids of constant initializers allocated on their own, so they can be freed once pre-packed
+  std::set<int> separately_allocated_initializer_ids;
   for (const auto& entry : initialized_tensor_set) {
     int ort_value_index;
     ORT_RETURN_IF_ERROR(ort_value_name_idx_map.GetIdx(entry.first, ort_value_index));
+    const OrtMemoryInfo& location = exec_plan.GetLocation(ort_value_index);
     if (use_user_supplied_initializer(entry.first)) {
       user_supplied_initializer_ids.insert(ort_value_index);
+    } else if (use_mmap_for_external_data && IsMappedExternalInitializer(*entry.second, location)) {
+      mapped_initializer_ids.insert(ort_value_index);
+    } else if (free_prepacked_initializers && IsCpuLocation(location) &&
+               entry.second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING &&
+               graph.IsConstantInitializer(entry.first, /* check_outer_scope */ false)) {
+      separately_allocated_initializer_ids.insert(ort_value_index);
     }
     id_to_initialized_tensor[ort_value_index] = entry.second;
   }
@@ -152,11 +194,18 @@ common::Status SaveInitializedTensors(
     ORT_ENFORCE(entry != initialized_tensors_to_allocate.end());
     ORT_RETURN_IF_ERROR(planner.Trace(entry->first, entry->second));
     initialized_tensors_to_allocate.erase(entry);
+    // a specific allocation order requires the planned buffer to be used
+    mapped_initializer_ids.erase(ort_value_index);
+    separately_allocated_initializer_ids.erase(ort_value_index);
   }
 
   for (const auto& entry : initialized_tensors_to_allocate) {
-    // We don't want to trace shared initializers since their memory is provided by the user
-    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
+    // We don't want to trace shared initializers since their memory is provided by the user,
+    // memory mapped initializers as their memory is provided by the mapping,
+    // or the initializers allocated on their own
+    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end() ||
+        mapped_initializer_ids.find(entry.first) != mapped_initializer_ids.end() ||
+        separately_allocated_initializer_ids.find(entry.first) != separately_allocated_initializer_ids.end()) {
       continue;
     }
     ORT_RETURN_IF_ERROR(planner.Trace(entry.first, entry.second));
@@ -178,42 +227,122 @@ common::Status SaveInitializedTensors(
                        << i.second << " bytes for " << i.first << std::endl;
   }
 
-  OrtCallback deleter{nullptr, nullptr};
-
   //3. create weight tensors based on weights buffer
-  for (const auto& entry : id_to_initialized_tensor) {
-    int ort_value_index = entry.first;
-    const char* name = (entry.second->name().empty()) ? "" : entry.second->name().c_str();
+  // The buffers are acquired up front so that the initializers can be deserialized in parallel. Only the ones on
+  // CPU are, as copying to another device goes through its data transfer.
+  struct InitializerToSave {
+    int ort_value_index;
+    const char* name;
+    const ONNX_NAMESPACE::TensorProto* tensor_proto;
+    std::unique_ptr<MemBuffer> m;             // null for a user supplied initializer
+    std::unique_ptr<Tensor> separate_tensor;  // owns the buffer of a separately allocated initializer
     OrtValue ort_value;
+    OrtCallback deleter{nullptr, nullptr};
+    Status status;
+  };
+
+  std::vector<InitializerToSave> initializers_to_save;
+  initializers_to_save.reserve(id_to_initialized_tensor.size());
+  for (const auto& entry : id_to_initialized_tensor) {
+    initializers_to_save.emplace_back();
+    InitializerToSave& initializer = initializers_to_save.back();
+    initializer.ort_value_index = entry.first;
+    initializer.name = (entry.second->name().empty()) ? "" : entry.second->name().c_str();
+    initializer.tensor_proto = entry.second;
 
-    if (user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end()) {
-      ort_value = *(session_options.initializers_to_share_map.at(name));
+    int ort_value_index = entry.first;
+    const char* name = initializer.name;
+    if (user_supplied_initializer_ids.find(ort_value_index) != user_supplied_initializer_ids.end()) {
+      initializer.ort_value = *(session_options.initializers_to_share_map.at(name));
       LOGS(logger, INFO) << "Using user supplied initializer with name (" << name << ").";
-    } else {
+    } else if (mapped_initializer_ids.find(ort_value_index) != mapped_initializer_ids.end()) {
+      // the tensor will use the mapped external data directly so no buffer is required
+      initializer.m = onnxruntime::make_unique<MemBuffer>(nullptr, 0, exec_plan.GetLocation(ort_value_index));
+    } else if (separately_allocated_initializer_ids.find(ort_value_index) !=
+               separately_allocated_initializer_ids.end()) {
       const ONNX_NAMESPACE::TensorProto& tensor_proto = *(entry.second);
-
-      std::unique_ptr<MemBuffer> m;
+      const OrtMemoryInfo& location = exec_plan.GetLocation(ort_value_index);
+      AllocatorPtr alloc = planner.GetAllocator(location);
+      ORT_RETURN_IF(alloc == nullptr, "No allocator for ", location.ToString(), " to allocate initializer ", name);
+      TensorShape shape(std::vector<int64_t>(tensor_proto.dims().begin(), tensor_proto.dims().end()));
+      initializer.separate_tensor = onnxruntime::make_unique<Tensor>(
+          DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType(), shape, alloc);
+      initializer.m = onnxruntime::make_unique<MemBuffer>(initializer.separate_tensor->MutableDataRaw(),
+                                                          initializer.separate_tensor->SizeInBytes(),
+                                                          initializer.separate_tensor->Location());
+    } else {
       // TODO: if the tensor need be copied, does it have enough room?
-      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m));
+      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, initializer.m));
 #ifndef NDEBUG
-      ORT_ENFORCE(m != nullptr);
-      ORT_ENFORCE(m->GetBuffer() != nullptr || m->GetLen() == 0);
+      ORT_ENFORCE(initializer.m != nullptr);
+      ORT_ENFORCE(initializer.m->GetBuffer() != nullptr || initializer.m->GetLen() == 0);
 #endif
-      Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, *m, default_cpu_memory_info, ort_value, deleter,
-                                         data_transfer_mgr);
-      if (!st.IsOK()) {
-        std::ostringstream oss;
-        oss << "Deserialize tensor " << name << " failed." << st.ErrorMessage();
-        return Status(st.Category(), st.Code(), oss.str());
+    }
+  }
+
+  auto deserialize = [&](InitializerToSave& initializer) {
+    ORT_TRY {
+      initializer.status = DeserializeTensorProto(env, graph_loc, *initializer.tensor_proto, *initializer.m,
+                                                  default_cpu_memory_info, initializer.ort_value, initializer.deleter,
+                                                  data_transfer_mgr, use_mmap_for_external_data);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        initializer.status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+      });
+    }
+  };
+
+  std::vector<InitializerToSave*> cpu_initializers;
+  for (auto& initializer : initializers_to_save) {
+    if (initializer.m == nullptr) {
+      continue;
+    }
+
+    if (IsCpuLocation(initializer.m->GetAllocInfo())) {
+      cpu_initializers.push_back(&initializer);
+    } else {
+      deserialize(initializer);
+    }
+  }
+
+  // the largest initializers are deserialized first to balance the work between the threads
+  std::stable_sort(cpu_initializers.begin(), cpu_initializers.end(),
+                   [](const InitializerToSave* a, const InitializerToSave* b) {
+                     return a->m->GetLen() > b->m->GetLen();
+                   });
+  concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, static_cast<std::ptrdiff_t>(cpu_initializers.size()),
+                                                [&](std::ptrdiff_t i) { deserialize(*cpu_initializers[i]); });
+
+  for (size_t i = 0, end = initializers_to_save.size(); i < end; ++i) {
+    InitializerToSave& initializer = initializers_to_save[i];
+    const Status& st = initializer.status;
+    if (!st.IsOK()) {
+      // release the resources of the initializers that won't be saved
+      for (size_t j = i; j < end; ++j) {
+        const OrtCallback& d = initializers_to_save[j].deleter;
+        if (d.f != nullptr) d.f(d.param);
       }
+
+      std::ostringstream oss;
+      oss << "Deserialize tensor " << initializer.name << " failed." << st.ErrorMessage();
+      return Status(st.Category(), st.Code(), oss.str());
+    }
+
+    if (initializer.separate_tensor != nullptr) {
+      // the deserialized tensor refers to the buffer of this tensor, which frees it when the OrtValue is released
+      auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+      initializer.ort_value.Init(initializer.separate_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
     }
 
     // any outer scope value is shadowed by a local value and can't override it.
     // due to that check_outer_scope is false
-    bool constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
-    ORT_RETURN_IF_ERROR(save_tensor_func(ort_value_index, ort_value, deleter, constant));
+    bool constant = graph.IsConstantInitializer(initializer.name, /* check_outer_scope */ false);
+    ORT_RETURN_IF_ERROR(save_tensor_func(initializer.ort_value_index, initializer.ort_value, initializer.deleter,
+                                         constant));
 
-    VLOGS(logger, 1) << "Added weight with name : " << name << " with index: " << ort_value_index;
+    VLOGS(logger, 1) << "Added weight with name : " << initializer.name << " with index: "
+                     << initializer.ort_value_index;
   }
 
   LOGS(logger, INFO) << "Done saving initialized tensors";
@@ -44,6 +44,14 @@ size_t Tensor::SizeInBytes() const {
   return ret;
 }
 
+void Tensor::SetExternalData(void* p_data, const int64_t* dims, size_t num_dims) {
+  ORT_ENFORCE(!OwnsBuffer(), "The data of a tensor that owns its buffer can't be replaced");
+  shape_.Assign(dims, num_dims);
+  if (shape_.Size() < 0) ORT_THROW("shape.Size() must >=0");
+  p_data_ = p_data;
+  byte_offset_ = 0;
+}
+
 void Tensor::Init(MLDataType p_type, const TensorShape& shape, void* p_raw_data, AllocatorPtr deleter, ptrdiff_t offset) {
   int64_t shape_size = shape.Size();
   if (shape_size < 0) ORT_THROW("shape.Size() must >=0");
@@ -0,0 +1,271 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/tensor_calibration_stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+#include "core/common/make_unique.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/session_state.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+constexpr size_t TensorCalibrationStats::kNumQuantizedBins;
+
+TensorCalibrationStats::TensorCalibrationStats(const GraphViewer& graph_viewer,
+                                               const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                               const std::unordered_set<std::string>& tensor_names,
+                                               size_t num_histogram_bins)
+    : num_histogram_bins_(num_histogram_bins) {
+  ORT_ENFORCE(num_histogram_bins_ >= 2 * kNumQuantizedBins && num_histogram_bins_ % 2 == 0,
+              "The number of histogram bins must be even and at least ", 2 * kNumQuantizedBins, ", got ",
+              num_histogram_bins_);
+
+  const bool select_all = tensor_names.count("*") > 0;
+  entries_.resize(static_cast<size_t>(ort_value_name_idx_map.MaxIdx() + 1));
+  auto select = [&](const NodeArg& node_arg) -> int {
+    int idx = -1;
+    if (!node_arg.Exists() || (!select_all && tensor_names.count(node_arg.Name()) == 0) ||
+        !ort_value_name_idx_map.GetIdx(node_arg.Name(), idx).IsOK()) {
+      return -1;
+    }
+
+    auto& entry = entries_[idx];
+    if (!entry) {
+      entry = onnxruntime::make_unique<Entry>();
+      entry->name = node_arg.Name();
+    }
+    return idx;
+  };
+
+  for (const auto* input : graph_viewer.GetInputs()) {
+    select(*input);
+  }
+
+  node_outputs_.resize(static_cast<size_t>(graph_viewer.MaxNodeIndex()));
+  for (const auto& node : graph_viewer.Nodes()) {
+    const auto& output_defs = node.OutputDefs();
+    for (size_t i = 0, end = output_defs.size(); i < end; ++i) {
+      const int idx = select(*output_defs[i]);
+      if (idx >= 0) {
+        node_outputs_[node.Index()].emplace_back(static_cast<int>(i), idx);
+      }
+    }
+  }
+}
+
+void TensorCalibrationStats::RecordValues(Entry& entry, const float* values, size_t num_values) {
+  uint64_t count = 0;
+  float min = std::numeric_limits<float>::max();
+  float max = std::numeric_limits<float>::lowest();
+  for (size_t i = 0; i < num_values; ++i) {
+    const float value = values[i];
+    if (std::isfinite(value)) {
+      min = std::min(min, value);
+      max = std::max(max, value);
+      ++count;
+    }
+  }
+
+  if (count == 0) {
+    return;
+  }
+
+  const float max_abs = std::max(std::abs(min), std::abs(max));
+  std::lock_guard<OrtMutex> lock(entry.mutex);
+  if (entry.count == 0) {
+    entry.min = min;
+    entry.max = max;
+  } else {
+    entry.min = std::min(entry.min, min);
+    entry.max = std::max(entry.max, max);
+  }
+  entry.count += count;
+
+  // the range grows by merging pairs of bins so the bins recorded so far stay exact
+  auto& histogram = entry.histogram;
+  const size_t num_bins = histogram.size();
+  if (entry.histogram_range == 0.f) {
+    entry.histogram_range = max_abs;
+  }
+  while (entry.histogram_range < max_abs) {
+    for (size_t i = 0; i < num_bins / 2; ++i) {
+      histogram[i] = histogram[2 * i] + histogram[2 * i + 1];
+    }
+    std::fill(histogram.begin() + num_bins / 2, histogram.end(), 0);
+    entry.histogram_range *= 2;
+  }
+
+  const float bins_per_unit = entry.histogram_range > 0.f ? num_bins / entry.histogram_range : 0.f;
+  for (size_t i = 0; i < num_values; ++i) {
+    const float value = values[i];
+    if (std::isfinite(value)) {
+      const size_t bin = static_cast<size_t>(std::abs(value) * bins_per_unit);
+      ++histogram[std::min(bin, num_bins - 1)];
+    }
+  }
+}
+
+Status TensorCalibrationStats::Record(int ort_value_idx, const OrtValue& value, const SessionState& session_state) {
+  if (ort_value_idx < 0 || static_cast<size_t>(ort_value_idx) >= entries_.size() || !entries_[ort_value_idx] ||
+      !value.IsTensor()) {
+    return Status::OK();
+  }
+
+  const Tensor& tensor = value.Get<Tensor>();
+  if (!tensor.IsDataType<float>() && !tensor.IsDataType<MLFloat16>()) {
+    return Status::OK();
+  }
+
+  // the statistics of the tensors of the other devices are computed from a copy on the CPU
+  const Tensor* p_cpu_tensor = &tensor;
+  std::unique_ptr<Tensor> cpu_tensor;
+  if (tensor.Location().device.Type() != OrtDevice::CPU) {
+    cpu_tensor = onnxruntime::make_unique<Tensor>(tensor.DataType(), tensor.Shape(),
+                                                  session_state.GetAllocator(OrtDevice()));
+    ORT_RETURN_IF_ERROR(session_state.GetDataTransferMgr().CopyTensor(tensor, *cpu_tensor));
+    p_cpu_tensor = cpu_tensor.get();
+  }
+
+  Entry& entry = *entries_[ort_value_idx];
+  {
+    std::lock_guard<OrtMutex> lock(entry.mutex);
+    if (entry.histogram.empty()) {
+      entry.histogram.resize(num_histogram_bins_);
+    }
+  }
+
+  const size_t num_values = static_cast<size_t>(p_cpu_tensor->Shape().Size());
+  if (p_cpu_tensor->IsDataType<float>()) {
+    RecordValues(entry, p_cpu_tensor->Data<float>(), num_values);
+  } else {
+    const MLFloat16* half_values = p_cpu_tensor->Data<MLFloat16>();
+    std::vector<float> values(half_values, half_values + num_values);
+    RecordValues(entry, values.data(), num_values);
+  }
+
+  return Status::OK();
+}
+
+Status TensorCalibrationStats::RecordNodeOutputs(NodeIndex node_index, OpKernelContextInternal& context,
+                                                 const SessionState& session_state) {
+  if (node_index >= node_outputs_.size()) {
+    return Status::OK();
+  }
+
+  for (const auto& output : node_outputs_[node_index]) {
+    const OrtValue* value = context.GetOutputMLValue(output.first);
+    if (value != nullptr && value->IsAllocated()) {
+      ORT_RETURN_IF_ERROR(Record(output.second, *value, session_state));
+    }
+  }
+
+  return Status::OK();
+}
+
+// The threshold of the absolute values whose int8 quantization loses the least information, as in the entropy
+// calibration of TensorRT: the one minimizing the KL divergence between the histogram clipped to it and the histogram
+// quantized to kNumQuantizedBins bins.
+static float EntropyThreshold(const std::vector<uint64_t>& histogram, float histogram_range, size_t num_quantized_bins) {
+  const size_t num_bins = histogram.size();
+  std::vector<double> outliers(num_bins + 1, 0.0);
+  for (size_t i = num_bins; i > 0; --i) {
+    outliers[i - 1] = outliers[i] + static_cast<double>(histogram[i - 1]);
+  }
+
+  const double total = outliers[0];
+  if (total == 0.0) {
+    return 0.f;
+  }
+
+  double best_divergence = std::numeric_limits<double>::max();
+  size_t best_num_bins = num_bins;
+  std::vector<double> quantized(num_bins);
+  for (size_t i = num_quantized_bins; i <= num_bins; ++i) {
+    const double clipped_total = total - outliers[i];
+    if (clipped_total == 0.0) {
+      continue;
+    }
+
+    // each quantized bin spreads its count uniformly over the non empty bins it merges
+    for (size_t j = 0; j < num_quantized_bins; ++j) {
+      const size_t begin = j * i / num_quantized_bins;
+      const size_t end = (j + 1) * i / num_quantized_bins;
+      double sum = 0.0;
+      size_t num_non_empty = 0;
+      for (size_t k = begin; k < end; ++k) {
+        sum += static_cast<double>(histogram[k]);
+        num_non_empty += histogram[k] != 0 ? 1 : 0;
+      }
+      for (size_t k = begin; k < end; ++k) {
+        quantized[k] = histogram[k] != 0 ? sum / num_non_empty : 0.0;
+      }
+    }
+
+    // the clipped histogram adds the values above the threshold to its last bin
+    double divergence = 0.0;
+    for (size_t k = 0; k < i; ++k) {
+      const double p = (static_cast<double>(histogram[k]) + (k == i - 1 ? outliers[i] : 0.0)) / total;
+      if (p > 0.0) {
+        const double q = std::max(quantized[k] / clipped_total, 1e-12);
+        divergence += p * std::log(p / q);
+      }
+    }
+
+    if (divergence < best_divergence) {
+      best_divergence = divergence;
+      best_num_bins = i;
+    }
+  }
+
+  return histogram_range * best_num_bins / num_bins;
+}
+
+std::string TensorCalibrationStats::ToJson() const {
+  std::ostringstream os;
+  os.precision(9);
+  os << "{\"tensors\" : [";
+  bool is_first = true;
+  for (const auto& entry : entries_) {
+    if (!entry) {
+      continue;
+    }
+
+    std::lock_guard<OrtMutex> lock(entry->mutex);
+    if (entry->count == 0) {
+      continue;
+    }
+
+    os << (is_first ? "" : ", ") << "{\"name\" : \"" << entry->name << "\", \"count\" : " << entry->count
+       << ", \"min\" : " << entry->min << ", \"max\" : " << entry->max
+       << ", \"histogram_range\" : " << entry->histogram_range << ", \"histogram\" : [";
+    for (size_t i = 0, end = entry->histogram.size(); i < end; ++i) {
+      os << (i == 0 ? "" : ", ") << entry->histogram[i];
+    }
+    os << "], \"entropy_threshold\" : "
+       << EntropyThreshold(entry->histogram, entry->histogram_range, kNumQuantizedBins) << "}";
+    is_first = false;
+  }
+
+  os << "]}";
+  return os.str();
+}
+
+void TensorCalibrationStats::Reset() {
+  for (auto& entry : entries_) {
+    if (entry) {
+      std::lock_guard<OrtMutex> lock(entry->mutex);
+      entry->count = 0;
+      entry->histogram_range = 0.f;
+      std::fill(entry->histogram.begin(), entry->histogram.end(), 0);
+    }
+  }
+}
+
+}  // namespace onnxruntime
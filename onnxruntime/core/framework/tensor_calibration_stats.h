@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/graph/basic_types.h"
+#include "core/platform/ort_mutex.h"
+
+struct OrtValue;
+namespace onnxruntime {
+class GraphViewer;
+class OpKernelContextInternal;
+class OrtValueNameIdxMap;
+class SessionState;
+
+/**
+ * Running statistics of the values of selected float tensors of a graph, collected while the graph executes for
+ * the calibration of quantization: the min and max, a histogram of the absolute values and the entropy calibrated
+ * threshold derived from it. The graph is not modified and only the statistics are kept, so calibrating a model takes
+ * no extra outputs and no copies of the tensors besides the ones from the devices other than the CPU.
+ * The tensors are selected at construction. Recording a tensor locks only its own statistics.
+ */
+class TensorCalibrationStats {
+ public:
+  /**
+   * @param tensor_names the names of the graph inputs and node outputs to collect the statistics of. "*" selects
+   * all of them. The names of other values, such as the initializers, are ignored.
+   * @param num_histogram_bins the number of bins of the histograms, at least 2 * kNumQuantizedBins and even.
+   */
+  TensorCalibrationStats(const GraphViewer& graph_viewer, const OrtValueNameIdxMap& ort_value_name_idx_map,
+                         const std::unordered_set<std::string>& tensor_names, size_t num_histogram_bins);
+
+  /** Records the value with index ort_value_idx if it is a selected float or float16 tensor. */
+  Status Record(int ort_value_idx, const OrtValue& value, const SessionState& session_state);
+
+  /** Records the selected outputs of a node once its kernel computed them. */
+  Status RecordNodeOutputs(NodeIndex node_index, OpKernelContextInternal& context, const SessionState& session_state);
+
+  /**
+   * Returns the statistics as JSON: for each selected tensor that was recorded its name, the number of values and
+   * the min and max of the finite values, the upper bound of the range of absolute values the histogram covers, the
+   * counts of its bins, and the entropy calibrated threshold of the absolute values for int8 quantization.
+   */
+  std::string ToJson() const;
+
+  void Reset();
+
+  // number of bins of the int8 quantization the entropy calibrated threshold is computed for
+  static constexpr size_t kNumQuantizedBins = 128;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(TensorCalibrationStats);
+
+  struct Entry {
+    std::string name;
+    mutable OrtMutex mutex;
+    uint64_t count = 0;               // GUARDED_BY(mutex)
+    float min = 0.f;                  // GUARDED_BY(mutex)
+    float max = 0.f;                  // GUARDED_BY(mutex)
+    float histogram_range = 0.f;      // GUARDED_BY(mutex)
+    std::vector<uint64_t> histogram;  // GUARDED_BY(mutex)
+  };
+
+  static void RecordValues(Entry& entry, const float* values, size_t num_values);
+
+  const size_t num_histogram_bins_;
+
+  // indexed by the OrtValue index. null for the values that are not selected.
+  std::vector<std::unique_ptr<Entry>> entries_;
+  // indexed by NodeIndex. the output index and OrtValue index of the selected outputs of each node.
+  std::vector<std::vector<std::pair<int, int>>> node_outputs_;
+};
+
+}  // namespace onnxruntime
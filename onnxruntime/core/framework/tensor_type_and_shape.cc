@@ -220,6 +220,44 @@ ORT_API_STATUS_IMPL(OrtApis::GetTensorTypeAndShape, _In_ const OrtValue* v, _Out
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::GetTensorTypesAndShapes, _In_reads_(num_values) const OrtValue* const* values,
+                    size_t num_values, _Out_writes_(num_values) ONNXTensorElementDataType* element_types,
+                    _Out_writes_(num_values) size_t* ranks, _Out_writes_(dims_len) int64_t* dims, size_t dims_len) {
+  API_IMPL_BEGIN
+  size_t dims_used = 0;
+  for (size_t i = 0; i != num_values; ++i) {
+    const OrtValue* v = values[i];
+    if (v == nullptr || !v->IsAllocated()) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "the value is null or not allocated");
+    }
+    onnxruntime::MLDataType type = v->Type();
+    const onnxruntime::TensorShape* shape = nullptr;
+    onnxruntime::MLDataType data_type = nullptr;
+    if (type->IsTensorType()) {
+      const Tensor& tensor = v->Get<onnxruntime::Tensor>();
+      shape = &tensor.Shape();
+      data_type = tensor.DataType();
+    } else if (type->IsSparseTensorType()) {
+      const SparseTensor& tensor = v->Get<onnxruntime::SparseTensor>();
+      shape = &tensor.Shape();
+      data_type = tensor.Values().DataType();
+    } else {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Argument is not a tensor");
+    }
+
+    const size_t rank = shape->NumDimensions();
+    if (rank > dims_len - dims_used) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "dims_len is less than the sum of the ranks of the values");
+    }
+    element_types[i] = MLDataTypeToOnnxRuntimeTensorElementDataType(data_type);
+    ranks[i] = rank;
+    shape->CopyDims(dims + dims_used, rank);
+    dims_used += rank;
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::GetValueType, _In_ const OrtValue* v, _Out_ ONNXType* out) {
   API_IMPL_BEGIN
   OrtTypeInfo* type_info;
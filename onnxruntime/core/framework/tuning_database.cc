@@ -0,0 +1,173 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/tuning_database.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <locale>
+#include <sstream>
+
+#include "core/common/logging/logging.h"
+
+namespace onnxruntime {
+namespace tuning {
+
+namespace {
+constexpr const char* kFileHeader = "# onnxruntime tuning database: <key> <values...>";
+
+bool HasWhitespace(const std::string& key) {
+  return std::any_of(key.begin(), key.end(), [](char c) { return std::isspace(static_cast<unsigned char>(c)); });
+}
+}  // namespace
+
+Status TuningDatabase::Load(const std::string& file_path) {
+  std::ifstream stream(file_path);
+  if (!stream.is_open()) {
+    // nothing was tuned yet
+    return Status::OK();
+  }
+
+  std::unordered_map<std::string, std::vector<int64_t>> records;
+  std::string line;
+  size_t line_number = 0;
+  while (std::getline(stream, line)) {
+    ++line_number;
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    std::istringstream line_stream(line);
+    line_stream.imbue(std::locale::classic());
+    std::string key;
+    line_stream >> key;
+    std::vector<int64_t> values;
+    int64_t value;
+    while (line_stream >> value) {
+      values.push_back(value);
+    }
+
+    ORT_RETURN_IF(key.empty() || values.empty() || !line_stream.eof(), "Invalid record at line ", line_number,
+                  " of the tuning database ", file_path);
+    records[key] = std::move(values);
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  for (auto& record : records) {
+    records_[record.first] = std::move(record.second);
+  }
+  size_.store(records_.size(), std::memory_order_relaxed);
+
+  return Status::OK();
+}
+
+Status TuningDatabase::Save(const std::string& file_path) const {
+  std::vector<std::pair<std::string, std::vector<int64_t>>> records;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    records.assign(records_.begin(), records_.end());
+  }
+  std::sort(records.begin(), records.end());
+
+  // write a temporary file and rename it, so a process loading the database never sees a partial file
+  const std::string temp_file_path = file_path + ".tmp";
+  {
+    std::ofstream stream(temp_file_path, std::ios::out | std::ios::trunc);
+    ORT_RETURN_IF_NOT(stream.is_open(), "Failed to open ", temp_file_path, " to save the tuning database");
+    stream.imbue(std::locale::classic());
+    stream << kFileHeader << "\n";
+    for (const auto& record : records) {
+      stream << record.first;
+      for (int64_t value : record.second) {
+        stream << " " << value;
+      }
+      stream << "\n";
+    }
+    ORT_RETURN_IF_NOT(stream.good(), "Failed to write the tuning database to ", temp_file_path);
+  }
+
+  std::remove(file_path.c_str());
+  ORT_RETURN_IF_NOT(std::rename(temp_file_path.c_str(), file_path.c_str()) == 0,
+                    "Failed to rename ", temp_file_path, " to ", file_path);
+  return Status::OK();
+}
+
+bool TuningDatabase::Lookup(const std::string& key, std::vector<int64_t>& values) const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto entry = records_.find(key);
+  if (entry == records_.end()) {
+    return false;
+  }
+
+  values = entry->second;
+  return true;
+}
+
+void TuningDatabase::Record(const std::string& key, std::vector<int64_t> values) {
+  ORT_ENFORCE(!key.empty() && !HasWhitespace(key), "Invalid tuning database key: '", key, "'");
+  ORT_ENFORCE(!values.empty(), "A tuning database record needs at least one value.");
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  records_[key] = std::move(values);
+  size_.store(records_.size(), std::memory_order_relaxed);
+}
+
+void TuningDatabase::Clear() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  records_.clear();
+  size_.store(0, std::memory_order_relaxed);
+}
+
+TuningDatabase& GetTuningDatabase() {
+  static TuningDatabase tuning_database;
+  return tuning_database;
+}
+
+namespace {
+std::atomic<bool> tuning_enabled{false};
+
+struct TuningFile {
+  OrtMutex mutex;
+  std::string path;
+};
+
+TuningFile& GetTuningFile() {
+  static TuningFile tuning_file;
+  return tuning_file;
+}
+}  // namespace
+
+void EnableTuning(const std::string& file_path) {
+  if (!file_path.empty()) {
+    auto& tuning_file = GetTuningFile();
+    std::lock_guard<OrtMutex> lock(tuning_file.mutex);
+    tuning_file.path = file_path;
+  }
+
+  tuning_enabled.store(true, std::memory_order_release);
+}
+
+bool IsTuningEnabled() {
+  return tuning_enabled.load(std::memory_order_acquire);
+}
+
+void RecordTuningResult(const std::string& key, std::vector<int64_t> values) {
+  auto& tuning_database = GetTuningDatabase();
+  tuning_database.Record(key, std::move(values));
+
+  // new records are rare, as each problem is tuned once, so the whole file is rewritten every time. the lock
+  // serializes the writers of the file.
+  auto& tuning_file = GetTuningFile();
+  std::lock_guard<OrtMutex> lock(tuning_file.mutex);
+  if (!tuning_file.path.empty()) {
+    auto status = tuning_database.Save(tuning_file.path);
+    if (!status.IsOK()) {
+      LOGS_DEFAULT(WARNING) << status.ErrorMessage();
+    }
+  }
+}
+
+}  // namespace tuning
+}  // namespace onnxruntime
@@ -0,0 +1,68 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace tuning {
+
+/**
+ * The implementations chosen for kernel problems, e.g. the cuDNN algorithm of a convolution of a given shape.
+ * A record maps a key that identifies the problem completely, including the kernel and anything the timing depends
+ * on such as the device or the number of threads, to the values that describe the choice. Keys have no whitespace.
+ * The methods are thread safe.
+ */
+class TuningDatabase {
+ public:
+  TuningDatabase() = default;
+
+  /** Adds the records of a file written by Save. A record replaces one with the same key. */
+  Status Load(const std::string& file_path);
+
+  /** Writes all the records to a file, replacing it. */
+  Status Save(const std::string& file_path) const;
+
+  bool Lookup(const std::string& key, std::vector<int64_t>& values) const;
+
+  void Record(const std::string& key, std::vector<int64_t> values);
+
+  /** Takes no lock, so kernels can skip building their keys cheaply when there are no records. */
+  size_t Size() const { return size_.load(std::memory_order_relaxed); }
+
+  void Clear();
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(TuningDatabase);
+
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::string, std::vector<int64_t>> records_;
+  std::atomic<size_t> size_{0};
+};
+
+/** The database shared by the kernels of all the sessions in the process. */
+TuningDatabase& GetTuningDatabase();
+
+/**
+ * Enables tuning: kernels that have alternative implementations benchmark them for the problems that have no record
+ * and record the fastest. If file_path is not empty the database is saved to it after each new record.
+ * Tuning stays enabled for the process once a session enabled it.
+ */
+void EnableTuning(const std::string& file_path);
+
+bool IsTuningEnabled();
+
+/** Records the result of a tuning in the shared database, and saves it if EnableTuning was given a file. */
+void RecordTuningResult(const std::string& key, std::vector<int64_t> values);
+
+}  // namespace tuning
+}  // namespace onnxruntime
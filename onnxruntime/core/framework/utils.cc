@@ -10,13 +10,16 @@
 #include "core/framework/execution_frame.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/feeds_fetches_manager.h"
+#include "core/framework/heterogeneous_executor.h"
 #include "core/framework/kernel_def_builder.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/parallel_executor.h"
+#include "core/framework/run_latency_breakdown.h"
 #include "core/framework/session_state.h"
 #include "core/framework/sequential_executor.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/framework/work_stealing_executor.h"
 #include "core/mlas/inc/mlas.h"
 
 namespace ONNX_NAMESPACE {
@@ -434,20 +437,34 @@ static common::Status ExecuteGraphImpl(const SessionState& session_state,
                                        const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
                                        const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
                                        ExecutionMode execution_mode, const bool& terminate_flag,
-                                       const logging::Logger& logger, const bool only_execute_path_to_fetches = false) {
+                                       const logging::Logger& logger, const bool only_execute_path_to_fetches = false,
+                                       RunLatencyBreakdown* latency_breakdown = nullptr,
+                                       const ExecutionThreadPools* thread_pools = nullptr,
+                                       const std::chrono::steady_clock::time_point* deadline = nullptr) {
   std::unique_ptr<IExecutor> p_exec;
   if (execution_mode == ExecutionMode::ORT_SEQUENTIAL) {
     p_exec = std::unique_ptr<IExecutor>(new SequentialExecutor(terminate_flag, only_execute_path_to_fetches));
-  } else if (execution_mode == ExecutionMode::ORT_PARALLEL) {
-    auto* p_inter_op_thread_pool = session_state.GetInterOpThreadPool();
+  } else if (execution_mode == ExecutionMode::ORT_PARALLEL ||
+             execution_mode == ExecutionMode::ORT_PARALLEL_WORK_STEALING ||
+             execution_mode == ExecutionMode::ORT_PARALLEL_HETEROGENEOUS) {
+    auto* p_inter_op_thread_pool = thread_pools ? thread_pools->inter_op_thread_pool
+                                                : session_state.GetInterOpThreadPool();
     if (!p_inter_op_thread_pool) {
       LOGS(logger, WARNING) << "Only one thread was configured for parallel execution. Hence will use sequential execution.";
       p_exec = std::unique_ptr<IExecutor>(new SequentialExecutor(terminate_flag, only_execute_path_to_fetches));
+    } else if (execution_mode == ExecutionMode::ORT_PARALLEL_WORK_STEALING) {
+      p_exec = std::unique_ptr<IExecutor>(new WorkStealingExecutor(session_state, terminate_flag));
+    } else if (execution_mode == ExecutionMode::ORT_PARALLEL_HETEROGENEOUS) {
+      p_exec = std::unique_ptr<IExecutor>(new HeterogeneousExecutor(session_state, terminate_flag));
     } else {
       p_exec = std::unique_ptr<IExecutor>(new ParallelExecutor(session_state, terminate_flag));
     }
   }
 
+  p_exec->SetLatencyBreakdown(latency_breakdown);
+  p_exec->SetThreadPools(thread_pools);
+  p_exec->SetDeadline(deadline);
+
   const auto& feeds_fetches_info = feeds_fetches_manager.GetFeedsFetchesInfo();
   const auto& device_copy_checks = feeds_fetches_manager.GetDeviceCopyChecks();
 
@@ -466,7 +483,11 @@ static common::Status ExecuteGraphImpl(const SessionState& session_state,
 
     if (device_copy_checks.input_copy_needed == DeviceCopyCheck::Copy) {
       const auto& feed_copy_info = feeds_fetches_manager.GetFeedsDeviceCopyInfo();
+      const auto copy_begin_time = std::chrono::steady_clock::now();
       ORT_RETURN_IF_ERROR(CopyInputsAcrossDevices(session_state, feeds, device_feeds, feed_copy_info));
+      if (latency_breakdown) {
+        latency_breakdown->input_copy_ns += RunLatencyBreakdown::ElapsedNs(copy_begin_time);
+      }
       p_feeds = &device_feeds;
     }
 
@@ -495,7 +516,11 @@ static common::Status ExecuteGraphImpl(const SessionState& session_state,
                                         logger));
 
     if (device_copy_checks.output_copy_needed == DeviceCopyCheck::Copy) {
+      const auto copy_begin_time = std::chrono::steady_clock::now();
       ORT_RETURN_IF_ERROR(CopyOutputsAcrossDevices(session_state, *p_fetches, fetches, fetch_copy_info));
+      if (latency_breakdown) {
+        latency_breakdown->output_copy_ns += RunLatencyBreakdown::ElapsedNs(copy_begin_time);
+      }
     }
   }
 
@@ -505,25 +530,56 @@ static common::Status ExecuteGraphImpl(const SessionState& session_state,
 common::Status ExecuteGraph(const SessionState& session_state,
                             FeedsFetchesManager& feeds_fetches_manager,
                             const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
+                            const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
                             ExecutionMode execution_mode, const bool& terminate_flag,
-                            const logging::Logger& logger, bool only_execute_path_to_fetches) {
+                            const logging::Logger& logger, bool only_execute_path_to_fetches,
+                            RunLatencyBreakdown* latency_breakdown, const ExecutionThreadPools* thread_pools,
+                            const std::chrono::steady_clock::time_point* deadline) {
   ORT_RETURN_IF_ERROR(utils::InitializeFeedFetchCopyInfo(session_state, feeds_fetches_manager));
 
   // finalize the copy info using the provided feeds and fetches. will update device_copy_checks in the background
   FinalizeFeedFetchCopyInfo(feeds_fetches_manager, feeds, fetches);
 
-  auto status = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, {},
-                                 execution_mode, terminate_flag, logger, only_execute_path_to_fetches);
+  auto status = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
+                                 execution_mode, terminate_flag, logger, only_execute_path_to_fetches,
+                                 latency_breakdown, thread_pools, deadline);
 
   return status;
 }
 
+common::Status ExecuteGraphWithStaticCopyInfo(const SessionState& session_state,
+                                              const FeedsFetchesManager& feeds_fetches_manager,
+                                              const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
+                                              const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
+                                              ExecutionMode execution_mode, const bool& terminate_flag,
+                                              const logging::Logger& logger, bool only_execute_path_to_fetches,
+                                              RunLatencyBreakdown* latency_breakdown,
+                                              const ExecutionThreadPools* thread_pools,
+                                              const std::chrono::steady_clock::time_point* deadline) {
+  // only CPU based EPs, nothing depends on the feeds and fetches
+  if (feeds_fetches_manager.GetDeviceCopyChecks().status == DeviceCopyCheck::NoCopy) {
+    return ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
+                            execution_mode, terminate_flag, logger, only_execute_path_to_fetches,
+                            latency_breakdown, thread_pools, deadline);
+  }
+
+  FeedsFetchesManager run_feeds_fetches_manager{FeedsFetchesInfo(feeds_fetches_manager.GetFeedsFetchesInfo())};
+  run_feeds_fetches_manager.GetMutableFeedsDeviceCopyInfo() = feeds_fetches_manager.GetFeedsDeviceCopyInfo();
+  run_feeds_fetches_manager.GetMutableFetchesDeviceCopyInfo() = feeds_fetches_manager.GetFetchesDeviceCopyInfo();
+  FinalizeFeedFetchCopyInfo(run_feeds_fetches_manager, feeds, fetches);
+
+  return ExecuteGraphImpl(session_state, run_feeds_fetches_manager, feeds, fetches, fetch_allocators,
+                          execution_mode, terminate_flag, logger, only_execute_path_to_fetches,
+                          latency_breakdown, thread_pools, deadline);
+}
+
 common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFetchesManager& feeds_fetches_manager,
                                const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
                                const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
-                               ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger) {
+                               ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger,
+                               const ExecutionThreadPools* thread_pools) {
   auto status = ExecuteGraphImpl(session_state, feeds_fetches_manager, feeds, fetches, fetch_allocators,
-                                 execution_mode, terminate_flag, logger);
+                                 execution_mode, terminate_flag, logger, false, nullptr, thread_pools);
   return status;
 }
 
@@ -67,17 +67,40 @@ void FinalizeFeedFetchCopyInfo(FeedsFetchesManager& feeds_fetches_manager,
                                const std::vector<const OrtMemoryInfo*>& fetch_alloc_info);
 
 // Execute the main graph. The feed_fetches_manager will be finalized based on the provided feeds and fetches.
+// fetch_allocators are keyed by the index of the fetch and are used for fetches that are not pre-allocated.
+// The device copy, frame setup and kernel times are added to latency_breakdown if it is not null.
+// The kernels run on thread_pools if it is not null, or else on the thread pools of the session state.
+// The execution fails before the next node once deadline has passed if it is not null.
 common::Status ExecuteGraph(const SessionState& session_state, FeedsFetchesManager& feeds_fetches_manager,
                             const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
+                            const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
                             ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger,
-                            bool only_execute_path_to_fetches = false);
+                            bool only_execute_path_to_fetches = false,
+                            RunLatencyBreakdown* latency_breakdown = nullptr,
+                            const ExecutionThreadPools* thread_pools = nullptr,
+                            const std::chrono::steady_clock::time_point* deadline = nullptr);
+
+// Execute the main graph with a feeds_fetches_manager shared by many runs, whose static copy info was initialized
+// with InitializeFeedFetchCopyInfo. It's used as is if no device copies are needed. Otherwise the copy info is
+// finalized based on the provided feeds and fetches on a copy of it, so concurrent runs may share it.
+common::Status ExecuteGraphWithStaticCopyInfo(const SessionState& session_state,
+                                              const FeedsFetchesManager& feeds_fetches_manager,
+                                              const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
+                                              const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
+                                              ExecutionMode execution_mode, const bool& terminate_flag,
+                                              const logging::Logger& logger, bool only_execute_path_to_fetches = false,
+                                              RunLatencyBreakdown* latency_breakdown = nullptr,
+                                              const ExecutionThreadPools* thread_pools = nullptr,
+                                              const std::chrono::steady_clock::time_point* deadline = nullptr);
 
 // Execute a subgraph. The feeds_fetches_manager should have been finalized prior to calling this function.
 // See IControlFlowNode::SetupSubgraphExecutionInfo usage in the control flow kernels.
+// The kernels run on thread_pools if it is not null, which should be the thread pools of the control flow node.
 common::Status ExecuteSubgraph(const SessionState& session_state, const FeedsFetchesManager& feeds_fetches_manager,
                                const std::vector<OrtValue>& feeds, std::vector<OrtValue>& fetches,
                                const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
-                               ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger);
+                               ExecutionMode execution_mode, const bool& terminate_flag, const logging::Logger& logger,
+                               const ExecutionThreadPools* thread_pools = nullptr);
 
 template <typename T>
 constexpr ONNXTensorElementDataType GetONNXTensorElementDataType() {
@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "core/common/common.h"
+#include "core/common/status.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/iexecutor.h"
+#include "core/framework/framework_common.h"
+#include "core/framework/ml_value.h"
+#include "core/framework/session_state.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class ExecutionFrame;
+
+/**
+Inter-op parallel executor used for ExecutionMode::ORT_PARALLEL_WORK_STEALING.
+
+Compared to ParallelExecutor, which takes a mutex for every dependency update and schedules every ready node
+as a separate task:
+  - dependency and outstanding task counts are atomics so no lock is taken on the per-node path.
+  - the thread that finishes a node continues with its first ready successor (continuation passing).
+  - other ready successors that are estimated to be cheap are also run inline on the current thread, as
+    scheduling them would cost more than running them. Only expensive successors are handed to the inter-op
+    thread pool, whose threads each have their own queue and steal work from other threads when idle.
+  - the thread calling Execute participates by running a chain of nodes starting from the first root node.
+*/
+class WorkStealingExecutor : public IExecutor {
+ public:
+  WorkStealingExecutor(const SessionState& session_state, const bool& terminate_flag = false);
+
+  common::Status Execute(const SessionState& session_state, const std::vector<int>& feed_mlvalue_idxs,
+                         const std::vector<OrtValue>& feeds, const std::vector<int>& fetch_mlvalue_idxs,
+                         std::vector<OrtValue>& fetches,
+                         const std::unordered_map<size_t, CustomAllocator>& fetch_allocators,
+                         const logging::Logger& logger) override;
+
+  // Nodes with an estimated cost at or below this are run inline instead of being scheduled.
+  // The cost is the total number of elements in the node's outputs, which is only known if the output shapes are
+  // fully static. Nodes with unknown output sizes are treated as expensive.
+  static constexpr int64_t kInlineNodeCostThreshold = 4096;
+
+  // Returns true if the node is cheap enough to be run inline on the current thread.
+  static bool IsInlineCandidate(const Node& node);
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(WorkStealingExecutor);
+
+  // Run the nodes in ready_nodes, and any successors that become ready and are suitable for inline execution.
+  Status RunReadyNodes(std::vector<size_t>& ready_nodes, const SessionState& session_state,
+                       const logging::Logger& logger);
+
+  Status RunNode(size_t node_index, const SessionState& session_state, const logging::Logger& logger);
+
+  void ScheduleNode(size_t node_index, const SessionState& session_state, const logging::Logger& logger);
+
+  void FinishTask(const Status& status);
+
+  std::unique_ptr<ExecutionFrame> root_frame_;
+
+  // number of inputs edges for each node that are not yet satisfied
+  std::unique_ptr<std::atomic<int>[]> node_refs_;
+
+  // number of tasks running or scheduled, including the task run by the thread calling Execute
+  std::atomic<int> out_standings_{0};
+  std::atomic<bool> has_errors_{false};
+
+  OrtMutex complete_mutex_;
+  OrtCondVar complete_cv_;
+  std::vector<Status> errors_;  // protected by complete_mutex_
+  OrtMutex latency_breakdown_mutex_;  // the nodes record their kernel times concurrently
+
+  const bool& terminate_flag_;
+  onnxruntime::concurrency::ThreadPool* executor_pool_{};
+};
+}  // namespace onnxruntime
@@ -1684,6 +1684,64 @@ Matrix product that behaves like numpy.matmul: https://docs.scipy.org/doc/numpy-
         updateOutputShape(ctx, 0, input_shape);
       });
 
+  static const char* FusedScaler_ver1_doc = R"DOC(
+The fusion of an ai.onnx.ml Scaler with the Imputer before it and the Normalizer after it, each of which is optional.
+Each row of features of the input is imputed as by Imputer if 'imputed_values' is set, then scaled as by Scaler if
+'scale' and 'offset' are set, then normalized as by Normalizer if 'norm' is set. The input is a tensor of shape
+[N, F] or [F].)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(FusedScaler)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(FusedScaler_ver1_doc)
+      .Input(0, "X", "The rows of features to transform.", "T")
+      .Output(0, "Y", "The transformed features.", "tensor(float)")
+      .TypeConstraint("T", {"tensor(float)", "tensor(double)", "tensor(int64)", "tensor(int32)"}, "The input type must be a tensor of a numeric type.")
+      .Attr("imputed_values", "The values that replace the replaced value, of the size of the features or 1. The Imputer step is skipped if it is not set.", AttributeProto::FLOATS, OPTIONAL_VALUE)
+      .Attr("replaced_value", "The value to replace with the imputed values, which may be NaN.", AttributeProto::FLOAT, 0.f)
+      .Attr("scale", "The scale of the Scaler step, of the size of the features or 1. The Scaler step is skipped if it is not set.", AttributeProto::FLOATS, OPTIONAL_VALUE)
+      .Attr("offset", "The offset of the Scaler step, of the size of scale.", AttributeProto::FLOATS, OPTIONAL_VALUE)
+      .Attr("norm", "The norm of the Normalizer step: 'MAX', 'L1' or 'L2'. The Normalizer step is skipped if it is not set.", AttributeProto::STRING, OPTIONAL_VALUE)
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        ONNX_NAMESPACE::updateOutputElemType(ctx, 0, ONNX_NAMESPACE::TensorProto::FLOAT);
+        if (hasInputShape(ctx, 0)) {
+          propagateShapeFromInputToOutput(ctx, 0, 0);
+        }
+      });
+
+  static const char* MurmurHash3Bucket_ver1_doc = R"DOC(
+Hashes each element of the input with MurmurHash3_x86_32, as MurmurHash3 does, and maps the hash to a bucket
+in [0, num_buckets). This is the hashing trick of feature hashing, fused so that the hashes are not materialized.
+If 'positive' is 1 the bucket is the unsigned hash modulo num_buckets, else it is the absolute value of the
+signed hash modulo num_buckets, as in scikit-learn's FeatureHasher. The bucket ids can be fed to OneHot,
+Gather or EmbeddingBag.)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(MurmurHash3Bucket)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(MurmurHash3Bucket_ver1_doc)
+      .Input(0, "X", "An input tensor to hash.", "T1")
+      .Output(0, "Y", "The bucket of each element of X, with the shape of X.", "T2")
+      .TypeConstraint("T1", {"tensor(uint32)", "tensor(int32)", "tensor(uint64)", "tensor(int64)", "tensor(float)", "tensor(double)", "tensor(string)"}, "Constrain input type to unsigned or signed 32-bit or 64-bit integer, float, double or string tensor. Strings should be utf-8 encoded if using unicode.")
+      .TypeConstraint("T2", {"tensor(int64)"}, "Constrain output type to 64-bit integer tensor.")
+      .Attr("num_buckets", "The number of buckets, a positive integer.", AttributeProto::INT)
+      .Attr(
+          "seed",
+          "Seed for the hashing algorithm, unsigned 32-bit integer, default to 0.",
+          AttributeProto::INT,
+          (int64_t)0LL)
+      .Attr(
+          "positive",
+          "If value is 1, the bucket of the unsigned hash is computed, else the bucket of the absolute value of the signed hash. Default value is 1.",
+          AttributeProto::INT,
+          (int64_t)1LL)
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        ONNX_NAMESPACE::updateOutputElemType(ctx, 0, ONNX_NAMESPACE::TensorProto::INT64);
+        if (hasInputShape(ctx, 0)) {
+          propagateShapeFromInputToOutput(ctx, 0, 0);
+        }
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(GatherND)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -1748,6 +1806,89 @@ Example 4:
   output  = [[[2,3]],[[4,5]]]
 )DOC");
 
+  static const char* ScatterReduction_ver1_doc =
+      "Type of reduction to apply to the updates of the same output element: none (default), add, mul or max. "
+      "'none': the element is replaced by the update, the indices shall not have duplicate entries. "
+      "'add', 'mul', 'max': the element is combined with the updates, in any order. "
+      "The reductions are supported for the float, double, int32 and int64 data.";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(ScatterElements)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Attr("axis",
+            "Which axis to scatter on. Negative value means counting dimensions from the back. "
+            "Accepted range is [-r, r-1] where r = rank(data).",
+            AttributeProto::INT,
+            static_cast<int64_t>(0))
+      .Attr("reduction", ScatterReduction_ver1_doc, AttributeProto::STRING, std::string("none"))
+      .Input(0, "data", "Tensor of rank r >= 1.", "T")
+      .Input(1, "indices", "Tensor of int32/int64 indices, of r >= 1 (same rank as input). All index values are "
+             "expected to be within bounds [-s, s-1] along axis of size s.", "Tind")
+      .Input(2, "updates", "Tensor of rank r >=1 (same rank and shape as indices)", "T")
+      .Output(0, "output", "Tensor of rank r >= 1 (same rank as input).", "T")
+      .TypeConstraint(
+          "T",
+          OpSchema::all_tensor_types(),
+          "Constrain input and output types to any tensor type.")
+      .TypeConstraint(
+          "Tind",
+          {"tensor(int32)", "tensor(int64)"},
+          "Constrain indices to integer types")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (hasNInputShapes(ctx, 1)) {
+          propagateShapeFromInputToOutput(ctx, 0, 0);
+        }
+      })
+      .SetDoc(R"DOC(
+ScatterElements of the ONNX domain extended with the 'reduction' attribute of the later ONNX opsets.
+The output is a copy of `data` in which the element given by the coordinates of each entry of `updates`,
+with the coordinate on `axis` replaced by the entry of `indices`, is updated with the entry, e.g. for a
+2-D tensor and axis = 0
+  output[indices[i][j]][j] = updates[i][j]   if reduction == "none"
+  output[indices[i][j]][j] += updates[i][j]  if reduction == "add"
+
+Example:
+  data      = [0, 0, 0, 0]
+  indices   = [0, 2, 2, 3, 0]
+  updates   = [1, 2, 3, 4, 5]
+  reduction = "add"
+  output    = [6, 0, 5, 4]
+)DOC");
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(ScatterND)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .Attr("reduction", ScatterReduction_ver1_doc, AttributeProto::STRING, std::string("none"))
+      .Input(0, "data", "Tensor of rank r >= 1.", "T")
+      .Input(1, "indices", "Tensor of rank q >= 1.", "tensor(int64)")
+      .Input(2, "updates", "Tensor of rank q + r - indices_shape[-1] - 1.", "T")
+      .Output(0, "output", "Tensor of rank r >= 1.", "T")
+      .TypeConstraint(
+          "T",
+          OpSchema::all_tensor_types(),
+          "Constrain input and output types to any tensor type.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (hasNInputShapes(ctx, 1)) {
+          propagateShapeFromInputToOutput(ctx, 0, 0);
+        }
+      })
+      .SetDoc(R"DOC(
+ScatterND of the ONNX domain extended with the 'reduction' attribute of the later ONNX opsets.
+The output is a copy of `data` in which the slice addressed by each index tuple of the last dimension of
+`indices` is updated with the matching slice of `updates`:
+  output[indices[idx]] = updates[idx]   if reduction == "none"
+  output[indices[idx]] *= updates[idx]  if reduction == "mul"
+
+Example:
+  data      = [[1, 2], [3, 4], [5, 6]]
+  indices   = [[2], [0], [2]]
+  updates   = [[1, 7], [0, 1], [9, 3]]
+  reduction = "max"
+  output    = [[1, 2], [3, 4], [9, 7]]
+)DOC");
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(WordConvEmbedding)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -2184,6 +2325,35 @@ Example 4:
         }
       });
 
+  static const char* FusedElementwise_ver1_doc = R"DOC(
+Applies a chain of elementwise operations to the first input. 'ops' lists the operations in the order they are
+applied: Relu, Sigmoid, Tanh, Neg, Abs, Exp, Log, Sqrt, Reciprocal, Erf, Add, Sub, Mul or Div.
+Each operation is applied to the result of the operation before it, or to the first input for the first operation.
+The values of the chain are numbered: the inputs come first, followed by the result of each operation.
+The other operand of the binary operations Add, Sub, Mul and Div is the value whose number is at the same
+position in 'operands', or the value at the same position in 'scalars' if that number is negative or 'operands'
+is not given. It is the first operand if the value at the same position in 'operand_first' is nonzero.
+The inputs after the first are broadcast to the shape of the first input, which is the shape of the output.
+This is created by the elementwise chain fusion.)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(FusedElementwise)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(FusedElementwise_ver1_doc)
+      .Attr("ops", "The operations to apply in order.", AttributeProto::STRINGS)
+      .Attr("operands", "The number of the value used as the other operand of each operation. "
+            "Ignored for unary operations.",
+            AttributeProto::INTS, OPTIONAL_VALUE)
+      .Attr("scalars", "The scalar operand of each operation. Ignored for unary operations.",
+            AttributeProto::FLOATS, OPTIONAL_VALUE)
+      .Attr("operand_first", "Nonzero if the other operand is the first operand of a binary operation.",
+            AttributeProto::INTS, OPTIONAL_VALUE)
+      .Input(0, "inputs", "The input data followed by the tensor operands of the operations.", "T",
+             OpSchema::Variadic)
+      .Output(0, "Y", "The output.", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
+
   // Register the NCHWc schemas if supported by the platform.
   if (MlasNchwcGetBlockSize() > 1) {
     RegisterNchwcSchemas();
@@ -2367,6 +2537,43 @@ It's an extension of Gelu. It takes the sum of input A and bias input B as the i
           "Constrain input and output types to float tensors.")
       .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
 
+  static const char* EmbeddingBag_ver1_doc = R"DOC(
+Computes sums, means or maxima of bags of embeddings without materializing the gathered embeddings.
+Each row of 'indices' is a bag of row indices into 'weight'. The rows of 'weight' selected by a bag
+are reduced using 'mode' into the corresponding row of the output. This is equivalent to a Gather
+on axis 0 followed by a ReduceSum, ReduceMean or ReduceMax on axis 1. Negative indices count back
+from the end of 'weight'. An empty bag produces a row of zeros.)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(EmbeddingBag)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(EmbeddingBag_ver1_doc)
+      .Attr("mode", "The reduction applied to each bag: 'sum', 'mean' or 'max'.", AttributeProto::STRING, std::string("sum"))
+      .Input(0, "weight", "2D embedding table with shape (num_embeddings, embedding_dim)", "T")
+      .Input(1, "indices", "2D bags of indices with shape (num_bags, bag_size)", "Tind")
+      .Output(0, "output", "2D output tensor with shape (num_bags, embedding_dim)", "T")
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+      .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"}, "Constrain indices to integer types")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 1))
+          return;
+
+        auto& weight_shape = getInputShape(ctx, 0);
+        auto& indices_shape = getInputShape(ctx, 1);
+        if (weight_shape.dim_size() != 2) {
+          fail_shape_inference("weight shall be 2 dimensions");
+        }
+        if (indices_shape.dim_size() != 2) {
+          fail_shape_inference("indices shall be 2 dimensions");
+        }
+
+        ONNX_NAMESPACE::TensorShapeProto output_shape;
+        *output_shape.add_dim() = indices_shape.dim(0);
+        *output_shape.add_dim() = weight_shape.dim(1);
+        updateOutputShape(ctx, 0, output_shape);
+      });
+
   // Register the NCHWc schemas if supported by the platform.
   if (MlasNchwcGetBlockSize() > 1) {
     RegisterNchwcSchemas();
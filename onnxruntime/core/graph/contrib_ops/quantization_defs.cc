@@ -428,6 +428,68 @@ C (int32) = (A - A_zero_point) * (B - B_zero_point)
         ONNX_NAMESPACE::matmulShapeInference(ctx, 0, 1);
       });
 
+  static const char* MatMulWeightOnlyQuant_ver1_doc = R"DOC(
+Matrix product of a float input A with a weight matrix B that is quantized to 4 or 8 bits in blocks along the K dimension,
+like numpy.matmul. The weights are dequantized on the fly, so only their quantized form is read from memory.
+
+Each column of B is split into ceil(K / block_size) blocks of block_size elements, and each block has its own scale and
+zero point: B[k, n] = (quantized value - zero_point) * scale. The input B stores the blocks column by column, each using
+block_size * bits / 8 bytes, with two 4-bit values per byte and the lower row in the low nibble.)DOC";
+
+  ONNX_CONTRIB_OPERATOR_SCHEMA(MatMulWeightOnlyQuant)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(MatMulWeightOnlyQuant_ver1_doc)
+      .Attr("K", "Number of rows of the weight matrix B.", AttributeProto::INT)
+      .Attr("N", "Number of columns of the weight matrix B.", AttributeProto::INT)
+      .Attr("bits", "Number of bits of each quantized weight, 4 or 8.", AttributeProto::INT, static_cast<int64_t>(4))
+      .Attr("block_size",
+            "Number of rows of B in a quantization block. It must be a power of 2 from 16 to 256.",
+            AttributeProto::INT,
+            static_cast<int64_t>(32))
+      .Input(0, "A", "N-dimensional matrix A, whose last dimension is K", "T1")
+      .Input(1, "B", "Quantized weights, a 3-D tensor of shape [N, ceil(K / block_size), block_size * bits / 8]", "T2")
+      .Input(2, "scales", "Scale of each block, a 1-D tensor of N * ceil(K / block_size) elements", "T1")
+      .Input(
+          3,
+          "zero_points",
+          "Zero point of each block, a 1-D tensor of N * ceil(K / block_size) elements with one zero point per byte. "
+          "It's optional and the default value is 2^(bits - 1).",
+          "T2",
+          OpSchema::Optional)
+      .Input(4,
+             "bias",
+             "1D input tensor, whose dimension is N",
+             "T1",
+             OpSchema::Optional)
+      .Output(0, "Y", "Matrix multiply results from A * B", "T1")
+      .TypeConstraint(
+          "T1",
+          {"tensor(float)"},
+          "Constrain input A, scales, bias and output Y data type as float tensor.")
+      .TypeConstraint(
+          "T2",
+          {"tensor(uint8)"},
+          "Constrain the quantized weights and zero points to uint8 tensor.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+
+        if (!hasInputShape(ctx, 0)) {
+          return;
+        }
+
+        const auto& a_shape = ctx.getInputType(0)->tensor_type().shape();
+        if (a_shape.dim_size() == 0) {
+          fail_shape_inference("Input A must have at least one dimension");
+        }
+
+        auto* y_shape = ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape();
+        for (int i = 0; i < a_shape.dim_size() - 1; ++i) {
+          *y_shape->add_dim() = a_shape.dim(i);
+        }
+        y_shape->add_dim()->set_dim_value(getAttribute(ctx, "N", 0));
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(QLinearAdd)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
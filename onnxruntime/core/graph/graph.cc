@@ -228,6 +228,7 @@ bool NodeArg::HasTensorOrScalarShape() const {
 
 #if !defined(ORT_MINIMAL_BUILD)
 void NodeArg::SetShape(const TensorShapeProto& shape) {
+  type_or_shape_changed_ = true;
   const auto type_case = node_arg_info_.type().value_case();
   switch (type_case) {
     case TypeProto::kTensorType:
@@ -246,6 +247,7 @@ void NodeArg::SetShape(const TensorShapeProto& shape) {
 }
 
 void NodeArg::ClearShape() {
+  type_or_shape_changed_ = true;
   const auto type_case = node_arg_info_.type().value_case();
   switch (type_case) {
     case TypeProto::kTensorType:
@@ -265,6 +267,7 @@ void NodeArg::ClearShape() {
 
 common::Status NodeArg::UpdateTypeAndShape(const ONNX_NAMESPACE::TypeProto& input_type, bool strict,
                                            bool override_types, const logging::Logger& logger) {
+  type_or_shape_changed_ = true;
   if (!utils::HasType(node_arg_info_)) {
     *node_arg_info_.mutable_type() = input_type;
     type_ = DataTypeUtils::ToType(node_arg_info_.type());
@@ -375,9 +378,11 @@ void NodeArg::SetType(DataType p_type) {
 
   type_ = p_type;
   *(node_arg_info_.mutable_type()) = DataTypeUtils::ToTypeProto(p_type);
+  type_or_shape_changed_ = true;
 }
 
 void NodeArg::SetType(const TypeProto& type_proto) {
+  type_or_shape_changed_ = true;
   type_ = DataTypeUtils::ToType(type_proto);
   *(node_arg_info_.mutable_type()) = type_proto;
 }
@@ -490,7 +495,8 @@ void Node::ToProto(NodeProto& proto, bool update_subgraphs) const {
 }
 
 Status Node::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
-                             flatbuffers::Offset<fbs::Node>& fbs_node) const {
+                             flatbuffers::Offset<fbs::Node>& fbs_node,
+                             fbs::TensorDataCompression initializer_compression) const {
   // if type is Primitive it's an ONNX function and currently we have kernel implementations for all those
   if (func_body_ != nullptr && node_type_ != Type::Primitive) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Serialization of fused function body is not currently supported, ",
@@ -532,7 +538,7 @@ Status Node::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
       graph = it->second;
     }
     ORT_RETURN_IF_ERROR(
-        experimental::utils::SaveAttributeOrtFormat(builder, attr_proto, fbs_attr, graph));
+        experimental::utils::SaveAttributeOrtFormat(builder, attr_proto, fbs_attr, graph, initializer_compression));
     attributes_vec.push_back(fbs_attr);
   }
   auto attributes = builder.CreateVector(attributes_vec);
@@ -710,6 +716,7 @@ void Node::Init(const std::string& name,
 
 Node::Definitions& Node::MutableDefinitions() noexcept {
   // someone fetching these is going to change something
+  type_and_shape_inference_needed_ = true;
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
   return definitions_;
@@ -738,6 +745,7 @@ void Node::CreateSubgraph(const std::string& attr_name) {
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 void Node::AddAttribute(const std::string& attr_name, const AttributeProto& value) {
+  type_and_shape_inference_needed_ = true;
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
   attributes_[attr_name] = value;
@@ -745,6 +753,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
 
 #define ADD_BASIC_ATTR_IMPL(type, enumType, field)                           \
   void Node::AddAttribute(const std::string& attr_name, const type& value) { \
+    type_and_shape_inference_needed_ = true;                                 \
     graph_->SetGraphResolveNeeded();                                         \
     graph_->SetGraphProtoSyncNeeded();                                       \
     AttributeProto a;                                                        \
@@ -756,6 +765,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
 
 #define ADD_ATTR_IMPL(type, enumType, field)                                 \
   void Node::AddAttribute(const std::string& attr_name, const type& value) { \
+    type_and_shape_inference_needed_ = true;                                 \
     graph_->SetGraphResolveNeeded();                                         \
     graph_->SetGraphProtoSyncNeeded();                                       \
     AttributeProto a;                                                        \
@@ -768,6 +778,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
 #define ADD_LIST_ATTR_IMPL(type, enumType, field)            \
   void Node::AddAttribute(const std::string& attr_name,      \
                           const std::vector<type>& values) { \
+    type_and_shape_inference_needed_ = true;                 \
     graph_->SetGraphResolveNeeded();                         \
     graph_->SetGraphProtoSyncNeeded();                       \
     AttributeProto a;                                        \
@@ -780,6 +791,7 @@ void Node::AddAttribute(const std::string& attr_name, const AttributeProto& valu
   };
 
 void Node::AddAttribute(const std::string& attr_name, const GraphProto& value) {
+  type_and_shape_inference_needed_ = true;
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
   AttributeProto a;
@@ -808,6 +820,7 @@ ADD_LIST_ATTR_IMPL(SparseTensorProto, AttributeProto_AttributeType::AttributePro
 
 #if !defined(ORT_MINIMAL_BUILD)
 bool Node::ClearAttribute(const std::string& attr_name) {
+  type_and_shape_inference_needed_ = true;
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
   return attributes_.erase(attr_name) > 0;
@@ -2282,17 +2295,34 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
   // and need to call Resolve
   lsc.output_names.insert(outer_scope_node_arg_names_.cbegin(), outer_scope_node_arg_names_.cend());
 
+  // re-running type and shape inferencing on the nodes of a large model after every graph transformation is slow,
+  // so once the top level graph has been resolved we only infer the nodes that may have a different result.
+  // a subgraph is always fully inferred, as the types of its inputs come from the node containing it, which is
+  // always inferred again.
+  const bool infer_changed_nodes_only = parent_graph_ == nullptr && num_resolves_ > 0;
+
+  auto accumulate_output_names = [&lsc](const Node& node) {
+    for (const auto* output_def : node.OutputDefs()) {
+      lsc.output_names.insert(output_def->Name());
+    }
+  };
+
   for (auto node_index : nodes_in_topological_order_) {
     // Node verification.
     auto& node = *GetNode(node_index);
 
-    NodeProto node_proto;
-    node.ToProto(node_proto);
+    if (infer_changed_nodes_only && !NeedsTypeAndShapeInference(node)) {
+      accumulate_output_names(node);
+      continue;
+    }
+
     auto& node_name = node.Name();
     auto& domain = node.Domain();
 
     if (!node.Op()) {
       {
+        NodeProto node_proto;
+        node.ToProto(node_proto);
         auto status = Status::OK();
         ORT_TRY {
           checker::check_node(node_proto, ctx, lsc);
@@ -2352,17 +2382,57 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
       }
     }
 
+    // the outputs always have a changed shape after inferencing as it is merged with the existing one, so compare
+    // them to the existing values to find whether the consumers need inferencing again.
+    std::vector<std::string> output_types;
+    std::vector<bool> output_types_changed;
+    if (infer_changed_nodes_only) {
+      for (const auto* output_def : node.OutputDefs()) {
+        const auto* type = output_def->TypeAsProto();
+        output_types.push_back(type != nullptr ? type->SerializeAsString() : std::string());
+        output_types_changed.push_back(output_def->type_or_shape_changed_);
+      }
+    }
+
     NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
 
+    if (infer_changed_nodes_only) {
+      const auto& output_defs = node.GetDefinitions().output_defs;
+      for (size_t i = 0, end = std::min(output_defs.size(), output_types.size()); i < end; ++i) {
+        const auto* type = output_defs[i]->TypeAsProto();
+        output_defs[i]->type_or_shape_changed_ =
+            output_types_changed[i] || output_types[i] != (type != nullptr ? type->SerializeAsString() : std::string());
+      }
+    }
+
+    node.type_and_shape_inference_needed_ = false;
+
     // Accumulate output names of the iterated Node
-    for (auto& output_name : node_proto.output()) {
-      lsc.output_names.insert(output_name);
+    accumulate_output_names(node);
+  }
+
+  // the NodeArgs of a subgraph may change when the node containing it is inferred so only those of the top level
+  // graph are cleared
+  if (parent_graph_ == nullptr) {
+    for (auto& node_arg : node_args_) {
+      node_arg.second->type_or_shape_changed_ = false;
     }
   }
 
   return Status::OK();
 }
 
+bool Graph::NeedsTypeAndShapeInference(const Node& node) {
+  if (node.type_and_shape_inference_needed_ || node.op_ == nullptr || !node.subgraphs_.empty()) {
+    return true;
+  }
+
+  auto changed = [](const NodeArg* node_arg) { return node_arg->type_or_shape_changed_; };
+  const auto& definitions = node.GetDefinitions();
+  return std::any_of(definitions.input_defs.cbegin(), definitions.input_defs.cend(), changed) ||
+         std::any_of(definitions.implicit_input_defs.cbegin(), definitions.implicit_input_defs.cend(), changed);
+}
+
 void Graph::InitFunctionBodyForNode(Node& node) {
   if (node.op_ && (node.op_->HasFunction() || node.op_->HasContextDependentFunction())) {
     onnx::FunctionProto onnx_function_proto;
@@ -2546,6 +2616,7 @@ void Graph::AddInitializedTensor(const TensorProto& tensor) {
   *(tensor_added) = tensor;
   name_to_initial_tensor_[tensor.name()] = tensor_added;
   SetGraphResolveNeeded();
+  InitializerChanged(tensor.name());
   if (!is_loaded_from_model_file_ && GetNodeArg(tensor.name()) == nullptr) {
     // make sure there is a NodeArg for the initializer as SetGraphInputsOutputs may add it to the graph inputs.
     // the shape will be set to the correct value in TypeCheckInputsAndInitializers as we don't yet know whether there
@@ -2594,6 +2665,13 @@ static void RemoveRepeatedFieldEntry(T& repeated_field, const TIter& entry_to_re
   }
 }
 
+void Graph::InitializerChanged(const std::string& name) {
+  auto* node_arg = GetNodeArg(name);
+  if (node_arg != nullptr) {
+    node_arg->type_or_shape_changed_ = true;
+  }
+}
+
 bool Graph::IsInitializedTensor(const std::string& name) const {
   return name_to_initial_tensor_.count(name) > 0;
 }
@@ -2606,6 +2684,7 @@ void Graph::RemoveInitializedTensor(const std::string& tensor_name) {
     name_to_initial_tensor_.erase(iter);
     sparse_tensor_names_.erase(tensor_name);
     SetGraphResolveNeeded();
+    InitializerChanged(tensor_name);
   } else {
     ORT_ENFORCE(sparse_tensor_names_.count(tensor_name) == 0, "sparse_tensor_names_ not in sync with name_to_initial_tensor_");
   }
@@ -2657,6 +2736,10 @@ Status Graph::ReplaceInitializedTensor(const ONNX_NAMESPACE::TensorProto& new_in
 
   **existing_entry = new_initializer;
 
+  // the inferred shapes of the consumers may depend on the value, e.g. for the shape input of a Reshape
+  InitializerChanged(initializer_name);
+  SetGraphResolveNeeded();
+
   return Status::OK();
 }
 #endif  // !defined(ORT_MINIMAL_BUILD)
@@ -2805,6 +2888,12 @@ SaveInputsOutputsToOrtFormat(flatbuffers::FlatBufferBuilder& builder, const std:
 
 common::Status Graph::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
                                       flatbuffers::Offset<fbs::Graph>& fbs_graph) const {
+  return SaveToOrtFormat(builder, fbs_graph, fbs::TensorDataCompression::NONE);
+}
+
+common::Status Graph::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
+                                      flatbuffers::Offset<fbs::Graph>& fbs_graph,
+                                      fbs::TensorDataCompression initializer_compression) const {
   auto inputs = SaveInputsOutputsToOrtFormat(builder, graph_inputs_including_initializers_);
   auto outputs = SaveInputsOutputsToOrtFormat(builder, graph_outputs_);
 
@@ -2821,7 +2910,8 @@ common::Status Graph::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
     if (sparse_tensor_names_.find(pair.first) == sparse_end) {
       flatbuffers::Offset<fbs::Tensor> fbs_tensor;
       ORT_RETURN_IF_ERROR(
-          experimental::utils::SaveInitializerOrtFormat(builder, *pair.second, model_path, fbs_tensor));
+          experimental::utils::SaveInitializerOrtFormat(builder, *pair.second, model_path, fbs_tensor,
+                                                        initializer_compression));
       initializers_data.push_back(fbs_tensor);
     } else {
       SparseTensorProto sparse_initializer;
@@ -2851,7 +2941,7 @@ common::Status Graph::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
   for (const auto& node : nodes_) {
     if (node != nullptr) {
       flatbuffers::Offset<fbs::Node> fbs_node;
-      ORT_RETURN_IF_ERROR(node->SaveToOrtFormat(builder, fbs_node));
+      ORT_RETURN_IF_ERROR(node->SaveToOrtFormat(builder, fbs_node, initializer_compression));
       nodes_vec.push_back(fbs_node);
       node_edges_vec.push_back(node->SaveEdgesToOrtFormat(builder));
     }
@@ -2935,6 +3025,7 @@ Node& Graph::AddNode(const std::string& name,
 
   const gsl::not_null<Node*> node = AllocateNode();
   node->Init(name, op_type, description, inputs, outputs, attributes, domain);
+  op_type_to_node_indexes_[op_type].insert(node->Index());
   if (0 != op_type.compare(kNoOp)) {
     GraphProtoSyncNeeded(true);
   }
@@ -3309,6 +3400,22 @@ IOnnxRuntimeOpSchemaCollectionPtr Graph::GetSchemaRegistry() const {
 }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+size_t Graph::NumberOfNodesOfOpType(const std::string& op_type) const noexcept {
+  auto entry = op_type_to_node_indexes_.find(op_type);
+  return entry != op_type_to_node_indexes_.end() ? entry->second.size() : 0;
+}
+
+std::vector<NodeIndex> Graph::GetNodeIndexesOfOpType(const std::string& op_type) const {
+  std::vector<NodeIndex> node_indexes;
+  auto entry = op_type_to_node_indexes_.find(op_type);
+  if (entry != op_type_to_node_indexes_.end()) {
+    node_indexes.assign(entry->second.cbegin(), entry->second.cend());
+    std::sort(node_indexes.begin(), node_indexes.end());
+  }
+
+  return node_indexes;
+}
+
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 // calling private ctor
 GSL_SUPPRESS(r .11)
@@ -3332,6 +3439,14 @@ bool Graph::ReleaseNode(NodeIndex index) {
 
   // index is valid, but the entry may already be empty
   if (nodes_[index] != nullptr) {
+    auto op_type_entry = op_type_to_node_indexes_.find(nodes_[index]->OpType());
+    if (op_type_entry != op_type_to_node_indexes_.end()) {
+      op_type_entry->second.erase(index);
+      if (op_type_entry->second.empty()) {
+        op_type_to_node_indexes_.erase(op_type_entry);
+      }
+    }
+
     nodes_[index] = nullptr;
     --num_of_nodes_;
     GraphProtoSyncNeeded(true);
@@ -3768,6 +3883,7 @@ common::Status Graph::LoadFromOrtFormat(const onnxruntime::experimental::fbs::Gr
       std::unique_ptr<Node> node;
       ORT_RETURN_IF_ERROR(Node::LoadFromOrtFormat(*fbs_node, *this, logger_, node));
       ORT_RETURN_IF(node->Index() >= fbs_graph.max_node_index(), "Node index is out of range");
+      op_type_to_node_indexes_[node->OpType()].insert(node->Index());
       nodes_[node->Index()] = std::move(node);
       ++num_of_nodes_;
     }
@@ -4,6 +4,7 @@
 #include <core/graph/graph.h>
 #include "core/flatbuffers/flatbuffers_utils.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
+#include "core/flatbuffers/tensor_compression.h"
 #include "core/framework/tensorprotoutils.h"
 #include "graph_flatbuffers_utils.h"
 #include "flatbuffers/flatbuffers.h"
@@ -26,16 +27,22 @@ SaveDims(flatbuffers::FlatBufferBuilder& builder, const DimsFieldType& dims) {
   return builder.CreateVector(dims_data);
 }
 
+// Smaller initializers are not worth the cost of decompressing them
+constexpr size_t kMinCompressedInitializerSize = 1024;
+
 Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
                                 const TensorProto& initializer,
                                 const Path& model_path,
-                                flatbuffers::Offset<fbs::Tensor>& fbs_tensor) {
+                                flatbuffers::Offset<fbs::Tensor>& fbs_tensor,
+                                fbs::TensorDataCompression compression) {
   auto name = SaveStringToOrtFormat(builder, initializer.has_name(), initializer.name());
   auto doc_string = SaveStringToOrtFormat(builder, initializer.has_doc_string(), initializer.doc_string());
   auto dims = SaveDims(builder, initializer.dims());
 
   flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> string_data;
   flatbuffers::Offset<flatbuffers::Vector<uint8_t>> raw_data;
+  size_t uncompressed_size = 0;
+  bool is_compressed = false;
 
   auto src_type = initializer.data_type();
   const bool has_string_data = src_type == ONNX_NAMESPACE::TensorProto_DataType_STRING;
@@ -48,7 +55,24 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
     size_t tensor_byte_size = 0;
     ORT_RETURN_IF_ERROR(
         onnxruntime::utils::UnpackInitializerData(initializer, model_path, unpacked_tensor, tensor_byte_size));
-    raw_data = builder.CreateVector(unpacked_tensor.get(), tensor_byte_size);
+
+    std::vector<uint8_t> compressed;
+    if (compression != fbs::TensorDataCompression::NONE && tensor_byte_size >= kMinCompressedInitializerSize) {
+      int64_t num_elements = 1;
+      for (auto dim : initializer.dims()) {
+        num_elements *= dim;
+      }
+      const size_t element_size = num_elements > 0 ? tensor_byte_size / static_cast<size_t>(num_elements) : 1;
+      is_compressed = CompressTensorData(unpacked_tensor.get(), tensor_byte_size, compression, element_size,
+                                         compressed);
+    }
+
+    if (is_compressed) {
+      raw_data = builder.CreateVector(compressed);
+      uncompressed_size = tensor_byte_size;
+    } else {
+      raw_data = builder.CreateVector(unpacked_tensor.get(), tensor_byte_size);
+    }
   }
 
   fbs::TensorBuilder tb(builder);
@@ -60,6 +84,10 @@ Status SaveInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
     tb.add_string_data(string_data);
   else
     tb.add_raw_data(raw_data);
+  if (is_compressed) {
+    tb.add_raw_data_compression(compression);
+    tb.add_raw_data_uncompressed_size(uncompressed_size);
+  }
   fbs_tensor = tb.Finish();
   return Status::OK();
 }
@@ -71,12 +99,14 @@ Status SaveSparseInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
   // values
   const auto& values = initializer.values();
   flatbuffers::Offset<fbs::Tensor> values_off;
-  ORT_RETURN_IF_ERROR(SaveInitializerOrtFormat(builder, values, model_path, values_off));
+  ORT_RETURN_IF_ERROR(SaveInitializerOrtFormat(builder, values, model_path, values_off,
+                                               fbs::TensorDataCompression::NONE));
 
   // Indicies
   const auto& indicies = initializer.indices();
   flatbuffers::Offset<fbs::Tensor> indicies_off;
-  ORT_RETURN_IF_ERROR(SaveInitializerOrtFormat(builder, indicies, model_path, indicies_off));
+  ORT_RETURN_IF_ERROR(SaveInitializerOrtFormat(builder, indicies, model_path, indicies_off,
+                                               fbs::TensorDataCompression::NONE));
 
   // Shape
   auto shape = SaveDims(builder, initializer.dims());
@@ -106,7 +136,8 @@ Status SaveSparseInitializerOrtFormat(flatbuffers::FlatBufferBuilder& builder,
 Status SaveAttributeOrtFormat(flatbuffers::FlatBufferBuilder& builder,
                               const AttributeProto& attr_proto,
                               flatbuffers::Offset<fbs::Attribute>& fbs_attr,
-                              const onnxruntime::Graph* graph) {
+                              const onnxruntime::Graph* graph,
+                              fbs::TensorDataCompression initializer_compression) {
   auto name = SaveStringToOrtFormat(builder, attr_proto.has_name(), attr_proto.name());
   auto doc_string = SaveStringToOrtFormat(builder, attr_proto.has_doc_string(), attr_proto.doc_string());
   auto type = static_cast<fbs::AttributeType>(attr_proto.type());
@@ -124,13 +155,14 @@ Status SaveAttributeOrtFormat(flatbuffers::FlatBufferBuilder& builder,
     case fbs::AttributeType::TENSOR: {
       flatbuffers::Offset<fbs::Tensor> fbs_tensor;
       ORT_RETURN_IF_ERROR(
-          experimental::utils::SaveInitializerOrtFormat(builder, attr_proto.t(), graph->ModelPath(), fbs_tensor));
+          experimental::utils::SaveInitializerOrtFormat(builder, attr_proto.t(), graph->ModelPath(), fbs_tensor,
+                                                        fbs::TensorDataCompression::NONE));
       GET_FBS_ATTR(builder, type, t, fbs_tensor);
     } break;
     case fbs::AttributeType::GRAPH: {
       ORT_RETURN_IF(nullptr == graph, "Graph attribute value was null. Invalid ORT format model.");
       flatbuffers::Offset<fbs::Graph> fbs_graph;
-      ORT_RETURN_IF_ERROR(graph->SaveToOrtFormat(builder, fbs_graph));
+      ORT_RETURN_IF_ERROR(graph->SaveToOrtFormat(builder, fbs_graph, initializer_compression));
       GET_FBS_ATTR(builder, type, g, fbs_graph);
     } break;
     case fbs::AttributeType::FLOATS: {
@@ -154,7 +186,8 @@ Status SaveAttributeOrtFormat(flatbuffers::FlatBufferBuilder& builder,
       for (const auto& tensor : attr_proto.tensors()) {
         flatbuffers::Offset<fbs::Tensor> fbs_tensor;
         ORT_RETURN_IF_ERROR(
-            experimental::utils::SaveInitializerOrtFormat(builder, tensor, graph->ModelPath(), fbs_tensor));
+            experimental::utils::SaveInitializerOrtFormat(builder, tensor, graph->ModelPath(), fbs_tensor,
+                                                          fbs::TensorDataCompression::NONE));
         fbs_tensors_vec.push_back(fbs_tensor);
       }
       auto tensors = builder.CreateVector(fbs_tensors_vec);
@@ -201,8 +234,28 @@ Status LoadInitializerOrtFormat(const fbs::Tensor& fbs_tensor,
     const auto* fbs_raw_data = fbs_tensor.raw_data();
     ORT_RETURN_IF(nullptr == fbs_raw_data, "Missing raw data for initializer. Invalid ORT format model.");
 
-    // fbs_raw_data is uint8_t vector, so the size is byte size
-    initializer.set_raw_data(fbs_raw_data->Data(), fbs_raw_data->size());
+    const auto compression = fbs_tensor.raw_data_compression();
+    if (compression == fbs::TensorDataCompression::NONE) {
+      // fbs_raw_data is uint8_t vector, so the size is byte size
+      initializer.set_raw_data(fbs_raw_data->Data(), fbs_raw_data->size());
+    } else {
+      const uint64_t uncompressed_size = fbs_tensor.raw_data_uncompressed_size();
+      int64_t num_elements = 1;
+      for (auto dim : *fbs_dims) {
+        ORT_RETURN_IF(dim < 0, "Invalid dimension for initializer. Invalid ORT format model.");
+        num_elements *= dim;
+      }
+      ORT_RETURN_IF(num_elements == 0 || uncompressed_size % static_cast<uint64_t>(num_elements) != 0,
+                    "The uncompressed size ", uncompressed_size, " of initializer '", initializer.name(),
+                    "' doesn't match its dimensions. Invalid ORT format model.");
+      const size_t element_size = static_cast<size_t>(uncompressed_size / static_cast<uint64_t>(num_elements));
+
+      // decompress directly into the raw data of the initializer
+      auto* raw_data = initializer.mutable_raw_data();
+      raw_data->resize(static_cast<size_t>(uncompressed_size));
+      ORT_RETURN_IF_ERROR(DecompressTensorData(fbs_raw_data->Data(), fbs_raw_data->size(), compression, element_size,
+                                               reinterpret_cast<uint8_t*>(&(*raw_data)[0]), raw_data->size()));
+    }
   }
 
   return Status::OK();
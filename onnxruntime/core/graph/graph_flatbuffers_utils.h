@@ -30,14 +30,17 @@ namespace experimental {
 namespace fbs {
 struct Attribute;
 struct Tensor;
+enum class TensorDataCompression : int32_t;
 }  // namespace fbs
 
 namespace utils {
 
 // TODO, add ORT_MUST_USE_RESULT when it is moved to a different header
+// The raw data of the initializer is compressed with the given compression if that makes it smaller
 onnxruntime::common::Status SaveInitializerOrtFormat(
     flatbuffers::FlatBufferBuilder& builder, const ONNX_NAMESPACE::TensorProto& initializer,
-    const Path& model_path, flatbuffers::Offset<fbs::Tensor>& fbs_tensor);
+    const Path& model_path, flatbuffers::Offset<fbs::Tensor>& fbs_tensor,
+    fbs::TensorDataCompression compression);
 
 onnxruntime::common::Status SaveSparseInitializerOrtFormat(
     flatbuffers::FlatBufferBuilder& builder, const ONNX_NAMESPACE::SparseTensorProto& initializer,
@@ -47,9 +50,11 @@ onnxruntime::common::Status SaveSparseInitializerOrtFormat(
 // Note, we current do not support graphs, and sparse_tensor(s)
 //       If the attribute type is a graph, we need to use the supplied graph,
 //       instead of the GraphProto in attr_proto
+//       initializer_compression is used for the initializers of a graph attribute
 onnxruntime::common::Status SaveAttributeOrtFormat(
     flatbuffers::FlatBufferBuilder& builder, const ONNX_NAMESPACE::AttributeProto& attr_proto,
-    flatbuffers::Offset<fbs::Attribute>& fbs_attr, const onnxruntime::Graph* graph);
+    flatbuffers::Offset<fbs::Attribute>& fbs_attr, const onnxruntime::Graph* graph,
+    fbs::TensorDataCompression initializer_compression);
 
 #if defined(ENABLE_ORT_FORMAT_LOAD)
 
@@ -571,6 +571,12 @@ Status Model::Save(Model& model, int p_fd) {
 
 common::Status Model::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
                                       flatbuffers::Offset<fbs::Model>& fbs_model) const {
+  return SaveToOrtFormat(builder, fbs_model, fbs::TensorDataCompression::NONE);
+}
+
+common::Status Model::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
+                                      flatbuffers::Offset<fbs::Model>& fbs_model,
+                                      fbs::TensorDataCompression initializer_compression) const {
   auto producer_name = experimental::utils::SaveStringToOrtFormat(
       builder, model_proto_.has_producer_name(), model_proto_.producer_name());
   auto producer_version = experimental::utils::SaveStringToOrtFormat(
@@ -593,7 +599,7 @@ common::Status Model::SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
   auto op_set_ids = builder.CreateVector(op_set_ids_vec);
 
   flatbuffers::Offset<fbs::Graph> fbs_graph;
-  ORT_RETURN_IF_ERROR(graph_->SaveToOrtFormat(builder, fbs_graph));
+  ORT_RETURN_IF_ERROR(graph_->SaveToOrtFormat(builder, fbs_graph, initializer_compression));
 
   fbs::ModelBuilder mb(builder);
   mb.add_ir_version(model_proto_.ir_version());
@@ -23,6 +23,7 @@ namespace onnxruntime {
 namespace experimental {
 namespace fbs {
 struct Model;
+enum class TensorDataCompression : int32_t;
 }  // namespace fbs
 }  // namespace experimental
 
@@ -235,6 +236,12 @@ class Model {
   common::Status SaveToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
                                  flatbuffers::Offset<onnxruntime::experimental::fbs::Model>& model) const;
 
+  // Save with the raw data of the initializers compressed with initializer_compression. See Graph::SaveToOrtFormat.
+  common::Status SaveToOrtFormat(
+      flatbuffers::FlatBufferBuilder& builder,
+      flatbuffers::Offset<onnxruntime::experimental::fbs::Model>& model,
+      onnxruntime::experimental::fbs::TensorDataCompression initializer_compression) const;
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 #if defined(ENABLE_ORT_FORMAT_LOAD)
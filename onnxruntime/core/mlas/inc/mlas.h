@@ -180,6 +180,37 @@ MlasGemm(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Describes one matrix/matrix multiply of a batched SGEMM operation. If
+// BIsPacked is true, then B is a buffer packed by MlasGemmPackB and ldb is
+// ignored.
+//
+
+struct MLAS_SGEMM_DATA_PARAMS {
+    const float* A = nullptr;
+    size_t lda = 0;
+    const void* B = nullptr;
+    size_t ldb = 0;
+    float* C = nullptr;
+    size_t ldc = 0;
+    float alpha = 1.0f;
+    float beta = 0.0f;
+    bool BIsPacked = false;
+};
+
+void
+MLASCALL
+MlasGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasGemm(
@@ -199,6 +230,88 @@ MlasGemm(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Half precision and bfloat16 matrix/matrix multiply routines. The product is
+// accumulated in single precision and rounded to the output type. These have
+// the same layout as onnxruntime::MLFloat16 and onnxruntime::BFloat16.
+//
+
+struct MLAS_FP16 {
+    uint16_t val;
+};
+
+struct MLAS_BF16 {
+    uint16_t val;
+};
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const MLAS_FP16* A,
+    size_t lda,
+    const MLAS_FP16* B,
+    size_t ldb,
+    MLAS_FP16* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const MLAS_FP16* A,
+    size_t lda,
+    const void* PackedB,
+    MLAS_FP16* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const MLAS_BF16* A,
+    size_t lda,
+    const MLAS_BF16* B,
+    size_t ldb,
+    MLAS_BF16* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const MLAS_BF16* A,
+    size_t lda,
+    const void* PackedB,
+    MLAS_BF16* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 enum class MLAS_QUANTIZATION_GRANULARITY {
     PerMatrix,
     PerColumn,
@@ -273,6 +386,50 @@ private:
     MLAS_QUANTIZATION_GRANULARITY QuantGran_;
 };
 
+//
+// Requantizes each block of the int32 output matrix to uint8 as soon as the
+// GEMM kernel has produced it, while the block is still resident in the cache.
+// The bias is added per column and the scale is per matrix or per column, as
+// in MlasRequantizeOutput.
+//
+
+class MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR : public MLAS_QGEMM_OUTPUT_PROCESSOR {
+public:
+    MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR(
+        uint8_t* Output,
+        size_t LeadingDimensionOutput,
+        const int32_t* Bias,
+        const float* Scale,
+        bool PerColumnScale,
+        uint8_t ZeroPoint) :
+            Output_(Output),
+            LeadingDimensionOutput_(LeadingDimensionOutput),
+            Bias_(Bias),
+            Scale_(Scale),
+            PerColumnScale_(PerColumnScale),
+            ZeroPoint_(ZeroPoint)
+    {
+    }
+
+    void
+    Process(
+        const int32_t* C,
+        size_t StartM,
+        size_t StartN,
+        size_t CountM,
+        size_t CountN,
+        size_t ldc
+        ) const override;
+
+private:
+    uint8_t* Output_;
+    size_t LeadingDimensionOutput_;
+    const int32_t* Bias_;
+    const float* Scale_;
+    bool PerColumnScale_;
+    uint8_t ZeroPoint_;
+};
+
 void
 MLASCALL
 MlasGemm(
@@ -310,6 +467,40 @@ MlasGemm(
     const MLAS_QGEMM_OUTPUT_PROCESSOR* OutputProcessor = nullptr
     );
 
+//
+// Parameters of a quantized integer matrix/matrix multiply, for the cases not
+// covered by the routines above: matrix B with a zero point per column, e.g.
+// the per output channel quantization of a weight, and signed data in matrix
+// A. Signed data in matrix A is shifted to unsigned data as it is packed, so
+// the U8S8 and U8U8 kernels also implement S8S8 and S8U8.
+//
+
+struct MLAS_GEMM_U8X8_PARAMETERS {
+    size_t M = 0;
+    size_t N = 0;
+    size_t K = 0;
+    const uint8_t* A = nullptr;
+    size_t lda = 0;
+    uint8_t ZeroPointA = 0;
+    bool AIsSigned = false;
+    const void* B = nullptr;                        // the buffer from MlasGemmPackB if BIsPacked
+    size_t ldb = 0;                                 // not used if BIsPacked
+    uint8_t ZeroPointB = 0;
+    const uint8_t* PerColumnZeroPointB = nullptr;   // N zero points, overrides ZeroPointB
+    bool BIsPacked = false;
+    bool BIsSigned = false;
+    int32_t* C = nullptr;
+    size_t ldc = 0;
+    const MLAS_QGEMM_OUTPUT_PROCESSOR* OutputProcessor = nullptr;
+};
+
+void
+MLASCALL
+MlasGemm(
+    const MLAS_GEMM_U8X8_PARAMETERS& Parameters,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Buffer packing routines.
 //
@@ -332,6 +523,205 @@ MlasGemmPackB(
     void* PackedB
     );
 
+//
+// The half precision and bfloat16 packing routines convert matrix B to single
+// precision, so the packed buffer is sized by MlasGemmPackBSize(N, K) above.
+//
+
+void
+MLASCALL
+MlasGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const MLAS_FP16* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+void
+MLASCALL
+MlasGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const MLAS_BF16* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+//
+// Single precision matrix/matrix multiply routines with matrix B stored in
+// half precision or bfloat16. Matrix B is packed in the layout of
+// MlasGemmPackB with the elements rounded to the half precision type, which
+// halves the size of the packed buffer. Blocks of the packed matrix B are
+// expanded to single precision as the product is computed, so matrix A and
+// matrix C remain single precision.
+//
+
+size_t
+MLASCALL
+MlasGemmPackBHalfSize(
+    size_t N,
+    size_t K
+    );
+
+void
+MLASCALL
+MlasGemmPackBHalf(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    MLAS_FP16* PackedB
+    );
+
+void
+MLASCALL
+MlasGemmPackBHalf(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    MLAS_BF16* PackedB
+    );
+
+void
+MLASCALL
+MlasGemmHalfPackedB(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const MLAS_FP16* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasGemmHalfPackedB(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const MLAS_BF16* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Sparse SGEMM routines. Matrix B is packed into blocks of one row by 16
+// columns and the blocks that only contain zeros are dropped. The packed
+// buffer records the dimensions of matrix B.
+//
+
+size_t
+MLASCALL
+MlasGemmPackSparseBSize(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb
+    );
+
+void
+MLASCALL
+MlasGemmPackSparseB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+void
+MLASCALL
+MlasGemmSparse(
+    size_t M,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Block quantized weight SGEMM routines. Matrix B is quantized to 4 or 8 bits
+// in blocks of BlkLen rows along the K dimension, each block having its own
+// scale and zero point. The quantized data is stored column by column with
+// each block occupying BlkLen * BlkBits / 8 bytes, two 4-bit values per byte
+// with the lower row in the low nibble. The scales and the zero points are
+// stored as arrays of N by ceil(K / BlkLen) elements. If the zero points are
+// not supplied, then the quantization is symmetric with an implicit zero
+// point of 2^(BlkBits - 1).
+//
+
+bool
+MLASCALL
+MlasIsBlockQuantGemmAvailable(
+    size_t BlkBits,
+    size_t BlkLen
+    );
+
+size_t
+MLASCALL
+MlasBlockQuantBSize(
+    size_t N,
+    size_t K,
+    size_t BlkBits,
+    size_t BlkLen
+    );
+
+void
+MLASCALL
+MlasBlockQuantizeB(
+    size_t N,
+    size_t K,
+    size_t BlkBits,
+    size_t BlkLen,
+    const float* B,
+    size_t ldb,
+    uint8_t* QuantB,
+    float* QuantBScale,
+    uint8_t* QuantBZeroPoint
+    );
+
+void
+MLASCALL
+MlasBlockQuantGemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BlkBits,
+    size_t BlkLen,
+    const float* A,
+    size_t lda,
+    const uint8_t* QuantB,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    const float* Bias,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 size_t
 MLASCALL
 MlasGemmPackBSize(
@@ -359,6 +749,7 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmWinograd,
 };
 
 struct MLAS_CONV_PARAMETERS {
@@ -387,6 +778,12 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t TileCountH;
+            size_t TileCountW;
+            size_t TileRowsPerSegment;
+            size_t WorkingBufferSizePerThread;
+        } Winograd;
     } u;
 };
 
@@ -407,7 +804,9 @@ MlasConvPrepare(
     size_t FilterCount,
     const MLAS_ACTIVATION* Activation,
     size_t* WorkingBufferSize,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    bool FilterIsWinogradTransformed = false,
+    const MLAS_CONV_ALGORITHM* PreferredAlgorithm = nullptr
     );
 
 void
@@ -422,6 +821,34 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Winograd F(2x2, 3x3) convolution support. A filter transformed by
+// MlasConvWinogradTransformFilter is passed to MlasConv after preparing the
+// convolution with FilterIsWinogradTransformed set.
+//
+
+size_t
+MLASCALL
+MlasConvWinogradFilterSize(
+    size_t Dimensions,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* StrideShape,
+    size_t FilterCount
+    );
+
+void
+MLASCALL
+MlasConvWinogradTransformFilter(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    float* TransformedFilter
+    );
+
 template<typename FilterType>
 void
 MLASCALL
@@ -436,6 +863,24 @@ MlasConvDepthwise(
     size_t KernelSize
     );
 
+//
+// Depthwise convolution with a filter zero point per channel.
+//
+
+template<typename FilterType>
+void
+MLASCALL
+MlasConvDepthwise(
+    const uint8_t* Input,
+    uint8_t InputZeroPoint,
+    const FilterType* Filter,
+    const FilterType* FilterZeroPoints,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
 //
 // Pooling routines.
 //
@@ -462,6 +907,38 @@ MlasPool(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Reduction routines.
+//
+
+enum MLAS_REDUCTION_KIND {
+    MlasSumReduction,
+    MlasMeanReduction,
+    MlasMaximumReduction,
+    MlasMinimumReduction,
+};
+
+void
+MLASCALL
+MlasReduceInnerAxis(
+    MLAS_REDUCTION_KIND ReductionKind,
+    const float* Input,
+    float* Output,
+    size_t CountOuter,
+    size_t CountReduce
+    );
+
+void
+MLASCALL
+MlasReduceOuterAxis(
+    MLAS_REDUCTION_KIND ReductionKind,
+    const float* Input,
+    float* Output,
+    size_t CountReduce,
+    size_t CountInner,
+    size_t ldInput
+    );
+
 //
 // Miscellaneous compute routines.
 //
@@ -474,6 +951,39 @@ MlasComputeErf(
     size_t N
     );
 
+void
+MLASCALL
+MlasComputeBiasGelu(
+    const float* Input,
+    const float* Bias,
+    float* Output,
+    size_t N
+    );
+
+void
+MLASCALL
+MlasComputeMeanAndMeanSquare(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float* Mean,
+    float* MeanSquare
+    );
+
+void
+MLASCALL
+MlasComputeNormalizeScaleShift(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Mean,
+    float InverseStdDev,
+    const float* Scale,
+    const float* Shift
+    );
+
 void
 MLASCALL
 MlasComputeExp(
@@ -501,6 +1011,18 @@ MlasComputeSoftmax(
     MLAS_THREADPOOL* ThreadPool
     );
 
+void
+MLASCALL
+MlasComputeSoftmaxStrided(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    size_t M,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasComputeTanh(
@@ -510,7 +1032,8 @@ MlasComputeTanh(
     );
 
 //
-// Half-precision floating-point routines.
+// Half-precision floating-point routines. Conversions to half precision round
+// to nearest even.
 //
 
 extern "C"
@@ -522,6 +1045,15 @@ MlasConvertHalfToFloatBuffer(
     size_t Count
     );
 
+extern "C"
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
 //
 // Transpose routines.
 //
@@ -532,7 +1064,18 @@ MlasTranspose(
     const uint8_t* Input,
     uint8_t* Output,
     size_t M,
-    size_t N
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint16_t* Input,
+    uint16_t* Output,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
     );
 
 void
@@ -541,7 +1084,18 @@ MlasTranspose(
     const uint32_t* Input,
     uint32_t* Output,
     size_t M,
-    size_t N
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    const uint64_t* Input,
+    uint64_t* Output,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
     );
 
 //
@@ -0,0 +1,299 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    QgemmU8X8KernelUdot.cpp
+
+Abstract:
+
+    This module implements the kernels for the quantized integer matrix/matrix
+    multiply operation (QGEMM) using the ARMv8.2 dot product instructions.
+
+    This module must be compiled with the dot product extension enabled. The
+    kernel is only invoked after the platform has checked that the processor
+    supports the dot product instructions.
+
+--*/
+
+#include "../mlasi.h"
+
+//
+// Define the macro to accumulate the dot products of one row of the packed A
+// vector against each of the 16 columns of the packed B vectors.
+//
+
+#define MlasUdotAccumulateRow(Row) \
+    Accumulators[Row][0] = vdotq_laneq_u32(Accumulators[Row][0], BElements0, AElements, Row); \
+    Accumulators[Row][1] = vdotq_laneq_u32(Accumulators[Row][1], BElements1, AElements, Row); \
+    Accumulators[Row][2] = vdotq_laneq_u32(Accumulators[Row][2], BElements2, AElements, Row); \
+    Accumulators[Row][3] = vdotq_laneq_u32(Accumulators[Row][3], BElements3, AElements, Row);
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+uint8x16_t
+MlasUdotLoadPackedA(
+    const uint8_t* A
+    );
+
+template<>
+MLAS_FORCEINLINE
+uint8x16_t
+MlasUdotLoadPackedA<4>(
+    const uint8_t* A
+    )
+{
+    return vld1q_u8(A);
+}
+
+template<>
+MLAS_FORCEINLINE
+uint8x16_t
+MlasUdotLoadPackedA<2>(
+    const uint8_t* A
+    )
+{
+    return vcombine_u8(vld1_u8(A), vmov_n_u8(0));
+}
+
+template<>
+MLAS_FORCEINLINE
+uint8x16_t
+MlasUdotLoadPackedA<1>(
+    const uint8_t* A
+    )
+{
+    return vreinterpretq_u8_u32(vld1q_dup_u32(reinterpret_cast<const uint32_t*>(A)));
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasGemmU8X8KernelUdotBlock(
+    const uint8_t* A,
+    const uint8_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    int32_t DepthValue,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    block of RowCount rows by every column of the packed B buffer.
+
+Arguments:
+
+    A - Supplies the address of matrix A. The matrix data has been packed
+        using MlasGemmU8X8CopyPackANeon.
+
+    B - Supplies the address of matrix B. The matrix data has been packed
+        using MlasGemmU8X8CopyPackBUdot.
+
+    C - Supplies the address of matrix C.
+
+    PackedCountK - Supplies the number of packed columns from matrix A and
+        the number of packed rows from matrix B to iterate over.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    RowSumBuffer - Supplies the sum of each row from matrix A multiplied by
+        the zero point offset of matrix B. These values are accumulated into
+        every column of matrix C.
+
+    ColumnSumBuffer - Supplies the sum of each column from matrix B multiplied
+        by the zero point offset of matrix A. These values are accumulated
+        into every row of matrix C.
+
+    DepthValue - Supplies the value CountK multiplied by the zero point offset
+        of matrix A multplied by the zero point offset of matrix B. This value
+        is accumulated into every element of matrix C.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t PackedABytes = RowCount * 4;
+
+    while (CountN > 0) {
+
+        uint32x4_t Accumulators[RowCount][4];
+
+        for (size_t r = 0; r < RowCount; r++) {
+            for (size_t j = 0; j < 4; j++) {
+                Accumulators[r][j] = vmovq_n_u32(0);
+            }
+        }
+
+        //
+        // Multiply the packed rows of matrix A by the next 16 columns of the
+        // packed matrix B. Each packed B vector supplies four columns of four
+        // elements along the K dimension.
+        //
+
+        const uint8_t* a = A;
+
+        for (size_t k = 0; k < PackedCountK; k++) {
+
+            uint8x16_t AElements = MlasUdotLoadPackedA<RowCount>(a);
+            uint8x16_t BElements0 = vld1q_u8(B);
+            uint8x16_t BElements1 = vld1q_u8(B + 16);
+            uint8x16_t BElements2 = vld1q_u8(B + 32);
+            uint8x16_t BElements3 = vld1q_u8(B + 48);
+
+            MlasUdotAccumulateRow(0);
+
+            if (RowCount > 1) {
+                MlasUdotAccumulateRow(1);
+            }
+
+            if (RowCount > 2) {
+                MlasUdotAccumulateRow(2);
+                MlasUdotAccumulateRow(3);
+            }
+
+            a += PackedABytes;
+            B += 64;
+        }
+
+        //
+        // Fixup the accumulators with the zero point adjustments and store
+        // the block to matrix C.
+        //
+
+        const size_t CountNThisBlock = std::min(CountN, size_t(16));
+
+        int32x4_t ColumnSums[4];
+
+        for (size_t j = 0; j < 4; j++) {
+            ColumnSums[j] = vaddq_s32(vld1q_s32(ColumnSumBuffer + j * 4), vdupq_n_s32(DepthValue));
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            int32_t* c = C + r * ldc;
+            int32x4_t RowSum = vdupq_n_s32(RowSumBuffer[r]);
+            MLAS_DECLSPEC_ALIGN(int32_t Output[16], 16);
+
+            for (size_t j = 0; j < 4; j++) {
+                int32x4_t Vector = vaddq_s32(vreinterpretq_s32_u32(Accumulators[r][j]), RowSum);
+                vst1q_s32(&Output[j * 4], vaddq_s32(Vector, ColumnSums[j]));
+            }
+
+            if (ZeroMode) {
+                std::copy_n(Output, CountNThisBlock, c);
+            } else {
+                for (size_t n = 0; n < CountNThisBlock; n++) {
+                    c[n] += Output[n];
+                }
+            }
+        }
+
+        C += CountNThisBlock;
+        ColumnSumBuffer += 16;
+        CountN -= CountNThisBlock;
+    }
+}
+
+size_t
+MLASCALL
+MlasGemmU8X8KernelUdot(
+    const uint8_t* A,
+    const uint8_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    int32_t DepthValue,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows using the dot product instructions.
+
+Arguments:
+
+    A - Supplies the address of matrix A. The matrix data has been packed
+        using MlasGemmU8X8CopyPackANeon.
+
+    B - Supplies the address of matrix B. The matrix data has been packed
+        using MlasGemmU8X8CopyPackBUdot.
+
+    C - Supplies the address of matrix C.
+
+    PackedCountK - Supplies the number of packed columns from matrix A and
+        the number of packed rows from matrix B to iterate over.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    RowSumBuffer - Supplies the sum of each row from matrix A multiplied by
+        the zero point offset of matrix B. These values are accumulated into
+        every column of matrix C.
+
+    ColumnSumBuffer - Supplies the sum of each column from matrix B multiplied
+        by the zero point offset of matrix A. These values are accumulated
+        into every row of matrix C.
+
+    DepthValue - Supplies the value CountK multiplied by the zero point offset
+        of matrix A multplied by the zero point offset of matrix B. This value
+        is accumulated into every element of matrix C.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    //
+    // The row blocks match the interleaving used by MlasGemmU8X8CopyPackANeon.
+    //
+
+    if (CountM >= 4) {
+        MlasGemmU8X8KernelUdotBlock<4>(A, B, C, PackedCountK, CountN, ldc,
+            RowSumBuffer, ColumnSumBuffer, DepthValue, ZeroMode);
+        return 4;
+    }
+
+    if (CountM >= 2) {
+        MlasGemmU8X8KernelUdotBlock<2>(A, B, C, PackedCountK, CountN, ldc,
+            RowSumBuffer, ColumnSumBuffer, DepthValue, ZeroMode);
+        return 2;
+    }
+
+    MlasGemmU8X8KernelUdotBlock<1>(A, B, C, PackedCountK, CountN, ldc,
+        RowSumBuffer, ColumnSumBuffer, DepthValue, ZeroMode);
+    return 1;
+}
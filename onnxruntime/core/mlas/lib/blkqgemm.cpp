@@ -0,0 +1,696 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    blkqgemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation (SGEMM) for a block quantized matrix B.
+
+    Matrix B is quantized to 4 or 8 bits in blocks along the K dimension,
+    each block having its own scale and zero point. For the small row counts
+    of token by token generation, the operation is bound by the memory
+    bandwidth needed to stream matrix B, so the kernel dequantizes the values
+    in registers and matrix B is only read in its quantized form. For larger
+    row counts, the blocks are dequantized to a buffer that is multiplied with
+    the SGEMM kernels.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of columns from matrix B assigned to a thread as a unit.
+//
+
+#define MLAS_BLOCK_QUANT_GEMM_STRIDEN       16
+
+//
+// Define the number of columns and rows from matrix B dequantized to the
+// buffer multiplied with the SGEMM kernels. The rows are a multiple of the
+// largest supported block length.
+//
+
+#define MLAS_BLOCK_QUANT_DEQUANT_STRIDEN    32
+#define MLAS_BLOCK_QUANT_DEQUANT_STRIDEK    256
+
+//
+// Define the number of rows from matrix A needed to dequantize matrix B to a
+// buffer instead of dequantizing the values in registers for each row.
+//
+
+#define MLAS_BLOCK_QUANT_DEQUANT_MINIMUM_M  8
+
+//
+// Define the minimum number of multiply/accumulate operations to assign to a
+// thread.
+//
+
+#define MLAS_BLOCK_QUANT_GEMM_THREAD_COMPLEXITY (size_t(64) * size_t(1024))
+
+MLAS_FORCEINLINE
+size_t
+MlasBlockQuantBlobSize(
+    size_t BlkBits,
+    size_t BlkLen
+    )
+{
+    return BlkLen * BlkBits / 8;
+}
+
+MLAS_FORCEINLINE
+size_t
+MlasBlockQuantBlockCountK(
+    size_t K,
+    size_t BlkLen
+    )
+{
+    return (K + BlkLen - 1) / BlkLen;
+}
+
+MLAS_FORCEINLINE
+uint8_t
+MlasBlockQuantLoadValue(
+    const uint8_t* Blob,
+    size_t BlkBits,
+    size_t k
+    )
+{
+    if (BlkBits == 4) {
+        return (Blob[k / 2] >> ((k & 1) * 4)) & 0x0F;
+    }
+
+    return Blob[k];
+}
+
+bool
+MLASCALL
+MlasIsBlockQuantGemmAvailable(
+    size_t BlkBits,
+    size_t BlkLen
+    )
+/*++
+
+Routine Description:
+
+    This routine determines if the block quantized SGEMM supports the
+    quantization parameters.
+
+Arguments:
+
+    BlkBits - Supplies the number of bits of each quantized value.
+
+    BlkLen - Supplies the number of rows of matrix B in a quantization block.
+
+Return Value:
+
+    Returns true if the parameters are supported, else false.
+
+--*/
+{
+    if (BlkBits != 4 && BlkBits != 8) {
+        return false;
+    }
+
+    return BlkLen == 16 || BlkLen == 32 || BlkLen == 64 || BlkLen == 128 || BlkLen == 256;
+}
+
+size_t
+MLASCALL
+MlasBlockQuantBSize(
+    size_t N,
+    size_t K,
+    size_t BlkBits,
+    size_t BlkLen
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of bytes of the quantized data of matrix
+    B, not including the scales and the zero points.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    BlkBits - Supplies the number of bits of each quantized value.
+
+    BlkLen - Supplies the number of rows of matrix B in a quantization block.
+
+Return Value:
+
+    Returns the number of bytes, else zero if the parameters are not
+    supported.
+
+--*/
+{
+    if (!MlasIsBlockQuantGemmAvailable(BlkBits, BlkLen)) {
+        return 0;
+    }
+
+    return N * MlasBlockQuantBlockCountK(K, BlkLen) * MlasBlockQuantBlobSize(BlkBits, BlkLen);
+}
+
+void
+MLASCALL
+MlasBlockQuantizeB(
+    size_t N,
+    size_t K,
+    size_t BlkBits,
+    size_t BlkLen,
+    const float* B,
+    size_t ldb,
+    uint8_t* QuantB,
+    float* QuantBScale,
+    uint8_t* QuantBZeroPoint
+    )
+/*++
+
+Routine Description:
+
+    This routine quantizes matrix B to the layout used by the block quantized
+    SGEMM. The range of each block includes zero so that zero is exactly
+    representable.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    BlkBits - Supplies the number of bits of each quantized value.
+
+    BlkLen - Supplies the number of rows of matrix B in a quantization block.
+
+    B - Supplies the address of matrix B, with the rows along the K
+        dimension.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    QuantB - Supplies the address of the quantized data, of the size returned
+        by MlasBlockQuantBSize.
+
+    QuantBScale - Supplies the address of the scale of each block.
+
+    QuantBZeroPoint - Optionally supplies the address of the zero point of
+        each block, else nullptr to quantize symmetrically.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockCountK = MlasBlockQuantBlockCountK(K, BlkLen);
+    const size_t BlobSize = MlasBlockQuantBlobSize(BlkBits, BlkLen);
+    const int32_t QuantMaximum = (1 << BlkBits) - 1;
+
+    for (size_t n = 0; n < N; n++) {
+
+        for (size_t kb = 0; kb < BlockCountK; kb++) {
+
+            const size_t k0 = kb * BlkLen;
+            const size_t CountK = std::min(K - k0, BlkLen);
+
+            float Minimum = 0.0f;
+            float Maximum = 0.0f;
+
+            for (size_t k = 0; k < CountK; k++) {
+                Minimum = std::min(Minimum, B[(k0 + k) * ldb + n]);
+                Maximum = std::max(Maximum, B[(k0 + k) * ldb + n]);
+            }
+
+            float Scale;
+            int32_t ZeroPoint;
+
+            if (QuantBZeroPoint != nullptr) {
+                Scale = (Maximum - Minimum) / float(QuantMaximum);
+                ZeroPoint = (Scale != 0.0f) ? int32_t(std::nearbyint(-Minimum / Scale)) : 0;
+                ZeroPoint = std::min(std::max(ZeroPoint, 0), QuantMaximum);
+                QuantBZeroPoint[n * BlockCountK + kb] = uint8_t(ZeroPoint);
+            } else {
+                ZeroPoint = 1 << (BlkBits - 1);
+                Scale = std::max(-Minimum, Maximum) / float(ZeroPoint - 1);
+            }
+
+            QuantBScale[n * BlockCountK + kb] = Scale;
+
+            const float ReciprocalScale = (Scale != 0.0f) ? 1.0f / Scale : 0.0f;
+            uint8_t* Blob = QuantB + (n * BlockCountK + kb) * BlobSize;
+
+            std::fill_n(Blob, BlobSize, uint8_t(0));
+
+            for (size_t k = 0; k < BlkLen; k++) {
+
+                int32_t Value = ZeroPoint;
+
+                if (k < CountK) {
+                    Value += int32_t(std::nearbyint(B[(k0 + k) * ldb + n] * ReciprocalScale));
+                    Value = std::min(std::max(Value, 0), QuantMaximum);
+                }
+
+                if (BlkBits == 4) {
+                    Blob[k / 2] |= uint8_t(Value << ((k & 1) * 4));
+                } else {
+                    Blob[k] = uint8_t(Value);
+                }
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasBlockQuantGemvKernel(
+    const float* A,
+    const uint8_t* QuantB,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    size_t BlkBits,
+    size_t BlkLen
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute the product of a row of matrix
+    A by a set of columns of the block quantized matrix B.
+
+Arguments:
+
+    A - Supplies the address of the row of matrix A.
+
+    QuantB - Supplies the address of the quantized data of the first column.
+
+    QuantBScale - Supplies the address of the scales of the first column.
+
+    QuantBZeroPoint - Optionally supplies the address of the zero points of
+        the first column, else nullptr if the quantization is symmetric.
+
+    C - Supplies the address of the row of matrix C.
+
+    CountN - Supplies the number of columns of matrix C to compute.
+
+    CountK - Supplies the number of columns of matrix A and rows of matrix B.
+
+    BlockCountK - Supplies the number of blocks of each column of matrix B.
+
+    BlkBits - Supplies the number of bits of each quantized value.
+
+    BlkLen - Supplies the number of rows of matrix B in a quantization block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlobSize = MlasBlockQuantBlobSize(BlkBits, BlkLen);
+    const float DefaultZeroPoint = float(1 << (BlkBits - 1));
+
+    for (size_t n = 0; n < CountN; n++) {
+
+        float Accumulator = 0.0f;
+
+        for (size_t kb = 0; kb < BlockCountK; kb++) {
+
+            const size_t k0 = kb * BlkLen;
+            const size_t BlockK = std::min(CountK - k0, BlkLen);
+            const uint8_t* Blob = QuantB + (n * BlockCountK + kb) * BlobSize;
+            const float ZeroPoint = (QuantBZeroPoint != nullptr) ?
+                float(QuantBZeroPoint[n * BlockCountK + kb]) : DefaultZeroPoint;
+
+            float BlockAccumulator = 0.0f;
+
+            for (size_t k = 0; k < BlockK; k++) {
+                BlockAccumulator += A[k0 + k] * (float(MlasBlockQuantLoadValue(Blob, BlkBits, k)) - ZeroPoint);
+            }
+
+            Accumulator += BlockAccumulator * QuantBScale[n * BlockCountK + kb];
+        }
+
+        C[n] = Accumulator;
+    }
+}
+
+void
+MlasBlockQuantDequantizeB(
+    const uint8_t* QuantB,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* Buffer,
+    size_t CountN,
+    size_t StartK,
+    size_t CountK,
+    size_t BlockCountK,
+    size_t BlkBits,
+    size_t BlkLen
+    )
+/*++
+
+Routine Description:
+
+    This routine dequantizes a set of rows by a set of columns of the block
+    quantized matrix B to a buffer with a row stride of
+    MLAS_BLOCK_QUANT_DEQUANT_STRIDEN.
+
+Arguments:
+
+    QuantB - Supplies the address of the quantized data of the first column.
+
+    QuantBScale - Supplies the address of the scales of the first column.
+
+    QuantBZeroPoint - Optionally supplies the address of the zero points of
+        the first column, else nullptr if the quantization is symmetric.
+
+    Buffer - Supplies the address of the buffer.
+
+    CountN - Supplies the number of columns to dequantize.
+
+    StartK - Supplies the first row to dequantize, a multiple of BlkLen.
+
+    CountK - Supplies the number of rows to dequantize.
+
+    BlockCountK - Supplies the number of blocks of each column of matrix B.
+
+    BlkBits - Supplies the number of bits of each quantized value.
+
+    BlkLen - Supplies the number of rows of matrix B in a quantization block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlobSize = MlasBlockQuantBlobSize(BlkBits, BlkLen);
+    const float DefaultZeroPoint = float(1 << (BlkBits - 1));
+
+    for (size_t n = 0; n < CountN; n++) {
+
+        for (size_t k0 = 0; k0 < CountK; k0 += BlkLen) {
+
+            const size_t kb = (StartK + k0) / BlkLen;
+            const size_t BlockK = std::min(CountK - k0, BlkLen);
+            const uint8_t* Blob = QuantB + (n * BlockCountK + kb) * BlobSize;
+            const float Scale = QuantBScale[n * BlockCountK + kb];
+            const float ZeroPoint = (QuantBZeroPoint != nullptr) ?
+                float(QuantBZeroPoint[n * BlockCountK + kb]) : DefaultZeroPoint;
+
+            for (size_t k = 0; k < BlockK; k++) {
+                Buffer[(k0 + k) * MLAS_BLOCK_QUANT_DEQUANT_STRIDEN + n] =
+                    (float(MlasBlockQuantLoadValue(Blob, BlkBits, k)) - ZeroPoint) * Scale;
+            }
+        }
+    }
+}
+
+struct MLAS_BLOCK_QUANT_GEMM_WORK_BLOCK {
+    size_t M;
+    size_t N;
+    size_t K;
+    size_t BlkBits;
+    size_t BlkLen;
+    const float* A;
+    size_t lda;
+    const uint8_t* QuantB;
+    const float* QuantBScale;
+    const uint8_t* QuantBZeroPoint;
+    const float* Bias;
+    float* C;
+    size_t ldc;
+    int32_t ThreadCountN;
+};
+
+void
+MlasBlockQuantGemmOperation(
+    const MLAS_BLOCK_QUANT_GEMM_WORK_BLOCK* WorkBlock,
+    size_t RangeStartN,
+    size_t RangeCountN
+    )
+/*++
+
+Routine Description:
+
+    This routine computes all the rows by a range of columns of matrix C.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the GEMM parameters.
+
+    RangeStartN - Supplies the starting column.
+
+    RangeCountN - Supplies the number of columns.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t M = WorkBlock->M;
+    const size_t K = WorkBlock->K;
+    const size_t BlkBits = WorkBlock->BlkBits;
+    const size_t BlkLen = WorkBlock->BlkLen;
+    const size_t lda = WorkBlock->lda;
+    const size_t ldc = WorkBlock->ldc;
+    const size_t BlockCountK = MlasBlockQuantBlockCountK(K, BlkLen);
+    const size_t ColumnStrideQuantB = BlockCountK * MlasBlockQuantBlobSize(BlkBits, BlkLen);
+
+    const uint8_t* QuantB = WorkBlock->QuantB + RangeStartN * ColumnStrideQuantB;
+    const float* QuantBScale = WorkBlock->QuantBScale + RangeStartN * BlockCountK;
+    const uint8_t* QuantBZeroPoint = (WorkBlock->QuantBZeroPoint != nullptr) ?
+        WorkBlock->QuantBZeroPoint + RangeStartN * BlockCountK : nullptr;
+    float* C = WorkBlock->C + RangeStartN;
+
+    if (M < MLAS_BLOCK_QUANT_DEQUANT_MINIMUM_M) {
+
+#if defined(MLAS_TARGET_AMD64)
+        PMLAS_BLOCK_QUANT_GEMV_KERNEL BlockQuantGemvKernel = MlasPlatform.BlockQuantGemvKernel;
+#else
+        PMLAS_BLOCK_QUANT_GEMV_KERNEL BlockQuantGemvKernel = MlasBlockQuantGemvKernel;
+#endif
+
+        //
+        // Step through the columns in strides so that the quantized data of
+        // the columns stays in the cache while iterating over the rows.
+        //
+
+        for (size_t n = 0; n < RangeCountN; n += MLAS_BLOCK_QUANT_GEMM_STRIDEN) {
+
+            const size_t CountN = std::min(RangeCountN - n, size_t(MLAS_BLOCK_QUANT_GEMM_STRIDEN));
+
+            for (size_t m = 0; m < M; m++) {
+                BlockQuantGemvKernel(WorkBlock->A + m * lda, QuantB + n * ColumnStrideQuantB,
+                    QuantBScale + n * BlockCountK,
+                    (QuantBZeroPoint != nullptr) ? QuantBZeroPoint + n * BlockCountK : nullptr,
+                    C + m * ldc + n, CountN, K, BlockCountK, BlkBits, BlkLen);
+            }
+        }
+
+    } else {
+
+        MLAS_DECLSPEC_ALIGN(float Buffer[MLAS_BLOCK_QUANT_DEQUANT_STRIDEK * MLAS_BLOCK_QUANT_DEQUANT_STRIDEN], 64);
+
+        for (size_t n = 0; n < RangeCountN; n += MLAS_BLOCK_QUANT_DEQUANT_STRIDEN) {
+
+            const size_t CountN = std::min(RangeCountN - n, size_t(MLAS_BLOCK_QUANT_DEQUANT_STRIDEN));
+
+            for (size_t k = 0; k < K; k += MLAS_BLOCK_QUANT_DEQUANT_STRIDEK) {
+
+                const size_t CountK = std::min(K - k, size_t(MLAS_BLOCK_QUANT_DEQUANT_STRIDEK));
+
+                MlasBlockQuantDequantizeB(QuantB + n * ColumnStrideQuantB, QuantBScale + n * BlockCountK,
+                    (QuantBZeroPoint != nullptr) ? QuantBZeroPoint + n * BlockCountK : nullptr,
+                    Buffer, CountN, k, CountK, BlockCountK, BlkBits, BlkLen);
+
+                MlasGemm(CblasNoTrans, CblasNoTrans, M, CountN, CountK, 1.0f, WorkBlock->A + k, lda,
+                    Buffer, MLAS_BLOCK_QUANT_DEQUANT_STRIDEN, (k == 0) ? 0.0f : 1.0f, C + n, ldc, nullptr);
+            }
+        }
+    }
+
+    if (WorkBlock->Bias != nullptr) {
+
+        const float* Bias = WorkBlock->Bias + RangeStartN;
+
+        for (size_t m = 0; m < M; m++) {
+            for (size_t n = 0; n < RangeCountN; n++) {
+                C[m * ldc + n] += Bias[n];
+            }
+        }
+    }
+}
+
+void
+MlasBlockQuantGemmThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    block quantized SGEMM operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = static_cast<MLAS_BLOCK_QUANT_GEMM_WORK_BLOCK*>(Context);
+
+    const size_t BlockCountN = (WorkBlock->N + MLAS_BLOCK_QUANT_GEMM_STRIDEN - 1) / MLAS_BLOCK_QUANT_GEMM_STRIDEN;
+
+    size_t RangeStartN;
+    size_t RangeCountN;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCountN, BlockCountN, &RangeStartN, &RangeCountN);
+
+    RangeStartN *= MLAS_BLOCK_QUANT_GEMM_STRIDEN;
+    RangeCountN = std::min(WorkBlock->N - RangeStartN, RangeCountN * MLAS_BLOCK_QUANT_GEMM_STRIDEN);
+
+    if (RangeCountN > 0) {
+        MlasBlockQuantGemmOperation(WorkBlock, RangeStartN, RangeCountN);
+    }
+}
+
+void
+MLASCALL
+MlasBlockQuantGemm(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BlkBits,
+    size_t BlkLen,
+    const float* A,
+    size_t lda,
+    const uint8_t* QuantB,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    const float* Bias,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) with the block quantized matrix B.
+
+        C = A * B + Bias
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    BlkBits - Supplies the number of bits of each quantized value, 4 or 8.
+
+    BlkLen - Supplies the number of rows of matrix B in a quantization block,
+        a power of two from 16 to 256.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    QuantB - Supplies the address of the quantized data of matrix B.
+
+    QuantBScale - Supplies the address of the scale of each block.
+
+    QuantBZeroPoint - Optionally supplies the address of the zero point of
+        each block, else nullptr if the quantization is symmetric.
+
+    Bias - Optionally supplies the address of the bias vector of N elements.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (M == 0 || N == 0) {
+        return;
+    }
+
+    if (!MlasIsBlockQuantGemmAvailable(BlkBits, BlkLen)) {
+#ifdef MLAS_NO_EXCEPTION
+        abort();
+#else
+        throw std::runtime_error("unsupported block quantization");
+#endif
+    }
+
+    MLAS_BLOCK_QUANT_GEMM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.BlkBits = BlkBits;
+    WorkBlock.BlkLen = BlkLen;
+    WorkBlock.A = A;
+    WorkBlock.lda = lda;
+    WorkBlock.QuantB = QuantB;
+    WorkBlock.QuantBScale = QuantBScale;
+    WorkBlock.QuantBZeroPoint = QuantBZeroPoint;
+    WorkBlock.Bias = Bias;
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Only the columns are split so that each thread streams
+    // through a private slice of matrix B.
+    //
+
+    const size_t Complexity = M * N * std::max(K, size_t(1));
+    const size_t BlockCountN = (N + MLAS_BLOCK_QUANT_GEMM_STRIDEN - 1) / MLAS_BLOCK_QUANT_GEMM_STRIDEN;
+
+    size_t TargetThreadCount = Complexity / MLAS_BLOCK_QUANT_GEMM_THREAD_COMPLEXITY + 1;
+
+    TargetThreadCount = std::min(TargetThreadCount, size_t(MlasGetMaximumThreadCount(ThreadPool)));
+    TargetThreadCount = std::min(TargetThreadCount, BlockCountN);
+
+    if (TargetThreadCount == 1) {
+        MlasBlockQuantGemmOperation(&WorkBlock, 0, N);
+        return;
+    }
+
+    WorkBlock.ThreadCountN = int32_t(TargetThreadCount);
+
+    MlasExecuteThreaded(MlasBlockQuantGemmThreaded, &WorkBlock, WorkBlock.ThreadCountN, ThreadPool);
+}
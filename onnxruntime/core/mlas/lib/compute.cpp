@@ -989,3 +989,287 @@ Return Value:
 
     MlasExecuteThreaded(MlasComputeSoftmaxThreaded, &WorkBlock, ThreadCountN, ThreadPool);
 }
+
+//
+// Define the parameters to execute segments of a softmax operation over a
+// strided axis on worker threads.
+//
+
+struct MLAS_SOFTMAX_STRIDED_WORK_BLOCK {
+    int32_t ThreadCount;
+    bool LogSoftmax;
+    const float* Input;
+    float* Output;
+    size_t N;
+    size_t D;
+    size_t M;
+    size_t BlockCountM;
+};
+
+constexpr size_t MlasSoftmaxStridedBlockSize = 64;
+
+void
+MlasComputeSoftmaxStridedThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    softmax or log softmax operation over a strided axis.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_SOFTMAX_STRIDED_WORK_BLOCK*)Context;
+
+    //
+    // Partition the operation along the N dimension and the blocks of columns
+    // of the M dimension.
+    //
+
+    const size_t D = WorkBlock->D;
+    const size_t M = WorkBlock->M;
+    const size_t BlockCountM = WorkBlock->BlockCountM;
+    const bool LogSoftmax = WorkBlock->LogSoftmax;
+
+    size_t Block;
+    size_t CountBlock;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, WorkBlock->N * BlockCountM, &Block, &CountBlock);
+
+    MLAS_DECLSPEC_ALIGN(float NegativeMaximum[MlasSoftmaxStridedBlockSize], 16);
+    MLAS_DECLSPEC_ALIGN(float Accumulation[MlasSoftmaxStridedBlockSize], 16);
+
+    while (CountBlock > 0) {
+
+        const size_t n = Block / BlockCountM;
+        const size_t m = (Block % BlockCountM) * MlasSoftmaxStridedBlockSize;
+        const size_t CountM = std::min(M - m, MlasSoftmaxStridedBlockSize);
+        const size_t CountM4 = CountM & ~size_t(3);
+
+        const float* Input = WorkBlock->Input + n * D * M + m;
+        float* Output = WorkBlock->Output + n * D * M + m;
+
+        //
+        // Find the maximum value for each column of the block. The rows of the
+        // block are traversed in order so that the columns are loaded from
+        // contiguous memory.
+        //
+
+        for (size_t c = 0; c < CountM; c++) {
+            NegativeMaximum[c] = MlasMinimumF32Value;
+        }
+
+        for (size_t d = 0; d < D; d++) {
+
+            const float* InputRow = Input + d * M;
+            size_t c = 0;
+
+            for (; c < CountM4; c += 4) {
+                MLAS_FLOAT32X4 Maximum = MlasMaximumFloat32x4(MlasLoadFloat32x4(&NegativeMaximum[c]),
+                    MlasLoadFloat32x4(InputRow + c));
+                MlasStoreFloat32x4(&NegativeMaximum[c], Maximum);
+            }
+
+            for (; c < CountM; c++) {
+                NegativeMaximum[c] = std::max(NegativeMaximum[c], InputRow[c]);
+            }
+        }
+
+        for (size_t c = 0; c < CountM; c++) {
+            NegativeMaximum[c] = -NegativeMaximum[c];
+            Accumulation[c] = 0.0f;
+        }
+
+        //
+        // Compute the sum of the exponential functions for each column. The
+        // intermediate exp() results are stored for softmax.
+        //
+
+        for (size_t d = 0; d < D; d++) {
+
+            const float* InputRow = Input + d * M;
+            float* OutputRow = Output + d * M;
+            size_t c = 0;
+
+            for (; c < CountM4; c += 4) {
+
+                MLAS_FLOAT32X4 Vector = MlasComputeSumExpVector(MlasLoadFloat32x4(InputRow + c),
+                    MlasLoadFloat32x4(&NegativeMaximum[c]));
+                MlasStoreFloat32x4(&Accumulation[c], MlasAddFloat32x4(MlasLoadFloat32x4(&Accumulation[c]), Vector));
+
+                if (!LogSoftmax) {
+                    MlasStoreFloat32x4(OutputRow + c, Vector);
+                }
+            }
+
+            for (; c < CountM; c++) {
+
+                MLAS_FLOAT32X4 Vector = MlasComputeSumExpVector(MlasBroadcastFloat32x4(InputRow[c]),
+                    MlasBroadcastFloat32x4(NegativeMaximum[c]));
+                Accumulation[c] += MlasExtractLaneFloat32x4<0>(Vector);
+
+                if (!LogSoftmax) {
+                    MlasStoreLaneFloat32x4<0>(OutputRow + c, Vector);
+                }
+            }
+        }
+
+        //
+        // Produce the final output. The Accumulation buffer is reused for the
+        // logarithm of the sums for log softmax, else for their reciprocal.
+        //
+
+        if (LogSoftmax) {
+
+            for (size_t c = 0; c < CountM; c++) {
+                Accumulation[c] = std::log(Accumulation[c]);
+            }
+
+            for (size_t d = 0; d < D; d++) {
+
+                const float* InputRow = Input + d * M;
+                float* OutputRow = Output + d * M;
+                size_t c = 0;
+
+                for (; c < CountM4; c += 4) {
+
+                    MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(InputRow + c);
+                    Vector = MlasAddFloat32x4(Vector, MlasLoadFloat32x4(&NegativeMaximum[c]));
+                    Vector = MlasSubtractFloat32x4(Vector, MlasLoadFloat32x4(&Accumulation[c]));
+                    MlasStoreFloat32x4(OutputRow + c, Vector);
+                }
+
+                for (; c < CountM; c++) {
+                    OutputRow[c] = InputRow[c] + NegativeMaximum[c] - Accumulation[c];
+                }
+            }
+
+        } else {
+
+            for (size_t c = 0; c < CountM; c++) {
+                Accumulation[c] = 1.0f / Accumulation[c];
+            }
+
+            for (size_t d = 0; d < D; d++) {
+
+                float* OutputRow = Output + d * M;
+                size_t c = 0;
+
+                for (; c < CountM4; c += 4) {
+                    MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(OutputRow + c);
+                    MlasStoreFloat32x4(OutputRow + c, MlasMultiplyFloat32x4(Vector, MlasLoadFloat32x4(&Accumulation[c])));
+                }
+
+                for (; c < CountM; c++) {
+                    OutputRow[c] *= Accumulation[c];
+                }
+            }
+        }
+
+        Block++;
+        CountBlock--;
+    }
+}
+
+void
+MLASCALL
+MlasComputeSoftmaxStrided(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    size_t M,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax function over the middle
+    dimension of a [N, D, M] buffer, so that a softmax over an axis other than
+    the innermost one does not need to transpose its input and output.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of outer rows to process.
+
+    D - Supplies the size of the dimension to compute the function over.
+
+    M - Supplies the number of inner columns, which is the stride between the
+        consecutive elements the function is computed over.
+
+    LogSoftmax - Supplies true if this is a log softmax operation, else false
+        if this is a softmax operation.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SOFTMAX_STRIDED_WORK_BLOCK WorkBlock;
+
+    //
+    // Capture the softmax parameters to the work block.
+    //
+
+    WorkBlock.LogSoftmax = LogSoftmax;
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+    WorkBlock.M = M;
+    WorkBlock.BlockCountM = (M + MlasSoftmaxStridedBlockSize - 1) / MlasSoftmaxStridedBlockSize;
+
+    //
+    // Compute the number of target threads as for MlasComputeSoftmax, limited
+    // by the number of blocks of columns instead of the number of rows.
+    //
+
+    const size_t BlockCount = N * WorkBlock.BlockCountM;
+
+    int32_t ThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCount) > BlockCount) {
+        ThreadCount = int32_t(BlockCount);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t ElementBlockCount = ((N * D * M) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCount) > ElementBlockCount) {
+        ThreadCount = int32_t(ElementBlockCount);
+    }
+
+    if (ThreadCount == 0) {
+        return;
+    }
+
+    WorkBlock.ThreadCount = ThreadCount;
+
+    MlasExecuteThreaded(MlasComputeSoftmaxStridedThreaded, &WorkBlock, ThreadCount, ThreadPool);
+}
@@ -23,6 +23,27 @@ Abstract:
 #define MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD \
     (MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK)
 
+//
+// Define the number of elements in a transformed Winograd F(2x2, 3x3) tile.
+//
+
+#define MLAS_CONV_WINOGRAD_TILE_ELEMENTS            16
+
+//
+// Define the target number of working buffer elements per thread for the
+// Winograd algorithm. The tile rows that are processed together are sized so
+// that the transformed input and output tiles stay in the cache.
+//
+
+#define MLAS_CONV_WINOGRAD_WORKING_BUFFER_SIZE_PER_THREAD (128 * 1024)
+
+//
+// Define the minimum number of input channels and filters per group for the
+// Winograd algorithm.
+//
+
+#define MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS         32
+
 //
 // Define the parameters to execute segments of a convolution operation on
 // worker threads.
@@ -826,6 +847,339 @@ Return Value:
     return true;
 }
 
+void
+MlasConvWinogradTransformInput(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    float* TransformedInput,
+    size_t TileRowStart,
+    size_t TileRowCount
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the 4x4 input patches of a range of tile rows for
+    the Winograd F(2x2, 3x3) algorithm.
+
+        V = B^T * d * B
+
+    The transformed input is stored as 16 matrices of InputChannels rows by
+    the number of tiles in the range.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor for the current batch and group.
+
+    TransformedInput - Supplies the buffer to receive the transformed input.
+
+    TileRowStart - Supplies the first tile row to transform.
+
+    TileRowCount - Supplies the number of tile rows to transform.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+
+    const size_t TileCountW = Parameters->u.Winograd.TileCountW;
+    const size_t TileCount = TileRowCount * TileCountW;
+    const size_t MatrixStride = InputChannels * TileCount;
+
+    for (size_t c = 0; c < InputChannels; c++) {
+
+        const float* input = Input + c * InputSize;
+        float* transformed = TransformedInput + c * TileCount;
+
+        for (size_t ty = 0; ty < TileRowCount; ty++) {
+
+            //
+            // Compute the top row of the input patch. The unsigned arithmetic
+            // wraps for rows in the padding region, which then fail the
+            // bounds check below.
+            //
+
+            const size_t ih = (TileRowStart + ty) * 2 - PaddingTop;
+
+            for (size_t tx = 0; tx < TileCountW; tx++) {
+
+                const size_t iw = tx * 2 - PaddingLeft;
+
+                float d[4][4];
+
+                if (InputHeight >= 4 && ih <= InputHeight - 4 &&
+                    InputWidth >= 4 && iw <= InputWidth - 4) {
+
+                    const float* patch = input + ih * InputWidth + iw;
+
+                    for (size_t i = 0; i < 4; i++) {
+                        for (size_t j = 0; j < 4; j++) {
+                            d[i][j] = patch[i * InputWidth + j];
+                        }
+                    }
+
+                } else {
+
+                    for (size_t i = 0; i < 4; i++) {
+                        for (size_t j = 0; j < 4; j++) {
+                            d[i][j] = (ih + i < InputHeight && iw + j < InputWidth) ?
+                                input[(ih + i) * InputWidth + (iw + j)] : 0.0f;
+                        }
+                    }
+                }
+
+                float t[4][4];
+
+                for (size_t j = 0; j < 4; j++) {
+                    t[0][j] = d[0][j] - d[2][j];
+                    t[1][j] = d[1][j] + d[2][j];
+                    t[2][j] = d[2][j] - d[1][j];
+                    t[3][j] = d[1][j] - d[3][j];
+                }
+
+                float* v = transformed + ty * TileCountW + tx;
+
+                for (size_t i = 0; i < 4; i++) {
+                    v[(i * 4 + 0) * MatrixStride] = t[i][0] - t[i][2];
+                    v[(i * 4 + 1) * MatrixStride] = t[i][1] + t[i][2];
+                    v[(i * 4 + 2) * MatrixStride] = t[i][2] - t[i][1];
+                    v[(i * 4 + 3) * MatrixStride] = t[i][1] - t[i][3];
+                }
+            }
+        }
+    }
+}
+
+void
+MlasConvWinogradTransformOutput(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* TransformedOutput,
+    float* Output,
+    size_t TileRowStart,
+    size_t TileRowCount
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the products of a range of tile rows back to 2x2
+    output tiles for the Winograd F(2x2, 3x3) algorithm.
+
+        Y = A^T * m * A
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    TransformedOutput - Supplies the 16 matrices of FilterCount rows by the
+        number of tiles in the range.
+
+    Output - Supplies the output tensor for the current batch and group.
+
+    TileRowStart - Supplies the first tile row to transform.
+
+    TileRowCount - Supplies the number of tile rows to transform.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+
+    const size_t TileCountW = Parameters->u.Winograd.TileCountW;
+    const size_t TileCount = TileRowCount * TileCountW;
+    const size_t MatrixStride = FilterCount * TileCount;
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        const float* transformed = TransformedOutput + f * TileCount;
+        float* output = Output + f * OutputSize;
+
+        for (size_t ty = 0; ty < TileRowCount; ty++) {
+
+            const size_t oh = (TileRowStart + ty) * 2;
+
+            for (size_t tx = 0; tx < TileCountW; tx++) {
+
+                const size_t ow = tx * 2;
+
+                const float* m = transformed + ty * TileCountW + tx;
+
+                float t[2][4];
+
+                for (size_t j = 0; j < 4; j++) {
+                    const float m0 = m[(0 * 4 + j) * MatrixStride];
+                    const float m1 = m[(1 * 4 + j) * MatrixStride];
+                    const float m2 = m[(2 * 4 + j) * MatrixStride];
+                    const float m3 = m[(3 * 4 + j) * MatrixStride];
+                    t[0][j] = m0 + m1 + m2;
+                    t[1][j] = m1 - m2 - m3;
+                }
+
+                for (size_t i = 0; i < 2 && oh + i < OutputHeight; i++) {
+
+                    float* y = output + (oh + i) * OutputWidth + ow;
+
+                    y[0] = t[i][0] + t[i][1] + t[i][2];
+
+                    if (ow + 1 < OutputWidth) {
+                        y[1] = t[i][1] - t[i][2] - t[i][3];
+                    }
+                }
+            }
+        }
+    }
+}
+
+void
+MlasConvWinogradOperation(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* Filter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    size_t TileRowStart,
+    size_t TileRowCount
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the Winograd F(2x2, 3x3) convolution algorithm
+    for a range of tile rows.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor for the current batch and group.
+
+    Filter - Supplies the filter tensor for the current group transformed by
+        MlasConvWinogradTransformFilter.
+
+    Bias - Optionally supplies the bias vector for the current group.
+
+    WorkingBuffer - Supplies the thread local slice of the working buffer.
+
+    Output - Supplies the output tensor for the current batch and group.
+
+    TileRowStart - Supplies the first tile row to compute.
+
+    TileRowCount - Supplies the number of tile rows to compute.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t OutputSize = Parameters->OutputSize;
+
+    const size_t TileCount = TileRowCount * Parameters->u.Winograd.TileCountW;
+
+    float* TransformedInput = WorkingBuffer;
+    float* TransformedOutput = WorkingBuffer +
+        MLAS_CONV_WINOGRAD_TILE_ELEMENTS * InputChannels * TileCount;
+
+    MlasConvWinogradTransformInput(Parameters, Input, TransformedInput, TileRowStart,
+        TileRowCount);
+
+    //
+    // Multiply each of the transformed filter matrices by the corresponding
+    // transformed input matrix.
+    //
+
+    for (size_t e = 0; e < MLAS_CONV_WINOGRAD_TILE_ELEMENTS; e++) {
+
+        MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, TileCount,
+            InputChannels, 1.0f, Filter + e * FilterCount * InputChannels, InputChannels,
+            TransformedInput + e * InputChannels * TileCount, TileCount, 0.0f,
+            TransformedOutput + e * FilterCount * TileCount, TileCount);
+    }
+
+    MlasConvWinogradTransformOutput(Parameters, TransformedOutput, Output, TileRowStart,
+        TileRowCount);
+
+    //
+    // Apply the activation with optional bias to the output rows covered by
+    // this range of tile rows.
+    //
+
+    const size_t OutputRowStart = TileRowStart * 2;
+    const size_t OutputRowCount = std::min(TileRowCount * 2, OutputHeight - OutputRowStart);
+
+    MlasActivation(Parameters->Activation, Output + OutputRowStart * OutputWidth, Bias,
+        FilterCount, OutputRowCount * OutputWidth, OutputSize);
+}
+
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    Winograd convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WORK_BLOCK* WorkBlock = (MLAS_CONV_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t TileCountH = Parameters->u.Winograd.TileCountH;
+    const size_t TileRowsPerSegment = Parameters->u.Winograd.TileRowsPerSegment;
+    const size_t SegmentCount = (TileCountH + TileRowsPerSegment - 1) / TileRowsPerSegment;
+
+    float* WorkingBuffer = WorkBlock->WorkingBuffer +
+        Index * Parameters->u.Winograd.WorkingBufferSizePerThread;
+
+    for (size_t segment = Index; segment < SegmentCount; segment += WorkBlock->TargetThreadCount) {
+
+        const size_t TileRowStart = segment * TileRowsPerSegment;
+        const size_t TileRowCount = std::min(TileRowsPerSegment, TileCountH - TileRowStart);
+
+        MlasConvWinogradOperation(Parameters, WorkBlock->Input, WorkBlock->Filter,
+            WorkBlock->Bias, WorkingBuffer, WorkBlock->Output, TileRowStart, TileRowCount);
+    }
+}
+
 void
 MLASCALL
 MlasConv(
@@ -876,6 +1230,7 @@ Return Value:
     const size_t OutputGroupSize = FilterCount * OutputSize;
     const size_t FilterGroupSize = FilterCount * K;
 
+    const size_t InputChannels = Parameters->InputChannels;
     const size_t BatchCount = Parameters->BatchCount;
     const size_t GroupCount = Parameters->GroupCount;
 
@@ -988,6 +1343,33 @@ Return Value:
 
                     break;
                 }
+
+                case MlasConvAlgorithmWinograd:
+                {
+                    //
+                    // Slice the tile rows across multiple threads. The filter
+                    // has been transformed by MlasConvWinogradTransformFilter.
+                    //
+
+                    MLAS_CONV_WORK_BLOCK WorkBlock;
+
+                    WorkBlock.Parameters = Parameters;
+                    WorkBlock.Input = Input;
+                    WorkBlock.Filter = filter;
+                    WorkBlock.Bias = bias;
+                    WorkBlock.WorkingBuffer = WorkingBuffer;
+                    WorkBlock.Output = Output;
+                    WorkBlock.TargetThreadCount = Parameters->ThreadCount;
+
+                    if (Parameters->ThreadCount > 1) {
+                        MlasExecuteThreaded(MlasConvWinogradThreaded, &WorkBlock,
+                            Parameters->ThreadCount, ThreadPool);
+                    } else {
+                        MlasConvWinogradThreaded(&WorkBlock, 0);
+                    }
+
+                    break;
+                }
             }
 
             //
@@ -998,7 +1380,8 @@ Return Value:
                 bias += FilterCount;
             }
 
-            filter += FilterGroupSize;
+            filter += (Algorithm == MlasConvAlgorithmWinograd) ?
+                MLAS_CONV_WINOGRAD_TILE_ELEMENTS * FilterCount * InputChannels : FilterGroupSize;
             Input += InputGroupSize;
             Output += OutputGroupSize;
         }
@@ -1022,7 +1405,9 @@ MlasConvPrepare(
     size_t FilterCount,
     const MLAS_ACTIVATION* Activation,
     size_t* WorkingBufferSize,
-    MLAS_THREADPOOL* ThreadPool
+    MLAS_THREADPOOL* ThreadPool,
+    bool FilterIsWinogradTransformed,
+    const MLAS_CONV_ALGORITHM* PreferredAlgorithm
     )
 /*++
 
@@ -1069,6 +1454,16 @@ Arguments:
     ThreadPool - Supplies the thread pool object to use, else nullptr if the
         base library threading support should be used.
 
+    FilterIsWinogradTransformed - Supplies true if the filter that will be
+        passed to MlasConv has been transformed by
+        MlasConvWinogradTransformFilter. The convolution must be one that
+        MlasConvWinogradFilterSize accepts.
+
+    PreferredAlgorithm - Optionally supplies the algorithm to use instead of
+        the heuristic choice between MlasConvAlgorithmExpandThenGemm and
+        MlasConvAlgorithmExpandThenGemmSegmented, e.g. the result of a tuning.
+        It is ignored for the convolutions that use another algorithm.
+
 Return Value:
 
     None.
@@ -1148,6 +1543,47 @@ Return Value:
 
     *WorkingBufferSize = 0;
 
+    if (FilterIsWinogradTransformed) {
+
+        //
+        // Slice the output into rows of 2x2 tiles. Group enough tile rows
+        // together to amortize the cost of packing the transformed filter
+        // for each of the GEMMs, then split the tile row segments across
+        // multiple threads.
+        //
+
+        const size_t TileCountH = (Parameters->OutputShape[0] + 1) / 2;
+        const size_t TileCountW = (Parameters->OutputShape[1] + 1) / 2;
+        const size_t TileRowElements =
+            MLAS_CONV_WINOGRAD_TILE_ELEMENTS * (InputChannels + FilterCount) * TileCountW;
+
+        size_t TileRowsPerSegment =
+            std::max(MLAS_CONV_WINOGRAD_WORKING_BUFFER_SIZE_PER_THREAD / TileRowElements, size_t(1));
+
+        int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+        if (MaximumThreadCount > 1) {
+            TileRowsPerSegment = std::min(TileRowsPerSegment,
+                (TileCountH + MaximumThreadCount - 1) / size_t(MaximumThreadCount));
+        }
+
+        TileRowsPerSegment = std::min(TileRowsPerSegment, TileCountH);
+
+        const size_t SegmentCount = (TileCountH + TileRowsPerSegment - 1) / TileRowsPerSegment;
+
+        Parameters->ThreadCount = int32_t(std::min(SegmentCount, size_t(MaximumThreadCount)));
+
+        Parameters->Algorithm = MlasConvAlgorithmWinograd;
+        Parameters->u.Winograd.TileCountH = TileCountH;
+        Parameters->u.Winograd.TileCountW = TileCountW;
+        Parameters->u.Winograd.TileRowsPerSegment = TileRowsPerSegment;
+        Parameters->u.Winograd.WorkingBufferSizePerThread = TileRowsPerSegment * TileRowElements;
+
+        *WorkingBufferSize = Parameters->ThreadCount * Parameters->u.Winograd.WorkingBufferSizePerThread;
+
+        return;
+    }
+
     if (AllStridesAreOne && AllPaddingIsZero) {
 
         //
@@ -1191,12 +1627,22 @@ Return Value:
         }
     }
 
-    if (FilterCount > OutputSize) {
+    //
+    // If the filter count is larger than the output dimensions, then perform
+    // the full matrix expansion and then invoke the threaded GEMM.
+    //
 
-        //
-        // The filter count is larger than the output dimensions, so perform the
-        // full matrix expansion and then invoke the threaded GEMM.
-        //
+    bool ExpandThenGemm = (FilterCount > OutputSize);
+
+    if (PreferredAlgorithm != nullptr) {
+        if (*PreferredAlgorithm == MlasConvAlgorithmExpandThenGemm) {
+            ExpandThenGemm = true;
+        } else if (*PreferredAlgorithm == MlasConvAlgorithmExpandThenGemmSegmented) {
+            ExpandThenGemm = false;
+        }
+    }
+
+    if (ExpandThenGemm) {
 
         Parameters->Algorithm = MlasConvAlgorithmExpandThenGemm;
 
@@ -1258,14 +1704,158 @@ Return Value:
     }
 }
 
-template<typename FilterType>
+size_t
+MLASCALL
+MlasConvWinogradFilterSize(
+    size_t Dimensions,
+    size_t GroupCount,
+    size_t InputChannels,
+    const int64_t* KernelShape,
+    const int64_t* DilationShape,
+    const int64_t* StrideShape,
+    size_t FilterCount
+    )
+/*++
+
+Routine Description:
+
+    This routine determines whether a convolution should use the Winograd
+    F(2x2, 3x3) algorithm and returns the number of elements required for the
+    transformed filter.
+
+    The algorithm applies to two dimensional 3x3 convolutions with unit
+    strides and dilations. The shape of the input tensor is not required, so
+    this routine can be called when the filter is first available.
+
+Arguments:
+
+    Dimensions - Supplies the number of dimensions.
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    KernelShape - Supplies the shape of the kernel transform.
+
+    DilationShape - Supplies the shape of the dilation.
+
+    StrideShape - Supplies the shape of the stride.
+
+    FilterCount - Supplies the number of rows of the filter matrix per group.
+
+Return Value:
+
+    Returns the number of elements for the transformed filter, else zero if
+    the Winograd algorithm should not be used.
+
+--*/
+{
+    if (Dimensions != 2) {
+        return 0;
+    }
+
+    for (size_t dim = 0; dim < 2; dim++) {
+        if (KernelShape[dim] != 3 || DilationShape[dim] != 1 || StrideShape[dim] != 1) {
+            return 0;
+        }
+    }
+
+    //
+    // The element wise transforms are only amortized by the GEMMs if there are
+    // enough input channels and filters. Depthwise and narrow convolutions are
+    // better served by the other algorithms.
+    //
+
+    if (InputChannels < MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS ||
+        FilterCount < MLAS_CONV_WINOGRAD_MINIMUM_CHANNELS) {
+        return 0;
+    }
+
+    return GroupCount * MLAS_CONV_WINOGRAD_TILE_ELEMENTS * FilterCount * InputChannels;
+}
+
 void
 MLASCALL
-MlasConvDepthwise(
+MlasConvWinogradTransformFilter(
+    size_t GroupCount,
+    size_t InputChannels,
+    size_t FilterCount,
+    const float* Filter,
+    float* TransformedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the 3x3 filters of a convolution for the Winograd
+    F(2x2, 3x3) algorithm.
+
+        U = G * g * G^T
+
+    The transformed filter of each group is stored as 16 matrices of
+    FilterCount rows by InputChannels columns.
+
+Arguments:
+
+    GroupCount - Supplies the number of channel groups.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of rows of the filter matrix per group.
+
+    Filter - Supplies the filter tensor.
+
+    TransformedFilter - Supplies the buffer to receive the transformed filter.
+        The buffer is sized by MlasConvWinogradFilterSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t MatrixStride = FilterCount * InputChannels;
+
+    for (size_t group = 0; group < GroupCount; group++) {
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            for (size_t c = 0; c < InputChannels; c++) {
+
+                const float* g = Filter + (f * InputChannels + c) * 9;
+
+                float t[4][3];
+
+                for (size_t j = 0; j < 3; j++) {
+                    t[0][j] = g[j];
+                    t[1][j] = 0.5f * (g[j] + g[3 + j] + g[6 + j]);
+                    t[2][j] = 0.5f * (g[j] - g[3 + j] + g[6 + j]);
+                    t[3][j] = g[6 + j];
+                }
+
+                float* u = TransformedFilter + f * InputChannels + c;
+
+                for (size_t i = 0; i < 4; i++) {
+                    u[(i * 4 + 0) * MatrixStride] = t[i][0];
+                    u[(i * 4 + 1) * MatrixStride] = 0.5f * (t[i][0] + t[i][1] + t[i][2]);
+                    u[(i * 4 + 2) * MatrixStride] = 0.5f * (t[i][0] - t[i][1] + t[i][2]);
+                    u[(i * 4 + 3) * MatrixStride] = t[i][2];
+                }
+            }
+        }
+
+        Filter += FilterCount * InputChannels * 9;
+        TransformedFilter += MLAS_CONV_WINOGRAD_TILE_ELEMENTS * MatrixStride;
+    }
+}
+
+template<typename FilterType, bool PerChannelZeroPoint>
+void
+MlasConvDepthwiseKernel(
     const uint8_t* Input,
     uint8_t InputZeroPoint,
     const FilterType* Filter,
-    FilterType FilterZeroPoint,
+    const FilterType* FilterZeroPoints,
     int32_t* Output,
     size_t Channels,
     size_t OutputCount,
@@ -1294,7 +1884,8 @@ Arguments:
 
     Filter - Supplies the filter tensor.
 
-    FilterZeroPoint - Supplies the zero point offset of the filter tensor.
+    FilterZeroPoints - Supplies the zero point offsets of the filter tensor,
+        one per channel if PerChannelZeroPoint, else a single value.
 
     Output - Supplies the output tensor in channels last format.
 
@@ -1315,10 +1906,10 @@ Return Value:
 #if defined(MLAS_SSE2_INTRINSICS)
     const __m128i ZeroVector = _mm_setzero_si128();
     const __m128i InputZeroPointVector = _mm_set1_epi16(InputZeroPoint);
-    const __m128i FilterZeroPointVector = _mm_set1_epi16(FilterZeroPoint);
+    __m128i FilterZeroPointVector = _mm_set1_epi16(FilterZeroPoints[0]);
 #elif defined(MLAS_NEON_INTRINSICS)
     const uint8x8_t InputZeroPointVector = vdup_n_u8(InputZeroPoint);
-    const uint8x8_t FilterZeroPointVector = vdup_n_u8(uint8_t(FilterZeroPoint));
+    uint8x8_t FilterZeroPointVector = vdup_n_u8(uint8_t(FilterZeroPoints[0]));
 #endif
 
     while (OutputCount > 0) {
@@ -1330,6 +1921,16 @@ Return Value:
 
         while (c >= 8) {
 
+            if (PerChannelZeroPoint) {
+                FilterZeroPointVector = _mm_loadl_epi64((const __m128i*)&FilterZeroPoints[ChannelOffset]);
+
+                if (std::is_signed<FilterType>::value) {
+                    FilterZeroPointVector = _mm_srai_epi16(_mm_unpacklo_epi8(ZeroVector, FilterZeroPointVector), 8);
+                } else {
+                    FilterZeroPointVector = _mm_unpacklo_epi8(FilterZeroPointVector, ZeroVector);
+                }
+            }
+
             __m128i Accumulator0 = _mm_setzero_si128();
             __m128i Accumulator1 = _mm_setzero_si128();
             size_t ChannelKernelOffset = ChannelOffset;
@@ -1374,6 +1975,10 @@ Return Value:
 
         while (c >= 8) {
 
+            if (PerChannelZeroPoint) {
+                FilterZeroPointVector = vld1_u8(reinterpret_cast<const uint8_t*>(&FilterZeroPoints[ChannelOffset]));
+            }
+
             int32x4_t Accumulator0 = vdupq_n_s32(0);
             int32x4_t Accumulator1 = vdupq_n_s32(0);
             size_t ChannelKernelOffset = ChannelOffset;
@@ -1416,6 +2021,7 @@ Return Value:
 
             int32_t Accumulator = 0;
             size_t ChannelKernelOffset = ChannelOffset;
+            const int32_t FilterZeroPoint = FilterZeroPoints[PerChannelZeroPoint ? ChannelOffset : 0];
 
             for (size_t k = 0; k < KernelSize; k++) {
 
@@ -1437,6 +2043,58 @@ Return Value:
     }
 }
 
+template<typename FilterType>
+void
+MLASCALL
+MlasConvDepthwise(
+    const uint8_t* Input,
+    uint8_t InputZeroPoint,
+    const FilterType* Filter,
+    FilterType FilterZeroPoint,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the depthwise convolution operation, see
+    MlasConvDepthwiseKernel.
+
+--*/
+{
+    MlasConvDepthwiseKernel<FilterType, false>(Input, InputZeroPoint, Filter,
+        &FilterZeroPoint, Output, Channels, OutputCount, KernelSize);
+}
+
+template<typename FilterType>
+void
+MLASCALL
+MlasConvDepthwise(
+    const uint8_t* Input,
+    uint8_t InputZeroPoint,
+    const FilterType* Filter,
+    const FilterType* FilterZeroPoints,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the depthwise convolution operation with a filter
+    zero point offset per channel, see MlasConvDepthwiseKernel.
+
+--*/
+{
+    MlasConvDepthwiseKernel<FilterType, true>(Input, InputZeroPoint, Filter,
+        FilterZeroPoints, Output, Channels, OutputCount, KernelSize);
+}
+
 template
 void
 MLASCALL
@@ -1464,3 +2122,31 @@ MlasConvDepthwise<uint8_t>(
     size_t OutputCount,
     size_t KernelSize
     );
+
+template
+void
+MLASCALL
+MlasConvDepthwise<int8_t>(
+    const uint8_t* Input,
+    uint8_t InputZeroPoint,
+    const int8_t* Filter,
+    const int8_t* FilterZeroPoints,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
+
+template
+void
+MLASCALL
+MlasConvDepthwise<uint8_t>(
+    const uint8_t* Input,
+    uint8_t InputZeroPoint,
+    const uint8_t* Filter,
+    const uint8_t* FilterZeroPoints,
+    int32_t* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize
+    );
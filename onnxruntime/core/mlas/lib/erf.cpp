@@ -267,3 +267,96 @@ Return Value:
     MlasErfKernel(Input, Output, N);
 #endif
 }
+
+void
+MLASCALL
+MlasComputeBiasGelu(
+    const float* Input,
+    const float* Bias,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the Gaussian error linear unit of the sum of the
+    input and an optional bias using the error function.
+
+        Output = 0.5 * x * (1 + erf(x / sqrt(2))) where x = Input + Bias
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Bias - Optionally supplies a buffer to add to the input buffer.
+
+    Output - Supplies the output buffer. The output buffer may be the same as
+        the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Process the elements in blocks that fit in a stack buffer so that the
+    // intermediate values stay in the cache and no temporary allocation is
+    // needed.
+    //
+
+    constexpr size_t BlockSize = 256;
+    MLAS_DECLSPEC_ALIGN(float Buffer[BlockSize], 16);
+
+    constexpr float SqrtHalf = 0.70710678118654752440f;
+
+    const MLAS_FLOAT32X4 SqrtHalfVector = MlasBroadcastFloat32x4(SqrtHalf);
+    const MLAS_FLOAT32X4 HalfVector = MlasBroadcastFloat32x4(0.5f);
+
+    while (N > 0) {
+
+        const size_t CountThisBlock = std::min(N, BlockSize);
+        size_t n = 0;
+
+        for (; n + 4 <= CountThisBlock; n += 4) {
+            MLAS_FLOAT32X4 Value = MlasLoadFloat32x4(Input + n);
+            if (Bias != nullptr) {
+                Value = MlasAddFloat32x4(Value, MlasLoadFloat32x4(Bias + n));
+            }
+            MlasStoreFloat32x4(Buffer + n, MlasMultiplyFloat32x4(Value, SqrtHalfVector));
+        }
+
+        for (; n < CountThisBlock; n++) {
+            float Value = Input[n] + ((Bias != nullptr) ? Bias[n] : 0.0f);
+            Buffer[n] = Value * SqrtHalf;
+        }
+
+        MlasComputeErf(Buffer, Buffer, CountThisBlock);
+
+        n = 0;
+
+        for (; n + 4 <= CountThisBlock; n += 4) {
+            MLAS_FLOAT32X4 Value = MlasLoadFloat32x4(Input + n);
+            if (Bias != nullptr) {
+                Value = MlasAddFloat32x4(Value, MlasLoadFloat32x4(Bias + n));
+            }
+            MLAS_FLOAT32X4 Erf = MlasAddFloat32x4(MlasLoadFloat32x4(Buffer + n), MlasBroadcastFloat32x4(1.0f));
+            MlasStoreFloat32x4(Output + n, MlasMultiplyFloat32x4(MlasMultiplyFloat32x4(Value, HalfVector), Erf));
+        }
+
+        for (; n < CountThisBlock; n++) {
+            float Value = Input[n] + ((Bias != nullptr) ? Bias[n] : 0.0f);
+            Output[n] = 0.5f * Value * (Buffer[n] + 1.0f);
+        }
+
+        Input += CountThisBlock;
+        Output += CountThisBlock;
+        if (Bias != nullptr) {
+            Bias += CountThisBlock;
+        }
+        N -= CountThisBlock;
+    }
+}
@@ -0,0 +1,171 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfconvert.cpp
+
+Abstract:
+
+    This module implements the conversions between half precision and single
+    precision buffers.
+
+    The portable kernels convert one element at a time. On AMD64 the platform
+    dispatches to the F16C kernels, which convert eight elements per
+    instruction.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasConvertHalfToFloatKernel(
+    const MLAS_FP16* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the portable kernel to convert a buffer of half
+    precision values to single precision.
+
+Arguments:
+
+    Source - Supplies the buffer of half precision values.
+
+    Destination - Supplies the buffer of single precision values.
+
+    Count - Supplies the number of values to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0; n < Count; n++) {
+        Destination[n] = MLAS_HALF_CONVERT<MLAS_FP16>::ToFloat(Source[n]);
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalfKernel(
+    const float* Source,
+    MLAS_FP16* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the portable kernel to convert a buffer of single
+    precision values to half precision, rounding to nearest even.
+
+Arguments:
+
+    Source - Supplies the buffer of single precision values.
+
+    Destination - Supplies the buffer of half precision values.
+
+    Count - Supplies the number of values to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0; n < Count; n++) {
+        Destination[n] = MLAS_HALF_CONVERT<MLAS_FP16>::FromFloat(Source[n]);
+    }
+}
+
+//
+// The Windows AMD64 build implements MlasConvertHalfToFloatBuffer in
+// assembly.
+//
+
+#if !(defined(_WIN32) && defined(MLAS_TARGET_AMD64))
+
+void
+MLASCALL
+MlasConvertHalfToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of half precision values to single
+    precision.
+
+Arguments:
+
+    Source - Supplies the buffer of half precision values.
+
+    Destination - Supplies the buffer of single precision values.
+
+    Count - Supplies the number of values to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    PMLAS_CONVERT_HALF_TO_FLOAT_KERNEL ConvertHalfToFloatKernel = MlasPlatform.ConvertHalfToFloatKernel;
+#else
+    PMLAS_CONVERT_HALF_TO_FLOAT_KERNEL ConvertHalfToFloatKernel = MlasConvertHalfToFloatKernel;
+#endif
+
+    ConvertHalfToFloatKernel(reinterpret_cast<const MLAS_FP16*>(Source), Destination, Count);
+}
+
+#endif
+
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of single precision values to half
+    precision, rounding to nearest even.
+
+Arguments:
+
+    Source - Supplies the buffer of single precision values.
+
+    Destination - Supplies the buffer of half precision values.
+
+    Count - Supplies the number of values to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    PMLAS_CONVERT_FLOAT_TO_HALF_KERNEL ConvertFloatToHalfKernel = MlasPlatform.ConvertFloatToHalfKernel;
+#else
+    PMLAS_CONVERT_FLOAT_TO_HALF_KERNEL ConvertFloatToHalfKernel = MlasConvertFloatToHalfKernel;
+#endif
+
+    ConvertFloatToHalfKernel(Source, reinterpret_cast<MLAS_FP16*>(Destination), Count);
+}
@@ -0,0 +1,1195 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm.cpp
+
+Abstract:
+
+    This module implements the half precision and bfloat16 matrix/matrix
+    multiply operations.
+
+    The operations are computed by the single precision kernels: blocks of
+    matrix A and matrix B are converted to single precision in local buffers,
+    accumulated to a single precision block of matrix C, and then rounded to
+    the output type. Packing matrix B converts it once to the single precision
+    packed format, so repeated multiplies only convert matrix A and matrix C.
+
+    This module also implements the single precision matrix/matrix multiply
+    with matrix B packed in half precision or bfloat16, which stores constant
+    weights in half the memory. Blocks of the packed matrix B are expanded to
+    single precision in a local buffer and reused for all the rows of matrix A
+    processed by the thread.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of rows of matrix A and matrix C processed per block.
+//
+
+#define MLAS_HGEMM_STRIDEM                  16
+
+//
+// Define the number of rows of an unpacked matrix B converted per block.
+//
+
+#define MLAS_HGEMM_STRIDEK                  128
+
+//
+// Define the parameters to execute segments of a half precision GEMM
+// operation on worker threads.
+//
+
+template<typename T>
+struct MLAS_HGEMM_WORK_BLOCK {
+    int32_t ThreadCountM;
+    int32_t ThreadCountN;
+    CBLAS_TRANSPOSE TransA;
+    CBLAS_TRANSPOSE TransB;
+    size_t M;
+    size_t N;
+    size_t K;
+    const T* A;
+    size_t lda;
+    const void* B;
+    size_t ldb;
+    T* C;
+    size_t ldc;
+    float alpha;
+    bool BIsPacked;
+};
+
+//
+// Define the parameters to execute segments of a single precision GEMM
+// operation with a half precision packed matrix B on worker threads.
+//
+
+template<typename T>
+struct MLAS_SGEMM_HALF_PACKED_B_WORK_BLOCK {
+    int32_t ThreadCountM;
+    int32_t ThreadCountN;
+    CBLAS_TRANSPOSE TransA;
+    size_t M;
+    size_t N;
+    size_t K;
+    const float* A;
+    size_t lda;
+    const T* PackedB;
+    float* C;
+    size_t ldc;
+    float alpha;
+    float beta;
+};
+
+template<typename T>
+void
+MlasHalfGemmConvertA(
+    float* D,
+    const T* A,
+    size_t lda,
+    CBLAS_TRANSPOSE TransA,
+    size_t CountM,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a block of matrix A to a single precision buffer
+    with CountK elements per row.
+
+Arguments:
+
+    D - Supplies the address of the destination buffer.
+
+    A - Supplies the address of the first element of the block of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    CountM - Supplies the number of rows of the block.
+
+    CountK - Supplies the number of columns of the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t m = 0; m < CountM; m++) {
+
+        for (size_t k = 0; k < CountK; k++) {
+
+            const T Value = (TransA == CblasNoTrans) ? A[m * lda + k] : A[k * lda + m];
+
+            D[m * CountK + k] = MLAS_HALF_CONVERT<T>::ToFloat(Value);
+        }
+    }
+}
+
+template<typename T>
+void
+MlasHalfGemmConvertPackB(
+    float* D,
+    const T* B,
+    size_t ldb,
+    CBLAS_TRANSPOSE TransB,
+    size_t CountN,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a block of matrix B to the single precision packed
+    format used by the SGEMM kernels.
+
+    Columns of 16 elements from the source matrix are unrolled to be physically
+    contiguous. Any remaining columns less than 16 elements wide are
+    zero-padded.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    B - Supplies the address of the first element of the block of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    CountN - Supplies the number of columns of the block.
+
+    CountK - Supplies the number of rows of the block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t AlignedN =
+        (CountN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    for (size_t n = 0; n < AlignedN; n += 16) {
+
+        for (size_t k = 0; k < CountK; k++) {
+
+            for (size_t i = 0; i < 16; i++) {
+
+                float Value = 0.0f;
+
+                if (n + i < CountN) {
+                    Value = MLAS_HALF_CONVERT<T>::ToFloat(
+                        (TransB == CblasNoTrans) ? B[k * ldb + n + i] : B[(n + i) * ldb + k]);
+                }
+
+                *D++ = Value;
+            }
+        }
+    }
+}
+
+template<typename T>
+void
+MlasHalfGemmOperation(
+    const MLAS_HGEMM_WORK_BLOCK<T>* WorkBlock,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a segment of a half precision GEMM operation on the
+    current thread.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the GEMM parameters.
+
+    RangeStartM - Supplies the starting row of matrix C.
+
+    RangeCountM - Supplies the number of rows of matrix C.
+
+    RangeStartN - Supplies the starting column of matrix C.
+
+    RangeCountN - Supplies the number of columns of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float PanelA[MLAS_HGEMM_STRIDEM * MLAS_SGEMM_PACKED_STRIDEK];
+    MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_SGEMM_PACKED_STRIDEN * MLAS_HGEMM_STRIDEK], 16 * sizeof(float));
+    float PanelC[MLAS_HGEMM_STRIDEM * MLAS_SGEMM_PACKED_STRIDEN];
+
+    const CBLAS_TRANSPOSE TransA = WorkBlock->TransA;
+    const CBLAS_TRANSPOSE TransB = WorkBlock->TransB;
+    const size_t K = WorkBlock->K;
+    const size_t lda = WorkBlock->lda;
+    const size_t ldb = WorkBlock->ldb;
+    const size_t ldc = WorkBlock->ldc;
+
+    //
+    // The packed matrix B is sliced along the K dimension by the packing
+    // routine, so an unpacked matrix B is converted in smaller slices to
+    // limit the size of the local buffer.
+    //
+
+    const size_t StrideK = WorkBlock->BIsPacked ? MLAS_SGEMM_PACKED_STRIDEK : MLAS_HGEMM_STRIDEK;
+    const size_t PackedAlignedN =
+        (WorkBlock->N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    size_t CountM;
+
+    for (size_t m = RangeStartM; m < RangeStartM + RangeCountM; m += CountM) {
+
+        CountM = std::min(RangeStartM + RangeCountM - m, size_t(MLAS_HGEMM_STRIDEM));
+
+        size_t CountN;
+
+        for (size_t n = RangeStartN; n < RangeStartN + RangeCountN; n += CountN) {
+
+            CountN = std::min(RangeStartN + RangeCountN - n, size_t(MLAS_SGEMM_PACKED_STRIDEN));
+
+            //
+            // Accumulate the block of matrix C in single precision.
+            //
+
+            size_t CountK;
+
+            for (size_t k = 0; k < K; k += CountK) {
+
+                CountK = std::min(K - k, StrideK);
+
+                const T* a = WorkBlock->A + ((TransA == CblasNoTrans) ? (m * lda + k) : (k * lda + m));
+
+                MlasHalfGemmConvertA(PanelA, a, lda, TransA, CountM, CountK);
+
+                const float* PackedB;
+                size_t PackedStartN;
+                size_t AlignedN;
+
+                if (WorkBlock->BIsPacked) {
+
+                    PackedB = (const float*)WorkBlock->B + PackedAlignedN * k;
+                    PackedStartN = n;
+                    AlignedN = PackedAlignedN;
+
+                } else {
+
+                    const T* b = (const T*)WorkBlock->B + ((TransB == CblasNoTrans) ? (k * ldb + n) : (n * ldb + k));
+
+                    MlasHalfGemmConvertPackB(PanelB, b, ldb, TransB, CountN, CountK);
+
+                    PackedB = PanelB;
+                    PackedStartN = 0;
+                    AlignedN = (CountN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+                }
+
+                MlasSgemmPackedOperation(CblasNoTrans, CountM, PackedStartN, CountN,
+                    CountK, WorkBlock->alpha, PanelA, CountK, PackedB, AlignedN,
+                    (k == 0) ? 0.0f : 1.0f, PanelC, MLAS_SGEMM_PACKED_STRIDEN);
+            }
+
+            //
+            // Round the block of matrix C to the output type. An empty K
+            // dimension produces zeros.
+            //
+
+            T* c = WorkBlock->C + m * ldc + n;
+
+            for (size_t i = 0; i < CountM; i++) {
+
+                for (size_t j = 0; j < CountN; j++) {
+
+                    const float Value = (K == 0) ? 0.0f : PanelC[i * MLAS_SGEMM_PACKED_STRIDEN + j];
+
+                    c[i * ldc + j] = MLAS_HALF_CONVERT<T>::FromFloat(Value);
+                }
+            }
+        }
+    }
+}
+
+template<typename T>
+void
+MlasHalfGemmOperation(
+    const MLAS_SGEMM_HALF_PACKED_B_WORK_BLOCK<T>* WorkBlock,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a segment of a single precision GEMM operation with
+    a half precision packed matrix B on the current thread.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the GEMM parameters.
+
+    RangeStartM - Supplies the starting row of matrix C.
+
+    RangeCountM - Supplies the number of rows of matrix C.
+
+    RangeStartN - Supplies the starting column of matrix C.
+
+    RangeCountN - Supplies the number of columns of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_SGEMM_PACKED_STRIDEN * MLAS_HGEMM_STRIDEK], 16 * sizeof(float));
+
+    const CBLAS_TRANSPOSE TransA = WorkBlock->TransA;
+    const size_t K = WorkBlock->K;
+    const size_t lda = WorkBlock->lda;
+    const size_t ldc = WorkBlock->ldc;
+
+    const size_t PackedAlignedN =
+        (WorkBlock->N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    const float* A = WorkBlock->A + RangeStartM * ((TransA == CblasNoTrans) ? lda : 1);
+    float* C = WorkBlock->C + RangeStartM * ldc;
+
+    size_t CountN;
+
+    for (size_t n = RangeStartN; n < RangeStartN + RangeCountN; n += CountN) {
+
+        CountN = std::min(RangeStartN + RangeCountN - n, size_t(MLAS_SGEMM_PACKED_STRIDEN));
+
+        const size_t AlignedCountN =
+            (CountN + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+        //
+        // The packed matrix B is sliced along the K dimension by the packing
+        // routine. Each slice is expanded in smaller slices to limit the size
+        // of the local buffer.
+        //
+
+        size_t CountK;
+
+        for (size_t k = 0; k < K; k += CountK) {
+
+            const size_t PackedStartK = k - k % MLAS_SGEMM_PACKED_STRIDEK;
+            const size_t PackedCountK = std::min(K - PackedStartK, size_t(MLAS_SGEMM_PACKED_STRIDEK));
+            const size_t OffsetK = k - PackedStartK;
+
+            CountK = std::min(PackedCountK - OffsetK, size_t(MLAS_HGEMM_STRIDEK));
+
+            //
+            // Expand the rows of each column of 16 elements of the slice.
+            //
+
+            const T* pb = WorkBlock->PackedB + PackedAlignedN * PackedStartK;
+            float* d = PanelB;
+
+            for (size_t nn = n; nn < n + AlignedCountN; nn += 16) {
+
+                const T* b = pb + PackedCountK * nn + OffsetK * 16;
+
+                for (size_t i = 0; i < CountK * 16; i++) {
+                    d[i] = MLAS_HALF_CONVERT<T>::ToFloat(b[i]);
+                }
+
+                d += CountK * 16;
+            }
+
+            const float* a = A + ((TransA == CblasNoTrans) ? k : k * lda);
+
+            MlasSgemmPackedOperation(TransA, RangeCountM, 0, CountN, CountK,
+                WorkBlock->alpha, a, lda, PanelB, AlignedCountN,
+                (k == 0) ? WorkBlock->beta : 1.0f, C + n, ldc);
+        }
+    }
+}
+
+template<typename WorkBlockType>
+void
+MlasHalfGemmThreaded(
+    void* Context,
+    int32_t ThreadId
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    half precision GEMM operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (WorkBlockType*)Context;
+
+    const int32_t ThreadIdM = ThreadId / WorkBlock->ThreadCountN;
+    const int32_t ThreadIdN = ThreadId % WorkBlock->ThreadCountN;
+
+    //
+    // Partition the operation along the M dimension.
+    //
+
+    size_t RangeStartM;
+    size_t RangeCountM;
+
+    MlasPartitionWork(ThreadIdM, WorkBlock->ThreadCountM, WorkBlock->M, &RangeStartM, &RangeCountM);
+
+    //
+    // Partition the operation along the N dimension. Columns are partitioned
+    // to match the alignment of the packed matrix B.
+    //
+
+    const size_t N = WorkBlock->N;
+    size_t RangeStartN;
+    size_t RangeCountN;
+
+    const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
+        MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+    MlasPartitionWork(ThreadIdN, WorkBlock->ThreadCountN, BlockedN, &RangeStartN,
+        &RangeCountN);
+
+    RangeStartN *= MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+    RangeCountN *= MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+    RangeCountN = std::min(N - RangeStartN, RangeCountN);
+
+    MlasHalfGemmOperation(WorkBlock, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+}
+
+template<typename WorkBlockType>
+void
+MlasHalfGemmSchedule(
+    WorkBlockType* WorkBlock,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine schedules the half precision GEMM operation across one or
+    more threads.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the GEMM parameters.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t M = WorkBlock->M;
+    const size_t N = WorkBlock->N;
+    const size_t K = WorkBlock->K;
+
+    if (M == 0 || N == 0) {
+        return;
+    }
+
+    //
+    // Compute the number of target threads given the complexity of the GEMM
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K);
+
+    int32_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_SGEMM_THREAD_COMPLEXITY * MLAS_MAXIMUM_THREAD_COUNT)) {
+        TargetThreadCount = int32_t(Complexity / double(MLAS_SGEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = MLAS_MAXIMUM_THREAD_COUNT;
+    }
+
+    int32_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Segment the operation across multiple threads.
+    //
+
+    if (N > M) {
+
+        const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
+            MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
+
+        if (size_t(TargetThreadCount) > BlockedN) {
+            TargetThreadCount = int32_t(BlockedN);
+        }
+
+        WorkBlock->ThreadCountM = 1;
+        WorkBlock->ThreadCountN = TargetThreadCount;
+
+    } else {
+
+        if (size_t(TargetThreadCount) > M) {
+            TargetThreadCount = int32_t(M);
+        }
+
+        WorkBlock->ThreadCountM = TargetThreadCount;
+        WorkBlock->ThreadCountN = 1;
+    }
+
+    MlasExecuteThreaded(MlasHalfGemmThreaded<WorkBlockType>, WorkBlock, TargetThreadCount, ThreadPool);
+}
+
+template<typename T>
+void
+MlasHalfGemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const T* A,
+    size_t lda,
+    const void* B,
+    size_t ldb,
+    bool BIsPacked,
+    T* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    MLAS_HGEMM_WORK_BLOCK<T> WorkBlock;
+
+    memset(&WorkBlock, 0, sizeof(MLAS_HGEMM_WORK_BLOCK<T>));
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.TransB = TransB;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.A = A;
+    WorkBlock.lda = lda;
+    WorkBlock.B = B;
+    WorkBlock.ldb = ldb;
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+    WorkBlock.alpha = alpha;
+    WorkBlock.BIsPacked = BIsPacked;
+
+    MlasHalfGemmSchedule(&WorkBlock, ThreadPool);
+}
+
+template<typename T>
+void
+MlasHalfGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const T* B,
+    size_t ldb,
+    void* PackedB
+    )
+{
+    const size_t AlignedN =
+        (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    //
+    // Step through each slice of matrix B along the K dimension. Each slice
+    // is converted in the same layout as the single precision packing.
+    //
+
+    size_t CountK;
+
+    for (size_t k = 0; k < K; k += CountK) {
+
+        CountK = std::min(K - k, size_t(MLAS_SGEMM_PACKED_STRIDEK));
+
+        const T* b = B + ((TransB == CblasNoTrans) ? (k * ldb) : k);
+
+        MlasHalfGemmConvertPackB((float*)PackedB, b, ldb, TransB, N, CountK);
+
+        PackedB = (float*)PackedB + AlignedN * CountK;
+    }
+}
+
+template<typename T>
+void
+MlasGemmPackBHalfImpl(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    T* PackedB
+    )
+{
+    const size_t AlignedN =
+        (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    //
+    // Step through each slice of matrix B along the K dimension. Columns of
+    // 16 elements are unrolled to be physically contiguous and the remaining
+    // columns are zero-padded, as in the single precision packing.
+    //
+
+    size_t CountK;
+
+    for (size_t k = 0; k < K; k += CountK) {
+
+        CountK = std::min(K - k, size_t(MLAS_SGEMM_PACKED_STRIDEK));
+
+        for (size_t n = 0; n < AlignedN; n += 16) {
+
+            for (size_t kk = k; kk < k + CountK; kk++) {
+
+                for (size_t i = 0; i < 16; i++) {
+
+                    float Value = 0.0f;
+
+                    if (n + i < N) {
+                        Value = (TransB == CblasNoTrans) ? B[kk * ldb + n + i] : B[(n + i) * ldb + kk];
+                    }
+
+                    *PackedB++ = MLAS_HALF_CONVERT<T>::FromFloat(Value);
+                }
+            }
+        }
+    }
+}
+
+template<typename T>
+void
+MlasGemmHalfPackedBImpl(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const T* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    MLAS_SGEMM_HALF_PACKED_B_WORK_BLOCK<T> WorkBlock;
+
+    memset(&WorkBlock, 0, sizeof(MLAS_SGEMM_HALF_PACKED_B_WORK_BLOCK<T>));
+
+    WorkBlock.TransA = TransA;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+    WorkBlock.K = K;
+    WorkBlock.A = A;
+    WorkBlock.lda = lda;
+    WorkBlock.PackedB = PackedB;
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+    WorkBlock.alpha = alpha;
+    WorkBlock.beta = beta;
+
+    MlasHalfGemmSchedule(&WorkBlock, ThreadPool);
+}
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const MLAS_FP16* A,
+    size_t lda,
+    const MLAS_FP16* B,
+    size_t ldb,
+    MLAS_FP16* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the half precision matrix/matrix multiply
+    operation C = alpha * op(A) * op(B).
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar alpha multiplier.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasHalfGemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, false, C, ldc, ThreadPool);
+}
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const MLAS_FP16* A,
+    size_t lda,
+    const void* PackedB,
+    MLAS_FP16* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the half precision matrix/matrix multiply
+    operation C = alpha * op(A) * B with a matrix B packed by MlasGemmPackB.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar alpha multiplier.
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PackedB - Supplies the address of packed matrix B.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasHalfGemm(TransA, CblasNoTrans, M, N, K, alpha, A, lda, PackedB, 0, true, C, ldc, ThreadPool);
+}
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const MLAS_BF16* A,
+    size_t lda,
+    const MLAS_BF16* B,
+    size_t ldb,
+    MLAS_BF16* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the bfloat16 matrix/matrix multiply operation
+    C = alpha * op(A) * op(B).
+
+Arguments:
+
+    See the half precision routine above.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasHalfGemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, false, C, ldc, ThreadPool);
+}
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const MLAS_BF16* A,
+    size_t lda,
+    const void* PackedB,
+    MLAS_BF16* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the bfloat16 matrix/matrix multiply operation
+    C = alpha * op(A) * B with a matrix B packed by MlasGemmPackB.
+
+Arguments:
+
+    See the half precision routine above.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasHalfGemm(TransA, CblasNoTrans, M, N, K, alpha, A, lda, PackedB, 0, true, C, ldc, ThreadPool);
+}
+
+void
+MLASCALL
+MlasGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const MLAS_FP16* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the contents of half precision matrix B to the
+    single precision packed format. The destination buffer should be sized
+    based on MlasGemmPackBSize(N, K).
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasHalfGemmPackB(TransB, N, K, B, ldb, PackedB);
+}
+
+void
+MLASCALL
+MlasGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const MLAS_BF16* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the contents of bfloat16 matrix B to the single
+    precision packed format. The destination buffer should be sized based on
+    MlasGemmPackBSize(N, K).
+
+Arguments:
+
+    See the half precision routine above.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasHalfGemmPackB(TransB, N, K, B, ldb, PackedB);
+}
+
+size_t
+MLASCALL
+MlasGemmPackBHalfSize(
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the half precision or
+    bfloat16 packed matrix B buffer.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+Return Value:
+
+    Returns the size in bytes for the packed matrix B buffer.
+
+--*/
+{
+    const size_t AlignedN =
+        (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    const size_t BytesRequired = AlignedN * K * sizeof(uint16_t);
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+    const size_t AlignedBytesRequired = (BytesRequired + BufferAlignment - 1) &
+        ~(BufferAlignment - 1);
+
+    return AlignedBytesRequired;
+}
+
+void
+MLASCALL
+MlasGemmPackBHalf(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    MLAS_FP16* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the contents of single precision matrix B to the
+    destination buffer, rounding the elements to half precision. The
+    destination buffer should be sized based on MlasGemmPackBHalfSize().
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasGemmPackBHalfImpl(TransB, N, K, B, ldb, PackedB);
+}
+
+void
+MLASCALL
+MlasGemmPackBHalf(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    MLAS_BF16* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the contents of single precision matrix B to the
+    destination buffer, rounding the elements to bfloat16. The destination
+    buffer should be sized based on MlasGemmPackBHalfSize().
+
+Arguments:
+
+    See the half precision routine above.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasGemmPackBHalfImpl(TransB, N, K, B, ldb, PackedB);
+}
+
+void
+MLASCALL
+MlasGemmHalfPackedB(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const MLAS_FP16* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation C = alpha * op(A) * B + beta * C with a matrix B packed in half
+    precision by MlasGemmPackBHalf.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PackedB - Supplies the address of packed matrix B.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasGemmHalfPackedBImpl(TransA, M, N, K, alpha, A, lda, PackedB, beta, C, ldc, ThreadPool);
+}
+
+void
+MLASCALL
+MlasGemmHalfPackedB(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const MLAS_BF16* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation C = alpha * op(A) * B + beta * C with a matrix B packed in
+    bfloat16 by MlasGemmPackBHalf.
+
+Arguments:
+
+    See the half precision routine above.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasGemmHalfPackedBImpl(TransA, M, N, K, alpha, A, lda, PackedB, beta, C, ldc, ThreadPool);
+}
@@ -0,0 +1,164 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    blkqgemm_avx2.cpp
+
+Abstract:
+
+    This module implements the kernel for the block quantized single
+    precision matrix/matrix multiply operation (SGEMM) using AVX2 and FMA3
+    intrinsics. The quantized values are expanded to floats in registers.
+
+--*/
+
+#include "../../mlasi.h"
+
+template<size_t BlkBits>
+MLAS_FORCEINLINE
+__m128i
+MlasBlockQuantLoad16ValuesAvx2(
+    const uint8_t* Blob
+    );
+
+template<>
+MLAS_FORCEINLINE
+__m128i
+MlasBlockQuantLoad16ValuesAvx2<4>(
+    const uint8_t* Blob
+    )
+{
+    //
+    // Expand the 16 nibbles of 8 bytes to 16 bytes, interleaving the low and
+    // high nibbles of each byte.
+    //
+
+    const __m128i LowMask = _mm_set1_epi8(0x0F);
+    const __m128i Packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(Blob));
+    const __m128i Low = _mm_and_si128(Packed, LowMask);
+    const __m128i High = _mm_and_si128(_mm_srli_epi16(Packed, 4), LowMask);
+
+    return _mm_unpacklo_epi8(Low, High);
+}
+
+template<>
+MLAS_FORCEINLINE
+__m128i
+MlasBlockQuantLoad16ValuesAvx2<8>(
+    const uint8_t* Blob
+    )
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(Blob));
+}
+
+template<size_t BlkBits>
+void
+MlasBlockQuantGemvKernelAvx2Impl(
+    const float* A,
+    const uint8_t* QuantB,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    size_t BlkLen
+    )
+{
+    const size_t BlobSize = BlkLen * BlkBits / 8;
+    const float DefaultZeroPoint = float(1 << (BlkBits - 1));
+
+    for (size_t n = 0; n < CountN; n++) {
+
+        __m256 Accumulator = _mm256_setzero_ps();
+        float TailAccumulator = 0.0f;
+
+        for (size_t kb = 0; kb < BlockCountK; kb++) {
+
+            const size_t k0 = kb * BlkLen;
+            const size_t BlockK = std::min(CountK - k0, BlkLen);
+            const uint8_t* Blob = QuantB + (n * BlockCountK + kb) * BlobSize;
+            const float* a = A + k0;
+            const float Scale = QuantBScale[n * BlockCountK + kb];
+            const float ZeroPoint = (QuantBZeroPoint != nullptr) ?
+                float(QuantBZeroPoint[n * BlockCountK + kb]) : DefaultZeroPoint;
+
+            const __m256 ZeroPointBroadcast = _mm256_set1_ps(ZeroPoint);
+
+            __m256 BlockAccumulator0 = _mm256_setzero_ps();
+            __m256 BlockAccumulator1 = _mm256_setzero_ps();
+
+            size_t k = 0;
+
+            for (; k + 16 <= BlockK; k += 16) {
+
+                const __m128i Values = MlasBlockQuantLoad16ValuesAvx2<BlkBits>(Blob + k * BlkBits / 8);
+
+                __m256 BElements0 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(Values));
+                __m256 BElements1 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(Values, 8)));
+
+                BElements0 = _mm256_sub_ps(BElements0, ZeroPointBroadcast);
+                BElements1 = _mm256_sub_ps(BElements1, ZeroPointBroadcast);
+
+                BlockAccumulator0 = _mm256_fmadd_ps(BElements0, _mm256_loadu_ps(a + k), BlockAccumulator0);
+                BlockAccumulator1 = _mm256_fmadd_ps(BElements1, _mm256_loadu_ps(a + k + 8), BlockAccumulator1);
+            }
+
+            Accumulator = _mm256_fmadd_ps(_mm256_add_ps(BlockAccumulator0, BlockAccumulator1),
+                _mm256_set1_ps(Scale), Accumulator);
+
+            //
+            // Handle the remaining rows of a partial last block.
+            //
+
+            if (k < BlockK) {
+
+                float BlockTailAccumulator = 0.0f;
+
+                for (; k < BlockK; k++) {
+
+                    const uint8_t Value = (BlkBits == 4) ?
+                        uint8_t((Blob[k / 2] >> ((k & 1) * 4)) & 0x0F) : Blob[k];
+
+                    BlockTailAccumulator += a[k] * (float(Value) - ZeroPoint);
+                }
+
+                TailAccumulator += BlockTailAccumulator * Scale;
+            }
+        }
+
+        __m128 Reduction = _mm_add_ps(_mm256_castps256_ps128(Accumulator), _mm256_extractf128_ps(Accumulator, 1));
+        Reduction = _mm_add_ps(Reduction, _mm_movehl_ps(Reduction, Reduction));
+        Reduction = _mm_add_ss(Reduction, _mm_shuffle_ps(Reduction, Reduction, 1));
+
+        C[n] = _mm_cvtss_f32(Reduction) + TailAccumulator;
+    }
+}
+
+void
+MLASCALL
+MlasBlockQuantGemvKernelAvx2(
+    const float* A,
+    const uint8_t* QuantB,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    size_t BlkBits,
+    size_t BlkLen
+    )
+{
+    if (BlkBits == 4) {
+        MlasBlockQuantGemvKernelAvx2Impl<4>(A, QuantB, QuantBScale, QuantBZeroPoint, C, CountN, CountK,
+            BlockCountK, BlkLen);
+    } else {
+        MlasBlockQuantGemvKernelAvx2Impl<8>(A, QuantB, QuantBScale, QuantBZeroPoint, C, CountN, CountK,
+            BlockCountK, BlkLen);
+    }
+}
@@ -0,0 +1,120 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfconvert_f16c.cpp
+
+Abstract:
+
+    This module implements the kernels for the conversions between half
+    precision and single precision buffers using F16C intrinsics.
+
+--*/
+
+#include "../../mlasi.h"
+
+void
+MLASCALL
+MlasConvertHalfToFloatKernelF16C(
+    const MLAS_FP16* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+
+        __m128i Half0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source));
+        __m128i Half1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source + 8));
+
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(Half0));
+        _mm256_storeu_ps(Destination + 8, _mm256_cvtph_ps(Half1));
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count >= 8) {
+
+        __m128i Half = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source));
+
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(Half));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    //
+    // Convert the remaining elements through a local buffer.
+    //
+
+    if (Count > 0) {
+
+        MLAS_DECLSPEC_ALIGN(uint16_t SourceBuffer[8], 16) = {};
+        MLAS_DECLSPEC_ALIGN(float DestinationBuffer[8], 32);
+
+        memcpy(SourceBuffer, Source, Count * sizeof(MLAS_FP16));
+
+        __m128i Half = _mm_load_si128(reinterpret_cast<const __m128i*>(SourceBuffer));
+
+        _mm256_store_ps(DestinationBuffer, _mm256_cvtph_ps(Half));
+
+        memcpy(Destination, DestinationBuffer, Count * sizeof(float));
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalfKernelF16C(
+    const float* Source,
+    MLAS_FP16* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+
+        __m256 Float0 = _mm256_loadu_ps(Source);
+        __m256 Float1 = _mm256_loadu_ps(Source + 8);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Destination), _mm256_cvtps_ph(Float0, _MM_FROUND_TO_NEAREST_INT));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Destination + 8), _mm256_cvtps_ph(Float1, _MM_FROUND_TO_NEAREST_INT));
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count >= 8) {
+
+        __m256 Float = _mm256_loadu_ps(Source);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(Destination), _mm256_cvtps_ph(Float, _MM_FROUND_TO_NEAREST_INT));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    //
+    // Convert the remaining elements through a local buffer.
+    //
+
+    if (Count > 0) {
+
+        MLAS_DECLSPEC_ALIGN(float SourceBuffer[8], 32) = {};
+        MLAS_DECLSPEC_ALIGN(uint16_t DestinationBuffer[8], 16);
+
+        memcpy(SourceBuffer, Source, Count * sizeof(float));
+
+        __m256 Float = _mm256_load_ps(SourceBuffer);
+
+        _mm_store_si128(reinterpret_cast<__m128i*>(DestinationBuffer), _mm256_cvtps_ph(Float, _MM_FROUND_TO_NEAREST_INT));
+
+        memcpy(Destination, DestinationBuffer, Count * sizeof(MLAS_FP16));
+    }
+}
@@ -0,0 +1,184 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparsegemm_fma3.cpp
+
+Abstract:
+
+    This module implements the kernel for the sparse single precision
+    matrix/matrix multiply operation (SGEMM) using AVX2 and FMA3 intrinsics.
+
+--*/
+
+#include "../../mlasi.h"
+
+//
+// Define the macros to accumulate and store one row of the output block. The
+// accumulators are named explicitly so that the compiler keeps each of them in
+// a register for the duration of the loop.
+//
+
+#define MlasSparseGemmAccumulateRowFma3(Row) \
+    if (RowCount > Row) { \
+        __m256 AElement = _mm256_broadcast_ss(&A[Row * lda + k]); \
+        Accumulator##Row##0 = _mm256_fmadd_ps(BElements0, AElement, Accumulator##Row##0); \
+        Accumulator##Row##1 = _mm256_fmadd_ps(BElements1, AElement, Accumulator##Row##1); \
+    }
+
+#define MlasSparseGemmStoreRowFma3(Row) \
+    if (RowCount > Row) { \
+        MlasSparseGemmStoreRowFma3Routine(C + Row * ldc, CountN, \
+            _mm256_mul_ps(Accumulator##Row##0, AlphaBroadcast), \
+            _mm256_mul_ps(Accumulator##Row##1, AlphaBroadcast)); \
+    }
+
+MLAS_FORCEINLINE
+void
+MlasSparseGemmStoreRowFma3Routine(
+    float* C,
+    size_t CountN,
+    __m256 Output0,
+    __m256 Output1
+    )
+{
+    if (CountN == 16) {
+
+        _mm256_storeu_ps(C, Output0);
+        _mm256_storeu_ps(C + 8, Output1);
+
+    } else {
+
+        MLAS_DECLSPEC_ALIGN(float Output[16], 32);
+
+        _mm256_store_ps(Output, Output0);
+        _mm256_store_ps(Output + 8, Output1);
+
+        std::copy_n(Output, CountN, C);
+    }
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasSparseGemmFloatKernelFma3Block(
+    const float* A,
+    size_t lda,
+    const uint32_t* RowIndices,
+    const float* Values,
+    size_t BlockCount,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    float alpha
+    )
+{
+    __m256 Accumulator00 = _mm256_setzero_ps();
+    __m256 Accumulator01 = _mm256_setzero_ps();
+    __m256 Accumulator10 = _mm256_setzero_ps();
+    __m256 Accumulator11 = _mm256_setzero_ps();
+    __m256 Accumulator20 = _mm256_setzero_ps();
+    __m256 Accumulator21 = _mm256_setzero_ps();
+    __m256 Accumulator30 = _mm256_setzero_ps();
+    __m256 Accumulator31 = _mm256_setzero_ps();
+    __m256 Accumulator40 = _mm256_setzero_ps();
+    __m256 Accumulator41 = _mm256_setzero_ps();
+    __m256 Accumulator50 = _mm256_setzero_ps();
+    __m256 Accumulator51 = _mm256_setzero_ps();
+
+    for (size_t i = 0; i < BlockCount; i++) {
+
+        const size_t k = RowIndices[i];
+
+        __m256 BElements0 = _mm256_loadu_ps(Values);
+        __m256 BElements1 = _mm256_loadu_ps(Values + 8);
+
+        MlasSparseGemmAccumulateRowFma3(0);
+        MlasSparseGemmAccumulateRowFma3(1);
+        MlasSparseGemmAccumulateRowFma3(2);
+        MlasSparseGemmAccumulateRowFma3(3);
+        MlasSparseGemmAccumulateRowFma3(4);
+        MlasSparseGemmAccumulateRowFma3(5);
+
+        Values += 16;
+    }
+
+    const __m256 AlphaBroadcast = _mm256_set1_ps(alpha);
+
+    MlasSparseGemmStoreRowFma3(0);
+    MlasSparseGemmStoreRowFma3(1);
+    MlasSparseGemmStoreRowFma3(2);
+    MlasSparseGemmStoreRowFma3(3);
+    MlasSparseGemmStoreRowFma3(4);
+    MlasSparseGemmStoreRowFma3(5);
+}
+
+size_t
+MLASCALL
+MlasSparseGemmFloatKernelFma3(
+    const float* A,
+    size_t lda,
+    const uint32_t* RowIndices,
+    const float* Values,
+    size_t BlockCount,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    float alpha
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows by one column block of the packed sparse matrix B.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    RowIndices - Supplies the row index of each non-zero block of the column
+        block.
+
+    Values - Supplies the values of each non-zero block of the column block.
+
+    BlockCount - Supplies the number of non-zero blocks.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns of matrix C to store.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    if (CountM >= 6) {
+        MlasSparseGemmFloatKernelFma3Block<6>(A, lda, RowIndices, Values, BlockCount, C, ldc, CountN, alpha);
+        return 6;
+    }
+
+    if (CountM >= 3) {
+        MlasSparseGemmFloatKernelFma3Block<3>(A, lda, RowIndices, Values, BlockCount, C, ldc, CountN, alpha);
+        return 3;
+    }
+
+    MlasSparseGemmFloatKernelFma3Block<1>(A, lda, RowIndices, Values, BlockCount, C, ldc, CountN, alpha);
+    return 1;
+}
@@ -0,0 +1,239 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements routines to compute the statistics of a row and to
+    normalize a row for the layer normalization family of operators.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasComputeMeanAndMeanSquare(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    float* Output,
+    size_t N,
+    float* Mean,
+    float* MeanSquare
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the mean and the mean of the squares of a row in a
+    single pass.
+
+    If a skip or a bias buffer is supplied, the statistics are computed over
+    the element wise sum of the input, skip, and bias buffers and the sum is
+    stored to the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Skip - Optionally supplies a buffer to add to the input buffer.
+
+    Bias - Optionally supplies a buffer to add to the input buffer.
+
+    Output - Supplies the output buffer to receive the element wise sum. This
+        buffer is only accessed if a skip or a bias buffer is supplied.
+
+    N - Supplies the number of elements to process.
+
+    Mean - Receives the mean of the elements.
+
+    MeanSquare - Receives the mean of the squares of the elements.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const bool StoreOutput = (Skip != nullptr || Bias != nullptr);
+    const size_t Count = N;
+
+    MLAS_FLOAT32X4 Sum0 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 Sum1 = Sum0;
+    MLAS_FLOAT32X4 SumSquare0 = Sum0;
+    MLAS_FLOAT32X4 SumSquare1 = Sum0;
+
+    while (N >= 8) {
+
+        MLAS_FLOAT32X4 Value0 = MlasLoadFloat32x4(Input);
+        MLAS_FLOAT32X4 Value1 = MlasLoadFloat32x4(Input + 4);
+
+        if (Skip != nullptr) {
+            Value0 = MlasAddFloat32x4(Value0, MlasLoadFloat32x4(Skip));
+            Value1 = MlasAddFloat32x4(Value1, MlasLoadFloat32x4(Skip + 4));
+            Skip += 8;
+        }
+
+        if (Bias != nullptr) {
+            Value0 = MlasAddFloat32x4(Value0, MlasLoadFloat32x4(Bias));
+            Value1 = MlasAddFloat32x4(Value1, MlasLoadFloat32x4(Bias + 4));
+            Bias += 8;
+        }
+
+        if (StoreOutput) {
+            MlasStoreFloat32x4(Output, Value0);
+            MlasStoreFloat32x4(Output + 4, Value1);
+            Output += 8;
+        }
+
+        Sum0 = MlasAddFloat32x4(Sum0, Value0);
+        Sum1 = MlasAddFloat32x4(Sum1, Value1);
+        SumSquare0 = MlasMultiplyAddFloat32x4(Value0, Value0, SumSquare0);
+        SumSquare1 = MlasMultiplyAddFloat32x4(Value1, Value1, SumSquare1);
+
+        Input += 8;
+        N -= 8;
+    }
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 Value = MlasLoadFloat32x4(Input);
+
+        if (Skip != nullptr) {
+            Value = MlasAddFloat32x4(Value, MlasLoadFloat32x4(Skip));
+            Skip += 4;
+        }
+
+        if (Bias != nullptr) {
+            Value = MlasAddFloat32x4(Value, MlasLoadFloat32x4(Bias));
+            Bias += 4;
+        }
+
+        if (StoreOutput) {
+            MlasStoreFloat32x4(Output, Value);
+            Output += 4;
+        }
+
+        Sum0 = MlasAddFloat32x4(Sum0, Value);
+        SumSquare0 = MlasMultiplyAddFloat32x4(Value, Value, SumSquare0);
+
+        Input += 4;
+        N -= 4;
+    }
+
+    float Sum = MlasReduceAddFloat32x4(MlasAddFloat32x4(Sum0, Sum1));
+    float SumSquare = MlasReduceAddFloat32x4(MlasAddFloat32x4(SumSquare0, SumSquare1));
+
+    while (N > 0) {
+
+        float Value = *Input++;
+
+        if (Skip != nullptr) {
+            Value += *Skip++;
+        }
+
+        if (Bias != nullptr) {
+            Value += *Bias++;
+        }
+
+        if (StoreOutput) {
+            *Output++ = Value;
+        }
+
+        Sum += Value;
+        SumSquare += Value * Value;
+
+        N -= 1;
+    }
+
+    *Mean = Sum / float(Count);
+    *MeanSquare = SumSquare / float(Count);
+}
+
+void
+MLASCALL
+MlasComputeNormalizeScaleShift(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float Mean,
+    float InverseStdDev,
+    const float* Scale,
+    const float* Shift
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes a row using the supplied mean and inverse standard
+    deviation and then applies a per element scale and an optional per element
+    shift.
+
+        Output = (Input - Mean) * InverseStdDev * Scale + Shift
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer. The output buffer may be the same as
+        the input buffer.
+
+    N - Supplies the number of elements to process.
+
+    Mean - Supplies the mean to subtract from each element.
+
+    InverseStdDev - Supplies the inverse of the standard deviation.
+
+    Scale - Supplies the per element scale.
+
+    Shift - Optionally supplies the per element shift.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 MeanVector = MlasBroadcastFloat32x4(Mean);
+    const MLAS_FLOAT32X4 InverseStdDevVector = MlasBroadcastFloat32x4(InverseStdDev);
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Value = MlasSubtractFloat32x4(MlasLoadFloat32x4(Input), MeanVector);
+        Value = MlasMultiplyFloat32x4(Value, InverseStdDevVector);
+
+        if (Shift != nullptr) {
+            Value = MlasMultiplyAddFloat32x4(Value, MlasLoadFloat32x4(Scale), MlasLoadFloat32x4(Shift));
+            Shift += 4;
+        } else {
+            Value = MlasMultiplyFloat32x4(Value, MlasLoadFloat32x4(Scale));
+        }
+
+        MlasStoreFloat32x4(Output, Value);
+
+        Input += 4;
+        Output += 4;
+        Scale += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        float Value = (*Input++ - Mean) * InverseStdDev * *Scale++;
+
+        if (Shift != nullptr) {
+            Value += *Shift++;
+        }
+
+        *Output++ = Value;
+
+        N -= 1;
+    }
+}
@@ -401,6 +401,26 @@ void
 
 typedef MLAS_COMPUTE_UNARY_FLOAT_KERNEL* PMLAS_COMPUTE_UNARY_FLOAT_KERNEL;
 
+typedef
+void
+(MLASCALL MLAS_CONVERT_HALF_TO_FLOAT_KERNEL)(
+    const MLAS_FP16* Source,
+    float* Destination,
+    size_t Count
+    );
+
+typedef MLAS_CONVERT_HALF_TO_FLOAT_KERNEL* PMLAS_CONVERT_HALF_TO_FLOAT_KERNEL;
+
+typedef
+void
+(MLASCALL MLAS_CONVERT_FLOAT_TO_HALF_KERNEL)(
+    const float* Source,
+    MLAS_FP16* Destination,
+    size_t Count
+    );
+
+typedef MLAS_CONVERT_FLOAT_TO_HALF_KERNEL* PMLAS_CONVERT_FLOAT_TO_HALF_KERNEL;
+
 typedef
 float
 (MLASCALL MLAS_COMPUTE_SUMEXP_FLOAT_KERNEL)(
@@ -453,6 +473,40 @@ void
 
 typedef MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL* PMLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL;
 
+typedef
+size_t
+(MLASCALL MLAS_SPARSE_GEMM_FLOAT_KERNEL)(
+    const float* A,
+    size_t lda,
+    const uint32_t* RowIndices,
+    const float* Values,
+    size_t BlockCount,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    float alpha
+    );
+
+typedef MLAS_SPARSE_GEMM_FLOAT_KERNEL* PMLAS_SPARSE_GEMM_FLOAT_KERNEL;
+
+typedef
+void
+(MLASCALL MLAS_BLOCK_QUANT_GEMV_KERNEL)(
+    const float* A,
+    const uint8_t* QuantB,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlockCountK,
+    size_t BlkBits,
+    size_t BlkLen
+    );
+
+typedef MLAS_BLOCK_QUANT_GEMV_KERNEL* PMLAS_BLOCK_QUANT_GEMV_KERNEL;
+
 typedef
 void
 (MLASCALL MLAS_QLINEAR_BINARY_OP_S8_KERNEL)(
@@ -602,6 +656,23 @@ extern "C" {
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL MlasReduceMinimumMaximumF32KernelAvx;
 #endif
 
+    MLAS_SPARSE_GEMM_FLOAT_KERNEL MlasSparseGemmFloatKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_SPARSE_GEMM_FLOAT_KERNEL MlasSparseGemmFloatKernelFma3;
+#endif
+
+    MLAS_BLOCK_QUANT_GEMV_KERNEL MlasBlockQuantGemvKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_BLOCK_QUANT_GEMV_KERNEL MlasBlockQuantGemvKernelAvx2;
+#endif
+
+    MLAS_CONVERT_HALF_TO_FLOAT_KERNEL MlasConvertHalfToFloatKernel;
+    MLAS_CONVERT_FLOAT_TO_HALF_KERNEL MlasConvertFloatToHalfKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_CONVERT_HALF_TO_FLOAT_KERNEL MlasConvertHalfToFloatKernelF16C;
+    MLAS_CONVERT_FLOAT_TO_HALF_KERNEL MlasConvertFloatToHalfKernelF16C;
+#endif
+
 }
 
 //
@@ -651,6 +722,28 @@ MlasSgemmOperation(
     size_t ldc
     );
 
+//
+// Single-threaded single precision matrix/matrix multiply operation using a
+// matrix B packed by MlasGemmPackB.
+//
+
+void
+MlasSgemmPackedOperation(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t RangeStartN,
+    size_t RangeCountN,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    size_t AlignedN,
+    float beta,
+    float* C,
+    size_t ldc
+    );
+
 //
 // Quantized integer matrix/matrix multiply operation.
 //
@@ -658,6 +751,8 @@ MlasSgemmOperation(
 struct MLAS_GEMM_U8X8_KERNEL_SSE;
 struct MLAS_GEMM_U8S8_KERNEL_AVX2;
 struct MLAS_GEMM_U8U8_KERNEL_AVX2;
+struct MLAS_GEMM_U8X8_KERNEL_NEON;
+struct MLAS_GEMM_U8X8_KERNEL_UDOT;
 
 template<typename KernelType>
 void
@@ -713,9 +808,18 @@ struct MLAS_PLATFORM {
     PMLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL ComputeLogSoftmaxOutputF32Kernel;
     PMLAS_REDUCE_MAXIMUM_FLOAT_KERNEL ReduceMaximumF32Kernel;
     PMLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL ReduceMinimumMaximumF32Kernel;
+    PMLAS_SPARSE_GEMM_FLOAT_KERNEL SparseGemmFloatKernel;
+    PMLAS_BLOCK_QUANT_GEMV_KERNEL BlockQuantGemvKernel;
+    PMLAS_CONVERT_HALF_TO_FLOAT_KERNEL ConvertHalfToFloatKernel;
+    PMLAS_CONVERT_FLOAT_TO_HALF_KERNEL ConvertFloatToHalfKernel;
     uint32_t NchwcBlockSize;
     uint32_t PreferredBufferAlignment;
 #endif
+
+#if defined(MLAS_TARGET_ARM64)
+    PMLAS_GEMM_U8X8_OPERATION GemmU8X8Operation;
+    PMLAS_GEMM_U8X8_OPERATION GemmU8X8PackedOperation;
+#endif
 };
 
 extern MLAS_PLATFORM MlasPlatform;
@@ -823,6 +927,98 @@ MlasFp32FromBits(
     return u.FloatValue;
 }
 
+//
+// Define the conversions between single precision and the half precision
+// types. Conversions to the half precision types round to nearest even.
+//
+
+template<typename T>
+struct MLAS_HALF_CONVERT;
+
+template<>
+struct MLAS_HALF_CONVERT<MLAS_FP16>
+{
+    static
+    MLAS_FORCEINLINE
+    float
+    ToFloat(
+        MLAS_FP16 Value
+        )
+    {
+        const uint32_t ShiftedExponent = 0x7C00 << 13;
+        uint32_t Bits = uint32_t(Value.val & 0x7FFF) << 13;
+        const uint32_t Exponent = Bits & ShiftedExponent;
+
+        Bits += (127 - 15) << 23;
+
+        if (Exponent == ShiftedExponent) {
+            Bits += (128 - 16) << 23;
+        } else if (Exponent == 0) {
+            Bits += 1 << 23;
+            Bits = MlasBitsOfFp32(MlasFp32FromBits(Bits) - MlasFp32FromBits(113 << 23));
+        }
+
+        return MlasFp32FromBits(Bits | (uint32_t(Value.val & 0x8000) << 16));
+    }
+
+    static
+    MLAS_FORCEINLINE
+    MLAS_FP16
+    FromFloat(
+        float Value
+        )
+    {
+        uint32_t Bits = MlasBitsOfFp32(Value);
+        const uint32_t Sign = Bits & 0x80000000;
+        uint16_t Half;
+
+        Bits ^= Sign;
+
+        if (Bits >= ((127 + 16) << 23)) {
+            Half = (Bits > (255 << 23)) ? 0x7E00 : 0x7C00;
+        } else if (Bits < (113 << 23)) {
+            const uint32_t DenormMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+            Half = uint16_t(MlasBitsOfFp32(MlasFp32FromBits(Bits) + MlasFp32FromBits(DenormMagic)) - DenormMagic);
+        } else {
+            const uint32_t MantissaOdd = (Bits >> 13) & 1;
+            Bits += (uint32_t(15 - 127) << 23) + 0xFFF + MantissaOdd;
+            Half = uint16_t(Bits >> 13);
+        }
+
+        return MLAS_FP16{uint16_t(Half | (Sign >> 16))};
+    }
+};
+
+template<>
+struct MLAS_HALF_CONVERT<MLAS_BF16>
+{
+    static
+    MLAS_FORCEINLINE
+    float
+    ToFloat(
+        MLAS_BF16 Value
+        )
+    {
+        return MlasFp32FromBits(uint32_t(Value.val) << 16);
+    }
+
+    static
+    MLAS_FORCEINLINE
+    MLAS_BF16
+    FromFloat(
+        float Value
+        )
+    {
+        const uint32_t Bits = MlasBitsOfFp32(Value);
+
+        if ((Bits & 0x7FFFFFFF) > 0x7F800000) {
+            return MLAS_BF16{uint16_t((Bits >> 16) | 0x0040)};
+        }
+
+        return MLAS_BF16{uint16_t((Bits + 0x7FFF + ((Bits >> 16) & 1)) >> 16)};
+    }
+};
+
 //
 // Define the missing ARM64 NEON intrinsic macros from arm64_neon.h that enable
 // cross-compiler support.
@@ -849,6 +1045,9 @@ MlasFp32FromBits(
 #elif defined(MLAS_TARGET_ARM64)
 #define MLAS_NEON_INTRINSICS
 #define MLAS_NEON64_INTRINSICS
+#if defined(__linux__) && !defined(MLAS_UDOT_UNSUPPORTED)
+#define MLAS_UDOT_INTRINSICS
+#endif
 #elif defined(MLAS_TARGET_POWER)
 #define MLAS_VSX_INTRINSICS
 #elif defined(MLAS_TARGET_AMD64_IX86)
@@ -17,6 +17,11 @@ Abstract:
 
 #include "mlasi.h"
 
+#if defined(MLAS_UDOT_INTRINSICS)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
 //
 // Stores the platform information.
 //
@@ -138,6 +143,10 @@ Return Value:
     this->ComputeLogSoftmaxOutputF32Kernel = MlasComputeLogSoftmaxOutputF32Kernel;
     this->ReduceMaximumF32Kernel = MlasReduceMaximumF32Kernel;
     this->ReduceMinimumMaximumF32Kernel = MlasReduceMinimumMaximumF32Kernel;
+    this->SparseGemmFloatKernel = MlasSparseGemmFloatKernel;
+    this->BlockQuantGemvKernel = MlasBlockQuantGemvKernel;
+    this->ConvertHalfToFloatKernel = MlasConvertHalfToFloatKernel;
+    this->ConvertFloatToHalfKernel = MlasConvertFloatToHalfKernel;
     this->QLinearAddS8Kernel = MlasQLinearAddS8Kernel;
     this->QLinearAddU8Kernel = MlasQLinearAddU8Kernel;
 
@@ -221,6 +230,18 @@ Return Value:
                 this->QLinearAddS8Kernel = MlasQLinearAddS8KernelAvx2;
                 this->QLinearAddU8Kernel = MlasQLinearAddU8KernelAvx2;
                 this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelFma3;
+                this->SparseGemmFloatKernel = MlasSparseGemmFloatKernelFma3;
+                this->BlockQuantGemvKernel = MlasBlockQuantGemvKernelAvx2;
+
+                //
+                // Check if the processor supports the F16C feature.
+                //
+
+                if ((Cpuid1[2] & 0x20000000) != 0) {
+
+                    this->ConvertHalfToFloatKernel = MlasConvertHalfToFloatKernelF16C;
+                    this->ConvertFloatToHalfKernel = MlasConvertFloatToHalfKernelF16C;
+                }
                 
                 //
                 // Check if the processor supports AVXVNNI features.
@@ -305,6 +326,35 @@ Return Value:
 
 #endif // MLAS_TARGET_AMD64_IX86
 
+#if defined(MLAS_TARGET_ARM64)
+
+    //
+    // Default to the baseline NEON support.
+    //
+
+    this->GemmU8X8Operation = MlasGemmU8X8Operation<MLAS_GEMM_U8X8_KERNEL_NEON>;
+    this->GemmU8X8PackedOperation = MlasGemmU8X8PackedOperation<MLAS_GEMM_U8X8_KERNEL_NEON>;
+
+#if defined(MLAS_UDOT_INTRINSICS)
+
+#if !defined(HWCAP_ASIMDDP)
+#define HWCAP_ASIMDDP (1 << 20)
+#endif
+
+    //
+    // Check if the processor supports the ARMv8.2 dot product instructions.
+    //
+
+    if ((getauxval(AT_HWCAP) & HWCAP_ASIMDDP) != 0) {
+
+        this->GemmU8X8Operation = MlasGemmU8X8Operation<MLAS_GEMM_U8X8_KERNEL_UDOT>;
+        this->GemmU8X8PackedOperation = MlasGemmU8X8PackedOperation<MLAS_GEMM_U8X8_KERNEL_UDOT>;
+    }
+
+#endif // MLAS_UDOT_INTRINSICS
+
+#endif // MLAS_TARGET_ARM64
+
 }
 
 size_t
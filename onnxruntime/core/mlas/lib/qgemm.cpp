@@ -40,6 +40,8 @@ struct MLAS_GEMM_U8X8_WORK_BLOCK {
     size_t ldc;
     uint8_t offa;
     uint8_t offb;
+    const uint8_t* ZeroPointB;
+    bool AIsSigned;
     bool BIsPacked;
     bool BIsSigned;
     const MLAS_QGEMM_OUTPUT_PROCESSOR* OutputProcessor;
@@ -80,6 +82,152 @@ MlasGemmU8X8ScaleSumBuffer(
     return MlasGemmU8X8ScaleSumBuffer(SumBuffer, SumBuffer, N, Scale);
 }
 
+void
+MlasGemmU8X8CopySignedA(
+    uint8_t* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine copies a panel of signed matrix A to unsigned data by flipping
+    the sign bit, i.e. adding 128 to each element, so that the panel can be
+    packed by the U8X8 kernels. The zero point offset of matrix A is shifted in
+    the same way, so the products of the offset values are unchanged.
+
+Arguments:
+
+    D - Supplies the address of the destination buffer, with CountK elements
+        per row.
+
+    A - Supplies the address of the source matrix.
+
+    lda - Supplies the number of elements per row of the source matrix.
+
+    CountM - Supplies the number of rows to copy.
+
+    CountK - Supplies the number of columns to copy.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (CountM-- > 0) {
+
+        for (size_t k = 0; k < CountK; k++) {
+            D[k] = uint8_t(A[k] ^ 0x80);
+        }
+
+        D += CountK;
+        A += lda;
+    }
+}
+
+template<typename KernelType>
+MLAS_FORCEINLINE
+void
+MlasGemmU8X8FixupZeroPointBPerColumn(
+    int32_t* ZeroPointBBuffer,
+    int32_t* ColumnSumBuffer,
+    const uint8_t* ZeroPointB,
+    size_t CountN,
+    int32_t DepthScale,
+    bool BIsSigned
+    )
+/*++
+
+Routine Description:
+
+    This routine converts the zero point offsets of a panel of columns of
+    matrix B to the format of the kernel implementation, and adds the products
+    of the offset values of matrix A and matrix B to the column sums.
+
+Arguments:
+
+    ZeroPointBBuffer - Supplies the address of the buffer to receive the zero
+        point offsets.
+
+    ColumnSumBuffer - Supplies the address of the column sums.
+
+    ZeroPointB - Supplies the zero point offsets of the columns.
+
+    CountN - Supplies the number of columns.
+
+    DepthScale - Supplies the number of rows of the panel times the zero point
+        offset of matrix A.
+
+    BIsSigned - Supplies true if matrix B is signed data.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t n = 0; n < CountN; n++) {
+        const int32_t offb = KernelType::FixupZeroPointB(
+            typename KernelType::OffsetBType(ZeroPointB[n]), BIsSigned);
+        ZeroPointBBuffer[n] = offb;
+        ColumnSumBuffer[n] += DepthScale * offb;
+    }
+}
+
+void
+MlasGemmU8X8SubtractRowSumsPerColumn(
+    int32_t* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    const int32_t* RowSumBuffer,
+    const int32_t* ZeroPointBBuffer
+    )
+/*++
+
+Routine Description:
+
+    This routine subtracts the sums of the rows of matrix A times the zero
+    point offsets of the columns of matrix B from a block of matrix C, which
+    the kernels can't do as they only add a value per row and per column.
+
+Arguments:
+
+    C - Supplies the address of the block of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountM - Supplies the number of rows of the block.
+
+    CountN - Supplies the number of columns of the block.
+
+    RowSumBuffer - Supplies the sums of the rows of the panel of matrix A.
+
+    ZeroPointBBuffer - Supplies the zero point offsets of the columns, as
+        converted by MlasGemmU8X8FixupZeroPointBPerColumn.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (CountM-- > 0) {
+
+        const int32_t RowSum = *RowSumBuffer++;
+
+        for (size_t n = 0; n < CountN; n++) {
+            C[n] -= RowSum * ZeroPointBBuffer[n];
+        }
+
+        C += ldc;
+    }
+}
+
 template<typename KernelType>
 void
 MLASCALL
@@ -108,8 +256,12 @@ Return Value:
     MLAS_DECLSPEC_ALIGN(typename KernelType::PackedAType PanelA[Strides.M * Strides.K], 64);
     MLAS_DECLSPEC_ALIGN(typename KernelType::PackedBType PanelB[Strides.N * Strides.K], 64);
 
+    MLAS_DECLSPEC_ALIGN(uint8_t PanelAUnsigned[Strides.M * Strides.K], 64);
+
     MLAS_DECLSPEC_ALIGN(int32_t RowSumBuffer[Strides.M], 64);
     MLAS_DECLSPEC_ALIGN(int32_t ColumnSumBuffer[Strides.N], 64);
+    MLAS_DECLSPEC_ALIGN(int32_t ZeroPointBBuffer[Strides.N], 64);
+    MLAS_DECLSPEC_ALIGN(int32_t ZeroRowSumBuffer[Strides.M], 64);
 
     const size_t M = WorkBlock->RangeCountM;
     const size_t N = WorkBlock->RangeCountN;
@@ -126,11 +278,15 @@ Return Value:
     int32_t offa = WorkBlock->offa;
     int32_t offb = typename KernelType::OffsetBType(WorkBlock->offb);
 
+    const uint8_t* ZeroPointB = WorkBlock->ZeroPointB;
+    const bool AIsSigned = WorkBlock->AIsSigned;
+
     //
     // Try to use a GEMV kernel if supported by this kernel type.
     //
 
-    if ((M == 1) && (offa == 0) && (offb == 0) && WorkBlock->OutputProcessor == nullptr) {
+    if ((M == 1) && (offa == 0) && (offb == 0) && !WorkBlock->AIsSigned &&
+        WorkBlock->ZeroPointB == nullptr && WorkBlock->OutputProcessor == nullptr) {
         if (KernelType::TryGemvKernel(A, B, ldb, C, K, N, WorkBlock->BIsSigned)) {
             return;
         }
@@ -143,6 +299,27 @@ Return Value:
 
     offb = KernelType::FixupZeroPointB(offb, WorkBlock->BIsSigned);
 
+    //
+    // Flip the sign bit of the zero point offset of matrix A if the data is
+    // signed, as the panels of matrix A are flipped before packing. The
+    // products of the offset values are unchanged.
+    //
+
+    if (AIsSigned) {
+        offa = uint8_t(offa ^ 0x80);
+    }
+
+    //
+    // With per-column zero point offsets of matrix B, the product of the row
+    // sums and the column offsets is applied after the kernel, which is given
+    // zero row sums.
+    //
+
+    if (ZeroPointB != nullptr) {
+        ZeroPointB += WorkBlock->RangeStartN;
+        std::fill_n(ZeroRowSumBuffer, Strides.M, 0);
+    }
+
     //
     // Step through each slice of matrix B along the K dimension.
     //
@@ -172,11 +349,18 @@ Return Value:
 
             MlasGemmU8X8ScaleSumBuffer(ColumnSumBuffer, CountN, -offa);
 
+            if (ZeroPointB != nullptr) {
+                MlasGemmU8X8FixupZeroPointBPerColumn<KernelType>(ZeroPointBBuffer,
+                    ColumnSumBuffer, ZeroPointB + n, CountN, int32_t(CountK) * offa,
+                    WorkBlock->BIsSigned);
+            }
+
             //
             // Step through each slice of matrix A along the M dimension.
             //
 
-            const int32_t DepthValue = int32_t(CountK) * offa * offb;
+            const int32_t DepthValue =
+                (ZeroPointB != nullptr) ? 0 : int32_t(CountK) * offa * offb;
             const size_t PackedCountK = (CountK + KernelType::PackedK - 1) /
                 KernelType::PackedK;
 
@@ -191,10 +375,21 @@ Return Value:
                 // Copy a panel of matrix A to a local packed buffer.
                 //
 
-                KernelType::CopyPackA(PanelA, A + m * lda, lda, CountM, CountK,
+                const uint8_t* a = A + m * lda;
+                size_t lda_panel = lda;
+
+                if (AIsSigned) {
+                    MlasGemmU8X8CopySignedA(PanelAUnsigned, a, lda, CountM, CountK);
+                    a = PanelAUnsigned;
+                    lda_panel = CountK;
+                }
+
+                KernelType::CopyPackA(PanelA, a, lda_panel, CountM, CountK,
                     RowSumBuffer);
 
-                MlasGemmU8X8ScaleSumBuffer(RowSumBuffer, CountM, -offb);
+                if (ZeroPointB == nullptr) {
+                    MlasGemmU8X8ScaleSumBuffer(RowSumBuffer, CountM, -offb);
+                }
 
                 //
                 // Step through the rows of the local packed buffer.
@@ -212,8 +407,14 @@ Return Value:
                     size_t RowsHandled;
 
                     RowsHandled = KernelType::GemmKernel(pa, PanelB, c, PackedCountK,
-                        RowsRemaining, CountN, ldc, RowSums, ColumnSumBuffer,
-                        DepthValue, ZeroMode);
+                        RowsRemaining, CountN, ldc,
+                        (ZeroPointB != nullptr) ? ZeroRowSumBuffer : RowSums,
+                        ColumnSumBuffer, DepthValue, ZeroMode);
+
+                    if (ZeroPointB != nullptr) {
+                        MlasGemmU8X8SubtractRowSumsPerColumn(c, ldc, RowsHandled,
+                            CountN, RowSums, ZeroPointBBuffer);
+                    }
 
                     if (PostProcess && WorkBlock->OutputProcessor != nullptr) {
                         WorkBlock->OutputProcessor->Process(WorkBlock->C,
@@ -264,8 +465,12 @@ Return Value:
 
     MLAS_DECLSPEC_ALIGN(typename KernelType::PackedAType PanelA[Strides.M * Strides.K], 64);
 
+    MLAS_DECLSPEC_ALIGN(uint8_t PanelAUnsigned[Strides.M * Strides.K], 64);
+
     MLAS_DECLSPEC_ALIGN(int32_t RowSumBuffer[Strides.M], 64);
     MLAS_DECLSPEC_ALIGN(int32_t ColumnSumBuffer[Strides.N], 64);
+    MLAS_DECLSPEC_ALIGN(int32_t ZeroPointBBuffer[Strides.N], 64);
+    MLAS_DECLSPEC_ALIGN(int32_t ZeroRowSumBuffer[Strides.M], 64);
 
     const size_t M = WorkBlock->RangeCountM;
     const size_t N = WorkBlock->RangeCountN;
@@ -281,6 +486,9 @@ Return Value:
     int32_t offa = WorkBlock->offa;
     int32_t offb = typename KernelType::OffsetBType(WorkBlock->offb);
 
+    const uint8_t* ZeroPointB = WorkBlock->ZeroPointB;
+    const bool AIsSigned = WorkBlock->AIsSigned;
+
     //
     // Flip the sign bit of the zero point offset of matrix B if the data is
     // the opposite format of the kernel implementation.
@@ -288,6 +496,27 @@ Return Value:
 
     offb = KernelType::FixupZeroPointB(offb, WorkBlock->BIsSigned);
 
+    //
+    // Flip the sign bit of the zero point offset of matrix A if the data is
+    // signed, as the panels of matrix A are flipped before packing. The
+    // products of the offset values are unchanged.
+    //
+
+    if (AIsSigned) {
+        offa = uint8_t(offa ^ 0x80);
+    }
+
+    //
+    // With per-column zero point offsets of matrix B, the product of the row
+    // sums and the column offsets is applied after the kernel, which is given
+    // zero row sums.
+    //
+
+    if (ZeroPointB != nullptr) {
+        ZeroPointB += WorkBlock->RangeStartN;
+        std::fill_n(ZeroRowSumBuffer, Strides.M, 0);
+    }
+
     //
     // Extract the pointer to the column sum buffer from the packed matrix.
     //
@@ -330,11 +559,18 @@ Return Value:
                     CountN, -offa);
             }
 
+            if (ZeroPointB != nullptr) {
+                MlasGemmU8X8FixupZeroPointBPerColumn<KernelType>(ZeroPointBBuffer,
+                    ColumnSumBuffer, ZeroPointB + n, CountN,
+                    (k == 0) ? int32_t(K) * offa : 0, WorkBlock->BIsSigned);
+            }
+
             //
             // Step through each slice of matrix A along the M dimension.
             //
 
-            const int32_t DepthValue = int32_t(CountK) * offa * offb;
+            const int32_t DepthValue =
+                (ZeroPointB != nullptr) ? 0 : int32_t(CountK) * offa * offb;
             const uint8_t* b = PackedB + (WorkBlock->RangeStartN + n) *
                 KernelType::PackedK * PackedCountK;
             int32_t* c = C + n;
@@ -348,10 +584,21 @@ Return Value:
                 // Copy a panel of matrix A to a local packed buffer.
                 //
 
-                KernelType::CopyPackA(PanelA, A + m * lda, lda, CountM, CountK,
+                const uint8_t* a = A + m * lda;
+                size_t lda_panel = lda;
+
+                if (AIsSigned) {
+                    MlasGemmU8X8CopySignedA(PanelAUnsigned, a, lda, CountM, CountK);
+                    a = PanelAUnsigned;
+                    lda_panel = CountK;
+                }
+
+                KernelType::CopyPackA(PanelA, a, lda_panel, CountM, CountK,
                     RowSumBuffer);
 
-                MlasGemmU8X8ScaleSumBuffer(RowSumBuffer, CountM, -offb);
+                if (ZeroPointB == nullptr) {
+                    MlasGemmU8X8ScaleSumBuffer(RowSumBuffer, CountM, -offb);
+                }
 
                 //
                 // Step through the rows of the local packed buffer.
@@ -369,8 +616,14 @@ Return Value:
                     size_t RowsHandled;
 
                     RowsHandled = KernelType::GemmKernel(pa, b, c, PackedCountK,
-                        RowsRemaining, CountN, ldc, RowSums, ColumnSumBuffer,
-                        DepthValue, ZeroMode);
+                        RowsRemaining, CountN, ldc,
+                        (ZeroPointB != nullptr) ? ZeroRowSumBuffer : RowSums,
+                        ColumnSumBuffer, DepthValue, ZeroMode);
+
+                    if (ZeroPointB != nullptr) {
+                        MlasGemmU8X8SubtractRowSumsPerColumn(c, ldc, RowsHandled,
+                            CountN, RowSums, ZeroPointBBuffer);
+                    }
 
                     if (PostProcess && WorkBlock->OutputProcessor != nullptr) {
                         WorkBlock->OutputProcessor->Process(
@@ -1928,6 +2181,319 @@ constexpr size_t MLAS_GEMM_U8X8_KERNEL_NEON::PackedK;
 constexpr MLAS_GEMM_U8X8_STRIDES MLAS_GEMM_U8X8_KERNEL_NEON::Strides;
 constexpr MLAS_GEMM_U8X8_STRIDES MLAS_GEMM_U8X8_KERNEL_NEON::PackedStrides;
 
+#if defined(MLAS_TARGET_ARM64)
+
+template
+void
+MlasGemmU8X8Operation<MLAS_GEMM_U8X8_KERNEL_NEON>(
+    const MLAS_GEMM_U8X8_WORK_BLOCK* WorkBlock
+    );
+
+template
+void
+MlasGemmU8X8PackedOperation<MLAS_GEMM_U8X8_KERNEL_NEON>(
+    const MLAS_GEMM_U8X8_WORK_BLOCK* WorkBlock
+    );
+
+#endif
+
+#if defined(MLAS_UDOT_INTRINSICS)
+
+//
+// Define the prototypes of the dot product routines built with the ARMv8.2
+// dot product extension enabled.
+//
+
+size_t
+MLASCALL
+MlasGemmU8X8KernelUdot(
+    const uint8_t* A,
+    const uint8_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumVector,
+    const int32_t* ColumnSumVector,
+    int32_t DepthValue,
+    bool ZeroMode
+    );
+
+MLAS_FORCEINLINE
+void
+MlasGemmU8X8CopyPackBProcessUdot(
+    uint8_t* D,
+    const uint8_t* b,
+    size_t ldb,
+    uint8x16_t BitFlipVector,
+    uint32x4_t ColumnSums[4]
+    )
+{
+    uint8x16_t BytesRow0 = veorq_u8(vld1q_u8(b), BitFlipVector);
+    uint8x16_t BytesRow1 = veorq_u8(vld1q_u8(b + ldb), BitFlipVector);
+    uint8x16_t BytesRow2 = veorq_u8(vld1q_u8(b + ldb * 2), BitFlipVector);
+    uint8x16_t BytesRow3 = veorq_u8(vld1q_u8(b + ldb * 3), BitFlipVector);
+
+    //
+    // Transpose the four rows so that each 32-bit element holds the four
+    // values along the K dimension for a single column.
+    //
+
+    uint16x8_t Zip01Low = vreinterpretq_u16_u8(vzip1q_u8(BytesRow0, BytesRow1));
+    uint16x8_t Zip01High = vreinterpretq_u16_u8(vzip2q_u8(BytesRow0, BytesRow1));
+    uint16x8_t Zip23Low = vreinterpretq_u16_u8(vzip1q_u8(BytesRow2, BytesRow3));
+    uint16x8_t Zip23High = vreinterpretq_u16_u8(vzip2q_u8(BytesRow2, BytesRow3));
+
+    vst1q_u8(&D[0], vreinterpretq_u8_u16(vzip1q_u16(Zip01Low, Zip23Low)));
+    vst1q_u8(&D[16], vreinterpretq_u8_u16(vzip2q_u16(Zip01Low, Zip23Low)));
+    vst1q_u8(&D[32], vreinterpretq_u8_u16(vzip1q_u16(Zip01High, Zip23High)));
+    vst1q_u8(&D[48], vreinterpretq_u8_u16(vzip2q_u16(Zip01High, Zip23High)));
+
+    uint16x8_t WordsLow = vaddq_u16(vaddl_u8(vget_low_u8(BytesRow0), vget_low_u8(BytesRow1)),
+        vaddl_u8(vget_low_u8(BytesRow2), vget_low_u8(BytesRow3)));
+    uint16x8_t WordsHigh = vaddq_u16(vaddl_high_u8(BytesRow0, BytesRow1),
+        vaddl_high_u8(BytesRow2, BytesRow3));
+
+    ColumnSums[0] = vaddw_u16(ColumnSums[0], vget_low_u16(WordsLow));
+    ColumnSums[1] = vaddw_high_u16(ColumnSums[1], WordsLow);
+    ColumnSums[2] = vaddw_u16(ColumnSums[2], vget_low_u16(WordsHigh));
+    ColumnSums[3] = vaddw_high_u16(ColumnSums[3], WordsHigh);
+}
+
+void
+MLASCALL
+MlasGemmU8X8CopyPackBUdot(
+    uint8_t* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer,
+    bool BIsSigned
+    )
+/*++
+
+Routine Description:
+
+    This routine copies elements from the source matrix to the destination
+    packed buffer.
+
+Arguments:
+
+    D - Supplies the address of the destination packed buffer.
+
+    B - Supplies the address of the source matrix.
+
+    ldb - Supplies the number of elements per row of the source matrix.
+
+    CountN - Supplies the number of columns of the source matrix to copy.
+
+    CountK - Supplies the number of rows of the source matrix to copy.
+
+    ColumnSumBuffer - Supplies the address of the buffer to receive the sums of
+        the elements along each of the columns.
+
+    BIsSigned - Supplies true if the source matrix is signed data, else false
+        if the source matrix is unsigned data.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const uint8_t BitFlipValue = (BIsSigned ? 0x80 : 0);
+    const uint8x16_t BitFlipVector = vdupq_n_u8(BitFlipValue);
+
+    //
+    // Process 16 columns of matrix B in a loop.
+    //
+    // The buffer is packed as a series of 64 byte blocks where each group of
+    // four bytes holds four rows of a single column:
+    //
+    //      [ A0 B0 C0 D0 A1 B1 C1 D1 ... A15 B15 C15 D15 ]
+    //
+    // This pattern is repeated (CountK / 4) times.
+    //
+    // Signed buffers are converted to unsigned buffers in order to share a
+    // common kernel. Partial blocks of columns or rows are copied through a
+    // buffer filled with the bit flip value so that the padding is zero after
+    // the conversion.
+    //
+
+    while (CountN > 0) {
+
+        const size_t CountNThisBlock = std::min(CountN, size_t(16));
+        const uint8_t* b = B;
+        size_t k = CountK;
+        uint32x4_t ColumnSums[4];
+
+        for (size_t j = 0; j < 4; j++) {
+            ColumnSums[j] = vmovq_n_u32(0);
+        }
+
+        if (CountNThisBlock == 16) {
+
+            while (k >= 4) {
+
+                MlasGemmU8X8CopyPackBProcessUdot(D, b, ldb, BitFlipVector, ColumnSums);
+
+                b += ldb * 4;
+                D += 64;
+                k -= 4;
+            }
+        }
+
+        while (k > 0) {
+
+            uint8_t PaddedMatrixBData[64];
+            const size_t CountKThisBlock = std::min(k, size_t(4));
+
+            std::fill_n(PaddedMatrixBData, sizeof(PaddedMatrixBData), BitFlipValue);
+
+            for (size_t kk = 0; kk < CountKThisBlock; kk++) {
+                std::copy_n(b + kk * ldb, CountNThisBlock, &PaddedMatrixBData[kk * 16]);
+            }
+
+            MlasGemmU8X8CopyPackBProcessUdot(D, PaddedMatrixBData, 16, BitFlipVector, ColumnSums);
+
+            b += ldb * CountKThisBlock;
+            D += 64;
+            k -= CountKThisBlock;
+        }
+
+        for (size_t j = 0; j < 4; j++) {
+            vst1q_s32(&ColumnSumBuffer[j * 4], vreinterpretq_s32_u32(ColumnSums[j]));
+        }
+
+        ColumnSumBuffer += 16;
+        B += CountNThisBlock;
+        CountN -= CountNThisBlock;
+    }
+}
+
+struct MLAS_GEMM_U8X8_KERNEL_UDOT
+{
+    typedef uint8_t PackedAType;
+    typedef uint8_t PackedBType;
+    typedef uint8_t OffsetBType;
+
+    static constexpr size_t PackedK = 4;
+    static constexpr MLAS_GEMM_U8X8_STRIDES Strides{24, 128, 256};
+    static constexpr MLAS_GEMM_U8X8_STRIDES PackedStrides{24, 256, 128};
+
+    MLAS_FORCEINLINE
+    static
+    bool
+    TryGemvKernel(
+        const uint8_t* A,
+        const uint8_t* B,
+        size_t ldb,
+        int32_t* C,
+        size_t CountK,
+        size_t CountN,
+        bool BIsSigned
+        )
+    {
+        MLAS_UNREFERENCED_PARAMETER(A);
+        MLAS_UNREFERENCED_PARAMETER(B);
+        MLAS_UNREFERENCED_PARAMETER(ldb);
+        MLAS_UNREFERENCED_PARAMETER(C);
+        MLAS_UNREFERENCED_PARAMETER(CountK);
+        MLAS_UNREFERENCED_PARAMETER(CountN);
+        MLAS_UNREFERENCED_PARAMETER(BIsSigned);
+
+        return false;
+    }
+
+    MLAS_FORCEINLINE
+    static
+    int32_t
+    FixupZeroPointB(
+        int32_t offb,
+        bool BIsSigned
+        )
+    {
+        if (BIsSigned) {
+            offb = OffsetBType(offb ^ 0x80);
+        }
+
+        return offb;
+    }
+
+    MLAS_FORCEINLINE
+    static
+    void
+    CopyPackA(
+        PackedAType* D,
+        const uint8_t* A,
+        size_t lda,
+        size_t CountM,
+        size_t CountK,
+        int32_t* RowSumBuffer
+        )
+    {
+        MlasGemmU8X8CopyPackANeon(D, A, lda, CountM, CountK, RowSumBuffer);
+    }
+
+    MLAS_FORCEINLINE
+    static
+    void
+    CopyPackB(
+        PackedBType* D,
+        const uint8_t* B,
+        size_t ldb,
+        size_t CountN,
+        size_t CountK,
+        int32_t* ColumnSumBuffer,
+        bool BIsSigned
+        )
+    {
+        MlasGemmU8X8CopyPackBUdot(D, B, ldb, CountN, CountK, ColumnSumBuffer,
+            BIsSigned);
+    }
+
+    MLAS_FORCEINLINE
+    static
+    size_t
+    GemmKernel(
+        const PackedAType* A,
+        const PackedBType* B,
+        int32_t* C,
+        size_t PackedCountK,
+        size_t CountM,
+        size_t CountN,
+        size_t ldc,
+        const int32_t* RowSumBuffer,
+        const int32_t* ColumnSumBuffer,
+        int32_t DepthValue,
+        bool ZeroMode
+        )
+    {
+        return MlasGemmU8X8KernelUdot(A, B, C, PackedCountK, CountM, CountN, ldc,
+            RowSumBuffer, ColumnSumBuffer, DepthValue, ZeroMode);
+    }
+};
+
+constexpr size_t MLAS_GEMM_U8X8_KERNEL_UDOT::PackedK;
+constexpr MLAS_GEMM_U8X8_STRIDES MLAS_GEMM_U8X8_KERNEL_UDOT::Strides;
+constexpr MLAS_GEMM_U8X8_STRIDES MLAS_GEMM_U8X8_KERNEL_UDOT::PackedStrides;
+
+template
+void
+MlasGemmU8X8Operation<MLAS_GEMM_U8X8_KERNEL_UDOT>(
+    const MLAS_GEMM_U8X8_WORK_BLOCK* WorkBlock
+    );
+
+template
+void
+MlasGemmU8X8PackedOperation<MLAS_GEMM_U8X8_KERNEL_UDOT>(
+    const MLAS_GEMM_U8X8_WORK_BLOCK* WorkBlock
+    );
+
+#endif
+
 #endif
 
 struct MLAS_GEMM_U8X8_KERNEL_DEFAULT
@@ -2195,7 +2761,13 @@ Return Value:
     GemmU8X8Operation(&WorkBlock);
 #elif defined(MLAS_SSE2_INTRINSICS)
     MlasGemmU8X8Operation<MLAS_GEMM_U8X8_KERNEL_SSE>(&WorkBlock);
-#elif defined(MLAS_NEON64_INTRINSICS) || (defined(MLAS_NEON32_INTRINSICS) && !defined(_MSC_VER))
+#elif defined(MLAS_TARGET_ARM64)
+    if (WorkBlock.BIsPacked) {
+        MlasPlatform.GemmU8X8PackedOperation(&WorkBlock);
+    } else {
+        MlasPlatform.GemmU8X8Operation(&WorkBlock);
+    }
+#elif defined(MLAS_NEON32_INTRINSICS) && !defined(_MSC_VER)
     if (WorkBlock.BIsPacked) {
         MlasGemmU8X8PackedOperation<MLAS_GEMM_U8X8_KERNEL_NEON>(&WorkBlock);
     } else {
@@ -2381,6 +2953,75 @@ Return Value:
     MlasGemmU8X8Schedule(&WorkBlock, ThreadPool);
 }
 
+void
+MLASCALL
+MlasGemm(
+    const MLAS_GEMM_U8X8_PARAMETERS& Parameters,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the quantized integer matrix/matrix multiply
+    operation (QGEMM), with optional per-column zero point offsets of matrix B
+    and signed data in matrix A.
+
+Arguments:
+
+    Parameters - Supplies the structure containing the GEMM parameters.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_GEMM_U8X8_WORK_BLOCK WorkBlock;
+
+#ifndef MLAS_SUPPORTS_PACKED_GEMM_U8X8
+    if (Parameters.BIsPacked) {
+#ifdef MLAS_NO_EXCEPTION
+        abort();
+#else
+        throw std::runtime_error("packing unavailable");
+#endif
+    }
+#endif
+
+    //
+    // Capture the GEMM parameters to the work block.
+    //
+
+    memset(&WorkBlock, 0, sizeof(MLAS_GEMM_U8X8_WORK_BLOCK));
+
+    WorkBlock.M = Parameters.M;
+    WorkBlock.N = Parameters.N;
+    WorkBlock.K = Parameters.K;
+    WorkBlock.A = Parameters.A;
+    WorkBlock.lda = Parameters.lda;
+    WorkBlock.B = Parameters.B;
+    WorkBlock.ldb = Parameters.ldb;
+    WorkBlock.C = Parameters.C;
+    WorkBlock.ldc = Parameters.ldc;
+    WorkBlock.OutputProcessor = Parameters.OutputProcessor;
+    WorkBlock.offa = Parameters.ZeroPointA;
+    WorkBlock.offb = Parameters.ZeroPointB;
+    WorkBlock.ZeroPointB = Parameters.PerColumnZeroPointB;
+    WorkBlock.AIsSigned = Parameters.AIsSigned;
+    WorkBlock.BIsPacked = Parameters.BIsPacked;
+    WorkBlock.BIsSigned = Parameters.BIsSigned;
+
+    //
+    // Schedule the operation across a set of worker threads.
+    //
+
+    MlasGemmU8X8Schedule(&WorkBlock, ThreadPool);
+}
+
 #ifdef MLAS_SUPPORTS_PACKED_GEMM_U8X8
 
 void
@@ -2522,6 +3163,11 @@ Return Value:
 #elif defined(MLAS_NEON_INTRINSICS)
     MLAS_UNREFERENCED_PARAMETER(BIsSigned);
 
+#if defined(MLAS_UDOT_INTRINSICS)
+    if (MlasPlatform.GemmU8X8PackedOperation == &MlasGemmU8X8PackedOperation<MLAS_GEMM_U8X8_KERNEL_UDOT>) {
+        PackedK = MLAS_GEMM_U8X8_KERNEL_UDOT::PackedK;
+    } else
+#endif
     PackedK = MLAS_GEMM_U8X8_KERNEL_NEON::PackedK;
 #else
 #error Unknown architecture.
@@ -2607,8 +3253,19 @@ Return Value:
 #endif
     }
 #elif defined(MLAS_NEON_INTRINSICS)
-    PackedK = MLAS_GEMM_U8X8_KERNEL_NEON::PackedK;
-    StrideK = MLAS_GEMM_U8X8_KERNEL_NEON::PackedStrides.K;
+#if defined(MLAS_UDOT_INTRINSICS)
+    const bool UseUdotKernel =
+        (MlasPlatform.GemmU8X8PackedOperation == &MlasGemmU8X8PackedOperation<MLAS_GEMM_U8X8_KERNEL_UDOT>);
+
+    if (UseUdotKernel) {
+        PackedK = MLAS_GEMM_U8X8_KERNEL_UDOT::PackedK;
+        StrideK = MLAS_GEMM_U8X8_KERNEL_UDOT::PackedStrides.K;
+    } else
+#endif
+    {
+        PackedK = MLAS_GEMM_U8X8_KERNEL_NEON::PackedK;
+        StrideK = MLAS_GEMM_U8X8_KERNEL_NEON::PackedStrides.K;
+    }
 #else
 #error Unknown architecture.
 #endif
@@ -2657,6 +3314,11 @@ Return Value:
                 MLAS_GEMM_U8U8_KERNEL_AVX2::CopyPackB(pb, B + n, ldb, CountN, CountK, ColumnSumBuffer, BIsSigned);
             }
 #elif defined(MLAS_NEON_INTRINSICS)
+#if defined(MLAS_UDOT_INTRINSICS)
+            if (UseUdotKernel) {
+                MLAS_GEMM_U8X8_KERNEL_UDOT::CopyPackB(pb, B + n, ldb, CountN, CountK, ColumnSumBuffer, BIsSigned);
+            } else
+#endif
             MLAS_GEMM_U8X8_KERNEL_NEON::CopyPackB(pb, B + n, ldb, CountN, CountK, ColumnSumBuffer, BIsSigned);
 #else
 #error Unknown architecture.
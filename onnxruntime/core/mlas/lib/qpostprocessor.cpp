@@ -10,7 +10,7 @@ Module Name:
 
 Abstract:
 
-    This module implements the post processor for QGEMM.
+    This module implements the post processors for QGEMM.
 
 --*/
 
@@ -236,3 +236,59 @@ Return Value:
         Output += LeadingDimensionOutput_;
     }
 }
+
+void
+MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR::Process(
+    const int32_t* C,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    ) const
+/*++
+
+Routine Description:
+
+    This routine requantizes a block of the output matrix C to the uint8
+    output buffer using the stored bias, scale and zero point parameters.
+
+Arguments:
+
+    C - Supplies the address of matrix C.
+
+    StartM - Supplies the starting row offset relative to the matrix.
+
+    StartN - Supplies the starting column offset relative to the matrix.
+
+    CountM - Supplies the number of rows of the output matrix to process.
+
+    CountN - Supplies the number of columns of the output matrix to process.
+
+    ldc - Supplies the leading dimension of C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const int32_t* Bias = (Bias_ != nullptr) ? Bias_ + StartN : nullptr;
+    const float* Scale = PerColumnScale_ ? Scale_ + StartN : Scale_;
+
+    C += StartM * ldc + StartN;
+    uint8_t* Output = Output_ + StartM * LeadingDimensionOutput_ + StartN;
+
+    //
+    // The rows of the block are not contiguous, so requantize one row at a
+    // time.
+    //
+
+    while (CountM-- > 0) {
+
+        MlasRequantizeOutput(C, Output, Bias, 1, CountN, Scale, PerColumnScale_, ZeroPoint_);
+
+        C += ldc;
+        Output += LeadingDimensionOutput_;
+    }
+}
@@ -0,0 +1,401 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce.cpp
+
+Abstract:
+
+    This module implements routines to reduce floating point tensors along
+    a single contiguous or strided axis.
+
+    The reductions supported are sum, mean, maximum, and minimum. Callers
+    collapse the dimensions of the source tensor so that the reduction is
+    either along the innermost axis (each row is reduced to a single value)
+    or along an outer axis (each column is reduced to a single value).
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the parameters to execute a sum or mean reduction.
+//
+
+struct MLAS_REDUCE_SUM
+{
+    static float InitialValue() { return 0.0f; }
+
+    static MLAS_FLOAT32X4 Reduce(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+    {
+        return MlasAddFloat32x4(Vector1, Vector2);
+    }
+
+    static float Reduce(float Value1, float Value2)
+    {
+        return Value1 + Value2;
+    }
+
+    static float ReduceVector(MLAS_FLOAT32X4 Vector)
+    {
+        return MlasReduceAddFloat32x4(Vector);
+    }
+};
+
+//
+// Define the parameters to execute a maximum reduction.
+//
+
+struct MLAS_REDUCE_MAXIMUM
+{
+    static float InitialValue() { return -std::numeric_limits<float>::infinity(); }
+
+    static MLAS_FLOAT32X4 Reduce(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+    {
+        return MlasMaximumFloat32x4(Vector1, Vector2);
+    }
+
+    static float Reduce(float Value1, float Value2)
+    {
+        return std::max(Value1, Value2);
+    }
+
+    static float ReduceVector(MLAS_FLOAT32X4 Vector)
+    {
+        return MlasReduceMaximumFloat32x4(Vector);
+    }
+};
+
+//
+// Define the parameters to execute a minimum reduction.
+//
+
+struct MLAS_REDUCE_MINIMUM
+{
+    static float InitialValue() { return std::numeric_limits<float>::infinity(); }
+
+    static MLAS_FLOAT32X4 Reduce(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+    {
+        return MlasMinimumFloat32x4(Vector1, Vector2);
+    }
+
+    static float Reduce(float Value1, float Value2)
+    {
+        return std::min(Value1, Value2);
+    }
+
+    static float ReduceVector(MLAS_FLOAT32X4 Vector)
+    {
+        return MlasReduceMinimumFloat32x4(Vector);
+    }
+};
+
+template<typename ReduceOp>
+MLAS_FORCEINLINE
+float
+MlasReduceInnerAxisRow(
+    const float* Input,
+    size_t CountReduce
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces a contiguous row of elements to a single value.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    CountReduce - Supplies the number of elements to reduce.
+
+Return Value:
+
+    Returns the reduced value.
+
+--*/
+{
+    float Value = ReduceOp::InitialValue();
+
+    if (CountReduce >= 4) {
+
+        MLAS_FLOAT32X4 Accumulator0 = MlasBroadcastFloat32x4(Value);
+
+        if (CountReduce >= 16) {
+
+            MLAS_FLOAT32X4 Accumulator1 = Accumulator0;
+            MLAS_FLOAT32X4 Accumulator2 = Accumulator0;
+            MLAS_FLOAT32X4 Accumulator3 = Accumulator0;
+
+            while (CountReduce >= 16) {
+
+                Accumulator0 = ReduceOp::Reduce(Accumulator0, MlasLoadFloat32x4(Input));
+                Accumulator1 = ReduceOp::Reduce(Accumulator1, MlasLoadFloat32x4(Input + 4));
+                Accumulator2 = ReduceOp::Reduce(Accumulator2, MlasLoadFloat32x4(Input + 8));
+                Accumulator3 = ReduceOp::Reduce(Accumulator3, MlasLoadFloat32x4(Input + 12));
+
+                Input += 16;
+                CountReduce -= 16;
+            }
+
+            Accumulator0 = ReduceOp::Reduce(Accumulator0, Accumulator1);
+            Accumulator2 = ReduceOp::Reduce(Accumulator2, Accumulator3);
+            Accumulator0 = ReduceOp::Reduce(Accumulator0, Accumulator2);
+        }
+
+        while (CountReduce >= 4) {
+
+            Accumulator0 = ReduceOp::Reduce(Accumulator0, MlasLoadFloat32x4(Input));
+
+            Input += 4;
+            CountReduce -= 4;
+        }
+
+        Value = ReduceOp::ReduceVector(Accumulator0);
+    }
+
+    while (CountReduce > 0) {
+
+        Value = ReduceOp::Reduce(Value, *Input++);
+        CountReduce -= 1;
+    }
+
+    return Value;
+}
+
+template<typename ReduceOp>
+void
+MlasReduceInnerAxisKernel(
+    const float* Input,
+    float* Output,
+    size_t CountOuter,
+    size_t CountReduce,
+    float Scale
+    )
+{
+    while (CountOuter-- > 0) {
+
+        *Output++ = MlasReduceInnerAxisRow<ReduceOp>(Input, CountReduce) * Scale;
+
+        Input += CountReduce;
+    }
+}
+
+template<typename ReduceOp>
+void
+MlasReduceOuterAxisKernel(
+    const float* Input,
+    float* Output,
+    size_t CountReduce,
+    size_t CountInner,
+    size_t ldInput,
+    float Scale
+    )
+{
+    const MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+
+    //
+    // Reduce blocks of 16 columns at a time so that the accumulators stay in
+    // registers while walking down the rows of the input.
+    //
+
+    while (CountInner >= 16) {
+
+        MLAS_FLOAT32X4 Accumulator0 = MlasBroadcastFloat32x4(ReduceOp::InitialValue());
+        MLAS_FLOAT32X4 Accumulator1 = Accumulator0;
+        MLAS_FLOAT32X4 Accumulator2 = Accumulator0;
+        MLAS_FLOAT32X4 Accumulator3 = Accumulator0;
+
+        const float* input = Input;
+
+        for (size_t r = 0; r < CountReduce; r++) {
+
+            Accumulator0 = ReduceOp::Reduce(Accumulator0, MlasLoadFloat32x4(input));
+            Accumulator1 = ReduceOp::Reduce(Accumulator1, MlasLoadFloat32x4(input + 4));
+            Accumulator2 = ReduceOp::Reduce(Accumulator2, MlasLoadFloat32x4(input + 8));
+            Accumulator3 = ReduceOp::Reduce(Accumulator3, MlasLoadFloat32x4(input + 12));
+
+            input += ldInput;
+        }
+
+        MlasStoreFloat32x4(Output, MlasMultiplyFloat32x4(Accumulator0, ScaleVector));
+        MlasStoreFloat32x4(Output + 4, MlasMultiplyFloat32x4(Accumulator1, ScaleVector));
+        MlasStoreFloat32x4(Output + 8, MlasMultiplyFloat32x4(Accumulator2, ScaleVector));
+        MlasStoreFloat32x4(Output + 12, MlasMultiplyFloat32x4(Accumulator3, ScaleVector));
+
+        Input += 16;
+        Output += 16;
+        CountInner -= 16;
+    }
+
+    while (CountInner >= 4) {
+
+        MLAS_FLOAT32X4 Accumulator = MlasBroadcastFloat32x4(ReduceOp::InitialValue());
+
+        const float* input = Input;
+
+        for (size_t r = 0; r < CountReduce; r++) {
+            Accumulator = ReduceOp::Reduce(Accumulator, MlasLoadFloat32x4(input));
+            input += ldInput;
+        }
+
+        MlasStoreFloat32x4(Output, MlasMultiplyFloat32x4(Accumulator, ScaleVector));
+
+        Input += 4;
+        Output += 4;
+        CountInner -= 4;
+    }
+
+    while (CountInner > 0) {
+
+        float Value = ReduceOp::InitialValue();
+
+        const float* input = Input;
+
+        for (size_t r = 0; r < CountReduce; r++) {
+            Value = ReduceOp::Reduce(Value, *input);
+            input += ldInput;
+        }
+
+        *Output++ = Value * Scale;
+
+        Input += 1;
+        CountInner -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasReduceInnerAxis(
+    MLAS_REDUCTION_KIND ReductionKind,
+    const float* Input,
+    float* Output,
+    size_t CountOuter,
+    size_t CountReduce
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces each contiguous row of the input buffer to a single
+    value.
+
+Arguments:
+
+    ReductionKind - Supplies the kind of reduction operation.
+
+    Input - Supplies the input buffer. The buffer contains CountOuter rows of
+        CountReduce elements.
+
+    Output - Supplies the output buffer. The buffer receives CountOuter
+        elements.
+
+    CountOuter - Supplies the number of rows to reduce.
+
+    CountReduce - Supplies the number of elements in each row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (ReductionKind) {
+
+        case MlasSumReduction:
+        {
+            MlasReduceInnerAxisKernel<MLAS_REDUCE_SUM>(Input, Output, CountOuter, CountReduce, 1.0f);
+            break;
+        }
+
+        case MlasMeanReduction:
+        {
+            MlasReduceInnerAxisKernel<MLAS_REDUCE_SUM>(Input, Output, CountOuter, CountReduce,
+                1.0f / float(CountReduce));
+            break;
+        }
+
+        case MlasMaximumReduction:
+        {
+            MlasReduceInnerAxisKernel<MLAS_REDUCE_MAXIMUM>(Input, Output, CountOuter, CountReduce, 1.0f);
+            break;
+        }
+
+        case MlasMinimumReduction:
+        {
+            MlasReduceInnerAxisKernel<MLAS_REDUCE_MINIMUM>(Input, Output, CountOuter, CountReduce, 1.0f);
+            break;
+        }
+    }
+}
+
+void
+MLASCALL
+MlasReduceOuterAxis(
+    MLAS_REDUCTION_KIND ReductionKind,
+    const float* Input,
+    float* Output,
+    size_t CountReduce,
+    size_t CountInner,
+    size_t ldInput
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces each column of the input buffer to a single value.
+
+Arguments:
+
+    ReductionKind - Supplies the kind of reduction operation.
+
+    Input - Supplies the input buffer. The buffer contains CountReduce rows of
+        CountInner elements with a stride of ldInput elements between rows.
+
+    Output - Supplies the output buffer. The buffer receives CountInner
+        elements.
+
+    CountReduce - Supplies the number of rows to reduce.
+
+    CountInner - Supplies the number of columns to reduce.
+
+    ldInput - Supplies the first dimension of the input buffer.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (ReductionKind) {
+
+        case MlasSumReduction:
+        {
+            MlasReduceOuterAxisKernel<MLAS_REDUCE_SUM>(Input, Output, CountReduce, CountInner, ldInput, 1.0f);
+            break;
+        }
+
+        case MlasMeanReduction:
+        {
+            MlasReduceOuterAxisKernel<MLAS_REDUCE_SUM>(Input, Output, CountReduce, CountInner, ldInput,
+                1.0f / float(CountReduce));
+            break;
+        }
+
+        case MlasMaximumReduction:
+        {
+            MlasReduceOuterAxisKernel<MLAS_REDUCE_MAXIMUM>(Input, Output, CountReduce, CountInner, ldInput, 1.0f);
+            break;
+        }
+
+        case MlasMinimumReduction:
+        {
+            MlasReduceOuterAxisKernel<MLAS_REDUCE_MINIMUM>(Input, Output, CountReduce, CountInner, ldInput, 1.0f);
+            break;
+        }
+    }
+}
@@ -39,15 +39,7 @@ struct MLAS_SGEMM_WORK_BLOCK {
     size_t M;
     size_t N;
     size_t K;
-    const float* A;
-    size_t lda;
-    const void* B;
-    size_t ldb;
-    float* C;
-    size_t ldc;
-    float alpha;
-    float beta;
-    bool BIsPacked;
+    const MLAS_SGEMM_DATA_PARAMS* Data;
 };
 
 void
@@ -1232,6 +1224,15 @@ Return Value:
     const int32_t ThreadCountM = WorkBlock->ThreadCountM;
     const int32_t ThreadCountN = WorkBlock->ThreadCountN;
 
+    //
+    // Select the matrix multiply of the batch for this thread.
+    //
+
+    const int32_t ThreadsPerGemm = ThreadCountM * ThreadCountN;
+    const MLAS_SGEMM_DATA_PARAMS* Data = &WorkBlock->Data[ThreadId / ThreadsPerGemm];
+
+    ThreadId %= ThreadsPerGemm;
+
     const int32_t ThreadIdM = ThreadId / ThreadCountN;
     const int32_t ThreadIdN = ThreadId % ThreadCountN;
 
@@ -1270,47 +1271,50 @@ Return Value:
 
     CBLAS_TRANSPOSE TransA = WorkBlock->TransA;
 
-    const size_t lda = WorkBlock->lda;
-    const size_t ldc = WorkBlock->ldc;
+    const size_t lda = Data->lda;
+    const size_t ldc = Data->ldc;
 
-    const float* A = WorkBlock->A + RangeStartM * ((TransA == CblasNoTrans) ? lda : 1);
-    float* C = WorkBlock->C + RangeStartM * ldc + RangeStartN;
+    const float* A = Data->A + RangeStartM * ((TransA == CblasNoTrans) ? lda : 1);
+    float* C = Data->C + RangeStartM * ldc + RangeStartN;
 
-    if (WorkBlock->BIsPacked) {
+    if (Data->BIsPacked) {
 
         MlasSgemmPackedOperation(TransA, RangeCountM, RangeStartN, RangeCountN,
-            WorkBlock->K, WorkBlock->alpha, A, lda, WorkBlock->B,
-            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, WorkBlock->beta, C, ldc);
+            WorkBlock->K, Data->alpha, A, lda, Data->B,
+            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, Data->beta, C, ldc);
 
     } else {
 
         CBLAS_TRANSPOSE TransB = WorkBlock->TransB;
 
-        const size_t ldb = WorkBlock->ldb;
+        const size_t ldb = Data->ldb;
 
-        const float* B = (const float*)WorkBlock->B + RangeStartN * ((TransB == CblasNoTrans) ? 1 : ldb);
+        const float* B = (const float*)Data->B + RangeStartN * ((TransB == CblasNoTrans) ? 1 : ldb);
 
         MlasSgemmOperation(TransA, TransB, RangeCountM, RangeCountN, WorkBlock->K,
-            WorkBlock->alpha, A, lda, B, ldb, WorkBlock->beta, C, ldc);
+            Data->alpha, A, lda, B, ldb, Data->beta, C, ldc);
     }
 }
 
 void
 MlasSgemmSchedule(
     MLAS_SGEMM_WORK_BLOCK* WorkBlock,
+    size_t BatchSize,
     MLAS_THREADPOOL* ThreadPool
     )
 /*++
 
 Routine Description:
 
-    This routine schedules the single precision matrix/matrix multiply
-    operation (SGEMM) across one or more threads.
+    This routine schedules a batch of single precision matrix/matrix multiply
+    operations (SGEMM) across one or more threads.
 
 Arguments:
 
     WorkBlock - Supplies the structure containing the GEMM parameters.
 
+    BatchSize - Supplies the number of matrix multiplies in the batch.
+
     ThreadPool - Supplies the thread pool object to use, else nullptr if the
         base library threading support should be used.
 
@@ -1325,11 +1329,11 @@ Return Value:
     const size_t K = WorkBlock->K;
 
     //
-    // Compute the number of target threads given the complexity of the SGEMM
-    // operation. Small requests should run using the single threaded path.
+    // Compute the number of target threads given the complexity of the whole
+    // batch. Small requests should run using the single threaded path.
     //
 
-    const double Complexity = double(M) * double(N) * double(K);
+    const double Complexity = double(M) * double(N) * double(K) * double(BatchSize);
 
     int32_t TargetThreadCount;
 
@@ -1346,35 +1350,39 @@ Return Value:
     }
 
     //
-    // Segment the operation across multiple threads.
+    // Distribute the threads over the batch. Each matrix multiply is then
+    // segmented across its share of the threads.
     //
-    // N.B. Currently, the operation is segmented as a 1D partition, which
-    // works okay for operations involving skinny matrices.
+    // N.B. Currently, each matrix multiply is segmented as a 1D partition,
+    // which works okay for operations involving skinny matrices.
     //
 
+    int32_t ThreadsPerGemm = int32_t((size_t(TargetThreadCount) + BatchSize - 1) / BatchSize);
+
     if (N > M) {
 
         const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
             MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
 
-        if (size_t(TargetThreadCount) > BlockedN) {
-            TargetThreadCount = int32_t(BlockedN);
+        if (size_t(ThreadsPerGemm) > BlockedN) {
+            ThreadsPerGemm = int32_t(BlockedN);
         }
 
         WorkBlock->ThreadCountM = 1;
-        WorkBlock->ThreadCountN = TargetThreadCount;
+        WorkBlock->ThreadCountN = ThreadsPerGemm;
 
     } else {
 
-        if (size_t(TargetThreadCount) > M) {
-            TargetThreadCount = int32_t(M);
+        if (size_t(ThreadsPerGemm) > M) {
+            ThreadsPerGemm = int32_t(M);
         }
 
-        WorkBlock->ThreadCountM = TargetThreadCount;
+        WorkBlock->ThreadCountM = ThreadsPerGemm;
         WorkBlock->ThreadCountN = 1;
     }
 
-    MlasExecuteThreaded(MlasSgemmThreaded, WorkBlock, TargetThreadCount, ThreadPool);
+    MlasExecuteThreaded(MlasSgemmThreaded, WorkBlock,
+        int32_t(ThreadsPerGemm * BatchSize), ThreadPool);
 }
 
 void
@@ -1440,33 +1448,18 @@ Return Value:
 
 --*/
 {
-    MLAS_SGEMM_WORK_BLOCK WorkBlock;
-
-    //
-    // Capture the GEMM parameters to the work block.
-    //
-
-    memset(&WorkBlock, 0, sizeof(MLAS_SGEMM_WORK_BLOCK));
-
-    WorkBlock.TransA = TransA;
-    WorkBlock.TransB = TransB;
-    WorkBlock.M = M;
-    WorkBlock.N = N;
-    WorkBlock.K = K;
-    WorkBlock.A = A;
-    WorkBlock.lda = lda;
-    WorkBlock.B = B;
-    WorkBlock.ldb = ldb;
-    WorkBlock.C = C;
-    WorkBlock.ldc = ldc;
-    WorkBlock.alpha = alpha;
-    WorkBlock.beta = beta;
-
-    //
-    // Schedule the operation across a set of worker threads.
-    //
-
-    MlasSgemmSchedule(&WorkBlock, ThreadPool);
+    MLAS_SGEMM_DATA_PARAMS Data;
+
+    Data.A = A;
+    Data.lda = lda;
+    Data.B = B;
+    Data.ldb = ldb;
+    Data.C = C;
+    Data.ldc = ldc;
+    Data.alpha = alpha;
+    Data.beta = beta;
+
+    MlasGemmBatch(TransA, TransB, M, N, K, &Data, 1, ThreadPool);
 }
 
 void
@@ -1526,6 +1519,71 @@ Return Value:
 
 --*/
 {
+    MLAS_SGEMM_DATA_PARAMS Data;
+
+    Data.A = A;
+    Data.lda = lda;
+    Data.B = PackedB;
+    Data.C = C;
+    Data.ldc = ldc;
+    Data.alpha = alpha;
+    Data.beta = beta;
+    Data.BIsPacked = true;
+
+    MlasGemmBatch(TransA, CblasNoTrans, M, N, K, &Data, 1, ThreadPool);
+}
+
+void
+MLASCALL
+MlasGemmBatch(
+    CBLAS_TRANSPOSE TransA,
+    CBLAS_TRANSPOSE TransB,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements a batch of single precision matrix/matrix multiply
+    operations (SGEMM) that share the same shape. The work for the whole batch
+    is partitioned across the thread pool in a single dispatch.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    TransB - Supplies the transpose operation for matrix B. This is ignored
+        for the matrix multiplies that use a packed matrix B.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    Data - Supplies the array of matrix multiply parameters.
+
+    BatchSize - Supplies the number of elements in the Data array.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (BatchSize == 0) {
+        return;
+    }
+
     MLAS_SGEMM_WORK_BLOCK WorkBlock;
 
     //
@@ -1535,23 +1593,17 @@ Return Value:
     memset(&WorkBlock, 0, sizeof(MLAS_SGEMM_WORK_BLOCK));
 
     WorkBlock.TransA = TransA;
+    WorkBlock.TransB = TransB;
     WorkBlock.M = M;
     WorkBlock.N = N;
     WorkBlock.K = K;
-    WorkBlock.A = A;
-    WorkBlock.lda = lda;
-    WorkBlock.B = PackedB;
-    WorkBlock.C = C;
-    WorkBlock.ldc = ldc;
-    WorkBlock.alpha = alpha;
-    WorkBlock.beta = beta;
-    WorkBlock.BIsPacked = true;
+    WorkBlock.Data = Data;
 
     //
     // Schedule the operation across a set of worker threads.
     //
 
-    MlasSgemmSchedule(&WorkBlock, ThreadPool);
+    MlasSgemmSchedule(&WorkBlock, BatchSize, ThreadPool);
 }
 
 size_t
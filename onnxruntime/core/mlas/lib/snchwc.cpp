@@ -1115,6 +1115,19 @@ struct MLAS_NCHWC_POOL_ALGORITHM : MLAS_NCHWC_NN_ALGORITHM
 
         MlasPartitionWork(Index, WorkBlock->tids, TotalWork, &WorkIndex, &WorkRemaining);
 
+        //
+        // Global pooling reduces each channel block of the input image in
+        // memory order instead of going through the windowed pooling kernel.
+        //
+
+        if (KernelHeight == InputHeight && KernelWidth == InputWidth && OutputSize == 1 &&
+            WorkBlock->Padding[0] == 0 && WorkBlock->Padding[1] == 0 &&
+            WorkBlock->Padding[2] == 0 && WorkBlock->Padding[3] == 0) {
+
+            ExecuteGlobal(WorkIndex, WorkRemaining);
+            return;
+        }
+
         size_t ph = WorkIndex % OutputHeight;
         const size_t BatchChannel = WorkIndex / OutputHeight;
 
@@ -1195,6 +1208,70 @@ struct MLAS_NCHWC_POOL_ALGORITHM : MLAS_NCHWC_NN_ALGORITHM
             }
         }
     }
+
+    void ExecuteGlobal(size_t WorkIndex, size_t WorkRemaining)
+    {
+        static constexpr size_t MaximumBlockSize = 16;
+
+        const float* Input = WorkBlock->Input + WorkIndex * BlockSize * InputSize;
+        float* Output = WorkBlock->Output + WorkIndex * BlockSize;
+
+        const bool IsMaximumPooling = (WorkBlock->PoolingKind == MlasMaximumPooling);
+        const MLAS_FLOAT32X4 InputSizeBroadcast = MlasBroadcastFloat32x4(float(InputSize));
+
+        //
+        // Each work item is a channel block of an image. The reduction of each
+        // vector of the block runs in the order of the input elements, so the
+        // average matches a sum followed by a division.
+        //
+
+        while (WorkRemaining > 0) {
+
+            MLAS_FLOAT32X4 Reduction[MaximumBlockSize / 4];
+
+            for (size_t bc = 0; bc < BlockSize; bc += 4) {
+                Reduction[bc / 4] = MlasLoadFloat32x4(Input + bc);
+            }
+
+            const float* input = Input + BlockSize;
+
+            if (IsMaximumPooling) {
+
+                for (size_t i = 1; i < InputSize; i++) {
+
+                    for (size_t bc = 0; bc < BlockSize; bc += 4) {
+                        Reduction[bc / 4] = MlasMaximumFloat32x4(Reduction[bc / 4], MlasLoadFloat32x4(input + bc));
+                    }
+
+                    input += BlockSize;
+                }
+
+            } else {
+
+                for (size_t i = 1; i < InputSize; i++) {
+
+                    for (size_t bc = 0; bc < BlockSize; bc += 4) {
+                        Reduction[bc / 4] = MlasAddFloat32x4(Reduction[bc / 4], MlasLoadFloat32x4(input + bc));
+                    }
+
+                    input += BlockSize;
+                }
+
+                for (size_t bc = 0; bc < BlockSize; bc += 4) {
+                    Reduction[bc / 4] = MlasDivideFloat32x4(Reduction[bc / 4], InputSizeBroadcast);
+                }
+            }
+
+            for (size_t bc = 0; bc < BlockSize; bc += 4) {
+                MlasStoreFloat32x4(Output + bc, Reduction[bc / 4]);
+            }
+
+            Input += BlockSize * InputSize;
+            Output += BlockSize;
+
+            WorkRemaining -= 1;
+        }
+    }
 };
 
 #if !defined(MLAS_TARGET_AMD64)
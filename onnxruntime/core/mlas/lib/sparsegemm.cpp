@@ -0,0 +1,631 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparsegemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation (SGEMM) for a block sparse matrix B.
+
+    Matrix B is packed into a compressed sparse column layout where each
+    block is one row along the K dimension by 16 columns along the N
+    dimension. Blocks that only contain zeros are dropped, so the kernel only
+    does work proportional to the number of non-zero blocks. This layout
+    suits weights that have been pruned with a block structure.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Define the number of columns from matrix B in a sparse block.
+//
+
+#define MLAS_SPARSE_SGEMM_BLOCK_N           16
+
+//
+// Define the alignment of the block values in the packed buffer so that each
+// block occupies a single cache line.
+//
+
+#define MLAS_SPARSE_SGEMM_VALUES_ALIGNMENT  64
+
+//
+// Define the header of a packed sparse matrix B buffer. The header is
+// followed by the array of column block offsets, the array of row indices for
+// each non-zero block, and the aligned array of block values.
+//
+
+struct MLAS_SPARSE_SGEMM_PACKED_HEADER {
+    size_t N;
+    size_t K;
+    size_t BlockCountN;
+    size_t NonZeroBlockCount;
+};
+
+//
+// Define the minimum number of multiply/accumulate operations to assign to a
+// thread.
+//
+
+#define MLAS_SPARSE_SGEMM_THREAD_COMPLEXITY (size_t(64) * size_t(1024))
+
+MLAS_FORCEINLINE
+size_t
+MlasSparseGemmValuesOffset(
+    size_t BlockCountN,
+    size_t NonZeroBlockCount
+    )
+{
+    size_t Offset = sizeof(MLAS_SPARSE_SGEMM_PACKED_HEADER) +
+        (BlockCountN + 1 + NonZeroBlockCount) * sizeof(uint32_t);
+
+    return (Offset + MLAS_SPARSE_SGEMM_VALUES_ALIGNMENT - 1) & ~size_t(MLAS_SPARSE_SGEMM_VALUES_ALIGNMENT - 1);
+}
+
+MLAS_FORCEINLINE
+float
+MlasSparseGemmLoadB(
+    CBLAS_TRANSPOSE TransB,
+    const float* B,
+    size_t ldb,
+    size_t k,
+    size_t n
+    )
+{
+    return (TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k];
+}
+
+size_t
+MLASCALL
+MlasGemmPackSparseBSize(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the length in bytes for the packed sparse matrix B
+    buffer. The matrix is scanned to count the number of non-zero blocks.
+
+Arguments:
+
+    TransB - Supplies the transpose operation on B matrix
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+Return Value:
+
+    Returns the size in bytes for the packed sparse matrix B buffer, or zero
+    if the matrix is too large to be represented.
+
+--*/
+{
+    if (N == 0 || K == 0 || K > std::numeric_limits<uint32_t>::max()) {
+        return 0;
+    }
+
+    const size_t BlockCountN = (N + MLAS_SPARSE_SGEMM_BLOCK_N - 1) / MLAS_SPARSE_SGEMM_BLOCK_N;
+    size_t NonZeroBlockCount = 0;
+
+    for (size_t nb = 0; nb < BlockCountN; nb++) {
+
+        const size_t n0 = nb * MLAS_SPARSE_SGEMM_BLOCK_N;
+        const size_t CountN = std::min(N - n0, size_t(MLAS_SPARSE_SGEMM_BLOCK_N));
+
+        for (size_t k = 0; k < K; k++) {
+            for (size_t n = 0; n < CountN; n++) {
+                if (MlasSparseGemmLoadB(TransB, B, ldb, k, n0 + n) != 0.0f) {
+                    NonZeroBlockCount++;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (NonZeroBlockCount > std::numeric_limits<uint32_t>::max()) {
+        return 0;
+    }
+
+    return MlasSparseGemmValuesOffset(BlockCountN, NonZeroBlockCount) +
+        NonZeroBlockCount * MLAS_SPARSE_SGEMM_BLOCK_N * sizeof(float);
+}
+
+void
+MLASCALL
+MlasGemmPackSparseB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the contents of matrix B to the destination buffer. The
+    destination buffer should be sized based on MlasGemmPackSparseBSize() for
+    the same matrix.
+
+Arguments:
+
+    TransB - Supplies the transpose operation on B matrix
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of packed matrix B.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockCountN = (N + MLAS_SPARSE_SGEMM_BLOCK_N - 1) / MLAS_SPARSE_SGEMM_BLOCK_N;
+
+    uint32_t* BlockOffsets = reinterpret_cast<uint32_t*>(
+        static_cast<MLAS_SPARSE_SGEMM_PACKED_HEADER*>(PackedB) + 1);
+
+    //
+    // Find the non-zero blocks of each column block.
+    //
+
+    size_t NonZeroBlockCount = 0;
+
+    for (size_t nb = 0; nb < BlockCountN; nb++) {
+
+        const size_t n0 = nb * MLAS_SPARSE_SGEMM_BLOCK_N;
+        const size_t CountN = std::min(N - n0, size_t(MLAS_SPARSE_SGEMM_BLOCK_N));
+
+        BlockOffsets[nb] = uint32_t(NonZeroBlockCount);
+
+        for (size_t k = 0; k < K; k++) {
+            for (size_t n = 0; n < CountN; n++) {
+                if (MlasSparseGemmLoadB(TransB, B, ldb, k, n0 + n) != 0.0f) {
+                    BlockOffsets[BlockCountN + 1 + NonZeroBlockCount] = uint32_t(k);
+                    NonZeroBlockCount++;
+                    break;
+                }
+            }
+        }
+    }
+
+    BlockOffsets[BlockCountN] = uint32_t(NonZeroBlockCount);
+
+    auto* Header = static_cast<MLAS_SPARSE_SGEMM_PACKED_HEADER*>(PackedB);
+
+    Header->N = N;
+    Header->K = K;
+    Header->BlockCountN = BlockCountN;
+    Header->NonZeroBlockCount = NonZeroBlockCount;
+
+    //
+    // Copy the values of the non-zero blocks, padding the trailing column
+    // block with zeros.
+    //
+
+    const uint32_t* RowIndices = BlockOffsets + BlockCountN + 1;
+    float* Values = reinterpret_cast<float*>(static_cast<uint8_t*>(PackedB) +
+        MlasSparseGemmValuesOffset(BlockCountN, NonZeroBlockCount));
+
+    for (size_t nb = 0; nb < BlockCountN; nb++) {
+
+        const size_t n0 = nb * MLAS_SPARSE_SGEMM_BLOCK_N;
+        const size_t CountN = std::min(N - n0, size_t(MLAS_SPARSE_SGEMM_BLOCK_N));
+
+        for (size_t i = BlockOffsets[nb]; i < BlockOffsets[nb + 1]; i++) {
+
+            const size_t k = RowIndices[i];
+
+            for (size_t n = 0; n < MLAS_SPARSE_SGEMM_BLOCK_N; n++) {
+                *Values++ = (n < CountN) ? MlasSparseGemmLoadB(TransB, B, ldb, k, n0 + n) : 0.0f;
+            }
+        }
+    }
+}
+
+//
+// Define the macros to accumulate and store one row of the output block. The
+// accumulators are named explicitly so that the compiler keeps each of them in
+// a register for the duration of the loop.
+//
+
+#define MlasSparseGemmAccumulateRow(Row) \
+    if (RowCount > Row) { \
+        MLAS_FLOAT32X4 AElement = MlasBroadcastFloat32x4(A[Row * lda + k]); \
+        Accumulator##Row##0 = MlasMultiplyAddFloat32x4(BElements0, AElement, Accumulator##Row##0); \
+        Accumulator##Row##1 = MlasMultiplyAddFloat32x4(BElements1, AElement, Accumulator##Row##1); \
+        Accumulator##Row##2 = MlasMultiplyAddFloat32x4(BElements2, AElement, Accumulator##Row##2); \
+        Accumulator##Row##3 = MlasMultiplyAddFloat32x4(BElements3, AElement, Accumulator##Row##3); \
+    }
+
+#define MlasSparseGemmStoreRow(Row) \
+    if (RowCount > Row) { \
+        MlasSparseGemmStoreRowRoutine(C + Row * ldc, CountN, \
+            MlasMultiplyFloat32x4(Accumulator##Row##0, AlphaBroadcast), \
+            MlasMultiplyFloat32x4(Accumulator##Row##1, AlphaBroadcast), \
+            MlasMultiplyFloat32x4(Accumulator##Row##2, AlphaBroadcast), \
+            MlasMultiplyFloat32x4(Accumulator##Row##3, AlphaBroadcast)); \
+    }
+
+MLAS_FORCEINLINE
+void
+MlasSparseGemmStoreRowRoutine(
+    float* C,
+    size_t CountN,
+    MLAS_FLOAT32X4 Output0,
+    MLAS_FLOAT32X4 Output1,
+    MLAS_FLOAT32X4 Output2,
+    MLAS_FLOAT32X4 Output3
+    )
+{
+    if (CountN == MLAS_SPARSE_SGEMM_BLOCK_N) {
+
+        MlasStoreFloat32x4(C, Output0);
+        MlasStoreFloat32x4(C + 4, Output1);
+        MlasStoreFloat32x4(C + 8, Output2);
+        MlasStoreFloat32x4(C + 12, Output3);
+
+    } else {
+
+        MLAS_DECLSPEC_ALIGN(float Output[MLAS_SPARSE_SGEMM_BLOCK_N], 16);
+
+        MlasStoreFloat32x4(Output, Output0);
+        MlasStoreFloat32x4(Output + 4, Output1);
+        MlasStoreFloat32x4(Output + 8, Output2);
+        MlasStoreFloat32x4(Output + 12, Output3);
+
+        std::copy_n(Output, CountN, C);
+    }
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasSparseGemmFloatKernelBlock(
+    const float* A,
+    size_t lda,
+    const uint32_t* RowIndices,
+    const float* Values,
+    size_t BlockCount,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    float alpha
+    )
+{
+    MLAS_FLOAT32X4 Accumulator00 = MlasZeroFloat32x4();
+    MLAS_FLOAT32X4 Accumulator01 = Accumulator00;
+    MLAS_FLOAT32X4 Accumulator02 = Accumulator00;
+    MLAS_FLOAT32X4 Accumulator03 = Accumulator00;
+    MLAS_FLOAT32X4 Accumulator10 = Accumulator00;
+    MLAS_FLOAT32X4 Accumulator11 = Accumulator00;
+    MLAS_FLOAT32X4 Accumulator12 = Accumulator00;
+    MLAS_FLOAT32X4 Accumulator13 = Accumulator00;
+
+    for (size_t i = 0; i < BlockCount; i++) {
+
+        const size_t k = RowIndices[i];
+
+        MLAS_FLOAT32X4 BElements0 = MlasLoadFloat32x4(Values);
+        MLAS_FLOAT32X4 BElements1 = MlasLoadFloat32x4(Values + 4);
+        MLAS_FLOAT32X4 BElements2 = MlasLoadFloat32x4(Values + 8);
+        MLAS_FLOAT32X4 BElements3 = MlasLoadFloat32x4(Values + 12);
+
+        MlasSparseGemmAccumulateRow(0);
+        MlasSparseGemmAccumulateRow(1);
+
+        Values += MLAS_SPARSE_SGEMM_BLOCK_N;
+    }
+
+    const MLAS_FLOAT32X4 AlphaBroadcast = MlasBroadcastFloat32x4(alpha);
+
+    MlasSparseGemmStoreRow(0);
+    MlasSparseGemmStoreRow(1);
+}
+
+size_t
+MLASCALL
+MlasSparseGemmFloatKernel(
+    const float* A,
+    size_t lda,
+    const uint32_t* RowIndices,
+    const float* Values,
+    size_t BlockCount,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    float alpha
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute matrix multiplication for a
+    set of rows by one column block of the packed sparse matrix B.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    RowIndices - Supplies the row index of each non-zero block of the column
+        block.
+
+    Values - Supplies the values of each non-zero block of the column block.
+
+    BlockCount - Supplies the number of non-zero blocks.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountM - Supplies the maximum number of rows that can be processed for
+        matrix A and matrix C. The actual number of rows handled for this
+        invocation depends on the kernel implementation.
+
+    CountN - Supplies the number of columns of matrix C to store.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    if (CountM >= 2) {
+        MlasSparseGemmFloatKernelBlock<2>(A, lda, RowIndices, Values, BlockCount, C, ldc, CountN, alpha);
+        return 2;
+    }
+
+    MlasSparseGemmFloatKernelBlock<1>(A, lda, RowIndices, Values, BlockCount, C, ldc, CountN, alpha);
+    return 1;
+}
+
+struct MLAS_SPARSE_SGEMM_WORK_BLOCK {
+    size_t M;
+    float alpha;
+    const float* A;
+    size_t lda;
+    const void* PackedB;
+    float* C;
+    size_t ldc;
+    int32_t ThreadCountM;
+    int32_t ThreadCountN;
+};
+
+void
+MlasSparseGemmOperation(
+    const MLAS_SPARSE_SGEMM_WORK_BLOCK* WorkBlock,
+    size_t RangeStartM,
+    size_t RangeCountM,
+    size_t RangeStartN,
+    size_t RangeCountN
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a range of rows by a range of column blocks of
+    matrix C.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the GEMM parameters.
+
+    RangeStartM - Supplies the starting row.
+
+    RangeCountM - Supplies the number of rows.
+
+    RangeStartN - Supplies the starting column block.
+
+    RangeCountN - Supplies the number of column blocks.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* Header = static_cast<const MLAS_SPARSE_SGEMM_PACKED_HEADER*>(WorkBlock->PackedB);
+    const uint32_t* BlockOffsets = reinterpret_cast<const uint32_t*>(Header + 1);
+    const uint32_t* RowIndices = BlockOffsets + Header->BlockCountN + 1;
+    const float* Values = reinterpret_cast<const float*>(static_cast<const uint8_t*>(WorkBlock->PackedB) +
+        MlasSparseGemmValuesOffset(Header->BlockCountN, Header->NonZeroBlockCount));
+
+    const size_t lda = WorkBlock->lda;
+    const size_t ldc = WorkBlock->ldc;
+
+#if defined(MLAS_TARGET_AMD64)
+    PMLAS_SPARSE_GEMM_FLOAT_KERNEL SparseGemmFloatKernel = MlasPlatform.SparseGemmFloatKernel;
+#else
+    PMLAS_SPARSE_GEMM_FLOAT_KERNEL SparseGemmFloatKernel = MlasSparseGemmFloatKernel;
+#endif
+
+    //
+    // Step through the rows in the order of the kernel row blocks so that the
+    // rows of matrix A stay in the cache while iterating over the column
+    // blocks of matrix B.
+    //
+
+    const float* a = WorkBlock->A + RangeStartM * lda;
+    float* c = WorkBlock->C + RangeStartM * ldc;
+    size_t CountM = RangeCountM;
+
+    while (CountM > 0) {
+
+        size_t RowsHandled = 0;
+
+        for (size_t nb = RangeStartN; nb < RangeStartN + RangeCountN; nb++) {
+
+            const size_t n0 = nb * MLAS_SPARSE_SGEMM_BLOCK_N;
+            const size_t CountN = std::min(Header->N - n0, size_t(MLAS_SPARSE_SGEMM_BLOCK_N));
+            const size_t BlockStart = BlockOffsets[nb];
+            const size_t BlockCount = BlockOffsets[nb + 1] - BlockStart;
+
+            RowsHandled = SparseGemmFloatKernel(a, lda, RowIndices + BlockStart,
+                Values + BlockStart * MLAS_SPARSE_SGEMM_BLOCK_N, BlockCount, c + n0, ldc,
+                CountM, CountN, WorkBlock->alpha);
+        }
+
+        a += RowsHandled * lda;
+        c += RowsHandled * ldc;
+        CountM -= RowsHandled;
+    }
+}
+
+void
+MlasSparseGemmThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    sparse SGEMM operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = static_cast<MLAS_SPARSE_SGEMM_WORK_BLOCK*>(Context);
+    const auto* Header = static_cast<const MLAS_SPARSE_SGEMM_PACKED_HEADER*>(WorkBlock->PackedB);
+
+    const int32_t ThreadIdM = Index / WorkBlock->ThreadCountN;
+    const int32_t ThreadIdN = Index % WorkBlock->ThreadCountN;
+
+    size_t RangeStartM;
+    size_t RangeCountM;
+
+    MlasPartitionWork(ThreadIdM, WorkBlock->ThreadCountM, WorkBlock->M, &RangeStartM, &RangeCountM);
+
+    size_t RangeStartN;
+    size_t RangeCountN;
+
+    MlasPartitionWork(ThreadIdN, WorkBlock->ThreadCountN, Header->BlockCountN, &RangeStartN, &RangeCountN);
+
+    MlasSparseGemmOperation(WorkBlock, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+}
+
+void
+MLASCALL
+MlasGemmSparse(
+    size_t M,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) with matrix B packed by MlasGemmPackSparseB.
+
+        C = alpha * A * B
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    alpha - Supplies the scalar multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PackedB - Supplies the address of packed sparse matrix B. The number of
+        columns and rows of matrix B are stored in the packed buffer.
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* Header = static_cast<const MLAS_SPARSE_SGEMM_PACKED_HEADER*>(PackedB);
+
+    if (M == 0 || Header->BlockCountN == 0) {
+        return;
+    }
+
+    MLAS_SPARSE_SGEMM_WORK_BLOCK WorkBlock;
+
+    WorkBlock.M = M;
+    WorkBlock.alpha = alpha;
+    WorkBlock.A = A;
+    WorkBlock.lda = lda;
+    WorkBlock.PackedB = PackedB;
+    WorkBlock.C = C;
+    WorkBlock.ldc = ldc;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Split the column blocks first so that each thread streams
+    // through a private slice of the packed matrix B.
+    //
+
+    const size_t Complexity = M * std::max(Header->NonZeroBlockCount, size_t(1)) * MLAS_SPARSE_SGEMM_BLOCK_N;
+
+    int32_t TargetThreadCount = int32_t(std::min(Complexity / MLAS_SPARSE_SGEMM_THREAD_COMPLEXITY + 1,
+        size_t(MlasGetMaximumThreadCount(ThreadPool))));
+
+    if (TargetThreadCount == 1) {
+        MlasSparseGemmOperation(&WorkBlock, 0, M, 0, Header->BlockCountN);
+        return;
+    }
+
+    WorkBlock.ThreadCountN = int32_t(std::min(size_t(TargetThreadCount), Header->BlockCountN));
+    WorkBlock.ThreadCountM = int32_t(std::min(size_t(TargetThreadCount / WorkBlock.ThreadCountN), M));
+
+    MlasExecuteThreaded(MlasSparseGemmThreaded, &WorkBlock,
+        WorkBlock.ThreadCountM * WorkBlock.ThreadCountN, ThreadPool);
+}
@@ -132,22 +132,93 @@ Return Value:
 
 }
 
+MLAS_FORCEINLINE
+void
+MlasTranspose4x4Block(
+    const uint32_t* Input,
+    size_t InputStride,
+    uint32_t* Output,
+    size_t OutputStride
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a four by four element block from the input
+    matrix to the output matrix.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    InputStride - Supplies the number of elements between rows of the input
+        matrix.
+
+    Output - Supplies the output buffer.
+
+    OutputStride - Supplies the number of elements between rows of the output
+        matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+
+#if defined(MLAS_SSE2_INTRINSICS)
+
+    __m128i a0 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 0]);
+    __m128i a1 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 1]);
+    __m128i a2 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 2]);
+    __m128i a3 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 3]);
+
+    __m128i b0 = _mm_unpacklo_epi32(a0, a1);
+    __m128i b1 = _mm_unpacklo_epi32(a2, a3);
+    __m128i b2 = _mm_unpackhi_epi32(a0, a1);
+    __m128i b3 = _mm_unpackhi_epi32(a2, a3);
+
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 0], _mm_unpacklo_epi64(b0, b1));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 1], _mm_unpackhi_epi64(b0, b1));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 2], _mm_unpacklo_epi64(b2, b3));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 3], _mm_unpackhi_epi64(b2, b3));
+
+#elif defined(MLAS_NEON_INTRINSICS)
+
+    uint32x4_t a0 = vld1q_u32(&Input[InputStride * 0]);
+    uint32x4_t a1 = vld1q_u32(&Input[InputStride * 1]);
+    uint32x4_t a2 = vld1q_u32(&Input[InputStride * 2]);
+    uint32x4_t a3 = vld1q_u32(&Input[InputStride * 3]);
+
+    uint32x4x2_t b0 = vtrnq_u32(a0, a1);
+    uint32x4x2_t b1 = vtrnq_u32(a2, a3);
+
+    vst1q_u32(&Output[OutputStride * 0], vcombine_u32(vget_low_u32(b0.val[0]), vget_low_u32(b1.val[0])));
+    vst1q_u32(&Output[OutputStride * 1], vcombine_u32(vget_low_u32(b0.val[1]), vget_low_u32(b1.val[1])));
+    vst1q_u32(&Output[OutputStride * 2], vcombine_u32(vget_high_u32(b0.val[0]), vget_high_u32(b1.val[0])));
+    vst1q_u32(&Output[OutputStride * 3], vcombine_u32(vget_high_u32(b0.val[1]), vget_high_u32(b1.val[1])));
+
 #endif
 
+}
+
+#endif
+
+template<typename ElementType, size_t VectorLength>
 MLAS_FORCEINLINE
 void
-MlasTranspose8xNVector(
-    const uint8_t* Input,
+MlasTransposeVector(
+    const ElementType* Input,
     size_t InputStride,
-    uint8_t* Output,
+    ElementType* Output,
     size_t OutputStride
     )
 /*++
 
 Routine Description:
 
-    This routine transposes an eight element vector from the input matrix
-    to the output matrix.
+    This routine transposes a vector of VectorLength elements from the input
+    matrix to the output matrix.
 
 Arguments:
 
@@ -167,53 +238,135 @@ Return Value:
 
 --*/
 {
-    uint8_t a0 = Input[InputStride * 0];
-    uint8_t a1 = Input[InputStride * 1];
-    uint8_t a2 = Input[InputStride * 2];
-    uint8_t a3 = Input[InputStride * 3];
-
-    Output[OutputStride * 0] = a0;
-    Output[OutputStride * 1] = a1;
-    Output[OutputStride * 2] = a2;
-    Output[OutputStride * 3] = a3;
-
-    uint8_t a4 = Input[InputStride * 4];
-    uint8_t a5 = Input[InputStride * 5];
-    uint8_t a6 = Input[InputStride * 6];
-    uint8_t a7 = Input[InputStride * 7];
-
-    Output[OutputStride * 4] = a4;
-    Output[OutputStride * 5] = a5;
-    Output[OutputStride * 6] = a6;
-    Output[OutputStride * 7] = a7;
+    for (size_t i = 0; i < VectorLength; i++) {
+        Output[OutputStride * i] = Input[InputStride * i];
+    }
 }
 
+template<typename ElementType>
+struct MLAS_TRANSPOSE_KERNEL
+{
+    //
+    // Transpose blocks of elements without SIMD support using the vector
+    // routine for each column of the block.
+    //
+
+    static constexpr size_t BlockSize = 4;
+
+    MLAS_FORCEINLINE
+    static
+    void
+    TransposeBlock(
+        const ElementType* Input,
+        size_t InputStride,
+        ElementType* Output,
+        size_t OutputStride
+        )
+    {
+        for (size_t i = 0; i < BlockSize; i++) {
+            MlasTransposeVector<ElementType, BlockSize>(Input + i, InputStride, Output + OutputStride * i, 1);
+        }
+    }
+};
+
+template<>
+struct MLAS_TRANSPOSE_KERNEL<uint8_t>
+{
+    static constexpr size_t BlockSize = 8;
+
+    MLAS_FORCEINLINE
+    static
+    void
+    TransposeBlock(
+        const uint8_t* Input,
+        size_t InputStride,
+        uint8_t* Output,
+        size_t OutputStride
+        )
+    {
+#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS)
+        MlasTranspose8x8Block(Input, InputStride, Output, OutputStride);
+#else
+        for (size_t i = 0; i < BlockSize; i++) {
+            MlasTransposeVector<uint8_t, BlockSize>(Input + i, InputStride, Output + OutputStride * i, 1);
+        }
+#endif
+    }
+};
+
+template<>
+struct MLAS_TRANSPOSE_KERNEL<uint32_t>
+{
+    static constexpr size_t BlockSize = 4;
+
+    MLAS_FORCEINLINE
+    static
+    void
+    TransposeBlock(
+        const uint32_t* Input,
+        size_t InputStride,
+        uint32_t* Output,
+        size_t OutputStride
+        )
+    {
+#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS)
+        MlasTranspose4x4Block(Input, InputStride, Output, OutputStride);
+#else
+        for (size_t i = 0; i < BlockSize; i++) {
+            MlasTransposeVector<uint32_t, BlockSize>(Input + i, InputStride, Output + OutputStride * i, 1);
+        }
+#endif
+    }
+};
+
+//
+// Define the number of rows and columns of the tiles that are transposed at
+// a time, so that the tiles of the input and output matrices stay resident in
+// the cache.
+//
+
+#define MLAS_TRANSPOSE_TILE_SIZE                    64
+
+//
+// Define the number of elements to transpose per thread.
+//
+
+#define MLAS_TRANSPOSE_THREAD_COMPLEXITY            (64 * 1024)
+
+template<typename ElementType>
 void
-MLASCALL
-MlasTranspose(
-    const uint8_t* Input,
-    uint8_t* Output,
-    size_t M,
-    size_t N
+MlasTransposeTile(
+    const ElementType* Input,
+    size_t ldInput,
+    ElementType* Output,
+    size_t ldOutput,
+    size_t CountM,
+    size_t CountN
     )
 /*++
 
 Routine Description:
 
-    This routine transposes the input matrix (M rows by N columns) to the
-    output matrix (N rows by M columns).
+    This routine transposes a tile of the input matrix (CountM rows by CountN
+    columns) to the output matrix (CountN rows by CountM columns).
 
 Arguments:
 
     Input - Supplies the input buffer.
 
+    ldInput - Supplies the number of elements between rows of the input
+        matrix.
+
     Output - Supplies the output buffer.
 
-    M - Supplies the number of rows for the input matrix and the number of
-        columns for the output matrix.
+    ldOutput - Supplies the number of elements between rows of the output
+        matrix.
 
-    N - Supplies the number of columns for the input matrix and the number of
-        rows for the output matrix.
+    CountM - Supplies the number of rows for the input tile and the number of
+        columns for the output tile.
+
+    CountN - Supplies the number of columns for the input tile and the number
+        of rows for the output tile.
 
 Return Value:
 
@@ -221,44 +374,42 @@ Return Value:
 
 --*/
 {
-    size_t n = N;
+    constexpr size_t BlockSize = MLAS_TRANSPOSE_KERNEL<ElementType>::BlockSize;
+
+    size_t n = CountN;
 
     //
-    // Transpose elements from the input matrix to the output matrix 8 columns
-    // at a time.
+    // Transpose elements from the input matrix to the output matrix BlockSize
+    // columns at a time.
     //
 
-    while (n >= 8) {
-
-        const uint8_t* s = Input;
-        uint8_t* d = Output;
-        size_t m = M;
+    while (n >= BlockSize) {
 
-#if defined(MLAS_SSE2_INTRINSICS) || defined(MLAS_NEON_INTRINSICS)
+        const ElementType* s = Input;
+        ElementType* d = Output;
+        size_t m = CountM;
 
-        while (m >= 8) {
+        while (m >= BlockSize) {
 
-            MlasTranspose8x8Block(s, N, d, M);
+            MLAS_TRANSPOSE_KERNEL<ElementType>::TransposeBlock(s, ldInput, d, ldOutput);
 
-            s += N * 8;
-            d += 8;
-            m -= 8;
+            s += ldInput * BlockSize;
+            d += BlockSize;
+            m -= BlockSize;
         }
 
-#endif
-
         while (m > 0) {
 
-            MlasTranspose8xNVector(s, 1, d, M);
+            MlasTransposeVector<ElementType, BlockSize>(s, 1, d, ldOutput);
 
-            s += N;
+            s += ldInput;
             d += 1;
             m -= 1;
         }
 
-        Input += 8;
-        Output += M * 8;
-        n -= 8;
+        Input += BlockSize;
+        Output += ldOutput * BlockSize;
+        n -= BlockSize;
     }
 
     //
@@ -268,30 +419,240 @@ Return Value:
 
     while (n > 0) {
 
-        const uint8_t* s = Input;
-        uint8_t* d = Output;
-        size_t m = M;
+        const ElementType* s = Input;
+        ElementType* d = Output;
+        size_t m = CountM;
 
-        while (m >= 8) {
+        while (m >= BlockSize) {
 
-            MlasTranspose8xNVector(s, N, d, 1);
+            MlasTransposeVector<ElementType, BlockSize>(s, ldInput, d, 1);
 
-            s += N * 8;
-            d += 8;
-            m -= 8;
+            s += ldInput * BlockSize;
+            d += BlockSize;
+            m -= BlockSize;
         }
 
         while (m > 0) {
 
             d[0] = s[0];
 
-            s += N;
+            s += ldInput;
             d += 1;
             m -= 1;
         }
 
         Input += 1;
-        Output += M;
+        Output += ldOutput;
         n -= 1;
     }
 }
+
+template<typename ElementType>
+struct MLAS_TRANSPOSE_WORK_BLOCK {
+    const ElementType* Input;
+    ElementType* Output;
+    size_t M;
+    size_t N;
+    int32_t ThreadCount;
+};
+
+template<typename ElementType>
+void
+MlasTransposeOperation(
+    const MLAS_TRANSPOSE_WORK_BLOCK<ElementType>* WorkBlock,
+    size_t RangeStartTile,
+    size_t RangeCountTile
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a range of the tiles of the input matrix to the
+    output matrix. The tiles are numbered in row major order.
+
+Arguments:
+
+    WorkBlock - Supplies the structure containing the transpose parameters.
+
+    RangeStartTile - Supplies the index of the first tile to transpose.
+
+    RangeCountTile - Supplies the number of tiles to transpose.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t M = WorkBlock->M;
+    const size_t N = WorkBlock->N;
+    const size_t TileCountN = (N + MLAS_TRANSPOSE_TILE_SIZE - 1) / MLAS_TRANSPOSE_TILE_SIZE;
+
+    for (size_t tile = RangeStartTile; tile < RangeStartTile + RangeCountTile; tile++) {
+
+        const size_t m = (tile / TileCountN) * MLAS_TRANSPOSE_TILE_SIZE;
+        const size_t n = (tile % TileCountN) * MLAS_TRANSPOSE_TILE_SIZE;
+
+        MlasTransposeTile(WorkBlock->Input + m * N + n, N, WorkBlock->Output + n * M + m, M,
+            std::min(M - m, size_t(MLAS_TRANSPOSE_TILE_SIZE)), std::min(N - n, size_t(MLAS_TRANSPOSE_TILE_SIZE)));
+    }
+}
+
+template<typename ElementType>
+void
+MlasTransposeThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    transpose operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = static_cast<MLAS_TRANSPOSE_WORK_BLOCK<ElementType>*>(Context);
+
+    const size_t TileCount = ((WorkBlock->M + MLAS_TRANSPOSE_TILE_SIZE - 1) / MLAS_TRANSPOSE_TILE_SIZE) *
+        ((WorkBlock->N + MLAS_TRANSPOSE_TILE_SIZE - 1) / MLAS_TRANSPOSE_TILE_SIZE);
+
+    size_t RangeStartTile;
+    size_t RangeCountTile;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCount, TileCount, &RangeStartTile, &RangeCountTile);
+
+    if (RangeCountTile > 0) {
+        MlasTransposeOperation(WorkBlock, RangeStartTile, RangeCountTile);
+    }
+}
+
+template<typename ElementType>
+void
+MlasTransposeImpl(
+    const ElementType* Input,
+    ElementType* Output,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the input matrix (M rows by N columns) to the
+    output matrix (N rows by M columns).
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    M - Supplies the number of rows for the input matrix and the number of
+        columns for the output matrix.
+
+    N - Supplies the number of columns for the input matrix and the number of
+        rows for the output matrix.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_TRANSPOSE_WORK_BLOCK<ElementType> WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.M = M;
+    WorkBlock.N = N;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. The tiles are split across the threads.
+    //
+
+    const size_t TileCount = ((M + MLAS_TRANSPOSE_TILE_SIZE - 1) / MLAS_TRANSPOSE_TILE_SIZE) *
+        ((N + MLAS_TRANSPOSE_TILE_SIZE - 1) / MLAS_TRANSPOSE_TILE_SIZE);
+
+    size_t TargetThreadCount = (M * N) / MLAS_TRANSPOSE_THREAD_COMPLEXITY + 1;
+
+    TargetThreadCount = std::min(TargetThreadCount, size_t(MlasGetMaximumThreadCount(ThreadPool)));
+    TargetThreadCount = std::min(TargetThreadCount, TileCount);
+
+    if (TargetThreadCount <= 1) {
+        MlasTransposeOperation(&WorkBlock, 0, TileCount);
+        return;
+    }
+
+    WorkBlock.ThreadCount = int32_t(TargetThreadCount);
+
+    MlasExecuteThreaded(MlasTransposeThreaded<ElementType>, &WorkBlock, WorkBlock.ThreadCount, ThreadPool);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint8_t* Input,
+    uint8_t* Output,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    MlasTransposeImpl(Input, Output, M, N, ThreadPool);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint16_t* Input,
+    uint16_t* Output,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    MlasTransposeImpl(Input, Output, M, N, ThreadPool);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint32_t* Input,
+    uint32_t* Output,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    MlasTransposeImpl(Input, Output, M, N, ThreadPool);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    const uint64_t* Input,
+    uint64_t* Output,
+    size_t M,
+    size_t N,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    MlasTransposeImpl(Input, Output, M, N, ThreadPool);
+}
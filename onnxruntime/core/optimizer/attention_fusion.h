@@ -16,6 +16,8 @@ class AttentionFusion : public GraphTransformer {
   AttentionFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
       : GraphTransformer("AttentionFusion", compatible_execution_providers) {}
 
+  std::vector<std::string> TargetOpTypes() const override { return {"LayerNormalization"}; }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 
 private:
@@ -17,6 +17,8 @@ class BiasGeluFusion : public GraphTransformer {
       : GraphTransformer("BiasGeluFusion", compatible_execution_providers) {
   }
 
+  std::vector<std::string> TargetOpTypes() const override { return {"Gelu", "FastGelu"}; }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
@@ -44,11 +44,19 @@ bool TryBiasSoftmaxSubgraphMatch(Graph& graph, Node& start, Node*& add, Node*& s
 
   // check node is add and has single output
   if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7}) ||
-      !graph_utils::IsSupportedProvider(node, {kCudaExecutionProvider, kRocmExecutionProvider}) ||
+      !graph_utils::IsSupportedProvider(node, {kCpuExecutionProvider, kCudaExecutionProvider, kRocmExecutionProvider}) ||
       !optimizer_utils::CheckOutputEdges(graph, node, 1)) {
     return false;
   }
 
+  // the CPU kernel is only implemented for float
+  if (node.GetExecutionProviderType() == kCpuExecutionProvider) {
+    const auto* type = node.InputDefs()[0]->TypeAsProto();
+    if (type == nullptr || type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+      return false;
+    }
+  }
+
   // check shape information is not available for both add inputs
   Node& add_node = node;
   NodeArg* input1 = add_node.MutableInputDefs()[0];
@@ -224,9 +232,10 @@ Status BiasSoftmaxFusion::ApplyImpl(Graph& graph, bool& modified, int graph_leve
   GraphViewer graph_viewer(graph);
   const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
 
-  // only support GPU execution provider
+  // only support CPU and GPU execution providers
   auto& cep = GetCompatibleExecutionProviders();
-  if (cep.size() > 0 && cep.find(kCudaExecutionProvider) == cep.end() && cep.find(kRocmExecutionProvider) == cep.end())
+  if (cep.size() > 0 && cep.find(kCpuExecutionProvider) == cep.end() && cep.find(kCudaExecutionProvider) == cep.end() &&
+      cep.find(kRocmExecutionProvider) == cep.end())
     return Status::OK();
 
   for (auto node_index : node_topology_list) {
@@ -16,6 +16,8 @@ class BiasSoftmaxFusion : public GraphTransformer {
   BiasSoftmaxFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
       : GraphTransformer("BiasSoftmaxFusion", compatible_execution_providers) {}
 
+  std::vector<std::string> TargetOpTypes() const override { return {"Softmax"}; }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
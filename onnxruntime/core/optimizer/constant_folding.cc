@@ -8,18 +8,111 @@
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorprotoutils.h"
 
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
 using namespace onnxruntime::common;
 
 namespace onnxruntime {
 
 ConstantFolding::ConstantFolding(const IExecutionProvider& execution_provider,
                                  const std::unordered_set<std::string>& compatible_execution_providers,
-                                 const std::unordered_set<std::string>& excluded_initializers) noexcept
+                                 const std::unordered_set<std::string>& excluded_initializers,
+                                 size_t max_output_size_in_bytes,
+                                 bool skip_dequantize_linear) noexcept
     : GraphTransformer("ConstantFolding", compatible_execution_providers),
       excluded_initializers_(excluded_initializers),
-      execution_provider_(execution_provider) {
+      execution_provider_(execution_provider),
+      max_output_size_in_bytes_(max_output_size_in_bytes),
+      skip_dequantize_linear_(skip_dequantize_linear) {
+}
+
+// Returns true if the inferred shape of an output shows it will be larger than max_output_size_in_bytes, so that the
+// node isn't computed at all. Outputs without a static shape are checked after computing them.
+static bool HasOutputLargerThan(const Node& node, size_t max_output_size_in_bytes) {
+  for (const auto* output : node.OutputDefs()) {
+    const auto* type = output->TypeAsProto();
+    const auto* shape = output->Shape();
+    if (type == nullptr || shape == nullptr || !utils::HasTensorType(*type) ||
+        !utils::HasElemType(type->tensor_type()) ||
+        type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+      continue;
+    }
+
+    const auto& dims = shape->dim();
+    if (!std::all_of(dims.begin(), dims.end(),
+                     [](const ONNX_NAMESPACE::TensorShapeProto_Dimension& dim) {
+                       return utils::HasDimValue(dim) && dim.dim_value() > 0;
+                     })) {
+      continue;
+    }
+
+    size_t size_in_bytes = DataTypeImpl::TensorTypeFromONNXEnum(type->tensor_type().elem_type())->GetElementType()->Size();
+    for (const auto& dim : dims) {
+      // compare before multiplying so the size can't overflow
+      if (static_cast<size_t>(dim.dim_value()) > max_output_size_in_bytes / size_in_bytes) {
+        return true;
+      }
+
+      size_in_bytes *= static_cast<size_t>(dim.dim_value());
+    }
+  }
+
+  return false;
 }
 
+namespace {
+// The values computed when folding nodes of the graph, by a hash of their content. A folded value equal to an earlier
+// one reuses its initializer so the data is only stored once, which also allows CommonSubexpressionElimination to
+// merge the nodes consuming the values.
+class FoldedValues {
+ public:
+  explicit FoldedValues(const Graph& graph) : graph_(graph) {}
+
+  // Returns the name of an initializer with the same type, shape and data as tensor_proto, or nullptr.
+  const std::string* Find(const ONNX_NAMESPACE::TensorProto& tensor_proto) const {
+    if (!utils::HasRawData(tensor_proto)) {
+      return nullptr;
+    }
+
+    auto range = values_.equal_range(Hash(tensor_proto));
+    for (auto it = range.first; it != range.second; ++it) {
+      const ONNX_NAMESPACE::TensorProto* other = nullptr;
+      // the initializer may have been removed if it was only used by a node that was folded since
+      if (graph_.GetInitializedTensor(it->second, other) && other->data_type() == tensor_proto.data_type() &&
+          std::equal(other->dims().begin(), other->dims().end(), tensor_proto.dims().begin(),
+                     tensor_proto.dims().end()) &&
+          utils::HasRawData(*other) && other->raw_data() == tensor_proto.raw_data()) {
+        return &it->second;
+      }
+    }
+
+    return nullptr;
+  }
+
+  void Add(const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+    if (utils::HasRawData(tensor_proto)) {
+      values_.emplace(Hash(tensor_proto), tensor_proto.name());
+    }
+  }
+
+ private:
+  static size_t Hash(const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+    size_t hash = std::hash<std::string>()(tensor_proto.raw_data());
+    hash = hash * 31 + static_cast<size_t>(tensor_proto.data_type());
+    for (auto dim : tensor_proto.dims()) {
+      hash = hash * 31 + static_cast<size_t>(dim);
+    }
+
+    return hash;
+  }
+
+  const Graph& graph_;
+  std::unordered_multimap<size_t, std::string> values_;
+};
+}  // namespace
+
 // We need to handle a Shape node separately as the input doesn't need to be a constant initializer for
 // Shape to be able to be constant folded.
 static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
@@ -57,6 +150,7 @@ static bool ConstantFoldShapeNode(Graph& graph, Node& node) {
 
 Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
   bool have_updated_nodes = false;
+  FoldedValues folded_values(graph);
   GraphViewer graph_viewer(graph);
   auto& order = graph_viewer.GetNodesInTopologicalOrder();
 
@@ -77,6 +171,8 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
     }
 
     bool converted_to_constant = false;
+    // an initializer with the folded value that already exists, if the node has a single output
+    NodeArg* existing_value = nullptr;
     if (node->OpType().compare("Shape") == 0) {
       converted_to_constant = ConstantFoldShapeNode(graph, *node);
     } else {
@@ -96,6 +192,7 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       // Check if constant folding can be applied on this node.
       if (!graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders()) ||
           !optimizer_utils::IsOperationDeterministic(node->Domain(), node->OpType()) ||
+          (skip_dequantize_linear_ && node->OpType() == "DequantizeLinear") ||
           // constant folding does not support executing a node that includes subgraphs (control flow operators,
           // such as If/Loop/Scan, fall into this category). individual nodes in the subgraph will be processed
           // by the Recurse call above
@@ -103,6 +200,12 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
         continue;
       }
 
+      if (max_output_size_in_bytes_ > 0 && HasOutputLargerThan(*node, max_output_size_in_bytes_)) {
+        LOGS(logger, VERBOSE) << "Not constant folding " << node->OpType() << " node '" << node->Name()
+                              << "' as an output would be larger than " << max_output_size_in_bytes_ << " bytes";
+        continue;
+      }
+
       // Create execution frame for executing constant nodes.
       OptimizerExecutionFrame::Info info({node}, constant_inputs, graph.ModelPath(), execution_provider_);
 
@@ -152,6 +255,13 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
           converted_to_constant = false;
           break;
         }
+
+        if (max_output_size_in_bytes_ > 0 && ort_value.Get<Tensor>().SizeInBytes() > max_output_size_in_bytes_) {
+          LOGS(logger, VERBOSE) << "Not constant folding " << node->OpType() << " node '" << node->Name()
+                                << "' as an output is larger than " << max_output_size_in_bytes_ << " bytes";
+          converted_to_constant = false;
+          break;
+        }
       }
 
       if (converted_to_constant) {
@@ -168,6 +278,18 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
           }
 
           constant_arg_out->SetShape(result_shape);
+
+          if (fetches.size() == 1) {
+            const std::string* existing_name = folded_values.Find(out_tensorproto);
+            if (existing_name != nullptr &&
+                graph_utils::CanReplaceNodeWithInitializer(graph, *node, *existing_name, logger)) {
+              existing_value = graph.GetNodeArg(*existing_name);
+              break;
+            }
+
+            folded_values.Add(out_tensorproto);
+          }
+
           graph.AddInitializedTensor(out_tensorproto);
         }
       }
@@ -178,9 +300,15 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       for (auto p_ip_node = node->InputNodesBegin(); p_ip_node != node->InputNodesEnd(); ++p_ip_node) {
         graph_utils::RemoveNodesWithOneOutputBottomUp(graph, *p_ip_node);
       }
-      // Remove the output edges of the constant node and then remove the node itself.
-      graph_utils::RemoveNodeOutputEdges(graph, *node);
-      graph.RemoveNode(node->Index());
+
+      if (existing_value != nullptr) {
+        // Remove the node and update the consumers of its output to use the existing initializer.
+        graph_utils::ReplaceNodeWithInitializer(graph, *node, *existing_value);
+      } else {
+        // Remove the output edges of the constant node and then remove the node itself.
+        graph_utils::RemoveNodeOutputEdges(graph, *node);
+        graph.RemoveNode(node->Index());
+      }
       modified = true;
       have_updated_nodes = true;
     }
@@ -21,16 +21,24 @@ class ConstantFolding : public GraphTransformer {
   /*! Constant folding will not be applied to nodes that have one of initializers from excluded_initializers as input.
       For pre-training, the trainable weights are those initializers to be excluded.
       \param execution_provider Execution provider instance to execute constant folding.
+      \param max_output_size_in_bytes Nodes with an output larger than this are not folded, so that e.g. an Expand
+             of a small constant doesn't become a large initializer. 0 means there is no limit.
+      \param skip_dequantize_linear DequantizeLinear nodes are not folded, so that QDQFusion can fuse the quantized
+             weights into the integer kernels.
   */
   ConstantFolding(const IExecutionProvider& execution_provider,
                   const std::unordered_set<std::string>& compatible_execution_providers = {},
-                  const std::unordered_set<std::string>& excluded_initializers = {}) noexcept;
+                  const std::unordered_set<std::string>& excluded_initializers = {},
+                  size_t max_output_size_in_bytes = 0,
+                  bool skip_dequantize_linear = false) noexcept;
 
  private:
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 
   const std::unordered_set<std::string> excluded_initializers_;
   const IExecutionProvider& execution_provider_;
+  const size_t max_output_size_in_bytes_;
+  const bool skip_dequantize_linear_;
 };
 
 }  // namespace onnxruntime
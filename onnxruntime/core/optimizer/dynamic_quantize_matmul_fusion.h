@@ -17,6 +17,8 @@ class DynamicQuantizeMatMulFusion : public GraphTransformer {
       : GraphTransformer("DynamicQuantizeMatMulFusion", compatible_execution_providers) {
   }
 
+  std::vector<std::string> TargetOpTypes() const override { return {"MatMulIntegerToFloat"}; }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
@@ -0,0 +1,370 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_chain_fusion.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// The CUDA FusedElementwise kernel takes its chain by value in the kernel parameters, which bounds its length.
+constexpr size_t kCudaMaxChainLength = 16;
+
+struct ChainStep {
+  std::string op;
+  // the other operand of a binary node, which is nullptr if it is the scalar
+  NodeArg* operand;
+  float scalar;
+  bool operand_first;
+};
+
+// The values that the nodes of a chain can use as operands.
+struct ChainValues {
+  // the data input of the first node, which shares the shape of all the values of the chain
+  const NodeArg* input;
+  // the input and the outputs of the nodes of the chain
+  std::unordered_set<const NodeArg*> values;
+  // the topological position of the nodes of the graph and of the first node of the chain
+  const std::unordered_map<NodeIndex, size_t>& node_positions;
+  size_t first_position;
+};
+
+bool IsUnaryElementwiseOp(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Neg", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Abs", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Exp", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Log", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sqrt", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Reciprocal", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Erf", {9, 13});
+}
+
+bool IsBinaryElementwiseOp(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13});
+}
+
+// Get the value of a float scalar constant that doesn't change the shape of the data input when broadcast.
+bool GetScalarConstant(const Graph& graph, const NodeArg& input, const NodeArg& data_input, float& value) {
+  const TensorProto* tensor_proto = graph_utils::GetConstantInitializer(graph, input.Name());
+  if (tensor_proto == nullptr || tensor_proto->data_type() != TensorProto::FLOAT) {
+    return false;
+  }
+
+  for (auto dim : tensor_proto->dims()) {
+    if (dim != 1) {
+      return false;
+    }
+  }
+
+  if (tensor_proto->dims_size() > 0) {
+    const TensorShapeProto* data_shape = data_input.Shape();
+    if (data_shape == nullptr || data_shape->dim_size() < tensor_proto->dims_size()) {
+      return false;
+    }
+  }
+
+  Initializer initializer{*tensor_proto, graph.ModelPath()};
+  value = initializer.data<float>()[0];
+  return true;
+}
+
+// Check if the dimensions of input without the leading ones are known to match the trailing dimensions of
+// data_input, so input broadcasts to the shape of data_input.
+bool IsBroadcastCompatible(const NodeArg& input, const NodeArg& data_input) {
+  const TensorShapeProto* shape = input.Shape();
+  const TensorShapeProto* data_shape = data_input.Shape();
+  if (shape == nullptr || data_shape == nullptr) {
+    return false;
+  }
+
+  int leading_ones = 0;
+  while (leading_ones < shape->dim_size() && shape->dim(leading_ones).has_dim_value() &&
+         shape->dim(leading_ones).dim_value() == 1) {
+    ++leading_ones;
+  }
+
+  const int rank = shape->dim_size() - leading_ones;
+  if (rank > data_shape->dim_size()) {
+    return false;
+  }
+
+  for (int i = 0; i < rank; ++i) {
+    const auto& dim = shape->dim(leading_ones + i);
+    const auto& data_dim = data_shape->dim(data_shape->dim_size() - rank + i);
+    const bool same_value = dim.has_dim_value() && data_dim.has_dim_value() && dim.dim_value() == data_dim.dim_value();
+    const bool same_param = dim.has_dim_param() && data_dim.has_dim_param() && !dim.dim_param().empty() &&
+                            dim.dim_param() == data_dim.dim_param();
+    if (!same_value && !same_param) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Set the other operand of a binary operation of the chain.
+bool SetOperand(const Graph& graph, NodeArg& operand, const ChainValues& chain_values, ChainStep& step) {
+  if (chain_values.values.count(&operand) != 0) {
+    step.operand = &operand;
+    return true;
+  }
+
+  if (GetScalarConstant(graph, operand, *chain_values.input, step.scalar)) {
+    step.operand = nullptr;
+    return true;
+  }
+
+  if (!IsBroadcastCompatible(operand, *chain_values.input)) {
+    return false;
+  }
+
+  // a tensor from outside of the chain must be produced before the chain, so it doesn't depend on the fused node
+  const Node* producer = graph.GetProducerNode(operand.Name());
+  if (producer != nullptr) {
+    auto position = chain_values.node_positions.find(producer->Index());
+    if (position == chain_values.node_positions.end() || position->second >= chain_values.first_position) {
+      return false;
+    }
+  }
+
+  step.operand = &operand;
+  return true;
+}
+
+// Get the operation of node if it can be part of a chain that is applied to data_input.
+bool GetChainStep(const Graph& graph, Node& node, const NodeArg& data_input, const ChainValues& chain_values,
+                  ChainStep& step) {
+  auto& input_defs = node.MutableInputDefs();
+  const auto* output_type = node.OutputDefs()[0]->Type();
+  if (output_type == nullptr || *output_type != "tensor(float)") {
+    return false;
+  }
+
+  step.op = node.OpType();
+  step.operand = nullptr;
+  step.scalar = 0.0f;
+  step.operand_first = false;
+
+  if (IsUnaryElementwiseOp(node)) {
+    return input_defs[0] == &data_input;
+  }
+
+  if (IsBinaryElementwiseOp(node)) {
+    if (input_defs[0] == &data_input) {
+      return SetOperand(graph, *input_defs[1], chain_values, step);
+    }
+    if (input_defs[1] == &data_input) {
+      step.operand_first = true;
+      return SetOperand(graph, *input_defs[0], chain_values, step);
+    }
+  }
+
+  return false;
+}
+
+// Check if the outputs of the first chain_length - 1 nodes of the chain are only consumed inside of those nodes.
+bool IsSelfContainedChain(const Graph& graph, const std::vector<std::reference_wrapper<Node>>& chain,
+                          size_t chain_length) {
+  std::unordered_set<NodeIndex> chain_nodes;
+  for (size_t i = 0; i < chain_length; ++i) {
+    chain_nodes.insert(chain[i].get().Index());
+  }
+
+  for (size_t i = 0; i + 1 < chain_length; ++i) {
+    const Node& node = chain[i];
+    if (!graph.GetNodeOutputsInGraphOutputs(node).empty()) {
+      return false;
+    }
+
+    for (auto it = node.OutputNodesBegin(), end = node.OutputNodesEnd(); it != end; ++it) {
+      if (chain_nodes.count(it->Index()) == 0) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+ElementwiseChainFusion::ElementwiseChainFusion(std::unordered_map<std::string, int64_t> node_kernel_times,
+                                               double min_time_percent,
+                                               const std::unordered_set<std::string>& compatible_execution_providers) noexcept
+    : GraphTransformer("ElementwiseChainFusion", compatible_execution_providers),
+      node_kernel_times_(std::move(node_kernel_times)) {
+  int64_t total_kernel_time = 0;
+  for (const auto& entry : node_kernel_times_) {
+    total_kernel_time += entry.second;
+  }
+  min_chain_time_ = static_cast<double>(total_kernel_time) * min_time_percent / 100.0;
+}
+
+Status ElementwiseChainFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::unordered_map<NodeIndex, size_t> node_positions;
+  for (size_t i = 0; i < node_topology_list.size(); ++i) {
+    node_positions[node_topology_list[i]] = i;
+  }
+
+  auto get_kernel_time = [this](const Node& node) -> int64_t {
+    auto it = node_kernel_times_.find(node.Name());
+    return it != node_kernel_times_.end() ? it->second : 0;
+  };
+
+  for (size_t position = 0; position < node_topology_list.size(); ++position) {
+    auto* node_ptr = graph.GetNode(node_topology_list[position]);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    // the data input of the first node becomes input 0 of the fused node
+    NodeArg* chain_input = node.MutableInputDefs()[0];
+    ChainValues chain_values{chain_input, {chain_input}, node_positions, position};
+
+    ChainStep step;
+    if (!GetChainStep(graph, node, *chain_input, chain_values, step)) {
+      continue;
+    }
+
+    std::vector<std::reference_wrapper<Node>> chain{node};
+    std::vector<ChainStep> steps{step};
+    chain_values.values.insert(node.OutputDefs()[0]);
+
+    // extend the chain with a consumer of the output of the last node that applies an operation to it
+    for (;;) {
+      const Node& last_node = chain.back();
+      if (!graph.GetNodeOutputsInGraphOutputs(last_node).empty() ||
+          (node.GetExecutionProviderType() == kCudaExecutionProvider && chain.size() == kCudaMaxChainLength)) {
+        break;
+      }
+
+      Node* next_node = nullptr;
+      for (auto it = last_node.OutputNodesBegin(), end = last_node.OutputNodesEnd(); it != end; ++it) {
+        Node& candidate = *graph.GetNode(it->Index());
+        if (candidate.GetExecutionProviderType() == node.GetExecutionProviderType() &&
+            GetChainStep(graph, candidate, *last_node.OutputDefs()[0], chain_values, step)) {
+          next_node = &candidate;
+          break;
+        }
+      }
+
+      if (next_node == nullptr) {
+        break;
+      }
+
+      chain.push_back(*next_node);
+      steps.push_back(step);
+      chain_values.values.insert(next_node->OutputDefs()[0]);
+    }
+
+    // the intermediate results can't be used outside of the fused node
+    size_t chain_length = chain.size();
+    while (chain_length >= 2 && !IsSelfContainedChain(graph, chain, chain_length)) {
+      --chain_length;
+    }
+
+    if (chain_length < 2) {
+      continue;
+    }
+
+    chain.resize(chain_length);
+    steps.resize(chain_length);
+
+    int64_t chain_time = 0;
+    for (const Node& chain_node : chain) {
+      chain_time += get_kernel_time(chain_node);
+    }
+
+    if (static_cast<double>(chain_time) < min_chain_time_) {
+      continue;
+    }
+
+    // the tensors from outside of the chain follow the data input, then come the results of the nodes
+    std::vector<NodeArg*> inputs{chain_input};
+    std::unordered_map<const NodeArg*, int64_t> value_indices{{chain_input, 0}};
+    for (const auto& chain_step : steps) {
+      if (chain_step.operand != nullptr && chain_values.values.count(chain_step.operand) == 0 &&
+          value_indices.count(chain_step.operand) == 0) {
+        value_indices[chain_step.operand] = static_cast<int64_t>(inputs.size());
+        inputs.push_back(chain_step.operand);
+      }
+    }
+    for (size_t i = 0; i < chain.size(); ++i) {
+      value_indices[chain[i].get().OutputDefs()[0]] = static_cast<int64_t>(inputs.size() + i);
+    }
+
+    std::vector<std::string> ops;
+    std::vector<int64_t> operands;
+    std::vector<float> scalars;
+    std::vector<int64_t> operand_first;
+    for (const auto& chain_step : steps) {
+      ops.push_back(chain_step.op);
+      operands.push_back(chain_step.operand != nullptr ? value_indices[chain_step.operand] : -1);
+      scalars.push_back(chain_step.scalar);
+      operand_first.push_back(chain_step.operand_first ? 1 : 0);
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("FusedElementwise"),
+                                     "FusedElementwise",
+                                     "fused chain of elementwise nodes",
+                                     inputs,
+                                     {},
+                                     {},
+                                     kMSDomain);
+    fused_node.AddAttribute("ops", ops);
+    fused_node.AddAttribute("operands", operands);
+    fused_node.AddAttribute("scalars", scalars);
+    fused_node.AddAttribute("operand_first", operand_first);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    fused_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    // FinalizeNodeFusion only moves the input edges of the first node, which may not line up with the inputs of
+    // the fused node, so the edges from the producers of the inputs are added separately.
+    auto input_edges = node.GetRelationships().input_edges;
+    for (const auto& input_edge : input_edges) {
+      graph.RemoveEdge(input_edge.GetNode().Index(), node.Index(), input_edge.GetSrcArgIndex(),
+                       input_edge.GetDstArgIndex());
+    }
+
+    graph_utils::FinalizeNodeFusion(graph, chain, fused_node);
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      const Node* producer = graph.GetProducerNode(inputs[i]->Name());
+      if (producer != nullptr) {
+        const auto& producer_outputs = producer->OutputDefs();
+        for (size_t j = 0; j < producer_outputs.size(); ++j) {
+          if (producer_outputs[j] == inputs[i]) {
+            graph.AddEdge(producer->Index(), fused_node.Index(), static_cast<int>(j), static_cast<int>(i));
+          }
+        }
+      }
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
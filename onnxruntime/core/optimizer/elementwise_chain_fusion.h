@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ElementwiseChainFusion
+Fuse chains of float elementwise nodes into a single FusedElementwise node.
+
+Each node of a chain consumes the result of the node before it. The other operand of a binary node is a scalar
+constant, a value computed earlier in the chain, such as the input of Sigmoid in x * Sigmoid(x), or a tensor from
+outside of the chain that broadcasts to the shape of the chain.
+
+When guided by a profile of earlier runs, node_kernel_times holds the kernel time of the nodes in the profile,
+keyed by the node name. A chain of two or more nodes is then only fused if the kernel time of its nodes is at
+least min_time_percent of the total kernel time in the profile.
+*/
+class ElementwiseChainFusion : public GraphTransformer {
+ public:
+  explicit ElementwiseChainFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : ElementwiseChainFusion({}, 0.0, compatible_execution_providers) {}
+
+  ElementwiseChainFusion(std::unordered_map<std::string, int64_t> node_kernel_times,
+                         double min_time_percent,
+                         const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept;
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+ private:
+  std::unordered_map<std::string, int64_t> node_kernel_times_;
+  double min_chain_time_;
+};
+
+}  // namespace onnxruntime
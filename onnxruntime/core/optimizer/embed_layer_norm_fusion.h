@@ -18,6 +18,8 @@ class EmbedLayerNormFusion : public GraphTransformer {
   EmbedLayerNormFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
       : GraphTransformer("EmbedLayerNormFusion", compatible_execution_providers) {}
 
+  std::vector<std::string> TargetOpTypes() const override { return {"LayerNormalization"}; }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
@@ -21,6 +21,8 @@ class GeluFusion : public GraphTransformer {
   GeluFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
       : GraphTransformer("GeluFusion", compatible_execution_providers) {}
 
+  std::vector<std::string> TargetOpTypes() const override { return {"Div"}; }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
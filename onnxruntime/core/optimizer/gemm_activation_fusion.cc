@@ -36,6 +36,24 @@ bool IsFusableActivation(const Node& node) {
 #endif
          IsSupportedOptypeVersionAndDomain(node, "ThresholdedRelu", {1, 10}, kOnnxDomain);
 }
+
+// FusedGemm is registered for float on CPU, and for float, double and float16 on CUDA and ROCm.
+bool IsFusedGemmSupportedType(const Node& node) {
+  const auto* type = node.InputDefs()[0]->TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type()) {
+    return false;
+  }
+
+  const auto elem_type = type->tensor_type().elem_type();
+  if (node.GetExecutionProviderType() == kCudaExecutionProvider ||
+      node.GetExecutionProviderType() == kRocmExecutionProvider) {
+    return elem_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT ||
+           elem_type == ONNX_NAMESPACE::TensorProto_DataType_DOUBLE ||
+           elem_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT16;
+  }
+
+  return elem_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
+}
 }  // namespace
 
 Status GemmActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
@@ -52,7 +70,8 @@ Status GemmActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_l
     ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
 
     if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gemm", {7, 9, 11, 13}) ||
-        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) || node.GetOutputEdgesCount() != 1) {
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) || node.GetOutputEdgesCount() != 1 ||
+        !IsFusedGemmSupportedType(node)) {
       continue;
     }
 
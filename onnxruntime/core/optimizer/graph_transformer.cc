@@ -3,15 +3,48 @@
 
 #include "core/optimizer/graph_transformer.h"
 
+#include <algorithm>
+
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
 
+#if !defined(ORT_MINIMAL_BUILD)
+namespace {
+
+bool ContainsOpTypes(const Graph& graph, const std::vector<std::string>& op_types) {
+  if (std::any_of(op_types.cbegin(), op_types.cend(),
+                  [&graph](const std::string& op_type) { return graph.NumberOfNodesOfOpType(op_type) > 0; })) {
+    return true;
+  }
+
+  for (const auto& node : graph.Nodes()) {
+    if (node.ContainsSubgraph()) {
+      for (const auto& subgraph : node.GetSubgraphs()) {
+        if (ContainsOpTypes(*subgraph, op_types)) {
+          return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+}  // namespace
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 Status GraphTransformer::Apply(Graph& graph, bool& modified, const logging::Logger& logger) const {
   // the Graph should be in a good state prior this being called, so there should be no need to call Resolve here
   // ORT_RETURN_IF_ERROR(graph.Resolve());
 
 #if !defined(ORT_MINIMAL_BUILD)
+  // avoid the topological sort and walk of a large graph that has no node this transformer applies to
+  const auto op_types = TargetOpTypes();
+  if (!op_types.empty() && !ContainsOpTypes(graph, op_types)) {
+    return Status::OK();
+  }
+
   auto status = ApplyImpl(graph, modified, 0, logger);
   ORT_RETURN_IF_ERROR(status);
 
@@ -117,10 +117,11 @@ class NchwcTransformerImpl {
   void TransformPool(Node& node);
   void TransformBinary(Node& node, bool add_node);
   void TransformConcat(Node& node);
-  void TransformActivation(Node& node);
+  void TransformActivation(Node& node, bool fuse_node);
   void TransformBatchNormalization(Node& node);
   void TransformTranspose(Node& node);
   void TransformResize(Node& node);
+  void TransformFlatten(Node& node);
 
   Graph& graph_;
 
@@ -510,9 +511,9 @@ void NchwcTransformerImpl::TransformPool(Node& node) {
   removed_nodes_.push_front(node.Index());
 }
 
-// The existing Add/Sum operator implementations can be used with tensors
-// in NCHWc format if the tensor shapes are exactly the same (elementwise
-// add).
+// The existing Add/Sum/Mul/Sub operator implementations can be used with
+// tensors in NCHWc format if the tensor shapes are exactly the same
+// (elementwise add).
 void NchwcTransformerImpl::TransformBinary(Node& node, bool add_node) {
   auto& input_defs = node.MutableInputDefs();
 
@@ -646,8 +647,10 @@ void NchwcTransformerImpl::TransformConcat(Node& node) {
 
 // After doing a Conv/Add fusion, there may be an activation node that could now
 // be fused into the Conv node as well. Otherwise, this is an elementwise
-// operation that can directly use the NCHWc input.
-void NchwcTransformerImpl::TransformActivation(Node& node) {
+// operation that can directly use the NCHWc input. The values in the channels
+// that pad the NCHWc block are ignored by consumers, so the activation only
+// needs to map zero to a finite value.
+void NchwcTransformerImpl::TransformActivation(Node& node, bool fuse_node) {
   auto& input_defs = node.MutableInputDefs();
 
   auto it = nchwc_args_.find(input_defs[0]);
@@ -659,10 +662,19 @@ void NchwcTransformerImpl::TransformActivation(Node& node) {
     // Check if this is a single use NCHWc convolution that hasn't already
     // been fused with another activation.
     auto& nchwc_node = nchwc_input->output_node_;
-    if ((nchwc_node.OpType() == "Conv") && (nchwc_node.Domain() == kMSNchwcDomain) &&
+    if (fuse_node &&
+        (nchwc_node.OpType() == "Conv") && (nchwc_node.Domain() == kMSNchwcDomain) &&
         (nchwc_input->starting_original_uses_ == 1) &&
         (graph_utils::GetNodeAttribute(nchwc_node, "activation") == nullptr)) {
       nchwc_node.AddAttribute("activation", node.OpType());
+      if (node.OpType() == "LeakyRelu") {
+        const auto* alpha_attr = graph_utils::GetNodeAttribute(node, "alpha");
+        float alpha = 0.01f;
+        if (alpha_attr != nullptr && utils::HasFloat(*alpha_attr)) {
+          alpha = alpha_attr->f();
+        }
+        nchwc_node.AddAttribute("activation_params", std::vector<float>{alpha});
+      }
       FuseNchwcArgument(node, *nchwc_input);
       removed_nodes_.push_front(node.Index());
     } else {
@@ -927,6 +939,45 @@ void NchwcTransformerImpl::TransformResize(Node& node) {
   removed_nodes_.push_front(node.Index());
 }
 
+// A NCHWc tensor with a single spatial element and channels aligned to the
+// NCHWc block size has the same memory layout as the NCHW tensor, so a Flatten
+// to [N, C] can use the NCHWc tensor directly. This avoids reordering the
+// output of a global pooling node that feeds a classifier (Gemm/MatMul).
+void NchwcTransformerImpl::TransformFlatten(Node& node) {
+  auto& input_defs = node.MutableInputDefs();
+
+  // Don't transform the node if the input is not already in NCHWc format.
+  auto it = nchwc_args_.find(input_defs[0]);
+  if (it == nchwc_args_.end()) {
+    return;
+  }
+  auto* nchwc_input = it->second.get();
+
+  const auto* axis_attr = graph_utils::GetNodeAttribute(node, "axis");
+  if (axis_attr != nullptr && (!utils::HasInt(*axis_attr) || axis_attr->i() != 1)) {
+    return;
+  }
+
+  const size_t nchwc_block_size = MlasNchwcGetBlockSize();
+  if ((nchwc_input->channels_ % nchwc_block_size) != 0) {
+    return;
+  }
+
+  const auto* input_shape = input_defs[0]->Shape();
+  if ((input_shape == nullptr) || (input_shape->dim_size() != 4)) {
+    return;
+  }
+  for (int i = kNchwcBatchChannelDims; i < kNchwcDims; i++) {
+    auto& spatial_dim = input_shape->dim(i);
+    if (!utils::HasDimValue(spatial_dim) || (spatial_dim.dim_value() != 1)) {
+      return;
+    }
+  }
+
+  input_defs[0] = nchwc_input->nchwc_arg_;
+  nchwc_input->remaining_original_uses_--;
+}
+
 void NchwcTransformerImpl::Transform(Node& node) {
   if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Conv", {1, 11}) ||
       graph_utils::IsSupportedOptypeVersionAndDomain(node, "FusedConv", {1}, kMSDomain)) {
@@ -943,14 +994,21 @@ void NchwcTransformerImpl::Transform(Node& node) {
     if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13}) ||
         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sum", {6, 8, 13})) {
       TransformBinary(node, true);
-    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13})) {
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13})) {
       TransformBinary(node, false);
     } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Concat", {4, 11, 13})) {
       TransformConcat(node);
     } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13}) ||
                graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
-               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13})) {
-      TransformActivation(node);
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "LeakyRelu", {6})) {
+      TransformActivation(node, true);
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Clip", {6, 11, 12, 13}) ||
+               graph_utils::IsSupportedOptypeVersionAndDomain(node, "HardSigmoid", {6})) {
+      // These activations keep the NCHWc format but are not fused with a
+      // convolution.
+      TransformActivation(node, false);
     } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "BatchNormalization", {7, 9})) {
       TransformBatchNormalization(node);
     } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Transpose", {1, 13})) {
@@ -962,6 +1020,8 @@ void NchwcTransformerImpl::Transform(Node& node) {
                graph_utils::IsSupportedOptypeVersionAndDomain(node, "GlobalAveragePool", {1})) {
       // Convert these pooling types only if the input is already in NCHWc format.
       TransformPool(node);
+    } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Flatten", {1, 9, 11, 13})) {
+      TransformFlatten(node);
     }
   }
 
@@ -0,0 +1,326 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/qdq_fusion.h"
+
+#include <algorithm>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+struct QLinearOp {
+  std::string op_type;
+  std::string domain;
+  std::vector<ONNX_NAMESPACE::OperatorSetVersion> versions;
+  // the inputs of the float op that are dequantized, the other inputs are kept
+  size_t num_quantized_inputs;
+  // the kernel only supports uint8 activations, otherwise the inputs and the output have the same type
+  bool requires_uint8;
+};
+
+const std::unordered_map<std::string, QLinearOp> kQLinearOps{
+    {"Conv", {"QLinearConv", kOnnxDomain, {1, 11}, 2, true}},
+    {"MatMul", {"QLinearMatMul", kOnnxDomain, {1, 9, 13}, 2, true}},
+    {"Add", {"QLinearAdd", kMSDomain, {7, 13}, 2, false}},
+    {"Mul", {"QLinearMul", kMSDomain, {7, 13}, 2, false}},
+    {"Sigmoid", {"QLinearSigmoid", kMSDomain, {6, 13}, 1, false}},
+    {"LeakyRelu", {"QLinearLeakyRelu", kMSDomain, {6}, 1, false}},
+    {"GlobalAveragePool", {"QLinearGlobalAveragePool", kMSDomain, {1}, 1, true}},
+};
+
+// the ops that only move the elements of their first input, and have kernels for the quantized types
+const std::unordered_map<std::string, std::vector<ONNX_NAMESPACE::OperatorSetVersion>> kDataMovementOps{
+    {"Reshape", {5, 13}},
+    {"Transpose", {1, 13}},
+    {"Squeeze", {1, 11, 13}},
+    {"Unsqueeze", {1, 11, 13}},
+    {"Flatten", {1, 9, 11, 13}},
+    {"MaxPool", {12}},
+};
+
+int32_t GetElementType(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  if (type == nullptr || !utils::HasTensorType(*type) || !utils::HasElemType(type->tensor_type())) {
+    return TensorProto_DataType_UNDEFINED;
+  }
+
+  return type->tensor_type().elem_type();
+}
+
+// Returns the initializer of arg if it's a constant scalar or 1 element vector, or nullptr.
+const TensorProto* GetScalarConstant(const Graph& graph, const NodeArg& arg) {
+  if (!arg.Exists()) {
+    return nullptr;
+  }
+
+  const auto* tensor_proto = graph_utils::GetConstantInitializer(graph, arg.Name());
+  if (tensor_proto == nullptr || tensor_proto->dims_size() > 1 ||
+      (tensor_proto->dims_size() == 1 && tensor_proto->dims(0) != 1)) {
+    return nullptr;
+  }
+
+  return tensor_proto;
+}
+
+// Returns the quantized type of a DequantizeLinear or QuantizeLinear node with a constant scalar scale and zero point,
+// or UNDEFINED if it has other parameters.
+int32_t GetQuantizedType(const Graph& graph, const Node& node) {
+  const auto& inputs = node.InputDefs();
+  if (inputs.size() < 3 || GetScalarConstant(graph, *inputs[1]) == nullptr ||
+      GetScalarConstant(graph, *inputs[2]) == nullptr) {
+    return TensorProto_DataType_UNDEFINED;
+  }
+
+  return GetElementType(*inputs[2]);
+}
+
+bool IsQuantizedType(int32_t type) {
+  return type == TensorProto_DataType_UINT8 || type == TensorProto_DataType_INT8;
+}
+
+template <typename T>
+bool HaveSameScalarValue(const Graph& graph, const NodeArg& a, const NodeArg& b) {
+  const auto* a_proto = GetScalarConstant(graph, a);
+  const auto* b_proto = GetScalarConstant(graph, b);
+  T a_value;
+  T b_value;
+  return a_proto != nullptr && b_proto != nullptr &&
+         utils::UnpackTensor(*a_proto, graph.ModelPath(), &a_value, 1).IsOK() &&
+         utils::UnpackTensor(*b_proto, graph.ModelPath(), &b_value, 1).IsOK() &&
+         a_value == b_value;
+}
+
+// Returns true if a DequantizeLinear and a QuantizeLinear node use the same scale and zero point, so that the
+// quantized values are unchanged by the pair.
+bool HaveSameQuantParams(const Graph& graph, const Node& dq, const Node& q) {
+  const int32_t type = GetQuantizedType(graph, dq);
+  if (!IsQuantizedType(type) || type != GetQuantizedType(graph, q) ||
+      !HaveSameScalarValue<float>(graph, *dq.InputDefs()[1], *q.InputDefs()[1])) {
+    return false;
+  }
+
+  return type == TensorProto_DataType_UINT8
+             ? HaveSameScalarValue<uint8_t>(graph, *dq.InputDefs()[2], *q.InputDefs()[2])
+             : HaveSameScalarValue<int8_t>(graph, *dq.InputDefs()[2], *q.InputDefs()[2]);
+}
+
+template <typename T>
+bool AllValuesEqual(const Graph& graph, const TensorProto& tensor_proto, size_t size) {
+  std::vector<T> values(size);
+  return utils::UnpackTensor(tensor_proto, graph.ModelPath(), values.data(), size).IsOK() &&
+         std::all_of(values.begin(), values.end(), [&values](T value) { return value == values[0]; });
+}
+
+// Returns the quantized type of the DequantizeLinear node of a Conv weight, which may be per output channel as long
+// as the zero point is the same for all the channels, or UNDEFINED.
+int32_t GetConvWeightQuantizedType(const Graph& graph, const Node& dq) {
+  const int32_t type = GetQuantizedType(graph, dq);
+  if (type != TensorProto_DataType_UNDEFINED) {
+    return type;
+  }
+
+  const auto& inputs = dq.InputDefs();
+  const auto* axis = graph_utils::GetNodeAttribute(dq, "axis");
+  if (inputs.size() < 3 || axis == nullptr || axis->i() != 0) {
+    return TensorProto_DataType_UNDEFINED;
+  }
+
+  const auto* scale = graph_utils::GetConstantInitializer(graph, inputs[1]->Name());
+  const auto* zero_point = graph_utils::GetConstantInitializer(graph, inputs[2]->Name());
+  if (scale == nullptr || zero_point == nullptr || scale->dims_size() != 1 || zero_point->dims_size() != 1 ||
+      scale->dims(0) != zero_point->dims(0)) {
+    return TensorProto_DataType_UNDEFINED;
+  }
+
+  const size_t size = static_cast<size_t>(zero_point->dims(0));
+  const int32_t zero_point_type = zero_point->data_type();
+  if ((zero_point_type == TensorProto_DataType_UINT8 && AllValuesEqual<uint8_t>(graph, *zero_point, size)) ||
+      (zero_point_type == TensorProto_DataType_INT8 && AllValuesEqual<int8_t>(graph, *zero_point, size))) {
+    return zero_point_type;
+  }
+
+  return TensorProto_DataType_UNDEFINED;
+}
+
+// Returns the QuantizeLinear node that is the only consumer of the only output of node, or nullptr.
+const Node* GetOutputQuantizeLinear(const Graph& graph, const Node& node,
+                                    const std::unordered_set<std::string>& compatible_providers) {
+  const auto& outputs = node.OutputDefs();
+  if (!optimizer_utils::CheckOutputEdges(graph, node, 1) ||
+      std::any_of(outputs.begin() + 1, outputs.end(), [](const NodeArg* output) { return output->Exists(); })) {
+    return nullptr;
+  }
+
+  const Node& q = node.OutputEdgesBegin()->GetNode();
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(q, "QuantizeLinear", {10, 13}) ||
+      !graph_utils::IsSupportedProvider(q, compatible_providers)) {
+    return nullptr;
+  }
+
+  return &q;
+}
+
+// Returns the DequantizeLinear node producing an input of node, or nullptr.
+const Node* GetInputDequantizeLinear(const Node& node, int arg_index,
+                                     const std::unordered_set<std::string>& compatible_providers) {
+  const Node* dq = graph_utils::GetInputNode(node, arg_index);
+  if (dq == nullptr || !graph_utils::IsSupportedOptypeVersionAndDomain(*dq, "DequantizeLinear", {10, 13}) ||
+      !graph_utils::IsSupportedProvider(*dq, compatible_providers)) {
+    return nullptr;
+  }
+
+  return dq;
+}
+
+// A DequantizeLinear node is removed with the node it feeds if no other node or graph output uses its output.
+bool IsOnlyUsedBy(const Graph& graph, const Node& dq, const Node& node) {
+  return graph.GetNodeOutputsInGraphOutputs(dq).empty() &&
+         std::all_of(dq.OutputEdgesBegin(), dq.OutputEdgesEnd(),
+                     [&node](const Node::EdgeEnd& edge) { return edge.GetNode().Index() == node.Index(); });
+}
+
+}  // namespace
+
+Status QDQFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+  std::vector<NodeIndex> nodes_to_remove;
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        (node.Domain() != kOnnxDomain && node.Domain() != kOnnxDomainAlias)) {
+      continue;
+    }
+
+    const Node* q = GetOutputQuantizeLinear(graph, node, GetCompatibleExecutionProviders());
+    if (q == nullptr) {
+      continue;
+    }
+
+    const auto data_movement_op = kDataMovementOps.find(node.OpType());
+    if (data_movement_op != kDataMovementOps.end()) {
+      //   DequantizeLinear -> Reshape -> QuantizeLinear   ---->   Reshape
+      // the quantized values are moved as is if the DequantizeLinear and QuantizeLinear nodes cancel each other out
+      const Node* dq = GetInputDequantizeLinear(node, 0, GetCompatibleExecutionProviders());
+      if (!graph_utils::MatchesOpSinceVersion(node, data_movement_op->second) || dq == nullptr ||
+          !HaveSameQuantParams(graph, *dq, *q)) {
+        continue;
+      }
+
+      std::vector<NodeArg*> input_defs = node.MutableInputDefs();
+      input_defs[0] = graph.GetNode(dq->Index())->MutableInputDefs()[0];
+      Node& new_node = graph.AddNode(node.Name(), node.OpType(), "", input_defs,
+                                     graph.GetNode(q->Index())->MutableOutputDefs(), &node.GetAttributes(),
+                                     node.Domain());
+      new_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+      if (IsOnlyUsedBy(graph, *dq, node)) {
+        nodes_to_remove.push_back(dq->Index());
+      }
+      nodes_to_remove.push_back(node.Index());
+      nodes_to_remove.push_back(q->Index());
+      continue;
+    }
+
+    const auto qlinear_op = kQLinearOps.find(node.OpType());
+    if (qlinear_op == kQLinearOps.end() ||
+        !graph_utils::MatchesOpSinceVersion(node, qlinear_op->second.versions)) {
+      continue;
+    }
+
+    //   DequantizeLinear   DequantizeLinear
+    //          \                 /
+    //            -->  Conv  <--                ---->   QLinearConv
+    //                  |
+    //            QuantizeLinear
+    const QLinearOp& op = qlinear_op->second;
+    const auto& node_inputs = node.InputDefs();
+    const int32_t output_type = GetQuantizedType(graph, *q);
+    bool can_fuse = node_inputs.size() >= op.num_quantized_inputs && IsQuantizedType(output_type) &&
+                    (!op.requires_uint8 || output_type == TensorProto_DataType_UINT8);
+
+    std::vector<const Node*> dq_nodes;
+    for (size_t i = 0; can_fuse && i < op.num_quantized_inputs; ++i) {
+      const Node* dq = GetInputDequantizeLinear(node, static_cast<int>(i), GetCompatibleExecutionProviders());
+      if (dq == nullptr) {
+        can_fuse = false;
+        break;
+      }
+
+      // the weight of QLinearConv and QLinearMatMul may be int8, their activations are uint8
+      const bool is_weight = op.requires_uint8 && i == 1;
+      const int32_t type = is_weight && node.OpType() == "Conv" ? GetConvWeightQuantizedType(graph, *dq)
+                                                                 : GetQuantizedType(graph, *dq);
+      can_fuse = is_weight ? IsQuantizedType(type) : type == output_type;
+      dq_nodes.push_back(dq);
+    }
+
+    // the bias of QLinearConv is int32, with the scale of the input times the scale of the weight
+    const Node* bias_dq = nullptr;
+    if (can_fuse && node.OpType() == "Conv" && node_inputs.size() > 2 && node_inputs[2]->Exists()) {
+      bias_dq = GetInputDequantizeLinear(node, 2, GetCompatibleExecutionProviders());
+      can_fuse = bias_dq != nullptr && GetElementType(*bias_dq->InputDefs()[0]) == TensorProto_DataType_INT32;
+    }
+
+    if (!can_fuse) {
+      continue;
+    }
+
+    std::vector<NodeArg*> input_defs;
+    for (const Node* dq : dq_nodes) {
+      const auto& dq_inputs = graph.GetNode(dq->Index())->MutableInputDefs();
+      input_defs.insert(input_defs.end(), dq_inputs.begin(), dq_inputs.begin() + 3);
+    }
+    const auto& q_inputs = graph.GetNode(q->Index())->MutableInputDefs();
+    input_defs.push_back(q_inputs[1]);
+    input_defs.push_back(q_inputs[2]);
+    if (bias_dq != nullptr) {
+      input_defs.push_back(graph.GetNode(bias_dq->Index())->MutableInputDefs()[0]);
+      dq_nodes.push_back(bias_dq);
+    }
+
+    Node& fused_node = graph.AddNode(node.Name(), op.op_type, "", input_defs,
+                                     graph.GetNode(q->Index())->MutableOutputDefs(), &node.GetAttributes(),
+                                     op.domain);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    fused_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    // the same DequantizeLinear node may feed several inputs, e.g. of Mul(x, x)
+    for (size_t i = 0; i < dq_nodes.size(); ++i) {
+      if (std::find(dq_nodes.begin(), dq_nodes.begin() + i, dq_nodes[i]) == dq_nodes.begin() + i &&
+          IsOnlyUsedBy(graph, *dq_nodes[i], node)) {
+        nodes_to_remove.push_back(dq_nodes[i]->Index());
+      }
+    }
+    nodes_to_remove.push_back(node.Index());
+    nodes_to_remove.push_back(q->Index());
+  }
+
+  modified = modified || !nodes_to_remove.empty();
+
+  for (auto node_index : nodes_to_remove) {
+    Node& node = *graph.GetNode(node_index);
+    graph_utils::RemoveNodeOutputEdges(graph, node);
+    graph.RemoveNode(node_index);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
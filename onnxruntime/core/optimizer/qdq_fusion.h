@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class QDQFusion
+
+Execute the QDQ form of quantized models, as exported from quantization-aware training, with the integer kernels.
+
+The groups of DequantizeLinear nodes feeding an op whose output only feeds a QuantizeLinear node are fused into the
+QLinear op: Conv, MatMul, Add, Mul, Sigmoid, LeakyRelu and GlobalAveragePool become QLinearConv, QLinearMatMul,
+QLinearAdd, QLinearMul, QLinearSigmoid, QLinearLeakyRelu and QLinearGlobalAveragePool.
+
+The quantization is propagated through the ops that only move data, e.g., Reshape, Transpose and MaxPool: the
+DequantizeLinear and QuantizeLinear nodes around them are removed when they use the same scale and zero point.
+
+The scales and zero points must be constant, and scalars except for the per-channel weights of Conv.
+*/
+class QDQFusion : public GraphTransformer {
+ public:
+  QDQFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("QDQFusion", compatible_execution_providers) {
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/scaler_fusion.h"
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+bool IsImputer(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Imputer", {1}, kMLDomain);
+}
+
+// A Scaler without a scale fails in its kernel, so it isn't fused into a node that would skip it.
+bool IsScaler(const Node& node) {
+  const auto* scale = graph_utils::GetNodeAttribute(node, "scale");
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Scaler", {1}, kMLDomain) &&
+         scale != nullptr && scale->floats_size() > 0;
+}
+
+bool IsNormalizer(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Normalizer", {1}, kMLDomain);
+}
+
+// The kernel processes rows of features, which is what the ops do for inputs of rank 1 or 2.
+bool HasSupportedInput(const Node& node) {
+  const auto* shape = node.InputDefs()[0]->Shape();
+  return shape != nullptr && (shape->dim_size() == 1 || shape->dim_size() == 2);
+}
+
+// The fused kernel imputes float values only.
+bool IsFloatImputer(const Node& node) {
+  const auto* type = node.InputDefs()[0]->TypeAsProto();
+  const auto* imputed_values = graph_utils::GetNodeAttribute(node, "imputed_value_floats");
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT &&
+         imputed_values != nullptr && imputed_values->floats_size() > 0;
+}
+
+// Returns the only consumer of the output of node if it may be fused with node, or nullptr.
+Node* GetFusableNextNode(Graph& graph, const Node& node) {
+  if (node.GetOutputEdgesCount() != 1 || !graph.GetNodeOutputsInGraphOutputs(node).empty()) {
+    return nullptr;
+  }
+
+  const Node& next_node = *node.OutputNodesBegin();
+  if (next_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+    return nullptr;
+  }
+  return graph.GetNode(next_node.Index());
+}
+
+void AddRenamedAttribute(const Node& node, const std::string& attr_name, const std::string& new_name,
+                         Node& fused_node) {
+  const auto* attr = graph_utils::GetNodeAttribute(node, attr_name);
+  if (attr != nullptr) {
+    AttributeProto fused_attr(*attr);
+    fused_attr.set_name(new_name);
+    fused_node.AddAttribute(new_name, fused_attr);
+  }
+}
+
+}  // namespace
+
+Status ScalerFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto index : order) {
+    auto* node_ptr = graph.GetNode(index);
+    if (!node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) || !HasSupportedInput(node)) {
+      continue;
+    }
+
+    Node* imputer = nullptr;
+    Node* scaler = nullptr;
+    Node* normalizer = nullptr;
+    Node* next_node = &node;
+    if (IsImputer(*next_node)) {
+      if (!IsFloatImputer(*next_node)) {
+        continue;
+      }
+      imputer = next_node;
+      next_node = GetFusableNextNode(graph, *next_node);
+    }
+    if (next_node != nullptr && IsScaler(*next_node)) {
+      scaler = next_node;
+      next_node = GetFusableNextNode(graph, *next_node);
+    }
+    if (next_node != nullptr && IsNormalizer(*next_node)) {
+      normalizer = next_node;
+    }
+
+    std::vector<std::reference_wrapper<Node>> nodes;
+    for (Node* chain_node : {imputer, scaler, normalizer}) {
+      if (chain_node != nullptr) {
+        nodes.push_back(*chain_node);
+      }
+    }
+    // a single op is left as it is
+    if (nodes.size() < 2 || &nodes.front().get() != &node) {
+      continue;
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("FusedScaler"), "FusedScaler",
+                                     "fused Imputer, Scaler and Normalizer", node.MutableInputDefs(), {}, nullptr,
+                                     kMSDomain);
+    if (imputer != nullptr) {
+      AddRenamedAttribute(*imputer, "imputed_value_floats", "imputed_values", fused_node);
+      AddRenamedAttribute(*imputer, "replaced_value_float", "replaced_value", fused_node);
+    }
+    if (scaler != nullptr) {
+      AddRenamedAttribute(*scaler, "scale", "scale", fused_node);
+      AddRenamedAttribute(*scaler, "offset", "offset", fused_node);
+    }
+    if (normalizer != nullptr) {
+      // the norm of Normalizer defaults to MAX
+      const auto* norm = graph_utils::GetNodeAttribute(*normalizer, "norm");
+      fused_node.AddAttribute("norm", norm != nullptr ? norm->s() : std::string("MAX"));
+    }
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    fused_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, nodes, fused_node);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ScalerFusion
+Fuse a chain of the ai.onnx.ml per-feature ops Imputer -> Scaler -> Normalizer, of which at least two of the three
+are present in that order, into a single FusedScaler node. The fused kernel transforms each row in one pass without
+the intermediate tensors. Only chains with a float Imputer and an input of rank 1 or 2 are fused.
+*/
+class ScalerFusion : public GraphTransformer {
+ public:
+  ScalerFusion(const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ScalerFusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
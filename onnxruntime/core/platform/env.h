@@ -52,6 +52,15 @@ class EnvThread {
   virtual ~EnvThread() = default;
 };
 
+// How the idle threads of a thread pool that allows spinning wait for work.
+// kFixed spins for a fixed number of iterations before blocking. kLatency and kEfficiency size the spin window from
+// the observed gaps between work items; kEfficiency uses a shorter window so that idle pools block sooner.
+enum class SpinPolicy : uint8_t {
+  kFixed,
+  kLatency,
+  kEfficiency
+};
+
 // Parameters that are required to create a set of threads for a thread pool
 struct ThreadOptions {
   // Stack size for a new thread. If it is 0, the operating system uses the same value as the stack that's specified for
@@ -68,6 +77,9 @@ struct ThreadOptions {
 
   // Set or unset denormal as zero.
   bool set_denormal_as_zero = false;
+
+  // Spin policy of the threads. Has no effect if the thread pool doesn't allow spinning.
+  SpinPolicy spin_policy = SpinPolicy::kFixed;
 };
 /// \brief An interface used by the onnxruntime implementation to
 /// access operating system functionality like the filesystem etc.
@@ -111,6 +123,10 @@ class Env {
   // This function doesn't support systems with more than 64 logical processors
   virtual std::vector<size_t> GetThreadAffinityMasks() const = 0;
 
+  // Returns the ids of the logical processors that belong to the NUMA node numa_node.
+  // The result is empty if the node doesn't exist or the platform doesn't expose its NUMA topology.
+  virtual std::vector<size_t> GetNumaNodeProcessors(int /*numa_node*/) const { return {}; }
+
   /// \brief Returns the number of micro-seconds since the Unix epoch.
   virtual uint64_t NowMicros() const {
     return env_time_->NowMicros();
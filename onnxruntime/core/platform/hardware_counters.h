@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+
+namespace onnxruntime {
+
+/**
+ * Values of the hardware event counters. The cache counters are the generic cache references and misses of the
+ * kernel's perf events, which most processors map to the last level cache.
+ */
+struct HardwareCounterValues {
+  uint64_t instructions = 0;
+  uint64_t cycles = 0;
+  uint64_t cache_references = 0;
+  uint64_t cache_misses = 0;
+
+  HardwareCounterValues& operator-=(const HardwareCounterValues& rhs) {
+    instructions -= rhs.instructions;
+    cycles -= rhs.cycles;
+    cache_references -= rhs.cache_references;
+    cache_misses -= rhs.cache_misses;
+    return *this;
+  }
+};
+
+/**
+ * Hardware event counters of the threads of the process, collected with perf_event_open on Linux. The threads that
+ * execute kernels register themselves, e.g. the thread of an executor and the thread pool threads that run a
+ * parallel loop, and ReadHardwareCounters returns the sum over all of them so the work of a kernel that is split
+ * over the thread pool is attributed to the kernel.
+ * Only the user space events are counted, so perf_event_paranoid must be 2 or less.
+ */
+
+// Enable the collection for the process. Returns false if the platform or the processor doesn't support the
+// counters, or the process is not permitted to open them. Thread-safe.
+bool EnableHardwareCounters();
+
+// Whether EnableHardwareCounters succeeded.
+bool HardwareCountersEnabled();
+
+// Open the counters of the calling thread if the collection is enabled and they are not open yet.
+void RegisterThreadForHardwareCounters();
+
+// The sum of the counters of the registered threads since they were registered, including the threads that exited.
+HardwareCounterValues ReadHardwareCounters();
+
+}  // namespace onnxruntime
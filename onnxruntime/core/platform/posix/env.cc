@@ -26,6 +26,7 @@ limitations under the License.
 #include <fcntl.h>
 #include <dlfcn.h>
 #include <ftw.h>
+#include <fstream>
 #include <string.h>
 #include <thread>
 #include <utility>  // for std::forward
@@ -49,6 +50,28 @@ class UnmapFileParam {
   size_t len;
 };
 
+#if defined(__linux__) && !defined(__ANDROID__)
+// Reads a sysfs list of logical processors of the form "0-3,8-11".
+// Returns an empty vector if the file doesn't exist.
+std::vector<size_t> ReadCpuList(const std::string& path) {
+  std::vector<size_t> ret;
+  std::ifstream cpulist_file(path);
+  std::string range;
+  while (std::getline(cpulist_file, range, ',')) {
+    size_t first = 0;
+    size_t last = 0;
+    int n = sscanf(range.c_str(), "%zu-%zu", &first, &last);
+    if (n < 1)
+      continue;
+    if (n == 1)
+      last = first;
+    for (size_t cpu = first; cpu <= last; ++cpu)
+      ret.push_back(cpu);
+  }
+  return ret;
+}
+#endif
+
 static void UnmapFile(void* param) noexcept {
   UnmapFileParam* p = reinterpret_cast<UnmapFileParam*>(param);
   int ret = munmap(p->addr, p->len);
@@ -195,11 +218,38 @@ class PosixEnv : public Env {
   }
 
   std::vector<size_t> GetThreadAffinityMasks() const override {
+#if defined(__linux__) && !defined(__ANDROID__)
+    // On hybrid CPUs the kernel lists the logical processors of the performance cores separately.
+    // Use one processor per performance core so that the threads don't wait for the slower
+    // efficiency cores at the end of every parallel loop.
+    std::vector<size_t> performance_cpus = ReadCpuList("/sys/devices/cpu_core/cpus");
+    if (!performance_cpus.empty()) {
+      std::vector<size_t> ret;
+      for (size_t cpu : performance_cpus) {
+        std::vector<size_t> siblings =
+            ReadCpuList("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/thread_siblings_list");
+        if (siblings.empty() || siblings[0] == cpu)
+          ret.push_back(cpu);
+      }
+      return ret;
+    }
+#endif
     std::vector<size_t> ret(std::thread::hardware_concurrency() / 2);
     std::iota(ret.begin(), ret.end(), 0);
     return ret;
   }
 
+  std::vector<size_t> GetNumaNodeProcessors(int numa_node) const override {
+    std::vector<size_t> ret;
+#if defined(__linux__) && !defined(__ANDROID__)
+    if (numa_node >= 0)
+      ret = ReadCpuList("/sys/devices/system/node/node" + std::to_string(numa_node) + "/cpulist");
+#else
+    ORT_UNUSED_PARAMETER(numa_node);
+#endif
+    return ret;
+  }
+
   void SleepForMicroseconds(int64_t micros) const override {
     while (micros > 0) {
       timespec sleep_time;
@@ -0,0 +1,201 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/platform/hardware_counters.h"
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include "core/platform/ort_mutex.h"
+#endif
+
+namespace onnxruntime {
+
+#if defined(__linux__) && !defined(__ANDROID__)
+namespace {
+
+constexpr int kNumCounters = 4;
+constexpr uint64_t kCounterConfigs[kNumCounters] = {PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES,
+                                                    PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES};
+
+// the counters of a thread, read together as a group
+class ThreadCounters {
+ public:
+  ~ThreadCounters();
+
+  bool Open();
+  bool Read(HardwareCounterValues& values) const;
+
+ private:
+  int fds_[kNumCounters] = {-1, -1, -1, -1};
+};
+
+struct Registry {
+  std::atomic<bool> enabled{false};
+  OrtMutex mutex;
+  std::vector<const ThreadCounters*> threads;
+  // the final values of the threads that exited
+  HardwareCounterValues exited;
+};
+
+// never destroyed, as the counters of a thread are closed when it exits, which may be after static destruction
+Registry& GetRegistry() {
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+void Add(HardwareCounterValues& sum, const HardwareCounterValues& values) {
+  sum.instructions += values.instructions;
+  sum.cycles += values.cycles;
+  sum.cache_references += values.cache_references;
+  sum.cache_misses += values.cache_misses;
+}
+
+bool ThreadCounters::Open() {
+  for (int i = 0; i < kNumCounters; ++i) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = kCounterConfigs[i];
+    attr.read_format = PERF_FORMAT_GROUP;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    // count the calling thread on any cpu. the first counter is the leader of the group
+    fds_[i] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds_[0], 0));
+    if (fds_[i] < 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool ThreadCounters::Read(HardwareCounterValues& values) const {
+  // layout of a group read with PERF_FORMAT_GROUP: the number of counters followed by their values
+  uint64_t buffer[1 + kNumCounters];
+  if (fds_[0] < 0 || read(fds_[0], buffer, sizeof(buffer)) != static_cast<ssize_t>(sizeof(buffer)) ||
+      buffer[0] != kNumCounters) {
+    return false;
+  }
+
+  values.instructions = buffer[1];
+  values.cycles = buffer[2];
+  values.cache_references = buffer[3];
+  values.cache_misses = buffer[4];
+  return true;
+}
+
+ThreadCounters::~ThreadCounters() {
+  if (fds_[0] >= 0) {
+    auto& registry = GetRegistry();
+    std::lock_guard<OrtMutex> lock(registry.mutex);
+    for (auto it = registry.threads.begin(); it != registry.threads.end(); ++it) {
+      if (*it == this) {
+        HardwareCounterValues values;
+        if (Read(values)) {
+          Add(registry.exited, values);
+        }
+        registry.threads.erase(it);
+        break;
+      }
+    }
+  }
+
+  for (int fd : fds_) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+}
+
+void RegisterThread(ThreadCounters& counters) {
+  auto& registry = GetRegistry();
+  std::lock_guard<OrtMutex> lock(registry.mutex);
+  registry.threads.push_back(&counters);
+}
+
+// the counters of the calling thread. opened at most once.
+struct CurrentThreadCounters {
+  ThreadCounters counters;
+  bool opened = false;
+  bool failed = false;
+};
+
+thread_local CurrentThreadCounters current_thread_counters;
+
+// returns false if the counters of the calling thread can't be opened
+bool OpenCurrentThreadCounters() {
+  auto& tc = current_thread_counters;
+  if (!tc.opened && !tc.failed) {
+    tc.failed = !tc.counters.Open();
+    tc.opened = !tc.failed;
+    if (tc.opened) {
+      RegisterThread(tc.counters);
+    }
+  }
+
+  return tc.opened;
+}
+
+}  // namespace
+
+bool EnableHardwareCounters() {
+  auto& registry = GetRegistry();
+  if (registry.enabled.load(std::memory_order_acquire)) {
+    return true;
+  }
+
+  // probe with the counters of the calling thread
+  if (!OpenCurrentThreadCounters()) {
+    return false;
+  }
+
+  registry.enabled.store(true, std::memory_order_release);
+  return true;
+}
+
+bool HardwareCountersEnabled() {
+  return GetRegistry().enabled.load(std::memory_order_relaxed);
+}
+
+void RegisterThreadForHardwareCounters() {
+  if (HardwareCountersEnabled()) {
+    OpenCurrentThreadCounters();
+  }
+}
+
+HardwareCounterValues ReadHardwareCounters() {
+  auto& registry = GetRegistry();
+  std::lock_guard<OrtMutex> lock(registry.mutex);
+  HardwareCounterValues sum = registry.exited;
+  for (const auto* counters : registry.threads) {
+    HardwareCounterValues values;
+    if (counters->Read(values)) {
+      Add(sum, values);
+    }
+  }
+
+  return sum;
+}
+
+#else
+
+bool EnableHardwareCounters() { return false; }
+
+bool HardwareCountersEnabled() { return false; }
+
+void RegisterThreadForHardwareCounters() {}
+
+HardwareCounterValues ReadHardwareCounters() { return {}; }
+
+#endif
+
+}  // namespace onnxruntime
@@ -0,0 +1,17 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/platform/hardware_counters.h"
+
+namespace onnxruntime {
+
+// not supported. the counters are available to ETW consumers, e.g. with wpr -pmc, instead.
+bool EnableHardwareCounters() { return false; }
+
+bool HardwareCountersEnabled() { return false; }
+
+void RegisterThreadForHardwareCounters() {}
+
+HardwareCounterValues ReadHardwareCounters() { return {}; }
+
+}  // namespace onnxruntime
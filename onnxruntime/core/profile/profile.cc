@@ -59,7 +59,51 @@ void NvtxMarkerCreator::Mark() {
   nvtxMarkEx(&eventAttrib); 
 }
 
-}  // namespace contrib
+static Color TraceCategoryColor(tracing::Category category) {
+  switch (category) {
+    case tracing::Category::kNode:
+      return Color::Yellow;
+    case tracing::Category::kParallelSection:
+    case tracing::Category::kParallelFor:
+      return Color::Cyan;
+    default:
+      return Color::Magenta;
+  }
+}
+
+void NvtxTraceSink::Begin(tracing::Category category, const char* name, const char* detail) {
+  nvtxEventAttributes_t eventAttrib = {};
+  eventAttrib.version = NVTX_VERSION;
+  eventAttrib.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
+  eventAttrib.colorType = NVTX_COLOR_ARGB;
+  eventAttrib.color = static_cast<uint32_t>(TraceCategoryColor(category));
+  eventAttrib.messageType = NVTX_MESSAGE_TYPE_ASCII;
+  // nameless nodes are reported with their op type
+  eventAttrib.message.ascii = (name != nullptr && name[0] != '\0') ? name
+                                                                   : (detail ? detail : tracing::CategoryName(category));
+
+  nvtxRangePushEx(&eventAttrib);
+}
+
+void NvtxTraceSink::End(tracing::Category /*category*/, const char* /*name*/) {
+  nvtxRangePop();
+}
+
+void NvtxTraceSink::Instant(tracing::Category category, const char* name, int64_t value) {
+  const std::string message = std::string(name ? name : tracing::CategoryName(category)) + " " +
+                              std::to_string(value);
+  nvtxEventAttributes_t eventAttrib = {};
+  eventAttrib.version = NVTX_VERSION;
+  eventAttrib.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
+  eventAttrib.colorType = NVTX_COLOR_ARGB;
+  eventAttrib.color = static_cast<uint32_t>(TraceCategoryColor(category));
+  eventAttrib.messageType = NVTX_MESSAGE_TYPE_ASCII;
+  eventAttrib.message.ascii = message.c_str();
+
+  nvtxMarkEx(&eventAttrib);
+}
+
+}  // namespace profile
 }  // namespace onnxruntime
 
 #endif
\ No newline at end of file
@@ -17,6 +17,7 @@
 #include <string>
 
 #include "core/common/common.h"
+#include "core/common/trace_sink.h"
 
 namespace onnxruntime {
 namespace profile {
@@ -135,6 +136,15 @@ class NvtxMarkerCreator final {
   const Color color_;
 };
 
+// Reports the tracing events as nested NVTX ranges and marks, so the CPU side of node execution, thread pool
+// activity and arena extends line up with the CUDA kernels and memcpys in Nsight Systems.
+class NvtxTraceSink final : public tracing::ITraceSink {
+ public:
+  void Begin(tracing::Category category, const char* name, const char* detail) override;
+  void End(tracing::Category category, const char* name) override;
+  void Instant(tracing::Category category, const char* name, int64_t value) override;
+};
+
 }  // namespace profile
 }  // namespace onnxruntime
 
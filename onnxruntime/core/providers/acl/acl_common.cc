@@ -8,6 +8,8 @@
 
 #include "core/providers/acl/acl_common.h"
 
+#include <cstring>
+
 #include "arm_compute/runtime/PoolManager.h"
 #include "arm_compute/runtime/BlobLifetimeManager.h"
 
@@ -59,42 +61,46 @@ arm_compute::Status ACLImportMemory(arm_compute::TensorAllocator* allocator, voi
 #endif
 }
 
-template <typename T>
-void importDataToTensor(arm_compute::Tensor* tensor, const T* data){
-
-  arm_compute::Window aclInpuWindow;
-  aclInpuWindow.use_tensor_dimensions(tensor->info()->tensor_shape());
+// Window over the rows of a tensor. The elements of a row are contiguous in the buffer of the tensor, which only has
+// padding between the rows, so the rows are copied with memcpy instead of one element at a time.
+static arm_compute::Window ACLRowWindow(const arm_compute::Tensor* tensor) {
+  arm_compute::Window window;
+  window.use_tensor_dimensions(tensor->info()->tensor_shape());
+  window.set(arm_compute::Window::DimX, arm_compute::Window::Dimension(0, 1, 1));
+  return window;
+}
 
-  arm_compute::Iterator aclInputIt(tensor, aclInpuWindow);
-  int index = 0;
+template <typename T>
+void importDataToTensor(arm_compute::Tensor* tensor, const T* data) {
+  const size_t row_size = tensor->info()->dimension(0);
+  arm_compute::Window aclInputWindow = ACLRowWindow(tensor);
+  arm_compute::Iterator aclInputIt(tensor, aclInputWindow);
 
   // copy input tensor into the larger buffer
   arm_compute::execute_window_loop(
-      aclInpuWindow,
-      [&](const arm_compute::Coordinates& co) {
-        *reinterpret_cast<float*>(aclInputIt.ptr()) = data[index];
-        index++;
+      aclInputWindow,
+      [&](const arm_compute::Coordinates&) {
+        memcpy(aclInputIt.ptr(), data, row_size * sizeof(T));
+        data += row_size;
       },
       aclInputIt);
 }
 template void importDataToTensor<float>(arm_compute::Tensor*, const float*);
 
 template <typename T>
-void importDataFromTensor(arm_compute::Tensor* tensor, T* data){
-
-  arm_compute::Window aclInpuWindow;
-  aclInpuWindow.use_tensor_dimensions(tensor->info()->tensor_shape());
+void importDataFromTensor(arm_compute::Tensor* tensor, T* data) {
+  const size_t row_size = tensor->info()->dimension(0);
+  arm_compute::Window aclOutputWindow = ACLRowWindow(tensor);
+  arm_compute::Iterator aclOutputIt(tensor, aclOutputWindow);
 
-  arm_compute::Iterator aclInputIt(tensor, aclInpuWindow);
-  int index = 0;
-  // copy input tensor into the larger buffer
+  // copy the larger buffer into the output tensor
   arm_compute::execute_window_loop(
-      aclInpuWindow,
-      [&](const arm_compute::Coordinates& co) {
-        data[index] = *reinterpret_cast<float*>(aclInputIt.ptr());
-        index++;
+      aclOutputWindow,
+      [&](const arm_compute::Coordinates&) {
+        memcpy(data, aclOutputIt.ptr(), row_size * sizeof(T));
+        data += row_size;
       },
-      aclInputIt);
+      aclOutputIt);
 }
 template void importDataFromTensor<float>(arm_compute::Tensor*, float*);
 
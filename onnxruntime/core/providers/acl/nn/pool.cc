@@ -116,20 +116,7 @@ ACLNEPool PoolOperation(onnxruntime::OpKernelContext* context,
     tpool = it->second;
   }
   const T* x_data = X->template Data<T>();
-  arm_compute::Window aclInpuWindow;
-  aclInpuWindow.use_tensor_dimensions(tpool.in->info()->tensor_shape());
-
-  arm_compute::Iterator aclInputIt(tpool.in.get(), aclInpuWindow);
-  const unsigned int aclWidth = tpool.in->info()->dimension(0);
-  const unsigned int aclHeight = tpool.in->info()->dimension(1);
-
-  // copy input tensor into the larger buffer
-  arm_compute::execute_window_loop(
-      aclInpuWindow,
-      [&](const arm_compute::Coordinates& co) {
-        *reinterpret_cast<float*>(aclInputIt.ptr()) = x_data[co.z() * (aclWidth * aclHeight) + co.y() * aclHeight + co.x()];
-      },
-      aclInputIt);
+  importDataToTensor<T>(tpool.in.get(), x_data);
 
   T* y_data = Y->template MutableData<T>();
   ACLImportMemory(tpool.out->allocator(), (void*)y_data, Y->Shape().Size() * 4);
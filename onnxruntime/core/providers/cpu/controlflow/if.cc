@@ -377,7 +377,7 @@ Status IfImpl::Execute(const FeedsFetchesManager& ffm) {
 
   status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, fetch_allocators,
                                   ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(),
-                                  context_.Logger());
+                                  context_.Logger(), context_.GetThreadPools());
 
   ORT_RETURN_IF_ERROR(status);
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/framework/allocatormgr.h"
+#include "core/framework/arena.h"
 #include "core/framework/execution_provider.h"
 #include "core/graph/constants.h"
 
@@ -12,9 +13,10 @@ namespace onnxruntime {
 // Information needed to construct CPU execution providers.
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
+  ArenaType arena_type{ArenaType::kBFCArena};
 
-  explicit CPUExecutionProviderInfo(bool use_arena)
-      : create_arena(use_arena) {}
+  explicit CPUExecutionProviderInfo(bool use_arena, ArenaType arena_type0 = ArenaType::kBFCArena)
+      : create_arena(use_arena), arena_type(arena_type0) {}
 
   CPUExecutionProviderInfo() = default;
 };
@@ -40,8 +42,9 @@ class CPUExecutionProvider : public IExecutionProvider {
     create_arena = false;
 #endif
 
+    OrtArenaCfg arena_cfg{0, -1, -1, -1, 0, static_cast<int>(info.arena_type)};
     AllocatorCreationInfo device_info{[](int) { return onnxruntime::make_unique<TAllocator>(); },
-                                      0, create_arena};
+                                      0, create_arena, arena_cfg};
 
     InsertAllocator(CreateAllocator(device_info));
   }
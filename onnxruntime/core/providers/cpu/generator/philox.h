@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include "core/framework/random_generator.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+/**
+ * The Philox4x32-10 counter based random number generator of Salmon et al., "Parallel Random Numbers: As Easy as
+ * 1, 2, 3". A block of 128 random bits is a function of the seed and the counter of the block only, so the blocks
+ * of a tensor are generated in any order by any number of threads with the same values, and a kernel reserves the
+ * counters of a call with PhiloxGenerator::NextPhiloxSeeds instead of holding a lock while it generates.
+ */
+class Philox4x32 {
+ public:
+  using Block = std::array<uint32_t, 4>;
+
+  // Returns the random bits of the block with the counter under the seed.
+  static Block Generate(uint64_t seed, uint64_t counter) {
+    uint32_t key0 = static_cast<uint32_t>(seed);
+    uint32_t key1 = static_cast<uint32_t>(seed >> 32);
+    Block bits{{static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), 0, 0}};
+    for (int round = 0; round < 10; ++round) {
+      const uint64_t product0 = uint64_t{0xD2511F53} * bits[0];
+      const uint64_t product1 = uint64_t{0xCD9E8D57} * bits[2];
+      bits = {{static_cast<uint32_t>(product1 >> 32) ^ bits[1] ^ key0, static_cast<uint32_t>(product1),
+               static_cast<uint32_t>(product0 >> 32) ^ bits[3] ^ key1, static_cast<uint32_t>(product0)}};
+      key0 += 0x9E3779B9;
+      key1 += 0xBB67AE85;
+    }
+    return bits;
+  }
+
+  // The number of values of type T generated from a block.
+  template <typename T>
+  static constexpr std::ptrdiff_t NumValuesPerBlock() {
+    return static_cast<std::ptrdiff_t>(sizeof(Block) / sizeof(T));
+  }
+
+  // Sets the values to uniformly distributed values in [0, 1) with the 24 or 53 bits of the mantissa.
+  static void Uniform(const Block& bits, float (&values)[4]) {
+    for (int i = 0; i < 4; ++i) {
+      values[i] = static_cast<float>(bits[i] >> 8) * (1.0f / 16777216.0f);
+    }
+  }
+
+  static void Uniform(const Block& bits, double (&values)[2]) {
+    for (int i = 0; i < 2; ++i) {
+      const uint64_t mantissa = (uint64_t{bits[2 * i]} << 21) | (bits[2 * i + 1] >> 11);
+      values[i] = static_cast<double>(mantissa) * (1.0 / 9007199254740992.0);
+    }
+  }
+
+  // Sets the values to standard normally distributed values, by the Box-Muller transform of pairs of uniform values.
+  template <typename T, size_t N>
+  static void Normal(const Block& bits, T (&values)[N]) {
+    Uniform(bits, values);
+    for (size_t i = 0; i < N; i += 2) {
+      const T radius = std::sqrt(T(-2) * std::log(T(1) - values[i]));
+      const T theta = T(6.283185307179586) * values[i + 1];
+      values[i] = radius * std::cos(theta);
+      values[i + 1] = radius * std::sin(theta);
+    }
+  }
+
+  /**
+   * Reserves the counters of the blocks [0, num_blocks) from the generator and calls fn(block, bits) for each block
+   * in parallel on the thread pool.
+   */
+  template <typename Fn>
+  static void ParallelFor(concurrency::ThreadPool* tp, PhiloxGenerator& generator, std::ptrdiff_t num_blocks,
+                          const TensorOpCost& cost_per_block, Fn&& fn) {
+    if (num_blocks <= 0) {
+      return;
+    }
+
+    const auto seeds = generator.NextPhiloxSeeds(static_cast<uint64_t>(num_blocks));
+    concurrency::ThreadPool::TryParallelFor(
+        tp, num_blocks, cost_per_block, [&seeds, &fn](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t block = first; block < last; ++block) {
+            fn(block, Generate(seeds.first, seeds.second + static_cast<uint64_t>(block)));
+          }
+        });
+  }
+
+  /**
+   * Sets values[0, count) in parallel, NumValuesPerBlock<T>() of them from each block with transform(bits, block
+   * values), where the block values are a T[NumValuesPerBlock<T>()].
+   */
+  template <typename T, typename Transform>
+  static void Fill(concurrency::ThreadPool* tp, PhiloxGenerator& generator, T* values, std::ptrdiff_t count,
+                   double compute_cycles_per_block, Transform&& transform) {
+    constexpr std::ptrdiff_t num_values_per_block = NumValuesPerBlock<T>();
+    const std::ptrdiff_t num_blocks = (count + num_values_per_block - 1) / num_values_per_block;
+    const TensorOpCost cost{0, static_cast<double>(sizeof(Block)), compute_cycles_per_block};
+    ParallelFor(tp, generator, num_blocks, cost, [values, count, &transform](std::ptrdiff_t block, const Block& bits) {
+      T block_values[NumValuesPerBlock<T>()];
+      transform(bits, block_values);
+      const std::ptrdiff_t begin = block * NumValuesPerBlock<T>();
+      std::copy_n(block_values, std::min<std::ptrdiff_t>(NumValuesPerBlock<T>(), count - begin), values + begin);
+    });
+  }
+};
+
+}  // namespace onnxruntime
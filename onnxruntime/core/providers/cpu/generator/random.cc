@@ -22,10 +22,9 @@ limitations under the License.
 #endif
 
 #include <algorithm>
-#include <chrono>
-#include <random>
+#include <vector>
 
-#include "core/common/safeint.h"
+#include "core/providers/cpu/generator/philox.h"
 #include "core/util/math_cpuonly.h"
 #include "core/common/eigen_common_wrapper.h"
 #include "gsl/gsl"
@@ -68,11 +67,15 @@ ONNX_CPU_OPERATOR_KERNEL(
     KernelDefBuilder().TypeConstraint("T1", DataTypeImpl::GetTensorType<float>()).TypeConstraint("T2", std::vector<MLDataType>{DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()}),
     Multinomial);
 
-template <typename T, typename TDistribution>
-void GenerateData(std::default_random_engine& generator, TDistribution distribution, Tensor& tensor);
+template <typename T>
+static void GenerateNormal(concurrency::ThreadPool* tp, PhiloxGenerator& generator, T mean, T scale, Tensor& tensor);
+template <typename T>
+static void GenerateUniform(concurrency::ThreadPool* tp, PhiloxGenerator& generator, T low, T high, Tensor& tensor);
 
-static Status RandomNormalCompute(float mean, float scale, std::default_random_engine& generator, TensorProto::DataType dtype, Tensor& Y);
-static Status RandomUniformCompute(float high, float low, std::default_random_engine& generator, TensorProto::DataType dtype, Tensor& Y);
+static Status RandomNormalCompute(float mean, float scale, concurrency::ThreadPool* tp, PhiloxGenerator& generator,
+                                  TensorProto::DataType dtype, Tensor& Y);
+static Status RandomUniformCompute(float high, float low, concurrency::ThreadPool* tp, PhiloxGenerator& generator,
+                                   TensorProto::DataType dtype, Tensor& Y);
 
 static Status CreateOutputTensorFromTensorShape(OpKernelContext* ctx, const Tensor& X, Tensor** Y);
 static TensorProto::DataType InferDataType(const Tensor& tensor);
@@ -80,8 +83,7 @@ static TensorProto::DataType InferDataType(const Tensor& tensor);
 Status RandomNormal::Compute(OpKernelContext* ctx) const {
   Tensor& Y = *ctx->Output(0, shape_);
 
-  std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
-  auto status = RandomNormalCompute(mean_, scale_, generator_, dtype_, Y);
+  auto status = RandomNormalCompute(mean_, scale_, ctx->GetOperatorThreadPool(), generator_, dtype_, Y);
 
   return status;
 }
@@ -89,8 +91,7 @@ Status RandomNormal::Compute(OpKernelContext* ctx) const {
 Status RandomUniform::Compute(OpKernelContext* ctx) const {
   Tensor& Y = *ctx->Output(0, shape_);
 
-  std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
-  auto status = RandomUniformCompute(low_, high_, generator_, dtype_, Y);
+  auto status = RandomUniformCompute(low_, high_, ctx->GetOperatorThreadPool(), generator_, dtype_, Y);
 
   return status;
 }
@@ -111,8 +112,7 @@ Status RandomNormalLike::Compute(OpKernelContext* ctx) const {
                            "Could not infer data type from input tensor with data type ",
                            X.DataType());
 
-  std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
-  status = RandomNormalCompute(mean_, scale_, generator_, dtype, *Y);
+  status = RandomNormalCompute(mean_, scale_, ctx->GetOperatorThreadPool(), generator_, dtype, *Y);
 
   return status;
 }
@@ -132,8 +132,7 @@ Status RandomUniformLike::Compute(OpKernelContext* ctx) const {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
                            "Could not infer data type from input tensor with data type ",
                            X.DataType());
-  std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
-  status = RandomUniformCompute(low_, high_, generator_, dtype, *Y);
+  status = RandomUniformCompute(low_, high_, ctx->GetOperatorThreadPool(), generator_, dtype, *Y);
 
   return status;
 }
@@ -154,57 +153,66 @@ static Status MultinomialCompute(OpKernelContext* ctx,
                                  const int64_t batch_size,
                                  const int64_t num_classes,
                                  const int64_t num_samples,
-                                 std::default_random_engine& generator,
+                                 PhiloxGenerator& generator,
                                  Tensor& Y) {
-  // implementation copied from Tensorflow with some changes such as using the std::uniform_real_distribution
-  // instead of the Philox RNG.
+  // implementation copied from Tensorflow with some changes such as sampling the batches in parallel.
+  // the samples of a batch are from Philox blocks of their own, so they do not depend on how the batches are
+  // partitioned over the threads.
   Eigen::array<int64_t, 2> X_dims = {{batch_size, num_classes}};
   ConstMatrix<float> logits = ConstMatrix<float>(X.template Data<float>(), X_dims);
 
   Eigen::array<int64_t, 2> Y_dims = {{batch_size, num_samples}};
   Matrix<OutputType> output = Matrix<OutputType>(Y.template MutableData<OutputType>(), Y_dims);
 
-  // BEGIN create temporary tensor
-  AllocatorPtr alloc;
-  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
-  auto cdf_data = static_cast<double*>(alloc->Alloc(SafeInt<size_t>(sizeof(double)) * num_classes));
-  BufferUniquePtr cdf_buffer(cdf_data, BufferDeleter(alloc));
-  Eigen::array<int64_t, 1> cdf_dims = {{num_classes}};
-  auto cdf = EigenVector<double>(cdf_data, cdf_dims);
-  // END create temporary tensor
-
-  std::uniform_real_distribution<double> dist(0.0, 1.0);  // TODO: should this be initialized per batch?
-
-  for (int64_t b = 0; b < batch_size; ++b) {
-    const float* logits_row = &(logits(b, 0));
-    // Takes an along-class maximum (for numerical stability).
-    float maxx = std::numeric_limits<float>::lowest();
-    for (int64_t j = 0; j < num_classes; ++j) {
-      if (Eigen::numext::isfinite(logits_row[j])) {
-        maxx = std::max(maxx, logits_row[j]);
+  constexpr int64_t samples_per_block = Philox4x32::NumValuesPerBlock<double>();
+  const int64_t blocks_per_batch = (num_samples + samples_per_block - 1) / samples_per_block;
+  const auto seeds = generator.NextPhiloxSeeds(static_cast<uint64_t>(batch_size * blocks_per_batch));
+
+  const TensorOpCost cost{static_cast<double>(num_classes * sizeof(float)),
+                          static_cast<double>(num_samples * sizeof(OutputType)),
+                          static_cast<double>(num_classes * 20 + num_samples * 30)};
+  concurrency::ThreadPool::TryParallelFor(ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(batch_size), cost,
+                                          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    std::vector<double> cdf_data(static_cast<size_t>(num_classes));
+    Eigen::array<int64_t, 1> cdf_dims = {{num_classes}};
+    auto cdf = EigenVector<double>(cdf_data.data(), cdf_dims);
+
+    for (int64_t b = first; b < last; ++b) {
+      const float* logits_row = &(logits(b, 0));
+      // Takes an along-class maximum (for numerical stability).
+      float maxx = std::numeric_limits<float>::lowest();
+      for (int64_t j = 0; j < num_classes; ++j) {
+        if (Eigen::numext::isfinite(logits_row[j])) {
+          maxx = std::max(maxx, logits_row[j]);
+        }
       }
-    }
-    const auto max_logit = static_cast<double>(maxx);
-
-    // Precompute cumulative probability distribution across classes.
-    // Note: This isn't normalized.
-    cdf = (logits.chip<0>(b).cast<double>() - max_logit).exp();
-    double running_total = 0;
-    for (int64_t j = 0; j < num_classes; ++j) {
-      if (Eigen::numext::isfinite(logits_row[j])) {
-        running_total += cdf(j);
+      const auto max_logit = static_cast<double>(maxx);
+
+      // Precompute cumulative probability distribution across classes.
+      // Note: This isn't normalized.
+      cdf = (logits.chip<0>(b).cast<double>() - max_logit).exp();
+      double running_total = 0;
+      for (int64_t j = 0; j < num_classes; ++j) {
+        if (Eigen::numext::isfinite(logits_row[j])) {
+          running_total += cdf(j);
+        }
+        cdf(j) = running_total;
+      }
+      // Generate each sample.
+      const double* cdf_begin = cdf.data();
+      const double* cdf_end = cdf.data() + num_classes;
+      double uniform[samples_per_block];
+      for (int64_t j = 0; j < num_samples; ++j) {
+        if (j % samples_per_block == 0) {
+          const uint64_t block = static_cast<uint64_t>(b * blocks_per_batch + j / samples_per_block);
+          Philox4x32::Uniform(Philox4x32::Generate(seeds.first, seeds.second + block), uniform);
+        }
+        const double to_find = uniform[j % samples_per_block] * running_total;
+        auto found_iter = std::upper_bound(cdf_begin, cdf_end, to_find);
+        output(b, j) = static_cast<OutputType>(std::distance(cdf_begin, found_iter));
       }
-      cdf(j) = running_total;
-    }
-    // Generate each sample.
-    const double* cdf_begin = cdf.data();
-    const double* cdf_end = cdf.data() + num_classes;
-    for (int64_t j = 0; j < num_samples; ++j) {
-      const double to_find = dist(generator) * running_total;
-      auto found_iter = std::upper_bound(cdf_begin, cdf_end, to_find);
-      output(b, j) = static_cast<OutputType>(std::distance(cdf_begin, found_iter));
     }
-  }
+  });
 
   return Status::OK();
 }
@@ -236,7 +244,6 @@ Status Multinomial::Compute(OpKernelContext* ctx) const {
   Tensor* Y = ctx->Output(0, {batch_size, num_samples_});
 
   Status status = Status::OK();
-  std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
   switch (output_dtype_) {
     case TensorProto::INT32: {
       status = MultinomialCompute<int32_t>(ctx, X, batch_size, num_classes, num_samples_, generator_, *Y);
@@ -273,20 +280,18 @@ static TensorProto::DataType InferDataType(const Tensor& tensor) {
 }
 
 static Status RandomNormalCompute(float mean, float scale,
-                                  std::default_random_engine& generator,
+                                  concurrency::ThreadPool* tp, PhiloxGenerator& generator,
                                   TensorProto::DataType dtype, Tensor& Y) {
   switch (dtype) {
     case TensorProto::FLOAT: {
-      GenerateData<float, std::normal_distribution<float>>(
-          generator, std::normal_distribution<float>{mean, scale}, Y);
+      GenerateNormal<float>(tp, generator, mean, scale, Y);
       break;
     }
     case TensorProto::FLOAT16: {
       ORT_NOT_IMPLEMENTED("FLOAT16 is not supported");
     }
     case TensorProto::DOUBLE: {
-      GenerateData<double, std::normal_distribution<double>>(
-          generator, std::normal_distribution<double>{mean, scale}, Y);
+      GenerateNormal<double>(tp, generator, mean, scale, Y);
       break;
     }
     default:
@@ -297,21 +302,19 @@ static Status RandomNormalCompute(float mean, float scale,
 }
 
 static Status RandomUniformCompute(float low, float high,
-                                   std::default_random_engine& generator,
+                                   concurrency::ThreadPool* tp, PhiloxGenerator& generator,
                                    TensorProto::DataType dtype,
                                    Tensor& Y) {
   switch (dtype) {
     case TensorProto::FLOAT: {
-      GenerateData<float, std::uniform_real_distribution<float>>(
-          generator, std::uniform_real_distribution<float>{low, high}, Y);
+      GenerateUniform<float>(tp, generator, low, high, Y);
       break;
     }
     case TensorProto::FLOAT16: {
       ORT_NOT_IMPLEMENTED("FLOAT16 is not supported");
     }
     case TensorProto::DOUBLE: {
-      GenerateData<double, std::uniform_real_distribution<double>>(
-          generator, std::uniform_real_distribution<double>{low, high}, Y);
+      GenerateUniform<double>(tp, generator, low, high, Y);
       break;
     }
     default:
@@ -321,13 +324,28 @@ static Status RandomUniformCompute(float low, float high,
   return Status::OK();
 }
 
-template <typename T, typename TDistribution>
-void GenerateData(std::default_random_engine& generator, TDistribution distribution, Tensor& tensor) {
-  T* out = tensor.MutableData<T>();
-  for (int64_t i = 0, end = tensor.Shape().Size(); i < end; ++i) {
-    *out = distribution(generator);
-    ++out;
-  }
+// The value i of the tensor is from the Philox block i / NumValuesPerBlock<T>() of the call, so the values do not
+// depend on how the blocks are partitioned over the threads.
+template <typename T>
+static void GenerateNormal(concurrency::ThreadPool* tp, PhiloxGenerator& generator, T mean, T scale, Tensor& tensor) {
+  Philox4x32::Fill(tp, generator, tensor.MutableData<T>(), tensor.Shape().Size(), 200.0,
+                   [mean, scale](const Philox4x32::Block& bits, T(&values)[Philox4x32::NumValuesPerBlock<T>()]) {
+                     Philox4x32::Normal(bits, values);
+                     for (auto& value : values) {
+                       value = mean + scale * value;
+                     }
+                   });
+}
+
+template <typename T>
+static void GenerateUniform(concurrency::ThreadPool* tp, PhiloxGenerator& generator, T low, T high, Tensor& tensor) {
+  Philox4x32::Fill(tp, generator, tensor.MutableData<T>(), tensor.Shape().Size(), 50.0,
+                   [low, high](const Philox4x32::Block& bits, T(&values)[Philox4x32::NumValuesPerBlock<T>()]) {
+                     Philox4x32::Uniform(bits, values);
+                     for (auto& value : values) {
+                       value = low + (high - low) * value;
+                     }
+                   });
 }
 
 }  // namespace onnxruntime
@@ -2,50 +2,77 @@
 // Licensed under the MIT License.
 
 #include "cumsum.h"
+
+#include <algorithm>
+
 #include "core/providers/common.h"
-#include "core/providers/cpu/tensor/utils.h"
+#include "core/providers/cpu/parallel_scan.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorprotoutils.h"
 
 using namespace onnxruntime;
 
 namespace {
-// static section
-std::vector<int64_t> GetStarts(int64_t rank, int64_t axis, int64_t index) {
-  std::vector<int64_t> starts(rank, 0);
-  starts[axis] = index;
-  return starts;
-}
+// Computes the cumulative sums of the columns [column_begin, column_end) of a [dim, columns] matrix, with the rows
+// visited in reverse order if reverse is set. Each output row is the sum of the previous output row and the input row,
+// or the previous input row if exclusive is set.
 template <typename T>
-void ZeroOutSliceAtIndex(Tensor& output, int64_t rank, int64_t axis, int64_t index,
-                         const std::vector<int64_t>& slice_dims, const std::vector<int64_t>& steps, const int64_t slice_size) {
-  T zero{};
-  auto output_starts(GetStarts(rank, axis, index));
-  WritableSliceIterator<T> output_iterator(output, output_starts, slice_dims, steps);
-  for (int64_t k = 0; k < slice_size; ++k, ++output_iterator) {
-    *output_iterator = zero;
+void CumSumColumns(const T* input, T* output, int64_t dim, int64_t columns, int64_t column_begin, int64_t column_end,
+                   bool exclusive, bool reverse) {
+  const int64_t row_step = reverse ? -columns : columns;
+  input += (reverse ? (dim - 1) * columns : 0) + column_begin;
+  output += (reverse ? (dim - 1) * columns : 0) + column_begin;
+  const int64_t count = column_end - column_begin;
+
+  if (exclusive) {
+    std::fill_n(output, count, T{});
+  } else {
+    std::copy_n(input, count, output);
   }
-}
-template <typename T>
-void CopySlices(const Tensor& input, Tensor& output,
-                const std::vector<int64_t>& input_starts, const std::vector<int64_t>& output_starts,
-                const std::vector<int64_t>& slice_dims, const std::vector<int64_t>& steps, const int64_t slice_size) {
-  SliceIterator<T> input_iterator(input, input_starts, slice_dims, steps);
-  WritableSliceIterator<T> output_iterator(output, output_starts, slice_dims, steps);
-  for (int64_t k = 0; k < slice_size; ++k, ++output_iterator, ++input_iterator) {
-    *output_iterator = *input_iterator;
+
+  for (int64_t k = 1; k < dim; ++k) {
+    const T* input_row = input + (exclusive ? k - 1 : k) * row_step;
+    const T* previous_output_row = output + (k - 1) * row_step;
+    T* output_row = output + k * row_step;
+    for (int64_t c = 0; c < count; ++c) {
+      output_row[c] = previous_output_row[c] + input_row[c];
+    }
   }
 }
+
+// Computes the cumulative sum of a vector of dim elements in two passes over blocks of the vector: the sums of the
+// blocks are computed in parallel and their exclusive prefix gives the starting sum of each block, then each block
+// computes its cumulative sums from it in parallel.
 template <typename T>
-void SumSlices(const Tensor& input, Tensor& output,
-               const std::vector<int64_t>& input_starts, const std::vector<int64_t>& output_starts, const std::vector<int64_t>& previous_output_starts,
-               const std::vector<int64_t>& slice_dims, const std::vector<int64_t>& steps, const int64_t slice_size) {
-  SliceIterator<T> input_iterator(input, input_starts, slice_dims, steps);
-  WritableSliceIterator<T> output_iterator(output, output_starts, slice_dims, steps);
-  SliceIterator<T> previous_output_iterator(output, previous_output_starts, slice_dims, steps);
-  for (int64_t k = 0; k < slice_size; ++k, ++output_iterator, ++input_iterator, ++previous_output_iterator) {
-    *output_iterator = *input_iterator + *previous_output_iterator;
-  }
+void CumSumVector(concurrency::ThreadPool* tp, const T* input, T* output, int64_t dim, bool exclusive, bool reverse) {
+  // the position of an element in the order of the sums
+  auto element = [dim, reverse](std::ptrdiff_t i) { return reverse ? dim - 1 - i : i; };
+
+  ParallelScan scan(tp, static_cast<std::ptrdiff_t>(dim));
+  std::vector<T> block_offsets;
+  scan.ExclusiveScan<T>(
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        T sum{};
+        for (std::ptrdiff_t i = begin; i < end; ++i) {
+          sum += input[element(i)];
+        }
+        return sum;
+      },
+      block_offsets);
+
+  scan.ForEachBlock([&](std::ptrdiff_t block, std::ptrdiff_t begin, std::ptrdiff_t end) {
+    T sum = block_offsets[block];
+    for (std::ptrdiff_t i = begin; i < end; ++i) {
+      const auto e = element(i);
+      if (exclusive) {
+        output[e] = sum;
+        sum += input[e];
+      } else {
+        sum += input[e];
+        output[e] = sum;
+      }
+    }
+  });
 }
 }  // namespace
 
@@ -147,61 +174,36 @@ Status CumSum<T>::Compute(OpKernelContext* ctx) const {
   int64_t axis = 0;
   ORT_THROW_IF_ERROR(cumsum_op::GetAxis(axis_tensor, rank, axis));
 
-  auto dim(output_tensor.Shape()[axis]);    // dimension size for the axis
-  TensorShape slice_shape(input->Shape());  // the shape of one slice of input/output for the given value of the axis
-  slice_shape[axis] = 1;
-  auto slice_size(slice_shape.Size());     // total number of elements in each slice
-  auto slice_dims(slice_shape.GetDims());  // dim array for the slice
-
-  std::vector<int64_t> steps(rank, 1);  // steps for the slice -- always set to 1
+  const int64_t dim = output_shape[axis];                          // dimension size for the axis
+  const int64_t outer = output_shape.SizeToDimension(axis);        // number of [dim, inner] matrices to sum over
+  const int64_t inner = output_shape.SizeFromDimension(axis + 1);  // number of columns of each matrix
 
-  if (!reverse_) {
-    int64_t index(0);  // the index we use as we walkthrough the given axis
-    // If (exclusive == true) the first slice is always 0
-    if (exclusive_) {
-      ::ZeroOutSliceAtIndex<T>(output_tensor, rank, axis, index, slice_dims, steps, slice_size);
-      ++index;
-    }
-    {
-      // The next slice is a copy of the input (if exclusive == false then this is the first slice)
-      auto input_starts(::GetStarts(rank, axis, 0));
-      auto output_starts(::GetStarts(rank, axis, index));
-      ::CopySlices<T>(*input, output_tensor, input_starts, output_starts, slice_dims, steps, slice_size);
-      ++index;
-    }
+  const T* input_data = input->template Data<T>();
+  T* output_data = output_tensor.template MutableData<T>();
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
 
-    for (; index < dim; ++index) {
-      // Each output slice is the sum of corresponding input slice and the previous output slice
-      auto input_starts(::GetStarts(rank, axis, exclusive_ ? index - 1 : index));
-      auto output_starts(::GetStarts(rank, axis, index));
-      auto previous_starts(::GetStarts(rank, axis, index - 1));
-      ::SumSlices<T>(*input, output_tensor, input_starts, output_starts, previous_starts,
-                     slice_dims, steps, slice_size);
+  if (inner == 1 && outer < concurrency::ThreadPool::DegreeOfParallelism(tp)) {
+    // too few columns to sum in parallel, each one is summed in blocks
+    for (int64_t o = 0; o < outer; ++o) {
+      ::CumSumVector<T>(tp, input_data + o * dim, output_data + o * dim, dim, exclusive_ != 0, reverse_ != 0);
     }
   } else {
-    //_reverse == true
-    int64_t index(dim - 1);  // the index we use as we walkthrough the given axis
-    // If (exclusive == true) the first slice is always 0
-    if (exclusive_) {
-      ::ZeroOutSliceAtIndex<T>(output_tensor, rank, axis, index, slice_dims, steps, slice_size);
-      --index;
-    }
-    {
-      // The next slice is a copy of the input (if exclusive == false then this is the first slice)
-      auto input_starts(::GetStarts(rank, axis, dim - 1));
-      auto output_starts(::GetStarts(rank, axis, index));
-      ::CopySlices<T>(*input, output_tensor, input_starts, output_starts, slice_dims, steps, slice_size);
-      --index;
-    }
-
-    for (; index >= 0; --index) {
-      // Each output slice is the sum of corresponding input slice and the previous output slice
-      auto input_starts(::GetStarts(rank, axis, exclusive_ ? index + 1 : index));
-      auto output_starts(::GetStarts(rank, axis, index));
-      auto previous_starts(::GetStarts(rank, axis, index + 1));
-      ::SumSlices<T>(*input, output_tensor, input_starts, output_starts, previous_starts,
-                     slice_dims, steps, slice_size);
-    }
+    // the columns of all of the matrices are summed in parallel
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(outer * inner),
+        TensorOpCost{static_cast<double>(dim * sizeof(T)), static_cast<double>(dim * sizeof(T)),
+                     static_cast<double>(dim)},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          while (first < last) {
+            const int64_t o = first / inner;
+            const int64_t column_begin = first % inner;
+            const int64_t column_end = std::min<int64_t>(inner, column_begin + (last - first));
+            const int64_t offset = o * dim * inner;
+            ::CumSumColumns<T>(input_data + offset, output_data + offset, dim, inner, column_begin, column_end,
+                               exclusive_ != 0, reverse_ != 0);
+            first += column_end - column_begin;
+          }
+        });
   }
 
   return Status::OK();
@@ -43,6 +43,19 @@ Status Einsum::Compute(OpKernelContext* context) const {
   return DeviceCompute(context, inputs, allocator, tp);
 }
 
+EinsumOp::ContractionPath Einsum::GetContractionPath(EinsumComputePreprocessor& einsum_compute_preprocessor) const {
+  const auto& homogenized_input_dims = einsum_compute_preprocessor.GetHomogenizedInputDims();
+
+  std::lock_guard<OrtMutex> lock(contraction_path_mutex_);
+  if (contraction_path_input_dims_ != homogenized_input_dims) {
+    contraction_path_ = EinsumOp::ComputeContractionPath(
+        homogenized_input_dims, einsum_compute_preprocessor.GetMappedSubscriptIndicesToOutputindices());
+    contraction_path_input_dims_ = homogenized_input_dims;
+  }
+
+  return contraction_path_;
+}
+
 Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const Tensor*>& inputs,
                              AllocatorPtr allocator, concurrency::ThreadPool* tp) const {
   // EinsumComputePreprocessor section -
@@ -54,11 +67,14 @@ Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const T
   // Compute all required metadata to be used at Einsum compute time and return error status code if one was generated
   ORT_RETURN_IF_ERROR(einsum_compute_preprocessor.Run());
 
+  auto contraction_path = GetContractionPath(einsum_compute_preprocessor);
+
   // EinsumComputeProcessor section -
   if (inputs[0]->IsDataType<float>()) {
     auto einsum_compute_processor = EinsumTypedComputeProcessor<float>(context, allocator,
                                                                        tp,
                                                                        einsum_compute_preprocessor,
+                                                                       contraction_path,
                                                                        nullptr);
 
     // Set device specific methods (CPU methods) to be used during processing
@@ -72,6 +88,7 @@ Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const T
                                                                          allocator,
                                                                          tp,
                                                                          einsum_compute_preprocessor,
+                                                                         contraction_path,
                                                                          nullptr);
 
     // Set device specific methods (CPU methods) to be used during processing
@@ -86,6 +103,7 @@ Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const T
                                                                         allocator,
                                                                         tp,
                                                                         einsum_compute_preprocessor,
+                                                                        contraction_path,
                                                                         nullptr);
 
     // Set device specific methods (CPU methods) to be used during processing
@@ -99,6 +117,7 @@ Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const T
                                                                          allocator,
                                                                          tp,
                                                                          einsum_compute_preprocessor,
+                                                                         contraction_path,
                                                                          nullptr);
 
     einsum_compute_processor.SetDeviceHelpers(EinsumOp::DeviceHelpers::CpuDeviceHelpers::Transpose,
@@ -5,7 +5,9 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/ort_mutex.h"
 #include "einsum_utils/einsum_compute_preprocessor.h"
+#include "einsum_utils/einsum_contraction_path.h"
 #include "einsum_utils/einsum_typed_compute_processor.h"
 
 namespace onnxruntime {
@@ -25,8 +27,17 @@ class Einsum : public OpKernel {
   virtual Status DeviceCompute(OpKernelContext* context, const std::vector<const Tensor*>& inputs,
                                AllocatorPtr allocator, concurrency::ThreadPool* tp) const;
 
+  // Returns the order in which the operands are processed pair-wise
+  // The contraction path is computed for the input dims on the first run and only recomputed if they change
+  EinsumOp::ContractionPath GetContractionPath(EinsumComputePreprocessor& einsum_compute_preprocessor) const;
+
   std::string equation_;
   std::unique_ptr<EinsumEquationPreprocessor> einsum_equation_preprocessor_;
+
+ private:
+  mutable OrtMutex contraction_path_mutex_;
+  mutable std::vector<TensorShape> contraction_path_input_dims_;
+  mutable EinsumOp::ContractionPath contraction_path_;
 };
 
 }  // namespace onnxruntime
@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include "einsum_auxiliary_ops.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/util/math_cpuonly.h"
 
 using namespace onnxruntime::common;
 
@@ -28,21 +30,79 @@ Status Transpose(const std::vector<size_t>& permutation, const Tensor& input,
   return TransposeBase::DoTranspose(permutation, input, output, input_shape_override);
 }
 
-// CPU specific MatMul helper
+// CPU specific MatMul helper(s)
 template <typename T>
-Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
-              size_t left_stride, size_t right_stride, size_t output_stride,
-              size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
-              void* /*einsum_cuda_assets*/) {
+static void BatchedMatMul(const T* input_1_data, const T* input_2_data, T* output_data,
+                          size_t left_stride, size_t right_stride, size_t output_stride,
+                          size_t num_batches, size_t M, size_t K, size_t N,
+                          bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* /*tp*/) {
+  // The inputs and the output are row-major, so compute the column-major transposed output: op(B)' * op(A)'
+  for (size_t i = 0; i < num_batches; ++i) {
+    auto output = EigenMatrixMap<T>(output_data + i * output_stride, N, M);
+    auto input_1 = ConstEigenMatrixMap<T>(input_1_data + i * left_stride,
+                                          transpose_input_1 ? M : K, transpose_input_1 ? K : M);
+    auto input_2 = ConstEigenMatrixMap<T>(input_2_data + i * right_stride,
+                                          transpose_input_2 ? K : N, transpose_input_2 ? N : K);
+    if (transpose_input_1) {
+      if (transpose_input_2) {
+        output.noalias() = input_2.transpose() * input_1.transpose();
+      } else {
+        output.noalias() = input_2 * input_1.transpose();
+      }
+    } else if (transpose_input_2) {
+      output.noalias() = input_2.transpose() * input_1;
+    } else {
+      output.noalias() = input_2 * input_1;
+    }
+  }
+}
+
+static void BatchedMatMul(const float* input_1_data, const float* input_2_data, float* output_data,
+                          size_t left_stride, size_t right_stride, size_t output_stride,
+                          size_t num_batches, size_t M, size_t K, size_t N,
+                          bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp) {
+  // A single call lets MLAS partition the work across the batches
+  std::vector<MLAS_SGEMM_DATA_PARAMS> data(num_batches);
   for (size_t i = 0; i < num_batches; ++i) {
-    math::MatMul<T>(
-        static_cast<int>(M),
-        static_cast<int>(N),
-        static_cast<int>(K),
+    data[i].A = input_1_data + i * left_stride;
+    data[i].lda = transpose_input_1 ? M : K;
+    data[i].B = input_2_data + i * right_stride;
+    data[i].ldb = transpose_input_2 ? K : N;
+    data[i].C = output_data + i * output_stride;
+    data[i].ldc = N;
+  }
+
+  MlasGemmBatch(transpose_input_1 ? CblasTrans : CblasNoTrans, transpose_input_2 ? CblasTrans : CblasNoTrans,
+                M, N, K, data.data(), num_batches, tp);
+}
+
+static void BatchedMatMul(const double* input_1_data, const double* input_2_data, double* output_data,
+                          size_t left_stride, size_t right_stride, size_t output_stride,
+                          size_t num_batches, size_t M, size_t K, size_t N,
+                          bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp) {
+  for (size_t i = 0; i < num_batches; ++i) {
+    math::Gemm<double, concurrency::ThreadPool>(
+        transpose_input_1 ? CblasTrans : CblasNoTrans,
+        transpose_input_2 ? CblasTrans : CblasNoTrans,
+        static_cast<ptrdiff_t>(M),
+        static_cast<ptrdiff_t>(N),
+        static_cast<ptrdiff_t>(K),
+        1.0,
         input_1_data + i * left_stride,
         input_2_data + i * right_stride,
+        0.0,
         output_data + i * output_stride, tp);
   }
+}
+
+template <typename T>
+Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
+              size_t left_stride, size_t right_stride, size_t output_stride,
+              size_t num_batches, size_t M, size_t K, size_t N,
+              bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
+              void* /*einsum_cuda_assets*/) {
+  BatchedMatMul(input_1_data, input_2_data, output_data, left_stride, right_stride, output_stride,
+                num_batches, M, K, N, transpose_input_1, transpose_input_2, tp);
 
   return Status::OK();
 }
@@ -252,24 +312,27 @@ std::unique_ptr<Tensor> Diagonal(const Tensor& input, int64_t dim_1, int64_t dim
 }  // namespace DeviceHelpers
 
 // This helps decide if we need to apply (and pay the cost) of a Transpose
-bool IsTransposeRequired(size_t input_rank, const std::vector<size_t>& permutation) {
+bool IsTransposeRequired(const std::vector<int64_t>& input_dims, const std::vector<size_t>& permutation) {
+  auto input_rank = input_dims.size();
   ORT_ENFORCE(input_rank == permutation.size(), "The rank of the input must match permutation size for Transpose");
 
-  // No transpose required for scalars
-  if (input_rank == 0) {
-    return false;
-  }
-
   // Weeds out cases where permutation is something like [0, 1, 2] for a 3D input and so on
-  bool transpose_required = false;
+  // The axes of dim value 1 can be moved without changing the memory layout, so
+  // only the order of the other axes matters (e.g.) [2, 0, 1] for an input of shape [5, 3, 1] is not required
+  size_t last_permuted_axis = 0;
+  bool is_first_axis = true;
   for (size_t i = 0; i < input_rank; ++i) {
-    if (permutation[i] != i) {
-      transpose_required = true;
-      break;
+    if (input_dims[permutation[i]] == 1) {
+      continue;
+    }
+    if (!is_first_axis && permutation[i] < last_permuted_axis) {
+      return true;
     }
+    last_permuted_axis = permutation[i];
+    is_first_axis = false;
   }
 
-  return transpose_required;
+  return false;
 }
 
 // The following are thin wrappers over device specific helpers
@@ -303,19 +366,23 @@ std::unique_ptr<Tensor> Transpose(const Tensor& input, const std::vector<int64_t
 
 template <typename T>
 std::unique_ptr<Tensor> MatMul(const Tensor& input_1, const std::vector<int64_t>& input_shape_1_override,
+                               bool transpose_input_1,
                                const Tensor& input_2, const std::vector<int64_t>& input_shape_2_override,
+                               bool transpose_input_2,
                                AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
                                const DeviceHelpers::MatMul<T>& device_matmul_func) {
   // Sanity checks before the actual MatMul
   ORT_ENFORCE(input_1.DataType() == input_2.DataType(), "Data types of the inputs must match for MatMul");
   ORT_ENFORCE(input_shape_1_override.size() == 3 && input_shape_2_override.size() == 3, "Only 1 batch dimension is allowed for MatMul");
   ORT_ENFORCE(input_shape_1_override[0] == input_shape_2_override[0], "Batch dimension should match for MatMul;");
-  ORT_ENFORCE(input_shape_1_override[2] == input_shape_2_override[1], "Incompatible matrix dimensions for matMul");
 
   size_t batches = static_cast<size_t>(input_shape_1_override[0]);
-  size_t M = static_cast<size_t>(input_shape_1_override[1]);
-  size_t K = static_cast<size_t>(input_shape_1_override[2]);
-  size_t N = static_cast<size_t>(input_shape_2_override[2]);
+  size_t M = static_cast<size_t>(input_shape_1_override[transpose_input_1 ? 2 : 1]);
+  size_t K = static_cast<size_t>(input_shape_1_override[transpose_input_1 ? 1 : 2]);
+  size_t N = static_cast<size_t>(input_shape_2_override[transpose_input_2 ? 1 : 2]);
+
+  ORT_ENFORCE(static_cast<size_t>(input_shape_2_override[transpose_input_2 ? 2 : 1]) == K,
+              "Incompatible matrix dimensions for matMul");
 
   size_t left_offset = M * K;
   size_t right_offset = K * N;
@@ -336,7 +403,8 @@ std::unique_ptr<Tensor> MatMul(const Tensor& input_1, const std::vector<int64_t>
   T* output_data = output->template MutableData<T>();
 
   auto status = device_matmul_func(input_1_data, input_2_data, output_data,
-                                   left_offset, right_offset, output_offset, batches, M, K, N, tp, einsum_cuda_assets);
+                                   left_offset, right_offset, output_offset, batches, M, K, N,
+                                   transpose_input_1, transpose_input_2, tp, einsum_cuda_assets);
 
   if (!status.IsOK()) {
     ORT_THROW(ONNXRUNTIME, FAIL, "Einsum op: Exception during MatMul operation: ",
@@ -362,12 +430,13 @@ std::unique_ptr<Tensor> ReduceSum(const Tensor& input, const std::vector<int64_t
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<float>(
     const float* input_1_data, const float* input_2_data, float* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N,
+    bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> MatMul<float>(
-    const Tensor& input_1, const std::vector<int64_t>& input_shape_1_override,
-    const Tensor& input_2, const std::vector<int64_t>& input_shape_2_override,
+    const Tensor& input_1, const std::vector<int64_t>& input_shape_1_override, bool transpose_input_1,
+    const Tensor& input_2, const std::vector<int64_t>& input_shape_2_override, bool transpose_input_2,
     AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
     const DeviceHelpers::MatMul<float>& device_matmul_func);
 
@@ -386,12 +455,13 @@ template std::unique_ptr<Tensor> ReduceSum<float>(
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<int32_t>(
     const int32_t* input_1_data, const int32_t* input_2_data, int32_t* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N,
+    bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> MatMul<int32_t>(
-    const Tensor& input_1, const std::vector<int64_t>& input_shape_1_override,
-    const Tensor& input_2, const std::vector<int64_t>& input_shape_2_override,
+    const Tensor& input_1, const std::vector<int64_t>& input_shape_1_override, bool transpose_input_1,
+    const Tensor& input_2, const std::vector<int64_t>& input_shape_2_override, bool transpose_input_2,
     AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
     const DeviceHelpers::MatMul<int32_t>& device_matmul_func);
 
@@ -411,12 +481,13 @@ template std::unique_ptr<Tensor> ReduceSum<int32_t>(
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<double>(
     const double* input_1_data, const double* input_2_data, double* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N,
+    bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> MatMul<double>(
-    const Tensor& input_1, const std::vector<int64_t>& input_shape_1_override,
-    const Tensor& input_2, const std::vector<int64_t>& input_shape_2_override,
+    const Tensor& input_1, const std::vector<int64_t>& input_shape_1_override, bool transpose_input_1,
+    const Tensor& input_2, const std::vector<int64_t>& input_shape_2_override, bool transpose_input_2,
     AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
     const DeviceHelpers::MatMul<double>& device_matmul_func);
 
@@ -436,7 +507,8 @@ template std::unique_ptr<Tensor> ReduceSum<double>(
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<int64_t>(
     const int64_t* input_1_data, const int64_t* input_2_data, int64_t* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N,
+    bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template Tensor DeviceHelpers::CpuDeviceHelpers::ReduceSum<int64_t>(
@@ -446,8 +518,8 @@ template Tensor DeviceHelpers::CpuDeviceHelpers::ReduceSum<int64_t>(
     concurrency::ThreadPool* tp, void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> MatMul<int64_t>(
-    const Tensor& input_1, const std::vector<int64_t>& input_shape_1_override,
-    const Tensor& input_2, const std::vector<int64_t>& input_shape_2_override,
+    const Tensor& input_1, const std::vector<int64_t>& input_shape_1_override, bool transpose_input_1,
+    const Tensor& input_2, const std::vector<int64_t>& input_shape_2_override, bool transpose_input_2,
     AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
     const DeviceHelpers::MatMul<int64_t>& device_matmul_func);
 
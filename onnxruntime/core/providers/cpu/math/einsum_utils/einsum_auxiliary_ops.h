@@ -31,10 +31,13 @@ using Transpose = std::function<Status(const std::vector<size_t>& permutation, c
                                        void* einsum_cuda_assets)>;
 
 // MatMul op - Multiplies two inputs of shapes [num_batches, M, K] and [num_batches, K, N]
+// If `transpose_input_1` is true, the first input is stored as [num_batches, K, M] and
+// if `transpose_input_2` is true, the second input is stored as [num_batches, N, K]
 template <typename T>
 using MatMul = std::function<Status(const T* input_1_data, const T* input_2_data, T* output_data,
                                     size_t left_stride, size_t right_stride, size_t output_stride,
-                                    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+                                    size_t num_batches, size_t M, size_t K, size_t N,
+                                    bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
                                     void* einsum_cuda_assets)>;
 
 // ReduceSum op - Reduces along `reduce_axes`
@@ -67,7 +70,8 @@ Status Transpose(const std::vector<size_t>& permutation, const Tensor& input,
 template <typename T>
 Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
               size_t left_stride, size_t right_stride, size_t output_stride,
-              size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+              size_t num_batches, size_t M, size_t K, size_t N,
+              bool transpose_input_1, bool transpose_input_2, concurrency::ThreadPool* tp,
               void* einsum_cuda_assets);
 
 template <typename T>
@@ -83,7 +87,9 @@ std::unique_ptr<Tensor> Diagonal(const Tensor& input, int64_t dim_1, int64_t dim
 }  // namespace DeviceHelpers
 
 // This helps decide if we need to apply (and pay the cost) of a Transpose
-bool IsTransposeRequired(size_t input_rank, const std::vector<size_t>& permutation);
+// The axes of dim value 1 are ignored as they don't change the memory layout, so a caller skipping
+// the Transpose may need to reshape the input to the permutated dims
+bool IsTransposeRequired(const std::vector<int64_t>& input_dims, const std::vector<size_t>& permutation);
 
 // Thin wrapper over the Transpose op to be called from Einsum that does some checks and invokes the device specific helper
 std::unique_ptr<Tensor> Transpose(const Tensor& input, const std::vector<int64_t>& input_shape_override,
@@ -93,9 +99,13 @@ std::unique_ptr<Tensor> Transpose(const Tensor& input, const std::vector<int64_t
 // Thin wrapper over the MatMul op to be called from Einsum that does some checks and invokes the device specific helper
 // Not using the MatMulHelper for checks and to compute output dims as it adds a lot of checking overhead involving transposes of the inputs
 // In our case, we have a more simplistic version which doesn't need to have those checks
+// The shape overrides are the stored shapes of the inputs, so input_1 is [batches, K, M] if `transpose_input_1` is true
+// and input_2 is [batches, N, K] if `transpose_input_2` is true
 template <typename T>
 std::unique_ptr<Tensor> MatMul(const Tensor& input_1, const std::vector<int64_t>& input_1_shape_override,
+                               bool transpose_input_1,
                                const Tensor& input_2, const std::vector<int64_t>& input_2_shape_override,
+                               bool transpose_input_2,
                                AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
                                const DeviceHelpers::MatMul<T>& device_matmul_func);
 
@@ -0,0 +1,169 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "einsum_contraction_path.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace onnxruntime {
+
+namespace EinsumOp {
+
+namespace {
+
+// An operand of the contraction - either an input or an intermediate result
+struct Operand {
+  size_t id;
+  std::vector<int64_t> dims;
+};
+
+double NumElements(const std::vector<int64_t>& dims) {
+  double size = 1.0;
+  for (auto dim : dims) {
+    size *= static_cast<double>(dim);
+  }
+  return size;
+}
+
+// Computes the dims of the result of contracting operands[i] and operands[j] and returns the cost of the
+// contraction. An axis is kept if it appears in the output or in any of the other operands, otherwise it is reduced.
+// (Axes seen in only one of the pair are summed out before the contraction and don't add to its cost)
+double Contract(const std::vector<Operand>& operands, size_t i, size_t j,
+                const std::vector<int64_t>& subscript_indices_to_output_indices,
+                std::vector<int64_t>& result_dims) {
+  const auto& left_dims = operands[i].dims;
+  const auto& right_dims = operands[j].dims;
+  const size_t rank = left_dims.size();
+
+  result_dims.assign(rank, 1);
+  double cost = 1.0;
+
+  for (size_t axis = 0; axis < rank; ++axis) {
+    int64_t left_dim = left_dims[axis];
+    int64_t right_dim = right_dims[axis];
+
+    bool is_kept = subscript_indices_to_output_indices[axis] != -1;
+    for (size_t k = 0, end = operands.size(); k < end && !is_kept; ++k) {
+      if (k != i && k != j && operands[k].dims[axis] > 1) {
+        is_kept = true;
+      }
+    }
+
+    if (is_kept) {
+      result_dims[axis] = std::max(left_dim, right_dim);
+      cost *= static_cast<double>(result_dims[axis]);
+    } else if (left_dim > 1 && right_dim > 1) {
+      cost *= static_cast<double>(left_dim);
+    }
+  }
+
+  return cost;
+}
+
+// Replaces operands[i] and operands[j] (i < j) with the result of their contraction
+void ReplaceWithResult(std::vector<Operand>& operands, size_t i, size_t j, size_t result_id,
+                       std::vector<int64_t>&& result_dims) {
+  operands.erase(operands.begin() + j);
+  operands.erase(operands.begin() + i);
+  operands.push_back(Operand{result_id, std::move(result_dims)});
+}
+
+// Repeatedly contracts the pair that removes the most elements from the intermediate results
+// (ties are broken by the cost of the contraction)
+double GreedyContractionPath(std::vector<Operand> operands, size_t num_inputs,
+                             const std::vector<int64_t>& subscript_indices_to_output_indices,
+                             ContractionPath& path) {
+  double total_cost = 0.0;
+  std::vector<int64_t> result_dims;
+
+  while (operands.size() > 1) {
+    size_t best_i = 0;
+    size_t best_j = 1;
+    double best_size_change = std::numeric_limits<double>::max();
+    double best_cost = std::numeric_limits<double>::max();
+    std::vector<int64_t> best_result_dims;
+
+    for (size_t i = 0; i < operands.size(); ++i) {
+      for (size_t j = i + 1; j < operands.size(); ++j) {
+        double cost = Contract(operands, i, j, subscript_indices_to_output_indices, result_dims);
+        double size_change = NumElements(result_dims) - NumElements(operands[i].dims) - NumElements(operands[j].dims);
+        if (size_change < best_size_change || (size_change == best_size_change && cost < best_cost)) {
+          best_i = i;
+          best_j = j;
+          best_size_change = size_change;
+          best_cost = cost;
+          best_result_dims = result_dims;
+        }
+      }
+    }
+
+    path.emplace_back(operands[best_i].id, operands[best_j].id);
+    total_cost += best_cost;
+    ReplaceWithResult(operands, best_i, best_j, num_inputs + path.size() - 1, std::move(best_result_dims));
+  }
+
+  return total_cost;
+}
+
+// Searches all the contraction paths for one cheaper than `best_cost`
+void OptimalContractionPath(const std::vector<Operand>& operands, size_t num_inputs,
+                            const std::vector<int64_t>& subscript_indices_to_output_indices,
+                            double cost_so_far, ContractionPath& path,
+                            double& best_cost, ContractionPath& best_path) {
+  if (operands.size() == 1) {
+    if (cost_so_far < best_cost) {
+      best_cost = cost_so_far;
+      best_path = path;
+    }
+    return;
+  }
+
+  std::vector<int64_t> result_dims;
+  for (size_t i = 0; i < operands.size(); ++i) {
+    for (size_t j = i + 1; j < operands.size(); ++j) {
+      double cost = cost_so_far + Contract(operands, i, j, subscript_indices_to_output_indices, result_dims);
+      if (cost >= best_cost) {
+        continue;
+      }
+
+      std::vector<Operand> next_operands(operands);
+      path.emplace_back(operands[i].id, operands[j].id);
+      ReplaceWithResult(next_operands, i, j, num_inputs + path.size() - 1, std::move(result_dims));
+      OptimalContractionPath(next_operands, num_inputs, subscript_indices_to_output_indices,
+                             cost, path, best_cost, best_path);
+      path.pop_back();
+    }
+  }
+}
+
+}  // namespace
+
+ContractionPath ComputeContractionPath(const std::vector<TensorShape>& homogenized_input_dims,
+                                       const std::vector<int64_t>& subscript_indices_to_output_indices) {
+  const size_t num_inputs = homogenized_input_dims.size();
+
+  std::vector<Operand> operands;
+  operands.reserve(num_inputs);
+  for (size_t i = 0; i < num_inputs; ++i) {
+    operands.push_back(Operand{i, homogenized_input_dims[i].GetDims()});
+  }
+
+  ContractionPath path;
+  path.reserve(num_inputs);
+  double cost = GreedyContractionPath(operands, num_inputs, subscript_indices_to_output_indices, path);
+
+  // The greedy path is a good upper bound for pruning the exhaustive search
+  if (num_inputs > 2 && num_inputs <= max_operands_for_optimal_contraction_path) {
+    ContractionPath current_path;
+    current_path.reserve(num_inputs);
+    OptimalContractionPath(operands, num_inputs, subscript_indices_to_output_indices,
+                           0.0, current_path, cost, path);
+  }
+
+  return path;
+}
+
+}  // namespace EinsumOp
+
+}  // namespace onnxruntime
@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// This module hosts the following abstraction -
+
+// 1) ContractionPath - The order in which the Einsum operands are contracted pair-wise.
+// It is chosen with a cost model similar to opt_einsum's (see numpy.einsum_path):
+// an exhaustive search for a small number of operands and a greedy search otherwise.
+
+#pragma once
+
+#include "core/framework/tensor_shape.h"
+
+#include <utility>
+#include <vector>
+
+namespace onnxruntime {
+
+namespace EinsumOp {
+
+// Each step of a contraction path contracts a pair of operands.
+// The inputs are identified by their index (0 to num_inputs - 1) and the intermediate result of
+// the i-th step is identified by num_inputs + i, so the result of the last step is the final result.
+using ContractionPath = std::vector<std::pair<size_t, size_t>>;
+
+// The number of operands up to which all the contraction paths are searched for the cheapest one
+constexpr size_t max_operands_for_optimal_contraction_path = 4;
+
+/** Computes the contraction path of the Einsum operands.
+  * `homogenized_input_dims` are the dims of the operands with an axis for each subscript index
+  * (an axis of dim value 1 is treated as absent from the operand).
+  * `subscript_indices_to_output_indices` holds -1 for the subscript indices that are not in the output.
+  * The cost of a path is the number of multiply-adds of its contractions.
+  */
+ContractionPath ComputeContractionPath(const std::vector<TensorShape>& homogenized_input_dims,
+                                       const std::vector<int64_t>& subscript_indices_to_output_indices);
+
+}  // namespace EinsumOp
+
+}  // namespace onnxruntime
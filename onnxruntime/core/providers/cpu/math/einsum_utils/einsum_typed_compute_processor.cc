@@ -7,6 +7,7 @@ namespace onnxruntime {
 
 template <typename T>
 void EinsumTypedComputeProcessor<T>::FinalizeOutput(const Tensor& candidate_output,
+                                                    const std::vector<int64_t>& candidate_output_dims,
                                                     const std::vector<int64_t>& ordered_subscript_indices_in_candidate) {
   const std::vector<int64_t>& subscript_indices_to_output_indices =
       einsum_compute_preprocessor_.GetMappedSubscriptIndicesToOutputindices();
@@ -18,8 +19,9 @@ void EinsumTypedComputeProcessor<T>::FinalizeOutput(const Tensor& candidate_outp
   ORT_ENFORCE(candidate_output.Shape().Size() == output_shape.Size(),
               "Einsum op: The candidate output cannot be reshaped into the op's output");
 
-  const auto& candidate_output_dims = candidate_output.Shape().GetDims();
   const auto candidate_output_rank = candidate_output_dims.size();
+  ORT_ENFORCE(candidate_output_rank == ordered_subscript_indices_in_candidate.size(),
+              "Einsum op: Each dimension of the candidate output must correspond to a subscript index");
 
   // This vector holds the shape of the candidate_output after removing the dims that have
   // been reduced in the final output
@@ -43,13 +45,13 @@ void EinsumTypedComputeProcessor<T>::FinalizeOutput(const Tensor& candidate_outp
       ORT_ENFORCE(candidate_output_dims[iter] == 1,
                   "Not all dimensions to be reduced have been reduced in the candidate output. "
                   "Candidate output dims: ",
-                  candidate_output.Shape());
+                  TensorShape(candidate_output_dims));
     }
   }
 
   // Transpose to the required final output order
   // (Identify no-op transposes and prevent triggering the transpose)
-  if (EinsumOp::IsTransposeRequired(candidate_output_shape_without_reduced_dims.size(), output_permutation)) {
+  if (EinsumOp::IsTransposeRequired(candidate_output_shape_without_reduced_dims, output_permutation)) {
     auto candidate_output_transposed = EinsumOp::Transpose(candidate_output, candidate_output_shape_without_reduced_dims,
                                                            output_permutation,
                                                            allocator_, einsum_ep_assets_, device_transpose_func_);
@@ -121,6 +123,10 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   size_t reduce_dims_iter = 0;
   size_t reduce_dims_size = reduce_dims.size();
 
+  // The dims to be reduced that are only present in one of the operands are reduced right away
+  std::vector<int64_t> left_only_reduce_dims;
+  std::vector<int64_t> right_only_reduce_dims;
+
   for (int64_t i = 0; i < left_rank; ++i) {
     int64_t left_dim = left_dims[i];
     int64_t right_dim = right_dims[i];
@@ -137,11 +143,9 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
                     "Einsum op: Input dimensions must be equal along an axis to be reduced across all inputs");
         reduced_size *= left_dim;
       } else if (has_left_dim) {  // if it is only in one of left and right, we can reduce right away
-        current_left = EinsumOp::ReduceSum<T>(
-            left, left_dims, {i}, allocator_, tp_, einsum_ep_assets_, device_reduce_sum_func_);
+        left_only_reduce_dims.push_back(i);
       } else if (has_right_dim) {
-        current_right = EinsumOp::ReduceSum<T>(
-            right, right_dims, {i}, allocator_, tp_, einsum_ep_assets_, device_reduce_sum_func_);
+        right_only_reduce_dims.push_back(i);
       }
     } else {  // This dimension is not reduced (i.e.) it appears in the output after processing these 2 operands
       // Both the left and right operands have non-trivial dimension value along this axis
@@ -164,105 +168,143 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
     }
   }
 
-  // Permutate the left operand so that the axes order go like this: [lro, lo, reduce_dims, ro]
-  std::vector<size_t> left_permutation;
-  left_permutation.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
-  left_permutation.insert(left_permutation.end(), lro.begin(), lro.end());
-  left_permutation.insert(left_permutation.end(), lo.begin(), lo.end());
-  left_permutation.insert(left_permutation.end(), reduce_dims.begin(), reduce_dims.end());
-  left_permutation.insert(left_permutation.end(), ro.begin(), ro.end());
-  if (EinsumOp::IsTransposeRequired(current_left ? current_left->Shape().GetDims().size() : left_dims.size(),
-                                    left_permutation)) {
-    current_left = EinsumOp::Transpose(current_left ? *current_left : left,
-                                       current_left ? current_left->Shape().GetDims() : left_dims,
-                                       left_permutation, allocator_, einsum_ep_assets_,
-                                       device_transpose_func_);
+  if (!left_only_reduce_dims.empty()) {
+    current_left = EinsumOp::ReduceSum<T>(
+        left, left_dims, left_only_reduce_dims, allocator_, tp_, einsum_ep_assets_, device_reduce_sum_func_);
   }
-
-  // Permutate the right operand so that the axes order go like this: [lro, reduce_dims, ro, lo]
-  std::vector<size_t> right_permutation;
-  right_permutation.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
-  right_permutation.insert(right_permutation.end(), lro.begin(), lro.end());
-  right_permutation.insert(right_permutation.end(), reduce_dims.begin(), reduce_dims.end());
-  right_permutation.insert(right_permutation.end(), ro.begin(), ro.end());
-  right_permutation.insert(right_permutation.end(), lo.begin(), lo.end());
-  if (EinsumOp::IsTransposeRequired(current_right ? current_right->Shape().GetDims().size() : right_dims.size(),
-                                    right_permutation)) {
-    current_right = EinsumOp::Transpose(current_right ? *current_right : right,
-                                        current_right ? current_right->Shape().GetDims() : right_dims,
-                                        right_permutation, allocator_, einsum_ep_assets_,
-                                        device_transpose_func_);
+  if (!right_only_reduce_dims.empty()) {
+    current_right = EinsumOp::ReduceSum<T>(
+        right, right_dims, right_only_reduce_dims, allocator_, tp_, einsum_ep_assets_, device_reduce_sum_func_);
   }
 
-  // Calculate output size
-  // Output shape will be determined by rules of MatMul:
-  // because we are multiplying two tensors of shapes [lro, lo, reduce_dims] , [lro, reduce_dims, ro]
-  // [dim_value of `lro` dims,
-  //  dim_value of `lo` dims,
-  // `1` for each of the `reduce_dims`,
-  // dim_value of `ro` dims]
-  std::vector<int64_t> output_dims;
-  output_dims.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
-  for (size_t i = 0; i < lro.size(); ++i) {
-    output_dims.push_back(left_dims[lro[i]]);
-  }
-  for (size_t i = 0; i < lo.size(); ++i) {
-    output_dims.push_back(left_dims[lo[i]]);
+  std::vector<size_t> reduced;
+  reduced.reserve(reduce_dims.size());
+  for (auto dim : reduce_dims) {
+    reduced.push_back(static_cast<size_t>(dim));
   }
 
-  for (size_t i = 0; i < reduce_dims.size(); ++i) {
-    output_dims.push_back(1);  // reduced dimensions will have a value 1 in it
+  auto concat_axes = [](const std::vector<size_t>& first, const std::vector<size_t>& second,
+                        const std::vector<size_t>& third, const std::vector<size_t>& fourth) {
+    std::vector<size_t> axes;
+    axes.reserve(first.size() + second.size() + third.size() + fourth.size());
+    axes.insert(axes.end(), first.begin(), first.end());
+    axes.insert(axes.end(), second.begin(), second.end());
+    axes.insert(axes.end(), third.begin(), third.end());
+    axes.insert(axes.end(), fourth.begin(), fourth.end());
+    return axes;
+  };
+
+  // The MatMul multiplies a left operand of [lro, lo, reduce_dims] by a right operand of [lro, reduce_dims, ro]
+  // and either operand may be stored transposed (i.e.) as [lro, reduce_dims, lo] and [lro, ro, reduce_dims].
+  // Pick the layout an operand already has (ignoring the axes of dim value 1) to avoid transposing it.
+  const auto& current_left_dims = current_left ? current_left->Shape().GetDims() : left_dims;
+  auto left_permutation = concat_axes(lro, lo, reduced, ro);
+  bool transpose_left = false;
+  if (EinsumOp::IsTransposeRequired(current_left_dims, left_permutation)) {
+    auto transposed_left_permutation = concat_axes(lro, reduced, lo, ro);
+    if (!EinsumOp::IsTransposeRequired(current_left_dims, transposed_left_permutation)) {
+      transpose_left = true;
+    } else {
+      current_left = EinsumOp::Transpose(current_left ? *current_left : left, current_left_dims,
+                                         left_permutation, allocator_, einsum_ep_assets_,
+                                         device_transpose_func_);
+    }
   }
 
-  for (size_t i = 0; i < ro.size(); ++i) {
-    output_dims.push_back(right_dims[ro[i]]);
+  const auto& current_right_dims = current_right ? current_right->Shape().GetDims() : right_dims;
+  auto right_permutation = concat_axes(lro, reduced, ro, lo);
+  bool transpose_right = false;
+  if (EinsumOp::IsTransposeRequired(current_right_dims, right_permutation)) {
+    auto transposed_right_permutation = concat_axes(lro, ro, reduced, lo);
+    if (!EinsumOp::IsTransposeRequired(current_right_dims, transposed_right_permutation)) {
+      transpose_right = true;
+    } else {
+      current_right = EinsumOp::Transpose(current_right ? *current_right : right, current_right_dims,
+                                          right_permutation, allocator_, einsum_ep_assets_,
+                                          device_transpose_func_);
+    }
   }
 
-  std::vector<int64_t> current_subscript_order;
-
-  // Calculate output permutation
-  // After the MatMul op, the because the two operands have been permutated,
-  // the output is permutated as well with respect to the original ordering of the axes.
-  // The permutated order will be the dims in: [lro, lo, reduced_dims, ro]
-  // Hence invert the permutation by a permutation that puts the axes in the same ordering
-  std::vector<size_t> output_permutation;
-  if (!is_final_pair) {  // If this is not the final pair, we need to permutate the result to match the pre-fixed order for the next iteration
-    output_permutation.resize(lro.size() + lo.size() + reduce_dims.size() + ro.size(), 0);
-    size_t iter = 0;
-    for (size_t i = 0; i < lro.size(); ++i) {
-      output_permutation[lro[i]] = iter++;
+  std::vector<int64_t> left_matmul_dims = transpose_left ? std::vector<int64_t>{lro_size, reduced_size, lo_size}
+                                                         : std::vector<int64_t>{lro_size, lo_size, reduced_size};
+  std::vector<int64_t> right_matmul_dims = transpose_right ? std::vector<int64_t>{lro_size, ro_size, reduced_size}
+                                                           : std::vector<int64_t>{lro_size, reduced_size, ro_size};
+
+  // The MatMul output is [lro, lo, reduce_dims, ro] (with `1` for each of the `reduce_dims`)
+  // Multiplying the swapped operands gives [lro, ro, reduce_dims, lo] instead, which is used
+  // if that is already the order required downstream - the homogenized order for the next pair-wise operation
+  // or the op's output order for the final pair
+  const auto& subscript_indices_to_output_indices = einsum_compute_preprocessor_.GetMappedSubscriptIndicesToOutputindices();
+  auto get_output_dims = [&](const std::vector<size_t>& axes) {
+    std::vector<int64_t> dims;
+    dims.reserve(axes.size());
+    for (auto axis : axes) {
+      bool is_reduced = std::find(reduced.begin(), reduced.end(), axis) != reduced.end();
+      bool is_right_only = std::find(ro.begin(), ro.end(), axis) != ro.end();
+      dims.push_back(is_reduced ? 1 : (is_right_only ? right_dims[axis] : left_dims[axis]));
     }
-    for (size_t i = 0; i < lo.size(); ++i) {
-      output_permutation[lo[i]] = iter++;
-    }
-    for (size_t i = 0; i < reduce_dims.size(); ++i) {
-      output_permutation[reduce_dims[i]] = iter++;
+    return dims;
+  };
+  auto is_in_required_order = [&](const std::vector<size_t>& axes, const std::vector<int64_t>& dims) {
+    int64_t last_position = -1;
+    for (size_t i = 0; i < axes.size(); ++i) {
+      if (dims[i] == 1) {
+        continue;
+      }
+      int64_t position = is_final_pair ? subscript_indices_to_output_indices[axes[i]] : static_cast<int64_t>(axes[i]);
+      if (position < last_position) {
+        return false;
+      }
+      last_position = position;
     }
-    for (size_t i = 0; i < ro.size(); ++i) {
-      output_permutation[ro[i]] = iter++;
+    return true;
+  };
+
+  auto output_axes = concat_axes(lro, lo, reduced, ro);
+  auto output_dims = get_output_dims(output_axes);
+  bool swap_operands = false;
+  if (!is_in_required_order(output_axes, output_dims)) {
+    auto swapped_output_axes = concat_axes(lro, ro, reduced, lo);
+    auto swapped_output_dims = get_output_dims(swapped_output_axes);
+    if (is_in_required_order(swapped_output_axes, swapped_output_dims)) {
+      swap_operands = true;
+      output_axes = std::move(swapped_output_axes);
+      output_dims = std::move(swapped_output_dims);
     }
-  } else {
-    current_subscript_order.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
-    current_subscript_order.insert(current_subscript_order.end(), lro.begin(), lro.end());
-    current_subscript_order.insert(current_subscript_order.end(), lo.begin(), lo.end());
-    current_subscript_order.insert(current_subscript_order.end(), reduce_dims.begin(), reduce_dims.end());
-    current_subscript_order.insert(current_subscript_order.end(), ro.begin(), ro.end());
   }
 
   // Multiply the mutated inputs
-  auto output = EinsumOp::MatMul<T>(current_left ? *current_left : left, {lro_size, lo_size, reduced_size},
-                                    current_right ? *current_right : right, {lro_size, reduced_size, ro_size},
-                                    allocator_, tp_, einsum_ep_assets_, device_matmul_func_);
+  std::unique_ptr<Tensor> output;
+  if (swap_operands) {
+    output = EinsumOp::MatMul<T>(current_right ? *current_right : right, right_matmul_dims, !transpose_right,
+                                 current_left ? *current_left : left, left_matmul_dims, !transpose_left,
+                                 allocator_, tp_, einsum_ep_assets_, device_matmul_func_);
+  } else {
+    output = EinsumOp::MatMul<T>(current_left ? *current_left : left, left_matmul_dims, transpose_left,
+                                 current_right ? *current_right : right, right_matmul_dims, transpose_right,
+                                 allocator_, tp_, einsum_ep_assets_, device_matmul_func_);
+  }
 
   output->Reshape(output_dims);
 
   if (!is_final_pair) {  // This is not the final pair - so bring the axes order to what the inputs conformed to
-    if (EinsumOp::IsTransposeRequired(output_dims.size(), output_permutation)) {
+    // Invert the permutation of the axes relative to their original ordering
+    std::vector<size_t> output_permutation(output_axes.size(), 0);
+    std::vector<int64_t> homogenized_output_dims(output_axes.size(), 1);
+    for (size_t i = 0; i < output_axes.size(); ++i) {
+      output_permutation[output_axes[i]] = i;
+      homogenized_output_dims[output_axes[i]] = output_dims[i];
+    }
+
+    if (EinsumOp::IsTransposeRequired(output_dims, output_permutation)) {
       output = EinsumOp::Transpose(*output, output_dims, output_permutation, allocator_,
                                    einsum_ep_assets_, device_transpose_func_);
+    } else {
+      output->Reshape(homogenized_output_dims);
     }
   } else {  // This is the final pair - Transpose directly to the output ordering required and copy the contents to the op's output
-    FinalizeOutput(*output, current_subscript_order);
+    std::vector<int64_t> current_subscript_order(output_axes.begin(), output_axes.end());
+    FinalizeOutput(*output, output_dims, current_subscript_order);
   }
 
   return output;
@@ -283,6 +325,8 @@ template <typename T>
 Status EinsumTypedComputeProcessor<T>::Run() {
   const auto& mapped_indices_to_last_input_index = einsum_compute_preprocessor_.GetMappedSubscriptIndicesToLastInputIndex();
 
+  const auto& mapped_indices_to_output_indices = einsum_compute_preprocessor_.GetMappedSubscriptIndicesToOutputindices();
+
   auto& preprocessed_inputs = einsum_compute_preprocessor_.GetPreprocessedInputTensors();
 
   const auto& raw_inputs = einsum_compute_preprocessor_.GetRawInputTensors();
@@ -293,22 +337,19 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
   auto num_inputs = context_->InputCount();
 
-  // Pre-process the first input so as to reduce any dims that only it has
-  std::unique_ptr<const Tensor> result;
-
-  {
+  // Reduce any dims that only the single input has and finalize the output
+  if (num_inputs == 1) {
+    std::unique_ptr<const Tensor> result;
     std::vector<int64_t> reduced_dims;
-    std::vector<int64_t> preserved_dims;           // dims which were not reduced
-    std::vector<int64_t> preserved_shape;          // shape pertaining to only the dims that were preserved (not reduced)
+    std::vector<int64_t> subscript_indices;        // the reduced dims are kept with a dim value of 1
     reduced_dims.reserve(num_subscript_labels);    // num_subscript_labels is the upper bound. No harm in over-reserving.
-    preserved_dims.reserve(num_subscript_labels);  // num_subscript_labels is the upper bound. No harm in over-reserving.
+    subscript_indices.reserve(num_subscript_labels);
 
     for (int64_t i = 0; i < num_subscript_labels; ++i) {
       if (mapped_indices_to_last_input_index[i] == 0) {
         reduced_dims.push_back(i);
-      } else {
-        preserved_dims.push_back(i);
       }
+      subscript_indices.push_back(i);
     }
 
     // Reduce the dims that are last seen in the first input alone
@@ -324,39 +365,70 @@ Status EinsumTypedComputeProcessor<T>::Run() {
       }
     }
 
-    // Finalize the output at this stage if num_inputs == 1
-    if (num_inputs == 1) {
-      // Finalize the output by applying any transpose required to get
-      // it to the required output ordering and move it to the op's output
-      FinalizeOutput(result ? *result : *raw_inputs[0], preserved_dims);
+    // Finalize the output by applying any transpose required to get
+    // it to the required output ordering and move it to the op's output
+    FinalizeOutput(result ? *result : *raw_inputs[0],
+                   result ? result->Shape().GetDims() : homogenized_input_dims[0].GetDims(),
+                   subscript_indices);
 
-      return Status::OK();
-    }
+    return Status::OK();
   }
 
-  // Process the operands in a pair-wise fashion
-  {
-    bool is_final_pair = false;
-    // Keep processing each input pair-wise
-    for (int input = 1; input < num_inputs; ++input) {
-      std::vector<int64_t> reduced_dims;
-      reduced_dims.reserve(num_subscript_labels);  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
-      for (int64_t dim = 0; dim < num_subscript_labels; ++dim) {
-        if (mapped_indices_to_last_input_index[dim] == input) {
-          // This is the last input we are seeing this dimension (and it doesn't occur in the output), so reduce along the dimension
-          reduced_dims.push_back(dim);
-        }
+  // Process the operands in a pair-wise fashion in the order of the contraction path
+  // (The operand `num_inputs + i` is the result of the i-th pair-wise operation)
+  ORT_ENFORCE(contraction_path_.size() == static_cast<size_t>(num_inputs - 1),
+              "Einsum op: The contraction path must have a pair-wise operation for each input but the first");
+
+  std::vector<std::unique_ptr<Tensor>> intermediate_results;
+  intermediate_results.reserve(num_inputs - 1);
+
+  std::vector<TensorShape> operand_dims(homogenized_input_dims.begin(), homogenized_input_dims.end());
+  std::vector<bool> is_operand_pending(num_inputs, true);
+
+  auto get_operand = [&](size_t operand) -> const Tensor& {
+    if (operand >= static_cast<size_t>(num_inputs)) {
+      return *intermediate_results[operand - num_inputs];
+    }
+    // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
+    return preprocessed_inputs[operand] ? *preprocessed_inputs[operand] : *raw_inputs[operand];
+  };
+
+  for (size_t step = 0, num_steps = contraction_path_.size(); step < num_steps; ++step) {
+    size_t left = contraction_path_[step].first;
+    size_t right = contraction_path_[step].second;
+    is_operand_pending[left] = false;
+    is_operand_pending[right] = false;
+
+    std::vector<int64_t> reduced_dims;
+    reduced_dims.reserve(num_subscript_labels);  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
+    for (int64_t dim = 0; dim < num_subscript_labels; ++dim) {
+      if (mapped_indices_to_output_indices[dim] != -1) {
+        continue;
+      }
+      // If none of the operands yet to be processed has this dimension (and it doesn't occur in the output), reduce along the dimension
+      bool is_seen_later = false;
+      for (size_t operand = 0; operand < operand_dims.size() && !is_seen_later; ++operand) {
+        is_seen_later = is_operand_pending[operand] && operand_dims[operand][dim] > 1;
+      }
+      if (!is_seen_later) {
+        reduced_dims.push_back(dim);
       }
-      if (input == num_inputs - 1) {
-        is_final_pair = true;
+    }
+
+    auto result = PairwiseOperandProcess(get_operand(left), operand_dims[left],
+                                         get_operand(right), operand_dims[right],
+                                         reduced_dims, step == num_steps - 1);
+
+    // Release the intermediate results that have been consumed
+    for (auto operand : {left, right}) {
+      if (operand >= static_cast<size_t>(num_inputs)) {
+        intermediate_results[operand - num_inputs].reset();
       }
-      // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
-      result = PairwiseOperandProcess(result ? *result : *raw_inputs[0],
-                                      result ? result->Shape() : homogenized_input_dims[0],
-                                      preprocessed_inputs[input] ? *preprocessed_inputs[input] : *raw_inputs[input],
-                                      homogenized_input_dims[input],
-                                      reduced_dims, is_final_pair);
     }
+
+    operand_dims.push_back(result->Shape());
+    is_operand_pending.push_back(true);
+    intermediate_results.push_back(std::move(result));
   }
 
   return Status::OK();
@@ -9,6 +9,7 @@
 
 #include "einsum_auxiliary_ops.h"
 #include "einsum_compute_preprocessor.h"
+#include "einsum_contraction_path.h"
 
 namespace onnxruntime {
 
@@ -19,11 +20,13 @@ class EinsumTypedComputeProcessor {
   explicit EinsumTypedComputeProcessor(OpKernelContext* context, AllocatorPtr allocator,
                                        concurrency::ThreadPool* tp,
                                        EinsumComputePreprocessor& einsum_compute_preprocessor,
+                                       const EinsumOp::ContractionPath& contraction_path,
                                        void* einsum_cuda_assets)
       : context_(context),
         allocator_(allocator),
         tp_(tp),
         einsum_compute_preprocessor_(einsum_compute_preprocessor),
+        contraction_path_(contraction_path),
         einsum_ep_assets_(einsum_cuda_assets) {}
 
   // Pass-in device specific functions
@@ -41,6 +44,7 @@ class EinsumTypedComputeProcessor {
   // Processes Einsum operands in a pair-wise fashion
   // Employs Transpose, ReduceSum, and MatMul under the hood
   // to achieve MatMul(a, b) and reduces (by summing) along specified axes
+  // The operands are only transposed if their layout can't be handled by a (batched) MatMul with transposed inputs
   std::unique_ptr<Tensor> PairwiseOperandProcess(const Tensor& left,
                                                  const TensorShape& left_shape_override,
                                                  const Tensor& right,
@@ -51,7 +55,9 @@ class EinsumTypedComputeProcessor {
   // Here we take a "candidate output"(candidate output is a tensor that is a permutation and / or a reshape away from the final output),
   // and after a few operations to get it to the required output structure, copy it to the op's output
   // The candidate output might contain dims that may not be part of the op's output (i.e.) the dims will have to be unsqueezed
+  // The candidate output is read with `candidate_output_dims` which correspond to `ordered_subscript_indices_in_candidate`
   void FinalizeOutput(const Tensor& candidate_output,
+                      const std::vector<int64_t>& candidate_output_dims,
                       const std::vector<int64_t>& ordered_subscript_indices_in_candidate);
 
   // Private members -
@@ -60,6 +66,9 @@ class EinsumTypedComputeProcessor {
   concurrency::ThreadPool* tp_;
   EinsumComputePreprocessor& einsum_compute_preprocessor_;
 
+  // The order in which the operands are processed pair-wise
+  const EinsumOp::ContractionPath& contraction_path_;
+
   EinsumOp::DeviceHelpers::Transpose device_transpose_func_;
   EinsumOp::DeviceHelpers::MatMul<T> device_matmul_func_;
   EinsumOp::DeviceHelpers::ReduceSum<T> device_reduce_sum_func_;
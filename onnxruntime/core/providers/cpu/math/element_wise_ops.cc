@@ -56,6 +56,40 @@ void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
           .TypeConstraint("T1", DataTypeImpl::GetTensorType<bool>()),                                           \
       KERNEL_CLASS<TYPE>);
 
+// the output of these kernels only depends on the input elements at the same index, so the planner may let the output
+// reuse the buffer of the input (unary ops) or of either input (binary ops) if that input isn't broadcast
+#define REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS, ...) \
+  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                      \
+      OP_TYPE,                                                                         \
+      VERSION,                                                                         \
+      TYPE,                                                                            \
+      KernelDefBuilder()                                                               \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>())                    \
+          .MayInplace(__VA_ARGS__),                                                    \
+      KERNEL_CLASS<TYPE>);
+
+#define REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(OP_TYPE, VERSION_FROM, VERSION_TO, TYPE, KERNEL_CLASS, ...) \
+  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                                                       \
+      OP_TYPE,                                                                                                    \
+      VERSION_FROM, VERSION_TO,                                                                                   \
+      TYPE,                                                                                                       \
+      KernelDefBuilder()                                                                                          \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>())                                               \
+          .MayInplace(__VA_ARGS__),                                                                               \
+      KERNEL_CLASS<TYPE>);
+
+#define REG_ELEMENTWISE_UNARY_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS) \
+  REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS, {{0, 0}})
+
+#define REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(OP_TYPE, VERSION_FROM, VERSION_TO, TYPE, KERNEL_CLASS) \
+  REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(OP_TYPE, VERSION_FROM, VERSION_TO, TYPE, KERNEL_CLASS, {{0, 0}})
+
+#define REG_ELEMENTWISE_BINARY_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS) \
+  REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS, {{0, 0}, {1, 0}})
+
+#define REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(OP_TYPE, VERSION_FROM, VERSION_TO, TYPE, KERNEL_CLASS) \
+  REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(OP_TYPE, VERSION_FROM, VERSION_TO, TYPE, KERNEL_CLASS, {{0, 0}, {1, 0}})
+
 // var args are type constraints for T and T1
 #define REG_ELEMENTWISE_KERNEL_NONT(OP_TYPE, VERSION, KERNEL_CLASS, ...)   \
   ONNX_CPU_OPERATOR_KERNEL(                                                \
@@ -77,90 +111,90 @@ void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
           .TypeConstraint("T1", BuildKernelDefConstraints<__VA_ARGS__>()),                          \
       KERNEL_CLASS);
 
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, float, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, double, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int32_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int64_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 13, float, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 13, double, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 13, int32_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 13, int64_t, Add);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, float, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, double, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int32_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int64_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 13, float, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 13, double, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 13, int32_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 13, int64_t, Sub);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, float, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, double, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int32_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int64_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 13, float, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 13, double, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 13, int32_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 13, int64_t, Mul);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, float, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, double, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int32_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int64_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 13, float, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 13, double, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 13, int32_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 13, int64_t, Div);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, float, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, double, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int8_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int16_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int32_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int64_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint8_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint16_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint32_t, Abs);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint64_t, Abs);
-
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, float, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, double, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, int8_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, int16_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, int32_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, int64_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, uint8_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, uint16_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, uint32_t, Abs);
-REG_ELEMENTWISE_TYPED_KERNEL(Abs, 13, uint64_t, Abs);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, float, Neg);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, double, Neg);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int8_t, Neg);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int32_t, Neg);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int64_t, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, float, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, double, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, int8_t, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, int32_t, Neg);
-REG_ELEMENTWISE_TYPED_KERNEL(Neg, 13, int64_t, Neg);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Floor, 6, 12, float, Floor);
-REG_ELEMENTWISE_TYPED_KERNEL(Floor, 13, float, Floor);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Ceil, 6, 12, float, Ceil);
-REG_ELEMENTWISE_TYPED_KERNEL(Ceil, 13, float, Ceil);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Reciprocal, 6, 12, float, Reciprocal);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Reciprocal, 6, 12, double, Reciprocal);
-REG_ELEMENTWISE_TYPED_KERNEL(Reciprocal, 13, float, Reciprocal);
-REG_ELEMENTWISE_TYPED_KERNEL(Reciprocal, 13, double, Reciprocal);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sqrt, 6, 12, float, Sqrt);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sqrt, 6, 12, double, Sqrt);
-REG_ELEMENTWISE_TYPED_KERNEL(Sqrt, 13, float, Sqrt);
-REG_ELEMENTWISE_TYPED_KERNEL(Sqrt, 13, double, Sqrt);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Add, 7, 12, float, Add);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Add, 7, 12, double, Add);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Add, 7, 12, int32_t, Add);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Add, 7, 12, int64_t, Add);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Add, 13, float, Add);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Add, 13, double, Add);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Add, 13, int32_t, Add);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Add, 13, int64_t, Add);
+
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Sub, 7, 12, float, Sub);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Sub, 7, 12, double, Sub);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int32_t, Sub);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int64_t, Sub);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Sub, 13, float, Sub);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Sub, 13, double, Sub);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Sub, 13, int32_t, Sub);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Sub, 13, int64_t, Sub);
+
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Mul, 7, 12, float, Mul);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Mul, 7, 12, double, Mul);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int32_t, Mul);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int64_t, Mul);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Mul, 13, float, Mul);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Mul, 13, double, Mul);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Mul, 13, int32_t, Mul);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Mul, 13, int64_t, Mul);
+
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Div, 7, 12, float, Div);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Div, 7, 12, double, Div);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Div, 7, 12, int32_t, Div);
+REG_ELEMENTWISE_BINARY_VERSIONED_TYPED_KERNEL(Div, 7, 12, int64_t, Div);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Div, 13, float, Div);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Div, 13, double, Div);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Div, 13, int32_t, Div);
+REG_ELEMENTWISE_BINARY_TYPED_KERNEL(Div, 13, int64_t, Div);
+
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Abs, 6, 12, float, Abs);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Abs, 6, 12, double, Abs);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int8_t, Abs);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int16_t, Abs);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int32_t, Abs);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Abs, 6, 12, int64_t, Abs);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint8_t, Abs);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint16_t, Abs);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint32_t, Abs);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Abs, 6, 12, uint64_t, Abs);
+
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Abs, 13, float, Abs);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Abs, 13, double, Abs);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Abs, 13, int8_t, Abs);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Abs, 13, int16_t, Abs);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Abs, 13, int32_t, Abs);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Abs, 13, int64_t, Abs);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Abs, 13, uint8_t, Abs);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Abs, 13, uint16_t, Abs);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Abs, 13, uint32_t, Abs);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Abs, 13, uint64_t, Abs);
+
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Neg, 6, 12, float, Neg);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Neg, 6, 12, double, Neg);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int8_t, Neg);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int32_t, Neg);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Neg, 6, 12, int64_t, Neg);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Neg, 13, float, Neg);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Neg, 13, double, Neg);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Neg, 13, int8_t, Neg);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Neg, 13, int32_t, Neg);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Neg, 13, int64_t, Neg);
+
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Floor, 6, 12, float, Floor);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Floor, 13, float, Floor);
+
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Ceil, 6, 12, float, Ceil);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Ceil, 13, float, Ceil);
+
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Reciprocal, 6, 12, float, Reciprocal);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Reciprocal, 6, 12, double, Reciprocal);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Reciprocal, 13, float, Reciprocal);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Reciprocal, 13, double, Reciprocal);
+
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Sqrt, 6, 12, float, Sqrt);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Sqrt, 6, 12, double, Sqrt);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Sqrt, 13, float, Sqrt);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Sqrt, 13, double, Sqrt);
 
 REG_ELEMENTWISE_VERSIONED_KERNEL_NONT(Pow, 7, 11, Pow, float, double);
 // To reduce templetization we choose to support the below types for both
@@ -168,15 +202,15 @@ REG_ELEMENTWISE_VERSIONED_KERNEL_NONT(Pow, 7, 11, Pow, float, double);
 REG_ELEMENTWISE_VERSIONED_KERNEL_NONT(Pow, 12, 12, Pow, int32_t, int64_t, float, double);
 REG_ELEMENTWISE_KERNEL_NONT(Pow, 13, Pow, int32_t, int64_t, float, double);
 
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Exp, 6, 12, float, Exp);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Exp, 6, 12, double, Exp);
-REG_ELEMENTWISE_TYPED_KERNEL(Exp, 13, float, Exp);
-REG_ELEMENTWISE_TYPED_KERNEL(Exp, 13, double, Exp);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Exp, 6, 12, float, Exp);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Exp, 6, 12, double, Exp);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Exp, 13, float, Exp);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Exp, 13, double, Exp);
 
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Log, 6, 12, float, Log);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Log, 6, 12, double, Log);
-REG_ELEMENTWISE_TYPED_KERNEL(Log, 13, float, Log);
-REG_ELEMENTWISE_TYPED_KERNEL(Log, 13, double, Log);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Log, 6, 12, float, Log);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Log, 6, 12, double, Log);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Log, 13, float, Log);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Log, 13, double, Log);
 
 REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sum, 6, 7, float, Sum_6);
 REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sum, 6, 7, double, Sum_6);
@@ -246,9 +280,9 @@ REG_ELEMENTWISE_TYPED_KERNEL(BitShift, 11, uint8_t, BitShift);
 REG_ELEMENTWISE_TYPED_KERNEL(BitShift, 11, uint32_t, BitShift);
 REG_ELEMENTWISE_TYPED_KERNEL(BitShift, 11, uint64_t, BitShift);
 
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Erf, 9, 12, float, Erf);
+REG_ELEMENTWISE_UNARY_VERSIONED_TYPED_KERNEL(Erf, 9, 12, float, Erf);
 // Supposed to add BFloat16 but we are not supporting now, however, separate registration
-REG_ELEMENTWISE_TYPED_KERNEL(Erf, 13, float, Erf);
+REG_ELEMENTWISE_UNARY_TYPED_KERNEL(Erf, 13, float, Erf);
 
 // REG_ELEMENTWISE_LOGICALOP_TYPED_KERNEL(Not, 1, bool, Not);
 // REG_ELEMENTWISE_LOGICALOP_TYPED_KERNEL(And, 7, bool, And);
@@ -1467,7 +1501,7 @@ void BroadCastFMod(OpKernelContext* context) {
                        });
       }};
 
-  UntypedBroadcastTwo(*context, funcs);
+  UntypedBroadcastTwo(*context, funcs, 1.0);
 }
 
 template <class T>
@@ -1513,7 +1547,7 @@ void BroadCastMod(OpKernelContext* context) {
                        });
       }};
 
-  UntypedBroadcastTwo(*context, funcs);
+  UntypedBroadcastTwo(*context, funcs, 1.0);
 }
 
 void BroadCastMFloat16FMod(OpKernelContext* context) {
@@ -1551,7 +1585,7 @@ void BroadCastMFloat16FMod(OpKernelContext* context) {
                        });
       }};
 
-  UntypedBroadcastTwo(*context, funcs);
+  UntypedBroadcastTwo(*context, funcs, 1.0);
 }
 
 // Generic implementation of Mod kernel
@@ -1611,6 +1645,111 @@ void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFun
   BroadcastLooper(broadcast_helper, funcs);
 }
 
+// Broadcasting shapes such as {N, H, W, 3} and {3} is processed in spans of 3 elements, and the per-span cost
+// dominates. Spans shorter than this are widened by expanding the input that is broadcast next to the span.
+static constexpr int64_t kMinBroadcastSpanSize = 64;
+
+// Expand input to dims. Each dim of input must either be 1 or match the respective entry of dims.
+static std::unique_ptr<Tensor> ExpandInput(const Tensor& input, const std::vector<int64_t>& dims,
+                                           const AllocatorPtr& allocator) {
+  auto expanded = onnxruntime::make_unique<Tensor>(input.DataType(), TensorShape(dims), allocator);
+
+  Broadcaster broadcaster(input.Shape().GetDims(), dims);
+  const size_t element_size = input.DataType()->Size();
+  const size_t span_size = broadcaster.GetSpanSize();
+  const size_t num_spans = static_cast<size_t>(expanded->Shape().Size()) / span_size;
+  const bool broadcast_span = broadcaster.iterator1_.deltas_.front() == 0;
+
+  const auto* input_bytes = static_cast<const uint8_t*>(input.DataRaw());
+  auto* output_bytes = static_cast<uint8_t*>(expanded->MutableDataRaw());
+
+  for (size_t i = 0; i < num_spans; i++) {
+    const uint8_t* span_bytes = input_bytes + broadcaster.iterator1_.AdvanceBy(span_size) * element_size;
+    if (broadcast_span) {
+      for (size_t j = 0; j < span_size; j++) {
+        memcpy(output_bytes + j * element_size, span_bytes, element_size);
+      }
+    } else {
+      memcpy(output_bytes, span_bytes, span_size * element_size);
+    }
+    output_bytes += span_size * element_size;
+  }
+
+  return expanded;
+}
+
+// If broadcasting input0 and input1 would produce short spans, expand the input that is broadcast along the axes
+// next to the span so that the span gets longer. Returns the index of the expanded input, or -1 if it's not
+// worthwhile, e.g. when the expanded input would not be small compared to the output.
+static int WidenBroadcastSpan(const Tensor& input0, const Tensor& input1, const TensorShape& output_shape,
+                              OpKernelContext& context, std::unique_ptr<Tensor>& widened_input) {
+  if (input0.IsDataTypeString() || input1.IsDataTypeString()) {
+    return -1;
+  }
+
+  const std::vector<int64_t>& dims0 = input0.Shape().GetDims();
+  const std::vector<int64_t>& dims1 = input1.Shape().GetDims();
+  const std::vector<int64_t>& output_dims = output_shape.GetDims();
+  const size_t rank = output_dims.size();
+
+  // dim of the input for the output axis, with the leading axes of lower rank inputs being 1
+  auto input_dim = [rank](const std::vector<int64_t>& dims, size_t axis) {
+    return axis < rank - dims.size() ? int64_t{1} : dims[axis - (rank - dims.size())];
+  };
+
+  // the span covers the trailing axes where neither input is broadcast
+  size_t axis = rank;
+  int64_t span_size = 1;
+  for (; axis > 0; axis--) {
+    const int64_t dim = output_dims[axis - 1];
+    if (dim != 1 && (input_dim(dims0, axis - 1) != dim || input_dim(dims1, axis - 1) != dim)) {
+      break;
+    }
+    span_size *= dim;
+  }
+
+  // spans with a broadcast innermost axis use the scalar functions, which don't need widening
+  if (span_size == 1 || span_size >= kMinBroadcastSpanSize || axis == 0) {
+    return -1;
+  }
+
+  const int widen_index = input_dim(dims0, axis - 1) == 1 ? 0 : 1;
+  const std::vector<int64_t>& widen_dims = widen_index == 0 ? dims0 : dims1;
+  const std::vector<int64_t>& other_dims = widen_index == 0 ? dims1 : dims0;
+
+  // absorb the axes along which only the widened input is broadcast
+  const size_t span_axis = axis;
+  for (; axis > 0 && span_size < kMinBroadcastSpanSize; axis--) {
+    const int64_t dim = output_dims[axis - 1];
+    if (input_dim(other_dims, axis - 1) != dim) {
+      break;
+    }
+    span_size *= dim;
+  }
+
+  if (axis == span_axis) {
+    return -1;
+  }
+
+  std::vector<int64_t> expanded_dims(rank);
+  int64_t expanded_size = 1;
+  for (size_t i = 0; i < rank; i++) {
+    expanded_dims[i] = i < axis ? input_dim(widen_dims, i) : output_dims[i];
+    expanded_size *= expanded_dims[i];
+  }
+
+  // the expansion is a copy, so it has to be cheap compared to processing the output
+  if (expanded_size * 4 > output_shape.Size()) {
+    return -1;
+  }
+
+  AllocatorPtr allocator;
+  ORT_THROW_IF_ERROR(context.GetTempSpaceAllocator(&allocator));
+  widened_input = ExpandInput(widen_index == 0 ? input0 : input1, expanded_dims, allocator);
+
+  return widen_index;
+}
+
 // Variant of UntypedBroadcastTwo that will parallelize.
 // Operator usage is the same as the parallelization is opaque to the operator.
 // unit_cost must be a valid cost value.
@@ -1623,7 +1762,7 @@ void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFun
   Tensor& output_tensor = *context.Output(0, input_broadcaster.GetOutputShape());
 
   size_t span_size = input_broadcaster.GetSpanSize();
-  size_t output_size = static_cast<ptrdiff_t>(output_tensor.Shape().Size());
+  size_t output_size = static_cast<size_t>(output_tensor.Shape().Size());
 
   // one or more zero dimensions so nothing more to do
   if (output_size == 0) {
@@ -1632,25 +1771,48 @@ void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFun
 
   concurrency::ThreadPool* tp = context.GetOperatorThreadPool();
 
+  if (span_size < static_cast<size_t>(kMinBroadcastSpanSize) && span_size < output_size) {
+    std::unique_ptr<Tensor> widened_input;
+    int widened_index = WidenBroadcastSpan(input0_tensor, input1_tensor, output_tensor.Shape(), context,
+                                           widened_input);
+    if (widened_index >= 0) {
+      InputBroadcaster widened_broadcaster(widened_index == 0 ? *widened_input : input0_tensor,
+                                           widened_index == 1 ? *widened_input : input1_tensor);
+      ParallelizeBroadcastTwo(widened_broadcaster, output_tensor, funcs, tp, unit_cost, user_data);
+      return;
+    }
+  }
+
+  ParallelizeBroadcastTwo(input_broadcaster, output_tensor, funcs, tp, unit_cost, user_data);
+}
+
+void ParallelizeBroadcastTwo(const InputBroadcaster& input_broadcaster, Tensor& output_tensor,
+                             const ProcessBroadcastSpanFuncs& funcs, concurrency::ThreadPool* tp, double unit_cost,
+                             void* user_data) {
+  size_t span_size = input_broadcaster.GetSpanSize();
+  size_t output_size = static_cast<size_t>(output_tensor.Shape().Size());
+
+  // one or more zero dimensions so nothing more to do
+  if (output_size == 0) {
+    return;
+  }
+
   if (span_size == output_size) {  // Input data will be processed in a single span, so parallelize within the span
+    InputBroadcaster span_input_broadcaster(input_broadcaster);
     OutputBroadcaster output_broadcaster(span_size, output_tensor);
-    BroadcastHelper broadcast_helper(input_broadcaster, output_broadcaster, user_data, tp, unit_cost);
+    BroadcastHelper broadcast_helper(span_input_broadcaster, output_broadcaster, user_data, tp, unit_cost);
     BroadcastLooper(broadcast_helper, funcs);
   } else {
     // Input data will be processed in multiple spans, so parallelize across spans.
-
-    // enforce const on input broadcaster we copy from
-    const InputBroadcaster& const_input_broadcaster = input_broadcaster;
-
     concurrency::ThreadPool::TryParallelFor(
         tp, output_size / span_size,
         TensorOpCost{static_cast<float>(input_broadcaster.Input0ElementSize() * span_size),
                      static_cast<float>(output_tensor.DataType()->Size() * span_size),
                      unit_cost * span_size},
-        [span_size, &const_input_broadcaster, &output_tensor, &funcs, user_data](std::ptrdiff_t first_span,
-                                                                                 std::ptrdiff_t last_span) {
+        [span_size, &input_broadcaster, &output_tensor, &funcs, user_data](std::ptrdiff_t first_span,
+                                                                           std::ptrdiff_t last_span) {
           // copy original input_broadcaster (which is at start of all input) and advance to this segment
-          InputBroadcaster segment_input_broadcaster(const_input_broadcaster);
+          InputBroadcaster segment_input_broadcaster(input_broadcaster);
           segment_input_broadcaster.AdvanceBy(first_span * span_size);
 
           // create broadcaster for this segment of output
@@ -1697,10 +1859,7 @@ static void UntypedBroadcastVariadic(int input_count, OpKernelContext& context,
       p_output = temp_output.get();
     }
 
-    OutputBroadcaster output_broadcaster(input_broadcaster.GetSpanSize(), *p_output);
-    BroadcastHelper broadcast_helper(input_broadcaster, output_broadcaster);
-
-    BroadcastLooper(broadcast_helper, funcs);
+    ParallelizeBroadcastTwo(input_broadcaster, *p_output, funcs, context.GetOperatorThreadPool(), 1.0);
 
     temp_input = std::move(temp_output);
   }
@@ -919,6 +919,15 @@ void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFun
 void UntypedBroadcastTwo(OpKernelContext& context, const ProcessBroadcastSpanFuncs& funcs, double unit_cost,
                          void* user_data = nullptr);
 
+// Broadcast two inputs into output with parallelization.
+//
+// The processing is parallelized within the span if the output is a single span, or across spans otherwise.
+// This allows operators that setup the InputBroadcaster themselves, or produce temporary outputs, to share the
+// parallelization of UntypedBroadcastTwo. unit_cost must be a valid cost value.
+void ParallelizeBroadcastTwo(const InputBroadcaster& input_broadcaster, Tensor& output,
+                             const ProcessBroadcastSpanFuncs& funcs, concurrency::ThreadPool* tp, double unit_cost,
+                             void* user_data = nullptr);
+
 // Helper to provide the looping logic with optimization for parallelizing within a single span if the
 // TBroadcastHelper instance was setup to enable that.
 template <typename TBroadcastHelper>
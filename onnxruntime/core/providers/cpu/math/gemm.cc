@@ -6,6 +6,7 @@
 #include "core/util/math_cpuonly.h"
 #include "gemm_helper.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 
@@ -70,10 +71,11 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     Gemm<double>);
 
-bool GemmPackBFp32(const OpKernelInfo& info,
+bool GemmPackBFp32(AllocatorPtr& alloc,
                    const Tensor& tensor_b,
                    bool trans_b,
                    BufferUniquePtr& packed_b,
+                   size_t& packed_b_size,
                    TensorShape& b_shape) {
   // Only handle the common case of a 2D weight matrix. Additional matrices
   // could be handled by stacking the packed buffers.
@@ -85,12 +87,11 @@ bool GemmPackBFp32(const OpKernelInfo& info,
   const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
   const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
 
-  const size_t packed_b_size = MlasGemmPackBSize(N, K);
+  packed_b_size = MlasGemmPackBSize(N, K);
   if (packed_b_size == 0) {
     return false;
   }
 
-  auto alloc = info.GetAllocator(0, OrtMemTypeDefault);
   auto* packed_b_data = alloc->Alloc(packed_b_size);
   packed_b = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
   MlasGemmPackB(trans_b ? CblasTrans : CblasNoTrans,
@@ -102,6 +103,68 @@ bool GemmPackBFp32(const OpKernelInfo& info,
   return true;
 }
 
+GemmPackedBPrecision GetGemmPackedBPrecision(const OpKernelInfo& info) {
+  const std::string precision = info.GetConfigOrDefault(kOrtSessionOptionsConfigCpuGemmWeightPrecision, "FP32");
+  if (precision == "FP16") {
+    return GemmPackedBPrecision::Fp16;
+  }
+  if (precision == "BF16") {
+    return GemmPackedBPrecision::Bf16;
+  }
+  ORT_ENFORCE(precision == "FP32", "Invalid value '", precision, "' for ",
+              kOrtSessionOptionsConfigCpuGemmWeightPrecision, ". Supported values are FP32, FP16 and BF16.");
+  return GemmPackedBPrecision::Fp32;
+}
+
+bool GemmPackBHalf(AllocatorPtr& alloc,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   GemmPackedBPrecision precision,
+                   BufferUniquePtr& packed_b,
+                   size_t& packed_b_size,
+                   TensorShape& b_shape) {
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+  b_shape = tensor_b.Shape();
+
+  const size_t K = trans_b ? static_cast<size_t>(b_shape[1]) : static_cast<size_t>(b_shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(b_shape[0]) : static_cast<size_t>(b_shape[1]);
+
+  packed_b_size = MlasGemmPackBHalfSize(N, K);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  packed_b = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  const CBLAS_TRANSPOSE trans = trans_b ? CblasTrans : CblasNoTrans;
+  if (precision == GemmPackedBPrecision::Fp16) {
+    MlasGemmPackBHalf(trans, N, K, tensor_b.Data<float>(), trans_b ? K : N, static_cast<MLAS_FP16*>(packed_b_data));
+  } else {
+    MlasGemmPackBHalf(trans, N, K, tensor_b.Data<float>(), trans_b ? K : N, static_cast<MLAS_BF16*>(packed_b_data));
+  }
+  return true;
+}
+
+void GemmHalfPackedB(GemmPackedBPrecision precision,
+                     CBLAS_TRANSPOSE trans_a,
+                     size_t M, size_t N, size_t K,
+                     float alpha,
+                     const float* a_data, size_t lda,
+                     const void* packed_b,
+                     float beta,
+                     float* c_data, size_t ldc,
+                     concurrency::ThreadPool* thread_pool) {
+  if (precision == GemmPackedBPrecision::Fp16) {
+    MlasGemmHalfPackedB(trans_a, M, N, K, alpha, a_data, lda, static_cast<const MLAS_FP16*>(packed_b), beta,
+                        c_data, ldc, thread_pool);
+  } else {
+    MlasGemmHalfPackedB(trans_a, M, N, K, alpha, a_data, lda, static_cast<const MLAS_BF16*>(packed_b), beta,
+                        c_data, ldc, thread_pool);
+  }
+}
+
 template <typename T>
 static void GemmBroadcastBias(int64_t M, int64_t N, float beta,
                               const T* c_data, const TensorShape* c_shape,
@@ -164,19 +227,86 @@ template void Gemm<float>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE
                                        concurrency::ThreadPool* thread_pool);
 
 template <typename T>
-Status Gemm<T>::PrePack(const Tensor& /* tensor */, int /* input_idx */, bool& is_packed) {
+Status Gemm<T>::PrePack(const Tensor& /* tensor */, int /* input_idx */, AllocatorPtr /*alloc*/,
+                        bool& is_packed,
+                        /*out*/ PrePackedWeights* /*prepacked_weights*/) {
   is_packed = false;
   return Status::OK();
 }
 
 template <>
-Status Gemm<float>::PrePack(const Tensor& tensor, int input_idx, bool& is_packed) {
+Status Gemm<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
   is_packed = false;
 
   // only pack Matrix B
   if (input_idx == 1) {
-    is_packed = GemmPackBFp32(Info(), tensor, trans_B_ != CblasNoTrans, packed_b_, b_shape_);
+    size_t packed_b_size;
+    const bool trans_b = trans_B_ != CblasNoTrans;
+    is_packed = packed_b_precision_ == GemmPackedBPrecision::Fp32
+                    ? GemmPackBFp32(alloc, tensor, trans_b, packed_b_, packed_b_size, b_shape_)
+                    : GemmPackBHalf(alloc, tensor, trans_b, packed_b_precision_, packed_b_, packed_b_size, b_shape_);
+    if (is_packed && prepacked_weights != nullptr) {
+      prepacked_weights->buffers_.push_back(std::move(packed_b_));
+      prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+    }
+  }
+  return Status::OK();
+}
+
+template <typename T>
+Status Gemm<T>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                          int /*input_idx*/,
+                                          /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+  return Status::OK();
+}
+
+template <>
+Status Gemm<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
   }
+
+  return Status::OK();
+}
+
+template <typename T>
+Status Gemm<T>::UseCachedPrePackedBuffers(const Tensor& /*tensor*/, int /*input_idx*/,
+                                          PrePackedWeights& /*prepacked_weights*/,
+                                          /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+  return Status::OK();
+}
+
+template <>
+Status Gemm<float>::UseCachedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                              PrePackedWeights& prepacked_weights,
+                                              /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+
+  // the buffer is the matrix B packed by GemmPackBFp32, or GemmPackBHalf with the precision of the session
+  const auto& shape = tensor.Shape();
+  if (input_idx == 1 && shape.NumDimensions() == 2 && prepacked_weights.buffers_.size() == 1) {
+    const bool trans_b = trans_B_ != CblasNoTrans;
+    const size_t K = trans_b ? static_cast<size_t>(shape[1]) : static_cast<size_t>(shape[0]);
+    const size_t N = trans_b ? static_cast<size_t>(shape[0]) : static_cast<size_t>(shape[1]);
+    // the formats of a tiny matrix have the same aligned size, so it is packed again
+    const size_t fp32_size = MlasGemmPackBSize(N, K);
+    const size_t half_size = MlasGemmPackBHalfSize(N, K);
+    const size_t packed_b_size = packed_b_precision_ == GemmPackedBPrecision::Fp32 ? fp32_size : half_size;
+    if (fp32_size != half_size && prepacked_weights.buffer_sizes_[0] == packed_b_size) {
+      b_shape_ = shape;
+      packed_b_ = std::move(prepacked_weights.buffers_[0]);
+      used_cached_buffers = true;
+    }
+  }
+
   return Status::OK();
 }
 
@@ -268,19 +398,30 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
                 c_data, c_shape, y_data, thread_pool);
   } else {
     GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
-    MlasGemm(
-        trans_A_,
-        static_cast<size_t>(M),
-        static_cast<size_t>(N),
-        static_cast<size_t>(K),
-        alpha_,
-        A->Data<float>(),
-        static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K),
-        packed_b_.get(),
-        c_data != nullptr ? beta_ : 0.0f,
-        y_data,
-        static_cast<size_t>(N),
-        thread_pool);
+    if (packed_b_precision_ != GemmPackedBPrecision::Fp32) {
+      GemmHalfPackedB(packed_b_precision_, trans_A_,
+                      static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K),
+                      alpha_,
+                      A->Data<float>(), static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K),
+                      packed_b_.get(),
+                      c_data != nullptr ? beta_ : 0.0f,
+                      y_data, static_cast<size_t>(N),
+                      thread_pool);
+    } else {
+      MlasGemm(
+          trans_A_,
+          static_cast<size_t>(M),
+          static_cast<size_t>(N),
+          static_cast<size_t>(K),
+          alpha_,
+          A->Data<float>(),
+          static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K),
+          packed_b_.get(),
+          c_data != nullptr ? beta_ : 0.0f,
+          y_data,
+          static_cast<size_t>(N),
+          thread_pool);
+    }
   }
 
   ComputeActivation(y_data, M * N, thread_pool);
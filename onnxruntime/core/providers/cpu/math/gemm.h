@@ -7,6 +7,7 @@
 #include "core/common/common.h"
 #include "core/util/math.h"
 #include "core/providers/cpu/activation/activations.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 
 namespace onnxruntime {
 
@@ -23,11 +24,21 @@ class Gemm : public OpKernel {
 
     ORT_ENFORCE(info.GetAttr<float>("alpha", &alpha_).IsOK());
     ORT_ENFORCE(info.GetAttr<float>("beta", &beta_).IsOK());
+
+    packed_b_precision_ = GetGemmPackedBPrecision(info);
   }
 
   Status Compute(OpKernelContext* context) const override;
 
-  Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override;
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  Status UseCachedPrePackedBuffers(const Tensor& tensor, int input_idx, PrePackedWeights& prepacked_weights,
+                                   /*out*/ bool& used_cached_buffers) override;
 
   static void ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           int64_t M, int64_t N, int64_t K,
@@ -47,6 +58,8 @@ class Gemm : public OpKernel {
  protected:
   TensorShape b_shape_;
   BufferUniquePtr packed_b_;
+  // the precision packed_b_ is stored in
+  GemmPackedBPrecision packed_b_precision_;
 
   // For fused gemm + activation
   std::unique_ptr<functors::ElementWiseRangedTransform<T>> activation_;
@@ -4,13 +4,45 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
-bool GemmPackBFp32(const OpKernelInfo& info,
+// The precision of the pre-packed matrix B of the float Gemm and MatMul kernels.
+// See kOrtSessionOptionsConfigCpuGemmWeightPrecision.
+enum class GemmPackedBPrecision {
+  Fp32,
+  Fp16,
+  Bf16,
+};
+
+GemmPackedBPrecision GetGemmPackedBPrecision(const OpKernelInfo& info);
+
+bool GemmPackBFp32(AllocatorPtr& alloc,
+                   const Tensor& tensor_b,
+                   bool trans_b,
+                   BufferUniquePtr& packed_b,
+                   size_t& packed_b_size,
+                   TensorShape& b_shape);
+
+// Pack matrix B in half precision or bfloat16 with MlasGemmPackBHalf
+bool GemmPackBHalf(AllocatorPtr& alloc,
                    const Tensor& tensor_b,
                    bool trans_b,
+                   GemmPackedBPrecision precision,
                    BufferUniquePtr& packed_b,
+                   size_t& packed_b_size,
                    TensorShape& b_shape);
 
+// Compute C = alpha * op(A) * B + beta * C with a matrix B packed by GemmPackBHalf
+void GemmHalfPackedB(GemmPackedBPrecision precision,
+                     CBLAS_TRANSPOSE trans_a,
+                     size_t M, size_t N, size_t K,
+                     float alpha,
+                     const float* a_data, size_t lda,
+                     const void* packed_b,
+                     float beta,
+                     float* c_data, size_t ldc,
+                     concurrency::ThreadPool* thread_pool);
+
 };  // namespace onnxruntime
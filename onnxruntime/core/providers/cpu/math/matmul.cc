@@ -89,6 +89,36 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
         .TypeConstraint("T", BuildKernelDefConstraints<int64_t, uint64_t>()),
     MatMul<int64_t>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    1, 8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    HalfMatMul<MLFloat16>);
+
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    9,
+    12,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    HalfMatMul<MLFloat16>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    HalfMatMul<MLFloat16>);
+
+// bfloat16 was added to MatMul in opset 13
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    BFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<BFloat16>()),
+    HalfMatMul<BFloat16>);
+
 template <typename T>
 Status MatMul<T>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
@@ -126,13 +156,105 @@ Status MatMul<T>::Compute(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
-Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, bool& is_packed) {
+namespace {
+
+// Use the block sparse kernel when at least 70% of the 1x16 blocks of a
+// constant weight are zero, which is roughly where it overtakes the dense
+// packed kernel.
+constexpr size_t kSparsePackedBPercentThreshold = 30;
+
+bool SparsePackBFp32(AllocatorPtr& alloc,
+                     const Tensor& tensor_b,
+                     bool trans_b,
+                     BufferUniquePtr& packed_b,
+                     size_t& packed_b_size,
+                     TensorShape& b_shape) {
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+
+  const auto& shape = tensor_b.Shape();
+  const size_t K = trans_b ? static_cast<size_t>(shape[1]) : static_cast<size_t>(shape[0]);
+  const size_t N = trans_b ? static_cast<size_t>(shape[0]) : static_cast<size_t>(shape[1]);
+  const CBLAS_TRANSPOSE trans = trans_b ? CblasTrans : CblasNoTrans;
+  const float* b_data = tensor_b.Data<float>();
+
+  packed_b_size = MlasGemmPackSparseBSize(trans, N, K, b_data, trans_b ? K : N);
+  if (packed_b_size == 0 || packed_b_size * 100 > MlasGemmPackBSize(N, K) * kSparsePackedBPercentThreshold) {
+    return false;
+  }
+
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  packed_b = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  MlasGemmPackSparseB(trans, N, K, b_data, trans_b ? K : N, packed_b_data);
+  b_shape = shape;
+  return true;
+}
+
+}  // namespace
+
+Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                              /*out*/ PrePackedWeights* prepacked_weights) {
   is_packed = false;
 
-  // only pack Matrix B
+  // only pack Matrix B. the sparse kernel reads the rows of A, so it isn't used if A is transposed.
+  if (input_idx == 1) {
+    size_t packed_b_size;
+    sparse_b_ = !trans_a_attr_ && SparsePackBFp32(alloc, tensor, trans_b_attr_, packed_b_, packed_b_size, b_shape_);
+    if (sparse_b_) {
+      is_packed = true;
+    } else if (packed_b_precision_ == GemmPackedBPrecision::Fp32) {
+      is_packed = GemmPackBFp32(alloc, tensor, trans_b_attr_, packed_b_, packed_b_size, b_shape_);
+    } else {
+      is_packed = GemmPackBHalf(alloc, tensor, trans_b_attr_, packed_b_precision_, packed_b_, packed_b_size, b_shape_);
+    }
+    if (is_packed && prepacked_weights != nullptr) {
+      prepacked_weights->buffers_.push_back(std::move(packed_b_));
+      prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+    }
+  }
+  return Status::OK();
+}
+
+Status MatMul<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                int input_idx,
+                                                /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
   if (input_idx == 1) {
-    is_packed = GemmPackBFp32(Info(), tensor, trans_b_attr_, packed_b_, b_shape_);
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
   }
+
+  return Status::OK();
+}
+
+Status MatMul<float>::UseCachedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                                PrePackedWeights& prepacked_weights,
+                                                /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+
+  const auto& shape = tensor.Shape();
+  if (input_idx == 1 && shape.NumDimensions() == 2 && prepacked_weights.buffers_.size() == 1) {
+    const size_t K = trans_b_attr_ ? static_cast<size_t>(shape[1]) : static_cast<size_t>(shape[0]);
+    const size_t N = trans_b_attr_ ? static_cast<size_t>(shape[0]) : static_cast<size_t>(shape[1]);
+    // the block sparse format is only chosen when it is much smaller than the dense packed format, including the
+    // half precision one, so the size of the buffer tells which one PrePack used. the dense formats of a tiny
+    // matrix have the same aligned size, so they are packed again.
+    const size_t buffer_size = prepacked_weights.buffer_sizes_[0];
+    const bool fp32_b = buffer_size == MlasGemmPackBSize(N, K);
+    const bool half_b = buffer_size == MlasGemmPackBHalfSize(N, K);
+    const bool sparse_b = !fp32_b && !half_b;
+    const bool dense_b_matches =
+        fp32_b != half_b && (packed_b_precision_ == GemmPackedBPrecision::Fp32 ? fp32_b : half_b);
+    if (sparse_b ? !trans_a_attr_ : dense_b_matches) {
+      sparse_b_ = sparse_b;
+      b_shape_ = shape;
+      packed_b_ = std::move(prepacked_weights.buffers_[0]);
+      used_cached_buffers = true;
+    }
+  }
+
   return Status::OK();
 }
 
@@ -159,37 +281,170 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const auto* b_data = b ? b->Data<float>() : nullptr;
   auto* y_data = y->MutableData<float>();
 
-  // TODO: replace it with GemmBatch for performance, it's OK for now as GemmBatch unrolls as well
+  // Run all the broadcast matrix multiplies with a single dispatch to the
+  // thread pool.
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  if (sparse_b_) {
+    for (size_t i = 0; i < max_len; i++) {
+      MlasGemmSparse(M, alpha_attr_, a_data + helper.LeftOffsets()[i], K, packed_b_.get(),
+                     y_data + helper.OutputOffsets()[i], N, thread_pool);
+    }
+    return Status::OK();
+  }
+
+  if (packed_b_ && packed_b_precision_ != GemmPackedBPrecision::Fp32) {
+    for (size_t i = 0; i < max_len; i++) {
+      GemmHalfPackedB(packed_b_precision_, trans_a ? CblasTrans : CblasNoTrans, M, N, K, alpha_attr_,
+                      a_data + helper.LeftOffsets()[i], trans_a ? M : K, packed_b_.get(), 0.0f,
+                      y_data + helper.OutputOffsets()[i], N, thread_pool);
+    }
+    return Status::OK();
+  }
+
+  std::vector<MLAS_SGEMM_DATA_PARAMS> data(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    data[i].BIsPacked = bool(packed_b_);
+    data[i].A = a_data + helper.LeftOffsets()[i];
+    data[i].lda = trans_a ? M : K;
+    data[i].B = data[i].BIsPacked ? static_cast<const void*>(packed_b_.get()) : b_data + helper.RightOffsets()[i];
+    data[i].ldb = trans_b ? K : N;
+    data[i].C = y_data + helper.OutputOffsets()[i];
+    data[i].ldc = N;
+    data[i].alpha = alpha_attr_;
+    data[i].beta = 0.0f;
+  }
+  MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
+                M, N, K, data.data(), max_len, thread_pool);
+
+  return Status::OK();
+}
+
+namespace {
+
+// MLFloat16 and BFloat16 have the same layout as the MLAS types
+template <typename T>
+struct MlasHalfType;
+
+template <>
+struct MlasHalfType<MLFloat16> {
+  using type = MLAS_FP16;
+};
+
+template <>
+struct MlasHalfType<BFloat16> {
+  using type = MLAS_BF16;
+};
+
+}  // namespace
+
+template <typename T>
+Status HalfMatMul<T>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                              /*out*/ PrePackedWeights* prepacked_weights) {
+  using MlasT = typename MlasHalfType<T>::type;
+  is_packed = false;
+
+  // only pack a 2D matrix B
+  if (input_idx != 1 || tensor.Shape().NumDimensions() != 2) {
+    return Status::OK();
+  }
+
+  b_shape_ = tensor.Shape();
+  const auto K = static_cast<size_t>(b_shape_[0]);
+  const auto N = static_cast<size_t>(b_shape_[1]);
+
+  const size_t packed_b_size = MlasGemmPackBSize(N, K);
+  if (packed_b_size == 0) {
+    return Status::OK();
+  }
+
+  packed_b_ = BufferUniquePtr(alloc->Alloc(packed_b_size), BufferDeleter(alloc));
+  MlasGemmPackB(CblasNoTrans, N, K, reinterpret_cast<const MlasT*>(tensor.Data<T>()), N, packed_b_.get());
+  is_packed = true;
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(packed_b_));
+    prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+  }
+
+  return Status::OK();
+}
+
+template <typename T>
+Status HalfMatMul<T>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                int input_idx,
+                                                /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+template <typename T>
+Status HalfMatMul<T>::UseCachedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                                PrePackedWeights& prepacked_weights,
+                                                /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+
+  const auto& shape = tensor.Shape();
+  if (input_idx == 1 && shape.NumDimensions() == 2 && prepacked_weights.buffers_.size() == 1 &&
+      prepacked_weights.buffer_sizes_[0] == MlasGemmPackBSize(static_cast<size_t>(shape[1]),
+                                                              static_cast<size_t>(shape[0]))) {
+    b_shape_ = shape;
+    packed_b_ = std::move(prepacked_weights.buffers_[0]);
+    used_cached_buffers = true;
+  }
+
+  return Status::OK();
+}
+
+template <typename T>
+Status HalfMatMul<T>::Compute(OpKernelContext* ctx) const {
+  using MlasT = typename MlasHalfType<T>::type;
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const Tensor* a = ctx->Input<Tensor>(0);
+  const Tensor* b = packed_b_ ? nullptr : ctx->Input<Tensor>(1);
+  const auto& b_shape = b ? b->Shape() : b_shape_;
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  const auto* a_data = reinterpret_cast<const MlasT*>(a->Data<T>());
+  const auto* b_data = b ? reinterpret_cast<const MlasT*>(b->Data<T>()) : nullptr;
+  auto* y_data = reinterpret_cast<MlasT*>(y->MutableData<T>());
+
+  const auto M = static_cast<size_t>(helper.M());
+  const auto N = static_cast<size_t>(helper.N());
+  const auto K = static_cast<size_t>(helper.K());
+
   size_t max_len = helper.OutputOffsets().size();
   for (size_t i = 0; i < max_len; i++) {
     if (packed_b_) {
-      MlasGemm(
-          trans_a ? CblasTrans : CblasNoTrans,
-          static_cast<size_t>(helper.M()),
-          static_cast<size_t>(helper.N()),
-          static_cast<size_t>(helper.K()),
-          alpha_attr_,
-          a_data + helper.LeftOffsets()[i],
-          static_cast<size_t>(trans_a ? helper.M() : helper.K()),
-          packed_b_.get(),
-          0.0f,
-          y_data + helper.OutputOffsets()[i],
-          static_cast<size_t>(helper.N()),
-          thread_pool);
-      continue;
+      MlasGemm(CblasNoTrans, M, N, K, 1.0f,
+               a_data + helper.LeftOffsets()[i], K,
+               packed_b_.get(),
+               y_data + helper.OutputOffsets()[i], N,
+               thread_pool);
+    } else {
+      MlasGemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f,
+               a_data + helper.LeftOffsets()[i], K,
+               b_data + helper.RightOffsets()[i], N,
+               y_data + helper.OutputOffsets()[i], N,
+               thread_pool);
     }
-    math::Gemm<float, concurrency::ThreadPool>(
-        trans_a ? CblasTrans : CblasNoTrans,
-        trans_b ? CblasTrans : CblasNoTrans,
-        helper.M(),
-        helper.N(),
-        helper.K(),
-        alpha_attr_,
-        a_data + helper.LeftOffsets()[i],
-        b_data + helper.RightOffsets()[i],
-        0.0f,
-        y_data + helper.OutputOffsets()[i],
-        thread_pool);
   }
 
   return Status::OK();
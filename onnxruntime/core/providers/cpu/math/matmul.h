@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 
 namespace onnxruntime {
 
@@ -22,15 +23,28 @@ class MatMul<float> final : public OpKernel {
     info.GetAttrOrDefault<int64_t>("transA", &trans_a_attr_, 0);
     info.GetAttrOrDefault<int64_t>("transB", &trans_b_attr_, 0);
     info.GetAttrOrDefault<float>("alpha", &alpha_attr_, 1.0);
+    packed_b_precision_ = GetGemmPackedBPrecision(info);
   }
 
-  Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override;
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  Status UseCachedPrePackedBuffers(const Tensor& tensor, int input_idx, PrePackedWeights& prepacked_weights,
+                                   /*out*/ bool& used_cached_buffers) override;
 
   Status Compute(OpKernelContext* context) const override;
 
  private:
   TensorShape b_shape_;
   BufferUniquePtr packed_b_;
+  // packed_b_ holds a block sparse matrix B packed by MlasGemmPackSparseB
+  bool sparse_b_{false};
+  // the precision a dense packed_b_ is stored in
+  GemmPackedBPrecision packed_b_precision_;
 
   // For FusedMatMul and TransposeMatMul contrib ops
   float alpha_attr_;
@@ -38,4 +52,28 @@ class MatMul<float> final : public OpKernel {
   int64_t trans_b_attr_;
 };
 
+// MatMul for MLFloat16 and BFloat16. MLAS accumulates in single precision; a constant B is
+// converted and packed once by PrePack so each run only converts A and the output.
+template <typename T>
+class HalfMatMul final : public OpKernel {
+ public:
+  HalfMatMul(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  Status UseCachedPrePackedBuffers(const Tensor& tensor, int input_idx, PrePackedWeights& prepacked_weights,
+                                   /*out*/ bool& used_cached_buffers) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  TensorShape b_shape_;
+  BufferUniquePtr packed_b_;
+};
+
 }  // namespace onnxruntime
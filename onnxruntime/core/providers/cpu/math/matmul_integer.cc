@@ -28,6 +28,18 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
         .TypeConstraint("T3", DataTypeImpl::GetTensorType<int32_t>()),
     MatMulInteger);
 
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    MatMulInteger,
+    kOnnxDomain,
+    10,
+    int8_t,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<int8_t>())
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()})
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<int32_t>()),
+    MatMulInteger);
+
 Status MatMulInteger::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
@@ -44,60 +56,68 @@ Status MatMulInteger::Compute(OpKernelContext* ctx) const {
 
   // validate zero points
   uint8_t a_offset = 0;
-  uint8_t b_offset = 0;
   const auto* a_zero_point = ctx->Input<Tensor>(2);
   if (a_zero_point != nullptr) {
     ORT_ENFORCE(IsScalarOr1ElementVector(a_zero_point),
                 "MatmulInteger : input1 zero point must be a scalar or 1D tensor of size 1");
-    a_offset = *a_zero_point->template Data<uint8_t>();
+    a_offset = *static_cast<const uint8_t*>(a_zero_point->DataRaw());
   }
+
+  // the zero point of B is either a scalar or per column, e.g. from the per channel quantization of a weight
+  const uint8_t* b_offsets = nullptr;
+  uint8_t b_offset = 0;
   const auto* b_zero_point = ctx->Input<Tensor>(3);
   if (b_zero_point != nullptr) {
-    ORT_ENFORCE(IsScalarOr1ElementVector(b_zero_point),
-                "MatmulInteger : input2 zero point must be a scalar or 1D tensor of size 1");
-    b_offset = *static_cast<const uint8_t*>(b_zero_point->DataRaw());
+    const auto& b_zero_point_shape = b_zero_point->Shape();
+    const bool is_per_column = b_zero_point_shape.NumDimensions() == 1 && b_zero_point_shape[0] == helper.N() &&
+                               helper.N() != 1;
+    ORT_ENFORCE(IsScalarOr1ElementVector(b_zero_point) || is_per_column,
+                "MatmulInteger : input2 zero point must be a scalar, or a 1D tensor of size 1 or of the number of "
+                "columns of input2");
+    b_offsets = static_cast<const uint8_t*>(b_zero_point->DataRaw());
+    b_offset = b_offsets[0];
+    if (!is_per_column) {
+      b_offsets = nullptr;
+    }
   }
 
-  const auto* a_data = a->template Data<uint8_t>();
+  const auto* a_data = static_cast<const uint8_t*>(a->DataRaw());
   auto* y_data = y->template MutableData<int32_t>();
 
+  MLAS_GEMM_U8X8_PARAMETERS gemm_params;
+  gemm_params.M = static_cast<size_t>(helper.M());
+  gemm_params.N = static_cast<size_t>(helper.N());
+  gemm_params.K = static_cast<size_t>(helper.K());
+  gemm_params.lda = gemm_params.K;
+  gemm_params.ZeroPointA = a_offset;
+  gemm_params.AIsSigned = a->IsDataType<int8_t>();
+  gemm_params.ldb = gemm_params.N;
+  gemm_params.ZeroPointB = b_offset;
+  gemm_params.PerColumnZeroPointB = b_offsets;
+  gemm_params.ldc = gemm_params.N;
+
 #ifdef MLAS_SUPPORTS_PACKED_GEMM_U8X8
   if (packed_b_) {
+    gemm_params.B = packed_b_.get();
+    gemm_params.BIsPacked = true;
+    gemm_params.BIsSigned = b_is_signed_;
     for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
-      MlasGemm(static_cast<size_t>(helper.M()),
-               static_cast<size_t>(helper.N()),
-               static_cast<size_t>(helper.K()),
-               a_data + helper.LeftOffsets()[i],
-               static_cast<size_t>(helper.K()),
-               a_offset,
-               packed_b_.get(),
-               b_offset,
-               b_is_signed_,
-               y_data + helper.OutputOffsets()[i],
-               static_cast<size_t>(helper.N()),
-               thread_pool);
+      gemm_params.A = a_data + helper.LeftOffsets()[i];
+      gemm_params.C = y_data + helper.OutputOffsets()[i];
+      MlasGemm(gemm_params, thread_pool);
     }
     return Status::OK();
   }
 #endif
 
   if (b != nullptr) {
+    const auto* b_data = static_cast<const uint8_t*>(b->DataRaw());
+    gemm_params.BIsSigned = b->IsDataType<int8_t>();
     for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
-      const auto* b_data = static_cast<const uint8_t*>(b->DataRaw());
-      const bool b_is_signed = b->IsDataType<int8_t>();
-      MlasGemm(static_cast<size_t>(helper.M()),
-               static_cast<size_t>(helper.N()),
-               static_cast<size_t>(helper.K()),
-               a_data + helper.LeftOffsets()[i],
-               static_cast<size_t>(helper.K()),
-               a_offset,
-               b_data + helper.RightOffsets()[i],
-               static_cast<size_t>(helper.N()),
-               b_offset,
-               b_is_signed,
-               y_data + helper.OutputOffsets()[i],
-               static_cast<size_t>(helper.N()),
-               thread_pool);
+      gemm_params.A = a_data + helper.LeftOffsets()[i];
+      gemm_params.B = b_data + helper.RightOffsets()[i];
+      gemm_params.C = y_data + helper.OutputOffsets()[i];
+      MlasGemm(gemm_params, thread_pool);
     }
   } else {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input B should not be null.");
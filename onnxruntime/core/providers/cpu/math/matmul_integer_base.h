@@ -12,7 +12,8 @@ class MatMulIntegerBase : public OpKernel {
   MatMulIntegerBase(const OpKernelInfo& info) : OpKernel(info) {}
 
 #ifdef MLAS_SUPPORTS_PACKED_GEMM_U8X8
-  Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override {
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override {
     is_packed = false;
 
     // only pack Matrix B
@@ -35,14 +36,31 @@ class MatMulIntegerBase : public OpKernel {
         return Status::OK();
       }
 
-      auto alloc = Info().GetAllocator(0, OrtMemTypeDefault);
       auto* packed_b_data = alloc->Alloc(packed_b_size);
       packed_b_ = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
       MlasGemmPackB(N, K, b_data, N, b_is_signed_, packed_b_data);
       is_packed = true;
+
+      if (prepacked_weights != nullptr) {
+        prepacked_weights->buffers_.push_back(std::move(packed_b_));
+        prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+      }
     }
     return Status::OK();
   }
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override {
+    used_shared_buffers = false;
+
+    if (input_idx == 1) {
+      used_shared_buffers = true;
+      packed_b_ = std::move(prepacked_buffers[0]);
+    }
+
+    return Status::OK();
+  }
 #endif
 
  protected:
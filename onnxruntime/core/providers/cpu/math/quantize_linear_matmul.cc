@@ -41,14 +41,18 @@ Status QLinearMatMul::Compute(OpKernelContext* ctx) const {
   if (y->Shape().Size() == 0)
     return Status::OK();
 
-  // validate offsets
+  // validate offsets, the weight may be quantized per column
   const auto* a_offset = ctx->Input<Tensor>(2);
   const auto* b_offset = ctx->Input<Tensor>(5);
   const auto* y_offset = ctx->Input<Tensor>(7);
+  const auto is_per_column = [&helper](const Tensor* t) {
+    return t->Shape().NumDimensions() == 1 && t->Shape()[0] == helper.N() && helper.N() != 1;
+  };
   ORT_ENFORCE(IsScalarOr1ElementVector(a_offset),
               "QLinearMatmul : input zero point must be a scalar or 1D tensor of size 1");
-  ORT_ENFORCE(IsScalarOr1ElementVector(b_offset),
-              "QLinearMatmul : weight zero point must be a scalar or 1D tensor of size 1");
+  ORT_ENFORCE(IsScalarOr1ElementVector(b_offset) || is_per_column(b_offset),
+              "QLinearMatmul : weight zero point must be a scalar, or a 1D tensor of size 1 or of the number of "
+              "columns of the weight");
   ORT_ENFORCE(IsScalarOr1ElementVector(y_offset),
               "QLinearMatmul : result zero point must be a scalar or 1D tensor of size 1");
 
@@ -58,16 +62,21 @@ Status QLinearMatMul::Compute(OpKernelContext* ctx) const {
   const auto* y_scale = ctx->Input<Tensor>(6);
   ORT_ENFORCE(IsScalarOr1ElementVector(a_scale),
               "QLinearMatmul : input scale must be a scalar or 1D tensor of size 1");
-  ORT_ENFORCE(IsScalarOr1ElementVector(b_scale),
-              "QLinearMatmul : weight scale must be a scalar or 1D tensor of size 1");
+  ORT_ENFORCE(IsScalarOr1ElementVector(b_scale) || is_per_column(b_scale),
+              "QLinearMatmul : weight scale must be a scalar, or a 1D tensor of size 1 or of the number of "
+              "columns of the weight");
   ORT_ENFORCE(IsScalarOr1ElementVector(y_scale),
               "QLinearMatmul : result scale must be a scalar or 1D tensor of size 1");
 
   auto a_scale_data = *(a_scale->template Data<float>());
-  auto b_scale_data = *(b_scale->template Data<float>());
+  const auto* b_scale_data = b_scale->template Data<float>();
   auto y_scale_data = *(y_scale->template Data<float>());
 
-  const float real_multiplier = (a_scale_data * b_scale_data) / y_scale_data;
+  const bool is_per_column_scale = is_per_column(b_scale);
+  std::vector<float> real_multipliers(is_per_column_scale ? static_cast<size_t>(helper.N()) : 1);
+  for (size_t n = 0; n < real_multipliers.size(); n++) {
+    real_multipliers[n] = (a_scale_data * b_scale_data[n]) / y_scale_data;
+  }
 
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
@@ -76,29 +85,36 @@ Status QLinearMatMul::Compute(OpKernelContext* ctx) const {
   BufferUniquePtr gemm_output_buffer(gemm_output_data, BufferDeleter(alloc));
   auto* gemm_output = static_cast<int32_t*>(gemm_output_buffer.get());
 
+  const auto* b_offset_data = static_cast<const uint8_t*>(b_offset->DataRaw());
+
+  MLAS_GEMM_U8X8_PARAMETERS gemm_params;
+  gemm_params.M = static_cast<size_t>(helper.M());
+  gemm_params.N = static_cast<size_t>(helper.N());
+  gemm_params.K = static_cast<size_t>(helper.K());
+  gemm_params.lda = gemm_params.K;
+  gemm_params.ZeroPointA = *a_offset->template Data<uint8_t>();
+  gemm_params.ldb = gemm_params.N;
+  gemm_params.ZeroPointB = b_offset_data[0];
+  gemm_params.PerColumnZeroPointB = is_per_column(b_offset) ? b_offset_data : nullptr;
+  gemm_params.BIsSigned = b->IsDataType<int8_t>();
+  gemm_params.C = gemm_output;
+  gemm_params.ldc = gemm_params.N;
+
   for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
-    MlasGemm(static_cast<size_t>(helper.M()),
-             static_cast<size_t>(helper.N()),
-             static_cast<size_t>(helper.K()),
-             a->template Data<uint8_t>() + helper.LeftOffsets()[i],
-             static_cast<size_t>(helper.K()),
-             *a_offset->template Data<uint8_t>(),
-             static_cast<const uint8_t*>(b->DataRaw()) + helper.RightOffsets()[i],
-             static_cast<size_t>(helper.N()),
-             *static_cast<const uint8_t*>(b_offset->DataRaw()),
-             b->IsDataType<int8_t>(),
-             gemm_output,
-             static_cast<size_t>(helper.N()),
-             ctx->GetOperatorThreadPool());
-
-    MlasRequantizeOutput(gemm_output,
-                         y->template MutableData<uint8_t>() + helper.OutputOffsets()[i],
-                         nullptr,
-                         static_cast<size_t>(helper.M()),
-                         static_cast<size_t>(helper.N()),
-                         &real_multiplier,
-                         false,
-                         *y_offset->template Data<uint8_t>());
+    // Requantize each block of the output as soon as it is produced instead of
+    // making a separate pass over the whole int32 buffer.
+    MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR requant_processor(
+        y->template MutableData<uint8_t>() + helper.OutputOffsets()[i],
+        static_cast<size_t>(helper.N()),
+        nullptr,
+        real_multipliers.data(),
+        is_per_column_scale,
+        *y_offset->template Data<uint8_t>());
+
+    gemm_params.A = a->template Data<uint8_t>() + helper.LeftOffsets()[i];
+    gemm_params.B = static_cast<const uint8_t*>(b->DataRaw()) + helper.RightOffsets()[i];
+    gemm_params.OutputProcessor = &requant_processor;
+    MlasGemm(gemm_params, ctx->GetOperatorThreadPool());
   }
 
   return Status::OK();
@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/math/softmax.h"
 #include "core/providers/cpu/tensor/transpose.h"
+#include "core/mlas/inc/mlas.h"
 #include <vector>
 #include <numeric>
 
@@ -119,6 +120,23 @@ Status Softmax<T>::ComputeImpl(const Tensor& input, Tensor& output, size_t axis,
   return SoftmaxCPU<T>(N, D, input.template Data<T>(), output.template MutableData<T>(), log_softmax_, thread_pool);
 }
 
+namespace {
+// Computes the softmax over the middle dimension of an input of shape [N, D, M] in place of the transposes around
+// SoftmaxCPU. Returns false if there is no strided implementation for T.
+template <typename T>
+bool SoftmaxStridedCPU(size_t /*N*/, size_t /*D*/, size_t /*M*/, const T* /*Xdata*/, T* /*Ydata*/,
+                       bool /*logarithmic*/, concurrency::ThreadPool* /*thread_pool*/) {
+  return false;
+}
+
+template <>
+bool SoftmaxStridedCPU<float>(size_t N, size_t D, size_t M, const float* Xdata, float* Ydata,
+                              bool logarithmic, concurrency::ThreadPool* thread_pool) {
+  MlasComputeSoftmaxStrided(Xdata, Ydata, N, D, M, logarithmic, thread_pool);
+  return true;
+}
+}  // namespace
+
 // opset-13 and above
 template <typename T>
 Status Softmax<T>::ComputeImplOpset13(const Tensor& input, Tensor& output, size_t axis,
@@ -126,6 +144,13 @@ Status Softmax<T>::ComputeImplOpset13(const Tensor& input, Tensor& output, size_
   const auto& X_shape = input.Shape();
   size_t rank = X_shape.NumDimensions();
 
+  // the strided kernel computes the softmax over a dim other than the innermost one directly
+  if (axis != (rank - 1) &&
+      SoftmaxStridedCPU<T>(X_shape.SizeToDimension(axis), X_shape[axis], X_shape.SizeFromDimension(axis + 1),
+                           input.template Data<T>(), output.template MutableData<T>(), log_softmax_, thread_pool)) {
+    return Status::OK();
+  }
+
   bool is_transpose_required = false;
   Tensor transposed_input;
   std::vector<int64_t> transposed_input_dims;
@@ -137,7 +162,7 @@ Status Softmax<T>::ComputeImplOpset13(const Tensor& input, Tensor& output, size_
   // with https://github.com/onnx/onnx/blob/master/docs/Changelog.md#Softmax-11 for detailed explanations
   // To account for the opset-13 behavior, our plan will be to transpose the "axis" dim to the innermost dim
   // and perform softmax and then reverse the transpose. We can skip the transposing aspect if the axis is already
-  // the innermost dim
+  // the innermost dim, or if there is a strided implementation for T (see above)
   if (axis != (rank - 1)) {
     is_transpose_required = true;
   }
@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <algorithm>
+#include <numeric>
 #include <string>
 #include <vector>
 #include "core/common/common.h"
@@ -16,24 +18,41 @@ class DictVectorizerOp final : public OpKernel {
     //In some stupid models, the vocabulary could have duplicated elements.
     //We must support that, otherwise some tests will be break.
     ORT_ENFORCE(info.GetAttrs(std::is_same<AttrType, std::string>::value ? "string_vocabulary" : "int64_vocabulary", vocabulary_).IsOK());
+
+    sorted_vocabulary_indices_.resize(vocabulary_.size());
+    std::iota(sorted_vocabulary_indices_.begin(), sorted_vocabulary_indices_.end(), size_t{0});
+    std::sort(sorted_vocabulary_indices_.begin(), sorted_vocabulary_indices_.end(),
+              [this](size_t a, size_t b) { return vocabulary_[a] < vocabulary_[b]; });
   }
   common::Status Compute(OpKernelContext* ctx) const override {
     const auto* map = ctx->Input<std::map<AttrType, TargetType> >(0);
     auto* Y = ctx->Output(0, {1, static_cast<int64_t>(vocabulary_.size())});
     auto* y_data = Y->template MutableData<TargetType>();
-    for (size_t i = 0, end = vocabulary_.size(); i < end; ++i) {
-      auto index = map->find(vocabulary_[i]);
-      if (index != map->end()) {
-        *y_data++ = index->second;
-      } else {
-        //Any keys not present in the input dictionary, will be zero in the output array
-        *y_data++ = TargetType();
+
+    //Any keys not present in the input dictionary, will be zero in the output array
+    std::fill_n(y_data, vocabulary_.size(), TargetType());
+
+    //Both the map and the sorted vocabulary are ordered, so a single merge pass finds all the keys
+    auto entry = map->begin();
+    const auto map_end = map->end();
+    for (auto index : sorted_vocabulary_indices_) {
+      const AttrType& key = vocabulary_[index];
+      while (entry != map_end && entry->first < key) {
+        ++entry;
+      }
+      if (entry == map_end) {
+        break;
+      }
+      if (!(key < entry->first)) {
+        y_data[index] = entry->second;
       }
     }
     return Status::OK();
   }
 
   std::vector<AttrType> vocabulary_;
+  // indices of vocabulary_ in the order of the keys
+  std::vector<size_t> sorted_vocabulary_indices_;
 };
 
 }  // namespace ml
@@ -3,7 +3,7 @@
 
 #include "core/providers/cpu/ml/feature_vectorizer.h"
 
-#include <gsl/gsl>
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 namespace ml {
@@ -18,14 +18,50 @@ ONNX_CPU_OPERATOR_ML_KERNEL(
                                                 DataTypeImpl::GetTensorType<double>()}),
     FeatureVectorizer);
 
-template <typename T>
-static void VectorizeTensor(const Tensor& input_tensor, int64_t feature_size, int64_t sum_input_dimensions,
-                            typename gsl::span<float>::iterator out_iter);
+namespace {
+
+// The part of an input that is written to each row of the output.
+struct VectorizedInput {
+  const Tensor* tensor;
+  int64_t num_rows;
+  // the number of values of a row of the input
+  int64_t input_size;
+  // the number of values copied from a row of the input, after which the feature is padded with 0
+  int64_t copy_size;
+  int64_t feature_size;
+  int64_t feature_offset;
+};
 
 template <typename T>
-static void CopyWithCast(typename gsl::span<const T>::const_iterator begin,
-                         typename gsl::span<const T>::const_iterator end,
-                         gsl::span<float>::iterator out_iter);
+void CopyRowWithCast(const T* in, float* out, int64_t count) {
+  for (int64_t i = 0; i < count; ++i) {
+    out[i] = static_cast<float>(in[i]);
+  }
+}
+
+void VectorizeRow(const VectorizedInput& input, int64_t row, float* out_row) {
+  float* out = out_row + input.feature_offset;
+  int64_t copied = 0;
+  if (row < input.num_rows) {
+    const Tensor& tensor = *input.tensor;
+    const int64_t offset = row * input.input_size;
+    copied = input.copy_size;
+    if (tensor.IsDataType<float>()) {
+      CopyRowWithCast(tensor.Data<float>() + offset, out, copied);
+    } else if (tensor.IsDataType<int32_t>()) {
+      CopyRowWithCast(tensor.Data<int32_t>() + offset, out, copied);
+    } else if (tensor.IsDataType<int64_t>()) {
+      CopyRowWithCast(tensor.Data<int64_t>() + offset, out, copied);
+    } else {
+      CopyRowWithCast(tensor.Data<double>() + offset, out, copied);
+    }
+  }
+
+  // pad the feature if the input has fewer values or rows than the output
+  std::fill_n(out + copied, input.feature_size - copied, 0.f);
+}
+
+}  // namespace
 
 Status FeatureVectorizer::Compute(OpKernelContext* context) const {
   int input_count = context->NumVariadicInputs(0);
@@ -40,89 +76,57 @@ Status FeatureVectorizer::Compute(OpKernelContext* context) const {
   // assumes all inputs have the same batch size
   int64_t N = X.Shape().NumDimensions() == 1 ? 1 : x_dims[0];
 
-  // initialize all the output to 0.f
-  Tensor* Y = context->Output(0, {N, total_dimensions_});
-  auto Y_data = Y->template MutableData<float>();
-
-  auto out = gsl::make_span(Y_data, Y->Shape().Size());
-
-  // init all to 0.f so we don't need to do that each loop if we have to add padding
-  std::fill_n(out.data(), out.size(), 0.f);
-
+  std::vector<VectorizedInput> inputs;
+  inputs.reserve(input_count);
   int64_t feature_offset = 0;
-
-  // for each feature, write out its data in one pass
   for (int index = 0; index < input_count; ++index) {
     const auto* input_tensor_ptr = context->Input<Tensor>(index);
     ORT_ENFORCE(input_tensor_ptr != nullptr);
-    auto& input_tensor = *input_tensor_ptr;
-
-    auto feature_size = input_dimensions_[index];
-
-    auto cur_out = out.begin() + feature_offset;
-
-    if (input_tensor.IsDataType<float>()) {
-      // straight copy for float to float
-      VectorizeTensor<float>(input_tensor, feature_size, total_dimensions_, cur_out);
-    } else if (input_tensor.IsDataType<int32_t>()) {
-      VectorizeTensor<int32_t>(input_tensor, feature_size, total_dimensions_, cur_out);
-    } else if (input_tensor.IsDataType<int64_t>()) {
-      VectorizeTensor<int64_t>(input_tensor, feature_size, total_dimensions_, cur_out);
-    } else if (input_tensor.IsDataType<double>()) {
-      VectorizeTensor<double>(input_tensor, feature_size, total_dimensions_, cur_out);
-    } else {
+    const auto& input_dims = input_tensor_ptr->Shape().GetDims();
+    if (!input_tensor_ptr->IsDataType<float>() && !input_tensor_ptr->IsDataType<int32_t>() &&
+        !input_tensor_ptr->IsDataType<int64_t>() && !input_tensor_ptr->IsDataType<double>()) {
       // should never happen. graph validation should have failed
-      ORT_THROW("Invalid input type:", input_tensor.DataType());
+      ORT_THROW("Invalid input type:", input_tensor_ptr->DataType());
     }
 
-    // move to start of next feature
-    feature_offset += feature_size;
-  }
-
-  return Status::OK();
-}  // namespace ml
+    VectorizedInput input;
+    input.tensor = input_tensor_ptr;
+    input.num_rows = input_dims.size() == 1 ? 1 : input_dims[0];
+    input.input_size = input_dims.size() == 1 ? input_dims[0] : input_tensor_ptr->Shape().SizeFromDimension(1);
+    input.feature_size = input_dimensions_[index];
+    // if there's extra data, ignore it
+    input.copy_size = std::min(input.input_size, input.feature_size);
+    input.feature_offset = feature_offset;
+    if (input.num_rows > N) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input ", index, " has ", input.num_rows,
+                             " rows, which is more than the ", N, " rows of the first input.");
+    }
+    inputs.push_back(input);
 
-template <typename T>
-static void VectorizeTensor(const Tensor& input_tensor, int64_t feature_size, int64_t sum_input_dimensions,
-                            typename gsl::span<float>::iterator out_iter) {
-  auto& shape = input_tensor.Shape();
-  auto& input_dims = shape.GetDims();
-
-  auto input_size = input_dims.size() == 1 ? input_dims[0] : input_tensor.Shape().SizeFromDimension(1);
-  auto N = input_dims.size() == 1 ? 1 : input_dims[0];
-
-  // if there's extra data, ignore it
-  auto stride = input_size;
-  if (input_size > feature_size) {
-    stride = feature_size;
+    // move to start of next feature
+    feature_offset += input.feature_size;
   }
 
-  auto data = input_tensor.template Data<T>();
-  auto input = gsl::make_span(data, shape.Size());
-  auto input_iter = input.cbegin();
-
-  for (int i = 0; i < N;) {
-    // copy each row to the output. iters are passed by value
-    CopyWithCast<T>(input_iter, input_iter + stride, out_iter);
-
-    // skip to start of next input row, and start of next output
-    // if we have more input. otherwise we go past then end of the input and the bounds checking errors out
-    if (++i < N) {
-      input_iter += input_size;
-      out_iter += sum_input_dimensions;
-    }
-  }
-}
+  Tensor* Y = context->Output(0, {N, total_dimensions_});
+  float* Y_data = Y->template MutableData<float>();
+
+  // each row of the output is written once, feature by feature, including the padding
+  const int64_t total_dimensions = total_dimensions_;
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), N,
+      TensorOpCost{static_cast<double>(total_dimensions * sizeof(double)),
+                   static_cast<double>(total_dimensions * sizeof(float)),
+                   static_cast<double>(total_dimensions + 4 * input_count)},
+      [&inputs, Y_data, total_dimensions](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          float* out_row = Y_data + row * total_dimensions;
+          for (const auto& input : inputs) {
+            VectorizeRow(input, row, out_row);
+          }
+        }
+      });
 
-template <typename T>
-static void CopyWithCast(typename gsl::span<const T>::const_iterator begin,
-                         typename gsl::span<const T>::const_iterator end,
-                         gsl::span<float>::iterator out_iter) {
-  std::for_each(begin, end,
-                [&out_iter](const typename gsl::span<T>::const_reference value) {
-                  *out_iter = static_cast<float>(value);
-                  ++out_iter;
-                });
+  return Status::OK();
 }
 
 }  // namespace ml
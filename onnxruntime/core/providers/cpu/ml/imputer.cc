@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/ml/imputer.h"
 #include <cmath>
+#include "core/platform/threadpool.h"
 /**
 https://github.com/onnx/onnx/blob/master/onnx/defs/traditionalml/defs.cc
 ONNX_OPERATOR_SCHEMA(Imputer)
@@ -50,7 +51,8 @@ ONNX_CPU_OPERATOR_ML_KERNEL(
     Imputer,
     1,
     KernelDefBuilder().TypeConstraint("T", {DataTypeImpl::GetTensorType<float>(),
-                                            DataTypeImpl::GetTensorType<int64_t>()}),
+                                            DataTypeImpl::GetTensorType<int64_t>()})
+        .MayInplace(0, 0),
     ImputerOp);
 
 ImputerOp::ImputerOp(const OpKernelInfo& info) : OpKernel(info),
@@ -87,28 +89,30 @@ common::Status ComputeByType(OpKernelContext* context,
 
   Tensor* Y = context->Output(0, x_shape);
   T* y_data = Y->template MutableData<T>();
-  if (imputed_values.size() == static_cast<size_t>(stride)) {
-    for (size_t i = 0; i < x_size; i++) {
-      if (std::isnan(static_cast<float>(x_data[i])) && std::isnan(static_cast<float>(replaced_value))) {
-        y_data[i] = imputed_values[i % stride];
-      } else if (x_data[i] == replaced_value) {
-        y_data[i] = imputed_values[i % stride];
-      } else {
-        y_data[i] = x_data[i];
-      }
-    }
-  } else {
-    for (size_t i = 0; i < x_size; i++) {
-      if (std::isnan(static_cast<float>(x_data[i])) && std::isnan(static_cast<float>(replaced_value))) {
-        y_data[i] = imputed_values[0];
-      } else if (x_data[i] == replaced_value) {
-        y_data[i] = imputed_values[0];
-      } else {
-        y_data[i] = x_data[i];
-      }
-    }
+  if (stride == 0) {
+    return Status::OK();
   }
 
+  // the rows of stride features are imputed independently, reading each value before writing it for in-place use.
+  const int64_t num_rows = static_cast<int64_t>(x_size) / stride;
+  const bool per_feature = imputed_values.size() == static_cast<size_t>(stride);
+  const bool replaced_is_nan = std::isnan(static_cast<float>(replaced_value));
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), num_rows,
+      TensorOpCost{static_cast<double>(stride * sizeof(T)), static_cast<double>(stride * sizeof(T)),
+                   static_cast<double>(stride * 2)},
+      [&imputed_values, x_data, y_data, stride, per_feature, replaced_is_nan, replaced_value](std::ptrdiff_t first,
+                                                                                              std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const T* x = x_data + row * stride;
+          T* y = y_data + row * stride;
+          for (int64_t i = 0; i < stride; ++i) {
+            const bool replace = replaced_is_nan ? std::isnan(static_cast<float>(x[i])) : x[i] == replaced_value;
+            y[i] = replace ? imputed_values[per_feature ? i : 0] : x[i];
+          }
+        }
+      });
+
   return Status::OK();
 }
 
@@ -75,16 +75,8 @@ class LabelEncoder_2 final : public OpKernel {
     const TensorShape& shape = X.Shape();
     Tensor& Y = *context->Output(0, shape);
 
-    auto input = X.template DataAsSpan<TKey>();
-    auto output = Y.template MutableDataAsSpan<TValue>();
-
-    for (int64_t i = 0; i < shape.Size(); ++i) {
-      const auto found = _map.find(input[i]);
-      if (found == _map.end())
-        output[i] = _default_value;
-      else
-        output[i] = found->second;
-    }
+    MapValues<TKey, TValue>(context->GetOperatorThreadPool(), X.template DataAsSpan<TKey>(),
+                            Y.template MutableDataAsSpan<TValue>(), _map, _default_value);
 
     return Status::OK();
   }
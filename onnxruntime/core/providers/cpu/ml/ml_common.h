@@ -168,6 +168,54 @@ static inline NORMALIZE MakeNormalize(const std::string& input) {
   ORT_THROW("Invalid normalize value of ", input);
 }
 
+// Normalizes a row of row_size values of in by its MAX, L1 or L2 norm into out, which may be the same buffer as in.
+// A row whose norm is 0 is copied unchanged.
+template <typename T>
+void NormalizeRow(NORMALIZE normalization, const T* in, float* out, int64_t row_size) {
+  switch (normalization) {
+    case NORMALIZE::NMAX: {
+      float max = std::numeric_limits<float>::lowest();
+      for (int64_t i = 0; i < row_size; ++i) {
+        max = std::max(max, static_cast<float>(in[i]));
+      }
+      const float divisor = max != 0.f ? max : 1.f;
+      for (int64_t i = 0; i < row_size; ++i) {
+        out[i] = static_cast<float>(in[i]) / divisor;
+      }
+      break;
+    }
+    case NORMALIZE::L1: {
+      float sum = 0.f;
+      for (int64_t i = 0; i < row_size; ++i) {
+        sum += static_cast<float>(std::abs(in[i]));
+      }
+      const float divisor = sum != 0.f ? sum : 1.f;
+      for (int64_t i = 0; i < row_size; ++i) {
+        out[i] = static_cast<float>(in[i]) / divisor;
+      }
+      break;
+    }
+    case NORMALIZE::L2: {
+      float sum = 0.f;
+      for (int64_t i = 0; i < row_size; ++i) {
+        sum += static_cast<float>(in[i] * in[i]);
+      }
+      if (sum != 0.f) {
+        for (int64_t i = 0; i < row_size; ++i) {
+          const auto x = in[i];
+          const float value = std::sqrt(static_cast<float>(x * x) / sum);
+          out[i] = x < 0 ? -value : value;
+        }
+      } else {
+        for (int64_t i = 0; i < row_size; ++i) {
+          out[i] = static_cast<float>(in[i]);
+        }
+      }
+      break;
+    }
+  }
+}
+
 enum class SVM_TYPE {
   SVM_LINEAR,
   SVM_SVC
@@ -529,5 +577,27 @@ void batched_update_scores_inplace(gsl::span<T> scores, int64_t num_batches_in,
     }
   }
 }
+
+// Looks up each value of input in map and writes the mapped value, or default_value if the value isn't a key, to the
+// matching position of output. The lookups are independent so large inputs are split across the thread pool.
+template <typename TKey, typename TValue, typename TMap>
+void MapValues(concurrency::ThreadPool* threadpool, gsl::span<const TKey> input, gsl::span<TValue> output,
+               const TMap& map, const TValue& default_value) {
+  assert(input.size() == output.size());
+
+  // a hash lookup plus the copy of the mapped value. a rough estimate is enough to keep small inputs on one thread.
+  static constexpr double cost_per_value = 64.0;
+
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, static_cast<std::ptrdiff_t>(input.size()), cost_per_value,
+      [&input, &output, &map, &default_value](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // map isn't going to change so get end() once instead of calling inside the loop
+        const auto map_end = map.end();
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          auto map_to = map.find(input[i]);
+          output[i] = map_to == map_end ? default_value : map_to->second;
+        }
+      });
+}
 }  // namespace ml
 }  // namespace onnxruntime
@@ -42,82 +42,6 @@ ONNX_CPU_OPERATOR_ML_KERNEL(
                                                      DataTypeImpl::GetTensorType<int64_t>()}),
     Normalizer);
 
-template <typename T>
-void NormalizeMax(const T* in, float* out, int64_t num_batches, int64_t batch_size) {
-  for (int b = 0; b < num_batches; ++b) {
-    float max = std::numeric_limits<float>::lowest();
-
-    for (int i = 0; i < batch_size; ++i) {
-      max = std::max(max, static_cast<float>(*in++));
-    }
-
-    in -= batch_size;
-
-    if (max != 0.f) {
-      for (int i = 0; i < batch_size; ++i) {
-        *out++ = static_cast<float>(*in++) / max;
-      }
-    } else {
-      for (int i = 0; i < batch_size; ++i) {
-        *out++ = static_cast<float>(*in++);
-      }
-    }
-  }
-}
-
-template <typename T>
-static void NormalizeL1(const T* in, float* out, int64_t num_batches, int64_t batch_size) {
-  for (int b = 0; b < num_batches; ++b) {
-    float sum = 0.f;
-
-    for (int i = 0; i < batch_size; ++i) {
-      sum += static_cast<float>(std::abs(*in++));
-    }
-
-    in -= batch_size;
-
-    if (sum != 0.f) {
-      for (int i = 0; i < batch_size; ++i) {
-        *out++ = static_cast<float>(*in++) / sum;
-      }
-    } else {
-      for (int i = 0; i < batch_size; ++i) {
-        *out++ = static_cast<float>(*in++);
-      }
-    }
-  }
-}
-
-template <typename T>
-void NormalizeL2(const T* in, float* out, int64_t num_batches, int64_t batch_size) {
-  for (int b = 0; b < num_batches; ++b) {
-    float sum = 0.f;
-
-    for (int i = 0; i < batch_size; ++i) {
-      auto x = *in++;
-      auto x_sq = static_cast<float>(x * x);
-      *out++ = x_sq;
-      sum += x_sq;
-    }
-
-    in -= batch_size;
-    out -= batch_size;
-
-    if (sum != 0.f) {
-      for (int i = 0; i < batch_size; ++i) {
-        auto x = *in++;
-        auto x_sq = *out;
-
-        *out++ = (x < 0) ? std::sqrt(x_sq / sum) * -1 : std::sqrt(x_sq / sum);
-      }
-    } else {
-      for (int i = 0; i < batch_size; ++i) {
-        *out++ = static_cast<float>(*in++);
-      }
-    }
-  }
-}
-
 template <typename T>
 Status Normalizer::Normalize(OpKernelContext* context) const {
   const Tensor& X = *context->Input<Tensor>(0);
@@ -137,23 +61,17 @@ Status Normalizer::Normalize(OpKernelContext* context) const {
   const T* input = X.template Data<T>();
   float* output = Y->MutableData<float>();
 
-  switch (normalization_) {
-    case NORMALIZE::NMAX: {
-      NormalizeMax(input, output, num_batches, batch_size);
-      break;
-    }
-    case NORMALIZE::L1: {
-      NormalizeL1(input, output, num_batches, batch_size);
-      break;
-    }
-    case NORMALIZE::L2: {
-      NormalizeL2(input, output, num_batches, batch_size);
-      break;
-    }
-    default: {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unexpected NORMALIZE value of ", normalization_);
-    }
-  }
+  // the rows are normalized independently. the input is read before the output is written, for in-place use.
+  const NORMALIZE normalization = normalization_;
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), num_batches,
+      TensorOpCost{static_cast<double>(batch_size * sizeof(T)), static_cast<double>(batch_size * sizeof(float)),
+                   static_cast<double>(batch_size * 4)},
+      [normalization, input, output, batch_size](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t b = first; b < last; ++b) {
+          NormalizeRow(normalization, input + b * batch_size, output + b * batch_size, batch_size);
+        }
+      });
 
   return Status::OK();
 }
@@ -242,7 +242,11 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
     batched_kernel_dot<float>(x_data, support_vectors_, num_batches, vector_count_, feature_count_, 0.f, kernels_span,
                               threadpool);
 
-    for (int64_t n = 0; n < num_batches; n++) {
+    // each batch writes its own scores and votes so the reduction can run in parallel across the batches
+    auto reduce_batch = [this, &kernels_span, &classifier_scores, &votes_span, num_slots_per_iteration,
+                         num_classifiers](ptrdiff_t idx) {
+      const int64_t n = static_cast<int64_t>(idx);
+
       // reduce scores from kernels using coefficients, taking into account the varying number of support vectors
       // per class.
       // coefficients: [num_classes - 1, vector_count_]
@@ -299,7 +303,9 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
           ++(cur_votes[sum > 0 ? i : j]);
         }
       }
-    }
+    };
+
+    concurrency::ThreadPool::TryBatchParallelFor(threadpool, num_batches, reduce_batch, 0);
   }
 
   auto finalize_batch = [this, &final_scores, final_scores_per_batch,
@@ -39,28 +39,27 @@ class SVMCommon {
     assert(a.size() == size_t(m * k) && b.size() == size_t(k * n) && out.size() == size_t(m * n));
 
     if (kernel_type_ == KERNEL::RBF) {
-      T* cur_out = out.data();
-      const T* cur_batch = a.data();
-
-      // each batch has 'k' features
-      for (int64_t batch = 0; batch < m; ++batch) {
-        const T* cur_support_vector = b.data();
-
-        // broadcast the support vectors against the k features in each batch. output is one value per support vector
-        for (int64_t support_vector = 0; support_vector < n; ++support_vector) {
-          T sum = 0.f;
-          const T* cur_input = cur_batch;
+      // ||a - b||^2 == ||a||^2 + ||b||^2 - 2 * a.b so the cross term for all the batches and support vectors
+      // can be computed with a single GEMM, followed by one elementwise pass to add the squared norms.
+      onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                        m, n, k,
+                                        -2.f, a.data(), b.data(), 0.f,
+                                        nullptr, nullptr,
+                                        out.data(),
+                                        threadpool);
 
-          for (int64_t feature = 0; feature < k; ++feature) {
-            T val = *cur_input++ - *cur_support_vector++;
-            sum += val * val;
-          }
+      const Eigen::Array<T, Eigen::Dynamic, 1> a_norms =
+          ConstEigenMatrixMapRowMajor<T>(a.data(), m, k).rowwise().squaredNorm().array();
+      const Eigen::Array<T, 1, Eigen::Dynamic> b_norms =
+          ConstEigenMatrixMapRowMajor<T>(b.data(), n, k).rowwise().squaredNorm().transpose().array();
 
-          *cur_out++ = std::exp(-gamma_ * sum);
-        }
+      auto map_out = EigenMatrixMapRowMajor<T>(out.data(), m, n);
+      map_out.array().colwise() += a_norms;
+      map_out.array().rowwise() += b_norms;
 
-        cur_batch += k;  // move to start of next batch
-      }
+      // rounding can make the distance slightly negative for a batch that (nearly) matches a support vector
+      map_out.array() = map_out.array().max(T(0)) * -gamma_;
+      MlasComputeExp(out.data(), out.data(), out.size());
     } else {
       float alpha = 1.f;
       float beta = 1.f;
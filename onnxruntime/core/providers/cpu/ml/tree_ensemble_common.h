@@ -11,6 +11,10 @@ namespace onnxruntime {
 namespace ml {
 namespace detail {
 
+// Number of rows that are evaluated together with each tree, so the nodes of a tree
+// stay in the cache for all of them instead of being reloaded for every row.
+constexpr int64_t kTreeEnsembleRowBlockSize = 8;
+
 template <typename ITYPE, typename OTYPE>
 class TreeEnsembleCommon {
  public:
@@ -60,6 +64,19 @@ class TreeEnsembleCommon {
 
   template <typename AGG>
   void ComputeAgg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Z, Tensor* label, const AGG& agg) const;
+
+  // Computes the rows [begin, end) with 1 output (ComputeRows1) or 2+ outputs (ComputeRows),
+  // kTreeEnsembleRowBlockSize rows at a time.
+  template <typename AGG>
+  void ComputeRows1(const AGG& agg, const ITYPE* x_data, int64_t stride, int64_t begin, int64_t end,
+                    OTYPE* z_data, int64_t* label_data) const;
+
+  template <typename AGG>
+  void ComputeRows(const AGG& agg, const ITYPE* x_data, int64_t stride, int64_t begin, int64_t end,
+                   OTYPE* z_data, int64_t* label_data) const;
+
+ private:
+  void SortNodesBreadthFirst();
 };
 
 template <typename ITYPE, typename OTYPE>
@@ -215,6 +232,70 @@ TreeEnsembleCommon<ITYPE, OTYPE>::TreeEnsembleCommon(int parallel_tree, int para
   }
 }
 
+  SortNodesBreadthFirst();
+}
+
+// Stores the nodes of each tree contiguously in breadth first order. The first levels of
+// a tree are visited for every row, so this keeps them in a few cache lines. The order of
+// the trees doesn't change so the scores are aggregated in the same order.
+template <typename ITYPE, typename OTYPE>
+void TreeEnsembleCommon<ITYPE, OTYPE>::SortNodesBreadthFirst() {
+  const size_t n_nodes = nodes_.size();
+  auto index_of = [this](const TreeNodeElement<OTYPE>* node) {
+    return static_cast<size_t>(node - nodes_.data());
+  };
+
+  std::vector<size_t> order;
+  order.reserve(n_nodes);
+  std::vector<bool> visited(n_nodes, false);
+  for (auto* root : roots_) {
+    size_t next = order.size();
+    visited[index_of(root)] = true;
+    order.push_back(index_of(root));
+    while (next < order.size()) {
+      const TreeNodeElement<OTYPE>& node = nodes_[order[next++]];
+      for (const TreeNodeElement<OTYPE>* child : {node.truenode, node.falsenode}) {
+        if (child != nullptr && !visited[index_of(child)]) {
+          visited[index_of(child)] = true;
+          order.push_back(index_of(child));
+        }
+      }
+    }
+  }
+
+  // keep the nodes that can't be reached from a root
+  for (size_t i = 0; i < n_nodes; ++i) {
+    if (!visited[i]) {
+      order.push_back(i);
+    }
+  }
+
+  std::vector<size_t> new_index(n_nodes);
+  for (size_t i = 0; i < n_nodes; ++i) {
+    new_index[order[i]] = i;
+  }
+
+  std::vector<TreeNodeElement<OTYPE>> sorted_nodes;
+  sorted_nodes.reserve(n_nodes);
+  for (size_t i = 0; i < n_nodes; ++i) {
+    sorted_nodes.push_back(std::move(nodes_[order[i]]));
+  }
+
+  for (auto& node : sorted_nodes) {
+    if (node.truenode != nullptr) {
+      node.truenode = &sorted_nodes[new_index[index_of(node.truenode)]];
+    }
+    if (node.falsenode != nullptr) {
+      node.falsenode = &sorted_nodes[new_index[index_of(node.falsenode)]];
+    }
+  }
+  for (auto& root : roots_) {
+    root = &sorted_nodes[new_index[index_of(root)]];
+  }
+
+  nodes_.swap(sorted_nodes);
+}
+
 template <typename ITYPE, typename OTYPE>
 void TreeEnsembleCommon<ITYPE, OTYPE>::compute(OpKernelContext* ctx, const Tensor* X, Tensor* Z,
                                                Tensor* label) const {
@@ -287,18 +368,7 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeAgg(concurrency::ThreadPool* ttp,
       }
       agg.FinalizeScores1(z_data, score, label_data);
     } else if (N <= parallel_N_) { /* section C: 1 output, 2+ rows but not enough rows to parallelize */
-      ScoreValue<OTYPE> score;
-      size_t j;
-
-      for (int64_t i = 0; i < N; ++i) {
-        score = {0, 0};
-        for (j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-        }
-
-        agg.FinalizeScores1(z_data + i, score,
-                            label_data == nullptr ? nullptr : (label_data + i));
-      }
+      ComputeRows1(agg, x_data, stride, 0, N, z_data, label_data);
     } else if (n_trees_ > max_num_threads) { /* section D: 1 output, 2+ rows and enough trees to parallelize */
       auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(n_trees_));
       std::vector<ScoreValue<OTYPE>> scores(num_threads * N);
@@ -330,18 +400,15 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeAgg(concurrency::ThreadPool* ttp,
                                   label_data == nullptr ? nullptr : (label_data + i));
             }
           });
-    } else { /* section E: 1 output, 2+ rows, parallelization by rows */
+    } else { /* section E: 1 output, 2+ rows, parallelization by blocks of rows */
+      int64_t n_blocks = (N + kTreeEnsembleRowBlockSize - 1) / kTreeEnsembleRowBlockSize;
       concurrency::ThreadPool::TryBatchParallelFor(
           ttp,
-          SafeInt<int32_t>(N),
-          [this, &agg, x_data, z_data, stride, label_data](ptrdiff_t i) {
-            ScoreValue<OTYPE> score = {0, 0};
-            for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-              agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-            }
-
-            agg.FinalizeScores1(z_data + i, score,
-                                label_data == nullptr ? nullptr : (label_data + i));
+          SafeInt<int32_t>(n_blocks),
+          [this, &agg, x_data, z_data, stride, label_data, N](ptrdiff_t block) {
+            int64_t begin = block * kTreeEnsembleRowBlockSize;
+            ComputeRows1(agg, x_data, stride, begin, std::min(N, begin + kTreeEnsembleRowBlockSize),
+                         z_data, label_data);
           },
           0);
     }
@@ -372,18 +439,7 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeAgg(concurrency::ThreadPool* ttp,
         agg.FinalizeScores(scores[0], z_data, -1, label_data);
       }
     } else if (N <= parallel_N_) { /* section C2: 2+ outputs, 2+ rows, not enough rows to parallelize */
-      std::vector<ScoreValue<OTYPE>> scores(n_targets_or_classes_);
-      size_t j;
-
-      for (int64_t i = 0; i < N; ++i) {
-        std::fill(scores.begin(), scores.end(), ScoreValue<OTYPE>({0, 0}));
-        for (j = 0; j < roots_.size(); ++j) {
-          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-        }
-
-        agg.FinalizeScores(scores, z_data + i * n_targets_or_classes_, -1,
-                           label_data == nullptr ? nullptr : (label_data + i));
-      }
+      ComputeRows(agg, x_data, stride, 0, N, z_data, label_data);
     } else if (n_trees_ >= max_num_threads) { /* section: D2: 2+ outputs, 2+ rows, enough trees to parallelize*/
       auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(n_trees_));
       std::vector<std::vector<ScoreValue<OTYPE>>> scores(num_threads * N);
@@ -421,25 +477,64 @@ void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeAgg(concurrency::ThreadPool* ttp,
           ttp,
           num_threads,
           [this, &agg, num_threads, x_data, z_data, label_data, N, stride](ptrdiff_t batch_num) {
-            size_t j;
-            std::vector<ScoreValue<OTYPE>> scores(n_targets_or_classes_);
             auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, N);
-
-            for (auto i = work.start; i < work.end; ++i) {
-              std::fill(scores.begin(), scores.end(), ScoreValue<OTYPE>({0, 0}));
-              for (j = 0; j < roots_.size(); ++j) {
-                agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
-              }
-
-              agg.FinalizeScores(scores,
-                                 z_data + i * n_targets_or_classes_, -1,
-                                 label_data == nullptr ? nullptr : (label_data + i));
-            }
+            ComputeRows(agg, x_data, stride, work.start, work.end, z_data, label_data);
           });
     }
   }
 }  // namespace detail
 
+template <typename ITYPE, typename OTYPE>
+template <typename AGG>
+void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeRows1(const AGG& agg, const ITYPE* x_data, int64_t stride,
+                                                    int64_t begin, int64_t end,
+                                                    OTYPE* z_data, int64_t* label_data) const {
+  ScoreValue<OTYPE> scores[kTreeEnsembleRowBlockSize];
+  for (int64_t i = begin; i < end; i += kTreeEnsembleRowBlockSize) {
+    int64_t block_size = std::min(kTreeEnsembleRowBlockSize, end - i);
+    for (int64_t k = 0; k < block_size; ++k) {
+      scores[k] = {0, 0};
+    }
+
+    for (int64_t j = 0; j < n_trees_; ++j) {
+      for (int64_t k = 0; k < block_size; ++k) {
+        agg.ProcessTreeNodePrediction1(scores[k], *ProcessTreeNodeLeave(roots_[j], x_data + (i + k) * stride));
+      }
+    }
+
+    for (int64_t k = 0; k < block_size; ++k) {
+      agg.FinalizeScores1(z_data + i + k, scores[k],
+                          label_data == nullptr ? nullptr : (label_data + i + k));
+    }
+  }
+}
+
+template <typename ITYPE, typename OTYPE>
+template <typename AGG>
+void TreeEnsembleCommon<ITYPE, OTYPE>::ComputeRows(const AGG& agg, const ITYPE* x_data, int64_t stride,
+                                                   int64_t begin, int64_t end,
+                                                   OTYPE* z_data, int64_t* label_data) const {
+  std::vector<std::vector<ScoreValue<OTYPE>>> scores(
+      kTreeEnsembleRowBlockSize, std::vector<ScoreValue<OTYPE>>(n_targets_or_classes_));
+  for (int64_t i = begin; i < end; i += kTreeEnsembleRowBlockSize) {
+    int64_t block_size = std::min(kTreeEnsembleRowBlockSize, end - i);
+    for (int64_t k = 0; k < block_size; ++k) {
+      std::fill(scores[k].begin(), scores[k].end(), ScoreValue<OTYPE>({0, 0}));
+    }
+
+    for (size_t j = 0; j < roots_.size(); ++j) {
+      for (int64_t k = 0; k < block_size; ++k) {
+        agg.ProcessTreeNodePrediction(scores[k], *ProcessTreeNodeLeave(roots_[j], x_data + (i + k) * stride));
+      }
+    }
+
+    for (int64_t k = 0; k < block_size; ++k) {
+      agg.FinalizeScores(scores[k], z_data + (i + k) * n_targets_or_classes_, -1,
+                         label_data == nullptr ? nullptr : (label_data + i + k));
+    }
+  }
+}
+
 #define TREE_FIND_VALUE(CMP)                                         \
   if (has_missing_tracks_) {                                         \
     while (root->is_not_leaf) {                                      \
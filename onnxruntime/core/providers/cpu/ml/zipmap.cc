@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/zipmap.h"
+
+#include <numeric>
+
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 /**
 https://github.com/onnx/onnx/blob/master/onnx/defs/traditionalml/defs.cc
@@ -35,6 +39,46 @@ ONNX_CPU_OPERATOR_ML_KERNEL(
                                             DataTypeImpl::GetType<std::vector<std::map<std::int64_t, float>>>()}),
     ZipMapOp);
 
+template <typename T>
+static std::vector<size_t> GetSortedLabelIndices(const std::vector<T>& labels) {
+  std::vector<size_t> indices(labels.size());
+  std::iota(indices.begin(), indices.end(), size_t{0});
+  std::stable_sort(indices.begin(), indices.end(),
+                   [&labels](size_t a, size_t b) { return labels[a] < labels[b]; });
+
+  // keep the last of equal labels as its value overwrites the others
+  std::vector<size_t> unique_indices;
+  unique_indices.reserve(indices.size());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    if (i + 1 < indices.size() && !(labels[indices[i]] < labels[indices[i + 1]])) {
+      continue;
+    }
+    unique_indices.push_back(indices[i]);
+  }
+
+  return unique_indices;
+}
+
+// Creates the map of each row. The keys are inserted in sorted order with a hint, so no key comparisons are needed
+// to find the insert position, and the rows are processed in parallel.
+template <typename T>
+static void ZipRows(concurrency::ThreadPool* tp, const std::vector<T>& labels,
+                    const std::vector<size_t>& sorted_label_indices, const float* x_data,
+                    int64_t batch_size, int64_t features_per_batch, std::vector<std::map<T, float>>& y) {
+  y.resize(batch_size);
+  concurrency::ThreadPool::TryBatchParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size),
+      [&](std::ptrdiff_t n) {
+        const float* row = x_data + n * features_per_batch;
+        std::map<T, float> row_map;
+        for (auto index : sorted_label_indices) {
+          row_map.emplace_hint(row_map.end(), labels[index], row[index]);
+        }
+        y[n] = std::move(row_map);
+      },
+      0);
+}
+
 ZipMapOp::ZipMapOp(const OpKernelInfo& info)
     : OpKernel(info),
       classlabels_int64s_(info.GetAttrsOrDefault<int64_t>("classlabels_int64s")),
@@ -42,6 +86,8 @@ ZipMapOp::ZipMapOp(const OpKernelInfo& info)
   ORT_ENFORCE(classlabels_strings_.empty() ^ classlabels_int64s_.empty(),
               "Must provide classlabels_strings or classlabels_int64s but not both.");
   using_strings_ = !classlabels_strings_.empty();
+  sorted_label_indices_ = using_strings_ ? GetSortedLabelIndices(classlabels_strings_)
+                                         : GetSortedLabelIndices(classlabels_int64s_);
 }
 
 common::Status ZipMapOp::Compute(OpKernelContext* context) const {
@@ -77,17 +123,8 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
     auto* y_data = context->Output<std::vector<std::map<std::string, float>>>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
 
-    //auto* y_data = Y->template MutableData<std::vector<std::map<std::string, float>>>();
-    y_data->resize(batch_size);
-    int64_t current_weight_0 = 0;
-    for (int64_t n = 0; n < batch_size; n++) {
-      std::map<std::string, float> map1;
-      for (int64_t j = 0; j < features_per_batch; j++) {
-        map1[classlabels_strings_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map1);
-    }
+    ZipRows(context->GetOperatorThreadPool(), classlabels_strings_, sorted_label_indices_, x_data,
+            batch_size, features_per_batch, *y_data);
   } else {
     if (features_per_batch != static_cast<int64_t>(classlabels_int64s_.size())) {
       return Status(ONNXRUNTIME,
@@ -97,17 +134,8 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
     }
     auto* y_data = context->Output<std::vector<std::map<std::int64_t, float>>>(0);
     if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-    //auto* y_data = Y->template MutableData<std::vector<std::map<int64_t, float>>>();
-    y_data->resize(batch_size);
-    int64_t current_weight_0 = 0;
-    for (int n = 0; n < batch_size; n++) {
-      std::map<int64_t, float> map2;
-      for (int j = 0; j < features_per_batch; j++) {
-        map2[classlabels_int64s_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map2);
-    }
+    ZipRows(context->GetOperatorThreadPool(), classlabels_int64s_, sorted_label_indices_, x_data,
+            batch_size, features_per_batch, *y_data);
   }
   return common::Status::OK();
 }
@@ -16,6 +16,9 @@ class ZipMapOp final : public OpKernel {
   bool using_strings_;
   std::vector<int64_t> classlabels_int64s_;
   std::vector<std::string> classlabels_strings_;
+  // indices of the class labels in the order of the keys of the output maps, without the duplicates
+  // whose value is overwritten by a later label
+  std::vector<size_t> sorted_label_indices_;
 };
 
 }  // namespace ml
@@ -17,7 +17,12 @@
 
 #include "core/providers/cpu/nn/conv.h"
 
+#include <chrono>
+#include <limits>
+#include <sstream>
+
 #include "core/common/safeint.h"
+#include "core/framework/tuning_database.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -151,18 +156,111 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+// identifies a convolution run by MLAS in the tuning database, along with the number of threads the timing depends on
+static std::string MlasConvTuningKey(int64_t N, int64_t group, int64_t C, int64_t M, const TensorShape& input_shape,
+                                     const std::vector<int64_t>& kernel_shape,
+                                     const std::vector<int64_t>& dilations,
+                                     const std::vector<int64_t>& pads,
+                                     const std::vector<int64_t>& strides,
+                                     int num_threads) {
+  std::ostringstream key;
+  key.imbue(std::locale::classic());
+  key << "mlas_conv:" << N << "," << group << "," << C << "," << M;
+  for (const auto* dims : {&input_shape.GetDims(), &kernel_shape, &dilations, &pads, &strides}) {
+    key << ":";
+    for (size_t i = 0; i < dims->size(); ++i) {
+      key << (i == 0 ? "" : ",") << (*dims)[i];
+    }
+  }
+  key << ":" << num_threads;
+  return key.str();
+}
+
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // only transform the filter W of a 2D convolution
+  if (input_idx != 1 || tensor.Shape().NumDimensions() != 4) {
+    return Status::OK();
+  }
+
+  std::vector<int64_t> kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(tensor.Shape(), kernel_shape));
+
+  std::vector<int64_t> dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_shape.size(), 1);
+  }
+  std::vector<int64_t> strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_shape.size(), 1);
+  }
+
+  if (kernel_shape.size() != 2 || dilations.size() != 2 || strides.size() != 2 ||
+      conv_attrs_.group <= 0 || tensor.Shape()[0] % conv_attrs_.group != 0) {
+    return Status::OK();
+  }
+
+  const auto group_count = static_cast<size_t>(conv_attrs_.group);
+  const auto input_channels = static_cast<size_t>(tensor.Shape()[1]);
+  const auto filter_count = static_cast<size_t>(tensor.Shape()[0] / conv_attrs_.group);
+
+  const size_t winograd_w_elements = MlasConvWinogradFilterSize(kernel_shape.size(),
+                                                                group_count,
+                                                                input_channels,
+                                                                kernel_shape.data(),
+                                                                dilations.data(),
+                                                                strides.data(),
+                                                                filter_count);
+  if (winograd_w_elements == 0) {
+    return Status::OK();
+  }
+
+  const size_t winograd_w_size = SafeInt<size_t>(sizeof(float)) * winograd_w_elements;
+  winograd_w_ = BufferUniquePtr(alloc->Alloc(winograd_w_size), BufferDeleter(alloc));
+  MlasConvWinogradTransformFilter(group_count,
+                                  input_channels,
+                                  filter_count,
+                                  tensor.Data<float>(),
+                                  static_cast<float*>(winograd_w_.get()));
+  w_shape_ = tensor.Shape();
+  is_packed = true;
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(std::move(winograd_w_));
+    prepacked_weights->buffer_sizes_.push_back(winograd_w_size);
+  }
+
+  return Status::OK();
+}
+
+Status Conv<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    winograd_w_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const auto* X = context->Input<Tensor>(0);
-  const auto* W = context->Input<Tensor>(1);
+  const auto* W = winograd_w_ ? nullptr : context->Input<Tensor>(1);
+  const auto& W_shape = W ? W->Shape() : w_shape_;
   const Tensor* B = num_inputs == 3 ? context->Input<Tensor>(2) : nullptr;
   const int64_t N = X->Shape()[0];
   const int64_t C = X->Shape()[1];
-  const int64_t M = W->Shape()[0];
-  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
+  const int64_t M = W_shape[0];
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape));
 
   std::vector<int64_t> kernel_shape;
-  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W->Shape(), kernel_shape));
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
 
   std::vector<int64_t> pads(conv_attrs_.pads);
   if (pads.empty()) {
@@ -199,35 +297,85 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
   concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
 
   if (kernel_rank >= 1 && kernel_rank <= 3) {
-    MLAS_CONV_PARAMETERS Parameters;
-    size_t WorkingBufferSize;
-    MlasConvPrepare(&Parameters,
-                    kernel_rank,
-                    static_cast<size_t>(N),
-                    static_cast<size_t>(conv_attrs_.group),
-                    static_cast<size_t>(C / conv_attrs_.group),
-                    input_shape.GetDims().data(),
-                    kernel_shape.data(),
-                    dilations.data(),
-                    pads.data(),
-                    strides.data(),
-                    output_shape.GetDims().data(),
-                    static_cast<size_t>(M / conv_attrs_.group),
-                    &activation_,
-                    &WorkingBufferSize,
-                    thread_pool);
-
-    auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(SafeInt<size_t>(sizeof(float)) * WorkingBufferSize)
-                                               : nullptr;
-    BufferUniquePtr working_buffer(working_data, BufferDeleter(alloc));
-
-    MlasConv(&Parameters,
-             Xdata,
-             W->template Data<float>(),
-             Bdata,
-             static_cast<float*>(working_buffer.get()),
-             Ydata,
-             thread_pool);
+    const float* Wdata = winograd_w_ ? static_cast<const float*>(winograd_w_.get()) : W->template Data<float>();
+
+    auto run_mlas_conv = [&](const MLAS_CONV_ALGORITHM* preferred_algorithm,
+                             MLAS_CONV_ALGORITHM* algorithm) {
+      MLAS_CONV_PARAMETERS Parameters;
+      size_t WorkingBufferSize;
+      MlasConvPrepare(&Parameters,
+                      kernel_rank,
+                      static_cast<size_t>(N),
+                      static_cast<size_t>(conv_attrs_.group),
+                      static_cast<size_t>(C / conv_attrs_.group),
+                      input_shape.GetDims().data(),
+                      kernel_shape.data(),
+                      dilations.data(),
+                      pads.data(),
+                      strides.data(),
+                      output_shape.GetDims().data(),
+                      static_cast<size_t>(M / conv_attrs_.group),
+                      &activation_,
+                      &WorkingBufferSize,
+                      thread_pool,
+                      winograd_w_ != nullptr,
+                      preferred_algorithm);
+      if (algorithm != nullptr) {
+        *algorithm = Parameters.Algorithm;
+      }
+
+      auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(SafeInt<size_t>(sizeof(float)) * WorkingBufferSize)
+                                                 : nullptr;
+      BufferUniquePtr working_buffer(working_data, BufferDeleter(alloc));
+
+      MlasConv(&Parameters,
+               Xdata,
+               Wdata,
+               Bdata,
+               static_cast<float*>(working_buffer.get()),
+               Ydata,
+               thread_pool);
+    };
+
+    const bool use_tuning = tuning::IsTuningEnabled() || tuning::GetTuningDatabase().Size() > 0;
+    if (winograd_w_ || !use_tuning) {
+      run_mlas_conv(nullptr, nullptr);
+      return Status::OK();
+    }
+
+    // the choice between the expand then GEMM algorithms is a heuristic, so it can be replaced by a tuned choice
+    const std::string tuning_key = MlasConvTuningKey(N, conv_attrs_.group, C, M, input_shape, kernel_shape,
+                                                     dilations, pads, strides,
+                                                     concurrency::ThreadPool::DegreeOfParallelism(thread_pool));
+    std::vector<int64_t> tuned;
+    MLAS_CONV_ALGORITHM algorithm;
+    if (tuning::GetTuningDatabase().Lookup(tuning_key, tuned) && tuned.size() == 1) {
+      algorithm = static_cast<MLAS_CONV_ALGORITHM>(tuned[0]);
+      run_mlas_conv(&algorithm, nullptr);
+    } else if (tuning::IsTuningEnabled()) {
+      run_mlas_conv(nullptr, &algorithm);
+      if (algorithm == MlasConvAlgorithmExpandThenGemm || algorithm == MlasConvAlgorithmExpandThenGemmSegmented) {
+        // the fastest of a few runs of each, after the run above that warmed up the caches. the output of the last
+        // run is the same as any other.
+        double best_seconds = std::numeric_limits<double>::max();
+        for (MLAS_CONV_ALGORITHM candidate : {MlasConvAlgorithmExpandThenGemm,
+                                              MlasConvAlgorithmExpandThenGemmSegmented}) {
+          for (int i = 0; i < 3; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            run_mlas_conv(&candidate, nullptr);
+            const std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+            if (seconds.count() < best_seconds) {
+              best_seconds = seconds.count();
+              algorithm = candidate;
+            }
+          }
+        }
+      }
+
+      tuning::RecordTuningResult(tuning_key, {static_cast<int64_t>(algorithm)});
+    } else {
+      run_mlas_conv(nullptr, nullptr);
+    }
   } else {
     const int64_t input_image_size = input_shape.Size();
     const int64_t output_image_size = output_shape.Size();
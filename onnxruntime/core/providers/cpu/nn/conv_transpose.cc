@@ -17,7 +17,10 @@
 
 #include "core/providers/cpu/nn/conv_transpose.h"
 
+#include <algorithm>
+
 #include "core/common/safeint.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 
@@ -35,6 +38,162 @@ ONNX_CPU_OPERATOR_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     ConvTranspose<float>);
 
+namespace {
+// The 2D ConvTranspose with 4x4 kernels, 2x2 strides and no dilation, the 2x upsampling of most decoders, computed
+// without the column buffer and col2im. The output pixels whose row and column have the same parities get the
+// contributions of the same 2x2 of the 16 kernel taps, from the input pixels of the tap at the same offsets. So the
+// output of each of these 4 phases is the sum of the GEMMs of the weights of its 4 taps with the input shifted by
+// the taps, computed over the input padded with a ring of zeros, and is then scattered to its pixels.
+struct Stride2Kernel4Phase {
+  int64_t output_begin;  // the first output of the phase, the others follow every 2
+  int64_t input_begin;   // the input of the tap of the first output with the smaller kernel index
+  int64_t count;
+};
+
+// Gets the phase of the outputs o of a dim with (o + pad) % 2 == parity, which get the taps parity and parity + 2.
+// Returns false if they need inputs beyond the ring of zeros around the input.
+bool GetStride2Kernel4Phase(int64_t input_size, int64_t output_size, int64_t pad, int64_t parity,
+                            Stride2Kernel4Phase& phase) {
+  phase.output_begin = ((parity - pad) % 2 + 2) % 2;
+  phase.input_begin = (phase.output_begin + pad - parity) / 2;
+  phase.count = phase.output_begin < output_size ? (output_size - phase.output_begin + 1) / 2 : 0;
+  return phase.count == 0 || (phase.input_begin >= 0 && phase.input_begin + phase.count - 1 <= input_size);
+}
+
+bool GetStride2Kernel4Phases(const ConvTransposeAttributes::Prepare& p, Stride2Kernel4Phase phases[2][2]) {
+  if (p.X->Shape().NumDimensions() != 4 || p.kernel_shape != std::vector<int64_t>{4, 4} ||
+      p.strides != std::vector<int64_t>{2, 2} || p.dilations != std::vector<int64_t>{1, 1}) {
+    return false;
+  }
+
+  for (int64_t parity = 0; parity < 2; ++parity) {
+    for (size_t dim = 0; dim < 2; ++dim) {
+      if (!GetStride2Kernel4Phase(p.input_shape[dim], p.Y->Shape()[2 + dim], p.pads[dim], parity,
+                                  phases[dim][parity])) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename T>
+Status ConvTransposeStride2Kernel4(const ConvTransposeAttributes::Prepare& p, int64_t group,
+                                   const Stride2Kernel4Phase phases[2][2], AllocatorPtr alloc,
+                                   concurrency::ThreadPool* thread_pool) {
+  const int64_t input_height = p.input_shape[0];
+  const int64_t input_width = p.input_shape[1];
+  const int64_t output_height = p.Y->Shape()[2];
+  const int64_t output_width = p.Y->Shape()[3];
+  const int64_t input_channels = p.num_input_channels / group;
+  const int64_t output_channels = p.num_output_channels / group;
+  const int64_t padded_width = input_width + 2;
+  const int64_t padded_size = (input_height + 2) * padded_width;
+  constexpr int64_t kernel_size = 16;
+
+  // the weights of each tap as a [input_channels, output_channels] matrix
+  const int64_t packed_filter_size = group * kernel_size * input_channels * output_channels;
+  BufferUniquePtr packed_filter_buffer(alloc->Alloc(SafeInt<size_t>(sizeof(T)) * packed_filter_size),
+                                       BufferDeleter(alloc));
+  T* packed_filter = static_cast<T*>(packed_filter_buffer.get());
+  const T* filter_data = p.F->template Data<T>();
+  for (int64_t gc = 0; gc < group * input_channels; ++gc) {
+    const int64_t group_id = gc / input_channels;
+    const int64_t ic = gc % input_channels;
+    for (int64_t oc = 0; oc < output_channels; ++oc) {
+      for (int64_t tap = 0; tap < kernel_size; ++tap) {
+        packed_filter[((group_id * kernel_size + tap) * input_channels + ic) * output_channels + oc] =
+            filter_data[(gc * output_channels + oc) * kernel_size + tap];
+      }
+    }
+  }
+
+  // the input is copied inside a ring of zeros, which stays zero
+  BufferUniquePtr padded_input_buffer(alloc->Alloc(SafeInt<size_t>(sizeof(T)) * input_channels * padded_size),
+                                      BufferDeleter(alloc));
+  T* padded_input = static_cast<T*>(padded_input_buffer.get());
+  std::fill_n(padded_input, input_channels * padded_size, static_cast<T>(0));
+
+  // the outputs of a phase, in rows of padded_width of which the last ones are not used
+  const int64_t phase_output_size = (input_height + 1) * padded_width;
+  BufferUniquePtr phase_output_buffer(alloc->Alloc(SafeInt<size_t>(sizeof(T)) * output_channels * phase_output_size),
+                                      BufferDeleter(alloc));
+  T* phase_output = static_cast<T*>(phase_output_buffer.get());
+
+  const T* Xdata = p.X->template Data<T>();
+  T* Ydata = p.Y->template MutableData<T>();
+  const int64_t output_image_size = output_height * output_width;
+
+  for (int64_t image_id = 0; image_id < p.N; ++image_id) {
+    for (int64_t group_id = 0; group_id < group; ++group_id) {
+      const T* x = Xdata + (image_id * group + group_id) * input_channels * input_height * input_width;
+      T* y = Ydata + (image_id * group + group_id) * output_channels * output_image_size;
+      const T* bias = p.B != nullptr ? p.B->template Data<T>() + group_id * output_channels : nullptr;
+
+      for (int64_t ic = 0; ic < input_channels; ++ic) {
+        for (int64_t iy = 0; iy < input_height; ++iy) {
+          std::copy_n(x + (ic * input_height + iy) * input_width, input_width,
+                      padded_input + ic * padded_size + (iy + 1) * padded_width + 1);
+        }
+      }
+
+      for (int64_t row_parity = 0; row_parity < 2; ++row_parity) {
+        for (int64_t col_parity = 0; col_parity < 2; ++col_parity) {
+          const Stride2Kernel4Phase& rows = phases[0][row_parity];
+          const Stride2Kernel4Phase& cols = phases[1][col_parity];
+          if (rows.count == 0 || cols.count == 0) {
+            continue;
+          }
+
+          // the taps parity + 2 read the input row or column before the one of the taps parity
+          const int64_t phase_size = (rows.count - 1) * padded_width + cols.count;
+          for (int64_t tap_row = 0; tap_row < 2; ++tap_row) {
+            for (int64_t tap_col = 0; tap_col < 2; ++tap_col) {
+              const int64_t tap = (row_parity + 2 * tap_row) * 4 + col_parity + 2 * tap_col;
+              math::GemmEx<T, concurrency::ThreadPool>(
+                  CblasTrans,
+                  CblasNoTrans,
+                  output_channels,
+                  phase_size,
+                  input_channels,
+                  1,
+                  packed_filter + (group_id * kernel_size + tap) * input_channels * output_channels,
+                  static_cast<int>(output_channels),
+                  padded_input + (rows.input_begin - tap_row + 1) * padded_width + cols.input_begin - tap_col + 1,
+                  static_cast<int>(padded_size),
+                  tap_row + tap_col == 0 ? 0 : 1,
+                  phase_output,
+                  static_cast<int>(phase_size),
+                  thread_pool);
+            }
+          }
+
+          concurrency::ThreadPool::TryParallelFor(
+              thread_pool, output_channels,
+              TensorOpCost{static_cast<double>(phase_size * sizeof(T)),
+                           static_cast<double>(rows.count * cols.count * sizeof(T)),
+                           static_cast<double>(rows.count * cols.count)},
+              [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+                for (std::ptrdiff_t oc = begin; oc < end; ++oc) {
+                  const T* src = phase_output + oc * phase_size;
+                  T* dst = y + oc * output_image_size + rows.output_begin * output_width + cols.output_begin;
+                  const T b = bias != nullptr ? bias[oc] : static_cast<T>(0);
+                  for (int64_t i = 0; i < rows.count; ++i) {
+                    for (int64_t j = 0; j < cols.count; ++j) {
+                      dst[i * 2 * output_width + 2 * j] = src[i * padded_width + j] + b;
+                    }
+                  }
+                }
+              });
+        }
+      }
+    }
+  }
+
+  return Status::OK();
+}
+}  // namespace
+
 template <typename T>
 Status ConvTranspose<T>::Compute(OpKernelContext* context) const {
   return ConvTranspose<T>::DoConvTranspose(context, false);
@@ -65,6 +224,11 @@ Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
 
+  Stride2Kernel4Phase phases[2][2];
+  if (GetStride2Kernel4Phases(p, phases)) {
+    return ConvTransposeStride2Kernel4<T>(p, conv_transpose_attrs_.group, phases, alloc, thread_pool);
+  }
+
   const int64_t col_buffer_size = kernel_dim * p.input_shape.Size();
   auto col_data = alloc->Alloc(SafeInt<size_t>(sizeof(T)) * col_buffer_size);
   BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
@@ -91,24 +255,31 @@ Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_
             col_buffer_data,
             thread_pool);
 
-        // Col2im
-        math::Col2im<T, CPUMathUtil, StorageOrder::NCHW>(
-            col_buffer_data,
-            p.num_output_channels / conv_transpose_attrs_.group,
-            p.Y->Shape()[2],
-            p.Y->Shape()[3],
-            p.kernel_shape[0],
-            p.kernel_shape[1],
-            p.dilations[0],
-            p.dilations[1],
-            p.pads[0],
-            p.pads[1],
-            p.pads[2],
-            p.pads[3],
-            p.strides[0],
-            p.strides[1],
-            Ydata + group_id * Y_offset,
-            &CPUMathUtil::Instance());
+        // Col2im, in parallel over the output channels as they only accumulate into their own planes
+        concurrency::ThreadPool::TryParallelFor(
+            thread_pool, p.num_output_channels / conv_transpose_attrs_.group,
+            TensorOpCost{static_cast<double>(kernel_size * input_image_size * sizeof(T)),
+                         static_cast<double>(output_size * sizeof(T)),
+                         static_cast<double>(kernel_size * input_image_size)},
+            [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+              math::Col2im<T, CPUMathUtil, StorageOrder::NCHW>(
+                  col_buffer_data + begin * kernel_size * input_image_size,
+                  end - begin,
+                  p.Y->Shape()[2],
+                  p.Y->Shape()[3],
+                  p.kernel_shape[0],
+                  p.kernel_shape[1],
+                  p.dilations[0],
+                  p.dilations[1],
+                  p.pads[0],
+                  p.pads[1],
+                  p.pads[2],
+                  p.pads[3],
+                  p.strides[0],
+                  p.strides[1],
+                  Ydata + group_id * Y_offset + begin * output_size,
+                  &CPUMathUtil::Instance());
+            });
       }
 
       if (p.B != nullptr) {
@@ -5,8 +5,7 @@
 
 #include "core/framework/op_kernel.h"
 #include "core/framework/random_generator.h"
-#include <chrono>
-#include <random>
+#include "core/providers/cpu/generator/philox.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -17,14 +16,14 @@ class Dropout final: public OpKernel {
   Dropout(const OpKernelInfo& info) : OpKernel{info} {
     int64_t seed = 0;
     if (info.GetAttr<int64_t>("seed", &seed).IsOK()) {
-      generator_ = onnxruntime::make_unique<RandomGenerator>(seed);
+      generator_ = onnxruntime::make_unique<PhiloxGenerator>(static_cast<uint64_t>(seed));
     }
   }
 
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  mutable std::unique_ptr<RandomGenerator> generator_;
+  mutable std::unique_ptr<PhiloxGenerator> generator_;
 };
 
 namespace {
@@ -81,14 +80,24 @@ Status Dropout<T1, T2>::Compute(OpKernelContext* context) const {
     EigenVectorArrayMap<T1> Y_arr(Y_span.data(), Y_span.size());
     EigenVectorArrayMap<bool> mask_arr(mask_span.data(), mask_span.size());
 
-    // generate mask
+    // generate mask, in parallel from the Philox blocks of the call
     {
-      RandomGenerator& generator = generator_ != nullptr ? *generator_.get() : RandomGenerator::Default();
-      std::default_random_engine rng(generator.NextSeed());
-      std::uniform_real_distribution<float> dist{0.0f, 1.0f};
-      mask_arr = Eigen::ArrayX<bool>::NullaryExpr(
-          mask_arr.size(),
-          [ratio_value, &dist, &rng]() { return dist(rng) >= ratio_value; });
+      PhiloxGenerator& generator = generator_ != nullptr ? *generator_.get() : PhiloxGenerator::Default();
+      bool* mask_data = mask_span.data();
+      const std::ptrdiff_t mask_size = mask_span.size();
+      constexpr std::ptrdiff_t values_per_block = Philox4x32::NumValuesPerBlock<float>();
+      Philox4x32::ParallelFor(
+          context->GetOperatorThreadPool(), generator, (mask_size + values_per_block - 1) / values_per_block,
+          TensorOpCost{0, static_cast<double>(values_per_block), 50.0},
+          [ratio_value, mask_data, mask_size](std::ptrdiff_t block, const Philox4x32::Block& bits) {
+            float uniform[Philox4x32::NumValuesPerBlock<float>()];
+            Philox4x32::Uniform(bits, uniform);
+            const std::ptrdiff_t begin = block * Philox4x32::NumValuesPerBlock<float>();
+            const std::ptrdiff_t end = std::min(begin + Philox4x32::NumValuesPerBlock<float>(), mask_size);
+            for (std::ptrdiff_t i = begin; i < end; ++i) {
+              mask_data[i] = uniform[i - begin] >= ratio_value;
+            }
+          });
     }
 
     Y_arr = mask_arr.cast<T1>() * X_arr / (1.0f - ratio_value);
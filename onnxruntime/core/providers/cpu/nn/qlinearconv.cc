@@ -22,7 +22,12 @@ class QLinearConv : public OpKernel {
   }
 
   Status Compute(OpKernelContext* context) const override;
-  Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override;
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
 
  private:
   static void ReorderFilter(const uint8_t* input,
@@ -84,7 +89,8 @@ ONNX_OPERATOR_KERNEL_EX(
 
 #endif
 
-Status QLinearConv::PrePack(const Tensor& tensor, int input_idx, bool& is_packed) {
+Status QLinearConv::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
   is_packed = false;
 
   // Support packing the weight matrix.
@@ -113,8 +119,6 @@ Status QLinearConv::PrePack(const Tensor& tensor, int input_idx, bool& is_packed
   W_shape_ = shape;
   is_W_signed_ = tensor.IsDataType<int8_t>();
 
-  auto alloc = Info().GetAllocator(0, OrtMemTypeDefault);
-
 #ifdef MLAS_SUPPORTS_PACKED_GEMM_U8X8
   const size_t group_count = static_cast<size_t>(conv_attrs_.group);
   const size_t group_output_channels = output_channels / group_count;
@@ -147,6 +151,13 @@ Status QLinearConv::PrePack(const Tensor& tensor, int input_idx, bool& is_packed
 
       is_W_packed_ = true;
       is_packed = true;
+
+      if (prepacked_weights != nullptr) {
+        prepacked_weights->buffers_.push_back(std::move(packed_W_buffer_));
+        prepacked_weights->buffer_sizes_.push_back(SafeInt<size_t>(group_count) * packed_W_size_);
+        prepacked_weights->buffers_.push_back(nullptr);
+        prepacked_weights->buffer_sizes_.push_back(0);
+      }
       return Status::OK();
     }
   }
@@ -159,6 +170,30 @@ Status QLinearConv::PrePack(const Tensor& tensor, int input_idx, bool& is_packed
 
   is_W_packed_ = true;
   is_packed = true;
+
+  if (prepacked_weights != nullptr) {
+    prepacked_weights->buffers_.push_back(nullptr);
+    prepacked_weights->buffer_sizes_.push_back(0);
+    prepacked_weights->buffers_.push_back(std::move(reordered_W_buffer_));
+    prepacked_weights->buffer_sizes_.push_back(output_channels * group_input_channels * kernel_size);
+  }
+  return Status::OK();
+}
+
+Status QLinearConv::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx != 3) {
+    return Status::OK();
+  }
+
+  // PrePack adds the packed buffer followed by the reordered buffer, one of which is null
+  used_shared_buffers = true;
+  packed_W_buffer_ = std::move(prepacked_buffers[0]);
+  reordered_W_buffer_ = std::move(prepacked_buffers[1]);
+
   return Status::OK();
 }
 
@@ -183,7 +218,10 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
   auto X_zero_point_value = *(X_zero_point->template Data<uint8_t>());
   auto Y_zero_point_value = *(Y_zero_point->template Data<uint8_t>());
 
+  // The filter zero points are either constant or per output channel. The
+  // per output channel zero points are only used if they aren't all equal.
   uint8_t W_zero_point_value;
+  const uint8_t* W_zero_points = nullptr;
   const auto& W_zero_point_shape = W_zero_point->Shape();
   if (W_zero_point_shape.NumDimensions() == 0 ||
       (W_zero_point_shape.NumDimensions() == 1 && (W_zero_point_shape[0] == 1 || W_zero_point_shape[0] == M))) {
@@ -192,7 +230,8 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
     W_zero_point_value = W_zero_point_data[0];
     for (int64_t i = 1; i < W_zero_point_size; i++) {
       if (W_zero_point_data[i] != W_zero_point_value) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "QLinearConv : filter zero point must be constant");
+        W_zero_points = W_zero_point_data;
+        break;
       }
     }
   } else {
@@ -380,7 +419,8 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
       MlasTranspose(Xdata,
                     static_cast<uint8_t*>(transpose_input_buffer.get()),
                     static_cast<size_t>(C),
-                    static_cast<size_t>(input_image_size));
+                    static_cast<size_t>(input_image_size),
+                    thread_pool);
       input_data = static_cast<uint8_t*>(transpose_input_buffer.get());
       output_data = static_cast<uint8_t*>(transpose_output_buffer.get());
     }
@@ -471,7 +511,25 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
         }
 
         if (is_depthwise_conv) {
-          if (is_W_signed) {
+          if (W_zero_points != nullptr && is_W_signed) {
+            MlasConvDepthwise(worker_gemm_input,
+                              X_zero_point_value,
+                              reinterpret_cast<int8_t*>(reordered_W),
+                              reinterpret_cast<const int8_t*>(W_zero_points),
+                              worker_gemm_output,
+                              static_cast<size_t>(M),
+                              static_cast<size_t>(output_count),
+                              static_cast<size_t>(kernel_size));
+          } else if (W_zero_points != nullptr) {
+            MlasConvDepthwise(worker_gemm_input,
+                              X_zero_point_value,
+                              reordered_W,
+                              W_zero_points,
+                              worker_gemm_output,
+                              static_cast<size_t>(M),
+                              static_cast<size_t>(output_count),
+                              static_cast<size_t>(kernel_size));
+          } else if (is_W_signed) {
             MlasConvDepthwise(worker_gemm_input,
                               X_zero_point_value,
                               reinterpret_cast<int8_t*>(reordered_W),
@@ -491,48 +549,56 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
                               static_cast<size_t>(kernel_size));
           }
         } else {
+          // Requantize each block of the output as soon as it is produced
+          // instead of making a separate pass over the whole int32 buffer.
+          const bool per_column_scale = output_scales.size() > 1;
+          MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR requant_processor(
+              worker_requantize_output + group_id * group_output_channels,
+              static_cast<size_t>(M),
+              Bdata != nullptr ? Bdata + group_id * group_output_channels : nullptr,
+              output_scales.data() + (per_column_scale ? group_id * group_output_channels : 0),
+              per_column_scale,
+              Y_zero_point_value);
+
+          MLAS_GEMM_U8X8_PARAMETERS gemm_params;
+          gemm_params.M = static_cast<size_t>(output_count);
+          gemm_params.N = static_cast<size_t>(group_output_channels);
+          gemm_params.K = static_cast<size_t>(kernel_dim);
+          gemm_params.A = worker_gemm_input;
+          gemm_params.lda = static_cast<size_t>(kernel_dim);
+          gemm_params.ZeroPointA = X_zero_point_value;
+          gemm_params.ZeroPointB = W_zero_point_value;
+          gemm_params.PerColumnZeroPointB =
+              W_zero_points != nullptr ? W_zero_points + group_id * group_output_channels : nullptr;
+          gemm_params.BIsSigned = is_W_signed;
+          gemm_params.C = worker_gemm_output + group_id * group_output_channels;
+          gemm_params.ldc = static_cast<size_t>(M);
+          gemm_params.OutputProcessor = &requant_processor;
+
 #ifdef MLAS_SUPPORTS_PACKED_GEMM_U8X8
           if (packed_W_buffer_) {
-            MlasGemm(static_cast<size_t>(output_count),
-                     static_cast<size_t>(group_output_channels),
-                     static_cast<size_t>(kernel_dim),
-                     worker_gemm_input,
-                     static_cast<size_t>(kernel_dim),
-                     X_zero_point_value,
-                     static_cast<const int8_t*>(packed_W_buffer_.get()) + group_id * packed_W_size_,
-                     W_zero_point_value,
-                     is_W_signed,
-                     worker_gemm_output + group_id * group_output_channels,
-                     static_cast<size_t>(M),
-                     nullptr);
+            gemm_params.B = static_cast<const int8_t*>(packed_W_buffer_.get()) + group_id * packed_W_size_;
+            gemm_params.BIsPacked = true;
           } else
 #endif
           {
-            MlasGemm(static_cast<size_t>(output_count),
-                     static_cast<size_t>(group_output_channels),
-                     static_cast<size_t>(kernel_dim),
-                     worker_gemm_input,
-                     static_cast<size_t>(kernel_dim),
-                     X_zero_point_value,
-                     reordered_W + group_id * group_output_channels,
-                     static_cast<size_t>(M),
-                     W_zero_point_value,
-                     is_W_signed,
-                     worker_gemm_output + group_id * group_output_channels,
-                     static_cast<size_t>(M),
-                     nullptr);
+            gemm_params.B = reordered_W + group_id * group_output_channels;
+            gemm_params.ldb = static_cast<size_t>(M);
           }
+          MlasGemm(gemm_params, nullptr);
         }
       }
 
-      MlasRequantizeOutput(worker_gemm_output,
-                           worker_requantize_output,
-                           Bdata,
-                           static_cast<size_t>(output_count),
-                           static_cast<size_t>(M),
-                           output_scales.data(),
-                           output_scales.size() > 1,
-                           Y_zero_point_value);
+      if (is_depthwise_conv) {
+        MlasRequantizeOutput(worker_gemm_output,
+                             worker_requantize_output,
+                             Bdata,
+                             static_cast<size_t>(output_count),
+                             static_cast<size_t>(M),
+                             output_scales.data(),
+                             output_scales.size() > 1,
+                             Y_zero_point_value);
+      }
     };
 
     concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, thread_count, conv_worker);
@@ -542,7 +608,8 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
       MlasTranspose(output_data,
                     Ydata,
                     static_cast<size_t>(output_image_size),
-                    static_cast<size_t>(M));
+                    static_cast<size_t>(M),
+                    thread_pool);
     }
 
     Xdata += X_offset;
@@ -2,7 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/nn/roi_pool.h"
+#include <algorithm>
 #include <cmath>
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
 ONNX_CPU_OPERATOR_KERNEL(
@@ -33,64 +36,99 @@ Status RoiPool<float>::Compute(OpKernelContext* context) const {
 
   auto* Ydata = Y->template MutableData<float>();
 
+  const int64_t num_roi_cols = R->Shape().SizeFromDimension(1);
   for (int n = 0; n < num_rois; n++) {
-    int roi_batch_id = static_cast<int>(rois[0]);
-    int roi_start_w = static_cast<int>(std::round(rois[1] * spatial_scale_));
-    int roi_start_h = static_cast<int>(std::round(rois[2] * spatial_scale_));
-    int roi_end_w = static_cast<int>(std::round(rois[3] * spatial_scale_));
-    int roi_end_h = static_cast<int>(std::round(rois[4] * spatial_scale_));
+    int roi_batch_id = static_cast<int>(rois[n * num_roi_cols]);
     ORT_ENFORCE(roi_batch_id >= 0);
     ORT_ENFORCE(roi_batch_id < batch_size);
+  }
+
+  // The work is partitioned over the ROIs and blocks of their channels. The pooling regions of the rows and columns
+  // of an ROI are computed once per work range for all of its channels.
+  constexpr int channel_block_size = 16;
+  const int channel_blocks = (channels + channel_block_size - 1) / channel_block_size;
+  const int64_t channel_size = X->Shape().SizeFromDimension(2);
+  const int64_t pooled_size = Y->Shape().SizeFromDimension(2);
+  // the size of the pooling regions depends on the ROIs, 16 input elements per output is a rough guess
+  const double cost = static_cast<double>(std::min(channels, channel_block_size) * pooled_size * 16);
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_rois) * channel_blocks, cost,
+      [&](std::ptrdiff_t work, std::ptrdiff_t end) {
+        // [start (included), end (excluded)) of the pooling regions of the rows and the columns
+        std::vector<std::pair<int, int>> h_ranges(static_cast<size_t>(pooled_height_));
+        std::vector<std::pair<int, int>> w_ranges(static_cast<size_t>(pooled_width_));
+        std::ptrdiff_t ranges_n = -1;
+
+        for (; work != end; ++work) {
+          const std::ptrdiff_t n = work / channel_blocks;
+          const int channel_begin = static_cast<int>(work % channel_blocks) * channel_block_size;
+          const int channel_end = std::min(channel_begin + channel_block_size, channels);
+          const float* roi = rois + n * num_roi_cols;
+          int roi_batch_id = static_cast<int>(roi[0]);
+
+          if (n != ranges_n) {
+            int roi_start_w = static_cast<int>(std::round(roi[1] * spatial_scale_));
+            int roi_start_h = static_cast<int>(std::round(roi[2] * spatial_scale_));
+            int roi_end_w = static_cast<int>(std::round(roi[3] * spatial_scale_));
+            int roi_end_h = static_cast<int>(std::round(roi[4] * spatial_scale_));
+
+            // Force malformed ROIs to be 1x1
+            int roi_height = std::max(roi_end_h - roi_start_h + 1, 1);
+            int roi_width = std::max(roi_end_w - roi_start_w + 1, 1);
+
+            const float bin_size_h =
+                static_cast<float>(roi_height) / static_cast<float>(pooled_height_);
+            const float bin_size_w =
+                static_cast<float>(roi_width) / static_cast<float>(pooled_width_);
+
+            // Compute pooling region for each output unit:
+            //  start (included) = floor(ph * roi_height / pooled_height_)
+            //  end (excluded) = ceil((ph + 1) * roi_height / pooled_height_)
+            // Add roi offsets and clip to input boundaries
+            for (int ph = 0; ph < pooled_height_; ++ph) {
+              int hstart = static_cast<int>(std::floor(static_cast<float>(ph) * bin_size_h));
+              int hend = static_cast<int>(std::ceil(static_cast<float>(ph + 1) * bin_size_h));
+              h_ranges[ph] = {std::min(std::max(hstart + roi_start_h, 0), height),
+                              std::min(std::max(hend + roi_start_h, 0), height)};
+            }
+            for (int pw = 0; pw < pooled_width_; ++pw) {
+              int wstart = static_cast<int>(std::floor(static_cast<float>(pw) * bin_size_w));
+              int wend = static_cast<int>(std::ceil(static_cast<float>(pw + 1) * bin_size_w));
+              w_ranges[pw] = {std::min(std::max(wstart + roi_start_w, 0), width),
+                              std::min(std::max(wend + roi_start_w, 0), width)};
+            }
+            ranges_n = n;
+          }
 
-    // Force malformed ROIs to be 1x1
-    int roi_height = std::max(roi_end_h - roi_start_h + 1, 1);
-    int roi_width = std::max(roi_end_w - roi_start_w + 1, 1);
-
-    const float bin_size_h =
-        static_cast<float>(roi_height) / static_cast<float>(pooled_height_);
-    const float bin_size_w =
-        static_cast<float>(roi_width) / static_cast<float>(pooled_width_);
-
-    const float* batch_data = Xdata + roi_batch_id * X->Shape().SizeFromDimension(1);
-
-    for (int c = 0; c < channels; ++c) {
-      for (int ph = 0; ph < pooled_height_; ++ph) {
-        for (int pw = 0; pw < pooled_width_; ++pw) {
-          // Compute pooling region for this output unit:
-          //  start (included) = floor(ph * roi_height / pooled_height_)
-          //  end (excluded) = ceil((ph + 1) * roi_height / pooled_height_)
-          int hstart = static_cast<int>(std::floor(static_cast<float>(ph) * bin_size_h));
-          int wstart = static_cast<int>(std::floor(static_cast<float>(pw) * bin_size_w));
-          int hend = static_cast<int>(std::ceil(static_cast<float>(ph + 1) * bin_size_h));
-          int wend = static_cast<int>(std::ceil(static_cast<float>(pw + 1) * bin_size_w));
-
-          // Add roi offsets and clip to input boundaries
-          hstart = std::min(std::max(hstart + roi_start_h, 0), height);
-          hend = std::min(std::max(hend + roi_start_h, 0), height);
-          wstart = std::min(std::max(wstart + roi_start_w, 0), width);
-          wend = std::min(std::max(wend + roi_start_w, 0), width);
-
-          const int pool_index = static_cast<int>(ph * pooled_width_ + pw);
-
-          // Define an empty pooling region to be zero
-          bool is_empty = (hend <= hstart) || (wend <= wstart);
-          Ydata[pool_index] = is_empty ? 0 : std::numeric_limits<float>::lowest();
-
-          for (int h = hstart; h < hend; ++h) {
-            for (int w = wstart; w < wend; ++w) {
-              const int index = h * width + w;
-              Ydata[pool_index] = std::max(batch_data[index], Ydata[pool_index]);
+          for (int c = channel_begin; c < channel_end; ++c) {
+            const float* channel_data = Xdata + (static_cast<int64_t>(roi_batch_id) * channels + c) * channel_size;
+            float* pooled_data = Ydata + (n * channels + c) * pooled_size;
+
+            for (int ph = 0; ph < pooled_height_; ++ph) {
+              const int hstart = h_ranges[ph].first;
+              const int hend = h_ranges[ph].second;
+              for (int pw = 0; pw < pooled_width_; ++pw) {
+                const int wstart = w_ranges[pw].first;
+                const int wend = w_ranges[pw].second;
+
+                // Define an empty pooling region to be zero
+                bool is_empty = (hend <= hstart) || (wend <= wstart);
+                float pooled_value = is_empty ? 0 : std::numeric_limits<float>::lowest();
+
+                // the rows of the region are reduced as vectors
+                for (int h = hstart; !is_empty && h < hend; ++h) {
+                  pooled_value = std::max(
+                      ConstEigenVectorArrayMap<float>(channel_data + h * width + wstart, wend - wstart).maxCoeff(),
+                      pooled_value);
+                }
+
+                pooled_data[ph * pooled_width_ + pw] = pooled_value;
+              }
             }
           }
         }
-      }
-      // Increment all data pointers by one channel
-      batch_data += X->Shape().SizeFromDimension(2);
-      Ydata += Y->Shape().SizeFromDimension(2);
-    }
-    // Increment ROI data pointer
-    rois += R->Shape().SizeFromDimension(1);
-  }
+      });
 
   return Status::OK();
 }
@@ -6,6 +6,7 @@
 #include "core/framework/tensor.h"
 #include "core/platform/threadpool.h"
 
+#include <algorithm>
 #include <functional>
 #include <unordered_map>
 
@@ -140,14 +141,18 @@ struct TfIdfVectorizer::Impl {
   Impl(const Impl&) = delete;
   Impl& operator=(const Impl&) = delete;
 
-  void IncrementCount(size_t ngram_id, size_t row_num,
-                      std::vector<uint32_t>& frequencies) const {
+  // Counts go straight into the float output of the row, which is exact for any realistic number of
+  // occurrences. The first hit of each output entry is recorded so the weights only touch counted entries.
+  void IncrementCount(size_t ngram_id, float* row_output, std::vector<size_t>& counted) const {
     assert(ngram_id != 0);
     --ngram_id;
     assert(ngram_id < ngram_indexes_.size());
-    auto output_idx = row_num * output_size_ + ngram_indexes_[ngram_id];
-    assert(static_cast<size_t>(output_idx) < frequencies.size());
-    ++frequencies[output_idx];
+    auto output_idx = static_cast<size_t>(ngram_indexes_[ngram_id]);
+    assert(output_idx < output_size_);
+    if (row_output[output_idx] == 0) {
+      counted.push_back(output_idx);
+    }
+    ++row_output[output_idx];
   }
 };
 
@@ -251,56 +256,28 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
 
 TfIdfVectorizer::~TfIdfVectorizer() = default;
 
-void TfIdfVectorizer::OutputResult(OpKernelContext* ctx, size_t B, const std::vector<uint32_t>& frequences) const {
+void TfIdfVectorizer::ApplyWeights(float* row_output, const std::vector<size_t>& counted) const {
   const Impl& impl = *impl_;
-  std::vector<int64_t> output_dims;
-  if (B == 0) {
-    output_dims.push_back(impl.output_size_);
-    B = 1;  // For use in the loops below
-  } else {
-    output_dims.push_back(B);
-    output_dims.push_back(impl.output_size_);
-  }
-
-  const auto row_size = impl.output_size_;
-
-  TensorShape output_shape(output_dims);
-  assert(frequences.size() == static_cast<size_t>(output_shape.Size()));
-
-  auto Y = ctx->Output(0, output_shape);
-  auto output_data = Y->MutableData<float>();
   const auto& w = impl.weights_;
   switch (impl.weighting_criteria_) {
-    case kTF: {
-      for (auto f : frequences) {
-        *output_data++ = static_cast<float>(f);
-      }
-    } break;
+    case kTF:
+      // the counts are the output
+      break;
     case kIDF: {
       if (!w.empty()) {
-        const auto* freqs = frequences.data();
-        for (size_t batch = 0; batch < B; ++batch) {
-          for (size_t i = 0; i < row_size; ++i) {
-            *output_data++ = (*freqs++ > 0) ? w[i] : 0;
-          }
+        for (auto i : counted) {
+          row_output[i] = w[i];
         }
       } else {
-        for (auto f : frequences) {
-          *output_data++ = (f > 0) ? 1.0f : 0;
+        for (auto i : counted) {
+          row_output[i] = 1.0f;
         }
       }
     } break;
     case kTFIDF: {
       if (!w.empty()) {
-        const auto* freqs = frequences.data();
-        for (size_t batch = 0; batch < B; ++batch) {
-          for (size_t i = 0; i < row_size; ++i) {
-            *output_data++ = *freqs++ * w[i];
-          }
-        }
-      } else {
-        for (auto f : frequences) {
-          *output_data++ = static_cast<float>(f);
+        for (auto i : counted) {
+          row_output[i] *= w[i];
         }
       }
     } break;
@@ -311,7 +288,7 @@ void TfIdfVectorizer::OutputResult(OpKernelContext* ctx, size_t B, const std::ve
 }
 
 void TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx, ptrdiff_t row_num, size_t row_size,
-                                  std::vector<uint32_t>& frequencies) const {
+                                  float* row_output) const {
   auto X = ctx->Input<Tensor>(0);
   const auto elem_size = X->DataType()->Size();
 
@@ -323,6 +300,9 @@ void TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx, ptrdiff_t row_num, size_
   const auto max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
   auto start_ngram_size = impl.min_gram_length_;
 
+  // output entries counted in this row. with a large vocabulary only a tiny part of the row is non-zero.
+  std::vector<size_t> counted;
+
   for (auto skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
     auto ngram_start = row_begin;
     auto const ngram_row_end = row_end;
@@ -348,7 +328,7 @@ void TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx, ptrdiff_t row_num, size_
             break;
           }
           if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            impl.IncrementCount(hit->second->id_, row_num, frequencies);
+            impl.IncrementCount(hit->second->id_, row_output, counted);
           }
           str_map = &hit->second->leafs_;
         }
@@ -365,7 +345,7 @@ void TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx, ptrdiff_t row_num, size_
             break;
           }
           if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            impl.IncrementCount(hit->second->id_, row_num, frequencies);
+            impl.IncrementCount(hit->second->id_, row_output, counted);
           }
           int_map = &hit->second->leafs_;
         }
@@ -379,6 +359,8 @@ void TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx, ptrdiff_t row_num, size_
       break;
     }
   }
+
+  ApplyWeights(row_output, counted);
 }
 
 Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
@@ -411,10 +393,21 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   }
 
   assert((num_rows * C) == total_items);
-  // Frequency holder allocate [B..output_size_]
-  // and init all to zero
-  std::vector<uint32_t> frequencies;
-  frequencies.resize(num_rows * impl_->output_size_, 0);
+
+  std::vector<int64_t> output_dims;
+  if (B == 0) {
+    output_dims.push_back(impl_->output_size_);
+  } else {
+    output_dims.push_back(B);
+    output_dims.push_back(impl_->output_size_);
+  }
+
+  // Rows are counted directly into the zero initialized output [B..output_size_]
+  // so no separate frequency buffer of the same size is needed
+  TensorShape output_shape(output_dims);
+  auto Y = ctx->Output(0, output_shape);
+  auto output_data = Y->MutableData<float>();
+  std::fill_n(output_data, output_shape.Size(), 0.f);
 
   if (total_items == 0 ||
       (X->IsDataTypeString() && impl_->str_map_.empty()) ||
@@ -424,18 +417,16 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
     // TfidfVectorizer returns a zero tensor of shape
     // {b_dim, output_size} when b_dim is the number of received observations
     // and output_size the is the maximum value in ngram_indexes attribute plus 1.
-    OutputResult(ctx, B, frequencies);
     return Status::OK();
   }
 
-  std::function<void(ptrdiff_t)> fn = [this, ctx, C, &frequencies](ptrdiff_t row_num) {
-    ComputeImpl(ctx, row_num, C, frequencies);
+  const size_t output_size = impl_->output_size_;
+  std::function<void(ptrdiff_t)> fn = [this, ctx, C, output_data, output_size](ptrdiff_t row_num) {
+    ComputeImpl(ctx, row_num, C, output_data + row_num * output_size);
   };
 
   concurrency::ThreadPool::TryBatchParallelFor(ctx->GetOperatorThreadPool(), num_rows, std::move(fn), 0);
 
-  OutputResult(ctx, B, frequencies);
-
   return Status::OK();
 }
 
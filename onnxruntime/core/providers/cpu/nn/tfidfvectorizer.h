@@ -20,11 +20,12 @@ class TfIdfVectorizer final : public OpKernel {
 
  private:
 
+  // Count the n-grams of a row into its zero initialized output and apply the weighting criteria
   void ComputeImpl(OpKernelContext* ctx, ptrdiff_t row_num, size_t row_size,
-                     std::vector<uint32_t>& frequencies) const;
+                   float* row_output) const;
 
-  // Apply weighing criteria and output
-  void OutputResult(OpKernelContext* ctx, size_t b_dim, const std::vector<uint32_t>& frequences) const;
+  // Apply weighing criteria to the entries of a row that were counted
+  void ApplyWeights(float* row_output, const std::vector<size_t>& counted) const;
 
   struct Impl;
   std::unique_ptr<Impl> impl_;
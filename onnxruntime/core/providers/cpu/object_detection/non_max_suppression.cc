@@ -13,6 +13,7 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 #include "non_max_suppression_helper.h"
+#include "core/platform/threadpool.h"
 #include <queue>
 #include <utility>
 //TODO:fix the warnings
@@ -181,61 +182,77 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
 
   const auto center_point_box = GetCenterPointBox();
 
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfo> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
-
-  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfo> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index, center_point_box, batch_boxes + (box_index * 4));
-          }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
+  // Each (batch, class) pair is suppressed independently so the pairs are processed in parallel.
+  // The selected indices of each pair go to their own vector which are concatenated in order at the end.
+  const int64_t num_batch_classes = pc.num_batches_ * pc.num_classes_;
+  std::vector<std::vector<SelectedIndex>> selected_indices_per_class(static_cast<size_t>(num_batch_classes));
+
+  auto suppress_class = [&](std::ptrdiff_t batch_class_index) {
+    const int64_t batch_index = batch_class_index / pc.num_classes_;
+    const int64_t class_index = batch_class_index % pc.num_classes_;
+    auto& selected_indices = selected_indices_per_class[batch_class_index];
+
+    int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
+    const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
+    std::vector<BoxInfo> candidate_boxes;
+    candidate_boxes.reserve(pc.num_boxes_);
+
+    // Filter by score_threshold_
+    const auto* class_scores = scores_data + box_score_offset;
+    if (pc.score_threshold_ != nullptr) {
+      for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
+        if (*class_scores > score_threshold) {
           candidate_boxes.emplace_back(*class_scores, box_index, center_point_box, batch_boxes + (box_index * 4));
         }
       }
-      std::priority_queue<BoxInfo, std::vector<BoxInfo>> sorted_boxes(std::less<BoxInfo>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfo& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (next_top_score.SuppressByIOU(selected_index, iou_threshold)) {
-            selected = false;
-            break;
-          }
+    } else {
+      for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
+        candidate_boxes.emplace_back(*class_scores, box_index, center_point_box, batch_boxes + (box_index * 4));
+      }
+    }
+    std::priority_queue<BoxInfo, std::vector<BoxInfo>> sorted_boxes(std::less<BoxInfo>(), std::move(candidate_boxes));
+
+    std::vector<BoxInfo> selected_boxes_inside_class;
+    selected_boxes_inside_class.reserve(
+        std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), sorted_boxes.size()));
+
+    // Get the next box with top score, filter by iou_threshold
+    while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
+      const BoxInfo& next_top_score = sorted_boxes.top();
+
+      bool selected = true;
+      // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
+      for (const auto& selected_index : selected_boxes_inside_class) {
+        if (next_top_score.SuppressByIOU(selected_index, iou_threshold)) {
+          selected = false;
+          break;
         }
+      }
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
-        }
-        sorted_boxes.pop();
-      }  //while
-    }    //for class_index
-  }      //for batch_index
+      if (selected) {
+        selected_boxes_inside_class.push_back(next_top_score);
+        selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
+      }
+      sorted_boxes.pop();
+    }  //while
+  };
+
+  concurrency::ThreadPool::TryBatchParallelFor(ctx->GetOperatorThreadPool(), num_batch_classes, suppress_class, 0);
+
+  size_t num_selected = 0;
+  for (const auto& class_selected_indices : selected_indices_per_class) {
+    num_selected += class_selected_indices.size();
+  }
 
   const auto last_dim = 3;
-  const auto num_selected = selected_indices.size();
   Tensor* output = ctx->Output(0, {static_cast<int64_t>(num_selected), last_dim});
   ORT_ENFORCE(output != nullptr);
   static_assert(last_dim * sizeof(int64_t) == sizeof(SelectedIndex), "Possible modification of SelectedIndex");
-  memcpy(output->MutableData<int64_t>(), selected_indices.data(), num_selected * sizeof(SelectedIndex));
+  auto* output_data = output->MutableData<int64_t>();
+  for (const auto& class_selected_indices : selected_indices_per_class) {
+    memcpy(output_data, class_selected_indices.data(), class_selected_indices.size() * sizeof(SelectedIndex));
+    output_data += class_selected_indices.size() * last_dim;
+  }
 
   return Status::OK();
 }
@@ -147,11 +147,23 @@ void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, floa
   int64_t pooled_height = output_shape[2];
   int64_t pooled_width = output_shape[3];
 
+  // the work is partitioned over the ROIs and blocks of their channels, so that a few large ROIs spread over the
+  // threads too. The coefficients of an ROI are shared by its channels, each work range computes them once per ROI.
+  constexpr int64_t channel_block_size = 16;
+  const int64_t channel_blocks = (channels + channel_block_size - 1) / channel_block_size;
+
   //100 is a random chosed value, need be tuned
-  double cost = static_cast<double>(channels * pooled_width * pooled_height * 100);
+  double cost = static_cast<double>(std::min(channels, channel_block_size) * pooled_width * pooled_height * 100);
+
+  const auto work_count = static_cast<ptrdiff_t>(n_rois * channel_blocks);
+  ThreadPool::TryParallelFor(ttp, work_count, cost, [&](ptrdiff_t work, ptrdiff_t end) {
+    std::vector<PreCalc<T>> pre_calc;
+    int64_t pre_calc_n = -1;
 
-  ThreadPool::TryParallelFor(ttp, static_cast<ptrdiff_t>(n_rois), cost, [&](ptrdiff_t n, ptrdiff_t end) {
-    for (; n != end; ++n) {
+    for (; work != end; ++work) {
+      const int64_t n = work / channel_blocks;
+      const int64_t channel_begin = (work % channel_blocks) * channel_block_size;
+      const int64_t channel_end = std::min(channel_begin + channel_block_size, channels);
       int64_t index_n = n * channels * pooled_width * pooled_height;
 
       const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
@@ -181,12 +193,15 @@ void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, floa
 
       // we want to precalculate indices and weights shared by all channels,
       // this is the key point of optimization
-      std::vector<PreCalc<T>> pre_calc(roi_bin_grid_h * roi_bin_grid_w * pooled_width * pooled_height);
-      pre_calc_for_bilinear_interpolate(height, width, pooled_height, pooled_width, roi_bin_grid_h, roi_bin_grid_w,
-                                        roi_start_h, roi_start_w, bin_size_h, bin_size_w, roi_bin_grid_h,
-                                        roi_bin_grid_w, pre_calc);
+      if (n != pre_calc_n) {
+        pre_calc.resize(roi_bin_grid_h * roi_bin_grid_w * pooled_width * pooled_height);
+        pre_calc_for_bilinear_interpolate(height, width, pooled_height, pooled_width, roi_bin_grid_h, roi_bin_grid_w,
+                                          roi_start_h, roi_start_w, bin_size_h, bin_size_w, roi_bin_grid_h,
+                                          roi_bin_grid_w, pre_calc);
+        pre_calc_n = n;
+      }
 
-      for (int64_t c = 0; c < channels; c++) {
+      for (int64_t c = channel_begin; c < channel_end; c++) {
         int64_t index_n_c = index_n + c * pooled_width * pooled_height;
         const T* offset_bottom_data =
             bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
@@ -233,7 +248,7 @@ void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, floa
           }  // for pw
         }    // for ph
       }      // for c
-    }        // for n
+    }        // for work
   });
 }
 }  // namespace
@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+// Partitions the range [0, total) into blocks for the two pass parallel algorithms of the operators whose output
+// positions depend on a prefix count, such as NonZero, Compress, CumSum and Unique. The first pass reduces each block
+// in parallel, an exclusive prefix of the block values gives each block its offset in the output, and the second pass
+// writes the output of each block from its offset in parallel.
+// The blocks are no smaller than min_block_size so small inputs use a single block and run on the calling thread.
+class ParallelScan {
+ public:
+  static constexpr std::ptrdiff_t kDefaultMinBlockSize = 16384;
+
+  ParallelScan(concurrency::ThreadPool* tp, std::ptrdiff_t total,
+               std::ptrdiff_t min_block_size = kDefaultMinBlockSize)
+      : tp_(tp), total_(total) {
+    const std::ptrdiff_t max_blocks = std::max<std::ptrdiff_t>(total / std::max<std::ptrdiff_t>(min_block_size, 1), 1);
+    // a few blocks per thread balance the load if the cost of the blocks differs
+    const int degree_of_parallelism = concurrency::ThreadPool::DegreeOfParallelism(tp);
+    num_blocks_ = degree_of_parallelism > 1 ? std::min<std::ptrdiff_t>(max_blocks, 4 * degree_of_parallelism) : 1;
+  }
+
+  std::ptrdiff_t NumBlocks() const { return num_blocks_; }
+
+  // Calls fn(block, begin, end) for each block [begin, end) of the range, in parallel.
+  template <typename Fn>
+  void ForEachBlock(Fn&& fn) const {
+    if (num_blocks_ == 1) {
+      fn(std::ptrdiff_t{0}, std::ptrdiff_t{0}, total_);
+      return;
+    }
+
+    concurrency::ThreadPool::TrySimpleParallelFor(tp_, num_blocks_, [&](std::ptrdiff_t block) {
+      const auto work = concurrency::ThreadPool::PartitionWork(block, num_blocks_, total_);
+      fn(block, work.start, work.end);
+    });
+  }
+
+  // Sets offsets[block] to the sum of block_sum(begin, end) over the blocks before it, with the block sums computed
+  // in parallel, and returns the sum over all of the blocks.
+  template <typename T, typename Fn>
+  T ExclusiveScan(Fn&& block_sum, std::vector<T>& offsets) const {
+    offsets.assign(static_cast<size_t>(num_blocks_), T{});
+    ForEachBlock([&](std::ptrdiff_t block, std::ptrdiff_t begin, std::ptrdiff_t end) {
+      offsets[block] = block_sum(begin, end);
+    });
+
+    T sum{};
+    for (auto& offset : offsets) {
+      const T block_value = offset;
+      offset = sum;
+      sum += block_value;
+    }
+    return sum;
+  }
+
+ private:
+  concurrency::ThreadPool* const tp_;
+  const std::ptrdiff_t total_;
+  std::ptrdiff_t num_blocks_;
+};
+
+}  // namespace onnxruntime
@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/reduction/reduction_ops.h"
 #include "core/providers/common.h"
+#include "core/mlas/inc/mlas.h"
 
 using namespace std;
 namespace onnxruntime {
@@ -347,6 +348,103 @@ void NoTransposePrepareForReduce(const TensorShape& new_input_shape,
   }
 }
 
+// Reduces the input with MLAS if, after dropping dimensions of size 1 and merging
+// adjacent dimensions, the reduced axes form a single run of shape [K0, R, K1]
+// where K0 or K1 may be absent. Returns false if the layout is not supported.
+static bool MlasReduce(MLAS_REDUCTION_KIND kind, const float* from_data, float* to_data,
+                       const TensorShape& new_input_shape, const std::vector<int64_t>& reduced_axes,
+                       concurrency::ThreadPool* tp) {
+  if (new_input_shape.Size() == 0) {
+    return false;
+  }
+
+  // Collapses the input shape into alternating runs of kept and reduced dimensions.
+  std::vector<std::pair<int64_t, bool>> runs;
+  for (size_t i = 0; i < new_input_shape.NumDimensions(); ++i) {
+    int64_t dim = new_input_shape[i];
+    if (dim == 1) {
+      continue;
+    }
+    bool reduced = std::find(reduced_axes.begin(), reduced_axes.end(), static_cast<int64_t>(i)) != reduced_axes.end();
+    if (!runs.empty() && runs.back().second == reduced) {
+      runs.back().first *= dim;
+    } else {
+      runs.emplace_back(dim, reduced);
+    }
+  }
+
+  size_t reduced_run = 0;
+  while (reduced_run < runs.size() && !runs[reduced_run].second) {
+    ++reduced_run;
+  }
+  if (reduced_run == runs.size() || reduced_run > 1 || runs.size() > reduced_run + 2) {
+    return false;
+  }
+
+  const int64_t outer_size = reduced_run == 1 ? runs[0].first : 1;
+  const int64_t reduce_size = runs[reduced_run].first;
+  const int64_t inner_size = runs.size() == reduced_run + 2 ? runs.back().first : 1;
+
+  if (inner_size == 1) {
+    auto fn = [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      MlasReduceInnerAxis(kind, from_data + first * reduce_size, to_data + first,
+                          static_cast<size_t>(last - first), static_cast<size_t>(reduce_size));
+    };
+    auto cost = TensorOpCost{static_cast<double>(reduce_size * sizeof(float)),
+                             static_cast<double>(sizeof(float)),
+                             static_cast<double>(reduce_size)};
+    concurrency::ThreadPool::TryParallelFor(tp, outer_size, cost, fn);
+    return true;
+  }
+
+  // Each unit of work reduces a block of columns from one outer slice so that
+  // a thread pool can be used even when the outer size is small.
+  constexpr int64_t block_size = 16;
+  const int64_t blocks_per_slice = (inner_size + block_size - 1) / block_size;
+  auto fn = [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    while (first < last) {
+      const int64_t outer = first / blocks_per_slice;
+      const int64_t block = first % blocks_per_slice;
+      const int64_t block_count = std::min<int64_t>(last - first, blocks_per_slice - block);
+      const int64_t start_n = block * block_size;
+      const int64_t count_n = std::min(block_count * block_size, inner_size - start_n);
+      MlasReduceOuterAxis(kind, from_data + outer * reduce_size * inner_size + start_n,
+                          to_data + outer * inner_size + start_n, static_cast<size_t>(reduce_size),
+                          static_cast<size_t>(count_n), static_cast<size_t>(inner_size));
+      first += block_count;
+    }
+  };
+  auto cost = TensorOpCost{static_cast<double>(reduce_size * block_size * sizeof(float)),
+                           static_cast<double>(block_size * sizeof(float)),
+                           static_cast<double>(reduce_size * block_size)};
+  concurrency::ThreadPool::TryParallelFor(tp, outer_size * blocks_per_slice, cost, fn);
+  return true;
+}
+
+// Aggregators with an MLAS equivalent use the vectorized reductions when the
+// layout allows it. All other aggregators always use the generic loops.
+template <typename T, typename AGG>
+struct ReduceAggregatorMlas {
+  static bool TryReduce(const T*, typename AGG::value_type*, const TensorShape&, const std::vector<int64_t>&,
+                        concurrency::ThreadPool*) {
+    return false;
+  }
+};
+
+#define REDUCE_AGGREGATOR_MLAS(AGG, kind)                                                             \
+  template <>                                                                                         \
+  struct ReduceAggregatorMlas<float, AGG<float>> {                                                    \
+    static bool TryReduce(const float* from_data, float* to_data, const TensorShape& new_input_shape, \
+                          const std::vector<int64_t>& reduced_axes, concurrency::ThreadPool* tp) {    \
+      return MlasReduce(kind, from_data, to_data, new_input_shape, reduced_axes, tp);                 \
+    }                                                                                                 \
+  };
+
+REDUCE_AGGREGATOR_MLAS(ReduceAggregatorSum, MlasSumReduction)
+REDUCE_AGGREGATOR_MLAS(ReduceAggregatorMean, MlasMeanReduction)
+REDUCE_AGGREGATOR_MLAS(ReduceAggregatorMax, MlasMaximumReduction)
+REDUCE_AGGREGATOR_MLAS(ReduceAggregatorMin, MlasMinimumReduction)
+
 template <typename T, typename AGG>
 void NoTransposeReduce(Tensor* output, const TensorShape& new_input_shape, const Tensor& input,
                        const std::vector<int64_t>& reduced_axes, concurrency::ThreadPool* tp,
@@ -363,6 +461,10 @@ void NoTransposeReduce(Tensor* output, const TensorShape& new_input_shape, const
     return;
   }
 
+  if (ReduceAggregatorMlas<T, AGG>::TryReduce(from_data, to_data, new_input_shape, reduced_axes, tp)) {
+    return;
+  }
+
   if (!last_results.equal(new_input_shape.GetDims(), reduced_axes)) {
     NoTransposePrepareForReduce(new_input_shape, reduced_axes, last_results);
     if (last_results.last_loop_red_size == 0 || last_results.last_loop_size == 0)
@@ -161,8 +161,8 @@ class UniDirectionalGru {
                     onnxruntime::concurrency::ThreadPool* ttp);
 
   void Compute(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths, int num_directions,
-               const gsl::span<const T>& input_weights, const gsl::span<const T>& recurrent_weights,
-               gsl::span<T>& outputs, gsl::span<T>& final_hidden_state);
+               const GemmWeights<T>& input_weights, const GemmWeights<T>& recurrent_weightsZR,
+               const GemmWeights<T>& recurrent_weightsH, gsl::span<T>& outputs, gsl::span<T>& final_hidden_state);
 
   ~UniDirectionalGru() = default;
 
@@ -236,6 +236,99 @@ class UniDirectionalGru {
 #define DumpMatrix(...) ((void)0)
 #endif
 
+Status DeepCpuGruOp::TryPackWeights(const Tensor& weights, size_t row_offset, size_t num_rows,
+                                    PackedWeights& packed_weights, bool& is_packed, AllocatorPtr alloc) {
+  const auto& shape = weights.Shape();
+  if (shape.NumDimensions() != 3) {
+    return Status::OK();
+  }
+
+  // weights: [num_directions, 3*hidden_size, input_size]
+  // recurrence weights: [num_directions, 3*hidden_size, hidden_size]
+  const size_t rows_per_direction = static_cast<size_t>(shape[1]);
+  const size_t K = static_cast<size_t>(shape[2]);
+
+  if ((shape[0] != num_directions_) || (rows_per_direction != static_cast<size_t>(hidden_size_ * 3)) ||
+      (row_offset + num_rows > rows_per_direction)) {
+    return Status::OK();
+  }
+
+  const size_t packed_weights_size = MlasGemmPackBSize(num_rows, K);
+  if (packed_weights_size == 0) {
+    return Status::OK();
+  }
+
+  auto* packed_weights_data = alloc->Alloc(SafeInt<size_t>(packed_weights_size) * num_directions_);
+  packed_weights.buffer_ = BufferUniquePtr(packed_weights_data, BufferDeleter(alloc));
+  packed_weights.weights_size_ = packed_weights_size;
+  packed_weights.shape_ = shape;
+
+  const auto* weights_data = weights.Data<float>() + row_offset * K;
+  for (int i = 0; i < num_directions_; i++) {
+    MlasGemmPackB(CblasTrans, num_rows, K, weights_data, K, packed_weights_data);
+    packed_weights_data = static_cast<uint8_t*>(packed_weights_data) + packed_weights_size;
+    weights_data += rows_per_direction * K;
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+Status DeepCpuGruOp::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                             /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  if (!tensor.IsDataType<float>()) {
+    return Status::OK();
+  }
+
+  const size_t hidden_size = static_cast<size_t>(hidden_size_);
+
+  if (input_idx == 1) {
+    ORT_RETURN_IF_ERROR(TryPackWeights(tensor, 0, 3 * hidden_size, packed_W_, is_packed, alloc));
+    if (is_packed && prepacked_weights != nullptr) {
+      prepacked_weights->buffers_.push_back(std::move(packed_W_.buffer_));
+      prepacked_weights->buffer_sizes_.push_back(packed_W_.weights_size_ * num_directions_);
+    }
+  } else if (input_idx == 2) {
+    // R[zr] and Rh are only usable as a pair, so both have to be packed for R to be considered packed
+    bool is_zr_packed = false;
+    bool is_h_packed = false;
+    ORT_RETURN_IF_ERROR(TryPackWeights(tensor, 0, 2 * hidden_size, packed_R_zr_, is_zr_packed, alloc));
+    ORT_RETURN_IF_ERROR(TryPackWeights(tensor, 2 * hidden_size, hidden_size, packed_R_h_, is_h_packed, alloc));
+
+    is_packed = is_zr_packed && is_h_packed;
+    if (!is_packed) {
+      packed_R_zr_.buffer_.reset();
+      packed_R_h_.buffer_.reset();
+    } else if (prepacked_weights != nullptr) {
+      prepacked_weights->buffers_.push_back(std::move(packed_R_zr_.buffer_));
+      prepacked_weights->buffer_sizes_.push_back(packed_R_zr_.weights_size_ * num_directions_);
+      prepacked_weights->buffers_.push_back(std::move(packed_R_h_.buffer_));
+      prepacked_weights->buffer_sizes_.push_back(packed_R_h_.weights_size_ * num_directions_);
+    }
+  }
+
+  return Status::OK();
+}
+
+Status DeepCpuGruOp::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                               int input_idx,
+                                               /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_W_.buffer_ = std::move(prepacked_buffers[0]);
+  } else if (input_idx == 2) {
+    used_shared_buffers = true;
+    packed_R_zr_.buffer_ = std::move(prepacked_buffers[0]);
+    packed_R_h_.buffer_ = std::move(prepacked_buffers[1]);
+  }
+
+  return Status::OK();
+}
+
 Status DeepCpuGruOp::Compute(OpKernelContext* context) const {
   const Tensor& X = *context->Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
 
@@ -258,8 +351,13 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   concurrency::ThreadPool* thread_pool = context.GetOperatorThreadPool();
 
   const Tensor& X = *context.Input<Tensor>(0);  // inputs. [seq_length, batch_size, input_size]
-  const Tensor& W = *context.Input<Tensor>(1);  // weights. [num_directions, 3*hidden_size, input_size]
-  const Tensor& R = *context.Input<Tensor>(2);  // recurrence weights. [num_directions, 3*hidden_size, hidden_size]
+  // weights. [num_directions, 3*hidden_size, input_size]
+  const Tensor* W = packed_W_.buffer_ ? nullptr : context.Input<Tensor>(1);
+  // recurrence weights. [num_directions, 3*hidden_size, hidden_size]
+  const Tensor* R = packed_R_zr_.buffer_ ? nullptr : context.Input<Tensor>(2);
+
+  const auto& W_shape = (W != nullptr) ? W->Shape() : packed_W_.shape_;
+  const auto& R_shape = (R != nullptr) ? R->Shape() : packed_R_zr_.shape_;
 
   // optional
   const auto* B = context.Input<Tensor>(3);              // bias. [num_directions, 6*hidden_size]
@@ -272,7 +370,7 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   int batch_size = gsl::narrow<int>(X_shape[1]);
   int input_size = gsl::narrow<int>(X_shape[2]);
 
-  auto status = ValidateCommonRnnInputs(X, W.Shape(), R.Shape(), B, 3, sequence_lens, initial_h, num_directions_, hidden_size_);
+  auto status = ValidateCommonRnnInputs(X, W_shape, R_shape, B, 3, sequence_lens, initial_h, num_directions_, hidden_size_);
   ORT_RETURN_IF_ERROR(status);
 
   // GRU outputs are optional but must be in the same order
@@ -295,8 +393,8 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   AllocatorPtr alloc;
   status = context.GetTempSpaceAllocator(&alloc);
   ORT_RETURN_IF_ERROR(status);
-  gsl::span<const T> input_weights = W.DataAsSpan<T>();
-  gsl::span<const T> recurrent_weights = R.DataAsSpan<T>();
+  const T* input_weights = (W != nullptr) ? W->Data<T>() : nullptr;
+  const T* recurrent_weights = (R != nullptr) ? R->Data<T>() : nullptr;
   gsl::span<const T> bias = B != nullptr ? B->DataAsSpan<T>() : gsl::span<const T>();
 
   // spans for first direction
@@ -304,8 +402,14 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
   const size_t recurrent_weights_size_per_direction = 3 * hidden_size_ * hidden_size_;
   const size_t bias_size_per_direction = 6 * hidden_size_;
 
-  gsl::span<const T> input_weights_1 = input_weights.subspan(0, input_weights_size_per_direction);
-  gsl::span<const T> recurrent_weights_1 = recurrent_weights.subspan(0, recurrent_weights_size_per_direction);
+  // R[zr] is the first 2*hidden_size rows of R for the direction and Rh is the last hidden_size rows
+  const size_t recurrent_weights_zr_size = 2 * hidden_size_ * hidden_size_;
+  const T* recurrent_weights_h = (recurrent_weights != nullptr) ? recurrent_weights + recurrent_weights_zr_size
+                                                                : nullptr;
+
+  GemmWeights<T> input_weights_1(0, input_weights, input_weights_size_per_direction, packed_W_);
+  GemmWeights<T> recurrent_weights_zr_1(0, recurrent_weights, recurrent_weights_size_per_direction, packed_R_zr_);
+  GemmWeights<T> recurrent_weights_h_1(0, recurrent_weights_h, recurrent_weights_size_per_direction, packed_R_h_);
   gsl::span<const T> bias_1 = bias.empty() ? bias : bias.subspan(0, bias_size_per_direction);
 
   gsl::span<const T> input = X.DataAsSpan<T>();
@@ -340,10 +444,9 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
 
   if (direction_ == Direction::kBidirectional) {
     // spans for second direction
-    gsl::span<const T> input_weights_2 = input_weights.subspan(input_weights_size_per_direction,
-                                                               input_weights_size_per_direction);
-    gsl::span<const T> recurrent_weights_2 = recurrent_weights.subspan(recurrent_weights_size_per_direction,
-                                                                       recurrent_weights_size_per_direction);
+    GemmWeights<T> input_weights_2(1, input_weights, input_weights_size_per_direction, packed_W_);
+    GemmWeights<T> recurrent_weights_zr_2(1, recurrent_weights, recurrent_weights_size_per_direction, packed_R_zr_);
+    GemmWeights<T> recurrent_weights_h_2(1, recurrent_weights_h, recurrent_weights_size_per_direction, packed_R_h_);
     gsl::span<const T> bias_2 = bias.empty() ? bias : bias.subspan(bias_size_per_direction, bias_size_per_direction);
 
     gsl::span<const T> initial_hidden_2 = initial_hidden.empty()
@@ -362,24 +465,24 @@ Status DeepCpuGruOp::ComputeImpl(OpKernelContext& context) const {
                                     activation_funcs_.Entries()[0],
                                     activation_funcs_.Entries()[1],
                                     clip_, thread_pool);
-    fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
-               output_1, hidden_output_1);
+    fw.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_zr_1,
+               recurrent_weights_h_1, output_1, hidden_output_1);
 
     detail::UniDirectionalGru<T> bw(alloc, seq_length, batch_size, input_size, hidden_size_,
                                     linear_before_reset_, Direction::kReverse, bias_2, initial_hidden_2,
                                     activation_funcs_.Entries()[2],
                                     activation_funcs_.Entries()[3],
                                     clip_, thread_pool);
-    bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_2,
-               output_2, hidden_output_2);
+    bw.Compute(input, sequence_lens_span, num_directions_, input_weights_2, recurrent_weights_zr_2,
+               recurrent_weights_h_2, output_2, hidden_output_2);
   } else {
     detail::UniDirectionalGru<T> gru_p(alloc, seq_length, batch_size, input_size, hidden_size_,
                                        linear_before_reset_, direction_, bias_1, initial_hidden_1,
                                        activation_funcs_.Entries()[0],
                                        activation_funcs_.Entries()[1],
                                        clip_, thread_pool);
-    gru_p.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_1,
-                  output_1, hidden_output_1);
+    gru_p.Compute(input, sequence_lens_span, num_directions_, input_weights_1, recurrent_weights_zr_1,
+                  recurrent_weights_h_1, output_1, hidden_output_1);
   }
 
   if (!output.empty())
@@ -478,8 +581,9 @@ template <typename T>
 void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
                                    const gsl::span<const int>& sequence_lengths_arg,
                                    const int num_directions,
-                                   const gsl::span<const T>& input_weights,
-                                   const gsl::span<const T>& recurrent_weights,
+                                   const GemmWeights<T>& input_weights,
+                                   const GemmWeights<T>& recurrent_weightsZR,
+                                   const GemmWeights<T>& recurrent_weightsH,
                                    gsl::span<T>& outputs,
                                    gsl::span<T>& final_hidden_state) {
   using span_T_const_iter = typename gsl::span<T>::const_iterator;
@@ -496,11 +600,12 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
   }
 
   DumpMatrix("Inputs", inputs.data(), seq_length_ * batch_size_, input_size_);
-  DumpMatrix("input_weights", input_weights.data(), 3 * hidden_size_, input_size_);
-  DumpMatrix("recurrent_weights", recurrent_weights.data(), 3 * hidden_size_, hidden_size_);
-
-  gsl::span<const T> recurrent_weightsZR = recurrent_weights.subspan(0, 2 * hidden_size_ * hidden_size_);
-  gsl::span<const T> recurrent_weightsH = recurrent_weights.subspan(2 * hidden_size_ * hidden_size_, hidden_size_ * hidden_size_);
+  if (!input_weights.is_prepacked_) {
+    DumpMatrix("input_weights", static_cast<const T*>(input_weights.buffer_), 3 * hidden_size_, input_size_);
+  }
+  if (!recurrent_weightsZR.is_prepacked_) {
+    DumpMatrix("recurrent_weights", static_cast<const T*>(recurrent_weightsZR.buffer_), 3 * hidden_size_, hidden_size_);
+  }
 
   gsl::span<T> original_outputs = outputs;
   const bool output_sequence = !outputs.empty();
@@ -529,12 +634,10 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
 
   // apply weights to all the inputs
   ComputeGemm(total_rows, hidden_size_x3, input_size_, alpha,
-              inputs.cbegin(), inputs.cend(),
-              input_size_,
-              input_weights.cbegin(), input_weights.cend(),
-              input_size_, 0.f,
-              outputZRH_.begin(), outputZRH_.end(),
-              hidden_size_x3, ttp_);
+              inputs.data(), inputs.data() + inputs.size(),
+              input_weights, 0.f,
+              outputZRH_.data(), outputZRH_.data() + outputZRH_.size(),
+              hidden_size_x3, allocator_, ttp_);
 
   DumpMatrix("inputs with weights applied", outputZRH_.data(), seq_length_ * batch_size_ * 3, hidden_size_);
 
@@ -598,13 +701,14 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
 
       // calculate Ht-1*R[zr], and add to the weighted inputs that are in outputZRH_
       // Ht-1 * R[zr] + Xt*(W[zr]^T)
+      const T* prev_Ht_data = &*prev_Ht;
+      const T* prev_Ht_data_end = prev_Ht_data + (prev_Ht_end - prev_Ht);
       ComputeGemm(batch_size_, hidden_size_x2, hidden_size_, alpha,
-                  prev_Ht, prev_Ht_end,
-                  hidden_size_,
-                  recurrent_weightsZR.cbegin(), recurrent_weightsZR.cend(),
-                  hidden_size_, 1.f,  // beta == 1 so we add existing values in outputZRH_
-                  outputZRH_.begin() + out_added_offset, outputZRH_.end(),
-                  hidden_size_x3, ttp_);
+                  prev_Ht_data, prev_Ht_data_end,
+                  recurrent_weightsZR,
+                  1.f,  // beta == 1 so we add existing values in outputZRH_
+                  outputZRH_.data() + out_added_offset, outputZRH_.data() + outputZRH_.size(),
+                  hidden_size_x3, allocator_, ttp_);
 
       DumpMatrix("Ht-1 * R[zr] + Xt*(W[zr]^T)" + seqno_str,
                  outputZRH_.data() + out_added_offset, batch_size_, hidden_size_x2, 0, hidden_size_x3);
@@ -619,14 +723,12 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
 
         // compute Ht-1 * (Rh^T) + Rbh
         ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
-                    prev_Ht, prev_Ht_end,  // Ht-1
-                    hidden_size_,
-                    recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                    hidden_size_,
-                    use_bias_ ? 1.f : 0.f,  // don't add values in linear_output_ if no bias input
-                    linear_output_.begin(),
-                    linear_output_.end(),  // pre: Rbh if use_bias_, post:output
-                    hidden_size_, ttp_);
+                    prev_Ht_data, prev_Ht_data_end,  // Ht-1
+                    recurrent_weightsH,        // Rh^T
+                    use_bias_ ? 1.f : 0.f,     // don't add values in linear_output_ if no bias input
+                    linear_output_.data(),
+                    linear_output_.data() + linear_output_.size(),  // pre: Rbh if use_bias_, post:output
+                    hidden_size_, allocator_, ttp_);
 
         DumpMatrix("Ht-1 * (Rh^T) + Rbh " + seqno_str, linear_output_.data(), batch_size_, hidden_size_);
       }
@@ -692,12 +794,11 @@ void UniDirectionalGru<T>::Compute(const gsl::span<const T>& inputs_arg,
 
         // Calculate Xt*(Wh^T) + rt (.) Ht-1 * Rh
         ComputeGemm(batch_size_, hidden_size_, hidden_size_, alpha,
-                    cur_h_local, cur_h_local_end,  // rt (.) Ht-1
-                    hidden_size_,
-                    recurrent_weightsH.cbegin(), recurrent_weightsH.cend(),  // Rh^T
-                    hidden_size_, 1.f,                                       // beta == 1 to add Xt*(Wh^T) from out_H
-                    out_H, outputZRH_.end(),
-                    hidden_size_x3, ttp_);
+                    cur_h_.data(), cur_h_.data() + cur_h_.size(),  // rt (.) Ht-1
+                    recurrent_weightsH,                            // Rh^T
+                    1.f,                                           // beta == 1 to add Xt*(Wh^T) from out_H
+                    &*out_H, outputZRH_.data() + outputZRH_.size(),
+                    hidden_size_x3, allocator_, ttp_);
       }
 
       DumpMatrix("Xt*(Wh^T) + (" + label + ")" + seqno_str, outputZRH_.data() + out_added_offset,
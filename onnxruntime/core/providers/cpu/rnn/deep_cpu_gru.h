@@ -51,11 +51,22 @@ class DeepCpuGruOp final : public OpKernel {
                                                      activation_func_betas);
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
   ~DeepCpuGruOp() override = default;
 
  private:
+  // pack rows [row_offset, row_offset + num_rows) of the weights for each direction
+  Status TryPackWeights(const Tensor& weights, size_t row_offset, size_t num_rows,
+                        rnn::detail::PackedWeights& packed_weights, bool& is_packed, AllocatorPtr alloc);
+
   rnn::detail::Direction direction_;
   int num_directions_;
 
@@ -65,6 +76,11 @@ class DeepCpuGruOp final : public OpKernel {
 
   rnn::detail::ActivationFuncs activation_funcs_;
 
+  // W is used as a whole. R is split into R[zr] and Rh as they are applied in separate GEMMs.
+  rnn::detail::PackedWeights packed_W_;
+  rnn::detail::PackedWeights packed_R_zr_;
+  rnn::detail::PackedWeights packed_R_h_;
+
   template <typename T>
   Status ComputeImpl(OpKernelContext& context) const;
 };
@@ -167,7 +167,8 @@ using namespace rnn::detail;
 
 // LSTM details
 
-Status DeepCpuLstmOp::TryPackWeights(const Tensor& weights, PackedWeights& packed_weights, bool& is_packed) {
+Status DeepCpuLstmOp::TryPackWeights(const Tensor& weights, PackedWeights& packed_weights, bool& is_packed,
+                                     AllocatorPtr alloc) {
   const auto& shape = weights.Shape();
   if (shape.NumDimensions() != 3) {
     return Status::OK();
@@ -187,7 +188,6 @@ Status DeepCpuLstmOp::TryPackWeights(const Tensor& weights, PackedWeights& packe
     return Status::OK();
   }
 
-  auto alloc = Info().GetAllocator(0, OrtMemTypeDefault);
   auto* packed_weights_data = alloc->Alloc(SafeInt<size_t>(packed_weights_size) * num_directions_);
   packed_weights.buffer_ = BufferUniquePtr(packed_weights_data, BufferDeleter(alloc));
   packed_weights.weights_size_ = packed_weights_size;
@@ -204,15 +204,41 @@ Status DeepCpuLstmOp::TryPackWeights(const Tensor& weights, PackedWeights& packe
   return Status::OK();
 }
 
-Status DeepCpuLstmOp::PrePack(const Tensor& tensor, int input_idx, bool& is_packed) {
+Status DeepCpuLstmOp::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                              /*out*/ PrePackedWeights* prepacked_weights) {
   is_packed = false;
 
   if (tensor.IsDataType<float>()) {
+    PackedWeights* packed_weights = nullptr;
     if (input_idx == 1) {
-      return TryPackWeights(tensor, packed_W_, is_packed);
+      packed_weights = &packed_W_;
     } else if (input_idx == 2) {
-      return TryPackWeights(tensor, packed_R_, is_packed);
+      packed_weights = &packed_R_;
     }
+
+    if (packed_weights != nullptr) {
+      ORT_RETURN_IF_ERROR(TryPackWeights(tensor, *packed_weights, is_packed, alloc));
+      if (is_packed && prepacked_weights != nullptr) {
+        prepacked_weights->buffers_.push_back(std::move(packed_weights->buffer_));
+        prepacked_weights->buffer_sizes_.push_back(packed_weights->weights_size_ * num_directions_);
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+Status DeepCpuLstmOp::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                int input_idx,
+                                                /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == 1) {
+    used_shared_buffers = true;
+    packed_W_.buffer_ = std::move(prepacked_buffers[0]);
+  } else if (input_idx == 2) {
+    used_shared_buffers = true;
+    packed_R_.buffer_ = std::move(prepacked_buffers[0]);
   }
 
   return Status::OK();
@@ -364,6 +364,11 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs_arg,
     double cost = max_sequence_length * (gemm_cost + num_seq_to_compute);
     ExecuteLambdaInParallel(sequences_calculator, batch_size_, num_seq_to_compute, cost, thread_pool_);
   } else {
+    // Enter a parallel section encompassing the per-step GEMMs so the
+    // runtime system can amortize loop entry/exit costs over the
+    // sequence. With a small batch each step is a short GEMV-like
+    // kernel and the dispatch cost would otherwise be paid every step.
+    concurrency::ThreadPool::ParallelSection ps(thread_pool_);
     sequences_calculator(0, thread_pool_);
   }
 
@@ -13,8 +13,9 @@ using namespace onnxruntime::common;
 
 namespace onnxruntime {
 
-// TODO: The current implementation of sequence ops relies on tensor copies. Ideally we should try to avoid
-// these copies. This has been postponed due to lack of time.
+// The tensors of a sequence are owned by the sequence, so an output sequence shares the tensors of the input sequence
+// instead of copying them. A tensor input is copied when it's added to a sequence, as its buffer may be reused by the
+// execution frame once the node has run.
 
 // SequenceLength
 ONNX_CPU_OPERATOR_KERNEL(
@@ -182,12 +183,12 @@ ONNX_CPU_OPERATOR_KERNEL(
                                  DataTypeImpl::GetTensorType<int64_t>()}),
     SequenceInsert);
 
-Status CreateCopyAndAppendCpuTensor(const Tensor& in_tensor, OpKernelContext* context, std::vector<Tensor>& tensors) {
+Status CreateCopyAndAppendCpuTensor(const Tensor& in_tensor, OpKernelContext* context, TensorSeq& tensors) {
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
   Tensor tmp(in_tensor.DataType(), onnxruntime::TensorShape(in_tensor.Shape()), alloc);
   CopyCpuTensor(&in_tensor, &tmp);
-  tensors.push_back(std::move(tmp));
+  tensors.Add(std::move(tmp));
   return Status::OK();
 }
 
@@ -222,23 +223,19 @@ Status SequenceInsert::Compute(OpKernelContext* context) const {
 
   auto* Y = context->Output<TensorSeq>(0);
   ORT_ENFORCE(Y != nullptr, "SequenceInsert: Got nullptr for output sequence");
-  std::vector<Tensor> tensors;
-  tensors.reserve(num_tensors_input_seq + 1);
-  for (int i = 0; i < num_tensors_input_seq; ++i) {
+  Y->SetType(S->DataType());
+  Y->Reserve(static_cast<size_t>(num_tensors_input_seq) + 1);
+  for (int64_t i = 0; i < num_tensors_input_seq; ++i) {
     if (i == input_seq_idx) {
-      CreateCopyAndAppendCpuTensor(*X, context, tensors);
-      CreateCopyAndAppendCpuTensor(S->Get(i), context, tensors);
-    } else {
-      CreateCopyAndAppendCpuTensor(S->Get(i), context, tensors);
+      ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(*X, context, *Y));
     }
+    Y->Add(S->GetAt(i));
   }
   if (input_seq_idx == num_tensors_input_seq + 1) {
-    CreateCopyAndAppendCpuTensor(*X, context, tensors);
+    // append, which only copies the new tensor
+    ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(*X, context, *Y));
   }
 
-  Y->SetType(S->DataType());
-  Y->SetElements(std::move(tensors));
-
   return Status::OK();
 }
 
@@ -275,15 +272,13 @@ Status SequenceErase::Compute(OpKernelContext* context) const {
   auto* Y = context->Output<TensorSeq>(0);
   ORT_ENFORCE(Y != nullptr, "SequenceErase: Got nullptr for output sequence");
   Y->SetType(S->DataType());
-  std::vector<Tensor> tensors;
-  tensors.reserve(num_tensors_input_seq - 1);
-  for (int i = 0; i < num_tensors_input_seq; ++i) {
+  Y->Reserve(num_tensors_input_seq > 0 ? static_cast<size_t>(num_tensors_input_seq) - 1 : 0);
+  for (int64_t i = 0; i < num_tensors_input_seq; ++i) {
     if (i == input_seq_idx) {
       continue;
     }
-    CreateCopyAndAppendCpuTensor(S->Get(i), context, tensors);
+    Y->Add(S->GetAt(i));
   }
-  Y->SetElements(std::move(tensors));
   return Status::OK();
 }
 
@@ -315,13 +310,11 @@ Status SequenceConstruct::Compute(OpKernelContext* context) const {
 
   // now copy the tensors to the output sequence
   Y->SetType(first_dtype);
-  std::vector<Tensor> tensors;
-  tensors.reserve(num_inputs);
+  Y->Reserve(num_inputs);
   for (int input_idx = 0; input_idx < num_inputs; ++input_idx) {
     const auto* X = context->Input<Tensor>(input_idx);
-    CreateCopyAndAppendCpuTensor(*X, context, tensors);
+    ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(*X, context, *Y));
   }
-  Y->SetElements(std::move(tensors));
   return Status::OK();
 }
 
@@ -499,7 +492,9 @@ Status SplitToSequence::ComputeImpl(OpKernelContext& context, const Tensor& inpu
   // copy dimensions so we can update the selected axis in place
   auto& input_dims = input_shape.GetDims();
   std::vector<int64_t> output_dimensions{input_dims};
-  std::vector<Tensor> tensors;
+  auto& tseq = *context.Output<TensorSeq>(0);
+  tseq.SetType(input.DataType());
+  tseq.Reserve(static_cast<size_t>(num_outputs));
   int64_t input_offset = 0;
   const T* input_data = input.template Data<T>();
   for (int i = 0; i < num_outputs; ++i) {
@@ -543,13 +538,9 @@ Status SplitToSequence::ComputeImpl(OpKernelContext& context, const Tensor& inpu
     }
 
     // finally move the resulting tensor to the output sequence
-    tensors.push_back(std::move(output_tensor));
+    tseq.Add(std::move(output_tensor));
   }
 
-  auto& tseq = *context.Output<TensorSeq>(0);
-  tseq.SetType(input.DataType());
-  tseq.SetElements(std::move(tensors));
-
   return Status::OK();
 }
 }  // namespace onnxruntime
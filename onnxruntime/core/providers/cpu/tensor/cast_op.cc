@@ -1,7 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 
@@ -16,13 +18,9 @@
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/op_kernel_type_control.h"
-#include "core/util/math_cpuonly.h"
-
-#include "Eigen/src/Core/arch/Default/Half.h"
-
-#if defined(_M_AMD64)
 #include "core/mlas/inc/mlas.h"
-#endif
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
 
 using namespace ONNX_NAMESPACE;
 using namespace boost::mp11;
@@ -116,17 +114,12 @@ CastFromString(const std::string& input, DstType& output) {
   output = gsl::narrow_cast<DstType>(std::stoll(input));
 }
 
-// generic scalar X -> Y
 template <typename SrcType, typename DstType>
-struct ScalarDirectCaster {
-  void Cast(const SrcType& in, DstType& out) const {
-    out = static_cast<DstType>(in);
-  }
-};
+struct ScalarStringCaster;
 
 // scalar X -> string
 template <typename SrcType>
-struct ScalarDirectCaster<SrcType, std::string> {
+struct ScalarStringCaster<SrcType, std::string> {
   void Cast(const SrcType& in, std::string& out) const {
     CastToString<SrcType>(in, out);
   }
@@ -134,98 +127,102 @@ struct ScalarDirectCaster<SrcType, std::string> {
 
 // scalar string -> X
 template <typename DstType>
-struct ScalarDirectCaster<std::string, DstType> {
+struct ScalarStringCaster<std::string, DstType> {
   void Cast(const std::string& in, DstType& out) const {
     CastFromString<DstType>(in, out);
   }
 };
 
-// helper for indirect cast types
-template <typename SrcType, typename DstType, typename IntermediateType>
-struct ScalarIndirectCaster {
-  void Cast(const SrcType& in, DstType& out) const {
-    IntermediateType intermediate;
-    ScalarDirectCaster<SrcType, IntermediateType>{}.Cast(in, intermediate);
-    ScalarDirectCaster<IntermediateType, DstType>{}.Cast(intermediate, out);
-  }
-};
+template <typename SrcType, typename DstType>
+using IsStringCast = mp_or<std::is_same<SrcType, std::string>, std::is_same<DstType, std::string>>;
 
+// casts count contiguous elements. the casts are called on ranges of the tensor in parallel.
 template <typename SrcType, typename DstType, class Enable = void>
-struct ScalarCaster;
+struct SpanCaster;
 
+// numeric X -> Y, which Eigen vectorizes
 template <typename SrcType, typename DstType>
-struct ScalarCaster<
+struct SpanCaster<
     SrcType, DstType,
-    typename std::enable_if<AreAllDirectCastTypes<SrcType, DstType>::value>::type> {
-  void Cast(const SrcType& in, DstType& out) const {
-    ScalarDirectCaster<SrcType, DstType>{}.Cast(in, out);
+    typename std::enable_if<AreAllDirectCastTypes<SrcType, DstType>::value &&
+                            !IsStringCast<SrcType, DstType>::value>::type> {
+  void Cast(const SrcType* in, DstType* out, std::ptrdiff_t count) const {
+    const auto in_vector = ConstEigenVectorMap<SrcType>(in, count);
+    auto out_vector = EigenVectorMap<DstType>(out, count);
+    out_vector = in_vector.template cast<DstType>();
   }
 };
 
+// X -> string and string -> X
 template <typename SrcType, typename DstType>
-struct ScalarCaster<
+struct SpanCaster<
     SrcType, DstType,
-    typename std::enable_if<!AreAllDirectCastTypes<SrcType, DstType>::value>::type> {
-  void Cast(const SrcType& in, DstType& out) const {
-    ScalarIndirectCaster<SrcType, DstType, float>{}.Cast(in, out);
+    typename std::enable_if<AreAllDirectCastTypes<SrcType, DstType>::value &&
+                            IsStringCast<SrcType, DstType>::value>::type> {
+  void Cast(const SrcType* in, DstType* out, std::ptrdiff_t count) const {
+    for (std::ptrdiff_t i = 0; i < count; ++i) {
+      ScalarStringCaster<SrcType, DstType>{}.Cast(in[i], out[i]);
+    }
   }
 };
 
-// generic tensor X -> Y
+// X -> Y where X or Y is an indirect cast type, converting blocks through float in a local buffer
 template <typename SrcType, typename DstType>
-struct TensorCaster {
-  void Cast(const Tensor& in, Tensor& out, const TensorShape& shape) const {
-    const std::ptrdiff_t shape_size = gsl::narrow<std::ptrdiff_t>(shape.Size());
-    const auto in_vector = ConstEigenVectorMap<SrcType>(in.Data<SrcType>(), shape_size);
-    auto out_vector = EigenVectorMap<DstType>(out.MutableData<DstType>(), shape_size);
-    out_vector = in_vector.unaryExpr([](const SrcType& in_scalar) {
-      DstType out_scalar;
-      ScalarCaster<SrcType, DstType>{}.Cast(in_scalar, out_scalar);
-      return out_scalar;
-    });
+struct SpanCaster<
+    SrcType, DstType,
+    typename std::enable_if<!AreAllDirectCastTypes<SrcType, DstType>::value>::type> {
+  void Cast(const SrcType* in, DstType* out, std::ptrdiff_t count) const {
+    constexpr std::ptrdiff_t kBlockSize = 256;
+    float intermediate[kBlockSize];
+    for (std::ptrdiff_t i = 0; i < count; i += kBlockSize) {
+      const std::ptrdiff_t block_size = std::min(count - i, kBlockSize);
+      SpanCaster<SrcType, float>{}.Cast(in + i, intermediate, block_size);
+      SpanCaster<float, DstType>{}.Cast(intermediate, out + i, block_size);
+    }
   }
 };
 
-template <typename SrcType, typename DstType>
-void CastStringTensor(const Tensor& in, Tensor& out, const TensorShape& shape) {
-  static_assert(std::is_same<SrcType, std::string>::value || std::is_same<DstType, std::string>::value,
-                "Either SrcType or DstType must be std::string.");
-  const std::ptrdiff_t shape_size = gsl::narrow<std::ptrdiff_t>(shape.Size());
-  const auto in_data = in.DataAsSpan<SrcType>();
-  const auto out_data = out.MutableDataAsSpan<DstType>();
-  for (std::ptrdiff_t i = 0; i < shape_size; ++i) {
-    ScalarCaster<SrcType, DstType>{}.Cast(in_data[i], out_data[i]);
+// MLFloat16 -> float
+template <>
+struct SpanCaster<MLFloat16, float> {
+  void Cast(const MLFloat16* in, float* out, std::ptrdiff_t count) const {
+    MlasConvertHalfToFloatBuffer(&in[0].val, out, static_cast<size_t>(count));
   }
-}
+};
 
-// tensor X -> string
-template <typename SrcType>
-struct TensorCaster<SrcType, std::string> {
-  void Cast(const Tensor& in, Tensor& out, const TensorShape& shape) const {
-    CastStringTensor<SrcType, std::string>(in, out, shape);
+// float -> MLFloat16, rounding to nearest even
+template <>
+struct SpanCaster<float, MLFloat16> {
+  void Cast(const float* in, MLFloat16* out, std::ptrdiff_t count) const {
+    MlasConvertFloatToHalfBuffer(in, &out[0].val, static_cast<size_t>(count));
   }
 };
 
-// tensor string -> X
-template <typename DstType>
-struct TensorCaster<std::string, DstType> {
-  void Cast(const Tensor& in, Tensor& out, const TensorShape& shape) const {
-    CastStringTensor<std::string, DstType>(in, out, shape);
+// BFloat16 holds the upper 16 bits of a float. these loops match BFloat16::ToFloat and BFloat16(float), which
+// truncates, and are simple enough for the compiler to vectorize.
+
+// BFloat16 -> float
+template <>
+struct SpanCaster<BFloat16, float> {
+  void Cast(const BFloat16* in, float* out, std::ptrdiff_t count) const {
+    for (std::ptrdiff_t i = 0; i < count; ++i) {
+      const uint32_t bits = static_cast<uint32_t>(in[i].val) << 16;
+      std::memcpy(&out[i], &bits, sizeof(bits));
+    }
   }
 };
 
-#if defined(_M_AMD64)
-// tensor MLFloat16 -> float
+// float -> BFloat16
 template <>
-struct TensorCaster<MLFloat16, float> {
-  void Cast(const Tensor& in, Tensor& out, const TensorShape& shape) const {
-    auto out_data = out.MutableData<float>();
-    auto in_data = in.Data<MLFloat16>();
-    const size_t shape_size = gsl::narrow<size_t>(shape.Size());
-    MlasConvertHalfToFloatBuffer(&in_data[0].val, out_data, shape_size);
+struct SpanCaster<float, BFloat16> {
+  void Cast(const float* in, BFloat16* out, std::ptrdiff_t count) const {
+    for (std::ptrdiff_t i = 0; i < count; ++i) {
+      uint32_t bits;
+      std::memcpy(&bits, &in[i], sizeof(bits));
+      out[i].val = static_cast<uint16_t>(bits >> 16);
+    }
   }
 };
-#endif
 
 class Cast final : public OpKernel {
  public:
@@ -244,17 +241,29 @@ class Cast final : public OpKernel {
 
 template <typename TSrc, typename TDst>
 struct Dispatcher {
-  void operator()(const Tensor& src, Tensor& dst, const TensorShape& shape) {
-    TensorCaster<TSrc, TDst>{}.Cast(src, dst, shape);
+  void operator()(const Tensor& src, Tensor& dst, const TensorShape& shape, concurrency::ThreadPool* thread_pool) {
+    const TSrc* in_data = src.Data<TSrc>();
+    TDst* out_data = dst.MutableData<TDst>();
+    const std::ptrdiff_t shape_size = gsl::narrow<std::ptrdiff_t>(shape.Size());
+
+    // formatting or parsing a string costs far more than a numeric cast
+    const double cost_per_element = IsStringCast<TSrc, TDst>::value ? 256.0 : 1.0;
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, shape_size,
+        TensorOpCost{static_cast<double>(sizeof(TSrc)), static_cast<double>(sizeof(TDst)), cost_per_element},
+        [in_data, out_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+          SpanCaster<TSrc, TDst>{}.Cast(in_data + first, out_data + first, last - first);
+        });
   }
 };
 
 template <typename TSrc>
 struct SrcDispatcher {
-  void operator()(int32_t to, const Tensor& src, Tensor& dst, const TensorShape& shape) {
+  void operator()(int32_t to, const Tensor& src, Tensor& dst, const TensorShape& shape,
+                  concurrency::ThreadPool* thread_pool) {
     using DstTypes = mp_remove_if_q<EnabledDstTypes, mp_bind_front<std::is_same, TSrc>>;
     utils::MLTypeCallDispatcherFromTypeList<DstTypes> dispatcher{to};
-    dispatcher.template InvokeWithLeadingTemplateArgs<Dispatcher, TypeList<TSrc>>(src, dst, shape);
+    dispatcher.template InvokeWithLeadingTemplateArgs<Dispatcher, TypeList<TSrc>>(src, dst, shape, thread_pool);
   }
 };
 
@@ -276,7 +285,7 @@ Status Cast::Compute(OpKernelContext* context) const {
   }
 
   utils::MLTypeCallDispatcherFromTypeList<EnabledSrcTypes> dispatcher{from};
-  dispatcher.Invoke<SrcDispatcher>(to_, *X, *Y, shape);
+  dispatcher.Invoke<SrcDispatcher>(to_, *X, *Y, shape, context->GetOperatorThreadPool());
 
   return Status::OK();
 }
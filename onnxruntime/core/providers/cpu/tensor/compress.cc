@@ -2,7 +2,11 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/compress.h"
+
+#include <algorithm>
+
 #include "core/providers/common.h"
+#include "core/providers/cpu/parallel_scan.h"
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
@@ -38,17 +42,20 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto condition_length = condition->Shape().Size();
   auto condition_data = condition->template Data<bool>();
 
-  int64_t positive_condition_count = 0;
   // if has axis, we need to compress on dimension[axis], otherwise compress on the flattened input data
   int64_t compress_input_length = has_axis_ ? input_dimensions[axis] : input_tensor->Shape().Size();
   int64_t valid_condition_length = compress_input_length < condition_length ? compress_input_length : condition_length;
 
-  // Figure out output shape
-  for (int i = 0; i < valid_condition_length; ++i) {
-    if (condition_data[i]) {
-      ++positive_condition_count;
-    }
-  }
+  // Figure out output shape. The positive conditions of each block of the condition are counted in parallel, so each
+  // block can copy its entries from the count of the blocks before it.
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  ParallelScan scan(tp, static_cast<std::ptrdiff_t>(valid_condition_length));
+  std::vector<int64_t> block_offsets;
+  const int64_t positive_condition_count = scan.ExclusiveScan<int64_t>(
+      [condition_data](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        return static_cast<int64_t>(std::count(condition_data + begin, condition_data + end, true));
+      },
+      block_offsets);
 
   std::vector<int64_t> output_dims(input_dimensions);
   if (has_axis_) {
@@ -68,7 +75,6 @@ Status Compress::Compute(OpKernelContext* ctx) const {
   auto* output_data = static_cast<uint8_t*>(output_tensor->MutableDataRaw());
   auto element_bytes = input_tensor->DataType()->Size();
   bool is_string_type = input_tensor->IsDataTypeString();
-  int64_t output_index = 0;
 
   if (has_axis_) {
     int64_t axes_left_stride = 1;
@@ -81,42 +87,59 @@ Status Compress::Compute(OpKernelContext* ctx) const {
       axes_right_stride *= input_dimensions[i];
     }
     int64_t axes_included_right_stride = axes_right_stride * input_dimensions[axis];
-    int64_t axes_included_right_stride_bytes = axes_included_right_stride * element_bytes;
     ORT_ENFORCE(axes_right_stride >= 0 &&
                 static_cast<uint64_t>(axes_right_stride) < std::numeric_limits<size_t>::max());
     size_t axes_right_stride_bytes = 0;
     if (!IAllocator::CalcMemSizeForArray(static_cast<size_t>(axes_right_stride), element_bytes,
                                          &axes_right_stride_bytes))
       return Status(ONNXRUNTIME, FAIL, "size overflow");
-    for (int i = 0; i < axes_left_stride; ++i) {
-      for (int j = 0; j < valid_condition_length; ++j) {
-        if (!condition_data[j]) {
+
+    // the entries of the axis that are kept
+    std::vector<int64_t> kept_entries;
+    kept_entries.reserve(static_cast<size_t>(positive_condition_count));
+    for (int64_t j = 0; j < valid_condition_length; ++j) {
+      if (condition_data[j]) {
+        kept_entries.push_back(j);
+      }
+    }
+
+    // each unit of work copies the slice of one kept entry of the axis for one index of the dimensions before it
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(axes_left_stride * positive_condition_count),
+        TensorOpCost{static_cast<double>(axes_right_stride_bytes), static_cast<double>(axes_right_stride_bytes),
+                     static_cast<double>(axes_right_stride)},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t work = first; work < last; ++work) {
+            const int64_t i = work / positive_condition_count;
+            const int64_t j = kept_entries[work % positive_condition_count];
+            const int64_t input_offset = i * axes_included_right_stride + j * axes_right_stride;
+            const int64_t output_offset = work * axes_right_stride;
+            if (is_string_type) {
+              const auto* input_strings = reinterpret_cast<const std::string*>(input_data) + input_offset;
+              std::copy(input_strings, input_strings + axes_right_stride,
+                        reinterpret_cast<std::string*>(output_data) + output_offset);
+            } else {
+              memcpy(output_data + output_offset * element_bytes, input_data + input_offset * element_bytes,
+                     axes_right_stride_bytes);
+            }
+          }
+        });
+  } else {
+    scan.ForEachBlock([&](std::ptrdiff_t block, std::ptrdiff_t begin, std::ptrdiff_t end) {
+      int64_t output_index = block_offsets[block];
+      for (std::ptrdiff_t i = begin; i < end; ++i) {
+        if (!condition_data[i]) {
           continue;
         }
         if (is_string_type) {
-          for (int idxItem = 0; idxItem < axes_right_stride; ++idxItem) {
-            reinterpret_cast<std::string*>(output_data)[output_index + idxItem] =
-                reinterpret_cast<const std::string*>(input_data)[i * axes_included_right_stride + j * axes_right_stride + idxItem];
-          }
-          output_index += axes_right_stride;
+          reinterpret_cast<std::string*>(output_data)[output_index] =
+              reinterpret_cast<const std::string*>(input_data)[i];
         } else {
-          memcpy(output_data + output_index, input_data + i * axes_included_right_stride_bytes + j * axes_right_stride_bytes, axes_right_stride_bytes);
-          output_index += axes_right_stride_bytes;
+          memcpy(output_data + output_index * element_bytes, input_data + i * element_bytes, element_bytes);
         }
+        ++output_index;
       }
-    }
-  } else {
-    for (int i = 0; i < valid_condition_length; ++i) {
-      if (!condition_data[i]) {
-        continue;
-      }
-      if (is_string_type) {
-        reinterpret_cast<std::string*>(output_data)[output_index] = reinterpret_cast<const std::string*>(input_data)[i];
-      } else {
-        memcpy(output_data + output_index * element_bytes, input_data + i * element_bytes, element_bytes);
-      }
-      ++output_index;
-    }
+    });
   }
 
   return Status::OK();
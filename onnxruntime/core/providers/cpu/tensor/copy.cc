@@ -0,0 +1,265 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/tensor/copy.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <emmintrin.h>
+#define ORT_STRIDED_COPY_USE_STREAMING_STORES
+#endif
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// The innermost copies are split into blocks of this size so that a few large copies can still run in parallel
+constexpr size_t kCopyBlockBytes = 64 * 1024;
+
+#ifdef ORT_STRIDED_COPY_USE_STREAMING_STORES
+// Outputs of at least this size are unlikely to be read from the last level cache by the next kernel,
+// so they are written with non-temporal stores
+constexpr size_t kStreamingCopyThreshold = 8 * 1024 * 1024;
+
+// Runs shorter than this are written with regular stores, as the partially written cache lines at their ends
+// would make streaming stores slower
+constexpr size_t kMinStreamingRunBytes = 256;
+
+// Copies with non-temporal stores. _mm_sfence must be called before another thread reads dst.
+void StreamingCopy(uint8_t* dst, const uint8_t* src, size_t size) {
+  const size_t head = std::min(size, (16 - (reinterpret_cast<uintptr_t>(dst) & 15)) & 15);
+  std::memcpy(dst, src, head);
+  dst += head;
+  src += head;
+  size -= head;
+
+  for (; size >= 64; size -= 64, dst += 64, src += 64) {
+    const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+    const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+    const __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 48));
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst), v0);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 16), v1);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 32), v2);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst + 48), v3);
+  }
+  for (; size >= 16; size -= 16, dst += 16, src += 16) {
+    _mm_stream_si128(reinterpret_cast<__m128i*>(dst), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+  }
+  std::memcpy(dst, src, size);
+}
+#endif
+
+struct CopyDim {
+  int64_t size;
+  int64_t dst_stride;
+  int64_t src_stride;
+};
+
+// Drops the dims of size 1 and merges the dims that are contiguous in both views, with the innermost dim last.
+// Returns false if there is nothing to copy.
+bool CoalesceDims(const std::vector<int64_t>& dst_strides, const std::vector<int64_t>& src_strides,
+                  const std::vector<int64_t>& dims, std::vector<CopyDim>& coalesced) {
+  ORT_ENFORCE(dst_strides.size() == dims.size() && src_strides.size() == dims.size(),
+              "StridedCopy: the number of strides must match the number of dims");
+
+  coalesced.clear();
+  coalesced.reserve(dims.size() + 1);
+  for (size_t i = dims.size(); i-- > 0;) {
+    if (dims[i] == 0) {
+      return false;
+    }
+    if (dims[i] == 1) {
+      continue;
+    }
+
+    if (!coalesced.empty()) {
+      auto& inner = coalesced.back();
+      if (dst_strides[i] == inner.size * inner.dst_stride && src_strides[i] == inner.size * inner.src_stride) {
+        inner.size *= dims[i];
+        continue;
+      }
+    }
+    coalesced.push_back({dims[i], dst_strides[i], src_strides[i]});
+  }
+
+  // a single element
+  if (coalesced.empty()) {
+    coalesced.push_back({1, 1, 1});
+  }
+
+  std::reverse(coalesced.begin(), coalesced.end());
+  return true;
+}
+
+// Calls copy_run(dst_offset, src_offset, count) to copy each run of the innermost dim in parallel, followed by
+// end_range() on each thread once its runs are copied. The offsets and count are in elements.
+template <typename CopyRun, typename EndRange>
+void ForEachRun(concurrency::ThreadPool* thread_pool, const std::vector<CopyDim>& dims, size_t element_size,
+                const CopyRun& copy_run, const EndRange& end_range) {
+  const CopyDim& inner = dims.back();
+  const size_t num_outer_dims = dims.size() - 1;
+  int64_t num_outer = 1;
+  for (size_t i = 0; i < num_outer_dims; ++i) {
+    num_outer *= dims[i].size;
+  }
+
+  int64_t run_size = inner.size;
+  if (static_cast<size_t>(inner.size) * element_size > kCopyBlockBytes) {
+    run_size = std::max<int64_t>(1, static_cast<int64_t>(kCopyBlockBytes / element_size));
+  }
+  const int64_t runs_per_inner = (inner.size + run_size - 1) / run_size;
+  const double run_bytes = static_cast<double>(run_size * element_size);
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(num_outer * runs_per_inner),
+      TensorOpCost{run_bytes, run_bytes, 0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // find the offsets of the first run, then step through the outer dims like an odometer
+        std::vector<int64_t> counters(num_outer_dims);
+        int64_t outer_index = first / runs_per_inner;
+        int64_t run_index = first % runs_per_inner;
+        int64_t dst_offset = 0;
+        int64_t src_offset = 0;
+        for (size_t i = num_outer_dims; i-- > 0;) {
+          counters[i] = outer_index % dims[i].size;
+          outer_index /= dims[i].size;
+          dst_offset += counters[i] * dims[i].dst_stride;
+          src_offset += counters[i] * dims[i].src_stride;
+        }
+
+        for (std::ptrdiff_t run = first; run < last; ++run) {
+          const int64_t begin = run_index * run_size;
+          copy_run(dst_offset + begin * inner.dst_stride, src_offset + begin * inner.src_stride,
+                   std::min(run_size, inner.size - begin));
+
+          if (++run_index < runs_per_inner) {
+            continue;
+          }
+
+          run_index = 0;
+          for (size_t i = num_outer_dims; i-- > 0;) {
+            dst_offset += dims[i].dst_stride;
+            src_offset += dims[i].src_stride;
+            if (++counters[i] < dims[i].size) {
+              break;
+            }
+            dst_offset -= dims[i].size * dims[i].dst_stride;
+            src_offset -= dims[i].size * dims[i].src_stride;
+            counters[i] = 0;
+          }
+        }
+
+        end_range();
+      });
+}
+
+// Copies elements of ElementSize bytes. memcpy with a constant size compiles to a single load and store.
+template <size_t ElementSize>
+void CopyElements(uint8_t* dst, int64_t dst_stride, const uint8_t* src, int64_t src_stride, int64_t count) {
+  for (int64_t i = 0; i < count; ++i) {
+    std::memcpy(dst + i * dst_stride * ElementSize, src + i * src_stride * ElementSize, ElementSize);
+  }
+}
+
+void CopyElements(uint8_t* dst, int64_t dst_stride, const uint8_t* src, int64_t src_stride, int64_t count,
+                  size_t element_size) {
+  switch (element_size) {
+    case 1:
+      CopyElements<1>(dst, dst_stride, src, src_stride, count);
+      break;
+    case 2:
+      CopyElements<2>(dst, dst_stride, src, src_stride, count);
+      break;
+    case 4:
+      CopyElements<4>(dst, dst_stride, src, src_stride, count);
+      break;
+    case 8:
+      CopyElements<8>(dst, dst_stride, src, src_stride, count);
+      break;
+    default:
+      for (int64_t i = 0; i < count; ++i) {
+        std::memcpy(dst + i * dst_stride * element_size, src + i * src_stride * element_size, element_size);
+      }
+      break;
+  }
+}
+
+}  // namespace
+
+void StridedCopy(concurrency::ThreadPool* thread_pool,
+                 void* dst, const std::vector<int64_t>& dst_strides,
+                 const void* src, const std::vector<int64_t>& src_strides,
+                 const std::vector<int64_t>& dims, size_t element_size) {
+  std::vector<CopyDim> coalesced;
+  if (!CoalesceDims(dst_strides, src_strides, dims, coalesced)) {
+    return;
+  }
+
+  auto* dst_bytes = static_cast<uint8_t*>(dst);
+  const auto* src_bytes = static_cast<const uint8_t*>(src);
+  const CopyDim inner = coalesced.back();
+
+  if (inner.dst_stride != 1 || inner.src_stride != 1) {
+    ForEachRun(
+        thread_pool, coalesced, element_size,
+        [&](int64_t dst_offset, int64_t src_offset, int64_t count) {
+          CopyElements(dst_bytes + dst_offset * element_size, inner.dst_stride,
+                       src_bytes + src_offset * element_size, inner.src_stride, count, element_size);
+        },
+        []() {});
+    return;
+  }
+
+#ifdef ORT_STRIDED_COPY_USE_STREAMING_STORES
+  size_t total_bytes = element_size;
+  for (const auto& dim : coalesced) {
+    total_bytes *= static_cast<size_t>(dim.size);
+  }
+
+  if (total_bytes >= kStreamingCopyThreshold && static_cast<size_t>(inner.size) * element_size >= kMinStreamingRunBytes) {
+    ForEachRun(
+        thread_pool, coalesced, element_size,
+        [&](int64_t dst_offset, int64_t src_offset, int64_t count) {
+          StreamingCopy(dst_bytes + dst_offset * element_size, src_bytes + src_offset * element_size,
+                        count * element_size);
+        },
+        []() { _mm_sfence(); });
+    return;
+  }
+#endif
+
+  ForEachRun(
+      thread_pool, coalesced, element_size,
+      [&](int64_t dst_offset, int64_t src_offset, int64_t count) {
+        std::memcpy(dst_bytes + dst_offset * element_size, src_bytes + src_offset * element_size,
+                    count * element_size);
+      },
+      []() {});
+}
+
+void StridedCopy(concurrency::ThreadPool* thread_pool,
+                 std::string* dst, const std::vector<int64_t>& dst_strides,
+                 const std::string* src, const std::vector<int64_t>& src_strides,
+                 const std::vector<int64_t>& dims) {
+  std::vector<CopyDim> coalesced;
+  if (!CoalesceDims(dst_strides, src_strides, dims, coalesced)) {
+    return;
+  }
+
+  const CopyDim inner = coalesced.back();
+  ForEachRun(
+      thread_pool, coalesced, sizeof(std::string),
+      [&](int64_t dst_offset, int64_t src_offset, int64_t count) {
+        for (int64_t i = 0; i < count; ++i) {
+          dst[dst_offset + i * inner.dst_stride] = src[src_offset + i * inner.src_stride];
+        }
+      },
+      []() {});
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+/**
+Copies a strided view of src to a strided view of dst, i.e. for every index (i_0, ..., i_n-1) within dims
+  dst[i_0 * dst_strides[0] + ... + i_n-1 * dst_strides[n-1]] = src[i_0 * src_strides[0] + ... + i_n-1 * src_strides[n-1]]
+The strides are in elements, and a source stride of 0 repeats the source elements along that dimension.
+The views of dst must not overlap, and dst must not overlap src.
+
+Dimensions that are contiguous in both views are coalesced so that the innermost copies are as large as possible.
+Large copies are partitioned into blocks that run on the thread pool, and outputs larger than the last level cache are
+written with non-temporal stores on x64 so that they don't evict the data being read.
+*/
+void StridedCopy(concurrency::ThreadPool* thread_pool,
+                 void* dst, const std::vector<int64_t>& dst_strides,
+                 const void* src, const std::vector<int64_t>& src_strides,
+                 const std::vector<int64_t>& dims, size_t element_size);
+
+// StridedCopy for string elements, which are assigned rather than copied bytewise.
+void StridedCopy(concurrency::ThreadPool* thread_pool,
+                 std::string* dst, const std::vector<int64_t>& dst_strides,
+                 const std::string* src, const std::vector<int64_t>& src_strides,
+                 const std::vector<int64_t>& dims);
+
+// StridedCopy for elements of type T, which must be trivially copyable unless T is std::string.
+template <typename T>
+void StridedCopy(concurrency::ThreadPool* thread_pool,
+                 T* dst, const std::vector<int64_t>& dst_strides,
+                 const T* src, const std::vector<int64_t>& src_strides,
+                 const std::vector<int64_t>& dims) {
+  StridedCopy(thread_pool, static_cast<void*>(dst), dst_strides, static_cast<const void*>(src), src_strides, dims,
+              sizeof(T));
+}
+
+}  // namespace onnxruntime
@@ -42,7 +42,7 @@ Status DynamicQuantizeLinear<T>::Compute(OpKernelContext* ctx) const {
 
   // find input range min and max
   float min, max;
-  MlasFindMinMaxElement(x_data, &min, &max, num_of_elements);
+  ParFindMinMaxElement(x_data, static_cast<size_t>(num_of_elements), min, max, ctx->GetOperatorThreadPool());
 
   // ensure the input range includes zero
   min = std::min(min, 0.0f);
@@ -60,7 +60,7 @@ Status DynamicQuantizeLinear<T>::Compute(OpKernelContext* ctx) const {
 
   // quantize the data
   auto* output = y.template MutableData<T>();
-  MlasQuantizeLinear(x_data, output, num_of_elements, scale, zero_point);
+  ParQuantizeLinear(x_data, output, static_cast<size_t>(num_of_elements), scale, zero_point, ctx->GetOperatorThreadPool());
 
   return Status::OK();
 }
@@ -2,7 +2,8 @@
 // Licensed under the MIT License.
 
 #include "expand.h"
-#include <cmath>
+#include "core/providers/cpu/tensor/copy.h"
+#include "core/providers/cpu/tensor/utils.h"
 
 namespace onnxruntime {
 
@@ -69,118 +70,27 @@ Status Expand<T>::Compute(OpKernelContext* context) const {
   TensorShape output_tensor_shape(output_shape);
   auto* output_tensor = context->Output(0, output_tensor_shape);
   auto* output_data = output_tensor->template MutableData<T>();
-  auto* output_dims = output_shape.data();
   auto output_dims_size = static_cast<int64_t>(output_shape.size());
-  auto max_dims_size = std::max(input_dims_size, output_dims_size);
 
-  if (0 == max_dims_size) {
+  if (0 == output_dims_size) {
     *output_data = *input_data;
     return Status::OK();
   }
 
-  std::unique_ptr<int64_t[]> input_dim_group{new int64_t[max_dims_size]};
-  std::unique_ptr<int64_t[]> output_dim_group{new int64_t[max_dims_size]};
-  std::unique_ptr<int64_t[]> expand_dim_size{new int64_t[max_dims_size]};
-  auto dim_group_start = max_dims_size;
-
-  for (int64_t input_dims_iter = input_dims_size - 1,
-               output_dims_iter = output_dims_size - 1,
-               last_dim_size = 1,
-               input_count = 1,
-               output_count = 1;
-       output_dims_iter > -1;
+  // The output is a strided copy of the input, which is read again along the broadcast dims by a stride of 0.
+  // The input dims are aligned with the innermost output dims.
+  TensorPitches output_pitches(output_shape);
+  std::vector<int64_t> input_strides(output_dims_size, 0);
+  for (int64_t input_dims_iter = input_dims_size - 1, output_dims_iter = output_dims_size - 1, input_pitch = 1;
+       input_dims_iter > -1;
        input_dims_iter--, output_dims_iter--) {
-    auto input_dim = input_dims_iter > -1 ? input_dims[input_dims_iter] : 1;
-    auto output_dim = output_dims[output_dims_iter];
-
-    input_count *= input_dim;
-    output_count *= output_dim;
-
-    if (0 == input_count || 0 == output_count) {
-      return Status::OK();
-    }
-
-    if (input_dim == 1 && output_dim > 1 || output_dims_iter == 0) {
-      --dim_group_start;
-      input_dim_group[dim_group_start] = input_count;
-      output_dim_group[dim_group_start] = output_count;
-      expand_dim_size[dim_group_start] = output_count / input_count / last_dim_size;
-      last_dim_size *= expand_dim_size[dim_group_start];
+    if (input_dims[input_dims_iter] != 1) {
+      input_strides[output_dims_iter] = input_pitch;
     }
+    input_pitch *= input_dims[input_dims_iter];
   }
 
-  auto distribute_count = input_dim_group[dim_group_start] / input_dim_group[max_dims_size - 1];
-  std::vector<int64_t> output_offsets(distribute_count, 0);
-  int64_t copy_len = input_dim_group[max_dims_size - 1];
-  auto copy_byte = copy_len * sizeof(T);
-
-  auto distribute_fn =
-    [&](ptrdiff_t i_start, ptrdiff_t i_end) {
-    for (auto i = i_start; i < i_end; i++) {
-      auto input_offset = i * copy_len;
-      int64_t output_offset = 0;
-      for (auto j = dim_group_start + 1, remains = input_offset; j < max_dims_size; ++j) {
-        auto current_count = remains / input_dim_group[j];
-        output_offset += current_count * output_dim_group[j];
-        remains = remains % input_dim_group[j];
-      }  //for j
-      memcpy(output_data + output_offset, input_data + input_offset, copy_byte);
-      output_offsets[i] = output_offset;
-    } //for i
-  };  //distribute_fn
-
-  auto per_thread_tasks =
-    distribute_count / concurrency::ThreadPool::DegreeOfParallelism(context->GetOperatorThreadPool());
-
-  if (per_thread_tasks > 4) {
-    concurrency::ThreadPool::TryParallelFor(
-      context->GetOperatorThreadPool(),
-      distribute_count,
-      static_cast<double>(copy_byte),
-      std::move(distribute_fn));
-  } else {
-    distribute_fn(0, distribute_count);
-  }  //else
-
-  for (auto i = max_dims_size - 1; i >= dim_group_start; --i) {
-    auto copy_fn =
-      [&](ptrdiff_t j_start, ptrdiff_t j_end) {
-      for (auto j = j_start; j < j_end; j++) {
-	auto output_offset = output_offsets[j];
-	if (output_offset % output_dim_group[i] == 0) {
-	  auto copy_len = output_dim_group[i] / expand_dim_size[i];
-	  auto copy_byte = copy_len * sizeof(T);
-	  auto output_from = output_data + output_offset;
-	  auto output_at = output_from + copy_len;
-	  auto output_end = output_from + output_dim_group[i];
-	  while (output_at + copy_len <= output_end) {
-	    memcpy(output_at, output_from, copy_byte);
-	    output_at += copy_len;
-	    copy_len <<= 1;
-	    copy_byte <<= 1;
-	  }  //while
-	  while (output_at < output_end) {
-	    if (output_at + copy_len <= output_end) {
-	      memcpy(output_at, output_from, copy_byte);
-	      output_at += copy_len;
-	    } else {
-	      copy_len >>= 1;
-	      copy_byte >>= 1;
-	    }
-	  }  //while
-	}  //if
-      } // for
-    };  //copy_fn
-    if (per_thread_tasks > 20) {
-      concurrency::ThreadPool::TryParallelFor(
-        context->GetOperatorThreadPool(),
-        distribute_count,
-        static_cast<double>(copy_byte),
-        std::move(copy_fn));
-    } else {
-      copy_fn(0, distribute_count);
-    }  //else
-  }  //for
+  StridedCopy(context->GetOperatorThreadPool(), output_data, output_pitches, input_data, input_strides, output_shape);
   return Status::OK();
 }  //Expand::compute
 
@@ -71,42 +71,62 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
                       const TensorShape& input_data_shape, const int64_t axis, concurrency::ThreadPool* tp) {
   const Tin* indices_data = indices_tensor->template Data<Tin>();
 
-  // Check the indices first in case there's a out of bound index.
+  // Check the indices first in case there's a out of bound index. The bounds are
+  // accumulated without branching so that the common case is a single pass over
+  // the indices, and the offending index is only searched for on failure.
   auto axis_dim_limit = input_data_shape[axis];
 
+  bool indices_in_bounds = true;
   for (int64_t i = 0; i < N; ++i) {
     Tin idx = indices_data[i];
-    if (idx < -axis_dim_limit || idx >= axis_dim_limit) {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
-                             "indices element out of data bounds, idx=", idx,
-                             " must be within the inclusive range [", -axis_dim_limit, ",", axis_dim_limit - 1, "]");
-    }
+    indices_in_bounds &= (idx >= -axis_dim_limit) & (idx < axis_dim_limit);
   }
 
-  auto lambda = [&](int64_t index) {
-    int64_t batch = index / N;
-    int64_t i = index % N;
+  if (!indices_in_bounds) {
+    for (int64_t i = 0; i < N; ++i) {
+      Tin idx = indices_data[i];
+      if (idx < -axis_dim_limit || idx >= axis_dim_limit) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "indices element out of data bounds, idx=", idx,
+                               " must be within the inclusive range [", -axis_dim_limit, ",", axis_dim_limit - 1, "]");
+      }
+    }
+  }
 
-    const int64_t src_offset_batch = batch * data_batch_bytes;
-    const int64_t dst_offset_batch = batch * gathered_batch_bytes;
-    Tin idx = indices_data[i];
-    idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
-    const int64_t src_offset = src_offset_batch + idx * block_size;
-    const int64_t dst_offset = dst_offset_batch + i * block_size;
-
-    if (is_string_type) {
-      reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
-          reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
-    } else {
-      memcpy(dst_base + dst_offset, src_base + src_offset, block_size);
+  // Copies the blocks for a contiguous range of output blocks. The batch and index
+  // positions are advanced incrementally rather than recomputed for every block.
+  auto copy_range = [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    int64_t batch = first / N;
+    int64_t i = first % N;
+    const uint8_t* src_batch = src_base + batch * data_batch_bytes;
+    uint8_t* dst = dst_base + batch * gathered_batch_bytes + i * block_size;
+
+    for (std::ptrdiff_t index = first; index < last; ++index) {
+      int64_t idx = static_cast<int64_t>(indices_data[i]);
+      idx = idx < 0 ? idx + axis_dim_limit : idx;
+      const uint8_t* src = src_batch + idx * block_size;
+
+      if (is_string_type) {
+        const auto* src_str = reinterpret_cast<const std::string*>(src);
+        auto* dst_str = reinterpret_cast<std::string*>(dst);
+        std::copy(src_str, src_str + block_size / element_bytes, dst_str);
+      } else {
+        memcpy(dst, src, block_size);
+      }
+
+      dst += block_size;
+      if (++i == N) {
+        i = 0;
+        src_batch += data_batch_bytes;
+      }
     }
   };
-  concurrency::ThreadPool::TryParallelFor(tp, M * N, static_cast<double>(block_size),
-                                          [&lambda](ptrdiff_t first, ptrdiff_t last) {
-                                            for (int index = static_cast<int>(first), end = static_cast<int>(last); index < end; ++index) {
-                                              lambda(index);
-                                            }
-                                          });
+
+  concurrency::ThreadPool::TryParallelFor(tp, M * N,
+                                          TensorOpCost{static_cast<double>(block_size + sizeof(Tin)),
+                                                       static_cast<double>(block_size),
+                                                       static_cast<double>(block_size / element_bytes)},
+                                          copy_range);
 
   return Status::OK();
 }
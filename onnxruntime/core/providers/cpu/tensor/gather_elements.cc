@@ -2,7 +2,6 @@
 // Licensed under the MIT License.
 
 #include "gather_elements.h"
-#include "onnxruntime_config.h"
 
 namespace onnxruntime {
 
@@ -25,8 +24,6 @@ ONNX_CPU_OPERATOR_KERNEL(
                                                         DataTypeImpl::GetTensorType<int64_t>()}),
     GatherElements);
 
-static constexpr int kParallelizationThreshold = 10 * 1000;
-
 // Some helpers needed for GatherElements op -
 
 // The following method computes the offset in the flattened array
@@ -49,83 +46,30 @@ static inline int64_t compute_base_offset(const std::vector<int64_t>& shape, con
   return base_offset;
 }
 
-// This method computes the number of 'inner_dimension' chunks
-// Example: input = [2, 3]     output = 2
-//          input = [3, 2, 4]  output = 3 * 2 = 6
-//          input  = [2]       output = 1
-static int64_t calculate_num_inner_dim(const TensorShape& dims) {
-  // in this context, rank can never be < 1, so saving checking overhead
-  return dims.SizeToDimension(dims.NumDimensions() - 1);
-}
-
-// This method computes increments over an 'inner_dimension'
-// Example 1: current_dims = [0, x] tensor_dims = [3, 1], then current_dims = [1, x]
-//            current_dims = [1, x] tensor_dims = [3, 1], then current_dims = [2, x]
-//            current_dims = [2, x] tensor_dims = [3, 1], then current_dims = [0, x]
-
-// Example 2: current_dims = [0, 0, x] tensor_dims = [1, 2, 2], then current_dims = [0, 1, x]
-//            current_dims = [0, 1, x] tensor_dims = [1, 2, 2], then current_dims = [0, 0, x]
-static inline void increment_over_inner_dim(std::vector<int64_t>& current_dims, const TensorShape& tensor_dims) {
+// This method converts the index of an 'inner_dimension' chunk into the coordinates
+// of the chunk within the indices tensor. The innermost coordinate is always 0.
+// Example: chunk = 4 tensor_dims = [3, 2, 5], then current_dims = [2, 0, 0]
+static inline void compute_inner_dim_coordinates(int64_t chunk, std::vector<int64_t>& current_dims,
+                                                 const TensorShape& tensor_dims) {
   // in this context, rank can never be < 1, so saving checking overhead
   int64_t rank = static_cast<int64_t>(current_dims.size());
 
-  // 'reset' innermost dimension value
   current_dims[rank - 1] = 0;
 
-  // nothing to increment over
-  if (rank == 1) {
-    return;
-  }
-
-  int64_t current_axis = rank - 2;
-
-  while (current_axis >= 0) {
-    if (++current_dims[current_axis] != tensor_dims[current_axis])
-      return;
-
-    current_dims[current_axis] = 0;
-    --current_axis;
-  }
-}
-
-template <typename Tin>
-static inline int64_t GetNegativeIndexAdjustedValue(const Tin* indices_data, Tin index, int64_t axis,
-                                                    const TensorShape& input_shape) {
-  int64_t retval = -1;
-  if (indices_data[index] < 0) {
-    retval = static_cast<int64_t>(indices_data[index] + input_shape[axis]);
-  } else {
-    retval = static_cast<int64_t>(indices_data[index]);
+  for (int64_t current_axis = rank - 2; current_axis >= 0; --current_axis) {
+    current_dims[current_axis] = chunk % tensor_dims[current_axis];
+    chunk /= tensor_dims[current_axis];
   }
-  return retval;
 }
 
-#ifdef __GNUC__
-#pragma GCC diagnostic push
-#ifdef HAS_CLASS_MEMACCESS
-#pragma GCC diagnostic ignored "-Wclass-memaccess"
-#endif
-#endif
-template <bool is_string, typename T, typename Tin>
+// T is the element type used to copy the data. Every fixed size data type is copied
+// through an unsigned integer type of the same size rather than with memcpy, and
+// strings are copied with their assignment operator.
+template <typename T, typename Tin>
 static void core_impl(const Tensor* input_tensor, const Tensor* indices_tensor,
                       Tensor* output_tensor, int64_t axis, concurrency::ThreadPool* ttp) {
-  // get pointer to input data
-  // optimizer will remove the redundant if/else block based on 'is_string' template parameter
-  const T* input_data = nullptr;
-  if (is_string) {
-    input_data = input_tensor->Data<T>();
-  } else {
-    input_data = reinterpret_cast<const T*>(input_tensor->DataRaw());
-  }
-
-  // get pointer to output data
-  // optimizer will remove the redundant if/else block based on 'is_string' template parameter
-  T* output_data = nullptr;
-  if (is_string) {
-    output_data = output_tensor->MutableData<T>();
-  } else {
-    output_data = reinterpret_cast<T*>(output_tensor->MutableDataRaw());
-  }
+  const T* input_data = reinterpret_cast<const T*>(input_tensor->DataRaw());
+  T* output_data = reinterpret_cast<T*>(output_tensor->MutableDataRaw());
 
   const int64_t input_rank = static_cast<int64_t>(input_tensor->Shape().NumDimensions());
   const TensorPitches input_shape_pitches(*input_tensor);
@@ -139,106 +83,85 @@ static void core_impl(const Tensor* input_tensor, const Tensor* indices_tensor,
   int64_t lower_index_limit = -input_shape[axis];
   int64_t upper_index_limit = input_shape[axis] - 1;
 
-  auto validation_fn = [indices_data, lower_index_limit, upper_index_limit](ptrdiff_t i) {
+  bool indices_in_bounds = true;
+  for (int64_t i = 0; i < num_elements; ++i) {
     auto indices_val = indices_data[i];
-    if (indices_val < lower_index_limit || indices_val > upper_index_limit)
-      ORT_THROW("GatherElements op: Value in indices must be within bounds [",
-                lower_index_limit, " , ", upper_index_limit, "]. Actual value is ", indices_val);
-  };
-  for (int64_t i = 0; i < num_elements; ++i) {  // TODO: parallelize this? didn't give any benefit in my tests
-    validation_fn(i);
+    indices_in_bounds &= (indices_val >= lower_index_limit) & (indices_val <= upper_index_limit);
+  }
+  if (!indices_in_bounds) {
+    for (int64_t i = 0; i < num_elements; ++i) {
+      auto indices_val = indices_data[i];
+      if (indices_val < lower_index_limit || indices_val > upper_index_limit)
+        ORT_THROW("GatherElements op: Value in indices must be within bounds [",
+                  lower_index_limit, " , ", upper_index_limit, "]. Actual value is ", indices_val);
+    }
   }
 
-  int64_t num_inner_dim = calculate_num_inner_dim(indices_shape);
-  int64_t inner_dim_size = indices_shape[input_rank - 1];
-  bool processing_inner_dim = (axis == input_rank - 1) ? true : false;
-
-  int64_t base_offset = 0;
-  Tin indices_counter = 0;
-  size_t element_size = input_tensor->DataType()->Size();
-
-  std::vector<int64_t> process_dims(input_rank, 0);
-  int64_t output_counter = 0;
-
-  auto conditional_batch_call = [ttp, inner_dim_size](std::function<void(ptrdiff_t)> f) {
-    if (inner_dim_size < kParallelizationThreshold) {  // TODO: tune this, arbitrary threshold
-      for (int64_t i = 0; i < inner_dim_size; ++i) {
-        f(i);
+  const int64_t inner_dim_size = indices_shape[input_rank - 1];
+  const int64_t axis_dim = input_shape[axis];
+  const int64_t axis_pitch = input_shape_pitches[axis];
+
+  // for the innermost axis the position within the chunk comes only from the 'indices'
+  // value, otherwise the element at position i of the chunk reads from column i
+  const int64_t inner_dim_stride = (axis == input_rank - 1) ? 0 : 1;
+
+  // The output is processed as a flat range of elements so that the work can be split
+  // across threads regardless of how the elements are distributed across the chunks.
+  auto fn = [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    std::vector<int64_t> process_dims(input_rank, 0);
+    int64_t chunk = first / inner_dim_size;
+    int64_t i = first % inner_dim_size;
+
+    while (first < last) {
+      compute_inner_dim_coordinates(chunk, process_dims, indices_shape);
+      const int64_t base_offset = compute_base_offset(process_dims, input_shape_pitches, axis);
+      const int64_t end_i = std::min<int64_t>(inner_dim_size, i + (last - first));
+
+      for (; i < end_i; ++i, ++first) {
+        int64_t index = static_cast<int64_t>(indices_data[first]);
+        index = index < 0 ? index + axis_dim : index;
+        output_data[first] = input_data[base_offset + index * axis_pitch + i * inner_dim_stride];
       }
-    } else {
-      concurrency::ThreadPool::TryBatchParallelFor(ttp, inner_dim_size, f, 0);
+
+      ++chunk;
+      i = 0;
     }
   };
 
-  if (!processing_inner_dim) {
-    while (num_inner_dim-- != 0) {
-      base_offset = compute_base_offset(process_dims, input_shape_pitches, axis);
-
-      // process 1 chunk of 'inner dimension' length
-      // optimizer will remove the redundant if/else block based on 'is_string' template parameter
-      if (is_string) {
-        auto fn = [input_data, output_data, base_offset, input_shape_pitches,
-                   indices_data, indices_counter, axis, input_shape, output_counter](ptrdiff_t i) {
-          output_data[i + output_counter] =
-              input_data[base_offset +
-                         (GetNegativeIndexAdjustedValue<Tin>(indices_data, static_cast<Tin>(i) + indices_counter, axis, input_shape) *
-                          input_shape_pitches[axis]) +
-                         i];
-        };
-        conditional_batch_call(fn);
-        output_counter += inner_dim_size;
-      } else {
-        auto fn = [input_data, output_data, base_offset, input_shape_pitches, element_size,
-                   indices_data, indices_counter, axis, input_shape](ptrdiff_t i) {
-          memcpy(output_data + (i * element_size),
-                 input_data + (base_offset + (GetNegativeIndexAdjustedValue<Tin>(indices_data, static_cast<Tin>(i) + indices_counter, axis, input_shape) * input_shape_pitches[axis]) + i) * element_size,
-                 element_size);
-        };
-        conditional_batch_call(fn);
-        output_data += inner_dim_size * element_size;
-      }
-      indices_counter += static_cast<Tin>(inner_dim_size);
-      increment_over_inner_dim(process_dims, indices_shape);
-    }
+  concurrency::ThreadPool::TryParallelFor(ttp, num_elements,
+                                          TensorOpCost{static_cast<double>(sizeof(T) + sizeof(Tin)),
+                                                       static_cast<double>(sizeof(T)), 2.0},
+                                          fn);
+}
+
+template <typename Tin>
+static Status core_impl_dispatch(const Tensor* input_tensor, const Tensor* indices_tensor,
+                                 Tensor* output_tensor, int64_t axis, concurrency::ThreadPool* ttp) {
+  if (input_tensor->IsDataTypeString()) {
+    core_impl<std::string, Tin>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+    return Status::OK();
   }
-  // we special-case inner dim as we can weed-out some unnecessary computations in element offset calculations
-  else {
-    while (num_inner_dim-- != 0) {
-      base_offset = compute_base_offset(process_dims, input_shape_pitches, axis);
-
-      // process 1 chunk of 'inner dimension' length
-      if (is_string) {
-        auto fn = [input_data, output_data, base_offset,
-                   indices_data, indices_counter, axis, input_shape, output_counter](ptrdiff_t i) {
-          // for innermost axis, input_shape_pitches[axis] = 1 (so no need to multiply)
-          output_data[i + output_counter] =
-              input_data[base_offset +
-                         GetNegativeIndexAdjustedValue<Tin>(indices_data, static_cast<Tin>(i) + indices_counter, axis, input_shape)];
-        };
-        conditional_batch_call(fn);
-        output_counter += inner_dim_size;
-      } else {
-        // for innermost axis, input_shape_pitches[axis] = 1 (so no need to multiply)
-        auto fn = [input_data, output_data, base_offset, element_size,
-                   indices_data, indices_counter, axis, input_shape](ptrdiff_t i) {
-          memcpy(output_data + (i * element_size),
-                 input_data + (base_offset +
-                               GetNegativeIndexAdjustedValue<Tin>(indices_data, static_cast<Tin>(i) + indices_counter, axis, input_shape)) *
-                                  element_size,
-                 element_size);
-        };
-        conditional_batch_call(fn);
-        output_data += inner_dim_size * element_size;
-      }
 
-      indices_counter += static_cast<Tin>(inner_dim_size);
-      increment_over_inner_dim(process_dims, indices_shape);
-    }
+  switch (input_tensor->DataType()->Size()) {
+    case sizeof(uint8_t):
+      core_impl<uint8_t, Tin>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      break;
+    case sizeof(uint16_t):
+      core_impl<uint16_t, Tin>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      break;
+    case sizeof(uint32_t):
+      core_impl<uint32_t, Tin>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      break;
+    case sizeof(uint64_t):
+      core_impl<uint64_t, Tin>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+      break;
+    default:
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                             "GatherElements op: Unsupported element size ", input_tensor->DataType()->Size());
   }
+
+  return Status::OK();
 }
-#ifdef __GNUC__
-#pragma GCC diagnostic pop
-#endif
 
 Status GatherElements::ValidateInputShapes(const TensorShape& input_data_shape,
                                            const TensorShape& indices_shape,
@@ -299,19 +222,10 @@ Status GatherElements::Compute(OpKernelContext* context) const {
     return Status::OK();
 
   auto* ttp = context->GetOperatorThreadPool();
-  if (input_tensor->IsDataTypeString()) {
-    if (indices_tensor->IsDataType<int32_t>())
-      core_impl<true, std::string, int32_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
-    else
-      core_impl<true, std::string, int64_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
-  } else {
-    if (indices_tensor->IsDataType<int32_t>())
-      core_impl<false, int8_t, int32_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
-    else
-      core_impl<false, int8_t, int64_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
-  }
-
-  return Status::OK();
+  if (indices_tensor->IsDataType<int32_t>())
+    return core_impl_dispatch<int32_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
+  else
+    return core_impl_dispatch<int64_t>(input_tensor, indices_tensor, output_tensor, axis, ttp);
 }
 
 }  // namespace onnxruntime
@@ -6,7 +6,7 @@
 #include <cassert>
 #include <vector>
 
-#include "core/util/math_cpuonly.h"
+#include "core/providers/cpu/parallel_scan.h"
 
 namespace onnxruntime {
 // kernel builder functions
@@ -59,59 +59,73 @@ Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto& X_shape = X->Shape();
   assert(X_shape.Size() >= 0);
 
-  const Eigen::Index coordinate_size = X_shape.IsScalar() ? 1 : X_shape.NumDimensions();
-  std::vector<int64_t> non_zero_indices_buffer{};
-  // reserve enough space for indices for every element of X
-  non_zero_indices_buffer.reserve(X_shape.Size() * coordinate_size);
-
+  const int64_t coordinate_size = X_shape.IsScalar() ? 1 : static_cast<int64_t>(X_shape.NumDimensions());
   const T* data = X->Data<T>();
 
   if (X_shape.IsScalar()) {
-    const T& value = *data;
-    if (value != T{}) {
-      non_zero_indices_buffer.push_back(0);
+    const bool is_non_zero = *data != T{};
+    Tensor* const Y = context->Output(0, {coordinate_size, is_non_zero ? 1 : 0});
+    ORT_ENFORCE(Y, "failed to get first output!");
+    if (is_non_zero) {
+      Y->MutableData<int64_t>()[0] = 0;
     }
-  } else {
+    return Status::OK();
+  }
+
+  // the non zero values of each block of the input are counted in parallel, then each block writes the coordinates
+  // of its non zero values from the count of the blocks before it
+  ParallelScan scan(context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(X_shape.Size()));
+  std::vector<int64_t> block_offsets;
+  const int64_t num_non_zero_values = scan.ExclusiveScan<int64_t>(
+      [data](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        int64_t count = 0;
+        for (std::ptrdiff_t i = begin; i < end; ++i) {
+          count += data[i] != T{} ? 1 : 0;
+        }
+        return count;
+      },
+      block_offsets);
+
+  // the coordinates are written transposed, one row per dimension
+  Tensor* const Y = context->Output(0, {coordinate_size, num_non_zero_values});
+  ORT_ENFORCE(Y, "failed to get first output!");
+
+  if (num_non_zero_values == 0) {
+    return Status::OK();
+  }
+
+  int64_t* const y_data = Y->MutableData<int64_t>();
+  const auto& dims = X_shape.GetDims();
+
+  scan.ForEachBlock([&](std::ptrdiff_t block, std::ptrdiff_t begin, std::ptrdiff_t end) {
+    // the coordinate of the first entry of the block
     std::vector<int64_t> coordinate(coordinate_size, 0);
+    for (int64_t idx = coordinate_size - 1, remainder = begin; idx >= 0; --idx) {
+      coordinate[idx] = remainder % dims[idx];
+      remainder /= dims[idx];
+    }
 
-    // as we iterate the entries, increment the coordinate for the current entry
-    // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
-    auto increment_coordinate = [&coordinate, &coordinate_size, &X_shape]() {
+    int64_t* y = y_data + block_offsets[block];
+    for (std::ptrdiff_t i = begin; i < end; ++i) {
+      if (data[i] != T{}) {
+        for (int64_t idx = 0; idx < coordinate_size; ++idx) {
+          y[idx * num_non_zero_values] = coordinate[idx];
+        }
+        ++y;
+      }
+
+      // increment the coordinate for the next entry
+      // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
       for (int64_t idx = coordinate_size - 1; idx >= 0; --idx) {
         int64_t& cur_coord = coordinate[idx];
-        if (cur_coord != X_shape[idx] - 1) {
+        if (cur_coord != dims[idx] - 1) {
           ++cur_coord;
           break;
         }
         cur_coord = 0;
       }
-    };
-
-    for (size_t i = 0, end = X_shape.Size(); i < end; ++i) {
-      const T& value = *data++;
-      if (value != T{}) {
-        non_zero_indices_buffer.insert(non_zero_indices_buffer.end(),
-                                       coordinate.begin(), coordinate.end());
-      }
-
-      increment_coordinate();
     }
-  }
-
-  const Eigen::Index num_non_zero_values = non_zero_indices_buffer.size() / coordinate_size;
-
-  // transpose result for output
-  ConstEigenMatrixMapRowMajor<int64_t> non_zero_indices_matrix{
-      non_zero_indices_buffer.data(),
-      num_non_zero_values, coordinate_size};
-
-  Tensor* const Y = context->Output(0, {coordinate_size, num_non_zero_values});
-  ORT_ENFORCE(Y, "failed to get first output!");
-
-  EigenMatrixMapRowMajor<int64_t> y_matrix{
-      Y->MutableData<int64_t>(),
-      coordinate_size, num_non_zero_values};
-  y_matrix = non_zero_indices_matrix.transpose();
+  });
 
   return Status::OK();
 }
@@ -9,6 +9,7 @@
 #endif
 #include "core/util/math.h"
 #include "core/providers/cpu/tensor/pad.h"
+#include "core/providers/cpu/tensor/copy.h"
 #include "core/providers/cpu/tensor/utils.h"
 
 namespace onnxruntime {
@@ -111,6 +112,29 @@ static void PadAxisConstant(T* output, T constant, size_t size) {
   }
 }
 
+// Writes the constant to the padding of the axis and the inner axes around the copied input, which starts at
+// the pads of each axis and spans the extents of the input
+template <typename T>
+static void PadConstantAroundInterior(T* output, size_t axis, const TensorPitches& output_pitches,
+                                      const std::vector<int64_t>& pads, const std::vector<int64_t>& input_extents,
+                                      T constant) {
+  const size_t dims_count = input_extents.size();
+  const int64_t pitch = output_pitches[axis];
+  const int64_t pre_pad = pads[axis];
+  const int64_t extent = input_extents[axis];
+  const int64_t post_pad = pads[axis + dims_count];
+
+  // the padding before and after the input along this axis covers whole blocks of the inner axes
+  PadAxisConstant(output, constant, static_cast<size_t>(pre_pad * pitch));
+  PadAxisConstant(output + (pre_pad + extent) * pitch, constant, static_cast<size_t>(post_pad * pitch));
+
+  if (axis + 1 < dims_count) {
+    for (int64_t i = pre_pad, end = pre_pad + extent; i < end; ++i) {
+      PadConstantAroundInterior(output + i * pitch, axis + 1, output_pitches, pads, input_extents, constant);
+    }
+  }
+}
+
 Status PadBase::HandleDimValueZero(const Mode& mode, const TensorShape& input_shape, TensorShape& output_shape) {
   switch (mode) {
     case Mode::Constant: {
@@ -279,36 +303,18 @@ static Status PadImpl(OpKernelContext* ctx,
   ExtentAxisCounters input_counters(input_extents);
 
   switch (mode) {
-    case Mode::Constant:
-      // Loop over the output tensor, writing out padding between the blocks of copied data
-      // On loop entry, 'pad' is already set to the first continuous block of padding, and
-      // after every pass through the inner loop it gets set to the next continuous pad size.
-      while (input_counters) {
-        output += alignSkip;
-        {
-          T* axisStart = output;
-          output = input.CopyInnermostAxisSolitaryInnerStep(output);
-
-          int64_t prePad = reshaped_pad[inner_axis];
-          int64_t postPad = reshaped_pad[inner_axis + new_dims_count];
-          PadAxisConstant(axisStart - prePad, value, prePad);
-          PadAxisConstant(output, value, postPad);
-          output += postPad;
-          alignSkip = prePad;
-        }
-        // Calculate the size of the next block of padding (skipping over the innermost axis since that's already done)
-        while (input_counters.Increment()) {
-          ptrdiff_t inner_pitch = output_pitches[input_counters.Axis()];
-          T* axisStart = output - inner_pitch * input_extents[input_counters.Axis()];
-          int64_t prePad = reshaped_pad[input_counters.Axis()];
-          int64_t postPad = reshaped_pad[input_counters.Axis() + new_dims_count];
-          PadAxisConstant(axisStart - prePad * inner_pitch, value, prePad * inner_pitch);
-          PadAxisConstant(output, value, postPad * inner_pitch);
-          output += inner_pitch * postPad;
-          alignSkip += inner_pitch * prePad;
-        }
-      }
+    case Mode::Constant: {
+      // Copy the input to the interior of the output as one strided copy, then write the padding around it
+      TensorPitches input_pitches(reshaped_input_dims);
+      const T* input_data = reinterpret_cast<const T*>(input_tensor.DataRaw());
+      for (size_t i = 0; i < new_dims_count; i++)
+        input_data += input_starts[i] * input_pitches[i];
+
+      StridedCopy(ctx->GetOperatorThreadPool(), output + alignSkip, output_pitches, input_data, input_pitches,
+                  input_extents);
+      PadConstantAroundInterior(output, 0, output_pitches, reshaped_pad, input_extents, value);
       break;
+    }
 
     case Mode::Edge:
       // Loop over the output tensor, writing out padding between the blocks of copied data
@@ -4,7 +4,11 @@
 //https://github.com/onnx/onnx/blob/master/docs/Operators.md#Scatter
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/data_types_internal.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
+#include "core/providers/cpu/tensor/scatter_reduction.h"
+#include "core/providers/cpu/tensor/utils.h"
 #ifdef ENABLE_TRAINING
 #include "orttraining/training_ops/cpu/tensor/gather_elements_grad_impl.h"
 #endif
@@ -16,6 +20,8 @@ class Scatter final : public OpKernel {
   explicit Scatter(const OpKernelInfo& info) : OpKernel(info) {
     ORT_ENFORCE(info.GetAttr<int64_t>("axis", &axis_).IsOK(),
                 "Missing/Invalid 'axis' attribute value");
+    // only the contrib op has the attribute
+    reduction_ = ScatterReductionFromString(info.GetAttrOrDefault<std::string>("reduction", "none"));
   }
 
   ~Scatter() = default;
@@ -23,6 +29,7 @@ class Scatter final : public OpKernel {
 
  private:
   int64_t axis_;
+  ScatterReduction reduction_;
 };
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
@@ -53,6 +60,26 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("Tind", std::vector<MLDataType>{DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()}),
     Scatter);
 
+#ifndef DISABLE_CONTRIB_OPS
+
+namespace contrib {
+
+// ScatterElements with the 'reduction' attribute of the later ONNX opsets
+ONNX_OPERATOR_KERNEL_EX(
+    ScatterElements,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .MayInplace(0, 0)
+        .TypeConstraint("T", DataTypeImpl::AllTensorTypes())
+        .TypeConstraint("Tind", std::vector<MLDataType>{DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()}),
+    Scatter);
+
+}  // namespace contrib
+
+#endif
+
 template <class T>
 struct Func_Assignment {
   void operator()(T* a, const T* b) const {
@@ -60,9 +87,30 @@ struct Func_Assignment {
   }
 };
 
+template <class T>
+struct Func_Add {
+  void operator()(T* a, const T* b) const {
+    *a = *a + *b;
+  }
+};
+
+template <class T>
+struct Func_Mul {
+  void operator()(T* a, const T* b) const {
+    *a = *a * *b;
+  }
+};
+
+template <class T>
+struct Func_Max {
+  void operator()(T* a, const T* b) const {
+    *a = std::max(*a, *b);
+  }
+};
+
 template <class Tin, class Tdata, typename FuncT>
 Status CopyScatterData(const FuncT& func, const Tensor* data_input, const Tensor* indices_input, const Tensor* updates_input,
-                       const int64_t axis, Tensor* data_output) {
+                       const int64_t axis, Tensor* data_output, concurrency::ThreadPool* tp) {
   const TensorShape& input_data_shape = data_input->Shape();
   const Tin* indices_data_raw = indices_input->template Data<Tin>();
   const auto num_indices = indices_input->Shape().Size();
@@ -105,87 +153,132 @@ Status CopyScatterData(const FuncT& func, const Tensor* data_input, const Tensor
     }
   }
 
+  if (num_indices == 0) {
+    return Status::OK();
+  }
+
   // Now poke updates
 
+  // The update at [i][j][k] goes to the output element that has the same coordinates as it on all the dimensions
+  // but the axis, e.g. for 3-dim and axis=1
+  //    output[i][indices[i][j][k]][k] = updates[i][j][k]
+  // so the updates that differ on the outer (i) or inner (k) coordinates never go to the same output element.
+  // The updates are split in num_items sequences of axis_count updates, one per outer and inner coordinates, which
+  // are applied concurrently. The updates of a sequence are applied in order, so repeated indices give the
+  // same result as a serial loop.
   const auto& upd_shape = updates_input->Shape();
-  const auto num_dims = input_data_shape.NumDimensions();
+  const auto num_dims = static_cast<int64_t>(input_data_shape.NumDimensions());
   assert(num_dims > 0);
 
-  // Allocate and zero out counts. The input/output is of the same rank as
-  // indices/updates but the actual dimensions of indices/updates must be less or equal
-  // than that of input/output because we can update no more elements than
-  // the input contains. As we walk through the indices/updates
-  // we maintain dimension count as we will need to use it
-  // to compute output offset but using input/output dim values.
-  // We treat the whole array as a number where each element having
-  // different cardinality according to the upd_shape dimensions.
-  // As each counter reaches its max (upd_shape) it resets to zero
-  // and we carry to the more significant dim (right to left)
-  std::vector<int64_t> dim_counters(num_dims);
-
-  // This vector contains number of elements under the dimension.
-  // For example, for the dimensions of [4, 2, 3] the vector
-  // would contain [6, 3, 1] since for each count of dim 1 it
-  // contains 3 elements of dim 2.
-  // For each count of dim 0 we would have 2x3=6 elements.
-  // The last value is always 1.
-  // We use it to compute output element offset. For a given value of
-  // counters we multiple each counter value per corresponding entry of dim_block_size value
-  // and add up resulting the output element offset. However, for dimensions
-  // that are equal to the specified axis value we take indices_data[index]
-  // instead of the counter value.
-  // E.g. for 3-dim and axis=0
-  //    output[indices[i][j][k]][j][k] = updates[i][j][k]
-  // for axis 1
-  //    output[i][indices[i][j][k]][k] = updates[i][j][k]
-  // and so on
-  std::vector<int64_t> dim_block_size(num_dims);
-
-  dim_block_size.back() = 1;
-  if (num_dims > 1) {
-    // We start at num_dims - 2 because we already pre-populated
-    // the last element above
-    for (auto i = int64_t(num_dims - 2); i >= 0; --i) {
-      dim_block_size[i] = input_data_shape[i + 1] * dim_block_size[i + 1];
-    }
-  }
+  const int64_t outer = upd_shape.SizeToDimension(static_cast<size_t>(axis));
+  const int64_t axis_count = upd_shape[static_cast<size_t>(axis)];
+  const int64_t inner = upd_shape.SizeFromDimension(static_cast<size_t>(axis) + 1);
+  const int64_t num_items = outer * inner;
+
+  // The output strides use the input dimensions, the updates dimensions may be smaller.
+  TensorPitches input_strides(input_data_shape);
+  const int64_t axis_stride = input_strides[static_cast<size_t>(axis)];
 
   const auto* update_data = static_cast<const Tdata*>(updates_input->DataRaw());
-  // For every update we compute the destination offset and copy it there
-  for (int64_t index = 0; index < num_indices;) {
-    const Tin axis_idx = indices_data[index];
-
-    // Compute the offset
-    // See comments above for dim_block_size
-    size_t dst_offset = 0;
-    for (size_t i = 0; i < num_dims; ++i) {
-      if (i == size_t(axis)) {
-        // replace the counter with the update index for this dim
-        dst_offset += axis_idx * dim_block_size[i];
-      } else {
-        dst_offset += dim_counters[i] * dim_block_size[i];
+
+  // Apply the updates [first, last) of the sequence item
+  auto apply_updates = [&](int64_t item, int64_t first, int64_t last) {
+    const int64_t outer_index = item / inner;
+    const int64_t inner_index = item % inner;
+
+    // Offset of the output element of the sequence for index 0, computed from the coordinates of item
+    int64_t dst_offset = 0;
+    int64_t remaining = inner_index;
+    for (auto i = num_dims - 1; i > axis; --i) {
+      dst_offset += (remaining % upd_shape[i]) * input_strides[i];
+      remaining /= upd_shape[i];
+    }
+    remaining = outer_index;
+    for (auto i = axis - 1; i >= 0; --i) {
+      dst_offset += (remaining % upd_shape[i]) * input_strides[i];
+      remaining /= upd_shape[i];
+    }
+
+    int64_t update_offset = (outer_index * axis_count + first) * inner + inner_index;
+    for (int64_t j = first; j < last; ++j, update_offset += inner) {
+      func(dst_base + dst_offset + indices_data[update_offset] * axis_stride, update_data + update_offset);
+    }
+  };
+
+  const double update_bytes = static_cast<double>(sizeof(Tdata));
+
+  // Few long sequences, e.g. a 1-D scatter-add over the edges of a graph, don't keep the pool busy. If all the updates
+  // of any output element are adjacent in every sequence, which is the case when the indices are sorted or unique,
+  // the sequences are also split, moving each split to the start of the next run of equal indices so that only one
+  // thread updates an output element.
+  bool split_sequences = num_items < concurrency::ThreadPool::DegreeOfParallelism(tp) && axis_count > 1;
+  if (split_sequences) {
+    std::vector<bool> done(static_cast<size_t>(axis_dim_limit));
+    for (int64_t item = 0; item < num_items && split_sequences; ++item) {
+      std::fill(done.begin(), done.end(), false);
+      int64_t update_offset = (item / inner) * axis_count * inner + item % inner;
+      Tin previous = indices_data[update_offset];
+      for (int64_t j = 1; j < axis_count; ++j) {
+        update_offset += inner;
+        const Tin idx = indices_data[update_offset];
+        if (idx != previous) {
+          done[previous] = true;
+          if (done[idx]) {
+            split_sequences = false;
+            break;
+          }
+          previous = idx;
+        }
       }
     }
+  }
 
-    func(dst_base + dst_offset, update_data + index);
+  if (!split_sequences) {
+    concurrency::ThreadPool::TryParallelFor(
+        tp, num_items,
+        TensorOpCost{static_cast<double>(axis_count) * (2 * update_bytes + sizeof(Tin)),
+                     static_cast<double>(axis_count) * update_bytes,
+                     static_cast<double>(axis_count * (num_dims + 1))},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t item = first; item < last; ++item) {
+            apply_updates(item, 0, axis_count);
+          }
+        });
+    return Status::OK();
+  }
 
-    if (++index == num_indices) {
-      break;
-    }
-    // Increment counters
-    // See comments for dim_counters above
-    for (auto i = int64_t(num_dims - 1); i >= 0; --i) {
-      auto v = ++dim_counters[i];
-      assert(v <= upd_shape[i]);
-      if (v < upd_shape[i]) {
-        // No carry, done
+  auto index_at = [&](int64_t item, int64_t j) {
+    return indices_data[((item / inner) * axis_count + j) * inner + item % inner];
+  };
+
+  // Both ends of a block are moved forward to the boundary of the run they fall in, so every run is applied by the
+  // block in which it starts.
+  auto run_start = [&](int64_t position) {
+    while (position < num_items * axis_count) {
+      const int64_t item = position / axis_count;
+      const int64_t j = position % axis_count;
+      if (j == 0 || index_at(item, j) != index_at(item, j - 1)) {
         break;
       }
-      // No carry for the most significant dim
-      assert(i > 0);
-      dim_counters[i] = 0;
+      ++position;
     }
-  }
+    return position;
+  };
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_items * axis_count,
+      TensorOpCost{2 * update_bytes + sizeof(Tin), update_bytes, 1.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        int64_t position = run_start(first);
+        const int64_t end = run_start(last);
+        while (position < end) {
+          const int64_t item = position / axis_count;
+          const int64_t item_end = std::min(end, (item + 1) * axis_count);
+          apply_updates(item, position % axis_count, item_end - item * axis_count);
+          position = item_end;
+        }
+      });
+
   return Status::OK();
 }
 
@@ -199,6 +292,37 @@ inline Status CopyInt64Index(Args&&... args) {
   return CopyScatterData<int64_t, T>(Func_Assignment<T>(), std::forward<Args>(args)...);
 }
 
+template <class Tin, class T>
+Status CopyScatterDataWithReduction(ScatterReduction reduction, const Tensor* data_input, const Tensor* indices_input,
+                                    const Tensor* updates_input, const int64_t axis, Tensor* data_output,
+                                    concurrency::ThreadPool* tp) {
+  switch (reduction) {
+    case ScatterReduction::Add:
+      return CopyScatterData<Tin, T>(Func_Add<T>(), data_input, indices_input, updates_input, axis, data_output, tp);
+    case ScatterReduction::Mul:
+      return CopyScatterData<Tin, T>(Func_Mul<T>(), data_input, indices_input, updates_input, axis, data_output, tp);
+    case ScatterReduction::Max:
+      return CopyScatterData<Tin, T>(Func_Max<T>(), data_input, indices_input, updates_input, axis, data_output, tp);
+    default:
+      return CopyScatterData<Tin, T>(Func_Assignment<T>(), data_input, indices_input, updates_input, axis, data_output,
+                                     tp);
+  }
+}
+
+template <class T>
+struct ScatterWithReduction {
+  Status operator()(ScatterReduction reduction, const Tensor* data_input, const Tensor* indices_input,
+                    const Tensor* updates_input, const int64_t axis, Tensor* data_output,
+                    concurrency::ThreadPool* tp) const {
+    if (indices_input->IsDataType<int32_t>()) {
+      return CopyScatterDataWithReduction<int32_t, T>(reduction, data_input, indices_input, updates_input, axis,
+                                                      data_output, tp);
+    }
+    return CopyScatterDataWithReduction<int64_t, T>(reduction, data_input, indices_input, updates_input, axis,
+                                                    data_output, tp);
+  }
+};
+
 Status Scatter::Compute(OpKernelContext* context) const {
   const auto* data_input = context->Input<Tensor>(0);
   const auto& input_data_shape = data_input->Shape();
@@ -241,16 +365,32 @@ Status Scatter::Compute(OpKernelContext* context) const {
     }
   }
 
+  if (!indices_input->IsDataType<int32_t>() && !indices_input->IsDataType<int64_t>()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Expecting indices to be either int32_t or int64_t");
+  }
+
+  if (reduction_ != ScatterReduction::None &&
+      !data_input->IsDataType<float>() && !data_input->IsDataType<double>() &&
+      !data_input->IsDataType<int32_t>() && !data_input->IsDataType<int64_t>()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "reduction is only supported for float, double, int32 and int64 data");
+  }
+
   auto* data_output = context->Output(0, input_data_shape);
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+
+  if (reduction_ != ScatterReduction::None) {
+    utils::MLTypeCallDispatcherRet<Status, ScatterWithReduction, float, double, int32_t, int64_t> t_disp(
+        data_input->GetElementType());
+    return t_disp.Invoke(reduction_, data_input, indices_input, updates_input, axis, data_output, tp);
+  }
 
   MLDataType Tdata_type = data_input->DataType();
   Status status;
   if (indices_input->IsDataType<int32_t>()) {
-    DispatchOnTensorTypeWithReturn(Tdata_type, status, CopyInt32Index, data_input, indices_input, updates_input, axis, data_output);
-  } else if (indices_input->IsDataType<int64_t>()) {
-    DispatchOnTensorTypeWithReturn(Tdata_type, status, CopyInt64Index, data_input, indices_input, updates_input, axis, data_output);
+    DispatchOnTensorTypeWithReturn(Tdata_type, status, CopyInt32Index, data_input, indices_input, updates_input, axis, data_output, tp);
   } else {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Expecting indices to be either int32_t or int64_t");
+    DispatchOnTensorTypeWithReturn(Tdata_type, status, CopyInt64Index, data_input, indices_input, updates_input, axis, data_output, tp);
   }
   return status;
 }
@@ -259,17 +399,11 @@ Status Scatter::Compute(OpKernelContext* context) const {
 
 namespace contrib {
 
-template <class T>
-struct Func_Add {
-  void operator()(T* a, const T* b) const {
-    *a = *a + *b;
-  }
-};
-
 template <class Tin, class Tdata>
 Status GatherElementsGradImpl(const Tensor* indices_input, const Tensor* updates_input,
                               const int64_t axis, Tensor* data_output) {
-  return CopyScatterData<Tin, Tdata>(Func_Add<Tdata>(), data_output, indices_input, updates_input, axis, data_output);
+  return CopyScatterData<Tin, Tdata>(Func_Add<Tdata>(), data_output, indices_input, updates_input, axis, data_output,
+                                     nullptr);
 }
 
 #define GATHER_ELEMENTS_GRAD_IMPL_SPECIALIZED(Tin, Tdata)         \
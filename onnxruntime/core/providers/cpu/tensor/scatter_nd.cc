@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "scatter_nd.h"
+#include <algorithm>
 #include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/utils.h"
 
@@ -12,6 +13,7 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     11,
     12,
     KernelDefBuilder()
+        .MayInplace(0, 0)
         .TypeConstraint("T", DataTypeImpl::AllTensorTypes()),
     ScatterND);
 
@@ -19,9 +21,29 @@ ONNX_CPU_OPERATOR_KERNEL(
     ScatterND,
     13,
     KernelDefBuilder()
+        .MayInplace(0, 0)
         .TypeConstraint("T", DataTypeImpl::AllTensorTypes()),
     ScatterND);
 
+#ifndef DISABLE_CONTRIB_OPS
+
+namespace contrib {
+
+// ScatterND with the 'reduction' attribute of the later ONNX opsets
+ONNX_OPERATOR_KERNEL_EX(
+    ScatterND,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .MayInplace(0, 0)
+        .TypeConstraint("T", DataTypeImpl::AllTensorTypes()),
+    ScatterND);
+
+}  // namespace contrib
+
+#endif
+
 Status ScatterNDBase::ValidateShapes(const TensorShape& input_shape,
                                      const TensorShape& indice_shape,
                                      const TensorShape& update_shape) {
@@ -143,38 +165,144 @@ Status ScatterNDBase::PrepareForCompute(OpKernelContext* context, Prepare& p) co
 Status ScatterND::Compute(OpKernelContext* context) const {
   Prepare p;
   concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  if (reduction_ == ScatterReduction::None) {
+    ORT_RETURN_IF_ERROR(PrepareForCompute(context, p));
+    return nullptr == p.input_str_base ? ScatterNumber(p, tp) : ScatterString(p, tp);
+  }
+
+  const auto* input_tensor = context->Input<Tensor>(0);
+  if (!input_tensor->IsDataType<float>() && !input_tensor->IsDataType<double>() &&
+      !input_tensor->IsDataType<int32_t>() && !input_tensor->IsDataType<int64_t>()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "reduction is only supported for float, double, int32 and int64 data");
+  }
+
   ORT_RETURN_IF_ERROR(PrepareForCompute(context, p));
-  return nullptr == p.input_str_base ? ScatterNumber(p, tp) : ScatterString(p, tp);
+  const int64_t output_slices = p.element_to_copy == 0
+                                    ? 0
+                                    : input_tensor->Shape().Size() / static_cast<int64_t>(p.element_to_copy);
+  if (input_tensor->IsDataType<float>()) {
+    return ScatterReduce<float>(p, output_slices, tp);
+  } else if (input_tensor->IsDataType<double>()) {
+    return ScatterReduce<double>(p, output_slices, tp);
+  } else if (input_tensor->IsDataType<int32_t>()) {
+    return ScatterReduce<int32_t>(p, output_slices, tp);
+  }
+  return ScatterReduce<int64_t>(p, output_slices, tp);
 }
 
 Status ScatterND::ScatterNumber(const Prepare& p, concurrency::ThreadPool* tp) const {
-  auto lambda = [&](int64_t i) {
-    memcpy(p.output_base + p.element_offsets[i] * p.element_bytes,
-           p.input_base + i * p.bytes_to_copy,
-           p.bytes_to_copy);
+  auto lambda = [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    const uint8_t* src = p.input_base + first * p.bytes_to_copy;
+    for (std::ptrdiff_t i = first; i < last; ++i) {
+      memcpy(p.output_base + p.element_offsets[i] * p.element_bytes, src, p.bytes_to_copy);
+      src += p.bytes_to_copy;
+    }
   };
-  concurrency::ThreadPool::TryParallelFor(tp, p.element_offsets.size(), static_cast<double>(p.bytes_to_copy),
-                                          [&lambda](ptrdiff_t first, ptrdiff_t last) {
-                                            for (int i = static_cast<int>(first), end = static_cast<int>(last); i < end; ++i) {
-                                              lambda(i);
-                                            }
-                                          });
+  concurrency::ThreadPool::TryParallelFor(tp, p.element_offsets.size(),
+                                          TensorOpCost{static_cast<double>(p.bytes_to_copy),
+                                                       static_cast<double>(p.bytes_to_copy),
+                                                       static_cast<double>(p.element_to_copy)},
+                                          lambda);
   return Status::OK();
 }
 
 Status ScatterND::ScatterString(const Prepare& p, concurrency::ThreadPool* tp) const {
-  auto lambda = [&](int64_t i) {
-    for (int64_t j = 0; j < static_cast<int64_t>(p.element_to_copy); ++j) {
-      p.output_str_base[p.element_offsets[i] + j] = p.input_str_base[i * p.element_to_copy + j];
+  auto lambda = [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    const std::string* src = p.input_str_base + first * p.element_to_copy;
+    for (std::ptrdiff_t i = first; i < last; ++i) {
+      std::copy(src, src + p.element_to_copy, p.output_str_base + p.element_offsets[i]);
+      src += p.element_to_copy;
     }
   };
   concurrency::ThreadPool::TryParallelFor(tp, p.element_offsets.size(), static_cast<double>(p.element_to_copy),
-                                          [&lambda](ptrdiff_t first, ptrdiff_t last) {
-                                            for (int i = static_cast<int>(first), end = static_cast<int>(last); i < end; ++i) {
-                                              lambda(i);
-                                            }
-                                          });
+                                          lambda);
+  return Status::OK();
+}
+
+template <typename T>
+Status ScatterND::ScatterReduce(const Prepare& p, int64_t output_slices, concurrency::ThreadPool* tp) const {
+  switch (reduction_) {
+    case ScatterReduction::Add:
+      ScatterReduceSlices<T>([](T* a, const T* b) { *a = *a + *b; }, p, output_slices, tp);
+      break;
+    case ScatterReduction::Mul:
+      ScatterReduceSlices<T>([](T* a, const T* b) { *a = *a * *b; }, p, output_slices, tp);
+      break;
+    case ScatterReduction::Max:
+      ScatterReduceSlices<T>([](T* a, const T* b) { *a = std::max(*a, *b); }, p, output_slices, tp);
+      break;
+    default:
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Unexpected reduction ", static_cast<int>(reduction_));
+  }
   return Status::OK();
 }
 
+template <typename T, typename FuncT>
+void ScatterND::ScatterReduceSlices(const FuncT& func, const Prepare& p, int64_t output_slices,
+                                    concurrency::ThreadPool* tp) {
+  const auto* updates = reinterpret_cast<const T*>(p.input_base);
+  auto* output = reinterpret_cast<T*>(p.output_base);
+  const auto& offsets = p.element_offsets;
+  const auto num_slices = static_cast<std::ptrdiff_t>(offsets.size());
+  const auto slice_size = static_cast<std::ptrdiff_t>(p.element_to_copy);
+  if (num_slices == 0 || slice_size == 0) {
+    return;
+  }
+
+  // Only the update slices with the same offset go to the same output elements. If all the slices of an offset are
+  // adjacent, which is the case when the indices are sorted or unique, the slices are partitioned at the boundaries
+  // of the runs of equal offsets so that only one thread updates an output slice. Otherwise the slices are
+  // partitioned on their elements, each going to a different output element.
+  bool adjacent_offsets = true;
+  std::vector<bool> done(static_cast<size_t>(output_slices));
+  for (std::ptrdiff_t i = 1; i < num_slices; ++i) {
+    if (offsets[i] != offsets[i - 1]) {
+      done[offsets[i - 1] / slice_size] = true;
+      if (done[offsets[i] / slice_size]) {
+        adjacent_offsets = false;
+        break;
+      }
+    }
+  }
+
+  const double slice_bytes = static_cast<double>(p.bytes_to_copy);
+  if (adjacent_offsets) {
+    // Both ends of a block are moved forward to the boundary of the run they fall in, so every run is applied by
+    // the block in which it starts.
+    auto run_start = [&offsets, num_slices](std::ptrdiff_t i) {
+      while (i > 0 && i < num_slices && offsets[i] == offsets[i - 1]) {
+        ++i;
+      }
+      return i;
+    };
+    concurrency::ThreadPool::TryParallelFor(
+        tp, num_slices, TensorOpCost{2 * slice_bytes, slice_bytes, static_cast<double>(slice_size)},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          const std::ptrdiff_t end = run_start(last);
+          for (std::ptrdiff_t i = run_start(first); i < end; ++i) {
+            const T* src = updates + i * slice_size;
+            T* dst = output + offsets[i];
+            for (std::ptrdiff_t j = 0; j < slice_size; ++j) {
+              func(dst + j, src + j);
+            }
+          }
+        });
+  } else {
+    const double element_bytes = static_cast<double>(p.element_bytes);
+    concurrency::ThreadPool::TryParallelFor(
+        tp, slice_size,
+        TensorOpCost{2 * element_bytes * num_slices, element_bytes * num_slices, static_cast<double>(num_slices)},
+        [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = 0; i < num_slices; ++i) {
+            const T* src = updates + i * slice_size;
+            T* dst = output + offsets[i];
+            for (std::ptrdiff_t j = first; j < last; ++j) {
+              func(dst + j, src + j);
+            }
+          }
+        });
+  }
+}
+
 }  // namespace onnxruntime
@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/tensor/scatter_reduction.h"
 
 namespace onnxruntime {
 namespace concurrency {
@@ -42,12 +43,23 @@ class ScatterNDBase {
 
 class ScatterND final : public OpKernel, protected ScatterNDBase {
  public:
-  explicit ScatterND(const OpKernelInfo& info) : OpKernel(info) {}
+  explicit ScatterND(const OpKernelInfo& info) : OpKernel(info) {
+    // only the contrib op has the attribute
+    reduction_ = ScatterReductionFromString(info.GetAttrOrDefault<std::string>("reduction", "none"));
+  }
   Status Compute(OpKernelContext* context) const override;
 
  private:
   Status ScatterNumber(const Prepare& p, concurrency::ThreadPool* tp) const;
   Status ScatterString(const Prepare& p, concurrency::ThreadPool* tp) const;
+
+  // Combine the updates with the output elements, output_slices is the number of slices of the output
+  template <typename T, typename FuncT>
+  static void ScatterReduceSlices(const FuncT& func, const Prepare& p, int64_t output_slices, concurrency::ThreadPool* tp);
+  template <typename T>
+  Status ScatterReduce(const Prepare& p, int64_t output_slices, concurrency::ThreadPool* tp) const;
+
+  ScatterReduction reduction_;
 };
 
 }  // namespace onnxruntime
\ No newline at end of file
@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+// Value of the 'reduction' attribute of the ScatterElements and ScatterND contrib ops, shared between the CPU
+// and CUDA kernels. 'none' replaces the data elements with the updates, the other modes combine the updates
+// of the same data element with it.
+enum class ScatterReduction : int {
+  None = 0,
+  Add,
+  Mul,
+  Max
+};
+
+inline ScatterReduction ScatterReductionFromString(const std::string& reduction) {
+  if (reduction == "none")
+    return ScatterReduction::None;
+  if (reduction == "add")
+    return ScatterReduction::Add;
+  if (reduction == "mul")
+    return ScatterReduction::Mul;
+  if (reduction == "max")
+    return ScatterReduction::Max;
+  ORT_THROW("Invalid 'reduction' attribute value: ", reduction);
+}
+
+}  // namespace onnxruntime
@@ -14,7 +14,9 @@ namespace onnxruntime {
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     1, 9,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::AllTensorTypes()),
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::AllTensorTypes())
+        .MayOutputView(0, 0),
     Slice1);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
@@ -23,7 +25,8 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     KernelDefBuilder()
         .TypeConstraint("T", DataTypeImpl::AllTensorTypes())
         .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(),
-                                 DataTypeImpl::GetTensorType<int64_t>()}),
+                                 DataTypeImpl::GetTensorType<int64_t>()})
+        .MayOutputView(0, 0),
     Slice10);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
@@ -33,7 +36,8 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     KernelDefBuilder()
         .TypeConstraint("T", DataTypeImpl::AllTensorTypes())
         .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(),
-                                 DataTypeImpl::GetTensorType<int64_t>()}),
+                                 DataTypeImpl::GetTensorType<int64_t>()})
+        .MayOutputView(0, 0),
     Slice10);
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -42,7 +46,8 @@ ONNX_CPU_OPERATOR_KERNEL(
     KernelDefBuilder()
         .TypeConstraint("T", DataTypeImpl::AllTensorTypes())
         .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(),
-                                 DataTypeImpl::GetTensorType<int64_t>()}),
+                                 DataTypeImpl::GetTensorType<int64_t>()})
+        .MayOutputView(0, 0),
     Slice10);
 namespace {
 // std::clamp doesn't exist until C++17 so create a local version
@@ -267,6 +272,50 @@ void SliceBase::FillVectorsFromInput(const Tensor& start_tensor,
   }
 }
 
+// Check if the output is a contiguous block of the input, i.e. the slice takes a single index of some outermost
+// dims, a range with a step of 1 of the next dim and all the data of the remaining innermost dims.
+// e.g. slicing a range of the outermost dim. Sets byte_offset to the offset of the block if it is.
+static bool IsContiguousSlice(const SliceOp::PrepareForComputeMetadata& compute_metadata, size_t element_size,
+                              ptrdiff_t& byte_offset) {
+  const auto& input_dims = compute_metadata.input_dimensions_;
+  const auto& output_dims = compute_metadata.output_dims_;
+  const size_t rank = input_dims.size();
+
+  // starts and steps only cover the dims that weren't flattened, the flattened dims start at 0 with a step of 1
+  auto start = [&compute_metadata](size_t axis) {
+    return axis < compute_metadata.starts_.size() ? compute_metadata.starts_[axis] : 0;
+  };
+  auto step = [&compute_metadata](size_t axis) {
+    return axis < compute_metadata.steps_.size() ? compute_metadata.steps_[axis] : 1;
+  };
+
+  size_t axis = 0;
+  while (axis < rank && output_dims[axis] == 1) {
+    ++axis;
+  }
+
+  if (axis < rank) {
+    if (step(axis) != 1) {
+      return false;
+    }
+    for (size_t inner_axis = axis + 1; inner_axis < rank; ++inner_axis) {
+      if (output_dims[inner_axis] != input_dims[inner_axis] || step(inner_axis) != 1) {
+        return false;
+      }
+    }
+  }
+
+  int64_t offset = 0;
+  int64_t pitch = 1;
+  for (size_t i = rank; i-- > 0;) {
+    offset += start(i) * pitch;
+    pitch *= input_dims[i];
+  }
+
+  byte_offset = static_cast<ptrdiff_t>(offset * static_cast<int64_t>(element_size));
+  return true;
+}
+
 template <typename T>
 static Status SliceImpl(OpKernelContext* ctx,
                         const Tensor& input_tensor,
@@ -338,6 +387,14 @@ Status SliceBase::Compute(OpKernelContext* ctx) const {
     ORT_RETURN_IF_ERROR(PrepareForCompute(attr_starts_, attr_ends_, attr_axes_, compute_metadata));
   }
 
+  // output a contiguous block of the input as a view of it rather than a copy when possible
+  ptrdiff_t byte_offset = 0;
+  if (TensorShape(compute_metadata.output_dims_).Size() > 0 &&
+      IsContiguousSlice(compute_metadata, input_tensor.DataType()->Size(), byte_offset) &&
+      ctx->OutputView(0, 0, TensorShape(compute_metadata.output_dims_), byte_offset) != nullptr) {
+    return Status::OK();
+  }
+
   Status status = Status::OK();
 
   if (input_tensor.IsDataTypeString()) {
@@ -3,8 +3,7 @@
 
 #include "core/providers/cpu/tensor/split.h"
 #include "core/providers/common.h"
-#include "core/util/math.h"
-#include "core/util/math_cpuonly.h"
+#include "core/providers/cpu/tensor/copy.h"
 
 #include "gsl/gsl"
 
@@ -20,7 +19,8 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
                                           DataTypeImpl::GetTensorType<int32_t>(),
                                           DataTypeImpl::GetTensorType<int64_t>(),
                                           DataTypeImpl::GetTensorType<uint8_t>(),
-                                          DataTypeImpl::GetTensorType<std::string>()}),
+                                          DataTypeImpl::GetTensorType<std::string>()})
+        .VariadicMayOutputView(0, 0),
     Split);
 
 // Opset 11 starts to support Neg Axis.
@@ -34,7 +34,8 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
                                           DataTypeImpl::GetTensorType<int32_t>(),
                                           DataTypeImpl::GetTensorType<int64_t>(),
                                           DataTypeImpl::GetTensorType<uint8_t>(),
-                                          DataTypeImpl::GetTensorType<std::string>()}),
+                                          DataTypeImpl::GetTensorType<std::string>()})
+        .VariadicMayOutputView(0, 0),
     Split);
 
 // Opset 13 starts to supports 'split' as optional input.
@@ -47,7 +48,8 @@ ONNX_CPU_OPERATOR_KERNEL(
                                           DataTypeImpl::GetTensorType<int32_t>(),
                                           DataTypeImpl::GetTensorType<int64_t>(),
                                           DataTypeImpl::GetTensorType<uint8_t>(),
-                                          DataTypeImpl::GetTensorType<std::string>()}),
+                                          DataTypeImpl::GetTensorType<std::string>()})
+        .VariadicMayOutputView(0, 0),
     Split);
 
 Status SplitBase::PrepareForCompute(const TensorShape& input_shape, int num_outputs, int64_t& axis, int& before_dims,
@@ -110,17 +112,6 @@ Status Split::Compute(OpKernelContext* context) const {
   return status;
 }
 
-template <typename T>
-inline void copy_data(const T* src, T* dst, size_t count) {
-  memcpy(dst, src, count * sizeof(T));
-}
-
-template <>
-inline void copy_data<std::string>(const std::string* src, std::string* dst, size_t count) {
-  const std::string* end = src + count;
-  std::copy(src, end, dst);
-}
-
 template <typename T>
 Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
   auto& input_shape = input.Shape();
@@ -163,19 +154,23 @@ Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
     auto split_size = gsl::narrow<int>(split_sizes[i]);
     output_dimensions[axis] = split_size;
 
+    // with a single block before the split axis each output is a contiguous block of the input,
+    // so it's output as a view of the input rather than a copy when possible
+    if (before_dims == 1 &&
+        context.OutputView(i, 0, TensorShape{output_dimensions},
+                           static_cast<ptrdiff_t>(input_offset * sizeof(T))) != nullptr) {
+      input_offset += split_size * after_dims_excluding_split;
+      continue;
+    }
+
     Tensor* output = context.Output(i, TensorShape{output_dimensions});
     T* output_data = output->template MutableData<T>();
 
-    ::onnxruntime::math::CopyMatrix<T>(
-        before_dims,                                       // M
-        split_size * after_dims_excluding_split,           // N
-        static_cast<const T*>(input_data + input_offset),  // A
-        after_dims_including_split_axis,                   // lda
-        static_cast<T*>(output_data),                      // B
-        split_size * after_dims_excluding_split,           // ldb
-        [](const T* src, T* dst, size_t count) {
-          copy_data<T>(src, dst, count);
-        });
+    const int64_t block_size = split_size * after_dims_excluding_split;
+    StridedCopy(context.GetOperatorThreadPool(),
+                output_data, {block_size, 1},
+                input_data + input_offset, {after_dims_including_split_axis, 1},
+                {before_dims, block_size});
 
     input_offset += split_size * after_dims_excluding_split;  // offset by the N data we used in this iteration
   }
@@ -10,6 +10,7 @@
 #endif
 
 #include "gsl/gsl"
+#include "core/providers/cpu/tensor/copy.h"
 #include "core/providers/cpu/tensor/tile.h"
 #include "core/providers/cpu/tensor/utils.h"
 
@@ -56,49 +57,6 @@ ONNX_CPU_OPERATOR_KERNEL(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<int64_t>()),
     Tile);
 
-Status TileCoreForFixedSizeTypes(const Tensor& input_tensor, Tensor& output_tensor, const int64_t* repeats, TensorAxisCounters& input_counters, const TensorPitches& output_pitches, size_t element_size) {
-  const auto& input_shape = input_tensor.Shape().GetDims();
-  const size_t dimension_count = input_shape.size();
-
-  const auto* input = reinterpret_cast<const uint8_t*>(input_tensor.DataRaw());
-  auto* output = reinterpret_cast<uint8_t*>(output_tensor.MutableDataRaw());
-
-  // some helper variables that will be used along the way
-  size_t block_size = 0;
-  int64_t num_repeats = 0;
-  const uint8_t* copy = nullptr;
-  const int64_t innermost_dim = input_shape[dimension_count - 1];
-
-  while (input_counters) {
-    // Copy the input data over
-    block_size = innermost_dim * element_size;
-    memcpy(output, input, block_size);
-    output += block_size;
-    input += block_size;
-
-    // Tile data for the innermost axis
-    copy = output - block_size;
-    num_repeats = repeats[dimension_count - 1] - 1;
-    for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-      memcpy(output, copy, block_size);
-      output += block_size;
-    }
-
-    // Tile data for other axes
-    while (input_counters.Increment()) {
-      ptrdiff_t pitch = output_pitches[input_counters.Axis()] * input_shape[input_counters.Axis()];
-      block_size = pitch * element_size;
-      copy = output - block_size;
-      num_repeats = repeats[input_counters.Axis()] - 1;
-      for (int64_t repeat = 0; repeat < num_repeats; ++repeat) {
-        memcpy(output, copy, block_size);
-        output += block_size;
-      }
-    }
-  }
-  return Status::OK();
-}
-
 namespace TileOp {
 // Find the first non-1 repeat and check the input shape to the left of that dimension,
 // if the dim values are 1, then the tiling logic is essentially copying the input buffer
@@ -157,61 +115,33 @@ Status Tile::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
-  // Repeat tensor has all 1s in it
-  if (output_shape == input_shape) {
-    // TODO: Handle string copies when the kernel eventually supports string type.
-    // For now, it shouldn't throw in the enforce as the kernel doesn't claim string support
-    ORT_ENFORCE(!input_tensor.IsDataType<std::string>(), "Tile doesn't support string type yet");
-    memcpy(output_tensor.MutableDataRaw(), input_tensor.DataRaw(), input_tensor.SizeInBytes());
-    return Status::OK();
-  }
-
-  size_t num_of_copies = 1;
-  if (TileOp::IsTileMemcpy(input_shape, repeats, input_rank, num_of_copies)) {
-    // TODO: Handle string copies when the kernel eventually supports string type.
-    // For now, it shouldn't throw in the enforce as the kernel doesn't claim string support
-    ORT_ENFORCE(!input_tensor.IsDataType<std::string>(), "Tile doesn't support string type yet");
-
-    int8_t* output_data_casted = reinterpret_cast<int8_t*>(output_tensor.MutableDataRaw());
-    const void* input_data_raw = input_tensor.DataRaw();
-    size_t tensor_size_in_bytes = input_tensor.SizeInBytes();
-
-    // TODO: Add multi-threading logic if num_of_copies is large enough
-    for (size_t i = 0; i < num_of_copies; ++i) {
-      memcpy(static_cast<void*>(output_data_casted), input_data_raw, tensor_size_in_bytes);
-      output_data_casted += tensor_size_in_bytes;
-    }
+  // TODO: Handle string copies when the kernel eventually supports string type.
+  // For now, it shouldn't throw in the enforce as the kernel doesn't claim string support
+  ORT_ENFORCE(!input_tensor.IsDataType<std::string>(), "Tile doesn't support string type yet");
+
+  // The output is a strided copy of the input with two dims for each axis: the repeats of the axis, which read the
+  // input of the axis from its start again, and the input dim. StridedCopy coalesces them, so e.g. repeating the
+  // whole input is a series of copies of the input buffer.
+  TensorPitches input_pitches(input_shape);
+  TensorPitches output_pitches(output_shape);
+  std::vector<int64_t> dims;
+  std::vector<int64_t> input_strides;
+  std::vector<int64_t> output_strides;
+  dims.reserve(2 * input_rank);
+  input_strides.reserve(2 * input_rank);
+  output_strides.reserve(2 * input_rank);
+  for (size_t axis = 0; axis < input_rank; axis++) {
+    dims.push_back(repeats[axis]);
+    input_strides.push_back(0);
+    output_strides.push_back(input_shape[axis] * output_pitches[axis]);
 
-    return Status::OK();
+    dims.push_back(input_shape[axis]);
+    input_strides.push_back(input_pitches[axis]);
+    output_strides.push_back(output_pitches[axis]);
   }
 
-  TensorAxisCounters input_counters(input_tensor);
-  TensorPitches output_pitches(output_tensor);
-
-  static_assert(sizeof(float) == sizeof(int32_t), "Float and Int32 are of different sizes");
-  static_assert(sizeof(double) == sizeof(int64_t), "Double and Int64 are of different sizes");
-
-  if (input_tensor.IsDataType<float>() ||
-      input_tensor.IsDataType<int32_t>() ||
-      input_tensor.IsDataType<uint32_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(float));
-
-  if (input_tensor.IsDataType<double>() || input_tensor.IsDataType<int64_t>() ||
-      input_tensor.IsDataType<uint64_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(double));
-
-  else if (input_tensor.IsDataType<int8_t>() ||
-           input_tensor.IsDataType<uint8_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(int8_t));
-
-  if (input_tensor.IsDataType<int16_t>() || input_tensor.IsDataType<uint16_t>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(int16_t));
-
-  else if (input_tensor.IsDataType<bool>())
-    return TileCoreForFixedSizeTypes(input_tensor, output_tensor, repeats, input_counters, output_pitches, sizeof(bool));
-
-  // TODO: Support 'string' and 'float16' types for completeness
-  else
-    ORT_THROW("Tile doesn't have an implementation yet for the type: ", input_tensor.DataType());
+  StridedCopy(ctx->GetOperatorThreadPool(), output_tensor.MutableDataRaw(), output_strides,
+              input_tensor.DataRaw(), input_strides, dims, input_tensor.DataType()->Size());
+  return Status::OK();
 }
 }  // namespace onnxruntime
@@ -217,12 +217,14 @@ static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const
   const bool is_string_type = input.IsDataTypeString();
 
   std::vector<size_t> stride(rank);
+  std::vector<int64_t> target_dims(rank);
   for (size_t i = 0; i < rank; i++) {
     size_t inpdim = permutations[i];
     if (inpdim + 1 < rank)
       stride[i] = input_shape.SizeFromDimension(inpdim + 1);
     else
       stride[i] = 1;
+    target_dims[i] = input_dims[inpdim];
   }
 
   // Partition the permutation into a prefix and the largest suffix such that
@@ -249,10 +251,10 @@ static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const
     if (1 == prefix_blocksize) {
       DoTransposeSingleBlock(suffix_blocksize, input_data, output_data);
     } else if (1 == suffix_blocksize) {
-      DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
+      DoTransposeEltWise(num_axes_in_prefix, target_dims, prefix_blocksize, stride,
                          input_data, output_data);
     } else {
-      DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
+      DoTransposeImpl(num_axes_in_prefix, target_dims, prefix_blocksize, suffix_blocksize, stride,
                       input_data, output_data);
     }
   } else {
@@ -261,10 +263,10 @@ static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const
     if (1 == prefix_blocksize) {
       DoTransposeSingleBlock(suffix_blocksize, input_data, output_data, element_size);
     } else if (1 == suffix_blocksize) {
-      DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
+      DoTransposeEltWise(num_axes_in_prefix, target_dims, prefix_blocksize, stride,
                          input_data, output_data, element_size);
     } else {
-      DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
+      DoTransposeImpl(num_axes_in_prefix, target_dims, prefix_blocksize, suffix_blocksize, stride,
                       input_data, output_data, element_size);
     }
   }
@@ -273,324 +275,167 @@ static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const
 }
 
 /*
-Optimizations for moving a single axis either inwards or outwards.
+Optimizations for transposing batches of matrices.
 
-If moving outwards we can use a single reader and multiple writers. The number of writers is equal to the value of
-the axis being moved.
+The permutation is first canonicalized by removing the axes of size 1 and merging the axes that stay adjacent, so
+many permutations reduce to a transpose of batched matrices whose elements are blocks of contiguous data. For example
+a permutation of [0, 3, 1, 2] on an {N, H, W, C} input (NHWC to NCHW) is the transpose of N matrices with H*W rows
+and C columns, and a permutation of [0, 2, 1, 3] on a {B, S, H, D} input is the transpose of B matrices with S rows
+and H columns, where each element is a block of D values.
 
-  e.g. if the input is NHWC with shape {N, 300, 300, 3}, we can transpose to NCHW by reading once and having
-       one writer for each of the 3 channels at a different offset in the output, updating the offset for each item
-       in the batch of N.
+If the block size is 1, 2, 4 or 8 bytes the matrices are transposed by MLAS using cache tiles and SIMD when available.
+Larger blocks are copied with memcpy. The work is parallelized across the matrices, or within the matrix by MLAS.
 
-Similarly if one axis is moving inwards we can use a single writer and multiple readers. The number of readers is equal
-to the value of the axis being moved.
-
-  e.g. if the input is NCHW with shape {N, 3, 300, 300}, we can transpose to NHWC by writing once using one reader for
-       each of the 3 channels at a different offset in the input, updating the read offset for each item in the batch
-       of N.
-
-This can be generalized for any input where only one axis is being moved, with the block size for each read/write
-being dependent on which axis is moving, what direction it's moving in, and where it's moving to.
-
-We use simple pointer arithmetic if the size of each read/write is a power of 2 and between 8 and 64 bits.
-We use memcpy if the block size is larger.
-
-We fall back to the default implementation in all other cases, and if the input is std::string.
+We fall back to the default implementation for other permutations, and if the input is std::string.
 */
 
-// moving a single axis outwards where the read/write size is a power of 2 and between 8 and 64 bits.
-template <typename T>
-static void SimpleTransposeSingleAxisOutwards(const T* input_data, T* output_data,
-                                              int64_t num_loops, int64_t num_writers,
-                                              int64_t writes_per_loop, int64_t writes_per_writer_per_loop) {
-  const T* end;
-  for (int64_t l = 0; l < num_loops; ++l) {
-    T* output_for_first_writer = output_data;
-
-    for (auto wwpl = 0; wwpl < writes_per_writer_per_loop; ++wwpl) {
-      T* output_for_current_writer = output_for_first_writer;
-
-      end = input_data + num_writers;
-      for (; input_data != end;) {
-        *output_for_current_writer = *input_data++;
+void CanonicalizeTranspose(std::vector<size_t>& permutations, std::vector<int64_t>& input_dims) {
+  const size_t rank = input_dims.size();
 
-        // skip to output position for next writer
-        output_for_current_writer += writes_per_writer_per_loop;
-      }
-
-      ++output_for_first_writer;
+  // renumber the input axes that are not of size 1
+  std::vector<size_t> new_axis(rank);
+  std::vector<int64_t> dims;
+  for (size_t i = 0; i < rank; ++i) {
+    new_axis[i] = dims.size();
+    if (input_dims[i] != 1) {
+      dims.push_back(input_dims[i]);
     }
-
-    output_data += writes_per_loop;
   }
-}
 
-static void SimpleTransposeSingleAxisOutwards(const uint8_t* input_data, uint8_t* output_data,
-                                              int64_t num_loops, int64_t num_writers,
-                                              int64_t writes_per_loop, int64_t writes_per_writer_per_loop) {
-  for (int64_t l = 0; l < num_loops; ++l) {
-    MlasTranspose(input_data,
-                  output_data,
-                  static_cast<size_t>(writes_per_writer_per_loop),
-                  static_cast<size_t>(num_writers));
-    input_data += writes_per_loop;
-    output_data += writes_per_loop;
+  std::vector<size_t> perm;
+  for (size_t i = 0; i < rank; ++i) {
+    if (input_dims[permutations[i]] != 1) {
+      perm.push_back(new_axis[permutations[i]]);
+    }
   }
-}
-
-//  `input_shape_override` overrides the shape of `input` for compute purposes.
-static void TransposeSingleAxisOutwards(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                        int64_t from, int64_t to, const TensorShape* input_shape_override = nullptr) {
-  ORT_UNUSED_PARAMETER(permutations);
 
-  const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
-  const auto& input_dims = input_shape.GetDims();
-
-  const auto element_size = input.DataType()->Size();
-
-  const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
-  auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
-
-  auto num_loops = input_shape.SizeToDimension(to);
-  auto num_writers = input_dims[from];
-  auto block_size = input_shape.SizeFromDimension(from + 1);
-  auto writes_per_loop = int64_t(input_shape.Size() / num_loops / block_size);
-  auto writes_per_writer_per_loop = int64_t(writes_per_loop / num_writers);
-  const int64_t bytes_per_write = block_size * element_size;
-
-  switch (bytes_per_write) {
-    case (sizeof(uint8_t)): {
-      SimpleTransposeSingleAxisOutwards(input_data, output_data,
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint16_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint16_t*>(input_data),
-                                        reinterpret_cast<uint16_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint32_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint32_t*>(input_data),
-                                        reinterpret_cast<uint32_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
-    }
-    case (sizeof(uint64_t)): {
-      SimpleTransposeSingleAxisOutwards(reinterpret_cast<const uint64_t*>(input_data),
-                                        reinterpret_cast<uint64_t*>(output_data),
-                                        num_loops, num_writers, writes_per_loop, writes_per_writer_per_loop);
-      break;
+  // an output axis that reads the input axis following the one read by the previous output axis merges with it
+  std::vector<bool> merged(dims.size(), false);
+  for (size_t i = 1; i < perm.size(); ++i) {
+    if (perm[i] == perm[i - 1] + 1) {
+      merged[perm[i]] = true;
     }
-    default: {
-      // we need to use memcpy for each block
-      for (int64_t l = 0; l < num_loops; ++l) {
-        uint8_t* output_for_first_writer = output_data;
-
-        for (auto wwpl = 0; wwpl < writes_per_writer_per_loop; ++wwpl) {
-          uint8_t* output_for_current_writer = output_for_first_writer;
-
-          for (int64_t w = 0; w < num_writers; ++w) {
-            memcpy(output_for_current_writer, input_data, bytes_per_write);
-            // skip to output position for next writer
-            output_for_current_writer += (writes_per_writer_per_loop * bytes_per_write);
-            input_data += bytes_per_write;
-          }
-
-          output_for_first_writer += bytes_per_write;
-        }
+  }
 
-        output_data += writes_per_loop * bytes_per_write;
-      }
+  std::vector<size_t> merged_axis(dims.size());
+  input_dims.clear();
+  for (size_t i = 0; i < dims.size(); ++i) {
+    if (merged[i]) {
+      input_dims.back() *= dims[i];
+    } else {
+      input_dims.push_back(dims[i]);
     }
+    merged_axis[i] = input_dims.size() - 1;
   }
-}
 
-template <typename T>
-static void SimpleTransposeSingleAxisInwards(const T* input_data, T* output_data,
-                                             int64_t num_loops, int64_t num_readers,
-                                             int64_t reads_per_loop, int64_t reads_per_reader_per_loop) {
-  T* end;
-  for (int64_t l = 0; l < num_loops; ++l) {
-    const T* input_for_first_reader = input_data;
-
-    for (auto rrpl = 0; rrpl < reads_per_reader_per_loop; ++rrpl) {
-      const T* input_for_current_reader = input_for_first_reader;
-
-      end = output_data + num_readers;
-      for (; output_data != end;) {
-        *output_data++ = *input_for_current_reader;
-        // skip to input position for next reader
-        input_for_current_reader += reads_per_reader_per_loop;
-      }
-
-      ++input_for_first_reader;
+  permutations.clear();
+  for (size_t i = 0; i < perm.size(); ++i) {
+    if (!merged[perm[i]]) {
+      permutations.push_back(merged_axis[perm[i]]);
     }
-
-    input_data += reads_per_loop;
   }
 }
 
-static void SimpleTransposeSingleAxisInwards(const uint8_t* input_data, uint8_t* output_data,
-                                             int64_t num_loops, int64_t num_readers,
-                                             int64_t reads_per_loop, int64_t reads_per_reader_per_loop) {
-  for (int64_t l = 0; l < num_loops; ++l) {
-    MlasTranspose(input_data,
-                  output_data,
-                  static_cast<size_t>(num_readers),
-                  static_cast<size_t>(reads_per_reader_per_loop));
-    input_data += reads_per_loop;
-    output_data += reads_per_loop;
+// Transposes num_matrices matrices of rows x cols elements, with elements of type T.
+template <typename T>
+static void TransposeMatrices(const uint8_t* input_data, uint8_t* output_data, size_t num_matrices,
+                              size_t rows, size_t cols, concurrency::ThreadPool* tp) {
+  const auto* input = reinterpret_cast<const T*>(input_data);
+  auto* output = reinterpret_cast<T*>(output_data);
+  const size_t matrix_size = rows * cols;
+
+  // MLAS parallelizes large matrices, smaller ones are parallelized across the matrices
+  if (num_matrices == 1 || matrix_size >= 64 * 1024) {
+    for (size_t i = 0; i < num_matrices; ++i) {
+      MlasTranspose(input + i * matrix_size, output + i * matrix_size, rows, cols, tp);
+    }
+  } else {
+    const double bytes = static_cast<double>(matrix_size * sizeof(T));
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(num_matrices), TensorOpCost{bytes, bytes, static_cast<double>(matrix_size)},
+        [input, output, matrix_size, rows, cols](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            MlasTranspose(input + i * matrix_size, output + i * matrix_size, rows, cols, nullptr);
+          }
+        });
   }
 }
 
-// moving a single axis inwards where the read/write size is a power of 2 and between 8 and 64 bits.
-//  `input_shape_override` overrides the shape of `input` for compute purposes.
-static void TransposeSingleAxisInwards(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                       int64_t from, int64_t to, const TensorShape* input_shape_override = nullptr) {
-  ORT_UNUSED_PARAMETER(permutations);
-
-  const auto& input_shape = input_shape_override ? *input_shape_override : input.Shape();
-  const auto& input_dims = input_shape.GetDims();
-
-  const auto element_size = input.DataType()->Size();
-
-  const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
-  auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
-
-  auto num_loops = input_shape.SizeToDimension(from);
-  auto num_readers = input_dims[from];
-  auto block_size = input_shape.SizeFromDimension(to + 1);
-  auto reads_per_loop = int64_t(input_shape.Size() / num_loops / block_size);
-  auto reads_per_reader_per_loop = int64_t(reads_per_loop / num_readers);
-  const int64_t bytes_per_read = block_size * element_size;
-
-  switch (bytes_per_read) {
-    case (sizeof(uint8_t)): {
-      SimpleTransposeSingleAxisInwards(input_data, output_data,
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
-      break;
-    }
-    case (sizeof(uint16_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint16_t*>(input_data),
-                                       reinterpret_cast<uint16_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
-      break;
-    }
-    case (sizeof(uint32_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint32_t*>(input_data),
-                                       reinterpret_cast<uint32_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
-      break;
-    }
-    case (sizeof(uint64_t)): {
-      SimpleTransposeSingleAxisInwards(reinterpret_cast<const uint64_t*>(input_data),
-                                       reinterpret_cast<uint64_t*>(output_data),
-                                       num_loops, num_readers, reads_per_loop, reads_per_reader_per_loop);
+// Transposes num_matrices matrices of rows x cols elements, where each element is a block of block_size bytes.
+static void TransposeBlockMatrices(const uint8_t* input_data, uint8_t* output_data, size_t num_matrices,
+                                   size_t rows, size_t cols, size_t block_size, concurrency::ThreadPool* tp) {
+  switch (block_size) {
+    case sizeof(uint8_t):
+      TransposeMatrices<uint8_t>(input_data, output_data, num_matrices, rows, cols, tp);
+      return;
+    case sizeof(uint16_t):
+      TransposeMatrices<uint16_t>(input_data, output_data, num_matrices, rows, cols, tp);
+      return;
+    case sizeof(uint32_t):
+      TransposeMatrices<uint32_t>(input_data, output_data, num_matrices, rows, cols, tp);
+      return;
+    case sizeof(uint64_t):
+      TransposeMatrices<uint64_t>(input_data, output_data, num_matrices, rows, cols, tp);
+      return;
+    default:
       break;
-    }
-    default: {
-      // we need to use memcpy for each block
-      for (int64_t l = 0; l < num_loops; ++l) {
-        const uint8_t* input_for_first_reader = input_data;
-
-        for (auto rrpl = 0; rrpl < reads_per_reader_per_loop; ++rrpl) {
-          const uint8_t* input_for_current_reader = input_for_first_reader;
-
-          for (int64_t r = 0; r < num_readers; ++r) {
-            memcpy(output_data, input_for_current_reader, bytes_per_read);
-            output_data += bytes_per_read;
+  }
 
-            // skip to input position for next reader
-            input_for_current_reader += (reads_per_reader_per_loop * bytes_per_read);
+  // we need to use memcpy for each block. each output row of a matrix is a unit of work.
+  const double row_bytes = static_cast<double>(rows * block_size);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_matrices * cols), TensorOpCost{row_bytes, row_bytes, static_cast<double>(rows)},
+      [input_data, output_data, rows, cols, block_size](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t output_row = first; output_row < last; ++output_row) {
+          const size_t matrix = static_cast<size_t>(output_row) / cols;
+          const size_t col = static_cast<size_t>(output_row) % cols;
+          const uint8_t* input = input_data + ((matrix * rows) * cols + col) * block_size;
+          uint8_t* output = output_data + static_cast<size_t>(output_row) * rows * block_size;
+          for (size_t row = 0; row < rows; ++row) {
+            memcpy(output, input, block_size);
+            input += cols * block_size;
+            output += block_size;
           }
-
-          input_for_first_reader += bytes_per_read;
         }
-
-        input_data += reads_per_loop * bytes_per_read;
-      }
-    }
-  }
+      });
 }
 
-//  `input_shape_override` overrides the shape of `input` for compute purposes.
-static void SingleAxisTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                size_t from, size_t to, const TensorShape* input_shape_override = nullptr) {
-  if (from > to) {
-    TransposeSingleAxisOutwards(permutations, input, output, from, to, input_shape_override);
+// Transposes the input if the canonical permutation is a transpose of batched matrices.
+// Returns false if the permutation needs the default implementation.
+static bool TryTransposeBatchedMatrices(const std::vector<size_t>& permutations, const std::vector<int64_t>& input_dims,
+                                        const Tensor& input, Tensor& output, concurrency::ThreadPool* tp) {
+  // the canonical permutations of batched matrices are [1, 0], [0, 2, 1], [1, 0, 2] and [0, 2, 1, 3]
+  size_t num_matrices = 1;
+  size_t rows;
+  size_t cols;
+  size_t block_elements = 1;
+
+  const size_t rank = permutations.size();
+  if (rank == 2 && permutations[0] == 1 && permutations[1] == 0) {
+    rows = static_cast<size_t>(input_dims[0]);
+    cols = static_cast<size_t>(input_dims[1]);
+  } else if (rank == 3 && permutations[0] == 0 && permutations[1] == 2 && permutations[2] == 1) {
+    num_matrices = static_cast<size_t>(input_dims[0]);
+    rows = static_cast<size_t>(input_dims[1]);
+    cols = static_cast<size_t>(input_dims[2]);
+  } else if (rank == 3 && permutations[0] == 1 && permutations[1] == 0 && permutations[2] == 2) {
+    rows = static_cast<size_t>(input_dims[0]);
+    cols = static_cast<size_t>(input_dims[1]);
+    block_elements = static_cast<size_t>(input_dims[2]);
+  } else if (rank == 4 && permutations[0] == 0 && permutations[1] == 2 && permutations[2] == 1 &&
+             permutations[3] == 3) {
+    num_matrices = static_cast<size_t>(input_dims[0]);
+    rows = static_cast<size_t>(input_dims[1]);
+    cols = static_cast<size_t>(input_dims[2]);
+    block_elements = static_cast<size_t>(input_dims[3]);
   } else {
-    TransposeSingleAxisInwards(permutations, input, output, from, to, input_shape_override);
-  }
-}
-
-static bool IsMovingSingleAxis(const std::vector<size_t>& permutations, size_t& from, size_t& to) {
-  // if a single axis moved to an outer dimension, the values should be one lower than the index until the slot the
-  // axis was moved from, and equal to the index after that.
-  // e.g. axis 3 moves out to 1 would be: 0, 3, 1, 2, 4
-  auto check_moved_outwards = [&permutations](size_t cur, size_t moved_from) {
-    // we start processing with the slot after the moved one, so the expected value is one less than the index
-    size_t expected = cur - 1;
-    for (size_t end = permutations.size(); cur < end; ++cur) {
-      if (permutations[cur] != expected) {
-        return false;
-      }
-
-      // we are at the slot the axis moved from, so do an additional increment before checking the next value
-      if (cur == moved_from) {
-        ++expected;
-      }
-
-      ++expected;
-    }
-
-    return true;
-  };
-
-  // if a single axis moved to an inner dimension, the values should be one higher than the index until the slot the
-  // axis was moved to, and equal to the index after that.
-  // e.g. axis 1 moves inwards to 3 would be: 0, 2, 3, 1, 4
-  auto check_moved_inwards = [&permutations](size_t cur, size_t& moved_to) {
-    size_t started_at = cur;
-    size_t expected = cur + 1;
-    moved_to = std::numeric_limits<size_t>::max();
-
-    for (size_t end = permutations.size(); cur < end; ++cur) {
-      if (permutations[cur] != expected) {
-        // if a single axis moved it must have come from the location we started at
-        if (started_at != permutations[cur]) {
-          return false;
-        }
-
-        moved_to = cur;
-      } else {
-        ++expected;
-      }
-    }
-
-    return moved_to != std::numeric_limits<size_t>::max();
-  };
-
-  bool single_axis_moved = false;
-  // check axis moving outwards (earlier entry in permutations)
-  for (size_t i = 0, end = permutations.size(); i < end; ++i) {
-    size_t axis = permutations[i];
-
-    if (axis != i) {
-      if (check_moved_outwards(i + 1, axis)) {
-        single_axis_moved = true;
-        to = i;
-        from = axis;
-      } else if (check_moved_inwards(i, to)) {
-        single_axis_moved = true;
-        from = i;
-      }
-
-      break;
-    }
+    return false;
   }
 
-  return single_axis_moved;
+  TransposeBlockMatrices(reinterpret_cast<const uint8_t*>(input.DataRaw()),
+                         reinterpret_cast<uint8_t*>(output.MutableDataRaw()),
+                         num_matrices, rows, cols, block_elements * input.DataType()->Size(), tp);
+  return true;
 }
 
 bool IsTransposeReshape(const std::vector<size_t>& perm, const std::vector<int64_t>& input_dims) {
@@ -609,36 +454,39 @@ bool IsTransposeReshape(const std::vector<size_t>& perm, const std::vector<int64
 
 //`input_shape_override` overrides the shape of `input` for compute purposes.
 Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                                  const TensorShape* input_shape_override) {
-  Status status = Status::OK();
-
+                                  const TensorShape* input_shape_override, concurrency::ThreadPool* tp) {
   auto input_type = input.DataType();
   auto output_type = output.DataType();
 
   if (input_type != output_type) {
-    status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Mismatched data types between input and output Tensors. ",
-                             input_type, " != ", output_type);
-  } else {
-    TensorShape shape = input_shape_override ? *input_shape_override : input.Shape();
-    if (IsTransposeReshape(permutations, shape.GetDims())) {
-      // As long as the dims with values > 1 stay in the same order, it's a reshape.
-      // Example: Shape=(1,1,1024,4096) -> perm=(2,0,3,1).
-      CopyCpuTensor(&input, &output);
-      return Status::OK();
-    }
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Mismatched data types between input and output Tensors. ",
+                           input_type, " != ", output_type);
+  }
 
-    size_t from = 0, to = 0;
-    bool moving_single_axis = IsMovingSingleAxis(permutations, from, to);
+  const TensorShape& shape = input_shape_override ? *input_shape_override : input.Shape();
+  if (shape.Size() == 0) {
+    return Status::OK();
+  }
 
-    if (moving_single_axis && !input.IsDataTypeString()) {
-      SingleAxisTranspose(permutations, input, output, from, to, input_shape_override);
-    } else {
-      // fall back to default implementation
-      status = DoUntypedTranspose(permutations, input, output, input_shape_override);
-    }
+  if (IsTransposeReshape(permutations, shape.GetDims())) {
+    // As long as the dims with values > 1 stay in the same order, it's a reshape.
+    // Example: Shape=(1,1,1024,4096) -> perm=(2,0,3,1).
+    CopyCpuTensor(&input, &output);
+    return Status::OK();
   }
 
-  return status;
+  std::vector<size_t> canonical_permutations(permutations);
+  std::vector<int64_t> canonical_dims(shape.GetDims());
+  CanonicalizeTranspose(canonical_permutations, canonical_dims);
+
+  if (!input.IsDataTypeString() &&
+      TryTransposeBatchedMatrices(canonical_permutations, canonical_dims, input, output, tp)) {
+    return Status::OK();
+  }
+
+  // fall back to default implementation
+  const TensorShape canonical_shape(canonical_dims);
+  return DoUntypedTranspose(canonical_permutations, input, output, &canonical_shape);
 }
 
 Status Transpose::Compute(OpKernelContext* ctx) const {
@@ -659,27 +507,7 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
   TensorShape output_shape{output_dims};
   Tensor& Y = *ctx->Output(0, output_shape);
 
-  if (output_shape.Size() == 0)
-    return Status::OK();
-
-  if (IsTransposeReshape(*p_perm, input_dims)) {
-    // As long as the dims with values > 1 stay in the same order, it's a reshape.
-    // Example: Shape=(1,1,1024,4096) -> perm=(2,0,3,1).
-    CopyCpuTensor(&X, &Y);
-    return Status::OK();
-  }
-
-  size_t from = 0, to = 0;
-  bool moving_single_axis = IsMovingSingleAxis(*p_perm, from, to);
-
-  if (moving_single_axis && !X.IsDataTypeString()) {
-    SingleAxisTranspose(*p_perm, X, Y, from, to);
-  } else {
-    // fall back to default implementation
-    status = DoUntypedTranspose(*p_perm, X, Y);
-  }
-
-  return status;
+  return DoTranspose(*p_perm, X, Y, nullptr, ctx->GetOperatorThreadPool());
 }
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
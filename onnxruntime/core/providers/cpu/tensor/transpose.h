@@ -16,6 +16,12 @@ namespace onnxruntime {
 */
 bool IsTransposeReshape(const std::vector<size_t>& perm, const std::vector<int64_t>& input_dims);
 
+/** Removes the axes of size 1 and merges the axes that are adjacent in both the input and the output,
+ e.g. perm=(0,3,1,2) of the shape (N,H,W,C) becomes perm=(0,2,1) of the shape (N,H*W,C).
+ `perm` and `input_dims` are replaced by the canonical permutation and input dims.
+*/
+void CanonicalizeTranspose(std::vector<size_t>& perm, std::vector<int64_t>& input_dims);
+
 void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& target_dims, size_t num_blocks,
                         const std::vector<size_t>& stride, const uint8_t* source, uint8_t* target,
                         size_t element_size);
@@ -25,9 +31,11 @@ class TransposeBase {
   /**
   Transpose the input Tensor into the output Tensor using the provided permutations.
   Both Tensors must have the same data type. `input_shape_override` overrides the shape of `input` for compute purposes.
+  The transpose is parallelized if `tp` is provided.
   */
   static Status DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
-                            const TensorShape* input_shape_override = nullptr);
+                            const TensorShape* input_shape_override = nullptr,
+                            concurrency::ThreadPool* tp = nullptr);
 
  protected:
   TransposeBase(const OpKernelInfo& info) {
@@ -3,9 +3,15 @@
 
 #include "core/providers/cpu/tensor/unique.h"
 
+#include <algorithm>
+#include <cmath>
 #include <map>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
 #include "gsl/gsl"
 #include "core/providers/common.h"
+#include "core/providers/cpu/parallel_scan.h"
 
 namespace onnxruntime {
 
@@ -129,13 +135,46 @@ class Subtensor {
   std::vector<T> items_;
 };
 
+// Hash, equality and order of the values of a flattened input. The NaNs are equal to each other and ordered after the
+// other values, so the flattened input has at most one unique NaN.
+template <typename T>
+struct UniqueValueHash {
+  size_t operator()(const T& value) const { return std::hash<T>{}(value); }
+};
+
+template <>
+struct UniqueValueHash<float> {
+  size_t operator()(float value) const { return std::isnan(value) ? size_t{0x7fc00000} : std::hash<float>{}(value); }
+};
+
+template <typename T>
+struct UniqueValueEqual {
+  bool operator()(const T& lhs, const T& rhs) const { return lhs == rhs; }
+};
+
+template <>
+struct UniqueValueEqual<float> {
+  bool operator()(float lhs, float rhs) const { return lhs == rhs || (std::isnan(lhs) && std::isnan(rhs)); }
+};
+
+template <typename T>
+struct UniqueValueLess {
+  bool operator()(const T& lhs, const T& rhs) const { return lhs < rhs; }
+};
+
+template <>
+struct UniqueValueLess<float> {
+  bool operator()(float lhs, float rhs) const { return std::isnan(rhs) ? !std::isnan(lhs) : lhs < rhs; }
+};
+
 template <typename T>
 static void CreateFlattenedOutput(OpKernelContext& context,
-                                  const std::map<const T, int64_t>& offsets,         // map sorted key to unsorted idx
-                                  const std::vector<std::vector<int64_t>>& indices,  // unsorted
-                                  const std::vector<int64_t>& inverse_index,         // unsorted
+                                  const std::vector<T>& unique_values,        // in the order of first occurrence
+                                  const std::vector<int64_t>& first_indices,  // unsorted
+                                  const std::vector<int64_t>& value_counts,   // unsorted
+                                  const std::vector<int64_t>& inverse_index,  // unsorted
                                   bool sorted) {
-  int64_t num_unique = static_cast<int64_t>(indices.size());
+  int64_t num_unique = static_cast<int64_t>(unique_values.size());
   Tensor& Y = *context.Output(0, {num_unique});
   Tensor* indices_out = context.Output(1, {num_unique});
   Tensor* inverse_indices = context.Output(2, {static_cast<int64_t>(inverse_index.size())});
@@ -149,21 +188,26 @@ static void CreateFlattenedOutput(OpKernelContext& context,
   gsl::span<int64_t> counts_data = counts != nullptr ? counts->MutableDataAsSpan<int64_t>()
                                                      : gsl::span<int64_t>();
 
-  // iterate using 'offsets' which is sorted, but contains the offset of the unsorted entry
-  auto offsets_iter = offsets.begin();
-  for (int64_t i = 0, end = num_unique; i < end; ++i, ++offsets_iter) {
-    // write sequentially if we want sorted output, use the unsorted_idx if not
-    auto unsorted_idx = offsets_iter->second;
-    auto output_idx = sorted ? i : unsorted_idx;
+  // the unsorted indices in the order of the output
+  std::vector<int64_t> order(static_cast<size_t>(num_unique));
+  std::iota(order.begin(), order.end(), int64_t{0});
+  if (sorted) {
+    std::sort(order.begin(), order.end(), [&unique_values](int64_t lhs, int64_t rhs) {
+      return UniqueValueLess<T>{}(unique_values[lhs], unique_values[rhs]);
+    });
+  }
+
+  for (int64_t i = 0, end = num_unique; i < end; ++i) {
+    auto unsorted_idx = order[i];
 
-    Y_data[output_idx] = offsets_iter->first;
+    Y_data[i] = unique_values[unsorted_idx];
 
     if (indices_out) {
-      indices_data[output_idx] = indices[unsorted_idx].front();
+      indices_data[i] = first_indices[unsorted_idx];
     }
 
     if (counts) {
-      counts_data[output_idx] = indices[unsorted_idx].size();
+      counts_data[i] = value_counts[unsorted_idx];
     }
   }
 
@@ -172,9 +216,8 @@ static void CreateFlattenedOutput(OpKernelContext& context,
       // need to convert unsorted entries in the inverse index to their sorted values
       std::vector<int64_t> unsorted_to_sorted;
       unsorted_to_sorted.resize(num_unique);
-      int64_t sorted_idx = 0;
-      for (const auto& offset : offsets) {
-        unsorted_to_sorted[offset.second] = sorted_idx++;
+      for (int64_t i = 0; i < num_unique; ++i) {
+        unsorted_to_sorted[order[i]] = i;
       }
 
       for (size_t i = 0, end = inverse_index.size(); i < end; ++i) {
@@ -289,30 +332,48 @@ Status Unique::ComputeImpl(OpKernelContext& context) const {
   auto data = input.DataAsSpan<T>();
 
   if (flatten_) {
-    std::map<const T, int64_t> offsets;  // offset of entry in indices. provides map between sorted and unsorted values
-    std::vector<std::vector<int64_t>> indices;
-    std::vector<int64_t> inverse_index;
-
-    indices.reserve(data.size() / 2);  // arbitrary value. at worst 1 realloc but could be too large
-    inverse_index.reserve(data.size());
-
-    int64_t num_unique = 0;
+    const int64_t num_values = input.Shape().Size();
+    ParallelScan scan(context.GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_values));
+
+    // the indices of the first occurrences of the distinct values of each block, found in parallel
+    std::vector<std::vector<int64_t>> block_first_indices(static_cast<size_t>(scan.NumBlocks()));
+    scan.ForEachBlock([&](std::ptrdiff_t block, std::ptrdiff_t begin, std::ptrdiff_t end) {
+      std::unordered_set<T, UniqueValueHash<T>, UniqueValueEqual<T>> block_values;
+      auto& first_indices = block_first_indices[block];
+      for (std::ptrdiff_t i = begin; i < end; ++i) {
+        if (block_values.insert(data[i]).second) {
+          first_indices.push_back(i);
+        }
+      }
+    });
+
+    // merging the blocks in order keeps the unique values in the order of their first occurrence in the input
+    std::unordered_map<T, int64_t, UniqueValueHash<T>, UniqueValueEqual<T>> offsets;  // offset of the unique value
+    std::vector<T> unique_values;
+    std::vector<int64_t> first_indices;
+    for (const auto& block_indices : block_first_indices) {
+      for (int64_t i : block_indices) {
+        if (offsets.emplace(data[i], static_cast<int64_t>(unique_values.size())).second) {
+          unique_values.push_back(data[i]);
+          first_indices.push_back(i);
+        }
+      }
+    }
 
-    for (int64_t i = 0, end = input.Shape().Size(); i < end; ++i) {
-      auto entry = offsets.find(data[i]);
-      if (entry == offsets.end()) {
-        offsets[data[i]] = num_unique;
-        inverse_index.push_back({num_unique});
-        indices.push_back({i});
-        ++num_unique;
-      } else {
-        size_t indices_idx = entry->second;
-        indices[indices_idx].push_back(i);
-        inverse_index.push_back(indices_idx);
+    // the inverse index is looked up for the blocks in parallel
+    std::vector<int64_t> inverse_index(static_cast<size_t>(num_values));
+    scan.ForEachBlock([&](std::ptrdiff_t /*block*/, std::ptrdiff_t begin, std::ptrdiff_t end) {
+      for (std::ptrdiff_t i = begin; i < end; ++i) {
+        inverse_index[i] = offsets.find(data[i])->second;
       }
+    });
+
+    std::vector<int64_t> counts(unique_values.size(), 0);
+    for (int64_t idx : inverse_index) {
+      ++counts[idx];
     }
 
-    CreateFlattenedOutput(context, offsets, indices, inverse_index, sort_);
+    CreateFlattenedOutput(context, unique_values, first_indices, counts, inverse_index, sort_);
   } else {
     const auto& input_shape = input.Shape();
     const int64_t input_dims = static_cast<int64_t>(input_shape.NumDimensions());
@@ -4,6 +4,7 @@
 #include "core/common/safeint.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/upsample.h"
+#include <algorithm>
 #include <sstream>
 
 using namespace onnxruntime::common;
@@ -297,69 +298,29 @@ Status UpsampleLinear(const T* input,
   return Status::OK();
 }
 
-// The following method supports a 4-D input in 'Linear mode'
-// that amounts to 'Bilinear' Upsampling/Resizing in the sense that it assumes
-// the scale values for the outermost 2 dimensions are 1.
-// This is the common use-case where the 4-D input (batched multi-channel images)
-// is usually of shape [N, C, H, W] and the scales are [1.0, 1.0, height_scale, width_scale]
-template <typename T>
-void UpsampleBilinear(int64_t batch_size,
-                      int64_t num_channels,
-                      int64_t input_height,
-                      int64_t input_width,
-                      int64_t output_height,
-                      int64_t output_width,
-                      float height_scale,
-                      float width_scale,
-                      const std::vector<float>& roi,
-                      bool use_extrapolation,
-                      float extrapolation_value,
-                      const T* XdataBase,
-                      T* YdataBase,
-                      AllocatorPtr& alloc,
-                      GetOriginalCoordinateFunc get_original_coordinate,
-                      concurrency::ThreadPool* tp) {
-  std::vector<float> y_original;
-  y_original.reserve(output_height);
-
-  std::vector<float> x_original;
-  x_original.reserve(output_width);
-
-  // For each index in the output height and output width, cache its corresponding indices in the input
-  // while multiplying it with the input stride for that dimension (cache because we don't have to re-compute
-  // each time we come across the output width/ output height value while iterating the output image tensor
-  SafeInt<size_t> idx_buffer_size = SafeInt<size_t>(2) * sizeof(int64_t) * (output_height + output_width);
-
-  // For each index in the output height and output width, cache its corresponding "weights/scales" for its
-  // corresponding indices in the input which proportionately indicates how much they will influence the final
-  // pixel value in the output
-  // (cache because we don't have to re-compute each time we come across the output width/ output height value while iterating the output image tensor
-  SafeInt<size_t> scale_buffer_size = SafeInt<size_t>(2) * sizeof(float_t) * (output_height + output_width);
-
-  // Limit number of allocations to just 1
-  auto inx_scale_data_buffer = alloc->Alloc(idx_buffer_size + scale_buffer_size);
-  BufferUniquePtr idx_scale_data_buffer_holder(inx_scale_data_buffer, BufferDeleter(alloc));
-
-  // Get pointers to appropriate memory locations in the scratch buffer
-  auto* idx_data = static_cast<int64_t*>(idx_scale_data_buffer_holder.get());
-
-  // input_width is the stride for the height dimension
-  int64_t* input_width_mul_y1 = idx_data;
-  int64_t* input_width_mul_y2 = input_width_mul_y1 + output_height;
-
-  // stride for width is 1 (no multiplication needed)
-  int64_t* in_x1 = input_width_mul_y1 + 2 * output_height;
-  int64_t* in_x2 = in_x1 + output_width;
+BilinearParams SetupUpsampleBilinear(int64_t input_height,
+                                     int64_t input_width,
+                                     int64_t output_height,
+                                     int64_t output_width,
+                                     float height_scale,
+                                     float width_scale,
+                                     const std::vector<float>& roi,
+                                     const GetOriginalCoordinateFunc& get_original_coordinate) {
+  BilinearParams p;
+
+  p.y_original.reserve(output_height);
+  p.x_original.reserve(output_width);
+
+  p.input_width_mul_y1.resize(output_height);
+  p.input_width_mul_y2.resize(output_height);
+  p.dy1.resize(output_height);
+  p.dy2.resize(output_height);
+
+  p.in_x1.resize(output_width);
+  p.in_x2.resize(output_width);
+  p.dx1.resize(output_width);
+  p.dx2.resize(output_width);
 
-  auto* scale_data = reinterpret_cast<float*>(in_x2 + output_width);
-
-  float* dy1 = scale_data;
-  float* dy2 = dy1 + output_height;
-
-  float* dx1 = dy1 + 2 * output_height;
-  float* dx2 = dx1 + output_width;
-
-  // Start processing
   auto roi_y_start = roi.size() / 2 - 2;
   auto roi_y_end = roi.size() - 2;
   for (int64_t y = 0; y < output_height; ++y) {
@@ -368,21 +329,22 @@ void UpsampleBilinear(int64_t batch_size,
                                                              static_cast<float>(output_height),
                                                              static_cast<float>(input_height),
                                                              roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
+    p.y_original.emplace_back(in_y);
     in_y = std::max(0.0f, std::min(in_y, static_cast<float>(input_height - 1)));
 
     const int64_t in_y1 = std::min(static_cast<int64_t>(in_y), input_height - 1);
     const int64_t in_y2 = std::min(in_y1 + 1, input_height - 1);
-    dy1[y] = std::fabs(in_y - in_y1);
-    dy2[y] = std::fabs(in_y - in_y2);
+    p.dy1[y] = std::fabs(in_y - in_y1);
+    p.dy2[y] = std::fabs(in_y - in_y2);
 
     if (in_y1 == in_y2) {
-      dy1[y] = 0.5f;
-      dy2[y] = 0.5f;
+      p.dy1[y] = 0.5f;
+      p.dy2[y] = 0.5f;
     }
 
-    input_width_mul_y1[y] = input_width * in_y1;
-    input_width_mul_y2[y] = input_width * in_y2;
+    // input_width is the stride for the height dimension
+    p.input_width_mul_y1[y] = input_width * in_y1;
+    p.input_width_mul_y2[y] = input_width * in_y2;
   }
 
   auto roi_x_start = roi.size() / 2 - 1;
@@ -394,51 +356,95 @@ void UpsampleBilinear(int64_t batch_size,
                                                             static_cast<float>(output_width),
                                                             static_cast<float>(input_width),
                                                             roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
+    p.x_original.emplace_back(in_x);
     in_x = std::max(0.0f, std::min(in_x, static_cast<float>(input_width - 1)));
 
-    in_x1[x] = std::min(static_cast<int64_t>(in_x), input_width - 1);
-    in_x2[x] = std::min(in_x1[x] + 1, input_width - 1);
+    // stride for width is 1 (no multiplication needed)
+    p.in_x1[x] = std::min(static_cast<int64_t>(in_x), input_width - 1);
+    p.in_x2[x] = std::min(p.in_x1[x] + 1, input_width - 1);
 
-    dx1[x] = std::fabs(in_x - in_x1[x]);
-    dx2[x] = std::fabs(in_x - in_x2[x]);
-    if (in_x1[x] == in_x2[x]) {
-      dx1[x] = 0.5f;
-      dx2[x] = 0.5f;
+    p.dx1[x] = std::fabs(in_x - p.in_x1[x]);
+    p.dx2[x] = std::fabs(in_x - p.in_x2[x]);
+    if (p.in_x1[x] == p.in_x2[x]) {
+      p.dx1[x] = 0.5f;
+      p.dx2[x] = 0.5f;
     }
   }
-  
- for (int64_t n = 0; n < batch_size; ++n) {
-    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_channels,
-                                                  [&](std::ptrdiff_t c) {
-                                                    const T* Xdata = XdataBase + (n * num_channels + c) * (input_height * input_width);
-                                                    T* Ydata = YdataBase + (n * num_channels + c) * (output_height * output_width);
-                                                    for (int64_t y = 0; y < output_height; ++y) {
-                                                      for (int64_t x = 0; x < output_width; ++x) {
-                                                        // when use_extrapolation is set and original index of x or y is out of the dim range
-                                                        // then use extrapolation_value as the output value.
-                                                        if (use_extrapolation &&
-                                                            ((y_original[y] < 0 || y_original[y] > static_cast<float>(input_height - 1)) ||
-                                                             (x_original[x] < 0 || x_original[x] > static_cast<float>(input_width - 1)))) {
-                                                          Ydata[output_width * y + x] = static_cast<T>(extrapolation_value);
-                                                          continue;
-                                                        }
 
-                                                        T X11 = Xdata[input_width_mul_y1[y] + in_x1[x]];
-                                                        T X21 = Xdata[input_width_mul_y1[y] + in_x2[x]];
-                                                        T X12 = Xdata[input_width_mul_y2[y] + in_x1[x]];
-                                                        T X22 = Xdata[input_width_mul_y2[y] + in_x2[x]];
+  return p;
+}
 
-                                                        Ydata[output_width * y + x] = static_cast<T>(dx2[x] * dy2[y] * X11 +
-                                                                                                     dx1[x] * dy2[y] * X21 +
-                                                                                                     dx2[x] * dy1[y] * X12 +
-                                                                                                     dx1[x] * dy1[y] * X22);
-                                                      }
-                                                    }
-                                                    Xdata += input_height * input_width;
-                                                    Ydata += output_width * output_height;
-                                                  });
-  }
+// The following method supports a 4-D input in 'Linear mode'
+// that amounts to 'Bilinear' Upsampling/Resizing in the sense that it assumes
+// the scale values for the outermost 2 dimensions are 1.
+// This is the common use-case where the 4-D input (batched multi-channel images)
+// is usually of shape [N, C, H, W] and the scales are [1.0, 1.0, height_scale, width_scale]
+// The work is partitioned over the rows of all the output images, so that a single large image
+// (e.g.) a 3-channel frame is spread across the whole thread pool.
+template <typename T>
+void UpsampleBilinear(int64_t batch_size,
+                      int64_t num_channels,
+                      int64_t input_height,
+                      int64_t input_width,
+                      int64_t output_height,
+                      int64_t output_width,
+                      const BilinearParams& p,
+                      bool use_extrapolation,
+                      float extrapolation_value,
+                      const T* XdataBase,
+                      T* YdataBase,
+                      concurrency::ThreadPool* tp) {
+  const std::ptrdiff_t total_rows = static_cast<std::ptrdiff_t>(batch_size * num_channels * output_height);
+
+  // Roughly 4 loads and 8 multiply-adds per output element
+  const TensorOpCost cost{static_cast<double>(4 * sizeof(T) * output_width),
+                          static_cast<double>(sizeof(T) * output_width),
+                          static_cast<double>(8 * output_width)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, total_rows, cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const int64_t nc = static_cast<int64_t>(row) / output_height;
+          const int64_t y = static_cast<int64_t>(row) % output_height;
+
+          const T* Xdata = XdataBase + nc * (input_height * input_width);
+          T* Ydata = YdataBase + nc * (output_height * output_width) + output_width * y;
+
+          // when use_extrapolation is set and original index of y is out of the dim range
+          // then use extrapolation_value as the output value for the whole row.
+          if (use_extrapolation &&
+              (p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1))) {
+            std::fill_n(Ydata, output_width, static_cast<T>(extrapolation_value));
+            continue;
+          }
+
+          const T* Xrow1 = Xdata + p.input_width_mul_y1[y];
+          const T* Xrow2 = Xdata + p.input_width_mul_y2[y];
+          const float dy1 = p.dy1[y];
+          const float dy2 = p.dy2[y];
+
+          for (int64_t x = 0; x < output_width; ++x) {
+            // when use_extrapolation is set and original index of x is out of the dim range
+            // then use extrapolation_value as the output value.
+            if (use_extrapolation &&
+                (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1))) {
+              Ydata[x] = static_cast<T>(extrapolation_value);
+              continue;
+            }
+
+            T X11 = Xrow1[p.in_x1[x]];
+            T X21 = Xrow1[p.in_x2[x]];
+            T X12 = Xrow2[p.in_x1[x]];
+            T X22 = Xrow2[p.in_x2[x]];
+
+            Ydata[x] = static_cast<T>(p.dx2[x] * dy2 * X11 +
+                                      p.dx1[x] * dy2 * X21 +
+                                      p.dx2[x] * dy1 * X12 +
+                                      p.dx1[x] * dy1 * X22);
+          }
+        }
+      });
 }
 
 // The following method supports a 5-D input in 'Linear mode'
@@ -649,49 +655,105 @@ std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff
   return coeffs;
 }
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
+// Computes the (clamped) indices of the 4 neighbors of each output index in one dimension and their coefficients.
+// When exclude_outside is set, the weight of sampling locations outside the grid is set to 0 and
+// the weights are renormalized so that their sum is 1.0
+void SetupCubicCoeffs1D(int64_t input_size,
+                        int64_t output_size,
+                        float scale,
+                        float roi_start,
+                        float roi_end,
+                        float cubic_coeff_a,
+                        bool exclude_outside,
+                        const GetOriginalCoordinateFunc& get_original_coordinate,
+                        std::vector<float>& original,
+                        std::vector<int64_t>& in_indices,
+                        std::vector<float>& coeffs,
+                        std::vector<float>& coeff_sums) {
+  original.resize(output_size);
+  in_indices.resize(output_size * CubicModeGridLength);
+  coeffs.resize(output_size * CubicModeGridLength);
+  coeff_sums.resize(output_size);
+
+  for (int64_t i = 0; i < output_size; ++i) {
+    float in_coord = scale == 1 ? static_cast<float>(i)
+                                : get_original_coordinate(static_cast<float>(i), scale,
+                                                          static_cast<float>(output_size),
+                                                          static_cast<float>(input_size),
+                                                          roi_start, roi_end);
+    original[i] = in_coord;
+
+    auto in_int = static_cast<int64_t>(std::floor(in_coord));
+    auto cubic_coeffs = GetCubicCoeffs(in_coord - in_int, cubic_coeff_a);
+
+    float coeff_sum = 1;
+    if (exclude_outside) {
+      coeff_sum = 0;
+      for (int64_t j = 0, in_val = in_int - 1; in_val <= in_int + 2; in_val++, j++) {
+        if (in_val < 0 || in_val >= input_size) {
+          cubic_coeffs[j] = 0.0f;
+        }
+        coeff_sum += cubic_coeffs[j];
+      }
+    }
+
+    for (int64_t j = 0, in_val = in_int - 1; in_val <= in_int + 2; in_val++, j++) {
+      in_indices[i * CubicModeGridLength + j] = std::max(static_cast<int64_t>(0), std::min(in_val, input_size - 1));
+      coeffs[i * CubicModeGridLength + j] = cubic_coeffs[j];
+    }
+    coeff_sums[i] = coeff_sum;
+  }
 }
 
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
+BicubicParams SetupResizeBiCubic(int64_t input_height,
+                                 int64_t input_width,
+                                 int64_t output_height,
+                                 int64_t output_width,
+                                 float height_scale,
+                                 float width_scale,
+                                 float cubic_coeff_a,
+                                 bool use_extrapolation,
+                                 bool exclude_outside,
+                                 const std::vector<float>& roi,
+                                 const GetOriginalCoordinateFunc& get_original_coordinate) {
+  BicubicParams p;
+
+  auto roi_y_start = roi.size() / 2 - 2;
+  auto roi_y_end = roi.size() - 2;
+  auto roi_x_start = roi.size() / 2 - 1;
+  auto roi_x_end = roi.size() - 1;
+
+  SetupCubicCoeffs1D(input_height, output_height, height_scale, roi[roi_y_start], roi[roi_y_end],
+                     cubic_coeff_a, exclude_outside, get_original_coordinate,
+                     p.y_original, p.in_y, p.y_coeffs, p.y_coeff_sums);
+
+  std::vector<float> x_coeff_sums;
+  SetupCubicCoeffs1D(input_width, output_width, width_scale, roi[roi_x_start], roi[roi_x_end],
+                     cubic_coeff_a, exclude_outside, get_original_coordinate,
+                     p.x_original, p.in_x, p.x_coeffs, x_coeff_sums);
+
+  // the x coefficients are applied to every input row so they are normalized upfront
+  for (int64_t x = 0; x < output_width; ++x) {
+    for (size_t j = 0; j < CubicModeGridLength; ++j) {
+      p.x_coeffs[x * CubicModeGridLength + j] /= x_coeff_sums[x];
+    }
   }
 
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[i] / coeff_sum * orig_data;
+  for (int64_t y = 0; y < output_height; ++y) {
+    if (use_extrapolation && (p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1))) {
+      continue;
+    }
+    p.in_y_min = p.in_y_max < p.in_y_min ? p.in_y[y * CubicModeGridLength]
+                                         : std::min(p.in_y_min, p.in_y[y * CubicModeGridLength]);
+    p.in_y_max = std::max(p.in_y_max, p.in_y[y * CubicModeGridLength + CubicModeGridLength - 1]);
   }
-  cache[grid_start_pos] = result;
 
-  return result;
+  return p;
 }
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 6001)
-#endif
+
+// The 'Bicubic' interpolation is separable - for each image, the input rows in use are first interpolated
+// in the x dimension into a scratch buffer, and the output rows are then interpolated from the rows of
+// the scratch buffer in the y dimension. Both passes are partitioned over rows across the thread pool.
 template <typename T>
 void ResizeBiCubic(
     int64_t batch_size,
@@ -700,147 +762,88 @@ void ResizeBiCubic(
     int64_t input_width,
     int64_t output_height,
     int64_t output_width,
-    float height_scale,
-    float width_scale,
-    float cubic_coeff_a,
+    const BicubicParams& p,
     bool use_extrapolation,
     float extrapolation_value,
-    bool exclude_outside,
-    const std::vector<float>& roi,
     const T* Xdata,
     T* Ydata,
-    GetOriginalCoordinateFunc get_original_coordinate) {
-  std::vector<float> y_original;
-  y_original.reserve(output_height);
-
-  std::vector<float> x_original;
-  x_original.reserve(output_width);
-
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
-
-  // generate coefficients in y direction
-  for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = height_scale == 1 ? static_cast<float>(y)
-                                   : get_original_coordinate(static_cast<float>(y), height_scale,
-                                                             static_cast<float>(output_height),
-                                                             static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[y] - std::floor(y_original[y]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
+    AllocatorPtr& alloc,
+    concurrency::ThreadPool* tp) {
+  const int64_t num_rows = p.in_y_max - p.in_y_min + 1;
+
+  float* x_interpolated = nullptr;
+  BufferUniquePtr x_interpolated_holder;
+  if (num_rows > 0) {
+    x_interpolated = static_cast<float*>(alloc->Alloc(SafeInt<size_t>(sizeof(float)) * num_rows * output_width));
+    x_interpolated_holder = BufferUniquePtr(x_interpolated, BufferDeleter(alloc));
   }
 
-  // generate coefficients in x direction
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x),
-                                                            width_scale,
-                                                            static_cast<float>(output_width),
-                                                            static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[x] - std::floor(x_original[x]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
-  }
-
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
+  const TensorOpCost x_pass_cost{static_cast<double>(CubicModeGridLength * sizeof(T) * output_width),
+                                 static_cast<double>(sizeof(float) * output_width),
+                                 static_cast<double>(2 * CubicModeGridLength * output_width)};
+  const TensorOpCost y_pass_cost{static_cast<double>(CubicModeGridLength * sizeof(float) * output_width),
+                                 static_cast<double>(sizeof(T) * output_width),
+                                 static_cast<double>(3 * CubicModeGridLength * output_width)};
 
   for (int64_t n = 0; n < batch_size; n++) {
     for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[y];
-
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
-          for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
-          }
-          continue;
-        }
-
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[i] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[i];
-            y_coeff_sum += y_coeff_holder[i];
-          }
-        }
-
-        for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[x];
-
-          // when use_extrapolation is set and original index is out of the dim range
-          // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
-            continue;
-          }
+      if (num_rows > 0) {
+        concurrency::ThreadPool::TryParallelFor(
+            tp, static_cast<std::ptrdiff_t>(num_rows), x_pass_cost,
+            [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+              for (std::ptrdiff_t row = first; row < last; ++row) {
+                const T* Xrow = Xdata + (p.in_y_min + row) * input_width;
+                float* x_interpolated_row = x_interpolated + row * output_width;
+                for (int64_t x = 0; x < output_width; ++x) {
+                  const int64_t* in_x = &p.in_x[x * CubicModeGridLength];
+                  const float* coeff_x = &p.x_coeffs[x * CubicModeGridLength];
+                  float result = 0;
+                  for (size_t i = 0; i < CubicModeGridLength; i++) {
+                    result += coeff_x[i] * Xrow[in_x[i]];
+                  }
+                  x_interpolated_row[x] = result;
+                }
+              }
+            });
+      }
 
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[i] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[i];
-              x_coeff_sum += x_coeff_holder[i];
+      concurrency::ThreadPool::TryParallelFor(
+          tp, static_cast<std::ptrdiff_t>(output_height), y_pass_cost,
+          [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t y = first; y < last; ++y) {
+              T* Yrow = Ydata + y * output_width;
+
+              // when use_extrapolation is set and original index is out of the dim range
+              // then use extrapolation_value as the output value.
+              if (use_extrapolation && (p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1))) {
+                std::fill_n(Yrow, output_width, static_cast<T>(extrapolation_value));
+                continue;
+              }
+
+              const int64_t* in_y = &p.in_y[y * CubicModeGridLength];
+              const float* coeff_y = &p.y_coeffs[y * CubicModeGridLength];
+              const float y_coeff_sum = p.y_coeff_sums[y];
+
+              for (int64_t x = 0; x < output_width; ++x) {
+                if (use_extrapolation && (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1))) {
+                  Yrow[x] = static_cast<T>(extrapolation_value);
+                  continue;
+                }
+
+                float result = 0;
+                for (size_t i = 0; i < CubicModeGridLength; i++) {
+                  result += x_interpolated[(in_y[i] - p.in_y_min) * output_width + x] * coeff_y[i] / y_coeff_sum;
+                }
+                Yrow[x] = static_cast<T>(result);
+              }
             }
-          }
-
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[i] / y_coeff_sum;
-          }
-
-          Ydata[y * output_width + x] = static_cast<T>(result);
-        }
-      }
+          });
 
       Xdata += input_height * input_width;
       Ydata += output_height * output_width;
-
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
     }
   }
 }
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
 
 template <typename T>
 Status Upsample<T>::BaseCompute(OpKernelContext* context,
@@ -898,13 +901,18 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
         const int64_t output_height = is_2D ? output_dims[0] : output_dims[2];
         const int64_t output_width = is_2D ? output_dims[1] : output_dims[3];
 
-        AllocatorPtr alloc;
-        ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+        const float height_scale = is_2D ? scales[0] : scales[2];
+        const float width_scale = is_2D ? scales[1] : scales[3];
+
+        auto params = bilinear_params_cache_.Get(dims, output_dims, scales, roi, [&]() {
+          return SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
+                                       height_scale, width_scale, roi, get_original_coordinate_);
+        });
+
         UpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                         is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3], roi,
-                         use_extrapolation_, extrapolation_value_, X->template Data<T>(),
-                         Y->template MutableData<T>(), alloc, get_original_coordinate_, 
-                         output_height*output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
+                         *params, use_extrapolation_, extrapolation_value_, X->template Data<T>(),
+                         Y->template MutableData<T>(),
+                         output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
         return Status::OK();
       } else if (dims.size() == 3 || dims.size() == 5) {
         //'trilinear' == 3-D input or 5-D input with outermost 2 scales as 1
@@ -958,10 +966,20 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
       const int64_t output_height = is_2D ? output_dims[0] : output_dims[2];
       const int64_t output_width = is_2D ? output_dims[1] : output_dims[3];
 
+      const float height_scale = is_2D ? scales[0] : scales[2];
+      const float width_scale = is_2D ? scales[1] : scales[3];
+
+      auto params = bicubic_params_cache_.Get(dims, output_dims, scales, roi, [&]() {
+        return SetupResizeBiCubic(input_height, input_width, output_height, output_width, height_scale, width_scale,
+                                  cubic_coeff_a_, use_extrapolation_, exclude_outside_, roi, get_original_coordinate_);
+      });
+
+      AllocatorPtr alloc;
+      ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
       ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                    is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3], cubic_coeff_a_, use_extrapolation_,
-                    extrapolation_value_, exclude_outside_, roi, X->template Data<float>(), Y->template MutableData<float>(),
-                    get_original_coordinate_);
+                    *params, use_extrapolation_, extrapolation_value_, X->template Data<float>(),
+                    Y->template MutableData<float>(), alloc,
+                    output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
       return Status::OK();
     }
     default:
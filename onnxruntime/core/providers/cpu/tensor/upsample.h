@@ -4,7 +4,9 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/platform/ort_mutex.h"
 #include <cmath>
+#include <memory>
 
 namespace onnxruntime {
 
@@ -351,6 +353,77 @@ class UpsampleBase {
   }
 };  // UpsampleBase
 
+// Coefficient tables of the 'Bilinear' mode.
+// For each index in the output height and output width, holds its corresponding indices in the input
+// (multiplied with the input stride for that dimension) and the "weights" of those indices which
+// proportionately indicate how much they will influence the final pixel value in the output.
+struct BilinearParams {
+  std::vector<float> y_original;
+  std::vector<float> x_original;
+
+  std::vector<int64_t> input_width_mul_y1;
+  std::vector<int64_t> input_width_mul_y2;
+  std::vector<int64_t> in_x1;
+  std::vector<int64_t> in_x2;
+
+  std::vector<float> dy1;
+  std::vector<float> dy2;
+  std::vector<float> dx1;
+  std::vector<float> dx2;
+};
+
+// Coefficient tables of the 'Bicubic' mode.
+// For each index in the output height and output width, holds the (clamped) indices of the 4 neighbors
+// in the input and their coefficients. The x coefficients are normalized while the y coefficients are
+// kept along with their sum (the sums are 1 unless exclude_outside is set).
+struct BicubicParams {
+  std::vector<float> y_original;
+  std::vector<float> x_original;
+
+  std::vector<int64_t> in_y;
+  std::vector<int64_t> in_x;
+
+  std::vector<float> y_coeffs;
+  std::vector<float> y_coeff_sums;
+  std::vector<float> x_coeffs;
+
+  // The range of input rows used by the output rows that aren't extrapolated
+  int64_t in_y_min = 0;
+  int64_t in_y_max = -1;
+};
+
+// Caches the coefficient tables computed for the last seen input/output shapes, scales and roi,
+// so that they aren't re-computed by every run of a model with fixed shapes
+template <typename Params>
+class ResizeCoefficientsCache {
+ public:
+  template <typename SetupFunc>
+  std::shared_ptr<const Params> Get(const std::vector<int64_t>& input_dims,
+                                    const std::vector<int64_t>& output_dims,
+                                    const std::vector<float>& scales,
+                                    const std::vector<float>& roi,
+                                    const SetupFunc& setup_func) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    if (params_ == nullptr || input_dims != input_dims_ || output_dims != output_dims_ ||
+        scales != scales_ || roi != roi_) {
+      params_ = std::make_shared<const Params>(setup_func());
+      input_dims_ = input_dims;
+      output_dims_ = output_dims;
+      scales_ = scales;
+      roi_ = roi;
+    }
+    return params_;
+  }
+
+ private:
+  OrtMutex mutex_;
+  std::vector<int64_t> input_dims_;
+  std::vector<int64_t> output_dims_;
+  std::vector<float> scales_;
+  std::vector<float> roi_;
+  std::shared_ptr<const Params> params_;
+};
+
 template <typename T>
 class Upsample : public UpsampleBase, public OpKernel {
  public:
@@ -361,6 +434,10 @@ class Upsample : public UpsampleBase, public OpKernel {
 
   Status BaseCompute(OpKernelContext* context, const std::vector<float>& roi, const std::vector<float>& scales,
                      const std::vector<int64_t>& output_dims) const;
+
+ private:
+  mutable ResizeCoefficientsCache<BilinearParams> bilinear_params_cache_;
+  mutable ResizeCoefficientsCache<BicubicParams> bicubic_params_cache_;
 };
 
 }  // namespace onnxruntime
@@ -205,12 +205,10 @@ static std::unique_ptr<Tensor> UntypedSelect(OpKernelContext& context, bool targ
   InputBroadcaster input_broadcaster(condition, values);
 
   std::unique_ptr<Tensor> selection_tensor = allocate_tensor(allocator, input_broadcaster.GetOutputShape());
-  OutputBroadcaster output_broadcaster(input_broadcaster.GetSpanSize(), *selection_tensor);
 
   // store value of 'target' directly in void* for user_data so it's accessible in the state-less functors
-  BroadcastHelper broadcast_helper(input_broadcaster, output_broadcaster, reinterpret_cast<void*>(target));
-
-  BroadcastLooper(broadcast_helper, functors);
+  ParallelizeBroadcastTwo(input_broadcaster, *selection_tensor, functors, context.GetOperatorThreadPool(), 1.0,
+                          reinterpret_cast<void*>(target));
 
   return selection_tensor;
 }
@@ -221,10 +219,7 @@ static void UntypedMerge(OpKernelContext& context,
   InputBroadcaster merge_broadcaster{X_selection_tensor, Y_selection_tensor};
   Tensor& output = *context.Output(0, merge_broadcaster.GetOutputShape());
 
-  OutputBroadcaster output_broadcaster{merge_broadcaster.GetSpanSize(), output};
-  BroadcastHelper broadcast_helper(merge_broadcaster, output_broadcaster);
-
-  BroadcastLooper(broadcast_helper, functors);
+  ParallelizeBroadcastTwo(merge_broadcaster, output, functors, context.GetOperatorThreadPool(), 1.0);
 }
 }  // namespace
 
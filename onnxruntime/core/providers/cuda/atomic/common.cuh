@@ -72,6 +72,84 @@ __device__ __forceinline__ void atomic_add(half *address, half value) {
 #endif
 }
 
+__device__ __forceinline__ void atomic_add(int32_t *address, int32_t value) {
+  atomicAdd(address, value);
+}
+
+__device__ __forceinline__ void atomic_add(int64_t *address, int64_t value) {
+  // two's complement addition is the same for the signed and unsigned values
+  atomicAdd(reinterpret_cast<unsigned long long*>(address), static_cast<unsigned long long>(value));
+}
+
+// The integer type that atomicCAS operates on for T.
+template <typename T>
+struct AtomicCasType;
+
+template <>
+struct AtomicCasType<float> {
+  using type = unsigned int;
+};
+
+template <>
+struct AtomicCasType<int32_t> {
+  using type = unsigned int;
+};
+
+template <>
+struct AtomicCasType<double> {
+  using type = unsigned long long;
+};
+
+template <>
+struct AtomicCasType<int64_t> {
+  using type = unsigned long long;
+};
+
+// Replace *address with op(*address, value) with a compare and swap loop, for the operations that have no atomic
+// instruction.
+template <typename T, typename Op>
+__device__ __forceinline__ void atomic_cas_loop(T *address, T value, const Op& op) {
+  using CasT = typename AtomicCasType<T>::type;
+  CasT* raw_address = reinterpret_cast<CasT*>(address);
+  CasT old = *raw_address;
+  CasT assumed;
+  do {
+    assumed = old;
+    T new_value = op(*reinterpret_cast<const T*>(&assumed), value);
+    old = atomicCAS(raw_address, assumed, *reinterpret_cast<const CasT*>(&new_value));
+  } while (assumed != old);
+}
+
+struct MulOp {
+  template <typename T>
+  __device__ __forceinline__ T operator()(T a, T b) const { return a * b; }
+};
+
+struct MaxOp {
+  template <typename T>
+  __device__ __forceinline__ T operator()(T a, T b) const { return a < b ? b : a; }
+};
+
+template <typename T>
+__device__ __forceinline__ void atomic_mul(T *address, T value) {
+  atomic_cas_loop(address, value, MulOp());
+}
+
+template <typename T>
+__device__ __forceinline__ void atomic_max(T *address, T value) {
+  atomic_cas_loop(address, value, MaxOp());
+}
+
+template <>
+__device__ __forceinline__ void atomic_max(int32_t *address, int32_t value) {
+  atomicMax(address, value);
+}
+
+template <>
+__device__ __forceinline__ void atomic_max(int64_t *address, int64_t value) {
+  atomicMax(reinterpret_cast<long long*>(address), static_cast<long long>(value));
+}
+
 #if CUDA_VERSION >= 11000 && (__CUDA_ARCH__ >= 800 || !defined(__CUDA_ARCH__))
 __device__ __forceinline__ void atomic_add(nv_bfloat16 *address, nv_bfloat16 value) {
   unsigned int * base_address = reinterpret_cast<unsigned int*>(reinterpret_cast<char*>(address) - (reinterpret_cast<size_t>(address) & 2));
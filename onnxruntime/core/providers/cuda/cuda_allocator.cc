@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "cuda_allocator.h"
+
+#include <algorithm>
+#include <limits>
+
 #include "cuda_common.h"
 #include "core/framework/allocatormgr.h"
 #include "core/framework/session_state.h"
@@ -51,6 +55,82 @@ FencePtr CUDAAllocator::CreateFence(const SessionState* session_state) {
   return std::make_shared<CUDAFence>(GetGPUDataTransfer(session_state));
 }
 
+CUDAMemPoolAllocator::CUDAMemPoolAllocator(OrtDevice::DeviceId device_id, const char* name, size_t mem_limit,
+                                           size_t release_threshold)
+    : IAllocator(
+          OrtMemoryInfo(name, OrtAllocatorType::OrtDeviceAllocator,
+                        OrtDevice(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, device_id),
+                        device_id, OrtMemTypeDefault)),
+      mem_limit_(mem_limit) {
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11020
+  int supported = 0;
+  CUDA_CALL_THROW(cudaDeviceGetAttribute(&supported, cudaDevAttrMemoryPoolsSupported, device_id));
+  ORT_ENFORCE(supported != 0, "CUDA device ", device_id, " does not support stream ordered memory pools.");
+
+  cudaMemPool_t mem_pool;
+  CUDA_CALL_THROW(cudaDeviceGetDefaultMemPool(&mem_pool, device_id));
+  uint64_t threshold = release_threshold;
+  CUDA_CALL_THROW(cudaMemPoolSetAttribute(mem_pool, cudaMemPoolAttrReleaseThreshold, &threshold));
+  stats_.bytes_limit = static_cast<int64_t>(std::min<size_t>(mem_limit, std::numeric_limits<int64_t>::max()));
+#else
+  ORT_UNUSED_PARAMETER(release_threshold);
+  ORT_THROW("The CUDA memory pool allocator requires CUDA 11.2 or later.");
+#endif
+}
+
+void* CUDAMemPoolAllocator::Alloc(size_t size) {
+  void* p = nullptr;
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11020
+  if (size > 0) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    ORT_ENFORCE(static_cast<size_t>(stats_.bytes_in_use) + size <= mem_limit_,
+                "Failed to allocate ", size, " bytes: ", stats_.bytes_in_use,
+                " bytes are in use and the limit is ", mem_limit_, " bytes.");
+
+    // Allocations and frees are ordered on the default stream, which is the stream kernels run on.
+    CUDA_CALL_THROW(cudaMallocAsync(&p, size, 0));
+    allocation_sizes_.emplace(p, size);
+
+    const int64_t alloc_size = static_cast<int64_t>(size);
+    stats_.num_allocs += 1;
+    stats_.bytes_in_use += alloc_size;
+    stats_.total_allocated_bytes += alloc_size;
+    stats_.max_bytes_in_use = std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
+    stats_.max_alloc_size = std::max(stats_.max_alloc_size, alloc_size);
+  }
+#else
+  ORT_UNUSED_PARAMETER(size);
+#endif
+  return p;
+}
+
+void CUDAMemPoolAllocator::Free(void* p) {
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11020
+  if (p == nullptr) {
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto it = allocation_sizes_.find(p);
+  if (it != allocation_sizes_.end()) {
+    stats_.bytes_in_use -= static_cast<int64_t>(it->second);
+    allocation_sizes_.erase(it);
+  }
+  cudaFreeAsync(p, 0);  // do not throw error since it's OK for cudaFreeAsync to fail during shutdown
+#else
+  ORT_UNUSED_PARAMETER(p);
+#endif
+}
+
+FencePtr CUDAMemPoolAllocator::CreateFence(const SessionState* session_state) {
+  return std::make_shared<CUDAFence>(GetGPUDataTransfer(session_state));
+}
+
+void CUDAMemPoolAllocator::GetStats(AllocatorStats* stats) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  *stats = stats_;
+}
+
 void* CUDAPinnedAllocator::Alloc(size_t size) {
   void* p = nullptr;
   if (size > 0) {
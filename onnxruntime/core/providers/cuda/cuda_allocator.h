@@ -3,7 +3,11 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "core/framework/allocator.h"
+#include "core/framework/arena.h"
+#include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
 
@@ -22,6 +26,24 @@ class CUDAAllocator : public IAllocator {
   void CheckDevice(bool throw_when_fail) const;
 };
 
+// Allocator backed by the CUDA stream ordered memory pool (cudaMallocAsync/cudaFreeAsync) of the device. It is used
+// without an arena since the pool already caches freed memory, and it returns memory to the device once the pool holds
+// more unused memory than release_threshold at a synchronization point. Requires CUDA 11.2 or later.
+class CUDAMemPoolAllocator : public IAllocator {
+ public:
+  CUDAMemPoolAllocator(OrtDevice::DeviceId device_id, const char* name, size_t mem_limit, size_t release_threshold);
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  FencePtr CreateFence(const SessionState* session_state) override;
+  void GetStats(AllocatorStats* stats);
+
+ private:
+  const size_t mem_limit_;
+  OrtMutex mutex_;
+  std::unordered_map<void*, size_t> allocation_sizes_;
+  AllocatorStats stats_;
+};
+
 //TODO: add a default constructor
 class CUDAPinnedAllocator : public IAllocator {
  public:
@@ -59,23 +59,42 @@ ONNX_OPERATOR_KERNEL_EX(
 
 }  // namespace cuda
 
-CUDAExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId device_id, size_t cuda_mem_limit, ArenaExtendStrategy arena_extend_strategy) {
-  CUDA_CALL_THROW(cudaSetDevice(device_id));
-  CUBLAS_CALL_THROW(cublasCreate(&cublas_handle_));
-  CUDNN_CALL_THROW(cudnnCreate(&cudnn_handle_));
+namespace {
+AllocatorPtr CreateCudaAllocator(const CUDAExecutionProviderInfo& info) {
+  if (info.use_cuda_mem_pool) {
+    // The memory pool caches freed memory itself, so no arena is needed on top of it
+    const size_t mem_limit = info.cuda_mem_limit;
+    const size_t release_threshold = info.cuda_mem_pool_release_threshold;
+    AllocatorCreationInfo pool_memory_info(
+        [mem_limit, release_threshold](OrtDevice::DeviceId id) {
+          return onnxruntime::make_unique<CUDAMemPoolAllocator>(id, CUDA, mem_limit, release_threshold);
+        },
+        info.device_id,
+        false);
+    return CreateAllocator(pool_memory_info);
+  }
 
   AllocatorCreationInfo default_memory_info(
       [](OrtDevice::DeviceId id) {
         return onnxruntime::make_unique<CUDAAllocator>(id, CUDA);
       },
-      device_id,
+      info.device_id,
       true,
-      {cuda_mem_limit,
-       static_cast<int>(arena_extend_strategy),
+      {info.cuda_mem_limit,
+       static_cast<int>(info.arena_extend_strategy),
        -1, -1});
 
   // CUDA malloc/free is expensive so always use an arena
-  allocator_ = CreateAllocator(default_memory_info);
+  return CreateAllocator(default_memory_info);
+}
+}  // namespace
+
+CUDAExecutionProvider::PerThreadContext::PerThreadContext(const CUDAExecutionProviderInfo& info) {
+  CUDA_CALL_THROW(cudaSetDevice(info.device_id));
+  CUBLAS_CALL_THROW(cublasCreate(&cublas_handle_));
+  CUDNN_CALL_THROW(cudnnCreate(&cudnn_handle_));
+
+  allocator_ = CreateCudaAllocator(info);
 }
 
 CUDAExecutionProvider::PerThreadContext::~PerThreadContext() {
@@ -156,7 +175,7 @@ CUDAExecutionProvider::PerThreadContext& CUDAExecutionProvider::GetPerThreadCont
 
     // get or create a context
     if (context_state_.retired_context_pool.empty()) {
-      context = std::make_shared<PerThreadContext>(info_.device_id, info_.cuda_mem_limit, info_.arena_extend_strategy);
+      context = std::make_shared<PerThreadContext>(info_);
     } else {
       context = context_state_.retired_context_pool.back();
       context_state_.retired_context_pool.pop_back();
@@ -1964,16 +1983,7 @@ void CUDAExecutionProvider::RegisterAllocator(std::shared_ptr<AllocatorManager>
   // Used to allocate CUDA device memory
   auto cuda_alloc = allocator_manager->GetAllocator(info_.device_id, OrtMemTypeDefault);
   if (nullptr == cuda_alloc) {
-    AllocatorCreationInfo default_memory_info(
-        [](OrtDevice::DeviceId device_id) {
-          return onnxruntime::make_unique<CUDAAllocator>(device_id, CUDA);
-        },
-        info_.device_id,
-        true,
-        {info_.cuda_mem_limit,
-         static_cast<int>(info_.arena_extend_strategy),
-         -1, -1});
-    cuda_alloc = CreateAllocator(default_memory_info);
+    cuda_alloc = CreateCudaAllocator(info_);
     allocator_manager->InsertAllocator(cuda_alloc);
   }
   TryInsertAllocator(cuda_alloc);
@@ -90,7 +90,7 @@ class CUDAExecutionProvider : public IExecutionProvider {
 
   class PerThreadContext final {
    public:
-    PerThreadContext(OrtDevice::DeviceId device_id, size_t cuda_mem_limit, ArenaExtendStrategy arena_extend_strategy);
+    PerThreadContext(const CUDAExecutionProviderInfo& info);
     ~PerThreadContext();
 
     cublasHandle_t CublasHandle() const {
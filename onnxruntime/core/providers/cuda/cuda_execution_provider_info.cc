@@ -16,6 +16,8 @@ constexpr const char* kMemLimit = "cuda_mem_limit";
 constexpr const char* kArenaExtendStrategy = "arena_extend_strategy";
 constexpr const char* kCudnnConvAlgoSearch = "cudnn_conv_algo_search";
 constexpr const char* kDoCopyInDefaultStream = "do_copy_in_default_stream";
+constexpr const char* kUseCudaMemPool = "use_cuda_mem_pool";
+constexpr const char* kCudaMemPoolReleaseThreshold = "cuda_mem_pool_release_threshold";
 }  // namespace provider_option_names
 }  // namespace cuda
 
@@ -59,6 +61,9 @@ CUDAExecutionProviderInfo CUDAExecutionProviderInfo::FromProviderOptions(const P
               cuda::provider_option_names::kCudnnConvAlgoSearch,
               ort_cudnn_conv_algo_search_mapping, info.cudnn_conv_algo_search)
           .AddAssignmentToReference(cuda::provider_option_names::kDoCopyInDefaultStream, info.do_copy_in_default_stream)
+          .AddAssignmentToReference(cuda::provider_option_names::kUseCudaMemPool, info.use_cuda_mem_pool)
+          .AddAssignmentToReference(cuda::provider_option_names::kCudaMemPoolReleaseThreshold,
+                                    info.cuda_mem_pool_release_threshold)
           .Parse(options));
 
   return info;
@@ -73,6 +78,9 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const CUDAExecution
       {cuda::provider_option_names::kCudnnConvAlgoSearch,
        EnumToName(ort_cudnn_conv_algo_search_mapping, info.cudnn_conv_algo_search)},
       {cuda::provider_option_names::kDoCopyInDefaultStream, MakeStringWithClassicLocale(info.do_copy_in_default_stream)},
+      {cuda::provider_option_names::kUseCudaMemPool, MakeStringWithClassicLocale(info.use_cuda_mem_pool)},
+      {cuda::provider_option_names::kCudaMemPoolReleaseThreshold,
+       MakeStringWithClassicLocale(info.cuda_mem_pool_release_threshold)},
   };
 
   return options;
@@ -18,6 +18,10 @@ struct CUDAExecutionProviderInfo {
   ArenaExtendStrategy arena_extend_strategy{ArenaExtendStrategy::kNextPowerOfTwo};
   OrtCudnnConvAlgoSearch cudnn_conv_algo_search{OrtCudnnConvAlgoSearch::EXHAUSTIVE};
   bool do_copy_in_default_stream{true};
+  // Allocate device memory from the CUDA stream ordered memory pool instead of a BFC arena. Requires CUDA 11.2.
+  bool use_cuda_mem_pool{false};
+  // Unused memory the pool keeps for reuse instead of releasing it to the device.
+  size_t cuda_mem_pool_release_threshold{std::numeric_limits<size_t>::max()};
 
   static CUDAExecutionProviderInfo FromProviderOptions(const ProviderOptions& options);
   static ProviderOptions ToProviderOptions(const CUDAExecutionProviderInfo& info);
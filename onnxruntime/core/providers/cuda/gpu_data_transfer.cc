@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cuda/gpu_data_transfer.h"
+
+#include <cstring>
+
 #include "cuda_common.h"
 
 // use default stream for copy for now, to avoid racing in BFC arena as in issue #4829
@@ -21,7 +24,18 @@ GPUDataTransfer::GPUDataTransfer(bool do_copy_in_default_stream) {
   }
 }
 
+namespace {
+// Larger copies are rare and would hold too much pinned memory, so they run synchronously from pageable memory.
+constexpr size_t kMaxStagingBufferSize = 64 * 1024 * 1024;
+constexpr size_t kMaxStagingBuffers = 16;
+}  // namespace
+
 GPUDataTransfer::~GPUDataTransfer() {
+  for (auto& buffer : staging_buffers_) {
+    CUDA_CALL(cudaEventSynchronize(buffer.event));
+    CUDA_CALL(cudaEventDestroy(buffer.event));
+    CUDA_CALL(cudaFreeHost(buffer.data));
+  }
   if (streams_[kCudaStreamCopyIn] != nullptr) {
     CUDA_CALL(cudaStreamDestroy(streams_[kCudaStreamCopyIn]));
   }
@@ -35,6 +49,93 @@ bool GPUDataTransfer::CanCopy(const OrtDevice& src_device, const OrtDevice& dst_
          dst_device.Type() == OrtDevice::GPU || dst_device.MemType() == OrtDevice::MemType::CUDA_PINNED;
 }
 
+bool GPUDataTransfer::TryCopyThroughStagingBuffer(void* dst_data, const void* src_data, size_t bytes,
+                                                  cudaStream_t stream, Status& status) const {
+  if (bytes > kMaxStagingBufferSize) {
+    return false;
+  }
+
+  std::lock_guard<OrtMutex> lock(staging_buffers_mutex_);
+
+  // Use the smallest idle buffer that is large enough, or replace the largest idle buffer that is too small.
+  StagingBuffer* buffer = nullptr;
+  StagingBuffer* small_buffer = nullptr;
+  for (auto& candidate : staging_buffers_) {
+    if (cudaEventQuery(candidate.event) != cudaSuccess) {
+      continue;
+    }
+    if (candidate.size >= bytes) {
+      if (buffer == nullptr || candidate.size < buffer->size) {
+        buffer = &candidate;
+      }
+    } else if (small_buffer == nullptr || candidate.size > small_buffer->size) {
+      small_buffer = &candidate;
+    }
+  }
+
+  if (buffer == nullptr) {
+    void* data = nullptr;
+    if (cudaMallocHost(&data, bytes) != cudaSuccess) {
+      cudaGetLastError();  // clear the error and copy synchronously instead
+      return false;
+    }
+
+    if (small_buffer != nullptr) {
+      CUDA_CALL(cudaFreeHost(small_buffer->data));
+      small_buffer->data = data;
+      small_buffer->size = bytes;
+      buffer = small_buffer;
+    } else if (staging_buffers_.size() < kMaxStagingBuffers) {
+      cudaEvent_t event;
+      if (!CUDA_CALL(cudaEventCreateWithFlags(&event, cudaEventDisableTiming))) {
+        CUDA_CALL(cudaFreeHost(data));
+        return false;
+      }
+      staging_buffers_.push_back({data, bytes, event});
+      buffer = &staging_buffers_.back();
+    } else {
+      CUDA_CALL(cudaFreeHost(data));
+      return false;
+    }
+  }
+
+  memcpy(buffer->data, src_data, bytes);
+  status = CUDA_CALL(cudaMemcpyAsync(dst_data, buffer->data, bytes, cudaMemcpyHostToDevice, stream))
+               ? Status::OK()
+               : ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "cudaMemcpyAsync failed");
+  if (status.IsOK()) {
+    status = CUDA_CALL(cudaEventRecord(buffer->event, stream))
+                 ? Status::OK()
+                 : ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "cudaEventRecord failed");
+  }
+  return true;
+}
+
+void GPUDataTransfer::EnablePeerAccess(int src_device_id, int dst_device_id) const {
+  std::lock_guard<OrtMutex> lock(peer_access_mutex_);
+  if (!peer_access_checked_.insert(std::make_pair(src_device_id, dst_device_id)).second) {
+    return;
+  }
+
+  int can_access_peer = 0;
+  if (!CUDA_CALL(cudaDeviceCanAccessPeer(&can_access_peer, dst_device_id, src_device_id)) || !can_access_peer) {
+    // cudaMemcpyPeerAsync still works, staged through host memory by the driver
+    return;
+  }
+
+  int current_device_id = 0;
+  if (!CUDA_CALL(cudaGetDevice(&current_device_id)) || !CUDA_CALL(cudaSetDevice(dst_device_id))) {
+    return;
+  }
+  const auto result = cudaDeviceEnablePeerAccess(src_device_id, 0);
+  if (result == cudaErrorPeerAccessAlreadyEnabled) {
+    cudaGetLastError();  // enabled by someone else in the process, which is fine
+  } else {
+    CUDA_CALL(result);
+  }
+  CUDA_CALL(cudaSetDevice(current_device_id));
+}
+
 common::Status GPUDataTransfer::CopyTensor(const Tensor& src, Tensor& dst, int exec_queue_id) const {
   size_t bytes = src.SizeInBytes();
   const void* src_data = src.DataRaw();
@@ -48,13 +149,24 @@ common::Status GPUDataTransfer::CopyTensor(const Tensor& src, Tensor& dst, int e
       // copy from pinned memory to GPU, this is non-blocking
       CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyHostToDevice, streams_[exec_queue_id]));
     } else if (src_device.Type() == OrtDevice::GPU) {
-      // copying between GPU, this is non-blocking
-      // Copy only if the two addresses are different.
-      if (dst_data != src_data) {
+      if (src_device.Id() != dst_device.Id()) {
+        // copying between two GPUs, directly if peer access is available, this is non-blocking
+        EnablePeerAccess(src_device.Id(), dst_device.Id());
+        CUDA_RETURN_IF_ERROR(cudaMemcpyPeerAsync(dst_data, dst_device.Id(), src_data, src_device.Id(), bytes,
+                                                 streams_[kCudaStreamDefault]));
+      } else if (dst_data != src_data) {
+        // copying within a GPU, this is non-blocking
+        // Copy only if the two addresses are different.
         CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToDevice, streams_[kCudaStreamDefault]));
       }
     } else {
-      // copy from other CPU memory to GPU, this is blocking
+      // copy from other CPU memory to GPU through a pinned staging buffer, this is non-blocking
+      Status status;
+      if (TryCopyThroughStagingBuffer(dst_data, src_data, bytes, streams_[exec_queue_id], status)) {
+        return status;
+      }
+
+      // no staging buffer is available, this is blocking
       CUDA_RETURN_IF_ERROR(cudaMemcpy(dst_data, src_data, bytes, cudaMemcpyHostToDevice));
     }
   } else if (src_device.Type() == OrtDevice::GPU) {
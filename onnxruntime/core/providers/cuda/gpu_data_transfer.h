@@ -3,8 +3,13 @@
 
 #pragma once
 
+#include <set>
+#include <utility>
+#include <vector>
+
 #include "cuda_pch.h"
 #include "core/framework/data_transfer.h"
+#include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
 
@@ -32,7 +37,29 @@ class GPUDataTransfer : public IDataTransfer {
   }
 
  private:
+  // Pinned host buffer used to stage a copy from pageable CPU memory to GPU, so that the copy can be issued
+  // asynchronously. The buffer can be reused once its event, recorded after the copy, has completed.
+  struct StagingBuffer {
+    void* data;
+    size_t size;
+    cudaEvent_t event;
+  };
+
+  // Copies pageable CPU memory to GPU through a staging buffer. Returns false if no staging buffer is available.
+  bool TryCopyThroughStagingBuffer(void* dst_data, const void* src_data, size_t bytes, cudaStream_t stream,
+                                   Status& status) const;
+
+  // Lets dst_device_id access the memory of src_device_id, if the devices support it, so that the copies between them
+  // don't go through host memory. Only the first call for a pair of devices does anything.
+  void EnablePeerAccess(int src_device_id, int dst_device_id) const;
+
   cudaStream_t streams_[kTotalCudaStreams];
+
+  mutable OrtMutex staging_buffers_mutex_;
+  mutable std::vector<StagingBuffer> staging_buffers_;
+
+  mutable OrtMutex peer_access_mutex_;
+  mutable std::set<std::pair<int, int>> peer_access_checked_;  // (src_device_id, dst_device_id)
 };
 
 }  // namespace onnxruntime
@@ -92,7 +92,10 @@ Status BinaryElementwise<ShouldBroadcast>::Prepare(OpKernelContext* context, Bin
       ver,                                                                      \
       T,                                                                        \
       kCudaExecutionProvider,                                                   \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      KernelDefBuilder()                                                        \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())                \
+          .MayInplace(0, 0)                                                     \
+          .MayInplace(1, 0),                                                    \
       class_name<T>);
 
 #define BINARY_ELEMENTWISE_REGISTER_KERNEL_TYPED(x, ver, T) \
@@ -125,7 +128,10 @@ Status BinaryElementwise<ShouldBroadcast>::Prepare(OpKernelContext* context, Bin
       endver,                                                                      \
       T,                                                                           \
       kCudaExecutionProvider,                                                      \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<T>()),    \
+      KernelDefBuilder()                                                           \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())                   \
+          .MayInplace(0, 0)                                                        \
+          .MayInplace(1, 0),                                                       \
       x<T>);
 
 #define BINARY_ELEMENTWISE_REGISTER_KERNEL_VERSIONED_TYPED_CLASS(x, class_name, startver, endver, T) \
@@ -37,10 +37,13 @@ Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const T
   // Compute all required metadata to be used at Einsum compute time and return error status code if one was generated
   ORT_RETURN_IF_ERROR(einsum_compute_preprocessor.Run());
 
+  auto contraction_path = GetContractionPath(einsum_compute_preprocessor);
+
   // EinsumComputeProcessor section -
   if (inputs[0]->IsDataType<float>()) {
     auto einsum_compute_processor = EinsumTypedComputeProcessor<float>(context, allocator, tp,
                                                                        einsum_compute_preprocessor,
+                                                                       contraction_path,
                                                                        &einsum_cuda_assets);
 
     einsum_compute_processor.SetDeviceHelpers(EinsumOp::DeviceHelpers::CudaDeviceHelpers::Transpose,
@@ -51,6 +54,7 @@ Status Einsum::DeviceCompute(OpKernelContext* context, const std::vector<const T
   } else if (inputs[0]->IsDataType<double>()) {
     auto einsum_compute_processor = EinsumTypedComputeProcessor<double>(context, allocator, tp,
                                                                         einsum_compute_preprocessor,
+                                                                        contraction_path,
                                                                         &einsum_cuda_assets);
 
     // Set device specific methods (CPU methods) to be used during processing
@@ -8,7 +8,7 @@
 namespace onnxruntime {
 namespace cuda {
 template <typename T>
-class Gemm final : public CudaKernel {
+class Gemm : public CudaKernel {
   using Base = CudaKernel;
 
  public:
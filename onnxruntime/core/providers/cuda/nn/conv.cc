@@ -1,6 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cctype>
+#include <sstream>
+
+#include "core/framework/tuning_database.h"
 #include "core/providers/common.h"
 #include "core/providers/cuda/cuda_common.h"
 #include "core/providers/cuda/nn/conv.h"
@@ -34,6 +38,56 @@ REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(double)
 REGISTER_KERNEL_TYPED(MLFloat16)
 
+namespace {
+using FwdAlgoPerfResult = CudnnConvState<cudnnConvolutionFwdAlgoPerf_t>::PerfResultParams;
+
+// Results of the exhaustive algorithm search shared by all Conv kernels in the process. The per kernel cache is keyed
+// by input dims only and starts empty for every session, so without this each session would benchmark its convs again.
+struct FwdAlgoCache {
+  OrtMutex mutex;
+  lru_unordered_map<std::vector<int64_t>, FwdAlgoPerfResult, vector_hash<int64_t>> results{MAX_CACHED_ALGO_PERF_RESULTS};
+};
+
+FwdAlgoCache& GetFwdAlgoCache() {
+  static FwdAlgoCache cache;
+  return cache;
+}
+
+// The key identifies the conv problem completely, since kernels of different nodes and sessions share the cache.
+std::vector<int64_t> GetFwdAlgoCacheKey(int device_id,
+                                        cudnnDataType_t data_type,
+                                        int64_t group,
+                                        const std::vector<int64_t>& x_dims,
+                                        const std::vector<int64_t>& w_dims,
+                                        const std::vector<int64_t>& pads,
+                                        const std::vector<int64_t>& strides,
+                                        const std::vector<int64_t>& dilations) {
+  std::vector<int64_t> key{device_id, static_cast<int64_t>(data_type), group, static_cast<int64_t>(x_dims.size())};
+  key.insert(key.end(), x_dims.begin(), x_dims.end());
+  key.insert(key.end(), w_dims.begin(), w_dims.end());
+  key.insert(key.end(), pads.begin(), pads.end());
+  key.insert(key.end(), strides.begin(), strides.end());
+  key.insert(key.end(), dilations.begin(), dilations.end());
+  return key;
+}
+
+// The key of a search result in the tuning database, which is shared across processes and machines, so the device
+// ordinal in the cache key is replaced by the device name and the cuDNN version is added.
+std::string GetFwdAlgoTuningKey(const cudaDeviceProp& device_prop, const std::vector<int64_t>& cache_key) {
+  std::ostringstream tuning_key;
+  tuning_key.imbue(std::locale::classic());
+  tuning_key << "cudnn_conv_fwd:";
+  for (const char* c = device_prop.name; *c != '\0'; ++c) {
+    tuning_key << (std::isspace(static_cast<unsigned char>(*c)) ? '_' : *c);
+  }
+  tuning_key << ":" << cudnnGetVersion() << ":";
+  for (size_t i = 1; i < cache_key.size(); ++i) {
+    tuning_key << (i == 1 ? "" : ",") << cache_key[i];
+  }
+  return tuning_key.str();
+}
+}  // namespace
+
 Status SliceOutUnwantedOutputSection(const void* input_data,
                                      const std::vector<int64_t>& input_dims,
                                      void* output_data,
@@ -211,22 +265,54 @@ Status Conv<T>::UpdateState(OpKernelContext* context, bool bias_expected) const
       int cudnn_conv_algo = cuda_ep->GetCudnnConvAlgo();
       ORT_ENFORCE(cudnn_conv_algo > -1 && cudnn_conv_algo < 3, "cudnn_conv_algo should be 0, 1 or 2, but got ", cudnn_conv_algo);
       switch (cudnn_conv_algo) {
-        case 0:
-          CUDNN_RETURN_IF_ERROR(cudnnFindConvolutionForwardAlgorithmEx(
-              CudnnHandle(),
-              s_.x_tensor,
-              s_.x_data,
-              s_.w_desc,
-              s_.w_data,
-              s_.conv_desc,
-              s_.y_tensor,
-              s_.y_data,
-              1,
-              &algo_count,
-              &perf,
-              algo_search_workspace.get(),
-              AlgoSearchWorkspaceSize));
+        case 0: {
+          FwdAlgoCache& shared_cache = GetFwdAlgoCache();
+          const std::vector<int64_t> key = GetFwdAlgoCacheKey(cuda_ep->GetDeviceId(), CudnnTensor::GetDataType<CudaT>(),
+                                                              conv_attrs_.group, x_dims_cudnn, w_dims, pads, strides,
+                                                              dilations);
+          {
+            std::lock_guard<OrtMutex> cache_lock(shared_cache.mutex);
+            if (shared_cache.results.contains(key)) {
+              const auto& result = shared_cache.results.at(key);
+              perf.algo = result.algo;
+              perf.memory = result.memory;
+              perf.mathType = result.mathType;
+              break;
+            }
+          }
+
+          // A result of an earlier process, loaded from the tuning database file, is used without searching again.
+          const std::string tuning_key = GetFwdAlgoTuningKey(cuda_ep->GetDeviceProp(), key);
+          std::vector<int64_t> tuned;
+          if (tuning::GetTuningDatabase().Lookup(tuning_key, tuned) && tuned.size() == 3) {
+            perf.algo = static_cast<cudnnConvolutionFwdAlgo_t>(tuned[0]);
+            perf.memory = static_cast<size_t>(tuned[1]);
+            perf.mathType = static_cast<cudnnMathType_t>(tuned[2]);
+          } else {
+            // The search runs without holding the lock, so other kernels are not blocked by the benchmark.
+            CUDNN_RETURN_IF_ERROR(cudnnFindConvolutionForwardAlgorithmEx(
+                CudnnHandle(),
+                s_.x_tensor,
+                s_.x_data,
+                s_.w_desc,
+                s_.w_data,
+                s_.conv_desc,
+                s_.y_tensor,
+                s_.y_data,
+                1,
+                &algo_count,
+                &perf,
+                algo_search_workspace.get(),
+                AlgoSearchWorkspaceSize));
+
+            tuning::RecordTuningResult(tuning_key, {static_cast<int64_t>(perf.algo), static_cast<int64_t>(perf.memory),
+                                                    static_cast<int64_t>(perf.mathType)});
+          }
+
+          std::lock_guard<OrtMutex> cache_lock(shared_cache.mutex);
+          shared_cache.results.insert(key, {perf.algo, perf.memory, perf.mathType});
           break;
+        }
 
         case 1:
           CUDNN_RETURN_IF_ERROR(cudnnGetConvolutionForwardAlgorithm_v7(
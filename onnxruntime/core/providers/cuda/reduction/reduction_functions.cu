@@ -134,13 +134,14 @@ __device__ void reduce_all(
   // Total number of threads in a grid row with 2-D blocks.
   const int num_threads_in_grid_row = num_blocks_in_grid_row * num_threads_in_block;
 
-  const auto write_result = [&output, &num_elements](const TOut result) {
+  const auto write_result = [&output, &num_elements](const TBuf result) {
     // Compilation time if-else branch controlled by template argument can be
     // optimized out, so there will be no branch in real computation phase.
+    // The division is done in TBuf so that e.g. half sums don't overflow before they are divided.
     if (DivideResultBySize) {
-      output[0] = TFinalOp()(result / TOut(num_elements));
+      output[0] = TFinalOp()(TOut(result / TBuf(num_elements)));
     } else {
-      output[0] = TFinalOp()(result);
+      output[0] = TFinalOp()(TOut(result));
     }
   };
 
@@ -373,7 +374,7 @@ INSTANTIATE_REDUCE_MEAN(double, double);
 #undef INSTANTIATE_REDUCE_MEAN
 
 namespace detail {
-template <typename TIn, typename TOut, typename TBuf>
+template <typename TIn, typename TOut, typename TBuf, bool DivideResultBySize>
 __global__ void reduce_matrix_rows_kernel(const TIn* input, TOut* output, int m, int n) {
   constexpr int x_load_count_per_thread = 1;
   constexpr int y_load_count_per_thread = 4;
@@ -425,12 +426,17 @@ __global__ void reduce_matrix_rows_kernel(const TIn* input, TOut* output, int m,
     }
 
     if (threadIdx.y == 0) {
-      atomic_add(output + col, TOut(shared_memory[threadIdx.x]));
+      // Each block adds its share of the mean, so no pass over the output is needed afterwards.
+      if (DivideResultBySize) {
+        atomic_add(output + col, TOut(shared_memory[threadIdx.x] / TBuf(m)));
+      } else {
+        atomic_add(output + col, TOut(shared_memory[threadIdx.x]));
+      }
     }
   }
 }
 
-template <typename TIn, typename TOut, typename TBuf>
+template <typename TIn, typename TOut, typename TBuf, bool DivideResultBySize>
 Status call_reduce_matrix_rows(const TIn* input, TOut* output, int m, int n, bool reset_initial_output) {
   ORT_ENFORCE(m >= 0 && n >= 0);
 
@@ -450,7 +456,7 @@ Status call_reduce_matrix_rows(const TIn* input, TOut* output, int m, int n, boo
   const dim3 grid(grid_x_dim, grid_y_dim, 1);
   const dim3 block(block_x_dim, block_y_dim, 1);
 
-  reduce_matrix_rows_kernel<TIn, TOut, TBuf><<<grid, block, block.y * block.x * sizeof(TBuf)>>>(
+  reduce_matrix_rows_kernel<TIn, TOut, TBuf, DivideResultBySize><<<grid, block, block.y * block.x * sizeof(TBuf)>>>(
       input, output, m, n);
 
   return Status::OK();
@@ -460,11 +466,18 @@ Status call_reduce_matrix_rows(const TIn* input, TOut* output, int m, int n, boo
 template <typename TIn, typename TOut>
 Status reduce_matrix_rows(const TIn* input, TOut* output, int m, int n, bool reset_initial_output) {
   using TBuf = AccumulationType_t<TIn>;
-  return detail::call_reduce_matrix_rows<TIn, TOut, TBuf>(input, output, m, n, reset_initial_output);
+  return detail::call_reduce_matrix_rows<TIn, TOut, TBuf, false>(input, output, m, n, reset_initial_output);
+}
+
+template <typename TIn, typename TOut>
+Status reduce_matrix_rows_mean(const TIn* input, TOut* output, int m, int n, bool reset_initial_output) {
+  using TBuf = AccumulationType_t<TIn>;
+  return detail::call_reduce_matrix_rows<TIn, TOut, TBuf, true>(input, output, m, n, reset_initial_output);
 }
 
-#define INSTANTIATE_REDUCE_MATRIX_ROWS(T) \
-  template Status reduce_matrix_rows<T, T>(const T* input, T* output, int m, int n, bool reset_initial_output)
+#define INSTANTIATE_REDUCE_MATRIX_ROWS(T)                                                                       \
+  template Status reduce_matrix_rows<T, T>(const T* input, T* output, int m, int n, bool reset_initial_output); \
+  template Status reduce_matrix_rows_mean<T, T>(const T* input, T* output, int m, int n, bool reset_initial_output)
 INSTANTIATE_REDUCE_MATRIX_ROWS(half);
 INSTANTIATE_REDUCE_MATRIX_ROWS(float);
 INSTANTIATE_REDUCE_MATRIX_ROWS(double);
@@ -479,8 +492,15 @@ Status reduce_matrix_columns(const TIn* input, TOut* output, int m, int n, void*
       input, output, m, n, buffer, buffer_size);
 }
 
-#define INSTANTIATE_REDUCE_MATRIX_COLUMNS(T) \
-  template Status reduce_matrix_columns<T, T>(const T* input, T* output, int m, int n, void* buffer, size_t buffer_size)
+template <typename TIn, typename TOut>
+Status reduce_matrix_columns_mean(const TIn* input, TOut* output, int m, int n, void* buffer, size_t buffer_size) {
+  return detail::call_reduce_matrix_columns<TIn, TOut, Identity, Identity, true>(
+      input, output, m, n, buffer, buffer_size);
+}
+
+#define INSTANTIATE_REDUCE_MATRIX_COLUMNS(T)                                                                              \
+  template Status reduce_matrix_columns<T, T>(const T* input, T* output, int m, int n, void* buffer, size_t buffer_size); \
+  template Status reduce_matrix_columns_mean<T, T>(const T* input, T* output, int m, int n, void* buffer, size_t buffer_size)
 INSTANTIATE_REDUCE_MATRIX_COLUMNS(half);
 INSTANTIATE_REDUCE_MATRIX_COLUMNS(float);
 INSTANTIATE_REDUCE_MATRIX_COLUMNS(double);
@@ -68,6 +68,7 @@ enum class ApplicableMatrixReduction {
 
 /**
  * Determines whether a cuDNN reduction can be computed by an optimized matrix reduction function.
+ * Sums (CUDNN_REDUCE_TENSOR_ADD) and means (CUDNN_REDUCE_TENSOR_AVG) are supported.
  * @param cudnn_reduce_op The cuDNN reduction op type.
  * @param dims The input dimensions.
  * @param axes The reduction axes.
@@ -91,6 +92,13 @@ ApplicableMatrixReduction get_applicable_matrix_reduction(
 template <typename TIn, typename TOut>
 Status reduce_matrix_rows(const TIn* input, TOut* output, int m, int n, bool reset_initial_output = true);
 
+/**
+ * Reduces the rows in a row-major matrix to a single row containing the mean of each column.
+ * The parameters are the same as for reduce_matrix_rows().
+ */
+template <typename TIn, typename TOut>
+Status reduce_matrix_rows_mean(const TIn* input, TOut* output, int m, int n, bool reset_initial_output = true);
+
 /**
  * Reduces the columns in a row-major matrix to a single column containing the sum of each row.
  * @param input The input data.
@@ -103,5 +111,12 @@ Status reduce_matrix_rows(const TIn* input, TOut* output, int m, int n, bool res
 template <typename TIn, typename TOut>
 Status reduce_matrix_columns(const TIn* input, TOut* output, int m, int n, void* buffer, size_t buffer_size);
 
+/**
+ * Reduces the columns in a row-major matrix to a single column containing the mean of each row.
+ * The parameters are the same as for reduce_matrix_columns().
+ */
+template <typename TIn, typename TOut>
+Status reduce_matrix_columns_mean(const TIn* input, TOut* output, int m, int n, void* buffer, size_t buffer_size);
+
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -126,6 +126,25 @@ namespace cuda {
           .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()),               \
       name<T>);
 
+namespace {
+// Runs the matrix reduction for the ops get_applicable_matrix_reduction() accepts, ADD or AVG
+template <typename TIn, typename TOut>
+Status ReduceMatrixRows(cudnnReduceTensorOp_t cudnn_reduce_op, const TIn* input, TOut* output, int m, int n,
+                        bool reset_initial_output = true) {
+  return cudnn_reduce_op == CUDNN_REDUCE_TENSOR_AVG
+             ? reduce_matrix_rows_mean(input, output, m, n, reset_initial_output)
+             : reduce_matrix_rows(input, output, m, n, reset_initial_output);
+}
+
+template <typename TIn, typename TOut>
+Status ReduceMatrixColumns(cudnnReduceTensorOp_t cudnn_reduce_op, const TIn* input, TOut* output, int m, int n,
+                           void* buffer, size_t buffer_size) {
+  return cudnn_reduce_op == CUDNN_REDUCE_TENSOR_AVG
+             ? reduce_matrix_columns_mean(input, output, m, n, buffer, buffer_size)
+             : reduce_matrix_columns(input, output, m, n, buffer, buffer_size);
+}
+}  // namespace
+
 // TODO ReduceKernel::ReduceKernelShared() is still used by some other training classes though it's not used here - this should be refactored.
 template <bool allow_multi_axes>
 template <typename T, typename OutT, cudnnReduceTensorIndices_t ReduceTensorIndices>
@@ -148,7 +167,8 @@ Status ReduceKernel<allow_multi_axes>::ReduceKernelShared(
         cudnn_reduce_op, input_shape.GetDims(), axes_, m, n);
     switch (applicable_matrix_reduction) {
       case ApplicableMatrixReduction::Rows: {
-        return reduce_matrix_rows(
+        return ReduceMatrixRows(
+            cudnn_reduce_op,
             reinterpret_cast<const CudaT*>(X),
             reinterpret_cast<CudaOutT*>(Y),
             m, n, false);
@@ -431,7 +451,8 @@ Status ReduceComputeCore(CUDAExecutionProvider& cuda_ep, const Tensor& input, Pr
         cudnn_reduce_op, input_shape.GetDims(), axes, m, n);
     switch (applicable_matrix_reduction) {
       case ApplicableMatrixReduction::Rows: {
-        return reduce_matrix_rows(
+        return ReduceMatrixRows(
+            cudnn_reduce_op,
             reinterpret_cast<const CudaT*>(input.template Data<T>()),
             reinterpret_cast<CudaT*>(output.template MutableData<T>()),
             m, n);
@@ -439,7 +460,8 @@ Status ReduceComputeCore(CUDAExecutionProvider& cuda_ep, const Tensor& input, Pr
       case ApplicableMatrixReduction::Columns: {
         const auto buffer_size_bytes = compute_reduce_matrix_columns_buffer_size<CudaT>(m, n);
         auto buffer = cuda_ep.GetScratchBuffer<void>(buffer_size_bytes);
-        return reduce_matrix_columns(
+        return ReduceMatrixColumns(
+            cudnn_reduce_op,
             reinterpret_cast<const CudaT*>(input.template Data<T>()),
             reinterpret_cast<CudaT*>(output.template MutableData<T>()),
             m, n, buffer.get(), buffer_size_bytes);
@@ -811,15 +833,15 @@ Status ReduceKernel<true>::ComputeImpl<BFloat16, CUDNN_REDUCE_TENSOR_NO_INDICES>
         get_applicable_matrix_reduction(cudnn_reduce_op, X->Shape().GetDims(), axes, m, n);
     switch (applicable_matrix_reduction) {
       case ApplicableMatrixReduction::Rows: {
-        return reduce_matrix_rows(reinterpret_cast<const CudaT*>(X->template Data<BFloat16>()),
-                                  reinterpret_cast<CudaT*>(Y->template MutableData<BFloat16>()), m, n);
+        return ReduceMatrixRows(cudnn_reduce_op, reinterpret_cast<const CudaT*>(X->template Data<BFloat16>()),
+                                reinterpret_cast<CudaT*>(Y->template MutableData<BFloat16>()), m, n);
       }
       case ApplicableMatrixReduction::Columns: {
         const auto buffer_size_bytes = compute_reduce_matrix_columns_buffer_size<CudaT>(m, n);
         auto buffer = cuda_ep_->GetScratchBuffer<void>(buffer_size_bytes);
-        return reduce_matrix_columns(reinterpret_cast<const CudaT*>(X->template Data<BFloat16>()),
-                                     reinterpret_cast<CudaT*>(Y->template MutableData<BFloat16>()), m, n, buffer.get(),
-                                     buffer_size_bytes);
+        return ReduceMatrixColumns(cudnn_reduce_op, reinterpret_cast<const CudaT*>(X->template Data<BFloat16>()),
+                                   reinterpret_cast<CudaT*>(Y->template MutableData<BFloat16>()), m, n, buffer.get(),
+                                   buffer_size_bytes);
       }
       default:
         break;
@@ -16,6 +16,7 @@ ONNX_OPERATOR_VERSIONED_KERNEL_EX(
     10,
     kCudaExecutionProvider,
     KernelDefBuilder()
+        .MayInplace(0, 0)
         .TypeConstraint("T", DataTypeImpl::AllFixedSizeTensorTypes())
         .TypeConstraint("Tind", std::vector<MLDataType>{
                                     DataTypeImpl::GetTensorType<int32_t>(),
@@ -29,6 +30,7 @@ ONNX_OPERATOR_VERSIONED_KERNEL_EX(
     12,
     kCudaExecutionProvider,
     KernelDefBuilder()
+        .MayInplace(0, 0)
         .TypeConstraint("T", DataTypeImpl::AllFixedSizeTensorTypes())
         .TypeConstraint("Tind", std::vector<MLDataType>{
                                     DataTypeImpl::GetTensorType<int32_t>(),
@@ -41,6 +43,7 @@ ONNX_OPERATOR_KERNEL_EX(
     13,
     kCudaExecutionProvider,
     KernelDefBuilder()
+        .MayInplace(0, 0)
         .TypeConstraint("T", DataTypeImpl::AllFixedSizeTensorTypes())
         .TypeConstraint("Tind", std::vector<MLDataType>{
                                     DataTypeImpl::GetTensorType<int32_t>(),
@@ -102,6 +105,40 @@ struct ScatterElements::ComputeImpl {
   }
 };
 
+template <typename T>
+struct ScatterElements::ComputeReduceImpl {
+  Status operator()(const Tensor* data_tensor,
+                    const Tensor* updates_tensor,
+                    const Tensor* indices_tensor,
+                    Tensor* output_tensor,
+                    const int rank,
+                    const int64_t input_data_size,
+                    TArray<int64_t>& buffer_input_dims,
+                    TArray<int64_t>& buffer_input_strides,
+                    const int64_t indices_size,
+                    TArray<int64_t>& buffer_indices_dims,
+                    TArray<fast_divmod>& fdm_indices_strides,
+                    const int axis,
+                    const ScatterReduction reduction) const {
+    T* output_data = output_tensor->template MutableData<T>();
+    const T* input_data = data_tensor->template Data<T>();
+    const T* update_data = updates_tensor->template Data<T>();
+    if (indices_tensor->IsDataType<int32_t>()) {
+      return ScatterElementsReduceImpl(
+          rank, input_data, input_data_size, buffer_input_dims, buffer_input_strides,
+          indices_tensor->template Data<int32_t>(), indices_size, buffer_indices_dims, fdm_indices_strides,
+          update_data, axis, output_data, reduction);
+    } else if (indices_tensor->IsDataType<int64_t>()) {
+      return ScatterElementsReduceImpl(
+          rank, input_data, input_data_size, buffer_input_dims, buffer_input_strides,
+          indices_tensor->template Data<int64_t>(), indices_size, buffer_indices_dims, fdm_indices_strides,
+          update_data, axis, output_data, reduction);
+    }
+
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Type for Tin is not supported yet in ScatterElements.");
+  }
+};
+
 Status ScatterElements::ComputeInternal(OpKernelContext* context) const {
   const auto* data_tensor = context->Input<Tensor>(0);
   const auto& input_data_shape = data_tensor->Shape();
@@ -160,6 +197,19 @@ Status ScatterElements::ComputeInternal(OpKernelContext* context) const {
     fdm_indices_strides[i] = fast_divmod(static_cast<int>(indices_strides[i]));
   }
 
+  if (reduction_ != ScatterReduction::None) {
+    if (!data_tensor->IsDataType<float>() && !data_tensor->IsDataType<double>() &&
+        !data_tensor->IsDataType<int32_t>() && !data_tensor->IsDataType<int64_t>()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "reduction is only supported for float, double, int32 and int64 data");
+    }
+    utils::MLTypeCallDispatcherRet<Status, ComputeReduceImpl, float, double, int32_t, int64_t>
+        t_disp(data_tensor->GetElementType());
+    return t_disp.Invoke(data_tensor, updates_tensor, indices_tensor, output_tensor, rank,
+                         input_data_size, buffer_input_dims, buffer_input_strides, indices_size,
+                         buffer_indices_dims, fdm_indices_strides, axis, reduction_);
+  }
+
   utils::MLTypeCallDispatcherRet<Status, ComputeImpl, float, MLFloat16, int16_t, int8_t, int32_t,
                                  int64_t, uint8_t, uint16_t, uint32_t, uint64_t, double, bool>
       t_disp(data_tensor->GetElementType());
@@ -169,4 +219,29 @@ Status ScatterElements::ComputeInternal(OpKernelContext* context) const {
 }
 
 }  // namespace cuda
+
+#ifndef DISABLE_CONTRIB_OPS
+
+namespace contrib {
+namespace cuda {
+
+// ScatterElements with the 'reduction' attribute of the later ONNX opsets
+ONNX_OPERATOR_KERNEL_EX(
+    ScatterElements,
+    kMSDomain,
+    1,
+    kCudaExecutionProvider,
+    KernelDefBuilder()
+        .MayInplace(0, 0)
+        .TypeConstraint("T", DataTypeImpl::AllFixedSizeTensorTypes())
+        .TypeConstraint("Tind", std::vector<MLDataType>{
+                                    DataTypeImpl::GetTensorType<int32_t>(),
+                                    DataTypeImpl::GetTensorType<int64_t>()}),
+    onnxruntime::cuda::ScatterElements);
+
+}  // namespace cuda
+}  // namespace contrib
+
+#endif
+
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 
 #include "core/common/common.h"
 #include "core/providers/cuda/cuda_kernel.h"
+#include "core/providers/cpu/tensor/scatter_reduction.h"
 
 namespace onnxruntime {
 namespace cuda {
@@ -13,6 +14,8 @@ class ScatterElements final : public CudaKernel {
   ScatterElements(const OpKernelInfo& info) : CudaKernel(info) {
     ORT_ENFORCE(info.GetAttr<int64_t>("axis", &axis_).IsOK(),
                 "Missing/Invalid 'axis' attribute value");
+    // only the contrib op has the attribute
+    reduction_ = ScatterReductionFromString(info.GetAttrOrDefault<std::string>("reduction", "none"));
   }
   ~ScatterElements() = default;
   Status ComputeInternal(OpKernelContext* context) const override;
@@ -21,7 +24,11 @@ class ScatterElements final : public CudaKernel {
   template <typename T>
   struct ComputeImpl;
 
+  template <typename T>
+  struct ComputeReduceImpl;
+
   int64_t axis_;
+  ScatterReduction reduction_;
 };
 
 }  // namespace cuda
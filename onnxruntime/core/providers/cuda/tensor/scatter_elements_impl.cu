@@ -1,8 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#include "core/providers/cuda/atomic/common.cuh"
 #include "core/providers/cuda/cu_inc/common.cuh"
+#include "core/providers/cuda/tensor/scatter_reduction.cuh"
 #include "scatter_elements_impl.h"
 #ifdef ENABLE_TRAINING
 #include "orttraining/training_ops/cuda/tensor/gather_elements_grad_impl.h"
@@ -209,13 +209,6 @@ Status ScatterElementsImplInternal(
   return Status::OK();
 }
 
-template <class T>
-struct Func_Assignment {
-  __device__ __inline__ void operator()(T* a, const T* b) const {
-    *a = *b;
-  }
-};
-
 template <typename T, typename Tin>
 Status ScatterElementsImpl(
     const int rank,
@@ -267,14 +260,67 @@ SCATTER_ELEMENTS_SPECIALIZED_IMPL(float)
 SCATTER_ELEMENTS_SPECIALIZED_IMPL(double)
 SCATTER_ELEMENTS_SPECIALIZED_IMPL(bool)
 
-#ifdef ENABLE_TRAINING
-
-template <class T>
-struct Func_AtomicAdd {
-  __device__ __inline__ void operator()(T* a, const T* b) const {
-    atomic_add(a, *b);
+template <typename T, typename Tin>
+Status ScatterElementsReduceImpl(
+    const int rank,
+    const T* input_data,
+    const int64_t input_size,
+    TArray<int64_t>& buffer_input_dims,
+    TArray<int64_t>& buffer_input_strides,
+    const Tin* indices_data,
+    const int64_t indices_size,
+    TArray<int64_t>& buffer_indices_dims,
+    TArray<fast_divmod>& fdm_indices_strides,
+    const T* updates,
+    const int axis,
+    T* output_data,
+    const ScatterReduction reduction) {
+  switch (reduction) {
+    case ScatterReduction::Add:
+      return ScatterElementsImplInternal(rank, input_data, input_size, buffer_input_dims,
+                                         buffer_input_strides, indices_data, indices_size, buffer_indices_dims,
+                                         fdm_indices_strides, updates, axis, output_data, Func_AtomicAdd<T>());
+    case ScatterReduction::Mul:
+      return ScatterElementsImplInternal(rank, input_data, input_size, buffer_input_dims,
+                                         buffer_input_strides, indices_data, indices_size, buffer_indices_dims,
+                                         fdm_indices_strides, updates, axis, output_data, Func_AtomicMul<T>());
+    case ScatterReduction::Max:
+      return ScatterElementsImplInternal(rank, input_data, input_size, buffer_input_dims,
+                                         buffer_input_strides, indices_data, indices_size, buffer_indices_dims,
+                                         fdm_indices_strides, updates, axis, output_data, Func_AtomicMax<T>());
+    default:
+      return ScatterElementsImpl(rank, input_data, input_size, buffer_input_dims,
+                                 buffer_input_strides, indices_data, indices_size, buffer_indices_dims,
+                                 fdm_indices_strides, updates, axis, output_data);
   }
-};
+}
+
+#define SCATTER_ELEMENTS_REDUCE_SPECIALIZED_TINDEX_IMPL(T, TIndex) \
+  template Status ScatterElementsReduceImpl<T, TIndex>(            \
+      const int rank,                                              \
+      const T* input_data,                                         \
+      const int64_t input_size,                                    \
+      TArray<int64_t>& buffer_input_dims,                          \
+      TArray<int64_t>& buffer_input_strides,                       \
+      const TIndex* indices_data,                                  \
+      const int64_t indices_size,                                  \
+      TArray<int64_t>& buffer_indices_dims,                        \
+      TArray<fast_divmod>& indices_strides,                        \
+      const T* updates,                                            \
+      const int axis,                                              \
+      T* output_data,                                              \
+      const ScatterReduction reduction)
+
+#define SCATTER_ELEMENTS_REDUCE_SPECIALIZED_IMPL(T)            \
+  SCATTER_ELEMENTS_REDUCE_SPECIALIZED_TINDEX_IMPL(T, int32_t); \
+  SCATTER_ELEMENTS_REDUCE_SPECIALIZED_TINDEX_IMPL(T, int64_t);
+
+SCATTER_ELEMENTS_REDUCE_SPECIALIZED_IMPL(int32_t)
+SCATTER_ELEMENTS_REDUCE_SPECIALIZED_IMPL(int64_t)
+SCATTER_ELEMENTS_REDUCE_SPECIALIZED_IMPL(float)
+SCATTER_ELEMENTS_REDUCE_SPECIALIZED_IMPL(double)
+
+#ifdef ENABLE_TRAINING
 
 template <typename T, typename Tin>
 Status GatherElementsGradImpl(
@@ -5,6 +5,7 @@
 
 #include <stdint.h>
 #include "core/providers/cuda/shared_inc/cuda_utils.h"
+#include "core/providers/cpu/tensor/scatter_reduction.h"
 
 namespace onnxruntime {
 namespace cuda {
@@ -24,5 +25,22 @@ Status ScatterElementsImpl(
     const int axis,
     T* output_data);
 
+// Only implemented for int32_t, int64_t, float and double
+template <typename T, typename Tin>
+Status ScatterElementsReduceImpl(
+    const int rank,
+    const T* input_data,
+    const int64_t input_size,
+    TArray<int64_t>& buffer_input_dims,
+    TArray<int64_t>& buffer_input_strides,
+    const Tin* indices_data,
+    const int64_t indices_size,
+    TArray<int64_t>& buffer_indices_dims,
+    TArray<fast_divmod>& indices_strides,
+    const T* updates,
+    const int axis,
+    T* output_data,
+    const ScatterReduction reduction);
+
 }  // namespace cuda
 }  // namespace onnxruntime
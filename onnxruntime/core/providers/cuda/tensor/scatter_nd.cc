@@ -37,7 +37,14 @@ Status ScatterND::ComputeInternal(OpKernelContext* context) const {
   const auto& updates_shape = updates_tensor->Shape();
 
   // Validate input shapes
-  ValidateShapes(input_shape, indices_shape, updates_shape);
+  ORT_RETURN_IF_ERROR(ValidateShapes(input_shape, indices_shape, updates_shape));
+
+  if (reduction_ != ScatterReduction::None &&
+      !input_tensor->IsDataType<float>() && !input_tensor->IsDataType<double>() &&
+      !input_tensor->IsDataType<int32_t>() && !input_tensor->IsDataType<int64_t>()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "reduction is only supported for float, double, int32 and int64 data");
+  }
 
   auto* output_tensor = context->Output(0, input_shape);
 
@@ -70,6 +77,28 @@ Status ScatterND::ComputeInternal(OpKernelContext* context) const {
   CudaAsyncBuffer<int64_t> element_counts_and_input_dims_gpu(this, element_counts_and_input_dims);
   element_counts_and_input_dims_gpu.CopyToGpu();
 
+  if (reduction_ != ScatterReduction::None) {
+    const size_t num_indices = indices_shape.Size() / static_cast<size_t>(last_index_dimension);
+    const size_t num_updates_elements = input_shape.SizeFromDimension(last_index_dimension);
+    const int64_t* indices_data = indices_tensor->Data<int64_t>();
+    if (input_tensor->IsDataType<float>()) {
+      return ScatterNDReduceImpl(output_tensor->MutableData<float>(), num_indices, indices_data, last_index_dimension,
+                                 element_counts_and_input_dims_gpu.GpuPtr(), updates_tensor->Data<float>(),
+                                 num_updates_elements, reduction_);
+    } else if (input_tensor->IsDataType<double>()) {
+      return ScatterNDReduceImpl(output_tensor->MutableData<double>(), num_indices, indices_data, last_index_dimension,
+                                 element_counts_and_input_dims_gpu.GpuPtr(), updates_tensor->Data<double>(),
+                                 num_updates_elements, reduction_);
+    } else if (input_tensor->IsDataType<int32_t>()) {
+      return ScatterNDReduceImpl(output_tensor->MutableData<int32_t>(), num_indices, indices_data, last_index_dimension,
+                                 element_counts_and_input_dims_gpu.GpuPtr(), updates_tensor->Data<int32_t>(),
+                                 num_updates_elements, reduction_);
+    }
+    return ScatterNDReduceImpl(output_tensor->MutableData<int64_t>(), num_indices, indices_data, last_index_dimension,
+                               element_counts_and_input_dims_gpu.GpuPtr(), updates_tensor->Data<int64_t>(),
+                               num_updates_elements, reduction_);
+  }
+
   ORT_RETURN_IF_ERROR(ScatterNDImpl(
       output_data,
       element_size,
@@ -84,4 +113,25 @@ Status ScatterND::ComputeInternal(OpKernelContext* context) const {
 }
 
 }  // namespace cuda
+
+#ifndef DISABLE_CONTRIB_OPS
+
+namespace contrib {
+namespace cuda {
+
+// ScatterND with the 'reduction' attribute of the later ONNX opsets
+ONNX_OPERATOR_KERNEL_EX(ScatterND,
+                        kMSDomain,
+                        1,
+                        kCudaExecutionProvider,
+                        KernelDefBuilder()
+                            .TypeConstraint("T", DataTypeImpl::AllFixedSizeTensorTypes())
+                            .MayInplace(0, 0),
+                        onnxruntime::cuda::ScatterND);
+
+}  // namespace cuda
+}  // namespace contrib
+
+#endif
+
 }  // namespace onnxruntime
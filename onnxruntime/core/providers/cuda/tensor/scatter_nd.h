@@ -12,8 +12,14 @@ namespace cuda {
 
 class ScatterND final : public CudaKernel, protected ScatterNDBase {
  public:
-  explicit ScatterND(const OpKernelInfo& info) : CudaKernel(info) {}
+  explicit ScatterND(const OpKernelInfo& info) : CudaKernel(info) {
+    // only the contrib op has the attribute
+    reduction_ = ScatterReductionFromString(info.GetAttrOrDefault<std::string>("reduction", "none"));
+  }
   Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  ScatterReduction reduction_;
 };
 
 }  // namespace cuda
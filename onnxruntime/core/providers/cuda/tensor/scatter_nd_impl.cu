@@ -3,12 +3,12 @@
 
 #include "core/providers/cuda/tensor/scatter_nd_impl.h"
 #include "core/providers/cuda/cu_inc/common.cuh"
-#include "core/providers/cuda/atomic/common.cuh"
+#include "core/providers/cuda/tensor/scatter_reduction.cuh"
 
 namespace onnxruntime {
 namespace cuda {
 
-template <typename T>
+template <typename T, typename FuncT>
 __global__ void _ScatterNDKernel(
     T* output_data,
     const size_t num_indices,
@@ -16,7 +16,8 @@ __global__ void _ScatterNDKernel(
     const int64_t last_index_dimension,
     const int64_t* element_counts_and_input_dims,
     const T* updates_data,
-    const size_t num_updates_elements) {
+    const size_t num_updates_elements,
+    const FuncT func) {
   CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, num_indices);
 
   // Compute the base offset into the output data
@@ -47,7 +48,7 @@ __global__ void _ScatterNDKernel(
   T* output_data_base = output_data + data_offset;
 
   for (size_t i = 0; i < num_updates_elements; ++i) {
-    output_data_base[i] = updates_data_base[i];
+    func(output_data_base + i, updates_data_base + i);
   }
 }
 
@@ -75,7 +76,8 @@ Status ScatterNDImpl(
           last_index_dimension,
           element_counts_and_input_dims,
           reinterpret_cast<const int8_t*>(updates_data),
-          num_updates_elements);
+          num_updates_elements,
+          Func_Assignment<int8_t>());
       break;
 
     case sizeof(int16_t):
@@ -86,7 +88,8 @@ Status ScatterNDImpl(
           last_index_dimension,
           element_counts_and_input_dims,
           reinterpret_cast<const int16_t*>(updates_data),
-          num_updates_elements);
+          num_updates_elements,
+          Func_Assignment<int16_t>());
       break;
 
     case sizeof(int32_t):
@@ -97,7 +100,8 @@ Status ScatterNDImpl(
           last_index_dimension,
           element_counts_and_input_dims,
           reinterpret_cast<const int32_t*>(updates_data),
-          num_updates_elements);
+          num_updates_elements,
+          Func_Assignment<int32_t>());
       break;
 
     case sizeof(int64_t):
@@ -108,7 +112,8 @@ Status ScatterNDImpl(
           last_index_dimension,
           element_counts_and_input_dims,
           reinterpret_cast<const int64_t*>(updates_data),
-          num_updates_elements);
+          num_updates_elements,
+          Func_Assignment<int64_t>());
       break;
 
     default:
@@ -119,5 +124,73 @@ Status ScatterNDImpl(
   return Status::OK();
 }
 
+template <typename T, typename FuncT>
+void ScatterNDReduce(
+    T* output_data,
+    const size_t num_indices,
+    const int64_t* indices_data,
+    const int64_t last_index_dimension,
+    const int64_t* element_counts_and_input_dims,
+    const T* updates_data,
+    const size_t num_updates_elements,
+    const FuncT& func) {
+  int blocksPerGrid = static_cast<int>(CeilDiv(num_indices, GridDim::maxThreadsPerBlock));
+  _ScatterNDKernel<T, FuncT><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0>>>(
+      output_data, num_indices, indices_data, last_index_dimension, element_counts_and_input_dims,
+      updates_data, num_updates_elements, func);
+}
+
+template <typename T>
+Status ScatterNDReduceImpl(
+    T* output_data,
+    const size_t num_indices,
+    const int64_t* indices_data,
+    const int64_t last_index_dimension,
+    const int64_t* element_counts_and_input_dims,
+    const T* updates_data,
+    const size_t num_updates_elements,
+    const ScatterReduction reduction) {
+  if (num_indices == 0)
+    return Status::OK();
+
+  // Different indices may address the same slice so the updates are combined atomically
+  switch (reduction) {
+    case ScatterReduction::Add:
+      ScatterNDReduce(output_data, num_indices, indices_data, last_index_dimension, element_counts_and_input_dims,
+                      updates_data, num_updates_elements, Func_AtomicAdd<T>());
+      break;
+    case ScatterReduction::Mul:
+      ScatterNDReduce(output_data, num_indices, indices_data, last_index_dimension, element_counts_and_input_dims,
+                      updates_data, num_updates_elements, Func_AtomicMul<T>());
+      break;
+    case ScatterReduction::Max:
+      ScatterNDReduce(output_data, num_indices, indices_data, last_index_dimension, element_counts_and_input_dims,
+                      updates_data, num_updates_elements, Func_AtomicMax<T>());
+      break;
+    default:
+      ScatterNDReduce(output_data, num_indices, indices_data, last_index_dimension, element_counts_and_input_dims,
+                      updates_data, num_updates_elements, Func_Assignment<T>());
+      break;
+  }
+
+  return Status::OK();
+}
+
+#define SCATTER_ND_REDUCE_SPECIALIZED_IMPL(T)         \
+  template Status ScatterNDReduceImpl<T>(             \
+      T* output_data,                                 \
+      const size_t num_indices,                       \
+      const int64_t* indices_data,                    \
+      const int64_t last_index_dimension,             \
+      const int64_t* element_counts_and_input_dims,   \
+      const T* updates_data,                          \
+      const size_t num_updates_elements,              \
+      const ScatterReduction reduction);
+
+SCATTER_ND_REDUCE_SPECIALIZED_IMPL(int32_t)
+SCATTER_ND_REDUCE_SPECIALIZED_IMPL(int64_t)
+SCATTER_ND_REDUCE_SPECIALIZED_IMPL(float)
+SCATTER_ND_REDUCE_SPECIALIZED_IMPL(double)
+
 }  // namespace cuda
 }  // namespace onnxruntime
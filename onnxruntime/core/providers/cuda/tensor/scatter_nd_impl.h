@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/providers/cuda/shared_inc/cuda_utils.h"
+#include "core/providers/cpu/tensor/scatter_reduction.h"
 
 namespace onnxruntime {
 namespace cuda {
@@ -18,5 +19,17 @@ Status ScatterNDImpl(
     const void* updates_data,
     const size_t num_updates_elements);
 
+// Only implemented for int32_t, int64_t, float and double
+template <typename T>
+Status ScatterNDReduceImpl(
+    T* output_data,
+    const size_t num_indices,
+    const int64_t* indices_data,
+    const int64_t last_index_dimension,
+    const int64_t* element_counts_and_input_dims,
+    const T* updates_data,
+    const size_t num_updates_elements,
+    const ScatterReduction reduction);
+
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/atomic/common.cuh"
+
+namespace onnxruntime {
+namespace cuda {
+
+// Functors applying an update to an output element in the scatter kernels. The threads of the kernels update the
+// output elements concurrently so the reductions are atomic.
+
+template <class T>
+struct Func_Assignment {
+  __device__ __inline__ void operator()(T* a, const T* b) const {
+    *a = *b;
+  }
+};
+
+template <class T>
+struct Func_AtomicAdd {
+  __device__ __inline__ void operator()(T* a, const T* b) const {
+    atomic_add(a, *b);
+  }
+};
+
+template <class T>
+struct Func_AtomicMul {
+  __device__ __inline__ void operator()(T* a, const T* b) const {
+    atomic_mul(a, *b);
+  }
+};
+
+template <class T>
+struct Func_AtomicMax {
+  __device__ __inline__ void operator()(T* a, const T* b) const {
+    atomic_max(a, *b);
+  }
+};
+
+}  // namespace cuda
+}  // namespace onnxruntime
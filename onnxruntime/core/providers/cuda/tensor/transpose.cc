@@ -27,27 +27,17 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("T", DataTypeImpl::AllFixedSizeTensorTypes()),
     Transpose);
 
-// special case acceleration using cublas matrix transpose
-static std::tuple<int, int> TryTransposeWithCublas(const std::vector<size_t>& perm, const TensorShape& input_shape) {
+// special case acceleration using cublas matrix transpose, for canonical permutations of a 2D matrix transpose.
+// this includes NCHW <-> NHWC when N == 1.
+static std::tuple<int, int> TryTransposeWithCublas(const std::vector<size_t>& perm,
+                                                   const std::vector<int64_t>& input_dims) {
   int M = 0;
   int N = 0;
 
-  if (perm.size() == 4 && input_shape[0] == 1 && perm[0] == 0) {
-    // NCHW <-> NHWC when N == 1
-    if ((perm[1] == 2 && perm[2] == 3 && perm[3] == 1) ||
-        (perm[1] == 3 && perm[2] == 1 && perm[3] == 2)) {
-      if (perm[1] == 2) {
-        M = gsl::narrow<int>(input_shape[1]);
-        N = gsl::narrow<int>(input_shape[2] * input_shape[3]);
-      } else {
-        M = gsl::narrow<int>(input_shape[1] * input_shape[2]);
-        N = gsl::narrow<int>(input_shape[3]);
-      }
-    }
-  } else if (perm.size() == 2 && perm[1] == 0 && perm[0] == 1) {
+  if (perm.size() == 2 && perm[1] == 0 && perm[0] == 1) {
     // 2D matrix transpose
-    M = gsl::narrow<int>(input_shape[0]);
-    N = gsl::narrow<int>(input_shape[1]);
+    M = gsl::narrow<int>(input_dims[0]);
+    N = gsl::narrow<int>(input_dims[1]);
   }
 
   return std::make_tuple(M, N);
@@ -87,11 +77,27 @@ Status Transpose::DoTranspose(const cudaDeviceProp& prop,
   if (output.Shape().Size() == 0)
     return Status::OK();
 
+  const std::vector<int64_t>& input_dims = input_shape_override ? input_shape_override->GetDims() : input.Shape().GetDims();
+
+  // remove the dims of size 1 and flatten the adjacent dimensions which are contiguous
+  // for example: permutations[0, 2, 3, 1] -> [0, 2, 1], permutations[0, 3, 1, 2] -> [0, 2, 1]
+  std::vector<size_t> new_permutations(permutations);
+  std::vector<int64_t> new_input_dims(input_dims);
+  CanonicalizeTranspose(new_permutations, new_input_dims);
+  auto new_rank = static_cast<int32_t>(new_input_dims.size());
+
+  // the dims with values > 1 stay in the same order, so it's a copy
+  if (new_rank <= 1) {
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(output.MutableDataRaw(), input.DataRaw(), input.SizeInBytes(),
+                                         cudaMemcpyDeviceToDevice));
+    return Status::OK();
+  }
+
   auto element_type = input.GetElementType();
   if (element_type == utils::GetONNXTensorElementDataType<float>() ||
       element_type == utils::GetONNXTensorElementDataType<double>() ||
       element_type == utils::GetONNXTensorElementDataType<MLFloat16>()) {
-    auto mn = TryTransposeWithCublas(permutations, input_shape_override ? *input_shape_override : input.Shape());
+    auto mn = TryTransposeWithCublas(new_permutations, new_input_dims);
     int M = std::get<0>(mn);
     int N = std::get<1>(mn);
     if (M != 0 && N != 0) {
@@ -105,53 +111,21 @@ Status Transpose::DoTranspose(const cudaDeviceProp& prop,
     }
   }
 
-  const std::vector<int64_t>& input_dims = input_shape_override ? input_shape_override->GetDims() : input.Shape().GetDims();
-  const std::vector<int64_t>& output_dims = output.Shape().GetDims();
-  auto rank = static_cast<int32_t>(input_dims.size());
-
-  // flatten the adjacent dimensions which are contiguous
-  // for example: permutations[0, 2, 3, 1] -> [0, 2, 1], permutations[0, 3, 1, 2] -> [0, 2, 1]
-  auto new_rank = rank;
-  std::vector<size_t> new_permutations(permutations);
-  std::vector<int64_t> new_input_dims(input_dims);
-  std::vector<int64_t> new_output_dims(output_dims);
-
-  for (auto i = rank - 1; i > 0; i--) {
-    auto curr = new_permutations[i];
-    auto prev = new_permutations[i - 1];
-    if (prev + 1 == curr) {
-      // all dims bigger than curr need to be reduced by 1 due to the merging.
-      for (auto j = 0; j < new_rank; j++) {
-        if (new_permutations[j] > curr) {
-          new_permutations[j] -= 1;
-        }
-      }
-      for (auto j = i+1; j < new_rank; j++) {
-        new_permutations[j-1] = new_permutations[j];
-      }
-
-      // update input dims
-      new_input_dims[prev] *= new_input_dims[curr];
-      new_input_dims[curr] = 1;
-      for (auto j = static_cast<int32_t>(curr+1); j < new_rank; j++) {
-        new_input_dims[j-1] = new_input_dims[j];
-      }
-      new_input_dims[new_rank-1] = 1;
-
-      // update output dims
-      new_output_dims[i-1] *= new_output_dims[i];
-      new_output_dims[i] = 1;
-      for (auto j = i+1; j < new_rank; j++) {
-        new_output_dims[j-1] = new_output_dims[j];
-      }
-      new_output_dims[new_rank-1] = 1;
-
-      new_rank--;
+  // a batch of one lets the canonical permutations [1, 0] and [1, 0, 2] use the 3D and 4D kernels
+  if ((new_rank == 2 && new_permutations[0] == 1) ||
+      (new_rank == 3 && new_permutations[0] == 1 && new_permutations[1] == 0 && new_permutations[2] == 2)) {
+    for (auto& p : new_permutations) {
+      ++p;
     }
+    new_permutations.insert(new_permutations.begin(), 0);
+    new_input_dims.insert(new_input_dims.begin(), 1);
+    new_rank++;
+  }
+
+  std::vector<int64_t> new_output_dims(new_rank);
+  for (auto i = 0; i < new_rank; i++) {
+    new_output_dims[i] = new_input_dims[new_permutations[i]];
   }
-  new_permutations.resize(new_rank);
-  new_input_dims.resize(new_rank);
-  new_output_dims.resize(new_rank);
 
   TensorPitches new_input_strides(new_input_dims);
   TensorPitches new_output_strides(new_output_dims);
@@ -169,16 +169,15 @@ namespace Dml
 
             if (graphDesc.reuseCommandList)
             {
-                BuildReusableCommandList();
+                m_reusableCommandLists.push_back(BuildReusableCommandList());
             }
         }
 
         onnxruntime::Status Compute(onnxruntime::OpKernelContext* kernelContext) const override
         {
-            // Only re-use the cached command list if its prior execution is complete on the GPU.
-            // This requirement can be avoided by mantaining ring buffers.
-            if (!m_graphicsCommandList || 
-                (m_fence != nullptr && m_fence->GetCompletedValue() < m_completionValue))
+            // Only re-use a cached command list if its prior execution is complete on the GPU.
+            ReusableCommandListState* reusableCommandList = GetIdleReusableCommandList();
+            if (!reusableCommandList)
             {
                 // Wrap tensors as required by Dml::IExecutionProvider::ExecuteOperator
                 OpKernelContextWrapper contextWrapper(
@@ -226,7 +225,7 @@ namespace Dml
             }
             else
             {
-                ExecuteReusableCommandList(kernelContext);
+                ExecuteReusableCommandList(kernelContext, *reusableCommandList);
             }
 
             return onnxruntime::Status::OK();
@@ -296,8 +295,58 @@ namespace Dml
             }
 
     private:
-        void BuildReusableCommandList()
+        // Re-usable command list, supporting descriptor heap, and DML binding table to update that heap.
+        struct ReusableCommandListState
+        {
+            ComPtr<ID3D12GraphicsCommandList> graphicsCommandList;
+            ComPtr<ID3D12DescriptorHeap> heap;
+            ComPtr<IDMLBindingTable> bindingTable;
+
+            // Bindings from previous executions of the command list
+            std::vector<uint64_t> inputBindingAllocIds;
+            std::vector<uint64_t> outputBindingAllocIds;
+            uint64_t tempBindingAllocId = 0;
+
+            // Fence tracking the status of the command list's last execution, and whether its descriptor heap 
+            // can safely be updated.
+            ComPtr<ID3D12Fence> fence;
+            uint64_t completionValue = 0;
+        };
+
+        // Maximum number of re-usable command lists in flight. Additional command lists are recorded on demand
+        // when consecutive executions are submitted before the GPU completes the previous ones.
+        static constexpr size_t c_maxReusableCommandLists = 3;
+
+        // Returns a re-usable command list whose prior execution is complete, or nullptr if command lists
+        // are not re-used for this graph or all of them are in flight.
+        ReusableCommandListState* GetIdleReusableCommandList() const
+        {
+            if (m_reusableCommandLists.empty())
+            {
+                return nullptr;
+            }
+
+            for (auto& commandList : m_reusableCommandLists)
+            {
+                if (commandList->fence == nullptr || commandList->fence->GetCompletedValue() >= commandList->completionValue)
+                {
+                    return commandList.get();
+                }
+            }
+
+            if (m_reusableCommandLists.size() < c_maxReusableCommandLists)
+            {
+                m_reusableCommandLists.push_back(BuildReusableCommandList());
+                return m_reusableCommandLists.back().get();
+            }
+
+            return nullptr;
+        }
+
+        std::unique_ptr<ReusableCommandListState> BuildReusableCommandList() const
         {
+            auto commandListState = std::make_unique<ReusableCommandListState>();
+
             ComPtr<IDMLDevice> device;
             THROW_IF_FAILED(m_provider->GetDmlDevice(device.GetAddressOf()));
 
@@ -311,16 +360,16 @@ namespace Dml
             ComPtr<ID3D12Device> d3dDevice;
             THROW_IF_FAILED(m_provider->GetD3DDevice(d3dDevice.GetAddressOf()));
 
-            THROW_IF_FAILED(d3dDevice->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&m_heap)));
+            THROW_IF_FAILED(d3dDevice->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&commandListState->heap)));
 
             // Create a binding table for execution.
             DML_BINDING_TABLE_DESC bindingTableDesc = {};
             bindingTableDesc.Dispatchable = m_compiledExecutionPlanOperator.Get();
-            bindingTableDesc.CPUDescriptorHandle = m_heap->GetCPUDescriptorHandleForHeapStart();
-            bindingTableDesc.GPUDescriptorHandle = m_heap->GetGPUDescriptorHandleForHeapStart();
+            bindingTableDesc.CPUDescriptorHandle = commandListState->heap->GetCPUDescriptorHandleForHeapStart();
+            bindingTableDesc.GPUDescriptorHandle = commandListState->heap->GetGPUDescriptorHandleForHeapStart();
             bindingTableDesc.SizeInDescriptors = execBindingProps.RequiredDescriptorCount;
 
-            THROW_IF_FAILED(device->CreateBindingTable(&bindingTableDesc, IID_PPV_ARGS(&m_bindingTable)));
+            THROW_IF_FAILED(device->CreateBindingTable(&bindingTableDesc, IID_PPV_ARGS(&commandListState->bindingTable)));
 
             ComPtr<ID3D12CommandAllocator> allocator;
             THROW_IF_FAILED(d3dDevice->CreateCommandAllocator(
@@ -335,27 +384,29 @@ namespace Dml
                 nullptr,
                 IID_PPV_ARGS(&commandList)));
             
-            THROW_IF_FAILED(commandList.As(&m_graphicsCommandList));
+            THROW_IF_FAILED(commandList.As(&commandListState->graphicsCommandList));
 
             if (m_persistentResource)
             {
                 DML_BINDING_DESC persistentResourceBindingDesc =
                     { DML_BINDING_TYPE_BUFFER, m_persistentResourceBinding ? &*m_persistentResourceBinding : nullptr };
-                m_bindingTable->BindPersistentResource(&persistentResourceBindingDesc);
+                commandListState->bindingTable->BindPersistentResource(&persistentResourceBindingDesc);
             }
 
-            ID3D12DescriptorHeap* descriptorHeaps[] = { m_heap.Get() };
-            m_graphicsCommandList->SetDescriptorHeaps(ARRAYSIZE(descriptorHeaps), descriptorHeaps);
+            ID3D12DescriptorHeap* descriptorHeaps[] = { commandListState->heap.Get() };
+            commandListState->graphicsCommandList->SetDescriptorHeaps(ARRAYSIZE(descriptorHeaps), descriptorHeaps);
 
             ComPtr<IDMLCommandRecorder> recorder;
             THROW_IF_FAILED(device->CreateCommandRecorder(IID_PPV_ARGS(recorder.GetAddressOf())));
 
-            recorder->RecordDispatch(commandList.Get(), m_compiledExecutionPlanOperator.Get(), m_bindingTable.Get());
+            recorder->RecordDispatch(commandList.Get(), m_compiledExecutionPlanOperator.Get(), commandListState->bindingTable.Get());
+
+            THROW_IF_FAILED(commandListState->graphicsCommandList->Close());
 
-            THROW_IF_FAILED(m_graphicsCommandList->Close());
+            return commandListState;
         }
 
-        void ExecuteReusableCommandList(onnxruntime::OpKernelContext* kernelContext) const
+        void ExecuteReusableCommandList(onnxruntime::OpKernelContext* kernelContext, ReusableCommandListState& commandListState) const
         {
             DML_BINDING_PROPERTIES execBindingProps = m_compiledExecutionPlanOperator->GetBindingProperties();
                 
@@ -370,7 +421,7 @@ namespace Dml
 
             // Populate input bindings, excluding those which were specified as owned by DML and provided 
             // at initialization instead.
-            m_inputBindingAllocIds.resize(inputBindings.size());
+            commandListState.inputBindingAllocIds.resize(inputBindings.size());
             bool inputBindingsChanged = false;
 
             for (uint32_t i = 0; i < inputBindings.size(); ++i)
@@ -389,25 +440,25 @@ namespace Dml
 
                         uint64_t allocId;
                         GraphKernelHelper::UnwrapTensor(m_winmlProvider.Get(), tensor, &inputBindings[i].Buffer, &allocId);
-                        inputBindingsChanged = inputBindingsChanged || (!allocId || m_inputBindingAllocIds[i] != allocId);
+                        inputBindingsChanged = inputBindingsChanged || (!allocId || commandListState.inputBindingAllocIds[i] != allocId);
                         inputBindings[i].Buffer->Release(); // Avoid holding an additional reference
                         inputBindings[i].SizeInBytes = GraphKernelHelper::AlignToPow2<size_t>(tensor->SizeInBytes(), 4);
                         inputBindingDescs[i] = {DML_BINDING_TYPE_BUFFER, &inputBindings[i]};
-                        m_inputBindingAllocIds[i] = allocId;
+                        commandListState.inputBindingAllocIds[i] = allocId;
                     }
                 }
             }
                 
             if (inputBindingsChanged)
             {
-                m_bindingTable->BindInputs(gsl::narrow_cast<uint32_t>(inputBindingDescs.size()), inputBindingDescs.data());
+                commandListState.bindingTable->BindInputs(gsl::narrow_cast<uint32_t>(inputBindingDescs.size()), inputBindingDescs.data());
             }
 
             // Populate Output bindings
             std::vector<DML_BUFFER_BINDING> outputBindings(kernelContext->OutputCount());
             std::vector<DML_BINDING_DESC> outputBindingDescs(kernelContext->OutputCount());
 
-            m_outputBindingAllocIds.resize(outputBindings.size());
+            commandListState.outputBindingAllocIds.resize(outputBindings.size());
             bool outputBindingsChanged = false;
             
             for (uint32_t i = 0; i < outputBindings.size(); ++i)
@@ -426,16 +477,16 @@ namespace Dml
 
                 uint64_t allocId;
                 GraphKernelHelper::UnwrapTensor(m_winmlProvider.Get(), tensor, &outputBindings[i].Buffer, &allocId);
-                outputBindingsChanged = outputBindingsChanged || (!allocId || m_outputBindingAllocIds[i] != allocId);
+                outputBindingsChanged = outputBindingsChanged || (!allocId || commandListState.outputBindingAllocIds[i] != allocId);
                 outputBindings[i].Buffer->Release(); // Avoid holding an additional reference
                 outputBindings[i].SizeInBytes = GraphKernelHelper::AlignToPow2<size_t>(tensor->SizeInBytes(), 4);
                 outputBindingDescs[i] = {DML_BINDING_TYPE_BUFFER, &outputBindings[i]};
-                m_outputBindingAllocIds[i] = allocId;
+                commandListState.outputBindingAllocIds[i] = allocId;
             }
 
             if (outputBindingsChanged)
             {
-                m_bindingTable->BindOutputs(gsl::narrow_cast<uint32_t>(outputBindingDescs.size()), outputBindingDescs.data());
+                commandListState.bindingTable->BindOutputs(gsl::narrow_cast<uint32_t>(outputBindingDescs.size()), outputBindingDescs.data());
             }
 
             if (execBindingProps.TemporaryResourceSize > 0)
@@ -455,26 +506,26 @@ namespace Dml
                 DML_BUFFER_BINDING tempBufferBinding = {tempResource.Get(), 0, execBindingProps.TemporaryResourceSize};
                 DML_BINDING_DESC tempBindingDesc = { DML_BINDING_TYPE_BUFFER, &tempBufferBinding };
 
-                if (!tempAllocId || m_tempBindingAllocId != tempAllocId)
+                if (!tempAllocId || commandListState.tempBindingAllocId != tempAllocId)
                 {
-                    m_bindingTable->BindTemporaryResource(&tempBindingDesc);
+                    commandListState.bindingTable->BindTemporaryResource(&tempBindingDesc);
                 }
             
-                m_tempBindingAllocId = tempAllocId;
+                commandListState.tempBindingAllocId = tempAllocId;
             }
 
             // Execute the command list and if it succeeds, update the fence value at which this command may be
             // re-used.
             ComPtr<ID3D12Fence> fence;
             uint64_t completionValue;
-            THROW_IF_FAILED(m_provider->ExecuteCommandList(m_graphicsCommandList.Get(), fence.GetAddressOf(), &completionValue));
-            m_fence = fence;
-            m_completionValue = completionValue;
+            THROW_IF_FAILED(m_provider->ExecuteCommandList(commandListState.graphicsCommandList.Get(), fence.GetAddressOf(), &completionValue));
+            commandListState.fence = fence;
+            commandListState.completionValue = completionValue;
 
             // Queue references to objects which must be kept alive until resulting GPU work completes
-            m_winmlProvider->QueueReference(m_graphicsCommandList.Get());
-            m_winmlProvider->QueueReference(m_heap.Get());
-            m_winmlProvider->QueueReference(m_bindingTable.Get());
+            m_winmlProvider->QueueReference(commandListState.graphicsCommandList.Get());
+            m_winmlProvider->QueueReference(commandListState.heap.Get());
+            m_winmlProvider->QueueReference(commandListState.bindingTable.Get());
             m_winmlProvider->QueueReference(m_persistentResourceAllocatorUnk.Get());
         }
 
@@ -485,23 +536,13 @@ namespace Dml
         ComPtr<Dml::IExecutionProvider> m_provider;
         EdgeShapes m_outputShapes;
 
-        // Re-usable command list, supporting descriptor heap, and DML binding table to update that heap.
-        ComPtr<ID3D12GraphicsCommandList> m_graphicsCommandList;
-        ComPtr<ID3D12DescriptorHeap> m_heap;
-        ComPtr<IDMLBindingTable> m_bindingTable;
+        // Re-usable command lists, empty if command lists are not re-used for this graph
+        mutable std::vector<std::unique_ptr<ReusableCommandListState>> m_reusableCommandLists;
+
         std::optional<DML_BUFFER_BINDING> m_persistentResourceBinding;
         ComPtr<ID3D12Resource> m_persistentResource;
         ComPtr<IUnknown> m_persistentResourceAllocatorUnk; // Controls when the persistent resource is returned to the allocator
-        
-        // Bindings from previous executions of a re-used command list
-        mutable std::vector<uint64_t> m_inputBindingAllocIds;
-        mutable std::vector<uint64_t> m_outputBindingAllocIds;
-        mutable uint64_t m_tempBindingAllocId = 0;
-
-        // Fence tracking the status of the command list's last execution, and whether its descriptor heap 
-        // can safely be updated.
-        mutable ComPtr<ID3D12Fence> m_fence;
-        mutable uint64_t m_completionValue = 0;
+
 
         std::vector<uint8_t> m_inputsConstant;
         std::vector<ComPtr<ID3D12Resource>> m_nonOwnedGraphInputsFromInitializers;
@@ -80,6 +80,10 @@ class PrimitiveBase {
   virtual ~PrimitiveBase() = default;
 };
 
+// Maximum number of primitives kept per thread by each PrimitivePool, 0 means unlimited.
+static const std::string kPrimitiveCacheCapacityEnv = "ORT_DNNL_PRIMITIVE_CACHE_CAPACITY";
+constexpr size_t kDefaultPrimitiveCacheCapacity = 1024;
+
 template <typename T>
 class PrimitivePool {
  public:
@@ -87,29 +91,50 @@ class PrimitivePool {
   ~PrimitivePool() = default;
 
   void SetPrimitive(const std::string& key, std::unique_ptr<PrimitiveBase> primitive) {
-    auto& map = PrimitivePool<T>::GetMap();
-    auto iter = map.find(key);
+    auto& cache = PrimitivePool<T>::GetCache();
+    auto iter = cache.map.find(key);
     // We should not find a primitive already using this key.
-    ORT_ENFORCE(iter == map.end(), "duplicate key: " + key);
-    map.insert(std::make_pair(key, std::move(primitive)));
+    ORT_ENFORCE(iter == cache.map.end(), "duplicate key: " + key);
+    cache.lru_keys.push_front(key);
+    cache.map.insert(std::make_pair(key, std::make_pair(std::move(primitive), cache.lru_keys.begin())));
+
+    // Evict the least recently used primitives, primitives are created for every new input shape
+    const size_t capacity = GetCapacity();
+    while (capacity > 0 && cache.map.size() > capacity) {
+      cache.map.erase(cache.lru_keys.back());
+      cache.lru_keys.pop_back();
+    }
   }
 
   PrimitiveBase* GetPrimitive(const std::string& key) {
-    const auto& map = PrimitivePool<T>::GetMap();
-    auto iter = map.find(key);
-    if (iter != map.end()) {
-      return iter->second.get();
+    auto& cache = PrimitivePool<T>::GetCache();
+    auto iter = cache.map.find(key);
+    if (iter != cache.map.end()) {
+      cache.lru_keys.splice(cache.lru_keys.begin(), cache.lru_keys, iter->second.second);
+      return iter->second.first.get();
     } else {
       return nullptr;
     }
   }
 
  private:
-  // For thread safety, the map needs to be kept in thread local storage.
-  static inline std::unordered_map<std::string, std::unique_ptr<PrimitiveBase>>& GetMap() {
-    using MapType = std::unordered_map<std::string, std::unique_ptr<PrimitiveBase>>;
-    static thread_local DeleteOnUnloadPtr<MapType> map(new MapType());
-    return *map;
+  struct Cache {
+    std::list<std::string> lru_keys;  // most recently used first
+    std::unordered_map<std::string, std::pair<std::unique_ptr<PrimitiveBase>, std::list<std::string>::iterator>> map;
+  };
+
+  static size_t GetCapacity() {
+    static const size_t capacity = []() {
+      const std::string capacity_env = GetEnvironmentVar(kPrimitiveCacheCapacityEnv);
+      return capacity_env.empty() ? kDefaultPrimitiveCacheCapacity : static_cast<size_t>(std::stoull(capacity_env));
+    }();
+    return capacity;
+  }
+
+  // For thread safety, the cache needs to be kept in thread local storage.
+  static inline Cache& GetCache() {
+    static thread_local DeleteOnUnloadPtr<Cache> cache(new Cache());
+    return *cache;
   }
 };
 
@@ -116,6 +116,12 @@ MIGraphXExecutionProvider::MIGraphXExecutionProvider(const MIGraphXExecutionProv
   if (!fp16_enable_env.empty()) {
     fp16_enable_ = (std::stoi(fp16_enable_env) == 0 ? false : true);
   }
+
+  // number of compiled programs kept for each fused node
+  const std::string program_cache_size_env = env_instance.GetEnvironmentVar(migraphx_env_vars::kProgramCacheSize);
+  if (!program_cache_size_env.empty()) {
+    max_cached_programs_ = static_cast<std::size_t>(std::max(std::stoi(program_cache_size_env), 0));
+  }
 }
 
 AllocatorPtr MIGraphXExecutionProvider::GetAllocator(int id, OrtMemType mem_type) const {
@@ -1018,6 +1024,7 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<onnxruntime::Node*>&
       *p = {context->allocate_func, context->release_func, context->allocator_handle, map_progs_[context->node_name],
             map_onnx_string_[context->node_name], options, t_, map_input_index_[context->node_name], &mgx_mu_,
             map_no_input_shape_[context->node_name], fp16_enable_};
+      p->max_cached_programs = max_cached_programs_;
       *state = p.release();
       return 0;
     };
@@ -1038,64 +1045,83 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<onnxruntime::Node*>&
       bool& no_input_shape = mgx_state->no_input_shape;
       bool fp16_enable = mgx_state->fp16_enable;
 
-      // mean no program at all, so need to get the input shape info
-      // from input data
-      bool input_shape_match = true;
+      // lock to avoid race condition, the state is shared by the concurrent runs of the session
+      std::lock_guard<OrtMutex> lock(*(mgx_state->mgx_mu_ptr));
+
+      // input lengths in input index order, the key of the compiled programs
+      std::vector<std::vector<std::size_t>> input_lens(map_input_name_index.size());
+      for (auto& it : map_input_name_index) {
+        const OrtValue* input_tensor = ort.KernelContext_GetInput(context, it.second);
+        auto tensor_info = ort.GetTensorTypeAndShape(input_tensor);
+        const auto& tensor_shape = ort.GetTensorShape(tensor_info);
+        ort.ReleaseTensorTypeAndShapeInfo(tensor_info);
+        input_lens[it.second].assign(tensor_shape.begin(), tensor_shape.end());
+      }
+
       migraphx::program_parameter_shapes param_shapes;
-      if (no_input_shape) {
-        for (auto& it : map_input_name_index) {
-          auto& name = it.first;
-          auto& index = it.second;
-          const OrtValue* input_tensor = ort.KernelContext_GetInput(context, index);
-          auto tensor_info = ort.GetTensorTypeAndShape(input_tensor);
-          const auto& tensor_shape = ort.GetTensorShape(tensor_info);
-          std::vector<std::size_t> ort_lens(tensor_shape.begin(), tensor_shape.end());
-          cmp_options.set_input_parameter_shape(name, ort_lens);
-          input_shape_match = false;
-        }
-      } else {
+      auto cached = mgx_state->programs.find(input_lens);
+      if (cached != mgx_state->programs.end()) {
+        prog = cached->second.prog;
+        cached->second.last_use = ++mgx_state->use_count;
         param_shapes = prog.get_parameter_shapes();
-        auto prog_output_shapes = prog.get_output_shapes();
-
-        // check whether input shapes match with shapes of program inputs
-        // migraphx::onnx_options cmp_options;
-        if (param_shapes.size() > 0) {
-          for (auto&& name : param_shapes.names()) {
-            if (map_input_name_index.count(name) > 0) {
-              const OrtValue* input_tensor = ort.KernelContext_GetInput(context, map_input_name_index[name]);
-              auto tensor_info = ort.GetTensorTypeAndShape(input_tensor);
-              const auto& tensor_shape = ort.GetTensorShape(tensor_info);
-              std::vector<std::size_t> ort_lens(tensor_shape.begin(), tensor_shape.end());
-
-              auto mgx_s = param_shapes[name];
-              auto mgx_lens = mgx_s.lengths();
-              auto mgx_strides = mgx_s.strides();
-              if (mgx_lens.size() == 1 and mgx_lens[0] == 1 and
-                  mgx_strides.size() == 1 and mgx_strides[0] == 0) {
-                mgx_lens.clear();
-              }
-
-              if (mgx_lens != ort_lens) {
-                cmp_options.set_input_parameter_shape(name, ort_lens);
-                input_shape_match = false;
+      } else {
+        // mean no program at all, so need to get the input shape info
+        // from input data
+        bool input_shape_match = true;
+        if (no_input_shape) {
+          for (auto& it : map_input_name_index) {
+            cmp_options.set_input_parameter_shape(it.first, input_lens[it.second]);
+            input_shape_match = false;
+          }
+        } else {
+          param_shapes = prog.get_parameter_shapes();
+
+          // check whether input shapes match with shapes of program inputs
+          if (param_shapes.size() > 0) {
+            for (auto&& name : param_shapes.names()) {
+              if (map_input_name_index.count(name) > 0) {
+                const auto& ort_lens = input_lens[map_input_name_index[name]];
+
+                auto mgx_s = param_shapes[name];
+                auto mgx_lens = mgx_s.lengths();
+                auto mgx_strides = mgx_s.strides();
+                if (mgx_lens.size() == 1 and mgx_lens[0] == 1 and
+                    mgx_strides.size() == 1 and mgx_strides[0] == 0) {
+                  mgx_lens.clear();
+                }
+
+                if (mgx_lens != ort_lens) {
+                  cmp_options.set_input_parameter_shape(name, ort_lens);
+                  input_shape_match = false;
+                }
               }
             }
           }
         }
-      }
 
-      // input shapes are different, needs to re-parse onnx and
-      // re-compile the program
-      if (!input_shape_match) {
-        prog = migraphx::parse_onnx_buffer(onnx_string, cmp_options);
-        if (fp16_enable) {
-          migraphx::quantize_fp16(prog);
+        // input shapes are different, needs to re-parse onnx and
+        // re-compile the program
+        if (!input_shape_match) {
+          prog = migraphx::parse_onnx_buffer(onnx_string, cmp_options);
+          if (fp16_enable) {
+            migraphx::quantize_fp16(prog);
+          }
+
+          prog.compile(t);
+          param_shapes = prog.get_parameter_shapes();
+          no_input_shape = false;
         }
 
-        prog.compile(t);
-        mgx_state->prog = prog;
-        param_shapes = prog.get_parameter_shapes();
-        no_input_shape = false;
+        if (mgx_state->max_cached_programs > 0) {
+          if (mgx_state->programs.size() >= mgx_state->max_cached_programs) {
+            auto lru = std::min_element(mgx_state->programs.begin(), mgx_state->programs.end(),
+                                        [](const auto& a, const auto& b) {
+                                          return a.second.last_use < b.second.last_use;
+                                        });
+            mgx_state->programs.erase(lru);
+          }
+          mgx_state->programs[input_lens] = {prog, ++mgx_state->use_count};
+        }
       }
 
       migraphx::program_parameters m;
@@ -1151,8 +1177,6 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<onnxruntime::Node*>&
       }
 
       {
-        // lock to avoid race condition
-        std::lock_guard<OrtMutex> lock(*(mgx_state->mgx_mu_ptr));
         auto prog_outputs = prog.eval(m);
         hipDeviceSynchronize();
 
@@ -12,6 +12,7 @@ namespace onnxruntime {
 
 namespace migraphx_env_vars {
 static const std::string kFP16Enable = "ORT_MIGRAPHX_FP16_ENABLE";
+static const std::string kProgramCacheSize = "ORT_MIGRAPHX_PROGRAM_CACHE_SIZE";
 };
 
 // Information needed to construct amdmigraphx execution providers.
@@ -20,6 +21,12 @@ struct MIGraphXExecutionProviderInfo {
   int device_id {0};
 };
 
+// A program compiled for one set of input shapes.
+struct MIGraphXCachedProgram {
+  migraphx::program prog{};
+  uint64_t last_use = 0;
+};
+
 // Information to construct kernel function state.
 struct MIGraphXFuncState {
   AllocateFunc allocate_func = nullptr;
@@ -33,6 +40,12 @@ struct MIGraphXFuncState {
   OrtMutex* mgx_mu_ptr = nullptr;
   bool no_input_shape = false;
   bool fp16_enable = false;
+  // Programs compiled for the input shapes seen so far, keyed by the input lengths in input index order, so that
+  // inputs alternating between shapes don't recompile the program every time. Least recently used programs are
+  // dropped beyond max_cached_programs.
+  std::map<std::vector<std::vector<std::size_t>>, MIGraphXCachedProgram> programs;
+  std::size_t max_cached_programs = 0;
+  uint64_t use_count = 0;
 };
 
 // Logical device representation.
@@ -54,6 +67,7 @@ class MIGraphXExecutionProvider : public IExecutionProvider {
 
 private:
   bool fp16_enable_ = false;
+  std::size_t max_cached_programs_ = 16;
   int device_id_;
   migraphx::target t_; 
   OrtMutex mgx_mu_;
@@ -24,11 +24,30 @@ int32_t ModelBuilder::GetAndroidSdkVer() const {
   return nnapi_ ? nnapi_->android_sdk_version : 0;
 }
 
+void ModelBuilder::UpdateModelHash(const void* data, size_t size) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (auto& hash : model_hash_) {
+    for (size_t i = 0; i < size; i++) {
+      hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+  }
+}
+
+void ModelBuilder::UpdateModelHash(const ANeuralNetworksOperandType& operand_type) {
+  UpdateModelHash(operand_type.type);
+  UpdateModelHash(operand_type.dimensionCount);
+  UpdateModelHash(operand_type.dimensions, operand_type.dimensionCount * sizeof(uint32_t));
+  UpdateModelHash(operand_type.scale);
+  UpdateModelHash(operand_type.zeroPoint);
+}
+
 // Scalar operand is copied into the model, no need to persist
 #define DEFINE_ADD_OPERAND_FROM_SCALAR(scalar_type, op_type)                      \
   Status ModelBuilder::AddOperandFromScalar(scalar_type value, uint32_t& index) { \
     OperandType operandType(Type::op_type, vector<uint32_t>{});                   \
     ORT_RETURN_IF_ERROR(AddNewNNAPIOperand(operandType, index));                  \
+    UpdateModelHash(index);                                                       \
+    UpdateModelHash(value);                                                       \
     RETURN_STATUS_ON_ERROR_WITH_NOTE(                                             \
         nnapi_->ANeuralNetworksModel_setOperandValue(                             \
             nnapi_model_->model_, index, &value, sizeof(value)),                  \
@@ -97,6 +116,7 @@ Status ModelBuilder::GetTargetDevices() {
     if ((target_device_option_ == TargetDeviceOption::CPU_DISABLED && !device_is_cpu) ||
         (target_device_option_ == TargetDeviceOption::CPU_ONLY && device_is_cpu)) {
       nnapi_target_devices_.push_back(device);
+      UpdateModelHash(device_name, strlen(device_name));
       LOGS_DEFAULT(VERBOSE) << "Target device [" << device_name << "] added";
     }
   }
@@ -378,6 +398,7 @@ Status ModelBuilder::AddNewNNAPIOperand(const OperandType& operand_type, uint32_
   RETURN_STATUS_ON_ERROR(
       nnapi_->ANeuralNetworksModel_addOperand(nnapi_model_->model_, &operand_type.operandType));
   index = next_index_++;
+  UpdateModelHash(operand_type.operandType);
 
   if (operand_type.channelQuant) {
     if (GetAndroidSdkVer() < 29) {
@@ -388,6 +409,9 @@ Status ModelBuilder::AddNewNNAPIOperand(const OperandType& operand_type, uint32_
 
     RETURN_STATUS_ON_ERROR(nnapi_->ANeuralNetworksModel_setOperandSymmPerChannelQuantParams(
         nnapi_model_->model_, index, &operand_type.channelQuant->params));
+    const auto& params = operand_type.channelQuant->params;
+    UpdateModelHash(params.channelDim);
+    UpdateModelHash(params.scales, params.scaleCount * sizeof(float));
   }
 
   return Status::OK();
@@ -406,6 +430,8 @@ void ModelBuilder::RegisterOperand(const std::string& name, uint32_t index,
 Status ModelBuilder::SetOperandValue(uint32_t index,
                                      Model::NNMemory* memory,
                                      size_t size, size_t offset) {
+  UpdateModelHash(index);
+  UpdateModelHash(memory->GetDataPtr() + offset, size);
 #ifdef USENNAPISHAREDMEM
   RETURN_STATUS_ON_ERROR(
       nnapi_->ANeuralNetworksModel_setOperandValueFromMemory(
@@ -434,6 +460,8 @@ Status ModelBuilder::AddOperandFromPersistMemoryBuffer(
   // for small size operand, the value will be copied
   // no need to persist
   if (size < ANEURALNETWORKS_MAX_SIZE_OF_IMMEDIATELY_COPIED_VALUES) {
+    UpdateModelHash(index);
+    UpdateModelHash(buffer, size);
     RETURN_STATUS_ON_ERROR(
         nnapi_->ANeuralNetworksModel_setOperandValue(
             nnapi_model_->model_, index,
@@ -476,6 +504,9 @@ Status ModelBuilder::AddOperation(int op, const std::vector<uint32_t>& input_ind
     output_indices.push_back(index);
   }
 
+  UpdateModelHash(op);
+  UpdateModelHash(input_indices.data(), input_indices.size() * sizeof(uint32_t));
+  UpdateModelHash(output_indices.data(), output_indices.size() * sizeof(uint32_t));
   RETURN_STATUS_ON_ERROR_WITH_NOTE(
       nnapi_->ANeuralNetworksModel_addOperation(
           nnapi_model_->model_, op, input_indices.size(), &input_indices[0],
@@ -496,8 +527,12 @@ Status ModelBuilder::Compile(std::unique_ptr<Model>& model) {
           &output_index_vec_[0]),
       "on identifyInputsAndOutputs");
 
+  UpdateModelHash(input_index_vec_.data(), input_index_vec_.size() * sizeof(uint32_t));
+  UpdateModelHash(output_index_vec_.data(), output_index_vec_.size() * sizeof(uint32_t));
+
   // relax fp32tofp16 is only available on API 28+
   if (use_fp16_ && GetAndroidSdkVer() > 27) {
+    UpdateModelHash(use_fp16_);
     RETURN_STATUS_ON_ERROR_WITH_NOTE(
         nnapi_->ANeuralNetworksModel_relaxComputationFloat32toFloat16(
             nnapi_model_->model_, true),
@@ -525,6 +560,16 @@ Status ModelBuilder::Compile(std::unique_ptr<Model>& model) {
           nnapi_model_->compilation_, static_cast<int32_t>(exe_pref_)),
       "on setPreference");
 
+  // setCaching is only available on API 29+
+  if (!cache_dir_.empty() && GetAndroidSdkVer() > 28 && nnapi_->ANeuralNetworksCompilation_setCaching) {
+    UpdateModelHash(exe_pref_);
+    uint8_t token[ANEURALNETWORKS_BYTE_SIZE_OF_CACHE_TOKEN];
+    memcpy(token, model_hash_, sizeof(token));
+    RETURN_STATUS_ON_ERROR_WITH_NOTE(
+        nnapi_->ANeuralNetworksCompilation_setCaching(nnapi_model_->compilation_, cache_dir_.c_str(), token),
+        "on setCaching");
+  }
+
   RETURN_STATUS_ON_ERROR_WITH_NOTE(
       nnapi_->ANeuralNetworksCompilation_finish(nnapi_model_->compilation_),
       "on compilation finish");
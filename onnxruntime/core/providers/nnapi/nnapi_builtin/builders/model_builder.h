@@ -74,6 +74,10 @@ class ModelBuilder {
   // It is off by default
   void SetUseFp16(bool use_fp16) { use_fp16_ = use_fp16; }
 
+  // Cache the NNAPI compilation in the given directory, keyed by a hash of the NNAPI model
+  // Only available on Android API level 29+, it is off if the directory is empty
+  void SetCacheDir(const std::string& cache_dir) { cache_dir_ = cache_dir; }
+
   // Set NNAPI execution preference
   // Default preference is PREFER_SUSTAINED_SPEED
   void ExecutePreference(
@@ -116,6 +120,7 @@ class ModelBuilder {
 
   bool use_nchw_{false};
   bool use_fp16_{false};
+  std::string cache_dir_;
   android::nn::wrapper::ExecutePreference exe_pref_{
       android::nn::wrapper::ExecutePreference::PREFER_FAST_SINGLE_ANSWER};
 
@@ -151,6 +156,16 @@ class ModelBuilder {
 
   uint32_t next_index_ = 0;
 
+  // Hash of everything added to the NNAPI model, used as the compilation cache token.
+  // It is made of 4 independently seeded 64-bit FNV-1a hashes.
+  uint64_t model_hash_[ANEURALNETWORKS_BYTE_SIZE_OF_CACHE_TOKEN / sizeof(uint64_t)]{
+      0xcbf29ce484222325ULL, 0x84222325cbf29ce4ULL, 0x9e3779b97f4a7c15ULL, 0xc2b2ae3d27d4eb4fULL};
+
+  void UpdateModelHash(const void* data, size_t size);
+  template <typename T>
+  void UpdateModelHash(const T& value) { UpdateModelHash(&value, sizeof(value)); }
+  void UpdateModelHash(const ANeuralNetworksOperandType& operand_type);
+
   // Convert the onnx model to ANeuralNetworksModel
   Status Prepare() ORT_MUST_USE_RESULT;
 
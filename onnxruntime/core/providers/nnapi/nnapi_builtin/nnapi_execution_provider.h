@@ -13,7 +13,7 @@ class Model;
 
 class NnapiExecutionProvider : public IExecutionProvider {
  public:
-  NnapiExecutionProvider(uint32_t nnapi_flags);
+  NnapiExecutionProvider(uint32_t nnapi_flags, const std::string& cache_dir = "");
   virtual ~NnapiExecutionProvider();
 
   std::vector<std::unique_ptr<ComputeCapability>>
@@ -38,6 +38,9 @@ class NnapiExecutionProvider : public IExecutionProvider {
   // NNAPIFlags in include/onnxruntime/core/providers/nnapi/nnapi_provider_factory.h
   const uint32_t nnapi_flags_;
 
+  // Directory for NNAPI compilation caching, caching is disabled if it is empty
+  const std::string cache_dir_;
+
 #ifdef __ANDROID__
   std::unordered_map<std::string, std::unique_ptr<onnxruntime::nnapi::Model>> nnapi_models_;
 #endif
@@ -8,20 +8,26 @@ using namespace onnxruntime;
 
 namespace onnxruntime {
 struct NnapiProviderFactory : IExecutionProviderFactory {
-  NnapiProviderFactory(uint32_t nnapi_flags)
-      : nnapi_flags_(nnapi_flags) {}
+  NnapiProviderFactory(uint32_t nnapi_flags, const std::string& cache_dir)
+      : nnapi_flags_(nnapi_flags), cache_dir_(cache_dir) {}
   ~NnapiProviderFactory() override {}
 
   std::unique_ptr<IExecutionProvider> CreateProvider() override;
   uint32_t nnapi_flags_;
+  std::string cache_dir_;
 };
 
 std::unique_ptr<IExecutionProvider> NnapiProviderFactory::CreateProvider() {
-  return onnxruntime::make_unique<NnapiExecutionProvider>(nnapi_flags_);
+  return onnxruntime::make_unique<NnapiExecutionProvider>(nnapi_flags_, cache_dir_);
+}
+
+std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_Nnapi(uint32_t nnapi_flags,
+                                                                              const std::string& cache_dir) {
+  return std::make_shared<onnxruntime::NnapiProviderFactory>(nnapi_flags, cache_dir);
 }
 
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_Nnapi(uint32_t nnapi_flags) {
-  return std::make_shared<onnxruntime::NnapiProviderFactory>(nnapi_flags);
+  return CreateExecutionProviderFactory_Nnapi(nnapi_flags, "");
 }
 }  // namespace onnxruntime
 
@@ -29,3 +35,10 @@ ORT_API_STATUS_IMPL(OrtSessionOptionsAppendExecutionProvider_Nnapi, _In_ OrtSess
   options->provider_factories.push_back(onnxruntime::CreateExecutionProviderFactory_Nnapi(nnapi_flags));
   return nullptr;
 }
+
+ORT_API_STATUS_IMPL(OrtSessionOptionsAppendExecutionProviderEx_Nnapi, _In_ OrtSessionOptions* options,
+                    uint32_t nnapi_flags, _In_ const char* cache_dir) {
+  options->provider_factories.push_back(
+      onnxruntime::CreateExecutionProviderFactory_Nnapi(nnapi_flags, cache_dir == nullptr ? "" : cache_dir));
+  return nullptr;
+}
@@ -38,7 +38,8 @@ static const std::unordered_set<std::string> valid_keys = {
     kNupharCacheModelChecksum,
     kNupharCacheForceNoJIT,
     kNupharCodeGenTarget,
-    kNupharParallelMinWorkloads};
+    kNupharParallelMinWorkloads,
+    kNupharCompileThreads};
 
 void SetDefaultOptions(std::map<std::string, std::string>& options) {
   // create two temporary strings to get rid of the odr-use issue introduced
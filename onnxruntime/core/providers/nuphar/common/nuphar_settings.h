@@ -47,6 +47,9 @@ constexpr static const char* kNupharCodeGenTarget = "nuphar_codegen_target";
 // Option to control nuphar code to run with parallel schedule
 constexpr static const char* kNupharParallelMinWorkloads = "nuphar_parallel_min_workloads";
 
+// Option to compile fused nodes with multiple threads, sequential when not set or not greater than 1
+constexpr static const char* kNupharCompileThreads = "nuphar_compile_threads";
+
 constexpr static const char* kNupharCacheSoName_Default = "jit.so";
 
 void CreateNupharCodeGenSettings(const NupharExecutionProviderInfo& info);
@@ -9,6 +9,7 @@
 #include "core/codegen/common/target_info.h"
 
 #include "core/common/logging/logging.h"
+#include "core/framework/murmurhash3.h"
 #include "core/platform/env.h"
 #include "core/providers/common.h"
 #include "core/providers/nuphar/scripts/NUPHAR_CACHE_VERSION"
@@ -20,6 +21,11 @@
 #undef _SILENCE_EXPERIMENTAL_FILESYSTEM_DEPRECATION_WARNING
 #include <atomic>
 #include <fstream>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
 namespace fs = std::experimental::filesystem;
 
 namespace onnxruntime {
@@ -163,6 +169,38 @@ static bool VerifyTVMModuleChecksum(const std::string& so_path) {
   }
 }
 
+// The cached dll is loaded and verified once per process, instead of for every function looked up in it.
+static CacheStatus LoadTVMModuleFromCache(const std::string& so_path, tvm::runtime::Module& module) {
+  struct CachedModule {
+    CacheStatus status;
+    tvm::runtime::Module module;
+  };
+
+  static std::mutex cached_modules_mutex;
+  static std::unordered_map<std::string, CachedModule> cached_modules;
+
+  // the checksum verification depends on the settings of the session
+  codegen::CodeGenSettings& settings = codegen::CodeGenSettings::Instance();
+  std::string key = so_path;
+  if (settings.HasOption(kNupharCacheModelChecksum)) {
+    key += "|" + settings.GetOptionValue(kNupharCacheModelChecksum);
+  }
+
+  std::lock_guard<std::mutex> lock(cached_modules_mutex);
+  auto iter = cached_modules.find(key);
+  if (iter == cached_modules.end()) {
+    CachedModule cached{CacheStatus::Mismatch, tvm::runtime::Module()};
+    if (VerifyCacheVersion(so_path) && VerifyTVMModuleChecksum(so_path)) {
+      cached.status = CacheStatus::Found;
+      cached.module = tvm::runtime::Module::LoadFromFile(so_path);
+    }
+    iter = cached_modules.emplace(key, std::move(cached)).first;
+  }
+
+  module = iter->second.module;
+  return iter->second.status;
+}
+
 CacheStatus LoadTVMPackedFuncFromCache(const std::string& func_name, tvm::runtime::PackedFunc& func) {
   std::string so_path;
   if (!GetCacheSoFilePath(so_path)) {
@@ -173,14 +211,11 @@ CacheStatus LoadTVMPackedFuncFromCache(const std::string& func_name, tvm::runtim
     }
   }
 
-  if (!VerifyCacheVersion(so_path)) {
+  tvm::runtime::Module module;
+  if (LoadTVMModuleFromCache(so_path, module) != CacheStatus::Found) {
     return CacheStatus::Mismatch;
   }
 
-  if (!VerifyTVMModuleChecksum(so_path))
-    return CacheStatus::Mismatch;
-
-  tvm::runtime::Module module = tvm::runtime::Module::LoadFromFile(so_path);
   func = module.GetFunction(func_name);
   if (func == nullptr) {
     LOGS_DEFAULT(CODEGEN_SETTINGS_LOG_LEVEL) << "Cannot find " << func_name << " in cache, using JIT...";
@@ -204,9 +239,130 @@ void SaveTVMModuleToCache(const std::string& filename, tvm::runtime::Module& mod
   }
 }
 
+std::string GetSubgraphHash(const nuphar::NupharSubgraphUnit& subgraph) {
+  uint32_t hash[4] = {0, 0, 0, 0};
+
+  auto hash_bytes = [&hash](const void* data, size_t len) {
+    // MurmurHash3 takes an int length so hash large buffers in chunks
+    constexpr size_t max_chunk = static_cast<size_t>(std::numeric_limits<int>::max());
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    do {
+      const size_t chunk = std::min(len, max_chunk);
+      MurmurHash3::x86_128(bytes, static_cast<int>(chunk), hash[0], &hash);
+      bytes += chunk;
+      len -= chunk;
+    } while (len > 0);
+  };
+
+  auto hash_int = [&hash_bytes](int64_t value) {
+    hash_bytes(&value, sizeof(value));
+  };
+
+  auto hash_string = [&hash_bytes, &hash_int](const std::string& str) {
+    hash_int(static_cast<int64_t>(str.size()));
+    if (!str.empty()) {
+      hash_bytes(str.data(), str.size());
+    }
+  };
+
+  // the defs are identified by their order of appearance instead of their names,
+  // so that the hash only depends on the structure of the subgraph
+  std::unordered_map<const NodeArg*, int64_t> def_ids;
+  auto hash_def = [&](const NodeArg* def) {
+    auto iter = def_ids.find(def);
+    if (iter == def_ids.end()) {
+      iter = def_ids.emplace(def, static_cast<int64_t>(def_ids.size())).first;
+    }
+    hash_int(iter->second);
+
+    hash_string(def->Type() != nullptr ? *def->Type() : std::string());
+    const auto* shape = def->Shape();
+    hash_int(shape != nullptr ? shape->dim_size() : -1);
+    if (shape != nullptr) {
+      for (const auto& dim : shape->dim()) {
+        if (dim.has_dim_value()) {
+          hash_int(dim.dim_value());
+        } else {
+          hash_string(dim.has_dim_param() ? dim.dim_param() : std::string());
+        }
+      }
+    }
+  };
+
+  // initializers may be folded to constants in the generated code, so their contents are part of the hash
+  for (const NodeArg* def : subgraph.inputs) {
+    hash_def(def);
+    auto iter = subgraph.initializers.find(def->Name());
+    if (iter != subgraph.initializers.end() && iter->second != nullptr) {
+      const Tensor* tensor = iter->second;
+      hash_int(tensor->Shape().Size());
+      if (tensor->IsDataTypeString()) {
+        for (const auto& str : tensor->DataAsSpan<std::string>()) {
+          hash_string(str);
+        }
+      } else if (tensor->SizeInBytes() > 0) {
+        hash_bytes(tensor->DataRaw(), tensor->SizeInBytes());
+      }
+    }
+  }
+
+  for (const Node* node : subgraph.nodes) {
+    hash_string(node->OpType());
+    hash_string(node->Domain());
+    hash_int(node->SinceVersion());
+
+    // NodeAttributes is an unordered map, sort the attributes to make the hash deterministic
+    std::vector<const ONNX_NAMESPACE::AttributeProto*> attributes;
+    for (const auto& attribute : node->GetAttributes()) {
+      attributes.push_back(&attribute.second);
+    }
+    std::sort(attributes.begin(), attributes.end(),
+              [](const ONNX_NAMESPACE::AttributeProto* a, const ONNX_NAMESPACE::AttributeProto* b) {
+                return a->name() < b->name();
+              });
+    for (const auto* attribute : attributes) {
+      hash_string(attribute->SerializeAsString());
+    }
+
+    for (const NodeArg* def : node->InputDefs()) {
+      if (def->Exists()) {
+        hash_def(def);
+      } else {
+        hash_int(-1);
+      }
+    }
+    for (const NodeArg* def : node->OutputDefs()) {
+      if (def->Exists()) {
+        hash_def(def);
+      } else {
+        hash_int(-1);
+      }
+    }
+  }
+
+  for (const NodeArg* def : subgraph.outputs) {
+    hash_def(def);
+  }
+  for (const auto attr : subgraph.input_attrs) {
+    hash_int(static_cast<int64_t>(attr));
+  }
+  for (const auto attr : subgraph.output_attrs) {
+    hash_int(static_cast<int64_t>(attr));
+  }
+
+  std::ostringstream stream;
+  stream << std::hex << std::setfill('0');
+  for (uint32_t h : hash) {
+    stream << std::setw(8) << h;
+  }
+  return stream.str();
+}
+
 std::string GetPackedFuncName(const nuphar::NupharSubgraphUnit& subgraph, const CodeGenTarget& codegen_target, int64_t parallel_min_workloads) {
+  // the name is keyed by the content of the subgraph and the target ISA, so that the cached functions can be reused
+  // by any session or model compiling the same subgraph.
   // in C, a function does not allow its name starting with a digit.
-  return NormalizeCppName("_" + subgraph.UniqueId() + "_" + codegen_target.GetTargetName() + "_p" + std::to_string(parallel_min_workloads));
+  return NormalizeCppName("_" + GetSubgraphHash(subgraph) + "_" + codegen_target.GetTargetName() + "_p" + std::to_string(parallel_min_workloads));
 }
 
 bool TryCreateConstantScalar(
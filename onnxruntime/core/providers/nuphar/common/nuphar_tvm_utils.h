@@ -30,6 +30,9 @@ enum class CacheStatus {
 CacheStatus LoadTVMPackedFuncFromCache(const std::string& func_name, tvm::runtime::PackedFunc& func);
 void SaveTVMModuleToCache(const std::string& filename, tvm::runtime::Module& module);
 
+// Hash of the nodes, shapes and initializers of a subgraph, independent of the names of its defs
+std::string GetSubgraphHash(const nuphar::NupharSubgraphUnit& subgraph);
+
 std::string GetPackedFuncName(const nuphar::NupharSubgraphUnit& subgraph, const CodeGenTarget& codegen_target, int64_t parallel_min_workloads);
 
 bool TryCreateConstantScalar(tvm::Expr& scalar, const Tensor* tensor);
@@ -20,10 +20,8 @@ thread_local std::unique_ptr<NupharFuncStateToComputeCtxMap> NupharKernelState::
 
 NupharKernelState::NupharKernelState(
     const Node& node,
-    const ComputeContext& ctx,
     const NupharExecutionProvider& provider)
-    : provider_(provider),
-      ctx_(ctx) {
+    : provider_(provider) {
   partition_info_ = onnxruntime::make_unique<OrtSubgraphAllocationInfo>(node);
 
   std::vector<NupharSubgraphUnit> subgraphs;
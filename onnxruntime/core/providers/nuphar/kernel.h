@@ -31,7 +31,6 @@ class NupharKernelState {
  public:
   explicit NupharKernelState(
       const Node& fused_node,
-      const ComputeContext& ctx,
       const NupharExecutionProvider& provider);
 
   ~NupharKernelState();
@@ -64,9 +63,6 @@ class NupharKernelState {
   // Calls
   std::vector<ExecBlock*> exec_block_calls_;
 
-  // Here ComputeContext of Ort is used for allocator
-  ComputeContext ctx_;  // the compute context from IExecutionProvider::Compile interface
-
   static thread_local std::unique_ptr<NupharFuncStateToComputeCtxMap> nuphar_compute_ctx_map_;
 };
 
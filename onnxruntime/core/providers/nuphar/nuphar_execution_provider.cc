@@ -15,6 +15,8 @@
 #include "core/providers/nuphar/kernel.h"
 #include "core/providers/nuphar/partition/graph_partitioner.h"
 #include "core/framework/onnxruntime_typeinfo.h"
+#include "core/platform/env.h"
+#include "core/util/thread_utils.h"
 
 #include <tvm/runtime/device_api.h>  // TODO remove this after removing tvm::runtime
 
@@ -406,24 +408,79 @@ Status NupharExecutionProvider::SaveInitializer(
   return Status::OK();
 }
 
+NupharExecutionProvider::~NupharExecutionProvider() = default;
+
+// Compile fused nodes on a temporary thread pool ahead of session initialization
+// The compiled states are picked up by create_state_func below
+Status NupharExecutionProvider::CompileInParallel(
+    const std::vector<onnxruntime::Node*>& fused_nodes,
+    int num_threads) {
+  OrtThreadPoolParams tp_params;
+  tp_params.thread_pool_size = num_threads;
+  tp_params.allow_spinning = false;
+  auto thread_pool = concurrency::CreateThreadPool(&Env::Default(), tp_params, concurrency::ThreadPoolType::INTRA_OP);
+
+  std::vector<std::unique_ptr<NupharKernelState>> states(fused_nodes.size());
+  std::vector<std::string> errors(fused_nodes.size());
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool.get(), static_cast<std::ptrdiff_t>(fused_nodes.size()),
+      [&](std::ptrdiff_t i) {
+        ORT_TRY {
+          states[i] = onnxruntime::make_unique<NupharKernelState>(*fused_nodes[i], *this);
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            errors[i] = ex.what();
+          });
+        }
+      });
+
+  for (size_t i = 0; i < fused_nodes.size(); ++i) {
+    ORT_RETURN_IF_NOT(errors[i].empty(), "Nuphar failed to compile ", fused_nodes[i]->Name(), ": ", errors[i]);
+  }
+
+  std::lock_guard<std::mutex> lock(compiled_states_mutex_);
+  for (size_t i = 0; i < fused_nodes.size(); ++i) {
+    compiled_states_[fused_nodes[i]] = std::move(states[i]);
+  }
+  return Status::OK();
+}
+
 // Compile nodes into node_compute_funcs
 // Here, each of nodes is a fuse node
 Status NupharExecutionProvider::Compile(
     const std::vector<onnxruntime::Node*>& nodes,
     std::vector<NodeComputeInfo>& node_compute_funcs) {
+  const codegen::CodeGenSettings& settings = codegen::CodeGenSettings::Instance();
+  int num_compile_threads = 1;
+  if (settings.HasOption(kNupharCompileThreads)) {
+    num_compile_threads = std::stoi(settings.GetOptionValue(kNupharCompileThreads));
+  }
+  if (num_compile_threads > 1 && nodes.size() > 1) {
+    ORT_RETURN_IF_ERROR(CompileInParallel(nodes, num_compile_threads));
+  }
+
   for (const auto* node : nodes) {
     NodeComputeInfo info;
 
     // Create state function
     // This is similar to the original OpKernel constructor
-    // TODO move compilation part out of create_state_func to above
+    // A state compiled by CompileInParallel is handed over, otherwise the node is compiled here
     info.create_state_func =
-        [&, node](ComputeContext* ctx, FunctionState* state) {
-          std::unique_ptr<NupharKernelState> s =
-              onnxruntime::make_unique<NupharKernelState>(
-                  *node,
-                  *ctx,
-                  *this);
+        [&, node](ComputeContext*, FunctionState* state) {
+          std::unique_ptr<NupharKernelState> s;
+          {
+            std::lock_guard<std::mutex> lock(compiled_states_mutex_);
+            auto iter = compiled_states_.find(node);
+            if (iter != compiled_states_.end()) {
+              s = std::move(iter->second);
+              compiled_states_.erase(iter);
+            }
+          }
+
+          if (!s) {
+            s = onnxruntime::make_unique<NupharKernelState>(*node, *this);
+          }
 
           *state = s.release();
           return 0;
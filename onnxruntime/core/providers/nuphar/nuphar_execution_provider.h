@@ -14,11 +14,17 @@
 
 #include <tvm/build_module.h>
 
+#include <mutex>
+
 namespace onnxruntime {
 
 // Forward declaration
 class CodeGenTarget;
 
+namespace nuphar {
+class NupharKernelState;
+}  // namespace nuphar
+
 // By default, construct either "llvm" or "stackvm" TVM target, for which the default device_type is kDLCPU.
 constexpr const char* llvm_target_str = "llvm";
 constexpr const char* stackvm_target_str = "stackvm";
@@ -50,7 +56,7 @@ class NupharExecutionProvider : public IExecutionProvider {
  public:
   explicit NupharExecutionProvider(const NupharExecutionProviderInfo& info);
 
-  virtual ~NupharExecutionProvider() = default;
+  virtual ~NupharExecutionProvider();
 
   std::vector<std::unique_ptr<ComputeCapability>>
   GetCapability(const onnxruntime::GraphViewer& graph_viewer,
@@ -125,6 +131,8 @@ class NupharExecutionProvider : public IExecutionProvider {
       const std::string& name,
       const ONNX_NAMESPACE::TensorProto* proto) const;
 
+  Status CompileInParallel(const std::vector<onnxruntime::Node*>& fused_nodes, int num_threads);
+
  private:
   // TODO move this to another place
   std::unique_ptr<CodeGenTarget> codegen_target_;
@@ -154,6 +162,10 @@ class NupharExecutionProvider : public IExecutionProvider {
   mutable std::unordered_map<std::string, std::unique_ptr<Tensor>> constant_initializers_used_in_compiled_nodes_;
   mutable std::unordered_map<std::string, int> domain_versions_;
 
+  // the states of the fused nodes compiled in parallel by Compile, until they are handed out by create_state_func
+  std::mutex compiled_states_mutex_;
+  std::unordered_map<const Node*, std::unique_ptr<nuphar::NupharKernelState>> compiled_states_;
+
   // used to create unique fused node name, make it thread_local because
   // subsession of a model with subgraph may create multiple instances of EPs,
   // and there might be multiple inference sessions running different models concurrently
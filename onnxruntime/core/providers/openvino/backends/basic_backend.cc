@@ -66,6 +66,16 @@ BasicBackend::BasicBackend(const Provider_ModelProto& model_proto,
     }
 #endif
   }
+  // Throughput streams let the infer requests of the pool run in parallel on the device
+  if (global_context_.num_streams > 0) {
+    if (global_context_.device_type == "CPU") {
+      config["CPU_THROUGHPUT_STREAMS"] = std::to_string(global_context_.num_streams);
+    } else if (global_context_.device_type == "GPU") {
+      config["GPU_THROUGHPUT_STREAMS"] = std::to_string(global_context_.num_streams);
+    } else {
+      LOGS_DEFAULT(WARNING) << log_tag << "num_streams is only supported for CPU and GPU devices, ignoring it";
+    }
+  }
   std::string& hw_target = (global_context_.device_id != "") ? global_context_.device_id : global_context_.device_type;
   try {
     exe_network = global_context_.ie_core.LoadNetwork(*ie_cnn_network_, hw_target, config);
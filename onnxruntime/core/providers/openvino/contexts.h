@@ -14,6 +14,7 @@ struct GlobalContext {
   bool is_wholly_supported_graph = false;
   bool enable_vpu_fast_compile = false;
   size_t num_of_threads;
+  size_t num_streams = 0;
   std::string device_type;
   std::string precision_str;
   std::string device_id;
@@ -1,7 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <iterator>
 #include <list>
 #include <unordered_set>
 #include "core/providers/shared_library/provider_api.h"
@@ -19,6 +22,7 @@
 #include <limits>
 #include <map>
 #include <memory>
+#include <thread>
 #include "flatbuffers/idl.h"
 #include "ort_trt_int8_cal_table.fbs.h"
 
@@ -41,6 +45,38 @@ std::string GetCachePath(const std::string& root, const std::string& name) {
   }
 }
 
+// Engine of a subgraph without dynamic shape input whose build is deferred to the end of Compile,
+// so that the engines of all such subgraphs can be built in parallel
+struct EngineBuildTask {
+  std::string fused_node_name;
+  std::string engine_cache_path;
+  bool cache_engine;
+  nvinfer1::IBuilder* builder;
+  nvinfer1::INetworkDefinition* network;
+  tensorrt_ptr::unique_pointer<nvinfer1::IBuilderConfig> config;
+  tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine> engine;
+};
+
+/*
+* Dynamic dimensions of execution tensors are widened to powers of two when the shape range is updated,
+* so that an engine is rebuilt O(log(n)) times for a dimension of size n instead of every time it grows.
+*/
+int64_t RoundDownToPowerOfTwo(int64_t value) {
+  int64_t result = 1;
+  while (result * 2 <= value) {
+    result *= 2;
+  }
+  return result;
+}
+
+int64_t RoundUpToPowerOfTwo(int64_t value) {
+  int64_t result = 1;
+  while (result < value) {
+    result *= 2;
+  }
+  return result;
+}
+
 float ConvertSinglePrecisionIEEE754ToFloat(unsigned long input) {
   int s = (input >> 31) & 0x01;
   int e = ((input & 0x7f800000) >> 23) - 127;
@@ -196,6 +232,42 @@ bool ReadDynamicRange(const std::string file_name, const bool is_trt_calibration
   return true;
 }
 
+// Subgraphs with QuantizeLinear/DequantizeLinear nodes are parsed into explicit precision networks, in which
+// TensorRT takes the INT8 scales from the Q/DQ nodes instead of a calibration table
+bool HasQDQNodes(const GraphViewer& graph) {
+  for (auto index : graph.GetNodesInTopologicalOrder()) {
+    const auto& op_type = graph.GetNode(index)->OpType();
+    if (op_type == "QuantizeLinear" || op_type == "DequantizeLinear") {
+      return true;
+    }
+  }
+  return false;
+}
+
+uint32_t GetNetworkCreationFlags(bool explicit_precision) {
+  uint32_t flags = 1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH);
+  if (explicit_precision) {
+    flags |= 1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_PRECISION);
+  }
+  return flags;
+}
+
+size_t GetElementSize(nvinfer1::DataType type) {
+  switch (type) {
+    case nvinfer1::DataType::kFLOAT:
+    case nvinfer1::DataType::kINT32:
+      return 4;
+    case nvinfer1::DataType::kHALF:
+      return 2;
+    default:
+      return 1;
+  }
+}
+
+bool SameDims(const nvinfer1::Dims& lhs, const nvinfer1::Dims& rhs) {
+  return lhs.nbDims == rhs.nbDims && std::equal(lhs.d, lhs.d + lhs.nbDims, rhs.d);
+}
+
 bool SetDynamicRange(nvinfer1::INetworkDefinition& network, std::unordered_map<std::string, float>& dynamic_range_map) {
   // Set dynamic range for input tensors
   for (int i = 0; i < network.getNbInputs(); ++i) {
@@ -390,6 +462,11 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     max_workspace_size_ = std::stoull(max_workspace_size_env);
   }
 
+  const std::string max_execution_contexts_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kMaxExecutionContexts);
+  if (!max_execution_contexts_env.empty()) {
+    max_execution_contexts_ = std::max(1, std::stoi(max_execution_contexts_env));
+  }
+
   const std::string fp16_enable_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kFP16Enable);
   if (!fp16_enable_env.empty()) {
     fp16_enable_ = (std::stoi(fp16_enable_env) == 0 ? false : true);
@@ -410,6 +487,11 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     if (!int8_use_native_tensorrt_calibration_table_env.empty()) {
       int8_use_native_tensorrt_calibration_table_ = (std::stoi(int8_use_native_tensorrt_calibration_table_env) == 0 ? false : true);
     }
+
+    const std::string int8_calibration_batches_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kINT8CalibrationBatches);
+    if (!int8_calibration_batches_env.empty()) {
+      int8_calibration_batches_ = static_cast<size_t>(std::max(0, std::stoi(int8_calibration_batches_env)));
+    }
   }
 
   const std::string dump_subgraphs_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kDumpSubgraphs);
@@ -440,6 +522,113 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
 
 TensorrtExecutionProvider::~TensorrtExecutionProvider() {}
 
+TensorrtExecutionContext::~TensorrtExecutionContext() {
+  if (event != nullptr) {
+    CUDA_CALL(cudaEventDestroy(event));
+  }
+  if (stream != nullptr) {
+    CUDA_CALL(cudaStreamSynchronize(stream));
+    CUDA_CALL(cudaStreamDestroy(stream));
+  }
+}
+
+TensorrtInt8Calibrator::TensorrtInt8Calibrator(const std::string& cache_path, size_t num_batches)
+    : cache_path_(cache_path), num_batches_(num_batches) {
+  std::ifstream cache_file(cache_path_, std::ios::binary | std::ios::in);
+  if (cache_file) {
+    cache_.assign(std::istreambuf_iterator<char>(cache_file), std::istreambuf_iterator<char>());
+    LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Read INT8 calibration cache " + cache_path_;
+  }
+}
+
+TensorrtInt8Calibrator::~TensorrtInt8Calibrator() {
+  ReleaseBatches();
+}
+
+common::Status TensorrtInt8Calibrator::AddBatch(const std::unordered_map<std::string, Input>& inputs, cudaStream_t stream) {
+  if (!NeedsBatches()) {
+    return Status::OK();
+  }
+
+  if (batches_.empty()) {
+    for (const auto& input : inputs) {
+      batch_dims_[input.first] = input.second.dims;
+    }
+  } else {
+    for (const auto& input : inputs) {
+      const auto& iter = batch_dims_.find(input.first);
+      if (iter == batch_dims_.end() || !SameDims(iter->second, input.second.dims)) {
+        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Skipped INT8 calibration batch whose input shapes differ from the first batch";
+        return Status::OK();
+      }
+    }
+  }
+
+  std::unordered_map<std::string, void*> batch;
+  Status status = Status::OK();
+  for (const auto& input : inputs) {
+    void* buffer = nullptr;
+    if (!CUDA_CALL(cudaMalloc(&buffer, input.second.size))) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "TensorRT EP failed to allocate INT8 calibration batch.");
+      break;
+    }
+    batch[input.first] = buffer;
+    if (!CUDA_CALL(cudaMemcpyAsync(buffer, input.second.data, input.second.size, cudaMemcpyDeviceToDevice, stream))) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "TensorRT EP failed to copy INT8 calibration batch.");
+      break;
+    }
+  }
+
+  if (!status.IsOK()) {
+    for (auto& buffer : batch) {
+      CUDA_CALL(cudaFree(buffer.second));
+    }
+    return status;
+  }
+  batches_.push_back(std::move(batch));
+  return Status::OK();
+}
+
+void TensorrtInt8Calibrator::ReleaseBatches() {
+  for (auto& batch : batches_) {
+    for (auto& buffer : batch) {
+      CUDA_CALL(cudaFree(buffer.second));
+    }
+  }
+  batches_.clear();
+  next_batch_ = 0;
+  calibrated_ = true;
+}
+
+bool TensorrtInt8Calibrator::getBatch(void* bindings[], const char* names[], int nb_bindings) noexcept {
+  if (next_batch_ >= batches_.size()) {
+    return false;
+  }
+
+  const auto& batch = batches_[next_batch_++];
+  for (int i = 0; i < nb_bindings; ++i) {
+    const auto& iter = batch.find(names[i]);
+    if (iter == batch.end()) {
+      return false;
+    }
+    bindings[i] = iter->second;
+  }
+  return true;
+}
+
+const void* TensorrtInt8Calibrator::readCalibrationCache(size_t& length) noexcept {
+  length = cache_.size();
+  return cache_.empty() ? nullptr : cache_.data();
+}
+
+void TensorrtInt8Calibrator::writeCalibrationCache(const void* cache, size_t length) noexcept {
+  const char* data = static_cast<const char*>(cache);
+  cache_.assign(data, data + length);
+  std::ofstream file(cache_path_, std::ios::binary | std::ios::out);
+  file.write(data, length);
+  LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized INT8 calibration cache " + cache_path_;
+}
+
 AllocatorPtr TensorrtExecutionProvider::GetAllocator(int id, OrtMemType mem_type) const {
   if (mem_type == OrtMemTypeDefault) {
     return allocator_;
@@ -747,8 +936,8 @@ SubGraphCollection_t TensorrtExecutionProvider::GetSupportedList(SubGraphCollect
         SubGraphCollection_t parser_nodes_list;
         TensorrtLogger& trt_logger = GetTensorrtLogger();
         auto trt_builder = tensorrt_ptr::unique_pointer<nvinfer1::IBuilder>(nvinfer1::createInferBuilder(trt_logger));
-        const auto explicitBatch = 1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH);
-        auto trt_network = tensorrt_ptr::unique_pointer<nvinfer1::INetworkDefinition>(trt_builder->createNetworkV2(explicitBatch));
+        const auto network_flags = GetNetworkCreationFlags(HasQDQNodes(*graph_viewer));
+        auto trt_network = tensorrt_ptr::unique_pointer<nvinfer1::INetworkDefinition>(trt_builder->createNetworkV2(network_flags));
 
         auto trt_parser = tensorrt_ptr::unique_pointer<nvonnxparser::IParser>(nvonnxparser::createParser(*trt_network, trt_logger));
         trt_parser->supportsModel(string_buf.data(), string_buf.size(), parser_nodes_list, model_path_);
@@ -939,6 +1128,7 @@ TensorrtExecutionProvider::GetCapability(const GraphViewer& graph,
 
 common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fused_nodes,
                                                   std::vector<NodeComputeInfo>& node_compute_funcs) {
+  std::vector<EngineBuildTask> engine_build_tasks;
   for (const auto* fused_node : fused_nodes) {
     // Build map from input name to its index in input definitions
     std::unordered_map<std::string, int> input_map;
@@ -978,8 +1168,9 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
 
     TensorrtLogger& trt_logger = GetTensorrtLogger();
     auto trt_builder = tensorrt_ptr::unique_pointer<nvinfer1::IBuilder>(nvinfer1::createInferBuilder(trt_logger));
-    const auto explicitBatch = 1U << static_cast<uint32_t>(nvinfer1::NetworkDefinitionCreationFlag::kEXPLICIT_BATCH);
-    auto trt_network = tensorrt_ptr::unique_pointer<nvinfer1::INetworkDefinition>(trt_builder->createNetworkV2(explicitBatch));
+    const bool explicit_precision = HasQDQNodes(*graph_body_viewer);
+    const auto network_flags = GetNetworkCreationFlags(explicit_precision);
+    auto trt_network = tensorrt_ptr::unique_pointer<nvinfer1::INetworkDefinition>(trt_builder->createNetworkV2(network_flags));
     auto trt_config = tensorrt_ptr::unique_pointer<nvinfer1::IBuilderConfig>(trt_builder->createBuilderConfig());
     auto trt_parser = tensorrt_ptr::unique_pointer<nvonnxparser::IParser>(nvonnxparser::createParser(*trt_network, trt_logger));
     trt_parser->parse(string_buf.data(), string_buf.size(), model_path_);
@@ -1029,35 +1220,55 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
       }
     }
 
-    // Load INT8 calibration table
+    // Load INT8 calibration table. Without table, the engine is calibrated with the inputs of the first Run calls of
+    // the fused node, or with the calibration cache saved by a previous session. Explicit precision networks take
+    // the INT8 scales from the Q/DQ nodes.
     std::unordered_map<std::string, float> dynamic_range_map;
-    if (int8_enable_) {
+    std::unique_ptr<TensorrtInt8Calibrator> calibrator;
+    if (int8_enable_ && !explicit_precision) {
       const std::string calibration_cache_path = GetCachePath(cache_path_, int8_calibration_cache_name_);
       if (!ReadDynamicRange(calibration_cache_path, int8_use_native_tensorrt_calibration_table_, dynamic_range_map)) {
-        throw std::runtime_error("Failed to read INT8 calibration table " + calibration_cache_path);
+        calibrator = onnxruntime::make_unique<TensorrtInt8Calibrator>(
+            GetCachePath(cache_path_, fused_node->Name()) + ".calibration", int8_calibration_batches_);
+        if (!calibrator->HasCache() && int8_calibration_batches_ == 0) {
+          throw std::runtime_error("Failed to read INT8 calibration table " + calibration_cache_path);
+        }
+        for (int i = 0; i < num_inputs; ++i) {
+          if (trt_network->getInput(i)->isShapeTensor()) {
+            return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                                   "TensorRT EP INT8 calibration doesn't support shape tensor inputs of fused node: " + fused_node->Name());
+          }
+        }
       }
     }
+    TensorrtInt8Calibrator* int8_calibrator = calibrator.get();
 
-    // Set precision flags
+    // Set precision flags. The engine of a fused node calibrated at runtime is built without INT8 until the
+    // calibration batches are collected, but it is named after its final precision.
+    const bool int8_enable = int8_enable_ || explicit_precision;
+    const bool build_int8 = int8_enable && (int8_calibrator == nullptr || int8_calibrator->IsReady());
+    const uint32_t int8_flag = build_int8 ? 1U << static_cast<uint32_t>(nvinfer1::BuilderFlag::kINT8) : 0U;
     std::string trt_node_name_with_precision = fused_node->Name();
-    if (fp16_enable_ && int8_enable_) {
-      trt_config->setFlags(1U << static_cast<uint32_t>(nvinfer1::BuilderFlag::kFP16) | 1U << static_cast<uint32_t>(nvinfer1::BuilderFlag::kINT8));
+    if (fp16_enable_ && int8_enable) {
+      trt_config->setFlags(1U << static_cast<uint32_t>(nvinfer1::BuilderFlag::kFP16) | int8_flag);
       trt_node_name_with_precision += "_fp16_int8";
       LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] FP16 and INT8 mode is enabled";
     } else if (fp16_enable_) {
       trt_config->setFlag(nvinfer1::BuilderFlag::kFP16);
       trt_node_name_with_precision += "_fp16";
       LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] FP16 mode is enabled";
-    } else if (int8_enable_) {
-      trt_config->setFlag(nvinfer1::BuilderFlag::kINT8);
+    } else if (int8_enable) {
+      trt_config->setFlags(int8_flag);
       trt_node_name_with_precision += "_int8";
       LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] INT8 mode is enabled";
     }
+    if (explicit_precision) {
+      LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Explicit precision network is created for Q/DQ nodes of fused node: " + fused_node->Name();
+    }
 
     // Build TRT engine here if the graph doesn't have dynamic shape input. Otherwise engine will
     // be built at runtime
     tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine> trt_engine;
-    tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext> trt_context;
     if (!has_dynamic_shape) {
       const std::string cache_path = GetCachePath(cache_path_, trt_node_name_with_precision);
       const std::string engine_cache_path = cache_path + ".engine";
@@ -1069,37 +1280,32 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
         std::unique_ptr<char[]> engine_buf{new char[engine_size]};
         engine_file.read((char*)engine_buf.get(), engine_size);
         trt_engine = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(runtime_->deserializeCudaEngine(engine_buf.get(), engine_size, nullptr));
-        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + engine_cache_path;
-      } else {
-        // Set INT8 per tensor dynamic range
-        if (int8_enable_ && trt_builder->platformHasFastInt8()) {
-          trt_config->setInt8Calibrator(nullptr);
-          if (!SetDynamicRange(*trt_network, dynamic_range_map)) {
-            return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                                   "TensorRT EP could not set INT8 dynamic range for fused node: " + fused_node->Name());
-          }
-        }
-
-        // Build engine
-        trt_engine = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(trt_builder->buildEngineWithConfig(*trt_network, *trt_config));
         if (trt_engine == nullptr) {
           return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                                 "TensorRT EP could not build engine for fused node: " + fused_node->Name());
+                                 "TensorRT EP could not deserialize engine for fused node: " + fused_node->Name());
         }
-        if (engine_cache_enable_) {
-          nvinfer1::IHostMemory* serializedModel = trt_engine->serialize();
-          std::ofstream file(engine_cache_path, std::ios::binary | std::ios::out);
-          file.write(reinterpret_cast<char*>(serializedModel->data()), serializedModel->size());
-          serializedModel->destroy();
-          LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + engine_cache_path;
+        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + engine_cache_path;
+        // Only INT8 engines are cached, so the engine doesn't need to be calibrated again
+        if (int8_calibrator != nullptr) {
+          int8_calibrator->ReleaseBatches();
+        }
+      } else {
+        // Set INT8 per tensor dynamic range, or the calibrator
+        if (build_int8 && !explicit_precision && trt_builder->platformHasFastInt8()) {
+          if (int8_calibrator != nullptr) {
+            trt_config->setInt8Calibrator(int8_calibrator);
+          } else {
+            trt_config->setInt8Calibrator(nullptr);
+            if (!SetDynamicRange(*trt_network, dynamic_range_map)) {
+              return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                                     "TensorRT EP could not set INT8 dynamic range for fused node: " + fused_node->Name());
+            }
+          }
         }
-      }
 
-      // Build context
-      trt_context = tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext>(trt_engine->createExecutionContext());
-      if (trt_context == nullptr) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                               "TensorRT EP could not build execution context for fused node: " + fused_node->Name());
+        // Build engine after all fused nodes are processed. The engine built before calibration isn't cached.
+        engine_build_tasks.push_back({fused_node->Name(), engine_cache_path, build_int8 == int8_enable,
+                                      trt_builder.get(), trt_network.get(), std::move(trt_config), nullptr});
       }
     }
 
@@ -1128,13 +1334,16 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
     // Save engine, context and input/output info to map
     parsers_.emplace(fused_node->Name(), std::move(trt_parser));
     engines_.emplace(fused_node->Name(), std::move(trt_engine));
-    contexts_.emplace(fused_node->Name(), std::move(trt_context));
+    context_pools_[fused_node->Name()];
     builders_.emplace(fused_node->Name(), std::move(trt_builder));
     networks_.emplace(fused_node->Name(), std::move(trt_network));
     input_info_[fused_node->Name()].push_back(input_indexes);
     output_info_[fused_node->Name()].push_back(output_indexes);
     output_info_[fused_node->Name()].push_back(output_types);
     input_shape_ranges_[fused_node->Name()] = input_shape_ranges;
+    if (calibrator != nullptr) {
+      calibrators_[fused_node->Name()] = std::move(calibrator);
+    }
 
     // Create function state
     // TODO: remove default capture
@@ -1142,11 +1351,11 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
     compute_info.create_state_func = [=](ComputeContext* context, FunctionState* state) {
       std::unique_ptr<TensorrtFuncState> p = onnxruntime::make_unique<TensorrtFuncState>();
       *p = {context->allocate_func, context->release_func, context->allocator_handle, &parsers_[context->node_name],
-            &engines_[context->node_name], &contexts_[context->node_name], &builders_[context->node_name],
+            &engines_[context->node_name], &context_pools_[context->node_name], &builders_[context->node_name],
             &networks_[context->node_name], input_info_[context->node_name], output_info_[context->node_name],
-            input_shape_ranges_[context->node_name], &tensorrt_mu_, &fp16_enable_, &int8_enable_, &max_workspace_size_,
+            input_shape_ranges_[context->node_name], &tensorrt_mu_, &tensorrt_cv_, max_execution_contexts_, &fp16_enable_, &int8_enable_, &max_workspace_size_,
             trt_node_name_with_precision, engine_cache_enable_, cache_path_, runtime_,
-            allocator_, dynamic_range_map};
+            allocator_, dynamic_range_map, int8_calibrator, explicit_precision};
       *state = p.release();
       return 0;
     };
@@ -1161,14 +1370,14 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
     compute_info.compute_func = [](FunctionState state, const OrtCustomOpApi* api, OrtKernelContext* context) {
       Ort::CustomOpApi ort{*api};
       TensorrtFuncState* trt_state = reinterpret_cast<TensorrtFuncState*>(state);
-      std::lock_guard<OrtMutex> lock(*(trt_state->tensorrt_mu_ptr));
+      std::unique_lock<OrtMutex> lock(*(trt_state->tensorrt_mu_ptr));
       const std::unordered_map<std::string, int>& input_indexes = (trt_state->input_info)[0];
       const std::unordered_map<std::string, int>& output_indexes = (trt_state->output_info)[0];
       const std::unordered_map<std::string, int>& output_types = (trt_state->output_info)[1];
       auto& shape_ranges = trt_state->input_shape_ranges;
       auto trt_builder = trt_state->builder->get();
       auto trt_engine = trt_state->engine->get();
-      auto trt_context = trt_state->context->get();
+      auto& context_pool = *(trt_state->context_pool);
       auto alloc = trt_state->scratch_allocator;
       int num_inputs = input_indexes.size();
       int num_outputs = output_indexes.size();
@@ -1188,7 +1397,6 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
         shape_ranges = DeserializeProfile(profile_file);
         LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + profile_cache_path;
         // Deserialize engine
-        trt_state->context->reset();
         trt_state->engine->reset();
         engine_file.seekg(0, std::ios::end);
         int engine_size = engine_file.tellg();
@@ -1203,12 +1411,9 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
         }
         LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + engine_cache_path;
         trt_engine = trt_state->engine->get();
-        *(trt_state->context) = tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext>(
-            trt_state->engine->get()->createExecutionContext());
-        if (trt_state->context->get() == nullptr) {
-          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to create context.");
+        if (trt_state->int8_calibrator != nullptr) {
+          trt_state->int8_calibrator->ReleaseBatches();
         }
-        trt_context = trt_state->context->get();
       }
 
       for (int i = 0, end = num_inputs; i < end; ++i) {
@@ -1317,15 +1522,15 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
 
                 // Update minimum dimension
                 if (tensor_shape < shape_range[j].first) {
-                  shape_range[j].first = tensor_shape;
-                  dims_min.d[j] = tensor_shape;
+                  shape_range[j].first = RoundDownToPowerOfTwo(tensor_shape);
+                  dims_min.d[j] = static_cast<int32_t>(shape_range[j].first);
                   dimension_update[input_name] = true;
                 }
                 // Update maximum dimension
                 if (tensor_shape > shape_range[j].second) {
-                  shape_range[j].second = tensor_shape;
-                  dims_max.d[j] = tensor_shape;
-                  dims_opt.d[j] = tensor_shape;
+                  shape_range[j].second = RoundUpToPowerOfTwo(tensor_shape);
+                  dims_max.d[j] = static_cast<int32_t>(shape_range[j].second);
+                  dims_opt.d[j] = static_cast<int32_t>(tensor_shape);
                   dimension_update[input_name] = true;
                 }
               }
@@ -1346,29 +1551,55 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
         }
       }
 
+      // Rebuild the engine in INT8 once the calibration batches are collected
+      auto calibrator = trt_state->int8_calibrator;
+      if (calibrator != nullptr && calibrator->IsPending()) {
+        engine_update = true;
+      }
+
       // Regenerate engine
       // Only one profile is generated, so no need to explicitly set optimization profile
       if (engine_update) {
-        trt_state->context->reset();
+        // Contexts in use keep the previous engine alive and are destroyed when they are returned
+        context_pool.free_contexts.clear();
+        context_pool.num_contexts = 0;
         trt_state->engine->reset();
         auto trt_config = tensorrt_ptr::unique_pointer<nvinfer1::IBuilderConfig>(trt_builder->createBuilderConfig());
         trt_config->setMaxWorkspaceSize(*(trt_state->max_workspace_size_ptr));
-        trt_config->addOptimizationProfile(trt_profile);
+        if (trt_profile != nullptr) {
+          trt_config->addOptimizationProfile(trt_profile);
+        }
 
-        // Set INT8 Per Tensor Dynamic range
-        if (*(trt_state->int8_enable_ptr) && trt_builder->platformHasFastInt8()) {
-          trt_config->setInt8Calibrator(nullptr);
-          if (!SetDynamicRange(*trt_state->network->get(), trt_state->dynamic_range_map)) {
-            return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to set INT8 dynamic range.");
+        // Set INT8 Per Tensor Dynamic range, or the calibrator. Explicit precision networks don't need either.
+        const bool int8_enable = *(trt_state->int8_enable_ptr) || trt_state->explicit_precision;
+        const bool build_int8 = int8_enable && (calibrator == nullptr || calibrator->IsReady());
+        if (build_int8 && !trt_state->explicit_precision && trt_builder->platformHasFastInt8()) {
+          if (calibrator != nullptr) {
+            trt_config->setInt8Calibrator(calibrator);
+            // Batches are calibrated with a profile of their own shapes
+            if (trt_profile != nullptr && !calibrator->BatchDims().empty()) {
+              auto calibration_profile = trt_builder->createOptimizationProfile();
+              for (const auto& batch_dims : calibrator->BatchDims()) {
+                calibration_profile->setDimensions(batch_dims.first.c_str(), nvinfer1::OptProfileSelector::kMIN, batch_dims.second);
+                calibration_profile->setDimensions(batch_dims.first.c_str(), nvinfer1::OptProfileSelector::kOPT, batch_dims.second);
+                calibration_profile->setDimensions(batch_dims.first.c_str(), nvinfer1::OptProfileSelector::kMAX, batch_dims.second);
+              }
+              trt_config->setCalibrationProfile(calibration_profile);
+            }
+          } else {
+            trt_config->setInt8Calibrator(nullptr);
+            if (!SetDynamicRange(*trt_state->network->get(), trt_state->dynamic_range_map)) {
+              return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to set INT8 dynamic range.");
+            }
           }
         }
 
         // Set precision
-        if (*(trt_state->fp16_enable_ptr) && *(trt_state->int8_enable_ptr)) {
+        if (*(trt_state->fp16_enable_ptr) && build_int8) {
           trt_config->setFlags(1U << static_cast<uint32_t>(nvinfer1::BuilderFlag::kFP16) | 1U << static_cast<uint32_t>(nvinfer1::BuilderFlag::kINT8));
         } else if (*(trt_state->fp16_enable_ptr)) {
           trt_config->setFlag(nvinfer1::BuilderFlag::kFP16);
-        } else if (*(trt_state->int8_enable_ptr)) {
+        } else if (build_int8) {
           trt_config->setFlag(nvinfer1::BuilderFlag::kINT8);
         }
 
@@ -1379,7 +1610,12 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
           return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP Failed to Build Engine.");
         }
         trt_engine = trt_state->engine->get();
-        if (trt_state->engine_cache_enable) {
+        if (calibrator != nullptr && build_int8) {
+          calibrator->ReleaseBatches();
+        }
+
+        // The engine built before calibration isn't cached
+        if (trt_state->engine_cache_enable && build_int8 == int8_enable) {
           // Serialize engine profile
           SerializeProfile(profile_cache_path, shape_ranges);
           LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + profile_cache_path;
@@ -1391,15 +1627,46 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
           serializedModel->destroy();
           LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + engine_cache_path;
         }
+      }
 
-        // Build context
-        *(trt_state->context) = tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext>(
-            trt_state->engine->get()->createExecutionContext());
-        if (trt_state->context->get() == nullptr) {
+      // Collect the inputs of this Run call as a calibration batch
+      const bool add_calibration_batch = calibrator != nullptr && calibrator->NeedsBatches();
+      std::unordered_map<std::string, TensorrtInt8Calibrator::Input> calibration_batch;
+
+      // Take an execution context of the current engine, creating one if the pool limit allows it
+      trt_state->tensorrt_cv_ptr->wait(lock, [&]() {
+        return !context_pool.free_contexts.empty() || context_pool.num_contexts < trt_state->max_execution_contexts;
+      });
+      std::unique_ptr<TensorrtExecutionContext> exec_context;
+      if (!context_pool.free_contexts.empty()) {
+        exec_context = std::move(context_pool.free_contexts.back());
+        context_pool.free_contexts.pop_back();
+      } else {
+        exec_context = onnxruntime::make_unique<TensorrtExecutionContext>();
+        exec_context->engine = *(trt_state->engine);
+        exec_context->context = tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext>(
+            exec_context->engine->createExecutionContext());
+        if (exec_context->context == nullptr) {
           return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to create context.");
         }
-        trt_context = trt_state->context->get();
+        CUDA_RETURN_IF_ERROR(cudaStreamCreateWithFlags(&exec_context->stream, cudaStreamNonBlocking));
+        CUDA_RETURN_IF_ERROR(cudaEventCreateWithFlags(&exec_context->event, cudaEventDisableTiming));
+        ++context_pool.num_contexts;
       }
+      trt_engine = exec_context->engine.get();
+      auto trt_context = exec_context->context.get();
+
+      // Return the context when done. Contexts of an engine that has been rebuilt meanwhile are destroyed.
+      auto release_context = gsl::finally([&]() {
+        std::lock_guard<OrtMutex> release_lock(*(trt_state->tensorrt_mu_ptr));
+        if (exec_context->engine == *(trt_state->engine)) {
+          context_pool.free_contexts.push_back(std::move(exec_context));
+        } else {
+          exec_context.reset();
+        }
+        trt_state->tensorrt_cv_ptr->notify_all();
+      });
+      lock.unlock();
 
       // Get input and output binding names
       int total_bindings = trt_engine->getNbBindings();
@@ -1524,9 +1791,27 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
                                    "TensorRT EP input onnx tensor data type: " + std::to_string(input_type) + " not supported.");
           }
         }
+
+        if (add_calibration_batch) {
+          nvinfer1::Dims batch_dims = trt_engine->getBindingDimensions(binding_index);
+          size_t batch_elements = 1;
+          for (int j = 0, end = nb_dims; j < end; ++j) {
+            batch_dims.d[j] = static_cast<int32_t>(tensor_shapes[j]);
+            batch_elements *= static_cast<size_t>(tensor_shapes[j]);
+          }
+          // Empty inputs are bound to a scratch buffer of one element
+          const size_t batch_size = std::max<size_t>(batch_elements, 1) * GetElementSize(trt_engine->getBindingDataType(binding_index));
+          calibration_batch[input_name] = {buffers[binding_index], batch_size, batch_dims};
+        }
         ort.ReleaseTensorTypeAndShapeInfo(tensor_info);
       }
 
+      if (add_calibration_batch) {
+        // Copied on the default stream, after the INT64 inputs are cast
+        std::lock_guard<OrtMutex> calibration_lock(*(trt_state->tensorrt_mu_ptr));
+        ORT_RETURN_IF_ERROR(calibrator->AddBatch(calibration_batch, nullptr));
+      }
+
       // Set output shapes and assign output buffers
       std::vector<int> output_dim_sizes(num_outputs, 1);
       std::vector<OrtValue*> output_tensor(num_outputs, nullptr);
@@ -1638,10 +1923,14 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
         }
       }
 
-      // Run TRT inference
-      if (!trt_context->enqueueV2(&buffers[0], nullptr, nullptr)) {
+      // Run TRT inference on the stream of the context, ordered after and before work on the default stream
+      CUDA_RETURN_IF_ERROR(cudaEventRecord(exec_context->event, nullptr));
+      CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(exec_context->stream, exec_context->event, 0));
+      if (!trt_context->enqueueV2(&buffers[0], exec_context->stream, nullptr)) {
         return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "TensorRT EP execution context enqueue failed.");
       }
+      CUDA_RETURN_IF_ERROR(cudaEventRecord(exec_context->event, exec_context->stream));
+      CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(nullptr, exec_context->event, 0));
 
       // Cast INT64 input to INT32 because TensorRT doesn't fully support INT64
       for (int i = 0, end = output_binding_names.size(); i < end; ++i) {
@@ -1665,6 +1954,46 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<Node*>& fuse
 
     node_compute_funcs.push_back(compute_info);
   }
+
+  // Build engines of subgraphs without dynamic shape input in parallel. Each task has its own builder and network.
+  if (!engine_build_tasks.empty()) {
+    const size_t num_tasks = engine_build_tasks.size();
+    const size_t num_threads = std::min<size_t>(num_tasks, std::max(1U, std::thread::hardware_concurrency()));
+    std::atomic<size_t> next_task{0};
+    auto build_engines = [&engine_build_tasks, &next_task, num_tasks]() {
+      for (size_t i = next_task++; i < num_tasks; i = next_task++) {
+        auto& task = engine_build_tasks[i];
+        task.engine = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(
+            task.builder->buildEngineWithConfig(*task.network, *task.config));
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (size_t i = 1; i < num_threads; ++i) {
+      threads.emplace_back(build_engines);
+    }
+    build_engines();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    for (auto& task : engine_build_tasks) {
+      if (task.engine == nullptr) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                               "TensorRT EP could not build engine for fused node: " + task.fused_node_name);
+      }
+      if (engine_cache_enable_ && task.cache_engine) {
+        nvinfer1::IHostMemory* serializedModel = task.engine->serialize();
+        std::ofstream file(task.engine_cache_path, std::ios::binary | std::ios::out);
+        file.write(reinterpret_cast<char*>(serializedModel->data()), serializedModel->size());
+        serializedModel->destroy();
+        LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + task.engine_cache_path;
+      }
+
+      engines_[task.fused_node_name] = std::move(task.engine);
+    }
+  }
   return Status::OK();
 }
 }  // namespace onnxruntime
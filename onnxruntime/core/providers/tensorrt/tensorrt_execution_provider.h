@@ -3,6 +3,7 @@
 
 #pragma once
 #include <ctime>
+#include "cuda_runtime_api.h"
 #include "NvInfer.h"
 #include "NvOnnxParser.h"
 #include "core/platform/ort_mutex.h"
@@ -17,9 +18,11 @@ static const std::string kFP16Enable = "ORT_TENSORRT_FP16_ENABLE";
 static const std::string kINT8Enable = "ORT_TENSORRT_INT8_ENABLE";
 static const std::string kINT8CalibrationTableName = "ORT_TENSORRT_INT8_CALIBRATION_TABLE_NAME";
 static const std::string kINT8UseNativeTensorrtCalibrationTable = "ORT_TENSORRT_INT8_USE_NATIVE_CALIBRATION_TABLE";
+static const std::string kINT8CalibrationBatches = "ORT_TENSORRT_INT8_CALIBRATION_BATCHES";
 static const std::string kDumpSubgraphs = "ORT_TENSORRT_DUMP_SUBGRAPHS";
 static const std::string kEngineCacheEnable = "ORT_TENSORRT_ENGINE_CACHE_ENABLE";
 static const std::string kCachePath = "ORT_TENSORRT_CACHE_PATH";
+static const std::string kMaxExecutionContexts = "ORT_TENSORRT_MAX_EXECUTION_CONTEXTS";
 // Old env variable for backward compatibility
 static const std::string kEngineCachePath = "ORT_TENSORRT_ENGINE_CACHE_PATH";
 }  // namespace tensorrt_env_vars
@@ -64,6 +67,83 @@ template <typename T>
 using unique_pointer = std::unique_ptr<T, TensorrtInferDeleter>;
 };  // namespace tensorrt_ptr
 
+// Execution context of a TensorRT engine with its own CUDA stream, so that concurrent Run calls
+// on the same fused node don't wait on each other while TensorRT executes.
+struct TensorrtExecutionContext {
+  TensorrtExecutionContext() = default;
+  ~TensorrtExecutionContext();
+  TensorrtExecutionContext(const TensorrtExecutionContext&) = delete;
+  TensorrtExecutionContext& operator=(const TensorrtExecutionContext&) = delete;
+
+  // Keeps the engine alive while the context is in use, even if the engine is rebuilt meanwhile
+  std::shared_ptr<nvinfer1::ICudaEngine> engine;
+  tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext> context;
+  cudaStream_t stream = nullptr;
+  cudaEvent_t event = nullptr;
+};
+
+// Execution contexts of the current engine of a fused node which are not in use
+struct TensorrtExecutionContextPool {
+  std::vector<std::unique_ptr<TensorrtExecutionContext>> free_contexts;
+  size_t num_contexts = 0;  // number of contexts of the current engine, including the ones in use
+};
+
+/*
+* INT8 calibrator of a fused node without calibration table. The inputs of the first Run calls of the node are
+* collected as calibration batches, and the engine is rebuilt in INT8 with them once they are all collected.
+* The calibration cache written by TensorRT is saved to a file, from which it is read in later sessions instead
+* of collecting the batches again.
+*/
+class TensorrtInt8Calibrator : public nvinfer1::IInt8EntropyCalibrator2 {
+ public:
+  struct Input {
+    const void* data;  // device memory in the format of the engine binding
+    size_t size;       // in bytes
+    nvinfer1::Dims dims;
+  };
+
+  TensorrtInt8Calibrator(const std::string& cache_path, size_t num_batches);
+  ~TensorrtInt8Calibrator();
+  TensorrtInt8Calibrator(const TensorrtInt8Calibrator&) = delete;
+  TensorrtInt8Calibrator& operator=(const TensorrtInt8Calibrator&) = delete;
+
+  // Copy the inputs of a Run call as a calibration batch. The batches must all have the shapes of the first one,
+  // so that they fit the calibration profile, and batches of other shapes are skipped.
+  common::Status AddBatch(const std::unordered_map<std::string, Input>& inputs, cudaStream_t stream);
+
+  // Called once the INT8 engine is built. Frees the batches and stops collecting new ones.
+  void ReleaseBatches();
+
+  // True if the batches of the inputs of the next Run call are needed
+  bool NeedsBatches() const { return !calibrated_ && cache_.empty() && batches_.size() < num_batches_; }
+
+  // True if the INT8 engine can be built, either from the calibration cache or from the batches
+  bool IsReady() const { return calibrated_ || !cache_.empty() || batches_.size() == num_batches_; }
+
+  // True if all the batches are collected but the INT8 engine is not built yet
+  bool IsPending() const { return !calibrated_ && cache_.empty() && batches_.size() == num_batches_; }
+
+  bool HasCache() const { return !cache_.empty(); }
+
+  // Input shapes of the batches for the calibration profile
+  const std::unordered_map<std::string, nvinfer1::Dims>& BatchDims() const { return batch_dims_; }
+
+  // The network has explicit batch dimension, so each batch is a set of complete inputs
+  int getBatchSize() const noexcept override { return 1; }
+  bool getBatch(void* bindings[], const char* names[], int nb_bindings) noexcept override;
+  const void* readCalibrationCache(size_t& length) noexcept override;
+  void writeCalibrationCache(const void* cache, size_t length) noexcept override;
+
+ private:
+  std::string cache_path_;
+  size_t num_batches_;
+  size_t next_batch_ = 0;  // batch returned by the next getBatch call
+  bool calibrated_ = false;
+  std::vector<std::unordered_map<std::string, void*>> batches_;
+  std::unordered_map<std::string, nvinfer1::Dims> batch_dims_;
+  std::vector<char> cache_;
+};
+
 // Information needed to construct trt execution providers.
 struct TensorrtExecutionProviderInfo {
   int device_id{0};
@@ -75,14 +155,16 @@ struct TensorrtFuncState {
   DestroyFunc test_release_func = nullptr;
   AllocatorHandle allocator = nullptr;
   tensorrt_ptr::unique_pointer<nvonnxparser::IParser>* parser = nullptr;
-  tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>* engine = nullptr;
-  tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext>* context = nullptr;
+  std::shared_ptr<nvinfer1::ICudaEngine>* engine = nullptr;
+  TensorrtExecutionContextPool* context_pool = nullptr;
   tensorrt_ptr::unique_pointer<nvinfer1::IBuilder>* builder = nullptr;
   tensorrt_ptr::unique_pointer<nvinfer1::INetworkDefinition>* network = nullptr;
   std::vector<std::unordered_map<std::string, int>> input_info;
   std::vector<std::unordered_map<std::string, int>> output_info;
   std::unordered_map<std::string, std::unordered_map<int, std::pair<int64_t, int64_t>>> input_shape_ranges;
   OrtMutex* tensorrt_mu_ptr = nullptr;
+  OrtCondVar* tensorrt_cv_ptr = nullptr;
+  size_t max_execution_contexts = 1;
   bool* fp16_enable_ptr = nullptr;
   bool* int8_enable_ptr = nullptr;
   size_t* max_workspace_size_ptr = nullptr;
@@ -92,6 +174,8 @@ struct TensorrtFuncState {
   nvinfer1::IRuntime* runtime = nullptr;
   AllocatorPtr scratch_allocator;
   std::unordered_map<std::string, float> dynamic_range_map;
+  TensorrtInt8Calibrator* int8_calibrator = nullptr;  // calibrator of a fused node calibrated at runtime
+  bool explicit_precision = false;                    // INT8 scales are given by the Q/DQ nodes of the subgraph
 };
 
 // Logical device representation.
@@ -124,23 +208,27 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   bool int8_enable_ = false;
   std::string int8_calibration_cache_name_ = "INT8_calibration_table";
   bool int8_use_native_tensorrt_calibration_table_ = false;
+  size_t int8_calibration_batches_ = 0;  // calibrate at runtime with this many batches if there is no table
   bool dump_subgraphs_ = false;
   bool engine_cache_enable_ = false;
   std::string cache_path_;
   nvinfer1::IRuntime* runtime_ = nullptr;
+  size_t max_execution_contexts_ = 1;
   OrtMutex tensorrt_mu_;
+  OrtCondVar tensorrt_cv_;  // signaled when an execution context is returned to its pool
   int device_id_;
   AllocatorPtr allocator_;
   mutable char model_path_[4096]; // Reserved for max path length
 
   std::unordered_map<std::string, tensorrt_ptr::unique_pointer<nvonnxparser::IParser>> parsers_;
-  std::unordered_map<std::string, tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>> engines_;
-  std::unordered_map<std::string, tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext>> contexts_;
+  std::unordered_map<std::string, std::shared_ptr<nvinfer1::ICudaEngine>> engines_;
+  std::unordered_map<std::string, TensorrtExecutionContextPool> context_pools_;
   std::unordered_map<std::string, tensorrt_ptr::unique_pointer<nvinfer1::IBuilder>> builders_;
   std::unordered_map<std::string, tensorrt_ptr::unique_pointer<nvinfer1::INetworkDefinition>> networks_;
   std::unordered_map<std::string, std::vector<std::unordered_map<std::string, int>>> input_info_;
   std::unordered_map<std::string, std::vector<std::unordered_map<std::string, int>>> output_info_;
   std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_map<int, std::pair<int64_t, int64_t>>>> input_shape_ranges_;
+  std::unordered_map<std::string, std::unique_ptr<TensorrtInt8Calibrator>> calibrators_;
 
   /**Get IndexedSubGraph based on node list of the subgraph*/
   std::unique_ptr<IndexedSubGraph> GetSubGraph(SubGraph_t graph_nodes_index,
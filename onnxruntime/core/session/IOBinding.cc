@@ -80,22 +80,30 @@ common::Status IOBinding::SynchronizeOutputs() {
 
 common::Status IOBinding::BindOutput(const std::string& name, const OrtValue& ml_value) {
   // device value is ignored when ml_value is pre-allocated
-  return BindOutputImpl(name, ml_value, {});
+  return BindOutputImpl(name, ml_value, {}, false);
 }
 
-common::Status IOBinding::BindOutput(const std::string& name, OrtDevice device) {
-  return BindOutputImpl(name, {}, device);
+common::Status IOBinding::BindOutput(const std::string& name, OrtDevice device, bool reuse_buffer) {
+  return BindOutputImpl(name, {}, device, reuse_buffer);
 }
 
-common::Status IOBinding::BindOutputImpl(const std::string& name, const OrtValue& ml_value, OrtDevice device) {
+common::Status IOBinding::BindOutputImpl(const std::string& name, const OrtValue& ml_value, OrtDevice device,
+                                         bool reuse_buffer) {
   auto rc = Contains(output_names_, name);
   if (rc.first) {
-    outputs_[rc.second] = ml_value;
+    // keep the buffer from the previous Run if it is still to be reused
+    const bool keep_buffer = reuse_buffer && outputs_reuse_buffer_[rc.second] &&
+                             outputs_device_info_[rc.second] == device;
+    if (!keep_buffer) {
+      outputs_[rc.second] = ml_value;
+    }
     outputs_device_info_[rc.second] = device;
+    outputs_reuse_buffer_[rc.second] = reuse_buffer;
   } else {
     output_names_.push_back(name);
     outputs_.push_back(ml_value);
     outputs_device_info_.push_back(device);
+    outputs_reuse_buffer_.push_back(reuse_buffer);
   }
 
   return Status::OK();
@@ -105,6 +113,7 @@ void IOBinding::ClearOutputs() {
   output_names_.clear();
   outputs_.clear();
   outputs_device_info_.clear();
+  outputs_reuse_buffer_.clear();
 }
 
 const std::vector<std::string>& IOBinding::GetOutputNames() const { return output_names_; }
@@ -115,6 +124,10 @@ const std::vector<OrtDevice>& IOBinding::GetOutputsDeviceInfo() const {
   return outputs_device_info_;
 }
 
+const std::vector<bool>& IOBinding::GetOutputsReuseBuffer() const {
+  return outputs_reuse_buffer_;
+}
+
 const std::vector<std::string>& IOBinding::GetInputNames() const { return feed_names_; }
 
 const std::vector<OrtValue>& IOBinding::GetInputs() const { return feeds_; }
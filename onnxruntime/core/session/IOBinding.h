@@ -68,8 +68,12 @@ class IOBinding {
     * Bind an output name to a device. 
     * 
     * @param device Device to allocate the output on. Default is CPU. 
+    * @param reuse_buffer If true, the output allocated by a Run() is kept and the next Run() writes into the same
+    *                     buffer if the output has the same shape and device, and allocates a new one otherwise.
+    *                     The values returned by GetOutputs() for the previous Run are overwritten in that case.
+    *                     Binding the name again with reuse_buffer and the same device keeps the current buffer.
     */
-  common::Status BindOutput(const std::string& name, OrtDevice device = {});
+  common::Status BindOutput(const std::string& name, OrtDevice device = {}, bool reuse_buffer = false);
 
   /**
     * This simply collects the outputs obtained after calling Run() inside the @param outputs.
@@ -103,13 +107,18 @@ class IOBinding {
   std::vector<std::string> output_names_;
   std::vector<OrtValue> outputs_;
   std::vector<OrtDevice> outputs_device_info_;
+  std::vector<bool> outputs_reuse_buffer_;
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IOBinding);
 
   // device info for all outputs. only used by InferenceSession if the output is not pre-allocated.
   const std::vector<OrtDevice>& GetOutputsDeviceInfo() const;
 
+  // whether the buffer of each output is kept and reused by the next Run. only used by InferenceSession.
+  const std::vector<bool>& GetOutputsReuseBuffer() const;
+
   // The implementation for the BindOutput() overloads
-  common::Status BindOutputImpl(const std::string& name, const OrtValue& ml_value, OrtDevice device);
+  common::Status BindOutputImpl(const std::string& name, const OrtValue& ml_value, OrtDevice device,
+                                bool reuse_buffer);
 };
 }  // namespace onnxruntime
@@ -5,6 +5,7 @@
 #pragma warning(disable : 4267)
 #endif
 
+#include "core/common/make_unique.h"
 #include "core/framework/customregistry.h"
 #include "core/framework/data_types.h"
 #include "core/framework/op_kernel_info.h"
@@ -12,6 +13,8 @@
 #include "core/framework/error_code_helper.h"
 #include "core/framework/tensor_type_and_shape.h"
 #include "core/graph/onnx_protobuf.h"
+#include "core/platform/threadpool.h"
+#include "core/session/device_allocator.h"
 #include "core/session/inference_session.h"
 #include "core/session/ort_apis.h"
 
@@ -52,6 +55,33 @@ ORT_API_STATUS_IMPL(OrtApis::KernelContext_GetOutput, _Inout_ OrtKernelContext*
   return nullptr;
 };
 
+ORT_API_STATUS_IMPL(OrtApis::KernelContext_ParallelFor, _In_ const OrtKernelContext* context,
+                    _In_ OrtParallelForFn fn, _In_opt_ void* user_data, size_t total, double cost_per_iteration) {
+  if (fn == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "fn is null");
+  }
+
+  auto* thread_pool = reinterpret_cast<const onnxruntime::OpKernelContext*>(context)->GetOperatorThreadPool();
+  onnxruntime::concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(total), cost_per_iteration,
+      [fn, user_data](std::ptrdiff_t first, std::ptrdiff_t last) {
+        fn(user_data, static_cast<size_t>(first), static_cast<size_t>(last));
+      });
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::KernelContext_GetScratchAllocator, _In_ const OrtKernelContext* context,
+                    _Outptr_ OrtAllocator** out) {
+  API_IMPL_BEGIN
+  onnxruntime::AllocatorPtr allocator;
+  auto status = reinterpret_cast<const onnxruntime::OpKernelContext*>(context)->GetTempSpaceAllocator(&allocator);
+  if (!status.IsOK())
+    return onnxruntime::ToOrtStatus(status);
+  *out = new onnxruntime::OrtAllocatorForDevice(std::move(allocator));
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::KernelInfoGetAttribute_string, _In_ const OrtKernelInfo* info, _In_ const char* name, _Out_ char* out, _Inout_ size_t* size) {
   std::string value;
   auto status = reinterpret_cast<const onnxruntime::OpKernelInfo*>(info)->GetAttr<std::string>(name, &value);
@@ -88,11 +118,40 @@ struct CustomOpKernel : OpKernel {
     return Status::OK();
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                 /*out*/ PrePackedWeights* /*prepacked_weights*/) override {
+    is_packed = false;
+    // KernelPrePack was added in version 7, so older ops don't have the member
+    if (op_.version < 7 || op_.KernelPrePack == nullptr) {
+      return Status::OK();
+    }
+
+    // the kernel may hold on to the memory it packed the tensor into, so the allocator lives as long as the kernel
+    prepack_allocators_.push_back(onnxruntime::make_unique<OrtAllocatorForDevice>(std::move(alloc)));
+
+    OrtValue value;
+    value.Init(const_cast<Tensor*>(&tensor), DataTypeImpl::GetType<Tensor>(), [](void*) {});
+
+    int packed = 0;
+    OrtStatus* status = op_.KernelPrePack(op_kernel_, &value, input_idx, prepack_allocators_.back().get(), &packed);
+    if (status != nullptr) {
+      Status result(common::ONNXRUNTIME, common::FAIL,
+                    "PrePack of custom op '" + std::string(op_.GetName(&op_)) + "' failed: " +
+                        OrtApis::GetErrorMessage(status));
+      OrtApis::ReleaseStatus(status);
+      return result;
+    }
+
+    is_packed = packed != 0;
+    return Status::OK();
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CustomOpKernel);
 
   const OrtCustomOp& op_;
   void* op_kernel_;
+  std::vector<std::unique_ptr<OrtAllocatorForDevice>> prepack_allocators_;
 };
 
 common::Status CreateCustomRegistry(const std::vector<OrtCustomOpDomain*>& op_domains,
@@ -3,6 +3,7 @@
 
 #include "core/session/environment.h"
 #include "core/framework/allocatormgr.h"
+#include "core/framework/arena.h"
 #include "core/graph/constants.h"
 #include "core/graph/op.h"
 #if !defined(ORT_MINIMAL_BUILD)
@@ -22,6 +23,7 @@
 #include "core/graph/dml_ops/dml_defs.h"
 #endif
 
+#include "core/common/trace_sink.h"
 #include "core/platform/env.h"
 #include "core/util/thread_utils.h"
 #include "core/session/allocator_impl.h"
@@ -30,6 +32,10 @@
 #include "core/platform/tracing.h"
 #endif
 
+#ifdef ENABLE_NVTX_PROFILE
+#include "core/profile/profile.h"
+#endif
+
 #ifdef ENABLE_TRAINING
 #include "orttraining/core/graph/training_op_defs.h"
 #include "orttraining/core/graph/gradient_builder_registry.h"
@@ -94,6 +100,8 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
     int arena_extend_strategy = -1;
     int initial_chunk_size_bytes = -1;
     int max_dead_bytes_per_chunk = -1;
+    size_t max_thread_cache_bytes = 0;
+    int arena_type = -1;
 
     // override with values from the user supplied arena_cfg object
     if (arena_cfg) {
@@ -109,9 +117,23 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
 
       initial_chunk_size_bytes = arena_cfg->initial_chunk_size_bytes;
       max_dead_bytes_per_chunk = arena_cfg->max_dead_bytes_per_chunk;
+      max_thread_cache_bytes = arena_cfg->max_thread_cache_bytes;
+
+      arena_type = arena_cfg->arena_type;
+      if (!(arena_type == -1 || arena_type == static_cast<int>(ArenaType::kBFCArena) ||
+            arena_type == static_cast<int>(ArenaType::kMiMallocArena))) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "Received invalid value for arena type. Valid values can be either 0, 1 or -1.");
+      }
+#if !defined(USE_MIMALLOC_ARENA_ALLOCATOR)
+      if (arena_type == static_cast<int>(ArenaType::kMiMallocArena)) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The mimalloc arena is not enabled in this build.");
+      }
+#endif
     }
 
-    OrtArenaCfg l_arena_cfg{max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk};
+    OrtArenaCfg l_arena_cfg{max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk,
+                            max_thread_cache_bytes, arena_type};
     AllocatorCreationInfo alloc_creation_info{
         [mem_info](int) { return onnxruntime::make_unique<TAllocator>(mem_info); },
         0,
@@ -127,12 +149,54 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
   return RegisterAllocator(allocator_ptr);
 }
 
+// Set the process wide trace sink from the ORT_TRACE_SINK environment variable once. See core/common/trace_sink.h.
+// "chrome": stream Chrome trace events to the file in ORT_TRACE_FILE, "onnxruntime_trace.json" by default.
+// "usdt": fire USDT probes. Requires a build with onnxruntime_ENABLE_USDT_TRACING.
+// "nvtx": report NVTX ranges and marks. Requires a build with onnxruntime_ENABLE_NVTX_PROFILE.
+static Status SetTraceSinkFromEnvironment() {
+  static std::once_flag trace_sink_once_flag;
+  Status status;
+  std::call_once(trace_sink_once_flag, [&status]() {
+    const std::string sink_type = Env::Default().GetEnvironmentVar("ORT_TRACE_SINK");
+    if (sink_type.empty()) {
+      return;
+    }
+
+    std::unique_ptr<tracing::ITraceSink> sink;
+    if (sink_type == "chrome") {
+      std::string file_path = Env::Default().GetEnvironmentVar("ORT_TRACE_FILE");
+      sink = tracing::CreateChromeTraceSink(file_path.empty() ? "onnxruntime_trace.json" : file_path);
+    } else if (sink_type == "usdt") {
+      sink = tracing::CreateUsdtTraceSink();
+    } else if (sink_type == "nvtx") {
+#ifdef ENABLE_NVTX_PROFILE
+      sink = onnxruntime::make_unique<profile::NvtxTraceSink>();
+#endif
+    } else {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unknown ORT_TRACE_SINK value: ", sink_type);
+      return;
+    }
+
+    if (!sink) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "ORT_TRACE_SINK ", sink_type,
+                               " is not supported by this build.");
+      return;
+    }
+
+    tracing::SetTraceSink(std::move(sink));
+  });
+
+  return status;
+}
+
 Status Environment::Initialize(std::unique_ptr<logging::LoggingManager> logging_manager,
                                const OrtThreadingOptions* tp_options,
                                bool create_global_thread_pools) {
   auto status = Status::OK();
 
   logging_manager_ = std::move(logging_manager);
+  ORT_RETURN_IF_ERROR(SetTraceSinkFromEnvironment());
+  prepacked_weights_container_ = onnxruntime::make_unique<PrepackedWeightsContainer>();
 
   // create thread pools
   if (create_global_thread_pools) {
@@ -4,16 +4,24 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <unordered_set>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
 #include <list>
+#include <map>
 #include <string>
 #include <thread>
 
+#include "core/common/cpuid_info.h"
 #include "core/common/denormal.h"
 #include "core/common/logging/logging.h"
+#include "core/common/parse_string.h"
 #include "core/framework/allocatormgr.h"
+#include "core/framework/arena.h"
 #include "core/framework/customregistry.h"
 #include "core/framework/error_code_helper.h"
 #include "core/framework/execution_frame.h"
@@ -22,14 +30,17 @@
 #include "core/framework/kernel_def_builder.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/mldata_type_utils.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/tensor_type_and_shape.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/ort_value_pattern_planner.h"
+#include "core/framework/run_latency_breakdown.h"
 #include "core/framework/utils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
+#include "core/optimizer/elementwise_chain_fusion.h"
 #include "core/optimizer/transformer_memcpy.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/insert_cast_transformer.h"
@@ -105,7 +116,8 @@ std::atomic<uint32_t> InferenceSession::global_session_id_{1};
 // Version 1 - history begins
 // Version 2 - add serialization/deserialization of sparse_initializer
 // Version 3 - add `graph_doc_string` to Model
-static constexpr const char* kOrtModelVersion = "3";
+// Version 4 - add optional compression of the raw data of Tensor
+static constexpr const char* kOrtModelVersion = "4";
 
 #if defined(ENABLE_ORT_FORMAT_LOAD)
 // Check if the given ort model version is supported in this build
@@ -116,6 +128,7 @@ static bool IsOrtModelVersionSupported(const std::string& ort_model_version) {
       std::string("1.4.0"),  // This is a special model version for existing converted model
       std::string("1"),
       std::string("2"),
+      std::string("3"),
       std::string(kOrtModelVersion),
   };
 
@@ -225,24 +238,50 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
   }
 
   use_per_session_threads_ = session_options.use_per_session_threads;
+  partition_concurrent_runs_ =
+      session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpPartitionConcurrentRuns, "0") == "1";
+
+  const std::string arena_shrink_interval_str =
+      session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigArenaShrinkIntervalRuns, "0");
+  if (!TryParseStringWithClassicLocale(arena_shrink_interval_str, arena_shrink_interval_runs_)) {
+    LOGS(*session_logger_, WARNING) << "Ignoring the invalid arena shrink interval: " << arena_shrink_interval_str;
+    arena_shrink_interval_runs_ = 0;
+  }
 
   if (use_per_session_threads_) {
     LOGS(*session_logger_, INFO) << "Creating and using per session threadpools since use_per_session_threads_ is true";
+    const std::string spin_policy_str =
+        session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigThreadPoolSpinPolicy, "fixed");
+    SpinPolicy spin_policy = SpinPolicy::kFixed;
+    if (spin_policy_str == "latency") {
+      spin_policy = SpinPolicy::kLatency;
+    } else if (spin_policy_str == "efficiency") {
+      spin_policy = SpinPolicy::kEfficiency;
+    } else if (spin_policy_str != "fixed") {
+      LOGS(*session_logger_, WARNING) << "Ignoring the invalid thread pool spin policy: " << spin_policy_str;
+    }
     {
       OrtThreadPoolParams to = session_options_.intra_op_param;
       if (to.name == nullptr) {
         to.name = ORT_TSTR("intra-op");
       }
       to.set_denormal_as_zero = set_denormal_as_zero;
+      to.spin_policy = spin_policy;
       // If the thread pool can use all the processors, then
       // we set affinity of each thread to each processor.
       to.auto_set_affinity = to.thread_pool_size == 0 &&
                              session_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL &&
                              to.affinity_vec_len == 0;
+      const std::string numa_node_str =
+          session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpNumaNode, "-1");
+      if (!TryParseStringWithClassicLocale(numa_node_str, to.numa_node)) {
+        LOGS(*session_logger_, WARNING) << "Ignoring the invalid intra-op NUMA node: " << numa_node_str;
+        to.numa_node = -1;
+      }
       thread_pool_ =
           concurrency::CreateThreadPool(&Env::Default(), to, concurrency::ThreadPoolType::INTRA_OP);
     }
-    if (session_options_.execution_mode == ExecutionMode::ORT_PARALLEL) {
+    if (session_options_.execution_mode != ExecutionMode::ORT_SEQUENTIAL) {
       OrtThreadPoolParams to = session_options_.inter_op_param;
       // If the thread pool can use all the processors, then
       // we set thread affinity.
@@ -251,6 +290,7 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
       if (to.name == nullptr)
         to.name = ORT_TSTR("intra-op");
       to.set_denormal_as_zero = set_denormal_as_zero;
+      to.spin_policy = spin_policy;
       inter_op_thread_pool_ =
           concurrency::CreateThreadPool(&Env::Default(), to, concurrency::ThreadPoolType::INTER_OP);
       if (inter_op_thread_pool_ == nullptr) {
@@ -267,6 +307,16 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
                 " threadpools, the env must be created with the the CreateEnvWithGlobalThreadPools API.");
   }
 
+  thread_pool_stats_enabled_ =
+      session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigProfilingThreadPoolStats, "0") == "1";
+  if (thread_pool_stats_enabled_) {
+    for (auto* tp : {GetIntraOpThreadPoolToUse(), GetInterOpThreadPoolToUse()}) {
+      if (tp) {
+        tp->EnableStats(true);
+      }
+    }
+  }
+
   session_profiler_.Initialize(session_logger_);
   if (session_options_.enable_profiling) {
     StartProfiling(session_options_.profile_file_prefix);
@@ -353,6 +403,20 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 InferenceSession::~InferenceSession() {
+  {
+    // runs scheduled by RunAsync reference this session
+    std::unique_lock<OrtMutex> lock(async_runs_mutex_);
+    async_runs_cv_.wait(lock, [this]() { return num_pending_async_runs_ == 0; });
+  }
+
+  if (thread_pool_) {
+    uint64_t spin_hits = 0;
+    uint64_t spin_misses = 0;
+    thread_pool_->GetSpinCounters(spin_hits, spin_misses);
+    LOGS(*session_logger_, INFO) << "Intra-op thread pool spin hits: " << spin_hits
+                                 << ", spin misses: " << spin_misses;
+  }
+
   if (session_options_.enable_profiling) {
     ORT_TRY {
       EndProfiling();
@@ -422,8 +486,10 @@ common::Status InferenceSession::RegisterExecutionProvider(std::unique_ptr<IExec
   }
 
   if (provider_type == onnxruntime::kCudaExecutionProvider) {
-    // Parallel execution mode does not support the CUDA EP
-    if (session_options_.execution_mode != ExecutionMode::ORT_SEQUENTIAL) {
+    // Parallel execution mode does not support the CUDA EP. The heterogeneous mode does, as it launches all the CUDA
+    // nodes from the thread calling Run.
+    if (session_options_.execution_mode != ExecutionMode::ORT_SEQUENTIAL &&
+        session_options_.execution_mode != ExecutionMode::ORT_PARALLEL_HETEROGENEOUS) {
       LOGS(*session_logger_, WARNING)
           << "Parallel execution mode does not support the CUDA Execution Provider. "
           << "So making the execution mode sequential for this session since it uses the CUDA Execution Provider.";
@@ -506,10 +572,22 @@ common::Status InferenceSession::SaveToOrtFormat(const std::basic_string<ORTCHAR
   fbs_buffer_size = ((fbs_buffer_size + m_bytes - 1) / m_bytes) * m_bytes;
   flatbuffers::FlatBufferBuilder builder(fbs_buffer_size);
 
+  const std::string compression_name =
+      session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigOrtFormatInitializerCompression, "NONE");
+  auto initializer_compression = fbs::TensorDataCompression::NONE;
+  if (compression_name == "LZ4") {
+    initializer_compression = fbs::TensorDataCompression::LZ4;
+  } else if (compression_name == "BYTE_SHUFFLE_LZ4") {
+    initializer_compression = fbs::TensorDataCompression::BYTE_SHUFFLE_LZ4;
+  } else if (compression_name != "NONE") {
+    LOGS(*session_logger_, WARNING) << "Unsupported ORT format initializer compression '" << compression_name
+                                    << "'. The initializers are saved uncompressed.";
+  }
+
   auto ort_model_version = builder.CreateString(kOrtModelVersion);
   flatbuffers::Offset<fbs::Model> model;
   ORT_RETURN_IF_ERROR(
-      model_->SaveToOrtFormat(builder, model));
+      model_->SaveToOrtFormat(builder, model, initializer_compression));
 
   flatbuffers::Offset<fbs::SessionState> session_state;
   ORT_RETURN_IF_ERROR(
@@ -549,9 +627,11 @@ common::Status InferenceSession::Load(std::function<common::Status(std::shared_p
       return common::Status(common::ONNXRUNTIME, common::MODEL_LOADED, "This session already contains a loaded model.");
     }
 
+    const TimePoint parse_start_time = std::chrono::high_resolution_clock::now();
     std::shared_ptr<onnxruntime::Model> p_tmp_model;
     status = loader(p_tmp_model);
     ORT_RETURN_IF_ERROR_SESSIONID_(status);
+    LOGS(*session_logger_, INFO) << "Model parsing took " << TimeDiffMicroSeconds(parse_start_time) << " us.";
 
     model_ = p_tmp_model;
 
@@ -840,8 +920,16 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph,
   auto mode = saving_model_in_ort_format ? GraphPartitioner::Mode::kAssignOnly
                                          : GraphPartitioner::Mode::kNormal;
 
+  const std::string max_cpu_island_size_str =
+      session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigPartitionMaxCpuIslandSize, "0");
+  size_t max_cpu_island_size = 0;
+  if (!TryParseStringWithClassicLocale(max_cpu_island_size_str, max_cpu_island_size)) {
+    LOGS(*session_logger_, WARNING) << "Ignoring the invalid maximum CPU island size: " << max_cpu_island_size_str;
+    max_cpu_island_size = 0;
+  }
+
   // Do partitioning based on execution providers' capability.
-  GraphPartitioner partitioner(kernel_registry_manager, providers);
+  GraphPartitioner partitioner(kernel_registry_manager, providers, max_cpu_island_size);
   ORT_RETURN_IF_ERROR_SESSIONID_(partitioner.Partition(graph, session_state.ExportDll(),
                                                        session_state.GetMutableFuncMgr(), mode));
 
@@ -933,15 +1021,26 @@ Status InferenceSession::PartitionOrtFormatModel(onnxruntime::Graph& graph,
 template <typename T>
 static Status LoadOrtModelBytes(const std::basic_string<T>& model_uri,
                                 std::basic_string<ORTCHAR_T>& model_location,
-                                std::vector<uint8_t>& bytes) {
+                                bool use_mmap,
+                                gsl::span<const uint8_t>& bytes,
+                                std::vector<uint8_t>& bytes_data_holder,
+                                Env::MappedMemoryPtr& mapped_memory) {
   size_t num_bytes = 0;
   model_location = ToWideString(model_uri);
   ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(model_location.c_str(), num_bytes));
 
-  bytes.resize(num_bytes);
+  if (use_mmap) {
+    // fall back to reading the file if it can't be mapped
+    if (Env::Default().MapFileIntoMemory(model_location.c_str(), 0, num_bytes, mapped_memory).IsOK()) {
+      bytes = gsl::make_span(reinterpret_cast<const uint8_t*>(mapped_memory.get()), num_bytes);
+      return Status::OK();
+    }
+  }
+
+  bytes_data_holder.resize(num_bytes);
 
   std::ifstream bytes_stream(model_uri, std::ifstream::in | std::ifstream::binary);
-  bytes_stream.read(reinterpret_cast<char*>(bytes.data()), num_bytes);
+  bytes_stream.read(reinterpret_cast<char*>(bytes_data_holder.data()), num_bytes);
 
   if (!bytes_stream) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
@@ -949,13 +1048,17 @@ static Status LoadOrtModelBytes(const std::basic_string<T>& model_uri,
                            bytes_stream.gcount(), "/", num_bytes, " bytes were able to be read.");
   }
 
+  bytes = gsl::make_span(bytes_data_holder.data(), bytes_data_holder.size());
   return Status::OK();
 }
 
 Status InferenceSession::LoadOrtModel(const std::string& model_uri) {
   return LoadOrtModel(
       [&]() {
-        ORT_RETURN_IF_ERROR(LoadOrtModelBytes(model_uri, model_location_, ort_format_model_bytes_));
+        const bool use_mmap =
+            session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigUseMmapForOrtModel, "0") == "1";
+        ORT_RETURN_IF_ERROR(LoadOrtModelBytes(model_uri, model_location_, use_mmap, ort_format_model_bytes_,
+                                              ort_format_model_bytes_data_holder_, ort_format_model_mapped_memory_));
         return Status::OK();
       });
 }
@@ -964,7 +1067,10 @@ Status InferenceSession::LoadOrtModel(const std::string& model_uri) {
 Status InferenceSession::LoadOrtModel(const std::wstring& model_uri) {
   return LoadOrtModel(
       [&]() {
-        ORT_RETURN_IF_ERROR(LoadOrtModelBytes(model_uri, model_location_, ort_format_model_bytes_));
+        const bool use_mmap =
+            session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigUseMmapForOrtModel, "0") == "1";
+        ORT_RETURN_IF_ERROR(LoadOrtModelBytes(model_uri, model_location_, use_mmap, ort_format_model_bytes_,
+                                              ort_format_model_bytes_data_holder_, ort_format_model_mapped_memory_));
         return Status::OK();
       });
 }
@@ -976,8 +1082,11 @@ Status InferenceSession::LoadOrtModel(const void* model_data, int model_data_len
     //
     // TODO: Provide Load API where we can take ownership of memory to avoid the copy,
     // and/or a combined Load+Initialize where we don't need this temporary copy.
-    ort_format_model_bytes_.resize(model_data_len);
-    std::copy_n(reinterpret_cast<const uint8_t*>(model_data), model_data_len, ort_format_model_bytes_.data());
+    ort_format_model_bytes_data_holder_.resize(model_data_len);
+    std::copy_n(reinterpret_cast<const uint8_t*>(model_data), model_data_len,
+                ort_format_model_bytes_data_holder_.data());
+    ort_format_model_bytes_ = gsl::make_span(ort_format_model_bytes_data_holder_.data(),
+                                             ort_format_model_bytes_data_holder_.size());
 
     return Status::OK();
   });
@@ -1001,7 +1110,14 @@ Status InferenceSession::LoadOrtModel(std::function<Status()> load_ort_format_mo
   }
 
   ORT_RETURN_IF_ERROR(load_ort_format_model_bytes());
+  ORT_RETURN_IF_ERROR(LoadOrtModelFromBytes());
 
+  is_model_loaded_ = true;
+
+  return Status::OK();
+}
+
+Status InferenceSession::LoadOrtModelFromBytes() {
   // Verify the ort_format_model_bytes_ is a valid InferenceSessionBuffer before we access the data
   flatbuffers::Verifier verifier(ort_format_model_bytes_.data(), ort_format_model_bytes_.size());
   ORT_RETURN_IF_NOT(fbs::VerifyInferenceSessionBuffer(verifier));
@@ -1037,10 +1153,192 @@ Status InferenceSession::LoadOrtModel(std::function<Status()> load_ort_format_mo
   const auto* fbs_sess_state = fbs_session->session_state();
   ORT_RETURN_IF(nullptr == fbs_sess_state, "SessionState is null. Invalid ORT format model.");
 
-  is_model_loaded_ = true;
-
   return Status::OK();
 }
+
+#if !defined(ORT_MINIMAL_BUILD)
+// suffix of the file with the pre-packed weights of an initialization cache entry
+static const ORTCHAR_T* const kPrePackedWeightsCacheSuffix = ORT_TSTR(".prepacked");
+
+std::basic_string<ORTCHAR_T> InferenceSession::GetInitializationCachePath() const {
+  const std::string cache_dir =
+      session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigInitializationCacheDir, "");
+  if (cache_dir.empty()) {
+    return {};
+  }
+
+  if (model_location_.empty()) {
+    LOGS(*session_logger_, INFO) << "The initialization cache is only used for models loaded from a file.";
+    return {};
+  }
+
+  // nodes compiled by an execution provider can't be saved in the ORT format model
+  for (const auto& provider_type : execution_providers_.GetIds()) {
+    if (provider_type != kCpuExecutionProvider && provider_type != kCudaExecutionProvider) {
+      LOGS(*session_logger_, INFO) << "The initialization cache is not used with the " << provider_type
+                                   << " execution provider.";
+      return {};
+    }
+  }
+
+  uint32_t hash[4] = {0, 0, 0, 0};
+
+  auto hash_bytes = [&hash](const void* data, size_t len) {
+    MurmurHash3::x86_128(data, static_cast<int>(len), hash[0], &hash);
+  };
+
+  // the model file is hashed in chunks so that it doesn't need to be read into memory
+  std::ifstream model_stream(model_location_, std::ios::in | std::ios::binary);
+  if (!model_stream) {
+    LOGS(*session_logger_, WARNING) << "The initialization cache is not used as the model file "
+                                    << ToMBString(model_location_) << " could not be read.";
+    return {};
+  }
+
+  std::vector<char> chunk(1024 * 1024);
+  while (model_stream) {
+    model_stream.read(chunk.data(), chunk.size());
+    const auto bytes_read = static_cast<size_t>(model_stream.gcount());
+    if (bytes_read > 0) {
+      hash_bytes(chunk.data(), bytes_read);
+    }
+  }
+
+  // anything that changes the optimized graph or the kernels assigned to its nodes is part of the key
+  const auto& cpuid_info = CPUIDInfo::GetCPUIDInfo();
+  std::ostringstream key;
+  key << ORT_VERSION
+      << ";level=" << static_cast<int>(session_options_.graph_optimization_level)
+      << ";mode=" << static_cast<int>(session_options_.execution_mode)
+      << ";cpu=" << cpuid_info.HasSSE3() << cpuid_info.HasAVX() << cpuid_info.HasAVX2() << cpuid_info.HasF16C()
+      << cpuid_info.HasAVX512f() << cpuid_info.HasAVX512Skylake();
+  for (const auto& provider_type : execution_providers_.GetIds()) {
+    key << ";ep=" << provider_type;
+  }
+  for (const auto& transformer : transformers_to_enable_) {
+    key << ";transformer=" << transformer;
+  }
+  for (const auto& free_dim : session_options_.free_dimension_overrides) {
+    key << ";free_dim=" << free_dim.dim_identifier << ":" << static_cast<int>(free_dim.dim_identifer_type)
+        << ":" << free_dim.dim_value;
+  }
+  const std::map<std::string, std::string> configurations(session_options_.session_configurations.begin(),
+                                                          session_options_.session_configurations.end());
+  for (const auto& entry : configurations) {
+    key << ";config=" << entry.first << ":" << entry.second;
+  }
+
+  const std::string key_string = key.str();
+  hash_bytes(key_string.data(), key_string.size());
+
+  std::ostringstream file_name;
+  file_name << std::hex << std::setfill('0');
+  for (uint32_t value : hash) {
+    file_name << std::setw(8) << value;
+  }
+  file_name << ".ort";
+
+  return ToPathString(cache_dir + "/" + file_name.str());
+}
+
+bool InferenceSession::LoadInitializationCache(const std::basic_string<ORTCHAR_T>& cache_path) {
+  size_t num_bytes = 0;
+  if (!Env::Default().GetFileLength(cache_path.c_str(), num_bytes).IsOK()) {
+    return false;
+  }
+
+  std::shared_ptr<onnxruntime::Model> onnx_model = model_;
+  const std::basic_string<ORTCHAR_T> onnx_model_location = model_location_;
+
+  const bool use_mmap =
+      session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigUseMmapForOrtModel, "0") == "1";
+  Status status = LoadOrtModelBytes(cache_path, model_location_, use_mmap, ort_format_model_bytes_,
+                                    ort_format_model_bytes_data_holder_, ort_format_model_mapped_memory_);
+  if (status.IsOK()) {
+    status = LoadOrtModelFromBytes();
+  }
+
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Ignoring the initialization cache entry " << ToMBString(cache_path)
+                                    << ": " << status.ErrorMessage();
+    ort_format_model_bytes_ = gsl::span<const uint8_t>();
+    std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+    ort_format_model_mapped_memory_.reset();
+    model_ = onnx_model;
+    model_location_ = onnx_model_location;
+    ORT_IGNORE_RETURN_VALUE(SaveModelMetadata(*model_));
+    return false;
+  }
+
+  LOGS(*session_logger_, INFO) << "Loaded the optimized model from the initialization cache entry "
+                               << ToMBString(cache_path);
+  return true;
+}
+
+void InferenceSession::SaveInitializationCache(const std::basic_string<ORTCHAR_T>& cache_path) const {
+  if (session_state_->GetFuncMgr().NumFuncs() > 0) {
+    LOGS(*session_logger_, INFO) << "The initialization cache is not saved as the model contains compiled nodes.";
+    return;
+  }
+
+  const auto cache_dir =
+      ToPathString(session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigInitializationCacheDir, ""));
+  if (!Env::Default().FolderExists(cache_dir)) {
+    Status status = Env::Default().CreateFolder(cache_dir);
+    if (!status.IsOK()) {
+      LOGS(*session_logger_, WARNING) << "Failed to create the initialization cache directory: "
+                                      << status.ErrorMessage();
+      return;
+    }
+  }
+
+  // write to a temporary file first so that other processes never read a partially written entry
+  std::basic_ostringstream<ORTCHAR_T> temp_path;
+  temp_path << cache_path << ORT_TSTR(".") << Env::Default().GetSelfPid() << ORT_TSTR(".tmp");
+
+#ifdef _WIN32
+  auto rename_file = [](const std::wstring& from, const std::wstring& to) { return _wrename(from.c_str(), to.c_str()); };
+  auto remove_file = [](const std::wstring& path) { return _wremove(path.c_str()); };
+#else
+  auto rename_file = [](const std::string& from, const std::string& to) { return std::rename(from.c_str(), to.c_str()); };
+  auto remove_file = [](const std::string& path) { return std::remove(path.c_str()); };
+#endif
+
+  // the weights pre-packed by the kernels are saved next to the model, before it, so that a session
+  // loading the model finds them
+  const PrePackedWeightsCache* prepacked_weights_cache = session_state_->GetPrePackedWeightsCache();
+  if (prepacked_weights_cache != nullptr && prepacked_weights_cache->GetNumberOfEntries() > 0) {
+    const auto prepacked_weights_path = cache_path + kPrePackedWeightsCacheSuffix;
+    const auto prepacked_weights_temp_path = temp_path.str() + kPrePackedWeightsCacheSuffix;
+    Status prepacked_status = prepacked_weights_cache->Save(prepacked_weights_temp_path);
+    if (prepacked_status.IsOK() && rename_file(prepacked_weights_temp_path, prepacked_weights_path) != 0) {
+      prepacked_status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to rename ",
+                                         ToMBString(prepacked_weights_temp_path));
+    }
+
+    if (!prepacked_status.IsOK()) {
+      ORT_IGNORE_RETURN_VALUE(remove_file(prepacked_weights_temp_path));
+      LOGS(*session_logger_, WARNING) << "Failed to save the pre-packed weights to the initialization cache: "
+                                      << prepacked_status.ErrorMessage();
+    }
+  }
+
+  Status status = SaveToOrtFormat(temp_path.str());
+  if (status.IsOK() && rename_file(temp_path.str(), cache_path) != 0) {
+    status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to rename ", ToMBString(temp_path.str()));
+  }
+
+  if (!status.IsOK()) {
+    ORT_IGNORE_RETURN_VALUE(remove_file(temp_path.str()));
+    LOGS(*session_logger_, WARNING) << "Failed to save the initialization cache entry " << ToMBString(cache_path)
+                                    << ": " << status.ErrorMessage();
+    return;
+  }
+
+  LOGS(*session_logger_, INFO) << "Saved the optimized model to the initialization cache entry "
+                               << ToMBString(cache_path);
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
 #endif  // defined(ENABLE_ORT_FORMAT_LOAD)
 
 bool InferenceSession::IsInitialized() const {
@@ -1122,7 +1420,15 @@ common::Status InferenceSession::Initialize() {
     // RegisterExecutionProvider locks the session_mutex_ so we can't be holding it when we call that
     if (!have_cpu_ep) {
       LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
-      CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+      const std::string arena_type_str =
+          session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigCpuArenaType, "bfc");
+      ArenaType arena_type = ArenaType::kBFCArena;
+      if (arena_type_str == "mimalloc") {
+        arena_type = ArenaType::kMiMallocArena;
+      } else if (arena_type_str != "bfc") {
+        LOGS(*session_logger_, WARNING) << "Ignoring the invalid CPU arena type: " << arena_type_str;
+      }
+      CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena, arena_type};
       auto p_cpu_exec_provider = onnxruntime::make_unique<CPUExecutionProvider>(epi);
       ORT_RETURN_IF_ERROR_SESSIONID_(RegisterExecutionProvider(std::move(p_cpu_exec_provider)));
     }
@@ -1154,6 +1460,29 @@ common::Status InferenceSession::Initialize() {
     session_activity_started_ = true;
 #endif
 
+#if !defined(ORT_MINIMAL_BUILD) && defined(ENABLE_ORT_FORMAT_LOAD)
+    // the initialization cache replaces the loaded ONNX model with the cached ORT format model, so it needs to be
+    // checked before the session state is created from the graph. if there is no cache entry yet it is saved once
+    // the session state is finalized.
+    std::basic_string<ORTCHAR_T> initialization_cache_path;
+    std::basic_string<ORTCHAR_T> loaded_initialization_cache_path;
+    if (ort_format_model_bytes_.empty() && session_options_.optimized_model_filepath.empty()) {
+      initialization_cache_path = GetInitializationCachePath();
+      if (!initialization_cache_path.empty() && LoadInitializationCache(initialization_cache_path)) {
+        loaded_initialization_cache_path.swap(initialization_cache_path);
+      }
+    }
+    const bool saving_initialization_cache = !initialization_cache_path.empty();
+#else
+    const bool saving_initialization_cache = false;
+#endif
+
+    PrepackedWeightsContainer* prepacked_weights_container = nullptr;
+    if (session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigUseEnvPrepackedWeights, "0") == "1") {
+      LOGS(*session_logger_, INFO) << "This session will share pre-packed weights using the environment.";
+      prepacked_weights_container = environment_.GetPrepackedWeightsContainer();
+    }
+
     // now that we have all the execution providers, create the session state
     session_state_ = onnxruntime::make_unique<SessionState>(
         model_->MainGraph(),
@@ -1164,7 +1493,29 @@ common::Status InferenceSession::Initialize() {
         data_transfer_mgr_,
         *session_logger_,
         session_profiler_,
-        session_options_.use_deterministic_compute);
+        session_options_.use_deterministic_compute,
+        prepacked_weights_container);
+
+#if !defined(ORT_MINIMAL_BUILD) && defined(ENABLE_ORT_FORMAT_LOAD)
+    // the kernels use the weights pre-packed by the session that saved the initialization cache entry,
+    // or the session saving the entry collects the weights its kernels pre-pack
+    if (!loaded_initialization_cache_path.empty()) {
+      std::unique_ptr<PrePackedWeightsCache> prepacked_weights_cache;
+      Status cache_status = PrePackedWeightsCache::Load(loaded_initialization_cache_path + kPrePackedWeightsCacheSuffix,
+                                                        prepacked_weights_cache);
+      if (cache_status.IsOK()) {
+        LOGS(*session_logger_, INFO) << "Loaded " << prepacked_weights_cache->GetNumberOfEntries()
+                                     << " pre-packed weights from the initialization cache.";
+        session_state_->SetPrePackedWeightsCache(std::move(prepacked_weights_cache));
+      } else {
+        LOGS(*session_logger_, INFO) << "The initializers are pre-packed as the initialization cache has no "
+                                        "pre-packed weights: "
+                                     << cache_status.ErrorMessage();
+      }
+    } else if (saving_initialization_cache) {
+      session_state_->SetPrePackedWeightsCache(onnxruntime::make_unique<PrePackedWeightsCache>());
+    }
+#endif
 
     onnxruntime::Graph& graph = model_->MainGraph();
 
@@ -1180,7 +1531,7 @@ common::Status InferenceSession::Initialize() {
 
     bool loading_ort_format = !ort_format_model_bytes_.empty();
     bool saving_model = !session_options_.optimized_model_filepath.empty();
-    bool saving_ort_format = false;
+    bool saving_ort_format = saving_initialization_cache;
     if (saving_model) {
       std::string model_type = session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigSaveModelFormat, "");
       bool has_explicit_type = !model_type.empty();
@@ -1196,11 +1547,18 @@ common::Status InferenceSession::Initialize() {
                                 transformers_to_enable_);
 
       // apply any transformations to the main graph and any subgraphs
+      const TimePoint transform_start_time = std::chrono::high_resolution_clock::now();
       ORT_RETURN_IF_ERROR_SESSIONID_(TransformGraph(graph, graph_transformation_mgr_,
                                                     execution_providers_, kernel_registry_manager_,
                                                     insert_cast_transformer_,
                                                     *session_state_,
                                                     saving_ort_format));
+      LOGS(*session_logger_, INFO) << "Graph transformation took " << TimeDiffMicroSeconds(transform_start_time)
+                                   << " us.";
+      if (session_profiler_.IsEnabled()) {
+        session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "graph_transformation",
+                                                transform_start_time);
+      }
 
       // now that all the transforms are done, call Resolve on the main graph. this will recurse into the subgraphs.
       ORT_RETURN_IF_ERROR_SESSIONID_(graph.Resolve());
@@ -1232,7 +1590,7 @@ common::Status InferenceSession::Initialize() {
                                              session_options_,
                                              serialized_session_state,
                                              // need to keep the initializers if saving the optimized model
-                                             !saving_model,
+                                             !saving_model && !saving_initialization_cache,
                                              saving_ort_format));
 
 #if !defined(ORT_MINIMAL_BUILD)
@@ -1259,11 +1617,22 @@ common::Status InferenceSession::Initialize() {
     }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+#if !defined(ORT_MINIMAL_BUILD) && defined(ENABLE_ORT_FORMAT_LOAD)
+    if (saving_initialization_cache) {
+      SaveInitializationCache(initialization_cache_path);
+
+      // the initializers were only kept in the graph to save the cache entry
+      graph.CleanAllInitializedTensors();
+    }
+#endif
+
     session_state_->ResolveMemoryPatternFlag();
     is_inited_ = true;
 
     // we don't directly use the ORT format bytes currently, so free those now
-    std::vector<uint8_t>().swap(ort_format_model_bytes_);
+    ort_format_model_bytes_ = gsl::span<const uint8_t>();
+    std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+    ort_format_model_mapped_memory_.reset();
 
     // and log telemetry
     bool model_has_fp16_inputs = ModelHasFP16Inputs(graph);
@@ -1306,6 +1675,41 @@ common::Status InferenceSession::Initialize() {
   return status;
 }
 
+common::Status InferenceSession::Clone(const SessionOptions& session_options,
+                                       std::unique_ptr<InferenceSession>& clone) const {
+  std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+  if (!is_inited_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Only an initialized session can be cloned.");
+  }
+
+  // the options that affect the graph, the kernels and the memory planning must be the ones of the shared state
+  SessionOptions clone_options = session_options_;
+  clone_options.session_logid = session_options.session_logid;
+  clone_options.session_log_severity_level = session_options.session_log_severity_level;
+  clone_options.session_log_verbosity_level = session_options.session_log_verbosity_level;
+  clone_options.enable_profiling = session_options.enable_profiling;
+  clone_options.profile_file_prefix = session_options.profile_file_prefix;
+  clone_options.use_per_session_threads = session_options.use_per_session_threads;
+  clone_options.intra_op_param = session_options.intra_op_param;
+  clone_options.inter_op_param = session_options.inter_op_param;
+
+  auto cloned_session = onnxruntime::make_unique<InferenceSession>(clone_options, environment_);
+  cloned_session->model_ = model_;
+  cloned_session->model_location_ = model_location_;
+  cloned_session->model_metadata_ = model_metadata_;
+  cloned_session->model_output_names_ = model_output_names_;
+  cloned_session->required_inputs_ = required_inputs_;
+  cloned_session->input_def_map_ = input_def_map_;
+  cloned_session->output_def_list_ = output_def_list_;
+  cloned_session->session_state_ = session_state_;
+  cloned_session->is_model_loaded_ = true;
+  cloned_session->is_inited_ = true;
+
+  LOGS(*cloned_session->session_logger_, INFO) << "Session cloned from session " << session_id_ << ".";
+  clone = std::move(cloned_session);
+  return Status::OK();
+}
+
 // This method should be called from within Initialize() only and before the creation of the session state.
 // This ensures all providers have been registered in the session and the session state is consistent with the providers.
 void InferenceSession::UpdateProvidersWithSharedAllocators() {
@@ -1319,16 +1723,34 @@ void InferenceSession::UpdateProvidersWithSharedAllocators() {
   }
 }
 
+void InferenceSession::ShrinkArenas() {
+  // an allocator can be shared by multiple providers. shrink it once so the peak usage isn't reset by the first call.
+  std::unordered_set<const IAllocator*> shrunk;
+  for (const auto& xp : GetExecutionProvidersInUse()) {
+    for (const auto& allocator : xp->GetAllocators()) {
+      if (allocator->Info().alloc_type != OrtArenaAllocator || !shrunk.insert(allocator.get()).second) {
+        continue;
+      }
+
+      auto status = static_cast<IArenaAllocator*>(allocator.get())->Shrink();
+      if (!status.IsOK()) {
+        LOGS(*session_logger_, WARNING) << "Failed to shrink the arena for " << allocator->Info().name << ": "
+                                        << status.ErrorMessage();
+      }
+    }
+  }
+}
+
 int InferenceSession::GetCurrentNumRuns() const {
   return current_num_runs_.load();
 }
 
 const std::vector<std::string>& InferenceSession::GetRegisteredProviderTypes() const {
-  return execution_providers_.GetIds();
+  return GetExecutionProvidersInUse().GetIds();
 }
 
 const ProviderOptionsMap& InferenceSession::GetAllProviderOptions() const {
-  return execution_providers_.GetAllProviderOptions();
+  return GetExecutionProvidersInUse().GetAllProviderOptions();
 }
 
 const SessionOptions& InferenceSession::GetSessionOptions() const {
@@ -1391,6 +1813,56 @@ static common::Status CheckTypes(MLDataType actual, MLDataType expected, const s
   return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, ostr.str());
 }
 
+common::Status InferenceSession::ValidateInput(const std::string& feed_name, const InputDefMetaData& input_def,
+                                               const OrtValue& input_ml_value) const {
+  auto expected_type = input_def.ml_data_type;
+  if (input_ml_value.IsTensor()) {
+    // check for type
+    if (!expected_type->IsTensorType()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
+                             " is not expected to be of type tensor.");
+    }
+    auto expected_element_type = expected_type->AsTensorType()->GetElementType();
+    auto input_element_type = input_ml_value.Get<Tensor>().DataType();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type, "tensor"));
+
+    // check for shape
+    const auto& expected_shape = input_def.tensor_shape;
+    if (expected_shape.NumDimensions() > 0) {
+      const auto& input_shape = input_ml_value.Get<Tensor>().Shape();
+      ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(feed_name, input_shape, expected_shape));
+    }
+  } else if (input_ml_value.IsSparseTensor()) {
+    if (!expected_type->IsSparseTensorType()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
+                             " is not expected to be of type sparse tensor.");
+    }
+    auto expected_element_type = expected_type->AsSparseTensorType()->GetElementType();
+    const SparseTensor& sparse_tensor = input_ml_value.Get<SparseTensor>();
+    auto input_element_type = sparse_tensor.Values().DataType();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type, "sparse_tensor"));
+    // Check shape
+    const auto& expected_shape = input_def.tensor_shape;
+    if (expected_shape.NumDimensions() > 0) {
+      const auto& input_shape = sparse_tensor.Shape();
+      ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(feed_name, input_shape, expected_shape));
+    }
+  } else if (input_ml_value.IsTensorSequence()) {
+    if (!expected_type->IsTensorSequenceType()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
+                             " is not expected to be of type tensor sequence.");
+    }
+    auto expected_element_type = expected_type->AsSequenceTensorBase()->GetElementType();
+    auto input_element_type = input_ml_value.Get<TensorSeq>().DataType();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type, "seq"));
+  } else {
+    auto input_type = input_ml_value.Type();
+    ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_type, expected_type, ""));
+  }
+
+  return Status::OK();
+}
+
 common::Status InferenceSession::ValidateInputs(const std::vector<std::string>& feed_names,
                                                 const std::vector<OrtValue>& feeds) const {
   if (feed_names.size() != feeds.size()) {
@@ -1406,73 +1878,49 @@ common::Status InferenceSession::ValidateInputs(const std::vector<std::string>&
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid Feed Input Name:", feed_name);
     }
 
-    auto expected_type = iter->second.ml_data_type;
-    auto& input_ml_value = feeds.at(i);
-    if (input_ml_value.IsTensor()) {
-      // check for type
-      if (!expected_type->IsTensorType()) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
-                               " is not expected to be of type tensor.");
-      }
-      auto expected_element_type = expected_type->AsTensorType()->GetElementType();
-      auto input_element_type = input_ml_value.Get<Tensor>().DataType();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type, "tensor"));
-
-      // check for shape
-      const auto& expected_shape = iter->second.tensor_shape;
-      if (expected_shape.NumDimensions() > 0) {
-        const auto& input_shape = input_ml_value.Get<Tensor>().Shape();
-        ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(feed_name, input_shape, expected_shape));
-      }
-    } else if (input_ml_value.IsSparseTensor()) {
-      if (!expected_type->IsSparseTensorType()) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
-                               " is not expected to be of type sparse tensor.");
-      }
-      auto expected_element_type = expected_type->AsSparseTensorType()->GetElementType();
-      const SparseTensor& sparse_tensor = input_ml_value.Get<SparseTensor>();
-      auto input_element_type = sparse_tensor.Values().DataType();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type, "sparse_tensor"));
-      // Check shape
-      const auto& expected_shape = iter->second.tensor_shape;
-      if (expected_shape.NumDimensions() > 0) {
-        const auto& input_shape = sparse_tensor.Shape();
-        ORT_RETURN_IF_ERROR_SESSIONID_(CheckShapes(feed_name, input_shape, expected_shape));
-      }
-    } else if (input_ml_value.IsTensorSequence()) {
-      if (!expected_type->IsTensorSequenceType()) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input with name: ", feed_name,
-                               " is not expected to be of type tensor sequence.");
-      }
-      auto expected_element_type = expected_type->AsSequenceTensorBase()->GetElementType();
-      auto input_element_type = input_ml_value.Get<TensorSeq>().DataType();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_element_type, expected_element_type, "seq"));
-    } else {
-      auto input_type = input_ml_value.Type();
-      ORT_RETURN_IF_ERROR_SESSIONID_(CheckTypes(input_type, expected_type, ""));
-    }
+    ORT_RETURN_IF_ERROR(ValidateInput(feed_name, iter->second, feeds[i]));
   }
 
   return Status::OK();
 }
 
-common::Status InferenceSession::ValidateOutputs(const std::vector<std::string>& output_names,
-                                                 const std::vector<OrtValue>* p_fetches) const {
+common::Status InferenceSession::ValidateInputs(const RunHandle& run_handle, const std::vector<OrtValue>& feeds) const {
+  const auto& feed_names = run_handle.FeedNames();
+  if (feed_names.size() != feeds.size()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Size mismatch: the run handle has ", feed_names.size(),
+                           " inputs, but feeds has ", feeds.size(), " elements.");
+  }
+
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    ORT_RETURN_IF_ERROR(ValidateInput(feed_names[i], *run_handle.input_defs_[i], feeds[i]));
+  }
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::ValidateFetches(size_t num_outputs, const std::vector<OrtValue>* p_fetches) const {
   if (p_fetches == nullptr) {
     return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Output vector pointer is NULL");
   }
 
-  if (output_names.empty()) {
+  if (num_outputs == 0) {
     return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "At least one output should be requested.");
   }
 
-  if (!p_fetches->empty() && (output_names.size() != p_fetches->size())) {
+  if (!p_fetches->empty() && (num_outputs != p_fetches->size())) {
     std::ostringstream ostr;
-    ostr << "Output vector incorrectly sized: output_names.size(): " << output_names.size()
+    ostr << "Output vector incorrectly sized: output_names.size(): " << num_outputs
          << "p_fetches->size(): " << p_fetches->size();
     return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, ostr.str());
   }
 
+  return common::Status::OK();
+}
+
+common::Status InferenceSession::ValidateOutputs(const std::vector<std::string>& output_names,
+                                                 const std::vector<OrtValue>* p_fetches) const {
+  ORT_RETURN_IF_ERROR(ValidateFetches(output_names.size(), p_fetches));
+
   for (const auto& name : output_names) {
     if (model_output_names_.find(name) == model_output_names_.end()) {
       return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Invalid Output Name:" + name);
@@ -1487,7 +1935,58 @@ common::Status InferenceSession::ValidateOutputs(const std::vector<std::string>&
 Status InferenceSession::Run(const RunOptions& run_options,
                              const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
                              const std::vector<std::string>& output_names, std::vector<OrtValue>* p_fetches,
-                             const std::vector<OrtDevice>* p_fetches_device_info) {
+                             const std::vector<OrtDevice>* p_fetches_device_info,
+                             const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators) {
+  return RunImpl(run_options, nullptr, feed_names, feeds, output_names, p_fetches, p_fetches_device_info,
+                 p_fetch_allocators);
+}
+
+common::Status InferenceSession::CreateRunHandle(const std::vector<std::string>& feed_names,
+                                                 const std::vector<std::string>& output_names,
+                                                 std::unique_ptr<RunHandle>& run_handle) const {
+  if (!is_inited_) {
+    return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+  }
+
+  std::vector<const InputDefMetaData*> input_defs;
+  input_defs.reserve(feed_names.size());
+  for (const auto& feed_name : feed_names) {
+    auto iter = input_def_map_.find(feed_name);
+    if (input_def_map_.end() == iter) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid Feed Input Name:", feed_name);
+    }
+    input_defs.push_back(&iter->second);
+  }
+
+  const std::vector<OrtValue> no_fetches;
+  ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, &no_fetches));
+
+  FeedsFetchesInfo info;
+  info.feed_names = feed_names;
+  info.output_names = output_names;
+  ORT_RETURN_IF_ERROR_SESSIONID_(info.SetMLValueIdxs(session_state_->GetOrtValueNameIdxMap()));
+
+  run_handle.reset(new RunHandle(*this, std::move(info), std::move(input_defs)));
+  ORT_RETURN_IF_ERROR_SESSIONID_(utils::InitializeFeedFetchCopyInfo(*session_state_,
+                                                                    run_handle->feeds_fetches_manager_));
+  return Status::OK();
+}
+
+Status InferenceSession::Run(const RunOptions& run_options, const RunHandle& run_handle,
+                             const std::vector<OrtValue>& feeds, std::vector<OrtValue>* p_fetches) {
+  if (run_handle.session_ != this) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The run handle was created by another session.");
+  }
+
+  return RunImpl(run_options, &run_handle, run_handle.FeedNames(), feeds, run_handle.OutputNames(), p_fetches,
+                 nullptr, nullptr);
+}
+
+Status InferenceSession::RunImpl(const RunOptions& run_options, const RunHandle* run_handle,
+                                 const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                                 const std::vector<std::string>& output_names, std::vector<OrtValue>* p_fetches,
+                                 const std::vector<OrtDevice>* p_fetches_device_info,
+                                 const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators) {
   TimePoint tp;
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.StartTime();
@@ -1501,8 +2000,14 @@ Status InferenceSession::Run(const RunOptions& run_options,
   Status retval = Status::OK();
   const Env& env = Env::Default();
 
+  // collected separately from the run options so concurrent runs sharing them don't mix their times
+  const auto run_begin_time = std::chrono::steady_clock::now();
+  RunLatencyBreakdown latency_breakdown;
+  RunLatencyBreakdown* p_latency_breakdown = run_options.latency_breakdown ? &latency_breakdown : nullptr;
+
+  const ExecutionProviders& execution_providers = GetExecutionProvidersInUse();
   std::vector<IExecutionProvider*> exec_providers_to_stop;
-  exec_providers_to_stop.reserve(execution_providers_.NumProviders());
+  exec_providers_to_stop.reserve(execution_providers.NumProviders());
 
   ORT_TRY {
     if (!is_inited_) {
@@ -1513,16 +2018,27 @@ Status InferenceSession::Run(const RunOptions& run_options,
     // log evaluation start to trace logging provider
     env.GetTelemetryProvider().LogEvaluationStart();
 
-    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
-    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+    // the names of a run handle were validated and mapped to their values when it was created
+    std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager;
+    if (run_handle) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(*run_handle, feeds));
+      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateFetches(output_names.size(), p_fetches));
+    } else {
+      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
+      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
 
-    FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
-    FeedsFetchesManager feeds_fetches_manager{std::move(info)};
+      FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
+      feeds_fetches_manager = onnxruntime::make_unique<FeedsFetchesManager>(std::move(info));
+    }
 
-    if (p_fetches_device_info) {
+    if (p_latency_breakdown) {
+      latency_breakdown.validation_ns = RunLatencyBreakdown::ElapsedNs(run_begin_time);
+    }
+
+    if (p_fetches_device_info && feeds_fetches_manager) {
       // populate the target device info. ignored if pre-allocated fetches are provided
       const auto& fetch_device_info = *p_fetches_device_info;
-      auto& fetch_info = feeds_fetches_manager.GetMutableFetchesDeviceCopyInfo();
+      auto& fetch_info = feeds_fetches_manager->GetMutableFetchesDeviceCopyInfo();
 
       for (size_t i = 0, end = output_names.size(); i < end; ++i) {
         fetch_info[i].target_device = fetch_device_info[i];
@@ -1533,6 +2049,22 @@ Status InferenceSession::Run(const RunOptions& run_options,
       LOGS(*session_logger_, INFO) << "Running with tag: " << run_options.run_tag;
     }
 
+    std::chrono::steady_clock::time_point deadline;
+    const std::chrono::steady_clock::time_point* p_deadline = nullptr;
+    if (run_options.timeout_ms > 0) {
+      deadline = run_begin_time + std::chrono::milliseconds(run_options.timeout_ms);
+      p_deadline = &deadline;
+
+      // under load, reject the runs that would miss their deadline instead of slowing down all the runs.
+      // a run on an idle session is not rejected so the average keeps up when the load drops.
+      const int64_t average_run_duration_ns = average_run_duration_ns_.load();
+      if (current_num_runs_.load() > 0 && average_run_duration_ns > run_options.timeout_ms * 1000000) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Rejected the run as the runs of the session take ",
+                               average_run_duration_ns / 1000000, " ms on average, more than its timeout of ",
+                               run_options.timeout_ms, " ms.");
+      }
+    }
+
     ++current_num_runs_;
 
     // scope of owned_run_logger is just the call to Execute.
@@ -1542,7 +2074,7 @@ Status InferenceSession::Run(const RunOptions& run_options,
 
     // info all execution providers InferenceSession:Run started
     // TODO: only call OnRunStart for all providers in-use
-    for (auto& xp : execution_providers_) {
+    for (auto& xp : execution_providers) {
       // call OnRunStart and add to exec_providers_to_stop if successful
       auto start_func = [&xp, &exec_providers_to_stop]() {
         auto status = xp->OnRunStart();
@@ -1557,14 +2089,32 @@ Status InferenceSession::Run(const RunOptions& run_options,
 
 #if !defined(ORT_MINIMAL_BUILD)
     if (run_options.only_execute_path_to_fetches) {
-      session_state_->UpdateToBeExecutedNodes(feeds_fetches_manager.GetFeedsFetchesInfo().fetches_mlvalue_idxs);
+      const FeedsFetchesInfo& feeds_fetches_info = run_handle
+                                                       ? run_handle->feeds_fetches_manager_.GetFeedsFetchesInfo()
+                                                       : feeds_fetches_manager->GetFeedsFetchesInfo();
+      session_state_->UpdateToBeExecutedNodes(feeds_fetches_info.fetches_mlvalue_idxs);
     }
 #endif
 
-    // execute the graph
-    ORT_CHECK_AND_SET_RETVAL(utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds, *p_fetches,
-                                                 session_options_.execution_mode, run_options.terminate, run_logger,
-                                                 run_options.only_execute_path_to_fetches));
+    // limit the intra-op threads used by this run
+    concurrency::ThreadPool::RunScope run_scope(GetIntraOpThreadPoolToUse(), run_options.intra_op_num_threads,
+                                                partition_concurrent_runs_);
+
+    // execute the graph on the thread pools of this session, which differ from the ones of the state when cloned
+    const std::unordered_map<size_t, IExecutor::CustomAllocator> no_fetch_allocators;
+    const ExecutionThreadPools thread_pools{GetIntraOpThreadPoolToUse(), GetInterOpThreadPoolToUse()};
+    if (run_handle) {
+      ORT_CHECK_AND_SET_RETVAL(utils::ExecuteGraphWithStaticCopyInfo(
+          *session_state_, run_handle->feeds_fetches_manager_, feeds, *p_fetches, no_fetch_allocators,
+          session_options_.execution_mode, run_options.terminate, run_logger,
+          run_options.only_execute_path_to_fetches, p_latency_breakdown, &thread_pools, p_deadline));
+    } else {
+      ORT_CHECK_AND_SET_RETVAL(utils::ExecuteGraph(*session_state_, *feeds_fetches_manager, feeds, *p_fetches,
+                                                   p_fetch_allocators ? *p_fetch_allocators : no_fetch_allocators,
+                                                   session_options_.execution_mode, run_options.terminate, run_logger,
+                                                   run_options.only_execute_path_to_fetches, p_latency_breakdown,
+                                                   &thread_pools, p_deadline));
+    }
   }
   ORT_CATCH(const std::exception& e) {
     ORT_HANDLE_EXCEPTION([&]() {
@@ -1583,6 +2133,23 @@ Status InferenceSession::Run(const RunOptions& run_options,
 
   --current_num_runs_;
 
+  // moving average of the duration of the completed runs. an update lost to a concurrent run only delays it a little.
+  if (retval.IsOK()) {
+    const int64_t run_duration_ns = RunLatencyBreakdown::ElapsedNs(run_begin_time);
+    const int64_t average_run_duration_ns = average_run_duration_ns_.load();
+    average_run_duration_ns_.store(average_run_duration_ns == 0
+                                       ? run_duration_ns
+                                       : average_run_duration_ns + (run_duration_ns - average_run_duration_ns) / 8);
+  }
+
+  // the first run is the warmup run the arenas are consolidated after
+  if (arena_shrink_interval_runs_ != 0) {
+    const uint64_t num_completed_runs = ++num_completed_runs_;
+    if (num_completed_runs == 1 || num_completed_runs % arena_shrink_interval_runs_ == 0) {
+      ShrinkArenas();
+    }
+  }
+
   // keep track of telemetry
   ++telemetry_.total_runs_since_last_;
   telemetry_.total_run_duration_since_last_ += TimeDiffMicroSeconds(tp);
@@ -1601,6 +2168,11 @@ Status InferenceSession::Run(const RunOptions& run_options,
   // log evaluation stop to trace logging provider
   env.GetTelemetryProvider().LogEvaluationStop();
 
+  if (p_latency_breakdown) {
+    latency_breakdown.total_ns = RunLatencyBreakdown::ElapsedNs(run_begin_time);
+    run_options.latency_breakdown->Set(std::move(latency_breakdown));
+  }
+
   // send out profiling events (optional)
   if (session_profiler_.IsEnabled()) {
     session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "model_run", tp);
@@ -1611,6 +2183,244 @@ Status InferenceSession::Run(const RunOptions& run_options,
   return retval;
 }
 
+common::Status InferenceSession::RunBatch(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                                          const std::vector<std::vector<OrtValue>>& feeds,
+                                          const std::vector<std::string>& output_names,
+                                          std::vector<std::vector<OrtValue>>* p_fetches) {
+  TimePoint tp;
+  if (session_profiler_.IsEnabled()) {
+    tp = session_profiler_.StartTime();
+  }
+
+  Status retval = Status::OK();
+  const Env& env = Env::Default();
+
+  const ExecutionProviders& execution_providers = GetExecutionProvidersInUse();
+  std::vector<IExecutionProvider*> exec_providers_to_stop;
+  exec_providers_to_stop.reserve(execution_providers.NumProviders());
+
+  ORT_TRY {
+    if (!is_inited_) {
+      LOGS(*session_logger_, ERROR) << "Session was not initialized";
+      return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+    }
+
+    if (p_fetches == nullptr) {
+      return common::Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "Output vector pointer is NULL");
+    }
+
+    const size_t num_requests = feeds.size();
+    if (p_fetches->empty()) {
+      p_fetches->resize(num_requests);
+    } else if (p_fetches->size() != num_requests) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Batch has ", num_requests, " feeds but ",
+                             p_fetches->size(), " fetches.");
+    }
+
+    for (size_t i = 0; i < num_requests; ++i) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds[i]));
+      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, &(*p_fetches)[i]));
+    }
+
+    // the name lookups are done once. each request gets its own copy as executing it updates the copy info.
+    const FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
+
+    if (!run_options.run_tag.empty()) {
+      LOGS(*session_logger_, INFO) << "Running batch of " << num_requests << " with tag: " << run_options.run_tag;
+    }
+
+    // the requests of the batch share the deadline
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(run_options.timeout_ms);
+    const auto* p_deadline = run_options.timeout_ms > 0 ? &deadline : nullptr;
+
+    ++current_num_runs_;
+
+    std::unique_ptr<logging::Logger> owned_run_logger;
+    auto run_logger = CreateLoggerForRun(run_options, owned_run_logger);
+
+    for (auto& xp : execution_providers) {
+      auto start_func = [&xp, &exec_providers_to_stop]() {
+        auto status = xp->OnRunStart();
+        if (status.IsOK())
+          exec_providers_to_stop.push_back(xp.get());
+
+        return status;
+      };
+
+      ORT_CHECK_AND_SET_RETVAL(start_func());
+    }
+
+#if !defined(ORT_MINIMAL_BUILD)
+    if (run_options.only_execute_path_to_fetches) {
+      session_state_->UpdateToBeExecutedNodes(info.fetches_mlvalue_idxs);
+    }
+#endif
+
+    auto* intra_op_tp = GetIntraOpThreadPoolToUse();
+    const ExecutionThreadPools thread_pools{intra_op_tp, GetInterOpThreadPoolToUse()};
+    std::vector<Status> statuses(num_requests);
+    auto run_request = [&](size_t i) {
+      ORT_TRY {
+        concurrency::ThreadPool::RunScope run_scope(intra_op_tp, run_options.intra_op_num_threads,
+                                                    partition_concurrent_runs_);
+        FeedsFetchesManager feeds_fetches_manager{FeedsFetchesInfo(info)};
+        statuses[i] = utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds[i], (*p_fetches)[i], {},
+                                          session_options_.execution_mode, run_options.terminate, run_logger,
+                                          run_options.only_execute_path_to_fetches, nullptr, &thread_pools,
+                                          p_deadline);
+      }
+      ORT_CATCH(const std::exception& e) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, e.what());
+        });
+      }
+    };
+
+    if (retval.IsOK() && num_requests > 0) {
+      // the requests after the first are scheduled on the intra-op pool and the first runs on the calling thread.
+      // they are not run in a parallel loop as the kernels of each request may run parallel loops of their own.
+      size_t num_scheduled = 0;
+      OrtMutex mutex;
+      OrtCondVar cv;
+      if (concurrency::ThreadPool::DegreeOfParallelism(intra_op_tp) > 1) {
+        for (size_t i = 1; i < num_requests; ++i) {
+          {
+            std::lock_guard<OrtMutex> lock(mutex);
+            ++num_scheduled;
+          }
+          concurrency::ThreadPool::Schedule(intra_op_tp, [&run_request, &mutex, &cv, &num_scheduled, i]() {
+            run_request(i);
+            std::lock_guard<OrtMutex> lock(mutex);
+            --num_scheduled;
+            cv.notify_all();
+          });
+        }
+
+        run_request(0);
+      } else {
+        for (size_t i = 0; i < num_requests; ++i) {
+          run_request(i);
+        }
+      }
+
+      std::unique_lock<OrtMutex> lock(mutex);
+      cv.wait(lock, [&num_scheduled]() { return num_scheduled == 0; });
+    }
+
+    for (const auto& status : statuses) {
+      ORT_CHECK_AND_SET_RETVAL(status);
+    }
+  }
+  ORT_CATCH(const std::exception& e) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      retval = Status(common::ONNXRUNTIME, common::FAIL, e.what());
+    });
+  }
+  ORT_CATCH(...) {
+    retval = Status(common::ONNXRUNTIME, common::RUNTIME_EXCEPTION, "Encountered unknown exception in RunBatch()");
+  }
+
+  for (auto* xp : exec_providers_to_stop) {
+    auto status = xp->OnRunEnd();
+    ORT_CHECK_AND_SET_RETVAL(status);
+  }
+
+  --current_num_runs_;
+
+  ++telemetry_.total_runs_since_last_;
+  telemetry_.total_run_duration_since_last_ += TimeDiffMicroSeconds(tp);
+
+  env.GetTelemetryProvider().LogEvaluationStop();
+
+  if (session_profiler_.IsEnabled()) {
+    session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, "model_run_batch", tp);
+  }
+
+  return retval;
+}
+
+common::Status InferenceSession::RunAsync(const RunOptions& run_options, std::vector<std::string> feed_names,
+                                          std::vector<OrtValue> feeds, std::vector<std::string> output_names,
+                                          std::vector<OrtValue> fetches, RunAsyncCallback callback) {
+  ORT_RETURN_IF_NOT(callback, "RunAsync requires a callback.");
+
+  // The run is scheduled on the intra-op pool rather than the inter-op pool. With the parallel executor the
+  // inter-op pool runs the nodes, and a run blocking one of its threads while waiting on them could deadlock.
+  auto* tp = GetIntraOpThreadPoolToUse();
+  if (concurrency::ThreadPool::DegreeOfParallelism(tp) < 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "RunAsync requires an intra-op thread pool with at least 2 threads.");
+  }
+
+  {
+    std::lock_guard<OrtMutex> lock(async_runs_mutex_);
+    ++num_pending_async_runs_;
+  }
+
+  // std::function requires a copyable callable so the state is held by a shared_ptr
+  struct AsyncRun {
+    std::vector<std::string> feed_names;
+    std::vector<OrtValue> feeds;
+    std::vector<std::string> output_names;
+    std::vector<OrtValue> fetches;
+    RunAsyncCallback callback;
+  };
+
+  auto async_run = std::make_shared<AsyncRun>();
+  async_run->feed_names = std::move(feed_names);
+  async_run->feeds = std::move(feeds);
+  async_run->output_names = std::move(output_names);
+  async_run->fetches = std::move(fetches);
+  async_run->callback = std::move(callback);
+
+  const auto schedule_time = std::chrono::steady_clock::now();
+  concurrency::ThreadPool::Schedule(tp, [this, &run_options, async_run, schedule_time]() {
+    Status status;
+    const int64_t queue_ns = RunLatencyBreakdown::ElapsedNs(schedule_time);
+    ORT_TRY {
+      // a run that waited past its timeout for a thread is not run
+      if (run_options.timeout_ms > 0 && queue_ns > run_options.timeout_ms * 1000000) {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Rejected the run as it waited ", queue_ns / 1000000,
+                                 " ms to be run, more than its timeout of ", run_options.timeout_ms, " ms.");
+      } else {
+        status = Run(run_options, async_run->feed_names, async_run->feeds, async_run->output_names,
+                     &async_run->fetches);
+      }
+    }
+    ORT_CATCH(const std::exception& e) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, e.what());
+      });
+    }
+
+    // Run stored the breakdown. add the time the run waited for a thread before the callback can query it.
+    RunLatencyBreakdown latency_breakdown;
+    if (run_options.latency_breakdown && run_options.latency_breakdown->Get(latency_breakdown)) {
+      latency_breakdown.queue_ns = queue_ns;
+      run_options.latency_breakdown->Set(std::move(latency_breakdown));
+    }
+
+    ORT_TRY {
+      async_run->callback(status, async_run->fetches);
+    }
+    ORT_CATCH(const std::exception& e) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        LOGS(*session_logger_, ERROR) << "Exception in RunAsync callback: " << e.what();
+      });
+    }
+
+    // release the inputs and outputs before the session can be destroyed
+    async_run->feeds.clear();
+    async_run->fetches.clear();
+
+    std::lock_guard<OrtMutex> lock(async_runs_mutex_);
+    --num_pending_async_runs_;
+    async_runs_cv_.notify_all();
+  });
+
+  return Status::OK();
+}
+
 common::Status InferenceSession::Run(const NameMLValMap& feeds, const std::vector<std::string>& output_names,
                                      std::vector<OrtValue>* p_fetches) {
   return Run(RunOptions(), feeds, output_names, p_fetches);
@@ -1700,8 +2510,44 @@ common::Status InferenceSession::NewIOBinding(std::unique_ptr<IOBinding>* io_bin
 common::Status InferenceSession::Run(const RunOptions& run_options, IOBinding& io_binding) {
   // TODO should Run() call io_binding.SynchronizeInputs() or should it let the callers do it?
   // io_binding.SynchronizeInputs();
-  return Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
-             &io_binding.GetOutputs(), &io_binding.GetOutputsDeviceInfo());
+  std::vector<OrtValue>& outputs = io_binding.GetOutputs();
+  const auto& outputs_reuse_buffer = io_binding.GetOutputsReuseBuffer();
+
+  // outputs bound with reuse_buffer hold the buffer allocated by the previous Run. they are not passed in as
+  // pre-allocated fetches as the shape of the output may change. instead the execution frame is offered the
+  // previous buffer when it allocates the output, and uses it if the shape and device still match.
+  std::vector<OrtValue> previous_outputs(outputs.size());
+  std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+  for (size_t i = 0, end = outputs.size(); i < end; ++i) {
+    if (!outputs_reuse_buffer[i] || !outputs[i].IsTensor()) {
+      continue;
+    }
+
+    previous_outputs[i] = std::move(outputs[i]);
+    outputs[i] = OrtValue();
+    fetch_allocators[i] = [i, &previous_outputs](const TensorShape& shape, const OrtMemoryInfo& location,
+                                                 OrtValue& ort_value, bool& allocated) {
+      const Tensor& previous = previous_outputs[i].Get<Tensor>();
+      if (previous.Shape() == shape && previous.Location().device == location.device) {
+        ort_value = previous_outputs[i];
+        allocated = true;
+      }
+
+      return Status::OK();
+    };
+  }
+
+  auto status = Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(), io_binding.GetOutputNames(),
+                    &outputs, &io_binding.GetOutputsDeviceInfo(), &fetch_allocators);
+
+  // keep the previous buffers of outputs the Run did not produce so they can still be reused
+  for (size_t i = 0, end = outputs.size(); i < end; ++i) {
+    if (previous_outputs[i].IsAllocated() && !outputs[i].IsAllocated()) {
+      outputs[i] = std::move(previous_outputs[i]);
+    }
+  }
+
+  return status;
 }
 
 common::Status InferenceSession::Run(IOBinding& io_binding) {
@@ -1730,9 +2576,90 @@ void InferenceSession::StartProfiling(const logging::Logger* logger_ptr) {
   session_profiler_.StartProfiling(logger_ptr);
 }
 
+// The means over the loops of a call site of the ParallelForStats, in microseconds.
+struct ParallelForSummary {
+  explicit ParallelForSummary(const concurrency::ParallelForStats& stats) {
+    const double calls = static_cast<double>(std::max<uint64_t>(stats.calls, 1));
+    const double helpers = static_cast<double>(std::max<uint64_t>(stats.workers - std::min(stats.workers, stats.calls), 1));
+    mean_wall_us = stats.wall_ns / calls / 1000;
+    mean_busy_us = stats.busy_ns / static_cast<double>(std::max<uint64_t>(stats.workers, 1)) / 1000;
+    mean_tail_us = stats.tail_ns / calls / 1000;
+    max_tail_us = stats.max_tail_ns / 1000.0;
+    // only the helping threads wake up, the calling thread of each loop starts it
+    mean_wakeup_us = stats.wakeup_ns / helpers / 1000;
+    max_wakeup_us = stats.max_wakeup_ns / 1000.0;
+    mean_imbalance = stats.imbalance / calls;
+  }
+
+  double mean_wall_us;
+  double mean_busy_us;
+  double mean_tail_us;
+  double max_tail_us;
+  double mean_wakeup_us;
+  double max_wakeup_us;
+  double mean_imbalance;
+};
+
+// Writes the counters of a thread pool and the statistics of its parallel loops per call site as a JSON object.
+static void WriteThreadPoolStats(std::ostream& os, concurrency::ThreadPool& tp, bool reset) {
+  uint64_t spin_hits = 0;
+  uint64_t spin_misses = 0;
+  tp.GetSpinCounters(spin_hits, spin_misses);
+  os << "{\"steals\" : " << tp.GetStealCount() << ", \"spin_hits\" : " << spin_hits
+     << ", \"spin_misses\" : " << spin_misses << ", \"call_sites\" : [";
+  bool is_first = true;
+  for (const auto& entry : tp.GetParallelForStats(reset)) {
+    const auto& stats = entry.second;
+    const ParallelForSummary summary(stats);
+    os << (is_first ? "" : ", ") << "{\"call_site\" : \"" << entry.first << "\", \"calls\" : " << stats.calls
+       << ", \"shards\" : " << stats.shards << ", \"workers\" : " << stats.workers
+       << ", \"shard_steals\" : " << stats.shard_steals << ", \"mean_wall_us\" : " << summary.mean_wall_us
+       << ", \"mean_busy_us\" : " << summary.mean_busy_us << ", \"mean_imbalance\" : " << summary.mean_imbalance
+       << ", \"mean_tail_us\" : " << summary.mean_tail_us << ", \"max_tail_us\" : " << summary.max_tail_us
+       << ", \"mean_wakeup_us\" : " << summary.mean_wakeup_us << ", \"max_wakeup_us\" : " << summary.max_wakeup_us
+       << "}";
+    is_first = false;
+  }
+  os << "]}";
+}
+
+// Records an event per call site with the statistics of the parallel loops of a thread pool.
+static void RecordThreadPoolStats(profiling::Profiler& profiler, const std::string& pool_name,
+                                  concurrency::ThreadPool& tp) {
+  const TimePoint now = profiler.StartTime();
+  for (const auto& entry : tp.GetParallelForStats(false)) {
+    const auto& stats = entry.second;
+    const ParallelForSummary summary(stats);
+    profiler.EndTimeAndRecordEvent(profiling::SESSION_EVENT,
+                                   pool_name + "_thread_pool_parallel_for",
+                                   now,
+                                   {{"call_site", entry.first},
+                                    {"calls", std::to_string(stats.calls)},
+                                    {"shards", std::to_string(stats.shards)},
+                                    {"workers", std::to_string(stats.workers)},
+                                    {"shard_steals", std::to_string(stats.shard_steals)},
+                                    {"mean_wall_us", std::to_string(summary.mean_wall_us)},
+                                    {"mean_busy_us", std::to_string(summary.mean_busy_us)},
+                                    {"mean_imbalance", std::to_string(summary.mean_imbalance)},
+                                    {"mean_tail_us", std::to_string(summary.mean_tail_us)},
+                                    {"max_tail_us", std::to_string(summary.max_tail_us)},
+                                    {"mean_wakeup_us", std::to_string(summary.mean_wakeup_us)},
+                                    {"max_wakeup_us", std::to_string(summary.max_wakeup_us)},
+                                    {"steals", std::to_string(tp.GetStealCount())}});
+  }
+}
+
 std::string InferenceSession::EndProfiling() {
   if (is_model_loaded_) {
     if (session_profiler_.IsEnabled()) {
+      if (thread_pool_stats_enabled_) {
+        if (auto* tp = GetIntraOpThreadPoolToUse()) {
+          RecordThreadPoolStats(session_profiler_, "intra_op", *tp);
+        }
+        if (auto* tp = GetInterOpThreadPoolToUse()) {
+          RecordThreadPoolStats(session_profiler_, "inter_op", *tp);
+        }
+      }
       return session_profiler_.EndProfiling();
     } else {
       LOGS(*session_logger_, VERBOSE) << "Profiler is disabled.";
@@ -1743,6 +2670,72 @@ std::string InferenceSession::EndProfiling() {
   return std::string();
 }
 
+common::Status InferenceSession::GetLatencyStats(std::string& stats_json, bool reset) const {
+  if (!is_inited_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Session not initialized.");
+  }
+
+  NodeLatencyStats* stats = session_state_->GetNodeLatencyStats();
+  if (stats == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Latency sampling is disabled. Set the ",
+                           kOrtSessionOptionsConfigProfilingSampleIntervalRuns, " session config key to enable it.");
+  }
+
+  stats_json = stats->ToJson();
+  if (reset) {
+    stats->Reset();
+  }
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::GetThreadPoolStats(std::string& stats_json, bool reset) const {
+  if (!is_inited_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Session not initialized.");
+  }
+
+  if (!thread_pool_stats_enabled_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Thread pool statistics are disabled. Set the ",
+                           kOrtSessionOptionsConfigProfilingThreadPoolStats, " session config key to enable them.");
+  }
+
+  std::ostringstream os;
+  os << "{";
+  bool is_first = true;
+  for (const auto& pool : {std::make_pair("intra_op", GetIntraOpThreadPoolToUse()),
+                           std::make_pair("inter_op", GetInterOpThreadPoolToUse())}) {
+    if (pool.second == nullptr) {
+      continue;
+    }
+    os << (is_first ? "" : ", ") << "\"" << pool.first << "\" : ";
+    WriteThreadPoolStats(os, *pool.second, reset);
+    is_first = false;
+  }
+  os << "}";
+  stats_json = os.str();
+
+  return Status::OK();
+}
+
+common::Status InferenceSession::GetCalibrationStats(std::string& stats_json, bool reset) const {
+  if (!is_inited_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Session not initialized.");
+  }
+
+  TensorCalibrationStats* stats = session_state_->GetTensorCalibrationStats();
+  if (stats == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Calibration statistics are disabled. Set the ",
+                           kOrtSessionOptionsConfigCalibrationTensorNames, " session config key to enable them.");
+  }
+
+  stats_json = stats->ToJson();
+  if (reset) {
+    stats->Reset();
+  }
+
+  return Status::OK();
+}
+
 const profiling::Profiler& InferenceSession::GetProfiling() const {
   return session_profiler_;
 }
@@ -1887,12 +2880,26 @@ void InferenceSession::InitLogger(logging::LoggingManager* logging_manager) {
 void InferenceSession::AddPredefinedTransformers(GraphTransformerManager& transformer_manager,
                                                  TransformerLevel graph_optimization_level,
                                                  const std::vector<std::string>& custom_list) {
+  const std::string max_output_bytes =
+      session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigConstantFoldingMaxOutputBytes, "0");
+  size_t constant_folding_max_output_bytes = 0;
+  if (!TryParseStringWithClassicLocale(max_output_bytes, constant_folding_max_output_bytes)) {
+    LOGS(*session_logger_, WARNING) << "Ignoring the invalid constant folding output size limit: " << max_output_bytes;
+    constant_folding_max_output_bytes = 0;
+  }
+
+  // DequantizeLinear nodes are kept for QDQFusion only if it will run, i.e. at level 2 or if it is in the custom list
+  const bool enable_qdq_fusion =
+      session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigDisableQuantQDQ, "0") != "1" &&
+      (graph_optimization_level >= TransformerLevel::Level2 ||
+       std::find(custom_list.begin(), custom_list.end(), "QDQFusion") != custom_list.end());
+
   auto add_transformers = [&](TransformerLevel level) {
     // Generate and register transformers for level
     auto transformers_to_register =
         optimizer_utils::GenerateTransformers(level, session_options_.free_dimension_overrides,
                                               *execution_providers_.Get(onnxruntime::kCpuExecutionProvider),
-                                              custom_list);
+                                              custom_list, constant_folding_max_output_bytes, enable_qdq_fusion);
     for (auto& entry : transformers_to_register) {
       transformer_manager.Register(std::move(entry), level);
     }
@@ -1908,6 +2915,35 @@ void InferenceSession::AddPredefinedTransformers(GraphTransformerManager& transf
       add_transformers(level);
     }
   }
+
+#ifndef DISABLE_CONTRIB_OPS
+  // the elementwise chain fusion runs after the other level 2 fusions so it only sees the remaining elementwise nodes
+  const std::unordered_set<std::string> chain_fusion_execution_providers = {kCpuExecutionProvider,
+                                                                            kCudaExecutionProvider};
+  const std::string profile_trace_file =
+      session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigProfileGuidedFusionTraceFile, "");
+  if (!profile_trace_file.empty() && graph_optimization_level >= TransformerLevel::Level2) {
+    std::unordered_map<std::string, int64_t> node_kernel_times;
+    auto status = inference_session_utils::ParseNodeKernelTimesFromProfile(ToPathString(profile_trace_file),
+                                                                           node_kernel_times);
+    if (status.IsOK()) {
+      const std::string min_time_percent =
+          session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigProfileGuidedFusionMinTimePercent, "1");
+      transformer_manager.Register(
+          onnxruntime::make_unique<ElementwiseChainFusion>(std::move(node_kernel_times),
+                                                           std::strtod(min_time_percent.c_str(), nullptr),
+                                                           chain_fusion_execution_providers),
+          TransformerLevel::Level2);
+    } else {
+      LOGS(*session_logger_, WARNING) << "The profile guided fusion is disabled: " << status.ErrorMessage();
+    }
+  } else if (session_options_.GetConfigOrDefault(kOrtSessionOptionsConfigEnableElementwiseChainFusion, "0") == "1" &&
+             graph_optimization_level >= TransformerLevel::Level2) {
+    transformer_manager.Register(
+        onnxruntime::make_unique<ElementwiseChainFusion>(chain_fusion_execution_providers),
+        TransformerLevel::Level2);
+  }
+#endif
 }
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
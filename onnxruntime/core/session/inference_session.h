@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 #include <unordered_map>
 
@@ -11,6 +12,7 @@
 #include "core/common/profiler.h"
 #include "core/common/status.h"
 #include "core/framework/execution_providers.h"
+#include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/iexecutor.h"
 #include "core/framework/kernel_registry_manager.h"
@@ -19,6 +21,7 @@
 #include "core/optimizer/graph_transformer_level.h"
 #include "core/optimizer/graph_transformer_mgr.h"
 #include "core/optimizer/insert_cast_transformer.h"
+#include "core/platform/env.h"
 #include "core/framework/session_options.h"
 #include "core/framework/allocatormgr.h"
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
@@ -257,10 +260,25 @@ class InferenceSession {
     */
   common::Status Initialize() ORT_MUST_USE_RESULT;
 
+  /**
+    * Create a session sharing the model, the kernels and the initializers of this initialized session.
+    * The clone owns its thread pools, logger and profiler, so it can run the model with different threading options
+    * without loading it again. It uses the options of this session, except for the logging, profiling and
+    * thread pool options which it takes from session_options.
+    * The kernel events of the runs of the clone are recorded by the profiler of this session.
+    * This session must outlive the clone.
+    * This API is thread-safe.
+    * @return OK if success
+    */
+  common::Status Clone(const SessionOptions& session_options,
+                       std::unique_ptr<InferenceSession>& clone) const ORT_MUST_USE_RESULT;
+
   common::Status Run(const RunOptions& run_options, const std::vector<std::string>& feed_names,
                      const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
                      std::vector<OrtValue>* p_fetches,
-                     const std::vector<OrtDevice>* p_fetches_device_info = nullptr) ORT_MUST_USE_RESULT;
+                     const std::vector<OrtDevice>* p_fetches_device_info = nullptr,
+                     const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators = nullptr)
+      ORT_MUST_USE_RESULT;
 
   /**
     * Run a pre-loaded and pre-intialized model.
@@ -284,6 +302,36 @@ class InferenceSession {
                      const std::vector<std::string>& output_names,
                      std::vector<OrtValue>* p_fetches) ORT_MUST_USE_RESULT;
 
+  /**
+    * Run a pre-loaded and pre-intialized model for a batch of independent requests in one call.
+    * The requests share the validation of the names, the run logger and the start and end of the run in the
+    * execution providers, and are executed concurrently on the session's intra-op thread pool if it has threads.
+    * The inputs of the requests are not concatenated so their shapes may differ.
+    * @param feeds the inputs of each request, in the order of feed_names.
+    * @param p_fetches the outputs of each request, in the order of output_names. If empty it is resized to the
+    *        number of requests. Empty entries are allocated by the run.
+    * @return OK if all the requests succeeded, otherwise the status of the first request that failed.
+    */
+  common::Status RunBatch(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                          const std::vector<std::vector<OrtValue>>& feeds,
+                          const std::vector<std::string>& output_names,
+                          std::vector<std::vector<OrtValue>>* p_fetches) ORT_MUST_USE_RESULT;
+
+  using RunAsyncCallback = std::function<void(const common::Status& status, std::vector<OrtValue>& fetches)>;
+
+  /**
+    * Run a pre-loaded and pre-intialized model without blocking the calling thread.
+    * The run is scheduled on the session's intra-op thread pool and callback is invoked on the thread that
+    * executed it once the run completes or fails. The callback may run before this method returns.
+    * The session must not be destroyed from within the callback. The destructor waits for pending runs.
+    * @param run_options must remain valid until the callback is invoked. Use RunOptions::terminate to cancel.
+    * @param fetches pre-allocated fetches. Empty entries are allocated by the run.
+    * @return OK if the run was scheduled. callback is only invoked in that case.
+    */
+  common::Status RunAsync(const RunOptions& run_options, std::vector<std::string> feed_names,
+                          std::vector<OrtValue> feeds, std::vector<std::string> output_names,
+                          std::vector<OrtValue> fetches, RunAsyncCallback callback) ORT_MUST_USE_RESULT;
+
   /**
   * Creates a new binding object for binding inputs and outputs.
   * @param provider_type specifies the location where the inputs need to be potentially copied.
@@ -294,6 +342,31 @@ class InferenceSession {
   virtual common::Status Run(const RunOptions& run_options, IOBinding& io_binding) ORT_MUST_USE_RESULT;
   common::Status Run(IOBinding& io_binding) ORT_MUST_USE_RESULT;
 
+  class RunHandle;
+
+  /**
+    * Create a handle of the inputs and outputs of Run calls that pass the input and output values by position.
+    * The names are validated and mapped to their values and the static device copy info is computed once here,
+    * so that a Run with the handle only checks the types and shapes of the inputs.
+    * The handle may be used by concurrent Run calls and must not outlive the session.
+    * @param feed_names the names of the inputs, in the order of the feeds of the runs.
+    * @param output_names the names of the outputs, in the order of the fetches of the runs.
+    * @return OK if success.
+    */
+  common::Status CreateRunHandle(const std::vector<std::string>& feed_names,
+                                 const std::vector<std::string>& output_names,
+                                 std::unique_ptr<RunHandle>& run_handle) const ORT_MUST_USE_RESULT;
+
+  /**
+    * Run a pre-loaded and pre-intialized model with the inputs and outputs of a handle created by CreateRunHandle.
+    * @param feeds the inputs, in the order of the input names of the handle.
+    * @param p_fetches the outputs, in the order of the output names of the handle. If empty it is resized to the
+    *        number of outputs. Empty entries are allocated by the run.
+    * @return OK if success.
+    */
+  common::Status Run(const RunOptions& run_options, const RunHandle& run_handle, const std::vector<OrtValue>& feeds,
+                     std::vector<OrtValue>* p_fetches) ORT_MUST_USE_RESULT;
+
   /**
     * @return pair.first = OK; FAIL otherwise. pair.second is non-NULL when pair.first = OK.
     * @note lifetime of the returned pointer is valid as long as the Session object is live.
@@ -371,6 +444,32 @@ class InferenceSession {
     @return the name of the profile file.
     */
   std::string EndProfiling();
+  /**
+    * Get the kernel latency statistics of the runs sampled with the session.profiling.sample_interval_runs
+    * session config key, as JSON. See NodeLatencyStats::ToJson.
+    * @param reset if true the statistics are cleared after they are read.
+    * @return FAIL if the session is not initialized or sampling is disabled.
+    */
+  common::Status GetLatencyStats(std::string& stats_json, bool reset = false) const ORT_MUST_USE_RESULT;
+
+  /**
+    * Get the calibration statistics of the tensors of the session.calibration.tensor_names session config key
+    * recorded by the runs, as JSON. See TensorCalibrationStats::ToJson.
+    * @param reset if true the statistics are cleared after they are read.
+    * @return FAIL if the session is not initialized or the collection is disabled.
+    */
+  common::Status GetCalibrationStats(std::string& stats_json, bool reset = false) const ORT_MUST_USE_RESULT;
+
+  /**
+    * Get the statistics of the parallel loops run on the thread pools of the session since the session was created
+    * or the last reset, collected with the session.profiling.thread_pool_stats session config key, as JSON.
+    * Each thread pool has its steal and spin counters and an entry per op type, with the number of loops, shards,
+    * threads and shard steals, and the mean and max durations in microseconds.
+    * @param reset if true the loop statistics are cleared after they are read.
+    * @return FAIL if the session is not initialized or the collection is disabled.
+    */
+  common::Status GetThreadPoolStats(std::string& stats_json, bool reset = false) const ORT_MUST_USE_RESULT;
+
   /**
     * Return the profiler to access its attributes
     @return the profiler object
@@ -432,6 +531,11 @@ class InferenceSession {
     return session_options_.use_per_session_threads ? inter_op_thread_pool_.get() : inter_op_thread_pool_from_env_;
   }
 
+  // The execution providers of the kernels. A cloned session runs on the execution providers of its source.
+  const ExecutionProviders& GetExecutionProvidersInUse() const {
+    return session_state_ != nullptr ? session_state_->GetExecutionProviders() : execution_providers_;
+  }
+
   /// convenience pointer to logger. should always be the same as session_state_.Logger();
   const logging::Logger* session_logger_;
 
@@ -496,6 +600,22 @@ class InferenceSession {
 
   common::Status LoadOrtModel(std::function<Status()> load_ort_format_model_bytes) ORT_MUST_USE_RESULT;
 
+  // Create model_ from the ORT format model in ort_format_model_bytes_.
+  common::Status LoadOrtModelFromBytes() ORT_MUST_USE_RESULT;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Get the path of the initialization cache entry for the loaded ONNX model.
+  // Returns an empty path if the initialization cache is not enabled or can't be used by this session.
+  std::basic_string<ORTCHAR_T> GetInitializationCachePath() const;
+
+  // Replace the loaded ONNX model with the cached ORT format model at cache_path.
+  // Returns false and leaves the loaded model unchanged if the entry doesn't exist or isn't valid.
+  bool LoadInitializationCache(const std::basic_string<ORTCHAR_T>& cache_path);
+
+  // Save the optimized model and session state to the initialization cache entry at cache_path.
+  void SaveInitializationCache(const std::basic_string<ORTCHAR_T>& cache_path) const;
+#endif
+
 #endif  // defined(ENABLE_ORT_FORMAT_LOAD)
 
   // Create a Logger for a single execution if possible. Otherwise use the default logger.
@@ -511,12 +631,31 @@ class InferenceSession {
   common::Status CheckShapes(const std::string& input_name, const TensorShape& input_shape,
                              const TensorShape& expected_shape) const ORT_MUST_USE_RESULT;
 
+  struct InputDefMetaData;
+
+  common::Status ValidateInput(const std::string& feed_name, const InputDefMetaData& input_def,
+                               const OrtValue& feed) const ORT_MUST_USE_RESULT;
+
   common::Status ValidateInputs(const std::vector<std::string>& feed_names,
                                 const std::vector<OrtValue>& feeds) const ORT_MUST_USE_RESULT;
 
+  // validates the feeds of the inputs of run_handle, whose names were validated when it was created
+  common::Status ValidateInputs(const RunHandle& run_handle,
+                                const std::vector<OrtValue>& feeds) const ORT_MUST_USE_RESULT;
+
+  common::Status ValidateFetches(size_t num_outputs, const std::vector<OrtValue>* p_fetches) const ORT_MUST_USE_RESULT;
+
   common::Status ValidateOutputs(const std::vector<std::string>& output_names,
                                  const std::vector<OrtValue>* p_fetches) const ORT_MUST_USE_RESULT;
 
+  // Run with the names of the inputs and outputs, or with run_handle if it is not null.
+  common::Status RunImpl(const RunOptions& run_options, const RunHandle* run_handle,
+                         const std::vector<std::string>& feed_names, const std::vector<OrtValue>& feeds,
+                         const std::vector<std::string>& output_names, std::vector<OrtValue>* p_fetches,
+                         const std::vector<OrtDevice>* p_fetches_device_info,
+                         const std::unordered_map<size_t, IExecutor::CustomAllocator>* p_fetch_allocators)
+      ORT_MUST_USE_RESULT;
+
   common::Status WaitForNotification(Notification* p_executor_done, int64_t timeout_in_ms) ORT_MUST_USE_RESULT;
 
   template <typename T>
@@ -525,6 +664,9 @@ class InferenceSession {
   // Updates all providers with the allocators from the env based on OrtMemoryInfo
   void UpdateProvidersWithSharedAllocators();
 
+  // Shrinks the arena allocators of all providers. See kOrtSessionOptionsConfigArenaShrinkIntervalRuns.
+  void ShrinkArenas();
+
 #if !defined(ORT_MINIMAL_BUILD)
   virtual void AddPredefinedTransformers(GraphTransformerManager& transformer_manager,
                                          TransformerLevel graph_optimization_level,
@@ -563,15 +705,25 @@ class InferenceSession {
   // Profiler for this session.
   profiling::Profiler session_profiler_;
 
-  // Immutable state for each op in the model. Shared by all executors.
+  // Immutable state for each op in the model. Shared by all executors, and by the clones of the session.
   // It has a dependency on execution_providers_.
-  std::unique_ptr<SessionState> session_state_;
+  std::shared_ptr<SessionState> session_state_;
 
   // Threadpools per session. These are initialized and used for the entire duration of the session
   // when use_per_session_threads is true.
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> thread_pool_;
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
 
+  // Whether concurrent Run calls use disjoint subsets of the intra-op threads.
+  bool partition_concurrent_runs_ = false;
+
+  // Whether the thread pools collect the statistics of their parallel loops.
+  bool thread_pool_stats_enabled_ = false;
+
+  // Number of runs between shrinking the arenas, or 0 to never shrink them, and the number of completed runs.
+  uint64_t arena_shrink_interval_runs_ = 0;
+  std::atomic<uint64_t> num_completed_runs_{0};
+
   // Global threadpools. These are intialized and used when use_per_session_threads is false *and*
   // the environment is created with create_global_thread_pools = true.
   onnxruntime::concurrency::ThreadPool* intra_op_thread_pool_from_env_{};
@@ -613,6 +765,15 @@ class InferenceSession {
   // Number of concurrently running executors
   std::atomic<int> current_num_runs_;
 
+  // Moving average of the duration of the successful Run calls, used to reject the runs that would miss their
+  // deadline under load. 0 until a run completes.
+  std::atomic<int64_t> average_run_duration_ns_{0};
+
+  // Number of RunAsync calls whose callback has not returned yet
+  int num_pending_async_runs_ = 0;  // GUARDED_BY(async_runs_mutex_)
+  OrtMutex async_runs_mutex_;
+  OrtCondVar async_runs_cv_;
+
   mutable onnxruntime::OrtMutex session_mutex_;  // to ensure only one thread can invoke Load/Initialize
   bool is_model_loaded_ = false;                 // GUARDED_BY(session_mutex_)
   bool is_inited_ = false;                       // GUARDED_BY(session_mutex_)
@@ -653,11 +814,46 @@ class InferenceSession {
   // Short term we free them after Initialize.
   // Longer term we may want to directly refer to offsets in this buffer for initializers so we don't need to copy
   // those into new OrtValue instances, at which point we won't free them until the InferenceSession goes away.
-  std::vector<uint8_t> ort_format_model_bytes_;
+  //
+  // The bytes are owned by either ort_format_model_bytes_data_holder_, or ort_format_model_mapped_memory_ if the
+  // model file was memory mapped (see kOrtSessionOptionsConfigUseMmapForOrtModel).
+  gsl::span<const uint8_t> ort_format_model_bytes_;
+  std::vector<uint8_t> ort_format_model_bytes_data_holder_;
+  Env::MappedMemoryPtr ort_format_model_mapped_memory_;
   
   std::shared_ptr<onnxruntime::AllocatorManager> allocator_manager_;
 };
 
+/**
+ * The inputs and outputs of Run calls created by InferenceSession::CreateRunHandle, with the OrtValue indexes of
+ * their names and the static device copy info shared by the runs.
+ */
+class InferenceSession::RunHandle {
+ public:
+  const std::vector<std::string>& FeedNames() const { return feeds_fetches_manager_.GetFeedsFetchesInfo().feed_names; }
+
+  const std::vector<std::string>& OutputNames() const {
+    return feeds_fetches_manager_.GetFeedsFetchesInfo().output_names;
+  }
+
+ private:
+  friend class InferenceSession;
+
+  RunHandle(const InferenceSession& session, FeedsFetchesInfo&& info,
+            std::vector<const InputDefMetaData*>&& input_defs)
+      : session_(&session), feeds_fetches_manager_(std::move(info)), input_defs_(std::move(input_defs)) {}
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(RunHandle);
+
+  // the session that created the handle, the only one it may run
+  const InferenceSession* const session_;
+
+  FeedsFetchesManager feeds_fetches_manager_;
+
+  // the expected type and shape of each input
+  const std::vector<const InputDefMetaData*> input_defs_;
+};
+
 struct SessionIOBinding {
  public:
   SessionIOBinding(InferenceSession* session);
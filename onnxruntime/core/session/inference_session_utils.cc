@@ -5,6 +5,8 @@
 
 #include "core/session/inference_session_utils.h"
 
+#include <fstream>
+
 namespace onnxruntime {
 
 //---------------------
@@ -45,13 +47,15 @@ static Status SetInterOpNumThreads(SessionOptions& session_options,
 static Status SetExecutionMode(SessionOptions& session_options,
                                int value,
                                const logging::Logger& logger) {
-  if (value != 0 && value != 1) {
+  if (value < 0 || value > 3) {
     LOGS(logger, ERROR) << "Unsupported execution_mode value in ORT config: " << value;
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported execution_mode value in ORT config: ", value);
   }
 
-  LOGS(logger, INFO) << "Setting execution_mode to " << (value == 0 ? "Sequential mode" : "Parallel mode");
-  session_options.execution_mode = (value == 0 ? ExecutionMode::ORT_SEQUENTIAL : ExecutionMode::ORT_PARALLEL);
+  static const char* const mode_names[] = {"Sequential mode", "Parallel mode", "Parallel work stealing mode",
+                                           "Parallel heterogeneous mode"};
+  LOGS(logger, INFO) << "Setting execution_mode to " << mode_names[value];
+  session_options.execution_mode = static_cast<ExecutionMode>(value);
   return Status::OK();
 }
 
@@ -227,6 +231,50 @@ Status JsonConfigParser::ParseRunOptionsFromModelProto(RunOptions& /*run_options
                          "Parsing RunOptions from ModelProto is not supported yet");
 }
 
+Status ParseNodeKernelTimesFromProfile(const PathString& profile_file_path,
+                                       std::unordered_map<std::string, int64_t>& node_kernel_times) {
+  static constexpr const char* kKernelTimeSuffix = "_kernel_time";
+  static constexpr size_t kKernelTimeSuffixLength = 12;
+
+  node_kernel_times.clear();
+
+  std::ifstream profile_stream(profile_file_path);
+  if (!profile_stream) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Failed to open the profile ",
+                           ToMBString(profile_file_path));
+  }
+
+  auto status = Status::OK();
+  ORT_TRY {
+    const json events = json::parse(profile_stream);
+    for (const auto& event : events) {
+      const auto category = event.find("cat");
+      const auto name = event.find("name");
+      const auto duration = event.find("dur");
+      if (category == event.end() || name == event.end() || duration == event.end() ||
+          *category != "Node" || !name->is_string()) {
+        continue;
+      }
+
+      const auto& event_name = name->get_ref<const std::string&>();
+      if (event_name.size() > kKernelTimeSuffixLength &&
+          event_name.compare(event_name.size() - kKernelTimeSuffixLength, kKernelTimeSuffixLength,
+                             kKernelTimeSuffix) == 0) {
+        node_kernel_times[event_name.substr(0, event_name.size() - kKernelTimeSuffixLength)] +=
+            duration->get<int64_t>();
+      }
+    }
+  }
+  ORT_CATCH(const std::exception& e) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The profile ", ToMBString(profile_file_path),
+                               " cannot be parsed. Error message: ", e.what());
+    });
+  }
+
+  return status;
+}
+
 }  // namespace inference_session_utils
 }  // namespace onnxruntime
 
@@ -13,6 +13,7 @@
 #include "core/session/inference_session.h"
 #include "core/framework/session_options.h"
 #include "core/common/common.h"
+#include "core/common/path_string.h"
 
 #ifdef _WIN32
 #pragma warning(push)
@@ -65,6 +66,11 @@ class JsonConfigParser {
   bool is_ort_config_json_available_ = false;
 };
 
+// Read the kernel time of each node from a profile trace written by a session with profiling enabled.
+// The times of all the runs in the trace are summed, in microseconds, and are keyed by the node name.
+Status ParseNodeKernelTimesFromProfile(const PathString& profile_file_path,
+                                       /*out*/ std::unordered_map<std::string, int64_t>& node_kernel_times);
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 }  // namespace inference_session_utils
@@ -291,6 +291,43 @@ ORT_API_STATUS_IMPL(OrtApis::CreateTensorWithDataAsOrtValue, _In_ const OrtMemor
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::UpdateTensorData, _Inout_ OrtValue* value, _Inout_ void* p_data, size_t p_data_len,
+                    _In_ const int64_t* shape, size_t shape_len) {
+  API_IMPL_BEGIN
+  if (!value->IsTensor()) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "the value is not a tensor");
+  }
+  auto* tensor = value->GetMutable<Tensor>();
+  if (tensor->OwnsBuffer()) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "the data of a tensor that owns its buffer can't be updated");
+  }
+  if (tensor->IsDataTypeString()) {
+    return OrtApis::CreateStatus(ORT_NOT_IMPLEMENTED, "the data of a string tensor can't be updated");
+  }
+
+  size_t elem_count = 1;
+  for (size_t i = 0; i != shape_len; ++i) {
+    if (shape[i] < 0)
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "tried updating tensor with negative value in shape");
+    if (!IAllocator::CalcMemSizeForArray(elem_count, static_cast<size_t>(shape[i]), &elem_count)) {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "size overflow");
+    }
+  }
+
+  size_t size_required;
+  if (!IAllocator::CalcMemSizeForArray(tensor->DataType()->Size(), elem_count, &size_required)) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "size overflow");
+  }
+  if (size_required > p_data_len) {
+    std::ostringstream oss;
+    oss << "not enough space: expected " << size_required << ", got " << p_data_len;
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, oss.str().c_str());
+  }
+  tensor->SetExternalData(p_data, shape, shape_len);
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::CreateTensorAsOrtValue, _Inout_ OrtAllocator* allocator,
                     _In_ const int64_t* shape, size_t shape_len, ONNXTensorElementDataType type,
                     _Outptr_ OrtValue** out) {
@@ -596,6 +633,230 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output,
+                    _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  const int queue_id = 0;
+
+  if (run_async_callback == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "run_async_callback cannot be null");
+  }
+
+  std::vector<std::string> feed_names(input_len);
+  std::vector<OrtValue> feeds(input_len);
+
+  for (size_t i = 0; i != input_len; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+    }
+
+    feed_names[i] = input_names[i];
+    auto& ort_value = feeds[i] = *reinterpret_cast<const ::OrtValue*>(input[i]);
+
+    if (ort_value.Fence()) ort_value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+  }
+
+  std::vector<std::string> output_names(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    output_names[i] = output_names1[i];
+  }
+
+  std::vector<OrtValue> fetches(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output[i] != nullptr) {
+      ::OrtValue& value = *(output[i]);
+      if (value.Fence())
+        value.Fence()->BeforeUsingAsOutput(onnxruntime::kCpuExecutionProvider, queue_id);
+      fetches[i] = value;
+    }
+  }
+
+  static const OrtRunOptions default_run_options;
+  const OrtRunOptions& options = run_options == nullptr ? default_run_options : *run_options;
+
+  auto callback = [output, output_names_len, run_async_callback,
+                   user_data](const Status& status, std::vector<OrtValue>& fetches) {
+    const int queue_id = 0;
+    if (!status.IsOK()) {
+      run_async_callback(user_data, output, output_names_len, ToOrtStatus(status));
+      return;
+    }
+
+    for (size_t i = 0; i != output_names_len; ++i) {
+      ::OrtValue& value = fetches[i];
+      if (value.Fence())
+        value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+      if (output[i] == nullptr) {
+        output[i] = new OrtValue(value);
+      }
+    }
+
+    run_async_callback(user_data, output, output_names_len, nullptr);
+  };
+
+  auto status = session->RunAsync(options, std::move(feed_names), std::move(feeds), std::move(output_names),
+                                  std::move(fetches), std::move(callback));
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunBatch, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(batch_size* input_len) const OrtValue* const* inputs, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    size_t batch_size, _Inout_updates_all_(batch_size* output_names_len) OrtValue** outputs) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  const int queue_id = 0;
+
+  std::vector<std::string> feed_names(input_len);
+  for (size_t i = 0; i != input_len; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+    }
+    feed_names[i] = input_names[i];
+  }
+
+  std::vector<std::string> output_names(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    output_names[i] = output_names1[i];
+  }
+
+  std::vector<std::vector<OrtValue>> feeds(batch_size, std::vector<OrtValue>(input_len));
+  std::vector<std::vector<OrtValue>> fetches(batch_size, std::vector<OrtValue>(output_names_len));
+  for (size_t r = 0; r != batch_size; ++r) {
+    for (size_t i = 0; i != input_len; ++i) {
+      auto& ort_value = feeds[r][i] = *inputs[r * input_len + i];
+      if (ort_value.Fence()) ort_value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+    }
+
+    for (size_t i = 0; i != output_names_len; ++i) {
+      OrtValue* output = outputs[r * output_names_len + i];
+      if (output != nullptr) {
+        if (output->Fence())
+          output->Fence()->BeforeUsingAsOutput(onnxruntime::kCpuExecutionProvider, queue_id);
+        fetches[r][i] = *output;
+      }
+    }
+  }
+
+  static const OrtRunOptions default_run_options;
+  const OrtRunOptions& options = run_options == nullptr ? default_run_options : *run_options;
+  auto status = session->RunBatch(options, feed_names, feeds, output_names, &fetches);
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+
+  for (size_t r = 0; r != batch_size; ++r) {
+    for (size_t i = 0; i != output_names_len; ++i) {
+      ::OrtValue& value = fetches[r][i];
+      if (value.Fence())
+        value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+      OrtValue*& output = outputs[r * output_names_len + i];
+      if (output == nullptr) {
+        output = new OrtValue(value);
+      }
+    }
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::CreateRunHandle, _In_ const OrtSession* sess,
+                    _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    _Outptr_ OrtRunHandle** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+
+  std::vector<std::string> feed_names(input_len);
+  for (size_t i = 0; i != input_len; ++i) {
+    if (input_names[i] == nullptr || input_names[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+    }
+    feed_names[i] = input_names[i];
+  }
+
+  std::vector<std::string> output_names(output_names_len);
+  for (size_t i = 0; i != output_names_len; ++i) {
+    if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
+    }
+    output_names[i] = output_names1[i];
+  }
+
+  std::unique_ptr<::onnxruntime::InferenceSession::RunHandle> run_handle;
+  auto status = session->CreateRunHandle(feed_names, output_names, run_handle);
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  *out = reinterpret_cast<OrtRunHandle*>(run_handle.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunWithHandle, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_ const OrtRunHandle* run_handle_ptr,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _Inout_updates_all_(output_len) OrtValue** output, size_t output_len) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  const auto& run_handle = *reinterpret_cast<const ::onnxruntime::InferenceSession::RunHandle*>(run_handle_ptr);
+  const int queue_id = 0;
+
+  if (output_len != run_handle.OutputNames().size()) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output_len doesn't match the outputs of the run handle");
+  }
+
+  std::vector<OrtValue> feeds(input_len);
+  for (size_t i = 0; i != input_len; ++i) {
+    auto& ort_value = feeds[i] = *input[i];
+    if (ort_value.Fence()) ort_value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+  }
+
+  std::vector<OrtValue> fetches(output_len);
+  for (size_t i = 0; i != output_len; ++i) {
+    if (output[i] != nullptr) {
+      ::OrtValue& value = *(output[i]);
+      if (value.Fence())
+        value.Fence()->BeforeUsingAsOutput(onnxruntime::kCpuExecutionProvider, queue_id);
+      fetches[i] = value;
+    }
+  }
+
+  static const OrtRunOptions default_run_options;
+  const OrtRunOptions& options = run_options == nullptr ? default_run_options : *run_options;
+  auto status = session->Run(options, run_handle, feeds, &fetches);
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+
+  for (size_t i = 0; i != output_len; ++i) {
+    ::OrtValue& value = fetches[i];
+    if (value.Fence())
+      value.Fence()->BeforeUsingAsInput(onnxruntime::kCpuExecutionProvider, queue_id);
+    if (output[i] == nullptr) {
+      output[i] = new OrtValue(value);
+    }
+  }
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API(void, OrtApis::ReleaseRunHandle, _Frees_ptr_opt_ OrtRunHandle* run_handle) {
+  delete reinterpret_cast<::onnxruntime::InferenceSession::RunHandle*>(run_handle);
+}
+
 struct OrtIoBinding {
   std::unique_ptr<::onnxruntime::IOBinding> binding_;
   explicit OrtIoBinding(std::unique_ptr<::onnxruntime::IOBinding>&& binding) : binding_(std::move(binding)) {}
@@ -977,6 +1238,58 @@ ORT_API_STATUS_IMPL(OrtApis::SessionEndProfiling, _In_ OrtSession* sess, _Inout_
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionGetLatencyStats, _In_ const OrtSession* sess, int reset,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::string stats_json;
+  auto status = session->GetLatencyStats(stats_json, reset != 0);
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  *out = StrDup(stats_json, allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetThreadPoolStats, _In_ const OrtSession* sess, int reset,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::string stats_json;
+  auto status = session->GetThreadPoolStats(stats_json, reset != 0);
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  *out = StrDup(stats_json, allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionGetCalibrationStats, _In_ const OrtSession* sess, int reset,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::string stats_json;
+  auto status = session->GetCalibrationStats(stats_json, reset != 0);
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  *out = StrDup(stats_json, allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::CloneSession, _In_ const OrtSession* session, _In_opt_ const OrtSessionOptions* options,
+                    _Outptr_ OrtSession** out) {
+  API_IMPL_BEGIN
+  auto source = reinterpret_cast<const ::onnxruntime::InferenceSession*>(session);
+  std::unique_ptr<::onnxruntime::InferenceSession> clone;
+  *out = nullptr;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(source->Clone(options == nullptr ? onnxruntime::SessionOptions() : options->value,
+                                                clone));
+  *out = reinterpret_cast<OrtSession*>(clone.release());
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::SessionGetModelMetadata, _In_ const OrtSession* sess,
                     _Outptr_ OrtModelMetadata** out) {
   API_IMPL_BEGIN
@@ -1842,6 +2155,45 @@ ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfg, _In_ size_t max_mem, int arena_exte
   (*out)->arena_extend_strategy = arena_extend_strategy;
   (*out)->initial_chunk_size_bytes = initial_chunk_size_bytes;
   (*out)->max_dead_bytes_per_chunk = max_dead_bytes_per_chunk;
+  (*out)->max_thread_cache_bytes = 0;
+  (*out)->arena_type = -1;
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfgV2, _In_reads_(num_keys) const char* const* arena_config_keys,
+                    _In_reads_(num_keys) const size_t* arena_config_values, _In_ size_t num_keys,
+                    _Outptr_ OrtArenaCfg** out) {
+  API_IMPL_BEGIN
+  auto cfg = onnxruntime::make_unique<OrtArenaCfg>();
+  cfg->max_mem = 0;
+  cfg->arena_extend_strategy = -1;
+  cfg->initial_chunk_size_bytes = -1;
+  cfg->max_dead_bytes_per_chunk = -1;
+  cfg->max_thread_cache_bytes = 0;
+  cfg->arena_type = -1;
+
+  for (size_t i = 0; i < num_keys; ++i) {
+    const std::string key = arena_config_keys[i];
+    const size_t value = arena_config_values[i];
+    if (key == "max_mem") {
+      cfg->max_mem = value;
+    } else if (key == "arena_extend_strategy") {
+      cfg->arena_extend_strategy = static_cast<int>(value);
+    } else if (key == "initial_chunk_size_bytes") {
+      cfg->initial_chunk_size_bytes = static_cast<int>(value);
+    } else if (key == "max_dead_bytes_per_chunk") {
+      cfg->max_dead_bytes_per_chunk = static_cast<int>(value);
+    } else if (key == "max_thread_cache_bytes") {
+      cfg->max_thread_cache_bytes = value;
+    } else if (key == "arena_type") {
+      cfg->arena_type = static_cast<int>(value);
+    } else {
+      return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, ("Invalid arena config key: " + key).c_str());
+    }
+  }
+
+  *out = cfg.release();
   return nullptr;
   API_IMPL_END
 }
@@ -2084,6 +2436,24 @@ static constexpr OrtApi ort_api_1_to_7 = {
 
     // Version 7 - In development, feel free to add/remove/rearrange here
     &OrtApis::ModelMetadataGetGraphDescription,
+    &OrtApis::CreateArenaCfgV2,
+    &OrtApis::RunAsync,
+    &OrtApis::RunOptionsSetIntraOpNumThreads,
+    &OrtApis::RunBatch,
+    &OrtApis::SessionGetLatencyStats,
+    &OrtApis::RunOptionsEnableLatencyBreakdown,
+    &OrtApis::RunOptionsGetLatencyBreakdown,
+    &OrtApis::CloneSession,
+    &OrtApis::KernelContext_ParallelFor,
+    &OrtApis::KernelContext_GetScratchAllocator,
+    &OrtApis::RunOptionsSetTimeout,
+    &OrtApis::SessionGetCalibrationStats,
+    &OrtApis::CreateRunHandle,
+    &OrtApis::ReleaseRunHandle,
+    &OrtApis::RunWithHandle,
+    &OrtApis::UpdateTensorData,
+    &OrtApis::GetTensorTypesAndShapes,
+    &OrtApis::SessionGetThreadPoolStats,
 };
 
 // Assert to do a limited check to ensure Version 1 of OrtApi never changes (will detect an addition or deletion but not if they cancel out each other)
@@ -255,4 +255,49 @@ ORT_API_STATUS_IMPL(SetGlobalDenormalAsZero, _Inout_ OrtThreadingOptions* option
 ORT_API_STATUS_IMPL(CreateArenaCfg, _In_ size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
                     int max_dead_bytes_per_chunk, _Outptr_ OrtArenaCfg** out);
 ORT_API(void, ReleaseArenaCfg, _Frees_ptr_opt_ OrtArenaCfg*);
+ORT_API_STATUS_IMPL(CreateArenaCfgV2, _In_reads_(num_keys) const char* const* arena_config_keys,
+                    _In_reads_(num_keys) const size_t* arena_config_values, _In_ size_t num_keys,
+                    _Outptr_ OrtArenaCfg** out);
+ORT_API_STATUS_IMPL(RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output,
+                    _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data);
+ORT_API_STATUS_IMPL(RunOptionsSetIntraOpNumThreads, _Inout_ OrtRunOptions* options, int intra_op_num_threads);
+ORT_API_STATUS_IMPL(RunBatch, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(batch_size* input_len) const OrtValue* const* inputs, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    size_t batch_size, _Inout_updates_all_(batch_size* output_names_len) OrtValue** outputs);
+ORT_API_STATUS_IMPL(SessionGetLatencyStats, _In_ const OrtSession* sess, int reset, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+ORT_API_STATUS_IMPL(RunOptionsEnableLatencyBreakdown, _Inout_ OrtRunOptions* options, int enable);
+ORT_API_STATUS_IMPL(RunOptionsGetLatencyBreakdown, _In_ const OrtRunOptions* options, _Inout_ OrtAllocator* allocator,
+                    _Outptr_ char** out);
+ORT_API_STATUS_IMPL(CloneSession, _In_ const OrtSession* session, _In_opt_ const OrtSessionOptions* options,
+                    _Outptr_ OrtSession** out);
+ORT_API_STATUS_IMPL(KernelContext_ParallelFor, _In_ const OrtKernelContext* context, _In_ OrtParallelForFn fn,
+                    _In_opt_ void* user_data, size_t total, double cost_per_iteration);
+ORT_API_STATUS_IMPL(KernelContext_GetScratchAllocator, _In_ const OrtKernelContext* context,
+                    _Outptr_ OrtAllocator** out);
+ORT_API_STATUS_IMPL(RunOptionsSetTimeout, _Inout_ OrtRunOptions* options, int64_t timeout_ms);
+ORT_API_STATUS_IMPL(SessionGetCalibrationStats, _In_ const OrtSession* sess, int reset,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** out);
+ORT_API_STATUS_IMPL(CreateRunHandle, _In_ const OrtSession* sess,
+                    _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Outptr_ OrtRunHandle** out);
+ORT_API(void, ReleaseRunHandle, _Frees_ptr_opt_ OrtRunHandle*);
+ORT_API_STATUS_IMPL(RunWithHandle, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_ const OrtRunHandle* run_handle,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _Inout_updates_all_(output_len) OrtValue** output, size_t output_len);
+ORT_API_STATUS_IMPL(UpdateTensorData, _Inout_ OrtValue* value, _Inout_ void* p_data, size_t p_data_len,
+                    _In_ const int64_t* shape, size_t shape_len);
+ORT_API_STATUS_IMPL(GetTensorTypesAndShapes, _In_reads_(num_values) const OrtValue* const* values,
+                    size_t num_values, _Out_writes_(num_values) ONNXTensorElementDataType* element_types,
+                    _Out_writes_(num_values) size_t* ranks, _Out_writes_(dims_len) int64_t* dims, size_t dims_len);
+ORT_API_STATUS_IMPL(SessionGetThreadPoolStats, _In_ const OrtSession* sess, int reset,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** out);
 }  // namespace OrtApis
@@ -552,89 +552,37 @@ void Col2im<float, CPUMathUtil, StorageOrder::NCHW>(const float* data_col, int64
   const int64_t hwc = height * width * channels;
   Set<float, CPUMathUtil>(gsl::narrow<ptrdiff_t>(hwc), 0, data_im, context);
 
-  // Fast path for zero padding and no dilation
-  // From Torch, modified THNN_(unfolded_acc)
-  if (dilation_h == 1 && dilation_w == 1 && pad_l == 0 && pad_r == 0 &&
-      pad_t == 0 && pad_b == 0) {
-    for (auto k = 0; k < channels * kernel_h * kernel_w; k++) {
-      const auto nip = k / (kernel_h * kernel_w);
-      const auto rest = k % (kernel_h * kernel_w);
-      const auto kh = rest / kernel_w;
-      const auto kw = rest % kernel_w;
-      const auto* dst = data_col +
-                        nip * (kernel_h * kernel_w * output_h * output_w) +
-                        kh * (kernel_w * output_h * output_w) + kw * (output_h * output_w);
-      auto* src = data_im + nip * (height * width);
-      for (auto y = 0; y < output_h; y++) {
-        const auto iy = y * stride_h + kh;
-        const auto ix = kw;
-        if (stride_w == 1) {
-          auto offsrc = src + (iy * width + ix);
-          const auto offdst = dst + (y * output_w);
-          for (auto i = 0; i < output_w; ++i) {
-            offsrc[i] += offdst[i];
-          }
-        } else {
-          for (auto x = 0; x < output_w; x++) {
-            auto offsrc = src + (iy * width + ix + x * stride_w);
-            const auto offdst = dst + (y * output_w + x);
-            *offsrc += *offdst;
-          }
-        }
-      }
-    }
-    return;
-  }
+  // From Intel, https://github.com/BVLC/caffe/pull/3536, with the range of the output columns that land in the image
+  // computed up front for each kernel column so the rows accumulate without a bounds check per element, and the
+  // rows of unit stride accumulate as vectors.
+  const int64_t channel_size = height * width;
+  for (int64_t channel = channels; channel--; data_im += channel_size) {
+    for (int64_t kernel_row = 0; kernel_row < kernel_h; kernel_row++) {
+      for (int64_t kernel_col = 0; kernel_col < kernel_w; kernel_col++) {
+        // the output columns [col_begin, col_end) land in the image, from input column input_col_begin on
+        const int64_t input_col_offset = -pad_l + kernel_col * dilation_w;
+        const int64_t col_begin = input_col_offset < 0 ? (-input_col_offset + stride_w - 1) / stride_w : 0;
+        const int64_t col_end = width > input_col_offset
+                                    ? std::min(output_w, (width - input_col_offset + stride_w - 1) / stride_w)
+                                    : 0;
+        const int64_t col_count = col_end - col_begin;
+        const int64_t input_col_begin = input_col_offset + col_begin * stride_w;
 
-  // Fast path for equal padding
-  if (pad_l == pad_r && pad_t == pad_b) {
-    // From Intel, https://github.com/BVLC/caffe/pull/3536
-    const int64_t pad_h = pad_t;
-    const int64_t pad_w = pad_l;
-    const int64_t channel_size = height * width;
-    for (int64_t channel = channels; channel--; data_im += channel_size) {
-      for (int64_t kernel_row = 0; kernel_row < kernel_h; kernel_row++) {
-        for (int64_t kernel_col = 0; kernel_col < kernel_w; kernel_col++) {
-          int64_t input_row = -pad_h + kernel_row * dilation_h;
-          for (int64_t output_rows = output_h; output_rows; output_rows--) {
-            if (!is_a_ge_zero_and_a_lt_b(input_row, height)) {
-              data_col += output_w;
+        int64_t input_row = -pad_t + kernel_row * dilation_h;
+        for (int64_t output_rows = output_h; output_rows; output_rows--) {
+          if (col_count > 0 && is_a_ge_zero_and_a_lt_b(input_row, height)) {
+            float* im = data_im + input_row * width + input_col_begin;
+            const float* col = data_col + col_begin;
+            if (stride_w == 1) {
+              EigenVectorArrayMap<float>(im, col_count) += ConstEigenVectorArrayMap<float>(col, col_count);
             } else {
-              int64_t input_col = -pad_w + kernel_col * dilation_w;
-              for (int64_t output_col = output_w; output_col; output_col--) {
-                if (is_a_ge_zero_and_a_lt_b(input_col, width)) {
-                  data_im[input_row * width + input_col] += *data_col;
-                }
-                data_col++;
-                input_col += stride_w;
+              for (int64_t i = 0; i < col_count; ++i) {
+                im[i * stride_w] += col[i];
               }
             }
-            input_row += stride_h;
           }
-        }
-      }
-    }
-    return;
-  }
-
-  // Fallback
-  const int64_t dkernel_h = dilation_h * (kernel_h - 1) + 1;
-  const int64_t dkernel_w = dilation_w * (kernel_w - 1) + 1;
-
-  int64_t height_col = (height + pad_t + pad_b - dkernel_h) / stride_h + 1;
-  int64_t width_col = (width + pad_l + pad_r - dkernel_w) / stride_w + 1;
-  int64_t channels_col = channels * kernel_h * kernel_w;
-  for (int64_t c = 0; c < channels_col; ++c) {
-    int64_t w_offset = c % kernel_w;
-    int64_t h_offset = (c / kernel_w) % kernel_h;
-    int64_t c_im = c / kernel_h / kernel_w;
-    for (int64_t h = 0; h < height_col; ++h) {
-      for (int64_t w = 0; w < width_col; ++w) {
-        int64_t h_pad = h * stride_h - pad_t + h_offset * dilation_h;
-        int64_t w_pad = w * stride_w - pad_l + w_offset * dilation_w;
-        if (h_pad >= 0 && h_pad < height && w_pad >= 0 && w_pad < width) {
-          data_im[(c_im * height + h_pad) * width + w_pad] +=
-              data_col[(c * height_col + h) * width_col + w];
+          data_col += output_w;
+          input_row += stride_h;
         }
       }
     }
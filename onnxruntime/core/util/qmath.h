@@ -4,8 +4,11 @@
 #pragma once
 
 #include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 namespace onnxruntime {
 
@@ -26,16 +29,61 @@ struct is_quant_type<int8_t> : std::true_type {};
 template <>
 struct is_quant_type<uint8_t> : std::true_type {};
 
+// the number of elements of the blocks of data the threads find the range of and quantize
+constexpr std::ptrdiff_t kQuantizeBlockSize = 16384;
+
+// Find the range of the data, split in blocks across the threads of the thread pool.
+inline void ParFindMinMaxElement(const float* data, size_t num_of_elements, float& min, float& max,
+                                 concurrency::ThreadPool* thread_pool) {
+  const std::ptrdiff_t block_count =
+      (static_cast<std::ptrdiff_t>(num_of_elements) + kQuantizeBlockSize - 1) / kQuantizeBlockSize;
+  if (block_count <= 1 || concurrency::ThreadPool::DegreeOfParallelism(thread_pool) == 1) {
+    MlasFindMinMaxElement(data, &min, &max, num_of_elements);
+    return;
+  }
+
+  std::vector<float> block_min(static_cast<size_t>(block_count));
+  std::vector<float> block_max(static_cast<size_t>(block_count));
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, block_count,
+      TensorOpCost{static_cast<double>(kQuantizeBlockSize * sizeof(float)), 0.0, static_cast<double>(kQuantizeBlockSize)},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t b = begin; b < end; b++) {
+          const size_t offset = static_cast<size_t>(b * kQuantizeBlockSize);
+          const size_t count = std::min(static_cast<size_t>(kQuantizeBlockSize), num_of_elements - offset);
+          MlasFindMinMaxElement(data + offset, &block_min[b], &block_max[b], count);
+        }
+      });
+
+  min = *std::min_element(block_min.begin(), block_min.end());
+  max = *std::max_element(block_max.begin(), block_max.end());
+}
+
+// Quantize the data, split in blocks across the threads of the thread pool.
+template <typename QType>
+void ParQuantizeLinear(const float* data, QType* output, size_t num_of_elements, float scale, QType zp,
+                       concurrency::ThreadPool* thread_pool) {
+  const std::ptrdiff_t block_count =
+      (static_cast<std::ptrdiff_t>(num_of_elements) + kQuantizeBlockSize - 1) / kQuantizeBlockSize;
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, block_count,
+      TensorOpCost{static_cast<double>(kQuantizeBlockSize * sizeof(float)),
+                   static_cast<double>(kQuantizeBlockSize * sizeof(QType)),
+                   static_cast<double>(kQuantizeBlockSize) * 2.0},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        const size_t offset = static_cast<size_t>(begin * kQuantizeBlockSize);
+        const size_t count = std::min(static_cast<size_t>((end - begin) * kQuantizeBlockSize),
+                                      num_of_elements - offset);
+        MlasQuantizeLinear(data + offset, output + offset, count, scale, zp);
+      });
+}
+
 // ReduceRange and Symmetric is for test only
 template <typename QType,
           bool ReduceRange = false,
           bool Symmetric = false,
           typename std::enable_if<is_quant_type<QType>::value, int>::type = 0>
-void GetQuantizationParameter(const float* data, int64_t num_of_elements, float& scale, QType& zp) {
-  // find input range min and max
-  float min, max;
-  MlasFindMinMaxElement(data, &min, &max, num_of_elements);
-
+void GetQuantizationParameter(float min, float max, float& scale, QType& zp) {
   // ensure the input range includes zero
   min = std::min(min, 0.0f);
   max = std::max(max, 0.0f);
@@ -62,4 +110,26 @@ void GetQuantizationParameter(const float* data, int64_t num_of_elements, float&
   zp = static_cast<QType>(RoundHalfToEven(std::max(float(qmin), std::min(float(qmax), initial_zero_point))));
 }
 
+// ReduceRange and Symmetric is for test only
+template <typename QType,
+          bool ReduceRange = false,
+          bool Symmetric = false,
+          typename std::enable_if<is_quant_type<QType>::value, int>::type = 0>
+void GetQuantizationParameter(const float* data, int64_t num_of_elements, float& scale, QType& zp,
+                              concurrency::ThreadPool* thread_pool = nullptr) {
+  // find input range min and max
+  float min, max;
+  ParFindMinMaxElement(data, static_cast<size_t>(num_of_elements), min, max, thread_pool);
+
+  GetQuantizationParameter<QType, ReduceRange, Symmetric>(min, max, scale, zp);
+}
+
+// Quantize the data with the quantization parameters of its range, for the dynamically quantized ops.
+template <typename QType>
+void DynamicQuantize(const float* data, QType* output, int64_t num_of_elements, float& scale, QType& zp,
+                     concurrency::ThreadPool* thread_pool) {
+  GetQuantizationParameter(data, num_of_elements, scale, zp, thread_pool);
+  ParQuantizeLinear(data, output, static_cast<size_t>(num_of_elements), scale, zp, thread_pool);
+}
+
 }  // namespace onnxruntime
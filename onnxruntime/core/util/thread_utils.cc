@@ -2,6 +2,7 @@
 #include <algorithm>
 
 #include <core/common/make_unique.h>
+#include "core/common/logging/logging.h"
 #ifdef _WIN32
 #include <Windows.h>
 #endif
@@ -19,6 +20,23 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   if (options.affinity_vec_len != 0) {
     to.affinity.assign(options.affinity_vec, options.affinity_vec + options.affinity_vec_len);
   }
+  if (options.numa_node >= 0) {
+    cpu_list = Env::Default().GetNumaNodeProcessors(options.numa_node);
+    if (cpu_list.empty()) {
+      LOGS_DEFAULT(WARNING) << "Could not get the processors of NUMA node " << options.numa_node
+                            << ", the thread pool is not bound to it";
+    } else {
+      if (options.thread_pool_size <= 0)
+        options.thread_pool_size = static_cast<int>(cpu_list.size());
+      if (options.thread_pool_size == 1)
+        return nullptr;
+      if (options.affinity_vec_len == 0) {
+        to.affinity.resize(options.thread_pool_size);
+        for (size_t i = 0; i < to.affinity.size(); ++i)
+          to.affinity[i] = cpu_list[i % cpu_list.size()];
+      }
+    }
+  }
   if (options.thread_pool_size <= 0) {  // default
     cpu_list = Env::Default().GetThreadAffinityMasks();
     if (cpu_list.empty() || cpu_list.size() == 1)
@@ -28,6 +46,7 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
       to.affinity = cpu_list;
   }
   to.set_denormal_as_zero = options.set_denormal_as_zero;
+  to.spin_policy = options.spin_policy;
 
   return onnxruntime::make_unique<ThreadPool>(env, to, options.name, options.thread_pool_size,
                                               options.allow_spinning);
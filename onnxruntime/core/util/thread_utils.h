@@ -28,6 +28,14 @@ struct OrtThreadPoolParams {
 
   // Set or unset denormal as zero
   bool set_denormal_as_zero = false;
+
+  //If it is not negative, bind the threads to the logical processors of this NUMA node.
+  //With thread_pool_size = 0 the pool gets one thread per processor of the node.
+  //Buffers that are first touched by these threads, e.g. the arena chunks, are then placed on the node.
+  int numa_node = -1;
+
+  //Spin policy of the threads if allow_spinning is true.
+  onnxruntime::SpinPolicy spin_policy = onnxruntime::SpinPolicy::kFixed;
 };
 
 struct OrtThreadingOptions {
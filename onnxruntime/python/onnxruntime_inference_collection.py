@@ -2,11 +2,19 @@
 # Copyright (c) Microsoft Corporation. All rights reserved.
 # Licensed under the MIT License.
 # --------------------------------------------------------------------------
+import asyncio
 import collections
 import collections.abc
+import concurrent.futures
+import json
 import os
+import shutil
+import tempfile
+import threading
 import warnings
 
+import numpy as np
+
 from onnxruntime.capi import _pybind_state as C
 
 
@@ -165,17 +173,22 @@ class Session:
         """
         self._enable_fallback = True
 
-    def run(self, output_names, input_feed, run_options=None):
+    def run(self, output_names, input_feed, run_options=None, outputs=None):
         """
         Compute the predictions.
 
         :param output_names: name of the outputs
-        :param input_feed: dictionary ``{ input_name: input_value }``
+        :param input_feed: dictionary ``{ input_name: input_value }``. C-contiguous numpy arrays and
+            :class:`onnxruntime.OrtValue` instances, e.g. from :meth:`OrtValue.from_dlpack`, are used without a copy.
         :param run_options: See :class:`onnxruntime.RunOptions`.
+        :param outputs: optional list of preallocated outputs, one per output name, which are returned instead of new
+            arrays. An entry is a C-contiguous, writeable numpy array with the type and shape of the output that the
+            output is written into, an :class:`onnxruntime.OrtValue`, or None to allocate the output.
 
         ::
 
             sess.run([output_name], {input_name: x})
+            sess.run([output_name], {input_name: x}, outputs=[y])
         """
         num_required_inputs = len(self._inputs_meta)
         num_inputs = len(input_feed)
@@ -184,8 +197,14 @@ class Session:
             raise ValueError("Model requires {} inputs. Input Feed contains {}".format(num_required_inputs, num_inputs))
         if not output_names:
             output_names = [output.name for output in self._outputs_meta]
+
+        def invoke():
+            if outputs is None:
+                return self._sess.run(output_names, input_feed, run_options)
+            return self._sess.run_with_outputs(output_names, input_feed, list(outputs), run_options)
+
         try:
-            return self._sess.run(output_names, input_feed, run_options)
+            return invoke()
         except C.EPFail as err:
             if self._enable_fallback:
                 print("EP Error: {} using {}".format(str(err), self._providers))
@@ -193,10 +212,63 @@ class Session:
                 self.set_providers(self._fallback_providers)
                 # Fallback only once.
                 self.disable_fallback()
-                return self._sess.run(output_names, input_feed, run_options)
+                return invoke()
             else:
                 raise
 
+    def run_async(self, output_names, input_feed, run_options=None):
+        """
+        Compute the predictions without blocking the calling thread. The run is scheduled on the intra-op thread
+        pool of the session, which needs at least 2 threads, and doesn't hold the GIL.
+
+        :param output_names: name of the outputs
+        :param input_feed: dictionary ``{ input_name: input_value }``
+        :param run_options: See :class:`onnxruntime.RunOptions`. Set its ``terminate`` flag to cancel the run.
+        :return: an :class:`asyncio.Future` of the current event loop, which completes with the list of outputs
+
+        ::
+
+            outputs = await sess.run_async([output_name], {input_name: x})
+        """
+        num_required_inputs = len(self._inputs_meta)
+        num_inputs = len(input_feed)
+        if num_inputs < num_required_inputs:
+            raise ValueError("Model requires {} inputs. Input Feed contains {}".format(num_required_inputs, num_inputs))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+
+        loop = asyncio.get_event_loop()
+        future = loop.create_future()
+
+        def complete(outputs, error):
+            if future.cancelled():
+                return
+            if error is not None:
+                future.set_exception(RuntimeError(error))
+            else:
+                future.set_result(outputs)
+
+        # invoked on a thread of the session's thread pool, the future must be completed on the event loop thread
+        def callback(outputs, error):
+            loop.call_soon_threadsafe(complete, outputs, error)
+
+        self._sess.run_async(output_names, input_feed, callback, run_options)
+        return future
+
+    def get_calibration_stats(self, reset=False):
+        """
+        Return the calibration statistics of quantization recorded by the runs of the session for the tensors of the
+        ``session.calibration.tensor_names`` session config entry, a ';' separated list of names or ``*`` for all the
+        float tensors. The statistics are computed while the model runs, without extra outputs.
+
+        :param reset: clear the statistics after they are read
+        :return: a dictionary from the tensor names to dictionaries with the ``count``, ``min`` and ``max`` of the
+            values, the ``histogram`` of their absolute values over [0, ``histogram_range``] and the
+            ``entropy_threshold`` of the absolute values for int8 quantization
+        """
+        stats = json.loads(self._sess.get_calibration_stats(reset))
+        return {tensor.pop('name'): tensor for tensor in stats['tensors']}
+
     def end_profiling(self):
         """
         End profiling and return results in a file.
@@ -340,6 +412,133 @@ class InferenceSession(Session):
         self._create_inference_session(providers, provider_options)
 
 
+class ReplicatedInferenceSession:
+    """
+    Runs a model data parallel on several devices, with a replica of the session on each device.
+
+    A batch of at least ``min_batch_size_per_replica`` rows per replica is split along its first dimension across the
+    least busy replicas, which run concurrently, and the outputs are concatenated. Smaller requests run whole on the
+    least busy replica, so concurrent requests from several threads are balanced across the devices.
+    All the outputs of a split batch must have the batch as their first dimension.
+    """
+    def __init__(self, path_or_bytes, device_ids, sess_options=None, provider='CUDAExecutionProvider',
+                 provider_options=None, min_batch_size_per_replica=1, optimize_once=True):
+        """
+        :param path_or_bytes: filename or serialized ONNX model in a byte string
+        :param device_ids: ids of the devices to create a replica on. CPU replicas ignore the id.
+        :param sess_options: session options of the replicas
+        :param provider: execution provider of the replicas, the CPU execution provider runs the nodes it doesn't
+            support. The 'device_id' provider option of each replica is set to its device id.
+        :param provider_options: options dict of the provider
+        :param min_batch_size_per_replica: minimum number of rows a replica runs of a split batch
+        :param optimize_once: optimize the graph for the first replica only, and load the optimized model in the
+            others. Must be False for execution providers that compile the graph, e.g. TensorRT, as compiled nodes
+            can't be saved.
+        """
+        if not device_ids:
+            raise ValueError("At least one device id is needed")
+        if min_batch_size_per_replica < 1:
+            raise ValueError("min_batch_size_per_replica must be at least 1")
+
+        self._min_batch_size_per_replica = min_batch_size_per_replica
+        self._replicas = []
+        self._in_flight = [0] * len(device_ids)
+        self._lock = threading.Lock()
+
+        sess_options = sess_options if sess_options else C.SessionOptions()
+        initial_optimized_model_filepath = sess_options.optimized_model_filepath
+        initial_graph_optimization_level = sess_options.graph_optimization_level
+        optimized_model_dir = tempfile.mkdtemp() if optimize_once and len(device_ids) > 1 else None
+        try:
+            for index, device_id in enumerate(device_ids):
+                providers = [provider, 'CPUExecutionProvider'] if provider != 'CPUExecutionProvider' else [provider]
+                options = dict(provider_options) if provider_options else {}
+                if provider != 'CPUExecutionProvider':
+                    options['device_id'] = str(device_id)
+                all_provider_options = [options, {}] if len(providers) > 1 else [options]
+
+                model = path_or_bytes
+                if optimized_model_dir:
+                    optimized_model_path = os.path.join(optimized_model_dir, 'optimized.onnx')
+                    if index == 0:
+                        sess_options.optimized_model_filepath = optimized_model_path
+                    else:
+                        # the saved model is already optimized for this provider
+                        model = optimized_model_path
+                        sess_options.optimized_model_filepath = ''
+                        sess_options.graph_optimization_level = C.GraphOptimizationLevel.ORT_DISABLE_ALL
+                sess = InferenceSession(model, sess_options, providers, all_provider_options)
+                # replicas must run on their device, not on a fallback
+                sess.disable_fallback()
+                self._replicas.append(sess)
+        finally:
+            sess_options.optimized_model_filepath = initial_optimized_model_filepath
+            sess_options.graph_optimization_level = initial_graph_optimization_level
+            if optimized_model_dir:
+                shutil.rmtree(optimized_model_dir, ignore_errors=True)
+
+        self._executor = concurrent.futures.ThreadPoolExecutor(max_workers=len(self._replicas))
+
+    def get_replicas(self):
+        "Return the :class:`onnxruntime.InferenceSession` of each device."
+        return list(self._replicas)
+
+    def get_inputs(self):
+        "Return the inputs metadata as a list of :class:`onnxruntime.NodeArg`."
+        return self._replicas[0].get_inputs()
+
+    def get_outputs(self):
+        "Return the outputs metadata as a list of :class:`onnxruntime.NodeArg`."
+        return self._replicas[0].get_outputs()
+
+    def _acquire(self, count):
+        with self._lock:
+            indices = sorted(range(len(self._replicas)), key=lambda i: self._in_flight[i])[:count]
+            for i in indices:
+                self._in_flight[i] += 1
+        return indices
+
+    def _run_replica(self, index, output_names, input_feed, run_options):
+        try:
+            return self._replicas[index].run(output_names, input_feed, run_options)
+        finally:
+            with self._lock:
+                self._in_flight[index] -= 1
+
+    def _split_count(self, input_feed):
+        if not input_feed or not all(isinstance(value, np.ndarray) and value.ndim > 0 for value in input_feed.values()):
+            return 1
+        batch_sizes = set(value.shape[0] for value in input_feed.values())
+        if len(batch_sizes) != 1:
+            return 1
+        return max(1, min(len(self._replicas), batch_sizes.pop() // self._min_batch_size_per_replica))
+
+    def run(self, output_names, input_feed, run_options=None):
+        """
+        Compute the predictions, splitting the batch across the replicas if it is large enough.
+
+        :param output_names: name of the outputs
+        :param input_feed: dictionary ``{ input_name: input_value }``. Batches are split if all the inputs are numpy
+            arrays with the same first dimension.
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        """
+        if not output_names:
+            output_names = [output.name for output in self.get_outputs()]
+
+        count = self._split_count(input_feed)
+        indices = self._acquire(count)
+        if count == 1:
+            return self._run_replica(indices[0], output_names, input_feed, run_options)
+
+        names = list(input_feed)
+        chunks = [np.array_split(input_feed[name], count) for name in names]
+        futures = [self._executor.submit(self._run_replica, index, output_names,
+                                         {name: chunks[n][i] for n, name in enumerate(names)}, run_options)
+                   for i, index in enumerate(indices)]
+        results = [future.result() for future in futures]
+        return [np.concatenate([result[i] for result in results]) for i in range(len(output_names))]
+
+
 class IOBinding:
     '''
     This class provides API to bind input/output to a specified device, e.g. GPU.
@@ -381,7 +580,8 @@ class IOBinding:
         '''
         self._iobinding.bind_ortvalue_input(name, ortvalue._ortvalue)
 
-    def bind_output(self, name, device_type='cpu', device_id=0, element_type=None, shape=None, buffer_ptr=None):
+    def bind_output(self, name, device_type='cpu', device_id=0, element_type=None, shape=None, buffer_ptr=None,
+                    reuse_buffer=False):
         '''
         :param name: output name
         :param device_type: e.g. cpu, cuda, cpu by default
@@ -389,6 +589,8 @@ class IOBinding:
         :param element_type: output element type
         :param shape: output shape
         :param buffer_ptr: memory pointer to output data
+        :param reuse_buffer: if no buffer_ptr is provided, keep the output ORT allocates and write the next run's
+            output into it when the shape is unchanged. The outputs from the previous run are overwritten.
         '''
 
         # Follow the `if` path when the user has not provided any pre-allocated buffer but still
@@ -400,7 +602,8 @@ class IOBinding:
         if buffer_ptr is None:
             self._iobinding.bind_output(name,
                                         C.OrtDevice(get_ort_device_type(device_type), C.OrtDevice.default_memory(),
-                                                    device_id))
+                                                    device_id),
+                                        reuse_buffer)
         else:
             if element_type is None or shape is None:
                 raise ValueError("`element_type` and `shape` are to be provided if pre-allocated memory is provided")
@@ -522,3 +725,37 @@ class OrtValue:
         Valid only for OrtValues holding Tensors. Throws for OrtValues holding non-Tensors.
         '''
         return self._ortvalue.numpy()
+
+    @staticmethod
+    def from_dlpack(data, is_bool_tensor=False):
+        '''
+        Factory method to construct an OrtValue (which holds a Tensor) that shares the memory of a DLPack tensor,
+        e.g. a PyTorch or CuPy tensor on the CPU or a CUDA device, without a copy. The tensor must be contiguous.
+        :param data: a DLPack capsule, or an object with a ``__dlpack__`` method
+        :param is_bool_tensor: DLPack has no boolean type. Set to True to read an 8-bit unsigned tensor as bool.
+        '''
+        capsule = data.__dlpack__() if hasattr(data, '__dlpack__') else data
+        # the OrtValue owns the DLPack tensor which keeps the memory of the producer alive
+        return OrtValue(C.OrtValue.from_dlpack(capsule, is_bool_tensor))
+
+    def to_dlpack(self):
+        '''
+        Returns a DLPack capsule that shares the memory of the OrtValue, e.g. for torch.utils.dlpack.from_dlpack.
+        The memory stays valid while the consumer of the capsule uses it, even if this OrtValue is released.
+        '''
+        return self._ortvalue.to_dlpack()
+
+    def __dlpack__(self, stream=None):
+        '''
+        DLPack protocol. ORT has completed the writes to the memory of an OrtValue that it returns, so no stream
+        synchronization is needed.
+        '''
+        return self.to_dlpack()
+
+    def __dlpack_device__(self):
+        '''
+        DLPack protocol: returns the DLPack device type and id of the memory.
+        '''
+        # the device types of the DLPack specification
+        dlpack_device_types = {'cpu': 1, 'cuda': 2}
+        return (dlpack_device_types[self.device_name()], self._ortvalue.device_id())
@@ -0,0 +1,268 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "onnxruntime_pybind_dlpack.h"
+
+#include <stdexcept>
+#include <vector>
+
+#include "core/common/make_unique.h"
+#include "core/framework/allocator.h"
+#include "core/framework/data_types.h"
+#include "core/framework/tensor.h"
+#include "core/graph/onnx_protobuf.h"
+
+namespace onnxruntime {
+namespace python {
+
+namespace {
+
+constexpr const char* kDlpackCapsuleName = "dltensor";
+constexpr const char* kUsedDlpackCapsuleName = "used_dltensor";
+
+// The DLPack tensor of an exported OrtValue. It keeps the OrtValue alive and owns the shape the tensor points to.
+struct OrtDlpackTensor {
+  OrtValue ort_value;
+  std::vector<int64_t> shape;
+  DLManagedTensor tensor;
+};
+
+void DeleteOrtDlpackTensor(DLManagedTensor* dlpack) {
+  delete static_cast<OrtDlpackTensor*>(dlpack->manager_ctx);
+}
+
+DLDataType GetDlpackDataType(const Tensor& tensor) {
+  DLDataType dtype;
+  dtype.lanes = 1;
+  dtype.bits = static_cast<uint8_t>(tensor.DataType()->Size() * 8);
+  switch (tensor.GetElementType()) {
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT:
+    case ONNX_NAMESPACE::TensorProto_DataType_DOUBLE:
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT16:
+      dtype.code = kDLFloat;
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16:
+      dtype.code = kDLBfloat;
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_INT8:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT32:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT64:
+      dtype.code = kDLInt;
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_BOOL:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT8:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT32:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT64:
+      dtype.code = kDLUInt;
+      break;
+    default:
+      throw std::runtime_error("Unsupported tensor type for DLPack: " +
+                               std::string(DataTypeImpl::ToString(tensor.DataType())));
+  }
+
+  return dtype;
+}
+
+MLDataType GetOrtElementType(const DLDataType& dtype, bool is_bool_tensor) {
+  if (dtype.lanes != 1) {
+    throw std::runtime_error("DLPack tensors with vector element types are not supported.");
+  }
+
+  switch (dtype.code) {
+    case kDLFloat:
+      switch (dtype.bits) {
+        case 16:
+          return DataTypeImpl::GetType<MLFloat16>();
+        case 32:
+          return DataTypeImpl::GetType<float>();
+        case 64:
+          return DataTypeImpl::GetType<double>();
+      }
+      break;
+    case kDLBfloat:
+      if (dtype.bits == 16) {
+        return DataTypeImpl::GetType<BFloat16>();
+      }
+      break;
+    case kDLInt:
+      switch (dtype.bits) {
+        case 8:
+          return DataTypeImpl::GetType<int8_t>();
+        case 16:
+          return DataTypeImpl::GetType<int16_t>();
+        case 32:
+          return DataTypeImpl::GetType<int32_t>();
+        case 64:
+          return DataTypeImpl::GetType<int64_t>();
+      }
+      break;
+    case kDLUInt:
+      switch (dtype.bits) {
+        case 8:
+          return is_bool_tensor ? DataTypeImpl::GetType<bool>() : DataTypeImpl::GetType<uint8_t>();
+        case 16:
+          return DataTypeImpl::GetType<uint16_t>();
+        case 32:
+          return DataTypeImpl::GetType<uint32_t>();
+        case 64:
+          return DataTypeImpl::GetType<uint64_t>();
+      }
+      break;
+  }
+
+  throw std::runtime_error("Unsupported DLPack data type: code " + std::to_string(dtype.code) + ", bits " +
+                           std::to_string(dtype.bits));
+}
+
+// A tensor over the buffer of an imported DLPack tensor. Deleted through this type by the OrtValue deleter.
+class DlpackOwnedTensor : public Tensor {
+ public:
+  DlpackOwnedTensor(MLDataType element_type, const TensorShape& shape, void* data, const OrtMemoryInfo& location,
+                    DLManagedTensor* dlpack)
+      : Tensor(element_type, shape, data, location), dlpack_(dlpack) {}
+
+  ~DlpackOwnedTensor() {
+    if (dlpack_->deleter != nullptr) {
+      dlpack_->deleter(dlpack_);
+    }
+  }
+
+  static void Delete(void* p) {
+    delete static_cast<DlpackOwnedTensor*>(static_cast<Tensor*>(p));
+  }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(DlpackOwnedTensor);
+
+  DLManagedTensor* const dlpack_;
+};
+
+void DeleteDlpackCapsule(PyObject* capsule) {
+  // a consumer renames the capsule when it takes ownership of the tensor
+  if (!PyCapsule_IsValid(capsule, kDlpackCapsuleName)) {
+    return;
+  }
+
+  auto* dlpack = static_cast<DLManagedTensor*>(PyCapsule_GetPointer(capsule, kDlpackCapsuleName));
+  if (dlpack->deleter != nullptr) {
+    dlpack->deleter(dlpack);
+  }
+}
+
+}  // namespace
+
+DLManagedTensor* OrtValueToDlpack(const OrtValue& ort_value) {
+  if (!ort_value.IsTensor()) {
+    throw std::runtime_error("Only OrtValues that are Tensors can be converted to DLPack.");
+  }
+
+  const Tensor& tensor = ort_value.Get<Tensor>();
+  if (tensor.IsDataTypeString()) {
+    throw std::runtime_error("String tensors can't be converted to DLPack.");
+  }
+
+  auto ort_dlpack = onnxruntime::make_unique<OrtDlpackTensor>();
+  ort_dlpack->ort_value = ort_value;
+  ort_dlpack->shape = tensor.Shape().GetDims();
+
+  DLTensor& dl_tensor = ort_dlpack->tensor.dl_tensor;
+  const OrtDevice& device = tensor.Location().device;
+  switch (device.Type()) {
+    case OrtDevice::CPU:
+      dl_tensor.ctx.device_type = kDLCPU;
+      break;
+    case OrtDevice::GPU:
+      dl_tensor.ctx.device_type = kDLGPU;
+      break;
+    default:
+      throw std::runtime_error("Unsupported device for DLPack: " + std::to_string(device.Type()));
+  }
+
+  dl_tensor.ctx.device_id = device.Id();
+  // the consumer may write to the buffer, as the users of the OrtValue may
+  dl_tensor.data = ort_dlpack->ort_value.GetMutable<Tensor>()->MutableDataRaw();
+  dl_tensor.ndim = static_cast<int>(ort_dlpack->shape.size());
+  dl_tensor.dtype = GetDlpackDataType(tensor);
+  dl_tensor.shape = ort_dlpack->shape.empty() ? nullptr : ort_dlpack->shape.data();
+  // compact row-major
+  dl_tensor.strides = nullptr;
+  dl_tensor.byte_offset = 0;
+
+  ort_dlpack->tensor.manager_ctx = ort_dlpack.get();
+  ort_dlpack->tensor.deleter = DeleteOrtDlpackTensor;
+  return &ort_dlpack.release()->tensor;
+}
+
+OrtValue DlpackToOrtValue(DLManagedTensor* dlpack, bool is_bool_tensor) {
+  const DLTensor& dl_tensor = dlpack->dl_tensor;
+
+  std::vector<int64_t> dims(dl_tensor.shape, dl_tensor.shape + dl_tensor.ndim);
+  if (dl_tensor.strides != nullptr) {
+    // only compact row-major strides can be used without a copy
+    int64_t expected_stride = 1;
+    for (int i = dl_tensor.ndim - 1; i >= 0; --i) {
+      if (dims[i] != 1 && dl_tensor.strides[i] != expected_stride) {
+        throw std::runtime_error("Only compact row-major DLPack tensors are supported. Make the tensor contiguous.");
+      }
+      expected_stride *= dims[i];
+    }
+  }
+
+  OrtMemoryInfo location;
+  switch (dl_tensor.ctx.device_type) {
+    case kDLCPU:
+    case kDLCPUPinned:
+      location = OrtMemoryInfo(CPU, OrtDeviceAllocator);
+      break;
+    case kDLGPU:
+#ifdef USE_CUDA
+      location = OrtMemoryInfo(CUDA, OrtDeviceAllocator,
+                               OrtDevice(OrtDevice::GPU, OrtDevice::MemType::DEFAULT,
+                                         static_cast<OrtDevice::DeviceId>(dl_tensor.ctx.device_id)),
+                               dl_tensor.ctx.device_id);
+      break;
+#else
+      throw std::runtime_error(
+          "Can't use a CUDA tensor with this package of OnnxRuntime. "
+          "Please use the CUDA package of OnnxRuntime to use this feature.");
+#endif
+    default:
+      throw std::runtime_error("Unsupported DLPack device type: " + std::to_string(dl_tensor.ctx.device_type));
+  }
+
+  MLDataType element_type = GetOrtElementType(dl_tensor.dtype, is_bool_tensor);
+  void* data = static_cast<char*>(dl_tensor.data) + dl_tensor.byte_offset;
+  auto tensor = onnxruntime::make_unique<DlpackOwnedTensor>(element_type, TensorShape(dims), data, location, dlpack);
+
+  OrtValue ort_value;
+  ort_value.Init(static_cast<Tensor*>(tensor.release()), DataTypeImpl::GetType<Tensor>(), DlpackOwnedTensor::Delete);
+  return ort_value;
+}
+
+py::object ToDlpack(const OrtValue& ort_value) {
+  DLManagedTensor* dlpack = OrtValueToDlpack(ort_value);
+  PyObject* capsule = PyCapsule_New(dlpack, kDlpackCapsuleName, DeleteDlpackCapsule);
+  if (capsule == nullptr) {
+    dlpack->deleter(dlpack);
+    throw py::error_already_set();
+  }
+
+  return py::reinterpret_steal<py::object>(capsule);
+}
+
+OrtValue FromDlpack(py::object capsule, bool is_bool_tensor) {
+  if (!PyCapsule_IsValid(capsule.ptr(), kDlpackCapsuleName)) {
+    throw std::runtime_error("Expected a DLPack capsule named 'dltensor' that was not consumed yet.");
+  }
+
+  auto* dlpack = static_cast<DLManagedTensor*>(PyCapsule_GetPointer(capsule.ptr(), kDlpackCapsuleName));
+  OrtValue ort_value = DlpackToOrtValue(dlpack, is_bool_tensor);
+  // the OrtValue owns the tensor now
+  PyCapsule_SetName(capsule.ptr(), kUsedDlpackCapsuleName);
+  return ort_value;
+}
+
+}  // namespace python
+}  // namespace onnxruntime
@@ -0,0 +1,34 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <pybind11/pybind11.h>
+
+#include <dlpack/dlpack.h>
+
+#include "core/framework/ml_value.h"
+
+namespace onnxruntime {
+namespace python {
+
+namespace py = pybind11;
+
+// Converts a tensor OrtValue to a DLPack tensor that shares its buffer. The DLPack tensor holds a reference to the
+// OrtValue, which is released when its deleter is called.
+DLManagedTensor* OrtValueToDlpack(const OrtValue& ort_value);
+
+// Creates a tensor OrtValue that shares the buffer of a compact, row-major DLPack tensor on the CPU or a CUDA device.
+// The OrtValue takes ownership of dlpack and calls its deleter when the tensor is released.
+// DLPack has no boolean type, so is_bool_tensor selects bool over uint8 for 8-bit unsigned tensors.
+OrtValue DlpackToOrtValue(DLManagedTensor* dlpack, bool is_bool_tensor);
+
+// Returns a "dltensor" PyCapsule holding the DLPack tensor of ort_value, as the DLPack protocol exchanges them.
+py::object ToDlpack(const OrtValue& ort_value);
+
+// Consumes a "dltensor" PyCapsule produced by another framework, and renames it "used_dltensor" as the protocol
+// requires so the capsule doesn't release the tensor.
+OrtValue FromDlpack(py::object capsule, bool is_bool_tensor);
+
+}  // namespace python
+}  // namespace onnxruntime
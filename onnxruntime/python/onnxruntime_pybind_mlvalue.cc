@@ -187,6 +187,10 @@ class OrtPybindSingleUseAllocator : public IAllocator {
 
   ORT_DISALLOW_COPY_AND_ASSIGNMENT(OrtPybindSingleUseAllocator);
 
+  ~OrtPybindSingleUseAllocator() override {
+    Free(nullptr);
+  }
+
   // Always return pre-allocated buffer
   // which actually contains the array data
   void* Alloc(size_t) override {
@@ -199,6 +203,8 @@ class OrtPybindSingleUseAllocator : public IAllocator {
     // be non-deterministic. However, we do not anticipate
     // true shared ownership of the allocator object except
     // at the creation stack.
+    // The feeds of run_async are released on a thread of the session's thread pool, which doesn't hold the GIL.
+    py::gil_scoped_acquire acquire;
     pyObjectContiguous_.reset();
     pyObject_.reset();
   }
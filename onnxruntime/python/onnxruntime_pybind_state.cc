@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include "python/onnxruntime_pybind_dlpack.h"
 #include "python/onnxruntime_pybind_exceptions.h"
 #include "python/onnxruntime_pybind_mlvalue.h"
 #include "python/onnxruntime_pybind_state_common.h"
@@ -17,8 +18,10 @@
 #include "core/framework/data_types_internal.h"
 #include "core/providers/get_execution_providers.h"
 #include "core/framework/kernel_registry.h"
+#include "core/framework/onnxruntime_typeinfo.h"
 #include "core/framework/provider_options_utils.h"
 #include "core/framework/random_seed.h"
+#include "core/framework/run_latency_breakdown.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/TensorSeq.h"
 #include "core/graph/graph_viewer.h"
@@ -422,6 +425,58 @@ static void AddTensorAsPyObj(const OrtValue& val, std::vector<py::object>& pyobj
   pyobjs.push_back(obj);
 }
 
+static NameMLValMap CreateFeeds(PyInferenceSession* sess, std::map<std::string, py::object>& pyfeeds) {
+  auto px = sess->GetSessionHandle()->GetModelInputs();
+  if (!px.first.IsOK() || !px.second) {
+    throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+  }
+
+  NameMLValMap feeds;
+  for (auto& feed : pyfeeds) {
+    OrtValue ml_value;
+    CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
+    ThrowIfPyErrOccured();
+    feeds.insert(std::make_pair(feed.first, ml_value));
+  }
+
+  return feeds;
+}
+
+// Wraps a preallocated output the run writes into: an OrtValue, or a numpy array whose buffer is used directly.
+// The array must be C-contiguous and writeable, and have the element type of the output and the shape it will have.
+static void CreatePreallocatedFetch(PyInferenceSession* sess, const std::string& name, py::object& output,
+                                    OrtValue& fetch) {
+  if (strcmp(Py_TYPE(output.ptr())->tp_name, PYTHON_ORTVALUE_OBJECT_NAME) == 0) {
+    fetch = *output.attr(PYTHON_ORTVALUE_NATIVE_OBJECT_ATTR).cast<OrtValue*>();
+    return;
+  }
+
+  if (!PyArray_Check(output.ptr())) {
+    throw std::runtime_error("The preallocated output '" + name + "' must be a numpy array or an OrtValue.");
+  }
+
+  auto* arr = reinterpret_cast<PyArrayObject*>(output.ptr());
+  if (!PyArray_IS_C_CONTIGUOUS(arr) || !PyArray_ISWRITEABLE(arr) || !IsNumericNumpyType(PyArray_TYPE(arr))) {
+    throw std::runtime_error("The preallocated output '" + name +
+                             "' must be a C-contiguous, writeable numpy array of a numeric type.");
+  }
+
+  auto px = sess->GetSessionHandle()->GetModelOutputs();
+  OrtPybindThrowIfError(px.first);
+  for (const auto* node_arg : *px.second) {
+    const auto* type_proto = node_arg->TypeAsProto();
+    if (node_arg->Name() == name && type_proto != nullptr && type_proto->has_tensor_type() &&
+        type_proto->tensor_type().has_elem_type() &&
+        OrtTypeInfo::ElementTypeFromProto(type_proto->tensor_type().elem_type()) !=
+            NumpyTypeToOnnxRuntimeType(PyArray_TYPE(arr))) {
+      throw std::runtime_error("The element type of the preallocated output '" + name +
+                               "' doesn't match the type of the model output.");
+    }
+  }
+
+  CreateGenericMLValue(nullptr, GetAllocator(), name, output, &fetch, true);
+}
+
 static inline void RegisterExecutionProvider(InferenceSession* sess, onnxruntime::IExecutionProviderFactory& f) {
   auto p = f.CreateProvider();
   OrtPybindThrowIfError(sess->RegisterExecutionProvider(std::move(p)));
@@ -572,6 +627,8 @@ static void RegisterExecutionProviders(InferenceSession* sess, const std::vector
             params.device_id = option.second.c_str();
           } else if (option.first == "num_of_threads") {
             params.num_of_threads = std::stoi(option.second);
+          } else if (option.first == "num_streams") {
+            params.num_streams = std::stoi(option.second);
           } else {
             ORT_THROW("Invalid OpenVINO EP option: ", option.first);
           }
@@ -1060,11 +1117,14 @@ void addObjectMethods(py::module& m, Environment& env) {
 
   py::enum_<ExecutionMode>(m, "ExecutionMode")
       .value("ORT_SEQUENTIAL", ExecutionMode::ORT_SEQUENTIAL)
-      .value("ORT_PARALLEL", ExecutionMode::ORT_PARALLEL);
+      .value("ORT_PARALLEL", ExecutionMode::ORT_PARALLEL)
+      .value("ORT_PARALLEL_WORK_STEALING", ExecutionMode::ORT_PARALLEL_WORK_STEALING)
+      .value("ORT_PARALLEL_HETEROGENEOUS", ExecutionMode::ORT_PARALLEL_HETEROGENEOUS);
 
   py::enum_<ExecutionOrder>(m, "ExecutionOrder")
       .value("DEFAULT", ExecutionOrder::DEFAULT)
-      .value("PRIORITY_BASED", ExecutionOrder::PRIORITY_BASED);
+      .value("PRIORITY_BASED", ExecutionOrder::PRIORITY_BASED)
+      .value("MEMORY_EFFICIENT", ExecutionOrder::MEMORY_EFFICIENT);
 
   py::enum_<OrtAllocatorType>(m, "OrtAllocatorType")
       .value("INVALID", OrtAllocatorType::Invalid)
@@ -1095,6 +1155,8 @@ void addObjectMethods(py::module& m, Environment& env) {
     ort_arena_cfg->arena_extend_strategy = arena_extend_strategy_local;
     ort_arena_cfg->initial_chunk_size_bytes = initial_chunk_size_bytes;
     ort_arena_cfg->max_dead_bytes_per_chunk = max_dead_bytes_per_chunk;
+    ort_arena_cfg->max_thread_cache_bytes = 0;
+    ort_arena_cfg->arena_type = -1;
     return ort_arena_cfg;
   }));
 
@@ -1222,6 +1284,11 @@ void addObjectMethods(py::module& m, Environment& env) {
 
         return std::string(GetDeviceName(ml_value->Get<Tensor>().Location().device));
       })
+      .def("device_id", [](OrtValue* ml_value) -> int {
+        ORT_ENFORCE(ml_value->IsTensor(), "Only OrtValues that are Tensors are currently supported");
+
+        return ml_value->Get<Tensor>().Location().device.Id();
+      })
       .def("shape", [](OrtValue* ml_value) -> py::list {
         // TODO: Assumes that the OrtValue is a Tensor, make this generic to handle non-Tensors
         ORT_ENFORCE(ml_value->IsTensor(), "Only OrtValues that are Tensors are currently supported");
@@ -1264,7 +1331,18 @@ void addObjectMethods(py::module& m, Environment& env) {
     GetPyObjFromTensor(ml_value->Get<Tensor>(), obj, nullptr, nullptr);
 #endif
         return obj;
-      });
+      })
+      // The DLPack tensor shares the buffer, and keeps it alive, without a copy on any device
+      .def("to_dlpack", [](OrtValue* ml_value) -> py::object {
+        return ToDlpack(*ml_value);
+      })
+      // Factory method to create an OrtValue (Tensor) that shares the buffer of a DLPack capsule, e.g. from
+      // torch.utils.dlpack.to_dlpack or cupy.ndarray.toDlpack. The OrtValue takes ownership of the capsule's tensor.
+      .def_static(
+          "from_dlpack", [](py::object capsule, bool is_bool_tensor) {
+            return onnxruntime::make_unique<OrtValue>(FromDlpack(capsule, is_bool_tensor));
+          },
+          py::arg("capsule"), py::arg("is_bool_tensor") = false);
 
   py::class_<SessionIOBinding> session_io_binding(m, "SessionIOBinding");
   session_io_binding
@@ -1374,12 +1452,14 @@ void addObjectMethods(py::module& m, Environment& env) {
           throw std::runtime_error("Error when binding output: " + status.ErrorMessage());
         }
       })
-      .def("bind_output", [](SessionIOBinding* io_binding, const std::string& name, const OrtDevice& device) -> void {
-        auto status = io_binding->Get()->BindOutput(name, device);
-        if (!status.IsOK()) {
-          throw std::runtime_error("Error when binding output: " + status.ErrorMessage());
-        }
-      })
+      .def(
+          "bind_output", [](SessionIOBinding* io_binding, const std::string& name, const OrtDevice& device, bool reuse_buffer) -> void {
+            auto status = io_binding->Get()->BindOutput(name, device, reuse_buffer);
+            if (!status.IsOK()) {
+              throw std::runtime_error("Error when binding output: " + status.ErrorMessage());
+            }
+          },
+          py::arg("name"), py::arg("device"), py::arg("reuse_buffer") = false)
       .def("bind_ortvalue_output", [](SessionIOBinding* io_binding, const std::string& name, OrtValue& ml_value) -> void {
         auto status = io_binding->Get()->BindOutput(name, ml_value);
         if (!status.IsOK()) {
@@ -1586,7 +1666,42 @@ RunOptions instance. The individual calls will exit gracefully and return an err
                      R"pbdoc(Choose to run in training or inferencing mode)pbdoc")
 #endif
       .def_readwrite("only_execute_path_to_fetches", &RunOptions::only_execute_path_to_fetches,
-                     R"pbdoc(Only execute the nodes needed by fetch list)pbdoc");
+                     R"pbdoc(Only execute the nodes needed by fetch list)pbdoc")
+      .def_readwrite("intra_op_num_threads", &RunOptions::intra_op_num_threads,
+                     R"pbdoc(Maximum number of intra-op threads, including the calling thread, used by this Run().
+Default is 0, which uses all the threads of the session's intra-op thread pool.)pbdoc")
+      .def_readwrite("timeout_ms", &RunOptions::timeout_ms,
+                     R"pbdoc(Maximum duration in milliseconds of this Run(). The run fails once it passes, and is
+rejected before it runs if the session is busy and its runs took longer on average. Default is 0, for no timeout.)pbdoc")
+      .def_property(
+          "enable_latency_breakdown",
+          [](const RunOptions* options) -> bool { return options->latency_breakdown != nullptr; },
+          [](RunOptions* options, bool enable) -> void {
+            if (!enable) {
+              options->latency_breakdown.reset();
+            } else if (!options->latency_breakdown) {
+              options->latency_breakdown = std::make_shared<RunLatencyBreakdownRecord>();
+            }
+          },
+          R"pbdoc(Set to True to collect where the time of the Run() calls using this RunOptions instance goes,
+without enabling profiling. Default is False.)pbdoc")
+      .def(
+          "get_latency_breakdown",
+          [](const RunOptions* options) -> std::string {
+            if (!options->latency_breakdown) {
+              throw std::runtime_error("The latency breakdown is not enabled for this RunOptions instance.");
+            }
+
+            RunLatencyBreakdown breakdown;
+            if (!options->latency_breakdown->Get(breakdown)) {
+              throw std::runtime_error("No run using this RunOptions instance completed yet.");
+            }
+
+            return breakdown.ToJson();
+          },
+          R"pbdoc(Returns the latency breakdown of the last completed Run() call as a JSON string, with the durations
+in microseconds: validation, input copies, frame setup, kernel time per execution provider, memcpy nodes,
+output copies and the inter-op thread pool wait.)pbdoc");
 
   py::class_<ModelMetadata>(m, "ModelMetadata", R"pbdoc(Pre-defined and custom metadata about the model.
 It is usually used to identify the model used to run the prediction and
@@ -1706,17 +1821,7 @@ including arg name, arg type (contains both type and shape).)pbdoc")
            [](PyInferenceSession* sess, std::vector<std::string> output_names,
               std::map<std::string, py::object> pyfeeds, RunOptions* run_options = nullptr)
                -> std::vector<py::object> {
-             NameMLValMap feeds;
-             for (auto _ : pyfeeds) {
-               OrtValue ml_value;
-               auto px = sess->GetSessionHandle()->GetModelInputs();
-               if (!px.first.IsOK() || !px.second) {
-                 throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
-               }
-               CreateGenericMLValue(px.second, GetAllocator(), _.first, _.second, &ml_value);
-               ThrowIfPyErrOccured();
-               feeds.insert(std::make_pair(_.first, ml_value));
-             }
+             NameMLValMap feeds = CreateFeeds(sess, pyfeeds);
 
              std::vector<OrtValue> fetches;
              common::Status status;
@@ -1742,9 +1847,144 @@ including arg name, arg type (contains both type and shape).)pbdoc")
              }
              return rfetch;
            })
+      .def("run_with_outputs",
+           [](PyInferenceSession* sess, std::vector<std::string> output_names,
+              std::map<std::string, py::object> pyfeeds, std::vector<py::object> outputs,
+              RunOptions* run_options = nullptr) -> std::vector<py::object> {
+             if (outputs.size() != output_names.size()) {
+               throw std::runtime_error("The number of preallocated outputs must match the number of output names.");
+             }
+
+             NameMLValMap feeds = CreateFeeds(sess, pyfeeds);
+
+             // the fetches without a preallocated output are allocated by the run
+             std::vector<OrtValue> fetches(output_names.size());
+             for (size_t i = 0; i < outputs.size(); ++i) {
+               if (!outputs[i].is_none()) {
+                 CreatePreallocatedFetch(sess, output_names[i], outputs[i], fetches[i]);
+               }
+             }
+
+             {
+               // release GIL to allow multiple python threads to invoke Run() in parallel.
+               py::gil_scoped_release release;
+               if (run_options != nullptr) {
+                 OrtPybindThrowIfError(sess->GetSessionHandle()->Run(*run_options, feeds, output_names, &fetches));
+               } else {
+                 OrtPybindThrowIfError(sess->GetSessionHandle()->Run(feeds, output_names, &fetches));
+               }
+             }
+
+             std::vector<py::object> rfetch;
+             rfetch.reserve(fetches.size());
+             for (size_t i = 0; i < fetches.size(); ++i) {
+               if (outputs[i].is_none()) {
+                 if (fetches[i].IsTensor()) {
+                   AddTensorAsPyObj(fetches[i], rfetch, nullptr, nullptr);
+                 } else {
+                   AddNonTensorAsPyObj(fetches[i], rfetch, nullptr, nullptr);
+                 }
+                 continue;
+               }
+
+               if (PyArray_Check(outputs[i].ptr())) {
+                 // an output that is also an input or an initializer may not have been written into the array
+                 auto* arr = reinterpret_cast<PyArrayObject*>(outputs[i].ptr());
+                 const Tensor& tensor = fetches[i].Get<Tensor>();
+                 if (tensor.DataRaw() != PyArray_DATA(arr)) {
+                   if (tensor.Location().device.Type() != OrtDevice::CPU ||
+                       tensor.SizeInBytes() != static_cast<size_t>(PyArray_NBYTES(arr))) {
+                     throw std::runtime_error("The output '" + output_names[i] +
+                                              "' could not be written into the preallocated array.");
+                   }
+                   memcpy(PyArray_DATA(arr), tensor.DataRaw(), tensor.SizeInBytes());
+                 }
+               }
+
+               rfetch.push_back(outputs[i]);
+             }
+
+             return rfetch;
+           })
+      // Schedules the run on the session's intra-op thread pool and returns. callback(outputs, error) is invoked on
+      // the thread that ran it with the list of outputs, or None and the error message if the run failed.
+      .def("run_async",
+           [](PyInferenceSession* sess, std::vector<std::string> output_names,
+              std::map<std::string, py::object> pyfeeds, py::function callback, py::object run_options) -> void {
+             NameMLValMap feeds = CreateFeeds(sess, pyfeeds);
+             std::vector<std::string> feed_names;
+             std::vector<OrtValue> feed_values;
+             feed_names.reserve(feeds.size());
+             feed_values.reserve(feeds.size());
+             for (auto& feed : feeds) {
+               feed_names.push_back(feed.first);
+               feed_values.push_back(feed.second);
+             }
+
+             // The Python objects the run uses, which must outlive it: the numpy arrays whose buffers the feeds
+             // use, and the run options. The callback releases them while it holds the GIL.
+             struct PyAsyncRun {
+               py::function callback;
+               std::map<std::string, py::object> pyfeeds;
+               py::object run_options_obj;
+               RunOptions default_run_options;
+             };
+
+             auto async_run = std::make_shared<PyAsyncRun>();
+             async_run->callback = std::move(callback);
+             async_run->pyfeeds = std::move(pyfeeds);
+             async_run->run_options_obj = run_options;
+             const RunOptions& options = run_options.is_none() ? async_run->default_run_options
+                                                               : *run_options.cast<RunOptions*>();
+
+             auto on_completion = [async_run](const common::Status& status, std::vector<OrtValue>& fetches) {
+               py::gil_scoped_acquire acquire;
+               try {
+                 if (status.IsOK()) {
+                   std::vector<py::object> rfetch;
+                   rfetch.reserve(fetches.size());
+                   for (auto& fetch : fetches) {
+                     if (fetch.IsTensor()) {
+                       AddTensorAsPyObj(fetch, rfetch, nullptr, nullptr);
+                     } else {
+                       AddNonTensorAsPyObj(fetch, rfetch, nullptr, nullptr);
+                     }
+                   }
+                   async_run->callback(rfetch, py::none());
+                 } else {
+                   async_run->callback(py::none(), status.ErrorMessage());
+                 }
+               } catch (py::error_already_set& e) {
+                 e.discard_as_unraisable("run_async callback");
+               } catch (const std::exception& e) {
+                 try {
+                   async_run->callback(py::none(), std::string(e.what()));
+                 } catch (py::error_already_set& callback_error) {
+                   callback_error.discard_as_unraisable("run_async callback");
+                 }
+               }
+
+               async_run->callback = py::function();
+               async_run->pyfeeds.clear();
+               async_run->run_options_obj = py::object();
+             };
+
+             OrtPybindThrowIfError(sess->GetSessionHandle()->RunAsync(options, std::move(feed_names),
+                                                                      std::move(feed_values), output_names,
+                                                                      std::vector<OrtValue>(output_names.size()),
+                                                                      std::move(on_completion)));
+           },
+           py::arg("output_names"), py::arg("feeds"), py::arg("callback"), py::arg("run_options") = py::none())
       .def("end_profiling", [](PyInferenceSession* sess) -> std::string {
         return sess->GetSessionHandle()->EndProfiling();
       })
+      .def(
+          "get_calibration_stats", [](const PyInferenceSession* sess, bool reset) -> std::string {
+            std::string stats_json;
+            OrtPybindThrowIfError(sess->GetSessionHandle()->GetCalibrationStats(stats_json, reset));
+            return stats_json;
+          },
+          py::arg("reset") = false)
       .def_property_readonly("get_profiling_start_time_ns", [](const PyInferenceSession* sess) -> uint64_t {
         return sess->GetSessionHandle()->GetProfiling().GetStartTimeNs();
       })
@@ -1780,6 +2020,8 @@ including arg name, arg type (contains both type and shape).)pbdoc")
       })
       .def("run_with_iobinding", [](PyInferenceSession* sess, SessionIOBinding& io_binding, RunOptions* run_options = nullptr) -> void {
         Status status;
+        // release GIL to allow multiple python threads to invoke Run() in parallel.
+        py::gil_scoped_release release;
         if (!run_options)
           status = sess->GetSessionHandle()->Run(*io_binding.Get());
         else
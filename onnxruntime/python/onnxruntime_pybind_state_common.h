@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <pybind11/pybind11.h>
+
 #include "core/common/logging/logging.h"
 #include "core/common/logging/sinks/cerr_sink.h"
 #include "core/framework/allocator.h"
@@ -71,7 +73,11 @@ struct PyInferenceSession {
 
   InferenceSession* GetSessionHandle() const { return sess_.get(); }
 
-  virtual ~PyInferenceSession() {}
+  virtual ~PyInferenceSession() {
+    // the session waits for the pending runs of run_async, whose callbacks take the GIL
+    pybind11::gil_scoped_release release;
+    sess_.reset();
+  }
 
  protected:
   PyInferenceSession(std::unique_ptr<InferenceSession> sess) {
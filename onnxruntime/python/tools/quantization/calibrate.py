@@ -58,6 +58,7 @@ class ONNXCalibrater:
         self.augmented_model_path = augmented_model_path
         self.input_name_to_nodes = {}
         self.calibration_cache = {}  # save temporary calibration table
+        self.calibration_stats = {}  # statistics recorded by onnxruntime, see collect_calibration_stats
 
     def set_data_reader(self, data_reader):
         self.data_reader = data_reader
@@ -65,22 +66,17 @@ class ONNXCalibrater:
     def get_calibration_cache(self):
         return self.calibration_cache
 
-    def augment_graph(self):
+    def select_tensors_to_calibrate(self, model):
         '''
-        Adds ReduceMin and ReduceMax nodes to all quantization_candidates op type nodes in
-        model and ensures their outputs are stored as part of the graph output
-        :return: augmented ONNX model
+        Select the float inputs and outputs of the nodes to calibrate, which are not initializers
+        :param model: the model to calibrate, with the inferred shapes
+        :return: set of tensor names
         '''
-        model = onnx_proto.ModelProto()
-        model.CopyFrom(self.model)
-        model = onnx.shape_inference.infer_shapes(model)
         value_infos = {vi.name: vi for vi in model.graph.value_info}
         value_infos.update({ot.name: ot for ot in model.graph.output})
         value_infos.update({it.name: it for it in model.graph.input})
         initializer = set(init.name for init in model.graph.initializer)
 
-        added_nodes = []
-        added_outputs = []
         tensors_to_calibrate = set()
         tensor_type_to_calibrate = set([TensorProto.FLOAT, TensorProto.FLOAT16])
 
@@ -94,6 +90,22 @@ class ONNXCalibrater:
                         if vi.type.HasField('tensor_type') and (vi.type.tensor_type.elem_type in tensor_type_to_calibrate) and (tensor_name not in initializer):
                             tensors_to_calibrate.add(tensor_name)
 
+        return tensors_to_calibrate
+
+    def augment_graph(self):
+        '''
+        Adds ReduceMin and ReduceMax nodes to all quantization_candidates op type nodes in
+        model and ensures their outputs are stored as part of the graph output
+        :return: augmented ONNX model
+        '''
+        model = onnx_proto.ModelProto()
+        model.CopyFrom(self.model)
+        model = onnx.shape_inference.infer_shapes(model)
+
+        added_nodes = []
+        added_outputs = []
+        tensors_to_calibrate = self.select_tensors_to_calibrate(model)
+
         # If augmenting all ops, it's possible that some nodes' input value are 0.
         # Can't reduce on dim with value of 0 if 'keepdims' is false, therefore set keepdims to 1.
         if self.calibrate_op_types:
@@ -208,6 +220,49 @@ class ONNXCalibrater:
 
         return final_dict
 
+    def collect_calibration_stats(self, providers=None, ort_graph_optimization_enable=False):
+        '''
+        Gather the (min, max) pairs of the tensors to calibrate from the calibration statistics onnxruntime records
+        while it runs the original model, instead of adding outputs to the model and pulling every intermediate tensor
+        to numpy. The statistics also include the histograms and entropy calibrated thresholds of the tensors, which
+        are kept in self.calibration_stats.
+        parameter providers: Onnxruntime execution providers
+        parameter ort_graph_optimization_enable: Enable the basic OnnxRuntime graph optimizations, default = False.
+                                                 The tensors the optimizations remove are not calibrated.
+        :return: dictionary mapping: {tensor names: (min, max) pairs}
+        '''
+        tensors_to_calibrate = self.select_tensors_to_calibrate(onnx.shape_inference.infer_shapes(self.model))
+
+        sess_options = onnxruntime.SessionOptions()
+        if ort_graph_optimization_enable:
+            sess_options.graph_optimization_level = onnxruntime.GraphOptimizationLevel.ORT_ENABLE_BASIC
+        else:
+            sess_options.graph_optimization_level = onnxruntime.GraphOptimizationLevel.ORT_DISABLE_ALL
+        sess_options.add_session_config_entry('session.calibration.tensor_names', ';'.join(sorted(tensors_to_calibrate)))
+        session = onnxruntime.InferenceSession(self.model.SerializeToString(),
+                                               sess_options=sess_options,
+                                               providers=providers)
+
+        while True:
+            inputs = self.data_reader.get_next()
+            if not inputs:
+                break
+            session.run(None, inputs)
+
+        self.calibration_stats = session.get_calibration_stats()
+        final_dict = {name: (stats['min'], stats['max']) for name, stats in self.calibration_stats.items()}
+
+        # merge new calibration data with previous calibration data
+        for key, value in self.calibration_cache.items():
+            if key in final_dict:
+                final_dict[key] = (min(value[0], final_dict[key][0]), max(value[1], final_dict[key][1]))
+            else:
+                final_dict[key] = value
+
+        self.calibration_cache = final_dict
+
+        return final_dict
+
     def _get_input_name_to_nodes(self, model):
         '''
             Helper function to get input_name_to_nodes dictionary
@@ -367,7 +422,8 @@ def calibrate(model,
               augmented_model_path='augmented_model.onnx',
               providers=["CPUExecutionProvider"],
               ort_graph_optimization_enable=True,
-              quantization_params_calculation_enable=True):
+              quantization_params_calculation_enable=True,
+              collect_in_runtime=False):
     '''
     Given an onnx model, augment and run the augmented model on calibration data set, aggregate and calculate the quantization parameters.
     :param model: ONNX model to calibrate. It can be a ModelProto or a model path
@@ -379,14 +435,21 @@ def calibrate(model,
     :param providers: execution providers to run calibration
     :param ort_graph_optimization_enable: enable all OnnxRuntime graph optimizations, default = True
     :param quantization_params_calculation_enable: enable quantization parameter calculation, default = True 
+    :param collect_in_runtime: collect the thresholds with the calibration statistics onnxruntime records while it runs
+                               the model, without augmenting it, default = False. The graph optimizations are then
+                               disabled, as they could remove tensors to calibrate.
     '''
     #1. initialize a calibrater
     calibrater = ONNXCalibrater(model, data_reader, op_types, black_nodes, white_nodes, augmented_model_path)
-    #2. augment
-    augmented_model = calibrater.augment_graph()
-    onnx.save(augmented_model, augmented_model_path)
-    #3. generate quantization thresholds
-    dict_for_quantization = calibrater.get_intermediate_outputs(providers=providers, ort_graph_optimization_enable=ort_graph_optimization_enable)
+    if collect_in_runtime:
+        #2-3. generate quantization thresholds while running the model
+        dict_for_quantization = calibrater.collect_calibration_stats(providers=providers)
+    else:
+        #2. augment
+        augmented_model = calibrater.augment_graph()
+        onnx.save(augmented_model, augmented_model_path)
+        #3. generate quantization thresholds
+        dict_for_quantization = calibrater.get_intermediate_outputs(providers=providers, ort_graph_optimization_enable=ort_graph_optimization_enable)
     #4. generate quantization parameters dict
     quantization_params_dict = {}    
     if quantization_params_calculation_enable:
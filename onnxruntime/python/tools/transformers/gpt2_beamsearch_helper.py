@@ -0,0 +1,386 @@
+# -------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation.  All rights reserved.
+# Licensed under the MIT License.  See License.txt in the project root for
+# license information.
+# --------------------------------------------------------------------------
+# This script helps onnx conversion and inference for GPT-2 model with one step of beam search in the graph.
+#
+# Each step of generation with the plain GPT2LMHeadModel returns logits of shape (batch_size, seq_len, vocab_size).
+# They have to be copied to host, and log softmax, top k and beam reordering of past state are done in python.
+# The model exported here runs those in onnxruntime instead, so only the selected tokens and their scores are
+# returned by each step.
+import logging
+import numpy
+import time
+import torch
+from pathlib import Path
+from typing import List, Dict
+from transformers import GPT2LMHeadModel, GPT2Config
+from gpt2_helper import Gpt2Helper, Gpt2Inputs
+
+logger = logging.getLogger(__name__)
+
+# Log probability used for beams that shall never be selected. It is not -inf so that float16 stays finite.
+BEAM_SEARCH_LOG_PROB_MIN = -1e4
+
+
+class MyGPT2LMHeadModel_BeamSearchStep(GPT2LMHeadModel):
+    """ Here we wrap a class for Onnx model conversion for GPT2LMHeadModel with past state and one step of beam search.
+        Beams are flattened into the batch dimension, so batch_size * beam_size is the batch size of GPT-2.
+    """
+    def __init__(self, config):
+        super().__init__(config)
+
+    def forward(self, input_ids, position_ids, attention_mask, beam_select_idx, input_log_probs,
+                input_unfinished_sents, prev_step_results, *past):
+        batch_size = input_log_probs.size(0)
+        beam_size = input_log_probs.size(1)
+
+        # Past state and results are stored in the order of beams selected by previous step.
+        past = [past_i.index_select(1, beam_select_idx) for past_i in past]
+        prev_step_results = prev_step_results.index_select(0, beam_select_idx)
+
+        outputs = super().forward(input_ids,
+                                  position_ids=position_ids,
+                                  attention_mask=attention_mask,
+                                  past_key_values=past)
+        logits = outputs[0]
+        present = outputs[1]
+
+        log_probs = torch.log_softmax(logits[:, -1, :], dim=-1)
+        vocab_size = log_probs.size(-1)
+        log_probs = log_probs.view(batch_size, beam_size, vocab_size)
+
+        # A finished beam can only be extended by end of sentence with unchanged score.
+        is_eos = torch.eq(torch.arange(vocab_size, device=log_probs.device), self.config.eos_token_id)
+        eos_log_probs = torch.where(is_eos, torch.zeros_like(log_probs),
+                                    torch.full_like(log_probs, BEAM_SEARCH_LOG_PROB_MIN))
+        unfinished = input_unfinished_sents.unsqueeze(-1)
+        log_probs = torch.where(unfinished, log_probs, eos_log_probs)
+
+        scores = (input_log_probs.unsqueeze(-1) + log_probs).view(batch_size, beam_size * vocab_size)
+        output_log_probs, selected = torch.topk(scores, beam_size, dim=-1)
+
+        selected_beams = selected // vocab_size
+        next_token_ids = selected % vocab_size
+
+        output_unfinished_sents = input_unfinished_sents.gather(1, selected_beams) & torch.ne(
+            next_token_ids, self.config.eos_token_id)
+
+        beam_offsets = (torch.arange(batch_size, dtype=selected_beams.dtype, device=selected_beams.device) *
+                        beam_size).unsqueeze(-1)
+        output_beam_select_idx = (selected_beams + beam_offsets).view(-1)
+
+        output_step_results = torch.cat(
+            [prev_step_results.index_select(0, output_beam_select_idx),
+             next_token_ids.view(-1, 1)], dim=-1)
+
+        return (next_token_ids, output_log_probs, output_unfinished_sents, output_beam_select_idx,
+                output_step_results) + tuple(present)
+
+
+class Gpt2BeamSearchInputs(Gpt2Inputs):
+    def __init__(self, input_ids, position_ids, attention_mask, past, beam_select_idx, input_log_probs,
+                 input_unfinished_sents, prev_step_results):
+        super().__init__(input_ids, position_ids, attention_mask, past)
+        self.beam_select_idx: torch.LongTensor = beam_select_idx
+        self.input_log_probs: torch.FloatTensor = input_log_probs
+        self.input_unfinished_sents: torch.BoolTensor = input_unfinished_sents
+        self.prev_step_results: torch.LongTensor = prev_step_results
+
+    def to_list(self) -> List:
+        input_list = [
+            self.input_ids, self.position_ids, self.attention_mask, self.beam_select_idx, self.input_log_probs,
+            self.input_unfinished_sents, self.prev_step_results
+        ]
+        if self.past:
+            input_list.extend(self.past)
+
+        return input_list
+
+
+BEAM_SEARCH_INPUT_NAMES = [
+    'input_ids', 'position_ids', 'attention_mask', 'beam_select_idx', 'input_log_probs', 'input_unfinished_sents',
+    'prev_step_results'
+]
+
+BEAM_SEARCH_OUTPUT_NAMES = [
+    'next_token_ids', 'output_log_probs', 'output_unfinished_sents', 'output_beam_select_idx', 'output_step_results'
+]
+
+
+class Gpt2BeamSearchHelper(Gpt2Helper):
+    """ A helper class for conversion and inference of GPT-2 model with one step of beam search.
+    """
+    @staticmethod
+    def get_initial_inputs(input_ids: torch.LongTensor,
+                           attention_mask: torch.FloatTensor,
+                           beam_size: int,
+                           num_attention_heads: int,
+                           hidden_size: int,
+                           num_layer: int,
+                           float16: bool = False) -> Gpt2BeamSearchInputs:
+        """ Create inputs of the first step from prompt input_ids and attention_mask of shape (batch_size, seq_len).
+        """
+        batch_size = input_ids.size(0)
+        device = input_ids.device
+        float_type = torch.float16 if float16 else torch.float32
+
+        # Every beam starts from the same prompt.
+        input_ids = input_ids.repeat_interleave(beam_size, dim=0)
+        attention_mask = attention_mask.to(float_type).repeat_interleave(beam_size, dim=0)
+        position_ids = (attention_mask.long().cumsum(-1) - 1)
+        position_ids.masked_fill_(position_ids < 0, 0)
+
+        past_shape = [2, batch_size * beam_size, num_attention_heads, 0, int(hidden_size / num_attention_heads)]
+        past = [torch.empty(past_shape, dtype=float_type, device=device) for _ in range(num_layer)]
+
+        beam_select_idx = torch.arange(batch_size * beam_size, dtype=torch.int64, device=device)
+
+        # Only the first beam is alive at the start, otherwise top k would select the same token beam_size times.
+        input_log_probs = torch.full((batch_size, beam_size), BEAM_SEARCH_LOG_PROB_MIN, dtype=float_type, device=device)
+        input_log_probs[:, 0] = 0
+        input_unfinished_sents = torch.ones((batch_size, beam_size), dtype=torch.bool, device=device)
+        prev_step_results = torch.empty((batch_size * beam_size, 0), dtype=torch.int64, device=device)
+
+        return Gpt2BeamSearchInputs(input_ids, position_ids, attention_mask, past, beam_select_idx, input_log_probs,
+                                    input_unfinished_sents, prev_step_results)
+
+    @staticmethod
+    def get_next_inputs(inputs: Gpt2BeamSearchInputs, outputs: List[torch.Tensor]) -> Gpt2BeamSearchInputs:
+        """ Create inputs of next step from inputs and outputs (in the order of exported outputs) of current step.
+        """
+        next_token_ids, output_log_probs, output_unfinished_sents, output_beam_select_idx, output_step_results = outputs[:5]
+        present = outputs[5:]
+
+        input_ids = next_token_ids.view(-1, 1)
+        position_ids = inputs.position_ids[:, -1:] + 1
+
+        # Beams of a sentence share the same padding so attention_mask need not be reordered.
+        attention_mask = torch.cat([inputs.attention_mask, inputs.attention_mask.new_ones((input_ids.size(0), 1))], -1)
+
+        return Gpt2BeamSearchInputs(input_ids, position_ids, attention_mask, list(present), output_beam_select_idx,
+                                    output_log_probs, output_unfinished_sents, output_step_results)
+
+    @staticmethod
+    def get_dummy_inputs(batch_size: int,
+                         beam_size: int,
+                         past_sequence_length: int,
+                         sequence_length: int,
+                         num_attention_heads: int,
+                         hidden_size: int,
+                         num_layer: int,
+                         vocab_size: int,
+                         device: torch.device,
+                         float16: bool = False) -> Gpt2BeamSearchInputs:
+        """ Create random inputs for GPT-2 model with one step of beam search.
+        """
+        inputs = Gpt2Helper.get_dummy_inputs(batch_size * beam_size, past_sequence_length, sequence_length,
+                                             num_attention_heads, hidden_size, num_layer, vocab_size, device, float16)
+        float_type = torch.float16 if float16 else torch.float32
+
+        beam_select_idx = torch.randint(low=0,
+                                        high=batch_size * beam_size,
+                                        size=(batch_size * beam_size, ),
+                                        dtype=torch.int64,
+                                        device=device)
+        input_log_probs = -torch.rand((batch_size, beam_size), dtype=float_type, device=device)
+        input_unfinished_sents = torch.ones((batch_size, beam_size), dtype=torch.bool, device=device)
+        prev_step_results = torch.randint(low=0,
+                                          high=vocab_size - 1,
+                                          size=(batch_size * beam_size, past_sequence_length),
+                                          dtype=torch.int64,
+                                          device=device)
+
+        return Gpt2BeamSearchInputs(inputs.input_ids, inputs.position_ids, inputs.attention_mask, inputs.past,
+                                    beam_select_idx, input_log_probs, input_unfinished_sents, prev_step_results)
+
+    @staticmethod
+    def get_output_shapes(batch_size: int, beam_size: int, past_sequence_length: int, sequence_length: int,
+                          config: GPT2Config) -> Dict[str, List[int]]:
+        """ Returns a dictionary with output name as key, and shape as value.
+        """
+        num_attention_heads = config.num_attention_heads
+        hidden_size = config.hidden_size
+
+        output_shapes = {
+            'next_token_ids': [batch_size, beam_size],
+            'output_log_probs': [batch_size, beam_size],
+            'output_unfinished_sents': [batch_size, beam_size],
+            'output_beam_select_idx': [batch_size * beam_size],
+            'output_step_results': [batch_size * beam_size, past_sequence_length + 1]
+        }
+
+        present_state_shape = [
+            2, batch_size * beam_size, num_attention_heads, past_sequence_length + sequence_length,
+            int(hidden_size / num_attention_heads)
+        ]
+        for i in range(config.num_hidden_layers):
+            output_shapes["present_" + str(i)] = present_state_shape
+
+        return output_shapes
+
+    @staticmethod
+    def export_onnx(model,
+                    device,
+                    onnx_model_path: str,
+                    verbose: bool = False,
+                    use_external_data_format: bool = False,
+                    beam_size: int = 4):
+        """ Export GPT-2 model with past state and one step of beam search to ONNX model.
+        """
+        config: GPT2Config = model.config
+        num_layer = config.n_layer
+        dummy_inputs = Gpt2BeamSearchHelper.get_dummy_inputs(batch_size=1,
+                                                             beam_size=beam_size,
+                                                             past_sequence_length=1,
+                                                             sequence_length=1,
+                                                             num_attention_heads=config.num_attention_heads,
+                                                             hidden_size=config.hidden_size,
+                                                             num_layer=num_layer,
+                                                             vocab_size=config.vocab_size,
+                                                             device=device,
+                                                             float16=False)
+        input_list = dummy_inputs.to_list()
+
+        with torch.no_grad():
+            outputs = model(*input_list)
+
+        past_names = [f'past_{i}' for i in range(num_layer)]
+        present_names = [f'present_{i}' for i in range(num_layer)]
+        input_names = BEAM_SEARCH_INPUT_NAMES + past_names
+        output_names = BEAM_SEARCH_OUTPUT_NAMES + present_names
+
+        # Shape of input tensors:
+        #    input_ids: (batch_size * beam_size, seq_len)
+        #    beam_select_idx: (batch_size * beam_size)
+        #    input_log_probs, input_unfinished_sents: (batch_size, beam_size)
+        #    prev_step_results: (batch_size * beam_size, past_seq_len)
+        #    past_{i}:  (2, batch_size * beam_size, num_heads, past_seq_len, hidden_size/num_heads)
+        # Shape of output tensors:
+        #    next_token_ids, output_log_probs, output_unfinished_sents: (batch_size, beam_size)
+        #    output_beam_select_idx: (batch_size * beam_size)
+        #    output_step_results: (batch_size * beam_size, past_seq_len + 1)
+        #    present_{i}:  (2, batch_size * beam_size, num_heads, past_seq_len + seq_len, hidden_size/num_heads)
+        dynamic_axes = {
+            'input_ids': {
+                0: 'batch_beam_size',
+                1: 'seq_len'
+            },
+            'position_ids': {
+                0: 'batch_beam_size',
+                1: 'seq_len'
+            },
+            'attention_mask': {
+                0: 'batch_beam_size',
+                1: 'total_seq_len'
+            },
+            'beam_select_idx': {
+                0: 'batch_beam_size'
+            },
+            'input_log_probs': {
+                0: 'batch_size',
+                1: 'beam_size'
+            },
+            'input_unfinished_sents': {
+                0: 'batch_size',
+                1: 'beam_size'
+            },
+            'prev_step_results': {
+                0: 'batch_beam_size',
+                1: 'past_seq_len'
+            },
+            'next_token_ids': {
+                0: 'batch_size',
+                1: 'beam_size'
+            },
+            'output_log_probs': {
+                0: 'batch_size',
+                1: 'beam_size'
+            },
+            'output_unfinished_sents': {
+                0: 'batch_size',
+                1: 'beam_size'
+            },
+            'output_beam_select_idx': {
+                0: 'batch_beam_size'
+            },
+            'output_step_results': {
+                0: 'batch_beam_size',
+                1: 'total_step_len'
+            }
+        }
+        for name in past_names:
+            dynamic_axes[name] = {1: 'batch_beam_size', 3: 'past_seq_len'}
+        for name in present_names:
+            dynamic_axes[name] = {1: 'batch_beam_size', 3: 'total_seq_len'}
+
+        logger.info(
+            f"Shapes: input_ids={dummy_inputs.input_ids.shape} past={dummy_inputs.past[0].shape} next_token_ids={outputs[0].shape} present={outputs[5].shape}"
+        )
+
+        Path(onnx_model_path).parent.mkdir(parents=True, exist_ok=True)
+
+        torch.onnx.export(model,
+                          args=tuple(input_list),
+                          f=onnx_model_path,
+                          input_names=input_names,
+                          output_names=output_names,
+                          example_outputs=outputs,
+                          dynamic_axes=dynamic_axes,
+                          opset_version=11,
+                          do_constant_folding=True,
+                          use_external_data_format=use_external_data_format,
+                          verbose=verbose)
+
+    @staticmethod
+    def onnxruntime_inference(ort_session, inputs: Gpt2BeamSearchInputs, total_runs: int = 0):
+        """ Run inference of ONNX model, and returns average latency in ms when total_runs > 0 besides outputs.
+        """
+        logger.debug(f"start onnxruntime_inference")
+
+        ort_inputs = {}
+        for name, value in zip(BEAM_SEARCH_INPUT_NAMES + [f'past_{i}' for i in range(len(inputs.past))],
+                               inputs.to_list()):
+            ort_inputs[name] = numpy.ascontiguousarray(value.cpu().numpy())
+
+        ort_outputs = ort_session.run(None, ort_inputs)
+        if total_runs == 0:
+            return ort_outputs
+
+        latency = []
+        for _ in range(total_runs):
+            start = time.time()
+            ort_outputs = ort_session.run(None, ort_inputs)
+            latency.append(time.time() - start)
+
+        average_latency = sum(latency) * 1000 / len(latency)
+        logger.debug("OnnxRuntime Inference time = {} ms".format(format(average_latency, '.2f')))
+
+        return ort_outputs, average_latency
+
+    @staticmethod
+    def generate(ort_session,
+                 input_ids: torch.LongTensor,
+                 attention_mask: torch.FloatTensor,
+                 config: GPT2Config,
+                 beam_size: int = 4,
+                 max_length: int = 32,
+                 float16: bool = False):
+        """ Run beam search with given prompt of shape (batch_size, seq_len) until all beams reach end of sentence or
+            max_length tokens are generated. Returns generated tokens of shape (batch_size, beam_size, length), and
+            log probabilities of shape (batch_size, beam_size). Beams of each sentence are sorted from the best.
+        """
+        batch_size = input_ids.size(0)
+        inputs = Gpt2BeamSearchHelper.get_initial_inputs(input_ids.cpu(), attention_mask.cpu(), beam_size,
+                                                         config.num_attention_heads, config.hidden_size,
+                                                         config.n_layer, float16)
+        for step in range(max_length):
+            ort_outputs = Gpt2BeamSearchHelper.onnxruntime_inference(ort_session, inputs)
+            outputs = [torch.from_numpy(output) for output in ort_outputs]
+            inputs = Gpt2BeamSearchHelper.get_next_inputs(inputs, outputs)
+            if not inputs.input_unfinished_sents.any():
+                logger.debug(f"all beams finished at step {step}")
+                break
+
+        return inputs.prev_step_results.view(batch_size, beam_size, -1), inputs.input_log_probs
@@ -0,0 +1,73 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/latency_histogram.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+using profiling::LatencyHistogram;
+
+TEST(LatencyHistogramTest, BucketsAreContiguous) {
+  for (int i = 0; i < LatencyHistogram::kNumBuckets - 1; ++i) {
+    const uint64_t lower = LatencyHistogram::BucketLowerBound(i);
+    const uint64_t upper = LatencyHistogram::BucketLowerBound(i + 1) - 1;
+    EXPECT_EQ(LatencyHistogram::BucketIndex(lower), i);
+    EXPECT_EQ(LatencyHistogram::BucketIndex(upper), i);
+  }
+
+  EXPECT_EQ(LatencyHistogram::BucketIndex(UINT64_MAX), LatencyHistogram::kNumBuckets - 1);
+}
+
+TEST(LatencyHistogramTest, Percentiles) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.Percentile(0.5), 0u);
+
+  // 1us to 1000us
+  for (uint64_t i = 1; i <= 1000; ++i) {
+    histogram.Record(i * 1000);
+  }
+
+  EXPECT_EQ(histogram.Count(), 1000u);
+  EXPECT_EQ(histogram.SumNs(), 500500u * 1000);
+
+  // the relative error is bounded by the width of the buckets
+  const double max_error = 1.0 / LatencyHistogram::kSubBuckets;
+  EXPECT_NEAR(histogram.Percentile(0.5), 500 * 1000, 500 * 1000 * max_error);
+  EXPECT_NEAR(histogram.Percentile(0.99), 990 * 1000, 990 * 1000 * max_error);
+  EXPECT_NEAR(histogram.Percentile(0.0), 1000, 1000 * max_error);
+
+  histogram.Reset();
+  EXPECT_EQ(histogram.Count(), 0u);
+  EXPECT_EQ(histogram.Percentile(0.99), 0u);
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecord) {
+  LatencyHistogram histogram;
+  constexpr int kNumThreads = 4;
+  constexpr int kNumRecords = 10000;
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&histogram]() {
+      for (int i = 0; i < kNumRecords; ++i) {
+        histogram.Record(100);
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(histogram.Count(), static_cast<uint64_t>(kNumThreads * kNumRecords));
+  EXPECT_NEAR(histogram.Percentile(0.5), 100, 100.0 / LatencyHistogram::kSubBuckets);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -142,6 +142,37 @@ TEST_F(LoggingTestsFixture, TestLoggerFiltering) {
   VLOGS(*logger, 2) << "VLOG enabled up to " << max_vlog_level;
 }
 
+/// <summary>
+/// Tests that the arguments of a filtered message are not evaluated, and that a change of the severity of a logger
+/// applies to the next message.
+/// </summary>
+TEST_F(LoggingTestsFixture, TestFilteredMessageIsNotFormatted) {
+  const std::string logid{"TestFilteredMessageIsNotFormatted"};
+
+  MockSink* sink_ptr = new MockSink();
+  EXPECT_CALL(*sink_ptr, SendImpl(testing::_, HasSubstr(logid), testing::_))
+      .Times(LOG_SEVERITY_COMPILED_IN(INFO) ? 1 : 0)
+      .WillRepeatedly(PrintArgs());
+
+  LoggingManager manager{std::unique_ptr<ISink>(sink_ptr), Severity::kWARNING, false, InstanceType::Temporal};
+  auto logger = manager.CreateLogger(logid);
+
+  int num_evaluations = 0;
+  auto expensive_argument = [&num_evaluations]() {
+    ++num_evaluations;
+    return std::string("formatted");
+  };
+
+  LOGS(*logger, INFO) << expensive_argument();
+  LOGF(*logger, VERBOSE, "%s", expensive_argument().c_str());
+  EXPECT_EQ(num_evaluations, 0);
+
+  logger->SetSeverity(Severity::kINFO);
+  EXPECT_EQ(logger->GetSeverity(), Severity::kINFO);
+  LOGS(*logger, INFO) << expensive_argument();
+  EXPECT_EQ(num_evaluations, LOG_SEVERITY_COMPILED_IN(INFO) ? 1 : 0);
+}
+
 /// <summary>
 /// Tests that the logging manager constructor validates its usage correctly.
 /// </summary>
@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/trace_sink.h"
+
+#include <string>
+#include <vector>
+
+#include "core/common/make_unique.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+class RecordingTraceSink : public tracing::ITraceSink {
+ public:
+  explicit RecordingTraceSink(std::vector<std::string>& events) : events_(events) {}
+
+  void Begin(tracing::Category category, const char* name, const char* detail) override {
+    events_.push_back(std::string("B:") + tracing::CategoryName(category) + ":" + name + ":" + (detail ? detail : ""));
+  }
+
+  void End(tracing::Category category, const char* name) override {
+    events_.push_back(std::string("E:") + tracing::CategoryName(category) + ":" + name);
+  }
+
+  void Instant(tracing::Category category, const char* name, int64_t value) override {
+    events_.push_back(std::string("i:") + tracing::CategoryName(category) + ":" + name + ":" + std::to_string(value));
+  }
+
+ private:
+  std::vector<std::string>& events_;
+};
+}  // namespace
+
+TEST(TraceSinkTest, RangesAndInstants) {
+  // leave a sink set from the environment with ORT_TRACE_SINK alone
+  if (tracing::GetTraceSink() != nullptr) {
+    GTEST_SKIP();
+  }
+
+  std::vector<std::string> events;
+  tracing::SetTraceSink(onnxruntime::make_unique<RecordingTraceSink>(events));
+
+  {
+    tracing::TraceRange node_range(tracing::Category::kNode, "conv1", "Conv");
+    tracing::TraceRange loop_range(tracing::Category::kParallelFor, "parallel_for");
+    tracing::TraceInstant(tracing::Category::kArena, "arena_extend", 1024);
+  }
+
+  tracing::SetTraceSink(nullptr);
+  tracing::TraceInstant(tracing::Category::kArena, "arena_extend", 2048);
+
+  const std::vector<std::string> expected{"B:node:conv1:Conv",
+                                          "B:parallel_for:parallel_for:",
+                                          "i:arena:arena_extend:1024",
+                                          "E:parallel_for:parallel_for",
+                                          "E:node:conv1"};
+  EXPECT_EQ(events, expected);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
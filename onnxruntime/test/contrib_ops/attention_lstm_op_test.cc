@@ -63,7 +63,8 @@ static void RunAttnLstmTest(
     // copy the following vectors as we may modify them
     std::vector<std::string> activations = {},
     std::vector<float> activation_alphas = {},
-    std::vector<float> activation_betas = {}) {
+    std::vector<float> activation_betas = {},
+    bool attn_weights_as_initializers = false) {
   const int64_t input_size = x_depth + aw_attn_size;
 
   OpTester test("AttnLSTM", 1, onnxruntime::kMSDomain);
@@ -135,10 +136,10 @@ static void RunAttnLstmTest(
   }
 
   std::vector<int64_t> QW_dims{num_directions, hidden_size, am_attn_size};
-  test.AddInput<float>("QW", QW_dims, QW_data);
+  test.AddInput<float>("QW", QW_dims, QW_data, attn_weights_as_initializers);
 
   std::vector<int64_t> MW_dims{num_directions, memory_depth, am_attn_size};
-  test.AddInput<float>("MW", MW_dims, MW_data);
+  test.AddInput<float>("MW", MW_dims, MW_data, attn_weights_as_initializers);
 
   std::vector<int64_t> attn_v_dims{num_directions, am_attn_size};
   test.AddInput<float>("V", attn_v_dims, attn_v_data);
@@ -528,7 +529,8 @@ TEST(AttnLSTMTest, BidirectionLstmWithBahdanauAMShortenSeqLength) {
       "bidirectional", -9999.f, true, false);
 }
 
-TEST(AttnLSTMTest, BidirectionLstmWithBahdanauAM2BatchShortenSeqLen) {
+// The query and memory layer weights are prepacked by the kernel when they are initializers.
+static void RunBidirectionLstmWithBahdanauAM2BatchShortenSeqLen(bool attn_weights_as_initializers) {
   const int batch2Size = 2;
   const int inputMaxStep4 = 4;
 
@@ -582,7 +584,15 @@ TEST(AttnLSTMTest, BidirectionLstmWithBahdanauAM2BatchShortenSeqLen) {
       input_only_depth, batch2Size, cell_hidden_size, inputMaxStep4,
       memory_max_step, memory_depth, am_attn_size, aw_attn_size,
       &d_B_data, nullptr, nullptr, nullptr, &s_seq_lengths_2batch,
-      "bidirectional", -9999.f, true, false);
+      "bidirectional", -9999.f, true, false, {}, {}, {}, attn_weights_as_initializers);
+}
+
+TEST(AttnLSTMTest, BidirectionLstmWithBahdanauAM2BatchShortenSeqLen) {
+  RunBidirectionLstmWithBahdanauAM2BatchShortenSeqLen(false);
+}
+
+TEST(AttnLSTMTest, BidirectionLstmWithBahdanauAM2BatchShortenSeqLenPrepacked) {
+  RunBidirectionLstmWithBahdanauAM2BatchShortenSeqLen(true);
 }
 
 }  // namespace test
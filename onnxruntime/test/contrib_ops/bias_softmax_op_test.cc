@@ -134,33 +134,45 @@ class BiasSoftmaxTester {
     }
   }
 
+  void RunComparison(std::vector<std::unique_ptr<IExecutionProvider>>& ep) {
+    OpTester tester("BiasSoftmax", 1, onnxruntime::kMSDomain);
+    tester.AddAttribute<int64_t>("softmax_axis", softmax_axis_);
+    tester.AddAttribute<int64_t>("broadcast_axis", broadcast_axis_);
+
+    if (use_float16_) {
+      tester.AddInput<MLFloat16>("data", in_shape_, ToFloat16(in_data_));
+      tester.AddInput<MLFloat16>("bias", bias_shape_, ToFloat16(bias_data_));
+      tester.AddOutput<MLFloat16>("output", out_shape_, ToFloat16(out_data_));
+    } else {
+      tester.AddInput<float>("data", in_shape_, in_data_);
+      tester.AddInput<float>("bias", bias_shape_, bias_data_);
+      tester.AddOutput<float>("output", out_shape_, out_data_);
+    }
+
+    tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &ep);
+  }
+
   void RunComparison() {
-    // BiasSoftmax only implemented for cuda architecture
+    // the CPU kernel is only implemented for float
+    if (!use_float16_) {
+      std::vector<std::unique_ptr<IExecutionProvider>> ep;
+      ep.push_back(DefaultCpuExecutionProvider());
+      RunComparison(ep);
+    }
+
     int min_cuda_architecture = use_float16_ ? 530 : 0;
     if (HasCudaEnvironment(min_cuda_architecture) ||
         kGpuExecutionProvider == kRocmExecutionProvider) {
-      OpTester tester("BiasSoftmax", 1, onnxruntime::kMSDomain);
-      tester.AddAttribute<int64_t>("softmax_axis", softmax_axis_);
-      tester.AddAttribute<int64_t>("broadcast_axis", broadcast_axis_);
-
-      if (use_float16_) {
-        tester.AddInput<MLFloat16>("data", in_shape_, ToFloat16(in_data_));
-        tester.AddInput<MLFloat16>("bias", bias_shape_, ToFloat16(bias_data_));
-        tester.AddOutput<MLFloat16>("output", out_shape_, ToFloat16(out_data_));
-      } else {
-        tester.AddInput<float>("data", in_shape_, in_data_);
-        tester.AddInput<float>("bias", bias_shape_, bias_data_);
-        tester.AddOutput<float>("output", out_shape_, out_data_);
-      }
-
       std::vector<std::unique_ptr<IExecutionProvider>> ep;
       #ifdef USE_CUDA
         ep.push_back(DefaultCudaExecutionProvider());
       #elif USE_ROCM
         ep.push_back(DefaultRocmExecutionProvider());
       #endif
-      
-      tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &ep);
+
+      if (!ep.empty()) {
+        RunComparison(ep);
+      }
     }
   }
 };
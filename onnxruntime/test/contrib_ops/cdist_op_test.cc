@@ -4,6 +4,9 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
+#include <cmath>
+#include <vector>
+
 namespace onnxruntime {
 namespace test {
 
@@ -69,5 +72,34 @@ TEST(CDistOpTest, DoubleEuclidean) {
   test.Run();
 }
 
+// the output spans several tiles of rows and columns, with partial tiles at the ends
+TEST(CDistOpTest, EuclideanMultipleTiles) {
+  const int64_t m = 70, n = 300, k = 5;
+  std::vector<float> a(m * k), b(n * k), y(m * n);
+  for (int64_t i = 0; i < m * k; ++i) {
+    a[i] = static_cast<float>((i * 7) % 13) * 0.25f - 1.5f;
+  }
+  for (int64_t i = 0; i < n * k; ++i) {
+    b[i] = static_cast<float>((i * 5) % 11) * 0.25f - 1.25f;
+  }
+  for (int64_t i = 0; i < m; ++i) {
+    for (int64_t j = 0; j < n; ++j) {
+      float sum = 0.f;
+      for (int64_t l = 0; l < k; ++l) {
+        const float d = a[i * k + l] - b[j * k + l];
+        sum += d * d;
+      }
+      y[i * n + j] = std::sqrt(sum);
+    }
+  }
+
+  OpTester test("CDist", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("metric", "euclidean");
+  test.AddInput<float>("A", {m, k}, a);
+  test.AddInput<float>("B", {n, k}, b);
+  test.AddOutput<float>("y", {m, n}, y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -8,6 +8,7 @@
 #include "test/providers/provider_test_utils.h"
 #include "test/util/include/default_providers.h"
 #include "core/util/qmath.h"
+#include "core/util/thread_utils.h"
 
 #include <chrono>
 #include <random>
@@ -151,5 +152,37 @@ TEST(DynamicQuantizeMatMul, UInt8_test_bias) {
                                      true /*has_bias*/);
 }
 
+TEST(DynamicQuantizeMatMul, ParallelQuantization) {
+  // the range and the quantization are split in blocks across the threads for large inputs
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = 4;
+  tpo.auto_set_affinity = false;
+  std::unique_ptr<concurrency::ThreadPool> thread_pool =
+      concurrency::CreateThreadPool(&Env::Default(), tpo, concurrency::ThreadPoolType::INTRA_OP);
+
+  RandomValueGenerator random{};
+  for (int64_t size : {1, 1000, 16384, 16385, 100000}) {
+    std::vector<float> data = random.Uniform<float>({size}, -3.0f, 5.0f);
+
+    float scale;
+    uint8_t zero_point;
+    std::vector<uint8_t> quantized(static_cast<size_t>(size));
+    DynamicQuantize(data.data(), quantized.data(), size, scale, zero_point, thread_pool.get());
+
+    float expected_min, expected_max;
+    MlasFindMinMaxElement(data.data(), &expected_min, &expected_max, static_cast<size_t>(size));
+    float expected_scale;
+    uint8_t expected_zero_point;
+    GetQuantizationParameter(expected_min, expected_max, expected_scale, expected_zero_point);
+    std::vector<uint8_t> expected_quantized(static_cast<size_t>(size));
+    MlasQuantizeLinear(data.data(), expected_quantized.data(), static_cast<size_t>(size), expected_scale,
+                       expected_zero_point);
+
+    EXPECT_EQ(scale, expected_scale);
+    EXPECT_EQ(zero_point, expected_zero_point);
+    EXPECT_EQ(quantized, expected_quantized);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
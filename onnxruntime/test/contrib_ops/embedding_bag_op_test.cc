@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+static const std::vector<float> kWeight = {1.0f, 2.0f, 3.0f,
+                                          4.0f, 5.0f, 6.0f,
+                                          -7.0f, 8.0f, -9.0f,
+                                          10.0f, -11.0f, 12.0f};
+
+TEST(EmbeddingBagContribOpTest, Sum) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<float>("weight", {4, 3}, kWeight);
+  test.AddInput<int64_t>("indices", {2, 2}, {0, 2, 3, -1});
+  test.AddOutput<float>("output", {2, 3}, {-6.0f, 10.0f, -6.0f,
+                                           20.0f, -22.0f, 24.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagContribOpTest, Mean) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddAttribute("mode", std::string("mean"));
+  test.AddInput<float>("weight", {4, 3}, kWeight);
+  test.AddInput<int32_t>("indices", {2, 3}, {0, 1, 3, 2, 2, 1});
+  test.AddOutput<float>("output", {2, 3}, {5.0f, -4.0f / 3.0f, 7.0f,
+                                           -10.0f / 3.0f, 7.0f, -4.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagContribOpTest, Max) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddAttribute("mode", std::string("max"));
+  test.AddInput<float>("weight", {4, 3}, kWeight);
+  test.AddInput<int64_t>("indices", {3, 2}, {0, 1, 2, 3, 1, 1});
+  test.AddOutput<float>("output", {3, 3}, {4.0f, 5.0f, 6.0f,
+                                           10.0f, 8.0f, 12.0f,
+                                           4.0f, 5.0f, 6.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagContribOpTest, EmptyBags) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<float>("weight", {4, 3}, kWeight);
+  test.AddInput<int64_t>("indices", {2, 0}, std::vector<int64_t>{});
+  test.AddOutput<float>("output", {2, 3}, {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagContribOpTest, InvalidIndex) {
+  OpTester test("EmbeddingBag", 1, kMSDomain);
+  test.AddInput<float>("weight", {4, 3}, kWeight);
+  test.AddInput<int64_t>("indices", {1, 2}, {0, 4});
+  test.AddOutput<float>("output", {1, 3}, {0.0f, 0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,128 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(FusedElementwiseContribOpTest, ScaledTanhRelu) {
+  const std::vector<float> X = {-4.0f, -1.5f, -0.5f, 0.0f, 0.25f, 1.0f, 2.0f, 8.0f};
+  std::vector<float> Y;
+  for (float x : X) {
+    Y.push_back(std::max(1.0f - std::tanh(x * 0.5f), 0.0f));
+  }
+
+  OpTester test("FusedElementwise", 1, kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Mul", "Tanh", "Sub", "Relu"});
+  test.AddAttribute("scalars", std::vector<float>{0.5f, 0.0f, 1.0f, 0.0f});
+  test.AddAttribute("operand_first", std::vector<int64_t>{0, 0, 1, 0});
+  test.AddInput<float>("X", {2, 4}, X);
+  test.AddOutput<float>("Y", {2, 4}, Y);
+  test.Run();
+}
+
+TEST(FusedElementwiseContribOpTest, AllOperations) {
+  // enough elements for several blocks with a partial last block
+  std::vector<float> X(10000);
+  std::vector<float> Y(X.size());
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<float>(static_cast<int>(i % 101) - 50) / 25.0f;
+
+    float y = -X[i];
+    y = std::abs(y);
+    y = y + 0.5f;
+    y = std::log(y);
+    y = 1.0f / (1.0f + std::exp(-y));
+    y = std::sqrt(y);
+    y = 1.0f / y;
+    y = std::exp(y);
+    y = y / 4.0f;
+    y = 2.0f / y;
+    y = y - 0.25f;
+    y = std::erf(y);
+    Y[i] = y;
+  }
+
+  OpTester test("FusedElementwise", 1, kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Neg", "Abs", "Add", "Log", "Sigmoid", "Sqrt", "Reciprocal",
+                                                    "Exp", "Div", "Div", "Sub", "Erf"});
+  test.AddAttribute("scalars", std::vector<float>{0.0f, 0.0f, 0.5f, 0.0f, 0.0f, 0.0f, 0.0f,
+                                                  0.0f, 4.0f, 2.0f, 0.25f, 0.0f});
+  test.AddAttribute("operand_first", std::vector<int64_t>{0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0});
+  test.AddInput<float>("X", {100, 100}, X);
+  test.AddOutput<float>("Y", {100, 100}, Y);
+  // the MLAS approximations of Sigmoid, Exp and Erf differ slightly from the standard library
+  test.SetOutputRelErr("Y", 1e-4f);
+  test.Run();
+}
+
+TEST(FusedElementwiseContribOpTest, BroadcastSiLU) {
+  // (X + B) * Sigmoid(X + B) * S with B broadcast over the rows and S over the whole tensor
+  const std::vector<float> X = {-3.0f, -1.0f, 0.0f, 1.0f, 3.0f, -2.0f, 0.5f, 2.0f, 4.0f, -0.5f, 1.5f, -4.0f};
+  const std::vector<float> B = {0.5f, -0.25f, 1.0f, 0.0f};
+  const std::vector<float> S = {2.0f};
+  std::vector<float> Y;
+  for (size_t i = 0; i < X.size(); ++i) {
+    const float a = X[i] + B[i % B.size()];
+    Y.push_back(a / (1.0f + std::exp(-a)) * S[0]);
+  }
+
+  // the values are X, B, S and then the results of Add, Sigmoid, Mul and Mul
+  OpTester test("FusedElementwise", 1, kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Add", "Sigmoid", "Mul", "Mul"});
+  test.AddAttribute("operands", std::vector<int64_t>{1, -1, 3, 2});
+  test.AddAttribute("operand_first", std::vector<int64_t>{0, 0, 1, 0});
+  test.AddInput<float>("X", {3, 4}, X);
+  test.AddInput<float>("B", {1, 4}, B);
+  test.AddInput<float>("S", {1, 1, 1}, S);
+  test.AddOutput<float>("Y", {3, 4}, Y);
+  test.SetOutputRelErr("Y", 1e-4f);
+  test.Run();
+}
+
+TEST(FusedElementwiseContribOpTest, ChainValueOperands) {
+  // enough elements for several blocks so the buffered values are used across blocks
+  std::vector<float> X(9000);
+  std::vector<float> Y(X.size());
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<float>(static_cast<int>(i % 37) - 18) / 8.0f;
+    const float square = X[i] * X[i];
+    const float shifted = square - 1.0f;
+    Y[i] = (X[i] - std::abs(shifted) + 1.0f) * square;
+  }
+
+  // the values are X and then the results of Mul, Sub, Abs, Sub, Add and Mul
+  OpTester test("FusedElementwise", 1, kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Mul", "Sub", "Abs", "Sub", "Add", "Mul"});
+  test.AddAttribute("operands", std::vector<int64_t>{0, -1, -1, 0, -1, 1});
+  test.AddAttribute("scalars", std::vector<float>{0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f});
+  test.AddAttribute("operand_first", std::vector<int64_t>{0, 0, 0, 1, 0, 0});
+  test.AddInput<float>("X", {9000}, X);
+  test.AddOutput<float>("Y", {9000}, Y);
+  test.Run();
+}
+
+TEST(FusedElementwiseContribOpTest, IncompatibleBroadcast) {
+  OpTester test("FusedElementwise", 1, kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Add", "Relu"});
+  test.AddAttribute("operands", std::vector<int64_t>{1, -1});
+  test.AddInput<float>("X", {2, 2}, {1.0f, 2.0f, 3.0f, 4.0f});
+  test.AddInput<float>("B", {2, 1}, {1.0f, 2.0f});
+  test.AddOutput<float>("Y", {2, 2}, {2.0f, 3.0f, 5.0f, 6.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "can't be broadcast to the shape of the first input");
+}
+
+TEST(FusedElementwiseContribOpTest, UnsupportedOperation) {
+  OpTester test("FusedElementwise", 1, kMSDomain);
+  test.AddAttribute("ops", std::vector<std::string>{"Relu", "Softmax"});
+  test.AddInput<float>("X", {2}, {1.0f, 2.0f});
+  test.AddOutput<float>("Y", {2}, {1.0f, 2.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "unsupported operation 'Softmax'");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <limits>
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(FusedScalerOpTest, ImputeScaleNormalizeL1) {
+  OpTester test("FusedScaler", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("imputed_values", std::vector<float>{10.f, 20.f, 30.f});
+  test.AddAttribute("replaced_value", std::numeric_limits<float>::quiet_NaN());
+  test.AddAttribute("scale", std::vector<float>{2.f});
+  test.AddAttribute("offset", std::vector<float>{1.f});
+  test.AddAttribute("norm", std::string("L1"));
+  test.AddInput<float>("X", {2, 3}, {1.f, std::numeric_limits<float>::quiet_NaN(), 3.f, 0.f, 4.f, -2.f});
+  // {1, 20, 3} and {0, 4, -2} scaled to {0, 38, 4} and {-2, 6, -6}
+  test.AddOutput<float>("Y", {2, 3}, {0.f, 38.f / 42.f, 4.f / 42.f, -2.f / 14.f, 6.f / 14.f, -6.f / 14.f});
+  test.Run();
+}
+
+TEST(FusedScalerOpTest, ScaleNormalizeMaxInt64) {
+  OpTester test("FusedScaler", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("scale", std::vector<float>{1.f, 0.5f});
+  test.AddAttribute("offset", std::vector<float>{0.f, 0.f});
+  test.AddAttribute("norm", std::string("MAX"));
+  test.AddInput<int64_t>("X", {2, 2}, {1, 2, 3, 4});
+  test.AddOutput<float>("Y", {2, 2}, {1.f, 1.f, 1.f, 2.f / 3.f});
+  test.Run();
+}
+
+// the sign of the input is kept by the L2 normalization
+TEST(FusedScalerOpTest, NormalizeL2OneDimension) {
+  OpTester test("FusedScaler", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("norm", std::string("L2"));
+  test.AddInput<float>("X", {2}, {3.f, -4.f});
+  test.AddOutput<float>("Y", {2}, {0.6f, -0.8f});
+  test.Run();
+}
+
+TEST(FusedScalerOpTest, ImputeBroadcast) {
+  OpTester test("FusedScaler", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("imputed_values", std::vector<float>{5.f});
+  test.AddAttribute("replaced_value", -1.f);
+  test.AddAttribute("scale", std::vector<float>{1.f});
+  test.AddAttribute("offset", std::vector<float>{0.f});
+  test.AddInput<float>("X", {1, 3}, {-1.f, 2.f, -1.f});
+  test.AddOutput<float>("Y", {1, 3}, {5.f, 2.f, 5.f});
+  test.Run();
+}
+
+TEST(FusedScalerOpTest, InvalidScaleSize) {
+  OpTester test("FusedScaler", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("scale", std::vector<float>{1.f, 2.f});
+  test.AddAttribute("offset", std::vector<float>{0.f, 0.f});
+  test.AddInput<float>("X", {1, 3}, {1.f, 2.f, 3.f});
+  test.AddOutput<float>("Y", {1, 3}, {1.f, 2.f, 3.f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "either both scale and offset can be of feature size");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
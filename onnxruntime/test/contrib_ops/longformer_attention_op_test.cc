@@ -23,11 +23,12 @@ static void RunAttentionTest(
     int hidden_size,
     int number_of_heads,
     int window,
-    bool use_float16 = false) {
+    bool use_float16 = false,
+    bool disable_cuda = false) {
   int min_cuda_architecture = use_float16 ? 530 : 0;
 
-  bool enable_cuda = HasCudaEnvironment(min_cuda_architecture);
-  bool enable_cpu = false;
+  bool enable_cuda = HasCudaEnvironment(min_cuda_architecture) && !disable_cuda;
+  bool enable_cpu = !use_float16;
   if (enable_cpu || enable_cuda) {
     OpTester tester("LongformerAttention", 1, onnxruntime::kMSDomain);
     tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(number_of_heads));
@@ -150,7 +151,8 @@ static void RunTinyLongformerBatch1(
     std::vector<int>& global_data,
     std::vector<float>& output_data,
     bool use_float16,
-    bool window_cover_whole_sequence = false) {
+    bool window_cover_whole_sequence = false,
+    bool disable_cuda = false) {
   int batch_size = 1;
   int one_sided_attention_window_size = 2;
   int hidden_size = 8;
@@ -184,7 +186,8 @@ static void RunTinyLongformerBatch1(
   GetTinyLongformerData(weight_data, bias_data, global_weight_data, global_bias_data);
 
   RunAttentionTest(input_data, weight_data, bias_data, mask_data, global_weight_data, global_bias_data, global_data, output_data,
-                   batch_size, sequence_length, hidden_size, number_of_heads, one_sided_attention_window_size, use_float16);
+                   batch_size, sequence_length, hidden_size, number_of_heads, one_sided_attention_window_size, use_float16,
+                   disable_cuda);
 }
 
 TEST(LongformerAttentionTest, LongformerAttention_NoGlobal) {
@@ -275,8 +278,7 @@ TEST(LongformerAttentionTest, LongformerAttention_FullWindow) {
   RunTinyLongformerBatch1(mask_data, global_data, output_data, false, window_cover_whole_sequence);
 }
 
-/*
-// TODO: enable the following tests after removing the limitations of CUDA kernels.
+// TODO: enable the following test for CUDA after removing the limitations of CUDA kernels.
 TEST(LongformerAttentionTest, LongformerAttention_GlobalMiddle) {
   std::vector<float> mask_data = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, -10000.0f};
 
@@ -293,9 +295,10 @@ TEST(LongformerAttentionTest, LongformerAttention_GlobalMiddle) {
       0.0803f, 0.0502f, -0.0089f, 0.0212f, -0.0030f, -0.0275f, -0.0244f, -0.0560f,
       0.0000f, 0.0000f, 0.0000f, 0.0000f, 0.0000f, 0.0000f, 0.0000f, 0.0000f};
 
-  RunTinyLongformerBatch1(mask_data, global_data, output_data, false);
+  bool window_cover_whole_sequence = false;
+  bool disable_cuda = true;  // the CUDA kernel requires all global tokens at the start of the sequence
+  RunTinyLongformerBatch1(mask_data, global_data, output_data, false, window_cover_whole_sequence, disable_cuda);
 }
-*/
 
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/mlas/inc/mlas.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+#include <functional>
+#include <numeric>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+static void TestMatMulWeightOnlyQuant(const std::vector<int64_t>& A_dims,
+                                      int64_t N,
+                                      int64_t bits,
+                                      int64_t block_size,
+                                      bool has_zero_points,
+                                      bool has_bias) {
+  const int64_t K = A_dims.back();
+  const int64_t M = std::accumulate(A_dims.begin(), A_dims.end() - 1, int64_t{1}, std::multiplies<int64_t>());
+  const int64_t block_count_k = (K + block_size - 1) / block_size;
+  const int64_t blob_size = block_size * bits / 8;
+
+  RandomValueGenerator random{};
+  std::vector<float> A_data = random.Uniform<float>(A_dims, -1.0f, 1.0f);
+  std::vector<float> B_data = random.Uniform<float>({K, N}, -1.0f, 1.0f);
+  std::vector<float> bias = random.Uniform<float>({N}, -1.0f, 1.0f);
+
+  std::vector<uint8_t> quant_b(MlasBlockQuantBSize(static_cast<size_t>(N), static_cast<size_t>(K),
+                                                   static_cast<size_t>(bits), static_cast<size_t>(block_size)));
+  std::vector<float> scales(static_cast<size_t>(N * block_count_k));
+  std::vector<uint8_t> zero_points(static_cast<size_t>(N * block_count_k));
+
+  MlasBlockQuantizeB(static_cast<size_t>(N), static_cast<size_t>(K), static_cast<size_t>(bits),
+                     static_cast<size_t>(block_size), B_data.data(), static_cast<size_t>(N), quant_b.data(),
+                     scales.data(), has_zero_points ? zero_points.data() : nullptr);
+
+  // the expected output is computed from the dequantized weights
+  std::vector<float> expected(static_cast<size_t>(M * N));
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = has_bias ? bias[n] : 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        const int64_t block = n * block_count_k + k / block_size;
+        const int64_t kk = k % block_size;
+        const uint8_t* blob = quant_b.data() + block * blob_size;
+        const int32_t value = bits == 4 ? (blob[kk / 2] >> ((kk & 1) * 4)) & 0x0F : blob[kk];
+        const int32_t zero_point = has_zero_points ? zero_points[block] : 1 << (bits - 1);
+        sum += A_data[m * K + k] * static_cast<float>(value - zero_point) * scales[block];
+      }
+      expected[m * N + n] = sum;
+    }
+  }
+
+  OpTester test("MatMulWeightOnlyQuant", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("N", N);
+  test.AddAttribute<int64_t>("bits", bits);
+  test.AddAttribute<int64_t>("block_size", block_size);
+  test.AddInput<float>("A", A_dims, A_data);
+  test.AddInput<uint8_t>("B", {N, block_count_k, blob_size}, quant_b, true);
+  test.AddInput<float>("scales", {N * block_count_k}, scales, true);
+  if (has_zero_points) {
+    test.AddInput<uint8_t>("zero_points", {N * block_count_k}, zero_points, true);
+  } else {
+    test.AddMissingOptionalInput<uint8_t>();
+  }
+  if (has_bias) {
+    test.AddInput<float>("bias", {N}, bias, true);
+  } else {
+    test.AddMissingOptionalInput<float>();
+  }
+
+  std::vector<int64_t> Y_dims(A_dims);
+  Y_dims.back() = N;
+  test.AddOutput<float>("Y", Y_dims, expected);
+  test.SetOutputRelErr("Y", 1e-4f);
+
+  test.Run();
+}
+
+TEST(MatMulWeightOnlyQuant, Int4_Gemv) {
+  TestMatMulWeightOnlyQuant({1, 256}, 64, 4, 32, true, false);
+  TestMatMulWeightOnlyQuant({1, 300}, 48, 4, 64, false, true);
+  TestMatMulWeightOnlyQuant({1, 1, 512}, 33, 4, 128, true, true);
+}
+
+TEST(MatMulWeightOnlyQuant, Int4_Gemm) {
+  TestMatMulWeightOnlyQuant({3, 256}, 64, 4, 32, true, true);
+  TestMatMulWeightOnlyQuant({2, 17, 200}, 40, 4, 32, false, false);
+  TestMatMulWeightOnlyQuant({64, 384}, 96, 4, 128, true, true);
+}
+
+TEST(MatMulWeightOnlyQuant, Int8) {
+  TestMatMulWeightOnlyQuant({1, 256}, 64, 8, 32, true, true);
+  TestMatMulWeightOnlyQuant({2, 300}, 48, 8, 64, false, false);
+  TestMatMulWeightOnlyQuant({4, 9, 512}, 33, 8, 128, true, false);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
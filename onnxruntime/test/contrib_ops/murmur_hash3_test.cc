@@ -148,5 +148,59 @@ TEST(MurmurHash3OpTest, StringKeyUIntWithSeed42) {
   test.Run();
 }
 
+// More keys than the kernels hash at a time, with 64-bit keys going through the fixed width path.
+TEST(MurmurHash3OpTest, ManyKeys) {
+  std::vector<int64_t> keys;
+  std::vector<uint32_t> hashes;
+  for (int i = 0; i < 300; ++i) {
+    keys.insert(keys.end(), {4LL, 3LL});
+    hashes.insert(hashes.end(), {3491892518U, 2738575283U});
+  }
+  OpTester test("MurmurHash3", 1, onnxruntime::kMSDomain);
+  test.AddInput<int64_t>("X", {300, 2}, keys);
+  test.AddOutput<uint32_t>("Y", {300, 2}, hashes);
+  test.Run();
+}
+
+TEST(MurmurHash3BucketOpTest, IntKeys) {
+  OpTester test("MurmurHash3Bucket", 1, onnxruntime::kMSDomain);
+  test.AddInput<int32_t>("X", {2}, {3L, 4L});
+  test.AddAttribute<int64_t>("num_buckets", 1000LL);
+  test.AddOutput<int64_t>("Y", {2}, {505LL, 975LL});
+  test.Run();
+}
+
+TEST(MurmurHash3BucketOpTest, StringKeys) {
+  OpTester test("MurmurHash3Bucket", 1, onnxruntime::kMSDomain);
+  test.AddInput<std::string>("X", {2}, {"foo", "bar"});
+  test.AddAttribute<int64_t>("num_buckets", 100LL);
+  test.AddOutput<int64_t>("Y", {2}, {84LL, 17LL});
+  test.Run();
+}
+
+// The bucket of the absolute value of the signed hash -156908512 of "foo".
+TEST(MurmurHash3BucketOpTest, SignedHash) {
+  OpTester test("MurmurHash3Bucket", 1, onnxruntime::kMSDomain);
+  test.AddInput<std::string>("X", {1}, {"foo"});
+  test.AddAttribute<int64_t>("num_buckets", 100LL);
+  test.AddAttribute<int64_t>("positive", 0LL);
+  test.AddOutput<int64_t>("Y", {1}, {12LL});
+  test.Run();
+}
+
+TEST(MurmurHash3BucketOpTest, ManyKeys) {
+  std::vector<int32_t> keys;
+  std::vector<int64_t> buckets;
+  for (int i = 0; i < 300; ++i) {
+    keys.insert(keys.end(), {3, 4});
+    buckets.insert(buckets.end(), {505LL, 975LL});
+  }
+  OpTester test("MurmurHash3Bucket", 1, onnxruntime::kMSDomain);
+  test.AddInput<int32_t>("X", {2, 300}, keys);
+  test.AddAttribute<int64_t>("num_buckets", 1000LL);
+  test.AddOutput<int64_t>("Y", {2, 300}, buckets);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -131,15 +131,23 @@ typedef std::unordered_map<const onnxruntime::NodeArg*, TensorShapeProto*> Shape
 
 class SequentialPlannerTestContext : public ISequentialPlannerContext {
  public:
-  SequentialPlannerTestContext(ShapeMap* shape_map) : shape_map_(shape_map) {}
+  SequentialPlannerTestContext(ShapeMap* shape_map, ExecutionOrder execution_order = ExecutionOrder::DEFAULT,
+                               bool enable_inplace_reuse = true)
+      : shape_map_(shape_map), execution_order_(execution_order), enable_inplace_reuse_(enable_inplace_reuse) {}
 
   TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
     auto iter = shape_map_->find(&arg);
     return (shape_map_->end() != iter) ? iter->second : nullptr;
   }
 
+  ExecutionOrder GetExecutionOrder() const override { return execution_order_; }
+
+  bool IsInplaceReuseEnabled() const override { return enable_inplace_reuse_; }
+
  private:
   ShapeMap* shape_map_;
+  ExecutionOrder execution_order_;
+  bool enable_inplace_reuse_;
 };
 
 class PlannerTest : public ::testing::Test {
@@ -154,8 +162,11 @@ class PlannerTest : public ::testing::Test {
   // some standard components used to build test-cases:
   Type float_type_;
 
-  std::unique_ptr<::onnxruntime::KernelDef> std_kernel_;       // a unary kernel with no-aliasing and no-in-place
-  std::unique_ptr<::onnxruntime::KernelDef> in_place_kernel_;  // a unary kernel with in-place
+  std::unique_ptr<::onnxruntime::KernelDef> std_kernel_;              // a unary kernel with no-aliasing and no-in-place
+  std::unique_ptr<::onnxruntime::KernelDef> in_place_kernel_;         // a unary kernel with in-place
+  std::unique_ptr<::onnxruntime::KernelDef> binary_kernel_;           // a binary kernel with no-aliasing and no-in-place
+  std::unique_ptr<::onnxruntime::KernelDef> binary_in_place_kernel_;  // a binary kernel with in-place for both inputs
+  std::unique_ptr<::onnxruntime::KernelDef> view_kernel_;             // a unary kernel whose output may be a view
 
   std::unordered_map<std::string, onnxruntime::NodeArg*> name_to_arg_;
   std::vector<std::unique_ptr<UnaryNode>> nodes_;
@@ -167,6 +178,8 @@ class PlannerTest : public ::testing::Test {
   profiling::Profiler profiler_;
   std::unique_ptr<SessionState> state_;
   ShapeMap shape_map_;
+  ExecutionOrder execution_order_ = ExecutionOrder::DEFAULT;
+  bool enable_inplace_reuse_ = true;
   std::unique_ptr<SequentialExecutionPlan> plan_;
 
  public:
@@ -178,6 +191,20 @@ class PlannerTest : public ::testing::Test {
     std_kernel_ = KernelDefBuilder().SetName("Transpose").Provider(kCpuExecutionProvider).SinceVersion(1, 10).Build();
     in_place_kernel_ =
         KernelDefBuilder().SetName("Relu").Provider(kCpuExecutionProvider).SinceVersion(1, 10).MayInplace(0, 0).Build();
+    binary_kernel_ = KernelDefBuilder().SetName("Add").Provider(kCpuExecutionProvider).SinceVersion(7, 10).Build();
+    binary_in_place_kernel_ = KernelDefBuilder()
+                                  .SetName("Sub")
+                                  .Provider(kCpuExecutionProvider)
+                                  .SinceVersion(7, 10)
+                                  .MayInplace(0, 0)
+                                  .MayInplace(1, 0)
+                                  .Build();
+    view_kernel_ = KernelDefBuilder()
+                       .SetName("Squeeze")
+                       .Provider(kCpuExecutionProvider)
+                       .SinceVersion(1, 10)
+                       .MayOutputView(0, 0)
+                       .Build();
     CPUExecutionProviderInfo epi;
     auto execution_provider = onnxruntime::make_unique<CPUExecutionProvider>(epi);
     execution_providers_.Add("CPUExecutionProvider", std::move(execution_provider));
@@ -209,6 +236,28 @@ class PlannerTest : public ::testing::Test {
     return AddNode(*in_place_kernel_, input, output);
   }
 
+  onnxruntime::Node* AddViewNode(std::string& input, std::string& output) {
+    return AddNode(*view_kernel_, input, output);
+  }
+
+  onnxruntime::Node* AddBinaryNode(::onnxruntime::KernelDef& kernel_def, std::string& input1, std::string& input2,
+                                    std::string& output) {
+    int num = NodeCounter::Next();
+    auto* p_node = &graph_.AddNode("node" + std::to_string(num), kernel_def.OpName(), "test op",
+                                   {Arg(input1), Arg(input2)}, {Arg(output)});
+    p_node->SetExecutionProviderType(onnxruntime::kCpuExecutionProvider);
+    kernel_bindings_.emplace_back(p_node, kernel_def);
+    return p_node;
+  }
+
+  onnxruntime::Node* AddBinaryNode(std::string& input1, std::string& input2, std::string& output) {
+    return AddBinaryNode(*binary_kernel_, input1, input2, output);
+  }
+
+  onnxruntime::Node* AddBinaryInplaceNode(std::string& input1, std::string& input2, std::string& output) {
+    return AddBinaryNode(*binary_in_place_kernel_, input1, input2, output);
+  }
+
   void BindKernel(onnxruntime::Node* p_node, ::onnxruntime::KernelDef& kernel_def, KernelRegistry* reg,
                   std::unordered_map<NodeIndex, gsl::not_null<const KernelCreateInfo*>>& kernel_create_info_map) {
     const IExecutionProvider* ep = execution_providers_.Get(*p_node);
@@ -232,6 +281,10 @@ class PlannerTest : public ::testing::Test {
 
   void SetShape(std::string& name, TensorShapeProto* shape) { shape_map_[Arg(name)] = shape; }
 
+  void SetExecutionOrder(ExecutionOrder execution_order) { execution_order_ = execution_order; }
+
+  void SetInplaceReuseEnabled(bool enable_inplace_reuse) { enable_inplace_reuse_ = enable_inplace_reuse; }
+
   void SetShape(std::initializer_list<std::pair<std::string&, TensorShapeProto*>> shapes) {
     for (auto& pair : shapes) {
       SetShape(pair.first, pair.second);
@@ -260,7 +313,7 @@ class PlannerTest : public ::testing::Test {
     status = state_->FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager, {}, nullptr, remove_initializers);
 
     EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
-    SequentialPlannerTestContext test_context(&shape_map_);
+    SequentialPlannerTestContext test_context(&shape_map_, execution_order_, enable_inplace_reuse_);
 
     status = SequentialPlanner::CreatePlan(nullptr, GraphViewer(graph_), outer_scope_node_args, execution_providers_,
                                            kernel_create_info_map, state_->GetOrtValueNameIdxMap(), test_context,
@@ -276,6 +329,15 @@ class PlannerTest : public ::testing::Test {
     EXPECT_EQ(plan_->allocation_plan[id].alloc_kind, kind) << "Error in allocation kind for " << name;
   }
 
+  void CheckExecutionOrder(std::initializer_list<const onnxruntime::Node*> nodes) {
+    ASSERT_EQ(plan_->execution_plan.size(), nodes.size()) << "Execution plan is of wrong size";
+    size_t step_number = 0;
+    for (const auto* p_node : nodes) {
+      EXPECT_EQ(plan_->execution_plan[step_number].node_index, p_node->Index()) << "Wrong node at step " << step_number;
+      ++step_number;
+    }
+  }
+
   void CheckFreed(int step_number, std::initializer_list<std::string> freed_items) {
     // create set and check equality
     std::unordered_set<int> expected;
@@ -403,6 +465,45 @@ TEST_F(PlannerTest, InPlaceTest) {
   CheckFreed(2, {X2});
 }
 
+// ViewTest: Check that an output that may be a view of its input keeps the input's buffer alive,
+// and that its own buffer is neither updated in-place nor reused while it may be a view.
+TEST_F(PlannerTest, ViewTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  // graph structure:
+  AddNormalNode(X1, X2);   // no in-place operator; X1: input; X2: temporary
+  AddViewNode(X2, X3);     // may-output-view operator; X3: temporary
+  AddInplaceNode(X3, X4);  // may-in-place operator; X4: temporary
+  AddNormalNode(X4, X5);   // no in-place operator; X5: output
+
+  // simulate shape-inference results:
+  Shape shape1w{"M", "N"};
+  auto shape1 = &shape1w.value;
+  Shape shape2w{"K", "N"};
+  auto shape2 = &shape2w.value;
+  SetShape({{X1, shape1}, {X2, shape1}, {X3, shape2}, {X4, shape2}, {X5, shape2}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X1, AllocKind::kPreExisting);
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+  CheckAllocKind(X4, AllocKind::kAllocate);
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+
+  int x3_index;
+  index(X3, x3_index);
+  EXPECT_TRUE(GetPlan().allocation_plan[x3_index].may_be_view);
+
+  // check each ml-value is freed at appropriate step
+  CheckFreed(0, {});
+  CheckFreed(1, {});
+  CheckFreed(2, {X2, X3});
+  CheckFreed(3, {X4});
+}
+
 // InPlaceSizeMismatchTest: Check that Inplace reuse is not allowed when sizes don't match.
 // Also tests reuse of disjoint lifetime tensors.
 TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
@@ -438,6 +539,68 @@ TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
   CheckFreed(3, {X2});
 }
 
+// BinaryInPlaceTest: Check that a binary operator reuses whichever input this node is the last consumer of.
+TEST_F(PlannerTest, BinaryInPlaceTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  // graph structure:
+  AddNormalNode(X1, X2);             // no in-place operator; X1: input; X2: temporary
+  AddNormalNode(X1, X3);             // no in-place operator; X3: temporary
+  AddBinaryInplaceNode(X2, X3, X4);  // may-in-place operator; X2 is used again below, so X3 is reused
+  AddBinaryNode(X4, X2, X5);         // no in-place operator; X5: output
+
+  // simulate shape-inference results:
+  Shape shape1{"M", "N"};
+  auto shape = &shape1.value;
+  SetShape({{X1, shape}, {X2, shape}, {X3, shape}, {X4, shape}, {X5, shape}});
+
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X1, AllocKind::kPreExisting);
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+  CheckAllocKind(X4, AllocKind::kReuse);
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+
+  // check each ml-value is freed at appropriate step
+  CheckFreed(0, {});
+  CheckFreed(1, {});
+  CheckFreed(2, {});
+  CheckFreed(3, {X2, X3});
+}
+
+// InPlaceReuseDisabledTest: Check that no optional in-place reuse happens when it is disabled in the context.
+TEST_F(PlannerTest, InPlaceReuseDisabledTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4");
+
+  // graph structure:
+  AddNormalNode(X1, X2);   // no in-place operator; X1: input; X2: temporary
+  AddInplaceNode(X2, X3);  // may-in-place operator; X3: temporary
+  AddNormalNode(X3, X4);   // no in-place operator; X4: output
+
+  // simulate shape-inference results:
+  Shape shape1{"M", "N"};
+  auto shape = &shape1.value;
+  SetShape({{X1, shape}, {X2, shape}, {X3, shape}, {X4, shape}});
+
+  SetInplaceReuseEnabled(false);
+  CreatePlan();
+
+  // check allocation kind:
+  CheckAllocKind(X1, AllocKind::kPreExisting);
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+  CheckAllocKind(X4, AllocKind::kAllocateOutput);
+
+  // check each ml-value is freed at appropriate step
+  CheckFreed(0, {});
+  CheckFreed(1, {X2});
+  CheckFreed(2, {X3});
+}
+
 // Test operator<< to output details of an allocation & execution plan.
 TEST_F(PlannerTest, PlanOutputTest) {
   // tensor variables:
@@ -469,5 +632,59 @@ TEST_F(PlannerTest, PlanOutputTest) {
   }
 }
 
+/* MemoryEfficientOrderTest: the outputs of two branches are added. The branch executed first by the default order
+has a large output, while the other branch has a huge intermediate value and a small output. Executing the other
+branch first means its intermediate value is never live together with the large output.
+*/
+class MemoryEfficientOrderTest : public PlannerTest {
+ protected:
+  void BuildGraph() {
+    // the branch with the lower node indices is executed last by the default order
+    q1_ = AddNormalNode(X_, Q1_);
+    q2_ = AddNormalNode(Q1_, Q2_);
+    p1_ = AddNormalNode(X_, P1_);
+    p2_ = AddNormalNode(P1_, P2_);
+    y_ = AddBinaryNode(P2_, Q2_, Y_);
+
+    SetShape({{X_, &small_.value}, {Q1_, &huge_.value}, {Q2_, &small_.value}, {P1_, &small_.value},
+              {P2_, &large_.value}, {Y_, &small_.value}});
+  }
+
+  std::string X_{"X"}, Q1_{"Q1"}, Q2_{"Q2"}, P1_{"P1"}, P2_{"P2"}, Y_{"Y"};
+  Shape small_{10}, large_{500}, huge_{1000};
+  onnxruntime::Node *q1_, *q2_, *p1_, *p2_, *y_;
+};
+
+TEST_F(MemoryEfficientOrderTest, DefaultOrder) {
+  BuildGraph();
+  CreatePlan();
+
+  CheckExecutionOrder({p1_, p2_, q1_, q2_, y_});
+
+  // Q1 is allocated while P1, which Q2 reuses later, and P2 are live
+  EXPECT_EQ(GetPlan().planned_peak_bytes, (10 + 500 + 1000) * sizeof(float));
+}
+
+TEST_F(MemoryEfficientOrderTest, MemoryEfficientOrder) {
+  BuildGraph();
+  SetExecutionOrder(ExecutionOrder::MEMORY_EFFICIENT);
+  CreatePlan();
+
+  CheckExecutionOrder({q1_, q2_, p1_, p2_, y_});
+
+  // the peak is reached when Q2 is allocated while Q1 is live
+  EXPECT_EQ(GetPlan().planned_peak_bytes, (1000 + 10) * sizeof(float));
+}
+
+TEST_F(MemoryEfficientOrderTest, KeepsDefaultOrderWithoutStaticShapes) {
+  BuildGraph();
+  Shape dynamic{"N"};
+  SetShape({{Q1_, &dynamic.value}, {P2_, &dynamic.value}});
+  SetExecutionOrder(ExecutionOrder::MEMORY_EFFICIENT);
+  CreatePlan();
+
+  CheckExecutionOrder({p1_, p2_, q1_, q2_, y_});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
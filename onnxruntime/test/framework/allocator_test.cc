@@ -3,6 +3,7 @@
 
 #include "core/framework/allocatormgr.h"
 #include "core/framework/allocator.h"
+#include "core/framework/arena.h"
 
 #include "test_utils.h"
 #include "gtest/gtest.h"
@@ -33,6 +34,29 @@ TEST(AllocatorTest, CPUAllocatorTest) {
   //todo: test the used / max api.
 }
 
+TEST(AllocatorTest, CreateAllocatorArenaType) {
+  auto create = [](int arena_type) {
+    OrtArenaCfg arena_cfg{0, -1, -1, -1, 0, arena_type};
+    AllocatorCreationInfo info{[](int) { return onnxruntime::make_unique<CPUAllocator>(); }, 0, true, arena_cfg};
+    return CreateAllocator(info);
+  };
+
+  // the BFC arena is used if the mimalloc arena isn't enabled in this build
+  for (int arena_type : {-1, static_cast<int>(ArenaType::kBFCArena), static_cast<int>(ArenaType::kMiMallocArena)}) {
+    auto arena = create(arena_type);
+    ASSERT_NE(arena, nullptr);
+    EXPECT_EQ(arena->Info().alloc_type, OrtAllocatorType::OrtArenaAllocator);
+
+    void* p = arena->Alloc(1024);
+    ASSERT_NE(p, nullptr);
+    memset(p, -1, 1024);
+    arena->Free(p);
+    EXPECT_TRUE(static_cast<IArenaAllocator*>(arena.get())->Shrink().IsOK());
+  }
+
+  EXPECT_EQ(create(2), nullptr);
+}
+
 // helper class to validate values in Alloc and Free calls made via IAllocator::MakeUniquePtr
 class TestAllocator : public IAllocator {
  public:
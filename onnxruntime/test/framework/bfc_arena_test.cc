@@ -5,6 +5,8 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include <cstdlib>
+#include <cstring>
+#include <thread>
 
 namespace onnxruntime {
 namespace test {
@@ -298,5 +300,229 @@ TEST(BFCArenaTest, TestBackoffDoesntHang) {
   BFCArena a(std::unique_ptr<IAllocator>(new BadAllocator()), 10 * 1024 * 1024);
   EXPECT_THROW(a.Alloc(1024), OnnxRuntimeException) << "Arena should be unable to allocate memory";
 }
+
+TEST(BFCArenaTest, ThreadCacheReusesFreedChunk) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK, 64 * 1024);
+
+  // miss. rounded up to the 1024 byte size class and refilled with a batch of 8.
+  void* p = a.Alloc(1000);
+  ASSERT_NE(p, nullptr);
+  EXPECT_EQ(a.AllocatedSize(p), 1024u);
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_misses, 1);
+  EXPECT_EQ(stats.num_thread_cache_hits, 0);
+  EXPECT_EQ(stats.thread_cache_bytes, 7 * 1024);
+  EXPECT_EQ(stats.bytes_in_use, 8 * 1024);
+
+  a.Free(p);
+  void* q = a.Alloc(900);
+  EXPECT_EQ(q, p);
+
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_misses, 1);
+  EXPECT_EQ(stats.num_thread_cache_hits, 1);
+
+  // large allocations bypass the cache
+  void* large = a.Alloc(BFCArena::kThreadCacheMaxAllocationSize + 1);
+  a.Free(large);
+  a.Free(q);
+
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_misses, 1);
+  EXPECT_EQ(stats.thread_cache_bytes, 8 * 1024);
+  EXPECT_EQ(stats.bytes_in_use, stats.thread_cache_bytes);
+}
+
+TEST(BFCArenaTest, ThreadCacheRespectsBudget) {
+  const size_t budget = 4096;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK, budget);
+
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 8; ++i) {
+    ptrs.push_back(a.Alloc(2048));
+  }
+
+  AllocatorStats stats;
+  for (void* p : ptrs) {
+    a.Free(p);
+    a.GetStats(&stats);
+    EXPECT_LE(stats.thread_cache_bytes, static_cast<int64_t>(budget));
+  }
+
+  EXPECT_EQ(stats.bytes_in_use, stats.thread_cache_bytes);
+}
+
+TEST(BFCArenaTest, ThreadCacheFlushedWhenOutOfMemory) {
+  const size_t memory_limit = 1 << 20;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), memory_limit, BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK, memory_limit);
+
+  // use all the memory for cacheable allocations, and free them so they're held in the thread cache
+  const size_t chunk_size = BFCArena::kThreadCacheMaxAllocationSize;
+  std::vector<void*> ptrs;
+  for (size_t i = 0; i < memory_limit / chunk_size; ++i) {
+    ptrs.push_back(a.Alloc(chunk_size));
+  }
+
+  for (void* p : ptrs) {
+    a.Free(p);
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.thread_cache_bytes, static_cast<int64_t>(memory_limit));
+
+  // the arena has no free chunks and can't be extended, so this requires the cache to be flushed
+  void* large = a.Alloc(memory_limit / 2);
+  EXPECT_NE(large, nullptr);
+
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.thread_cache_bytes, 0);
+  a.Free(large);
+}
+
+TEST(BFCArenaTest, ThreadCacheMultipleThreads) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, BFCArena::DEFAULT_ARENA_EXTEND_STRATEGY,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK, 16 * 1024);
+
+  auto worker = [&a](int seed) {
+    std::vector<std::pair<char*, size_t>> live;
+    for (int i = 0; i < 2000; ++i) {
+      const size_t size = static_cast<size_t>((seed * 7919 + i * 104729) % 8192) + 1;
+      auto* p = static_cast<char*>(a.Alloc(size));
+      memset(p, seed, size);
+      live.emplace_back(p, size);
+
+      if (live.size() > 16) {
+        // the contents must not have been changed by another thread
+        auto& oldest = live.front();
+        ASSERT_EQ(oldest.first[0], static_cast<char>(seed));
+        ASSERT_EQ(oldest.first[oldest.second - 1], static_cast<char>(seed));
+        a.Free(oldest.first);
+        live.erase(live.begin());
+      }
+    }
+
+    for (auto& entry : live) {
+      a.Free(entry.first);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back(worker, i + 1);
+  }
+
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_GT(stats.num_thread_cache_hits, 0);
+  // everything has been freed so the only chunks in use are the ones held in the thread caches
+  EXPECT_EQ(stats.bytes_in_use, stats.thread_cache_bytes);
+}
+
+TEST(BFCArenaTest, ShrinkConsolidatesAndReleasesRegions) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30);
+  const size_t size = 1 << 20;
+
+  auto alloc_and_free = [&a, size](int count) {
+    std::vector<void*> ptrs;
+    for (int i = 0; i < count; ++i) {
+      ptrs.push_back(a.Alloc(size));
+    }
+    for (void* p : ptrs) {
+      a.Free(p);
+    }
+  };
+
+  // extends by regions of 1, 2 and 4MB
+  alloc_and_free(4);
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 7 * size);
+
+  // replaced by a single region of the peak
+  ASSERT_TRUE(a.Shrink().IsOK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 4 * size);
+  EXPECT_EQ(stats.total_released_bytes, 3 * size);
+  EXPECT_EQ(stats.num_shrinks, 1);
+
+  // the same usage fits without extending, and the arena is already as small as the peak
+  alloc_and_free(4);
+  ASSERT_TRUE(a.Shrink().IsOK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 4 * size);
+  EXPECT_EQ(stats.num_shrinks, 1);
+
+  // the usage dropped
+  alloc_and_free(1);
+  ASSERT_TRUE(a.Shrink().IsOK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, size);
+  EXPECT_EQ(stats.total_released_bytes, 6 * size);
+  EXPECT_EQ(stats.num_shrinks, 2);
+}
+
+TEST(BFCArenaTest, ShrinkKeepsRegionsInUse) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30);
+  const size_t size = 1 << 20;
+
+  void* p = a.Alloc(size);
+  void* q = a.Alloc(size);
+  memset(p, 1, size);
+  a.Free(q);
+
+  ASSERT_TRUE(a.Shrink().IsOK());
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  // the 1MB region holding p is kept, the free 2MB region is replaced by 1MB for the peak of 2MB
+  EXPECT_EQ(stats.total_allocated_bytes, 2 * size);
+  EXPECT_EQ(stats.total_released_bytes, size);
+  EXPECT_EQ(static_cast<char*>(p)[size - 1], 1);
+
+  // the peak since the last call was p
+  a.Free(p);
+  ASSERT_TRUE(a.Shrink().IsOK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, size);
+
+  ASSERT_TRUE(a.Shrink().IsOK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+TEST(BFCArenaTest, LargestFreeChunk) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30);
+  const size_t size = 1 << 20;
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.largest_free_chunk, 0);
+
+  // the first region of 1MB is fully used
+  void* p = a.Alloc(size);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.largest_free_chunk, 0);
+
+  // the second region of 2MB holds q and a free chunk for the remainder
+  void* q = a.Alloc(size / 2);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.largest_free_chunk, static_cast<int64_t>(2 * size - size / 2));
+
+  a.Free(q);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.largest_free_chunk, static_cast<int64_t>(2 * size));
+
+  a.Free(p);
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/data_transfer_manager.h"
+
+#include "gtest/gtest.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+// Copies between CPU memory and a device of type device_type, and records the sizes of the batches it gets
+class RecordingDataTransfer : public IDataTransfer {
+ public:
+  RecordingDataTransfer(OrtDevice::DeviceType device_type, std::vector<size_t>& batch_sizes)
+      : device_type_(device_type), batch_sizes_(batch_sizes) {}
+
+  using IDataTransfer::CopyTensor;
+
+  bool CanCopy(const OrtDevice& src_device, const OrtDevice& dst_device) const override {
+    return src_device.Type() == device_type_ || dst_device.Type() == device_type_;
+  }
+
+  common::Status CopyTensor(const Tensor& src, Tensor& dst, int /*exec_queue_id*/) const override {
+    memcpy(dst.MutableDataRaw(), src.DataRaw(), src.SizeInBytes());
+    return Status::OK();
+  }
+
+  common::Status CopyTensors(const std::vector<SrcDstPair>& src_dst_pairs) const override {
+    batch_sizes_.push_back(src_dst_pairs.size());
+    return IDataTransfer::CopyTensors(src_dst_pairs);
+  }
+
+ private:
+  const OrtDevice::DeviceType device_type_;
+  std::vector<size_t>& batch_sizes_;
+};
+}  // namespace
+
+TEST(DataTransferManagerTest, CopyTensorsBatchesByDataTransfer) {
+  std::vector<size_t> gpu_batch_sizes, fpga_batch_sizes;
+  DataTransferManager manager;
+  ASSERT_STATUS_OK(manager.RegisterDataTransfer(
+      onnxruntime::make_unique<RecordingDataTransfer>(OrtDevice::GPU, gpu_batch_sizes)));
+  ASSERT_STATUS_OK(manager.RegisterDataTransfer(
+      onnxruntime::make_unique<RecordingDataTransfer>(OrtDevice::FPGA, fpga_batch_sizes)));
+
+  // the "device" memory is CPU memory, only the locations differ
+  const OrtMemoryInfo cpu_location(CPU, OrtDeviceAllocator);
+  const OrtMemoryInfo gpu_location("FakeGpu", OrtDeviceAllocator, OrtDevice(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, 0));
+  const OrtMemoryInfo fpga_location("FakeFpga", OrtDeviceAllocator, OrtDevice(OrtDevice::FPGA, OrtDevice::MemType::DEFAULT, 0));
+
+  const auto float_type = DataTypeImpl::GetType<float>();
+  std::vector<float> values[4] = {{1.f, 2.f}, {3.f, 4.f}, {5.f, 6.f}, {7.f, 8.f}};
+  std::vector<float> results[4] = {std::vector<float>(2), std::vector<float>(2), std::vector<float>(2),
+                                   std::vector<float>(2)};
+  const OrtMemoryInfo* dst_locations[4] = {&gpu_location, &fpga_location, &gpu_location, &gpu_location};
+
+  std::vector<std::unique_ptr<Tensor>> tensors;
+  std::vector<IDataTransfer::SrcDstPair> pairs;
+  for (int i = 0; i < 4; ++i) {
+    tensors.push_back(onnxruntime::make_unique<Tensor>(float_type, TensorShape({2}), values[i].data(), cpu_location));
+    tensors.push_back(onnxruntime::make_unique<Tensor>(float_type, TensorShape({2}), results[i].data(), *dst_locations[i]));
+    pairs.push_back({*tensors[2 * i], *tensors[2 * i + 1], 0});
+  }
+
+  ASSERT_STATUS_OK(manager.CopyTensors(pairs));
+
+  // one batch for each data transfer, instead of a copy at a time for the mix of devices
+  EXPECT_EQ(gpu_batch_sizes, std::vector<size_t>{3});
+  EXPECT_EQ(fpga_batch_sizes, std::vector<size_t>{1});
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(results[i], values[i]);
+  }
+
+  // a copy without a data transfer fails before any copy is done
+  std::vector<float> unreachable(2);
+  const OrtMemoryInfo npu_location("FakeNpu", OrtDeviceAllocator,
+                                   OrtDevice(static_cast<OrtDevice::DeviceType>(10), OrtDevice::MemType::DEFAULT, 0));
+  Tensor unreachable_tensor(float_type, TensorShape({2}), unreachable.data(), npu_location);
+  Tensor other_unreachable_tensor(float_type, TensorShape({2}), unreachable.data(), npu_location);
+  pairs.push_back({unreachable_tensor, other_unreachable_tensor, 0});
+  gpu_batch_sizes.clear();
+  EXPECT_FALSE(manager.CopyTensors(pairs).IsOK());
+  EXPECT_TRUE(gpu_batch_sizes.empty());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,70 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/dim_param_expression.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+static const std::unordered_map<std::string, int64_t> kValues{{"batch", 4}, {"seq", 7}, {"unk__12", 3}};
+
+static int64_t Evaluate(const std::string& dim_param) {
+  int64_t result = -1;
+  auto status = EvaluateDimParam(dim_param, kValues, result);
+  EXPECT_TRUE(status.IsOK()) << dim_param << ": " << status.ErrorMessage();
+  return result;
+}
+
+static void ExpectError(const std::string& dim_param) {
+  int64_t result = -1;
+  EXPECT_FALSE(EvaluateDimParam(dim_param, kValues, result).IsOK()) << dim_param;
+}
+
+TEST(DimParamExpressionTest, Names) {
+  EXPECT_EQ(Evaluate("batch"), 4);
+  EXPECT_EQ(Evaluate("unk__12"), 3);
+
+  // a dim_param that is bound from the graph inputs is never parsed as an expression
+  const std::unordered_map<std::string, int64_t> values{{"seq-len", 5}};
+  int64_t result = -1;
+  ASSERT_TRUE(EvaluateDimParam("seq-len", values, result).IsOK());
+  EXPECT_EQ(result, 5);
+}
+
+TEST(DimParamExpressionTest, Arithmetic) {
+  EXPECT_EQ(Evaluate("batch*seq"), 28);
+  EXPECT_EQ(Evaluate("seq + 1"), 8);
+  EXPECT_EQ(Evaluate("2*seq - batch"), 10);
+  EXPECT_EQ(Evaluate("batch*(seq + 1)"), 32);
+  EXPECT_EQ(Evaluate("seq**2"), 49);
+  EXPECT_EQ(Evaluate("-batch + seq"), 3);
+  EXPECT_EQ(Evaluate("batch*seq/2"), 14);
+}
+
+TEST(DimParamExpressionTest, Functions) {
+  // the forms written by symbolic_shape_infer.py for e.g. Conv, Slice, Range and Resize
+  EXPECT_EQ(Evaluate("floor(seq/2) + 1"), 4);
+  EXPECT_EQ(Evaluate("floor((seq - 3)/2) + 1"), 3);
+  EXPECT_EQ(Evaluate("ceiling(seq/2)"), 4);
+  EXPECT_EQ(Evaluate("Max(0, seq - 10)"), 0);
+  EXPECT_EQ(Evaluate("Min(batch, seq, unk__12)"), 3);
+  EXPECT_EQ(Evaluate("Mod(seq, batch)"), 3);
+  EXPECT_EQ(Evaluate("floor(0.5*seq)"), 3);
+}
+
+TEST(DimParamExpressionTest, Errors) {
+  ExpectError("");
+  ExpectError("heads");
+  ExpectError("batch*heads");
+  ExpectError("seq/2");
+  ExpectError("batch - seq");
+  ExpectError("seq/(batch - 4)");
+  ExpectError("floor(seq");
+  ExpectError("batch seq");
+  ExpectError("sqrt(seq)");
+  ExpectError("floor(seq, 2)");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
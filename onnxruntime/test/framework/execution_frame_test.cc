@@ -8,6 +8,7 @@
 #include "core/graph/model.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test_utils.h"
 #include "test/test_environment.h"
 #include "test/framework/TestAllocatorManager.h"
@@ -254,6 +255,71 @@ TEST_F(ExecutionFrameTest, MemPatternTest) {
   ASSERT_EQ(p->GetBlock(4)->offset_, kAllocAlignment);
 }
 
+TEST_F(ExecutionFrameTest, SmallTensorSlabTest) {
+  onnxruntime::Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg x_def("X", &tensor_float), t1_def("T1", &tensor_float), t2_def("T2", &tensor_float),
+      t3_def("T3", &tensor_float), y_def("Y", &tensor_float);
+
+  graph.AddNode("node1", "Relu", "relu1", ArgMap{&x_def}, ArgMap{&t1_def})
+      .SetExecutionProviderType(kCpuExecutionProvider);
+  graph.AddNode("node2", "Relu", "relu2", ArgMap{&t1_def}, ArgMap{&t2_def})
+      .SetExecutionProviderType(kCpuExecutionProvider);
+  graph.AddNode("node3", "Relu", "relu3", ArgMap{&t2_def}, ArgMap{&t3_def})
+      .SetExecutionProviderType(kCpuExecutionProvider);
+  graph.AddNode("node4", "Relu", "relu4", ArgMap{&t3_def}, ArgMap{&y_def})
+      .SetExecutionProviderType(kCpuExecutionProvider);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  ExecutionProviders execution_providers;
+  execution_providers.Add(kCpuExecutionProvider, CreateCPUExecutionProvider());
+  KernelRegistryManager kernel_registry_manager;
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+  SessionState state(graph, execution_providers, false, &tp_, nullptr, dtm,
+                     DefaultLoggingManager().DefaultLogger(), profiler);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.AddConfigEntry(kOrtSessionOptionsConfigSmallTensorSlabBytes, "4096"));
+  ASSERT_STATUS_OK(state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager, so));
+  EXPECT_EQ(state.GetSmallTensorSlabBytes(), 4096u);
+  EXPECT_EQ(state.GetSmallTensorMaxBytes(), 1024u);
+
+  const OrtValueNameIdxMap& name_idx_map = state.GetOrtValueNameIdxMap();
+  int t1_idx = -1, t2_idx = -1, t3_idx = -1, y_idx = -1;
+  ASSERT_STATUS_OK(name_idx_map.GetIdx("T1", t1_idx));
+  ASSERT_STATUS_OK(name_idx_map.GetIdx("T2", t2_idx));
+  ASSERT_STATUS_OK(name_idx_map.GetIdx("T3", t3_idx));
+  ASSERT_STATUS_OK(name_idx_map.GetIdx("Y", y_idx));
+
+  vector<OrtValue> outputs;
+  ExecutionFrame frame({}, {}, {y_idx}, outputs, {}, state);
+  const auto& cpu_info = execution_providers.Get(kCpuExecutionProvider)->GetAllocator(0, OrtMemTypeDefault)->Info();
+
+  auto allocate = [&](int idx, std::vector<int64_t> dims) -> uintptr_t {
+    OrtValue& value = *frame.GetMutableNodeInputOrOutputMLValue(idx);
+    EXPECT_STATUS_OK(frame.AllocateMLValueTensorSelfOwnBuffer(value, idx, DataTypeImpl::GetType<float>(), cpu_info,
+                                                              TensorShape(dims)));
+    return reinterpret_cast<uintptr_t>(value.Get<Tensor>().DataRaw());
+  };
+
+  // small tensors are placed in the slab one after the other
+  const uintptr_t t1 = allocate(t1_idx, {2});
+  const uintptr_t t2 = allocate(t2_idx, {2, 3});
+  EXPECT_EQ(t2, t1 + kAllocAlignment);
+
+  // larger tensors and graph outputs are allocated individually
+  const uintptr_t t3 = allocate(t3_idx, {1024});
+  const uintptr_t y = allocate(y_idx, {2});
+  EXPECT_FALSE(t3 >= t1 && t3 < t1 + 4096);
+  EXPECT_FALSE(y >= t1 && y < t1 + 4096);
+}
+
 TEST(ExecutionFrameTestWithoutSessionState, BadModelInvalidDimParamUsage) {
   // load model with 2 Scan ops that both incorrectly use shapes of { 'None', 'None' } for their outputs.
   // as 'None' is not a special value it's treated as a variable name, leading to a runtime error when we
@@ -20,6 +20,7 @@
 #include "core/framework/execution_provider.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/run_latency_breakdown.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/graph/graph_viewer.h"
@@ -622,6 +623,47 @@ TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions) {
   }
 }
 
+TEST(InferenceSessionTests, CheckRunMemoryProfiler) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunMemoryProfiler";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_memory_profile_test");
+  ASSERT_STATUS_OK(so.AddConfigEntry(kOrtSessionOptionsConfigEnableMemoryProfiling, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  bool has_alloc = false;
+  bool has_node = false;
+  bool has_counter = false;
+  std::string line;
+  while (std::getline(profile, line)) {
+    if (line.find(R"("cat" : "Memory")") == string::npos) {
+      continue;
+    }
+
+    has_alloc = has_alloc || (line.find("_alloc") != string::npos && line.find("alloc_kind") != string::npos);
+    has_node = has_node || (line.find("_memory") != string::npos && line.find("peak_live_bytes") != string::npos);
+    // the counter values are numbers
+    has_counter = has_counter || (line.find(R"("ph" : "C")") != string::npos &&
+                                  line.find(R"("name" :"live_bytes")") != string::npos &&
+                                  line.find(R"("Cpu:0" : )") != string::npos &&
+                                  line.find(R"("Cpu:0" : ")") == string::npos);
+  }
+
+  EXPECT_TRUE(has_alloc);
+  EXPECT_TRUE(has_node);
+  EXPECT_TRUE(has_counter);
+}
+
 TEST(InferenceSessionTests, CheckRunProfilerWithStartProfile) {
   SessionOptions so;
 
@@ -897,6 +939,206 @@ TEST(InferenceSessionTests, TestIOBindingReuse) {
   }
 }
 
+TEST(InferenceSessionTests, TestIOBindingReuseOutputBuffer) {
+  SessionOptions so;
+  InferenceSession session_object(so, GetEnvironment());
+  std::unique_ptr<Model> p_model;
+  CreateMatMulModel(p_model, kCpuExecutionProvider);
+
+  std::string s1;
+  p_model->ToProto().SerializeToString(&s1);
+  std::stringstream sstr(s1);
+  ASSERT_STATUS_OK(session_object.Load(sstr));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  unique_ptr<IOBinding> io_binding;
+  ASSERT_STATUS_OK(session_object.NewIOBinding(&io_binding));
+
+  auto allocator = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  auto run = [&](const std::vector<int64_t>& dims_a, const std::vector<float>& values_a) {
+    OrtValue input_a;
+    OrtValue input_b;
+    CreateMLValue<float>(allocator, dims_a, values_a, &input_a);
+    CreateMLValue<float>(allocator, {2, 2}, {1.f, 0.f, 0.f, 1.f}, &input_b);
+    ASSERT_STATUS_OK(io_binding->BindInput("A", input_a));
+    ASSERT_STATUS_OK(io_binding->BindInput("B", input_b));
+    ASSERT_STATUS_OK(io_binding->BindOutput("Y", OrtDevice(), true));
+    ASSERT_STATUS_OK(session_object.Run(*io_binding));
+  };
+
+  run({2, 2}, {1.f, 2.f, 3.f, 4.f});
+  const void* first_buffer = io_binding->GetOutputs()[0].Get<Tensor>().DataRaw();
+  VerifyOutputs(io_binding->GetOutputs()[0].Get<Tensor>(), {2, 2}, {1.f, 2.f, 3.f, 4.f});
+
+  // same shape so the buffer from the first Run is reused
+  run({2, 2}, {5.f, 6.f, 7.f, 8.f});
+  EXPECT_EQ(io_binding->GetOutputs()[0].Get<Tensor>().DataRaw(), first_buffer);
+  VerifyOutputs(io_binding->GetOutputs()[0].Get<Tensor>(), {2, 2}, {5.f, 6.f, 7.f, 8.f});
+
+  // a new shape requires a new buffer
+  run({3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  VerifyOutputs(io_binding->GetOutputs()[0].Get<Tensor>(), {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+}
+
+TEST(InferenceSessionTests, SampledLatencyStats) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.SampledLatencyStats";
+  so.AddConfigEntry(kOrtSessionOptionsConfigProfilingSampleIntervalRuns, "2");
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  for (int i = 0; i < 4; ++i) {
+    RunModel(session_object, run_options);
+  }
+
+  std::string stats;
+  ASSERT_STATUS_OK(session_object.GetLatencyStats(stats, true));
+  EXPECT_NE(stats.find("\"sampled_runs\" : 2"), std::string::npos) << stats;
+  EXPECT_NE(stats.find("{\"op_type\" : \"Mul\", \"count\" : 2,"), std::string::npos) << stats;
+
+  // cleared by the previous call
+  ASSERT_STATUS_OK(session_object.GetLatencyStats(stats));
+  EXPECT_NE(stats.find("\"sampled_runs\" : 0, \"nodes\" : [], \"op_types\" : []"), std::string::npos) << stats;
+
+  // sampling is disabled by default
+  InferenceSession session_without_sampling{SessionOptions(), GetEnvironment()};
+  ASSERT_STATUS_OK(session_without_sampling.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_without_sampling.Initialize());
+  EXPECT_FALSE(session_without_sampling.GetLatencyStats(stats).IsOK());
+}
+
+TEST(InferenceSessionTests, ThreadPoolStats) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.ThreadPoolStats";
+  so.intra_op_param.thread_pool_size = 2;
+  so.AddConfigEntry(kOrtSessionOptionsConfigProfilingThreadPoolStats, "1");
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+
+  // the sequential execution mode has no inter-op thread pool
+  std::string stats;
+  ASSERT_STATUS_OK(session_object.GetThreadPoolStats(stats, true));
+  EXPECT_EQ(stats.find("{\"intra_op\" : {\"steals\" : "), 0u) << stats;
+  EXPECT_NE(stats.find("\"call_sites\" : ["), std::string::npos) << stats;
+  EXPECT_EQ(stats.find("inter_op"), std::string::npos) << stats;
+
+  // the collection is disabled by default
+  InferenceSession session_without_stats{SessionOptions(), GetEnvironment()};
+  ASSERT_STATUS_OK(session_without_stats.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_without_stats.Initialize());
+  EXPECT_FALSE(session_without_stats.GetThreadPoolStats(stats).IsOK());
+}
+
+TEST(InferenceSessionTests, RunWithinTimeout) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.RunWithinTimeout";
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // the runs of an idle session are not rejected, and these take much less than the timeout
+  RunOptions run_options;
+  run_options.timeout_ms = 60 * 1000;
+  RunModel(session_object, run_options);
+  RunModel(session_object, run_options);
+}
+
+TEST(InferenceSessionTests, TensorCalibrationStats) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.TensorCalibrationStats";
+  so.AddConfigEntry(kOrtSessionOptionsConfigCalibrationTensorNames, "X;Y");
+  so.AddConfigEntry(kOrtSessionOptionsConfigCalibrationHistogramBins, "256");
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  RunModel(session_object, run_options);
+
+  std::string stats;
+  ASSERT_STATUS_OK(session_object.GetCalibrationStats(stats, true));
+  EXPECT_NE(stats.find("{\"name\" : \"X\", \"count\" : 12, \"min\" : 1, \"max\" : 6, \"histogram_range\" : 6,"),
+            std::string::npos)
+      << stats;
+  EXPECT_NE(stats.find("{\"name\" : \"Y\", \"count\" : 12, \"min\" : 1, \"max\" : 36, \"histogram_range\" : 36,"),
+            std::string::npos)
+      << stats;
+
+  // cleared by the previous call
+  ASSERT_STATUS_OK(session_object.GetCalibrationStats(stats));
+  EXPECT_EQ(stats, "{\"tensors\" : []}");
+
+  // the collection is disabled by default
+  InferenceSession session_without_stats{SessionOptions(), GetEnvironment()};
+  ASSERT_STATUS_OK(session_without_stats.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_without_stats.Initialize());
+  EXPECT_FALSE(session_without_stats.GetCalibrationStats(stats).IsOK());
+}
+
+TEST(InferenceSessionTests, RunLatencyBreakdown) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.RunLatencyBreakdown";
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.latency_breakdown = std::make_shared<RunLatencyBreakdownRecord>();
+  RunLatencyBreakdown breakdown;
+  EXPECT_FALSE(run_options.latency_breakdown->Get(breakdown));
+
+  RunModel(session_object, run_options);
+  ASSERT_TRUE(run_options.latency_breakdown->Get(breakdown));
+  ASSERT_EQ(breakdown.kernel_ns.size(), 1u);
+  EXPECT_EQ(breakdown.kernel_ns.begin()->first, kCpuExecutionProvider);
+  EXPECT_GT(breakdown.total_ns, 0);
+  EXPECT_GE(breakdown.total_ns, breakdown.validation_ns + breakdown.frame_setup_ns +
+                                    breakdown.kernel_ns.begin()->second);
+  // everything is on the CPU
+  EXPECT_EQ(breakdown.num_memcpy_nodes, 0);
+  EXPECT_EQ(breakdown.input_copy_ns, 0);
+  EXPECT_EQ(breakdown.output_copy_ns, 0);
+
+  const std::string json = breakdown.ToJson();
+  EXPECT_NE(json.find("\"kernel_us_per_provider\" : {\"CPUExecutionProvider\" : "), std::string::npos) << json;
+}
+
+TEST(InferenceSessionTests, CloneSharesSessionState) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.CloneSharesSessionState";
+  so.intra_op_param.thread_pool_size = 1;
+
+  InferenceSession session_object{so, GetEnvironment()};
+  std::unique_ptr<InferenceSession> clone;
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_FALSE(session_object.Clone(so, clone).IsOK());
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  SessionOptions clone_so;
+  clone_so.session_logid = "InferenceSessionTests.CloneSharesSessionState.Clone";
+  clone_so.intra_op_param.thread_pool_size = 2;
+  ASSERT_STATUS_OK(session_object.Clone(clone_so, clone));
+  EXPECT_EQ(&clone->GetSessionState(), &session_object.GetSessionState());
+  EXPECT_EQ(clone->GetSessionOptions().session_logid, clone_so.session_logid);
+  EXPECT_EQ(clone->GetSessionOptions().intra_op_param.thread_pool_size, 2);
+  EXPECT_EQ(clone->GetRegisteredProviderTypes(), session_object.GetRegisteredProviderTypes());
+
+  RunOptions run_options;
+  RunModel(*clone, run_options);
+  RunModel(session_object, run_options);
+}
+
 TEST(InferenceSessionTests, InvalidInputTypeOfTensorElement) {
   SessionOptions so;
 
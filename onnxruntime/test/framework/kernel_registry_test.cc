@@ -4,6 +4,8 @@
 #include <gtest/gtest.h>
 #include <core/framework/kernel_registry.h>
 #include <core/framework/op_kernel.h>
+#include "core/graph/model.h"
+#include "test/test_environment.h"
 
 using namespace onnxruntime;
 static Status RegKernels(KernelRegistry& r, std::vector<std::unique_ptr<KernelDef> >& function_table, const KernelCreateFn& kernel_creator) {
@@ -101,4 +103,41 @@ TEST(KernelRegistryTests, two_versions4) {
   function_table.emplace_back(KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).SetName("Elu").SetDomain("").SinceVersion(6,7).Provider(kCpuExecutionProvider).Build());
   Status st;
   ASSERT_FALSE((st = RegKernels(r, function_table, CreateFakeKernel)).IsOK());
-}
\ No newline at end of file
+}
+
+// The kernel matching the version and input type is found, and the reasons are reported when none matches
+TEST(KernelRegistryTests, find_kernel_by_type) {
+  KernelRegistry r;
+  std::vector<std::unique_ptr<KernelDef> > function_table;
+  function_table.emplace_back(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).SetName("Elu").SetDomain("").SinceVersion(1, 5).Provider(kCpuExecutionProvider).Build());
+  function_table.emplace_back(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()).SetName("Elu").SetDomain("").SinceVersion(6).Provider(kCpuExecutionProvider).Build());
+  function_table.emplace_back(KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()).SetName("Elu").SetDomain("").SinceVersion(6).Provider(kCpuExecutionProvider).Build());
+  Status st;
+  ASSERT_TRUE((st = RegKernels(r, function_table, CreateFakeKernel)).IsOK()) << st.ErrorMessage();
+
+  auto find_kernel = [&r](ONNX_NAMESPACE::TensorProto_DataType elem_type, const KernelCreateInfo** info) {
+    Model model("elu", false, test::DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+    ONNX_NAMESPACE::TypeProto tensor_type;
+    tensor_type.mutable_tensor_type()->set_elem_type(elem_type);
+    auto& x = graph.GetOrCreateNodeArg("x", &tensor_type);
+    auto& y = graph.GetOrCreateNodeArg("y", &tensor_type);
+    auto& node = graph.AddNode("elu", "Elu", "elu", {&x}, {&y});
+    ORT_RETURN_IF_ERROR(graph.Resolve());
+    return r.TryFindKernel(node, kCpuExecutionProvider, info);
+  };
+
+  const KernelCreateInfo* info = nullptr;
+  ASSERT_TRUE((st = find_kernel(ONNX_NAMESPACE::TensorProto_DataType_DOUBLE, &info)).IsOK()) << st.ErrorMessage();
+  ASSERT_NE(info, nullptr);
+  EXPECT_EQ(info->kernel_def->TypeConstraints().at("T")[0], DataTypeImpl::GetTensorType<double>());
+
+  ASSERT_TRUE((st = find_kernel(ONNX_NAMESPACE::TensorProto_DataType_FLOAT, &info)).IsOK()) << st.ErrorMessage();
+  EXPECT_EQ(info->kernel_def->TypeConstraints().at("T")[0], DataTypeImpl::GetTensorType<float>());
+
+  st = find_kernel(ONNX_NAMESPACE::TensorProto_DataType_FLOAT16, &info);
+  ASSERT_FALSE(st.IsOK());
+  EXPECT_EQ(info, nullptr);
+  EXPECT_NE(st.ErrorMessage().find("the types are incompatible"), std::string::npos) << st.ErrorMessage();
+  EXPECT_NE(st.ErrorMessage().find("Version mismatch"), std::string::npos) << st.ErrorMessage();
+}
@@ -0,0 +1,168 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/mem_pattern_cache.h"
+
+#include <cstdio>
+
+#include "core/framework/allocator.h"
+#include "core/framework/mem_pattern_planner.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+static std::shared_ptr<const MemoryPatternCache::Entry> CreateEntry() {
+  return std::make_shared<MemoryPatternCache::Entry>();
+}
+
+TEST(MemoryPatternCacheTest, KeyUsesFullShape) {
+  MemoryPatternCache cache;
+  ASSERT_TRUE(cache.Configure(0, 0).IsOK());
+
+  // these all produced the same key when the dims were XOR'd together
+  TensorShape a{2, 3}, b{3, 2}, c{2}, d{3};
+  auto key_ab = cache.CreateKey({std::cref(a), std::cref(b)});
+  auto key_ba = cache.CreateKey({std::cref(b), std::cref(a)});
+  auto key_cd = cache.CreateKey({std::cref(c), std::cref(d)});
+  EXPECT_NE(key_ab, key_ba);
+  EXPECT_NE(key_ab, key_cd);
+
+  cache.Insert(key_ab, CreateEntry());
+  EXPECT_NE(cache.Find(key_ab), nullptr);
+  EXPECT_EQ(cache.Find(key_ba), nullptr);
+  EXPECT_EQ(cache.Find(key_cd), nullptr);
+
+  auto stats = cache.GetStats();
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.misses, 2u);
+  EXPECT_EQ(stats.insertions, 1u);
+}
+
+TEST(MemoryPatternCacheTest, DimBucketing) {
+  MemoryPatternCache cache;
+  ASSERT_TRUE(cache.Configure(0, 32).IsOK());
+  ASSERT_TRUE(cache.IsBucketed());
+
+  TensorShape seq_33{1, 33}, seq_64{1, 64}, seq_65{1, 65};
+  EXPECT_EQ(cache.CreateKey({std::cref(seq_33)}), cache.CreateKey({std::cref(seq_64)}));
+  EXPECT_NE(cache.CreateKey({std::cref(seq_64)}), cache.CreateKey({std::cref(seq_65)}));
+
+  // zero sized dims are not rounded up
+  TensorShape empty{0, 33}, one{1, 33};
+  EXPECT_NE(cache.CreateKey({std::cref(empty)}), cache.CreateKey({std::cref(one)}));
+
+  EXPECT_FALSE(cache.Configure(0, -1).IsOK());
+}
+
+TEST(MemoryPatternCacheTest, LruEviction) {
+  MemoryPatternCache cache;
+  ASSERT_TRUE(cache.Configure(2, 0).IsOK());
+
+  TensorShape s1{1}, s2{2}, s3{3};
+  auto k1 = cache.CreateKey({std::cref(s1)});
+  auto k2 = cache.CreateKey({std::cref(s2)});
+  auto k3 = cache.CreateKey({std::cref(s3)});
+
+  cache.Insert(k1, CreateEntry());
+  cache.Insert(k2, CreateEntry());
+
+  // make k1 the most recently used so k2 is evicted
+  auto entry1 = cache.Find(k1);
+  ASSERT_NE(entry1, nullptr);
+  cache.Insert(k3, CreateEntry());
+
+  EXPECT_EQ(cache.Size(), 2u);
+  EXPECT_NE(cache.Find(k1), nullptr);
+  EXPECT_EQ(cache.Find(k2), nullptr);
+  EXPECT_NE(cache.Find(k3), nullptr);
+  EXPECT_EQ(cache.GetStats().evictions, 1u);
+
+  // an entry remains usable by a holder after it is removed from the cache
+  cache.Erase(k1);
+  EXPECT_EQ(cache.Find(k1), nullptr);
+  EXPECT_EQ(entry1.use_count(), 1);
+}
+
+TEST(MemoryPatternCacheTest, InsertKeepsExistingEntry) {
+  MemoryPatternCache cache;
+  ASSERT_TRUE(cache.Configure(0, 0).IsOK());
+
+  TensorShape s{4, 4};
+  auto key = cache.CreateKey({std::cref(s)});
+  auto first = CreateEntry();
+  cache.Insert(key, first);
+  cache.Insert(key, CreateEntry());
+
+  EXPECT_EQ(cache.Find(key), first);
+  EXPECT_EQ(cache.GetStats().insertions, 1u);
+}
+
+TEST(MemoryPatternCacheTest, SaveAndLoad) {
+  const std::string file_path = "mem_pattern_cache_test_save_and_load.txt";
+  const OrtMemoryInfo cpu_location(CPU, OrtDeviceAllocator);
+  constexpr uint64_t fingerprint = 1234;
+
+  MemoryPatternCache cache;
+  ASSERT_TRUE(cache.Configure(0, 0).IsOK());
+
+  MemPatternPlanner planner(false);
+  planner.TraceAllocation(3, 64);
+  planner.TraceAllocation(5, 32);
+  planner.TraceFree(3);
+  planner.TraceAllocation(7, 16);
+
+  auto entry = std::make_shared<MemoryPatternCache::Entry>();
+  entry->patterns.locations.push_back(cpu_location);
+  entry->patterns.patterns.push_back(planner.GenerateMemPattern());
+  entry->inferred_shapes[5] = TensorShape({2, 4});
+
+  TensorShape s1{1, 8}, s2{1, 16};
+  auto k1 = cache.CreateKey({std::cref(s1)});
+  auto k2 = cache.CreateKey({std::cref(s2)});
+  EXPECT_TRUE(cache.Insert(k1, entry));
+  EXPECT_TRUE(cache.Insert(k2, CreateEntry()));
+  ASSERT_TRUE(cache.Save(file_path, fingerprint).IsOK());
+
+  MemoryPatternCache loaded;
+  ASSERT_TRUE(loaded.Configure(1, 0).IsOK());
+  ASSERT_TRUE(loaded.Load(file_path, fingerprint, {cpu_location}).IsOK());
+
+  // k1 was the least recently used entry, so it was evicted when loading into a cache of one entry
+  EXPECT_EQ(loaded.Size(), 1u);
+  EXPECT_NE(loaded.Find(k2), nullptr);
+
+  ASSERT_TRUE(loaded.Configure(0, 0).IsOK());
+  ASSERT_TRUE(loaded.Load(file_path, fingerprint, {cpu_location}).IsOK());
+  auto loaded_entry = loaded.Find(k1);
+  ASSERT_NE(loaded_entry, nullptr);
+  ASSERT_EQ(loaded_entry->patterns.locations.size(), 1u);
+  EXPECT_EQ(loaded_entry->patterns.locations[0], cpu_location);
+  const auto& pattern = entry->patterns.patterns[0];
+  const auto& loaded_pattern = loaded_entry->patterns.patterns[0];
+  EXPECT_EQ(loaded_pattern.PeakSize(), pattern.PeakSize());
+  for (int idx : {3, 5, 7}) {
+    ASSERT_NE(loaded_pattern.GetBlock(idx), nullptr);
+    EXPECT_EQ(loaded_pattern.GetBlock(idx)->offset_, pattern.GetBlock(idx)->offset_);
+    EXPECT_EQ(loaded_pattern.GetBlock(idx)->size_, pattern.GetBlock(idx)->size_);
+  }
+  EXPECT_EQ(loaded_entry->inferred_shapes.at(5), TensorShape({2, 4}));
+
+  // a file saved for another graph, location or dimension bucket size adds nothing
+  MemoryPatternCache rejected;
+  ASSERT_TRUE(rejected.Configure(0, 0).IsOK());
+  EXPECT_FALSE(rejected.Load(file_path, fingerprint + 1, {cpu_location}).IsOK());
+  EXPECT_FALSE(rejected.Load(file_path, fingerprint, {}).IsOK());
+  ASSERT_TRUE(rejected.Configure(0, 32).IsOK());
+  EXPECT_FALSE(rejected.Load(file_path, fingerprint, {cpu_location}).IsOK());
+  EXPECT_EQ(rejected.Size(), 0u);
+
+  std::remove(file_path.c_str());
+
+  // a file that does not exist has no patterns
+  EXPECT_TRUE(rejected.Load(file_path, fingerprint, {cpu_location}).IsOK());
+  EXPECT_EQ(rejected.Size(), 0u);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -4,6 +4,8 @@
 // if we can't load an ORT format model we can't really test anything
 #if defined(ENABLE_ORT_FORMAT_LOAD)
 
+#include <algorithm>
+
 #include "core/common/make_unique.h"
 #include "core/framework/data_types.h"
 #include "core/framework/tensorprotoutils.h"
@@ -15,6 +17,8 @@
 #include "test_utils.h"
 #include "test/util/include/asserts.h"
 #include "test/util/include/inference_session_wrapper.h"
+#include "test/util/include/temp_dir.h"
+#include "core/platform/path_lib.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "flatbuffers/idl.h"
 #include "flatbuffers/util.h"
@@ -194,12 +198,16 @@ static void CompareGraphAndSessionState(const InferenceSessionWrapper& session_o
   }
 }
 
-static void SaveAndCompareModels(const std::string& onnx_file, const std::basic_string<ORTCHAR_T>& ort_file) {
+static void SaveAndCompareModels(const std::string& onnx_file, const std::basic_string<ORTCHAR_T>& ort_file,
+                                 const std::vector<std::pair<std::string, std::string>>& save_configs = {}) {
   SessionOptions so;
   so.session_logid = "SerializeToOrtFormat";
   so.optimized_model_filepath = ort_file;
   // not strictly necessary - type should be inferred from the filename
   so.AddConfigEntry(kOrtSessionOptionsConfigSaveModelFormat, "ORT");
+  for (const auto& config : save_configs) {
+    so.AddConfigEntry(config.first.c_str(), config.second.c_str());
+  }
   InferenceSessionWrapper session_object{so, GetEnvironment()};
 
   // create .ort file during Initialize due to values in SessionOptions
@@ -302,6 +310,35 @@ TEST(OrtModelOnlyTests, SerializeToOrtFormat) {
   RunOrtModel(test_info);
 }
 
+// the initializers are compared after the compressed ones are decompressed when loading the model
+TEST(OrtModelOnlyTests, SerializeToOrtFormatWithCompressedInitializers) {
+  for (const char* compression : {"LZ4", "BYTE_SHUFFLE_LZ4"}) {
+    SCOPED_TRACE(compression);
+    const std::basic_string<ORTCHAR_T> ort_file = ORT_TSTR("testdata/mnist.onnx.compressed.test_output.ort");
+    SaveAndCompareModels("testdata/mnist.onnx", ort_file,
+                         {{kOrtSessionOptionsConfigOrtFormatInitializerCompression, compression}});
+
+    OrtModelTestInfo test_info;
+    test_info.model_filename = ort_file;
+    test_info.logid = "SerializeToOrtFormatWithCompressedInitializers";
+    test_info.configs.push_back(std::make_pair(kOrtSessionOptionsConfigLoadModelFormat, "ORT"));
+
+    OrtValue ml_value;
+    vector<float> data(28 * 28, 1.0);
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 1, 28, 28}, data,
+                         &ml_value);
+    test_info.inputs.insert(std::make_pair("Input3", ml_value));
+
+    test_info.output_names = {"Plus214_Output_0"};
+    test_info.output_verifier = [](const std::vector<OrtValue>& fetches) {
+      const auto& output = fetches[0].Get<Tensor>();
+      ASSERT_EQ(output.Shape().Size(), 10);
+    };
+
+    RunOrtModel(test_info);
+  }
+}
+
 TEST(OrtModelOnlyTests, SparseInitializerHandling) {
   const std::basic_string<ORTCHAR_T> ort_file =
       ORT_TSTR("testdata/ort_minimal_test_models/sparse_initializer_handling.onnx.test_output.ort");
@@ -323,6 +360,98 @@ TEST(OrtModelOnlyTests, SparseInitializerHandling) {
   ASSERT_EQ(init_def.Name(), "x");
 }
 
+TEST(OrtModelOnlyTests, InitializationCache) {
+  TemporaryDirectory cache_dir{ORT_TSTR("ort_model_only_test_initialization_cache")};
+
+  // the cache entries with the given suffix
+  auto get_cache_entries = [&cache_dir](const std::basic_string<ORTCHAR_T>& suffix) {
+    std::vector<std::basic_string<ORTCHAR_T>> entries;
+    LoopDir(cache_dir.Path(), [&entries, &suffix](const ORTCHAR_T* filename, OrtFileType f_type) -> bool {
+      std::basic_string<ORTCHAR_T> name(filename);
+      if (f_type == OrtFileType::TYPE_REG && name.size() > suffix.size() &&
+          name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+        entries.push_back(name);
+      }
+      return true;
+    });
+    return entries;
+  };
+
+  SessionOptions so;
+  so.session_logid = "InitializationCache";
+  so.AddConfigEntry(kOrtSessionOptionsConfigInitializationCacheDir, ToMBString(cache_dir.Path()).c_str());
+
+  // the first session optimizes the model and saves the cache entry, with the weights pre-packed by its kernels
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load("testdata/mnist.onnx"));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  const auto entries = get_cache_entries(ORT_TSTR(".ort"));
+  ASSERT_EQ(entries.size(), 1U);
+  const auto prepacked_entries = get_cache_entries(ORT_TSTR(".prepacked"));
+  ASSERT_EQ(prepacked_entries.size(), 1U);
+  ASSERT_EQ(prepacked_entries[0], entries[0] + ORT_TSTR(".prepacked"));
+
+  // the second session loads the cache entry and uses the pre-packed weights
+  InferenceSessionWrapper session_object2{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object2.Load("testdata/mnist.onnx"));
+  ASSERT_STATUS_OK(session_object2.Initialize());
+  ASSERT_EQ(get_cache_entries(ORT_TSTR(".ort")), entries);
+  ASSERT_NE(session_object2.GetSessionState().GetPrePackedWeightsCache(), nullptr);
+  ASSERT_GT(session_object2.GetSessionState().GetPrePackedWeightsCache()->GetNumberOfEntries(), 0U);
+
+  CompareGraphAndSessionState(session_object, session_object2);
+
+  OrtValue ml_value;
+  vector<float> data(28 * 28);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 13) / 13.0f;
+  }
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 1, 28, 28}, data,
+                       &ml_value);
+  NameMLValMap feeds{{"Input3", ml_value}};
+  std::vector<OrtValue> expected_fetches;
+  ASSERT_STATUS_OK(session_object.Run(feeds, {"Plus214_Output_0"}, &expected_fetches));
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object2.Run(feeds, {"Plus214_Output_0"}, &fetches));
+  ASSERT_EQ(fetches[0].Get<Tensor>().Shape(), expected_fetches[0].Get<Tensor>().Shape());
+  const auto expected = expected_fetches[0].Get<Tensor>().DataAsSpan<float>();
+  const auto result = fetches[0].Get<Tensor>().DataAsSpan<float>();
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), result.begin()));
+
+  // a different optimization level uses a different entry
+  SessionOptions so3 = so;
+  so3.graph_optimization_level = TransformerLevel::Level1;
+  InferenceSessionWrapper session_object3{so3, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object3.Load("testdata/mnist.onnx"));
+  ASSERT_STATUS_OK(session_object3.Initialize());
+  ASSERT_EQ(get_cache_entries(ORT_TSTR(".ort")).size(), 2U);
+
+  // invalid pre-packed weights are ignored
+  {
+    std::ofstream entry_stream(cache_dir.Path() + ORT_TSTR("/") + prepacked_entries[0],
+                               std::ios::binary | std::ios::trunc);
+    entry_stream << "not pre-packed weights";
+  }
+
+  InferenceSessionWrapper session_object4{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object4.Load("testdata/mnist.onnx"));
+  ASSERT_STATUS_OK(session_object4.Initialize());
+  ASSERT_EQ(session_object4.GetSessionState().GetPrePackedWeightsCache(), nullptr);
+  ASSERT_STATUS_OK(session_object4.Run(feeds, {"Plus214_Output_0"}, &fetches));
+
+  // an invalid entry is ignored
+  {
+    std::ofstream entry_stream(cache_dir.Path() + ORT_TSTR("/") + entries[0], std::ios::binary | std::ios::trunc);
+    entry_stream << "not an ORT format model";
+  }
+
+  InferenceSessionWrapper session_object5{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object5.Load("testdata/mnist.onnx"));
+  ASSERT_STATUS_OK(session_object5.Initialize());
+  ASSERT_STATUS_OK(session_object5.Run(feeds, {"Plus214_Output_0"}, &fetches));
+}
+
 #if !defined(DISABLE_ML_OPS)
 TEST(OrtModelOnlyTests, SerializeToOrtFormatMLOps) {
   const std::basic_string<ORTCHAR_T> ort_file =
@@ -414,6 +543,13 @@ TEST(OrtModelOnlyTests, LoadOrtFormatModelFromBuffer) {
   RunOrtModel(test_info);
 }
 
+// Memory map the model file instead of reading it into a buffer
+TEST(OrtModelOnlyTests, LoadOrtFormatModelUsingMmap) {
+  OrtModelTestInfo test_info = GetTestInfoForLoadOrtFormatModel();
+  test_info.configs.push_back(std::make_pair(kOrtSessionOptionsConfigUseMmapForOrtModel, "1"));
+  RunOrtModel(test_info);
+}
+
 #if !defined(DISABLE_ML_OPS)
 // test that we can deserialize and run a previously saved ORT format model
 // for a model with sequence and map outputs
@@ -2,9 +2,13 @@
 // Licensed under the MIT License.
 
 #include "core/framework/data_types.h"
+#include "core/framework/heterogeneous_executor.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/work_stealing_executor.h"
+#include "core/graph/model.h"
 #include "test/providers/provider_test_utils.h"
 #include "test_utils.h"
+#include "test/test_environment.h"
 #include "core/session/inference_session.h"
 
 #include "gtest/gtest.h"
@@ -77,7 +81,7 @@ struct TestOp {
 };
 
 // test that the status from TestOp is correctly returned from InferenceSession::Run
-TEST(ParallelExecutor, TestStatusPropagation) {
+static void TestStatusPropagation(ExecutionMode execution_mode) {
   auto registry = std::make_shared<CustomRegistry>();
   std::vector<OpSchema> schemas{TestOp::OpSchema()};
   Status status;
@@ -94,7 +98,7 @@ TEST(ParallelExecutor, TestStatusPropagation) {
     tester.AddOutput<int64_t>("action_out", {1}, {0});
     // TensorRT doesn't handle a custom op. Possibly it should, but that would be a separate PR
     tester.Run(OpTester::ExpectResult::kExpectSuccess, {}, {kTensorrtExecutionProvider}, nullptr, nullptr,
-               ExecutionMode::ORT_PARALLEL);
+               execution_mode);
   }
 
   {  // test failure
@@ -104,7 +108,7 @@ TEST(ParallelExecutor, TestStatusPropagation) {
     tester.AddInput<int64_t>("action", {1}, {/*failure*/ 1});
     tester.AddOutput<int64_t>("action_out", {1}, {0});
     tester.Run(OpTester::ExpectResult::kExpectFailure, "Action was 1", {kTensorrtExecutionProvider}, nullptr, nullptr,
-               ExecutionMode::ORT_PARALLEL);
+               execution_mode);
   }
 
   {  // test exception
@@ -113,11 +117,75 @@ TEST(ParallelExecutor, TestStatusPropagation) {
 
     tester.AddInput<int64_t>("action", {1}, {/*exception*/ 2});
     tester.AddOutput<int64_t>("action_out", {1}, {0});
-    tester.Run(OpTester::ExpectResult::kExpectFailure, "Throwing as action was 2", {kTensorrtExecutionProvider}, nullptr, nullptr, ExecutionMode::ORT_PARALLEL);
+    tester.Run(OpTester::ExpectResult::kExpectFailure, "Throwing as action was 2", {kTensorrtExecutionProvider}, nullptr, nullptr, execution_mode);
   }
 }
 
-class ParallelExecutorThreadPoolTest : public testing::TestWithParam<int> {
+TEST(ParallelExecutor, TestStatusPropagation) {
+  TestStatusPropagation(ExecutionMode::ORT_PARALLEL);
+}
+
+TEST(WorkStealingExecutor, TestStatusPropagation) {
+  TestStatusPropagation(ExecutionMode::ORT_PARALLEL_WORK_STEALING);
+}
+
+TEST(WorkStealingExecutor, InlineCandidates) {
+  onnxruntime::Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+
+  TypeProto small_float, large_float, unknown_float;
+  small_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  small_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(16);
+  large_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  large_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1024);
+  large_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1024);
+  unknown_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  unknown_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+
+  auto& small_in = graph.GetOrCreateNodeArg("small_in", &small_float);
+  auto& small_out = graph.GetOrCreateNodeArg("small_out", &small_float);
+  auto& large_in = graph.GetOrCreateNodeArg("large_in", &large_float);
+  auto& large_out = graph.GetOrCreateNodeArg("large_out", &large_float);
+  auto& unknown_in = graph.GetOrCreateNodeArg("unknown_in", &unknown_float);
+  auto& unknown_out = graph.GetOrCreateNodeArg("unknown_out", &unknown_float);
+
+  auto& small_node = graph.AddNode("small", "Relu", "small relu", {&small_in}, {&small_out});
+  auto& large_node = graph.AddNode("large", "Relu", "large relu", {&large_in}, {&large_out});
+  auto& unknown_node = graph.AddNode("unknown", "Relu", "relu with unknown shape", {&unknown_in}, {&unknown_out});
+
+  EXPECT_TRUE(WorkStealingExecutor::IsInlineCandidate(small_node));
+  EXPECT_FALSE(WorkStealingExecutor::IsInlineCandidate(large_node));
+  EXPECT_FALSE(WorkStealingExecutor::IsInlineCandidate(unknown_node));
+}
+
+TEST(HeterogeneousExecutor, TestStatusPropagation) {
+  TestStatusPropagation(ExecutionMode::ORT_PARALLEL_HETEROGENEOUS);
+}
+
+TEST(HeterogeneousExecutor, DeviceNodes) {
+  onnxruntime::Model model("test", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(16);
+
+  auto& input = graph.GetOrCreateNodeArg("input", &float_tensor);
+  auto& cpu_out = graph.GetOrCreateNodeArg("cpu_out", &float_tensor);
+  auto& cuda_out = graph.GetOrCreateNodeArg("cuda_out", &float_tensor);
+
+  auto& cpu_node = graph.AddNode("cpu", "Relu", "relu on cpu", {&input}, {&cpu_out});
+  auto& cuda_node = graph.AddNode("cuda", "Relu", "relu on cuda", {&input}, {&cuda_out});
+  cpu_node.SetExecutionProviderType(kCpuExecutionProvider);
+  cuda_node.SetExecutionProviderType(kCudaExecutionProvider);
+
+  EXPECT_FALSE(HeterogeneousExecutor::IsDeviceNode(cpu_node));
+  EXPECT_TRUE(HeterogeneousExecutor::IsDeviceNode(cuda_node));
+}
+
+class ParallelExecutorThreadPoolTest : public testing::TestWithParam<std::tuple<ExecutionMode, int>> {
 };
 
 TEST_P(ParallelExecutorThreadPoolTest, TestNullInterOpThreadPool) {
@@ -138,12 +206,15 @@ TEST_P(ParallelExecutorThreadPoolTest, TestNullInterOpThreadPool) {
   onnxruntime::SessionOptions so;
   so.session_logid = "TestOp";
   so.session_log_verbosity_level = 1;
-  so.execution_mode = ExecutionMode::ORT_PARALLEL;
-  so.inter_op_param.thread_pool_size = GetParam();
+  so.execution_mode = std::get<0>(GetParam());
+  so.inter_op_param.thread_pool_size = std::get<1>(GetParam());
   tester.Run(so, OpTester::ExpectResult::kExpectSuccess, {}, {kTensorrtExecutionProvider}, nullptr, nullptr);
 }
 
 INSTANTIATE_TEST_SUITE_P(ParallelExecutorThreadPoolTests, ParallelExecutorThreadPoolTest,
-                        testing::Values(1, 0));
+                         testing::Combine(testing::Values(ExecutionMode::ORT_PARALLEL,
+                                                          ExecutionMode::ORT_PARALLEL_WORK_STEALING,
+                                                          ExecutionMode::ORT_PARALLEL_HETEROGENEOUS),
+                                          testing::Values(1, 0)));
 }  // namespace test
 }  // namespace onnxruntime
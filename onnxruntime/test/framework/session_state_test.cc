@@ -182,12 +182,29 @@ class PrePackingTestOpKernel : public OpKernel {
     return Status::OK();
   }
 
-  Status PrePack(const Tensor& tensor, int input_idx, bool& is_packed) override {
-    ORT_UNUSED_PARAMETER(tensor);
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc, bool& is_packed,
+                 PrePackedWeights* prepacked_weights) override {
     ORT_UNUSED_PARAMETER(input_idx);
+    const size_t size = tensor.SizeInBytes();
+    packed_ = BufferUniquePtr(alloc->Alloc(size), BufferDeleter(alloc));
+    memcpy(packed_.get(), tensor.DataRaw(), size);
+    if (prepacked_weights != nullptr) {
+      prepacked_weights->buffers_.push_back(std::move(packed_));
+      prepacked_weights->buffer_sizes_.push_back(size);
+    }
     is_packed = true;
     return Status::OK();
   }
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   bool& used_shared_buffers) override {
+    ORT_UNUSED_PARAMETER(input_idx);
+    packed_ = std::move(prepacked_buffers[0]);
+    used_shared_buffers = true;
+    return Status::OK();
+  }
+
+  BufferUniquePtr packed_;
 };
 
 static void CreateSimpleGraph(Graph& graph) {
@@ -322,6 +339,8 @@ static void PlaceAllNodesToCPUEP(Graph& graph) {
 struct PrepackingTestParam {
   bool test_subgraph;
   bool test_prepacking;
+  bool test_sharing;
+  bool test_free_prepacked_initializers;
 };
 
 class SessionStatePrepackingTest : public testing::TestWithParam<PrepackingTestParam> {};
@@ -343,28 +362,6 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
   DataTransferManager dtm;
   profiling::Profiler profiler;
 
-  std::unordered_map<std::string, int> domain_to_version;
-  domain_to_version[kOnnxDomain] = 11;
-  Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
-              domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
-              DefaultLoggingManager().DefaultLogger());
-
-  // onnxruntime::Model model("graph_main", false, DefaultLoggingManager().DefaultLogger());
-  if (test_param.test_subgraph) {
-    CreateGraphWithSubgraph(model.MainGraph());
-  } else {
-    CreateSimpleGraph(model.MainGraph());
-  }
-
-  SessionState session_state(model.MainGraph(),
-                             execution_providers,
-                             true, /*enable_mem_pattern*/
-                             tp.get(),
-                             nullptr, /*inter_op_thread_pool*/
-                             dtm,
-                             DefaultLoggingManager().DefaultLogger(),
-                             profiler);
-
   KernelRegistryManager kernel_registry_manager;
   Status status = kernel_registry_manager.RegisterKernels(execution_providers);
   ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
@@ -375,25 +372,96 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
                        [](const OpKernelInfo& info) -> OpKernel* { return new PrePackingTestOpKernel(info); })));
   kernel_registry_manager.RegisterKernelRegistry(kernel_registry);
 
-  PlaceAllNodesToCPUEP(model.MainGraph());
-
   SessionOptions sess_options;
   sess_options.session_configurations[kOrtSessionOptionsConfigDisablePrepacking] = test_param.test_prepacking ? "0" : "1";
-  ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
-                                                      kernel_registry_manager,
-                                                      sess_options));
+  sess_options.session_configurations[kOrtSessionOptionsConfigFreePrepackedInitializers] =
+      test_param.test_free_prepacked_initializers ? "1" : "0";
+
+  // when sharing, create two session states for the same model that share the pre-packed weights
+  PrepackedWeightsContainer prepacked_weights_container;
+  const size_t num_sessions = test_param.test_sharing ? 2 : 1;
+  std::vector<std::unique_ptr<Model>> models;
+  std::vector<std::unique_ptr<SessionState>> session_states;
+
+  for (size_t i = 0; i < num_sessions; ++i) {
+    std::unordered_map<std::string, int> domain_to_version;
+    domain_to_version[kOnnxDomain] = 11;
+    models.push_back(onnxruntime::make_unique<Model>("graph_main", false, ModelMetaData(), PathString(),
+                                                     IOnnxRuntimeOpSchemaRegistryList(),
+                                                     domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                                                     DefaultLoggingManager().DefaultLogger()));
+    Model& model = *models.back();
+
+    if (test_param.test_subgraph) {
+      CreateGraphWithSubgraph(model.MainGraph());
+    } else {
+      CreateSimpleGraph(model.MainGraph());
+    }
 
-  const auto& const_initialized_tensors = session_state.GetConstantInitializedTensors();
-  // check prepacking
-  ASSERT_EQ(const_initialized_tensors.size(), size_t(test_param.test_prepacking ? 0 : 1));
+    session_states.push_back(onnxruntime::make_unique<SessionState>(
+        model.MainGraph(),
+        execution_providers,
+        true, /*enable_mem_pattern*/
+        tp.get(),
+        nullptr, /*inter_op_thread_pool*/
+        dtm,
+        DefaultLoggingManager().DefaultLogger(),
+        profiler,
+        false, /*use_deterministic_compute*/
+        test_param.test_sharing ? &prepacked_weights_container : nullptr));
+    SessionState& session_state = *session_states.back();
+
+    PlaceAllNodesToCPUEP(model.MainGraph());
+
+    ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                        kernel_registry_manager,
+                                                        sess_options));
+
+    const auto& const_initialized_tensors = session_state.GetConstantInitializedTensors();
+    // check prepacking
+    ASSERT_EQ(const_initialized_tensors.size(), size_t(test_param.test_prepacking ? 0 : 1));
+
+    if (test_param.test_prepacking && !test_param.test_subgraph) {
+      // the kernel packed a copy of the initializer
+      const auto* kernel = static_cast<const PrePackingTestOpKernel*>(session_state.GetKernel(0));
+      ASSERT_NE(kernel->packed_.get(), nullptr);
+      EXPECT_EQ(*static_cast<const float*>(kernel->packed_.get()), 1.0f);
+    }
+  }
+
+  if (test_param.test_sharing && test_param.test_prepacking) {
+    // one copy of the packed weight is shared by all the kernels using it, which are the node in the main graph,
+    // or the nodes in both branches of the If in each session state
+    EXPECT_EQ(prepacked_weights_container.GetNumberOfElements(), size_t(1));
+    EXPECT_EQ(prepacked_weights_container.GetNumberOfSharedUses(), size_t(test_param.test_subgraph ? 3 : 1));
+
+    if (!test_param.test_subgraph) {
+      const auto* kernel_0 = static_cast<const PrePackingTestOpKernel*>(session_states[0]->GetKernel(0));
+      const auto* kernel_1 = static_cast<const PrePackingTestOpKernel*>(session_states[1]->GetKernel(0));
+      ASSERT_NE(kernel_0->packed_.get(), nullptr);
+      EXPECT_EQ(kernel_0->packed_.get(), kernel_1->packed_.get());
+      EXPECT_EQ(session_states[0]->GetNumberOfSharedPrePackedWeights(), size_t(1));
+    }
+
+    // the weights are released with the last session state using them
+    session_states.clear();
+    EXPECT_EQ(prepacked_weights_container.GetNumberOfElements(), size_t(0));
+  } else {
+    EXPECT_EQ(prepacked_weights_container.GetNumberOfElements(), size_t(0));
+  }
 }
 
 INSTANTIATE_TEST_SUITE_P(SessionStateTests,
                          SessionStatePrepackingTest,
-                         testing::Values(PrepackingTestParam{false, false},
-                                         PrepackingTestParam{false, true},
-                                         PrepackingTestParam{true, false},
-                                         PrepackingTestParam{true, true}));
+                         testing::Values(PrepackingTestParam{false, false, false, false},
+                                         PrepackingTestParam{false, true, false, false},
+                                         PrepackingTestParam{true, false, false, false},
+                                         PrepackingTestParam{true, true, false, false},
+                                         PrepackingTestParam{false, true, true, false},
+                                         PrepackingTestParam{true, true, true, false},
+                                         PrepackingTestParam{false, false, false, true},
+                                         PrepackingTestParam{false, true, false, true},
+                                         PrepackingTestParam{true, true, false, true}));
 
 }  // namespace test
 }  // namespace onnxruntime
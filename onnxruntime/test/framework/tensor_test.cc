@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/framework/tensor.h"
+#include "core/framework/TensorSeq.h"
 #include "core/framework/allocatormgr.h"
 #include "test_utils.h"
 
@@ -210,5 +211,37 @@ TEST(TensorTest, SizeOverflow) {
   Tensor t(type, shape1, nullptr, alloc->Info());
   EXPECT_THROW(t.SizeInBytes(), OnnxRuntimeException);
 }
+
+TEST(TensorSeqTest, SequencesShareTensors) {
+  auto type = DataTypeImpl::GetType<float>();
+  auto alloc = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+
+  TensorSeq seq(type);
+  seq.Add(Tensor(type, TensorShape({2, 3}), alloc));
+  seq.Add(Tensor(type, TensorShape({4}), alloc));
+  const float* first_data = seq.Get(0).Data<float>();
+
+  TensorSeq shared(type);
+  for (size_t i = 0; i < seq.Size(); ++i) {
+    shared.Add(seq.GetAt(i));
+  }
+
+  ASSERT_EQ(shared.Size(), 2u);
+  EXPECT_EQ(shared.Get(0).Data<float>(), first_data);
+  EXPECT_EQ(&shared.Get(1), &seq.Get(1));
+
+  size_t num_tensors = 0;
+  for (const Tensor& tensor : shared) {
+    EXPECT_EQ(&tensor, &seq.Get(num_tensors++));
+  }
+  EXPECT_EQ(num_tensors, 2u);
+
+  EXPECT_THROW(shared.Add(seq.GetAt(2)), OnnxRuntimeException);
+  OrtValue int_tensor;
+  auto int_type = DataTypeImpl::GetType<int32_t>();
+  int_tensor.Init(new Tensor(int_type, TensorShape({1}), alloc), DataTypeImpl::GetType<Tensor>(),
+                  DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+  EXPECT_THROW(shared.Add(int_tensor), OnnxRuntimeException);
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/tuning_database.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+using tuning::TuningDatabase;
+
+TEST(TuningDatabaseTest, SaveAndLoad) {
+  const std::string file_path = "tuning_database_test_save_and_load.txt";
+
+  TuningDatabase database;
+  database.Record("mlas_conv:1,1,64,64:56,56:3,3:1,1:1,1,1,1:1,1:8", {1});
+  database.Record("cudnn_conv_fwd:Tesla_V100:7605:2,1,4,1,64,56,56", {6, 1024, 1});
+  ASSERT_TRUE(database.Save(file_path).IsOK());
+
+  TuningDatabase loaded;
+  loaded.Record("other", {5});
+  ASSERT_TRUE(loaded.Load(file_path).IsOK());
+  EXPECT_EQ(loaded.Size(), 3u);
+
+  std::vector<int64_t> values;
+  ASSERT_TRUE(loaded.Lookup("cudnn_conv_fwd:Tesla_V100:7605:2,1,4,1,64,56,56", values));
+  EXPECT_EQ(values, (std::vector<int64_t>{6, 1024, 1}));
+  ASSERT_TRUE(loaded.Lookup("mlas_conv:1,1,64,64:56,56:3,3:1,1:1,1,1,1:1,1:8", values));
+  EXPECT_EQ(values, std::vector<int64_t>{1});
+  EXPECT_FALSE(loaded.Lookup("missing", values));
+
+  std::remove(file_path.c_str());
+}
+
+TEST(TuningDatabaseTest, LoadMissingFile) {
+  TuningDatabase database;
+  EXPECT_TRUE(database.Load("tuning_database_test_missing_file.txt").IsOK());
+  EXPECT_EQ(database.Size(), 0u);
+}
+
+TEST(TuningDatabaseTest, LoadInvalidFile) {
+  const std::string file_path = "tuning_database_test_invalid_file.txt";
+  {
+    std::ofstream stream(file_path);
+    stream << "# comment\nkey 1 2\nkey_without_values\n";
+  }
+
+  TuningDatabase database;
+  auto status = database.Load(file_path);
+  EXPECT_FALSE(status.IsOK());
+  EXPECT_NE(status.ErrorMessage().find("line 3"), std::string::npos) << status.ErrorMessage();
+  // nothing is loaded from an invalid file
+  EXPECT_EQ(database.Size(), 0u);
+
+  std::remove(file_path.c_str());
+}
+
+TEST(TuningDatabaseTest, InvalidKey) {
+  TuningDatabase database;
+  EXPECT_THROW(database.Record("key with spaces", {1}), OnnxRuntimeException);
+  EXPECT_THROW(database.Record("key", {}), OnnxRuntimeException);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
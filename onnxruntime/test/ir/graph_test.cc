@@ -1649,6 +1649,86 @@ TEST_F(GraphTest, ReplaceInitializedTensor) {
   }
 }
 
+TEST_F(GraphTest, NodesOfOpTypeAreIndexed) {
+  Model model("graph", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  auto& x = graph.GetOrCreateNodeArg("x", &tensor_float);
+  auto& a = graph.GetOrCreateNodeArg("a", nullptr);
+  auto& b = graph.GetOrCreateNodeArg("b", nullptr);
+  auto& c = graph.GetOrCreateNodeArg("c", nullptr);
+  auto& relu_1 = graph.AddNode("relu_1", "Relu", "relu 1", {&x}, {&a});
+  graph.AddNode("neg", "Neg", "neg", {&a}, {&b});
+  auto& relu_2 = graph.AddNode("relu_2", "Relu", "relu 2", {&b}, {&c});
+
+  EXPECT_EQ(graph.NumberOfNodesOfOpType("Relu"), 2u);
+  EXPECT_EQ(graph.NumberOfNodesOfOpType("Neg"), 1u);
+  EXPECT_EQ(graph.NumberOfNodesOfOpType("Conv"), 0u);
+  EXPECT_EQ(graph.GetNodeIndexesOfOpType("Relu"), (std::vector<NodeIndex>{relu_1.Index(), relu_2.Index()}));
+  EXPECT_TRUE(graph.GetNodeIndexesOfOpType("Conv").empty());
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  ASSERT_TRUE(graph.RemoveNode(relu_2.Index()));
+  EXPECT_EQ(graph.NumberOfNodesOfOpType("Relu"), 1u);
+  EXPECT_EQ(graph.GetNodeIndexesOfOpType("Relu"), std::vector<NodeIndex>{relu_1.Index()});
+}
+
+TEST_F(GraphTest, ResolveInfersChangedNodes) {
+  Model model("graph", false, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  tensor_float.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  auto& x = graph.GetOrCreateNodeArg("x", &tensor_float);
+  auto& a = graph.GetOrCreateNodeArg("a", nullptr);
+  auto& b = graph.GetOrCreateNodeArg("b", nullptr);
+  graph.AddNode("relu", "Relu", "relu", {&x}, {&a});
+  auto& neg = graph.AddNode("neg", "Neg", "neg", {&a}, {&b});
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+  ASSERT_NE(b.Shape(), nullptr);
+
+  // insert a Transpose between the Relu and Neg. only the new node and its consumer need inferencing, and the
+  // changed output shape of the Neg must be inferred from the new input.
+  auto& transposed = graph.GetOrCreateNodeArg("transposed", nullptr);
+  auto& b2 = graph.GetOrCreateNodeArg("b2", nullptr);
+  graph.AddNode("transpose", "Transpose", "transpose", {&a}, {&transposed});
+  neg.MutableInputDefs()[0] = &transposed;
+  neg.MutableOutputDefs()[0] = &b2;
+
+  status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  ASSERT_NE(transposed.Shape(), nullptr);
+  ASSERT_EQ(transposed.Shape()->dim_size(), 2);
+  EXPECT_EQ(transposed.Shape()->dim(0).dim_value(), 3);
+  EXPECT_EQ(transposed.Shape()->dim(1).dim_value(), 2);
+  ASSERT_NE(b2.Shape(), nullptr);
+  ASSERT_EQ(b2.Shape()->dim_size(), 2);
+  EXPECT_EQ(b2.Shape()->dim(0).dim_value(), 3);
+  EXPECT_EQ(b2.Shape()->dim(1).dim_value(), 2);
+
+  // a consumer of an unchanged value is inferred too
+  auto& c = graph.GetOrCreateNodeArg("c", nullptr);
+  graph.AddNode("abs", "Abs", "abs", {&a}, {&c});
+
+  status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+  ASSERT_NE(c.Type(), nullptr);
+  ASSERT_NE(c.Shape(), nullptr);
+  EXPECT_EQ(c.Shape()->dim(0).dim_value(), 2);
+}
+
 TEST_F(GraphTest, AddRemoveInitializerHandling) {
   Model m{"test_model", false, *logger_};
   Graph& graph = m.MainGraph();
@@ -20,6 +20,7 @@ Abstract:
 #include <limits>
 #include <memory>
 #include <random>
+#include <vector>
 #include <mlas.h>
 
 #if defined(_WIN32)
@@ -536,6 +537,839 @@ public:
     }
 };
 
+//
+// Define the conversions used to build the inputs and to check the outputs of
+// the half precision GEMM tests. The test values are normal numbers.
+//
+
+class MlasSgemmBatchTest : public MlasTestBase
+{
+private:
+    void
+    Test(
+        CBLAS_TRANSPOSE TransA,
+        CBLAS_TRANSPOSE TransB,
+        size_t M,
+        size_t N,
+        size_t K,
+        size_t BatchSize,
+        bool Packed
+        )
+    {
+        const size_t lda = (TransA == CblasNoTrans) ? K : M;
+        const size_t ldb = (TransB == CblasNoTrans) ? N : K;
+
+        const float* A = BufferA.GetBuffer(M * K * BatchSize);
+        const float* B = BufferB.GetBuffer(K * N * BatchSize);
+        float* C = BufferC.GetBuffer(M * N * BatchSize);
+        float* CReference = BufferCReference.GetBuffer(M * N * BatchSize);
+
+        size_t PackedBSize = 0;
+        uint8_t* PackedB = nullptr;
+
+        if (Packed) {
+            PackedBSize = MlasGemmPackBSize(N, K);
+            PackedB = BufferBPacked.GetBuffer(PackedBSize * BatchSize);
+        }
+
+        std::vector<MLAS_SGEMM_DATA_PARAMS> Data(BatchSize);
+
+        for (size_t b = 0; b < BatchSize; b++) {
+
+            const float* a = A + M * K * b;
+            const float* bb = B + K * N * b;
+            const float alpha = 1.0f + float(b % 3) * 0.5f;
+            const float beta = (b % 2) ? 1.0f : 0.0f;
+
+            Data[b].A = a;
+            Data[b].lda = lda;
+            Data[b].C = C + M * N * b;
+            Data[b].ldc = N;
+            Data[b].alpha = alpha;
+            Data[b].beta = beta;
+
+            if (Packed) {
+                uint8_t* pb = PackedB + PackedBSize * b;
+                MlasGemmPackB(TransB, N, K, bb, ldb, pb);
+                Data[b].B = pb;
+                Data[b].BIsPacked = true;
+            } else {
+                Data[b].B = bb;
+                Data[b].ldb = ldb;
+            }
+
+            for (size_t f = M * N * b; f < M * N * (b + 1); f++) {
+                C[f] = CReference[f] = float(int(f % 11) - 5);
+            }
+
+            //
+            // Compute the reference result using a separate call per matrix.
+            //
+
+            MlasGemm(TransA, TransB, M, N, K, alpha, a, lda, bb, ldb, beta,
+                     CReference + M * N * b, N, threadpool);
+        }
+
+        MlasGemmBatch(TransA, TransB, M, N, K, Data.data(), BatchSize, threadpool);
+
+        for (size_t f = 0; f < M * N * BatchSize; f++) {
+            if (C[f] != CReference[f]) {
+                printf("mismatch TransA=%d, TransB=%d, M=%zd, N=%zd, K=%zd, BatchSize=%zd, Packed=%d!\n",
+                       int(TransA), int(TransB), M, N, K, BatchSize, int(Packed));
+                break;
+            }
+        }
+    }
+
+    MatrixGuardBuffer<float> BufferA;
+    MatrixGuardBuffer<float> BufferB;
+    MatrixGuardBuffer<float> BufferC;
+    MatrixGuardBuffer<float> BufferCReference;
+    MatrixGuardBuffer<uint8_t> BufferBPacked;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (int p = 0; p < 2; p++) {
+            for (size_t BatchSize = 1; BatchSize <= 48; BatchSize += 7) {
+                Test(CblasNoTrans, CblasNoTrans, 1, 17, 33, BatchSize, p != 0);
+                Test(CblasNoTrans, CblasTrans, 16, 27, 9, BatchSize, p != 0);
+                Test(CblasTrans, CblasNoTrans, 31, 64, 13, BatchSize, p != 0);
+                Test(CblasNoTrans, CblasNoTrans, 128, 64, 64, BatchSize, p != 0);
+            }
+            Test(CblasNoTrans, CblasNoTrans, 384, 384, 64, 12, p != 0);
+        }
+    }
+};
+
+template<typename T>
+struct MlasHalfGemmTestType;
+
+template<>
+struct MlasHalfGemmTestType<MLAS_FP16>
+{
+    static constexpr float Epsilon = 1.0f / 1024.0f;
+
+    static
+    MLAS_FP16
+    FromFloat(
+        float Value
+        )
+    {
+        uint32_t Bits;
+        memcpy(&Bits, &Value, sizeof(Bits));
+        if ((Bits & 0x7FFFFFFF) == 0) {
+            return MLAS_FP16{uint16_t(Bits >> 16)};
+        }
+        return MLAS_FP16{uint16_t(((Bits >> 16) & 0x8000) | ((((Bits >> 23) & 0xFF) - 112) << 10) | ((Bits >> 13) & 0x3FF))};
+    }
+
+    static
+    float
+    ToFloat(
+        MLAS_FP16 Value
+        )
+    {
+        uint32_t Bits = uint32_t(Value.val & 0x8000) << 16;
+        if ((Value.val & 0x7FFF) != 0) {
+            Bits |= ((((Value.val >> 10) & 0x1F) + 112) << 23) | (uint32_t(Value.val & 0x3FF) << 13);
+        }
+        float f;
+        memcpy(&f, &Bits, sizeof(f));
+        return f;
+    }
+};
+
+template<>
+struct MlasHalfGemmTestType<MLAS_BF16>
+{
+    static constexpr float Epsilon = 1.0f / 128.0f;
+
+    static
+    MLAS_BF16
+    FromFloat(
+        float Value
+        )
+    {
+        uint32_t Bits;
+        memcpy(&Bits, &Value, sizeof(Bits));
+        return MLAS_BF16{uint16_t(Bits >> 16)};
+    }
+
+    static
+    float
+    ToFloat(
+        MLAS_BF16 Value
+        )
+    {
+        uint32_t Bits = uint32_t(Value.val) << 16;
+        float f;
+        memcpy(&f, &Bits, sizeof(f));
+        return f;
+    }
+};
+
+template<typename T, bool Packed>
+class MlasHalfGemmTest : public MlasTestBase
+{
+private:
+    void
+    Test(
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha
+        )
+    {
+        //
+        // Skip the test if the B buffer cannot be packed.
+        //
+
+        if (Packed && (N == 0 || K == 0)) {
+            return;
+        }
+
+        T* A = reinterpret_cast<T*>(BufferA.GetBuffer(K * M));
+        T* B = reinterpret_cast<T*>(BufferB.GetBuffer(N * K));
+        T* C = reinterpret_cast<T*>(BufferC.GetBuffer(N * M));
+        float* CReference = BufferCReference.GetBuffer(N * M);
+
+        //
+        // Use multiples of 0.25 so that the products and sums are exact in
+        // single precision.
+        //
+
+        for (size_t i = 0; i < K * M; i++) {
+            A[i] = MlasHalfGemmTestType<T>::FromFloat(float(int(i % 7) - 3) * 0.25f);
+        }
+        for (size_t i = 0; i < N * K; i++) {
+            B[i] = MlasHalfGemmTestType<T>::FromFloat(float(int(i % 5) - 2) * 0.25f);
+        }
+
+        Test(CblasNoTrans, CblasNoTrans, M, N, K, alpha, A, K, B, N, C, CReference, N);
+        Test(CblasNoTrans, CblasTrans, M, N, K, alpha, A, K, B, K, C, CReference, N);
+        Test(CblasTrans, CblasNoTrans, M, N, K, alpha, A, M, B, N, C, CReference, N);
+        Test(CblasTrans, CblasTrans, M, N, K, alpha, A, M, B, K, C, CReference, N);
+    }
+
+    void
+    Test(
+        CBLAS_TRANSPOSE TransA,
+        CBLAS_TRANSPOSE TransB,
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        const T* A,
+        size_t lda,
+        const T* B,
+        size_t ldb,
+        T* C,
+        float* CReference,
+        size_t ldc
+        )
+    {
+        std::fill_n(C, M * N, MlasHalfGemmTestType<T>::FromFloat(-0.5f));
+
+        if (Packed) {
+            size_t PackedBSize = MlasGemmPackBSize(N, K);
+            void* PackedB = BufferBPacked.GetBuffer(PackedBSize, true);
+            MlasGemmPackB(TransB, N, K, B, ldb, PackedB);
+            MlasGemm(TransA, M, N, K, alpha, A, lda, PackedB, C, ldc, threadpool);
+        } else {
+            MlasGemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, C, ldc, threadpool);
+        }
+
+        for (size_t m = 0; m < M; m++) {
+            for (size_t n = 0; n < N; n++) {
+                float sum = 0.0f;
+                for (size_t k = 0; k < K; k++) {
+                    const T a = (TransA == CblasNoTrans) ? A[m * lda + k] : A[k * lda + m];
+                    const T b = (TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k];
+                    sum += MlasHalfGemmTestType<T>::ToFloat(a) * MlasHalfGemmTestType<T>::ToFloat(b);
+                }
+                CReference[m * ldc + n] = sum * alpha;
+            }
+        }
+
+        for (size_t f = 0; f < M * N; f++) {
+            const float Value = MlasHalfGemmTestType<T>::ToFloat(C[f]);
+            if (std::fabs(Value - CReference[f]) > std::fabs(CReference[f]) * MlasHalfGemmTestType<T>::Epsilon) {
+                printf("mismatch TransA=%d, TransB=%d, M=%zd, N=%zd, K=%zd, alpha=%f  %f %f!\n", TransA, TransB, M, N, K, alpha, Value, CReference[f]);
+                break;
+            }
+        }
+    }
+
+    MatrixGuardBuffer<uint16_t> BufferA;
+    MatrixGuardBuffer<uint16_t> BufferB;
+    MatrixGuardBuffer<uint16_t> BufferC;
+    MatrixGuardBuffer<float> BufferCReference;
+    MatrixGuardBuffer<uint8_t> BufferBPacked;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t b = 0; b < 16; b++) {
+            Test(b, b, b, 1.0f);
+        }
+        for (size_t b = 16; b <= 256; b <<= 1) {
+            Test(b, b, b, 1.0f);
+        }
+
+        Test(1, 768, 1024, 1.0f);
+        Test(37, 300, 513, 0.5f);
+        Test(128, 257, 255, -1.0f);
+    }
+};
+
+template<typename T>
+class MlasHalfPackedBGemmTest : public MlasTestBase
+{
+private:
+    void
+    Test(
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        float beta
+        )
+    {
+        float* A = BufferA.GetBuffer(K * M);
+        float* B = BufferB.GetBuffer(N * K);
+        float* C = BufferC.GetBuffer(N * M);
+        float* CReference = BufferCReference.GetBuffer(N * M);
+
+        //
+        // Use multiples of 0.25 so that matrix B is exact in the half
+        // precision types and the products and sums are exact.
+        //
+
+        for (size_t i = 0; i < K * M; i++) {
+            A[i] = float(int(i % 7) - 3) * 0.25f;
+        }
+        for (size_t i = 0; i < N * K; i++) {
+            B[i] = float(int(i % 5) - 2) * 0.25f;
+        }
+
+        Test(CblasNoTrans, CblasNoTrans, M, N, K, alpha, A, K, B, N, beta, C, CReference);
+        Test(CblasNoTrans, CblasTrans, M, N, K, alpha, A, K, B, K, beta, C, CReference);
+        Test(CblasTrans, CblasNoTrans, M, N, K, alpha, A, M, B, N, beta, C, CReference);
+        Test(CblasTrans, CblasTrans, M, N, K, alpha, A, M, B, K, beta, C, CReference);
+    }
+
+    void
+    Test(
+        CBLAS_TRANSPOSE TransA,
+        CBLAS_TRANSPOSE TransB,
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        const float* A,
+        size_t lda,
+        const float* B,
+        size_t ldb,
+        float beta,
+        float* C,
+        float* CReference
+        )
+    {
+        for (size_t f = 0; f < M * N; f++) {
+            C[f] = float(int(f % 3) - 1) * 0.5f;
+            CReference[f] = C[f];
+        }
+
+        size_t PackedBSize = MlasGemmPackBHalfSize(N, K);
+        T* PackedB = reinterpret_cast<T*>(BufferBPacked.GetBuffer(PackedBSize, true));
+        MlasGemmPackBHalf(TransB, N, K, B, ldb, PackedB);
+        MlasGemmHalfPackedB(TransA, M, N, K, alpha, A, lda, PackedB, beta, C, N, threadpool);
+
+        for (size_t m = 0; m < M; m++) {
+            for (size_t n = 0; n < N; n++) {
+                float sum = 0.0f;
+                for (size_t k = 0; k < K; k++) {
+                    const float a = (TransA == CblasNoTrans) ? A[m * lda + k] : A[k * lda + m];
+                    const float b = (TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k];
+                    sum += a * b;
+                }
+                CReference[m * N + n] = sum * alpha + CReference[m * N + n] * beta;
+            }
+        }
+
+        for (size_t f = 0; f < M * N; f++) {
+            if (C[f] != CReference[f]) {
+                printf("mismatch TransA=%d, TransB=%d, M=%zd, N=%zd, K=%zd, alpha=%f, beta=%f  %f %f!\n", TransA, TransB, M, N, K, alpha, beta, C[f], CReference[f]);
+                break;
+            }
+        }
+    }
+
+    MatrixGuardBuffer<float> BufferA;
+    MatrixGuardBuffer<float> BufferB;
+    MatrixGuardBuffer<float> BufferC;
+    MatrixGuardBuffer<float> BufferCReference;
+    MatrixGuardBuffer<uint8_t> BufferBPacked;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t b = 1; b < 16; b++) {
+            Test(b, b, b, 1.0f, 0.0f);
+        }
+        for (size_t b = 16; b <= 256; b <<= 1) {
+            Test(b, b, b, 1.0f, 0.0f);
+        }
+
+        Test(1, 768, 1024, 1.0f, 0.0f);
+        Test(37, 300, 513, 0.5f, 1.0f);
+        Test(128, 257, 255, -1.0f, -0.5f);
+    }
+};
+
+class MlasSparseGemmTest : public MlasTestBase
+{
+private:
+    void
+    Test(
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        unsigned Density
+        )
+    {
+        float* A = BufferA.GetBuffer(K * M);
+        float* B = BufferB.GetBuffer(N * K);
+        float* C = BufferC.GetBuffer(N * M);
+        float* CReference = BufferCReference.GetBuffer(N * M);
+
+        //
+        // Use multiples of 0.25 so that the products and sums are exact. Zero
+        // out runs of elements of matrix B so that some blocks are dropped by
+        // the packing and others are only partially filled.
+        //
+
+        for (size_t i = 0; i < K * M; i++) {
+            A[i] = float(int(i % 7) - 3) * 0.25f;
+        }
+        for (size_t i = 0; i < N * K; i++) {
+            B[i] = ((i / 5) % 100 < Density) ? float(int(i % 5) - 2) * 0.25f : 0.0f;
+        }
+
+        Test(CblasNoTrans, M, N, K, alpha, A, B, N, C, CReference);
+        Test(CblasTrans, M, N, K, alpha, A, B, K, C, CReference);
+    }
+
+    void
+    Test(
+        CBLAS_TRANSPOSE TransB,
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        const float* A,
+        const float* B,
+        size_t ldb,
+        float* C,
+        float* CReference
+        )
+    {
+        size_t PackedBSize = MlasGemmPackSparseBSize(TransB, N, K, B, ldb);
+
+        if (PackedBSize == 0) {
+            return;
+        }
+
+        void* PackedB = BufferBPacked.GetBuffer(PackedBSize, true);
+        MlasGemmPackSparseB(TransB, N, K, B, ldb, PackedB);
+
+        std::fill_n(C, M * N, -0.5f);
+
+        MlasGemmSparse(M, alpha, A, K, PackedB, C, N, threadpool);
+
+        for (size_t m = 0; m < M; m++) {
+            for (size_t n = 0; n < N; n++) {
+                float sum = 0.0f;
+                for (size_t k = 0; k < K; k++) {
+                    const float b = (TransB == CblasNoTrans) ? B[k * ldb + n] : B[n * ldb + k];
+                    sum += A[m * K + k] * b;
+                }
+                CReference[m * N + n] = sum * alpha;
+            }
+        }
+
+        for (size_t f = 0; f < M * N; f++) {
+            if (C[f] != CReference[f]) {
+                printf("mismatch TransB=%d, M=%zd, N=%zd, K=%zd, alpha=%f  %f %f!\n", TransB, M, N, K, alpha, C[f], CReference[f]);
+                break;
+            }
+        }
+    }
+
+    MatrixGuardBuffer<float> BufferA;
+    MatrixGuardBuffer<float> BufferB;
+    MatrixGuardBuffer<float> BufferC;
+    MatrixGuardBuffer<float> BufferCReference;
+    MatrixGuardBuffer<uint8_t> BufferBPacked;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t b = 1; b < 20; b++) {
+            Test(b, b, b, 1.0f, 30);
+        }
+        for (unsigned Density : {0, 10, 30, 100}) {
+            Test(1, 768, 1024, 1.0f, Density);
+            Test(37, 300, 513, 0.5f, Density);
+            Test(128, 257, 255, -1.0f, Density);
+        }
+    }
+};
+
+template<typename ElementType>
+class MlasTransposeTest : public MlasTestBase
+{
+private:
+    void
+    Test(
+        size_t M,
+        size_t N
+        )
+    {
+        ElementType* Input = BufferInput.GetBuffer(M * N);
+        ElementType* Output = BufferOutput.GetBuffer(M * N);
+
+        for (size_t i = 0; i < M * N; i++) {
+            Input[i] = ElementType(i * 2654435761u);
+        }
+
+        std::fill_n(Output, M * N, ElementType(0));
+
+        MlasTranspose(Input, Output, M, N, threadpool);
+
+        for (size_t m = 0; m < M; m++) {
+            for (size_t n = 0; n < N; n++) {
+                if (Output[n * M + m] != Input[m * N + n]) {
+                    printf("mismatch transpose %zd-byte M=%zd, N=%zd, m=%zd, n=%zd!\n",
+                        sizeof(ElementType), M, N, m, n);
+                    return;
+                }
+            }
+        }
+    }
+
+    MatrixGuardBuffer<ElementType> BufferInput;
+    MatrixGuardBuffer<ElementType> BufferOutput;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t m = 1; m <= 32; m++) {
+            for (size_t n = 1; n <= 32; n++) {
+                Test(m, n);
+            }
+        }
+
+        Test(3, 90000);
+        Test(90000, 3);
+        Test(1000, 777);
+        Test(129, 4097);
+    }
+};
+
+class MlasHalfConvertTest : public MlasTestBase
+{
+private:
+    static
+    float
+    FloatFromBits(
+        uint32_t Bits
+        )
+    {
+        float f;
+        memcpy(&f, &Bits, sizeof(f));
+        return f;
+    }
+
+    void
+    TestRoundTrip(
+        void
+        )
+    {
+        //
+        // Every half precision value converts to single precision and back
+        // to itself, except that NaNs only need to stay NaNs.
+        //
+
+        const size_t Count = 65536;
+        unsigned short* Half = BufferHalf.GetBuffer(Count);
+        unsigned short* HalfOutput = BufferHalfOutput.GetBuffer(Count);
+        float* Float = BufferFloat.GetBuffer(Count);
+
+        for (size_t i = 0; i < Count; i++) {
+            Half[i] = static_cast<unsigned short>(i);
+        }
+
+        MlasConvertHalfToFloatBuffer(Half, Float, Count);
+        MlasConvertFloatToHalfBuffer(Float, HalfOutput, Count);
+
+        for (size_t i = 0; i < Count; i++) {
+            const bool IsNaN = (Half[i] & 0x7C00) == 0x7C00 && (Half[i] & 0x03FF) != 0;
+            if (IsNaN ? !std::isnan(Float[i]) || (HalfOutput[i] & 0x7FFF) <= 0x7C00 : HalfOutput[i] != Half[i]) {
+                printf("mismatch half round trip: %04zx -> %04x!\n", i, HalfOutput[i]);
+                return;
+            }
+        }
+    }
+
+    void
+    TestRounding(
+        size_t Count
+        )
+    {
+        //
+        // The values halfway between consecutive finite positive half
+        // precision values round to the value with an even mantissa.
+        //
+
+        unsigned short* Half = BufferHalf.GetBuffer(Count);
+        float* Float = BufferFloat.GetBuffer(Count);
+
+        for (size_t i = 0; i < Count; i++) {
+            const uint32_t Lower = uint32_t((i * 2654435761u) % 0x7BFF);
+            float LowerFloat;
+            float UpperFloat;
+            unsigned short LowerHalf = static_cast<unsigned short>(Lower);
+            unsigned short UpperHalf = static_cast<unsigned short>(Lower + 1);
+            MlasConvertHalfToFloatBuffer(&LowerHalf, &LowerFloat, 1);
+            MlasConvertHalfToFloatBuffer(&UpperHalf, &UpperFloat, 1);
+            Float[i] = (LowerFloat + UpperFloat) * 0.5f;
+            if (i & 1) {
+                Float[i] = -Float[i];
+            }
+        }
+
+        std::fill_n(Half, Count, static_cast<unsigned short>(0));
+
+        MlasConvertFloatToHalfBuffer(Float, Half, Count);
+
+        for (size_t i = 0; i < Count; i++) {
+            const uint32_t Lower = uint32_t((i * 2654435761u) % 0x7BFF);
+            uint32_t Expected = (Lower & 1) ? Lower + 1 : Lower;
+            if (i & 1) {
+                Expected |= 0x8000;
+            }
+            if (Half[i] != Expected) {
+                printf("mismatch half rounding Count=%zd, i=%zd: %f -> %04x, expected %04x!\n",
+                    Count, i, Float[i], Half[i], Expected);
+                return;
+            }
+        }
+
+        if (Count < 2) {
+            return;
+        }
+
+        //
+        // Values beyond the half precision range convert to infinity.
+        //
+
+        Float[0] = FloatFromBits(0x477FF000);
+        Float[Count - 1] = -std::numeric_limits<float>::infinity();
+
+        MlasConvertFloatToHalfBuffer(Float, Half, Count);
+
+        if (Half[0] != 0x7C00 || Half[Count - 1] != 0xFC00) {
+            printf("mismatch half overflow Count=%zd!\n", Count);
+        }
+    }
+
+    MatrixGuardBuffer<unsigned short> BufferHalf;
+    MatrixGuardBuffer<unsigned short> BufferHalfOutput;
+    MatrixGuardBuffer<float> BufferFloat;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        TestRoundTrip();
+
+        for (size_t n = 1; n <= 40; n++) {
+            TestRounding(n);
+        }
+
+        TestRounding(4097);
+    }
+};
+
+class MlasBlockQuantGemmTest : public MlasTestBase
+{
+private:
+    void
+    Test(
+        size_t M,
+        size_t N,
+        size_t K,
+        size_t BlkBits,
+        size_t BlkLen,
+        bool Symmetric,
+        bool WithBias
+        )
+    {
+        const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+        const size_t BlobSize = BlkLen * BlkBits / 8;
+        const uint32_t QuantMaximum = (1u << BlkBits) - 1;
+
+        float* A = BufferA.GetBuffer(K * M);
+        uint8_t* QuantB = BufferQuantB.GetBuffer(MlasBlockQuantBSize(N, K, BlkBits, BlkLen));
+        float* QuantBScale = BufferQuantBScale.GetBuffer(N * BlockCountK);
+        uint8_t* QuantBZeroPoint = Symmetric ? nullptr : BufferQuantBZeroPoint.GetBuffer(N * BlockCountK);
+        float* Bias = WithBias ? BufferBias.GetBuffer(N) : nullptr;
+        float* C = BufferC.GetBuffer(N * M);
+        float* CReference = BufferCReference.GetBuffer(N * M);
+
+        //
+        // Use multiples of 0.25 and power of two scales so that the products
+        // and sums are exact.
+        //
+
+        for (size_t i = 0; i < K * M; i++) {
+            A[i] = float(int(i % 7) - 3) * 0.25f;
+        }
+        for (size_t i = 0; i < N * BlockCountK * BlobSize; i++) {
+            QuantB[i] = uint8_t(i * 37 + 11);
+        }
+        for (size_t i = 0; i < N * BlockCountK; i++) {
+            QuantBScale[i] = 1.0f / float(1 << (i % 4));
+            if (QuantBZeroPoint != nullptr) {
+                QuantBZeroPoint[i] = uint8_t((i * 5) & QuantMaximum);
+            }
+        }
+        if (Bias != nullptr) {
+            for (size_t n = 0; n < N; n++) {
+                Bias[n] = float(int(n % 9) - 4) * 0.5f;
+            }
+        }
+
+        std::fill_n(C, M * N, -0.5f);
+
+        MlasBlockQuantGemm(M, N, K, BlkBits, BlkLen, A, K, QuantB, QuantBScale, QuantBZeroPoint, Bias, C, N, threadpool);
+
+        for (size_t m = 0; m < M; m++) {
+            for (size_t n = 0; n < N; n++) {
+                float sum = (Bias != nullptr) ? Bias[n] : 0.0f;
+                for (size_t k = 0; k < K; k++) {
+                    const size_t Block = n * BlockCountK + k / BlkLen;
+                    const uint8_t* Blob = QuantB + Block * BlobSize;
+                    const size_t kk = k % BlkLen;
+                    const uint32_t Value = (BlkBits == 4) ? (Blob[kk / 2] >> ((kk & 1) * 4)) & 0x0F : Blob[kk];
+                    const uint32_t ZeroPoint = (QuantBZeroPoint != nullptr) ? QuantBZeroPoint[Block] : (1u << (BlkBits - 1));
+                    sum += A[m * K + k] * ((float(Value) - float(ZeroPoint)) * QuantBScale[Block]);
+                }
+                CReference[m * N + n] = sum;
+            }
+        }
+
+        for (size_t f = 0; f < M * N; f++) {
+            if (C[f] != CReference[f]) {
+                printf("mismatch M=%zd, N=%zd, K=%zd, BlkBits=%zd, BlkLen=%zd, Symmetric=%d  %f %f!\n",
+                    M, N, K, BlkBits, BlkLen, int(Symmetric), C[f], CReference[f]);
+                break;
+            }
+        }
+    }
+
+    void
+    TestQuantize(
+        size_t N,
+        size_t K,
+        size_t BlkBits,
+        size_t BlkLen,
+        bool Symmetric
+        )
+    {
+        const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+        const size_t BlobSize = BlkLen * BlkBits / 8;
+
+        float* B = BufferB.GetBuffer(K * N);
+        uint8_t* QuantB = BufferQuantB.GetBuffer(MlasBlockQuantBSize(N, K, BlkBits, BlkLen));
+        float* QuantBScale = BufferQuantBScale.GetBuffer(N * BlockCountK);
+        uint8_t* QuantBZeroPoint = Symmetric ? nullptr : BufferQuantBZeroPoint.GetBuffer(N * BlockCountK);
+
+        for (size_t i = 0; i < K * N; i++) {
+            B[i] = float(int((i * 13) % 101) - 40) * 0.03125f;
+        }
+
+        MlasBlockQuantizeB(N, K, BlkBits, BlkLen, B, N, QuantB, QuantBScale, QuantBZeroPoint);
+
+        for (size_t n = 0; n < N; n++) {
+            for (size_t k = 0; k < K; k++) {
+                const size_t Block = n * BlockCountK + k / BlkLen;
+                const uint8_t* Blob = QuantB + Block * BlobSize;
+                const size_t kk = k % BlkLen;
+                const uint32_t Value = (BlkBits == 4) ? (Blob[kk / 2] >> ((kk & 1) * 4)) & 0x0F : Blob[kk];
+                const uint32_t ZeroPoint = (QuantBZeroPoint != nullptr) ? QuantBZeroPoint[Block] : (1u << (BlkBits - 1));
+                const float Dequantized = (float(Value) - float(ZeroPoint)) * QuantBScale[Block];
+                if (std::fabs(Dequantized - B[k * N + n]) > QuantBScale[Block] * 0.501f) {
+                    printf("mismatch quantize N=%zd, K=%zd, BlkBits=%zd, BlkLen=%zd, Symmetric=%d  %f %f!\n",
+                        N, K, BlkBits, BlkLen, int(Symmetric), Dequantized, B[k * N + n]);
+                    return;
+                }
+            }
+        }
+    }
+
+    MatrixGuardBuffer<float> BufferA;
+    MatrixGuardBuffer<float> BufferB;
+    MatrixGuardBuffer<uint8_t> BufferQuantB;
+    MatrixGuardBuffer<float> BufferQuantBScale;
+    MatrixGuardBuffer<uint8_t> BufferQuantBZeroPoint;
+    MatrixGuardBuffer<float> BufferBias;
+    MatrixGuardBuffer<float> BufferC;
+    MatrixGuardBuffer<float> BufferCReference;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t BlkBits : {4, 8}) {
+            for (size_t BlkLen : {16, 32, 64, 128, 256}) {
+                for (bool Symmetric : {false, true}) {
+                    for (size_t b = 1; b < 20; b++) {
+                        Test(b, b, b, BlkBits, BlkLen, Symmetric, false);
+                    }
+                    Test(1, 768, 1024, BlkBits, BlkLen, Symmetric, true);
+                    Test(3, 300, 513, BlkBits, BlkLen, Symmetric, false);
+                    Test(37, 257, 255, BlkBits, BlkLen, Symmetric, true);
+                    Test(128, 96, 600, BlkBits, BlkLen, Symmetric, false);
+                    TestQuantize(33, 300, BlkBits, BlkLen, Symmetric);
+                }
+            }
+        }
+    }
+};
+
 template<bool Packed>
 class MlasQgemmU8X8U8X8TestBase;
 
@@ -588,6 +1422,31 @@ protected:
                  threadpool,
                  &scale_bias_processor);
     }
+
+    void
+    TestGemm(
+        size_t M,
+        size_t N,
+        size_t K,
+        const uint8_t* A,
+        size_t lda,
+        uint8_t offa,
+        const uint8_t* B,
+        size_t ldb,
+        uint8_t offb,
+        bool BIsSigned,
+        int32_t* C,
+        size_t ldc,
+        uint8_t* Output,
+        const int32_t* Bias,
+        const float* Scale,
+        bool PerColumnScale,
+        uint8_t ZeroPoint
+        )
+    {
+        MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR requant_processor(Output, ldc, Bias, Scale, PerColumnScale, ZeroPoint);
+        MlasGemm(M, N, K, A, lda, offa, B, ldb, offb, BIsSigned, C, ldc, threadpool, &requant_processor);
+    }
 };
 
 #ifdef MLAS_SUPPORTS_PACKED_GEMM_U8X8
@@ -660,6 +1519,32 @@ protected:
                  &scale_bias_processor);
     }
 
+    void
+    TestGemm(
+        size_t M,
+        size_t N,
+        size_t K,
+        const uint8_t* A,
+        size_t lda,
+        uint8_t offa,
+        const uint8_t* B,
+        size_t ldb,
+        uint8_t offb,
+        bool BIsSigned,
+        int32_t* C,
+        size_t ldc,
+        uint8_t* Output,
+        const int32_t* Bias,
+        const float* Scale,
+        bool PerColumnScale,
+        uint8_t ZeroPoint
+        )
+    {
+        const void* PackedB = PackB(N, K, B, ldb, BIsSigned);
+        MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR requant_processor(Output, ldc, Bias, Scale, PerColumnScale, ZeroPoint);
+        MlasGemm(M, N, K, A, lda, offa, PackedB, offb, BIsSigned, C, ldc, threadpool, &requant_processor);
+    }
+
 private:
     MatrixGuardBuffer<uint8_t> BufferBPacked;
 };
@@ -838,23 +1723,229 @@ public:
             }
             printf("M %zd\n", M);
         }
-
-        for (size_t M = 160; M < 320; M += 24) {
-            for (size_t N = 112; N < 320; N += 24) {
-                for (size_t K = 1; K < 16; K++) {
-                    Test(M, N, K, 1, 3);
-                }
-                for (size_t K = 16; K < 160; K += 32) {
-                    Test(M, N, K, 5, 7);
-                }
-            }
-            printf("M %zd\n", M);
+
+        for (size_t M = 160; M < 320; M += 24) {
+            for (size_t N = 112; N < 320; N += 24) {
+                for (size_t K = 1; K < 16; K++) {
+                    Test(M, N, K, 1, 3);
+                }
+                for (size_t K = 16; K < 160; K += 32) {
+                    Test(M, N, K, 5, 7);
+                }
+            }
+            printf("M %zd\n", M);
+        }
+    }
+};
+
+template<typename xint8_t, bool Packed>
+class MlasQgemmU8X8Test<xint8_t, float, Packed> : public MlasQgemmU8X8U8X8TestBase<Packed>
+{
+private:
+    void
+    Test(
+        size_t M,
+        size_t N,
+        size_t K,
+        uint8_t offa,
+        uint8_t offb
+        )
+    {
+        const uint8_t* A = BufferA.GetBuffer(K * M);
+        const uint8_t* B = BufferB.GetBuffer(N * K);
+        float* C = BufferC.GetBuffer(N * M);
+        float* CReference = BufferCReference.GetBuffer(N * M);
+        const float* Bias = BufferBias.GetBuffer(N);
+
+        const float AScale = 0.5f;
+        float* AFloat = BufferAFloat.GetBuffer(K * M);
+        DequantizeLinear(A, AFloat, K * M, AScale, offa);
+
+        const float BScale = 0.25f;
+        float* BFloat = BufferBFloat.GetBuffer(N * K);
+        DequantizeLinear((xint8_t*)B, BFloat, N * K, BScale, xint8_t(offb));
+
+        const float CScale = AScale * BScale;
+
+        Test(M, N, K, A, AFloat, K, offa, B, BFloat, N, offb, C, CReference, N, CScale, nullptr);
+        Test(M, N, K, A, AFloat, K, offa, B, BFloat, N, offb, C, CReference, N, CScale, Bias);
+    }
+
+    void
+    Test(
+        size_t M,
+        size_t N,
+        size_t K,
+        const uint8_t* A,
+        const float* AFloat,
+        size_t lda,
+        uint8_t offa,
+        const uint8_t* B,
+        const float* BFloat,
+        size_t ldb,
+        uint8_t offb,
+        float* C,
+        float* CReference,
+        size_t ldc,
+        float CScale,
+        const float* Bias
+        )
+    {
+        MlasGemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, AFloat, lda, BFloat, ldb, 0.0f, CReference, ldc, threadpool);
+
+        if (Bias != nullptr) {
+            for (size_t m = 0; m < M; m++) {
+                for (size_t n = 0; n < N; n++) {
+                    CReference[m * ldc + n] += Bias[n];
+                }
+            }
+        }
+
+        this->TestGemm(M, N, K, A, lda, offa, B, ldb, offb, BIsSigned, C, ldc, CScale, Bias);
+
+        for (size_t f = 0; f < M * N; f++) {
+            // Sensitive to comparing positive/negative zero.
+            if (C[f] != CReference[f]) {
+                printf("mismatch M=%zd, N=%zd, K=%zd, offa=%d, offb=%d! %f %f\n", M, N, K, int(offa), int(offb), C[f], CReference[f]);
+                break;
+            }
+        }
+    }
+
+    template<typename qint8_t>
+    void
+    DequantizeLinear(
+        const qint8_t* Input,
+        float* Output,
+        size_t N,
+        float scale,
+        qint8_t offset
+        )
+    {
+        for (size_t n = 0; n < N; n++) {
+            Output[n] = float((int32_t(Input[n]) - offset)) * scale;
+        }
+    }
+
+    MatrixGuardBuffer<uint8_t> BufferA;
+    MatrixGuardBuffer<uint8_t> BufferB;
+    MatrixGuardBuffer<float> BufferAFloat;
+    MatrixGuardBuffer<float> BufferBFloat;
+    MatrixGuardBuffer<float> BufferC;
+    MatrixGuardBuffer<float> BufferCReference;
+    MatrixGuardBuffer<float> BufferBias;
+    const bool BIsSigned = std::is_signed<xint8_t>::value;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t b = 1; b < 16; b++) {
+            Test(b, b, b, 34, 46);
+        }
+        for (size_t b = 16; b <= 256; b <<= 1) {
+            Test(b, b, b, 15, 191);
+        }
+        for (size_t b = 256; b < 320; b += 32) {
+            Test(b, b, b, 223, 73);
+        }
+        for (size_t b = 1; b < 96; b++) {
+            Test(1, b, 32, 0, 0);
+        }
+        Test(43, 503, 401, 183, 223);
+        Test(1024, 1024, 256, 13, 15);
+    }
+};
+
+template<typename xint8_t, bool Packed>
+class MlasQgemmU8X8Test<xint8_t, uint8_t, Packed> : public MlasQgemmU8X8U8X8TestBase<Packed>
+{
+private:
+    void
+    Test(
+        size_t M,
+        size_t N,
+        size_t K,
+        uint8_t offa,
+        uint8_t offb,
+        uint8_t ZeroPoint
+        )
+    {
+        const uint8_t* A = BufferA.GetBuffer(K * M);
+        const uint8_t* B = BufferB.GetBuffer(N * K);
+        int32_t* C = BufferC.GetBuffer(N * M);
+        int32_t* CReference = BufferCReference.GetBuffer(N * M);
+        uint8_t* Output = BufferOutput.GetBuffer(N * M);
+        uint8_t* OutputReference = BufferOutputReference.GetBuffer(N * M);
+        const int32_t* Bias = BufferBias.GetBuffer(N);
+        float* Scale = BufferScale.GetBuffer(N);
+
+        for (size_t n = 0; n < N; n++) {
+            Scale[n] = 1.0f / float(256 + (n % 29) * 37);
+        }
+
+        this->TestGemm(M, N, K, A, K, offa, B, N, offb, BIsSigned, CReference, N);
+
+        for (int i = 0; i < 4; i++) {
+
+            const int32_t* bias = (i & 1) ? Bias : nullptr;
+            const bool PerColumnScale = (i & 2) != 0;
+
+            MlasRequantizeOutput(CReference, OutputReference, bias, M, N, Scale, PerColumnScale, ZeroPoint);
+
+            this->TestGemm(M, N, K, A, K, offa, B, N, offb, BIsSigned, C, N,
+                           Output, bias, Scale, PerColumnScale, ZeroPoint);
+
+            for (size_t f = 0; f < M * N; f++) {
+                if (Output[f] != OutputReference[f]) {
+                    printf("mismatch M=%zd, N=%zd, K=%zd, offa=%d, offb=%d, bias=%d, percolumn=%d! %d %d\n",
+                           M, N, K, int(offa), int(offb), int(bias != nullptr), int(PerColumnScale),
+                           int(Output[f]), int(OutputReference[f]));
+                    break;
+                }
+            }
+        }
+    }
+
+    MatrixGuardBuffer<uint8_t> BufferA;
+    MatrixGuardBuffer<uint8_t> BufferB;
+    MatrixGuardBuffer<int32_t> BufferC;
+    MatrixGuardBuffer<int32_t> BufferCReference;
+    MatrixGuardBuffer<uint8_t> BufferOutput;
+    MatrixGuardBuffer<uint8_t> BufferOutputReference;
+    MatrixGuardBuffer<int32_t> BufferBias;
+    MatrixGuardBuffer<float> BufferScale;
+    const bool BIsSigned = std::is_signed<xint8_t>::value;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t b = 1; b < 16; b++) {
+            Test(b, b, b, 34, 46, 128);
+        }
+        for (size_t b = 16; b <= 256; b <<= 1) {
+            Test(b, b, b, 15, 191, 7);
+        }
+        for (size_t b = 1; b < 96; b++) {
+            Test(1, b, 32, 0, 0, 101);
         }
+        Test(43, 503, 401, 183, 223, 0);
+        Test(1024, 1024, 256, 13, 15, 255);
     }
 };
 
-template<typename xint8_t, bool Packed>
-class MlasQgemmU8X8Test<xint8_t, float, Packed> : public MlasQgemmU8X8U8X8TestBase<Packed>
+//
+// Tests the QGEMM parameters routine with signed data in matrix A and with the
+// zero point offsets of matrix B per column.
+//
+
+template<typename AType, typename BType, bool Packed>
+class MlasQgemmPerColumnTest : public MlasTestBase
 {
 private:
     void
@@ -863,93 +1954,117 @@ private:
         size_t N,
         size_t K,
         uint8_t offa,
-        uint8_t offb
+        bool PerColumnZeroPoints
         )
     {
         const uint8_t* A = BufferA.GetBuffer(K * M);
         const uint8_t* B = BufferB.GetBuffer(N * K);
-        float* C = BufferC.GetBuffer(N * M);
-        float* CReference = BufferCReference.GetBuffer(N * M);
-        const float* Bias = BufferBias.GetBuffer(N);
+        uint8_t* ZeroPointB = BufferZeroPointB.GetBuffer(N);
+        int32_t* C = BufferC.GetBuffer(N * M);
+        int32_t* CReference = BufferCReference.GetBuffer(N * M);
+        uint8_t* Output = BufferOutput.GetBuffer(N * M);
+        uint8_t* OutputReference = BufferOutputReference.GetBuffer(N * M);
+        float* Scale = BufferScale.GetBuffer(N);
 
-        const float AScale = 0.5f;
-        float* AFloat = BufferAFloat.GetBuffer(K * M);
-        DequantizeLinear(A, AFloat, K * M, AScale, offa);
+        for (size_t n = 0; n < N; n++) {
+            ZeroPointB[n] = uint8_t(PerColumnZeroPoints ? (n * 37 + 11) : 211);
+            Scale[n] = 1.0f / float(256 + (n % 29) * 37);
+        }
 
-        const float BScale = 0.25f;
-        float* BFloat = BufferBFloat.GetBuffer(N * K);
-        DequantizeLinear((xint8_t*)B, BFloat, N * K, BScale, xint8_t(offb));
+        MLAS_GEMM_U8X8_PARAMETERS Parameters;
+
+        Parameters.M = M;
+        Parameters.N = N;
+        Parameters.K = K;
+        Parameters.A = A;
+        Parameters.lda = K;
+        Parameters.ZeroPointA = offa;
+        Parameters.AIsSigned = std::is_signed<AType>::value;
+        Parameters.B = B;
+        Parameters.ldb = N;
+        Parameters.ZeroPointB = ZeroPointB[0];
+        Parameters.PerColumnZeroPointB = PerColumnZeroPoints ? ZeroPointB : nullptr;
+        Parameters.BIsSigned = std::is_signed<BType>::value;
+        Parameters.C = C;
+        Parameters.ldc = N;
 
-        const float CScale = AScale * BScale;
+#ifdef MLAS_SUPPORTS_PACKED_GEMM_U8X8
+        if (Packed) {
+            size_t PackedBSize = MlasGemmPackBSize(N, K, Parameters.BIsSigned);
+            void* PackedB = BufferBPacked.GetBuffer(PackedBSize);
+            MlasGemmPackB(N, K, B, N, Parameters.BIsSigned, PackedB);
+            Parameters.B = PackedB;
+            Parameters.BIsPacked = true;
+        }
+#endif
 
-        Test(M, N, K, A, AFloat, K, offa, B, BFloat, N, offb, C, CReference, N, CScale, nullptr);
-        Test(M, N, K, A, AFloat, K, offa, B, BFloat, N, offb, C, CReference, N, CScale, Bias);
-    }
+        std::fill_n(C, M * N, -1);
 
-    void
-    Test(
-        size_t M,
-        size_t N,
-        size_t K,
-        const uint8_t* A,
-        const float* AFloat,
-        size_t lda,
-        uint8_t offa,
-        const uint8_t* B,
-        const float* BFloat,
-        size_t ldb,
-        uint8_t offb,
-        float* C,
-        float* CReference,
-        size_t ldc,
-        float CScale,
-        const float* Bias
-        )
-    {
-        MlasGemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, AFloat, lda, BFloat, ldb, 0.0f, CReference, ldc, threadpool);
+        MlasGemm(Parameters, threadpool);
+        ReferenceQgemm(M, N, K, (const AType*)A, AType(offa), (const BType*)B,
+                       (const BType*)ZeroPointB, PerColumnZeroPoints, CReference);
 
-        if (Bias != nullptr) {
-            for (size_t m = 0; m < M; m++) {
-                for (size_t n = 0; n < N; n++) {
-                    CReference[m * ldc + n] += Bias[n];
-                }
+        for (size_t f = 0; f < M * N; f++) {
+            if (C[f] != CReference[f]) {
+                printf("mismatch M=%zd, N=%zd, K=%zd, offa=%d, percolumn=%d!\n",
+                       M, N, K, int(offa), int(PerColumnZeroPoints));
+                break;
             }
         }
 
-        this->TestGemm(M, N, K, A, lda, offa, B, ldb, offb, BIsSigned, C, ldc, CScale, Bias);
+        //
+        // The zero point offsets must be applied before the output processor.
+        //
+
+        MLAS_QGEMM_REQUANT_OUTPUT_PROCESSOR requant_processor(Output, N, nullptr, Scale, true, 7);
+        Parameters.OutputProcessor = &requant_processor;
+
+        MlasGemm(Parameters, threadpool);
+        MlasRequantizeOutput(CReference, OutputReference, nullptr, M, N, Scale, true, 7);
 
         for (size_t f = 0; f < M * N; f++) {
-            // Sensitive to comparing positive/negative zero.
-            if (C[f] != CReference[f]) {
-                printf("mismatch M=%zd, N=%zd, K=%zd, offa=%d, offb=%d! %f %f\n", M, N, K, int(offa), int(offb), C[f], CReference[f]);
+            if (Output[f] != OutputReference[f]) {
+                printf("mismatch requant M=%zd, N=%zd, K=%zd, offa=%d, percolumn=%d!\n",
+                       M, N, K, int(offa), int(PerColumnZeroPoints));
                 break;
             }
         }
     }
 
-    template<typename qint8_t>
     void
-    DequantizeLinear(
-        const qint8_t* Input,
-        float* Output,
+    ReferenceQgemm(
+        size_t M,
         size_t N,
-        float scale,
-        qint8_t offset
+        size_t K,
+        const AType* A,
+        AType offa,
+        const BType* B,
+        const BType* ZeroPointB,
+        bool PerColumnZeroPoints,
+        int32_t* C
         )
     {
-        for (size_t n = 0; n < N; n++) {
-            Output[n] = float((int32_t(Input[n]) - offset)) * scale;
+        for (size_t m = 0; m < M; m++) {
+            for (size_t n = 0; n < N; n++) {
+                const int32_t offb = ZeroPointB[PerColumnZeroPoints ? n : 0];
+                int32_t sum = 0;
+                for (size_t k = 0; k < K; k++) {
+                    sum += (int32_t(A[m * K + k]) - offa) * (int32_t(B[k * N + n]) - offb);
+                }
+                C[m * N + n] = sum;
+            }
         }
     }
 
     MatrixGuardBuffer<uint8_t> BufferA;
     MatrixGuardBuffer<uint8_t> BufferB;
-    MatrixGuardBuffer<float> BufferAFloat;
-    MatrixGuardBuffer<float> BufferBFloat;
-    MatrixGuardBuffer<float> BufferC;
-    MatrixGuardBuffer<float> BufferCReference;
-    MatrixGuardBuffer<float> BufferBias;
-    const bool BIsSigned = std::is_signed<xint8_t>::value;
+    MatrixGuardBuffer<uint8_t> BufferBPacked;
+    MatrixGuardBuffer<uint8_t> BufferZeroPointB;
+    MatrixGuardBuffer<int32_t> BufferC;
+    MatrixGuardBuffer<int32_t> BufferCReference;
+    MatrixGuardBuffer<uint8_t> BufferOutput;
+    MatrixGuardBuffer<uint8_t> BufferOutputReference;
+    MatrixGuardBuffer<float> BufferScale;
 
 public:
     void
@@ -957,20 +2072,22 @@ public:
         void
         ) override
     {
-        for (size_t b = 1; b < 16; b++) {
-            Test(b, b, b, 34, 46);
-        }
-        for (size_t b = 16; b <= 256; b <<= 1) {
-            Test(b, b, b, 15, 191);
-        }
-        for (size_t b = 256; b < 320; b += 32) {
-            Test(b, b, b, 223, 73);
-        }
-        for (size_t b = 1; b < 96; b++) {
-            Test(1, b, 32, 0, 0);
+        for (int i = 0; i < 2; i++) {
+            const bool PerColumnZeroPoints = (i != 0);
+
+            for (size_t b = 1; b < 16; b++) {
+                Test(b, b, b, 14, PerColumnZeroPoints);
+            }
+            for (size_t b = 16; b <= 256; b <<= 1) {
+                Test(b, b, b, 34, PerColumnZeroPoints);
+            }
+            for (size_t b = 1; b < 96; b++) {
+                Test(1, b, 32, 0, PerColumnZeroPoints);
+                Test(1, 32, b, 128, PerColumnZeroPoints);
+            }
+            Test(43, 500, 401, 183, PerColumnZeroPoints);
+            Test(97, 301, 777, 255, PerColumnZeroPoints);
         }
-        Test(43, 503, 401, 183, 223);
-        Test(1024, 1024, 256, 13, 15);
     }
 };
 
@@ -1209,23 +2326,176 @@ protected:
 
                     float biasValue = *bias++;
 
-                    for (size_t o = 0; o < OutputSize; o++) {
-                        *Output++ += biasValue;
-                    }
-                }
+                    for (size_t o = 0; o < OutputSize; o++) {
+                        *Output++ += biasValue;
+                    }
+                }
+
+                filter += FilterCount * InputChannels * KernelSize;
+            }
+        }
+    }
+
+    MatrixGuardBuffer<float> BufferInput;
+    MatrixGuardBuffer<float> BufferFilter;
+    MatrixGuardBuffer<float> BufferBias;
+    MatrixGuardBuffer<float> BufferOutput;
+    MatrixGuardBuffer<float> BufferOutputReference;
+    MatrixGuardBuffer<float> BufferWorking;
+    MatrixGuardBuffer<float> BufferIm2Col;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (unsigned i = 1; i < 256; i <<= 1) {
+            Test(1, 1, 16, i, i, 32, 3, 3, 0, 0, 0, 0, 1, 1, 1, 1);
+            Test(1, 1, 16, i, i, 32, 3, 3, 0, 0, 0, 0, 1, 1, 2, 2);
+            Test(1, 1, 16, i, i, 32, 3, 3, 0, 0, 0, 0, 2, 2, 1, 1);
+            Test(1, 1, 16, i, i, 32, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+            Test(1, 1, 16, i, i, 32, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1);
+            Test(1, 1, 16, i, i, 32, i, 1, 0, 0, 0, 0, 1, 1, 1, 1);
+            Test(1, 1, 16, i, i, 32, 1, i, 0, 0, 0, 0, 1, 1, 1, 1);
+        }
+    }
+
+    void
+    ExecuteLong(
+        void
+        ) override
+    {
+        static const unsigned cs[] = { 32, 14, 1 };
+        static const unsigned is[] = { 53, 11, 5, 1 };
+
+        for (unsigned i = 1; i <= 32; i++) {
+            Test(4, 18, 1, 32, 89, 48, i, 89, 0, 0, 0, 0, 1, 1, 1, 1);
+            Test(4, 18, 1, 32, 89, 48, i, 89, 1, 1, 1, 1, 1, 1, 1, 1);
+            Test(4, 18, 2, 32, 89, 48, i, 89, 0, 0, 0, 0, 1, 1, 1, 1);
+        }
+
+        for (unsigned b = 1; b < 64; b++) {
+            Test(b, 1, 64, 11, 11, 128, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1);
+        }
+
+        for (unsigned ic = 0; ic < _countof(cs); ic++) {
+            for (unsigned ih = 0; ih < _countof(is); ih++) {
+                for (unsigned iw = 0; iw < _countof(is); iw++) {
+                    fprintf(stderr, "Handling %ux%ux%u\n", cs[ic], is[ih], is[iw]);
+                    for (unsigned fc = 0; fc < _countof(cs); fc++) {
+                        for (unsigned kh = 1; kh <= 5; kh++) {
+                            if (kh == 4) continue;
+                            for (unsigned kw = 1; kw <= 5; kw++) {
+                                if (kw == 4) continue;
+                                for (unsigned p0 = 0; p0 < 2; p0++) {
+                                    for (unsigned p1 = 0; p1 < 2; p1++) {
+                                        for (unsigned p2 = 0; p2 < 2; p2++) {
+                                            for (unsigned p3 = 0; p3 < 2; p3++) {
+                                                for (unsigned dh = 1; dh <= 2; dh++) {
+                                                    for (unsigned dw = 1; dw <= 2; dw++) {
+                                                        for (unsigned sh = 1; sh <= 2; sh++) {
+                                                            for (unsigned sw = 1; sw <= 2; sw++) {
+                                                                Test(1, 1, cs[ic], is[ih], is[iw], cs[fc], kh, kw, p0, p1, p2, p3, dh, dw, sh, sw);
+                                                            }
+                                                        }
+                                                    }
+                                                }
+                                            }
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+};
+
+class MlasWinogradConv2DTest : public MlasConv2DTest
+{
+protected:
+    void
+    MlasConv2D(
+        size_t BatchCount,
+        size_t GroupCount,
+        size_t InputChannels,
+        size_t InputHeight,
+        size_t InputWidth,
+        size_t FilterCount,
+        size_t KernelHeight,
+        size_t KernelWidth,
+        size_t PaddingLeftHeight,
+        size_t PaddingLeftWidth,
+        size_t PaddingRightHeight,
+        size_t PaddingRightWidth,
+        size_t DilationHeight,
+        size_t DilationWidth,
+        size_t StrideHeight,
+        size_t StrideWidth,
+        size_t OutputHeight,
+        size_t OutputWidth,
+        const float* Input,
+        const float* Filter,
+        const float* Bias,
+        float* Output
+        ) override
+    {
+        int64_t InputShape[] = { int64_t(InputHeight), int64_t(InputWidth) };
+        int64_t KernelShape[] = { int64_t(KernelHeight), int64_t(KernelWidth) };
+        int64_t DilationShape[] = { int64_t(DilationHeight), int64_t(DilationWidth) };
+        int64_t Padding[] = { int64_t(PaddingLeftHeight), int64_t(PaddingLeftWidth), int64_t(PaddingRightHeight), int64_t(PaddingRightWidth) };
+        int64_t StrideShape[] = { int64_t(StrideHeight), int64_t(StrideWidth) };
+        int64_t OutputShape[] = { int64_t(OutputHeight), int64_t(OutputWidth) };
+
+        size_t TransformedFilterElements = MlasConvWinogradFilterSize(2, GroupCount, InputChannels,
+            KernelShape, DilationShape, StrideShape, FilterCount);
+
+        if (TransformedFilterElements == 0) {
+            printf("Winograd algorithm not selected: input(%zd,%zd,%zd),filter=%zd!!!\n",
+                InputChannels, InputHeight, InputWidth, FilterCount);
+            return;
+        }
+
+        float* TransformedFilter = BufferTransformedFilter.GetBuffer(TransformedFilterElements);
+
+        MlasConvWinogradTransformFilter(GroupCount, InputChannels, FilterCount, Filter, TransformedFilter);
+
+        MLAS_ACTIVATION Activation;
+        Activation.ActivationKind = MlasIdentityActivation;
+
+        MLAS_CONV_PARAMETERS Parameters;
+        size_t WorkingBufferSize;
+
+        MlasConvPrepare(&Parameters,
+                        2,
+                        BatchCount,
+                        GroupCount,
+                        InputChannels,
+                        InputShape,
+                        KernelShape,
+                        DilationShape,
+                        Padding,
+                        StrideShape,
+                        OutputShape,
+                        FilterCount,
+                        &Activation,
+                        &WorkingBufferSize,
+                        threadpool,
+                        true);
 
-                filter += FilterCount * InputChannels * KernelSize;
-            }
-        }
+        MlasConv(&Parameters,
+                 Input,
+                 TransformedFilter,
+                 Bias,
+                 BufferWorking.GetBuffer(WorkingBufferSize),
+                 Output,
+                 threadpool);
     }
 
-    MatrixGuardBuffer<float> BufferInput;
-    MatrixGuardBuffer<float> BufferFilter;
-    MatrixGuardBuffer<float> BufferBias;
-    MatrixGuardBuffer<float> BufferOutput;
-    MatrixGuardBuffer<float> BufferOutputReference;
-    MatrixGuardBuffer<float> BufferWorking;
-    MatrixGuardBuffer<float> BufferIm2Col;
+    MatrixGuardBuffer<float> BufferTransformedFilter;
 
 public:
     void
@@ -1233,15 +2503,22 @@ public:
         void
         ) override
     {
-        for (unsigned i = 1; i < 256; i <<= 1) {
-            Test(1, 1, 16, i, i, 32, 3, 3, 0, 0, 0, 0, 1, 1, 1, 1);
-            Test(1, 1, 16, i, i, 32, 3, 3, 0, 0, 0, 0, 1, 1, 2, 2);
-            Test(1, 1, 16, i, i, 32, 3, 3, 0, 0, 0, 0, 2, 2, 1, 1);
-            Test(1, 1, 16, i, i, 32, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
-            Test(1, 1, 16, i, i, 32, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1);
-            Test(1, 1, 16, i, i, 32, i, 1, 0, 0, 0, 0, 1, 1, 1, 1);
-            Test(1, 1, 16, i, i, 32, 1, i, 0, 0, 0, 0, 1, 1, 1, 1);
+        //
+        // The fill values are small integers, so the transformed products are
+        // exact and the output matches the reference bit for bit.
+        //
+
+        for (unsigned i = 1; i < 40; i += 3) {
+            Test(1, 1, 32, i, i, 32, 3, 3, 0, 0, 0, 0, 1, 1, 1, 1);
+            Test(1, 1, 32, i, i + 1, 48, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
         }
+
+        Test(1, 1, 32, 7, 9, 32, 3, 3, 0, 1, 1, 0, 1, 1, 1, 1);
+        Test(1, 1, 40, 5, 5, 32, 3, 3, 2, 2, 2, 2, 1, 1, 1, 1);
+        Test(3, 1, 32, 14, 14, 48, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+        Test(2, 2, 32, 15, 13, 40, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+        Test(1, 1, 64, 56, 56, 64, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
+        Test(1, 1, 128, 28, 28, 128, 3, 3, 1, 1, 1, 1, 1, 1, 1, 1);
     }
 
     void
@@ -1249,51 +2526,6 @@ public:
         void
         ) override
     {
-        static const unsigned cs[] = { 32, 14, 1 };
-        static const unsigned is[] = { 53, 11, 5, 1 };
-
-        for (unsigned i = 1; i <= 32; i++) {
-            Test(4, 18, 1, 32, 89, 48, i, 89, 0, 0, 0, 0, 1, 1, 1, 1);
-            Test(4, 18, 1, 32, 89, 48, i, 89, 1, 1, 1, 1, 1, 1, 1, 1);
-            Test(4, 18, 2, 32, 89, 48, i, 89, 0, 0, 0, 0, 1, 1, 1, 1);
-        }
-
-        for (unsigned b = 1; b < 64; b++) {
-            Test(b, 1, 64, 11, 11, 128, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1);
-        }
-
-        for (unsigned ic = 0; ic < _countof(cs); ic++) {
-            for (unsigned ih = 0; ih < _countof(is); ih++) {
-                for (unsigned iw = 0; iw < _countof(is); iw++) {
-                    fprintf(stderr, "Handling %ux%ux%u\n", cs[ic], is[ih], is[iw]);
-                    for (unsigned fc = 0; fc < _countof(cs); fc++) {
-                        for (unsigned kh = 1; kh <= 5; kh++) {
-                            if (kh == 4) continue;
-                            for (unsigned kw = 1; kw <= 5; kw++) {
-                                if (kw == 4) continue;
-                                for (unsigned p0 = 0; p0 < 2; p0++) {
-                                    for (unsigned p1 = 0; p1 < 2; p1++) {
-                                        for (unsigned p2 = 0; p2 < 2; p2++) {
-                                            for (unsigned p3 = 0; p3 < 2; p3++) {
-                                                for (unsigned dh = 1; dh <= 2; dh++) {
-                                                    for (unsigned dw = 1; dw <= 2; dw++) {
-                                                        for (unsigned sh = 1; sh <= 2; sh++) {
-                                                            for (unsigned sw = 1; sw <= 2; sw++) {
-                                                                Test(1, 1, cs[ic], is[ih], is[iw], cs[fc], kh, kw, p0, p1, p2, p3, dh, dw, sh, sw);
-                                                            }
-                                                        }
-                                                    }
-                                                }
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-        }
     }
 };
 
@@ -1759,6 +2991,7 @@ public:
             Test(1, 16, i, i, 1, 1, 0, 0, 0, 0, 1, 1);
             Test(1, 16, i, i, i, 1, 0, 0, 0, 0, 1, 1);
             Test(1, 16, i, i, 1, i, 0, 0, 0, 0, 1, 1);
+            Test(1, 16, i, i, i, i, 0, 0, 0, 0, 1, 1);
         }
     }
 
@@ -2404,6 +3637,64 @@ private:
     MatrixGuardBuffer<float> BufferInput;
     MatrixGuardBuffer<float> BufferOutput;
     MatrixGuardBuffer<float> BufferOutputReference;
+    MatrixGuardBuffer<float> BufferInputTransposed;
+
+    void
+    TestStrided(
+        size_t N,
+        size_t D,
+        size_t M,
+        float MinimumValue,
+        float MaximumValue
+        )
+    {
+        float* Input = BufferInput.GetBuffer(N * D * M);
+        float* Output = BufferOutput.GetBuffer(N * D * M);
+        float* OutputReference = BufferOutputReference.GetBuffer(N * D * M);
+        float* InputTransposed = BufferInputTransposed.GetBuffer(N * D * M);
+
+        std::default_random_engine generator(static_cast<unsigned>(N * D * M));
+        std::uniform_real_distribution<float> distribution(MinimumValue, MaximumValue);
+
+        for (size_t ndm = 0; ndm < N * D * M; ndm++) {
+            Input[ndm] = distribution(generator);
+        }
+
+        //
+        // The reference is the softmax of the rows of the input transposed to
+        // [N, M, D].
+        //
+
+        for (size_t n = 0; n < N; n++) {
+            for (size_t d = 0; d < D; d++) {
+                for (size_t m = 0; m < M; m++) {
+                    InputTransposed[(n * M + m) * D + d] = Input[(n * D + d) * M + m];
+                }
+            }
+        }
+
+        for (int32_t LogSoftmax = 0; LogSoftmax < 2; LogSoftmax++) {
+
+            MlasComputeSoftmaxStrided(Input, Output, N, D, M, LogSoftmax != 0, threadpool);
+            ReferenceSoftmax(InputTransposed, OutputReference, N * M, D, LogSoftmax != 0);
+
+            constexpr float AbsoluteTolerance = 1e-6f;
+            constexpr float RelativeTolerance = 1e-6f;
+
+            for (size_t n = 0; n < N; n++) {
+                for (size_t d = 0; d < D; d++) {
+                    for (size_t m = 0; m < M; m++) {
+                        float Value = Output[(n * D + d) * M + m];
+                        float ReferenceValue = OutputReference[(n * M + m) * D + d];
+                        float diff = std::fabs(Value - ReferenceValue);
+                        if (diff > AbsoluteTolerance && diff > std::fabs(ReferenceValue) * RelativeTolerance) {
+                            printf("softmax strided(%d) difference: %u/%u/%u %.8f %.8f\n", LogSoftmax, unsigned(N), unsigned(D), unsigned(M), Value, ReferenceValue);
+                        }
+                    }
+                }
+            }
+        }
+    }
 
     void
     Test(
@@ -2512,6 +3803,14 @@ public:
         Test(3, 128, 20.f, 30.f);
         Test(63, 95, -150.f, 190.f);
         Test(16, 211, 20.f, 30.f);
+
+        for (size_t m = 1; m < 20; m++) {
+            TestStrided(1, 7, m, -10.f, 10.f);
+        }
+
+        TestStrided(3, 128, 5, 20.f, 30.f);
+        TestStrided(5, 33, 131, -150.f, 190.f);
+        TestStrided(2, 49, 64, -10.f, 10.f);
     }
 };
 
@@ -2947,6 +4246,232 @@ public:
     }
 };
 
+class MlasReduceTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<float> BufferInput;
+    MatrixGuardBuffer<float> BufferOutput;
+    MatrixGuardBuffer<float> BufferOutputReference;
+
+    static
+    float
+    ReduceReference(
+        MLAS_REDUCTION_KIND ReductionKind,
+        const float* Input,
+        size_t Count,
+        size_t Stride
+        )
+    {
+        double Value = Input[0];
+
+        for (size_t i = 1; i < Count; i++) {
+            float v = Input[i * Stride];
+            switch (ReductionKind) {
+                case MlasSumReduction:
+                case MlasMeanReduction:
+                    Value += v;
+                    break;
+                case MlasMaximumReduction:
+                    Value = std::max(Value, double(v));
+                    break;
+                case MlasMinimumReduction:
+                    Value = std::min(Value, double(v));
+                    break;
+            }
+        }
+
+        if (ReductionKind == MlasMeanReduction) {
+            Value /= double(Count);
+        }
+
+        return float(Value);
+    }
+
+    void
+    Test(
+        MLAS_REDUCTION_KIND ReductionKind,
+        bool InnerAxis,
+        size_t Rows,
+        size_t Columns
+        )
+    {
+        float* Input = BufferInput.GetBuffer(Rows * Columns);
+        size_t OutputCount = InnerAxis ? Rows : Columns;
+        float* Output = BufferOutput.GetBuffer(OutputCount);
+        float* OutputReference = BufferOutputReference.GetBuffer(OutputCount);
+
+        std::default_random_engine generator(static_cast<unsigned>(Rows * Columns));
+        std::uniform_real_distribution<float> distribution(-10.0f, 10.0f);
+
+        for (size_t i = 0; i < Rows * Columns; i++) {
+            Input[i] = distribution(generator);
+        }
+
+        if (InnerAxis) {
+            MlasReduceInnerAxis(ReductionKind, Input, Output, Rows, Columns);
+            for (size_t m = 0; m < Rows; m++) {
+                OutputReference[m] = ReduceReference(ReductionKind, Input + m * Columns, Columns, 1);
+            }
+        } else {
+            MlasReduceOuterAxis(ReductionKind, Input, Output, Rows, Columns, Columns);
+            for (size_t n = 0; n < Columns; n++) {
+                OutputReference[n] = ReduceReference(ReductionKind, Input + n, Rows, Columns);
+            }
+        }
+
+        //
+        // The rounding error of the sum grows with the number of elements.
+        //
+
+        const float Tolerance = 1e-5f * float(InnerAxis ? Columns : Rows);
+
+        for (size_t i = 0; i < OutputCount; i++) {
+            if (std::fabs(Output[i] - OutputReference[i]) > Tolerance) {
+                printf("mismatch Reduce(kind=%d,inner=%d,%zd,%zd) %zd: %f %f\n",
+                    int(ReductionKind), int(InnerAxis), Rows, Columns, i, Output[i], OutputReference[i]);
+                break;
+            }
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        static const MLAS_REDUCTION_KIND ReductionKinds[] = {
+            MlasSumReduction, MlasMeanReduction, MlasMaximumReduction, MlasMinimumReduction };
+
+        for (size_t k = 0; k < _countof(ReductionKinds); k++) {
+            for (size_t m = 1; m < 20; m++) {
+                for (size_t n = 1; n < 40; n++) {
+                    Test(ReductionKinds[k], true, m, n);
+                    Test(ReductionKinds[k], false, m, n);
+                }
+            }
+            Test(ReductionKinds[k], true, 3, 1000);
+            Test(ReductionKinds[k], false, 1000, 35);
+        }
+    }
+};
+
+class MlasLayerNormTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<float> BufferInput;
+    MatrixGuardBuffer<float> BufferSkip;
+    MatrixGuardBuffer<float> BufferBias;
+    MatrixGuardBuffer<float> BufferScale;
+    MatrixGuardBuffer<float> BufferOutput;
+    MatrixGuardBuffer<float> BufferOutputReference;
+
+    void
+    Test(
+        size_t N,
+        bool UseSkip,
+        bool UseBias
+        )
+    {
+        float* Input = BufferInput.GetBuffer(N);
+        float* Skip = UseSkip ? BufferSkip.GetBuffer(N) : nullptr;
+        float* Bias = UseBias ? BufferBias.GetBuffer(N) : nullptr;
+        float* Scale = BufferScale.GetBuffer(N);
+        float* Output = BufferOutput.GetBuffer(N);
+        float* OutputReference = BufferOutputReference.GetBuffer(N);
+
+        std::default_random_engine generator(static_cast<unsigned>(N));
+        std::uniform_real_distribution<float> distribution(-4.0f, 4.0f);
+
+        for (size_t n = 0; n < N; n++) {
+            Input[n] = distribution(generator);
+            Scale[n] = distribution(generator);
+            if (Skip != nullptr) {
+                Skip[n] = distribution(generator);
+            }
+            if (Bias != nullptr) {
+                Bias[n] = distribution(generator);
+            }
+        }
+
+        double SumReference = 0.0;
+        double SumSquareReference = 0.0;
+
+        for (size_t n = 0; n < N; n++) {
+            float Value = Input[n] + (Skip != nullptr ? Skip[n] : 0.0f) + (Bias != nullptr ? Bias[n] : 0.0f);
+            OutputReference[n] = Value;
+            SumReference += Value;
+            SumSquareReference += double(Value) * Value;
+        }
+
+        float Mean;
+        float MeanSquare;
+        MlasComputeMeanAndMeanSquare(Input, Skip, Bias, Output, N, &Mean, &MeanSquare);
+
+        if (std::fabs(Mean - float(SumReference / N)) > 1e-4f ||
+            std::fabs(MeanSquare - float(SumSquareReference / N)) > 1e-3f) {
+            printf("mismatch MeanAndMeanSquare(N=%zd): %f %f, %f %f\n", N,
+                Mean, float(SumReference / N), MeanSquare, float(SumSquareReference / N));
+        }
+
+        if (Skip != nullptr || Bias != nullptr) {
+            for (size_t n = 0; n < N; n++) {
+                if (Output[n] != OutputReference[n]) {
+                    printf("mismatch MeanAndMeanSquare(N=%zd) sum %zd: %f %f\n", N, n, Output[n], OutputReference[n]);
+                    break;
+                }
+            }
+        }
+
+        //
+        // Normalize the input buffer. The optional bias buffer is used as the shift.
+        //
+
+        const float InverseStdDev = 0.75f;
+
+        MlasComputeNormalizeScaleShift(Input, Output, N, Mean, InverseStdDev, Scale, Bias);
+
+        for (size_t n = 0; n < N; n++) {
+            float Reference = (Input[n] - Mean) * InverseStdDev * Scale[n] + (Bias != nullptr ? Bias[n] : 0.0f);
+            if (std::fabs(Output[n] - Reference) > 1e-5f) {
+                printf("mismatch NormalizeScaleShift(N=%zd) %zd: %f %f\n", N, n, Output[n], Reference);
+                break;
+            }
+        }
+
+        //
+        // Compute the GELU of the input buffer plus the optional bias buffer.
+        //
+
+        MlasComputeBiasGelu(Input, Bias, Output, N);
+
+        for (size_t n = 0; n < N; n++) {
+            float Value = Input[n] + (Bias != nullptr ? Bias[n] : 0.0f);
+            float Reference = 0.5f * Value * (1.0f + std::erf(Value * 0.70710678118654752440f));
+            if (std::fabs(Output[n] - Reference) > 1e-5f) {
+                printf("mismatch BiasGelu(N=%zd) %zd: %f %f\n", N, n, Output[n], Reference);
+                break;
+            }
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t n = 1; n < 80; n++) {
+            Test(n, false, false);
+            Test(n, true, false);
+            Test(n, false, true);
+            Test(n, true, true);
+        }
+        Test(768, true, true);
+        Test(1031, false, true);
+    }
+};
+
 class MlasScaleOutputTest : public MlasTestBase
 {
 private:
@@ -3042,6 +4567,28 @@ RunThreadedTests(
     onnxruntime::make_unique<MlasFgemmTest<float, false>>()->ExecuteShort();
     printf("SGEMM packed tests.\n");
     onnxruntime::make_unique<MlasFgemmTest<float, true>>()->ExecuteShort();
+    printf("SGEMM batch tests.\n");
+    onnxruntime::make_unique<MlasSgemmBatchTest>()->ExecuteShort();
+    printf("HGEMM tests.\n");
+    onnxruntime::make_unique<MlasHalfGemmTest<MLAS_FP16, false>>()->ExecuteShort();
+    onnxruntime::make_unique<MlasHalfGemmTest<MLAS_FP16, true>>()->ExecuteShort();
+    printf("BF16 GEMM tests.\n");
+    onnxruntime::make_unique<MlasHalfGemmTest<MLAS_BF16, false>>()->ExecuteShort();
+    onnxruntime::make_unique<MlasHalfGemmTest<MLAS_BF16, true>>()->ExecuteShort();
+    printf("SGEMM half precision packed B tests.\n");
+    onnxruntime::make_unique<MlasHalfPackedBGemmTest<MLAS_FP16>>()->ExecuteShort();
+    onnxruntime::make_unique<MlasHalfPackedBGemmTest<MLAS_BF16>>()->ExecuteShort();
+    printf("Half precision conversion tests.\n");
+    onnxruntime::make_unique<MlasHalfConvertTest>()->ExecuteShort();
+    printf("Sparse SGEMM tests.\n");
+    onnxruntime::make_unique<MlasSparseGemmTest>()->ExecuteShort();
+    printf("Block quantized SGEMM tests.\n");
+    onnxruntime::make_unique<MlasBlockQuantGemmTest>()->ExecuteShort();
+    printf("Transpose tests.\n");
+    onnxruntime::make_unique<MlasTransposeTest<uint8_t>>()->ExecuteShort();
+    onnxruntime::make_unique<MlasTransposeTest<uint16_t>>()->ExecuteShort();
+    onnxruntime::make_unique<MlasTransposeTest<uint32_t>>()->ExecuteShort();
+    onnxruntime::make_unique<MlasTransposeTest<uint64_t>>()->ExecuteShort();
 #ifdef MLAS_SUPPORTS_GEMM_DOUBLE
     printf("DGEMM tests.\n");
     onnxruntime::make_unique<MlasFgemmTest<double, false>>()->ExecuteShort();
@@ -3055,6 +4602,10 @@ RunThreadedTests(
     onnxruntime::make_unique<MlasQgemmU8X8Test<uint8_t, int32_t, false>>()->ExecuteShort();
     printf("QGEMM U8U8=float tests.\n");
     onnxruntime::make_unique<MlasQgemmU8X8Test<uint8_t, float, false>>()->ExecuteShort();
+    printf("QGEMM U8S8=uint8_t tests.\n");
+    onnxruntime::make_unique<MlasQgemmU8X8Test<int8_t, uint8_t, false>>()->ExecuteShort();
+    printf("QGEMM U8U8=uint8_t tests.\n");
+    onnxruntime::make_unique<MlasQgemmU8X8Test<uint8_t, uint8_t, false>>()->ExecuteShort();
 
 #ifdef MLAS_SUPPORTS_PACKED_GEMM_U8X8
     if (MlasGemmPackBSize(128, 128, true) > 0) {
@@ -3062,17 +4613,40 @@ RunThreadedTests(
         onnxruntime::make_unique<MlasQgemmU8X8Test<int8_t, int32_t, true>>()->ExecuteShort();
         printf("QGEMM U8S8=float packed tests.\n");
         onnxruntime::make_unique<MlasQgemmU8X8Test<int8_t, float, true>>()->ExecuteShort();
+        printf("QGEMM U8S8=uint8_t packed tests.\n");
+        onnxruntime::make_unique<MlasQgemmU8X8Test<int8_t, uint8_t, true>>()->ExecuteShort();
     }
     if (MlasGemmPackBSize(128, 128, false) > 0) {
         printf("QGEMM U8U8=int32_t packed tests.\n");
         onnxruntime::make_unique<MlasQgemmU8X8Test<uint8_t, int32_t, true>>()->ExecuteShort();
         printf("QGEMM U8U8=float packed tests.\n");
         onnxruntime::make_unique<MlasQgemmU8X8Test<uint8_t, float, true>>()->ExecuteShort();
+        printf("QGEMM U8U8=uint8_t packed tests.\n");
+        onnxruntime::make_unique<MlasQgemmU8X8Test<uint8_t, uint8_t, true>>()->ExecuteShort();
+    }
+#endif
+
+    printf("QGEMM per-column zero point tests.\n");
+    onnxruntime::make_unique<MlasQgemmPerColumnTest<uint8_t, int8_t, false>>()->ExecuteShort();
+    onnxruntime::make_unique<MlasQgemmPerColumnTest<uint8_t, uint8_t, false>>()->ExecuteShort();
+    onnxruntime::make_unique<MlasQgemmPerColumnTest<int8_t, int8_t, false>>()->ExecuteShort();
+    onnxruntime::make_unique<MlasQgemmPerColumnTest<int8_t, uint8_t, false>>()->ExecuteShort();
+
+#ifdef MLAS_SUPPORTS_PACKED_GEMM_U8X8
+    if (MlasGemmPackBSize(128, 128, true) > 0) {
+        printf("QGEMM per-column zero point packed tests.\n");
+        onnxruntime::make_unique<MlasQgemmPerColumnTest<uint8_t, int8_t, true>>()->ExecuteShort();
+        onnxruntime::make_unique<MlasQgemmPerColumnTest<int8_t, int8_t, true>>()->ExecuteShort();
+    }
+    if (MlasGemmPackBSize(128, 128, false) > 0) {
+        onnxruntime::make_unique<MlasQgemmPerColumnTest<uint8_t, uint8_t, true>>()->ExecuteShort();
+        onnxruntime::make_unique<MlasQgemmPerColumnTest<int8_t, uint8_t, true>>()->ExecuteShort();
     }
 #endif
 
     printf("Conv2D tests.\n");
     onnxruntime::make_unique<MlasConv2DTest>()->ExecuteShort();
+    onnxruntime::make_unique<MlasWinogradConv2DTest>()->ExecuteShort();
     if (MlasNchwcGetBlockSize() > 1) {
         onnxruntime::make_unique<MlasNchwcConv2DTest>()->ExecuteShort();
     }
@@ -3132,6 +4706,12 @@ main(
     printf("MinMaxElements tests.\n");
     onnxruntime::make_unique<MlasFindMinMaxElementsTest>()->ExecuteShort();
 
+    printf("Reduce tests.\n");
+    onnxruntime::make_unique<MlasReduceTest>()->ExecuteShort();
+
+    printf("LayerNorm tests.\n");
+    onnxruntime::make_unique<MlasLayerNormTest>()->ExecuteShort();
+
     printf("ReorderOutput tests.\n");
     if (MlasNchwcGetBlockSize() > 1) {
         onnxruntime::make_unique<MlasReorderOutputTest>()->ExecuteShort();
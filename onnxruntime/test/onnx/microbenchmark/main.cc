@@ -74,6 +74,7 @@ BENCHMARK(BM_ResolveGraph);
     }                                                        \
   } while (0);
 
+// results can be saved for comparison across versions with --benchmark_out=<file> --benchmark_out_format=json
 int main(int argc, char** argv) {
   ::benchmark::Initialize(&argc, argv);
   if (::benchmark::ReportUnrecognizedArguments(argc, argv))
@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/platform/threadpool.h>
+#include <core/util/thread_utils.h>
+
+#include <mlas.h>
+#include <random>
+#include <vector>
+
+using namespace onnxruntime::concurrency;
+
+// batch, channels, height and width of the input, the number of filters, the kernel size and the stride.
+// the padding keeps the output at input / stride.
+static void ResNetConvShapes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"N", "C", "H", "W", "F", "kernel", "stride"});
+  for (int64_t batch : {1, 8}) {
+    // the stem, then the 1x1 and 3x3 convolutions of the bottleneck blocks of ResNet-50
+    b->Args({batch, 3, 224, 224, 64, 7, 2});
+    b->Args({batch, 64, 56, 56, 64, 1, 1});
+    b->Args({batch, 64, 56, 56, 64, 3, 1});
+    b->Args({batch, 64, 56, 56, 256, 1, 1});
+    b->Args({batch, 128, 28, 28, 128, 3, 1});
+    b->Args({batch, 256, 14, 14, 256, 3, 1});
+    b->Args({batch, 512, 7, 7, 512, 3, 1});
+    b->Args({batch, 512, 7, 7, 2048, 1, 1});
+  }
+}
+
+static std::vector<float> RandomVector(size_t size) {
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  std::vector<float> data(size);
+  for (auto& v : data) {
+    v = dist(gen);
+  }
+  return data;
+}
+
+static void BM_MlasConv(benchmark::State& state) {
+  const int64_t batch = state.range(0);
+  const int64_t channels = state.range(1);
+  const int64_t height = state.range(2);
+  const int64_t width = state.range(3);
+  const int64_t filters = state.range(4);
+  const int64_t kernel = state.range(5);
+  const int64_t stride = state.range(6);
+
+  const int64_t input_shape[] = {height, width};
+  const int64_t kernel_shape[] = {kernel, kernel};
+  const int64_t dilation_shape[] = {1, 1};
+  const int64_t padding[] = {kernel / 2, kernel / 2, kernel / 2, kernel / 2};
+  const int64_t stride_shape[] = {stride, stride};
+  const int64_t output_shape[] = {(height + 2 * (kernel / 2) - kernel) / stride + 1,
+                                  (width + 2 * (kernel / 2) - kernel) / stride + 1};
+
+  OrtThreadPoolParams param;
+  param.allow_spinning = true;
+  auto tp = CreateThreadPool(&onnxruntime::Env::Default(), param, ThreadPoolType::INTRA_OP);
+
+  MLAS_ACTIVATION activation;
+  activation.ActivationKind = MlasIdentityActivation;
+  MLAS_CONV_PARAMETERS parameters;
+  size_t working_buffer_size;
+  MlasConvPrepare(&parameters, 2, static_cast<size_t>(batch), 1, static_cast<size_t>(channels), input_shape,
+                  kernel_shape, dilation_shape, padding, stride_shape, output_shape, static_cast<size_t>(filters),
+                  &activation, &working_buffer_size, tp.get());
+
+  auto input = RandomVector(static_cast<size_t>(batch * channels * height * width));
+  auto filter = RandomVector(static_cast<size_t>(filters * channels * kernel * kernel));
+  auto bias = RandomVector(static_cast<size_t>(filters));
+  std::vector<float> working_buffer(working_buffer_size);
+  std::vector<float> output(static_cast<size_t>(batch * filters * output_shape[0] * output_shape[1]));
+
+  for (auto _ : state) {
+    MlasConv(&parameters, input.data(), filter.data(), bias.data(), working_buffer.data(), output.data(), tp.get());
+  }
+
+  const double flops = 2.0 * batch * filters * output_shape[0] * output_shape[1] * channels * kernel * kernel;
+  state.counters["FLOPS"] = benchmark::Counter(flops, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_MlasConv)->Apply(ResNetConvShapes)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond);
+
+// the 3x3 stride 2 max pool after the ResNet stem, and the global average pool before the classifier
+static void BM_MlasResNetPool(benchmark::State& state) {
+  const int64_t batch = state.range(0);
+  const bool is_global = state.range(1) != 0;
+
+  const int64_t input_shape[] = {batch, is_global ? 2048 : 64, is_global ? 7 : 112, is_global ? 7 : 112};
+  const int64_t kernel_shape[] = {is_global ? 7 : 3, is_global ? 7 : 3};
+  const int64_t padding[] = {0, 0, is_global ? 0 : 1, is_global ? 0 : 1};
+  const int64_t stride_shape[] = {is_global ? 1 : 2, is_global ? 1 : 2};
+  const int64_t output_shape[] = {batch, input_shape[1], is_global ? 1 : 56, is_global ? 1 : 56};
+
+  OrtThreadPoolParams param;
+  param.allow_spinning = true;
+  auto tp = CreateThreadPool(&onnxruntime::Env::Default(), param, ThreadPoolType::INTRA_OP);
+
+  auto input = RandomVector(static_cast<size_t>(input_shape[0] * input_shape[1] * input_shape[2] * input_shape[3]));
+  std::vector<float> output(static_cast<size_t>(output_shape[0] * output_shape[1] * output_shape[2] *
+                                                output_shape[3]));
+
+  for (auto _ : state) {
+    MlasPool(is_global ? MlasAveragePoolingExcludePad : MlasMaximumPooling, 2, input_shape, kernel_shape, padding,
+             stride_shape, output_shape, input.data(), output.data(), tp.get());
+  }
+}
+BENCHMARK(BM_MlasResNetPool)
+    ->ArgNames({"N", "global"})
+    ->Args({1, 0})
+    ->Args({8, 0})
+    ->Args({1, 1})
+    ->Args({8, 1})
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond);
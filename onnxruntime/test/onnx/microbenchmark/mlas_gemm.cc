@@ -0,0 +1,183 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/platform/threadpool.h>
+#include <core/util/thread_utils.h>
+
+#include <mlas.h>
+#include <random>
+#include <vector>
+
+using namespace onnxruntime::concurrency;
+
+// M, N and K of the matrix multiplies that dominate some common models.
+static void GemmShapes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"M", "N", "K"});
+  // BERT base, sequence length 128: the fused QKV projection, the attention output and the two FFN layers
+  b->Args({128, 2304, 768});
+  b->Args({128, 768, 768});
+  b->Args({128, 3072, 768});
+  b->Args({128, 768, 3072});
+  // GPT-2 small, decoding one token: the same layers with M = 1, and the LM head
+  b->Args({1, 2304, 768});
+  b->Args({1, 3072, 768});
+  b->Args({1, 768, 3072});
+  b->Args({1, 50257, 768});
+  // ResNet-50 convolutions after im2col: filters x output pixels x (channels * kernel size)
+  b->Args({64, 3136, 576});
+  b->Args({256, 3136, 64});
+  b->Args({128, 784, 1152});
+  b->Args({512, 49, 4608});
+}
+
+static std::unique_ptr<ThreadPool> CreateGemmThreadPool() {
+  OrtThreadPoolParams param;
+  param.allow_spinning = true;
+  return CreateThreadPool(&onnxruntime::Env::Default(), param, ThreadPoolType::INTRA_OP);
+}
+
+template <typename T>
+static std::vector<T> RandomMatrix(size_t size, float low, float high) {
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<float> dist(low, high);
+  std::vector<T> data(size);
+  for (auto& v : data) {
+    v = static_cast<T>(dist(gen));
+  }
+  return data;
+}
+
+static void SetFlops(benchmark::State& state, size_t M, size_t N, size_t K) {
+  state.counters["FLOPS"] = benchmark::Counter(2.0 * M * N * K, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+static void BM_SGemm(benchmark::State& state) {
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  auto tp = CreateGemmThreadPool();
+  auto A = RandomMatrix<float>(M * K, -1.0f, 1.0f);
+  auto B = RandomMatrix<float>(K * N, -1.0f, 1.0f);
+  std::vector<float> C(M * N);
+
+  for (auto _ : state) {
+    MlasGemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A.data(), K, B.data(), N, 0.0f, C.data(), N, tp.get());
+  }
+  SetFlops(state, M, N, K);
+}
+BENCHMARK(BM_SGemm)->Apply(GemmShapes)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond);
+
+static void BM_SGemmPackedB(benchmark::State& state) {
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  auto tp = CreateGemmThreadPool();
+  auto A = RandomMatrix<float>(M * K, -1.0f, 1.0f);
+  auto B = RandomMatrix<float>(K * N, -1.0f, 1.0f);
+  std::vector<float> C(M * N);
+
+  std::vector<uint8_t> packed_b(MlasGemmPackBSize(N, K));
+  MlasGemmPackB(CblasNoTrans, N, K, B.data(), N, packed_b.data());
+
+  for (auto _ : state) {
+    MlasGemm(CblasNoTrans, M, N, K, 1.0f, A.data(), K, packed_b.data(), 0.0f, C.data(), N, tp.get());
+  }
+  SetFlops(state, M, N, K);
+}
+BENCHMARK(BM_SGemmPackedB)->Apply(GemmShapes)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond);
+
+static void BM_DGemm(benchmark::State& state) {
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  auto tp = CreateGemmThreadPool();
+  auto A = RandomMatrix<double>(M * K, -1.0f, 1.0f);
+  auto B = RandomMatrix<double>(K * N, -1.0f, 1.0f);
+  std::vector<double> C(M * N);
+
+  for (auto _ : state) {
+    MlasGemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0, A.data(), K, B.data(), N, 0.0, C.data(), N, tp.get());
+  }
+  SetFlops(state, M, N, K);
+}
+BENCHMARK(BM_DGemm)->Apply(GemmShapes)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond);
+
+// the values of the 16 bit matrices are not significant for the timing, as long as they are normal numbers
+template <typename T>
+static std::vector<T> Matrix16(size_t size, uint16_t base) {
+  std::vector<T> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i].val = static_cast<uint16_t>(base + (i % 64));
+  }
+  return data;
+}
+
+// 1.0 in half precision and bfloat16
+template <typename T>
+static constexpr uint16_t One16();
+template <>
+constexpr uint16_t One16<MLAS_FP16>() { return 0x3C00; }
+template <>
+constexpr uint16_t One16<MLAS_BF16>() { return 0x3F80; }
+
+template <typename T, bool PackB>
+static void BM_Gemm16(benchmark::State& state) {
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  auto tp = CreateGemmThreadPool();
+  auto A = Matrix16<T>(M * K, One16<T>());
+  auto B = Matrix16<T>(K * N, One16<T>());
+  std::vector<T> C(M * N);
+
+  std::vector<uint8_t> packed_b;
+  if (PackB) {
+    packed_b.resize(MlasGemmPackBSize(N, K));
+    MlasGemmPackB(CblasNoTrans, N, K, B.data(), N, packed_b.data());
+  }
+
+  for (auto _ : state) {
+    if (PackB) {
+      MlasGemm(CblasNoTrans, M, N, K, 1.0f, A.data(), K, packed_b.data(), C.data(), N, tp.get());
+    } else {
+      MlasGemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A.data(), K, B.data(), N, C.data(), N, tp.get());
+    }
+  }
+  SetFlops(state, M, N, K);
+}
+BENCHMARK_TEMPLATE(BM_Gemm16, MLAS_FP16, false)->Apply(GemmShapes)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Gemm16, MLAS_FP16, true)->Apply(GemmShapes)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Gemm16, MLAS_BF16, false)->Apply(GemmShapes)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_Gemm16, MLAS_BF16, true)->Apply(GemmShapes)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond);
+
+template <bool BIsSigned, bool PackB>
+static void BM_QGemm(benchmark::State& state) {
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  const size_t K = static_cast<size_t>(state.range(2));
+  auto tp = CreateGemmThreadPool();
+  auto A = RandomMatrix<uint8_t>(M * K, 0.0f, 255.0f);
+  auto B = RandomMatrix<uint8_t>(K * N, 0.0f, 255.0f);
+  std::vector<int32_t> C(M * N);
+  const uint8_t offb = BIsSigned ? 0 : 128;
+
+  std::vector<uint8_t> packed_b;
+  if (PackB) {
+    packed_b.resize(MlasGemmPackBSize(N, K, BIsSigned));
+    MlasGemmPackB(N, K, B.data(), N, BIsSigned, packed_b.data());
+  }
+
+  for (auto _ : state) {
+    if (PackB) {
+      MlasGemm(M, N, K, A.data(), K, 128, packed_b.data(), offb, BIsSigned, C.data(), N, tp.get());
+    } else {
+      MlasGemm(M, N, K, A.data(), K, 128, B.data(), N, offb, BIsSigned, C.data(), N, tp.get());
+    }
+  }
+  SetFlops(state, M, N, K);
+}
+BENCHMARK_TEMPLATE(BM_QGemm, false, false)->Apply(GemmShapes)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_QGemm, false, true)->Apply(GemmShapes)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_QGemm, true, false)->Apply(GemmShapes)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_QGemm, true, true)->Apply(GemmShapes)->UseRealTime()->Unit(benchmark::TimeUnit::kMicrosecond);
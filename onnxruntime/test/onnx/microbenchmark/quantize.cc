@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <mlas.h>
+#include <random>
+#include <vector>
+
+// the activations of BERT base at sequence length 128 (hidden and FFN intermediate), and of one GPT-2 token
+static void QuantizeShapes(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"M", "N"});
+  b->Args({128, 768});
+  b->Args({128, 3072});
+  b->Args({1, 768});
+  b->Args({1, 3072});
+}
+
+template <typename OutputType>
+static void BM_QuantizeLinear(benchmark::State& state) {
+  const size_t size = static_cast<size_t>(state.range(0) * state.range(1));
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<float> dist(-10.0f, 10.0f);
+  std::vector<float> input(size);
+  for (auto& v : input) {
+    v = dist(gen);
+  }
+  std::vector<OutputType> output(size);
+
+  for (auto _ : state) {
+    MlasQuantizeLinear(input.data(), output.data(), size, 0.08f, static_cast<OutputType>(1));
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK_TEMPLATE(BM_QuantizeLinear, uint8_t)->Apply(QuantizeShapes);
+BENCHMARK_TEMPLATE(BM_QuantizeLinear, int8_t)->Apply(QuantizeShapes);
+
+template <bool PerColumnScale>
+static void BM_RequantizeOutput(benchmark::State& state) {
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+  std::mt19937 gen(1234);
+  std::uniform_int_distribution<int32_t> dist(-100000, 100000);
+  std::vector<int32_t> input(M * N);
+  for (auto& v : input) {
+    v = dist(gen);
+  }
+  std::vector<int32_t> bias(N, 100);
+  std::vector<float> scale(PerColumnScale ? N : 1, 0.001f);
+  std::vector<uint8_t> output(M * N);
+
+  for (auto _ : state) {
+    MlasRequantizeOutput(input.data(), output.data(), bias.data(), M, N, scale.data(), PerColumnScale, 128);
+  }
+  state.SetItemsProcessed(state.iterations() * M * N);
+}
+BENCHMARK_TEMPLATE(BM_RequantizeOutput, false)->Apply(QuantizeShapes);
+BENCHMARK_TEMPLATE(BM_RequantizeOutput, true)->Apply(QuantizeShapes);
@@ -0,0 +1,102 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/onnx_protobuf.h>
+#include <core/session/onnxruntime_c_api.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+// a chain of num_nodes Relu nodes on a tensor of 16 floats, so a run is dominated by the per node cost of the
+// executor: kernel lookup, input/output fetching, allocation and release.
+static std::string CreateReluChainModel(int64_t num_nodes) {
+  ONNX_NAMESPACE::ModelProto model;
+  model.set_ir_version(ONNX_NAMESPACE::IR_VERSION);
+  model.add_opset_import()->set_version(12);
+  auto* graph = model.mutable_graph();
+  graph->set_name("relu_chain");
+
+  auto add_value_info = [](ONNX_NAMESPACE::ValueInfoProto* value_info, const std::string& name) {
+    value_info->set_name(name);
+    auto* tensor_type = value_info->mutable_type()->mutable_tensor_type();
+    tensor_type->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    tensor_type->mutable_shape()->add_dim()->set_dim_value(1);
+    tensor_type->mutable_shape()->add_dim()->set_dim_value(16);
+  };
+  add_value_info(graph->add_input(), "X");
+  add_value_info(graph->add_output(), "Y");
+
+  for (int64_t i = 0; i < num_nodes; ++i) {
+    auto* node = graph->add_node();
+    node->set_op_type("Relu");
+    node->set_name("relu_" + std::to_string(i));
+    node->add_input(i == 0 ? "X" : "T" + std::to_string(i - 1));
+    node->add_output(i == num_nodes - 1 ? "Y" : "T" + std::to_string(i));
+  }
+
+  return model.SerializeAsString();
+}
+
+#define ORT_SKIP_ON_ERROR(expr)                                 \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+      return;                                                   \
+    }                                                           \
+  } while (0);
+
+static void BM_SequentialExecutorPerNode(benchmark::State& state) {
+  const int64_t num_nodes = state.range(0);
+  const std::string model_data = CreateReluChainModel(num_nodes);
+
+  OrtSessionOptions* session_options;
+  ORT_SKIP_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+  std::unique_ptr<OrtSessionOptions, decltype(g_ort->ReleaseSessionOptions)> session_options_holder(
+      session_options, g_ort->ReleaseSessionOptions);
+  // keep the chain as it is, and the kernels to the calling thread
+  ORT_SKIP_ON_ERROR(g_ort->SetSessionGraphOptimizationLevel(session_options, ORT_DISABLE_ALL));
+  ORT_SKIP_ON_ERROR(g_ort->SetIntraOpNumThreads(session_options, 1));
+
+  OrtSession* session;
+  ORT_SKIP_ON_ERROR(g_ort->CreateSessionFromArray(env, model_data.data(), model_data.size(), session_options,
+                                                  &session));
+  std::unique_ptr<OrtSession, decltype(g_ort->ReleaseSession)> session_holder(session, g_ort->ReleaseSession);
+
+  OrtMemoryInfo* memory_info;
+  ORT_SKIP_ON_ERROR(g_ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
+  std::unique_ptr<OrtMemoryInfo, decltype(g_ort->ReleaseMemoryInfo)> memory_info_holder(memory_info,
+                                                                                         g_ort->ReleaseMemoryInfo);
+
+  std::vector<float> input_data(16, 1.0f);
+  const int64_t shape[] = {1, 16};
+  OrtValue* input;
+  ORT_SKIP_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(memory_info, input_data.data(),
+                                                          input_data.size() * sizeof(float), shape, 2,
+                                                          ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &input));
+  std::unique_ptr<OrtValue, decltype(g_ort->ReleaseValue)> input_holder(input, g_ort->ReleaseValue);
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  for (auto _ : state) {
+    OrtValue* output = nullptr;
+    ORT_SKIP_ON_ERROR(g_ort->Run(session, nullptr, input_names, &input, 1, output_names, 1, &output));
+    g_ort->ReleaseValue(output);
+  }
+
+  // items are nodes, so the rate is the number of nodes executed per second
+  state.SetItemsProcessed(state.iterations() * num_nodes);
+}
+BENCHMARK(BM_SequentialExecutorPerNode)
+    ->ArgNames({"nodes"})
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(100)
+    ->Arg(1000)
+    ->Unit(benchmark::TimeUnit::kMicrosecond);
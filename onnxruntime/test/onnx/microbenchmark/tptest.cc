@@ -4,6 +4,8 @@
 #include <core/session/onnxruntime_c_api.h>
 #include <core/platform/Barrier.h>
 
+#include <chrono>
+
 #ifdef _WIN32
 #include <Windows.h>
 #endif
@@ -188,6 +190,32 @@ BENCHMARK(BM_SimpleScheduleWait)
     ->Arg(80000)
     ->Arg(160000);
 
+// Measures the time from ThreadPool::Schedule on a thread outside the pool until the task starts on a worker.
+// range(0) selects whether the workers spin (1) or block (0) while idle.
+static void BM_ScheduleToStartLatency(benchmark::State& state) {
+  const bool allow_spinning = state.range(0) != 0;
+  auto tp = onnxruntime::make_unique<ThreadPool>(&onnxruntime::Env::Default(),
+                                                 onnxruntime::ThreadOptions(),
+                                                 nullptr,
+                                                 NUM_THREADS, allow_spinning);
+  for (auto _ : state) {
+    std::chrono::steady_clock::time_point start_time;
+    onnxruntime::Barrier barrier(1);
+    const auto schedule_time = std::chrono::steady_clock::now();
+    ThreadPool::Schedule(tp.get(), [&]() {
+      start_time = std::chrono::steady_clock::now();
+      barrier.Notify();
+    });
+    barrier.Wait();
+    state.SetIterationTime(std::chrono::duration<double>(start_time - schedule_time).count());
+  }
+}
+BENCHMARK(BM_ScheduleToStartLatency)
+    ->UseManualTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->Arg(0)
+    ->Arg(1);
+
 #ifdef _WIN32
 struct Param {
   std::atomic<int> id = 0;
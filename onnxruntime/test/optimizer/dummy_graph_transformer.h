@@ -10,14 +10,19 @@ namespace test {
 // Dummy graph transformer that does nothing, but just sets the modified value
 class DummyGraphTransformer : public GraphTransformer {
  public:
-  DummyGraphTransformer(const std::string& name) noexcept : GraphTransformer(name),
-                                                            transformer_invoked_(false) {}
+  DummyGraphTransformer(const std::string& name, const std::vector<std::string>& target_op_types = {})
+      : GraphTransformer(name), target_op_types_(target_op_types), transformer_invoked_(false) {}
 
   bool IsTransformerInvoked() const {
     return transformer_invoked_;
   }
 
+  std::vector<std::string> TargetOpTypes() const override {
+    return target_op_types_;
+  }
+
  private:
+  const std::vector<std::string> target_op_types_;
   mutable bool transformer_invoked_;
 
   Status ApplyImpl(Graph& /*graph*/, bool& /*modified*/, int /*graph_level*/, const logging::Logger&) const override {
@@ -27,6 +27,7 @@
 #include "core/optimizer/conv_mul_fusion.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_chain_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
@@ -45,6 +46,7 @@
 #include "core/optimizer/relu_clip_fusion.h"
 #include "core/optimizer/reshape_fusion.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
+#include "core/optimizer/scaler_fusion.h"
 #include "core/optimizer/shape_to_initializer.h"
 #include "core/optimizer/skip_layer_norm_fusion.h"
 #include "core/optimizer/slice_elimination.h"
@@ -303,6 +305,123 @@ TEST_F(GraphTransformationTests, ConstantFoldingWithScalarShapeToInitializer) {
   ASSERT_TRUE(op_to_count["Add"] == 1);
 }
 
+// Build a graph with an Expand of a scalar to a [64, 64] tensor that is added to the input.
+static void BuildExpandGraph(Graph& graph) {
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(64);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(64);
+
+  TensorProto value;
+  value.set_name("value");
+  value.set_data_type(TensorProto_DataType_FLOAT);
+  value.add_float_data(1.f);
+  graph.AddInitializedTensor(value);
+
+  TensorProto shape;
+  shape.set_name("shape");
+  shape.set_data_type(TensorProto_DataType_INT64);
+  shape.add_dims(2);
+  shape.add_int64_data(64);
+  shape.add_int64_data(64);
+  graph.AddInitializedTensor(shape);
+
+  auto& input = graph.GetOrCreateNodeArg("input", &tensor_type);
+  auto& expanded = graph.GetOrCreateNodeArg("expanded", nullptr);
+  auto& output = graph.GetOrCreateNodeArg("output", &tensor_type);
+  graph.AddNode("expand", "Expand", "", {graph.GetNodeArg("value"), graph.GetNodeArg("shape")}, {&expanded});
+  graph.AddNode("add", "Add", "", {&input, &expanded}, {&output});
+}
+
+TEST_F(GraphTransformationTests, ConstantFoldingMaxOutputSize) {
+  std::unique_ptr<CPUExecutionProvider> e =
+      onnxruntime::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+
+  // the [64, 64] float output is 16KB
+  for (size_t max_output_size : {size_t{0}, size_t{16384}, size_t{16383}}) {
+    Model model("ConstantFoldingMaxOutputSize", false, *logger_);
+    auto& graph = model.MainGraph();
+    BuildExpandGraph(graph);
+    ASSERT_STATUS_OK(graph.Resolve());
+
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+    graph_transformation_mgr.Register(
+        onnxruntime::make_unique<ConstantFolding>(*e.get(), std::unordered_set<std::string>{},
+                                                  std::unordered_set<std::string>{}, max_output_size),
+        TransformerLevel::Level1);
+    ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+    std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_to_count["Expand"], max_output_size == 16383 ? 1 : 0) << max_output_size;
+    EXPECT_EQ(op_to_count["Add"], 1);
+  }
+}
+
+TEST_F(GraphTransformationTests, ConstantFoldingDeduplicatesFoldedValues) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 12;
+  Model model("ConstantFoldingDeduplicatesFoldedValues", false, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+              *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+
+  TensorProto value;
+  value.set_name("value");
+  value.set_data_type(TensorProto_DataType_FLOAT);
+  value.add_dims(4);
+  for (int i = 0; i < 4; ++i) {
+    value.add_float_data(static_cast<float>(i));
+  }
+  graph.AddInitializedTensor(value);
+
+  TensorProto shape;
+  shape.set_name("shape");
+  shape.set_data_type(TensorProto_DataType_INT64);
+  shape.add_dims(2);
+  shape.add_int64_data(1);
+  shape.add_int64_data(4);
+  graph.AddInitializedTensor(shape);
+
+  // Unsqueeze and Reshape compute the same [1, 4] value, which is added to the input twice
+  auto& input = graph.GetOrCreateNodeArg("input", &tensor_type);
+  auto& unsqueezed = graph.GetOrCreateNodeArg("unsqueezed", nullptr);
+  auto& reshaped = graph.GetOrCreateNodeArg("reshaped", nullptr);
+  auto& output1 = graph.GetOrCreateNodeArg("output1", &tensor_type);
+  auto& output2 = graph.GetOrCreateNodeArg("output2", &tensor_type);
+  graph.AddNode("unsqueeze", "Unsqueeze", "", {graph.GetNodeArg("value")}, {&unsqueezed})
+      .AddAttribute("axes", std::vector<int64_t>{0});
+  graph.AddNode("reshape", "Reshape", "", {graph.GetNodeArg("value"), graph.GetNodeArg("shape")}, {&reshaped});
+  graph.AddNode("add1", "Add", "", {&input, &unsqueezed}, {&output1});
+  graph.AddNode("add2", "Add", "", {&input, &reshaped}, {&output2});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::unique_ptr<CPUExecutionProvider> e =
+      onnxruntime::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<ConstantFolding>(*e.get()), TransformerLevel::Level1);
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["Unsqueeze"], 0);
+  ASSERT_EQ(op_to_count["Reshape"], 0);
+  ASSERT_EQ(op_to_count["Add"], 2);
+
+  // both Add nodes use the initializer created for the first folded value
+  std::vector<std::string> add_inputs;
+  for (const auto& node : graph.Nodes()) {
+    add_inputs.push_back(node.InputDefs()[1]->Name());
+  }
+
+  ASSERT_EQ(add_inputs.size(), 2u);
+  EXPECT_EQ(add_inputs[0], add_inputs[1]);
+  EXPECT_TRUE(graph_utils::IsConstantInitializer(graph, add_inputs[0]));
+}
+
 TEST_F(GraphTransformationTests, ShapeToInitializer) {
   auto model_uri = MODEL_FOLDER "shape-add.onnx";
   std::shared_ptr<Model> model;
@@ -2161,6 +2280,284 @@ TEST_F(GraphTransformationTests, BiasGeluTest) {
   ASSERT_TRUE(op_to_count["com.microsoft.BiasGelu"] == 1);
 }
 
+TEST_F(GraphTransformationTests, ElementwiseChainFusion) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 12;
+  Model model("ElementwiseChainFusion", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(), *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(8);
+
+  TensorProto half_proto;
+  Initializer half(TensorProto_DataType_FLOAT, "half", {});
+  *half.data<float>() = 0.5f;
+  half.ToProto(half_proto);
+  graph.AddInitializedTensor(half_proto);
+
+  TensorProto one_proto;
+  Initializer one(TensorProto_DataType_FLOAT, "one", {1});
+  *one.data<float>() = 1.0f;
+  one.ToProto(one_proto);
+  graph.AddInitializedTensor(one_proto);
+
+  // a hot chain Mul -> Tanh -> Sub -> Relu and a cold chain Sigmoid -> Neg
+  auto& input = graph.GetOrCreateNodeArg("input", &tensor_type);
+  auto& mul_out = graph.GetOrCreateNodeArg("mul_out", &tensor_type);
+  auto& tanh_out = graph.GetOrCreateNodeArg("tanh_out", &tensor_type);
+  auto& sub_out = graph.GetOrCreateNodeArg("sub_out", &tensor_type);
+  auto& relu_out = graph.GetOrCreateNodeArg("relu_out", &tensor_type);
+  auto& sigmoid_out = graph.GetOrCreateNodeArg("sigmoid_out", &tensor_type);
+  auto& neg_out = graph.GetOrCreateNodeArg("neg_out", &tensor_type);
+
+  graph.AddNode("mul", "Mul", "", {&input, graph.GetNodeArg("half")}, {&mul_out});
+  graph.AddNode("tanh", "Tanh", "", {&mul_out}, {&tanh_out});
+  graph.AddNode("sub", "Sub", "", {graph.GetNodeArg("one"), &tanh_out}, {&sub_out});
+  graph.AddNode("relu", "Relu", "", {&sub_out}, {&relu_out});
+  graph.AddNode("sigmoid", "Sigmoid", "", {&input}, {&sigmoid_out});
+  graph.AddNode("neg", "Neg", "", {&sigmoid_out}, {&neg_out});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  for (auto& node : graph.Nodes()) {
+    node.SetExecutionProviderType(kCpuExecutionProvider);
+  }
+
+  std::unordered_map<std::string, int64_t> node_kernel_times = {
+      {"mul", 100}, {"tanh", 100}, {"sub", 100}, {"relu", 100}, {"sigmoid", 1}, {"neg", 1}, {"matmul", 1000}};
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(
+      onnxruntime::make_unique<ElementwiseChainFusion>(std::move(node_kernel_times), 10.0), TransformerLevel::Level2);
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["Mul"], 0);
+  ASSERT_EQ(op_to_count["Tanh"], 0);
+  ASSERT_EQ(op_to_count["Sub"], 0);
+  ASSERT_EQ(op_to_count["Relu"], 0);
+  ASSERT_EQ(op_to_count["Sigmoid"], 1);
+  ASSERT_EQ(op_to_count["Neg"], 1);
+  ASSERT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+
+  for (auto& node : graph.Nodes()) {
+    if (node.OpType() == "FusedElementwise") {
+      ASSERT_EQ(node.InputDefs()[0]->Name(), "input");
+      ASSERT_EQ(node.OutputDefs()[0]->Name(), "relu_out");
+
+      const auto* ops = graph_utils::GetNodeAttribute(node, "ops");
+      ASSERT_EQ(ops->strings_size(), 4);
+      EXPECT_EQ(ops->strings(0), "Mul");
+      EXPECT_EQ(ops->strings(1), "Tanh");
+      EXPECT_EQ(ops->strings(2), "Sub");
+      EXPECT_EQ(ops->strings(3), "Relu");
+
+      const auto* scalars = graph_utils::GetNodeAttribute(node, "scalars");
+      EXPECT_EQ(scalars->floats(0), 0.5f);
+      EXPECT_EQ(scalars->floats(2), 1.0f);
+
+      const auto* operand_first = graph_utils::GetNodeAttribute(node, "operand_first");
+      EXPECT_EQ(operand_first->ints(0), 0);
+      EXPECT_EQ(operand_first->ints(2), 1);
+    }
+  }
+}
+
+TEST_F(GraphTransformationTests, ElementwiseChainFusionTensorOperands) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 12;
+  Model model("ElementwiseChainFusionTensorOperands", false, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+              *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(8);
+
+  TypeProto bias_type;
+  bias_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  bias_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(8);
+
+  TypeProto other_type;
+  other_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  other_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  other_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(8);
+
+  // SiLU of input + bias followed by a Mul with a second input, then a Sub with a tensor of another shape
+  auto& input = graph.GetOrCreateNodeArg("input", &tensor_type);
+  auto& bias = graph.GetOrCreateNodeArg("bias", &bias_type);
+  auto& scale = graph.GetOrCreateNodeArg("scale", &tensor_type);
+  auto& other = graph.GetOrCreateNodeArg("other", &other_type);
+  auto& add_out = graph.GetOrCreateNodeArg("add_out", &tensor_type);
+  auto& sigmoid_out = graph.GetOrCreateNodeArg("sigmoid_out", &tensor_type);
+  auto& silu_out = graph.GetOrCreateNodeArg("silu_out", &tensor_type);
+  auto& mul_out = graph.GetOrCreateNodeArg("mul_out", &tensor_type);
+  auto& sub_out = graph.GetOrCreateNodeArg("sub_out", &tensor_type);
+
+  graph.AddNode("add", "Add", "", {&input, &bias}, {&add_out});
+  graph.AddNode("sigmoid", "Sigmoid", "", {&add_out}, {&sigmoid_out});
+  graph.AddNode("silu", "Mul", "", {&add_out, &sigmoid_out}, {&silu_out});
+  graph.AddNode("mul", "Mul", "", {&scale, &silu_out}, {&mul_out});
+  graph.AddNode("sub", "Sub", "", {&mul_out, &other}, {&sub_out});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  for (auto& node : graph.Nodes()) {
+    node.SetExecutionProviderType(kCpuExecutionProvider);
+  }
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<ElementwiseChainFusion>(), TransformerLevel::Level2);
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["Add"], 0);
+  ASSERT_EQ(op_to_count["Sigmoid"], 0);
+  ASSERT_EQ(op_to_count["Mul"], 0);
+  ASSERT_EQ(op_to_count["Sub"], 1);
+  ASSERT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+
+  for (auto& node : graph.Nodes()) {
+    if (node.OpType() == "FusedElementwise") {
+      ASSERT_EQ(node.InputDefs().size(), 3u);
+      EXPECT_EQ(node.InputDefs()[0]->Name(), "input");
+      EXPECT_EQ(node.InputDefs()[1]->Name(), "bias");
+      EXPECT_EQ(node.InputDefs()[2]->Name(), "scale");
+      EXPECT_EQ(node.OutputDefs()[0]->Name(), "mul_out");
+
+      const auto* ops = graph_utils::GetNodeAttribute(node, "ops");
+      ASSERT_EQ(ops->strings_size(), 4);
+      EXPECT_EQ(ops->strings(0), "Add");
+      EXPECT_EQ(ops->strings(1), "Sigmoid");
+      EXPECT_EQ(ops->strings(2), "Mul");
+      EXPECT_EQ(ops->strings(3), "Mul");
+
+      // the values are input, bias, scale and then the results of the nodes
+      const auto* operands = graph_utils::GetNodeAttribute(node, "operands");
+      EXPECT_EQ(operands->ints(0), 1);
+      EXPECT_EQ(operands->ints(2), 3);
+      EXPECT_EQ(operands->ints(3), 2);
+
+      const auto* operand_first = graph_utils::GetNodeAttribute(node, "operand_first");
+      EXPECT_EQ(operand_first->ints(2), 1);
+      EXPECT_EQ(operand_first->ints(3), 1);
+    } else if (node.OpType() == "Sub") {
+      EXPECT_EQ(node.InputDefs()[0]->Name(), "mul_out");
+    }
+  }
+
+  ASSERT_STATUS_OK(graph.Resolve());
+}
+
+#if !defined(DISABLE_ML_OPS) && !defined(DISABLE_CONTRIB_OPS)
+TEST_F(GraphTransformationTests, ScalerFusion) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 12;
+  domain_to_version[kMLDomain] = 1;
+  Model model("ScalerFusion", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  // Imputer -> Scaler -> Normalizer is fused, the Scaler of the second input is left alone
+  auto& input = graph.GetOrCreateNodeArg("input", &tensor_type);
+  auto& other = graph.GetOrCreateNodeArg("other", &tensor_type);
+  auto& imputer_out = graph.GetOrCreateNodeArg("imputer_out", &tensor_type);
+  auto& scaler_out = graph.GetOrCreateNodeArg("scaler_out", &tensor_type);
+  auto& normalizer_out = graph.GetOrCreateNodeArg("normalizer_out", &tensor_type);
+  auto& other_out = graph.GetOrCreateNodeArg("other_out", &tensor_type);
+
+  auto& imputer = graph.AddNode("imputer", "Imputer", "", {&input}, {&imputer_out}, nullptr, kMLDomain);
+  imputer.AddAttribute("imputed_value_floats", std::vector<float>{1.f, 2.f, 3.f});
+  imputer.AddAttribute("replaced_value_float", -1.f);
+  auto& scaler = graph.AddNode("scaler", "Scaler", "", {&imputer_out}, {&scaler_out}, nullptr, kMLDomain);
+  scaler.AddAttribute("scale", std::vector<float>{2.f});
+  scaler.AddAttribute("offset", std::vector<float>{0.5f});
+  auto& normalizer = graph.AddNode("normalizer", "Normalizer", "", {&scaler_out}, {&normalizer_out}, nullptr,
+                                   kMLDomain);
+  normalizer.AddAttribute("norm", "L2");
+  auto& other_scaler = graph.AddNode("other_scaler", "Scaler", "", {&other}, {&other_out}, nullptr, kMLDomain);
+  other_scaler.AddAttribute("scale", std::vector<float>{3.f});
+  other_scaler.AddAttribute("offset", std::vector<float>{0.f});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  for (auto& node : graph.Nodes()) {
+    node.SetExecutionProviderType(kCpuExecutionProvider);
+  }
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<ScalerFusion>(), TransformerLevel::Level2);
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["ai.onnx.ml.Imputer"], 0);
+  ASSERT_EQ(op_to_count["ai.onnx.ml.Scaler"], 1);
+  ASSERT_EQ(op_to_count["ai.onnx.ml.Normalizer"], 0);
+  ASSERT_EQ(op_to_count["com.microsoft.FusedScaler"], 1);
+
+  for (auto& node : graph.Nodes()) {
+    if (node.OpType() == "FusedScaler") {
+      EXPECT_EQ(node.InputDefs()[0]->Name(), "input");
+      EXPECT_EQ(node.OutputDefs()[0]->Name(), "normalizer_out");
+      EXPECT_EQ(graph_utils::GetNodeAttribute(node, "imputed_values")->floats_size(), 3);
+      EXPECT_EQ(graph_utils::GetNodeAttribute(node, "replaced_value")->f(), -1.f);
+      EXPECT_EQ(graph_utils::GetNodeAttribute(node, "scale")->floats(0), 2.f);
+      EXPECT_EQ(graph_utils::GetNodeAttribute(node, "offset")->floats(0), 0.5f);
+      EXPECT_EQ(graph_utils::GetNodeAttribute(node, "norm")->s(), "L2");
+    }
+  }
+
+  ASSERT_STATUS_OK(graph.Resolve());
+}
+#endif
+
+TEST_F(GraphTransformationTests, ElementwiseChainFusionCudaChainLength) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 12;
+  Model model("ElementwiseChainFusionCudaChainLength", false, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+              *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(8);
+
+  // a chain of 20 nodes, which is longer than the CUDA FusedElementwise kernel supports
+  NodeArg* input = &graph.GetOrCreateNodeArg("input", &tensor_type);
+  for (int i = 0; i < 20; ++i) {
+    auto& output = graph.GetOrCreateNodeArg("out_" + std::to_string(i), &tensor_type);
+    graph.AddNode("node_" + std::to_string(i), i % 2 == 0 ? "Relu" : "Neg", "", {input}, {&output});
+    input = &output;
+  }
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  for (auto& node : graph.Nodes()) {
+    node.SetExecutionProviderType(kCudaExecutionProvider);
+  }
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(onnxruntime::make_unique<ElementwiseChainFusion>(), TransformerLevel::Level2);
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["Relu"], 0);
+  ASSERT_EQ(op_to_count["Neg"], 0);
+  ASSERT_EQ(op_to_count["com.microsoft.FusedElementwise"], 2);
+
+  for (auto& node : graph.Nodes()) {
+    const auto* ops = graph_utils::GetNodeAttribute(node, "ops");
+    EXPECT_EQ(ops->strings_size(), node.InputDefs()[0]->Name() == "input" ? 16 : 4);
+    EXPECT_EQ(node.GetExecutionProviderType(), kCudaExecutionProvider);
+  }
+}
+
 // BiasGelu allows input switching based on input dimensions.
 // This test validates the input edges are plugged correct in the optimized graph.
 TEST_F(GraphTransformationTests, BiasGeluSwitchedInputOrder) {
@@ -2448,7 +2845,7 @@ struct BiasSoftmaxFusionTester {
       const char* execution_provider = kCudaExecutionProvider) : logger_(logger), graph_transformation_mgr_{5} {
     model_load_ = Model::Load(model_uri, p_model_, nullptr, *logger_);
 
-    // move to cuda since fusion only takes place in that case
+    // the fusion only takes place for the providers with a BiasSoftmax kernel
     SetExecutionProvider(execution_provider);
 
     graph_transformation_mgr_.Register(
@@ -2496,9 +2893,15 @@ struct BiasSoftmaxFusionTester {
   }
 };
 
-TEST_F(GraphTransformationTests, BiasSoftmaxFusionTest_GpuOnly) {
+TEST_F(GraphTransformationTests, BiasSoftmaxFusionTest_Simple_Cpu) {
   auto model_uri = MODEL_FOLDER "fusion/bias_softmax_fusion_simple.onnx";
   BiasSoftmaxFusionTester tester(model_uri, logger_.get(), kCpuExecutionProvider);
+  tester.TestFusionOccurs(1);
+}
+
+TEST_F(GraphTransformationTests, BiasSoftmaxFusionTest_UnsupportedProvider) {
+  auto model_uri = MODEL_FOLDER "fusion/bias_softmax_fusion_simple.onnx";
+  BiasSoftmaxFusionTester tester(model_uri, logger_.get(), kDnnlExecutionProvider);
   tester.TestNoFusionOccurs();
 }
 
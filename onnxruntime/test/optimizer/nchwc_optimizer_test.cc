@@ -519,6 +519,43 @@ TEST(NchwcOptimizerTests, ConvGlobalPool) {
   }
 }
 
+TEST(NchwcOptimizerTests, ConvGlobalPoolFlatten) {
+  auto test_case = [&](const std::string& op_type, int64_t output_channels) {
+    auto build_test_case = [&](NchwcTestHelper& helper) {
+      auto* input_arg = helper.MakeInput<float>({2, 96, 7, 7});
+      auto* conv_output_arg = helper.MakeIntermediate();
+      auto* pool_output_arg = helper.MakeIntermediate();
+      auto* flatten_output_arg = helper.MakeIntermediate();
+      auto* output_arg = helper.MakeOutput();
+
+      helper.AddConvNode(input_arg, conv_output_arg, {output_channels, 96, 3, 3});
+      helper.AddNode(op_type, {conv_output_arg}, {pool_output_arg});
+      helper.AddNode("Flatten", {pool_output_arg}, {flatten_output_arg});
+
+      auto* gemm_weights_arg = helper.MakeInitializer({output_channels, 10});
+      auto* gemm_bias_arg = helper.MakeInitializer({10});
+      helper.AddNode("Gemm", {flatten_output_arg, gemm_weights_arg, gemm_bias_arg}, {output_arg});
+    };
+
+    auto check_nchwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.Conv"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc." + op_type], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderInput"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderOutput"], 0);
+      EXPECT_EQ(op_to_count["Flatten"], 1);
+    };
+
+    NchwcOptimizerTester(build_test_case, check_nchwc_graph);
+  };
+
+  // Verify that the classifier reads the pooled NCHWc tensor without a reorder.
+  std::vector<std::string> op_types{"GlobalMaxPool", "GlobalAveragePool"};
+  for (auto& op_type : op_types) {
+    test_case(op_type, 128);
+  }
+}
+
 TEST(NchwcOptimizerTests, ConvAddFusion) {
   auto test_case = [&](const std::string& op_type, int opset_version, bool do_relu) {
     auto build_test_case = [&](NchwcTestHelper& helper) {
@@ -667,7 +704,7 @@ TEST(NchwcOptimizerTests, ConvBinary) {
 
   // Verify that the optimizer keeps the inputs to the binary operator as NCHWc
   // and only reorders the output of the binary operator.
-  std::vector<std::string> op_types{"Add", "Sum", "Mul"};
+  std::vector<std::string> op_types{"Add", "Sum", "Mul", "Sub"};
   for (auto& op_type : op_types) {
     test_case(op_type);
   }
@@ -1227,12 +1264,41 @@ TEST(NchwcOptimizerTests, Activation) {
 
   // Verify that the optimizer doesn't add reorders for these activations that
   // cannot be fused with a convolution.
-  std::vector<std::string> activation_op_types{"Relu", "Sigmoid", "Tanh"};
+  std::vector<std::string> activation_op_types{"Relu", "Sigmoid", "Tanh", "LeakyRelu", "Clip", "HardSigmoid"};
   for (auto& activation_op_type : activation_op_types) {
     test_case(activation_op_type);
   }
 }
 
+TEST(NchwcOptimizerTests, ConvAddLeakyReluFusion) {
+  auto build_test_case = [&](NchwcTestHelper& helper) {
+    auto* input_arg = helper.MakeInput<float>({1, 32, 28, 28});
+    auto* conv1_output_arg = helper.MakeIntermediate();
+    auto* conv2_output_arg = helper.MakeIntermediate();
+    auto* add_output_arg = helper.MakeIntermediate();
+    auto* output_arg = helper.MakeOutput();
+
+    helper.AddConvNode(input_arg, conv1_output_arg, {32, 32, 3, 3});
+    helper.AddConvNode(input_arg, conv2_output_arg, {32, 32, 3, 3});
+    helper.AddNode("Add", {conv1_output_arg, conv2_output_arg}, {add_output_arg});
+    auto& leaky_relu_node = helper.AddNode("LeakyRelu", {add_output_arg}, {output_arg});
+    leaky_relu_node.AddAttribute("alpha", 0.2f);
+  };
+
+  auto check_nchwc_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.nchwc.Conv"], 2);
+    EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderInput"], 1);
+    EXPECT_EQ(op_to_count["com.microsoft.nchwc.ReorderOutput"], 1);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["LeakyRelu"], 0);
+  };
+
+  // Verify that the LeakyRelu is fused into the NCHWc Conv node after the
+  // Conv/Add fusion, including the alpha parameter.
+  NchwcOptimizerTester(build_test_case, check_nchwc_graph);
+}
+
 TEST(NchwcOptimizerTests, MaxPoolTypeCheck) {
   auto build_test_case = [&](NchwcTestHelper& helper) {
     auto add_pool_node = [&](NchwcTestHelper& helper, NodeArg* input_arg) {
@@ -0,0 +1,360 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <numeric>
+#include <random>
+#include "core/graph/model.h"
+#include "core/graph/onnx_protobuf.h"
+#include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/compare_ortvalue.h"
+#include "test/test_environment.h"
+#include "test/framework/test_utils.h"
+#include "test/util/include/inference_session_wrapper.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+struct QDQTestHelper {
+  QDQTestHelper(Graph& graph) : graph_(graph) {
+  }
+
+  template <typename T>
+  NodeArg* MakeInput(const std::vector<int64_t>& shape) {
+    ONNX_NAMESPACE::TypeProto type_proto;
+    type_proto.mutable_tensor_type()->set_elem_type(utils::ToTensorProtoElementType<T>());
+    for (auto& dim : shape) {
+      type_proto.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+
+    OrtValue input_value;
+    CreateMLValue<T>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), shape,
+                     FillRandomData<T>(shape, 0, 31), &input_value);
+    std::string name = graph_.GenerateNodeArgName("input");
+    feeds_.insert(std::make_pair(name, input_value));
+
+    return &graph_.GetOrCreateNodeArg(name, &type_proto);
+  }
+
+  NodeArg* MakeOutput() {
+    std::string name = graph_.GenerateNodeArgName("output");
+    output_names_.push_back(name);
+    return &graph_.GetOrCreateNodeArg(name, nullptr);
+  }
+
+  NodeArg* MakeIntermediate() {
+    std::string name = graph_.GenerateNodeArgName("node");
+    return &graph_.GetOrCreateNodeArg(name, nullptr);
+  }
+
+  template <typename T>
+  NodeArg* MakeInitializer(const std::vector<int64_t>& shape, const std::vector<T>& data) {
+    std::string name = graph_.GenerateNodeArgName("constant");
+    ONNX_NAMESPACE::TensorProto tensor_proto;
+    tensor_proto.set_name(name);
+    tensor_proto.set_data_type(utils::ToTensorProtoElementType<T>());
+    tensor_proto.set_raw_data(data.data(), data.size() * sizeof(T));
+
+    for (auto& dim : shape) {
+      tensor_proto.add_dims(dim);
+    }
+
+    graph_.AddInitializedTensor(tensor_proto);
+
+    return &graph_.GetOrCreateNodeArg(name, nullptr);
+  }
+
+  template <typename T>
+  NodeArg* MakeInitializer(const std::vector<int64_t>& shape, int32_t min_value, int32_t max_value) {
+    return MakeInitializer<T>(shape, FillRandomData<T>(shape, min_value, max_value));
+  }
+
+  template <typename T>
+  NodeArg* MakeScalarInitializer(T data) {
+    return MakeInitializer({}, std::vector<T>{data});
+  }
+
+  Node& AddNode(const std::string& op_type,
+                const std::vector<NodeArg*>& input_args,
+                const std::vector<NodeArg*>& output_args) {
+    return graph_.AddNode(graph_.GenerateNodeName("node"),
+                          op_type,
+                          "description",
+                          input_args,
+                          output_args);
+  }
+
+  template <typename T>
+  Node& AddQuantizeLinearNode(NodeArg* input_arg, float scale, T zero_point, NodeArg* output_arg) {
+    return AddNode("QuantizeLinear",
+                   {input_arg, MakeScalarInitializer<float>(scale), MakeScalarInitializer<T>(zero_point)},
+                   {output_arg});
+  }
+
+  template <typename T>
+  Node& AddDequantizeLinearNode(NodeArg* input_arg, float scale, T zero_point, NodeArg* output_arg) {
+    return AddNode("DequantizeLinear",
+                   {input_arg, MakeScalarInitializer<float>(scale), MakeScalarInitializer<T>(zero_point)},
+                   {output_arg});
+  }
+
+  // Adds the DequantizeLinear node of an int8 weight, returning its float output.
+  NodeArg* AddWeight(const std::vector<int64_t>& shape, float scale) {
+    auto* weight_arg = MakeIntermediate();
+    // Avoid saturation from u8s8 math.
+    AddDequantizeLinearNode<int8_t>(MakeInitializer<int8_t>(shape, -63, 63), scale, 0, weight_arg);
+    return weight_arg;
+  }
+
+  template <typename T>
+  std::vector<T> FillRandomData(const std::vector<int64_t>& shape, int32_t min_value, int32_t max_value) {
+    int64_t num_elements = std::accumulate(shape.begin(), shape.end(), int64_t(1), std::multiplies<int64_t>{});
+    std::vector<T> random_data(static_cast<size_t>(num_elements));
+    std::uniform_int_distribution<int32_t> distribution(min_value, max_value);
+    for (auto& value : random_data) {
+      value = static_cast<T>(distribution(generator_));
+    }
+    return random_data;
+  }
+
+  Graph& graph_;
+  NameMLValMap feeds_;
+  std::vector<std::string> output_names_;
+  std::default_random_engine generator_{2345};
+};
+
+// Runs the model built by build_test_case with the level 1 optimizations, which don't fuse the QDQ groups, and with
+// the level 2 optimizations, and checks that the outputs differ by at most one step of the quantized output.
+void QDQFusionTester(const std::function<void(QDQTestHelper& helper)>& build_test_case,
+                     const std::function<void(InferenceSessionWrapper& session)>& check_fused_graph,
+                     float output_scale,
+                     int opset_version = 12,
+                     bool disable_qdq_fusion = false) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = opset_version;
+  domain_to_version[kMSDomain] = 1;
+  Model model("qdq", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  QDQTestHelper helper(model.MainGraph());
+  build_test_case(helper);
+  ASSERT_TRUE(model.MainGraph().Resolve().IsOK());
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+
+  auto run_model = [&](TransformerLevel level, std::vector<OrtValue>& fetches) {
+    SessionOptions session_options;
+    session_options.graph_optimization_level = level;
+    session_options.session_logid = "QDQFusionTests";
+    if (disable_qdq_fusion) {
+      ASSERT_TRUE(session_options.AddConfigEntry(kOrtSessionOptionsConfigDisableQuantQDQ, "1").IsOK());
+    }
+    InferenceSessionWrapper session{session_options, GetEnvironment()};
+    ASSERT_TRUE(session.Load(model_data.data(), static_cast<int>(model_data.size())).IsOK());
+    ASSERT_TRUE(session.Initialize().IsOK());
+
+    RunOptions run_options;
+    auto status = session.Run(run_options, helper.feeds_, helper.output_names_, &fetches);
+    ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+    if (level == TransformerLevel::Level2) {
+      check_fused_graph(session);
+    }
+  };
+
+  std::vector<OrtValue> level1_fetches;
+  run_model(TransformerLevel::Level1, level1_fetches);
+
+  std::vector<OrtValue> level2_fetches;
+  run_model(TransformerLevel::Level2, level2_fetches);
+
+  ASSERT_EQ(level1_fetches.size(), level2_fetches.size());
+  for (size_t i = 0; i < level1_fetches.size(); i++) {
+    // the integer kernels round the requantized values differently than the float ops
+    std::pair<COMPARE_RESULT, std::string> ret =
+        CompareOrtValue(level2_fetches[i], level1_fetches[i], output_scale * 1.01, 0.0, false);
+    EXPECT_EQ(ret.first, COMPARE_RESULT::SUCCESS) << ret.second;
+  }
+}
+
+#ifndef DISABLE_CONTRIB_OPS
+
+TEST(QDQFusionTests, Conv) {
+  auto test_case = [&](bool has_bias) {
+    auto build_test_case = [&](QDQTestHelper& helper) {
+      auto* input_arg = helper.MakeInput<uint8_t>({1, 8, 13, 13});
+      auto* dq_output_arg = helper.MakeIntermediate();
+      auto* conv_output_arg = helper.MakeIntermediate();
+      auto* q_output_arg = helper.MakeIntermediate();
+      auto* output_arg = helper.MakeOutput();
+
+      helper.AddDequantizeLinearNode<uint8_t>(input_arg, .05f, 10, dq_output_arg);
+      std::vector<NodeArg*> conv_inputs{dq_output_arg, helper.AddWeight({16, 8, 3, 3}, .02f)};
+      if (has_bias) {
+        auto* bias_arg = helper.MakeIntermediate();
+        helper.AddDequantizeLinearNode<int32_t>(helper.MakeInitializer<int32_t>({16}, -1000, 1000),
+                                                .05f * .02f, 0, bias_arg);
+        conv_inputs.push_back(bias_arg);
+      }
+      Node& conv_node = helper.AddNode("Conv", conv_inputs, {conv_output_arg});
+      conv_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+      helper.AddQuantizeLinearNode<uint8_t>(conv_output_arg, .05f, 128, q_output_arg);
+      helper.AddDequantizeLinearNode<uint8_t>(q_output_arg, .05f, 128, output_arg);
+    };
+
+    auto check_fused_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["QLinearConv"], 1);
+      EXPECT_EQ(op_to_count["Conv"], 0);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], 0);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+    };
+
+    QDQFusionTester(build_test_case, check_fused_graph, .05f);
+  };
+
+  test_case(false);
+  test_case(true);
+}
+
+TEST(QDQFusionTests, ConvPerChannelWeights) {
+  auto build_test_case = [&](QDQTestHelper& helper) {
+    auto* input_arg = helper.MakeInput<uint8_t>({1, 8, 13, 13});
+    auto* dq_output_arg = helper.MakeIntermediate();
+    auto* weight_arg = helper.MakeIntermediate();
+    auto* conv_output_arg = helper.MakeIntermediate();
+    auto* q_output_arg = helper.MakeIntermediate();
+    auto* output_arg = helper.MakeOutput();
+
+    helper.AddDequantizeLinearNode<uint8_t>(input_arg, .05f, 10, dq_output_arg);
+    std::vector<float> weight_scales{.01f, .02f, .03f, .04f};
+    Node& weight_node = helper.AddNode("DequantizeLinear",
+                                       {helper.MakeInitializer<int8_t>({4, 8, 3, 3}, -63, 63),
+                                        helper.MakeInitializer<float>({4}, weight_scales),
+                                        helper.MakeInitializer<int8_t>({4}, std::vector<int8_t>(4, 0))},
+                                       {weight_arg});
+    weight_node.AddAttribute("axis", static_cast<int64_t>(0));
+    helper.AddNode("Conv", {dq_output_arg, weight_arg}, {conv_output_arg});
+    helper.AddQuantizeLinearNode<uint8_t>(conv_output_arg, .05f, 128, q_output_arg);
+    helper.AddDequantizeLinearNode<uint8_t>(q_output_arg, .05f, 128, output_arg);
+  };
+
+  auto check_fused_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["QLinearConv"], 1);
+    EXPECT_EQ(op_to_count["Conv"], 0);
+  };
+
+  QDQFusionTester(build_test_case, check_fused_graph, .05f, 13);
+}
+
+TEST(QDQFusionTests, MatMulAddSigmoid) {
+  auto build_test_case = [&](QDQTestHelper& helper) {
+    auto* input1_arg = helper.MakeInput<uint8_t>({2, 5, 16});
+    auto* input2_arg = helper.MakeInput<uint8_t>({2, 5, 8});
+    auto* dq1_output_arg = helper.MakeIntermediate();
+    auto* dq2_output_arg = helper.MakeIntermediate();
+    auto* matmul_output_arg = helper.MakeIntermediate();
+    auto* matmul_q_output_arg = helper.MakeIntermediate();
+    auto* matmul_dq_output_arg = helper.MakeIntermediate();
+    auto* add_output_arg = helper.MakeIntermediate();
+    auto* add_q_output_arg = helper.MakeIntermediate();
+    auto* add_dq_output_arg = helper.MakeIntermediate();
+    auto* sigmoid_output_arg = helper.MakeIntermediate();
+    auto* sigmoid_q_output_arg = helper.MakeIntermediate();
+    auto* output_arg = helper.MakeOutput();
+
+    helper.AddDequantizeLinearNode<uint8_t>(input1_arg, .05f, 10, dq1_output_arg);
+    helper.AddNode("MatMul", {dq1_output_arg, helper.AddWeight({16, 8}, .02f)}, {matmul_output_arg});
+    helper.AddQuantizeLinearNode<uint8_t>(matmul_output_arg, .03f, 128, matmul_q_output_arg);
+    helper.AddDequantizeLinearNode<uint8_t>(matmul_q_output_arg, .03f, 128, matmul_dq_output_arg);
+    helper.AddDequantizeLinearNode<uint8_t>(input2_arg, .04f, 20, dq2_output_arg);
+    helper.AddNode("Add", {matmul_dq_output_arg, dq2_output_arg}, {add_output_arg});
+    helper.AddQuantizeLinearNode<uint8_t>(add_output_arg, .05f, 100, add_q_output_arg);
+    helper.AddDequantizeLinearNode<uint8_t>(add_q_output_arg, .05f, 100, add_dq_output_arg);
+    helper.AddNode("Sigmoid", {add_dq_output_arg}, {sigmoid_output_arg});
+    helper.AddQuantizeLinearNode<uint8_t>(sigmoid_output_arg, 1.f / 256, 0, sigmoid_q_output_arg);
+    helper.AddDequantizeLinearNode<uint8_t>(sigmoid_q_output_arg, 1.f / 256, 0, output_arg);
+  };
+
+  auto check_fused_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["QLinearMatMul"], 1);
+    EXPECT_EQ(op_to_count["com.microsoft.QLinearAdd"], 1);
+    EXPECT_EQ(op_to_count["com.microsoft.QLinearSigmoid"], 1);
+    EXPECT_EQ(op_to_count["QuantizeLinear"], 0);
+    EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+  };
+
+  QDQFusionTester(build_test_case, check_fused_graph, 1.f / 256);
+}
+
+TEST(QDQFusionTests, DataMovement) {
+  auto test_case = [&](float reshape_output_scale, int expected_quantize_linear_count) {
+    auto build_test_case = [&](QDQTestHelper& helper) {
+      auto* input_arg = helper.MakeInput<uint8_t>({1, 8, 12, 12});
+      auto* dq_output_arg = helper.MakeIntermediate();
+      auto* maxpool_output_arg = helper.MakeIntermediate();
+      auto* maxpool_q_output_arg = helper.MakeIntermediate();
+      auto* maxpool_dq_output_arg = helper.MakeIntermediate();
+      auto* reshape_output_arg = helper.MakeIntermediate();
+      auto* reshape_q_output_arg = helper.MakeIntermediate();
+      auto* output_arg = helper.MakeOutput();
+
+      helper.AddDequantizeLinearNode<uint8_t>(input_arg, .05f, 10, dq_output_arg);
+      Node& maxpool_node = helper.AddNode("MaxPool", {dq_output_arg}, {maxpool_output_arg});
+      maxpool_node.AddAttribute("kernel_shape", std::vector<int64_t>{2, 2});
+      maxpool_node.AddAttribute("strides", std::vector<int64_t>{2, 2});
+      helper.AddQuantizeLinearNode<uint8_t>(maxpool_output_arg, .05f, 10, maxpool_q_output_arg);
+      helper.AddDequantizeLinearNode<uint8_t>(maxpool_q_output_arg, .05f, 10, maxpool_dq_output_arg);
+      helper.AddNode("Reshape",
+                     {maxpool_dq_output_arg, helper.MakeInitializer<int64_t>({2}, std::vector<int64_t>{1, -1})},
+                     {reshape_output_arg});
+      helper.AddQuantizeLinearNode<uint8_t>(reshape_output_arg, reshape_output_scale, 10, reshape_q_output_arg);
+      helper.AddDequantizeLinearNode<uint8_t>(reshape_q_output_arg, reshape_output_scale, 10, output_arg);
+    };
+
+    auto check_fused_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["MaxPool"], 1);
+      EXPECT_EQ(op_to_count["Reshape"], 1);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], expected_quantize_linear_count);
+    };
+
+    QDQFusionTester(build_test_case, check_fused_graph, reshape_output_scale);
+  };
+
+  test_case(.05f, 0);
+  // the quantization isn't propagated through the Reshape if it requantizes the values
+  test_case(.1f, 1);
+}
+
+TEST(QDQFusionTests, Disabled) {
+  auto build_test_case = [&](QDQTestHelper& helper) {
+    auto* input_arg = helper.MakeInput<uint8_t>({1, 8, 13, 13});
+    auto* dq_output_arg = helper.MakeIntermediate();
+    auto* conv_output_arg = helper.MakeIntermediate();
+    auto* q_output_arg = helper.MakeIntermediate();
+    auto* output_arg = helper.MakeOutput();
+
+    helper.AddDequantizeLinearNode<uint8_t>(input_arg, .05f, 10, dq_output_arg);
+    helper.AddNode("Conv", {dq_output_arg, helper.AddWeight({16, 8, 3, 3}, .02f)}, {conv_output_arg});
+    helper.AddQuantizeLinearNode<uint8_t>(conv_output_arg, .05f, 128, q_output_arg);
+    helper.AddDequantizeLinearNode<uint8_t>(q_output_arg, .05f, 128, output_arg);
+  };
+
+  auto check_fused_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["QLinearConv"], 0);
+    EXPECT_EQ(op_to_count["Conv"], 1);
+  };
+
+  QDQFusionTester(build_test_case, check_fused_graph, .05f, 12, true);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -56,6 +56,49 @@ TEST(RuleBasedGraphTransformerTest, TestCompatibleProviders) {
   ASSERT_TRUE(dummy_rule1_ptr->IsRewriteRuleInvoked());
 }
 
+TEST(RuleBasedGraphTransformerTest, TestTransformersSkippedWithoutTargetOpTypes) {
+  auto model_uri = ORT_TSTR("testdata/transform/fusion/fuse-conv-bn-mul-add-unsqueeze.onnx");
+
+  std::shared_ptr<Model> model;
+  ASSERT_TRUE(Model::Load(model_uri, model, nullptr,
+                          DefaultLoggingManager().DefaultLogger())
+                  .IsOK());
+  Graph& graph = model->MainGraph();
+
+  auto conv_transformer = onnxruntime::make_unique<DummyGraphTransformer>("ConvTransformer",
+                                                                          std::vector<std::string>{"Conv"});
+  const auto* conv_transformer_ptr = conv_transformer.get();
+  auto lstm_transformer = onnxruntime::make_unique<DummyGraphTransformer>("LSTMTransformer",
+                                                                          std::vector<std::string>{"LSTM", "GRU"});
+  const auto* lstm_transformer_ptr = lstm_transformer.get();
+
+  // a rule-based transformer targets the op types of its rules
+  class LSTMRule : public DummyRewriteRule {
+   public:
+    LSTMRule() : DummyRewriteRule("LSTMRule") {}
+    std::vector<std::string> TargetOpTypes() const noexcept override { return {"LSTM"}; }
+  };
+
+  auto lstm_rule = onnxruntime::make_unique<LSTMRule>();
+  const auto* lstm_rule_ptr = lstm_rule.get();
+  auto rule_transformer = onnxruntime::make_unique<RuleBasedGraphTransformer>("LSTMRuleTransformer");
+  ASSERT_TRUE(rule_transformer->Register(std::move(lstm_rule)).IsOK());
+  ASSERT_EQ(rule_transformer->TargetOpTypes(), std::vector<std::string>{"LSTM"});
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_TRUE(graph_transformation_mgr.Register(std::move(conv_transformer), TransformerLevel::Level2).IsOK());
+  ASSERT_TRUE(graph_transformation_mgr.Register(std::move(lstm_transformer), TransformerLevel::Level2).IsOK());
+  ASSERT_TRUE(graph_transformation_mgr.Register(std::move(rule_transformer), TransformerLevel::Level2).IsOK());
+
+  ASSERT_TRUE(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2,
+                                                         DefaultLoggingManager().DefaultLogger())
+                  .IsOK());
+
+  ASSERT_TRUE(conv_transformer_ptr->IsTransformerInvoked());
+  ASSERT_FALSE(lstm_transformer_ptr->IsTransformerInvoked());
+  ASSERT_FALSE(lstm_rule_ptr->IsRewriteRuleInvoked());
+}
+
 TEST(RuleBasedGraphTransformerTest, TestSettingStepsInGraphTransformerManager) {
   // steps provided at object construction time
   onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
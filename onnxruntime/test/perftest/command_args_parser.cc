@@ -33,6 +33,10 @@ namespace perftest {
       "\t-A: Disable memory arena\n"
       "\t-I: Generate tensor input binding (Free dimensions are treated as 1.)\n"
       "\t-c [parallel runs]: Specifies the (max) number of runs to invoke simultaneously. Default:1.\n"
+      "\t-Q [target_qps]: Issue requests at this average rate with Poisson arrivals (open loop) instead of back to back.\n"
+      "\t\tUp to [parallel runs] requests run at once, and the latency includes the time a request waited to run.\n"
+      "\t-W [warmup_times]: Specifies the number of warmup runs that are not measured. Default:1.\n"
+      "\t-J [summary_file]: Write the latency percentiles and the per second throughput as JSON to the file.\n"
       "\t-e [cpu|cuda|dnnl|tensorrt|openvino|nuphar|dml|acl]: Specifies the provider 'cpu','cuda','dnnl','tensorrt', "
       "'openvino', 'nuphar', 'dml' or 'acl'. "
       "Default:'cpu'.\n"
@@ -56,7 +60,7 @@ namespace perftest {
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:AMPIvhsqz"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:Q:W:J:AMPIvhsqz"))) != -1) {
     switch (ch) {
       case 'm':
         if (!CompareCString(optarg, ORT_TSTR("duration"))) {
@@ -147,6 +151,23 @@ namespace perftest {
           return false;
         }
         break;
+      case 'Q':
+        test_config.run_config.target_qps = OrtStrtod<PATH_CHAR_TYPE>(optarg, nullptr);
+        if (!(test_config.run_config.target_qps > 0)) {
+          return false;
+        }
+        break;
+      case 'W': {
+        long warmup_times = OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr);
+        if (warmup_times < 0) {
+          return false;
+        }
+        test_config.run_config.warmup_times = static_cast<size_t>(warmup_times);
+        break;
+      }
+      case 'J':
+        test_config.run_config.summary_file = optarg;
+        break;
       case 'o': {
         int tmp = static_cast<int>(OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr));
         switch (tmp) {
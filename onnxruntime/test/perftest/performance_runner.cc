@@ -8,6 +8,7 @@
 
 #include "performance_runner.h"
 #include <iostream>
+#include <thread>
 
 #include "TestCase.h"
 #include "TFModelInfo.h"
@@ -42,6 +43,11 @@ Eigen::ThreadPoolInterface* GetDefaultThreadPool(const onnxruntime::Env& env) {
 namespace onnxruntime {
 namespace perftest {
 
+// sorted_time must not be empty
+static double Percentile(const std::vector<double>& sorted_time, double percentile) {
+  return sorted_time[static_cast<size_t>(sorted_time.size() * percentile)];
+}
+
 void PerformanceResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, bool f_include_statistics) const {
   bool have_file = !path.empty();
   std::ofstream outfile;
@@ -70,24 +76,16 @@ void PerformanceResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, boo
 
   if (!time_costs.empty() && f_include_statistics) {
     std::vector<double> sorted_time = time_costs;
-
-    size_t total = sorted_time.size();
-    size_t n50 = static_cast<size_t>(total * 0.5);
-    size_t n90 = static_cast<size_t>(total * 0.9);
-    size_t n95 = static_cast<size_t>(total * 0.95);
-    size_t n99 = static_cast<size_t>(total * 0.99);
-    size_t n999 = static_cast<size_t>(total * 0.999);
-
     std::sort(sorted_time.begin(), sorted_time.end());
 
     auto output_stats = [&](std::ostream& ostream) {
-      ostream << "Min Latency: " << sorted_time[0] << " s\n";
-      ostream << "Max Latency: " << sorted_time[total - 1] << " s\n";
-      ostream << "P50 Latency: " << sorted_time[n50] << " s\n";
-      ostream << "P90 Latency: " << sorted_time[n90] << " s\n";
-      ostream << "P95 Latency: " << sorted_time[n95] << " s\n";
-      ostream << "P99 Latency: " << sorted_time[n99] << " s\n";
-      ostream << "P999 Latency: " << sorted_time[n999] << " s" << std::endl;
+      ostream << "Min Latency: " << sorted_time.front() << " s\n";
+      ostream << "Max Latency: " << sorted_time.back() << " s\n";
+      ostream << "P50 Latency: " << Percentile(sorted_time, 0.5) << " s\n";
+      ostream << "P90 Latency: " << Percentile(sorted_time, 0.9) << " s\n";
+      ostream << "P95 Latency: " << Percentile(sorted_time, 0.95) << " s\n";
+      ostream << "P99 Latency: " << Percentile(sorted_time, 0.99) << " s\n";
+      ostream << "P999 Latency: " << Percentile(sorted_time, 0.999) << " s" << std::endl;
     };
 
     if (have_file) {
@@ -99,28 +97,77 @@ void PerformanceResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, boo
   }
 }
 
+void PerformanceResult::DumpSummaryToFile(const std::basic_string<ORTCHAR_T>& path, double target_qps) const {
+  std::ofstream outfile(path, std::ofstream::out | std::ofstream::trunc);
+  if (!outfile.good()) {
+    std::cerr << "failed to open summary file '" << ToMBString(path) << "'.\n";
+    return;
+  }
+
+  std::chrono::duration<double> run_time = end - start;
+  outfile << "{\"model_name\" : \"" << model_name << "\", \"requests\" : " << time_costs.size()
+          << ", \"run_time_s\" : " << run_time.count() << ", \"target_qps\" : " << target_qps
+          << ", \"achieved_qps\" : " << (run_time.count() > 0 ? time_costs.size() / run_time.count() : 0.0);
+
+  if (!time_costs.empty()) {
+    std::vector<double> sorted_time = time_costs;
+    std::sort(sorted_time.begin(), sorted_time.end());
+
+    outfile << ", \"latency_ms\" : {\"min\" : " << sorted_time.front() * 1000
+            << ", \"mean\" : " << total_time_cost / time_costs.size() * 1000
+            << ", \"p50\" : " << Percentile(sorted_time, 0.5) * 1000
+            << ", \"p90\" : " << Percentile(sorted_time, 0.9) * 1000
+            << ", \"p95\" : " << Percentile(sorted_time, 0.95) * 1000
+            << ", \"p99\" : " << Percentile(sorted_time, 0.99) * 1000
+            << ", \"p999\" : " << Percentile(sorted_time, 0.999) * 1000
+            << ", \"max\" : " << sorted_time.back() * 1000 << "}";
+  }
+
+  // number of requests completed in each second since the start of the run
+  std::vector<size_t> throughput;
+  for (double completion_time : completion_times) {
+    size_t second = static_cast<size_t>(completion_time);
+    if (second >= throughput.size()) {
+      throughput.resize(second + 1, 0);
+    }
+    ++throughput[second];
+  }
+
+  outfile << ", \"throughput_per_second\" : [";
+  for (size_t i = 0; i < throughput.size(); ++i) {
+    outfile << (i == 0 ? "" : ", ") << throughput[i];
+  }
+  outfile << "]}" << std::endl;
+}
+
 Status PerformanceRunner::Run() {
   if (!Initialize()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "failed to initialize.");
   }
 
   // warm up
-  RunOneIteration<true>();
+  for (size_t i = 0; i < performance_test_config_.run_config.warmup_times; ++i) {
+    ORT_RETURN_IF_ERROR(RunOneIteration<true>());
+  }
 
   // TODO: start profiling
   // if (!performance_test_config_.run_config.profile_file.empty())
   performance_result_.start = std::chrono::high_resolution_clock::now();
 
   std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
-  switch (performance_test_config_.run_config.test_mode) {
-    case TestMode::kFixDurationMode:
-      ORT_RETURN_IF_ERROR(FixDurationTest());
-      break;
-    case TestMode::KFixRepeatedTimesMode:
-      ORT_RETURN_IF_ERROR(RepeatedTimesTest());
-      break;
-    default:
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+  if (performance_test_config_.run_config.target_qps > 0) {
+    ORT_RETURN_IF_ERROR(RunOpenLoop());
+  } else {
+    switch (performance_test_config_.run_config.test_mode) {
+      case TestMode::kFixDurationMode:
+        ORT_RETURN_IF_ERROR(FixDurationTest());
+        break;
+      case TestMode::KFixRepeatedTimesMode:
+        ORT_RETURN_IF_ERROR(RepeatedTimesTest());
+        break;
+      default:
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+    }
   }
   performance_result_.end = std::chrono::high_resolution_clock::now();
 
@@ -138,6 +185,7 @@ Status PerformanceRunner::Run() {
             << "Average inference time cost: " << performance_result_.total_time_cost / performance_result_.time_costs.size() * 1000 << " ms\n"
             // Time between start and end of run. Less than Total time cost when running requests in parallel.
             << "Total inference run time: " << inference_duration.count() << " s\n"
+            << "Throughput: " << performance_result_.time_costs.size() / inference_duration.count() << " requests/s\n"
             << "Avg CPU usage: " << performance_result_.average_CPU_usage << " %\n"
             << "Peak working set size: " << performance_result_.peak_workingset_size << " bytes"
             << std::endl;
@@ -230,6 +278,59 @@ Status PerformanceRunner::ForkJoinRepeat() {
   return Status::OK();
 }
 
+Status PerformanceRunner::RunOpenLoop() {
+  const auto& run_config = performance_test_config_.run_config;
+
+  // requests that arrive while every session run is busy wait in the queue of the pool. the latency is measured
+  // from the arrival, so the wait is included as it would be for a client.
+  auto tpool = onnxruntime::make_unique<DefaultThreadPoolType>(run_config.concurrent_session_runs);
+  std::mt19937 rand_engine(std::random_device{}());
+  std::exponential_distribution<double> inter_arrival_seconds(run_config.target_qps);
+  std::atomic<int> counter{0};
+  OrtMutex m;
+  OrtCondVar cv;
+
+  const auto start = std::chrono::high_resolution_clock::now();
+  auto arrival = start;
+  for (size_t requests = 0;; ++requests) {
+    if (run_config.test_mode == TestMode::KFixRepeatedTimesMode) {
+      if (requests >= run_config.repeated_times) {
+        break;
+      }
+    } else if (std::chrono::duration<double>(arrival - start).count() >= run_config.duration_in_seconds) {
+      break;
+    }
+
+    // the arrivals are not delayed when the loop falls behind, so the schedule does not adapt to the model
+    std::this_thread::sleep_until(arrival);
+    counter++;
+    tpool->Schedule([this, arrival, &counter, &m, &cv]() {
+      std::chrono::duration<double> duration_seconds(std::chrono::seconds(0));
+      auto status = RunSession(duration_seconds);
+      if (status.IsOK()) {
+        std::chrono::duration<double> latency = std::chrono::high_resolution_clock::now() - arrival;
+        RecordResult(latency.count());
+      } else {
+        std::cerr << status.ErrorMessage();
+      }
+
+      // Simplified version of Eigen::Barrier
+      std::lock_guard<OrtMutex> lg(m);
+      counter--;
+      cv.notify_all();
+    });
+
+    arrival += std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+        std::chrono::duration<double>(inter_arrival_seconds(rand_engine)));
+  }
+
+  //Join
+  std::unique_lock<OrtMutex> lock(m);
+  cv.wait(lock, [&counter]() { return counter == 0; });
+
+  return Status::OK();
+}
+
 static std::unique_ptr<TestModelInfo> CreateModelInfo(const PerformanceTestConfig& performance_test_config_) {
   if (CompareCString(performance_test_config_.backend.c_str(), ORT_TSTR("ort")) == 0) {
     const auto& file_path = performance_test_config_.model_info.model_file_path;
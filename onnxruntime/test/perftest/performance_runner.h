@@ -34,9 +34,14 @@ struct PerformanceResult {
   short average_CPU_usage{0};
   double total_time_cost{0};
   std::vector<double> time_costs;
+  // seconds from start to the completion of each request, in the same order as time_costs
+  std::vector<double> completion_times;
   std::string model_name;
 
   void DumpToFile(const std::basic_string<ORTCHAR_T>& path, bool f_include_statistics = false) const;
+
+  // writes the latency percentiles in milliseconds and the number of requests completed in each second as JSON
+  void DumpSummaryToFile(const std::basic_string<ORTCHAR_T>& path, double target_qps) const;
 };
 
 class PerformanceRunner {
@@ -51,16 +56,17 @@ class PerformanceRunner {
   inline void SerializeResult() const {
     performance_result_.DumpToFile(performance_test_config_.model_info.result_file_path,
                                    performance_test_config_.run_config.f_dump_statistics);
+    if (!performance_test_config_.run_config.summary_file.empty()) {
+      performance_result_.DumpSummaryToFile(performance_test_config_.run_config.summary_file,
+                                            performance_test_config_.run_config.target_qps);
+    }
   }
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PerformanceRunner);
 
  private:
   bool Initialize();
 
-  template <bool isWarmup>
-  Status RunOneIteration() {
-    std::chrono::duration<double> duration_seconds(std::chrono::seconds(0));
-
+  Status RunSession(std::chrono::duration<double>& duration_seconds) {
     auto status = Status::OK();
     ORT_TRY {
       duration_seconds = session_->Run();
@@ -70,16 +76,30 @@ class PerformanceRunner {
         status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PerformanceRunner::RunOneIteration caught exception: ", ex.what());
       });
     }
-    ORT_RETURN_IF_ERROR(status);
+    return status;
+  }
+
+  void RecordResult(double time_cost) {
+    std::chrono::duration<double> completion_time = std::chrono::high_resolution_clock::now() -
+                                                    performance_result_.start;
+
+    std::lock_guard<OrtMutex> guard(results_mutex_);
+    performance_result_.time_costs.emplace_back(time_cost);
+    performance_result_.completion_times.emplace_back(completion_time.count());
+    performance_result_.total_time_cost += time_cost;
+    if (performance_test_config_.run_config.f_verbose) {
+      std::cout << "iteration:" << performance_result_.time_costs.size() << ","
+                << "time_cost:" << performance_result_.time_costs.back() << std::endl;
+    }
+  }
+
+  template <bool isWarmup>
+  Status RunOneIteration() {
+    std::chrono::duration<double> duration_seconds(std::chrono::seconds(0));
+    ORT_RETURN_IF_ERROR(RunSession(duration_seconds));
 
     if (!isWarmup) {
-      std::lock_guard<OrtMutex> guard(results_mutex_);
-      performance_result_.time_costs.emplace_back(duration_seconds.count());
-      performance_result_.total_time_cost += duration_seconds.count();
-      if (performance_test_config_.run_config.f_verbose) {
-        std::cout << "iteration:" << performance_result_.time_costs.size() << ","
-                  << "time_cost:" << performance_result_.time_costs.back() << std::endl;
-      }
+      RecordResult(duration_seconds.count());
     }
     return Status::OK();
   }
@@ -88,6 +108,7 @@ class PerformanceRunner {
   Status RepeatedTimesTest();
   Status ForkJoinRepeat();
   Status RunParallelDuration();
+  Status RunOpenLoop();
 
   inline Status RunFixDuration() {
     while (performance_result_.total_time_cost < performance_test_config_.run_config.duration_in_seconds) {
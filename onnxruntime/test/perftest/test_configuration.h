@@ -40,6 +40,11 @@ struct RunConfig {
   size_t repeated_times{1000};
   size_t duration_in_seconds{600};
   size_t concurrent_session_runs{1};
+  // when positive, requests are issued at this average rate with Poisson arrivals instead of back to back,
+  // and the latency of a request includes the time it waited for a free session run.
+  double target_qps{0};
+  size_t warmup_times{1};
+  std::basic_string<ORTCHAR_T> summary_file;
   bool f_dump_statistics{false};
   bool f_verbose{false};
   bool enable_memory_pattern{true};
@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/platform/hardware_counters.h"
+
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+static void Spin() {
+  volatile double sum = 0;
+  for (int i = 0; i < 1000000; ++i) {
+    sum = sum + i;
+  }
+}
+
+TEST(HardwareCountersTest, CountsRegisteredThreads) {
+  if (!EnableHardwareCounters()) {
+    // not supported by the platform, or not permitted by perf_event_paranoid
+    EXPECT_FALSE(HardwareCountersEnabled());
+    GTEST_SKIP();
+  }
+
+  EXPECT_TRUE(HardwareCountersEnabled());
+
+  HardwareCounterValues begin = ReadHardwareCounters();
+  Spin();
+  HardwareCounterValues after_spin = ReadHardwareCounters();
+  EXPECT_GT(after_spin.instructions, begin.instructions);
+  EXPECT_GT(after_spin.cycles, begin.cycles);
+
+  // the counts of a thread are kept after it exits
+  HardwareCounterValues thread_counters;
+  std::thread thread([&thread_counters]() {
+    RegisterThreadForHardwareCounters();
+    Spin();
+    thread_counters = ReadHardwareCounters();
+  });
+  thread.join();
+
+  HardwareCounterValues after_thread = ReadHardwareCounters();
+  EXPECT_GE(after_thread.instructions, thread_counters.instructions);
+  after_thread -= after_spin;
+  // at least the loop of the thread
+  EXPECT_GT(after_thread.instructions, 1000000u);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
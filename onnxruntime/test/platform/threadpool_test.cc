@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <memory>
 #include <functional>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -381,6 +382,107 @@ TEST(ThreadPoolTest, TestMultiLoopSections_4Thread_100Loop) {
   TestMultiLoopSections("TestMultiLoopSections_4Thread_100Loop", 4, 100);
 }
 
+#ifndef _OPENMP
+TEST(ThreadPoolTest, TestRunScopeMaxDop) {
+  auto tp = onnxruntime::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions(), nullptr,
+                                                 5, true);
+  ASSERT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), 5);
+  {
+    ThreadPool::RunScope run_scope(tp.get(), 2, false);
+    ASSERT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), 2);
+    auto test_data = CreateTestData(50);
+    ThreadPool::TrySimpleParallelFor(tp.get(), 50, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+    ValidateTestData(*test_data);
+  }
+  ASSERT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), 5);
+}
+
+TEST(ThreadPoolTest, TestRunScopePartition) {
+  auto tp = onnxruntime::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions(), nullptr,
+                                                 5, true);
+  std::atomic<int> stage{0};
+  int other_dop = 0;
+  std::thread other([&]() {
+    ThreadPool::RunScope run_scope(tp.get(), 0, true);
+    stage = 1;
+    while (stage != 2) {
+      std::this_thread::yield();
+    }
+    other_dop = ThreadPool::DegreeOfParallelism(tp.get());
+    stage = 3;
+  });
+  while (stage != 1) {
+    std::this_thread::yield();
+  }
+  {
+    // The 4 workers are split between the two scopes.
+    ThreadPool::RunScope run_scope(tp.get(), 0, true);
+    ASSERT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), 3);
+    auto test_data = CreateTestData(50);
+    ThreadPool::TrySimpleParallelFor(tp.get(), 50, [&](std::ptrdiff_t i) { IncrementElement(*test_data, i); });
+    ValidateTestData(*test_data);
+    stage = 2;
+    while (stage != 3) {
+      std::this_thread::yield();
+    }
+  }
+  other.join();
+  ASSERT_EQ(other_dop, 3);
+
+  // Once the other scope ended, a new scope gets all the workers again.
+  ThreadPool::RunScope run_scope(tp.get(), 0, true);
+  ASSERT_EQ(ThreadPool::DegreeOfParallelism(tp.get()), 5);
+}
+
+TEST(ThreadPoolTest, TestParallelForStats) {
+  auto tp = onnxruntime::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions(), nullptr,
+                                                 4, true);
+  auto test_data = CreateTestData(1000);
+  auto increment_range = [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    for (std::ptrdiff_t i = first; i < last; i++) {
+      IncrementElement(*test_data, i);
+    }
+  };
+
+  // the stats are off by default
+  ThreadPool::TryParallelFor(tp.get(), 1000, 1e6, increment_range);
+  ASSERT_TRUE(tp->GetParallelForStats(false).empty());
+
+  tp->EnableStats(true);
+  {
+    ThreadPool::CallSiteScope call_site("MyOp");
+    for (int i = 0; i < 3; i++) {
+      ThreadPool::TryParallelFor(tp.get(), 1000, 1e6, increment_range);
+    }
+  }
+  auto other_data = CreateTestData(8);
+  ThreadPool::TrySimpleParallelFor(tp.get(), 8, [&](std::ptrdiff_t i) { IncrementElement(*other_data, i); });
+  ValidateTestData(*test_data, 4);
+  ValidateTestData(*other_data);
+
+  auto stats = tp->GetParallelForStats(true);
+  ASSERT_EQ(stats.size(), 2u);
+  EXPECT_EQ(stats[0].first, "");
+  EXPECT_EQ(stats[0].second.calls, 1u);
+  EXPECT_EQ(stats[0].second.shards, 8u);
+
+  ASSERT_EQ(stats[1].first, "MyOp");
+  const ParallelForStats& my_op = stats[1].second;
+  EXPECT_EQ(my_op.calls, 3u);
+  EXPECT_GE(my_op.workers, 3u);
+  EXPECT_LE(my_op.workers, 12u);
+  EXPECT_GE(my_op.shards, 6u);
+  EXPECT_LE(my_op.shard_steals, my_op.shards);
+  EXPECT_LE(my_op.max_tail_ns, my_op.tail_ns);
+  EXPECT_LE(my_op.max_wakeup_ns, my_op.wakeup_ns);
+  // the busiest thread of a loop is at least as busy as the mean
+  EXPECT_GE(my_op.imbalance, 3.0 - 1e-6);
+
+  // cleared by the previous call
+  ASSERT_TRUE(tp->GetParallelForStats(false).empty());
+}
+#endif
+
 #ifdef _WIN32
 TEST(ThreadPoolTest, TestStackSize) {
   ThreadOptions to;
@@ -4,12 +4,66 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
+#include "core/providers/cpu/generator/philox.h"
+
 #include <algorithm>
-#include <random>
 using namespace ONNX_NAMESPACE;
 namespace onnxruntime {
 namespace test {
 
+// The values of the first call of a kernel with the seed. Value i is from the Philox block i / NumValuesPerBlock<T>().
+template <typename T>
+std::vector<T> ExpectedNormal(float seed, float mean, float scale, size_t count) {
+  PhiloxGenerator generator{gsl::narrow_cast<uint32_t>(seed)};
+  std::vector<T> values(count);
+  Philox4x32::Fill(nullptr, generator, values.data(), static_cast<std::ptrdiff_t>(count), 0.0,
+                   [mean, scale](const Philox4x32::Block& bits, T(&block_values)[Philox4x32::NumValuesPerBlock<T>()]) {
+                     Philox4x32::Normal(bits, block_values);
+                     for (auto& value : block_values) {
+                       value = static_cast<T>(mean) + static_cast<T>(scale) * value;
+                     }
+                   });
+  return values;
+}
+
+template <typename T>
+std::vector<T> ExpectedUniform(float seed, float low, float high, size_t count) {
+  PhiloxGenerator generator{gsl::narrow_cast<uint32_t>(seed)};
+  std::vector<T> values(count);
+  Philox4x32::Fill(nullptr, generator, values.data(), static_cast<std::ptrdiff_t>(count), 0.0,
+                   [low, high](const Philox4x32::Block& bits, T(&block_values)[Philox4x32::NumValuesPerBlock<T>()]) {
+                     Philox4x32::Uniform(bits, block_values);
+                     for (auto& value : block_values) {
+                       value = static_cast<T>(low) + (static_cast<T>(high) - static_cast<T>(low)) * value;
+                     }
+                   });
+  return values;
+}
+
+TEST(Random, Philox4x32) {
+  // the known answer of Random123 for a zero key and counter
+  const Philox4x32::Block expected_bits{{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}};
+  EXPECT_EQ(Philox4x32::Generate(0, 0), expected_bits);
+
+  // the values of a block do not depend on the blocks generated before it
+  PhiloxGenerator generator{17};
+  std::vector<float> values(10);
+  Philox4x32::Fill(nullptr, generator, values.data(), 10, 0.0,
+                   [](const Philox4x32::Block& bits, float(&block_values)[4]) {
+                     Philox4x32::Uniform(bits, block_values);
+                   });
+  EXPECT_EQ(generator.NextPhiloxSeeds(0).second, 3u);
+
+  float uniform[4];
+  Philox4x32::Uniform(Philox4x32::Generate(17, 2), uniform);
+  EXPECT_EQ(values[8], uniform[0]);
+  EXPECT_EQ(values[9], uniform[1]);
+  for (float value : values) {
+    EXPECT_GE(value, 0.f);
+    EXPECT_LT(value, 1.f);
+  }
+}
+
 TEST(Random, RandomNormal2DDouble) {
   OpTester test("RandomNormal");
 
@@ -25,12 +79,7 @@ TEST(Random, RandomNormal2DDouble) {
   test.AddAttribute<int64_t>("dtype", TensorProto::DOUBLE);
   test.AddAttribute("shape", dims);
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::normal_distribution<double> distribution{mean, scale};
-
-  std::vector<double> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](double& value) { value = distribution(generator); });
+  std::vector<double> expected_output = ExpectedNormal<double>(seed, mean, scale, TensorShape(dims).Size());
 
   test.AddOutput<double>("Y", dims, expected_output);
   test.Run();
@@ -59,12 +108,7 @@ void RunRandomNormalLike3DFloat(bool infer_dtype = false) {
                         0.f, 0.f, 0.f,
                         0.f, 0.f, 0.f});
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::normal_distribution<float> distribution{mean, scale};
-
-  std::vector<float> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](float& value) { value = distribution(generator); });
+  std::vector<float> expected_output = ExpectedNormal<float>(seed, mean, scale, TensorShape(dims).Size());
 
   test.AddOutput<float>("Y", dims, expected_output);
 
@@ -95,12 +139,7 @@ TEST(Random, RandomUniform1DFloat) {
   test.AddAttribute<int64_t>("dtype", TensorProto::FLOAT);
   test.AddAttribute("shape", dims);
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::uniform_real_distribution<float> distribution{low, high};
-
-  std::vector<float> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](float& value) { value = distribution(generator); });
+  std::vector<float> expected_output = ExpectedUniform<float>(seed, low, high, TensorShape(dims).Size());
 
   test.AddOutput<float>("Y", dims, expected_output);
 
@@ -128,12 +167,7 @@ void RunRandomUniformLikeTest(bool infer_dtype = false) {
                         {0., 0., 0., 0., 0., 0.,
                          0., 0., 0., 0., 0., 0.});
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::uniform_real_distribution<double> distribution{low, high};
-
-  std::vector<double> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](double& value) { value = distribution(generator); });
+  std::vector<double> expected_output = ExpectedUniform<double>(seed, low, high, TensorShape(dims).Size());
 
   test.AddOutput<double>("Y", dims, expected_output);
 
@@ -223,9 +257,9 @@ TEST(Random, InvalidDType) {
 
 /*
 Note: There are no reference tests that can be reused in this case. I tried to use the tensorflow
-test cases but they use a different RNG (Philox) and hence the test results differ. Since the implementation
+test cases but they use a different Philox stream and hence the test results differ. Since the implementation
 of the op is same as tensorflow, for now I've just relied on the output generated by this code as ground truth
-for verification.
+for verification. The Philox generator gives the same output on all platforms.
 */
 TEST(Random, MultinomialGoodCase) {
   OpTester test("Multinomial");
@@ -245,13 +279,7 @@ TEST(Random, MultinomialGoodCase) {
   test.AddAttribute<int64_t>("dtype", TensorProto::INT64);
 
   const std::vector<int64_t> output_dims{batch_size, num_samples};
-#ifdef _WIN32
-  const std::vector<int64_t> expected_output{2, 0, 0, 2, 2, 2, 0, 2, 2, 1, 1, 2, 1, 1, 1, 1, 2, 1, 2, 0};
-#elif defined(__MACH__) || defined(__ANDROID__) || defined(__FreeBSD__)
-  const std::vector<int64_t> expected_output{1, 1, 2, 2, 0, 2, 2, 2, 0, 2, 1, 1, 2, 0, 2, 2, 0, 2, 1, 1};
-#else
-  const std::vector<int64_t> expected_output{2, 0, 0, 1, 0, 1, 2, 0, 1, 0, 0, 1, 1, 0, 1, 0, 2, 0, 2, 0};
-#endif
+  const std::vector<int64_t> expected_output{1, 2, 0, 2, 0, 0, 2, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0};
   test.AddOutput<int64_t>("Y", output_dims, expected_output);
 
   test.Run();
@@ -282,16 +310,8 @@ TEST(Random, MultinomialDefaultDType) {
     test.Run();
   };
 
-#ifdef _WIN32
-  const std::vector<int32_t> expected_output_1{2, 0, 0, 2, 2, 2, 0, 2, 2, 1, 1, 2, 1, 1, 1, 1, 2, 1, 2, 0};
-  const std::vector<int32_t> expected_output_2{0, 0, 1, 0, 2, 2, 2, 0, 2, 1, 2, 1, 0, 2, 0, 2, 2, 1, 2, 1};
-#elif defined(__MACH__) || defined(__ANDROID__) || defined(__FreeBSD__)
-  const std::vector<int32_t> expected_output_1{1, 1, 2, 2, 0, 2, 2, 2, 0, 2, 1, 1, 2, 0, 2, 2, 0, 2, 1, 1};
-  const std::vector<int32_t> expected_output_2{1, 0, 1, 1, 1, 1, 0, 0, 1, 1, 0, 2, 0, 1, 1, 0, 2, 2, 2, 1};
-#else
-  const std::vector<int32_t> expected_output_1{2, 0, 0, 1, 0, 1, 2, 0, 1, 0, 0, 1, 1, 0, 1, 0, 2, 0, 2, 0};
-  const std::vector<int32_t> expected_output_2{2, 2, 1, 1, 0, 2, 2, 1, 1, 2, 0, 0, 0, 2, 0, 1, 1, 1, 0, 0};
-#endif
+  const std::vector<int32_t> expected_output_1{1, 2, 0, 2, 0, 0, 2, 0, 1, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0};
+  const std::vector<int32_t> expected_output_2{2, 0, 0, 2, 0, 1, 2, 1, 1, 0, 0, 2, 0, 2, 2, 0, 2, 2, 1, 2};
 
   // Test output from a single call to Multinomial::Compute
   run_test(1, expected_output_1);
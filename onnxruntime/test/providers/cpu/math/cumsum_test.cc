@@ -218,5 +218,38 @@ TEST(CumSumTest, _1DTestdouble_WithInt64Axis) {
   test.AddOutput<double>("y", {5}, {1., 3., 6., 10., 15.});
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
+TEST(CumSumTest, _1DTestInt64Large) {
+  // large enough for the input to be summed in blocks
+  const int64_t size = 100000;
+  std::vector<int64_t> x(size);
+  for (int64_t i = 0; i < size; ++i) {
+    x[i] = i % 5;
+  }
+
+  for (int64_t exclusive = 0; exclusive < 2; ++exclusive) {
+    for (int64_t reverse = 0; reverse < 2; ++reverse) {
+      std::vector<int64_t> y(size);
+      int64_t sum = 0;
+      for (int64_t k = 0; k < size; ++k) {
+        const int64_t i = reverse ? size - 1 - k : k;
+        if (exclusive) {
+          y[i] = sum;
+          sum += x[i];
+        } else {
+          sum += x[i];
+          y[i] = sum;
+        }
+      }
+
+      OpTester test("CumSum", 11, onnxruntime::kOnnxDomain);
+      test.AddAttribute<int64_t>("exclusive", exclusive);
+      test.AddAttribute<int64_t>("reverse", reverse);
+      test.AddInput<int64_t>("x", {size}, x);
+      test.AddInput<int32_t>("axis", {1}, {0});
+      test.AddOutput<int64_t>("y", {size}, y);
+      test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+    }
+  }
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -519,5 +519,68 @@ TEST(Einsum, ImplicitEinsumAsTensorContraction) {
   test.Run();
 }
 
+// Theme: Contraction order and operand layouts
+
+// The cheapest contraction path processes the last two inputs first
+TEST(Einsum, ExplicitEinsumAsMatmulVector_Contraction_Path) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,jk,k->i");
+  test.AddInput<float>("x", {2, 3}, {-2.f, -1.f, 0.f, 1.f, 2.f, -2.f});
+  test.AddInput<float>("y", {3, 4}, {-1.f, 0.f, 1.f, 2.f, -2.f, -1.f, 0.f, 1.f, 2.f, -2.f, -1.f, 0.f});
+  test.AddInput<float>("z", {4}, {1.f, 2.f, -2.f, -1.f});
+  test.AddOutput<float>("o", {2}, {15.f, -15.f});
+  test.Run();
+}
+
+TEST(Einsum, ExplicitEinsumAsChainedMatmul_Contraction_Path) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ab,bc,cd,d->a");
+  test.AddInput<double>("x", {2, 3}, {-2., -1., 0., 1., 2., -2.});
+  test.AddInput<double>("y", {3, 4}, {-1., 0., 1., 2., -2., -1., 0., 1., 2., -2., -1., 0.});
+  test.AddInput<double>("z", {4, 2}, {1., 2., -2., -1., 0., 1., 2., -2.});
+  test.AddInput<double>("w", {2}, {-1., 0.});
+  test.AddOutput<double>("o", {2}, {8., 5.});
+  test.Run();
+}
+
+// The right operand is multiplied as a transposed matrix
+TEST(Einsum, ExplicitEinsumAsMatmul_RightOperandTransposed) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,kj->ik");
+  test.AddInput<float>("x", {2, 3}, {-2.f, -1.f, 0.f, 1.f, 2.f, -2.f});
+  test.AddInput<float>("y", {4, 3}, {-1.f, 0.f, 1.f, 2.f, -2.f, -1.f, 0.f, 1.f, 2.f, -2.f, -1.f, 0.f});
+  test.AddOutput<float>("o", {2, 4}, {2.f, -2.f, -1.f, 5.f, -3.f, 0.f, -2.f, -4.f});
+  test.Run();
+}
+
+// The left operand is multiplied as a transposed matrix
+TEST(Einsum, ExplicitEinsumAsMatmul_LeftOperandTransposed) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ji,jk->ik");
+  test.AddInput<float>("x", {3, 2}, {-2.f, -1.f, 0.f, 1.f, 2.f, -2.f});
+  test.AddInput<float>("y", {3, 4}, {-1.f, 0.f, 1.f, 2.f, -2.f, -1.f, 0.f, 1.f, 2.f, -2.f, -1.f, 0.f});
+  test.AddOutput<float>("o", {2, 4}, {6.f, -4.f, -4.f, -4.f, -5.f, 3.f, 1.f, -1.f});
+  test.Run();
+}
+
+// The operands are swapped to produce the transposed output directly
+TEST(Einsum, ExplicitEinsumAsMatmul_OutputTransposed_SwappedOperands) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,jk->ki");
+  test.AddInput<float>("x", {2, 3}, {-2.f, -1.f, 0.f, 1.f, 2.f, -2.f});
+  test.AddInput<float>("y", {3, 4}, {-1.f, 0.f, 1.f, 2.f, -2.f, -1.f, 0.f, 1.f, 2.f, -2.f, -1.f, 0.f});
+  test.AddOutput<float>("o", {4, 2}, {4.f, -9.f, 1.f, 2.f, -2.f, 3.f, -5.f, 4.f});
+  test.Run();
+}
+
+TEST(Einsum, ExplicitEinsumAsReduceOpWithTranspose_3D_input) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ijk->ki");
+  test.AddInput<float>("x", {2, 3, 4}, {-2.f, -1.f, 0.f, 1.f, 2.f, -2.f, -1.f, 0.f, 1.f, 2.f, -2.f, -1.f,
+                                        0.f, 1.f, 2.f, -2.f, -1.f, 0.f, 1.f, 2.f, -2.f, -1.f, 0.f, 1.f});
+  test.AddOutput<float>("o", {4, 2}, {1.f, -3.f, -1.f, 0.f, -3.f, 3.f, 0.f, 1.f});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -7,6 +7,7 @@
 #include "core/util/math.h"
 #include <algorithm>
 #include <cmath>
+#include <numeric>
 
 namespace onnxruntime {
 namespace test {
@@ -307,6 +308,41 @@ TEST(MathOpTest, Add_Broadcast_2x1x1_3x4) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", excluded_providers);  //TensorRT: Input batch size is inconsistent
 }
 
+// Broadcasts with short spans, where the CPU provider expands the input that is broadcast next to the span
+TEST(MathOpTest, Add_Broadcast_ShortSpan_4x2x32x3_3) {
+  OpTester test("Add");
+
+  std::vector<float> a(4 * 2 * 32 * 3);
+  std::iota(a.begin(), a.end(), 0.0f);
+  std::vector<float> c(a.size());
+  for (size_t i = 0; i < a.size(); i++) {
+    c[i] = a[i] + 1000.0f * static_cast<float>(i % 3 + 1);
+  }
+
+  test.AddInput<float>("A", {4, 2, 32, 3}, a);
+  test.AddInput<float>("B", {3}, {1000.0f, 2000.0f, 3000.0f});
+  test.AddOutput<float>("C", {4, 2, 32, 3}, c);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+TEST(MathOpTest, Sub_Broadcast_ShortSpan_1x4x3_16x8x4x3) {
+  OpTester test("Sub");
+
+  std::vector<float> a(4 * 3);
+  std::iota(a.begin(), a.end(), 0.0f);
+  std::vector<float> b(16 * 8 * 4 * 3);
+  std::iota(b.begin(), b.end(), 0.0f);
+  std::vector<float> c(b.size());
+  for (size_t i = 0; i < b.size(); i++) {
+    c[i] = a[i % a.size()] - b[i];
+  }
+
+  test.AddInput<float>("A", {1, 4, 3}, a);
+  test.AddInput<float>("B", {16, 8, 4, 3}, b);
+  test.AddOutput<float>("C", {16, 8, 4, 3}, c);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 // Validate runtime failure has useful error message when ORT_ENFORCE is used
 TEST(MathOpTest, Add_Invalid_Broadcast) {
   OpTester test("Add");
@@ -247,6 +247,37 @@ TEST(MatmulIntegerOpTest, MatMulInteger_int8_t_No_Zero_Point) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
 }
 
+TEST(MatmulIntegerOpTest, MatMulInteger_PerColumn_ZeroPoint) {
+  OpTester test("MatMulInteger", 10);
+  test.AddInput<uint8_t>("T1", {4, 3}, {11, 7, 3, 10, 6, 2, 9, 5, 1, 8, 4, 0});
+  test.AddInput<uint8_t>("T2", {3, 2}, {1, 4, 2, 5, 3, 6});
+  test.AddInput<uint8_t>("a_zero_point", {}, {12});
+  test.AddInput<uint8_t>("b_zero_point", {2}, {1, 4});
+  test.AddOutput<int32_t>("T3", {4, 2}, {-23, -23, -26, -26, -29, -29, -32, -32});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kNupharExecutionProvider});
+}
+
+TEST(MatmulIntegerOpTest, MatMulInteger_Int8_Int8_PerColumn_ZeroPoint) {
+  OpTester test("MatMulInteger", 10);
+  test.AddInput<int8_t>("T1",
+                        {2, 4},
+                        {-3, 7, 5, -6,
+                         4, -5, 8, 7});
+  test.AddInput<int8_t>("T2",
+                        {4, 4},
+                        {5, -3, 7, 8,
+                         -6, -8, -3, 6,
+                         7, 9, 9, -5,
+                         8, 7, -6, 7});
+  test.AddInput<int8_t>("a_zero_point", {}, {5});
+  test.AddInput<int8_t>("b_zero_point", {4}, {5, -3, 0, 2});
+  test.AddOutput<int32_t>("T3",
+                          {2, 4},
+                          {-55, -120, 4, -95,
+                           122, 106, 38, -57});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kNupharExecutionProvider});
+}
+
 TEST(MatmulIntegerOpTest, MatMulInteger_WithZero_ZeroPoint) {
   OpTester test("MatMulInteger", 10);
   test.AddInput<uint8_t>("T1", {4, 3}, {11, 7, 3, 10, 6, 2, 9, 5, 1, 8, 4, 0});
@@ -3,6 +3,8 @@
 
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
 namespace test {
@@ -125,6 +127,83 @@ TEST(MathOpTest, MatMulFloatType) {
   RunMatMulTest<float>(7, true);
 }
 
+// B is constant and mostly zero so that it is packed for the block sparse kernel
+TEST(MathOpTest, MatMulFloatSparseConstantB) {
+  constexpr int64_t batch = 3, M = 5, K = 20, N = 40;
+
+  std::vector<float> a_vals(batch * M * K);
+  for (size_t i = 0; i < a_vals.size(); i++) {
+    a_vals[i] = static_cast<float>(static_cast<int>(i % 7) - 3);
+  }
+
+  // keep one in eight rows of each 16 column block. N isn't a multiple of the block width.
+  std::vector<float> b_vals(K * N, 0.0f);
+  for (int64_t k = 0; k < K; k++) {
+    for (int64_t n = 0; n < N; n++) {
+      if ((k + n / 16) % 8 == 0) {
+        b_vals[k * N + n] = static_cast<float>(static_cast<int>((k * N + n) % 5) - 2);
+      }
+    }
+  }
+
+  std::vector<float> y_vals(batch * M * N, 0.0f);
+  for (int64_t m = 0; m < batch * M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      for (int64_t k = 0; k < K; k++) {
+        y_vals[m * N + n] += a_vals[m * K + k] * b_vals[k * N + n];
+      }
+    }
+  }
+
+  OpTester test("MatMul", 13);
+  test.AddInput<float>("A", {batch, M, K}, a_vals);
+  test.AddInput<float>("B", {K, N}, b_vals, true);
+  test.AddOutput<float>("Y", {batch, M, N}, y_vals);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+// B is constant and pre-packed in half precision. The values are exact in FP16 and BF16.
+TEST(MathOpTest, MatMulFloatHalfPrecisionConstantB) {
+  constexpr int64_t batch = 2, M = 3, K = 300, N = 40;
+
+  std::vector<float> a_vals(batch * M * K);
+  for (size_t i = 0; i < a_vals.size(); i++) {
+    a_vals[i] = static_cast<float>(static_cast<int>(i % 7) - 3);
+  }
+
+  std::vector<float> b_vals(K * N);
+  for (size_t i = 0; i < b_vals.size(); i++) {
+    b_vals[i] = static_cast<float>(static_cast<int>(i % 5) - 2) * 0.5f;
+  }
+
+  std::vector<float> y_vals(batch * M * N, 0.0f);
+  for (int64_t m = 0; m < batch * M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      for (int64_t k = 0; k < K; k++) {
+        y_vals[m * N + n] += a_vals[m * K + k] * b_vals[k * N + n];
+      }
+    }
+  }
+
+  for (const char* precision : {"FP16", "BF16"}) {
+    SCOPED_TRACE(precision);
+    OpTester test("MatMul", 13);
+    test.AddInput<float>("A", {batch, M, K}, a_vals);
+    test.AddInput<float>("B", {K, N}, b_vals, true);
+    test.AddOutput<float>("Y", {batch, M, N}, y_vals);
+
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.AddConfigEntry(kOrtSessionOptionsConfigCpuGemmWeightPrecision, precision));
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  }
+}
+
 TEST(MathOpTest, MatMulDoubleType) {
   RunMatMulTest<double>(7);
 }
@@ -145,5 +224,55 @@ TEST(MathOpTest, MatMulUint64Type) {
   RunMatMulTest<uint64_t>(9);
 }
 
+template <typename T>
+std::vector<T> FloatsToHalfType(const std::vector<float>& f);
+
+template <>
+std::vector<MLFloat16> FloatsToHalfType(const std::vector<float>& f) {
+  return FloatsToMLFloat16s(f);
+}
+
+template <>
+std::vector<BFloat16> FloatsToHalfType(const std::vector<float>& f) {
+  std::vector<BFloat16> result;
+  for (auto v : f) {
+    result.push_back(BFloat16(v));
+  }
+  return result;
+}
+
+// the test values and results are integers that MLFloat16 and BFloat16 represent exactly
+template <typename T>
+void RunMatMulHalfTest(int32_t opset_version, bool is_b_constant) {
+  std::vector<float> common_input_vals{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+  for (auto t : GenerateTestCases<float>()) {
+    OpTester test("MatMul", opset_version);
+
+    int64_t size0 = TensorShape::ReinterpretBaseType(t.input0_dims).SizeHelper(0, t.input0_dims.size());
+    std::vector<float> input0_vals(common_input_vals.cbegin(), common_input_vals.cbegin() + size0);
+    test.AddInput<T>("A", t.input0_dims, FloatsToHalfType<T>(input0_vals));
+
+    int64_t size1 = TensorShape::ReinterpretBaseType(t.input1_dims).SizeHelper(0, t.input1_dims.size());
+    std::vector<float> input1_vals(common_input_vals.cbegin(), common_input_vals.cbegin() + size1);
+    test.AddInput<T>("B", t.input1_dims, FloatsToHalfType<T>(input1_vals), is_b_constant);
+
+    test.AddOutput<T>("Y", t.expected_dims, FloatsToHalfType<T>(t.expected_vals));
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  }
+}
+
+TEST(MathOpTest, MatMulFloat16Type) {
+  RunMatMulHalfTest<MLFloat16>(9, false);
+  RunMatMulHalfTest<MLFloat16>(13, true);
+}
+
+TEST(MathOpTest, MatMulBFloat16Type) {
+  RunMatMulHalfTest<BFloat16>(13, false);
+  RunMatMulHalfTest<BFloat16>(13, true);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -45,6 +45,33 @@ TEST(QuantizeLinearMatmulOpTest, QLinearMatMul3D_U8U8) {
   test.Run();
 }
 
+TEST(QuantizeLinearMatmulOpTest, QLinearMatMul2D_U8U8_PerColumn) {
+  OpTester test("QLinearMatMul", 10);
+  test.AddInput<uint8_t>("T1", {2, 4},
+                         {208, 236, 0, 238,
+                          3, 214, 255, 29});
+
+  test.AddInput<float>("a_scale", {}, {0.0066f});
+  test.AddInput<uint8_t>("a_zero_point", {}, {113});
+
+  test.AddInput<uint8_t>("T2", {4, 3},
+                         {152, 51, 244,
+                          60, 26, 255,
+                          0, 127, 246,
+                          127, 254, 247});
+
+  test.AddInput<float>("b_scale", {3}, {0.00705f, 0.0068f, 0.0071f});
+  test.AddInput<uint8_t>("b_zero_point", {3}, {114, 120, 110});
+
+  test.AddInput<float>("y_scale", {}, {0.0107f});
+  test.AddInput<uint8_t>("y_zero_point", {}, {118});
+  test.AddOutput<uint8_t>("T3", {2, 3},
+                          {168, 109, 255,
+                           1, 67, 152});
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kNupharExecutionProvider});
+}
+
 TEST(QuantizeLinearMatmulOpTest, QLinearMatMul3D_U8S8) {
   OpTester test("QLinearMatMul", 10);
   test.AddInput<uint8_t>("T1", {2, 2, 4},
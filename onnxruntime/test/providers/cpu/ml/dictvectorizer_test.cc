@@ -42,5 +42,24 @@ TEST(MLOpTest, DictVectorizerInt64Input) {
   test.Run();
 }
 
+TEST(MLOpTest, DictVectorizerUnsortedVocabulary) {
+  OpTester test("DictVectorizer", 1, onnxruntime::kMLDomain);
+
+  // the vocabulary isn't sorted, has a duplicate and contains keys that are not in the map and vice versa
+  test.AddAttribute("int64_vocabulary", std::vector<int64_t>{7, 3, 5, 3, 1});
+
+  std::map<int64_t, float> map;
+  map[0] = 10.f;
+  map[3] = 30.f;
+  map[5] = 50.f;
+  map[9] = 90.f;
+
+  test.AddInput<int64_t, float>("X", map);
+
+  std::vector<int64_t> dims{1, 5};
+  test.AddOutput<float>("Y", dims, {0.f, 30.f, 50.f, 30.f, 0.f});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
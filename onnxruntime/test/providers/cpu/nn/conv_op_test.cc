@@ -713,5 +713,55 @@ TEST(ConvTest, Conv_AutoPad_with_non_default_strides) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, true);
 }
 
+
+// A constant 3x3 filter with enough channels is transformed by PrePack for the
+// Winograd algorithm.
+TEST(ConvTest, Conv2D_WinogradInitializer) {
+  const int64_t C = 32, M = 40, H = 5, W = 6;
+
+  vector<float> X_data(C * H * W);
+  for (size_t i = 0; i < X_data.size(); i++) {
+    X_data[i] = static_cast<float>(static_cast<int>(i % 7) - 3);
+  }
+  vector<float> W_data(M * C * 3 * 3);
+  for (size_t i = 0; i < W_data.size(); i++) {
+    W_data[i] = static_cast<float>(static_cast<int>(i % 5) - 2);
+  }
+  vector<float> B_data(M);
+  for (size_t i = 0; i < B_data.size(); i++) {
+    B_data[i] = static_cast<float>(i % 3);
+  }
+
+  vector<float> Y_data(M * H * W);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t oh = 0; oh < H; oh++) {
+      for (int64_t ow = 0; ow < W; ow++) {
+        float sum = B_data[m];
+        for (int64_t c = 0; c < C; c++) {
+          for (int64_t kh = 0; kh < 3; kh++) {
+            for (int64_t kw = 0; kw < 3; kw++) {
+              const int64_t ih = oh + kh - 1;
+              const int64_t iw = ow + kw - 1;
+              if (ih >= 0 && ih < H && iw >= 0 && iw < W) {
+                sum += X_data[(c * H + ih) * W + iw] * W_data[((m * C + c) * 3 + kh) * 3 + kw];
+              }
+            }
+          }
+        }
+        Y_data[(m * H + oh) * W + ow] = sum;
+      }
+    }
+  }
+
+  OpTester test("Conv", 11);
+  test.AddAttribute("kernel_shape", vector<int64_t>{3, 3});
+  test.AddAttribute("pads", vector<int64_t>{1, 1, 1, 1});
+  test.AddInput<float>("X", {1, C, H, W}, X_data);
+  test.AddInput<float>("W", {M, C, 3, 3}, W_data, true);
+  test.AddInput<float>("B", {M}, B_data, true);
+  test.AddOutput<float>("Y", {1, M, H, W}, Y_data);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -575,6 +575,83 @@ TEST(ConvTransposeTest, ConvTranspose_2D_NonDefaultStridesAndDilations) {
   TestConvTransposeOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape);
 }
 
+// 4x4 kernels with 2x2 strides are computed without the column buffer, by the phases of the output pixels
+TEST(ConvTransposeTest, ConvTranspose_2D_Stride2Kernel4) {
+  ConvTransposeOpAttributes attrs = {
+      vector<int64_t>{4, 4},        // kernel_shape
+      {},                           // output_padding
+      {},                           // output_shape
+      vector<int64_t>{1, 1, 1, 1},  // pads
+      vector<int64_t>{2, 2},        // strides
+      vector<int64_t>{1, 1},        // dilations
+      1,                            // group
+      "NOTSET"                      // auto_pad
+  };
+  vector<float> X(18);
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = 0.1f * i;
+  }
+  vector<int64_t> X_shape = {1, 2, 3, 3};
+  vector<float> W(64);
+  for (size_t i = 0; i < W.size(); ++i) {
+    W[i] = 0.1f * (static_cast<int>(i % 7) - 3);
+  }
+  vector<int64_t> W_shape = {2, 2, 4, 4};
+  vector<float> B = {0.5f, -0.5f};
+  vector<int64_t> B_shape = {2};
+  vector<int64_t> Y_shape = {1, 2, 6, 6};
+  auto expected_vals = {
+      0.41f, 0.31f, 0.51f, 0.33f, 0.5f, 0.56f,
+      0.95f, 0.75f, 0.43f, 0.72f, 0.41f, 0.54f,
+      0.44f, 0.38f, 0.69f, 0.39f, 0.71f, 0.7f,
+      1.01f, 0.66f, 0.37f, 0.63f, 0.35f, 0.51f,
+      0.56f, 0.41f, 0.75f, 0.42f, 0.77f, 0.73f,
+      0.89f, 0.23f, 0.67f, 0.2f, 0.68f, -0.01f,
+      -0.41f, -0.29f, -0.16f, -0.26f, -0.16f, -0.32f,
+      -1.04f, -0.75f, -1.14f, -0.76f, -1.14f, -0.8f,
+      -0.29f, 0.14f, -0.25f, 0.17f, -0.28f, -0.01f,
+      -1.16f, -0.78f, -1.14f, -0.79f, -1.14f, -0.8f,
+      -0.35f, 0.23f, -0.34f, 0.26f, -0.37f, 0.05f,
+      -0.74f, -1.01f, -0.57f, -1.03f, -0.55f, -0.51f};
+
+  TestConvTransposeOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+}
+
+TEST(ConvTransposeTest, ConvTranspose_2D_Stride2Kernel4_Group_AsymmetricPads) {
+  ConvTransposeOpAttributes attrs = {
+      vector<int64_t>{4, 4},        // kernel_shape
+      {},                           // output_padding
+      {},                           // output_shape
+      vector<int64_t>{0, 1, 2, 1},  // pads
+      vector<int64_t>{2, 2},        // strides
+      vector<int64_t>{1, 1},        // dilations
+      2,                            // group
+      "NOTSET"                      // auto_pad
+  };
+  vector<float> X(8);
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = 0.25f * i - 1.0f;
+  }
+  vector<int64_t> X_shape = {1, 2, 2, 2};
+  vector<float> W(32);
+  for (size_t i = 0; i < W.size(); ++i) {
+    W[i] = 0.5f * (static_cast<int>(i % 5) - 2);
+  }
+  vector<int64_t> W_shape = {2, 1, 4, 4};
+  vector<int64_t> Y_shape = {1, 2, 4, 4};
+  auto expected_vals = {
+      0.5f, 0.75f, -0.125f, 0.0f,
+      1.0f, -0.25f, 0.75f, 0.375f,
+      -0.75f, 0.875f, -0.375f, 0.75f,
+      0.0f, -1.0f, 0.875f, -0.625f,
+      0.0f, -0.125f, 0.0f, 0.125f,
+      0.0f, -0.25f, -0.125f, 0.0f,
+      0.0f, 0.125f, 0.25f, 0.25f,
+      -0.25f, -0.625f, 0.125f, -0.25f};
+
+  TestConvTransposeOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape);
+}
+
 TEST(ConvTransposeTest, DimWithZero) {
   ConvTransposeOpAttributes attrs = {
       vector<int64_t>{3, 3},        // kernel_shape
@@ -274,6 +274,7 @@ class QLinearConvOpTester {
   std::default_random_engine generator_{1234};
   QuantizedTensor<T1> X_;
   QuantizedTensor<T2> W_;
+  std::vector<T2> W_zero_points_;
   std::vector<int32_t> B_;
   std::vector<int64_t> pads_;
   std::vector<int64_t> strides_;
@@ -399,7 +400,6 @@ class QLinearConvOpTester {
     const int64_t kernel_size = std::accumulate(
         kernel_shape, kernel_shape + kernel_rank, 1LL, std::multiplies<int64_t>());
     const int32_t X_zero_point = X_.zero_point_;
-    const int32_t W_zero_point = W_.zero_point_;
 
     const T1* Xdata = X_.data_.data();
     T1* Ydata = Y_data.data();
@@ -416,6 +416,7 @@ class QLinearConvOpTester {
           int32_t bias = B_.empty() ? 0 : B_[channel_index];
           float weight_scale = W_.scale_[(W_.scale_.size() == 1) ? 0 : channel_index];
           float requantize_scale = (X_.scale_[0] * weight_scale) / output_scale_;
+          const int32_t W_zero_point = W_zero_points_.empty() ? W_.zero_point_ : W_zero_points_[channel_index];
 
           std::vector<int64_t> d_output(kernel_rank, 0);
           std::vector<int64_t> d_kernel(kernel_rank, 0);
@@ -469,7 +470,12 @@ class QLinearConvOpTester {
     const std::vector<int64_t> W_scale_shape{static_cast<int64_t>(W_.scale_.size())};
     test.AddInput<T2>("w", W_.shape_, W_.data_, all_input_initializer_except_x);
     test.AddInput<float>("w_scale", W_scale_shape, W_.scale_, all_input_initializer_except_x);
-    test.AddInput<T2>("w_zero_point", {}, {W_.zero_point_}, all_input_initializer_except_x);
+    if (W_zero_points_.empty()) {
+      test.AddInput<T2>("w_zero_point", {}, {W_.zero_point_}, all_input_initializer_except_x);
+    } else {
+      const std::vector<int64_t> W_zero_point_shape{static_cast<int64_t>(W_zero_points_.size())};
+      test.AddInput<T2>("w_zero_point", W_zero_point_shape, W_zero_points_, all_input_initializer_except_x);
+    }
 
     test.AddInput<float>("y_scale", {}, {output_scale_}, all_input_initializer_except_x);
     test.AddInput<T1>("y_zero_point", {}, {output_zero_point_}, all_input_initializer_except_x);
@@ -533,6 +539,10 @@ class QLinearConvOpTester {
     W_.scale_ = scales;
   }
 
+  void SetWeightZeroPoints(const std::vector<T2>& zero_points) {
+    W_zero_points_ = zero_points;
+  }
+
   void GenerateRandomBias() {
     ORT_ENFORCE(W_.shape_.size() >= 1);
     const size_t output_channels = static_cast<size_t>(W_.shape_[0]);
@@ -736,6 +746,37 @@ TEST(QLinearConvTest, Conv2D_U8S8_Groups_PerChannel) {
   test.Run();
 }
 
+TEST(QLinearConvTest, Conv2D_U8U8_Groups_PerChannelZeroPoints) {
+  QLinearConvOpTester<uint8_t, uint8_t> test;
+  test.GenerateRandomInput({1, 8, 13, 17}, .03f, 7);
+  test.GenerateRandomWeights({10, 4, 3, 3}, .10f, 0);
+  test.SetWeightScales({.15f, .14f, .11f, .13f, .15f, .09f, .12f, .16f, .17f, .07f});
+  test.SetWeightZeroPoints({128, 120, 135, 127, 131, 122, 129, 140, 118, 126});
+  test.GenerateRandomBias();
+  test.SetPads({1, 1, 1, 1});
+  test.SetGroups(2);
+  test.SetOutputScaleAndZeroPoint(.76f, 88);
+  test.Run();
+}
+
+TEST(QLinearConvTest, Conv2D_U8S8_Depthwise_PerChannelZeroPoints) {
+  for (int64_t channels : std::initializer_list<int64_t>{7, 8, 9, 16, 25}) {
+    QLinearConvOpTester<uint8_t, int8_t> test;
+    test.GenerateRandomInput({1, channels, 25, 25}, .03f, 12);
+    test.GenerateRandomWeights({channels, 1, 5, 5}, .10f, 0);
+    std::vector<int8_t> zero_points(static_cast<size_t>(channels));
+    for (size_t c = 0; c < zero_points.size(); c++) {
+      zero_points[c] = static_cast<int8_t>(static_cast<int>(c % 7) - 3);
+    }
+    test.SetWeightZeroPoints(zero_points);
+    test.GenerateRandomBias();
+    test.SetPads({2, 2, 2, 2});
+    test.SetGroups(channels);
+    test.SetOutputScaleAndZeroPoint(.76f, 88);
+    test.Run();
+  }
+}
+
 TEST(QLinearConvTest, Conv2D_U8S8_Depthwise) {
   for (int64_t channels : std::initializer_list<int64_t>{7, 8, 9, 16, 25}) {
     QLinearConvOpTester<uint8_t, int8_t> test;
@@ -1259,6 +1259,52 @@ TEST(ReductionOpTest, ReduceSum_axes02) {
   test.Run();
 }
 
+// Reduces a middle axis where the inner dimension spans several column blocks.
+TEST(ReductionOpTest, ReduceSum_middle_axis_wide) {
+  const int64_t outer = 2, reduce = 5, inner = 37;
+  std::vector<float> data(outer * reduce * inner);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(static_cast<int>(i % 13) - 6);
+  }
+  std::vector<float> expected(outer * inner, 0.0f);
+  for (int64_t o = 0; o < outer; ++o) {
+    for (int64_t r = 0; r < reduce; ++r) {
+      for (int64_t n = 0; n < inner; ++n) {
+        expected[o * inner + n] += data[(o * reduce + r) * inner + n];
+      }
+    }
+  }
+
+  OpTester test("ReduceSum");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {outer, reduce, inner}, data);
+  test.AddOutput<float>("reduced", {outer, inner}, expected);
+  test.Run();
+}
+
+// Reduces the leading axes of a tensor with a unit dimension between them.
+TEST(ReductionOpTest, ReduceMax_leading_axes) {
+  const int64_t reduce = 7, inner = 21;
+  std::vector<float> data(reduce * inner);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>((i * 37) % 101) - 50.0f;
+  }
+  std::vector<float> expected(inner, std::numeric_limits<float>::lowest());
+  for (int64_t r = 0; r < reduce; ++r) {
+    for (int64_t n = 0; n < inner; ++n) {
+      expected[n] = std::max(expected[n], data[r * inner + n]);
+    }
+  }
+
+  OpTester test("ReduceMax");
+  test.AddAttribute("axes", std::vector<int64_t>{0, 1});
+  test.AddAttribute("keepdims", (int64_t)1);
+  test.AddInput<float>("data", {reduce, 1, inner}, data);
+  test.AddOutput<float>("reduced", {1, 1, inner}, expected);
+  test.Run();
+}
+
 TEST(ReductionOpTest, ReduceSum_int32) {
   OpTester test("ReduceSum");
   test.AddAttribute("axes", std::vector<int64_t>{0, 2});
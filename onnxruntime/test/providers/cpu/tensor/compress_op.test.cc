@@ -171,5 +171,26 @@ TEST(CompressTest, Compress_3dims_neg_axis) {
   test.Run();
 }
 
+TEST(CompressTest, Compress_large) {
+  // large enough for the condition to be split into blocks
+  const int64_t size = 100000;
+  std::vector<int64_t> input(size);
+  std::unique_ptr<bool[]> condition(new bool[size]);
+  std::vector<int64_t> output;
+  for (int64_t i = 0; i < size; ++i) {
+    input[i] = i;
+    condition[i] = i % 3 == 0;
+    if (condition[i]) {
+      output.push_back(i);
+    }
+  }
+
+  OpTester test("Compress", 11);
+  test.AddInput<int64_t>("input", {size}, input);
+  test.AddInput<bool>("condition", {size}, condition.get(), static_cast<size_t>(size));
+  test.AddOutput<int64_t>("output", {static_cast<int64_t>(output.size())}, output);
+  test.Run();
+}
+
 }  // namespace Test
 }  // namespace onnxruntime
@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/tensor/copy.h"
+
+#include <numeric>
+
+#include "core/common/make_unique.h"
+#include "core/platform/env.h"
+#include "core/platform/threadpool.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(StridedCopyTest, BroadcastAndTranspose) {
+  // a [2, 3] input expanded to [2, 2, 3] and transposed to [3, 2, 2]
+  const std::vector<float> input{0.f, 1.f, 2.f, 3.f, 4.f, 5.f};
+  std::vector<float> output(12);
+  StridedCopy(nullptr, output.data(), {1, 2, 4}, input.data(), {0, 3, 1}, {2, 2, 3});
+
+  const std::vector<float> expected{0.f, 0.f, 3.f, 3.f, 1.f, 1.f, 4.f, 4.f, 2.f, 2.f, 5.f, 5.f};
+  EXPECT_EQ(output, expected);
+}
+
+TEST(StridedCopyTest, EmptyAndScalar) {
+  const std::vector<int64_t> input{42};
+  std::vector<int64_t> output{0};
+  StridedCopy(nullptr, output.data(), {1, 1}, input.data(), {1, 1}, {3, 0});
+  EXPECT_EQ(output[0], 0);
+
+  StridedCopy(nullptr, output.data(), {}, input.data(), {}, {});
+  EXPECT_EQ(output[0], 42);
+}
+
+TEST(StridedCopyTest, Strings) {
+  const std::vector<std::string> input{"a", "bb", "ccc"};
+  std::vector<std::string> output(6);
+  StridedCopy(nullptr, output.data(), {3, 1}, input.data(), {0, 1}, {2, 3});
+
+  const std::vector<std::string> expected{"a", "bb", "ccc", "a", "bb", "ccc"};
+  EXPECT_EQ(output, expected);
+}
+
+TEST(StridedCopyTest, LargeCopiesInParallel) {
+  auto thread_pool = onnxruntime::make_unique<concurrency::ThreadPool>(&Env::Default(), ThreadOptions(), nullptr, 4,
+                                                                       true);
+
+  // large enough to be split into blocks and written with streaming stores, and offset from the alignment of the
+  // buffers so that the copies have unaligned heads and tails
+  const int64_t size = 5 * 1024 * 1024 + 3;
+  std::vector<int32_t> input(size + 1);
+  std::iota(input.begin(), input.end(), 0);
+  std::vector<int32_t> output(size + 1, -1);
+  StridedCopy(thread_pool.get(), output.data() + 1, {1}, input.data(), {1}, {size});
+  EXPECT_EQ(output[0], -1);
+  EXPECT_TRUE(std::equal(input.begin(), input.begin() + size, output.begin() + 1));
+
+  // concatenate two [rows, 3] inputs on axis 1, with the first input offset by 1 byte
+  const int64_t rows = 1024 * 1024;
+  std::vector<uint8_t> first(rows * 3 + 1);
+  std::vector<uint8_t> second(rows * 3);
+  for (int64_t i = 0; i < rows * 3; ++i) {
+    first[i + 1] = static_cast<uint8_t>(i);
+    second[i] = static_cast<uint8_t>(i + 7);
+  }
+  std::vector<uint8_t> concatenated(rows * 6);
+  StridedCopy(thread_pool.get(), concatenated.data(), {6, 1}, first.data() + 1, {3, 1}, {rows, 3});
+  StridedCopy(thread_pool.get(), concatenated.data() + 3, {6, 1}, second.data(), {3, 1}, {rows, 3});
+  for (int64_t row = 0; row < rows; ++row) {
+    for (int64_t col = 0; col < 3; ++col) {
+      ASSERT_EQ(concatenated[row * 6 + col], first[row * 3 + col + 1]);
+      ASSERT_EQ(concatenated[row * 6 + 3 + col], second[row * 3 + col]);
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
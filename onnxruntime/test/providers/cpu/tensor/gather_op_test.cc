@@ -286,6 +286,22 @@ TEST(GatherOpTest, Gather_axis1_indices2d_string) {
   test.Run();
 }
 
+TEST(GatherOpTest, Gather_axis0_string_rows) {
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<std::string>("data", {3, 2},
+                             {"00", "01",
+                              "10", "11",
+                              "20", "21"});
+  test.AddInput<int64_t>("indices", {3},
+                         {2, 0, -1});
+  test.AddOutput<std::string>("output", {3, 2},
+                              {"20", "21",
+                               "00", "01",
+                               "20", "21"});
+  test.Run();
+}
+
 TEST(GatherOpTest, Gather_axis1_indices2d_bool) {
   OpTester test("Gather");
   test.AddAttribute<int64_t>("axis", 1LL);
@@ -93,5 +93,29 @@ TEST(NonZeroOpTest, EmptyInput) {
   test.Run();
 }
 
+TEST(NonZeroOpTest, LargeInput) {
+  // large enough for the input to be split into blocks
+  const std::vector<int64_t> X_dims{200, 500};
+  std::vector<int32_t> X(200 * 500);
+  std::vector<int64_t> rows, columns;
+  for (int64_t i = 0; i < 200; ++i) {
+    for (int64_t j = 0; j < 500; ++j) {
+      const bool non_zero = (i * 500 + j) % 7 == 3;
+      X[i * 500 + j] = non_zero ? static_cast<int32_t>(j) + 1 : 0;
+      if (non_zero) {
+        rows.push_back(i);
+        columns.push_back(j);
+      }
+    }
+  }
+  std::vector<int64_t> Y(rows);
+  Y.insert(Y.end(), columns.begin(), columns.end());
+
+  OpTester test{kOpName, kOpVersion};
+  test.AddInput<int32_t>("X", X_dims, X);
+  test.AddOutput<int64_t>("Y", {2, static_cast<int64_t>(rows.size())}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
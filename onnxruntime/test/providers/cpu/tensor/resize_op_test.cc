@@ -886,6 +886,43 @@ TEST(ResizeOpTest, ResizeOpCubicDownSampleTest_with_roi) {
   test.Run();
 }
 
+TEST(ResizeOpTest, ResizeOpCubicDownSampleTest_tf_crop_and_resize_with_extrapolation_MultiChannel) {
+  OpTester test("Resize", 13);
+  std::vector<float> scales{1.0f, 1.0f, 0.75f, 1.25f};
+  std::vector<float> roi{0.0f, 0.0f, -0.2f, 0.1f, 1.0f, 1.0f, 0.9f, 1.2f};
+
+  test.AddAttribute("mode", "cubic");
+  test.AddAttribute("coordinate_transformation_mode", "tf_crop_and_resize");
+  test.AddAttribute("extrapolation_value", 10.0f);
+
+  const int64_t N = 1, C = 2, H = 4, W = 4;
+  std::vector<float> X = {
+      1.0f, 2.0f, 3.0f, 4.0f,
+      5.0f, 6.0f, 7.0f, 8.0f,
+      9.0f, 10.0f, 11.0f, 12.0f,
+      13.0f, 14.0f, 15.0f, 16.0f,
+
+      17.0f, 18.0f, 19.0f, 20.0f,
+      21.0f, 22.0f, 23.0f, 24.0f,
+      25.0f, 26.0f, 27.0f, 28.0f,
+      29.0f, 30.0f, 31.0f, 32.0f};
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {8}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  std::vector<float> Y = {10.0f, 10.0f, 10.0f, 10.0f, 10.0f,
+                          5.51725f, 6.45151f, 7.21411f, 8.11389f, 10.0f,
+                          12.3048f, 13.239f, 14.0016f, 14.9014f, 10.0f,
+
+                          10.0f, 10.0f, 10.0f, 10.0f, 10.0f,
+                          21.5172f, 22.4515f, 23.2141f, 24.1139f, 10.0f,
+                          28.3048f, 29.239f, 30.0016f, 30.9014f, 10.0f};
+
+  test.AddOutput<float>("Y", {N, C, static_cast<int64_t>(H * scales[2]), static_cast<int64_t>(W * scales[3])}, Y);
+  test.Run();
+}
+
 TEST(ResizeOpTest, ResizeOpCubicDownSampleTest_asymmetric) {
   OpTester test("Resize", 13);
   std::vector<float> scales{1.0f, 1.0f, 0.8f, 0.8f};
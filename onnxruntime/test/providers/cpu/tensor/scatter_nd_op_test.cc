@@ -155,5 +155,59 @@ TEST(ScatterNDOpTest, ScatterND_batched_3tensor_int64) {
   test3.Run();
 }
 
+#ifndef DISABLE_CONTRIB_OPS
+
+TEST(ScatterNDOpTest, ScatterND_reduction_max_float) {
+  OpTester test("ScatterND", 1, kMSDomain);
+  test.AddAttribute<std::string>("reduction", "max");
+  test.AddInput<float>("data", {3, 2}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f});
+  test.AddInput<int64_t>("indices", {3, 1}, {2LL, 0LL, 2LL});
+  test.AddInput<float>("updates", {3, 2}, {1.0f, 7.0f, 0.0f, 1.0f, 9.0f, 3.0f});
+  test.AddOutput<float>("output", {3, 2}, {1.0f, 2.0f, 3.0f, 4.0f, 9.0f, 7.0f});
+  test.Run();
+}
+
+TEST(ScatterNDOpTest, ScatterND_reduction_add_int64) {
+  // sorted indices
+  OpTester test1("ScatterND", 1, kMSDomain);
+  test1.AddAttribute<std::string>("reduction", "add");
+  test1.AddInput<int64_t>("data", {2, 2}, {1LL, 1LL, 1LL, 1LL});
+  test1.AddInput<int64_t>("indices", {4, 2}, {0LL, 0LL, 0LL, 0LL, 0LL, 1LL, 1LL, 1LL});
+  test1.AddInput<int64_t>("updates", {4}, {2LL, 3LL, 4LL, 5LL});
+  test1.AddOutput<int64_t>("output", {2, 2}, {6LL, 5LL, 1LL, 6LL});
+  test1.Run();
+
+  // repeated indices that are not adjacent
+  OpTester test2("ScatterND", 1, kMSDomain);
+  test2.AddAttribute<std::string>("reduction", "add");
+  test2.AddInput<int64_t>("data", {3, 2}, {0LL, 0LL, 0LL, 0LL, 0LL, 0LL});
+  test2.AddInput<int64_t>("indices", {4, 1}, {1LL, 0LL, 1LL, 2LL});
+  test2.AddInput<int64_t>("updates", {4, 2}, {1LL, 2LL, 3LL, 4LL, 5LL, 6LL, 7LL, 8LL});
+  test2.AddOutput<int64_t>("output", {3, 2}, {3LL, 4LL, 6LL, 8LL, 7LL, 8LL});
+  test2.Run();
+}
+
+TEST(ScatterNDOpTest, ScatterND_reduction_mul_int32) {
+  OpTester test("ScatterND", 1, kMSDomain);
+  test.AddAttribute<std::string>("reduction", "mul");
+  test.AddInput<int32_t>("data", {2, 2, 2}, {1, 2, 3, 4, 5, 6, 7, 8});
+  test.AddInput<int64_t>("indices", {3, 2}, {1LL, 1LL, 0LL, 0LL, 1LL, 1LL});
+  test.AddInput<int32_t>("updates", {3, 2}, {2, 3, -1, 0, 10, 1});
+  test.AddOutput<int32_t>("output", {2, 2, 2}, {-1, 0, 3, 4, 5, 6, 140, 24});
+  test.Run();
+}
+
+TEST(ScatterNDOpTest, ScatterND_reduction_string_not_supported) {
+  OpTester test("ScatterND", 1, kMSDomain);
+  test.AddAttribute<std::string>("reduction", "add");
+  test.AddInput<std::string>("data", {2}, {"a", "b"});
+  test.AddInput<int64_t>("indices", {1, 1}, {0LL});
+  test.AddInput<std::string>("updates", {1}, {"c"});
+  test.AddOutput<std::string>("output", {2}, {"ac", "b"});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "reduction is only supported for float, double, int32 and int64 data");
+}
+
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
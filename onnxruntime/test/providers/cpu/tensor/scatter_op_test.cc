@@ -278,5 +278,122 @@ TEST(Scatter, SameUpdateWithoutAxis) {
   scatter_same_updates_tests("ScatterElements", 11);
 }
 
+#ifndef DISABLE_CONTRIB_OPS
+
+TEST(Scatter, ReductionAdd) {
+  OpTester test("ScatterElements", 1, kMSDomain);
+  test.AddAttribute<int64_t>("axis", 0);
+  test.AddAttribute<std::string>("reduction", "add");
+
+  test.AddInput<float>("data", {4}, {0.0f, 0.0f, 0.0f, 0.0f});
+  test.AddInput<int64_t>("indices", {5}, {0, 2, 2, 3, 0});
+  test.AddInput<float>("updates", {5}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f});
+  test.AddOutput<float>("y", {4}, {6.0f, 0.0f, 5.0f, 4.0f});
+  test.Run();
+}
+
+TEST(Scatter, ReductionMulWithAxis) {
+  OpTester test("ScatterElements", 1, kMSDomain);
+  test.AddAttribute<int64_t>("axis", 1);
+  test.AddAttribute<std::string>("reduction", "mul");
+
+  test.AddInput<double>("data", {2, 3}, {1.0, 2.0, 3.0,
+                                         4.0, 5.0, 6.0});
+  test.AddInput<int32_t>("indices", {2, 2}, {2, 2,
+                                             0, -3});
+  test.AddInput<double>("updates", {2, 2}, {2.0, 5.0,
+                                            0.5, 3.0});
+  test.AddOutput<double>("y", {2, 3}, {1.0, 2.0, 30.0,
+                                       6.0, 5.0, 6.0});
+  test.Run();
+}
+
+TEST(Scatter, ReductionMaxThreeDim) {
+  OpTester test("ScatterElements", 1, kMSDomain);
+  test.AddAttribute<int64_t>("axis", 1);
+  test.AddAttribute<std::string>("reduction", "max");
+
+  test.AddInput<int64_t>("data", {1, 3, 2}, {1, 2,
+                                             3, 4,
+                                             5, 6});
+  test.AddInput<int64_t>("indices", {1, 2, 2}, {0, 2,
+                                                0, 2});
+  test.AddInput<int64_t>("updates", {1, 2, 2}, {-1, 10,
+                                                7, 0});
+  test.AddOutput<int64_t>("y", {1, 3, 2}, {7, 2,
+                                           3, 4,
+                                           5, 10});
+  test.Run();
+}
+
+// Long sequences of sorted and of unsorted indices are split between the threads differently
+static void scatter_add_edges_tests(bool sorted) {
+  OpTester test("ScatterElements", 1, kMSDomain);
+  test.AddAttribute<int64_t>("axis", 0);
+  test.AddAttribute<std::string>("reduction", "add");
+
+  const int64_t num_nodes = 37;
+  const int64_t num_edges = 5000;
+  std::vector<int64_t> indices(num_edges);
+  std::vector<float> updates(num_edges);
+  std::vector<float> expected(num_nodes, 1.0f);
+  for (int64_t i = 0; i < num_edges; ++i) {
+    indices[i] = sorted ? i * num_nodes / num_edges : (i * 7) % num_nodes;
+    updates[i] = static_cast<float>(i % 5);
+    expected[indices[i]] += updates[i];
+  }
+
+  test.AddInput<float>("data", {num_nodes}, std::vector<float>(num_nodes, 1.0f));
+  test.AddInput<int64_t>("indices", {num_edges}, indices);
+  test.AddInput<float>("updates", {num_edges}, updates);
+  test.AddOutput<float>("y", {num_nodes}, expected);
+  test.Run();
+}
+
+TEST(Scatter, ReductionAddSortedIndices) {
+  scatter_add_edges_tests(true);
+}
+
+TEST(Scatter, ReductionAddUnsortedIndices) {
+  scatter_add_edges_tests(false);
+}
+
+TEST(Scatter, ReductionNoneMatchesOnnxOp) {
+  OpTester test("ScatterElements", 1, kMSDomain);
+  test.AddAttribute<int64_t>("axis", 1);
+
+  test.AddInput<float>("data", {1, 5}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f});
+  test.AddInput<int64_t>("indices", {1, 2}, {1, 3});
+  test.AddInput<float>("updates", {1, 2}, {1.1f, 2.1f});
+  test.AddOutput<float>("y", {1, 5}, {1.0f, 1.1f, 3.0f, 2.1f, 5.0f});
+  test.Run();
+}
+
+TEST(Scatter, ReductionUnsupportedType) {
+  OpTester test("ScatterElements", 1, kMSDomain);
+  test.AddAttribute<int64_t>("axis", 0);
+  test.AddAttribute<std::string>("reduction", "add");
+
+  test.AddInput<uint8_t>("data", {2}, {1, 2});
+  test.AddInput<int64_t>("indices", {1}, {0});
+  test.AddInput<uint8_t>("updates", {1}, {3});
+  test.AddOutput<uint8_t>("y", {2}, {4, 2});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "reduction is only supported for float, double, int32 and int64 data");
+}
+
+TEST(Scatter, InvalidReduction) {
+  OpTester test("ScatterElements", 1, kMSDomain);
+  test.AddAttribute<int64_t>("axis", 0);
+  test.AddAttribute<std::string>("reduction", "min");
+
+  test.AddInput<float>("data", {2}, {1.0f, 2.0f});
+  test.AddInput<int64_t>("indices", {1}, {0});
+  test.AddInput<float>("updates", {1}, {3.0f});
+  test.AddOutput<float>("y", {2}, {1.0f, 2.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Invalid 'reduction' attribute value: min");
+}
+
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -289,6 +289,44 @@ TEST(TensorOpTest, CastFromFloat16) {
   TestCastOp(input, int64_t_data, shape, TensorProto::INT64);
 }
 
+template <typename SrcType, typename DstType>
+void TestCastOp(const std::vector<SrcType>& input, const std::vector<DstType>& output, int64_t toType) {
+  OpTester test("Cast", 13);
+  test.AddAttribute("to", toType);
+  test.AddInput<SrcType>("input", {static_cast<int64_t>(input.size())}, input);
+  test.AddOutput<DstType>("output", {static_cast<int64_t>(output.size())}, output);
+  test.Run(ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+TEST(TensorOpTest, CastLargeTensors) {
+  // large enough to be cast in parallel, and not a multiple of the vector width
+  const size_t size = 100003;
+
+  std::vector<float> float_data(size);
+  std::vector<MLFloat16> float16_data(size);
+  std::vector<BFloat16> bfloat16_data(size);
+  std::vector<float> bfloat16_float_data(size);
+  std::vector<int32_t> int32_data(size);
+  for (size_t i = 0; i < size; ++i) {
+    // exactly representable in float16, but not always in bfloat16
+    const float value = static_cast<float>(static_cast<int>(i % 4096) - 2048) * 0.5f;
+    float_data[i] = value;
+    float16_data[i] = MLFloat16(math::floatToHalf(value));
+    bfloat16_data[i] = BFloat16(value);
+    bfloat16_float_data[i] = bfloat16_data[i].ToFloat();
+    int32_data[i] = static_cast<int32_t>(value);
+  }
+
+  TestCastOp(float_data, float16_data, TensorProto::FLOAT16);
+  TestCastOp(float16_data, float_data, TensorProto::FLOAT);
+  TestCastOp(float16_data, int32_data, TensorProto::INT32);
+  TestCastOp(int32_data, float16_data, TensorProto::FLOAT16);
+  TestCastOp(int32_data, float_data, TensorProto::FLOAT);
+  TestCastOp(float_data, bfloat16_data, TensorProto::BFLOAT16);
+  TestCastOp(float16_data, bfloat16_data, TensorProto::BFLOAT16);
+  TestCastOp(bfloat16_data, bfloat16_float_data, TensorProto::FLOAT);
+}
+
 TEST(TensorOpTest, CastFromString) {
   const std::vector<int64_t> shape{2, 2, 2};
   std::initializer_list<std::string> string_data = {"-inf", "+INF", "0.9767611", "0.28280696",
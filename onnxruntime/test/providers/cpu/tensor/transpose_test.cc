@@ -21,6 +21,26 @@ TEST(TransposeOpTest, IsTransposeReshapeTest) {
   ASSERT_FALSE(IsTransposeReshape(perm, input_dims));
 }
 
+TEST(TransposeOpTest, CanonicalizeTransposeTest) {
+  std::vector<int64_t> input_dims{2, 1, 3, 4, 5};
+  std::vector<size_t> perm{0, 2, 3, 1, 4};
+  CanonicalizeTranspose(perm, input_dims);
+  ASSERT_EQ(input_dims, (std::vector<int64_t>{120}));
+  ASSERT_EQ(perm, (std::vector<size_t>{0}));
+
+  input_dims = std::vector<int64_t>{2, 3, 4, 5};
+  perm = std::vector<size_t>{0, 3, 1, 2};
+  CanonicalizeTranspose(perm, input_dims);
+  ASSERT_EQ(input_dims, (std::vector<int64_t>{2, 12, 5}));
+  ASSERT_EQ(perm, (std::vector<size_t>{0, 2, 1}));
+
+  input_dims = std::vector<int64_t>{1, 3, 1, 5};
+  perm = std::vector<size_t>{3, 2, 1, 0};
+  CanonicalizeTranspose(perm, input_dims);
+  ASSERT_EQ(input_dims, (std::vector<int64_t>{3, 5}));
+  ASSERT_EQ(perm, (std::vector<size_t>{1, 0}));
+}
+
 // Some of the tests can't run on TensorrtExecutionProvider because of errors.
 // Those tests will fallback to other EPs.
 
@@ -568,6 +588,53 @@ TEST(TransposeOpTest, DoTransposeEltWise) {
   }
 }
 
+// Transposes large enough to use the tiled batched matrix transposes, checked against the naive results.
+template <typename T>
+static void TestBatchedMatrixTranspose(const std::vector<int64_t>& x_dims, const std::vector<int64_t>& perm) {
+  const size_t rank = x_dims.size();
+  std::vector<int64_t> y_dims(rank);
+  for (size_t i = 0; i < rank; i++) {
+    y_dims[i] = x_dims[perm[i]];
+  }
+
+  const TensorShape x_shape(x_dims);
+  const TensorShape y_shape(y_dims);
+  std::vector<T> x_data(static_cast<size_t>(x_shape.Size()));
+  for (size_t i = 0; i < x_data.size(); i++) {
+    x_data[i] = static_cast<T>(i % 251);
+  }
+
+  std::vector<T> y_data(x_data.size());
+  std::vector<int64_t> y_index(rank, 0);
+  for (size_t y = 0; y < y_data.size(); y++) {
+    int64_t x = 0;
+    for (size_t i = 0; i < rank; i++) {
+      x += y_index[i] * x_shape.SizeFromDimension(perm[i] + 1);
+    }
+    y_data[y] = x_data[static_cast<size_t>(x)];
+    for (size_t i = rank; i-- > 0;) {
+      if (++y_index[i] < y_dims[i]) break;
+      y_index[i] = 0;
+    }
+  }
+
+  OpTester test("Transpose");
+  test.AddAttribute("perm", perm);
+  test.AddInput<T>("X", x_dims, x_data);
+  test.AddOutput<T>("Y", y_dims, y_data);
+  test.Run();
+}
+
+TEST(TransposeOpTest, BatchedMatrixTranspose) {
+  TestBatchedMatrixTranspose<float>({300, 257}, {1, 0});
+  TestBatchedMatrixTranspose<float>({3, 65, 129}, {0, 2, 1});
+  TestBatchedMatrixTranspose<uint8_t>({2, 33, 17, 5}, {0, 3, 1, 2});
+  TestBatchedMatrixTranspose<uint8_t>({2, 7, 33, 65}, {0, 2, 3, 1});
+  TestBatchedMatrixTranspose<int16_t>({5, 40, 3, 7}, {1, 0, 2, 3});
+  TestBatchedMatrixTranspose<double>({2, 31, 6, 9}, {0, 2, 1, 3});
+  TestBatchedMatrixTranspose<int64_t>({130, 1, 70}, {2, 1, 0});
+}
+
 #if USE_CUDA
 constexpr const char* kGpuExecutionProvider = kCudaExecutionProvider;
 #elif USE_ROCM
@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <map>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -39,6 +41,31 @@ void RunUniqueTest(const std::vector<int64_t>& X_dims,
   test.Run();
 }
 
+TEST(Unique, Flatten_Large) {
+  // large enough for the input to be split into blocks
+  const int64_t size = 50000;
+  const std::vector<int64_t> X_dims{size};
+  std::vector<int64_t> X(size);
+  std::vector<int64_t> Y, indices, inverse_indices, counts;
+  std::map<int64_t, int64_t> unique_offsets;
+  for (int64_t i = 0; i < size; ++i) {
+    X[i] = (i * 7919) % 1013;
+    auto it = unique_offsets.find(X[i]);
+    if (it == unique_offsets.end()) {
+      it = unique_offsets.emplace(X[i], static_cast<int64_t>(Y.size())).first;
+      Y.push_back(X[i]);
+      indices.push_back(i);
+      counts.push_back(0);
+    }
+    inverse_indices.push_back(it->second);
+    ++counts[it->second];
+  }
+
+  const int64_t num_unique = static_cast<int64_t>(Y.size());
+  RunUniqueTest<int64_t>(X_dims, X, nullptr, false, {num_unique}, Y, {num_unique}, indices,
+                         {size}, inverse_indices, {num_unique}, counts);
+}
+
 TEST(Unique, Flatten_Unsorted) {
   const std::vector<int64_t> X_dims{2, 3};
   const std::vector<float> X{1.f, 4.f, 1.f, 2.f, 2.f, 0.f};
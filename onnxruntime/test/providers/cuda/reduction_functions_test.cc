@@ -172,6 +172,42 @@ void TestReduceColumnsToColumn(int m, int n, float relative_error_tolerance = 1e
 
   CheckDeviceValues(m, d_out.get(), expected_column.data(), relative_error_tolerance);
 }
+
+void TestReduceMatrixMeans(int m, int n, float relative_error_tolerance = 1e-4f) {
+  SCOPED_TRACE(MakeString("m: ", m, ", n:", n));
+
+  const TensorShape shape{m, n};
+  RandomValueGenerator random{};
+  const auto values = random.Uniform<float>(shape.GetDims(), 1.0f, 10.0f);
+  std::vector<float> expected_row(n), expected_column(m);
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      expected_row[j] += values[i * n + j] / m;
+      expected_column[i] += values[i * n + j] / n;
+    }
+  }
+
+  auto d_in = AllocateDeviceMemory<float>(m * n);
+  auto d_row = AllocateDeviceMemory<float>(n);
+  auto d_column = AllocateDeviceMemory<float>(m);
+
+  cudaMemcpy(d_in.get(), values.data(), m * n * sizeof(float), cudaMemcpyHostToDevice);
+
+  size_t buffer_size_in_bytes =
+      compute_reduce_matrix_columns_buffer_size<float>(m, n);
+  auto d_buffer = AllocateDeviceMemory<char>(buffer_size_in_bytes);
+
+  ASSERT_STATUS_OK(reduce_matrix_rows_mean(d_in.get(), d_row.get(), m, n));
+  ASSERT_STATUS_OK(reduce_matrix_columns_mean(
+      d_in.get(), d_column.get(),
+      m, n,
+      d_buffer.get(), buffer_size_in_bytes));
+
+  ASSERT_TRUE(CUDA_CALL(cudaDeviceSynchronize()));
+
+  CheckDeviceValues(n, d_row.get(), expected_row.data(), relative_error_tolerance);
+  CheckDeviceValues(m, d_column.get(), expected_column.data(), relative_error_tolerance);
+}
 }  // namespace
 
 TEST(ReductionFunctionsTest, ReduceRowToScalar) {
@@ -200,6 +236,14 @@ TEST(ReductionFunctionsTest, ReduceColumnsToColumn) {
   }
 }
 
+TEST(ReductionFunctionsTest, ReduceMatrixMeans) {
+  for (int m : {3, 193, 2945}) {
+    for (int n : {3, 193, 2945}) {
+      TestReduceMatrixMeans(m, n);
+    }
+  }
+}
+
 TEST(ReductionFunctionsTest, BufferOffsets) {
   const int m = 2048;
   const int n = 1024;
@@ -344,6 +388,11 @@ TEST(ReductionFunctionsTest, GetApplicableMatrixReduction) {
       valid_op_type, {1, 2, 1, 1, 4, 1, 8, 1}, {3, 6},
       ApplicableMatrixReduction::None);
 
+  // mean
+  test_get_applicable_matrix_reduction(
+      CUDNN_REDUCE_TENSOR_AVG, {2, 4, 8, 16}, {2, 3},
+      ApplicableMatrixReduction::Columns, 2 * 4, 8 * 16);
+
   // invalid op type
   test_get_applicable_matrix_reduction(
       CUDNN_REDUCE_TENSOR_MAX, {2, 4, 8, 16}, {0, 1},
@@ -2,6 +2,8 @@
 # Licensed under the MIT License.
 
 # -*- coding: UTF-8 -*-
+import asyncio
+import json
 import unittest
 import os
 import numpy as np
@@ -322,6 +324,91 @@ class TestInferenceSession(unittest.TestCase):
             t1.join()
             t2.join()
 
+    def testRunOptionsLatencyBreakdown(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"))
+        ro = onnxrt.RunOptions()
+        self.assertFalse(ro.enable_latency_breakdown)
+        self.assertRaises(RuntimeError, ro.get_latency_breakdown)
+
+        ro.enable_latency_breakdown = True
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        sess.run([], {sess.get_inputs()[0].name: x}, ro)
+        breakdown = json.loads(ro.get_latency_breakdown())
+        self.assertGreater(breakdown["total_us"], 0)
+        self.assertIn("CPUExecutionProvider", breakdown["kernel_us_per_provider"])
+        self.assertGreaterEqual(breakdown["total_us"], breakdown["kernel_us"])
+
+    def testRunWithPreallocatedOutputs(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"))
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        input_name = sess.get_inputs()[0].name
+        output_name = sess.get_outputs()[0].name
+        y = np.zeros((3, 2), dtype=np.float32)
+        res = sess.run([output_name], {input_name: x}, outputs=[y])
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        self.assertIs(res[0], y)
+        np.testing.assert_allclose(output_expected, y, rtol=1e-05, atol=1e-08)
+
+        # None entries are allocated by the session
+        res = sess.run([output_name], {input_name: x}, outputs=[None])
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+
+        # the type of a preallocated output must match the model
+        self.assertRaises(RuntimeError, sess.run, [output_name], {input_name: x},
+                          outputs=[np.zeros((3, 2), dtype=np.float64)])
+
+    def testOrtValueDlpack(self):
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        ortvalue = onnxrt.OrtValue.ortvalue_from_numpy(x)
+        self.assertEqual(ortvalue.__dlpack_device__(), (1, 0))
+
+        # the round trip shares the buffer
+        ortvalue2 = onnxrt.OrtValue.from_dlpack(ortvalue.to_dlpack())
+        self.assertEqual(ortvalue.data_ptr(), ortvalue2.data_ptr())
+        self.assertEqual(ortvalue2.shape(), [3, 2])
+        self.assertEqual(ortvalue2.data_type(), 'tensor(float)')
+        # the DLPack tensor keeps the buffer alive
+        del ortvalue
+        np.testing.assert_equal(x, ortvalue2.numpy())
+
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"))
+        res = sess.run([], {sess.get_inputs()[0].name: ortvalue2})
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+
+        # a capsule can only be consumed once
+        capsule = ortvalue2.to_dlpack()
+        onnxrt.OrtValue.from_dlpack(capsule)
+        self.assertRaises(RuntimeError, onnxrt.OrtValue.from_dlpack, capsule)
+
+    def testRunAsync(self):
+        so = onnxrt.SessionOptions()
+        so.intra_op_num_threads = 2
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), sess_options=so)
+        input_name = sess.get_inputs()[0].name
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+
+        async def run_all():
+            inputs = [np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32) * (i + 1) for i in range(8)]
+            return await asyncio.gather(*[sess.run_async([], {input_name: x}) for x in inputs])
+
+        loop = asyncio.new_event_loop()
+        try:
+            asyncio.set_event_loop(loop)
+            results = loop.run_until_complete(run_all())
+            for i, res in enumerate(results):
+                np.testing.assert_allclose(output_expected * (i + 1) * (i + 1), res[0], rtol=1e-05, atol=1e-08)
+
+            # the errors of the run complete the future
+            ro = onnxrt.RunOptions()
+            ro.terminate = True
+            x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+            with self.assertRaises(RuntimeError):
+                loop.run_until_complete(sess.run_async([], {input_name: x}, ro))
+        finally:
+            asyncio.set_event_loop(None)
+            loop.close()
+
     def testListAsInput(self):
         sess = onnxrt.InferenceSession(get_name("mul_1.onnx"))
         x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
@@ -358,6 +445,26 @@ class TestInferenceSession(unittest.TestCase):
         output_expected = np.array([[5.0], [11.0], [17.0]], dtype=np.float32)
         np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
 
+    def testReplicatedInferenceSession(self):
+        sess = onnxrt.ReplicatedInferenceSession(get_name("matmul_2.onnx"), [0, 0], provider='CPUExecutionProvider',
+                                                 min_batch_size_per_replica=2)
+        self.assertEqual(len(sess.get_replicas()), 2)
+        self.assertEqual(sess.get_inputs()[0].name, "X")
+
+        # split across both replicas
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0], [7.0, 8.0], [9.0, 10.0]], dtype=np.float32)
+        res = sess.run([], {"X": x})
+        output_expected = np.array([[5.0], [11.0], [17.0], [23.0], [29.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+
+        # too small to split
+        res = sess.run(["Y"], {"X": x[:3]})
+        np.testing.assert_allclose(output_expected[:3], res[0], rtol=1e-05, atol=1e-08)
+        self.assertEqual(sess._in_flight, [0, 0])
+
+        with self.assertRaises(ValueError):
+            onnxrt.ReplicatedInferenceSession(get_name("matmul_2.onnx"), [], provider='CPUExecutionProvider')
+
     def testBooleanInputs(self):
         sess = onnxrt.InferenceSession(get_name("logicaland.onnx"))
         a = np.array([[True, True], [False, False]], dtype=bool)
@@ -277,6 +277,54 @@ class TestCalibrate(unittest.TestCase):
 
         print('Finished' + ' test calculation of quantization params.')
 
+    def test_collect_calibration_stats(self):
+        '''TEST_CONFIG_5'''
+
+        #   Relu
+        #    |
+        #   Conv
+        #    |
+        #   Relu
+
+        input0 = helper.make_tensor_value_info('input0', TensorProto.FLOAT, [1, 3, 1, 3])
+        output = helper.make_tensor_value_info('X3', TensorProto.FLOAT, [1, 3, 1, 3])
+
+        X1_weight = generate_input_initializer([3, 3, 1, 1], np.float32, 'X1_weight')
+        X1_bias = generate_input_initializer([3], np.float32, 'X1_bias')
+
+        relu_node_1 = onnx.helper.make_node('Relu', ['input0'], ['X1'], name='Relu1')
+        conv_node_1 = onnx.helper.make_node('Conv', ['X1', 'X1_weight', 'X1_bias'], ['X2'], name='Conv1')
+        relu_node_2 = onnx.helper.make_node('Relu', ['X2'], ['X3'], name='Relu2')
+
+        graph = helper.make_graph([relu_node_1, conv_node_1, relu_node_2], 'test_graph_5', [input0], [output])
+        graph.initializer.add().CopyFrom(X1_weight)
+        graph.initializer.add().CopyFrom(X1_bias)
+
+        model = helper.make_model(graph, opset_imports=[helper.make_opsetid("", 13)])
+        augmented_model_path = './augmented_test_model_5.onnx'
+        calibrater = ONNXCalibrater(model, TestDataReaderSecond(), ['Conv'], [], [], augmented_model_path)
+
+        # the statistics recorded by the runtime agree with the outputs of the augmented model
+        dict_in_runtime = calibrater.collect_calibration_stats()
+        self.assertEqual(set(dict_in_runtime.keys()), set(['X1', 'X2']))
+
+        onnx.save(calibrater.augment_graph(), augmented_model_path)
+        calibrater.calibration_cache = {}
+        calibrater.set_data_reader(TestDataReaderSecond())
+        dict_for_quantization = calibrater.get_intermediate_outputs()
+        for key, value in dict_for_quantization.items():
+            self.assertAlmostEqual(dict_in_runtime[key][0], value[0], places=5)
+            self.assertAlmostEqual(dict_in_runtime[key][1], value[1], places=5)
+
+        # 3 runs of 9 values, and a threshold no larger than the largest absolute value
+        stats = calibrater.calibration_stats['X1']
+        self.assertEqual(stats['count'], 27)
+        self.assertEqual(len(stats['histogram']), 2048)
+        self.assertEqual(sum(stats['histogram']), 27)
+        self.assertLessEqual(stats['entropy_threshold'], stats['histogram_range'])
+
+        print('Finished' + ' test collection of calibration statistics.')
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -7,6 +7,7 @@
 #include <fstream>
 #include <sstream>
 #include <atomic>
+#include <condition_variable>
 #include <mutex>
 #include <algorithm>
 
@@ -254,6 +255,122 @@ TEST(CApiTest, custom_op_handler) {
 #endif
 }
 
+#ifndef USE_CUDA
+// Foo kernel that pre-packs W and computes X + W on the intra-op thread pool through a scratch buffer
+struct PrePackingFooKernel {
+  PrePackingFooKernel(Ort::CustomOpApi ort, std::atomic<int>& prepack_calls) : ort_(ort), prepack_calls_(prepack_calls) {}
+
+  ~PrePackingFooKernel() {
+    if (packed_w_ != nullptr) {
+      allocator_->Free(allocator_, packed_w_);
+    }
+  }
+
+  OrtStatusPtr PrePack(const OrtValue* tensor, int input_index, OrtAllocator* allocator, int* is_packed) {
+    *is_packed = 0;
+    if (input_index != 1) {
+      return nullptr;
+    }
+
+    ++prepack_calls_;
+    OrtTensorTypeAndShapeInfo* info = ort_.GetTensorTypeAndShape(tensor);
+    packed_count_ = ort_.GetTensorShapeElementCount(info);
+    ort_.ReleaseTensorTypeAndShapeInfo(info);
+
+    allocator_ = allocator;
+    packed_w_ = static_cast<float*>(allocator->Alloc(allocator, packed_count_ * sizeof(float)));
+    const float* w = ort_.GetTensorData<float>(tensor);
+    std::copy(w, w + packed_count_, packed_w_);
+    *is_packed = 1;
+    return nullptr;
+  }
+
+  void Compute(OrtKernelContext* context) {
+    ASSERT_NE(packed_w_, nullptr);
+    const OrtValue* input_x = ort_.KernelContext_GetInput(context, 0);
+    const float* x = ort_.GetTensorData<float>(input_x);
+
+    OrtTensorTypeAndShapeInfo* info = ort_.GetTensorTypeAndShape(input_x);
+    std::vector<int64_t> dimensions = ort_.GetTensorShape(info);
+    size_t size = ort_.GetTensorShapeElementCount(info);
+    ort_.ReleaseTensorTypeAndShapeInfo(info);
+    ASSERT_EQ(size, packed_count_);
+
+    OrtValue* output = ort_.KernelContext_GetOutput(context, 0, dimensions.data(), dimensions.size());
+    float* y = ort_.GetTensorMutableData<float>(output);
+
+    OrtAllocator* scratch_allocator = ort_.KernelContext_GetScratchAllocator(context);
+    float* scratch = static_cast<float*>(scratch_allocator->Alloc(scratch_allocator, size * sizeof(float)));
+
+    struct AddArgs {
+      const float* x;
+      const float* w;
+      float* scratch;
+    } args{x, packed_w_, scratch};
+    ort_.KernelContext_ParallelFor(
+        context, [](void* user_data, size_t begin, size_t end) {
+          auto* add_args = static_cast<AddArgs*>(user_data);
+          for (size_t i = begin; i < end; i++) {
+            add_args->scratch[i] = add_args->x[i] + add_args->w[i];
+          }
+        },
+        &args, size, 1.0);
+
+    std::copy(scratch, scratch + size, y);
+    scratch_allocator->Free(scratch_allocator, scratch);
+    ort_.ReleaseAllocator(scratch_allocator);
+  }
+
+ private:
+  Ort::CustomOpApi ort_;
+  std::atomic<int>& prepack_calls_;
+  OrtAllocator* allocator_ = nullptr;
+  float* packed_w_ = nullptr;
+  size_t packed_count_ = 0;
+};
+
+struct PrePackingFooOp : Ort::CustomOpBase<PrePackingFooOp, PrePackingFooKernel> {
+  PrePackingFooOp() {
+    OrtCustomOp::KernelPrePack = [](void* op_kernel, const OrtValue* tensor, int input_index,
+                                    OrtAllocator* allocator, int* is_packed) {
+      return static_cast<PrePackingFooKernel*>(op_kernel)->PrePack(tensor, input_index, allocator, is_packed);
+    };
+  }
+
+  void* CreateKernel(Ort::CustomOpApi api, const OrtKernelInfo* /*info*/) const {
+    return new PrePackingFooKernel(api, prepack_calls_);
+  };
+  const char* GetName() const { return "Foo"; };
+
+  size_t GetInputTypeCount() const { return 2; };
+  ONNXTensorElementDataType GetInputType(size_t /*index*/) const { return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT; };
+
+  size_t GetOutputTypeCount() const { return 1; };
+  ONNXTensorElementDataType GetOutputType(size_t /*index*/) const { return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT; };
+
+  mutable std::atomic<int> prepack_calls_{0};
+};
+
+TEST(CApiTest, custom_op_prepack_and_parallel_for) {
+  std::vector<Input> inputs(1);
+  Input& input = inputs[0];
+  input.name = "X";
+  input.dims = {3, 2};
+  input.values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+
+  std::vector<int64_t> expected_dims_y = {3, 2};
+  std::vector<float> expected_values_y = {2.0f, 4.0f, 6.0f, 8.0f, 10.0f, 12.0f};
+
+  PrePackingFooOp custom_op;
+  Ort::CustomOpDomain custom_op_domain("");
+  custom_op_domain.Add(&custom_op);
+
+  TestInference<float>(*ort_env, CUSTOM_OP_MODEL_URI, inputs, "Y", expected_dims_y, expected_values_y, 0,
+                       custom_op_domain, nullptr);
+  ASSERT_GE(custom_op.prepack_calls_.load(), 1);
+}
+#endif
+
 template <typename T>
 void cuda_slice(const T*, int64_t, int64_t, T*);
 
@@ -676,6 +793,233 @@ TEST(CApiTest, io_binding) {
   binding.ClearBoundOutputs();
 }
 
+namespace {
+struct RunAsyncResult {
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool done = false;
+  OrtErrorCode error_code = ORT_OK;
+  Ort::Value output{nullptr};
+
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this]() { return done; });
+  }
+};
+
+void ORT_API_CALL RunAsyncCallback(void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status) {
+  auto* result = reinterpret_cast<RunAsyncResult*>(user_data);
+  std::lock_guard<std::mutex> lock(result->mutex);
+  if (status != nullptr) {
+    result->error_code = Ort::GetApi().GetErrorCode(status);
+    Ort::GetApi().ReleaseStatus(status);
+  } else if (num_outputs == 1) {
+    result->output = Ort::Value(outputs[0]);
+  }
+
+  result->done = true;
+  result->cv.notify_one();
+}
+}  // namespace
+
+TEST(CApiTest, run_async) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(2);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  std::array<float, 3 * 2> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Ort::Value input = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(),
+                                              x_shape.data(), x_shape.size());
+  const std::array<float, 3 * 2> expected_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  OrtValue* output = nullptr;
+  RunAsyncResult result;
+  session.RunAsync(Ort::RunOptions(), input_names, &input, 1, output_names,
+                   reinterpret_cast<Ort::Value*>(&output), 1, RunAsyncCallback, &result);
+  result.Wait();
+
+  ASSERT_EQ(result.error_code, ORT_OK);
+  ASSERT_TRUE(result.output.IsTensor());
+  auto count = result.output.GetTensorTypeAndShapeInfo().GetElementCount();
+  ASSERT_EQ(expected_y.size(), count);
+  const float* values = result.output.GetTensorData<float>();
+  ASSERT_TRUE(std::equal(values, values + count, std::begin(expected_y)));
+
+  // errors during the run are reported to the callback
+  const char* invalid_output_names[] = {"invalid"};
+  OrtValue* invalid_output = nullptr;
+  RunAsyncResult invalid_result;
+  session.RunAsync(Ort::RunOptions(), input_names, &input, 1, invalid_output_names,
+                   reinterpret_cast<Ort::Value*>(&invalid_output), 1, RunAsyncCallback, &invalid_result);
+  invalid_result.Wait();
+  ASSERT_NE(invalid_result.error_code, ORT_OK);
+}
+
+TEST(CApiTest, run_async_requires_thread_pool) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(1);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  std::array<float, 3 * 2> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Ort::Value input = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(),
+                                              x_shape.data(), x_shape.size());
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  OrtValue* output = nullptr;
+  RunAsyncResult result;
+  ASSERT_THROW(session.RunAsync(Ort::RunOptions(), input_names, &input, 1, output_names,
+                                reinterpret_cast<Ort::Value*>(&output), 1, RunAsyncCallback, &result),
+               Ort::Exception);
+}
+
+TEST(CApiTest, run_batch) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(2);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  constexpr size_t batch_size = 3;
+  std::array<std::array<float, 3 * 2>, batch_size> x_values;
+  std::vector<Ort::Value> inputs;
+  for (size_t r = 0; r < batch_size; ++r) {
+    for (size_t i = 0; i < x_values[r].size(); ++i) {
+      x_values[r][i] = static_cast<float>(r * 10 + i);
+    }
+    inputs.push_back(Ort::Value::CreateTensor(info_cpu, x_values[r].data(), x_values[r].size(),
+                                              x_shape.data(), x_shape.size()));
+  }
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  std::vector<Ort::Value> outputs;
+  for (size_t r = 0; r < batch_size; ++r) {
+    outputs.emplace_back(nullptr);
+  }
+  session.RunBatch(Ort::RunOptions(), input_names, inputs.data(), 1, output_names, outputs.data(), 1, batch_size);
+
+  for (size_t r = 0; r < batch_size; ++r) {
+    ASSERT_TRUE(outputs[r].IsTensor());
+    auto count = outputs[r].GetTensorTypeAndShapeInfo().GetElementCount();
+    ASSERT_EQ(x_values[r].size(), count);
+    const float* values = outputs[r].GetTensorData<float>();
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(values[i], x_values[r][i] * x_values[r][i]);
+    }
+  }
+}
+
+TEST(CApiTest, run_with_handle) {
+  Ort::Session session(*ort_env, MODEL_URI, Ort::SessionOptions());
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  const char* invalid_names[] = {"Z"};
+  ASSERT_THROW(Ort::RunHandle(session, invalid_names, 1, output_names, 1), Ort::Exception);
+  ASSERT_THROW(Ort::RunHandle(session, input_names, 1, invalid_names, 1), Ort::Exception);
+  Ort::RunHandle run_handle(session, input_names, 1, output_names, 1);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  std::array<float, 3 * 2> x_values;
+  for (int run = 0; run < 3; ++run) {
+    for (size_t i = 0; i < x_values.size(); ++i) {
+      x_values[i] = static_cast<float>(run * 10 + i);
+    }
+    Ort::Value input = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(),
+                                                x_shape.data(), x_shape.size());
+    Ort::Value output{nullptr};
+    session.Run(Ort::RunOptions(), run_handle, &input, 1, &output, 1);
+
+    ASSERT_TRUE(output.IsTensor());
+    auto count = output.GetTensorTypeAndShapeInfo().GetElementCount();
+    ASSERT_EQ(x_values.size(), count);
+    const float* values = output.GetTensorData<float>();
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(values[i], x_values[i] * x_values[i]);
+    }
+  }
+
+  // the values are checked against the names of the handle
+  Ort::Value output{nullptr};
+  ASSERT_THROW(session.Run(Ort::RunOptions(), run_handle, nullptr, 0, &output, 1), Ort::Exception);
+  const std::array<int64_t, 1> wrong_shape = {6};
+  Ort::Value wrong_input = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(),
+                                                    wrong_shape.data(), wrong_shape.size());
+  ASSERT_THROW(session.Run(Ort::RunOptions(), run_handle, &wrong_input, 1, &output, 1), Ort::Exception);
+
+  // a handle only runs the session that created it
+  Ort::Session other_session(*ort_env, MODEL_URI, Ort::SessionOptions());
+  Ort::Value input = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(),
+                                              x_shape.data(), x_shape.size());
+  ASSERT_THROW(other_session.Run(Ort::RunOptions(), run_handle, &input, 1, &output, 1), Ort::Exception);
+}
+
+TEST(CApiTest, update_tensor_data) {
+  Ort::Session session(*ort_env, MODEL_URI, Ort::SessionOptions());
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  std::array<std::array<float, 3 * 2>, 2> x_values;
+  std::array<std::array<float, 3 * 2>, 2> y_values;
+  Ort::Value input = Ort::Value::CreateTensor(info_cpu, x_values[0].data(), x_values[0].size(),
+                                              x_shape.data(), x_shape.size());
+  Ort::Value output = Ort::Value::CreateTensor(info_cpu, y_values[0].data(), y_values[0].size(),
+                                               x_shape.data(), x_shape.size());
+  for (size_t run = 0; run < x_values.size(); ++run) {
+    for (size_t i = 0; i < x_values[run].size(); ++i) {
+      x_values[run][i] = static_cast<float>(run * 10 + i);
+    }
+    input.UpdateTensorData(x_values[run].data(), x_values[run].size(), x_shape.data(), x_shape.size());
+    output.UpdateTensorData(y_values[run].data(), y_values[run].size(), x_shape.data(), x_shape.size());
+    session.Run(Ort::RunOptions(), input_names, &input, 1, output_names, &output, 1);
+
+    ASSERT_EQ(output.GetTensorData<float>(), y_values[run].data());
+    for (size_t i = 0; i < x_values[run].size(); ++i) {
+      ASSERT_EQ(y_values[run][i], x_values[run][i] * x_values[run][i]);
+    }
+  }
+
+  // the shape may change as long as the buffer is large enough
+  const std::array<int64_t, 1> flat_shape = {4};
+  input.UpdateTensorData(x_values[0].data(), x_values[0].size(), flat_shape.data(), flat_shape.size());
+  const std::array<int64_t, 2> large_shape = {4, 2};
+  ASSERT_THROW(input.UpdateTensorData(x_values[0].data(), x_values[0].size(), large_shape.data(), large_shape.size()),
+               Ort::Exception);
+  const std::array<int64_t, 2> negative_shape = {-1, 2};
+  ASSERT_THROW(input.UpdateTensorData(x_values[0].data(), x_values[0].size(), negative_shape.data(),
+                                      negative_shape.size()),
+               Ort::Exception);
+
+  // a tensor that owns its buffer can't be updated
+  Ort::AllocatorWithDefaultOptions allocator;
+  Ort::Value owned = Ort::Value::CreateTensor<float>(allocator, x_shape.data(), x_shape.size());
+  ASSERT_THROW(owned.UpdateTensorData(x_values[0].data(), x_values[0].size(), x_shape.data(), x_shape.size()),
+               Ort::Exception);
+
+  Ort::Value values[] = {std::move(input), std::move(output), std::move(owned)};
+  std::array<ONNXTensorElementDataType, 3> element_types;
+  std::array<size_t, 3> ranks;
+  std::array<int64_t, 5> dims;
+  Ort::Value::GetTensorTypesAndShapes(values, 3, element_types.data(), ranks.data(), dims.data(), dims.size());
+  for (auto element_type : element_types) {
+    ASSERT_EQ(element_type, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT);
+  }
+  ASSERT_EQ(ranks, (std::array<size_t, 3>{1, 2, 2}));
+  ASSERT_EQ(dims, (std::array<int64_t, 5>{4, 3, 2, 3, 2}));
+  ASSERT_THROW(Ort::Value::GetTensorTypesAndShapes(values, 3, element_types.data(), ranks.data(), dims.data(), 4),
+               Ort::Exception);
+}
+
 #if defined(USE_CUDA) || defined(USE_TENSORRT)
 TEST(CApiTest, io_binding_cuda) {
   struct CudaMemoryDeleter {
@@ -8,8 +8,10 @@
 
 #include "re2/re2.h"
 
+#include "core/common/logging/logging.h"
 #include "core/platform/path_lib.h"
 #include "core/platform/env.h"
+#include "orttraining/core/framework/checkpointing.h"
 
 namespace onnxruntime {
 namespace training {
@@ -86,8 +88,13 @@ CheckpointRegistry::CheckpointIdToPathMap CheckpointRegistry::GetCheckpointsFrom
             const PathString& file_name, OrtFileType /*file_type*/) {
           CheckpointId id;
           if (ParseCheckpointFileName(file_name, id)) {
-            checkpoints.emplace(
-                id, ConcatPathComponent(checkpoints_directory_path, file_name));
+            const PathString checkpoint_path = ConcatPathComponent(checkpoints_directory_path, file_name);
+            // e.g., the run stopped while the checkpoint was written in the background
+            if (!IsModelCheckpointComplete(checkpoint_path)) {
+              LOGS_DEFAULT(WARNING) << "Ignoring incomplete checkpoint " << ToMBString(checkpoint_path);
+              return true;
+            }
+            checkpoints.emplace(id, checkpoint_path);
           }
           return true;
         });
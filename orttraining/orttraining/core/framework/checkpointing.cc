@@ -4,12 +4,21 @@
 #include "orttraining/core/framework/checkpointing.h"
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <functional>
+#include <map>
+#include <set>
+#include <sstream>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "re2/re2.h"
+
 #include "core/common/common.h"
 #include "core/common/logging/logging.h"
+#include "core/common/make_unique.h"
 #include "core/common/path.h"
 #include "core/framework/data_transfer_utils.h"
 #include "core/framework/endian_utils.h"
@@ -42,17 +51,65 @@ PathString GetCheckpointPropertiesFilePath(const PathString& checkpoint_director
   return ConcatPathComponent<PathChar>(checkpoint_directory, k_properties_file_name);
 }
 
-Status SaveRuntimeTensor(
+// shard file names look like this: "shard_<index>_of_<count>.pbseq" and "shard_<index>_of_<count>.bin"
+
+PathString GetCheckpointShardFilePath(
+    const PathString& checkpoint_directory, int shard_index, int shard_count, const PathChar* extension) {
+  std::basic_stringstream<PathChar> shard_file_name{};
+  shard_file_name << ORT_TSTR("shard_") << shard_index << ORT_TSTR("_of_") << shard_count << extension;
+  return ConcatPathComponent<PathChar>(checkpoint_directory, shard_file_name.str());
+}
+
+PathString GetCheckpointShardIndexFilePath(const PathString& checkpoint_directory, int shard_index, int shard_count) {
+  return GetCheckpointShardFilePath(checkpoint_directory, shard_index, shard_count, ORT_TSTR(".pbseq"));
+}
+
+PathString GetCheckpointShardDataFilePath(const PathString& checkpoint_directory, int shard_index, int shard_count) {
+  return GetCheckpointShardFilePath(checkpoint_directory, shard_index, shard_count, ORT_TSTR(".bin"));
+}
+
+// returns the indices of the saved shards, by shard count
+std::map<int, std::set<int>> GetCheckpointShards(const PathString& checkpoint_directory) {
+  static RE2 re = {R"(^shard_(\d+)_of_(\d+)\.pbseq$)"};
+  std::map<int, std::set<int>> shards{};
+  if (Env::Default().FolderExists(checkpoint_directory)) {
+    LoopDir(
+        checkpoint_directory,
+        [&shards](const PathString& file_name, OrtFileType /*file_type*/) {
+          int shard_index, shard_count;
+          if (RE2::FullMatch(ToMBString(file_name), re, &shard_index, &shard_count) &&
+              shard_index < shard_count) {
+            shards[shard_count].insert(shard_index);
+          }
+          return true;
+        });
+  }
+
+  return shards;
+}
+
+// returns the shard count of a complete sharded checkpoint, or 0 if there isn't any
+int GetCompleteCheckpointShardCount(const PathString& checkpoint_directory) {
+  for (const auto& shard_count_and_indices : GetCheckpointShards(checkpoint_directory)) {
+    if (shard_count_and_indices.second.size() == static_cast<size_t>(shard_count_and_indices.first)) {
+      return shard_count_and_indices.first;
+    }
+  }
+
+  return 0;
+}
+
+bool FileExists(const PathString& path) {
+  return std::ifstream{path}.good();
+}
+
+// creates a tensor proto locating the data of tensor in an external data file
+ONNX_NAMESPACE::TensorProto MakeExternalDataTensorProto(
     const std::string& tensor_name,
     const Tensor& tensor,
-    gsl::span<const char> tensor_data,
     const PathString& relative_data_path,
-    std::ofstream& data_file,
-    ONNX_NAMESPACE::TensorProto& tensor_proto) {
-  ORT_RETURN_IF(tensor.DataType() == DataTypeImpl::GetType<std::string>());
-
-  VLOGS_DEFAULT(1) << "Saving tensor " << tensor_name;
-
+    std::streamoff offset,
+    size_t length) {
   ONNX_NAMESPACE::TensorProto saved_tensor_proto{};
 
   for (const auto dim : tensor.Shape().GetDims()) {
@@ -71,13 +128,30 @@ Status SaveRuntimeTensor(
 
   // TODO is the encoding correct? https://github.com/onnx/onnx/issues/2392
   add_external_data("location", ToMBString(relative_data_path));
-  const std::streamoff offset = data_file.tellp();
   add_external_data("offset", std::to_string(offset));
-  const auto length = tensor_data.size_bytes();
   add_external_data("length", std::to_string(length));
 
   saved_tensor_proto.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
 
+  return saved_tensor_proto;
+}
+
+Status SaveRuntimeTensor(
+    const std::string& tensor_name,
+    const Tensor& tensor,
+    gsl::span<const char> tensor_data,
+    const PathString& relative_data_path,
+    std::ofstream& data_file,
+    ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  ORT_RETURN_IF(tensor.DataType() == DataTypeImpl::GetType<std::string>());
+
+  VLOGS_DEFAULT(1) << "Saving tensor " << tensor_name;
+
+  const std::streamoff offset = data_file.tellp();
+  const auto length = tensor_data.size_bytes();
+  ONNX_NAMESPACE::TensorProto saved_tensor_proto =
+      MakeExternalDataTensorProto(tensor_name, tensor, relative_data_path, offset, length);
+
   // TODO need to ensure the data is written in little-endian format...
   // e.g., with endian_utils.h:WriteLittleEndian()
   // https://github.com/microsoft/onnxruntime/blob/master/onnxruntime/core/framework/endian_utils.h
@@ -200,6 +274,119 @@ Status SaveProperties(
   return Status::OK();
 }
 
+using HostTensors = std::vector<std::pair<std::string, std::unique_ptr<Tensor>>>;
+
+// the data of a shard is written in chunks of this size, each by one I/O thread
+constexpr size_t k_shard_data_chunk_size = 64 * 1024 * 1024;
+
+// writes the data of the tensors one after the other, with up to num_io_threads threads writing chunks in parallel
+Status WriteDataInParallel(const PathString& data_path, const HostTensors& tensors, int num_io_threads) {
+  struct Chunk {
+    const char* data;
+    std::streamoff offset;
+    size_t length;
+  };
+
+  std::vector<Chunk> chunks{};
+  std::streamoff total_length = 0;
+  for (const auto& name_and_tensor : tensors) {
+    const auto* data = static_cast<const char*>(name_and_tensor.second->DataRaw());
+    const size_t length = name_and_tensor.second->SizeInBytes();
+    for (size_t chunk_offset = 0; chunk_offset < length; chunk_offset += k_shard_data_chunk_size) {
+      chunks.push_back(
+          {data + chunk_offset, total_length + static_cast<std::streamoff>(chunk_offset),
+           std::min(k_shard_data_chunk_size, length - chunk_offset)});
+    }
+    total_length += static_cast<std::streamoff>(length);
+  }
+
+  // size the file first, so that the threads can write their chunks anywhere in it
+  {
+    std::ofstream data_file{data_path, std::ios::binary | std::ios::trunc};
+    ORT_RETURN_IF_NOT(data_file.good(), "Failed to open data file: ", ToMBString(data_path));
+    if (total_length > 0) {
+      ORT_RETURN_IF_NOT(
+          data_file.seekp(total_length - 1).put('\0'),
+          "Failed to write to data file: ", ToMBString(data_path));
+    }
+  }
+
+  const size_t num_threads = std::min(static_cast<size_t>(std::max(num_io_threads, 1)), chunks.size());
+  std::atomic<size_t> next_chunk{0};
+  std::vector<Status> thread_statuses(num_threads);
+  auto write_chunks = [&](Status& status) {
+    std::fstream data_file{data_path, std::ios::in | std::ios::out | std::ios::binary};
+    if (!data_file.good()) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to open data file: ", ToMBString(data_path));
+      return;
+    }
+
+    for (size_t i = next_chunk++; i < chunks.size(); i = next_chunk++) {
+      const Chunk& chunk = chunks[i];
+      if (!data_file.seekp(chunk.offset).write(chunk.data, chunk.length)) {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write to data file: ", ToMBString(data_path));
+        return;
+      }
+    }
+
+    if (!data_file.flush()) {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write to data file: ", ToMBString(data_path));
+    }
+  };
+
+  std::vector<std::thread> threads{};
+  threads.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads.emplace_back(write_chunks, std::ref(thread_statuses[i]));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& status : thread_statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  return Status::OK();
+}
+
+// writes the data of a shard, then the properties if it's shard 0, then the index of the shard
+Status WriteCheckpointShard(
+    const PathString& checkpoint_path,
+    const HostTensors& tensors,
+    const std::unordered_map<std::string, std::string>& properties,
+    int shard_index, int shard_count, int num_io_threads) {
+  const PathString data_path = GetCheckpointShardDataFilePath(checkpoint_path, shard_index, shard_count);
+  ORT_RETURN_IF_ERROR(WriteDataInParallel(data_path, tensors, num_io_threads));
+
+  if (shard_index == 0) {
+    ORT_RETURN_IF_ERROR(SaveProperties(GetCheckpointPropertiesFilePath(checkpoint_path), properties));
+  }
+
+  // just write data file basename to TensorProto - this will get overwritten
+  //   with the actual path when loading the checkpoint
+  const PathString data_relative_path = GetLastComponent(data_path);
+  std::vector<ONNX_NAMESPACE::TensorProto> saved_tensor_protos{};
+  saved_tensor_protos.reserve(tensors.size());
+  std::streamoff offset = 0;
+  for (const auto& name_and_tensor : tensors) {
+    const size_t length = name_and_tensor.second->SizeInBytes();
+    saved_tensor_protos.push_back(MakeExternalDataTensorProto(
+        name_and_tensor.first, *name_and_tensor.second, data_relative_path, offset, length));
+    offset += static_cast<std::streamoff>(length);
+  }
+
+  ORT_RETURN_IF_ERROR(WithOpenFile(
+      GetCheckpointShardIndexFilePath(checkpoint_path, shard_index, shard_count), false,
+      [&saved_tensor_protos](int fd) {
+        google::protobuf::io::FileOutputStream output{fd};
+        ORT_RETURN_IF_ERROR(WriteProtoMessageSequence(saved_tensor_protos, output));
+        return Status::OK();
+      }));
+
+  return Status::OK();
+}
+
 }  // namespace
 
 Status SaveModelCheckpoint(
@@ -229,6 +416,87 @@ Status SaveModelCheckpoint(
   return Status::OK();
 }
 
+AsyncCheckpointWriter::AsyncCheckpointWriter(AllocatorPtr host_allocator, int num_io_threads)
+    : host_allocator_{host_allocator ? std::move(host_allocator) : std::make_shared<CPUAllocator>()},
+      num_io_threads_{num_io_threads} {
+  ORT_ENFORCE(num_io_threads_ > 0, "num_io_threads must be positive: ", num_io_threads_);
+}
+
+AsyncCheckpointWriter::~AsyncCheckpointWriter() {
+  const Status status = Wait();
+  LOGS_DEFAULT_IF(!status.IsOK(), ERROR) << "Failed to save model checkpoint: " << status.ErrorMessage();
+}
+
+Status AsyncCheckpointWriter::SaveShard(
+    const PathString& checkpoint_path,
+    const DataTransferManager& data_transfer_manager,
+    const NameMLValMap& runtime_tensors,
+    const std::unordered_map<std::string, std::string>& properties,
+    int shard_index, int shard_count) {
+  ORT_RETURN_IF_NOT(
+      0 <= shard_index && shard_index < shard_count,
+      "Invalid checkpoint shard index ", shard_index, " of ", shard_count, " shards.");
+
+  ORT_RETURN_IF_ERROR(Wait());
+
+  // TODO need to ensure the data is written in little-endian format...
+  if (endian::native != endian::little) {
+    ORT_NOT_IMPLEMENTED("checkpointing currently requires little-endian host byte order");
+  }
+
+  LOGS_DEFAULT(INFO) << "Saving model checkpoint shard " << shard_index << " of " << shard_count
+                     << " to " << ToMBString(checkpoint_path);
+
+  // the ranks create the directory concurrently
+  const Status create_folder_status = Env::Default().CreateFolder(checkpoint_path);
+  ORT_RETURN_IF_NOT(
+      create_folder_status.IsOK() || Env::Default().FolderExists(checkpoint_path),
+      create_folder_status.ErrorMessage());
+
+  // the copy is taken before returning, training may update the tensors while it's written
+  auto tensors = std::make_shared<HostTensors>();
+  for (const auto& tensor_name : GetOrderedOrtValueNames(runtime_tensors)) {
+    const OrtValue& ort_value = runtime_tensors.at(tensor_name);
+    ORT_RETURN_IF_NOT(ort_value.IsTensor());
+    const Tensor& tensor = ort_value.Get<Tensor>();
+    ORT_RETURN_IF(tensor.IsDataTypeString(), "String tensors can't be checkpointed: ", tensor_name);
+
+    auto host_tensor = onnxruntime::make_unique<Tensor>(tensor.DataType(), tensor.Shape(), host_allocator_);
+    ORT_RETURN_IF_ERROR(data_transfer_manager.CopyTensor(tensor, *host_tensor));
+    tensors->emplace_back(tensor_name, std::move(host_tensor));
+  }
+
+  const int num_io_threads = num_io_threads_;
+  writer_thread_ = std::thread(
+      [this, checkpoint_path, tensors, properties, shard_index, shard_count, num_io_threads]() {
+        try {
+          write_status_ = WriteCheckpointShard(
+              checkpoint_path, *tensors, properties, shard_index, shard_count, num_io_threads);
+        } catch (const std::exception& e) {
+          write_status_ = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, e.what());
+        }
+      });
+
+  return Status::OK();
+}
+
+Status AsyncCheckpointWriter::Wait() {
+  if (!writer_thread_.joinable()) {
+    return Status::OK();
+  }
+
+  writer_thread_.join();
+  Status status = write_status_;
+  write_status_ = Status::OK();
+  LOGS_DEFAULT_IF(status.IsOK(), INFO) << "Model checkpoint shard saved successfully.";
+  return status;
+}
+
+bool IsModelCheckpointComplete(const PathString& checkpoint_path) {
+  return FileExists(GetCheckpointTensorsFilePath(checkpoint_path)) ||
+         GetCompleteCheckpointShardCount(checkpoint_path) > 0;
+}
+
 namespace {
 Status UpdateTensorsExternalDataLocations(
     const PathString& external_data_path,
@@ -252,17 +520,16 @@ Status UpdateTensorsExternalDataLocations(
 }
 }  // namespace
 
-Status LoadModelCheckpoint(
-    const PathString& checkpoint_path,
-    const PathString& model_path,
-    std::vector<ONNX_NAMESPACE::TensorProto>& tensor_protos,
-    std::unordered_map<std::string, std::string>& properties) {
-  LOGS_DEFAULT(INFO) << "Loading model checkpoint files from " << ToMBString(checkpoint_path);
-
-  // read tensors file
+namespace {
+// reads the tensors of an index file, locating their data file relative to the model directory
+Status LoadCheckpointTensors(
+    const PathString& tensors_path,
+    const PathString& tensors_data_path,
+    const PathString& model_directory_canonical_path,
+    std::vector<ONNX_NAMESPACE::TensorProto>& tensor_protos) {
   std::vector<ONNX_NAMESPACE::TensorProto> loaded_tensor_protos{};
   ORT_RETURN_IF_ERROR(WithOpenFile(
-      GetCheckpointTensorsFilePath(checkpoint_path), true,
+      tensors_path, true,
       [&loaded_tensor_protos](int fd) {
         google::protobuf::io::FileInputStream input{fd};
         ORT_RETURN_IF_ERROR(ReadProtoMessageSequence(loaded_tensor_protos, input));
@@ -270,24 +537,62 @@ Status LoadModelCheckpoint(
       }));
 
   // set external data locations
-  {
-    PathString model_directory_path{}, model_directory_canonical_path{};
-    ORT_RETURN_IF_ERROR(GetDirNameFromFilePath(
-        model_path, model_directory_path));
-    ORT_RETURN_IF_ERROR(Env::Default().GetCanonicalPath(
-        model_directory_path, model_directory_canonical_path));
-
-    PathString checkpoint_canonical_path{};
-    ORT_RETURN_IF_ERROR(Env::Default().GetCanonicalPath(
-        checkpoint_path, checkpoint_canonical_path));
-
-    Path relative_tensors_data_path_obj{};
-    ORT_RETURN_IF_ERROR(RelativePath(
-        Path::Parse(model_directory_canonical_path),
-        Path::Parse(GetCheckpointTensorsDataFilePath(checkpoint_canonical_path)),
-        relative_tensors_data_path_obj));
-    ORT_RETURN_IF_ERROR(UpdateTensorsExternalDataLocations(
-        relative_tensors_data_path_obj.ToPathString(), loaded_tensor_protos));
+  PathString tensors_data_canonical_path{};
+  ORT_RETURN_IF_ERROR(Env::Default().GetCanonicalPath(
+      tensors_data_path, tensors_data_canonical_path));
+
+  Path relative_tensors_data_path_obj{};
+  ORT_RETURN_IF_ERROR(RelativePath(
+      Path::Parse(model_directory_canonical_path),
+      Path::Parse(tensors_data_canonical_path),
+      relative_tensors_data_path_obj));
+  ORT_RETURN_IF_ERROR(UpdateTensorsExternalDataLocations(
+      relative_tensors_data_path_obj.ToPathString(), loaded_tensor_protos));
+
+  tensor_protos = std::move(loaded_tensor_protos);
+  return Status::OK();
+}
+}  // namespace
+
+Status LoadModelCheckpoint(
+    const PathString& checkpoint_path,
+    const PathString& model_path,
+    std::vector<ONNX_NAMESPACE::TensorProto>& tensor_protos,
+    std::unordered_map<std::string, std::string>& properties) {
+  LOGS_DEFAULT(INFO) << "Loading model checkpoint files from " << ToMBString(checkpoint_path);
+
+  PathString model_directory_path{}, model_directory_canonical_path{};
+  ORT_RETURN_IF_ERROR(GetDirNameFromFilePath(
+      model_path, model_directory_path));
+  ORT_RETURN_IF_ERROR(Env::Default().GetCanonicalPath(
+      model_directory_path, model_directory_canonical_path));
+
+  // read tensors files
+  std::vector<ONNX_NAMESPACE::TensorProto> loaded_tensor_protos{};
+  if (FileExists(GetCheckpointTensorsFilePath(checkpoint_path))) {
+    ORT_RETURN_IF_ERROR(LoadCheckpointTensors(
+        GetCheckpointTensorsFilePath(checkpoint_path),
+        GetCheckpointTensorsDataFilePath(checkpoint_path),
+        model_directory_canonical_path, loaded_tensor_protos));
+  } else {
+    const int shard_count = GetCompleteCheckpointShardCount(checkpoint_path);
+    ORT_RETURN_IF_NOT(
+        shard_count > 0, "No complete model checkpoint in ", ToMBString(checkpoint_path));
+
+    // tensors which aren't partitioned, e.g., the step, are saved with every shard
+    std::unordered_set<std::string> loaded_tensor_names{};
+    for (int shard_index = 0; shard_index < shard_count; ++shard_index) {
+      std::vector<ONNX_NAMESPACE::TensorProto> shard_tensor_protos{};
+      ORT_RETURN_IF_ERROR(LoadCheckpointTensors(
+          GetCheckpointShardIndexFilePath(checkpoint_path, shard_index, shard_count),
+          GetCheckpointShardDataFilePath(checkpoint_path, shard_index, shard_count),
+          model_directory_canonical_path, shard_tensor_protos));
+      for (auto& tensor_proto : shard_tensor_protos) {
+        if (loaded_tensor_names.insert(tensor_proto.name()).second) {
+          loaded_tensor_protos.push_back(std::move(tensor_proto));
+        }
+      }
+    }
   }
 
   // read properties file
@@ -4,11 +4,13 @@
 #pragma once
 
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include "core/common/path_string.h"
 #include "core/common/status.h"
+#include "core/framework/allocator.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/data_types.h"
 #include "core/framework/framework_common.h"
@@ -22,6 +24,13 @@ namespace training {
  *   tensors.pbseq - tensor protobuf messages
  *   tensors.bin - tensor binary data
  *   properties.pbseq - property protobuf messages
+ *
+ * A sharded checkpoint has the tensors of each rank in its own shard instead:
+ * checkpoint/
+ *   shard_<index>_of_<count>.bin - tensor binary data of the shard
+ *   shard_<index>_of_<count>.pbseq - the index of the shard, tensor protobuf messages locating the tensors in the data
+ *   properties.pbseq - property protobuf messages, saved with shard 0
+ * The index of a shard is written after its data, so a shard without index is incomplete.
  */
 
 /**
@@ -39,9 +48,74 @@ common::Status SaveModelCheckpoint(
     const NameMLValMap& runtime_tensors,
     const std::unordered_map<std::string, std::string>& properties);
 
+/**
+ * Saves the shards of model checkpoints in the background.
+ *
+ * SaveShard() copies the tensors to host memory and returns, a background thread then writes the copy while training
+ * continues. The data of a shard is split into chunks written by parallel I/O threads.
+ * One checkpoint is written at a time, SaveShard() and the destructor wait for the previous one.
+ */
+class AsyncCheckpointWriter {
+ public:
+  /**
+   * Constructor.
+   *
+   * @param host_allocator The allocator of the host copy, e.g., a pinned memory allocator for faster device copies.
+   *        The CPU allocator is used if it's null.
+   * @param num_io_threads The number of threads writing the data of a shard.
+   */
+  explicit AsyncCheckpointWriter(AllocatorPtr host_allocator = nullptr, int num_io_threads = 4);
+
+  ~AsyncCheckpointWriter();
+
+  /**
+   * Starts saving a shard of a sharded model checkpoint in the specified location.
+   *
+   * @param checkpoint_path The checkpoint location.
+   * @param data_transfer_manager The DataTransferManager instance.
+   * @param runtime_tensors The tensors of the shard.
+   * @param properties The properties to persist, only saved with shard 0.
+   * @param shard_index The index of the shard, e.g., the rank.
+   * @param shard_count The number of shards of the checkpoint.
+   * @return The status of the copy to host memory, or of the previous write if it failed.
+   */
+  common::Status SaveShard(
+      const PathString& checkpoint_path,
+      const DataTransferManager& data_transfer_manager,
+      const NameMLValMap& runtime_tensors,
+      const std::unordered_map<std::string, std::string>& properties,
+      int shard_index, int shard_count);
+
+  /**
+   * Waits until the shard being saved is written.
+   *
+   * @return The status of the write.
+   */
+  common::Status Wait();
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(AsyncCheckpointWriter);
+
+  AllocatorPtr host_allocator_;
+  const int num_io_threads_;
+  std::thread writer_thread_;
+  common::Status write_status_;
+};
+
+/**
+ * Checks whether a checkpoint was completely saved, i.e., it isn't sharded or it has the index of every shard.
+ *
+ * @param checkpoint_path The checkpoint location.
+ * @return True if the checkpoint is complete, false otherwise.
+ */
+bool IsModelCheckpointComplete(const PathString& checkpoint_path);
+
 /**
  * Loads a model checkpoint from the specified location.
  *
+ * The tensors of every shard of a sharded checkpoint are loaded, a tensor in several shards is loaded once.
+ * The checkpoint can then be loaded by ranks partitioned differently, which take the tensors they need by name.
+ *
  * @param checkpoint_path The checkpoint location.
  * @param model_path The model location.
  * @param tensor_protos The loaded tensors.
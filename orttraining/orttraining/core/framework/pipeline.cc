@@ -574,6 +574,137 @@ int PipelineScheduler::GetBackwardRecvRecordedEvent(const int batch_id, const in
   return GetEventOrDefault(false, batch_id, stage_id, PipelineTask::Pass::Backward, PipelineTask::Type::Recv);
 }
 
+std::vector<SimulatedPipelineTask> GetPipelineTaskOrder(const PipelineScheduleConfig& config, const int rank) {
+  const int num_stages = config.num_stages;
+  const int num_chunks = config.num_virtual_stages;
+  const int num_batches = config.num_batches;
+  if (num_stages < 1 || num_chunks < 1 || num_batches < 1) {
+    throw std::invalid_argument("The numbers of stages, virtual stages and micro-batches must be positive.");
+  }
+  if (rank < 0 || rank >= num_stages) {
+    throw std::invalid_argument("The rank must be one of the pipeline stages.");
+  }
+  if (num_chunks > 1 && num_batches % num_stages != 0) {
+    throw std::invalid_argument("The interleaved schedule needs a number of micro-batches divisible by the number of stages.");
+  }
+
+  // The k-th forward (or backward) of the rank processes micro-batch batch_of(k) through model chunk chunk_of(k).
+  // Micro-batches go through the chunks in groups of num_stages, so that the ranks stay busy.
+  const int num_tasks = num_batches * num_chunks;
+  const auto batch_of = [&](int k) { return (k / (num_stages * num_chunks)) * num_stages + k % num_stages; };
+  const auto chunk_of = [&](int k, bool is_forward) {
+    const int chunk = (k / num_stages) % num_chunks;
+    return is_forward ? chunk : num_chunks - 1 - chunk;
+  };
+  const auto make_task = [&](int k, bool is_forward) {
+    return SimulatedPipelineTask{batch_of(k), chunk_of(k, is_forward) * num_stages + rank,
+                                 is_forward ? PipelineTask::Pass::Forward : PipelineTask::Pass::Backward,
+                                 -1.0, -1.0};
+  };
+
+  // The warm-up forwards fill the pipeline before the first backward reaches the rank.
+  const int num_warmup_tasks = num_chunks == 1
+                                   ? std::min(num_stages - rank - 1, num_tasks)
+                                   : std::min((num_stages - rank - 1) * 2 + (num_chunks - 1) * num_stages, num_tasks);
+
+  std::vector<SimulatedPipelineTask> tasks;
+  tasks.reserve(2 * num_tasks);
+  for (int k = 0; k < num_warmup_tasks; ++k) {
+    tasks.push_back(make_task(k, true));
+  }
+  // steady state: one forward, one backward
+  for (int k = 0; k < num_tasks - num_warmup_tasks; ++k) {
+    tasks.push_back(make_task(num_warmup_tasks + k, true));
+    tasks.push_back(make_task(k, false));
+  }
+  // cool-down: the backwards of the warm-up forwards
+  for (int k = num_tasks - num_warmup_tasks; k < num_tasks; ++k) {
+    tasks.push_back(make_task(k, false));
+  }
+
+  return tasks;
+}
+
+PipelineSimulation SimulatePipelineSchedule(const PipelineScheduleConfig& config) {
+  const int num_stages = config.num_stages;
+  const int num_virtual_stages = num_stages * config.num_virtual_stages;
+  const double forward_time = config.forward_time / config.num_virtual_stages;
+  const double backward_time = config.backward_time / config.num_virtual_stages;
+
+  PipelineSimulation simulation;
+  for (int r = 0; r < num_stages; ++r) {
+    simulation.timelines.push_back(GetPipelineTaskOrder(config, r));
+  }
+
+  // end times of the tasks per pass, micro-batch and virtual stage, negative until the task ran
+  std::vector<double> forward_end(static_cast<size_t>(config.num_batches) * num_virtual_stages, -1.0);
+  std::vector<double> backward_end(forward_end.size(), -1.0);
+  const auto index = [&](int batch, int virtual_stage) {
+    return static_cast<size_t>(batch) * num_virtual_stages + virtual_stage;
+  };
+  // the inputs of a task on another rank arrive send_recv_time after the end of the task producing them
+  const auto arrival_time = [&](double end_time, int from_virtual_stage, int to_virtual_stage) {
+    return from_virtual_stage % num_stages == to_virtual_stage % num_stages ? end_time
+                                                                             : end_time + config.send_recv_time;
+  };
+
+  std::vector<size_t> next_task(num_stages, 0);
+  std::vector<double> rank_free_time(num_stages, 0.0);
+  double busy_time = 0.0;
+  size_t num_remaining_tasks = 0;
+  for (const auto& timeline : simulation.timelines) {
+    num_remaining_tasks += timeline.size();
+  }
+
+  while (num_remaining_tasks > 0) {
+    bool made_progress = false;
+    for (int r = 0; r < num_stages; ++r) {
+      auto& timeline = simulation.timelines[r];
+      while (next_task[r] < timeline.size()) {
+        auto& task = timeline[next_task[r]];
+        const int vs = task.virtual_stage;
+        double ready_time = 0.0;
+        if (task.pass == PipelineTask::Pass::Forward) {
+          if (vs > 0) {
+            const double upstream_end = forward_end[index(task.batch, vs - 1)];
+            if (upstream_end < 0.0) {
+              break;
+            }
+            ready_time = arrival_time(upstream_end, vs - 1, vs);
+          }
+        } else {
+          const bool is_last = vs == num_virtual_stages - 1;
+          const double upstream_end = is_last ? forward_end[index(task.batch, vs)]
+                                              : backward_end[index(task.batch, vs + 1)];
+          if (upstream_end < 0.0) {
+            break;
+          }
+          ready_time = is_last ? upstream_end : arrival_time(upstream_end, vs + 1, vs);
+        }
+
+        const double duration = task.pass == PipelineTask::Pass::Forward ? forward_time : backward_time;
+        task.start_time = std::max(rank_free_time[r], ready_time);
+        task.end_time = task.start_time + duration;
+        rank_free_time[r] = task.end_time;
+        busy_time += duration;
+        (task.pass == PipelineTask::Pass::Forward ? forward_end : backward_end)[index(task.batch, vs)] = task.end_time;
+
+        ++next_task[r];
+        --num_remaining_tasks;
+        made_progress = true;
+      }
+    }
+
+    if (!made_progress) {
+      throw std::logic_error("The pipeline schedule deadlocks.");
+    }
+  }
+
+  simulation.makespan = *std::max_element(rank_free_time.begin(), rank_free_time.end());
+  simulation.bubble_fraction = 1.0 - busy_time / (num_stages * simulation.makespan);
+  return simulation;
+}
+
 void PipelineWorkerPool::Join(size_t worker_id) {
   auto& worker = workers.at(worker_id);
   if (!worker.joinable())
@@ -238,6 +238,50 @@ class PipelineScheduler {
   std::vector<int> stage_id_to_rank_id_map_;
 };
 
+// Configuration of a simulated pipeline schedule.
+struct PipelineScheduleConfig {
+  // Number of micro-batches.
+  int num_batches{1};
+  // Number of pipeline stages, i.e. ranks.
+  int num_stages{1};
+  // Number of model chunks per rank. Rank r runs the virtual stages r, r + num_stages, r + 2 * num_stages, ...
+  // so each micro-batch crosses the ranks num_virtual_stages times. 1 is the 1F1B schedule, more is the
+  // interleaved 1F1B schedule, which needs num_batches to be a multiple of num_stages.
+  int num_virtual_stages{1};
+  // Durations of the forward and backward passes of a micro-batch over all the layers of a rank.
+  double forward_time{1.0};
+  double backward_time{2.0};
+  // Latency of the asynchronous send/recv of activations or gradients between ranks.
+  // It delays the receiving task but does not occupy the compute of either rank.
+  double send_recv_time{0.0};
+};
+
+// A compute task of a simulated pipeline schedule.
+struct SimulatedPipelineTask {
+  int batch;
+  int virtual_stage;
+  PipelineTask::Pass pass;
+  double start_time;
+  double end_time;
+};
+
+// The result of a pipeline schedule simulation.
+struct PipelineSimulation {
+  // timelines[r] lists the compute tasks of rank r in execution order.
+  std::vector<std::vector<SimulatedPipelineTask>> timelines;
+  // The end time of the last task.
+  double makespan{0.0};
+  // The fraction of the ranks' time until makespan they spend idle.
+  double bubble_fraction{0.0};
+};
+
+// Returns the compute tasks of a rank, in the order the (interleaved) 1F1B schedule runs them.
+// The times of the returned tasks are not set.
+std::vector<SimulatedPipelineTask> GetPipelineTaskOrder(const PipelineScheduleConfig& config, int rank);
+
+// Simulates the (interleaved) 1F1B schedule, with every rank running its tasks as soon as their inputs arrive.
+PipelineSimulation SimulatePipelineSchedule(const PipelineScheduleConfig& config);
+
 struct PipelineWorkerState {
   std::vector<std::string> feed_names;
   std::vector<MLValue> feeds;
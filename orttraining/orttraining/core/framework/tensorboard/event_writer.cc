@@ -5,6 +5,7 @@
 #include "orttraining/core/framework/tensorboard/crc32c.h"
 #include "core/platform/env.h"
 
+#include <algorithm>
 #include <ctime>
 #include <fstream>
 #include <iomanip>
@@ -46,13 +47,80 @@ static void Encode(char* buffer, T value) {
   memcpy(buffer, &value, sizeof(value));
 }
 
-EventWriter::EventWriter(const std::basic_string<PATH_CHAR_TYPE>& log_dir) : stream_(GenerateFilePath(log_dir), std::ios::binary) {
+// Returns the event of the summary at step, with the tags prefixed by tag_prefix if it's not empty.
+static ::tensorboard::Event CreateSummaryEvent(int64_t step, double wall_time, const std::string& tag_prefix,
+                                               const std::function<void(::tensorboard::Summary&)>& set_summary) {
+  ::tensorboard::Event event;
+  event.set_step(step);
+  event.set_wall_time(wall_time);
+
+  ::tensorboard::Summary* event_summary = event.mutable_summary();
+  set_summary(*event_summary);
+
+  if (!tag_prefix.empty()) {
+    for (int i = 0; i < event_summary->value_size(); ++i) {
+      ::tensorboard::Summary::Value* summary_value = event_summary->mutable_value(i);
+      summary_value->set_tag(tag_prefix + "/" + summary_value->tag());
+    }
+  }
+
+  return event;
+}
+
+constexpr size_t EventWriter::kDefaultMaxPendingEvents;
+
+EventWriter::EventWriter(const std::basic_string<PATH_CHAR_TYPE>& log_dir, size_t max_pending_events)
+    : EventWriter(std::ofstream(GenerateFilePath(log_dir), std::ios::binary), max_pending_events) {
 }
 
-EventWriter::EventWriter(std::ofstream&& stream) : stream_(std::move(stream)) {
+EventWriter::EventWriter(std::ofstream&& stream, size_t max_pending_events)
+    : stream_(std::move(stream)), max_pending_events_(std::max<size_t>(max_pending_events, 1)) {
+  writer_thread_ = std::thread(&EventWriter::WriteEvents, this);
 }
 
 EventWriter::~EventWriter() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  queue_cv_.notify_all();
+  writer_thread_.join();
+}
+
+void EventWriter::Flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  const size_t num_events_added = num_events_added_;
+  written_cv_.wait(lock, [this, num_events_added]() { return num_events_written_ >= num_events_added; });
+}
+
+void EventWriter::Enqueue(SerializeFn serialize) {
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    written_cv_.wait(lock, [this]() { return pending_events_.size() < max_pending_events_; });
+    pending_events_.push_back(std::move(serialize));
+    ++num_events_added_;
+  }
+  queue_cv_.notify_one();
+}
+
+void EventWriter::WriteEvents() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (;;) {
+    queue_cv_.wait(lock, [this]() { return stop_ || !pending_events_.empty(); });
+    if (pending_events_.empty()) {
+      // stopping with every event written
+      return;
+    }
+
+    SerializeFn serialize = std::move(pending_events_.front());
+    pending_events_.pop_front();
+    lock.unlock();
+    WriteRecord(serialize());
+    lock.lock();
+
+    ++num_events_written_;
+    written_cv_.notify_all();
+  }
 }
 
 void EventWriter::WriteRecord(const std::string& data) {
@@ -70,7 +138,7 @@ void EventWriter::WriteRecord(const std::string& data) {
 }
 
 void EventWriter::AddEvent(const ::tensorboard::Event& event) {
-  WriteRecord(event.SerializeAsString());
+  Enqueue([event]() { return event.SerializeAsString(); });
 }
 
 void EventWriter::AddHistogram(const std::string& tag, const ::tensorboard::HistogramProto& histogram, int64_t step) {
@@ -92,39 +160,24 @@ void EventWriter::AddScalar(const std::string& tag, float value, int64_t step) {
 }
 
 void EventWriter::AddSummary(const ::tensorboard::Summary& summary, int64_t step, const std::string& tag_prefix) {
-  ::tensorboard::Event event;
-  event.set_step(step);
-  event.set_wall_time(static_cast<double>(std::time(0)));
-
-  ::tensorboard::Summary* event_summary = event.mutable_summary();
-  event_summary->CopyFrom(summary);
-
-  if (!tag_prefix.empty()) {
-    for (int i = 0; i < event_summary->value_size(); ++i) {
-      ::tensorboard::Summary::Value* summary_value = event_summary->mutable_value(i);
-      summary_value->set_tag(tag_prefix + "/" + summary_value->tag());
-    }
-  }
-
-  AddEvent(event);
+  const double wall_time = static_cast<double>(std::time(0));
+  Enqueue([summary, step, wall_time, tag_prefix]() {
+    return CreateSummaryEvent(step, wall_time, tag_prefix, [&summary](::tensorboard::Summary& event_summary) {
+             event_summary.CopyFrom(summary);
+           })
+        .SerializeAsString();
+  });
 }
 
 void EventWriter::AddSummary(const std::string& summary, int64_t step, const std::string& tag_prefix) {
-  ::tensorboard::Event event;
-  event.set_step(step);
-  event.set_wall_time(static_cast<double>(std::time(0)));
-
-  ::tensorboard::Summary* event_summary = event.mutable_summary();
-  event_summary->ParseFromString(summary);
-
-  if (!tag_prefix.empty()) {
-    for (int i = 0; i < event_summary->value_size(); ++i) {
-      ::tensorboard::Summary::Value* summary_value = event_summary->mutable_value(i);
-      summary_value->set_tag(tag_prefix + "/" + summary_value->tag());
-    }
-  }
-
-  AddEvent(event);
+  // the summary is parsed by the writer thread too
+  const double wall_time = static_cast<double>(std::time(0));
+  Enqueue([summary, step, wall_time, tag_prefix]() {
+    return CreateSummaryEvent(step, wall_time, tag_prefix, [&summary](::tensorboard::Summary& event_summary) {
+             event_summary.ParseFromString(summary);
+           })
+        .SerializeAsString();
+  });
 }
 
 }  // namespace tensorboard
@@ -3,7 +3,14 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
 #include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
 #include "core/platform/path_lib.h"
 
 namespace tensorboard {
@@ -16,10 +23,16 @@ namespace onnxruntime {
 namespace training {
 namespace tensorboard {
 
+// Writes Tensorboard events to an events file. An event is serialized, checksummed and written by a background
+// writer thread, so adding an event only queues it and doesn't stall the training step.
+// Adding an event blocks while max_pending_events are queued.
 class EventWriter {
  public:
-  EventWriter(const std::basic_string<PATH_CHAR_TYPE>& log_dir);
-  EventWriter(std::ofstream&& stream);
+  static constexpr size_t kDefaultMaxPendingEvents = 1024;
+
+  EventWriter(const std::basic_string<PATH_CHAR_TYPE>& log_dir, size_t max_pending_events = kDefaultMaxPendingEvents);
+  EventWriter(std::ofstream&& stream, size_t max_pending_events = kDefaultMaxPendingEvents);
+  // Writes the queued events.
   ~EventWriter();
 
   void AddEvent(const ::tensorboard::Event& event);
@@ -28,10 +41,28 @@ class EventWriter {
   void AddSummary(const ::tensorboard::Summary& summary, int64_t step = 0, const std::string& tag_prefix = "");
   void AddSummary(const std::string& summary, int64_t step = 0, const std::string& tag_prefix = "");
 
+  // Waits until the events added so far are written.
+  void Flush();
+
  private:
+  // Returns the serialized event of a record.
+  using SerializeFn = std::function<std::string()>;
+
+  void Enqueue(SerializeFn serialize);
+  void WriteEvents();
   void WriteRecord(const std::string& data);
 
   std::ofstream stream_;
+  const size_t max_pending_events_;
+
+  std::mutex mutex_;
+  std::condition_variable queue_cv_;
+  std::condition_variable written_cv_;
+  std::deque<SerializeFn> pending_events_;
+  size_t num_events_added_{0};
+  size_t num_events_written_{0};
+  bool stop_{false};
+  std::thread writer_thread_;
 };
 
 }  // namespace tensorboard
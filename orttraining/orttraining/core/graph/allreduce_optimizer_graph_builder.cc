@@ -3,6 +3,11 @@
 
 #include "orttraining/core/graph/allreduce_optimizer_graph_builder.h"
 
+#include <algorithm>
+#include <numeric>
+
+#include "core/framework/session_options.h"
+#include "core/graph/graph_viewer.h"
 #include "orttraining/core/framework/distributed_run_context.h"
 
 namespace onnxruntime {
@@ -41,6 +46,134 @@ static Status AddNcclAllReduceForGradients(
   return Status::OK();
 }
 
+// Splits the gradients in buckets of at most bucket_size_bytes, in the order the backward pass produces them,
+// so that each bucket can be all-reduced as soon as its last gradient is produced.
+// Returns the indices of the gradients of each bucket.
+static std::vector<std::vector<size_t>> GetGradientBuckets(
+    const Graph& graph,
+    const std::vector<std::string>& gradient_names,
+    const std::vector<ArgDef>& weight_argdefs,
+    ONNX_NAMESPACE::TensorProto_DataType allreduce_element_type,
+    int64_t bucket_size_bytes) {
+  std::unordered_map<NodeIndex, size_t> node_positions;
+  GraphViewer graph_viewer(graph);
+  const auto& node_indices = graph_viewer.GetNodesInTopologicalOrder(ExecutionOrder::PRIORITY_BASED);
+  for (size_t i = 0; i < node_indices.size(); ++i) {
+    node_positions[node_indices[i]] = i;
+  }
+
+  // gradients without a producer, e.g. graph inputs, go last
+  std::vector<size_t> production_positions(gradient_names.size(), node_indices.size());
+  for (size_t i = 0; i < gradient_names.size(); ++i) {
+    const Node* producer = graph.GetProducerNode(gradient_names[i]);
+    if (producer != nullptr) {
+      production_positions[i] = node_positions[producer->Index()];
+    }
+  }
+
+  std::vector<size_t> gradient_order(gradient_names.size());
+  std::iota(gradient_order.begin(), gradient_order.end(), 0);
+  std::stable_sort(gradient_order.begin(), gradient_order.end(), [&production_positions](size_t a, size_t b) {
+    return production_positions[a] < production_positions[b];
+  });
+
+  // the gradients are all-reduced in fp32, fp16 or bf16
+  const int64_t element_size = allreduce_element_type == ONNX_NAMESPACE::TensorProto_DataType_FLOAT ? 4 : 2;
+  std::vector<std::vector<size_t>> buckets;
+  int64_t current_bucket_size = 0;
+  for (size_t i : gradient_order) {
+    // the gradient has the shape of its weight, which is static
+    int64_t gradient_size = element_size;
+    if (weight_argdefs[i].type_proto != nullptr) {
+      for (const auto& dim : weight_argdefs[i].type_proto->tensor_type().shape().dim()) {
+        gradient_size *= dim.dim_value();
+      }
+    }
+
+    if (buckets.empty() || (current_bucket_size > 0 && current_bucket_size + gradient_size > bucket_size_bytes)) {
+      buckets.emplace_back();
+      current_bucket_size = 0;
+    }
+
+    buckets.back().push_back(i);
+    current_bucket_size += gradient_size;
+  }
+
+  return buckets;
+}
+
+// Adds the scaling and the all-reduce of each bucket, with a high priority so that they run as soon as the gradients
+// of the bucket are produced. The all-reduces of all but the last bucket run on the NCCL stream, overlapping the
+// computation of the remaining gradients, and the last one waits for them. The all-reduced gradients then go through a
+// PassThrough barrier, so nothing reads them before the last all-reduce.
+static Status AddBucketedNcclAllReduceForGradients(
+    const NodeArgNameGeneratorFn& nodearg_name_generator,
+    const float scale,
+    const std::vector<std::vector<size_t>>& buckets,
+    std::vector<ArgDef>& gradient_argdefs,
+    GraphAugmenter::GraphDefs& graph_defs,
+    ONNX_NAMESPACE::TensorProto_DataType allreduce_element_type) {
+  const int priority = static_cast<int>(ExecutionPriority::LOCAL_HIGH);
+  std::vector<ArgDef> allreduced_gradient_argdefs(gradient_argdefs.size());
+  for (size_t bucket_index = 0; bucket_index < buckets.size(); ++bucket_index) {
+    const auto& bucket = buckets[bucket_index];
+    const std::string bucket_suffix = "_Bucket" + std::to_string(bucket_index);
+
+    ArgDef bucket_scale(nodearg_name_generator("pre_allreduce_scale" + bucket_suffix),
+                        graph_defs.CreateTypeProto({}, ONNX_NAMESPACE::TensorProto_DataType_FLOAT));
+    graph_defs.AddInitializers({CreateTensorProto<float>(bucket_scale.name, scale, {})});
+
+    std::vector<ArgDef> scale_inputs{bucket_scale};
+    std::vector<ArgDef> scaled_gradient_argdefs;
+    std::vector<ArgDef> allreduce_outputs;
+    for (size_t i : bucket) {
+      scale_inputs.push_back(gradient_argdefs[i]);
+
+      TypeProto* scaled_gradient_type_proto = graph_defs.CopyTypeProto(gradient_argdefs[i]);
+      scaled_gradient_type_proto->mutable_tensor_type()->set_elem_type(allreduce_element_type);
+      scaled_gradient_argdefs.emplace_back(nodearg_name_generator(gradient_argdefs[i].name + "_scaled"),
+                                           scaled_gradient_type_proto);
+      allreduce_outputs.emplace_back(gradient_argdefs[i].name + "_AllReduce_Out", scaled_gradient_type_proto);
+    }
+
+    graph_defs.AddNodeDefs({NodeDef(OpDef{"MixedPrecisionScale", kMSDomain, 1},
+                                    scale_inputs,
+                                    scaled_gradient_argdefs,
+                                    std::vector<AttributeProto>({ONNX_NAMESPACE::MakeAttribute("to", static_cast<int64_t>(allreduce_element_type))}),
+                                    bucket_scale.name,
+                                    priority)});
+
+    const bool is_last_bucket = bucket_index + 1 == buckets.size();
+    graph_defs.AddNodeDefs({NodeDef(OpDef{"NcclAllReduce", kMSDomain, 1},
+                                    scaled_gradient_argdefs,
+                                    allreduce_outputs,
+                                    std::vector<AttributeProto>({ONNX_NAMESPACE::MakeAttribute("group_type",
+                                                                                              static_cast<int64_t>(WorkerGroupType::DataParallel)),
+                                                                 ONNX_NAMESPACE::MakeAttribute("overlap_with_compute",
+                                                                                              static_cast<int64_t>(!is_last_bucket))}),
+                                    "NcclAllReduce" + bucket_suffix,
+                                    priority)});
+
+    for (size_t j = 0; j < bucket.size(); ++j) {
+      allreduced_gradient_argdefs[bucket[j]] = allreduce_outputs[j];
+    }
+  }
+
+  std::vector<ArgDef> synced_gradient_argdefs;
+  for (const auto& argdef : allreduced_gradient_argdefs) {
+    synced_gradient_argdefs.emplace_back(argdef.name + "_Synced", argdef.type_proto);
+  }
+
+  graph_defs.AddNodeDefs({NodeDef(OpDef{"PassThrough", kMSDomain, 1},
+                                  allreduced_gradient_argdefs,
+                                  synced_gradient_argdefs,
+                                  NodeAttributes(),
+                                  "NcclAllReduce_Barrier")});
+
+  gradient_argdefs = synced_gradient_argdefs;
+  return Status::OK();
+}
+
 AllreduceOptimizerGraphBuilder::AllreduceOptimizerGraphBuilder(
     const OptimizerBuilderRegistry& opt_builder_registry,
     const OptimizerGraphConfig& opt_graph_config,
@@ -80,10 +213,20 @@ Status AllreduceOptimizerGraphBuilder::BuildInternal(
       opt_graph_config_.gradient_accumulation_steps * opt_graph_config_.data_parallel_group_size;
   ORT_RETURN_IF_NOT(total_num_accumulations > 0);
   const float scale = 1.0f / total_num_accumulations;
-  ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, gradient_argdefs, output_gradient_argdef, graph_defs,
-                                              opt_graph_config_.AllReduceDataType()));
+  const auto buckets = opt_graph_config_.allreduce_bucket_size_bytes > 0
+                           ? GetGradientBuckets(graph, gradient_names_, weight_argdefs,
+                                                opt_graph_config_.AllReduceDataType(),
+                                                opt_graph_config_.allreduce_bucket_size_bytes)
+                           : std::vector<std::vector<size_t>>{};
+  if (buckets.size() <= 1) {
+    ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, gradient_argdefs, output_gradient_argdef, graph_defs,
+                                                opt_graph_config_.AllReduceDataType()));
 
-  ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(gradient_argdefs, output_gradient_argdef, graph_defs));
+    ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(gradient_argdefs, output_gradient_argdef, graph_defs));
+  } else {
+    ORT_RETURN_IF_ERROR(AddBucketedNcclAllReduceForGradients(nodearg_name_generator, scale, buckets, gradient_argdefs,
+                                                             graph_defs, opt_graph_config_.AllReduceDataType()));
+  }
 
   // check if all gradients are finite
   ArgDef global_grad_norm_argdef;
@@ -2,10 +2,15 @@
 // Licensed under the MIT License.
 
 #include "orttraining/core/graph/optimizer/adam_optimizer_builder.h"
+
+#include <algorithm>
+
 #include "orttraining/core/graph/graph_augmenter.h"
 #include "core/util/math.h"
 #include "core/framework/ml_value.h"
 #include "core/framework/tensorprotoutils.h"
+#include "onnx/defs/attr_proto_util.h"
+#include "orttraining/core/session/training_session.h"
 
 namespace onnxruntime {
 namespace training {
@@ -167,5 +172,237 @@ Status AdamOptimizerBuilder::Build(
   return Status::OK();
 }
 
+Status MultiTensorAdamOptimizerBuilder::Build(
+    const OptimizerBuilderConfig& config,
+    GraphAugmenter::GraphDefs& graph_defs,
+    std::vector<ONNX_NAMESPACE::TensorProto>& new_external_initializers,
+    std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& weight_to_opt_mapping,
+    std::vector<ArgDef>& output_weight_argdefs,
+    std::vector<ArgDef>& output_gradient_argdefs) const {
+  const auto& weight_argdefs = config.weight_argdefs;
+  const auto& gradient_argdefs = config.gradient_argdefs;
+  const auto& opt_configs = config.opt_configs;
+
+  // gradient clipping is disabled by default for Adam.
+  bool enable_grad_clipping = config.enable_grad_clipping.has_value() ? *config.enable_grad_clipping : false;
+
+  ORT_ENFORCE(weight_argdefs.size() <= size_t(1024),
+              "The current MultiTensorAdamOptimizer can only update up to 1024 weight tensors, but ",
+              "the actual number of weight tensors is ", weight_argdefs.size());
+
+  // In distributed training, some weights may not be updated by all ranks.
+  const auto first_enabled = std::find_if(opt_configs.begin(), opt_configs.end(),
+                                          [](const OptimizerNodeConfig& opt_config) { return opt_config.enabled; });
+  if (first_enabled == opt_configs.end()) {
+    for (size_t i = 0; i < weight_argdefs.size(); ++i) {
+      const auto* mixed_precision_weight_arg = opt_configs[i].mixed_precision_weight_arg;
+      output_weight_argdefs.push_back(mixed_precision_weight_arg != nullptr
+                                          ? ArgDef(mixed_precision_weight_arg->Name(), mixed_precision_weight_arg->TypeAsProto())
+                                          : weight_argdefs[i]);
+      output_gradient_argdefs.push_back(gradient_argdefs[i]);
+    }
+    return Status::OK();
+  }
+
+  std::vector<ArgDef> input_argdefs;
+  std::vector<ArgDef> output_argdefs;
+
+  if (config.gradient_norm_finite_argdef) {
+    input_argdefs.push_back(*config.gradient_norm_finite_argdef);
+  } else {
+    input_argdefs.emplace_back(ArgDef());
+  }
+
+  if (!first_enabled->loss_scale_input_name.empty()) {
+    input_argdefs.emplace_back(ArgDef(first_enabled->loss_scale_input_name, graph_defs.CreateTypeProto({1}, ONNX_NAMESPACE::TensorProto_DataType_FLOAT)));
+  } else {
+    input_argdefs.emplace_back(ArgDef());
+  }
+
+  if (config.gradient_norm_argdef && enable_grad_clipping) {
+    input_argdefs.push_back(*config.gradient_norm_argdef);
+  } else if (!config.gradient_norm_argdef && enable_grad_clipping) {
+    ORT_THROW("Gradient clipping is enabled but gradient norm is not given.");
+  } else {
+    input_argdefs.push_back(ArgDef());
+  }
+
+  input_argdefs.emplace_back(ArgDef(first_enabled->lr_feed_name, CreateLearningRateTypeProto(graph_defs)));
+  graph_defs.AddGraphInputs({first_enabled->lr_feed_name});
+
+  // The update count shared by all the weights, which should be 1 at the first training iteration.
+  // A checkpoint of per weight AdamOptimizer nodes has the same count for every weight.
+  TensorProto uc_tensor_proto;
+  const auto& shared_optim_state = config.shared_optimizer_states;
+  const auto shared_uc_state_it = shared_optim_state.find(ADAM_UC_PREFIX);
+  const auto uc_state_it = first_enabled->initial_states.find(ADAM_UC_PREFIX);
+  if (shared_uc_state_it != shared_optim_state.end() || uc_state_it != first_enabled->initial_states.end()) {
+    const auto& init_tensor = shared_uc_state_it != shared_optim_state.end() ? shared_uc_state_it->second.Get<Tensor>()
+                                                                             : uc_state_it->second.Get<Tensor>();
+    ORT_THROW_IF_ERROR(IsMatchingTypeAndShape(init_tensor, ONNX_NAMESPACE::TensorProto_DataType_INT64, {1}));
+    uc_tensor_proto = utils::TensorToTensorProto(init_tensor, ADAM_UC_PREFIX);
+  } else {
+    uc_tensor_proto = CreateTensorProto<int64_t>(ADAM_UC_PREFIX, 1);
+  }
+  new_external_initializers.emplace_back(uc_tensor_proto);
+  weight_to_opt_mapping[onnxruntime::training::SHARED_OPTIMIZER_STATES_KEY][ADAM_UC_PREFIX] = ADAM_UC_PREFIX;
+  input_argdefs.emplace_back(ArgDef(ADAM_UC_PREFIX));
+
+  TypeProto* step_type_proto = graph_defs.CreateTypeProto({}, ONNX_NAMESPACE::TensorProto_DataType_INT64);
+  output_argdefs.emplace_back(ArgDef(ADAM_UC_PREFIX + "_Out", step_type_proto));
+
+  std::vector<float> alpha;
+  std::vector<float> beta;
+  std::vector<float> lambda;
+  std::vector<float> epsilon;
+  std::vector<float> max_norm_clip;
+  const auto& first_int_attrs = first_enabled->int_attributes;
+  const auto do_bias_correction_iter = first_int_attrs.find("do_bias_correction");
+  const int64_t do_bias_correction = do_bias_correction_iter != first_int_attrs.end() ? do_bias_correction_iter->second : 1;
+  const auto weight_decay_mode_iter = first_int_attrs.find("weight_decay_mode");
+  const int64_t weight_decay_mode = weight_decay_mode_iter != first_int_attrs.end() ? weight_decay_mode_iter->second : 0;
+
+  const auto get_attribute = [](const std::unordered_map<std::string, float>& attrs, const std::string& name, float default_value) {
+    const auto it = attrs.find(name);
+    return it != attrs.end() ? it->second : default_value;
+  };
+
+  // Associated inputs: [w, g, m1, m2, w_mixed_precision].
+  // Associated outputs: [w_new, g_new, m1_new, m2_new, w_mixed_precision_new].
+  for (size_t i = 0; i < weight_argdefs.size(); ++i) {
+    const std::string& weight_name = weight_argdefs[i].name;
+    const std::string& gradient_name = gradient_argdefs[i].name;
+    const TypeProto* const weight_type_proto = weight_argdefs[i].type_proto;
+    const TypeProto* const gradient_type_proto = gradient_argdefs[i].type_proto;
+
+    ArgDef output_gradient_argdef = gradient_argdefs[i];
+    ArgDef output_weight_argdef = weight_argdefs[i];
+    if (opt_configs[i].mixed_precision_weight_arg != nullptr)
+      output_weight_argdef = ArgDef(opt_configs[i].mixed_precision_weight_arg->Name(), opt_configs[i].mixed_precision_weight_arg->TypeAsProto());
+
+    if (opt_configs[i].enabled) {
+      const auto& attrs = opt_configs[i].attributes;
+      alpha.emplace_back(get_attribute(attrs, "alpha", 0.9f));
+      beta.emplace_back(get_attribute(attrs, "beta", 0.999f));
+      lambda.emplace_back(get_attribute(attrs, "lambda", 0.0f));
+      epsilon.emplace_back(get_attribute(attrs, "epsilon", 1e-8f));
+      max_norm_clip.emplace_back(get_attribute(attrs, "max_norm_clip", 1.0f));
+
+      const auto& int_attrs = opt_configs[i].int_attributes;
+      const auto bias_correction_iter = int_attrs.find("do_bias_correction");
+      ORT_ENFORCE(bias_correction_iter == int_attrs.end() || bias_correction_iter->second == do_bias_correction,
+                  "All the weights of MultiTensorAdamOptimizer must have the same do_bias_correction.");
+      const auto decay_mode_iter = int_attrs.find("weight_decay_mode");
+      ORT_ENFORCE(decay_mode_iter == int_attrs.end() || decay_mode_iter->second == weight_decay_mode,
+                  "All the weights of MultiTensorAdamOptimizer must have the same weight_decay_mode.");
+
+      std::vector<int64_t> weight_dims;
+      ORT_RETURN_IF_NOT(
+          weight_argdefs[i].type_proto &&
+          weight_argdefs[i].type_proto->has_tensor_type() &&
+          weight_argdefs[i].type_proto->tensor_type().has_shape());
+      for (const auto& dim : weight_argdefs[i].type_proto->tensor_type().shape().dim()) {
+        weight_dims.push_back(dim.dim_value());
+      }
+
+      input_argdefs.push_back(weight_argdefs[i]);
+      input_argdefs.push_back(gradient_argdefs[i]);
+
+      // Output either w_new or g_new based on config.
+      if (opt_configs[i].update_weight) {
+        output_weight_argdef = ArgDef(weight_name + "_Adam_out", weight_type_proto);
+        output_argdefs.push_back(output_weight_argdef);  // w_new
+        output_argdefs.push_back(ArgDef());              // g_new
+      } else {
+        output_gradient_argdef = ArgDef(gradient_name + "_Adam_out", gradient_type_proto);
+        output_argdefs.push_back(ArgDef());                // w_new
+        output_argdefs.push_back(output_gradient_argdef);  // g_new
+      }
+
+      const auto element_type = opt_configs[i].use_mixed_precision_moments ? ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_FLOAT16 : ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_FLOAT;
+
+      weight_to_opt_mapping[weight_name] = {};
+      for (const auto& moments_prefix : MOMENTS_PREFIXES) {
+        const std::string gradient_moment_name = moments_prefix + "_" + weight_name;
+
+        TensorProto moment_tensor_proto;
+        TypeProto* moment_type_proto = graph_defs.CopyTypeProto(weight_argdefs[i]);
+
+        const auto& initial_states = opt_configs[i].initial_states;
+        const auto moment_state_it = initial_states.find(moments_prefix);
+        if (moment_state_it != initial_states.end()) {
+          const auto& init_tensor = moment_state_it->second.Get<Tensor>();
+          ORT_THROW_IF_ERROR(IsMatchingTypeAndShape(init_tensor, element_type, weight_dims));
+          moment_tensor_proto = utils::TensorToTensorProto(init_tensor, gradient_moment_name);
+        } else if (opt_configs[i].use_mixed_precision_moments) {
+          moment_tensor_proto = CreateTensorProto<MLFloat16>(gradient_moment_name, MLFloat16(math::floatToHalf(0.f)), weight_dims);
+        } else {
+          moment_tensor_proto = CreateTensorProto<float>(gradient_moment_name, 0.f, weight_dims);
+        }
+
+        moment_type_proto->mutable_tensor_type()->set_elem_type(element_type);
+
+        new_external_initializers.emplace_back(std::move(moment_tensor_proto));
+        weight_to_opt_mapping[weight_name][moments_prefix] = gradient_moment_name;
+
+        input_argdefs.emplace_back(ArgDef(gradient_moment_name, moment_type_proto));
+        output_argdefs.emplace_back(ArgDef(gradient_moment_name + "_Out", moment_type_proto));
+      }
+
+      if (opt_configs[i].update_weight && opt_configs[i].mixed_precision_weight_arg != nullptr) {
+        input_argdefs.emplace_back(ArgDef(
+            opt_configs[i].mixed_precision_weight_arg->Name(),
+            opt_configs[i].mixed_precision_weight_arg->TypeAsProto()));
+        output_weight_argdef = ArgDef(
+            opt_configs[i].mixed_precision_weight_arg->Name() + "_Adam_out",
+            opt_configs[i].mixed_precision_weight_arg->TypeAsProto());
+        output_argdefs.push_back(output_weight_argdef);
+      } else {
+        input_argdefs.emplace_back(ArgDef());
+        output_argdefs.emplace_back(ArgDef());
+      }
+    }
+
+    output_weight_argdefs.push_back(output_weight_argdef);
+    output_gradient_argdefs.push_back(output_gradient_argdef);
+  }
+
+  std::vector<AttributeProto> attribute_protos;
+  attribute_protos.emplace_back(ONNX_NAMESPACE::MakeAttribute("alpha", alpha));
+  attribute_protos.emplace_back(ONNX_NAMESPACE::MakeAttribute("beta", beta));
+  attribute_protos.emplace_back(ONNX_NAMESPACE::MakeAttribute("lambda", lambda));
+  attribute_protos.emplace_back(ONNX_NAMESPACE::MakeAttribute("epsilon", epsilon));
+  attribute_protos.emplace_back(ONNX_NAMESPACE::MakeAttribute("max_norm_clip", max_norm_clip));
+  attribute_protos.emplace_back(ONNX_NAMESPACE::MakeAttribute("do_bias_correction", do_bias_correction));
+  attribute_protos.emplace_back(ONNX_NAMESPACE::MakeAttribute("weight_decay_mode", weight_decay_mode));
+
+  graph_defs.AddNodeDefs({NodeDef(OpDefinition(),
+                                  input_argdefs,
+                                  output_argdefs,
+                                  attribute_protos,
+                                  OptimizerNodeName("AllWeights"))});
+
+  return Status::OK();
+}
+
+Status OffloadedMultiTensorAdamOptimizerBuilder::Build(
+    const OptimizerBuilderConfig& config,
+    GraphAugmenter::GraphDefs& graph_defs,
+    std::vector<ONNX_NAMESPACE::TensorProto>& new_external_initializers,
+    std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& weight_to_opt_mapping,
+    std::vector<ArgDef>& output_weight_argdefs,
+    std::vector<ArgDef>& output_gradient_argdefs) const {
+  for (size_t i = 0; i < config.opt_configs.size(); ++i) {
+    const auto& opt_config = config.opt_configs[i];
+    ORT_RETURN_IF_NOT(
+        !opt_config.enabled || (opt_config.update_weight && opt_config.mixed_precision_weight_arg != nullptr),
+        "OffloadedMultiTensorAdamOptimizer must update the weights in place and requires mixed precision "
+        "initializers, but weight ", config.weight_argdefs[i].name, " doesn't meet them.");
+  }
+
+  return MultiTensorAdamOptimizerBuilder::Build(config, graph_defs, new_external_initializers, weight_to_opt_mapping,
+                                                output_weight_argdefs, output_gradient_argdefs);
+}
+
 }  // namespace training
 }  // namespace onnxruntime
@@ -28,5 +28,47 @@ class AdamOptimizerBuilder final : public OptimizerBuilder {
       std::vector<ArgDef>& output_gradient_argdefs) const override;
 };
 
+// Builds a single MultiTensorAdamOptimizer node updating all the weights, instead of one AdamOptimizer node per weight.
+// The weights share one update count, so their do_bias_correction and weight_decay_mode must be the same.
+class MultiTensorAdamOptimizerBuilder : public OptimizerBuilder {
+ public:
+  MultiTensorAdamOptimizerBuilder() : MultiTensorAdamOptimizerBuilder("MultiTensorAdamOptimizer") {}
+
+  virtual Status Build(
+      const OptimizerBuilderConfig& config,
+      GraphAugmenter::GraphDefs& graph_defs,
+      std::vector<ONNX_NAMESPACE::TensorProto>& new_external_initializers,
+      std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& weight_to_opt_mapping,
+      std::vector<ArgDef>& output_weight_argdefs,
+      std::vector<ArgDef>& output_gradient_argdefs) const override;
+
+ protected:
+  explicit MultiTensorAdamOptimizerBuilder(const std::string& op_type)
+      : OptimizerBuilder(OpDef{op_type, kMSDomain, 1},
+                         {"alpha",
+                          "beta",
+                          "lambda",
+                          "epsilon",
+                          "max_norm_clip",
+                          "do_bias_correction",
+                          "weight_decay_mode"}) {}
+};
+
+// Builds a single OffloadedMultiTensorAdamOptimizer node, which keeps the weights and the moments in host memory.
+// The full precision weights must only be read by the optimizer, so the updated weights need mixed precision
+// initializers, which the rest of the graph reads instead.
+class OffloadedMultiTensorAdamOptimizerBuilder final : public MultiTensorAdamOptimizerBuilder {
+ public:
+  OffloadedMultiTensorAdamOptimizerBuilder() : MultiTensorAdamOptimizerBuilder("OffloadedMultiTensorAdamOptimizer") {}
+
+  virtual Status Build(
+      const OptimizerBuilderConfig& config,
+      GraphAugmenter::GraphDefs& graph_defs,
+      std::vector<ONNX_NAMESPACE::TensorProto>& new_external_initializers,
+      std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& weight_to_opt_mapping,
+      std::vector<ArgDef>& output_weight_argdefs,
+      std::vector<ArgDef>& output_gradient_argdefs) const override;
+};
+
 }  // namespace training
 }  // namespace onnxruntime
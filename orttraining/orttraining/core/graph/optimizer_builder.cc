@@ -13,6 +13,8 @@ namespace training {
 void OptimizerBuilderRegistry::RegisterBuilders() {
   GetInstance().Register<AdamOptimizerBuilder>("AdamOptimizer");
   GetInstance().Register<LambOptimizerBuilder>("LambOptimizer");
+  GetInstance().Register<MultiTensorAdamOptimizerBuilder>("MultiTensorAdamOptimizer");
+  GetInstance().Register<OffloadedMultiTensorAdamOptimizerBuilder>("OffloadedMultiTensorAdamOptimizer");
   GetInstance().Register<SGDOptimizerBuilder>("SGDOptimizer");
 }
 
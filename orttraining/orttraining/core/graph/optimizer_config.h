@@ -28,8 +28,9 @@ enum MixedPrecisionDataType {
 };
 
 // Configuration for the DeepSpeed ZeRO technique.  Currently only the stage
-// setting is supported, and only with stages 0 (disabled) and 1 (optimizer
-// state partitioning).
+// setting is supported, and only with stages 0 (disabled), 1 (optimizer
+// state partitioning) and 2 (stage 1, plus gradient accumulation of the
+// local partition of the gradients only).
 
 struct ZeROConfig {
   // Default configuration
@@ -42,6 +43,15 @@ struct ZeROConfig {
   int stage{0};
 };
 
+// Configuration of the loss scale that the DynamicLossScale op updates on the device. The loss scale is halved
+// when a step has non-finite gradients and doubled after up_scale_window steps in a row with finite gradients.
+struct DynamicLossScaleConfig {
+  float initial_loss_scale{static_cast<float>(1 << 16)};
+  int64_t up_scale_window{2000};
+  float min_loss_scale{1.0f};
+  float max_loss_scale{static_cast<float>(1 << 24)};
+};
+
 // configuration per optimizer node
 struct OptimizerNodeConfig {
   std::string name{};
@@ -68,9 +78,16 @@ struct OptimizerGraphConfig {
   bool use_nccl{false};
   ZeROConfig deepspeed_zero{0};
   int gradient_accumulation_steps{1};
+  // whether a single MultiTensorInPlaceAccumulator node per gradient type accumulates the gradients
+  bool use_multi_tensor_gradient_accumulation{false};
   std::string loss_scale_input_name{};  // empty string means no loss scaling factor is applied
+  // whether the loss scale is an initializer updated on the device instead of an input fed each step
+  bool use_dynamic_loss_scale{false};
+  DynamicLossScaleConfig dynamic_loss_scale_config{};
   AdasumReductionType adasum_reduction_type{AdasumReductionType::None};
   bool enable_grad_norm_clip{true};
+  // the maximum size of a gradient all-reduce bucket, 0 for a single all-reduce of all the gradients
+  int64_t allreduce_bucket_size_bytes{0};
 
   NameMLValMap shared_optimizer_states{};  // initial states for shared params, eg. 'Step' for lamb
 
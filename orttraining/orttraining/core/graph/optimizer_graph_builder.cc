@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <functional>
 #include <iterator>
+#include <map>
 
 #include "core/common/common.h"
 #include "core/framework/tensorprotoutils.h"
@@ -34,18 +35,16 @@ Status GetArgDefsFromGraph(
   return Status::OK();
 }
 
-ArgDef BuildGradientAccumulationNode(const NodeArgNameGeneratorFn& nodearg_name_generator,
-                                     const ArgDef& gradient,
-                                     ArgDef& gradient_accumulation_buffer,
-                                     GraphAugmenter::GraphDefs& graph_defs,
-                                     bool add_accumulate_buffer_as_initializers) {
+// Returns the fp32 accumulation buffer of the gradient, added as a zero initializer if add_as_initializer.
+static ArgDef CreateGradientAccumulationBuffer(const NodeArgNameGeneratorFn& nodearg_name_generator,
+                                               const ArgDef& gradient,
+                                               GraphAugmenter::GraphDefs& graph_defs,
+                                               bool add_as_initializer) {
   TypeProto* gradient_fp32_type_proto = graph_defs.CopyTypeProto(gradient);
   gradient_fp32_type_proto->mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
 
   ArgDef gradient_accumulate_buffer(nodearg_name_generator(gradient.name + "_accumulate_buffer"),
                                     gradient_fp32_type_proto);
-  ArgDef gradient_accumulator_output(nodearg_name_generator(gradient.name + "_accumulator_output"),
-                                     gradient_fp32_type_proto);
 
   std::vector<int64_t> dims;
   ORT_ENFORCE(gradient.type_proto &&
@@ -54,8 +53,21 @@ ArgDef BuildGradientAccumulationNode(const NodeArgNameGeneratorFn& nodearg_name_
   for (const auto& dim : gradient.type_proto->tensor_type().shape().dim()) {
     dims.push_back(dim.dim_value());
   }
-  if (add_accumulate_buffer_as_initializers)
+  if (add_as_initializer)
     graph_defs.AddInitializers({CreateTensorProto<float>(gradient_accumulate_buffer.name, 0.f, dims)});
+  return gradient_accumulate_buffer;
+}
+
+ArgDef BuildGradientAccumulationNode(const NodeArgNameGeneratorFn& nodearg_name_generator,
+                                     const ArgDef& gradient,
+                                     ArgDef& gradient_accumulation_buffer,
+                                     GraphAugmenter::GraphDefs& graph_defs,
+                                     bool add_accumulate_buffer_as_initializers) {
+  ArgDef gradient_accumulate_buffer = CreateGradientAccumulationBuffer(
+      nodearg_name_generator, gradient, graph_defs, add_accumulate_buffer_as_initializers);
+  ArgDef gradient_accumulator_output(nodearg_name_generator(gradient.name + "_accumulator_output"),
+                                     gradient_accumulate_buffer.type_proto);
+
   graph_defs.AddNodeDefs({NodeDef(OpDef{"InPlaceAccumulator", kMSDomain, 1},
                                   {gradient_accumulate_buffer, gradient},
                                   {gradient_accumulator_output},
@@ -66,6 +78,43 @@ ArgDef BuildGradientAccumulationNode(const NodeArgNameGeneratorFn& nodearg_name_
   return gradient_accumulator_output;
 }
 
+void BuildMultiTensorGradientAccumulationNodes(const NodeArgNameGeneratorFn& nodearg_name_generator,
+                                               std::vector<ArgDef>& gradient_argdefs,
+                                               std::vector<ArgDef>& gradient_accumulation_buffers,
+                                               GraphAugmenter::GraphDefs& graph_defs) {
+  // the old sums and the values of a node share their types, so the gradients of each type get a node
+  std::map<int32_t, std::vector<size_t>> gradient_indices_per_type;
+  for (size_t i = 0; i < gradient_argdefs.size(); ++i) {
+    gradient_indices_per_type[gradient_argdefs[i].type_proto->tensor_type().elem_type()].push_back(i);
+  }
+
+  gradient_accumulation_buffers.resize(gradient_argdefs.size());
+  for (const auto& type_and_indices : gradient_indices_per_type) {
+    const auto& indices = type_and_indices.second;
+    std::vector<ArgDef> input_argdefs(1 + 2 * indices.size());
+    std::vector<ArgDef> output_argdefs(indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+      const ArgDef& gradient = gradient_argdefs[indices[i]];
+      ArgDef& gradient_accumulate_buffer = gradient_accumulation_buffers[indices[i]];
+      gradient_accumulate_buffer = CreateGradientAccumulationBuffer(nodearg_name_generator, gradient, graph_defs, true);
+      input_argdefs[1 + i] = gradient_accumulate_buffer;
+      input_argdefs[1 + indices.size() + i] = gradient;
+      output_argdefs[i] = ArgDef(nodearg_name_generator(gradient.name + "_accumulator_output"),
+                                 gradient_accumulate_buffer.type_proto);
+    }
+
+    graph_defs.AddNodeDefs({NodeDef(OpDef{"MultiTensorInPlaceAccumulator", kMSDomain, 1},
+                                    input_argdefs,
+                                    output_argdefs,
+                                    NodeAttributes(),
+                                    nodearg_name_generator("MultiTensorInPlaceAccumulator"))});
+
+    for (size_t i = 0; i < indices.size(); ++i) {
+      gradient_argdefs[indices[i]] = output_argdefs[i];
+    }
+  }
+}
+
 ArgDef BuildGroupNode(const std::string& group_output_name,
                       const std::vector<ArgDef>& input_argdefs,
                       GraphAugmenter::GraphDefs& graph_defs) {
@@ -194,11 +243,17 @@ Status OptimizerGraphBuilder::AddGradientScalingNodes(
 ArgDef AddGradientAccumulationNodes(const NodeArgNameGeneratorFn& nodearg_name_generator,
                                     std::vector<ArgDef>& gradient_argdefs,               // update argdefs in place
                                     std::vector<ArgDef>& gradient_accumulation_buffers,  // output
-                                    GraphAugmenter::GraphDefs& graph_defs) {
-  gradient_accumulation_buffers.resize(gradient_argdefs.size());
-  for (size_t i = 0; i < gradient_argdefs.size(); ++i) {
-    gradient_argdefs[i] = BuildGradientAccumulationNode(
-        nodearg_name_generator, gradient_argdefs[i], gradient_accumulation_buffers[i], graph_defs);
+                                    GraphAugmenter::GraphDefs& graph_defs,
+                                    bool use_multi_tensor_accumulation) {
+  if (use_multi_tensor_accumulation) {
+    BuildMultiTensorGradientAccumulationNodes(
+        nodearg_name_generator, gradient_argdefs, gradient_accumulation_buffers, graph_defs);
+  } else {
+    gradient_accumulation_buffers.resize(gradient_argdefs.size());
+    for (size_t i = 0; i < gradient_argdefs.size(); ++i) {
+      gradient_argdefs[i] = BuildGradientAccumulationNode(
+          nodearg_name_generator, gradient_argdefs[i], gradient_accumulation_buffers[i], graph_defs);
+    }
   }
 
   ArgDef group_accumulate_gradient_output = BuildGroupNode(nodearg_name_generator("Group_Accumulated_Gradients"),
@@ -369,6 +424,47 @@ Status OptimizerGraphBuilder::AddFiniteGradientCheck(
   return Status::OK();
 }
 
+Status OptimizerGraphBuilder::AddDynamicLossScaleUpdate(
+    const NodeArgNameGeneratorFn& nodearg_name_generator,
+    const Graph& graph,
+    const std::string& grad_norm_finite_name,
+    const std::vector<ArgDef>& optimizer_output_argdefs,
+    GraphAugmenter::GraphDefs& graph_defs) {
+  const DynamicLossScaleConfig& config = opt_graph_config_.dynamic_loss_scale_config;
+  const std::string& loss_scale_name = opt_graph_config_.loss_scale_input_name;
+  const NodeArg* loss_scale_node_arg = graph.GetNodeArg(loss_scale_name);
+  ORT_RETURN_IF_NOT(loss_scale_node_arg, "Failed to get NodeArg with name ", loss_scale_name);
+
+  // the loss scale input becomes an initializer, next to the count of the steps with finite gradients
+  const ArgDef loss_scale_argdef(loss_scale_name, loss_scale_node_arg->TypeAsProto());
+  const ArgDef stable_steps_argdef(nodearg_name_generator(loss_scale_name + "_stable_steps"),
+                                   graph_defs.CreateTypeProto({1}, ONNX_NAMESPACE::TensorProto_DataType_INT64));
+  graph_defs.AddInitializers({CreateTensorProto<float>(loss_scale_argdef.name, config.initial_loss_scale, {1}),
+                              CreateTensorProto<int64_t>(stable_steps_argdef.name, 0, {1})});
+
+  // the optimizers unscale the gradients with the loss scale of this step, so update it after all of them
+  std::vector<ArgDef> update_signal_inputs;
+  std::copy_if(optimizer_output_argdefs.begin(), optimizer_output_argdefs.end(),
+               std::back_inserter(update_signal_inputs), [](const ArgDef& argdef) { return !argdef.name.empty(); });
+  const ArgDef update_signal = BuildGroupNode(nodearg_name_generator("Group_Optimizer_Outputs"),
+                                              update_signal_inputs, graph_defs);
+
+  const ArgDef new_loss_scale_argdef(nodearg_name_generator(loss_scale_name + "_new"), loss_scale_argdef.type_proto);
+  const ArgDef new_stable_steps_argdef(nodearg_name_generator(stable_steps_argdef.name + "_new"),
+                                       stable_steps_argdef.type_proto);
+  std::vector<AttributeProto> attributes{
+      ONNX_NAMESPACE::MakeAttribute("up_scale_window", config.up_scale_window),
+      ONNX_NAMESPACE::MakeAttribute("min_loss_scale", config.min_loss_scale),
+      ONNX_NAMESPACE::MakeAttribute("max_loss_scale", config.max_loss_scale)};
+  graph_defs.AddNodeDefs({NodeDef{OpDef{"DynamicLossScale", kMSDomain, 1},
+                                  {loss_scale_argdef, stable_steps_argdef, ArgDef(grad_norm_finite_name), update_signal},
+                                  {new_loss_scale_argdef, new_stable_steps_argdef},
+                                  attributes,
+                                  new_loss_scale_argdef.name}});
+
+  return Status::OK();
+}
+
 OptimizerGraphBuilder::OptimizerGraphBuilder(
     const OptimizerBuilderRegistry& opt_builder_registry,
     const OptimizerGraphConfig& opt_graph_config,
@@ -431,12 +527,14 @@ Status OptimizerGraphBuilder::Build(
   ORT_RETURN_IF_ERROR(GetArgDefsFromGraph(graph, gradient_names_, gradient_argdefs));
 
   const bool is_gradient_accumulation_enabled = opt_graph_config_.gradient_accumulation_steps > 1;
+  const bool should_add_gradient_accumulation = is_gradient_accumulation_enabled && !BuildsGradientAccumulation();
 
   // add gradient accumulation
   std::vector<ArgDef> gradient_accumulation_buffers;
-  if (is_gradient_accumulation_enabled) {
+  if (should_add_gradient_accumulation) {
     ArgDef group_accumulate_gradient_output =
-        AddGradientAccumulationNodes(nodearg_name_generator, gradient_argdefs, gradient_accumulation_buffers, graph_defs);
+        AddGradientAccumulationNodes(nodearg_name_generator, gradient_argdefs, gradient_accumulation_buffers, graph_defs,
+                                     opt_graph_config_.use_multi_tensor_gradient_accumulation);
     optimizer_graph_outputs[OptimizerOutputKey::GradientAccumulation] = group_accumulate_gradient_output.name;
   }
 
@@ -453,13 +551,40 @@ Status OptimizerGraphBuilder::Build(
       should_add_gradient_norm, should_add_gradient_finite_check,
       graph, graph_defs, weight_argdefs, gradient_argdefs, weight_to_opt_mapping, optimizer_graph_outputs));
 
+  // update the loss scale on the device from the finite check of the gradients
+  const auto grad_norm_finite_it = optimizer_graph_outputs.find(OptimizerOutputKey::GradientAllIsFinite);
+  const bool should_add_dynamic_loss_scale = opt_graph_config_.use_dynamic_loss_scale &&
+                                             !opt_graph_config_.loss_scale_input_name.empty() &&
+                                             grad_norm_finite_it != optimizer_graph_outputs.end();
+  if (should_add_dynamic_loss_scale) {
+    std::vector<ArgDef> optimizer_output_argdefs(weight_argdefs);
+    optimizer_output_argdefs.insert(optimizer_output_argdefs.end(), gradient_argdefs.begin(), gradient_argdefs.end());
+    ORT_RETURN_IF_ERROR(AddDynamicLossScaleUpdate(
+        nodearg_name_generator, graph, grad_norm_finite_it->second, optimizer_output_argdefs, graph_defs));
+  }
+
   // add zero gradient
-  if (is_gradient_accumulation_enabled) {
+  if (should_add_gradient_accumulation) {
     ORT_RETURN_IF_ERROR(AddZeroGradientNodes(
         nodearg_name_generator, weight_argdefs, gradient_accumulation_buffers, graph_defs));
   }
 
-  return GraphAugmenter::AugmentGraph(graph, graph_defs);
+  ORT_RETURN_IF_ERROR(GraphAugmenter::AugmentGraph(graph, graph_defs));
+
+  if (should_add_dynamic_loss_scale) {
+    // the loss scale is an initializer now and is no longer fed
+    const NodeArg* loss_scale_node_arg = graph.GetNodeArg(opt_graph_config_.loss_scale_input_name);
+    std::vector<const NodeArg*> inputs;
+    const auto& inputs_including_initializers = graph.GetInputsIncludingInitializers();
+    std::copy_if(inputs_including_initializers.begin(), inputs_including_initializers.end(),
+                 std::back_inserter(inputs),
+                 [loss_scale_node_arg](const NodeArg* input) { return input != loss_scale_node_arg; });
+    graph.SetInputs(inputs);
+    graph.SetGraphResolveNeeded();
+    ORT_RETURN_IF_ERROR(graph.Resolve());
+  }
+
+  return Status::OK();
 }
 
 Status OptimizerGraphBuilder::BuildInternal(
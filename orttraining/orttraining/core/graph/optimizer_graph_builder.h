@@ -30,6 +30,23 @@ ArgDef BuildGradientAccumulationNode(const NodeArgNameGeneratorFn& nodearg_name_
                                      GraphAugmenter::GraphDefs& graph_defs,
                                      bool add_accumulate_buffer_as_initializers = true);
 
+// Accumulates the gradients with a MultiTensorInPlaceAccumulator node per gradient type, replacing gradient_argdefs
+// with the accumulated gradients. The node waits for all of the gradients of its type, so they are all alive
+// together, in exchange for a single launch instead of one per gradient.
+void BuildMultiTensorGradientAccumulationNodes(const NodeArgNameGeneratorFn& nodearg_name_generator,
+                                               std::vector<ArgDef>& gradient_argdefs,
+                                               std::vector<ArgDef>& gradient_accumulation_buffers,
+                                               GraphAugmenter::GraphDefs& graph_defs);
+
+ArgDef BuildGroupNode(const std::string& group_output_name,
+                      const std::vector<ArgDef>& input_argdefs,
+                      GraphAugmenter::GraphDefs& graph_defs);
+
+ArgDef BuildZeroGradientNode(const NodeArgNameGeneratorFn& nodearg_name_generator,
+                             const ArgDef& control_signal,
+                             const ArgDef& gradient,
+                             GraphAugmenter::GraphDefs& graph_defs);
+
 /**
  * Builds the optimizer components on top of an existing training graph.
  * The optimizers used are determined by the weight_names_to_opt_configs parameter
@@ -80,6 +97,10 @@ class OptimizerGraphBuilder {
       std::unordered_map<std::string, std::unordered_map<std::string, std::string>>& weight_to_opt_mapping,
       OptimizerOutputKeyMap<std::string>& optimizer_graph_outputs);
 
+  // Whether BuildInternal() adds the gradient accumulation and the zeroing of the accumulation buffers itself,
+  // instead of Build() accumulating the gradients before calling it.
+  virtual bool BuildsGradientAccumulation() const { return false; }
+
   Status AddGradientPassThroughNode(
       const NodeArgNameGeneratorFn& nodearg_name_generator,
       std::vector<ArgDef>& gradient_argdefs,  // update argdefs in place
@@ -115,6 +136,15 @@ class OptimizerGraphBuilder {
       ArgDef& grad_norm_finite_argdef,
       const std::string& node_name = "all_gradients_finite");
 
+  // Adds the DynamicLossScale node that updates the loss scale initializer in place once the optimizer outputs are
+  // ready, so the loss scale and its update stay on the device.
+  Status AddDynamicLossScaleUpdate(
+      const NodeArgNameGeneratorFn& nodearg_name_generator,
+      const Graph& graph,
+      const std::string& grad_norm_finite_name,
+      const std::vector<ArgDef>& optimizer_output_argdefs,
+      GraphAugmenter::GraphDefs& graph_defs);
+
   Status AddDirectWeightUpdate(
       const OptimizerBuilderRegistry& opt_builder_registry,
       std::vector<ArgDef>& weight_argdefs,
@@ -133,6 +133,119 @@ static void propagateRecvOutputTensorElemTypes(
   }
 }
 
+// The update count, then repeated [w, g, m1, m2, w_mixed_precision] inputs and their updated outputs, shared by the
+// optimizers updating all the weights in a single node.
+static void AddMultiTensorOptimizerInputsAndOutputs(OpSchema& op_schema) {
+  op_schema.TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+    // Handle update count, the first output.
+    const size_t step_input_index = 4;
+    const size_t step_output_index = 0;
+    auto input_type = ctx.getInputType(step_input_index);
+    if (input_type != nullptr) {
+      propagateElemTypeFromInputToOutput(ctx, step_input_index, step_output_index);
+      if (hasInputShape(ctx, step_input_index)) {
+        propagateShapeFromInputToOutput(ctx, step_input_index, step_output_index);
+      }
+    }
+
+    // Handle other tensors including new weight, new gradient (update direction),
+    // new momentums.
+    for (size_t i = 0; i < ctx.getNumInputs() - 5; ++i) {
+      const size_t input_index = 5 + i;   // The first 5 inputs don't affect output shape.
+      const size_t output_index = 1 + i;  // The first output has been processed above.
+      input_type = ctx.getInputType(input_index);
+      if (input_type != nullptr) {
+        propagateElemTypeFromInputToOutput(ctx, input_index, output_index);
+        if (hasInputShape(ctx, input_index)) {
+          propagateShapeFromInputToOutput(ctx, input_index, output_index);
+        }
+      }
+    }
+  });
+
+  op_schema
+      .Input(
+          0,
+          "update_signal",
+          "This signal indicates if weight tensors should be updated.",
+          "T_BOOL",
+          OpSchema::Optional)
+      .Input(
+          1,
+          "loss_scale",
+          "Loss scale for mixed precision training.",
+          "T2",
+          OpSchema::Optional)
+      .Input(
+          2,
+          "gradient_norm",
+          "Norm of global gradient.",
+          "T_GRAD_NORM",
+          OpSchema::Optional)
+      .Input(
+          3,
+          "R",
+          "The initial learning rate.",
+          "T1",
+          OpSchema::Optional)
+      .Input(
+          4,
+          "step",
+          "One-based index of the current training iteration.",
+          "TInt64",
+          OpSchema::Optional);
+
+  AddRepeatedInputs(
+      op_schema,
+      5,
+      1024,
+      {"weights",
+       "gradients",
+       "moment1",
+       "moment2",
+       "mixed_precision_weights"},
+      {"weights to optimize.",
+       "gradients computed in this iteration.",
+       "exponentially averaged historical gradients.",
+       "exponentially averaged historical squared gradients.",
+       "FP16 or BF16 weights to optimize."},
+      {"T2",
+       "T3",
+       "T4",
+       "T4",
+       "T_MIXED_PRECISION_FP"},
+      OpSchema::Optional);
+
+  op_schema
+      .Output(
+          0,
+          "new_step",
+          "One-based index of the next training iteration.",
+          "TInt64",
+          OpSchema::Optional);
+
+  AddRepeatedOutputs(
+      op_schema,
+      1,
+      1024,
+      {"new_weights",
+       "new_gradients",
+       "new_moment_1",
+       "new_moment_2",
+       "new_mixed_precision_weights"},
+      {"New weights",
+       "New gradients",
+       "New averaged gradients",
+       "New averaged squared gradients",
+       "New FP16 or BF16 weights"},
+      {"T2",
+       "T3",
+       "T4",
+       "T4",
+       "T_MIXED_PRECISION_FP"},
+      OpSchema::Optional);
+}
+
 // TODO: This is copied from onnx schemas. When the change is in and we update this can be removed.
 // For Brevity documentation was not copied
 OpSchema& RegisterLambOpSchema(OpSchema&& op_schema) {
@@ -213,115 +326,100 @@ OpSchema& RegisterLambOpSchema(OpSchema&& op_schema) {
       .TypeConstraint(
           "TInt64",
           {"tensor(int64)"},
-          "Constrain update count to 64-bit integer")
-      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
-        // Handle update count, the first output.
-        const size_t step_input_index = 4;
-        const size_t step_output_index = 0;
-        auto input_type = ctx.getInputType(step_input_index);
-        if (input_type != nullptr) {
-          propagateElemTypeFromInputToOutput(ctx, step_input_index, step_output_index);
-          if (hasInputShape(ctx, step_input_index)) {
-            propagateShapeFromInputToOutput(ctx, step_input_index, step_output_index);
-          }
-        }
+          "Constrain update count to 64-bit integer");
 
-        // Handle other tensors including new weight, new gradient (update direction),
-        // new momentums.
-        for (size_t i = 0; i < ctx.getNumInputs() - 5; ++i) {
-          const size_t input_index = 5 + i;   // The first 5 inputs don't affect output shape.
-          const size_t output_index = 1 + i;  // The first output has been processed above.
-          input_type = ctx.getInputType(input_index);
-          if (input_type != nullptr) {
-            propagateElemTypeFromInputToOutput(ctx, input_index, output_index);
-            if (hasInputShape(ctx, input_index)) {
-              propagateShapeFromInputToOutput(ctx, input_index, output_index);
-            }
-          }
-        }
-      });
+  AddMultiTensorOptimizerInputsAndOutputs(op_schema);
+
+  return op_schema;
+}
 
+OpSchema& RegisterMultiTensorAdamOpSchema(OpSchema&& op_schema) {
   op_schema
-      .Input(
-          0,
-          "update_signal",
-          "This signal indicates if weight tensors should be updated.",
-          "T_BOOL",
-          OpSchema::Optional)
-      .Input(
-          1,
-          "loss_scale",
-          "Loss scale for mixed precision training.",
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc("AdamOptimizer of all the weights in a single node, the i-th attribute values apply to the i-th weight. "
+              "Weights sharing the same attribute values are updated by a single kernel launch.")
+      .Attr(
+          "alpha",
+          "Coefficient of previous gradient in running average.",
+          AttributeProto::FLOATS,
+          std::vector<float>(1024, 0.9f))
+      .Attr(
+          "beta",
+          "Coefficient of previous squared gradient in running average.",
+          AttributeProto::FLOATS,
+          std::vector<float>(1024, 0.999f))
+      .Attr(
+          "lambda",
+          "Regularization coefficient of 0.5 * lambda * ||X||_2^2. Default to 0, "
+          "which means no regularization.",
+          AttributeProto::FLOATS,
+          std::vector<float>(1024, 0.0f))
+      .Attr(
+          "epsilon",
+          "Small scalar to avoid dividing by zero.",
+          AttributeProto::FLOATS,
+          std::vector<float>(1024, 1e-8f))
+      .Attr(
+          "max_norm_clip",
+          "clip threshold of gradients.",
+          AttributeProto::FLOATS,
+          std::vector<float>(1024, 1.f))
+      .Attr(
+          "do_bias_correction",
+          "Compute unbiased 1st and 2nd momentums.",
+          AttributeProto::INT,
+          static_cast<int64_t>(1))
+      .Attr(
+          "weight_decay_mode",
+          "Modes for applying weight decay, "
+          "0 means applying decay before weight update, "
+          "1 means applying decay after weight update.",
+          AttributeProto::INT,
+          static_cast<int64_t>(0))
+      .TypeConstraint(
+          "T1",
+          {"tensor(float16)", "tensor(float)", "tensor(bfloat16)"},
+          "Constrain learning rate to float")
+      .TypeConstraint(
           "T2",
-          OpSchema::Optional)
-      .Input(
-          2,
-          "gradient_norm",
-          "Norm of global gradient.",
+          {"tensor(float)"},
+          "Constrain input types to float tensors.")
+      .TypeConstraint(
+          "T3",
+          {"tensor(float16)", "tensor(float)", "tensor(bfloat16)"},
+          "Constrain input types to float tensors.")
+      .TypeConstraint(
+          "T4",
+          {"tensor(float16)", "tensor(float)", "tensor(bfloat16)"},
+          "Constrain input types to float tensors.")
+      .TypeConstraint(
+          "T_MIXED_PRECISION_FP",
+          {"tensor(float16)", "tensor(bfloat16)"},
+          "Constrain input types to float16 or bfloat16 tensors.")
+      .TypeConstraint(
           "T_GRAD_NORM",
-          OpSchema::Optional)
-      .Input(
-          3,
-          "R",
-          "The initial learning rate.",
-          "T1",
-          OpSchema::Optional)
-      .Input(
-          4,
-          "step",
-          "One-based index of the current training iteration.",
+          {"tensor(float16)", "tensor(float)", "tensor(bfloat16)"},
+          "Constrain input types to float tensors.")
+      .TypeConstraint(
+          "T_BOOL",
+          {"tensor(bool)"},
+          "Constrain types to boolean tensors.")
+      .TypeConstraint(
           "TInt64",
-          OpSchema::Optional);
+          {"tensor(int64)"},
+          "Constrain update count to 64-bit integer");
 
-  AddRepeatedInputs(
-      op_schema,
-      5,
-      1024,
-      {"weights",
-       "gradients",
-       "moment1",
-       "moment2",
-       "mixed_precision_weights"},
-      {"weights to optimize.",
-       "gradients computed in this iteration.",
-       "exponentially averaged historical gradients.",
-       "exponentially averaged historical squared gradients.",
-       "FP16 or BF16 weights to optimize."},
-      {"T2",
-       "T3",
-       "T4",
-       "T4",
-       "T_MIXED_PRECISION_FP"},
-      OpSchema::Optional);
+  AddMultiTensorOptimizerInputsAndOutputs(op_schema);
 
-  op_schema
-      .Output(
-          0,
-          "new_step",
-          "One-based index of the next training iteration.",
-          "TInt64",
-          OpSchema::Optional);
+  return op_schema;
+}
 
-  AddRepeatedOutputs(
-      op_schema,
-      1,
-      1024,
-      {"new_weights",
-       "new_gradients",
-       "new_moment_1",
-       "new_moment_2",
-       "new_mixed_precision_weights"},
-      {"New weights",
-       "New gradients",
-       "New averaged gradients",
-       "New averaged squared gradients",
-       "New FP16 or BF16 weights"},
-      {"T2",
-       "T3",
-       "T4",
-       "T4",
-       "T_MIXED_PRECISION_FP"},
-      OpSchema::Optional);
+OpSchema& RegisterOffloadedMultiTensorAdamOpSchema(OpSchema&& op_schema) {
+  RegisterMultiTensorAdamOpSchema(std::move(op_schema))
+      .SetDoc("MultiTensorAdamOptimizer with the weights and the moments in host memory, e.g. pinned memory the "
+              "device accesses directly, so they don't take device memory. The weights are the full precision "
+              "copies, the mixed precision weights and the gradients are in device memory.");
 
   return op_schema;
 }
@@ -719,6 +817,8 @@ void RegisterTrainingOpSchemas() {
           "Constrain types to boolean tensors.");
 
   ONNX_CONTRIB_OPERATOR_SCHEMA_ELSEWHERE(LambOptimizer, RegisterLambOpSchema);
+  ONNX_CONTRIB_OPERATOR_SCHEMA_ELSEWHERE(MultiTensorAdamOptimizer, RegisterMultiTensorAdamOpSchema);
+  ONNX_CONTRIB_OPERATOR_SCHEMA_ELSEWHERE(OffloadedMultiTensorAdamOptimizer, RegisterOffloadedMultiTensorAdamOpSchema);
 
   ONNX_CONTRIB_OPERATOR_SCHEMA(InPlaceAccumulator)
       .SetDomain(kMSDomain)
@@ -744,6 +844,36 @@ void RegisterTrainingOpSchemas() {
         propagateShapeAndTypeFromFirstInput(ctx);
       });
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(MultiTensorInPlaceAccumulator)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc("in-place accumulator for a list of N tensors, the i-th new_sum is old_sum_i + value_i as in "
+              "InPlaceAccumulator. All of the old sums have one type and all of the values have one type.")
+      .Input(0, "update_signal", "This signal indicates if tensors should be updated", "T_BOOL", OpSchema::Optional)
+      .Input(1, "inputs", "the N old sums, historical results of accumulator, followed by the N values", "T",
+             OpSchema::Variadic, false)
+      .Output(0, "new_sums", "the N updated results of accumulator", "T", OpSchema::Variadic, false)
+      .TypeConstraint(
+          "T",
+          {"tensor(float16)", "tensor(float)", "tensor(bfloat16)"},
+          "Constrain input and output types to float tensors.")
+      .TypeConstraint(
+          "T_BOOL",
+          {"tensor(bool)"},
+          "Constrain types to boolean tensors.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        if (ctx.getNumInputs() != 1 + 2 * ctx.getNumOutputs()) {
+          fail_shape_inference("MultiTensorInPlaceAccumulator must have an old sum and a value per output.");
+        }
+        for (size_t i = 0; i < ctx.getNumOutputs(); ++i) {
+          const size_t old_sum_index = 1 + i;
+          propagateElemTypeFromInputToOutput(ctx, old_sum_index, i);
+          if (hasInputShape(ctx, old_sum_index)) {
+            propagateShapeFromInputToOutput(ctx, old_sum_index, i);
+          }
+        }
+      });
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(ZeroGradient)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
@@ -763,6 +893,37 @@ void RegisterTrainingOpSchemas() {
         propagateShapeAndTypeFromFirstInput(ctx);
       });
 
+  ONNX_CONTRIB_OPERATOR_SCHEMA(DynamicLossScale)
+      .SetDomain(kMSDomain)
+      .SinceVersion(1)
+      .SetDoc(
+          "Updates the loss scale of mixed precision training from whether all of the gradients of the step are finite. "
+          "The loss scale is halved if they are not. It is doubled once they have been finite for up_scale_window "
+          "steps in a row. The loss scale and the count of the steps stay on the device of the kernel, so the "
+          "trainer does not read them back each step.")
+      .Input(0, "loss_scale", "The loss scale of the step.", "T")
+      .Input(1, "stable_steps", "The number of steps in a row that had finite gradients.", "T_INT")
+      .Input(2, "is_all_finite", "Whether all of the gradients of the step are finite.", "T_BOOL")
+      .Input(3, "update_signal",
+             "The loss scale is updated after this input is ready, for example after the optimizers that read it. "
+             "Its value is not used.",
+             "T_ANY", OpSchema::Optional)
+      .Output(0, "new_loss_scale", "The loss scale of the next step.", "T")
+      .Output(1, "new_stable_steps", "The number of steps in a row that had finite gradients, after this step.", "T_INT")
+      .Attr("up_scale_window", "The number of steps in a row with finite gradients that double the loss scale.",
+            AttributeProto::INT, static_cast<int64_t>(2000))
+      .Attr("min_loss_scale", "The smallest loss scale.", AttributeProto::FLOAT, 1.0f)
+      .Attr("max_loss_scale", "The largest loss scale.", AttributeProto::FLOAT, static_cast<float>(1 << 24))
+      .TypeConstraint("T", {"tensor(float)"}, "Constrain the loss scale to float tensors.")
+      .TypeConstraint("T_INT", {"tensor(int64)"}, "Constrain the step count to int64 tensors.")
+      .TypeConstraint("T_BOOL", {"tensor(bool)"}, "Constrain types to boolean tensors.")
+      .TypeConstraint("T_ANY", OpSchema::all_tensor_types_with_bfloat(), "update_signal can be of any tensor type.")
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateShapeAndTypeFromFirstInput(ctx);
+        propagateElemTypeFromInputToOutput(ctx, 1, 1);
+        propagateShapeFromInputToOutput(ctx, 1, 1);
+      });
+
   // TODO: Depreacate this schema when training support is udpated to opset-12
   ONNX_CONTRIB_OPERATOR_SCHEMA(GatherND)
       .SetDomain(kOnnxDomain)
@@ -942,6 +1103,12 @@ Example 4:
             "4 - horozontal parallel, 5 - model parallel.",
             AttributeProto::INT,
             static_cast<int64_t>(0))
+      .Attr("overlap_with_compute",
+            "If 1, the reduction runs on a separate stream and overlaps the kernels that follow it, "
+            "so the outputs may only be read after a later NcclAllReduce with overlap_with_compute = 0, "
+            "which waits for the overlapped reductions before its own.",
+            AttributeProto::INT,
+            static_cast<int64_t>(0))
       .Input(0, "input", "tensors to be reduced", "T", OpSchema::Variadic)
       .Output(0, "output", "reduced tensors", "T", OpSchema::Variadic)
       .TypeConstraint(
@@ -418,6 +418,37 @@ static std::vector<ArgDef> GetGradientNormInputs(
   return inputs;
 }
 
+// Accumulates the reduce-scattered gradients of the partitions this rank updates only, so that the accumulation
+// buffers hold 1/data_parallel_group_size of the gradients. The other gradients are discarded after their
+// reduction. If the rank updates no partition, the group output waits for the reduction only.
+static Status AddGradientAccumulationForPartitions(
+    const NodeArgNameGeneratorFn& nodearg_name_generator,
+    const std::vector<OptimizerNodeConfig>& opt_configs,
+    std::vector<ArgDef>& gradient_argdefs,               // update argdefs in place
+    std::vector<ArgDef>& gradient_accumulation_buffers,  // output, empty for the partitions of other ranks
+    GraphAugmenter::GraphDefs& graph_defs,
+    OptimizerOutputKeyMap<std::string>& optimizer_graph_outputs) {
+  ORT_RETURN_IF_NOT(gradient_argdefs.size() == opt_configs.size());
+
+  gradient_accumulation_buffers.resize(gradient_argdefs.size());
+  std::vector<ArgDef> accumulated_gradient_argdefs;
+  for (size_t i = 0; i < gradient_argdefs.size(); ++i) {
+    if (opt_configs[i].enabled) {
+      gradient_argdefs[i] = BuildGradientAccumulationNode(
+          nodearg_name_generator, gradient_argdefs[i], gradient_accumulation_buffers[i], graph_defs);
+      accumulated_gradient_argdefs.push_back(gradient_argdefs[i]);
+    }
+  }
+
+  ArgDef group_accumulate_gradient_output = BuildGroupNode(
+      nodearg_name_generator("Group_Accumulated_Gradients"),
+      accumulated_gradient_argdefs.empty() ? gradient_argdefs : accumulated_gradient_argdefs,
+      graph_defs);
+  graph_defs.AddGraphOutputs({group_accumulate_gradient_output.name});
+  optimizer_graph_outputs[OptimizerOutputKey::GradientAccumulation] = group_accumulate_gradient_output.name;
+  return Status::OK();
+}
+
 ZeROOptimizerGraphBuilder::ZeROOptimizerGraphBuilder(
     const OptimizerBuilderRegistry& opt_builder_registry,
     const OptimizerGraphConfig& opt_graph_config,
@@ -432,6 +463,17 @@ ZeROOptimizerGraphBuilder::ZeROOptimizerGraphBuilder(
   ORT_ENFORCE(opt_graph_config.data_parallel_group_size > 1, "ZeRO optimizer graph builder can only be used for distributed training.");
   ORT_ENFORCE(opt_graph_config.use_nccl, "Distributed training with ZeRO is only supported with NCCL.");
   ORT_ENFORCE(IsNcclAvailable(), "Distributed training with NCCL is not supported, as NCCL is not enabled in this build.");
+  ORT_ENFORCE(opt_graph_config.deepspeed_zero.stage <= 2,
+              "ZeRO stage ", opt_graph_config.deepspeed_zero.stage, " is not supported, the maximum is stage 2.");
+  // the partitioned weights are views produced on the device, not initializers in host memory
+  for (const auto& weight_and_opt_config : weight_names_to_opt_configs) {
+    ORT_ENFORCE(weight_and_opt_config.second.name != "OffloadedMultiTensorAdamOptimizer",
+                "OffloadedMultiTensorAdamOptimizer is not supported with ZeRO.");
+  }
+}
+
+bool ZeROOptimizerGraphBuilder::BuildsGradientAccumulation() const {
+  return opt_graph_config_.deepspeed_zero.stage >= 2;
 }
 
 Status ZeROOptimizerGraphBuilder::BuildInternal(
@@ -462,6 +504,15 @@ Status ZeROOptimizerGraphBuilder::BuildInternal(
   // add Reducescatter for gradients
   ORT_RETURN_IF_ERROR(AddNcclReduceScatterForGradients(gradient_argdefs, graph_defs));
 
+  // stage 2: reduce-scatter the gradients of every step and accumulate the local partitions only
+  const bool is_gradient_accumulation_enabled = opt_graph_config_.gradient_accumulation_steps > 1;
+  std::vector<ArgDef> gradient_accumulation_buffers;
+  if (BuildsGradientAccumulation() && is_gradient_accumulation_enabled) {
+    ORT_RETURN_IF_ERROR(AddGradientAccumulationForPartitions(
+        nodearg_name_generator, opt_configs_, gradient_argdefs, gradient_accumulation_buffers, graph_defs,
+        optimizer_graph_outputs));
+  }
+
   // check if all gradients are finite
   ArgDef global_grad_norm_argdef;
   ArgDef global_grad_norm_finite_argdef;
@@ -488,6 +539,13 @@ Status ZeROOptimizerGraphBuilder::BuildInternal(
       opt_configs_, graph_defs,
       optimizer_state_initializer_names));
 
+  // zero the accumulation buffers after the update of their partitions
+  for (size_t i = 0; i < gradient_accumulation_buffers.size(); ++i) {
+    if (opt_configs_[i].enabled) {
+      BuildZeroGradientNode(nodearg_name_generator, weight_argdefs[i], gradient_accumulation_buffers[i], graph_defs);
+    }
+  }
+
   // add Allgather for weights
   ORT_RETURN_IF_ERROR(AddNcclAllGatherForWeights(weight_argdefs, graph_defs));
 
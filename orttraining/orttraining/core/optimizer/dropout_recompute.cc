@@ -4,6 +4,8 @@
 #include "orttraining/core/optimizer/dropout_recompute.h"
 #include "orttraining/core/graph/recompute_graph_utils.h"
 
+#include <algorithm>
+
 namespace onnxruntime {
 
 Node& InsertDropoutRecompute(Graph& graph, Node& node, bool use_original_input) {
@@ -35,4 +37,60 @@ Node& InsertDropoutRecompute(Graph& graph, Node& node, bool use_original_input)
   return recompute_node;
 }
 
+void InsertRecomputeNodes(Graph& graph, const std::vector<const Node*>& nodes, int priority) {
+  auto initializers = graph.GetAllInitializedTensors();
+
+  for (const Node* n : nodes) {
+    Node* node = graph.GetNode(n->Index());
+
+    // recomputed Dropout need to produce the same output as original dropout
+    // currently reusing original dropout's mask to achieve this
+    if (node->OpType() == "Dropout") {
+      const NodeArg* input = node->InputDefs()[0];
+      const Node* p_node = graph.GetProducerNode(input->Name());
+
+      bool use_original_input =
+          initializers.find(input->Name()) != initializers.end() ||
+          std::find(nodes.begin(), nodes.end(), p_node) == nodes.end();
+
+      Node& recompute_node = InsertDropoutRecompute(graph, *node, use_original_input);
+      recompute_node.SetPriority(priority);
+      continue;
+    }
+
+    // prepare inputs for recompute node
+    std::vector<NodeArg*> recomputed_inputs;
+    for (NodeArg* input : node->MutableInputDefs()) {
+      const Node* p_node = graph.GetProducerNode(input->Name());
+
+      // do not duplicate initializers in recompute subgraph
+      if (initializers.find(input->Name()) != initializers.end() ||
+          std::find(nodes.begin(), nodes.end(), p_node) == nodes.end()) {
+        recomputed_inputs.push_back(input);
+      } else {
+        auto& recomputed_input = graph.GetOrCreateNodeArg(graph_utils::RecomputeName(input->Name()),
+                                                          input->TypeAsProto());
+        recomputed_inputs.push_back(&recomputed_input);
+      }
+    }
+
+    // prepare ouputs for recompute node
+    std::vector<NodeArg*> recomputed_outputs;
+    for (NodeArg* output : node->MutableOutputDefs()) {
+      auto& recomputed_output = graph.GetOrCreateNodeArg(graph_utils::RecomputeName(output->Name()),
+                                                         output->TypeAsProto());
+      recomputed_outputs.push_back(&recomputed_output);
+    }
+
+    Node& recompute_node = graph.AddNode(node->Name() + "_recompute",
+                                         node->OpType(),
+                                         "Recompute of " + node->Name(),
+                                         recomputed_inputs,
+                                         recomputed_outputs,
+                                         &node->GetAttributes(),
+                                         node->Domain());
+    recompute_node.SetPriority(priority);
+  }
+}
+
 }  // namespace onnxruntime
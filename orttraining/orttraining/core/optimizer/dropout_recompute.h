@@ -3,10 +3,16 @@
 
 #pragma once
 
+#include <vector>
+
 #include "core/graph/graph.h"
 
 namespace onnxruntime {
 
 Node& InsertDropoutRecompute(Graph& graph, Node& node, bool use_original_input);
 
+// Adds a recompute node with the given priority for each of nodes, which are in topological order.
+// The recompute nodes read the recomputed outputs of the nodes in the list and the original outputs of the others.
+void InsertRecomputeNodes(Graph& graph, const std::vector<const Node*>& nodes, int priority);
+
 }  // namespace onnxruntime
@@ -43,6 +43,7 @@
 #include "orttraining/core/optimizer/concat_replacement.h"
 #include "orttraining/core/optimizer/insert_output_rewriter.h"
 #include "orttraining/core/optimizer/localized_recompute.h"
+#include "orttraining/core/optimizer/memory_budget_recompute.h"
 #include "orttraining/core/optimizer/nonzero_shape_setter.h"
 #include "orttraining/core/optimizer/transformer_layer_recompute.h"
 
@@ -109,6 +110,11 @@ std::vector<std::unique_ptr<GraphTransformer>> GeneratePreTrainingTransformers(
         transformers.emplace_back(onnxruntime::make_unique<TransformerLayerRecompute>(
             config.number_recompute_layers, compatible_eps));
       }
+      // after the pattern based recomputes, which it doesn't recompute again
+      if (config.recompute_memory_budget_bytes > 0) {
+        transformers.emplace_back(onnxruntime::make_unique<MemoryBudgetRecompute>(
+            config.recompute_memory_budget_bytes, config.recompute_dim_params, compatible_eps));
+      }
     } break;
 
     case TransformerLevel::Level2: {
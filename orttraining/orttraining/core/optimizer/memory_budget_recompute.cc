@@ -0,0 +1,216 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "orttraining/core/optimizer/memory_budget_recompute.h"
+
+#include <algorithm>
+
+#include "core/framework/session_options.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "orttraining/core/graph/recompute_graph_utils.h"
+#include "orttraining/core/optimizer/dropout_recompute.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+
+namespace {
+
+int64_t GetElementSize(int32_t element_type) {
+  switch (element_type) {
+    case TensorProto_DataType_BOOL:
+    case TensorProto_DataType_INT8:
+    case TensorProto_DataType_UINT8:
+      return 1;
+    case TensorProto_DataType_FLOAT16:
+    case TensorProto_DataType_BFLOAT16:
+    case TensorProto_DataType_INT16:
+    case TensorProto_DataType_UINT16:
+      return 2;
+    case TensorProto_DataType_FLOAT:
+    case TensorProto_DataType_INT32:
+    case TensorProto_DataType_UINT32:
+      return 4;
+    case TensorProto_DataType_DOUBLE:
+    case TensorProto_DataType_INT64:
+    case TensorProto_DataType_UINT64:
+      return 8;
+    default:
+      return -1;
+  }
+}
+
+// the outputs of these ops share the buffer of their input, so they don't use memory of their own
+const std::unordered_set<std::string> kViewOps{"Reshape", "Squeeze", "Unsqueeze", "Flatten", "Identity"};
+
+// the estimated floating point operations per output element of the ops that can be recomputed
+const std::unordered_map<std::string, int64_t> kFlopsPerElement{
+    {"Add", 1}, {"Sub", 1}, {"Mul", 1}, {"Div", 1}, {"Neg", 1}, {"Relu", 1}, {"Cast", 1}, {"Where", 1},
+    {"Transpose", 1}, {"Dropout", 1}, {"Gelu", 8}, {"FastGelu", 8}, {"BiasGelu", 8}, {"Tanh", 8},
+    {"Sigmoid", 8}, {"Erf", 8}, {"Softmax", 5}, {"LayerNormalization", 8}};
+
+struct Candidate {
+  const Node* node;
+  size_t position;
+  int64_t bytes;
+  int64_t flops;
+};
+
+}  // namespace
+
+int64_t MemoryBudgetRecompute::GetTensorSizeInBytes(const NodeArg& arg) const {
+  const auto* type = arg.TypeAsProto();
+  const auto* shape = arg.Shape();
+  if (type == nullptr || !type->has_tensor_type() || shape == nullptr) {
+    return -1;
+  }
+
+  int64_t size = GetElementSize(type->tensor_type().elem_type());
+  for (int i = 0; i < shape->dim_size() && size >= 0; ++i) {
+    const auto& dim = shape->dim(i);
+    if (utils::HasDimValue(dim)) {
+      size *= dim.dim_value();
+    } else if (utils::HasDimParam(dim) && dim_params_.count(dim.dim_param()) > 0) {
+      size *= dim_params_.at(dim.dim_param());
+    } else {
+      size = -1;
+    }
+  }
+
+  return size;
+}
+
+int64_t MemoryBudgetRecompute::GetRecomputeFlops(const Node& node) const {
+  const auto& outputs = node.OutputDefs();
+  if (outputs.empty() || outputs[0]->TypeAsProto() == nullptr) {
+    return -1;
+  }
+
+  const int64_t output_size = GetTensorSizeInBytes(*outputs[0]);
+  const int64_t element_size = GetElementSize(outputs[0]->TypeAsProto()->tensor_type().elem_type());
+  if (output_size < 0 || element_size <= 0) {
+    return -1;
+  }
+  const int64_t num_elements = output_size / element_size;
+
+  if (node.OpType() == "MatMul" || node.OpType() == "Gemm") {
+    const auto* a_shape = node.InputDefs()[0]->Shape();
+    if (a_shape == nullptr || a_shape->dim_size() < 1) {
+      return -1;
+    }
+
+    const auto* trans_a = graph_utils::GetNodeAttribute(node, "transA");
+    const bool is_a_transposed = node.OpType() == "Gemm" && trans_a != nullptr && trans_a->i() != 0;
+    const auto& k_dim = a_shape->dim(is_a_transposed ? 0 : a_shape->dim_size() - 1);
+    if (!utils::HasDimValue(k_dim)) {
+      return -1;
+    }
+
+    return 2 * k_dim.dim_value() * num_elements;
+  }
+
+  const auto it = kFlopsPerElement.find(node.OpType());
+  if (it == kFlopsPerElement.end()) {
+    return -1;
+  }
+
+  // Dropout is recomputed from its mask, see InsertDropoutRecompute()
+  if (node.OpType() == "Dropout" &&
+      (node.InputDefs().size() != 3 || outputs.size() != 2 || !outputs[1]->Exists())) {
+    return -1;
+  }
+
+  return it->second * num_elements;
+}
+
+Status MemoryBudgetRecompute::ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/, const logging::Logger& logger) const {
+  if (memory_budget_bytes_ <= 0) {
+    return Status::OK();
+  }
+
+  std::unordered_set<const NodeArg*> graph_outputs(graph.GetOutputs().begin(), graph.GetOutputs().end());
+
+  GraphViewer graph_viewer(graph);
+  const auto& node_ids = graph_viewer.GetNodesInTopologicalOrder();
+
+  int64_t activation_bytes = 0;
+  std::vector<Candidate> candidates;
+  for (size_t position = 0; position < node_ids.size(); ++position) {
+    const Node& node = *graph.GetNode(node_ids[position]);
+    if (kViewOps.count(node.OpType()) > 0) {
+      continue;
+    }
+
+    int64_t node_bytes = 0;
+    bool can_recompute = true;
+    for (const NodeArg* output : node.OutputDefs()) {
+      if (!output->Exists()) {
+        continue;
+      }
+
+      const int64_t bytes = GetTensorSizeInBytes(*output);
+      if (bytes >= 0) {
+        activation_bytes += bytes;
+        node_bytes += bytes;
+      }
+
+      // graph outputs are kept anyway, and other transformers may have recomputed the node already
+      can_recompute = can_recompute && bytes >= 0 && graph_outputs.count(output) == 0 &&
+                      graph.GetNodeArg(graph_utils::RecomputeName(output->Name())) == nullptr;
+    }
+
+    const int64_t flops = can_recompute ? GetRecomputeFlops(node) : -1;
+    if (flops >= 0 && node_bytes > 0) {
+      // the mask of Dropout is kept to recompute its output
+      const int64_t bytes = node.OpType() == "Dropout" ? GetTensorSizeInBytes(*node.OutputDefs()[0]) : node_bytes;
+      candidates.push_back({&node, position, bytes, flops});
+    }
+  }
+
+  const int64_t bytes_to_free = activation_bytes - memory_budget_bytes_;
+  if (bytes_to_free <= 0) {
+    LOGS(logger, INFO) << "The estimated activations of " << activation_bytes << " bytes fit in the budget of "
+                       << memory_budget_bytes_ << " bytes, nothing is recomputed.";
+    return Status::OK();
+  }
+
+  // greedily recompute the activations costing the least FLOPs per byte freed
+  std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+    return static_cast<double>(a.flops) * b.bytes < static_cast<double>(b.flops) * a.bytes;
+  });
+
+  int64_t freed_bytes = 0;
+  int64_t recompute_flops = 0;
+  size_t num_selected = 0;
+  while (num_selected < candidates.size() && freed_bytes < bytes_to_free) {
+    freed_bytes += candidates[num_selected].bytes;
+    recompute_flops += candidates[num_selected].flops;
+    ++num_selected;
+  }
+
+  if (freed_bytes < bytes_to_free) {
+    LOGS(logger, WARNING) << "Recomputing all the " << num_selected << " candidate nodes frees " << freed_bytes
+                          << " bytes, the estimated activations of " << activation_bytes
+                          << " bytes still exceed the budget of " << memory_budget_bytes_ << " bytes.";
+  } else {
+    LOGS(logger, INFO) << "Recomputing " << num_selected << " nodes frees " << freed_bytes
+                       << " bytes of the estimated activations of " << activation_bytes << " bytes, for "
+                       << recompute_flops << " extra FLOPs.";
+  }
+
+  // the recompute nodes of a chain read each other's outputs, so they are added in topological order
+  std::sort(candidates.begin(), candidates.begin() + num_selected,
+            [](const Candidate& a, const Candidate& b) { return a.position < b.position; });
+  std::vector<const Node*> nodes;
+  for (size_t i = 0; i < num_selected; ++i) {
+    nodes.push_back(candidates[i].node);
+  }
+
+  InsertRecomputeNodes(graph, nodes, static_cast<int>(ExecutionPriority::LOCAL_LOW));
+
+  modified = !nodes.empty();
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
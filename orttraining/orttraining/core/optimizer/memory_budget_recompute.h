@@ -0,0 +1,44 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class MemoryBudgetRecompute
+
+Recompute the activations of the forward pass that are cheapest to recompute per byte, until the activations kept
+for the backward pass fit in memory_budget_bytes.
+
+The plan is made from the shapes of the graph: every activation is assumed to be kept for the backward pass, its size
+is the product of its dimensions and the recompute cost is estimated from the op type. Symbolic dimensions are
+resolved with dim_params, activations with other unknown dimensions are ignored.
+*/
+class MemoryBudgetRecompute : public GraphTransformer {
+ public:
+  MemoryBudgetRecompute(int64_t memory_budget_bytes,
+                        const std::unordered_map<std::string, int64_t>& dim_params = {},
+                        const std::unordered_set<std::string>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("MemoryBudgetRecompute", compatible_execution_providers),
+        memory_budget_bytes_(memory_budget_bytes),
+        dim_params_(dim_params) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  bool ShouldOnlyApplyOnce() const override { return true; }
+
+ private:
+  // Returns the size of arg in bytes, or -1 if its type or shape isn't known.
+  int64_t GetTensorSizeInBytes(const NodeArg& arg) const;
+
+  // Returns the number of floating point operations to recompute the outputs of node, or -1 if it can't be recomputed.
+  int64_t GetRecomputeFlops(const Node& node) const;
+
+  int64_t memory_budget_bytes_;
+  std::unordered_map<std::string, int64_t> dim_params_;
+};
+
+}  // namespace onnxruntime
@@ -26,8 +26,6 @@ class TransformerLayerRecompute : public GraphTransformer {
 
   std::vector<const Node*> NodesBetweenEdges(const Graph& graph, const NodeArg* start, const NodeArg* end) const;
 
-  void InsertRecomputeNodes(Graph& graph, const std::vector<const Node*>& nodes, int priority) const;
-
   int number_recompute_layers_;
 };
 
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "orttraining/core/session/horizontal_parallel_inference.h"
+
+#include "core/providers/cpu/cpu_execution_provider.h"
+#include "orttraining/core/framework/distributed_run_context.h"
+#include "orttraining/core/optimizer/megatron_transformer.h"
+
+namespace onnxruntime {
+namespace training {
+
+namespace {
+// Runs the MegatronTransformer on an inference graph. It owns the weight names, partition info and optimizer state
+// the MegatronTransformer records for training, which inference doesn't use.
+class HorizontalParallelInferenceTransformer : public GraphTransformer {
+ public:
+  HorizontalParallelInferenceTransformer(int32_t horizontal_parallel_rank, int32_t horizontal_parallel_size)
+      : GraphTransformer("HorizontalParallelInferenceTransformer"),
+        cpu_execution_provider_(onnxruntime::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo())),
+        megatron_transformer_(horizontal_parallel_rank, horizontal_parallel_size, updated_weight_names_,
+                              weights_to_train_, weight_partition_info_, initial_optimizer_states_,
+                              *cpu_execution_provider_) {}
+
+  // partitioning the already partitioned weights again would be wrong
+  bool ShouldOnlyApplyOnce() const override { return true; }
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/, const logging::Logger& logger) const override {
+    return megatron_transformer_.Apply(graph, modified, logger);
+  }
+
+  std::unordered_map<std::string, std::string> updated_weight_names_;
+  std::unordered_set<std::string> weights_to_train_;
+  std::unordered_map<std::string, TrainingSession::PartitionInfo> weight_partition_info_;
+  TrainingSession::OptimizerState initial_optimizer_states_;
+  std::unique_ptr<CPUExecutionProvider> cpu_execution_provider_;
+  MegatronTransformer megatron_transformer_;
+};
+}  // namespace
+
+std::unique_ptr<GraphTransformer> CreateHorizontalParallelInferenceTransformer(int32_t horizontal_parallel_rank,
+                                                                               int32_t horizontal_parallel_size) {
+  return onnxruntime::make_unique<HorizontalParallelInferenceTransformer>(horizontal_parallel_rank,
+                                                                          horizontal_parallel_size);
+}
+
+Status ConfigureHorizontalParallelInference(InferenceSession& session, const HorizontalParallelInferenceConfig& config) {
+  ORT_RETURN_IF_NOT(config.world_size > 0 && config.world_rank >= 0 && config.world_rank < config.world_size,
+                    "Invalid world rank ", config.world_rank, " of world size ", config.world_size);
+  ORT_RETURN_IF_NOT(config.local_size > 0 && config.local_rank >= 0 && config.local_rank < config.local_size,
+                    "Invalid local rank ", config.local_rank, " of local size ", config.local_size);
+  if (config.world_size == 1) {
+    return Status::OK();
+  }
+
+  // the NCCL kernels of the MegatronG nodes get their communicators from the horizontal parallel worker group
+  DistributedRunContext::CreateInstance({config.world_rank, config.world_size, config.local_rank, config.local_size,
+                                         1, config.world_size, 1});
+  const auto& run_config = DistributedRunContext::RunConfig();
+  ORT_RETURN_IF_NOT(run_config.world_size == config.world_size && run_config.horizontal_parallel_size == config.world_size,
+                    "The distributed run context of the process was already created with world size ",
+                    run_config.world_size, " and horizontal parallel size ", run_config.horizontal_parallel_size);
+
+  return session.RegisterGraphTransformer(
+      CreateHorizontalParallelInferenceTransformer(
+          DistributedRunContext::RankInGroup(WorkerGroupType::HorizontalParallel), config.world_size),
+      TransformerLevel::Level1);
+}
+
+}  // namespace training
+}  // namespace onnxruntime
@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+
+#include "core/optimizer/graph_transformer.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+namespace training {
+
+struct HorizontalParallelInferenceConfig {
+  // rank and number of the processes, one per GPU, that the model is partitioned across
+  int32_t world_rank{0};
+  int32_t world_size{1};
+  // rank and number of the processes on this node, local_rank is the CUDA device id of the process
+  int32_t local_rank{0};
+  int32_t local_size{1};
+};
+
+// Creates the transformer that partitions the weights of the MLP and attention blocks the MegatronTransformer
+// recognizes for rank 'horizontal_parallel_rank' of 'horizontal_parallel_size', and inserts the MegatronF/MegatronG
+// nodes that all-reduce the partial results of the ranks with NCCL. Applied once, at the start of level 1.
+std::unique_ptr<GraphTransformer> CreateHorizontalParallelInferenceTransformer(int32_t horizontal_parallel_rank,
+                                                                               int32_t horizontal_parallel_size);
+
+// Configures an inference session for tensor-parallel inference, with the model partitioned across
+// config.world_size processes that each run a session on one GPU, usually started with mpirun. Must be called before
+// the session is initialized. Every rank feeds the same inputs and gets the full outputs.
+Status ConfigureHorizontalParallelInference(InferenceSession& session, const HorizontalParallelInferenceConfig& config);
+
+}  // namespace training
+}  // namespace onnxruntime
@@ -112,6 +112,11 @@ Status SetupOptimizerParams(
   opt_graph_config.use_mixed_precision = config.mixed_precision_config.has_value();
   if (opt_graph_config.use_mixed_precision) {
     opt_graph_config.mixed_precision_type = config.mixed_precision_config.value().mixed_precision_type;
+    const auto& dynamic_loss_scale_config = config.mixed_precision_config.value().dynamic_loss_scale_config;
+    if (dynamic_loss_scale_config.has_value()) {
+      opt_graph_config.use_dynamic_loss_scale = true;
+      opt_graph_config.dynamic_loss_scale_config = dynamic_loss_scale_config.value();
+    }
   }
 
   // TODO make OptimizerGraphConfig::loss_scale_input_name optional<string>
@@ -124,8 +129,10 @@ Status SetupOptimizerParams(
   opt_graph_config.gradient_accumulation_steps = config.gradient_accumulation_steps;
   opt_graph_config.allreduce_in_mixed_precision_type = optimizer_config.do_all_reduce_in_mixed_precision_type;
   opt_graph_config.use_nccl = optimizer_config.use_nccl;
+  opt_graph_config.allreduce_bucket_size_bytes = optimizer_config.allreduce_bucket_size_bytes;
   opt_graph_config.adasum_reduction_type = optimizer_config.adasum_reduction_type;
   opt_graph_config.enable_grad_norm_clip = optimizer_config.enable_grad_norm_clip;
+  opt_graph_config.use_multi_tensor_gradient_accumulation = optimizer_config.use_multi_tensor_gradient_accumulation;
   opt_graph_config.deepspeed_zero = optimizer_config.deepspeed_zero;
 
   // check if shared initial optimizer states have been provided
@@ -1509,6 +1516,8 @@ Status PipelineTrainingSession::SetExtraDataDependency() {
   for (auto& node : model_->MainGraph().Nodes()) {
     if (node.OpType().compare("AdamOptimizer") == 0 ||
         node.OpType().compare("LambOptimizer") == 0 ||
+        node.OpType().compare("MultiTensorAdamOptimizer") == 0 ||
+        node.OpType().compare("OffloadedMultiTensorAdamOptimizer") == 0 ||
         node.OpType().compare("SGDOptimizer") == 0) {
       SetDataDependency(graph, node, dependent_node_args);
     }
@@ -1610,6 +1619,16 @@ Status PipelineTrainingSession::SetEventSynchronization(
                                                    DistributedRunContext::GetRanks(WorkerGroupType::PipelineParallel));
   pipeline_worker_pool_ = pipeline::PipelineWorkerPool(num_pipeline_stages);
 
+  {
+    pipeline::PipelineScheduleConfig schedule_config;
+    schedule_config.num_batches = num_pipeline_micro_batches;
+    schedule_config.num_stages = num_pipeline_stages;
+    const auto simulation = pipeline::SimulatePipelineSchedule(schedule_config);
+    LOGS(*session_logger_, INFO) << "Pipeline bubble fraction of " << num_pipeline_micro_batches << " micro-batches over "
+                                 << num_pipeline_stages << " stages, assuming balanced stages: "
+                                 << simulation.bubble_fraction;
+  }
+
   // Insert PipelineOps may access "sliced_schema" from "pipeline_context_".
   pipeline_context_.sliced_schema = distributed_config.value().sliced_schema;
   // Declare a place holder for pipeline configuration.
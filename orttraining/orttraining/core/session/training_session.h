@@ -115,6 +115,11 @@ class TrainingSession : public InferenceSession {
 
       bool layernorm_stash_as_fp32{true};
 
+      // The configuration of the loss scale updated on the device.
+      // If provided, the loss scale is an initializer that the optimizer graph updates from the finite check of the
+      // gradients, and it is not fed. Otherwise the loss scale is an input fed each step.
+      optional<DynamicLossScaleConfig> dynamic_loss_scale_config{};
+
       ONNX_NAMESPACE::TensorProto_DataType TensorProtoDataType() const {
         switch (mixed_precision_type) {
           case MixedPrecisionDataType::FP16:
@@ -179,12 +184,18 @@ class TrainingSession : public InferenceSession {
       bool do_all_reduce_in_mixed_precision_type{};
       // Whether to use NCCL.
       bool use_nccl{};
+      // The maximum size in bytes of a bucket of gradients all-reduced together with NCCL.
+      // Buckets are all-reduced as soon as their gradients are produced, overlapping the rest of the backward pass.
+      // 0 all-reduces all the gradients at once.
+      int64_t allreduce_bucket_size_bytes{};
       // Whether to partition the optimizer state.
       ZeROConfig deepspeed_zero{};
       // Selects the reduction algorithm for Adasum.
       AdasumReductionType adasum_reduction_type{AdasumReductionType::None};
       // Whether to enable gradient clipping.
       bool enable_grad_norm_clip{true};
+      // Whether a single node per gradient type accumulates the gradients, instead of one node per gradient.
+      bool use_multi_tensor_gradient_accumulation{};
     };
     // The optimizer configuration.
     // If not provided, no optimizer is added.
@@ -252,6 +263,11 @@ class TrainingSession : public InferenceSession {
       bool transformer_layer_recompute{false};
       // Number of layers to apply recompute
       int number_recompute_layers{0};
+      // If positive, recompute the activations cheapest to recompute until the estimated activation memory fits
+      // in this budget
+      int64_t recompute_memory_budget_bytes{0};
+      // The values of the symbolic dimensions used to estimate the activation memory, e.g. the batch size
+      std::unordered_map<std::string, int64_t> recompute_dim_params{};
     };
 
     GraphTransformerConfiguration graph_transformer_config{};
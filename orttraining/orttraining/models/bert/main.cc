@@ -104,6 +104,11 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
       ("checkpoint_period", "How many weight-update steps to run before saving a model checkpoint.", cxxopts::value<size_t>()->default_value("1000"))
       ("max_num_checkpoints", "Maximum number of checkpoint files to maintain.",
         cxxopts::value<size_t>()->default_value("10"))
+      ("async_checkpointing", "Whether to save the checkpoints in the background. "
+        "Every rank saves its own shard of the checkpoints when the training state is partitioned.",
+        cxxopts::value<bool>()->default_value("false"))
+      ("checkpoint_io_threads", "The number of threads writing the data of a checkpoint in the background.",
+        cxxopts::value<int>()->default_value("4"))
       ("gradient_accumulation_steps_phase2", "The number of gradient accumulation steps before performing a backward/update pass in phase 2.",
         cxxopts::value<int>()->default_value("1"))
       ("iterations_per_loop", "How many steps to make in each estimator call.", cxxopts::value<int>()->default_value("1000"))
@@ -116,10 +121,20 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
       ("loss_scale", "Loss scaling, positive power of 2 values can improve fp16 convergence. "
         "Set it 0 to uses dynamic scaling; Other none-zero value will used as static scale",
         cxxopts::value<float>()->default_value("0.0"))
+      ("use_device_loss_scale", "Whether the dynamic loss scale is updated on the device instead of on the host each step.",
+        cxxopts::value<bool>()->default_value("false"))
       ("use_fp16_moments", "Whether to use fp16 version of moments.", cxxopts::value<bool>()->default_value("false"))
       ("use_fp16_initializer", "FP16 weights will be created. Otherwise, cast nodes will be inserted for converting weights from FP32 to FP16",
         cxxopts::value<bool>()->default_value("true"))
       ("use_nccl", "Whether to use NCCL for distributed training.", cxxopts::value<bool>()->default_value("false"))
+      ("num_prefetched_batches", "The number of training batches assembled in the background ahead of the step. "
+        "0 assembles the batches in the step.", cxxopts::value<size_t>()->default_value("2"))
+      ("sequence_length_bucketing", "Whether to batch the training samples of similar sequence lengths together and "
+        "trim the padding of each batch to its longest sequence.", cxxopts::value<bool>()->default_value("false"))
+      ("sequence_length_alignment", "The sequence length of a batch trimmed by sequence_length_bucketing is rounded up "
+        "to a multiple of it.", cxxopts::value<size_t>()->default_value("8"))
+      ("allreduce_bucket_size_mb", "The size of the buckets of gradients all-reduced while the backward pass runs. "
+        "0 all-reduces all the gradients after the backward pass.", cxxopts::value<int64_t>()->default_value("0"))
       ("use_profiler", "Collect runtime profile data during this training run.", cxxopts::value<bool>()->default_value("false"))
       ("max_profile_records", "Maximum number of runtime profile data records to collect. 0 means use the default value.",
         cxxopts::value<size_t>()->default_value("0"))
@@ -137,7 +152,9 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
       ("max_predictions_per_seq",
         "Maximum number of masked LM predictions per sequence. "
         "Must match data generation.", cxxopts::value<int>()->default_value("80"))
-      ("optimizer", "Adam or Lamb", cxxopts::value<std::string>()->default_value("Adam"))
+      ("optimizer", "Adam, Lamb, MultiTensorAdam, which updates all the weights with the Adam rule in a single node, "
+        "or OffloadedMultiTensorAdam, which also keeps the fp32 weights and the moments in pinned host memory "
+        "and requires use_mixed_precision with use_fp16_initializer", cxxopts::value<std::string>()->default_value("Adam"))
       ("deepspeed_zero_stage", "Controls whether to partition state using the DeepSpeed ZeRO technique. "
        "Stages 0 (disabled) and 1 (optimizer state partitioning) are supported.",
        cxxopts::value<int>()->default_value("0"))
@@ -169,6 +186,9 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
       "separate each consumer node with a '/'. ", cxxopts::value<std::vector<std::string>>()->default_value(""))
       ("enable_grad_norm_clip", "Specify whether to enable gradient clipping for optimizers.",
         cxxopts::value<bool>()->default_value("true"))
+      ("use_multi_tensor_gradient_accumulation", "Whether to accumulate all the gradients of a type in a single node. "
+        "It saves a launch per gradient, but keeps all the gradients alive until the end of the backward pass.",
+        cxxopts::value<bool>()->default_value("false"))
       ("enable_gelu_approximation", "Specify whether to enable GELU approximation.",
         cxxopts::value<bool>()->default_value("true"))
       ("attn_dropout_recompute", "Enable checkpointing of attention dropout to save memory.",
@@ -179,6 +199,9 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
         cxxopts::value<bool>()->default_value("false"))
       ("number_recompute_layers", "Number of layers to apply recompute.",
         cxxopts::value<int>()->default_value("0"))
+      ("recompute_memory_budget_mb", "Recompute the activations cheapest to recompute until the estimated activation "
+        "memory fits in this budget. 0 disables it.",
+        cxxopts::value<int64_t>()->default_value("0"))
       ("use_invertible_layernorm_grad", "Specify whether to use invertible laynorm(dropping the input activation)",
         cxxopts::value<bool>()->default_value("false"))
       ("debug_break", "Specify whether to break at app start, useful for multi-gpu debugging.",
@@ -252,8 +275,19 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
     params.display_loss_steps = flags["display_loss_steps"].as<size_t>();
     params.checkpoint_period = flags["checkpoint_period"].as<size_t>();
     params.max_num_checkpoints = flags["max_num_checkpoints"].as<size_t>();
+    params.use_async_checkpointing = flags["async_checkpointing"].as<bool>();
+    params.checkpoint_io_threads = flags["checkpoint_io_threads"].as<int>();
+    if (params.checkpoint_io_threads <= 0) {
+      return Status(ONNXRUNTIME, INVALID_ARGUMENT, "checkpoint_io_threads must be positive.");
+    }
 
     params.use_nccl = flags["use_nccl"].as<bool>();
+    params.num_prefetched_batches = flags["num_prefetched_batches"].as<size_t>();
+    params.sequence_length_bucketing = flags["sequence_length_bucketing"].as<bool>();
+    params.sequence_length_alignment = flags["sequence_length_alignment"].as<size_t>();
+    if (params.sequence_length_alignment == 0) {
+      return Status(ONNXRUNTIME, INVALID_ARGUMENT, "sequence_length_alignment must be positive.");
+    }
     params.enable_adasum = flags["enable_adasum"].as<bool>();
     params.use_profiler = flags.count("use_profiler") > 0;
     ort_params.max_num_profiling_events = flags["max_profile_records"].as<size_t>();
@@ -300,15 +334,17 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
     } else {
       printf("Performing AllReduce in fp32 \n");
     }
+    params.allreduce_bucket_size_bytes = flags["allreduce_bucket_size_mb"].as<int64_t>() * 1024 * 1024;
     {
       const float loss_scale = flags["loss_scale"].as<float>();
       if (loss_scale < 0.0f) {
         return Status(ONNXRUNTIME, INVALID_ARGUMENT, "Loss scale should be >= 0.");
       }
       params.loss_scale = loss_scale;
+      params.use_device_loss_scale = flags["use_device_loss_scale"].as<bool>();
       if (params.use_mixed_precision) {
         if (params.loss_scale == 0.0) {
-          printf("Using Dynamic loss scale.\n");
+          printf("Using Dynamic loss scale%s.\n", params.use_device_loss_scale ? " on the device" : "");
         } else {
           printf("Mixed precision loss scale is: %f\n", params.loss_scale);
         }
@@ -342,12 +378,18 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
       params.training_optimizer_name = "AdamOptimizer";
     } else if (optimizer_name == "lamb" || optimizer_name == "Lamb") {
       params.training_optimizer_name = "LambOptimizer";
+    } else if (optimizer_name == "multi_tensor_adam" || optimizer_name == "MultiTensorAdam") {
+      params.training_optimizer_name = "MultiTensorAdamOptimizer";
+    } else if (optimizer_name == "offloaded_multi_tensor_adam" || optimizer_name == "OffloadedMultiTensorAdam") {
+      params.training_optimizer_name = "OffloadedMultiTensorAdamOptimizer";
     } else {
-      return Status(ONNXRUNTIME, INVALID_ARGUMENT, "Incorrect optimizer type: it must be one of [Adam|Lamb]");
+      return Status(ONNXRUNTIME, INVALID_ARGUMENT,
+                    "Incorrect optimizer type: it must be one of [Adam|Lamb|MultiTensorAdam|OffloadedMultiTensorAdam]");
     }
 
     params.deepspeed_zero = ZeROConfig(flags["deepspeed_zero_stage"].as<int>());
     params.enable_grad_norm_clip = flags["enable_grad_norm_clip"].as<bool>();
+    params.use_multi_tensor_gradient_accumulation = flags["use_multi_tensor_gradient_accumulation"].as<bool>();
 
     float alpha = flags["alpha"].as<float>();
     float beta = flags["beta"].as<float>();
@@ -474,6 +516,7 @@ Status ParseArguments(int argc, char* argv[], BertParameters& params, OrtParamet
     params.gelu_recompute = flags["gelu_recompute"].as<bool>();
     params.transformer_layer_recompute = flags["transformer_layer_recompute"].as<bool>();
     params.number_recompute_layers = flags["number_recompute_layers"].as<int>();
+    params.recompute_memory_budget_bytes = flags["recompute_memory_budget_mb"].as<int64_t>() * 1024 * 1024;
 
     ort_params.log_severity = static_cast<logging::Severity>(flags["ort_log_severity"].as<int>());
     ORT_RETURN_IF_NOT(
@@ -629,6 +672,10 @@ void setup_training_params(BertParameters& params) {
       {"masked_lm_ids", "masked_lm_ids"},
       {"next_sentence_label", "next_sentence_labels"}};
 
+  // the padding of input_ids, segment_ids and input_mask is trimmed by sequence length bucketing
+  params.sequence_mask_name = "input3";
+  params.sequence_tensor_names = {"input1", "input2", "input3"};
+
   params.model_type = "bert";
 
   params.skip_evaluation = params.is_perf_test;
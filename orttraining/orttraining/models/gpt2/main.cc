@@ -54,6 +54,8 @@ Status ParseArguments(int argc, char* argv[], GPT2Parameters& params, OrtParamet
         cxxopts::value<std::string>()->default_value(""))
       ("train_batch_size", "Total batch size for training.", cxxopts::value<int>())
       ("eval_batch_size", "Total batch size for eval.", cxxopts::value<int>())
+      ("num_prefetched_batches", "The number of training batches assembled in the background ahead of the step. "
+        "0 assembles the batches in the step.", cxxopts::value<size_t>()->default_value("2"))
       ("learning_rate", "The initial learning rate for the optimizer.", cxxopts::value<float>()->default_value("5e-5"))
       ("num_train_steps", "Total number of training steps to perform.", cxxopts::value<int>()->default_value("100"))
       ("warmup_ratio", "Fraction of training steps for learning rate warmup.", cxxopts::value<float>()->default_value("0"))
@@ -77,7 +79,7 @@ Status ParseArguments(int argc, char* argv[], GPT2Parameters& params, OrtParamet
         "The maximum total input sequence length after WordPiece tokenization. "
         "Sequences longer than this will be truncated, and sequences shorter "
         "than this will be padded. Must match data generation.", cxxopts::value<int>()->default_value("1024"))
-      ("optimizer", "Adam or Lamb", cxxopts::value<std::string>()->default_value("Adam"))
+      ("optimizer", "Adam, Lamb or MultiTensorAdam, which updates all the weights with the Adam rule in a single node", cxxopts::value<std::string>()->default_value("Adam"))
       ("deepspeed_zero_stage", "Controls whether to partition state using the DeepSpeed ZeRO technique. "
        "Stages 0 (disabled) and 1 (optimizer state partitioning) are supported.",
        cxxopts::value<int>()->default_value("0"))
@@ -124,6 +126,7 @@ Status ParseArguments(int argc, char* argv[], GPT2Parameters& params, OrtParamet
 
     params.num_train_steps = flags["num_train_steps"].as<int>();
     params.batch_size = flags["train_batch_size"].as<int>();
+    params.num_prefetched_batches = flags["num_prefetched_batches"].as<size_t>();
     if (flags.count("eval_batch_size")) {
       params.eval_batch_size = flags["eval_batch_size"].as<int>();
     } else {
@@ -202,8 +205,11 @@ Status ParseArguments(int argc, char* argv[], GPT2Parameters& params, OrtParamet
       params.training_optimizer_name = "AdamOptimizer";
     } else if (optimizer_name == "lamb" || optimizer_name == "Lamb") {
       params.training_optimizer_name = "LambOptimizer";
+    } else if (optimizer_name == "multi_tensor_adam" || optimizer_name == "MultiTensorAdam") {
+      params.training_optimizer_name = "MultiTensorAdamOptimizer";
     } else {
-      return Status(ONNXRUNTIME, INVALID_ARGUMENT, "Incorrect optimizer type: it must be one of [Adam|Lamb]");
+      return Status(ONNXRUNTIME, INVALID_ARGUMENT,
+                    "Incorrect optimizer type: it must be one of [Adam|Lamb|MultiTensorAdam]");
     }
 
     params.deepspeed_zero = ZeROConfig(flags["deepspeed_zero_stage"].as<int>());
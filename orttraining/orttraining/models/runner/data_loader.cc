@@ -6,6 +6,7 @@
 #include "core/util/protobuf_parsing_utils.h"
 #include "orttraining/models/runner/data_loader.h"
 #include <fstream>
+#include "core/common/make_unique.h"
 
 namespace onnxruntime {
 namespace training {
@@ -191,5 +192,184 @@ Status DataLoader::LoadOneSample(CodedInputStream& coded_in,
   return Status::OK();
 }
 
+// A tensor of a prefetched batch. It keeps the buffers of the batch until the batch is released.
+class BatchPrefetcher::BatchTensor : public Tensor {
+ public:
+  BatchTensor(Tensor& buffer, const TensorShape& shape, std::shared_ptr<BatchBuffers> batch_buffers)
+      : Tensor(buffer.DataType(), shape, buffer.MutableDataRaw(), buffer.Location()),
+        batch_buffers_(std::move(batch_buffers)) {}
+
+  static void Delete(void* p) {
+    delete static_cast<BatchTensor*>(static_cast<Tensor*>(p));
+  }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BatchTensor);
+
+  const std::shared_ptr<BatchBuffers> batch_buffers_;
+};
+
+BatchPrefetcher::BatchPrefetcher(AllocatorPtr allocator, size_t num_prefetched_batches)
+    : allocator_(allocator ? allocator : TrainingUtil::GetCpuAllocator()),
+      num_prefetched_batches_(num_prefetched_batches),
+      state_(std::make_shared<State>()) {
+  ORT_ENFORCE(num_prefetched_batches_ > 0);
+  thread_ = std::thread(&BatchPrefetcher::AssembleBatches, this);
+}
+
+BatchPrefetcher::~BatchPrefetcher() {
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    stop_ = true;
+  }
+  state_->cv.notify_all();
+  thread_.join();
+}
+
+void BatchPrefetcher::Start(std::shared_ptr<DataSet> data_set, size_t batch_size, size_t first_batch) {
+  std::unique_lock<std::mutex> lock(state_->mutex);
+  // the batch being assembled may use the previous data set
+  state_->cv.wait(lock, [this] { return num_batches_assembling_ == 0; });
+
+  auto types_and_shapes = data_set->GetBatchTypesAndShapes(batch_size);
+  if (types_and_shapes != types_and_shapes_) {
+    types_and_shapes_ = std::move(types_and_shapes);
+    state_->free_buffers.clear();
+    ++state_->generation;
+  }
+
+  for (auto& ready_batch : ready_batches_) {
+    state_->free_buffers.push_back(std::move(ready_batch.buffers));
+  }
+  ready_batches_.clear();
+
+  data_set_ = std::move(data_set);
+  batch_size_ = batch_size;
+  next_batch_to_assemble_ = first_batch;
+  num_batches_ = data_set_->TotalBatch(batch_size);
+
+  AllocateBuffers(lock);
+  lock.unlock();
+  state_->cv.notify_all();
+}
+
+void BatchPrefetcher::Stop() {
+  std::unique_lock<std::mutex> lock(state_->mutex);
+  num_batches_ = 0;
+  state_->cv.wait(lock, [this] { return num_batches_assembling_ == 0; });
+  data_set_.reset();
+  for (auto& ready_batch : ready_batches_) {
+    state_->free_buffers.push_back(std::move(ready_batch.buffers));
+  }
+  ready_batches_.clear();
+}
+
+void BatchPrefetcher::AllocateBuffers(std::unique_lock<std::mutex>& lock) {
+  // the batches in use hold their buffers, so this allocates more buffers while training uses more batches at once
+  while (state_->free_buffers.size() + ready_batches_.size() + num_batches_assembling_ < num_prefetched_batches_) {
+    const auto types_and_shapes = types_and_shapes_;
+    lock.unlock();
+    auto buffers = onnxruntime::make_unique<BatchBuffers>();
+    for (const auto& type_and_shape : types_and_shapes) {
+      buffers->push_back(onnxruntime::make_unique<Tensor>(type_and_shape.first, type_and_shape.second, allocator_));
+    }
+    lock.lock();
+    if (types_and_shapes != types_and_shapes_) {
+      return;
+    }
+    state_->free_buffers.push_back(std::move(buffers));
+  }
+}
+
+Status BatchPrefetcher::GetBatch(size_t batch_index, std::vector<OrtValue>& batch) {
+  std::unique_lock<std::mutex> lock(state_->mutex);
+  ORT_RETURN_IF_NOT(data_set_ != nullptr, "No data set to get batch ", batch_index, " from.");
+  ORT_RETURN_IF_NOT(
+      ready_batches_.empty() ? batch_index == next_batch_to_assemble_ - num_batches_assembling_
+                             : batch_index == ready_batches_.front().index,
+      "Batch ", batch_index, " is taken out of order.");
+  ORT_RETURN_IF_NOT(batch_index < num_batches_, "Batch ", batch_index, " is out of range.");
+
+  AllocateBuffers(lock);
+  state_->cv.notify_all();
+  state_->cv.wait(lock, [this] { return !ready_batches_.empty(); });
+
+  std::unique_ptr<BatchBuffers> buffers = std::move(ready_batches_.front().buffers);
+  const std::vector<TensorShape> shapes = std::move(ready_batches_.front().shapes);
+  ready_batches_.pop_front();
+  const size_t generation = state_->generation;
+  lock.unlock();
+  state_->cv.notify_all();
+
+  // the buffers return to the free buffers when every tensor of the batch is released
+  std::weak_ptr<State> weak_state = state_;
+  BatchBuffers* raw_buffers = buffers.release();
+  std::shared_ptr<BatchBuffers> batch_buffers(
+      raw_buffers,
+      [weak_state, generation](BatchBuffers* released_buffers) {
+        std::unique_ptr<BatchBuffers> owned_buffers(released_buffers);
+        auto state = weak_state.lock();
+        if (state) {
+          {
+            std::lock_guard<std::mutex> state_lock(state->mutex);
+            if (state->generation == generation) {
+              state->free_buffers.push_back(std::move(owned_buffers));
+            }
+          }
+          state->cv.notify_all();
+        }
+      });
+
+  batch.clear();
+  for (size_t i = 0; i < raw_buffers->size(); ++i) {
+    auto tensor = onnxruntime::make_unique<BatchTensor>(*(*raw_buffers)[i], shapes[i], batch_buffers);
+    batch.emplace_back(static_cast<Tensor*>(tensor.release()), DataTypeImpl::GetType<Tensor>(), BatchTensor::Delete);
+  }
+
+  return Status::OK();
+}
+
+void BatchPrefetcher::AssembleBatches() {
+  std::unique_lock<std::mutex> lock(state_->mutex);
+  while (true) {
+    state_->cv.wait(lock, [this] {
+      return stop_ ||
+             (next_batch_to_assemble_ < num_batches_ && ready_batches_.size() < num_prefetched_batches_ &&
+              !state_->free_buffers.empty());
+    });
+    if (stop_) {
+      return;
+    }
+
+    std::unique_ptr<BatchBuffers> buffers = std::move(state_->free_buffers.back());
+    state_->free_buffers.pop_back();
+    const size_t batch_index = next_batch_to_assemble_++;
+    ++num_batches_assembling_;
+    std::shared_ptr<DataSet> data_set = data_set_;
+    const size_t batch_size = batch_size_;
+    lock.unlock();
+
+    // the batch may be smaller than the buffers if its sequences are trimmed
+    const auto types_and_shapes = data_set->GetKthBatchTypesAndShapes(batch_size, batch_index);
+    std::vector<TensorShape> shapes;
+    std::vector<std::unique_ptr<Tensor>> batch_tensors;
+    std::vector<Tensor*> batch;
+    for (size_t i = 0; i < buffers->size(); ++i) {
+      Tensor& buffer = *(*buffers)[i];
+      shapes.push_back(types_and_shapes[i].second);
+      batch_tensors.push_back(onnxruntime::make_unique<Tensor>(
+          buffer.DataType(), shapes.back(), buffer.MutableDataRaw(), buffer.Location()));
+      batch.push_back(batch_tensors.back().get());
+    }
+    data_set->CopyKthBatchTo(batch_size, batch_index, batch);
+
+    // Start() and Stop() wait for the batch being assembled, so it's still of the current data set
+    lock.lock();
+    --num_batches_assembling_;
+    ready_batches_.push_back(ReadyBatch{batch_index, std::move(buffers), std::move(shapes)});
+    state_->cv.notify_all();
+  }
+}
+
 }  // namespace training
 }  // namespace onnxruntime
@@ -7,6 +7,8 @@
 #include <string>
 #include <mutex>
 #include <condition_variable>
+#include <deque>
+#include <thread>
 #include "core/common/common.h"
 #include "core/common/path_string.h"
 #include "core/framework/framework_common.h"
@@ -155,6 +157,78 @@ class DataLoader : public IDataLoader {
   bool is_preloaded_ = false;
 };
 
+/*
+Assembles the batches of a data set on a background thread ahead of the training step, so that the step
+doesn't wait for the samples to be copied into its feeds.
+
+The batches are assembled into buffers allocated once from the given allocator and reused, giving
+double buffering with the default of 2 prefetched batches. With a pinned memory allocator, the feeds are
+copied to the device directly from the buffers. The buffers are only allocated on the thread calling
+Start() and GetBatch(), the background thread only copies. The buffers have the shapes of the full batches,
+a batch trimmed by DataSet::BucketBySequenceLength() uses the beginning of them.
+*/
+class BatchPrefetcher {
+ public:
+  BatchPrefetcher(AllocatorPtr allocator, size_t num_prefetched_batches = 2);
+
+  ~BatchPrefetcher();
+
+  // Starts assembling the batches of data_set, from first_batch to the last batch of the data set.
+  void Start(std::shared_ptr<DataSet> data_set, size_t batch_size, size_t first_batch = 0);
+
+  // Gets the batch_index-th batch of the data set, waiting until it's ready. The batches are taken in order.
+  // The buffers of the batch are reused once the returned values are released.
+  common::Status GetBatch(size_t batch_index, std::vector<OrtValue>& batch);
+
+  // Stops assembling batches. The batches already taken remain valid.
+  void Stop();
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BatchPrefetcher);
+
+  using BatchBuffers = std::vector<std::unique_ptr<Tensor>>;
+
+  // The state shared with the batches, which return their buffers when they are released.
+  struct State {
+    std::mutex mutex;
+    std::condition_variable cv;
+    // the buffers of batches of the current shapes that nothing uses
+    std::vector<std::unique_ptr<BatchBuffers>> free_buffers;
+    // incremented when the shapes change, the buffers of older batches are then freed instead of reused
+    size_t generation = 0;
+  };
+
+  // A batch assembled into buffers, with the shapes of its tensors.
+  struct ReadyBatch {
+    size_t index;
+    std::unique_ptr<BatchBuffers> buffers;
+    std::vector<TensorShape> shapes;
+  };
+
+  class BatchTensor;
+
+  // Allocates buffers until enough are free to assemble the prefetched batches.
+  void AllocateBuffers(std::unique_lock<std::mutex>& lock);
+
+  void AssembleBatches();
+
+  const AllocatorPtr allocator_;
+  const size_t num_prefetched_batches_;
+  const std::shared_ptr<State> state_;
+
+  // protected by state_->mutex
+  std::shared_ptr<DataSet> data_set_;
+  std::vector<std::pair<MLDataType, TensorShape>> types_and_shapes_;
+  size_t batch_size_ = 0;
+  size_t next_batch_to_assemble_ = 0;
+  size_t num_batches_ = 0;
+  size_t num_batches_assembling_ = 0;
+  std::deque<ReadyBatch> ready_batches_;
+  bool stop_ = false;
+
+  std::thread thread_;
+};
+
 // Loader that only load one single DataSet.
 class SingleDataLoader : public IDataLoader {
  public:
@@ -118,6 +118,9 @@ Status TrainingRunner::Initialize() {
       mp.mixed_precision_type = MixedPrecisionDataType::BF16;
     }
     mp.layernorm_stash_as_fp32 = params_.layernorm_stash_as_fp32;
+    if (UseDeviceLossScale()) {
+      mp.dynamic_loss_scale_config = DynamicLossScaleConfig{};
+    }
     config.mixed_precision_config = mp;
   }
 
@@ -143,9 +146,11 @@ Status TrainingRunner::Initialize() {
     opt.use_mixed_precision_moments = params_.use_mixed_precision_moments;
     opt.do_all_reduce_in_mixed_precision_type = params_.allreduce_in_mixed_precision_type;
     opt.use_nccl = params_.use_nccl;
+    opt.allreduce_bucket_size_bytes = params_.allreduce_bucket_size_bytes;
     opt.deepspeed_zero = params_.deepspeed_zero;
     opt.adasum_reduction_type = params_.GetAdasumReductionType();
     opt.enable_grad_norm_clip = params_.enable_grad_norm_clip;
+    opt.use_multi_tensor_gradient_accumulation = params_.use_multi_tensor_gradient_accumulation;
     config.optimizer_config = opt;
   }
 
@@ -188,6 +193,7 @@ Status TrainingRunner::Initialize() {
     gt_config.gelu_recompute = params_.gelu_recompute;
     gt_config.transformer_layer_recompute = params_.transformer_layer_recompute;
     gt_config.number_recompute_layers = params_.number_recompute_layers;
+    gt_config.recompute_memory_budget_bytes = params_.recompute_memory_budget_bytes;
 
     config.graph_transformer_config = gt_config;
   }
@@ -196,7 +202,8 @@ Status TrainingRunner::Initialize() {
 
   ORT_RETURN_IF_ERROR(session_.ConfigureForTraining(config, config_result));
 
-  if (config_result.mixed_precision_config_result.has_value()) {
+  // the loss scale on the device is neither fed nor updated by the runner
+  if (config_result.mixed_precision_config_result.has_value() && !UseDeviceLossScale()) {
     const std::string& loss_scale_input_name =
         config_result.mixed_precision_config_result.value().loss_scale_input_name;
     if (params_.loss_scale == 0.0f) {
@@ -273,8 +280,16 @@ Status TrainingRunner::Initialize() {
   // Checkpointing initialization
   // session_.Initialize() must be called prior to LoadCheckpoint()
   if (!params_.checkpoints_dir.empty()) {
+    // rank 0 deletes the old checkpoints, the other ranks may still write the shards of the previous one
+    const size_t max_num_checkpoints =
+        ShouldSaveCheckpointShards() ? std::max<size_t>(params_.max_num_checkpoints, 2) : params_.max_num_checkpoints;
     checkpoint_registry_ = onnxruntime::make_unique<CheckpointRegistry>(
-        params_.checkpoints_dir, params_.max_num_checkpoints);
+        params_.checkpoints_dir, max_num_checkpoints);
+
+    if (params_.use_async_checkpointing) {
+      checkpoint_writer_ = onnxruntime::make_unique<AsyncCheckpointWriter>(
+          params_.input_allocator, params_.checkpoint_io_threads);
+    }
 
     // Load checkpoint, if any
     PathString checkpoint_to_load_path = params_.checkpoint_to_load_path;
@@ -326,7 +341,12 @@ Status TrainingRunner::PrepareFeedNamesAndFeeds(const SessionMode mode,
   // Pick up feeds from data loader
   {
     std::vector<std::string> data_feed_names = training_data_loader.DataSetTensorNames();
-    std::vector<MLValue> data_feeds = training_data.GetKthBatch(params_.batch_size, batch_index, input_allocator_);
+    std::vector<MLValue> data_feeds;
+    if (mode != EvaluateStep && batch_prefetcher_) {
+      ORT_RETURN_IF_ERROR(batch_prefetcher_->GetBatch(batch_index, data_feeds));
+    } else {
+      data_feeds = training_data.GetKthBatch(params_.batch_size, batch_index, input_allocator_);
+    }
     for (size_t i = 0; i < data_feed_names.size(); ++i) {
       const auto name = data_feed_names[i];
       if (params_.pipeline_parallel_size == 1 || std::find(allowed_feed_begin, allowed_feed_end, name) != allowed_feed_end) {
@@ -453,7 +473,7 @@ Status TrainingRunner::PrepareFetchNamesAndFetches(const SessionMode mode,
       fetch_names = params_.fetch_names;
 
       if (params_.use_mixed_precision) {
-        if (!params_.use_bfloat16) {
+        if (!params_.use_bfloat16 && !UseDeviceLossScale()) {
           auto it = opt_graph_outputs_.find(OptimizerOutputKey::GradientAllIsFinite);
           ORT_RETURN_IF(it == opt_graph_outputs_.end(), "Gradient norm's IsFinite output is missing in the optimizer output");
           fetch_names.push_back(it->second);
@@ -728,9 +748,10 @@ void TrainingRunner::RunWithoutUpdate(VectorString& feed_names,
 
 Status TrainingRunner::TrainingLoop(IDataLoader& training_data_loader, IDataLoader* test_data_loader,
                                     const MapStringToString& mapped_dimensions) {
+  const bool is_checkpoint_saving_rank =
+      MPIContext::GetInstance().GetWorldRank() == 0 || ShouldSaveCheckpointShards();
   const bool enable_checkpoint_saving =
-      MPIContext::GetInstance().GetWorldRank() == 0 &&
-      checkpoint_registry_ && params_.checkpoint_period > 0;
+      is_checkpoint_saving_rank && checkpoint_registry_ && params_.checkpoint_period > 0;
 
   std::unique_ptr<perftest::utils::ICPUUsage> cpu_usage_calculator;
   if (!params_.perf_output_dir.empty()) {
@@ -784,6 +805,10 @@ Status TrainingRunner::TrainingLoop(IDataLoader& training_data_loader, IDataLoad
   nccl_service.Launch();
 #endif
 
+  if (params_.num_prefetched_batches > 0) {
+    batch_prefetcher_ = onnxruntime::make_unique<BatchPrefetcher>(input_allocator_, params_.num_prefetched_batches);
+  }
+
   auto all_steps_time_start = std::chrono::high_resolution_clock::now();
   while (step_ < params_.num_train_steps) {
     for (size_t shard_it = 0; shard_it < num_shards_to_visit; ++shard_it) {
@@ -802,6 +827,17 @@ Status TrainingRunner::TrainingLoop(IDataLoader& training_data_loader, IDataLoad
         training_data->RandomShuffle();
       }
 
+      if (params_.sequence_length_bucketing) {
+        ORT_RETURN_IF_ERROR(training_data->BucketBySequenceLength(params_.batch_size,
+                                                                  params_.sequence_mask_name,
+                                                                  params_.sequence_tensor_names,
+                                                                  params_.sequence_length_alignment));
+      }
+
+      if (batch_prefetcher_) {
+        batch_prefetcher_->Start(training_data, params_.batch_size);
+      }
+
       // loop through the data
       size_t batch_num_cur_shard = training_data->TotalBatch(params_.batch_size);
       for (size_t batch = 0; batch < batch_num_cur_shard && step_ < params_.num_train_steps; ++batch) {
@@ -888,16 +924,24 @@ Status TrainingRunner::TrainingLoop(IDataLoader& training_data_loader, IDataLoad
           PathString new_checkpoint_path, old_checkpoint_path;
           bool should_remove_old_checkpoint;
 
+          // the old checkpoint may be the one still being written
+          if (checkpoint_writer_) {
+            ORT_RETURN_IF_ERROR(checkpoint_writer_->Wait());
+          }
+
           ORT_RETURN_IF_ERROR(checkpoint_registry_->AddCheckpoint(
               weight_update_step_count_, new_checkpoint_path,
               should_remove_old_checkpoint, old_checkpoint_path));
 
           // ensure checkpoint directory exists
           if (!Env::Default().FolderExists(params_.checkpoints_dir)) {
-            ORT_RETURN_IF_ERROR(Env::Default().CreateFolder(params_.checkpoints_dir));
+            const auto status = Env::Default().CreateFolder(params_.checkpoints_dir);
+            // the ranks saving shards create it concurrently
+            ORT_RETURN_IF_NOT(status.IsOK() || Env::Default().FolderExists(params_.checkpoints_dir),
+                              status.ErrorMessage());
           }
 
-          if (should_remove_old_checkpoint) {
+          if (should_remove_old_checkpoint && MPIContext::GetInstance().GetWorldRank() == 0) {
             const auto status = Env::Default().DeleteFolder(old_checkpoint_path);
             LOGS_DEFAULT_IF(!status.IsOK(), WARNING)
                 << "Failed to delete old checkpoint. "
@@ -909,6 +953,10 @@ Status TrainingRunner::TrainingLoop(IDataLoader& training_data_loader, IDataLoad
         }
       }  // end of one file/shard
 
+      if (batch_prefetcher_) {
+        batch_prefetcher_->Stop();
+      }
+
       if (params_.pipeline_parallel_size > 1) {
         pipeline_worker_pool_.JoinAll();
       }
@@ -966,6 +1014,14 @@ Status TrainingRunner::TrainingLoop(IDataLoader& training_data_loader, IDataLoad
 #if defined(USE_CUDA) && defined(ORT_USE_NCCL) && defined(USE_NCCL_P2P)
   nccl_service.Terminate();
 #endif
+
+  batch_prefetcher_.reset();
+
+  // the last checkpoint must be complete when training ends
+  if (checkpoint_writer_) {
+    ORT_RETURN_IF_ERROR(checkpoint_writer_->Wait());
+  }
+
   return Status::OK();
 }
 
@@ -1202,6 +1258,17 @@ Status TrainingRunner::Evaluate(TrainingSession& session, IDataLoader& data_load
   return Status::OK();
 }
 
+bool TrainingRunner::ShouldSaveCheckpointShards() const {
+  return params_.use_async_checkpointing &&
+         (params_.deepspeed_zero.stage > 0 || params_.pipeline_parallel_size > 1 ||
+          params_.horizontal_parallel_size > 1);
+}
+
+bool TrainingRunner::UseDeviceLossScale() const {
+  return params_.use_device_loss_scale && params_.use_mixed_precision && !params_.use_bfloat16 &&
+         params_.loss_scale == 0.0f && params_.pipeline_parallel_size == 1;
+}
+
 Status TrainingRunner::SaveCheckpoint(const PathString& checkpoint_path) {
   NameMLValMap checkpointed_tensors{};
   ORT_RETURN_IF_ERROR(session_.GetStateTensors(checkpointed_tensors));
@@ -1209,6 +1276,16 @@ Status TrainingRunner::SaveCheckpoint(const PathString& checkpoint_path) {
   std::unordered_map<std::string, std::string> checkpointed_properties{};
   ORT_RETURN_IF_ERROR(SaveCheckpointProperties(checkpointed_properties));
 
+  if (checkpoint_writer_) {
+    const bool save_shards = ShouldSaveCheckpointShards();
+    ORT_RETURN_IF_ERROR(checkpoint_writer_->SaveShard(
+        checkpoint_path, session_.GetDataTransferManager(),
+        checkpointed_tensors, checkpointed_properties,
+        save_shards ? MPIContext::GetInstance().GetWorldRank() : 0,
+        save_shards ? MPIContext::GetInstance().GetWorldSize() : 1));
+    return Status::OK();
+  }
+
   ORT_RETURN_IF_ERROR(SaveModelCheckpoint(
       checkpoint_path, session_.GetDataTransferManager(),
       checkpointed_tensors, checkpointed_properties));
@@ -1267,7 +1344,8 @@ Status TrainingRunner::LoadCheckpoint(const PathString& checkpoint_path) {
   ORT_RETURN_IF_ERROR(WithOrtValuesFromTensorProtos(
       session_.GetModelLocation(), checkpointed_tensors,
       [this](const NameMLValMap& name_to_ort_value) -> Status {
-        ORT_RETURN_IF_ERROR(session_.SetStateTensors(name_to_ort_value, true));
+        // the shards of every rank are loaded, each rank takes the tensors it has
+        ORT_RETURN_IF_ERROR(session_.SetStateTensors(name_to_ort_value, !ShouldSaveCheckpointShards()));
         return Status::OK();
       }));
 
@@ -10,6 +10,7 @@
 #include "core/framework/ml_value.h"
 #include "core/providers/providers.h"
 #include "orttraining/core/framework/checkpoint_registry.h"
+#include "orttraining/core/framework/checkpointing.h"
 #include "orttraining/core/framework/communication/mpi/mpi_context.h"
 #include "orttraining/core/framework/pipeline.h"
 #include "orttraining/core/graph/optimizer_config.h"
@@ -87,6 +88,16 @@ class TrainingRunner {
 
     // Allocator to use for allocating inputs from the dataset (optional).
     AllocatorPtr input_allocator;
+    // Number of training batches assembled ahead of the step on a background thread, 0 assembles them in the step.
+    size_t num_prefetched_batches = 0;
+    // Whether to bucket the training samples by sequence length, trimming the padding of each batch.
+    bool sequence_length_bucketing = false;
+    // The input whose last nonzero element of a sample is the last token of its sequence, for the bucketing.
+    std::string sequence_mask_name;
+    // The inputs trimmed to the sequence length of a batch by the bucketing, including the mask.
+    VectorString sequence_tensor_names;
+    // The sequence length of a bucketed batch is rounded up to a multiple of it.
+    size_t sequence_length_alignment = 8;
     // List of execution providers to register.
     std::unordered_map<std::string, std::shared_ptr<IExecutionProviderFactory>> providers;
     // Whether to use NCCL for distributed training.
@@ -108,9 +119,13 @@ class TrainingRunner {
     bool use_mixed_precision = false;
     bool use_bfloat16 = false;
     float loss_scale = 1.0f;
+    // Whether the dynamic loss scale (loss_scale 0) is updated on the device instead of on the host each step.
+    bool use_device_loss_scale = false;
     bool use_mixed_precision_moments = false;
     bool use_mixed_precision_initializer = true;
     bool allreduce_in_mixed_precision_type = false;
+    // 0 all-reduces all the gradients at once
+    int64_t allreduce_bucket_size_bytes = 0;
     bool layernorm_stash_as_fp32 = true;
 
     // Tensorboard configuration.
@@ -157,6 +172,10 @@ class TrainingRunner {
     size_t checkpoint_period = 0;
     // upper limit on number of checkpoint files to keep
     size_t max_num_checkpoints = 1;
+    // whether to save checkpoints in the background, every rank saving its own shard when the state is partitioned
+    bool use_async_checkpointing = false;
+    // number of threads writing the data of an asynchronous checkpoint
+    int checkpoint_io_threads = 4;
 
     int data_parallel_size = 1;
     int horizontal_parallel_size = 1;
@@ -181,6 +200,8 @@ class TrainingRunner {
     VectorString pipeline_stage_paths;
     // Enable gradient clipping.
     bool enable_grad_norm_clip = true;
+    // Accumulate the gradients with a single node per gradient type.
+    bool use_multi_tensor_gradient_accumulation = false;
 
     // Enable GELU approximation
     bool enable_gelu_approximation = false;
@@ -192,6 +213,8 @@ class TrainingRunner {
     bool transformer_layer_recompute = false;
     // Number of layers to apply recompute
     int number_recompute_layers = 0;
+    // Recompute activations until the estimated activation memory fits in this budget, 0 disables it
+    int64_t recompute_memory_budget_bytes = 0;
     // Use invertible layernorm grad
     bool use_invertible_layernorm_grad = false;
   };
@@ -240,6 +263,10 @@ class TrainingRunner {
     const MapStringToString& mapped_dimensions);
   Status Evaluate(TrainingSession& session, IDataLoader& data_loader);
 
+  // Whether every rank saves its own shard of the checkpoints, as its state differs from the other ranks.
+  bool ShouldSaveCheckpointShards() const;
+  // Whether the dynamic loss scale is an initializer updated on the device, which needs fp16 without pipelining.
+  bool UseDeviceLossScale() const;
   Status SaveCheckpoint(const PathString& checkpoint_path);
   Status LoadCheckpoint(const PathString& checkpoint_path);
   Status SaveCheckpointProperties(std::unordered_map<std::string, std::string>& properties) const;
@@ -264,7 +291,12 @@ class TrainingRunner {
   TrainingSession session_;
   AllocatorPtr input_allocator_;
 
+  // Valid only if params_.num_prefetched_batches > 0, during the training loop.
+  std::unique_ptr<BatchPrefetcher> batch_prefetcher_;
+
   std::unique_ptr<CheckpointRegistry> checkpoint_registry_;
+  // Valid only if params_.use_async_checkpointing is true.
+  std::unique_ptr<AsyncCheckpointWriter> checkpoint_writer_;
 
   // Pipeline fields are valid only if params_.pipeline_parallel_size > 1.
   // Information for running pipeline.
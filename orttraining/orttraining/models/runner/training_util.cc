@@ -3,6 +3,8 @@
 
 #include "orttraining/models/runner/training_util.h"
 
+#include <algorithm>
+#include <numeric>
 #include <sstream>
 
 #include "constant.h"
@@ -96,13 +98,29 @@ common::Status DataSet::GetTensorDimensionsFromInputs(const std::map<std::string
 }
 
 std::vector<OrtValue> DataSet::GetKthBatch(size_t batch_size, size_t k_th, AllocatorPtr allocator) const {
-  batch_size = min(batch_size, data_.size());
+  AllocatorPtr alloc = allocator ? allocator : TrainingUtil::GetCpuAllocator();
 
   std::vector<OrtValue> result;
+  std::vector<Tensor*> batch;
+  for (const auto& type_and_shape : GetKthBatchTypesAndShapes(batch_size, k_th)) {
+    auto p_tensor = onnxruntime::make_unique<Tensor>(type_and_shape.first, type_and_shape.second, alloc);
+    batch.push_back(p_tensor.get());
+    result.emplace_back(p_tensor.release(),
+                        DataTypeImpl::GetType<Tensor>(),
+                        DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+  }
+
+  CopyKthBatchTo(batch_size, k_th, batch);
+  return result;
+}
+
+std::vector<std::pair<MLDataType, TensorShape>> DataSet::GetBatchTypesAndShapes(size_t batch_size) const {
+  batch_size = min(batch_size, data_.size());
+
+  std::vector<std::pair<MLDataType, TensorShape>> result;
   for (size_t input_index = 0; input_index < NumInputs(); ++input_index) {
     const Tensor& first_tensor = data_[0]->at(input_index).Get<Tensor>();
 
-    MLDataType element_type = first_tensor.DataType();
     std::vector<int64_t> shape_vector = first_tensor.Shape().GetDims();
     if (first_tensor.Shape().Size() > 1) {
       shape_vector.insert(shape_vector.begin(), batch_size);
@@ -111,36 +129,163 @@ std::vector<OrtValue> DataSet::GetKthBatch(size_t batch_size, size_t k_th, Alloc
       shape_vector.emplace_back(batch_size);
     }
 
-    AllocatorPtr alloc = allocator ? allocator : TrainingUtil::GetCpuAllocator();
-    auto p_tensor = onnxruntime::make_unique<Tensor>(element_type, shape_vector, alloc);
-    void* buffer = p_tensor->MutableDataRaw();
-    size_t memory_size_per_sample = first_tensor.SizeInBytes();
+    result.emplace_back(first_tensor.DataType(), TensorShape(shape_vector));
+  }
+
+  return result;
+}
+
+std::vector<std::pair<MLDataType, TensorShape>> DataSet::GetKthBatchTypesAndShapes(size_t batch_size,
+                                                                                    size_t k_th) const {
+  std::vector<std::pair<MLDataType, TensorShape>> result = GetBatchTypesAndShapes(batch_size);
+
+  batch_size = min(batch_size, data_.size());
+  if (bucketed_batch_size_ == 0 || batch_size != bucketed_batch_size_ || k_th >= batch_sequence_lengths_.size()) {
+    return result;
+  }
+
+  for (size_t input_index = 0; input_index < NumInputs(); ++input_index) {
+    std::vector<int64_t> shape_vector = result[input_index].second.GetDims();
+    if (is_sequence_input_[input_index] && shape_vector.size() > 1) {
+      shape_vector[1] = batch_sequence_lengths_[k_th];
+      result[input_index].second = TensorShape(shape_vector);
+    }
+  }
+
+  return result;
+}
+
+void DataSet::CopyKthBatchTo(size_t batch_size, size_t k_th, const std::vector<Tensor*>& batch) const {
+  batch_size = min(batch_size, data_.size());
+
+  for (size_t input_index = 0; input_index < NumInputs(); ++input_index) {
+    void* buffer = batch[input_index]->MutableDataRaw();
+    // the trimmed sequence of a sample is the beginning of the sample
+    size_t memory_size_per_sample = batch[input_index]->SizeInBytes() / batch_size;
 
     size_t offset = k_th * batch_size;
     for (size_t i = offset; i < offset + batch_size; ++i) {
-      size_t index = (offset + i) % NumSamples();
+      size_t index = i % NumSamples();
       const void* raw_value = data_[index]->at(input_index).Get<Tensor>().DataRaw();
       memcpy(buffer, raw_value, memory_size_per_sample);
       buffer = static_cast<char*>(buffer) + memory_size_per_sample;
     }
-
-    result.emplace_back(p_tensor.release(),
-                        DataTypeImpl::GetType<Tensor>(),
-                        DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
   }
-
-  return result;
 }
 
 void DataSet::RandomShuffle() {
   random_shuffle(data_.begin(), data_.end());
+
+  bucketed_batch_size_ = 0;
+  batch_sequence_lengths_.clear();
 }
 
-std::vector<OrtValue> RandomDataSet::GetKthBatch(size_t /*batch_size*/, size_t /*k_th*/, AllocatorPtr allocator) const {
-  std::vector<OrtValue> result;
+namespace {
+// The length of the sequence of a sample, up to the last nonzero element of its mask.
+template <typename T>
+int64_t SequenceLengthFromMask(const Tensor& mask) {
+  const T* data = mask.Data<T>();
+  int64_t length = mask.Shape().Size();
+  while (length > 0 && data[length - 1] == T{0}) {
+    --length;
+  }
+  return length;
+}
+}  // namespace
+
+common::Status DataSet::BucketBySequenceLength(size_t batch_size,
+                                               const std::string& mask_name,
+                                               const std::vector<std::string>& sequence_tensor_names,
+                                               size_t sequence_length_alignment) {
+  ORT_RETURN_IF_NOT(batch_size > 0, "The batch size to bucket the samples into must be positive.");
+  ORT_RETURN_IF_NOT(sequence_length_alignment > 0, "The sequence length alignment must be positive.");
+  ORT_RETURN_IF_NOT(!data_.empty(), "There are no samples to bucket.");
+  batch_size = min(batch_size, data_.size());
+
+  const auto mask_it = find(tensor_names_.begin(), tensor_names_.end(), mask_name);
+  ORT_RETURN_IF_NOT(mask_it != tensor_names_.end(), "The mask ", mask_name, " isn't an input of the data set.");
+  const size_t mask_index = static_cast<size_t>(mask_it - tensor_names_.begin());
+
+  const Tensor& first_mask = data_[0]->at(mask_index).Get<Tensor>();
+  ORT_RETURN_IF_NOT(first_mask.Shape().NumDimensions() == 1, "The mask ", mask_name, " of a sample must be 1-D.");
+  const int64_t max_sequence_length = first_mask.Shape()[0];
+
+  vector<bool> is_sequence_input(NumInputs(), false);
+  for (const auto& name : sequence_tensor_names) {
+    const auto it = find(tensor_names_.begin(), tensor_names_.end(), name);
+    ORT_RETURN_IF_NOT(it != tensor_names_.end(), "The sequence tensor ", name, " isn't an input of the data set.");
+    const size_t input_index = static_cast<size_t>(it - tensor_names_.begin());
+
+    const TensorShape& shape = data_[0]->at(input_index).Get<Tensor>().Shape();
+    ORT_RETURN_IF_NOT(shape.NumDimensions() > 0 && shape[0] == max_sequence_length,
+                      "The sequence tensor ", name, " of shape ", shape, " doesn't match the mask ", mask_name,
+                      " of shape ", first_mask.Shape(), ".");
+    is_sequence_input[input_index] = true;
+  }
+  ORT_RETURN_IF_NOT(is_sequence_input[mask_index], "The mask ", mask_name, " must be a sequence tensor.");
+
+  vector<int64_t> sequence_lengths(data_.size());
+  for (size_t i = 0; i < data_.size(); ++i) {
+    const Tensor& mask = data_[i]->at(mask_index).Get<Tensor>();
+    if (mask.IsDataType<int64_t>()) {
+      sequence_lengths[i] = SequenceLengthFromMask<int64_t>(mask);
+    } else if (mask.IsDataType<int32_t>()) {
+      sequence_lengths[i] = SequenceLengthFromMask<int32_t>(mask);
+    } else if (mask.IsDataType<float>()) {
+      sequence_lengths[i] = SequenceLengthFromMask<float>(mask);
+    } else {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported type of the mask ", mask_name, ".");
+    }
+  }
+
+  // Sort the samples by sequence length, keeping the shuffled order of the samples of the same length.
+  vector<size_t> order(data_.size());
+  iota(order.begin(), order.end(), 0);
+  stable_sort(order.begin(), order.end(),
+              [&sequence_lengths](size_t a, size_t b) { return sequence_lengths[a] < sequence_lengths[b]; });
+
+  // Shuffle the full batches, so that training doesn't see the sequences from the shortest to the longest.
+  // The last partial batch stays last, since it wraps around to the first samples.
+  const size_t num_full_batches = data_.size() / batch_size;
+  vector<size_t> batch_order(num_full_batches);
+  iota(batch_order.begin(), batch_order.end(), 0);
+  random_shuffle(batch_order.begin(), batch_order.end());
+  if (data_.size() % batch_size != 0) {
+    batch_order.push_back(num_full_batches);
+  }
+
+  vector<SampleType> data;
+  vector<int64_t> bucketed_sequence_lengths;
+  data.reserve(data_.size());
+  bucketed_sequence_lengths.reserve(data_.size());
+  for (size_t batch : batch_order) {
+    for (size_t i = batch * batch_size; i < min((batch + 1) * batch_size, data_.size()); ++i) {
+      data.push_back(move(data_[order[i]]));
+      bucketed_sequence_lengths.push_back(sequence_lengths[order[i]]);
+    }
+  }
+  data_ = move(data);
+
+  const int64_t alignment = static_cast<int64_t>(sequence_length_alignment);
+  batch_sequence_lengths_.assign(TotalBatch(batch_size), 0);
+  for (size_t k = 0; k < batch_sequence_lengths_.size(); ++k) {
+    int64_t length = 1;
+    for (size_t i = k * batch_size; i < (k + 1) * batch_size; ++i) {
+      length = max(length, bucketed_sequence_lengths[i % data_.size()]);
+    }
+    batch_sequence_lengths_[k] = min(max_sequence_length, (length + alignment - 1) / alignment * alignment);
+  }
+  bucketed_batch_size_ = batch_size;
+  is_sequence_input_ = move(is_sequence_input);
+
+  return Status::OK();
+}
+
+std::vector<std::pair<MLDataType, TensorShape>> RandomDataSet::GetBatchTypesAndShapes(size_t /*batch_size*/) const {
+  std::vector<std::pair<MLDataType, TensorShape>> result;
 
   for (size_t input_index = 0; input_index < NumInputs(); ++input_index) {
-    MLDataType element_type;
+    MLDataType element_type = nullptr;
     TensorShape shape = tensor_shapes_[input_index];
 
     if (tensor_types_[input_index] == onnx::TensorProto_DataType_INT64) {
@@ -150,18 +295,19 @@ std::vector<OrtValue> RandomDataSet::GetKthBatch(size_t /*batch_size*/, size_t /
     } else if (tensor_types_[input_index] == onnx::TensorProto_DataType_FLOAT) {
       element_type = DataTypeImpl::GetType<float>();
     }
-    AllocatorPtr alloc = allocator ? allocator : TrainingUtil::GetCpuAllocator();
-    auto p_tensor = onnxruntime::make_unique<Tensor>(element_type, shape, alloc);
-    memset(p_tensor->MutableDataRaw(), 0, p_tensor->SizeInBytes());
 
-    result.emplace_back(p_tensor.release(),
-                        DataTypeImpl::GetType<Tensor>(),
-                        DataTypeImpl::GetType<Tensor>()->GetDeleteFunc());
+    result.emplace_back(element_type, shape);
   }
 
   return result;
 }
 
+void RandomDataSet::CopyKthBatchTo(size_t /*batch_size*/, size_t /*k_th*/, const std::vector<Tensor*>& batch) const {
+  for (Tensor* p_tensor : batch) {
+    memset(p_tensor->MutableDataRaw(), 0, p_tensor->SizeInBytes());
+  }
+}
+
 void TrainingUtil::PrintNameMLValMap(const NameMLValMap& mlvalue_map) {
   for (auto pair : mlvalue_map) {
     auto name = pair.first;
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <utility>
 #include <vector>
 #include <math.h>
 #include "constant.h"
@@ -52,10 +53,35 @@ class DataSet {
   // Given a batch_size, get the total num of batches.
   size_t TotalBatch(size_t batch_size) const;
 
-  virtual std::vector<OrtValue> GetKthBatch(size_t batch_size, size_t k_th, AllocatorPtr allocator = nullptr) const;
+  std::vector<OrtValue> GetKthBatch(size_t batch_size, size_t k_th, AllocatorPtr allocator = nullptr) const;
+
+  // Get the types and shapes of the tensors of a batch, in the order of the tensor names.
+  virtual std::vector<std::pair<MLDataType, TensorShape>> GetBatchTypesAndShapes(size_t batch_size) const;
+
+  // Get the types and shapes of the tensors of the k_th batch. They are those of GetBatchTypesAndShapes(), with the
+  // sequence tensors trimmed to the sequence length of the batch if the data set is bucketed by sequence length.
+  std::vector<std::pair<MLDataType, TensorShape>> GetKthBatchTypesAndShapes(size_t batch_size, size_t k_th) const;
+
+  // Copy the k_th batch into batch, which has a tensor of the type and shape from GetKthBatchTypesAndShapes() per input.
+  virtual void CopyKthBatchTo(size_t batch_size, size_t k_th, const std::vector<Tensor*>& batch) const;
 
   void RandomShuffle();
 
+  /**
+   * Groups the samples into batches of similar sequence lengths and shuffles the order of the batches, so that the
+   * padding of the sequence tensors of each batch is trimmed to the longest sequence in it. The positions of the tokens
+   * don't change, so the trimmed batches give the same results as the padded ones.
+   * The bucketing holds until the next RandomShuffle(), and only for batches of batch_size.
+   * @param batch_size the size of the batches to bucket the samples into
+   * @param mask_name the input whose last nonzero element of a sample is the last token of its sequence
+   * @param sequence_tensor_names the inputs whose first dimension of a sample is the sequence, including mask_name
+   * @param sequence_length_alignment the sequence length of a batch is rounded up to a multiple of it
+   */
+  common::Status BucketBySequenceLength(size_t batch_size,
+                                        const std::string& mask_name,
+                                        const std::vector<std::string>& sequence_tensor_names,
+                                        size_t sequence_length_alignment = 8);
+
   /**
    * The method is for getting model training params that are part of training data
    * first load .onnx model in Netron to get the mapping between input data and the graph
@@ -86,6 +112,15 @@ class DataSet {
 
   std::vector<std::unique_ptr<char[]>> ortvalue_buffers_;
 
+  // The batch size of BucketBySequenceLength(), 0 if the data set isn't bucketed.
+  size_t bucketed_batch_size_ = 0;
+
+  // The sequence length of each batch of bucketed_batch_size_.
+  std::vector<int64_t> batch_sequence_lengths_;
+
+  // Whether the input at each index is a sequence tensor trimmed to the sequence length of a batch.
+  std::vector<bool> is_sequence_input_;
+
   std::vector<OrtCallback> ortvalue_deleters_;
 };
 
@@ -104,7 +139,9 @@ class RandomDataSet : public DataSet {
 
   virtual size_t NumSamples() const override { return num_samples_; }
 
-  virtual std::vector<OrtValue> GetKthBatch(size_t batch_size, size_t k_th, AllocatorPtr allocator = nullptr) const override;
+  virtual std::vector<std::pair<MLDataType, TensorShape>> GetBatchTypesAndShapes(size_t batch_size) const override;
+
+  virtual void CopyKthBatchTo(size_t batch_size, size_t k_th, const std::vector<Tensor*>& batch) const override;
 
  private:
   size_t num_samples_;
@@ -40,6 +40,7 @@ struct TrainingParameters {
 
   bool use_mixed_precision = false;
   bool allreduce_post_accumulation = false;
+  int64_t allreduce_bucket_size_bytes = 0;
   float loss_scale = 0.0f;
   int world_rank = 0;
   int world_size = 1;
@@ -62,6 +63,8 @@ struct TrainingParameters {
   bool gelu_recompute = false;
   bool transformer_layer_recompute = false;
   int number_recompute_layers = 0;
+  int64_t recompute_memory_budget_bytes = 0;
+  std::unordered_map<std::string, int64_t> recompute_dim_params;
   bool enable_adasum = false;
 
   // graph dumping
@@ -200,6 +203,7 @@ TrainingConfigurationResult ConfigureSessionForTraining(
     // eventually we will have one all reduce kernel and let opt to have
     // an allreduce_post_accumulation option and remove the use_nccl option.
     opt.use_nccl = parameters.allreduce_post_accumulation;
+    opt.allreduce_bucket_size_bytes = parameters.allreduce_bucket_size_bytes;
     opt.deepspeed_zero = onnxruntime::training::ZeROConfig(parameters.deepspeed_zero_stage);
     opt.enable_grad_norm_clip = parameters.enable_grad_norm_clip;
 
@@ -226,6 +230,8 @@ TrainingConfigurationResult ConfigureSessionForTraining(
   config.graph_transformer_config.gelu_recompute = parameters.gelu_recompute;
   config.graph_transformer_config.transformer_layer_recompute = parameters.transformer_layer_recompute;
   config.graph_transformer_config.number_recompute_layers = parameters.number_recompute_layers;
+  config.graph_transformer_config.recompute_memory_budget_bytes = parameters.recompute_memory_budget_bytes;
+  config.graph_transformer_config.recompute_dim_params = parameters.recompute_dim_params;
 
   if (!parameters.model_after_graph_transforms_path.empty()) {
     config.model_after_graph_transforms_path = parameters.model_after_graph_transforms_path;
@@ -304,6 +310,7 @@ void addObjectMethodsForTraining(py::module& m) {
       .def_readwrite("use_fp16_moments", &TrainingParameters::use_fp16_moments)
       .def_readwrite("use_mixed_precision", &TrainingParameters::use_mixed_precision)
       .def_readwrite("allreduce_post_accumulation", &TrainingParameters::allreduce_post_accumulation)
+      .def_readwrite("allreduce_bucket_size_bytes", &TrainingParameters::allreduce_bucket_size_bytes)
       .def_readwrite("loss_scale", &TrainingParameters::loss_scale)
       .def_readwrite("world_rank", &TrainingParameters::world_rank)
       .def_readwrite("world_size", &TrainingParameters::world_size)
@@ -321,6 +328,8 @@ void addObjectMethodsForTraining(py::module& m) {
       .def_readwrite("gelu_recompute", &TrainingParameters::gelu_recompute)
       .def_readwrite("transformer_layer_recompute", &TrainingParameters::transformer_layer_recompute)
       .def_readwrite("number_recompute_layers", &TrainingParameters::number_recompute_layers)
+      .def_readwrite("recompute_memory_budget_bytes", &TrainingParameters::recompute_memory_budget_bytes)
+      .def_readwrite("recompute_dim_params", &TrainingParameters::recompute_dim_params)
       .def_readwrite("data_parallel_size", &TrainingParameters::data_parallel_size)
       .def_readwrite("horizontal_parallel_size", &TrainingParameters::horizontal_parallel_size)
       .def_readwrite("pipeline_parallel_size", &TrainingParameters::pipeline_parallel_size)
@@ -112,5 +112,75 @@ TEST(Pipeline, ScheduleB5S3) {
   TestPipelineScheduler(num_batches, num_stages, baseline_events);
 }
 
+// The bubble of the 1F1B schedule without communication latency is (num_stages - 1) / num_virtual_stages
+// micro-batches long.
+static double GetExpectedBubbleFraction(const int num_batches, const int num_stages, const int num_virtual_stages) {
+  const double bubble = (num_stages - 1.0) / num_virtual_stages;
+  return bubble / (num_batches + bubble);
+}
+
+TEST(Pipeline, SimulateSchedule) {
+  for (const int num_virtual_stages : {1, 2, 4}) {
+    for (const int num_stages : {2, 4, 8}) {
+      for (const int num_batches : {8, 16, 32}) {
+        training::pipeline::PipelineScheduleConfig config;
+        config.num_batches = num_batches;
+        config.num_stages = num_stages;
+        config.num_virtual_stages = num_virtual_stages;
+        const auto simulation = training::pipeline::SimulatePipelineSchedule(config);
+
+        EXPECT_NEAR(simulation.bubble_fraction, GetExpectedBubbleFraction(num_batches, num_stages, num_virtual_stages),
+                    1e-9)
+            << num_batches << " batches, " << num_stages << " stages, " << num_virtual_stages << " virtual stages";
+
+        // every rank runs the forward and backward of every micro-batch through each of its chunks once
+        ASSERT_EQ(simulation.timelines.size(), static_cast<size_t>(num_stages));
+        for (const auto& timeline : simulation.timelines) {
+          EXPECT_EQ(timeline.size(), static_cast<size_t>(2 * num_batches * num_virtual_stages));
+        }
+      }
+    }
+  }
+}
+
+TEST(Pipeline, SimulateInterleavedScheduleOrder) {
+  training::pipeline::PipelineScheduleConfig config;
+  config.num_batches = 4;
+  config.num_stages = 2;
+  config.num_virtual_stages = 2;
+  const auto simulation = training::pipeline::SimulatePipelineSchedule(config);
+
+  // rank 0 owns the virtual stages 0 and 2, and warms up with the forwards of 2 micro-batches through both
+  const auto& timeline = simulation.timelines.at(0);
+  const std::vector<std::pair<int, int>> expected_warmup{{0, 0}, {1, 0}, {0, 2}, {1, 2}};
+  for (size_t i = 0; i < expected_warmup.size(); ++i) {
+    EXPECT_TRUE(timeline.at(i).pass == training::pipeline::PipelineTask::Pass::Forward);
+    EXPECT_EQ(timeline.at(i).batch, expected_warmup[i].first);
+    EXPECT_EQ(timeline.at(i).virtual_stage, expected_warmup[i].second);
+  }
+
+  // a task starts after the one producing its inputs
+  for (const auto& rank_timeline : simulation.timelines) {
+    for (size_t i = 1; i < rank_timeline.size(); ++i) {
+      EXPECT_GE(rank_timeline[i].start_time, rank_timeline[i - 1].end_time);
+    }
+  }
+}
+
+TEST(Pipeline, SimulateScheduleWithSendRecvLatency) {
+  training::pipeline::PipelineScheduleConfig config;
+  config.num_batches = 16;
+  config.num_stages = 8;
+  config.num_virtual_stages = 2;
+  const double bubble_without_latency = training::pipeline::SimulatePipelineSchedule(config).bubble_fraction;
+  config.send_recv_time = 0.1;
+  const double bubble_with_latency = training::pipeline::SimulatePipelineSchedule(config).bubble_fraction;
+  EXPECT_GT(bubble_with_latency, bubble_without_latency);
+
+  // the interleaved schedule needs whole groups of num_stages micro-batches
+  config.num_batches = 12;
+  EXPECT_THROW(training::pipeline::SimulatePipelineSchedule(config), std::invalid_argument);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
\ No newline at end of file
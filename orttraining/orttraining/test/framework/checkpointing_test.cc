@@ -141,6 +141,74 @@ TEST(CheckpointingTest, SaveAndLoad) {
       model_path, name_to_ort_value, name_to_loaded_tensor_proto);
 }
 
+TEST(CheckpointingTest, AsyncSaveShardsAndLoad) {
+  std::unordered_map<std::string, OrtValueTensorData> name_to_ort_value_data{
+      {"first", {{3}, {1.0f, 2.0f, 3.0f}}},
+      {"second", {{2, 2}, {1.0f, 2.0f, 3.0f, 4.0f}}},
+      {"step", {{1}, {5.0f}}},
+  };
+
+  // "step" is saved with both shards
+  std::vector<NameMLValMap> shard_tensors(2);
+  NameMLValMap name_to_ort_value{};
+  for (auto& name_and_ort_value_data : name_to_ort_value_data) {
+    const auto& name = name_and_ort_value_data.first;
+    const OrtValue ort_value = name_and_ort_value_data.second.GetOrtValue();
+    name_to_ort_value.emplace(name, ort_value);
+    if (name != "second") shard_tensors[0].emplace(name, ort_value);
+    if (name != "first") shard_tensors[1].emplace(name, ort_value);
+  }
+
+  std::unordered_map<std::string, std::string> properties{
+      {"one", "1"},
+      {"two", "2"},
+  };
+
+  TemporaryDirectory tmp_dir{ORT_TSTR("checkpointing_test_dir")};
+
+  PathString checkpoint_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("test_checkpoint"))};
+  // this path doesn't need to exist, we just consider its parent directory
+  PathString model_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("test_model.onnx"))};
+
+  DataTransferManager data_transfer{};
+  data_transfer.RegisterDataTransfer(onnxruntime::make_unique<CPUDataTransfer>());
+
+  {
+    AsyncCheckpointWriter writer{nullptr, 2};
+    ASSERT_STATUS_OK(writer.SaveShard(
+        checkpoint_path, data_transfer, shard_tensors[0], properties, 0, 2));
+    ASSERT_STATUS_OK(writer.Wait());
+    ASSERT_FALSE(IsModelCheckpointComplete(checkpoint_path));
+
+    ASSERT_STATUS_OK(writer.SaveShard(
+        checkpoint_path, data_transfer, shard_tensors[1], {}, 1, 2));
+    ASSERT_STATUS_OK(writer.Wait());
+    ASSERT_TRUE(IsModelCheckpointComplete(checkpoint_path));
+  }
+
+  std::vector<ONNX_NAMESPACE::TensorProto> loaded_tensor_protos{};
+  std::unordered_map<std::string, std::string> loaded_properties{};
+
+  ASSERT_STATUS_OK(LoadModelCheckpoint(
+      checkpoint_path, model_path, loaded_tensor_protos, loaded_properties));
+
+  ASSERT_EQ(loaded_properties, properties);
+  ASSERT_EQ(loaded_tensor_protos.size(), name_to_ort_value.size());
+
+  std::unordered_map<std::string, ONNX_NAMESPACE::TensorProto> name_to_loaded_tensor_proto{};
+  std::transform(
+      loaded_tensor_protos.begin(), loaded_tensor_protos.end(),
+      std::inserter(name_to_loaded_tensor_proto, name_to_loaded_tensor_proto.end()),
+      [](const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+        return std::make_pair(tensor_proto.name(), tensor_proto);
+      });
+
+  CompareOrtValuesToTensorProtoValues(
+      model_path, name_to_ort_value, name_to_loaded_tensor_proto);
+}
+
 }  // namespace test
 }  // namespace training
 }  // namespace onnxruntime
@@ -46,5 +46,25 @@ TEST(Crc32cTest, ChecksumTests) {
   ASSERT_EQ(static_cast<uint32_t>(0xd9963a56), Crc32c(reinterpret_cast<const char*>(iscsi), sizeof(iscsi)));
 }
 
+// The checksum of unaligned data of any size is the same computed at once or a byte at a time.
+TEST(Crc32cTest, ChecksumUpdateTests) {
+  char data[64];
+  for (size_t i = 0; i < sizeof(data); i++) {
+    data[i] = static_cast<char>(i * 7 + 3);
+  }
+
+  for (size_t offset = 0; offset < 8; offset++) {
+    for (size_t size = 0; offset + size <= sizeof(data); size++) {
+      uint32_t crc = 0;
+      for (size_t i = 0; i < size; i++) {
+        crc = Crc32cUpdate(crc, data + offset + i, 1);
+      }
+      ASSERT_EQ(crc, Crc32c(data + offset, size));
+    }
+  }
+
+  ASSERT_EQ(static_cast<uint32_t>(0xe3069283), Crc32c("123456789", 9));
+}
+
 }  // namespace test
 }  // namespace onnxruntime
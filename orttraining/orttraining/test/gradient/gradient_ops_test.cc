@@ -2049,6 +2049,63 @@ TEST(GradientUtilsTest, ZeroGradientFloat16) {
 }
 #endif
 
+static void RunDynamicLossScaleTest(float loss_scale, int64_t stable_steps, bool is_all_finite,
+                                    float expected_loss_scale, int64_t expected_stable_steps) {
+  OpTester test("DynamicLossScale", 1, onnxruntime::kMSDomain);
+  test.AddAttribute("up_scale_window", static_cast<int64_t>(3));
+  test.AddAttribute("min_loss_scale", 2.0f);
+  test.AddAttribute("max_loss_scale", 64.0f);
+
+  test.AddInput<float>("loss_scale", {1}, {loss_scale});
+  test.AddInput<int64_t>("stable_steps", {1}, {stable_steps});
+  test.AddInput<bool>("is_all_finite", {}, {is_all_finite});
+
+  test.AddOutput<float>("new_loss_scale", {1}, {expected_loss_scale});
+  test.AddOutput<int64_t>("new_stable_steps", {1}, {expected_stable_steps});
+
+  test.Run();
+}
+
+TEST(GradientUtilsTest, DynamicLossScale) {
+  // finite steps count up to the window, which doubles the scale up to the maximum
+  RunDynamicLossScaleTest(16.0f, 0, true, 16.0f, 1);
+  RunDynamicLossScaleTest(16.0f, 2, true, 32.0f, 0);
+  RunDynamicLossScaleTest(64.0f, 2, true, 64.0f, 0);
+  // a non-finite step halves the scale down to the minimum and restarts the count
+  RunDynamicLossScaleTest(16.0f, 2, false, 8.0f, 0);
+  RunDynamicLossScaleTest(2.0f, 1, false, 2.0f, 0);
+}
+
+TEST(GradientUtilsTest, MultiTensorInPlaceAccumulator) {
+  OpTester test("MultiTensorInPlaceAccumulator", 1, onnxruntime::kMSDomain);
+
+  test.AddMissingOptionalInput<bool>();
+  test.AddInput<float>("old_sum_0", {3}, {1.0f, 2.0f, 3.0f});
+  test.AddInput<float>("old_sum_1", {2}, {-1.0f, 0.0f});
+  test.AddInput<float>("value_0", {3}, {4.0f, 5.0f, 6.0f});
+  test.AddInput<float>("value_1", {2}, {2.0f, 3.0f});
+
+  test.AddOutput<float>("new_sum_0", {3}, {5.0f, 7.0f, 9.0f});
+  test.AddOutput<float>("new_sum_1", {2}, {1.0f, 3.0f});
+
+  test.Run();
+}
+
+TEST(GradientUtilsTest, MultiTensorInPlaceAccumulator_NoUpdate) {
+  OpTester test("MultiTensorInPlaceAccumulator", 1, onnxruntime::kMSDomain);
+
+  test.AddInput<bool>("update_signal", {}, {false});
+  test.AddInput<float>("old_sum_0", {3}, {1.0f, 2.0f, 3.0f});
+  test.AddInput<float>("old_sum_1", {2}, {-1.0f, 0.0f});
+  test.AddInput<float>("value_0", {3}, {4.0f, 5.0f, 6.0f});
+  test.AddInput<float>("value_1", {2}, {2.0f, 3.0f});
+
+  test.AddOutput<float>("new_sum_0", {3}, {1.0f, 2.0f, 3.0f});
+  test.AddOutput<float>("new_sum_1", {2}, {-1.0f, 0.0f});
+
+  test.Run();
+}
+
 TEST(GradientCheckerTest, WhereGrad) {
   float max_error;
   GradientChecker<float, float, float> gradient_checker;
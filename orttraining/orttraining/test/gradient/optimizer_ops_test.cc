@@ -1640,6 +1640,53 @@ TEST(OptimizerTest, LambOptimizerMultiTensorRatio) {
       lambdas, alphas, betas, epsilons, max_norms,
       step, loss_scale, &scaled_g_norm);
 }
+
+#ifdef USE_CUDA
+TEST(OptimizerTest, MultiTensorAdamOptimizerTest) {
+  OpTester test("MultiTensorAdamOptimizer", 1, onnxruntime::kMSDomain);
+  AdamOptimizerInputOutput data;
+
+  test.AddInput<bool>("update_signal", {}, {true});
+  test.AddMissingOptionalInput<float>();
+  test.AddMissingOptionalInput<float>();
+  test.AddInput<float>("ETA", {}, data.eta);
+  test.AddInput<int64_t>("Update_Count", {}, {3});
+  test.AddOutput<int64_t>("Update_Count_Out", {}, {4});
+
+  // The first weight matches AdamOptimizerTest, the second one has weight decay so it is updated by another launch.
+  test.AddInput<float>("W_0", {3}, data.w);
+  test.AddInput<float>("G_0", {3}, data.g);
+  test.AddInput<float>("Moment_1_0", {3}, data.m1);
+  test.AddInput<float>("Moment_2_0", {3}, data.m2);
+  test.AddMissingOptionalInput<MLFloat16>();
+  test.AddInput<float>("W_1", {2}, {-1.0f, 0.5f});
+  test.AddInput<float>("G_1", {2}, {0.2f, -0.3f});
+  test.AddInput<float>("Moment_1_1", {2}, {0.05f, 0.0f});
+  test.AddInput<float>("Moment_2_1", {2}, {0.01f, 0.02f});
+  test.AddMissingOptionalInput<MLFloat16>();
+
+  test.AddOutput<float>("W_Out_0", {3}, data.w_new);
+  test.AddMissingOptionalOutput<float>();
+  test.AddOutput<float>("Moment_1_Out_0", {3}, data.m1_new);
+  test.AddOutput<float>("Moment_2_Out_0", {3}, data.m2_new);
+  test.AddMissingOptionalOutput<MLFloat16>();
+  test.AddOutput<float>("W_Out_1", {2}, {-1.3195136f, 0.6033809f});
+  test.AddMissingOptionalOutput<float>();
+  test.AddOutput<float>("Moment_1_Out_1", {2}, {0.065f, -0.03f});
+  test.AddOutput<float>("Moment_2_Out_1", {2}, {0.01003f, 0.02007f});
+  test.AddMissingOptionalOutput<MLFloat16>();
+
+  test.AddAttribute("alpha", std::vector<float>{0.9f, 0.9f});
+  test.AddAttribute("beta", std::vector<float>{0.999f, 0.999f});
+  test.AddAttribute("lambda", std::vector<float>{0.0f, 0.01f});
+  test.AddAttribute("epsilon", std::vector<float>{1e-8f, 1e-8f});
+  test.AddAttribute("max_norm_clip", std::vector<float>{1.0f, 1.0f});
+  test.AddAttribute("do_bias_correction", static_cast<int64_t>(0));
+  test.AddAttribute("weight_decay_mode", static_cast<int64_t>(0));
+
+  test.Run();
+}
+#endif
 #endif
 }
 }  // namespace test
@@ -41,6 +41,8 @@ const std::vector<const char*> k_weight_names{"weight_1", "weight_2"};
 constexpr const char* const k_loss_scaling_factor_name = "loss_scaling_factor";
 constexpr const char* const k_adam_optimizer_op_name = "AdamOptimizer";
 constexpr const char* const k_lamb_optimizer_op_name = "LambOptimizer";
+constexpr const char* const k_multi_tensor_adam_optimizer_op_name = "MultiTensorAdamOptimizer";
+constexpr const char* const k_offloaded_multi_tensor_adam_optimizer_op_name = "OffloadedMultiTensorAdamOptimizer";
 constexpr const char* const k_all_reduce_op_name = "NcclAllReduce";
 constexpr const char* const k_all_gather_op_name = "NcclAllGather";
 constexpr const char* const k_reduce_scatter_op_name = "NcclReduceScatter";
@@ -48,6 +50,7 @@ constexpr const char* const k_is_all_finite_op_name = "IsAllFinite";
 constexpr const char* const k_gradient_norm_op_name = "ReduceAllL2";
 constexpr const char* const k_unscale_op_name = "MixedPrecisionScale";
 constexpr const char* const k_inplace_accumulator_op_name = "InPlaceAccumulator";
+constexpr const char* const k_multi_tensor_inplace_accumulator_op_name = "MultiTensorInPlaceAccumulator";
 constexpr const char* const k_zero_gradient_op_name = "ZeroGradient";
 #if defined(USE_MPI)
 constexpr const char* const k_adasum_op_name = "AdasumAllReduce";
@@ -320,6 +323,66 @@ TEST_F(OptimizerGraphBuilderTest, Default_WithGradientAccumulation_WithMixedPrec
   TestDefaultOptimizerGraphBuilder(config, graph_);
 }
 
+TEST_F(OptimizerGraphBuilderTest, MultiTensorAdam_SingleNodeForAllWeights) {
+  OptimizerGraphConfig config;
+  config.use_mixed_precision = true;
+  std::unordered_map<std::string, std::string> updated_weight_names_map;
+  std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
+  OptimizerGraphBuilder optimizer_graph_builder(
+      GetOptimizerBuilderRegistry(), config, GetOptInfoMap(k_multi_tensor_adam_optimizer_op_name),
+      updated_weight_names_map, weight_partition_info);
+
+  OptimizerOutputKeyMap<std::string> opt_graph_outputs;
+  std::unordered_map<std::string, std::unordered_map<std::string, std::string>> weight_to_opt_mapping;
+  ASSERT_STATUS_OK(optimizer_graph_builder.Build(graph_, weight_to_opt_mapping, opt_graph_outputs));
+
+  auto op_counts = CountOpsInGraph(graph_, false);
+  ASSERT_EQ(GetOpCount(op_counts, k_multi_tensor_adam_optimizer_op_name), 1);
+  ASSERT_EQ(GetOpCount(op_counts, k_adam_optimizer_op_name), 0);
+
+  // the update count is shared by all the weights
+  ASSERT_EQ(weight_to_opt_mapping[SHARED_OPTIMIZER_STATES_KEY][ADAM_UC_PREFIX], ADAM_UC_PREFIX);
+  for (const auto& weight_name : k_weight_names) {
+    ASSERT_EQ(weight_to_opt_mapping[weight_name].count(ADAM_UC_PREFIX), 0);
+  }
+}
+
+TEST_F(OptimizerGraphBuilderTest, OffloadedMultiTensorAdam_RequiresMixedPrecisionWeights) {
+  OptimizerGraphConfig config;
+  std::unordered_map<std::string, std::string> updated_weight_names_map;
+  std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
+  OptimizerGraphBuilder optimizer_graph_builder(
+      GetOptimizerBuilderRegistry(), config, GetOptInfoMap(k_offloaded_multi_tensor_adam_optimizer_op_name),
+      updated_weight_names_map, weight_partition_info);
+
+  // the full precision weights in host memory would be read by the rest of the graph
+  OptimizerOutputKeyMap<std::string> opt_graph_outputs;
+  std::unordered_map<std::string, std::unordered_map<std::string, std::string>> weight_to_opt_mapping;
+  ASSERT_FALSE(optimizer_graph_builder.Build(graph_, weight_to_opt_mapping, opt_graph_outputs).IsOK());
+}
+
+TEST_F(OptimizerGraphBuilderTest, MultiTensorGradientAccumulation_SingleNodeForAllGradients) {
+  OptimizerGraphConfig config;
+  config.gradient_accumulation_steps = 10;
+  config.use_multi_tensor_gradient_accumulation = true;
+  std::unordered_map<std::string, std::string> updated_weight_names_map;
+  std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
+  OptimizerGraphBuilder optimizer_graph_builder(
+      GetOptimizerBuilderRegistry(), config, GetOptInfoMap(), updated_weight_names_map, weight_partition_info);
+
+  OptimizerOutputKeyMap<std::string> opt_graph_outputs;
+  std::unordered_map<std::string, std::unordered_map<std::string, std::string>> weight_to_opt_mapping;
+  ASSERT_STATUS_OK(optimizer_graph_builder.Build(graph_, weight_to_opt_mapping, opt_graph_outputs));
+
+  // the gradients share a type, so one node accumulates all of them
+  auto op_counts = CountOpsInGraph(graph_, false);
+  ASSERT_EQ(GetOpCount(op_counts, k_multi_tensor_inplace_accumulator_op_name), 1);
+  ASSERT_EQ(GetOpCount(op_counts, k_inplace_accumulator_op_name), 0);
+  ASSERT_EQ(GetOpCount(op_counts, k_zero_gradient_op_name), k_weight_names.size());
+  ASSERT_EQ(GetOpCount(op_counts, k_adam_optimizer_op_name), k_weight_names.size());
+  ASSERT_GT(opt_graph_outputs.count(OptimizerOutputKey::GradientAccumulation), 0);
+}
+
 #if defined(ORT_USE_NCCL)
 static void TestAllreduceOptimizerGraphBuilder(OptimizerGraphConfig config, Graph& graph) {
   std::unordered_map<std::string, std::string> updated_weight_names_map;
@@ -477,6 +540,33 @@ TEST_F(OptimizerGraphBuilderTest, Allreduce_WithGradientAccumulation_WithMixedPr
   TestAllreduceOptimizerGraphBuilder(config, graph_);
 }
 
+TEST_F(OptimizerGraphBuilderTest, Allreduce_BucketedGradients) {
+  OptimizerGraphConfig config;
+  config.data_parallel_group_size = 4;
+  config.use_nccl = true;
+  // each of the 1 element fp32 gradients fills a bucket
+  config.allreduce_bucket_size_bytes = sizeof(float);
+  TestAllreduceOptimizerGraphBuilder(config, graph_);
+
+  auto op_counts = CountOpsInGraph(graph_, false);
+  ASSERT_EQ(GetOpCount(op_counts, k_all_reduce_op_name), k_weight_names.size());
+  ASSERT_EQ(GetOpCount(op_counts, k_unscale_op_name), k_weight_names.size());
+  ASSERT_EQ(GetOpCount(op_counts, "PassThrough"), 1);
+
+  // only the last bucket waits for the overlapped all-reduces
+  int num_overlapped_allreduces = 0;
+  for (const auto& node : graph_.Nodes()) {
+    if (node.OpType() == k_all_reduce_op_name) {
+      ASSERT_EQ(node.Priority(), static_cast<int>(ExecutionPriority::LOCAL_HIGH));
+      const auto& attributes = node.GetAttributes();
+      const auto it = attributes.find("overlap_with_compute");
+      ASSERT_NE(it, attributes.end());
+      num_overlapped_allreduces += static_cast<int>(it->second.i());
+    }
+  }
+  ASSERT_EQ(num_overlapped_allreduces, static_cast<int>(k_weight_names.size()) - 1);
+}
+
 static void TestZeROOptimizerGraphBuilder(OptimizerGraphConfig config, Graph& graph) {
   std::unordered_map<std::string, std::string> updated_weight_names_map;
   std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
@@ -554,6 +644,75 @@ TEST_F(OptimizerGraphBuilderTest, ZeRO_WithGradientAccumulation_WithMixedPrecisi
   TestZeROOptimizerGraphBuilder(config, graph_);
 }
 
+TEST_F(OptimizerGraphBuilderTest, ZeRO_Stage2_WithGradientAccumulation) {
+  OptimizerGraphConfig config;
+  config.data_parallel_group_size = 4;
+  config.use_nccl = true;
+  config.deepspeed_zero = ZeROConfig{2};
+  config.gradient_accumulation_steps = 10;
+  config.use_mixed_precision = false;
+
+  std::unordered_map<std::string, std::string> updated_weight_names_map;
+  std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
+  ZeROOptimizerGraphBuilder optimizer_graph_builder(
+      GetOptimizerBuilderRegistry(), config, GetOptInfoMap(), updated_weight_names_map, weight_partition_info);
+
+  OptimizerOutputKeyMap<std::string> opt_graph_outputs;
+  std::unordered_map<std::string, std::unordered_map<std::string, std::string>> weight_to_opt_mapping;
+  ASSERT_STATUS_OK(optimizer_graph_builder.Build(graph_, weight_to_opt_mapping, opt_graph_outputs));
+
+  auto op_counts = CountOpsInGraph(graph_, false);
+
+  // the gradients of every step are reduce-scattered before the accumulation
+  ASSERT_EQ(GetOpCount(op_counts, k_reduce_scatter_op_name), 1);
+  ASSERT_GT(opt_graph_outputs.count(OptimizerOutputKey::GradientAccumulation), 0);
+  const Node* reduce_scatter_node = nullptr;
+  for (const auto& node : graph_.Nodes()) {
+    if (node.OpType() == k_reduce_scatter_op_name) {
+      reduce_scatter_node = &node;
+    }
+  }
+  ASSERT_NE(reduce_scatter_node, nullptr);
+  for (auto it = reduce_scatter_node->OutputNodesBegin(); it != reduce_scatter_node->OutputNodesEnd(); ++it) {
+    ASSERT_EQ(it->OpType(), k_inplace_accumulator_op_name);
+  }
+
+  // rank 0 updates both the small weights, so it accumulates and zeroes both their gradients
+  ASSERT_EQ(GetOpCount(op_counts, k_inplace_accumulator_op_name), k_weight_names.size());
+  ASSERT_EQ(GetOpCount(op_counts, k_zero_gradient_op_name), k_weight_names.size());
+  ASSERT_EQ(GetOpCount(op_counts, k_adam_optimizer_op_name), k_weight_names.size());
+}
+
+TEST_F(OptimizerGraphBuilderTest, ZeRO_Stage2_RankWithoutPartition) {
+  OptimizerGraphConfig config;
+  config.data_parallel_group_size = 4;
+  // the padded partition of the last rank contains no weight
+  config.data_parallel_group_rank = 3;
+  config.use_nccl = true;
+  config.deepspeed_zero = ZeROConfig{2};
+  config.gradient_accumulation_steps = 10;
+  config.use_mixed_precision = false;
+  // there is no local gradient to compute the norm of
+  config.enable_grad_norm_clip = false;
+
+  std::unordered_map<std::string, std::string> updated_weight_names_map;
+  std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
+  ZeROOptimizerGraphBuilder optimizer_graph_builder(
+      GetOptimizerBuilderRegistry(), config, GetOptInfoMap(), updated_weight_names_map, weight_partition_info);
+
+  OptimizerOutputKeyMap<std::string> opt_graph_outputs;
+  std::unordered_map<std::string, std::unordered_map<std::string, std::string>> weight_to_opt_mapping;
+  ASSERT_STATUS_OK(optimizer_graph_builder.Build(graph_, weight_to_opt_mapping, opt_graph_outputs));
+
+  auto op_counts = CountOpsInGraph(graph_, false);
+
+  // the rank still takes part in the reduce-scatter of every step
+  ASSERT_EQ(GetOpCount(op_counts, k_reduce_scatter_op_name), 1);
+  ASSERT_GT(opt_graph_outputs.count(OptimizerOutputKey::GradientAccumulation), 0);
+  ASSERT_EQ(GetOpCount(op_counts, k_inplace_accumulator_op_name), 0);
+  ASSERT_EQ(GetOpCount(op_counts, k_zero_gradient_op_name), 0);
+}
+
 #endif  // ORT_USE_NCCL
 
 }  // namespace test
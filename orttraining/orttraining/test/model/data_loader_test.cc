@@ -194,6 +194,145 @@ TEST(TrainingDataLoaderTest, DataLoader_MultipleFiles_PreloadCountExceedsFileCou
   TestDataLoaderWithMultipleFiles(3, 4);
 }
 
+TEST(TrainingDataLoaderTest, BatchPrefetcher_SameBatchesAsGetKthBatch) {
+  const size_t num_samples = 5;
+  const size_t batch_size = 2;
+  auto data_set = std::make_shared<DataSet>(std::vector<std::string>{"a", "b"});
+  for (uint32_t i = 0; i < num_samples; ++i) {
+    std::vector<ONNX_NAMESPACE::TensorProto> features(2);
+    for (auto& feature : features) {
+      feature.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_UINT32);
+      feature.add_dims(2);
+      feature.add_uint64_data(i);
+      feature.add_uint64_data(i + 100);
+    }
+    ASSERT_STATUS_OK(data_set->AddData(features));
+  }
+
+  const size_t num_batches = data_set->TotalBatch(batch_size);
+  BatchPrefetcher prefetcher{nullptr, 2};
+  for (int epoch = 0; epoch < 3; ++epoch) {
+    prefetcher.Start(data_set, batch_size);
+
+    // the batches are held until the end of the epoch, so their buffers can't be reused meanwhile
+    std::vector<std::vector<OrtValue>> batches(num_batches);
+    for (size_t k = 0; k < num_batches; ++k) {
+      ASSERT_STATUS_OK(prefetcher.GetBatch(k, batches[k]));
+    }
+    ASSERT_FALSE(prefetcher.GetBatch(num_batches, batches[0]).IsOK());
+    prefetcher.Stop();
+
+    for (size_t k = 0; k < num_batches; ++k) {
+      const auto expected_batch = data_set->GetKthBatch(batch_size, k);
+      ASSERT_EQ(batches[k].size(), expected_batch.size());
+      for (size_t i = 0; i < expected_batch.size(); ++i) {
+        const auto& tensor = batches[k][i].Get<Tensor>();
+        const auto& expected_tensor = expected_batch[i].Get<Tensor>();
+        ASSERT_EQ(tensor.Shape(), expected_tensor.Shape());
+        ASSERT_EQ(std::vector<uint32_t>(tensor.Data<uint32_t>(), tensor.Data<uint32_t>() + tensor.Shape().Size()),
+                  std::vector<uint32_t>(expected_tensor.Data<uint32_t>(),
+                                        expected_tensor.Data<uint32_t>() + expected_tensor.Shape().Size()));
+      }
+    }
+  }
+}
+
+TEST(TrainingDataLoaderTest, DataSet_BucketBySequenceLength) {
+  const int64_t max_sequence_length = 8;
+  const std::vector<int64_t> sequence_lengths{7, 1, 5, 2, 8};
+  const size_t batch_size = 2;
+  auto data_set = std::make_shared<DataSet>(std::vector<std::string>{"ids", "mask", "label"});
+  for (size_t i = 0; i < sequence_lengths.size(); ++i) {
+    std::vector<ONNX_NAMESPACE::TensorProto> features(3);
+    for (auto& feature : features) {
+      feature.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+    }
+    features[0].add_dims(max_sequence_length);
+    features[1].add_dims(max_sequence_length);
+    for (int64_t j = 0; j < max_sequence_length; ++j) {
+      features[0].add_int64_data(j < sequence_lengths[i] ? static_cast<int64_t>(i) + 1 : 0);
+      features[1].add_int64_data(j < sequence_lengths[i] ? 1 : 0);
+    }
+    features[2].add_dims(1);
+    features[2].add_int64_data(static_cast<int64_t>(i));
+    ASSERT_STATUS_OK(data_set->AddData(features));
+  }
+
+  ASSERT_FALSE(data_set->BucketBySequenceLength(batch_size, "label", {"ids", "mask"}, 4).IsOK());
+  ASSERT_FALSE(data_set->BucketBySequenceLength(batch_size, "mask", {"ids"}, 4).IsOK());
+  ASSERT_STATUS_OK(data_set->BucketBySequenceLength(batch_size, "mask", {"ids", "mask"}, 4));
+
+  // the samples sorted by length are batched as {1, 2}, {5, 7} and {8} with the first sample wrapped around,
+  // with the full batches shuffled
+  const size_t num_batches = data_set->TotalBatch(batch_size);
+  ASSERT_EQ(num_batches, 3u);
+  std::vector<int64_t> batch_sequence_lengths;
+  std::vector<bool> seen(sequence_lengths.size(), false);
+  for (size_t k = 0; k < num_batches; ++k) {
+    const auto batch = data_set->GetKthBatch(batch_size, k);
+    const Tensor& ids = batch[0].Get<Tensor>();
+    const Tensor& labels = batch[2].Get<Tensor>();
+    ASSERT_EQ(ids.Shape().NumDimensions(), 2u);
+    const int64_t batch_sequence_length = ids.Shape()[1];
+    ASSERT_EQ(batch[1].Get<Tensor>().Shape(), TensorShape({2, batch_sequence_length}));
+    ASSERT_EQ(labels.Shape(), TensorShape({2}));
+    batch_sequence_lengths.push_back(batch_sequence_length);
+
+    for (size_t b = 0; b < batch_size; ++b) {
+      const int64_t sample = labels.Data<int64_t>()[b];
+      if (k + 1 < num_batches || b == 0) {
+        ASSERT_FALSE(seen[sample]);
+        seen[sample] = true;
+      }
+      const int64_t* sample_ids = ids.Data<int64_t>() + static_cast<int64_t>(b) * batch_sequence_length;
+      for (int64_t j = 0; j < batch_sequence_length; ++j) {
+        ASSERT_EQ(sample_ids[j], j < sequence_lengths[sample] ? sample + 1 : 0);
+      }
+    }
+  }
+  ASSERT_EQ(std::vector<bool>(sequence_lengths.size(), true), seen);
+  std::sort(batch_sequence_lengths.begin(), batch_sequence_lengths.end() - 1);
+  ASSERT_EQ(batch_sequence_lengths, std::vector<int64_t>({4, 8, 8}));
+
+  // the prefetched batches are trimmed the same
+  BatchPrefetcher prefetcher{nullptr, 2};
+  prefetcher.Start(data_set, batch_size);
+  for (size_t k = 0; k < num_batches; ++k) {
+    std::vector<OrtValue> batch;
+    ASSERT_STATUS_OK(prefetcher.GetBatch(k, batch));
+    const auto expected_batch = data_set->GetKthBatch(batch_size, k);
+    for (size_t i = 0; i < expected_batch.size(); ++i) {
+      const auto& tensor = batch[i].Get<Tensor>();
+      const auto& expected_tensor = expected_batch[i].Get<Tensor>();
+      ASSERT_EQ(tensor.Shape(), expected_tensor.Shape());
+      ASSERT_EQ(std::vector<int64_t>(tensor.Data<int64_t>(), tensor.Data<int64_t>() + tensor.Shape().Size()),
+                std::vector<int64_t>(expected_tensor.Data<int64_t>(),
+                                     expected_tensor.Data<int64_t>() + expected_tensor.Shape().Size()));
+    }
+  }
+
+  // shuffling drops the bucketing
+  data_set->RandomShuffle();
+  ASSERT_EQ(data_set->GetKthBatch(batch_size, 0)[0].Get<Tensor>().Shape(), TensorShape({2, max_sequence_length}));
+}
+
+TEST(TrainingDataLoaderTest, BatchPrefetcher_BatchesTakenInOrder) {
+  const std::vector<std::string> tensor_names{"input1"};
+  auto data_set = std::make_shared<RandomDataSet>(
+      4, tensor_names, std::vector<TensorShape>{{1, 3}}, std::vector<onnx::TensorProto_DataType>{onnx::TensorProto_DataType_FLOAT});
+
+  BatchPrefetcher prefetcher{nullptr, 2};
+  prefetcher.Start(data_set, 1, 1);
+
+  std::vector<OrtValue> batch;
+  ASSERT_FALSE(prefetcher.GetBatch(0, batch).IsOK());
+  ASSERT_STATUS_OK(prefetcher.GetBatch(1, batch));
+  ASSERT_EQ(batch.size(), 1);
+  ASSERT_EQ(batch[0].Get<Tensor>().Shape(), TensorShape({1, 3}));
+  ASSERT_FALSE(prefetcher.GetBatch(3, batch).IsOK());
+  ASSERT_STATUS_OK(prefetcher.GetBatch(2, batch));
+}
+
 }  // namespace test
 }  // namespace training
 }  // namespace onnxruntime
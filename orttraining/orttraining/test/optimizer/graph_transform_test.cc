@@ -19,11 +19,13 @@
 #include "orttraining/core/optimizer/megatron_transformer.h"
 #include "orttraining/core/optimizer/concat_replacement.h"
 #include "orttraining/core/optimizer/localized_recompute.h"
+#include "orttraining/core/optimizer/memory_budget_recompute.h"
 #include "test/optimizer/graph_transform_test_fixture.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/asserts.h"
 #include "orttraining/test/optimizer/horizontal_parallel_test_utils.h"
 #include "orttraining/core/session/training_session.h"
+#include "orttraining/core/session/horizontal_parallel_inference.h"
 
 #include <random>
 
@@ -300,6 +302,43 @@ TEST_F(GraphTransformationTests, MegatronMLPPartitionRank1) {
   }
 }
 
+TEST_F(GraphTransformationTests, HorizontalParallelInferenceMLPPartition) {
+  auto model_uri = MODEL_FOLDER "model_parallel/mlp_megatron_basic_test.onnx";
+  std::shared_ptr<Model> p_model;
+  auto ret = Model::Load(model_uri, p_model, nullptr, *logger_);
+  ASSERT_TRUE(ret.IsOK());
+  Graph& graph = p_model->MainGraph();
+
+  // the inference transformer must partition the weights once, even with several steps
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  graph_transformation_mgr.Register(training::CreateHorizontalParallelInferenceTransformer(1, 2),
+                                    TransformerLevel::Level1);
+  ret = graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_);
+  ASSERT_TRUE(ret.IsOK());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_EQ(op_to_count["com.microsoft.MegatronF"], 1);
+  ASSERT_EQ(op_to_count["com.microsoft.MegatronG"], 1);
+
+  const std::vector<std::pair<std::string, std::vector<int64_t>>> expected_shapes = {
+      {"matmul", {4, 8}}, {"add", {8}}, {"matmul2", {8, 4}}};
+  for (const auto& expected : expected_shapes) {
+    auto weight_arg = GetNodeByName(graph, expected.first)->MutableInputDefs()[1];
+    ORT_ENFORCE(weight_arg != nullptr);
+    std::vector<float> actual_val;
+    std::vector<int64_t> actual_shape;
+    horizontal_parallel_test_utils::GetDataAndShapeFromTensorProto(graph, weight_arg, actual_val, actual_shape);
+    ASSERT_EQ(actual_shape, expected.second) << expected.first;
+  }
+
+  // same values as the MegatronTransformer partition of rank 1
+  std::vector<float> expected_value = {0.08f, 0.09f, 0.1f, 0.11f, 0.12f, 0.13f, 0.14f, 0.15f};
+  std::vector<float> actual_val;
+  std::vector<int64_t> actual_shape;
+  horizontal_parallel_test_utils::GetDataAndShapeFromTensorProto(
+      graph, GetNodeByName(graph, "add")->MutableInputDefs()[1], actual_val, actual_shape);
+  horizontal_parallel_test_utils::VerifyOutputs(expected_value, actual_val, true);
+}
 TEST_F(GraphTransformationTests, MegatronSelfAttentionPartitionRank0) {
   auto model_uri = MODEL_FOLDER "model_parallel/self_attention_megatron_basic_test.onnx";
   std::shared_ptr<Model> p_model;
@@ -466,6 +505,76 @@ TEST_F(GraphTransformationTests, BiasGeluRecomputeTest) {
   }
 }
 
+// MatMul -> Gelu -> Add -> Relu, where each activation is 4096 bytes for a batch of 4
+static void BuildMemoryBudgetRecomputeGraph(Graph& graph) {
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("batch");
+  tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(256);
+  TypeProto weight_type;
+  weight_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  weight_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(256);
+  weight_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(256);
+
+  auto& input = graph.GetOrCreateNodeArg("input", &tensor_type);
+  auto& weight = graph.GetOrCreateNodeArg("weight", &weight_type);
+  auto& bias = graph.GetOrCreateNodeArg("bias", &tensor_type);
+  auto& matmul_out = graph.GetOrCreateNodeArg("matmul_out", &tensor_type);
+  auto& gelu_out = graph.GetOrCreateNodeArg("gelu_out", &tensor_type);
+  auto& add_out = graph.GetOrCreateNodeArg("add_out", &tensor_type);
+  auto& output = graph.GetOrCreateNodeArg("output", &tensor_type);
+  graph.AddNode("matmul", "MatMul", "", {&input, &weight}, {&matmul_out});
+  graph.AddNode("gelu", "Gelu", "", {&matmul_out}, {&gelu_out}, nullptr, kMSDomain);
+  graph.AddNode("add", "Add", "", {&gelu_out, &bias}, {&add_out});
+  graph.AddNode("relu", "Relu", "", {&add_out}, {&output});
+  ASSERT_STATUS_OK(graph.Resolve());
+}
+
+TEST_F(GraphTransformationTests, MemoryBudgetRecompute) {
+  const std::unordered_map<std::string, int64_t> dim_params{{"batch", 4}};
+  const auto apply = [this, &dim_params](Graph& graph, int64_t memory_budget_bytes) {
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{1};
+    graph_transformation_mgr.Register(
+        onnxruntime::make_unique<MemoryBudgetRecompute>(memory_budget_bytes, dim_params), TransformerLevel::Level1);
+    ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+  };
+
+  // the 16384 bytes of activations fit
+  {
+    Model model("MemoryBudgetRecompute", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                {{kOnnxDomain, 12}, {kMSDomain, 1}}, {}, *logger_);
+    BuildMemoryBudgetRecomputeGraph(model.MainGraph());
+    apply(model.MainGraph(), 16384);
+    ASSERT_EQ(model.MainGraph().NumberOfNodes(), 4);
+  }
+
+  // the Add is the cheapest to recompute
+  {
+    Model model("MemoryBudgetRecompute", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                {{kOnnxDomain, 12}, {kMSDomain, 1}}, {}, *logger_);
+    Graph& graph = model.MainGraph();
+    BuildMemoryBudgetRecomputeGraph(graph);
+    apply(graph, 12288);
+    ASSERT_EQ(graph.NumberOfNodes(), 5);
+    const Node* add_recompute = graph.GetProducerNode("add_out_recompute");
+    ASSERT_NE(add_recompute, nullptr);
+    ASSERT_EQ(add_recompute->InputDefs()[0]->Name(), "gelu_out");
+  }
+
+  // then the Gelu, which the recomputed Add reads, rather than the MatMul
+  {
+    Model model("MemoryBudgetRecompute", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                {{kOnnxDomain, 12}, {kMSDomain, 1}}, {}, *logger_);
+    Graph& graph = model.MainGraph();
+    BuildMemoryBudgetRecomputeGraph(graph);
+    apply(graph, 8192);
+    ASSERT_EQ(graph.NumberOfNodes(), 6);
+    ASSERT_NE(graph.GetProducerNode("gelu_out_recompute"), nullptr);
+    ASSERT_EQ(graph.GetProducerNode("matmul_out_recompute"), nullptr);
+    ASSERT_EQ(graph.GetProducerNode("add_out_recompute")->InputDefs()[0]->Name(), "gelu_out_recompute");
+  }
+}
+
 // We only tested on CUDA run.
 #if defined(USE_CUDA)
 static void RunPartitionCorrectnessTest(std::string model_path,
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "orttraining/training_ops/cpu/nn/dropout_7.h"
+#include "core/providers/cpu/generator/philox.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -42,11 +43,23 @@ Status Dropout_7::Compute(OpKernelContext* context) const {
     Tensor& mask = *context->Output(1, shape);
     bool* mask_data = mask.template MutableData<bool>();
 
-    // TODO: Compute is a const function, generator cannot be a private meber
-    float seed = gsl::narrow_cast<float>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
-    std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-    std::bernoulli_distribution distribution(keep_prob_);
-    std::generate_n(mask_data, shape.Size(), [&] { return distribution(generator); });
+    // the mask is generated in parallel from the Philox blocks of the call, as in Dropout
+    const std::ptrdiff_t mask_size = shape.Size();
+    const float keep_prob = keep_prob_;
+    constexpr std::ptrdiff_t values_per_block = Philox4x32::NumValuesPerBlock<float>();
+    Philox4x32::ParallelFor(
+        context->GetOperatorThreadPool(), PhiloxGenerator::Default(),
+        (mask_size + values_per_block - 1) / values_per_block,
+        TensorOpCost{0, static_cast<double>(values_per_block), 50.0},
+        [keep_prob, mask_data, mask_size](std::ptrdiff_t block, const Philox4x32::Block& bits) {
+          float uniform[Philox4x32::NumValuesPerBlock<float>()];
+          Philox4x32::Uniform(bits, uniform);
+          const std::ptrdiff_t begin = block * Philox4x32::NumValuesPerBlock<float>();
+          const std::ptrdiff_t end = std::min(begin + Philox4x32::NumValuesPerBlock<float>(), mask_size);
+          for (std::ptrdiff_t i = begin; i < end; ++i) {
+            mask_data[i] = uniform[i - begin] < keep_prob;
+          }
+        });
 
     EigenMap<float>(Y) = scale * EigenMap<float>(X).cwiseProduct(EigenMap<bool>(mask).cast<float>());
   }
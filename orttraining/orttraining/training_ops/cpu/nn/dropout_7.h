@@ -4,7 +4,6 @@
 #pragma once
 
 #include "core/common/common.h"
-#include <random>
 #include "core/framework/op_kernel.h"
 
 namespace onnxruntime {
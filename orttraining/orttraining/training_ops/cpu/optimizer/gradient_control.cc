@@ -3,6 +3,8 @@
 
 #include "gradient_control.h"
 
+#include <algorithm>
+
 #include "core/framework/op_kernel.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/math/element_wise_ops.h"
@@ -53,6 +55,48 @@ Status InPlaceAccumulator<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+ONNX_OPERATOR_KERNEL_EX(
+    MultiTensorInPlaceAccumulator,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .VariadicAlias(1, 0)  // accumulate the old sums in-place
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T_BOOL", DataTypeImpl::GetTensorType<bool>()),
+    MultiTensorInPlaceAccumulator<float>);
+
+template <typename T>
+Status MultiTensorInPlaceAccumulator<T>::Compute(OpKernelContext* context) const {
+  const int num_tensors = (context->InputCount() - 1) / 2;
+  ORT_RETURN_IF_NOT(num_tensors > 0 && context->InputCount() == 1 + 2 * num_tensors,
+                    "MultiTensorInPlaceAccumulator must have as many values as old sums.");
+
+  const Tensor* do_update_tensor = context->Input<Tensor>(0);
+  const bool do_update = do_update_tensor == nullptr || *(do_update_tensor->template Data<bool>());
+  for (int i = 0; i < num_tensors; ++i) {
+    const Tensor& old_sum = *context->Input<Tensor>(1 + i);
+    const Tensor& value = *context->Input<Tensor>(1 + num_tensors + i);
+    ORT_RETURN_IF_NOT(old_sum.Shape() == value.Shape(),
+                      "The old sum and the value of tensor ", i, " must have the same shape.");
+    Tensor& new_sum = *context->Output(i, old_sum.Shape());
+
+    const T* old_sum_data = old_sum.template Data<T>();
+    T* new_sum_data = new_sum.template MutableData<T>();
+    if (do_update) {
+      const T* value_data = value.template Data<T>();
+      const int64_t count = old_sum.Shape().Size();
+      for (int64_t j = 0; j < count; ++j) {
+        new_sum_data[j] = old_sum_data[j] + value_data[j];
+      }
+    } else if (new_sum_data != old_sum_data) {
+      memcpy(new_sum_data, old_sum_data, old_sum.SizeInBytes());
+    }
+  }
+
+  return Status::OK();
+}
+
 template <typename T>
 Status ZeroGradient<T>::Compute(OpKernelContext* context) const {
   const Tensor& old_gradient = *context->Input<Tensor>(0);
@@ -73,5 +117,45 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("T2", DataTypeImpl::AllTensorTypes()),
     ZeroGradient<float>);
 
+ONNX_OPERATOR_KERNEL_EX(
+    DynamicLossScale,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .Alias(0, 0)  // update the loss scale in-place
+        .Alias(1, 1)  // update the stable steps in-place
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T_INT", DataTypeImpl::GetTensorType<int64_t>())
+        .TypeConstraint("T_BOOL", DataTypeImpl::GetTensorType<bool>())
+        .TypeConstraint("T_ANY", DataTypeImpl::AllTensorTypes()),
+    DynamicLossScale);
+
+Status DynamicLossScale::Compute(OpKernelContext* context) const {
+  const Tensor& loss_scale_tensor = *context->Input<Tensor>(0);
+  const Tensor& stable_steps_tensor = *context->Input<Tensor>(1);
+  const Tensor& is_all_finite_tensor = *context->Input<Tensor>(2);
+  ORT_RETURN_IF_NOT(loss_scale_tensor.Shape().Size() == 1 && stable_steps_tensor.Shape().Size() == 1 &&
+                        is_all_finite_tensor.Shape().Size() == 1,
+                    "The loss scale, stable steps and is_all_finite inputs must have a single element.");
+
+  float loss_scale = *loss_scale_tensor.template Data<float>();
+  int64_t stable_steps = *stable_steps_tensor.template Data<int64_t>();
+  if (*is_all_finite_tensor.template Data<bool>()) {
+    ++stable_steps;
+    if (stable_steps >= up_scale_window_) {
+      loss_scale = std::min(max_loss_scale_, loss_scale * 2.0f);
+      stable_steps = 0;
+    }
+  } else {
+    loss_scale = std::max(min_loss_scale_, loss_scale / 2.0f);
+    stable_steps = 0;
+  }
+
+  *context->Output(0, loss_scale_tensor.Shape())->template MutableData<float>() = loss_scale;
+  *context->Output(1, stable_steps_tensor.Shape())->template MutableData<int64_t>() = stable_steps;
+  return Status::OK();
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
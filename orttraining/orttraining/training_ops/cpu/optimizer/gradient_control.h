@@ -21,5 +21,30 @@ class InPlaceAccumulator final : public OpKernel {
   InPlaceAccumulator(const OpKernelInfo& info) : OpKernel(info) {}
   Status Compute(OpKernelContext* context) const override;
 };
+
+template <typename T>
+class MultiTensorInPlaceAccumulator final : public OpKernel {
+ public:
+  MultiTensorInPlaceAccumulator(const OpKernelInfo& info) : OpKernel(info) {}
+  Status Compute(OpKernelContext* context) const override;
+};
+
+class DynamicLossScale final : public OpKernel {
+ public:
+  DynamicLossScale(const OpKernelInfo& info) : OpKernel(info) {
+    up_scale_window_ = info.GetAttrOrDefault<int64_t>("up_scale_window", 2000);
+    min_loss_scale_ = info.GetAttrOrDefault<float>("min_loss_scale", 1.0f);
+    max_loss_scale_ = info.GetAttrOrDefault<float>("max_loss_scale", static_cast<float>(1 << 24));
+    ORT_ENFORCE(up_scale_window_ > 0, "up_scale_window must be positive.");
+    ORT_ENFORCE(min_loss_scale_ > 0.0f && min_loss_scale_ <= max_loss_scale_,
+                "min_loss_scale must be positive and no larger than max_loss_scale.");
+  }
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t up_scale_window_;
+  float min_loss_scale_;
+  float max_loss_scale_;
+};
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -2,18 +2,103 @@
 // Licensed under the MIT License.
 #ifdef USE_MPI
 #include "orttraining/training_ops/cuda/collective/adasum_kernels.h"
+
+#include <algorithm>
+
 #include "orttraining/training_ops/communication_common.h"
 #include "orttraining/core/framework/communication/mpi/mpi_context.h"
 
 namespace onnxruntime {
 namespace cuda {
 
-Status AdasumAllReduce::ComputeInternal(OpKernelContext* context) const {
+Status AdasumAllReduce::ComputeHierarchical(OpKernelContext* context) const {
+#ifdef ORT_USE_NCCL
+  cudaStream_t stream = nullptr;  // Default stream
+  ORT_RETURN_IF_ERROR(nccl_->WaitForOverlappedWork(stream));
+
+  // The inputs are the same on the ranks of a node, the node-local all-reduce of the gradients before the optimizers
+  // made them so. Each rank of the node reduces its shard of the fused inputs with the ranks of the other nodes, and an
+  // all-gather over the node assembles the shards, so the inter-node traffic of a node is one copy of the inputs
+  // instead of one copy per rank.
+  const training::WorkerGroupType node_local_group = training::WorkerGroupType::NodeLocalDataParallel;
+  const int local_rank = nccl_->Rank(node_local_group);
+  const int local_size = nccl_->Size(node_local_group);
+
+  const int num_tensors = context->InputCount();
+  MLDataType onnx_type = context->Input<Tensor>(0)->DataType();
+  const size_t element_size = onnx_type->Size();
+  int64_t total_count = 0;
+  for (int i = 0; i < num_tensors; ++i) {
+    total_count += context->Input<Tensor>(i)->Shape().Size();
+  }
+
+  // the shard of this rank is [shard_begin, shard_end) of the fused inputs, padded to the same count on every rank
+  const int64_t shard_count = (total_count + local_size - 1) / local_size;
+  const int64_t shard_begin = std::min(total_count, local_rank * shard_count);
+  const int64_t shard_end = std::min(total_count, shard_begin + shard_count);
+
+  AllocatorPtr allocator = Info().GetAllocator(0, OrtMemTypeCPU);
+  const size_t shard_bytes = static_cast<size_t>(shard_count) * element_size;
+  BufferUniquePtr data_buffer_ptr(allocator->Alloc(shard_bytes), BufferDeleter(allocator));
+  BufferUniquePtr recv_buffer_ptr(allocator->Alloc(shard_bytes), BufferDeleter(allocator));
+  uint8_t* data_buffer = reinterpret_cast<uint8_t*>(data_buffer_ptr.get());
+
+  // copy the part of each input in the shard to the host, with the element counts of the shard for Adasum
+  std::vector<int> shard_element_counts(num_tensors, 0);
+  int64_t offset = 0;
+  for (int i = 0; i < num_tensors; ++i) {
+    const Tensor* x_tensor = context->Input<Tensor>(i);
+    const int64_t count = x_tensor->Shape().Size();
+    const int64_t begin = std::max(offset, shard_begin);
+    const int64_t end = std::min(offset + count, shard_end);
+    if (begin < end) {
+      shard_element_counts[i] = static_cast<int>(end - begin);
+      CUDA_RETURN_IF_ERROR(cudaMemcpy(data_buffer + (begin - shard_begin) * element_size,
+                                      static_cast<const uint8_t*>(x_tensor->DataRaw()) + (begin - offset) * element_size,
+                                      (end - begin) * element_size, cudaMemcpyDeviceToHost));
+    }
+    offset += count;
+  }
+
+  // the levels of the node-local ranks are skipped, their dot products and norms are still summed over the shards
+  ORT_RETURN_IF_ERROR(adasum_reducer_->DispatchFusedAllreduce(
+      data_buffer, recv_buffer_ptr.get(), shard_element_counts,
+      local_size,  // start level
+      training::MPIContext::GetInstance().GetMPIGroup(training::WorkerGroupType::GlobalParallel).communicator,
+      0,  // tag
+      adasum_reducer_->GetReductionComms(),
+      onnx_type));
+
+  // gather the reduced shards of the node in place
+  auto fusion_buffer = GetScratchBuffer<uint8_t>(shard_bytes * local_size);
+  uint8_t* fusion_data = fusion_buffer.get();
+  uint8_t* fusion_shard = fusion_data + local_rank * shard_bytes;
+  CUDA_RETURN_IF_ERROR(cudaMemcpy(fusion_shard, data_buffer, (shard_end - shard_begin) * element_size,
+                                  cudaMemcpyHostToDevice));
+  NCCL_RETURN_IF_ERROR(ncclAllGather(fusion_shard, fusion_data, shard_count, GetNcclDataType(onnx_type),
+                                     nccl_->Comm(node_local_group), stream));
+
+  offset = 0;
+  for (int i = 0; i < num_tensors; ++i) {
+    const Tensor* x_tensor = context->Input<Tensor>(i);
+    Tensor* y_tensor = context->Output(i, x_tensor->Shape());
+    CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(y_tensor->MutableDataRaw(), fusion_data + offset * element_size,
+                                         x_tensor->SizeInBytes(), cudaMemcpyDeviceToDevice, stream));
+    offset += x_tensor->Shape().Size();
+  }
+  return Status::OK();
+#else
+  ORT_UNUSED_PARAMETER(context);
+  return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Hierarchical Adasum needs ORT built with NCCL.");
+#endif
+}
 
-  int vhdd_start_level = 1;
+Status AdasumAllReduce::ComputeInternal(OpKernelContext* context) const {
   if (adasum_reduce_algo_ == training::AdasumReductionType::GpuHierarchicalReduction) {
-    vhdd_start_level = training::DistributedRunContext::GetInstance().GroupSize(training::WorkerGroupType::NodeLocalDataParallel);
+    return ComputeHierarchical(context);
   }
+
+  const int vhdd_start_level = 1;
   // Get tensor count
   const int num_tensors = context->InputCount();
   std::vector<int> tensor_element_counts;
@@ -28,6 +28,9 @@ class AdasumAllReduce final : public NcclKernel {
   Status ComputeInternal(OpKernelContext* context) const override;
 
  private:
+  // Reduces the shard of this rank across the nodes and all-gathers the shards within the node.
+  Status ComputeHierarchical(OpKernelContext* context) const;
+
   training::AdasumReductionType adasum_reduce_algo_ = training::AdasumReductionType::GpuHierarchicalReduction;
   std::unique_ptr<training::AdasumMPI> adasum_reducer_;
 };
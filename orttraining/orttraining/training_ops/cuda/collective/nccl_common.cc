@@ -122,7 +122,39 @@ ncclComm_t NcclContext::Comm(training::WorkerGroupType group_type) {
   return nullptr;
 }
 
+Status NcclContext::BeginOverlappedWork(cudaStream_t compute_stream, cudaStream_t& communication_stream) {
+  if (communication_stream_ == nullptr) {
+    CUDA_RETURN_IF_ERROR(cudaStreamCreateWithFlags(&communication_stream_, cudaStreamNonBlocking));
+    CUDA_RETURN_IF_ERROR(cudaEventCreateWithFlags(&compute_ready_event_, cudaEventDisableTiming));
+    CUDA_RETURN_IF_ERROR(cudaEventCreateWithFlags(&communication_done_event_, cudaEventDisableTiming));
+  }
+
+  CUDA_RETURN_IF_ERROR(cudaEventRecord(compute_ready_event_, compute_stream));
+  CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(communication_stream_, compute_ready_event_, 0));
+  has_overlapped_work_ = true;
+  communication_stream = communication_stream_;
+  return Status::OK();
+}
+
+Status NcclContext::WaitForOverlappedWork(cudaStream_t compute_stream) {
+  if (!has_overlapped_work_) {
+    return Status::OK();
+  }
+
+  // the reductions on the communication stream run in order, so waiting for the last one waits for all of them
+  CUDA_RETURN_IF_ERROR(cudaEventRecord(communication_done_event_, communication_stream_));
+  CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(compute_stream, communication_done_event_, 0));
+  has_overlapped_work_ = false;
+  return Status::OK();
+}
+
 NcclContext::~NcclContext() {
+  if (communication_stream_ != nullptr) {
+    cudaStreamDestroy(communication_stream_);
+    cudaEventDestroy(compute_ready_event_);
+    cudaEventDestroy(communication_done_event_);
+  }
+
   if (data_group_comm_ != nullptr) {
     ncclCommDestroy(data_group_comm_);
   }
@@ -154,6 +186,9 @@ NcclKernel::NcclKernel(const OpKernelInfo& info) : CudaKernel(info) {
   int64_t group_type;
   info.GetAttrOrDefault("group_type", &group_type, static_cast<int64_t>(0));
   group_type_ = static_cast<training::WorkerGroupType>(group_type);
+  int64_t overlap_with_compute;
+  info.GetAttrOrDefault("overlap_with_compute", &overlap_with_compute, static_cast<int64_t>(0));
+  overlap_with_compute_ = overlap_with_compute != 0;
 }
 
 }  // namespace cuda
@@ -31,6 +31,13 @@ class NcclContext final {
     return training::DistributedRunContext::GroupSize(group_type);
   }
 
+  // Enqueues a reduction on the communication stream, after the work enqueued so far on compute_stream,
+  // so that it overlaps the work enqueued on compute_stream afterwards.
+  Status BeginOverlappedWork(cudaStream_t compute_stream, cudaStream_t& communication_stream);
+
+  // Makes compute_stream wait for the reductions enqueued on the communication stream.
+  Status WaitForOverlappedWork(cudaStream_t compute_stream);
+
  private:
   ncclComm_t global_group_comm_;
   ncclComm_t data_group_comm_;
@@ -38,6 +45,11 @@ class NcclContext final {
   ncclComm_t cross_node_comm_;
   ncclComm_t horizontal_group_comm_;
 
+  // the non-blocking stream and the events of the overlapped reductions, created on first use
+  cudaStream_t communication_stream_ = nullptr;
+  cudaEvent_t compute_ready_event_ = nullptr;
+  cudaEvent_t communication_done_event_ = nullptr;
+  bool has_overlapped_work_ = false;
 };
 
 // -----------------------------------------------------------------------
@@ -50,6 +62,7 @@ class NcclKernel : public CudaKernel {
  protected:
   NcclContext* nccl_ = nullptr;
   training::WorkerGroupType group_type_;
+  bool overlap_with_compute_ = false;
 };
 
 ncclDataType_t GetNcclDataType(onnxruntime::MLDataType type);
@@ -11,6 +11,13 @@ NcclAllReduce::NcclAllReduce(const OpKernelInfo& info) : NcclKernel(info) {
 
 Status NcclAllReduce::ComputeInternal(OpKernelContext* context) const {
   cudaStream_t stream = nullptr;  // Default stream
+  if (overlap_with_compute_) {
+    // run on the communication stream, after the kernels that produced the inputs
+    ORT_RETURN_IF_ERROR(nccl_->BeginOverlappedWork(nullptr, stream));
+  } else {
+    ORT_RETURN_IF_ERROR(nccl_->WaitForOverlappedWork(stream));
+  }
+
   ncclComm_t comm = nccl_->Comm(group_type_);
 
   const void* input_data = context->Input<Tensor>(0)->DataRaw();
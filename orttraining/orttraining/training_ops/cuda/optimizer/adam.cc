@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <map>
+#include <tuple>
 #include "core/providers/cuda/cuda_allocator.h"
 #include "core/providers/cuda/reduction/reduction_functions.h"
 #include "core/providers/cuda/math/binary_elementwise_ops.h"
@@ -59,6 +61,132 @@ REGISTER_ADAM_KERNEL_TYPED(float, int64_t, float, BFloat16, BFloat16, BFloat16,
 REGISTER_ADAM_KERNEL_TYPED(float, int64_t, float, BFloat16, BFloat16, float, BFloat16)
 #endif
 
+std::vector<std::pair<int, int>> GenerateMultiTensorAdamAliasMapping() {
+  // Starting index of extra inputs.
+  constexpr int input_index_bias = 5;
+  // Starting index of extra outputs.
+  constexpr int output_index_bias = 1;
+  // Count of extra I/O groups. One group corresponds to a weight update.
+  constexpr int group_count = 1024;
+  // length of [w, g, m1, m2, w_mixed_precision].
+  constexpr int input_stride = 5;
+  // length of [w_new, g_new, m1_new, m2_new, w_mixed_precision_new].
+  constexpr int output_stride = 5;
+
+  std::vector<std::pair<int, int>> alias_pairs{};
+  for (int i = 0; i < group_count; ++i) {
+    const int input = input_index_bias + i * input_stride;
+    const int output = output_index_bias + i * output_stride;
+    for (int j = 0; j < input_stride; ++j) {
+      alias_pairs.emplace_back(std::make_pair(input + j, output + j));
+    }
+  }
+
+  // update_count are updated in place.
+  alias_pairs.emplace_back(std::make_pair(4, 0));
+
+  return alias_pairs;
+}
+
+#define REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(T1, T2, T3, T4, T_GRAD_NORM, T_MIXED_PRECISION_FP)     \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                                       \
+      MultiTensorAdamOptimizer,                                                                        \
+      kMSDomain,                                                                                       \
+      1,                                                                                               \
+      T1##_##T2##_##T3##_##T4##_##T_GRAD_NORM##_##T_MIXED_PRECISION_FP,                                \
+      kCudaExecutionProvider,                                                                          \
+      KernelDefBuilder()                                                                               \
+          .Alias(GenerateMultiTensorAdamAliasMapping())                                                \
+          .InputMemoryType<OrtMemTypeCPUInput>(0)   /* Keep do_update in CPU */                        \
+          .InputMemoryType<OrtMemTypeCPUInput>(4)   /* Keep update_count in CPU */                     \
+          .OutputMemoryType<OrtMemTypeCPUOutput>(0) /* Keep update_count in CPU */                     \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<T1>())                                     \
+          .TypeConstraint("T2", DataTypeImpl::GetTensorType<T2>())                                     \
+          .TypeConstraint("T3", DataTypeImpl::GetTensorType<T3>())                                     \
+          .TypeConstraint("T4", DataTypeImpl::GetTensorType<T4>())                                     \
+          .TypeConstraint("T_MIXED_PRECISION_FP", DataTypeImpl::GetTensorType<T_MIXED_PRECISION_FP>()) \
+          .TypeConstraint("T_GRAD_NORM", DataTypeImpl::GetTensorType<T_GRAD_NORM>()),                  \
+      MultiTensorAdamOptimizer<T1, T2, T3, T4, T_GRAD_NORM, T_MIXED_PRECISION_FP>);
+
+REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(float, float, float, float, float, MLFloat16)
+REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(MLFloat16, float, float, MLFloat16, float, MLFloat16)
+REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(float, float, float, MLFloat16, float, MLFloat16)
+REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(float, float, MLFloat16, float, MLFloat16, MLFloat16)
+REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(float, float, MLFloat16, float, float, MLFloat16)
+REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(MLFloat16, float, MLFloat16, MLFloat16, MLFloat16, MLFloat16)
+REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(MLFloat16, float, MLFloat16, MLFloat16, float, MLFloat16)
+REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(float, float, MLFloat16, MLFloat16, MLFloat16, MLFloat16)
+REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(float, float, MLFloat16, MLFloat16, float, MLFloat16)
+
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11000
+REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(float, float, float, float, float, BFloat16)
+REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(BFloat16, float, float, BFloat16, float, BFloat16)
+REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(float, float, float, BFloat16, float, BFloat16)
+REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(float, float, BFloat16, float, BFloat16, BFloat16)
+REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(float, float, BFloat16, float, float, BFloat16)
+REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(BFloat16, float, BFloat16, BFloat16, BFloat16, BFloat16)
+REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(BFloat16, float, BFloat16, BFloat16, float, BFloat16)
+REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(float, float, BFloat16, BFloat16, BFloat16, BFloat16)
+REGISTER_MULTI_TENSOR_ADAM_KERNEL_TYPED(float, float, BFloat16, BFloat16, float, BFloat16)
+#endif
+
+// The indexes of the weights and the moments of the groups starting at index_bias, which
+// OffloadedMultiTensorAdamOptimizer keeps in pinned memory. The kernel accesses the pinned memory directly
+// through the unified address space, so the optimizer states are streamed over PCIe by the update itself.
+std::vector<int> GenerateOffloadedMultiTensorAdamHostIndexes(int index_bias) {
+  // Count of extra I/O groups. One group corresponds to a weight update.
+  constexpr int group_count = 1024;
+  // length of [w, g, m1, m2, w_mixed_precision], and of the outputs.
+  constexpr int stride = 5;
+
+  std::vector<int> indexes{};
+  for (int i = 0; i < group_count; ++i) {
+    const int start = index_bias + i * stride;
+    indexes.push_back(start);      // w
+    indexes.push_back(start + 2);  // m1
+    indexes.push_back(start + 3);  // m2
+  }
+
+  return indexes;
+}
+
+#define REGISTER_OFFLOADED_MULTI_TENSOR_ADAM_KERNEL_TYPED(T1, T2, T3, T4, T_GRAD_NORM, T_MIXED_PRECISION_FP)         \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                                                     \
+      OffloadedMultiTensorAdamOptimizer,                                                                             \
+      kMSDomain,                                                                                                     \
+      1,                                                                                                             \
+      T1##_##T2##_##T3##_##T4##_##T_GRAD_NORM##_##T_MIXED_PRECISION_FP,                                              \
+      kCudaExecutionProvider,                                                                                        \
+      KernelDefBuilder()                                                                                             \
+          .Alias(GenerateMultiTensorAdamAliasMapping())                                                              \
+          .InputMemoryType<OrtMemTypeCPUInput>(0) /* Keep do_update in CPU */                                        \
+          .InputMemoryType<OrtMemTypeCPUInput>(4) /* Keep update_count in CPU */                                     \
+          .InputMemoryType<OrtMemTypeCPUOutput>(GenerateOffloadedMultiTensorAdamHostIndexes(5)) /* Pinned states */  \
+          .OutputMemoryType<OrtMemTypeCPUOutput>(0) /* Keep update_count in CPU */                                   \
+          .OutputMemoryType<OrtMemTypeCPUOutput>(GenerateOffloadedMultiTensorAdamHostIndexes(1)) /* Pinned states */ \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<T1>())                                                   \
+          .TypeConstraint("T2", DataTypeImpl::GetTensorType<T2>())                                                   \
+          .TypeConstraint("T3", DataTypeImpl::GetTensorType<T3>())                                                   \
+          .TypeConstraint("T4", DataTypeImpl::GetTensorType<T4>())                                                   \
+          .TypeConstraint("T_MIXED_PRECISION_FP", DataTypeImpl::GetTensorType<T_MIXED_PRECISION_FP>())               \
+          .TypeConstraint("T_GRAD_NORM", DataTypeImpl::GetTensorType<T_GRAD_NORM>()),                                \
+      MultiTensorAdamOptimizer<T1, T2, T3, T4, T_GRAD_NORM, T_MIXED_PRECISION_FP>);
+
+// The offloaded weights are only read by the optimizer, which requires mixed precision weights and gradients.
+REGISTER_OFFLOADED_MULTI_TENSOR_ADAM_KERNEL_TYPED(float, float, MLFloat16, float, MLFloat16, MLFloat16)
+REGISTER_OFFLOADED_MULTI_TENSOR_ADAM_KERNEL_TYPED(float, float, MLFloat16, float, float, MLFloat16)
+
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11000
+REGISTER_OFFLOADED_MULTI_TENSOR_ADAM_KERNEL_TYPED(float, float, BFloat16, float, BFloat16, BFloat16)
+REGISTER_OFFLOADED_MULTI_TENSOR_ADAM_KERNEL_TYPED(float, float, BFloat16, float, float, BFloat16)
+#endif
+
+// A kernel accesses a tensor in device memory, or in pinned memory mapped into the unified address space.
+static bool IsDeviceAccessible(const Tensor& tensor) {
+  const OrtDevice& device = tensor.Location().device;
+  return device.Type() == OrtDevice::GPU || device.MemType() == OrtDevice::MemType::CUDA_PINNED;
+}
+
 template <typename T1, typename T2, typename T3, typename T4, typename T_GRAD, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
 Status AdamOptimizer<T1, T2, T3, T4, T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP>::ComputeInternal(OpKernelContext* ctx) const {
   typedef typename ToCudaType<T1>::MappedType CudaT1;
@@ -163,5 +291,149 @@ Status AdamOptimizer<T1, T2, T3, T4, T_GRAD, T_GRAD_NORM, T_MIXED_PRECISION_FP>:
   return Status::OK();
 }
 
+template <typename T1, typename T2, typename T3, typename T4, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
+Status MultiTensorAdamOptimizer<T1, T2, T3, T4, T_GRAD_NORM, T_MIXED_PRECISION_FP>::ComputeInternal(OpKernelContext* ctx) const {
+  typedef typename ToCudaType<T1>::MappedType CudaT1;
+  typedef typename ToCudaType<T2>::MappedType CudaT2;
+  typedef typename ToCudaType<T3>::MappedType CudaT3;
+  typedef typename ToCudaType<T4>::MappedType CudaT4;
+  typedef typename ToCudaType<T_GRAD_NORM>::MappedType CudaT_GRAD_NORM;
+  typedef typename ToCudaType<T_MIXED_PRECISION_FP>::MappedType CudaT_MIXED_PRECISION_FP;
+
+  constexpr int non_grouped_input_count = 5;
+  constexpr int input_group_size = 5;
+  constexpr int output_group_size = 5;
+  constexpr int non_grouped_output_count = 1;
+  const int grouped_input_tensor_count = ctx->InputCount() - non_grouped_input_count;
+  const int grouped_output_tensor_count = ctx->OutputCount() - non_grouped_output_count;
+
+  ORT_ENFORCE(
+      grouped_input_tensor_count > 0 && grouped_input_tensor_count % input_group_size == 0,
+      "Input count must be ", non_grouped_input_count, " + ", input_group_size,
+      " x (number of weights to optimize).");
+  ORT_ENFORCE(
+      grouped_output_tensor_count / output_group_size == grouped_input_tensor_count / input_group_size,
+      "Input and output tensor counts are not aligned. Please check MultiTensorAdamOptimizer's input and output lists.");
+
+  const int group_count = grouped_input_tensor_count / input_group_size;
+  ORT_ENFORCE(alpha_.size() >= static_cast<size_t>(group_count));
+  ORT_ENFORCE(beta_.size() >= static_cast<size_t>(group_count));
+  ORT_ENFORCE(lambda_.size() >= static_cast<size_t>(group_count));
+  ORT_ENFORCE(epsilon_.size() >= static_cast<size_t>(group_count));
+  ORT_ENFORCE(max_norm_clip_.size() >= static_cast<size_t>(group_count));
+
+  // If gradient norm is not finite, we copy inputs to outputs directly.
+  const Tensor* update_signal_tensor = ctx->Input<Tensor>(0);
+  if (update_signal_tensor != nullptr && !*update_signal_tensor->template Data<bool>()) {
+    return copy_inputs_to_outputs<T2, T3, T4, T_MIXED_PRECISION_FP>(
+        ctx,
+        non_grouped_input_count,
+        non_grouped_output_count,
+        group_count,
+        input_group_size,
+        output_group_size);
+  }
+
+  const Tensor* loss_scale_tensor = ctx->Input<Tensor>(1);
+  const CudaT2* loss_scale_data = loss_scale_tensor != nullptr ? reinterpret_cast<const CudaT2*>(loss_scale_tensor->template Data<T2>()) : nullptr;
+
+  const Tensor* g_norm_tensor = ctx->Input<Tensor>(2);
+  const CudaT_GRAD_NORM* g_norm_data = g_norm_tensor != nullptr ? reinterpret_cast<const CudaT_GRAD_NORM*>(g_norm_tensor->template Data<T_GRAD_NORM>()) : nullptr;
+
+  const CudaT1* eta_data = reinterpret_cast<const CudaT1*>(ctx->Input<Tensor>(3)->template Data<T1>());
+
+  // Adam's bias correction needs the update count, which starts at 1.
+  const Tensor* step_tensor = ctx->Input<Tensor>(4);
+  ORT_ENFORCE(step_tensor != nullptr, "MultiTensorAdamOptimizer requires the update count.");
+  const int64_t step = *step_tensor->template Data<int64_t>();
+
+  // Bucketize tensor groups by the associated optimizer configuration,
+  // each bucket is updated by a single launch.
+  typedef std::tuple<float, float, float, float, float> AdamConfig;
+  std::map<AdamConfig, std::vector<std::vector<void*>>> buckets;
+  std::map<AdamConfig, std::vector<int>> tensor_sizes_in_buckets;
+  for (int group_index = 0; group_index < group_count; ++group_index) {
+    const int input_start_index = non_grouped_input_count + group_index * input_group_size;
+    const Tensor* w = ctx->Input<Tensor>(input_start_index);
+    const Tensor* g = ctx->Input<Tensor>(input_start_index + 1);
+    const Tensor* m1 = ctx->Input<Tensor>(input_start_index + 2);
+    const Tensor* m2 = ctx->Input<Tensor>(input_start_index + 3);
+    const Tensor* w_mixed_precision = ctx->Input<Tensor>(input_start_index + 4);
+
+    const int output_start_index = non_grouped_output_count + group_index * output_group_size;
+    Tensor* w_new = ctx->Output(output_start_index, w->Shape());
+    Tensor* g_new = ctx->Output(output_start_index + 1, g->Shape());
+    Tensor* m1_new = ctx->Output(output_start_index + 2, m1->Shape());
+    Tensor* m2_new = ctx->Output(output_start_index + 3, m2->Shape());
+    Tensor* w_mixed_precision_new = w_mixed_precision != nullptr ? ctx->Output(output_start_index + 4, w_mixed_precision->Shape()) : nullptr;
+
+    // TODO: temporary hack until View is improved (it doesn't work with Alias)
+    if (w_new != nullptr)
+      w_new->SetByteOffset(w->ByteOffset());
+    if (g_new != nullptr)
+      g_new->SetByteOffset(g->ByteOffset());
+    if (w_mixed_precision_new != nullptr)
+      w_mixed_precision_new->SetByteOffset(w_mixed_precision->ByteOffset());
+
+    check_inputs_and_outputs(w, g, m1, m2, w_mixed_precision, w_new, g_new, m1_new, m2_new, w_mixed_precision_new);
+    ORT_RETURN_IF_NOT(IsDeviceAccessible(*w) && IsDeviceAccessible(*m1) && IsDeviceAccessible(*m2),
+                      "The weights and moments of ", Node().OpType(), " must be in device or pinned memory.");
+
+    // The kernel updates the moments in-place, so they are moved to the outputs first when not aliased.
+    ORT_RETURN_IF_ERROR(CopyIfNotSameBuffer<T4>(*m1, *m1_new));
+    ORT_RETURN_IF_ERROR(CopyIfNotSameBuffer<T4>(*m2, *m2_new));
+
+    // The index in CUDA system is 32-bit integer.
+    ORT_ENFORCE(w->Shape().Size() < static_cast<int64_t>(std::numeric_limits<int>::max()));
+
+    std::vector<void*> ptrs(7);
+    ptrs[0] = const_cast<T2*>(w->template Data<T2>());
+    ptrs[1] = const_cast<T3*>(g->template Data<T3>());
+    ptrs[2] = m1_new->template MutableData<T4>();
+    ptrs[3] = m2_new->template MutableData<T4>();
+    ptrs[4] = w_new != nullptr ? w_new->template MutableData<T2>() : nullptr;
+    ptrs[5] = g_new != nullptr ? g_new->template MutableData<T3>() : nullptr;
+    ptrs[6] = w_mixed_precision_new != nullptr ? w_mixed_precision_new->template MutableData<T_MIXED_PRECISION_FP>() : nullptr;
+
+    const auto key = std::make_tuple(alpha_[group_index], beta_[group_index], lambda_[group_index],
+                                     epsilon_[group_index], max_norm_clip_[group_index]);
+    buckets[key].push_back(ptrs);
+    tensor_sizes_in_buckets[key].push_back(static_cast<int>(w->Shape().Size()));
+  }
+
+  typedef AdamMultiTensorFunctor<CudaT1, CudaT2, CudaT3, CudaT4, CudaT_GRAD_NORM, CudaT_MIXED_PRECISION_FP> AdamFunctor;
+  AdamFunctor adam_functor;
+  for (auto& pair : buckets) {
+    float alpha = 0.f, beta = 0.f, lambda = 0.f, epsilon = 0.f, max_norm = 0.f;
+    std::tie(alpha, beta, lambda, epsilon, max_norm) = pair.first;
+
+    const float alpha_correction =
+        do_bias_correction_ ? onnxruntime::contrib::compute_bias_correction_coefficient(alpha, step) : 1.f;
+    const float beta_correction =
+        do_bias_correction_ ? onnxruntime::contrib::compute_bias_correction_coefficient(beta, step) : 1.f;
+
+    launch_multi_tensor_functor<7, AdamFunctor>(
+        2048 * 32,
+        tensor_sizes_in_buckets[pair.first],
+        pair.second,
+        adam_functor,
+        eta_data, loss_scale_data, g_norm_data,
+        ToCudaType<T4>::FromFloat(alpha),
+        ToCudaType<T4>::FromFloat(beta),
+        ToCudaType<T4>::FromFloat(lambda),
+        ToCudaType<T4>::FromFloat(epsilon),
+        ToCudaType<T4>::FromFloat(max_norm),
+        ToCudaType<T4>::FromFloat(alpha_correction),
+        ToCudaType<T4>::FromFloat(beta_correction),
+        weight_decay_mode_);
+  }
+
+  Tensor* step_tensor_new = ctx->Output(0, step_tensor->Shape());
+  ORT_ENFORCE(step_tensor_new != nullptr, "Step tensor (input) and updated step tensor (output) must be specified together.");
+  *step_tensor_new->template MutableData<int64_t>() = step + 1;
+
+  return Status::OK();
+}
+
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -9,6 +9,82 @@
 
 namespace onnxruntime {
 namespace cuda {
+// Mode 0 of the update of one element: returns the weight delta and computes the new moments.
+template <typename T1, typename T3, typename T4>
+__device__ __forceinline__ T4 _AdamUpdateRule_mode0(
+    const T1 eta,
+    const T3 weight,
+    const T4 g,
+    const T4 moment_1,
+    const T4 moment_2,
+    const T4 alpha,
+    const T4 beta,
+    const T4 lambda,
+    const T4 epsilon,
+    const T4 alpha_correction,
+    const T4 beta_correction,
+    T4& moment_1_out,
+    T4& moment_2_out) {
+  // A shared constant.
+  const T4 one = T4(1.0f);
+
+  // Compute exponentially-averaged historical gradient.
+  const T4 m1o = alpha * moment_1 + (one - alpha) * g;
+  const T4 m1o_corrected = m1o / alpha_correction;
+
+  // Compute exponentially-averaged historical squared gradient.
+  const T4 m2o = beta * moment_2 + (one - beta) * g * g;
+  const T4 m2o_corrected = m2o / beta_correction;
+
+  // Compute weight update.
+  const T4 denom = _Sqrt(m2o_corrected) + epsilon;
+  const T4 update = (m1o_corrected / denom) + (lambda * T4(weight));
+
+  moment_1_out = m1o;
+  moment_2_out = m2o;
+  return -T4(eta) * update;
+}
+
+// Mode 1 of the update of one element: returns the weight delta and computes the new moments.
+template <typename T1, typename T3, typename T4>
+__device__ __forceinline__ T4 _AdamUpdateRule_mode1(
+    const T1 eta,
+    const T3 weight,
+    const T4 g,
+    const T4 moment_1,
+    const T4 moment_2,
+    const T4 alpha,
+    const T4 beta,
+    const T4 lambda,
+    const T4 epsilon,
+    const T4 alpha_correction,
+    const T4 beta_correction,
+    T4& moment_1_out,
+    T4& moment_2_out) {
+  // A shared constant.
+  const T4 one = T4(1.0f);
+
+  // Compute exponentially-averaged historical gradient.
+  const T4 m1o = alpha * moment_1 + (one - alpha) * g;
+
+  // Compute exponentially-averaged historical squared gradient.
+  const T4 m2o = beta * moment_2 + (one - beta) * g * g;
+
+  const T4 denom = _Sqrt(m2o) + epsilon;
+
+  // Apply bias correction terms on learning rate
+  const T4 step_size = T4(eta) * _Sqrt(beta_correction) / alpha_correction;
+
+  // Huggingface updates weights in the following logic:
+  // param' = param - step_size * m1o / denom
+  // param_out = param' - original_lr * lambda * param'
+  // then param_out = param - step_size * m1o / denom - original_lr * lambda * (param - step_size * m1o / denom)
+  // so delta = -step_size * m1o / denom - original_lr * lambda * (param - step_size * m1o / denom)
+  moment_1_out = m1o;
+  moment_2_out = m2o;
+  return -step_size * m1o / denom - T4(eta) * lambda * (T4(weight) - step_size * m1o / denom);
+}
+
 template <typename T1, typename T3, typename T4, typename T_GRAD, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
 __global__ void _AdamOptimizer_mode0(
     const T1* eta,
@@ -36,22 +112,10 @@ __global__ void _AdamOptimizer_mode0(
 
   // Gradient scaling/clipping.
   const T4 g = T4(grads[id]) / actual_scale;
-  // A shared constant.
-  const T4 one = T4(1.0f);
-
-  // Compute exponentially-averaged historical gradient.
-  const T4 m1o = alpha * moment_1[id] + (one - alpha) * g;
-  const T4 m1o_corrected = m1o / alpha_correction;
-
-  // Compute exponentially-averaged historical squared gradient.
-  const T4 m2o = beta * moment_2[id] + (one - beta) * g * g;
-  const T4 m2o_corrected = m2o / beta_correction;
 
-  // Compute weight update.
-  const T4 denom = _Sqrt(m2o_corrected) + epsilon;
-  const T4 update = (m1o_corrected / denom) + (lambda * T4(weights[id]));
-
-  const T4 delta = -T4(*eta) * update;
+  const T4 delta = _AdamUpdateRule_mode0(
+      *eta, weights[id], g, moment_1[id], moment_2[id], alpha, beta, lambda, epsilon,
+      alpha_correction, beta_correction, moment_1_out[id], moment_2_out[id]);
 
   // Compute the new gradient.
   if (grads_out) {
@@ -66,9 +130,6 @@ __global__ void _AdamOptimizer_mode0(
       mixed_precision_weights_out[id] = static_cast<T_MIXED_PRECISION_FP>(weights_out[id]);
     }
   }
-
-  moment_1_out[id] = m1o;
-  moment_2_out[id] = m2o;
 }
 
 template <typename T1, typename T3, typename T4, typename T_GRAD, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
@@ -98,32 +159,16 @@ __global__ void _AdamOptimizer_mode1(
 
   // Gradient scaling/clipping.
   const T4 g = T4(grads[id]) / actual_scale;
-  // A shared constant.
-  const T4 one = T4(1.0f);
-
-  // Compute exponentially-averaged historical gradient.
-  const T4 m1o = alpha * moment_1[id] + (one - alpha) * g;
-
-  // Compute exponentially-averaged historical squared gradient.
-  const T4 m2o = beta * moment_2[id] + (one - beta) * g * g;
-
-  const T4 denom = _Sqrt(m2o) + epsilon;
 
-  // Apply bias correction terms on learning rate
-  const T4 step_size = T4(*eta) * _Sqrt(beta_correction) / alpha_correction;
-
-  // Huggingface updates weights in the following logic:
-  // param' = param - step_size * m1o / denom
-  // param_out = param' - original_lr * lambda * param'
-  // then param_out = param - step_size * m1o / denom - original_lr * lambda * (param - step_size * m1o / denom)
-  // so delta = -step_size * m1o / denom - original_lr * lambda * (param - step_size * m1o / denom)
-  const T4 delta = -step_size * m1o / denom - T4(*eta) * lambda * (T4(weights[id]) - step_size * m1o / denom);
+  const T4 delta = _AdamUpdateRule_mode1(
+      *eta, weights[id], g, moment_1[id], moment_2[id], alpha, beta, lambda, epsilon,
+      alpha_correction, beta_correction, moment_1_out[id], moment_2_out[id]);
 
   // Compute the new gradient.
   if (grads_out) {
     grads_out[id] = T_GRAD(delta);
   }
-  
+
   // Compute the new weight.
   if (weights_out) {
     weights_out[id] = weights[id] + T3(delta);
@@ -132,9 +177,6 @@ __global__ void _AdamOptimizer_mode1(
       mixed_precision_weights_out[id] = static_cast<T_MIXED_PRECISION_FP>(weights_out[id]);
     }
   }
-
-  moment_1_out[id] = m1o;
-  moment_2_out[id] = m2o;
 }
 
 template <typename T1, typename T2, typename T3, typename T4, typename T_GRAD, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
@@ -274,5 +316,125 @@ SPECIALIZED_AdamOptimizerImpl(float, int64_t, float, nv_bfloat16, nv_bfloat16, n
 SPECIALIZED_AdamOptimizerImpl(float, int64_t, float, nv_bfloat16, nv_bfloat16, float, nv_bfloat16)
 #endif
 
+template <typename T1, typename T2, typename T3, typename T4, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP, int WeightDecayMode>
+__global__ void _AdamMultiTensorImpl(
+    ChunkGroup<7> chunk_group,
+    const T1* eta,
+    const T2* loss_scale,
+    const T_GRAD_NORM* grad_norm,
+    const T4 alpha,
+    const T4 beta,
+    const T4 lambda,
+    const T4 epsilon,
+    const T4 max_norm,
+    const T4 alpha_correction,
+    const T4 beta_correction) {
+  const int group_index = chunk_group.block_index_to_tensor_group_index[blockIdx.x];
+  const int tensor_size = chunk_group.tensor_sizes[group_index];
+  const int chunk_size = chunk_group.chunk_size;
+  const int chunk_start = chunk_group.block_index_to_chunk_start_index[blockIdx.x];
+
+  const T2* w = reinterpret_cast<const T2*>(chunk_group.tensor_ptrs[0][group_index]) + chunk_start;
+  const T3* g = reinterpret_cast<const T3*>(chunk_group.tensor_ptrs[1][group_index]) + chunk_start;
+  T4* m1 = reinterpret_cast<T4*>(chunk_group.tensor_ptrs[2][group_index]) + chunk_start;
+  T4* m2 = reinterpret_cast<T4*>(chunk_group.tensor_ptrs[3][group_index]) + chunk_start;
+  T2* w_new = chunk_group.tensor_ptrs[4][group_index] != nullptr ? reinterpret_cast<T2*>(chunk_group.tensor_ptrs[4][group_index]) + chunk_start : nullptr;
+  T3* g_new = chunk_group.tensor_ptrs[5][group_index] != nullptr ? reinterpret_cast<T3*>(chunk_group.tensor_ptrs[5][group_index]) + chunk_start : nullptr;
+  T_MIXED_PRECISION_FP* w_mixed_precision_new = chunk_group.tensor_ptrs[6][group_index] != nullptr ? reinterpret_cast<T_MIXED_PRECISION_FP*>(chunk_group.tensor_ptrs[6][group_index]) + chunk_start : nullptr;
+
+  const T4 actual_scale = _ComputeGradScale<T2, T_GRAD_NORM, T4>(loss_scale, grad_norm, max_norm);
+
+  for (int i = threadIdx.x; i < chunk_size && i + chunk_start < tensor_size; i += blockDim.x) {
+    // Gradient scaling/clipping.
+    const T4 g_scaled = T4(g[i]) / actual_scale;
+    const T2 weight = w[i];
+    const T4 delta = WeightDecayMode == 0
+                         ? _AdamUpdateRule_mode0(*eta, weight, g_scaled, m1[i], m2[i], alpha, beta, lambda, epsilon,
+                                                 alpha_correction, beta_correction, m1[i], m2[i])
+                         : _AdamUpdateRule_mode1(*eta, weight, g_scaled, m1[i], m2[i], alpha, beta, lambda, epsilon,
+                                                 alpha_correction, beta_correction, m1[i], m2[i]);
+
+    if (g_new != nullptr) {
+      g_new[i] = T3(delta);
+    }
+
+    if (w_new != nullptr) {
+      w_new[i] = weight + T2(delta);
+
+      if (w_mixed_precision_new != nullptr) {
+        w_mixed_precision_new[i] = static_cast<T_MIXED_PRECISION_FP>(w_new[i]);
+      }
+    }
+  }
+}
+
+template <typename T1, typename T2, typename T3, typename T4, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
+void AdamMultiTensorFunctor<T1, T2, T3, T4, T_GRAD_NORM, T_MIXED_PRECISION_FP>::operator()(
+    ChunkGroup<7> chunk_group,
+    const T1* eta,
+    const T2* loss_scale,
+    const T_GRAD_NORM* grad_norm,
+    const T4 alpha,
+    const T4 beta,
+    const T4 lambda,
+    const T4 epsilon,
+    const T4 max_norm,
+    const T4 alpha_correction,
+    const T4 beta_correction,
+    const int64_t weight_decay_mode) {
+  const int thread_count = ChunkGroup<7>::thread_count_per_block;
+  const int block_count = chunk_group.chunk_count;
+
+  if (weight_decay_mode == 0) {
+    _AdamMultiTensorImpl<T1, T2, T3, T4, T_GRAD_NORM, T_MIXED_PRECISION_FP, 0><<<block_count, thread_count, 0>>>(
+        chunk_group, eta, loss_scale, grad_norm, alpha, beta, lambda, epsilon, max_norm,
+        alpha_correction, beta_correction);
+  } else if (weight_decay_mode == 1) {
+    _AdamMultiTensorImpl<T1, T2, T3, T4, T_GRAD_NORM, T_MIXED_PRECISION_FP, 1><<<block_count, thread_count, 0>>>(
+        chunk_group, eta, loss_scale, grad_norm, alpha, beta, lambda, epsilon, max_norm,
+        alpha_correction, beta_correction);
+  } else {
+    // Shouldn't reach here
+    ORT_THROW("Unsupported Adamw optimizer mode.");
+  }
+}
+
+#define INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(T1, T2, T3, T4, T_GRAD_NORM, T_MIXED_PRECISION_FP)                   \
+  template void AdamMultiTensorFunctor<T1, T2, T3, T4, T_GRAD_NORM, T_MIXED_PRECISION_FP>::operator()(            \
+      ChunkGroup<7> chunk_group,                                                                                  \
+      const T1* eta,                                                                                              \
+      const T2* loss_scale,                                                                                       \
+      const T_GRAD_NORM* grad_norm,                                                                               \
+      const T4 alpha,                                                                                             \
+      const T4 beta,                                                                                              \
+      const T4 lambda,                                                                                            \
+      const T4 epsilon,                                                                                           \
+      const T4 max_norm,                                                                                          \
+      const T4 alpha_correction,                                                                                  \
+      const T4 beta_correction,                                                                                   \
+      const int64_t weight_decay_mode);
+
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, float, float, float, half)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(half, float, float, half, float, half)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, float, half, float, half)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, half, float, half, half)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, half, float, float, half)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(half, float, half, half, half, half)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(half, float, half, half, float, half)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, half, half, half, half)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, half, half, float, half)
+
+#if CUDA_VERSION >= 11000 && (__CUDA_ARCH__ >= 800 || !defined(__CUDA_ARCH__))
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, float, float, float, nv_bfloat16)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(nv_bfloat16, float, float, nv_bfloat16, float, nv_bfloat16)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, float, nv_bfloat16, float, nv_bfloat16)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, nv_bfloat16, float, nv_bfloat16, nv_bfloat16)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, nv_bfloat16, float, float, nv_bfloat16)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(nv_bfloat16, float, nv_bfloat16, nv_bfloat16, nv_bfloat16, nv_bfloat16)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(nv_bfloat16, float, nv_bfloat16, nv_bfloat16, float, nv_bfloat16)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, nv_bfloat16, nv_bfloat16, nv_bfloat16, nv_bfloat16)
+INSTANTIATE_ADAM_MULTI_TENSOR_FUNCTOR(float, float, nv_bfloat16, nv_bfloat16, float, nv_bfloat16)
+#endif
+
 }  // namespace cuda
 }  // namespace onnxruntime
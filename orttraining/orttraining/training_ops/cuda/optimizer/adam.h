@@ -4,6 +4,7 @@
 #pragma once
 #include "core/common/common.h"
 #include "core/providers/cuda/cuda_kernel.h"
+#include "core/providers/cuda/multi_tensor/common.cuh"
 
 namespace onnxruntime {
 namespace cuda {
@@ -62,5 +63,64 @@ class AdamOptimizer final : public CudaKernel {
   int64_t weight_decay_mode_;
 };
 
+// Updates the tensors of many weights per launch. The tensor pointers of the i-th weight of the chunk group are
+//  w: chunk_group.tensor_ptrs[0][i]
+//  g: chunk_group.tensor_ptrs[1][i]
+//  m1 (updated in-place): chunk_group.tensor_ptrs[2][i]
+//  m2 (updated in-place): chunk_group.tensor_ptrs[3][i]
+//  w_new (optional): chunk_group.tensor_ptrs[4][i]
+//  g_new (optional): chunk_group.tensor_ptrs[5][i]
+//  w_mixed_precision_new (optional): chunk_group.tensor_ptrs[6][i]
+template <typename T1, typename T2, typename T3, typename T4, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
+struct AdamMultiTensorFunctor {
+  void operator()(
+      ChunkGroup<7> chunk_group,
+      const T1* eta,
+      const T2* loss_scale,
+      const T_GRAD_NORM* grad_norm,
+      const T4 alpha,
+      const T4 beta,
+      const T4 lambda,
+      const T4 epsilon,
+      const T4 max_norm,
+      const T4 alpha_correction,
+      const T4 beta_correction,
+      const int64_t weight_decay_mode);
+};
+
+// The AdamOptimizer of all the weights in a single node, see MultiTensorAdamOptimizer's schema.
+// T1: learning rate, T2: weights, T3: gradients, T4: moments.
+template <typename T1, typename T2, typename T3, typename T4, typename T_GRAD_NORM, typename T_MIXED_PRECISION_FP>
+class MultiTensorAdamOptimizer final : public CudaKernel {
+ public:
+  MultiTensorAdamOptimizer(const OpKernelInfo& info) : CudaKernel(info) {
+    alpha_ = info.GetAttrsOrDefault("alpha", std::vector<float>(1024, 0.9f));
+    beta_ = info.GetAttrsOrDefault("beta", std::vector<float>(1024, 0.999f));
+    lambda_ = info.GetAttrsOrDefault("lambda", std::vector<float>(1024, 0.0f));
+    epsilon_ = info.GetAttrsOrDefault("epsilon", std::vector<float>(1024, 1e-8f));
+    max_norm_clip_ = info.GetAttrsOrDefault("max_norm_clip", std::vector<float>(1024, 1.0f));
+    for (const auto& max_norm : max_norm_clip_) {
+      ORT_ENFORCE(max_norm != 0, "max_norm_clip must NOT be 0.");
+    }
+
+    int64_t tmp_flag = static_cast<int64_t>(0);
+    ORT_ENFORCE(info.GetAttr<int64_t>("do_bias_correction", &tmp_flag).IsOK(), "Missing/Invalid do_bias_correction");
+    ORT_ENFORCE(tmp_flag == 0 || tmp_flag == 1, "do_bias_correction must be either 0 or 1.");
+    do_bias_correction_ = tmp_flag != 0 ? true : false;
+    info.GetAttrOrDefault("weight_decay_mode", &weight_decay_mode_, static_cast<int64_t>(0));
+  }
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  std::vector<float> alpha_;
+  std::vector<float> beta_;
+  std::vector<float> lambda_;
+  std::vector<float> epsilon_;
+  std::vector<float> max_norm_clip_;
+  bool do_bias_correction_;
+  int64_t weight_decay_mode_;
+};
+
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -89,5 +89,141 @@ Status InPlaceAccumulator<T, T_GRAD>::ComputeInternal(OpKernelContext* ctx) cons
   return Status::OK();
 }
 
+ONNX_OPERATOR_KERNEL_EX(
+    MultiTensorInPlaceAccumulator,
+    kMSDomain,
+    1,
+    kCudaExecutionProvider,
+    KernelDefBuilder()
+        .InputMemoryType<OrtMemTypeCPUInput>(0) /* Keep do_update in CPU */
+        .VariadicAlias(1, 0)                    /* Accumulate the old sums in-place */
+        .TypeConstraint("T", {DataTypeImpl::GetTensorType<float>(), DataTypeImpl::GetTensorType<MLFloat16>(),
+                              DataTypeImpl::GetTensorType<BFloat16>()})
+        .TypeConstraint("T_BOOL", DataTypeImpl::GetTensorType<bool>()),
+    MultiTensorInPlaceAccumulator);
+
+namespace {
+template <typename T, typename T_GRAD>
+Status LaunchInPlaceAccumulatorMultiTensor(OpKernelContext* ctx, int num_tensors) {
+  typedef typename ToCudaType<T>::MappedType CudaT;
+  typedef typename ToCudaType<T_GRAD>::MappedType CudaT_GRAD;
+
+  std::vector<int> tensor_sizes;
+  std::vector<std::vector<void*>> tensor_pointers;
+  tensor_sizes.reserve(num_tensors);
+  tensor_pointers.reserve(num_tensors);
+  for (int i = 0; i < num_tensors; ++i) {
+    const Tensor& old_sum = *ctx->Input<Tensor>(1 + i);
+    const Tensor& value = *ctx->Input<Tensor>(1 + num_tensors + i);
+    ORT_RETURN_IF_NOT(old_sum.Shape() == value.Shape(),
+                      "The old sum and the value of tensor ", i, " must have the same shape.");
+    Tensor& new_sum = *ctx->Output(i, old_sum.Shape());
+    if (old_sum.Shape().Size() == 0) {
+      continue;
+    }
+
+    tensor_sizes.push_back(static_cast<int>(old_sum.Shape().Size()));
+    tensor_pointers.push_back({const_cast<T*>(old_sum.template Data<T>()),
+                               const_cast<T_GRAD*>(value.template Data<T_GRAD>()),
+                               new_sum.template MutableData<T>()});
+  }
+
+  if (!tensor_sizes.empty()) {
+    typedef InPlaceAccumulatorMultiTensorFunctor<CudaT, CudaT_GRAD> AccumulatorFunctor;
+    launch_multi_tensor_functor<3, AccumulatorFunctor>(2048 * 32, tensor_sizes, tensor_pointers, AccumulatorFunctor());
+  }
+  return Status::OK();
+}
+}  // namespace
+
+Status MultiTensorInPlaceAccumulator::ComputeInternal(OpKernelContext* ctx) const {
+  const int num_tensors = (ctx->InputCount() - 1) / 2;
+  ORT_RETURN_IF_NOT(num_tensors > 0 && ctx->InputCount() == 1 + 2 * num_tensors,
+                    "MultiTensorInPlaceAccumulator must have as many values as old sums.");
+
+  const Tensor* do_update_tensor = ctx->Input<Tensor>(0);
+  if (do_update_tensor && !*(do_update_tensor->template Data<bool>())) {
+    for (int i = 0; i < num_tensors; ++i) {
+      const Tensor& old_sum = *ctx->Input<Tensor>(1 + i);
+      Tensor& new_sum = *ctx->Output(i, old_sum.Shape());
+      if (old_sum.DataRaw() != new_sum.DataRaw()) {
+        CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(new_sum.MutableDataRaw(), old_sum.DataRaw(), old_sum.SizeInBytes(),
+                                             cudaMemcpyDeviceToDevice));
+      }
+    }
+    return Status::OK();
+  }
+
+  // a single launch adds all of the tensors, so the old sums share a type and the values share a type
+  const MLDataType sum_type = ctx->Input<Tensor>(1)->DataType();
+  const MLDataType value_type = ctx->Input<Tensor>(1 + num_tensors)->DataType();
+  for (int i = 1; i < num_tensors; ++i) {
+    ORT_RETURN_IF_NOT(ctx->Input<Tensor>(1 + i)->DataType() == sum_type &&
+                          ctx->Input<Tensor>(1 + num_tensors + i)->DataType() == value_type,
+                      "All of the old sums of MultiTensorInPlaceAccumulator must have one type, "
+                      "and so must all of the values.");
+  }
+
+  const Tensor& old_sum = *ctx->Input<Tensor>(1);
+  const Tensor& value = *ctx->Input<Tensor>(1 + num_tensors);
+  if (old_sum.IsDataType<float>() && value.IsDataType<float>()) {
+    return LaunchInPlaceAccumulatorMultiTensor<float, float>(ctx, num_tensors);
+  } else if (old_sum.IsDataType<float>() && value.IsDataType<MLFloat16>()) {
+    return LaunchInPlaceAccumulatorMultiTensor<float, MLFloat16>(ctx, num_tensors);
+  } else if (old_sum.IsDataType<MLFloat16>() && value.IsDataType<MLFloat16>()) {
+    return LaunchInPlaceAccumulatorMultiTensor<MLFloat16, MLFloat16>(ctx, num_tensors);
+  } else if (old_sum.IsDataType<MLFloat16>() && value.IsDataType<float>()) {
+    return LaunchInPlaceAccumulatorMultiTensor<MLFloat16, float>(ctx, num_tensors);
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11000
+  } else if (old_sum.IsDataType<float>() && value.IsDataType<BFloat16>()) {
+    return LaunchInPlaceAccumulatorMultiTensor<float, BFloat16>(ctx, num_tensors);
+  } else if (old_sum.IsDataType<BFloat16>() && value.IsDataType<BFloat16>()) {
+    return LaunchInPlaceAccumulatorMultiTensor<BFloat16, BFloat16>(ctx, num_tensors);
+  } else if (old_sum.IsDataType<BFloat16>() && value.IsDataType<float>()) {
+    return LaunchInPlaceAccumulatorMultiTensor<BFloat16, float>(ctx, num_tensors);
+#endif
+  }
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "MultiTensorInPlaceAccumulator does not support the types ",
+                         DataTypeImpl::ToString(sum_type), " and ", DataTypeImpl::ToString(value_type), ".");
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    DynamicLossScale,
+    kMSDomain,
+    1,
+    kCudaExecutionProvider,
+    KernelDefBuilder()
+        .Alias(0, 0) /* Update the loss scale in-place */
+        .Alias(1, 1) /* Update the stable steps in-place */
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T_INT", DataTypeImpl::GetTensorType<int64_t>())
+        .TypeConstraint("T_BOOL", DataTypeImpl::GetTensorType<bool>())
+        .TypeConstraint("T_ANY", DataTypeImpl::AllTensorTypes()),
+    DynamicLossScale);
+
+Status DynamicLossScale::ComputeInternal(OpKernelContext* ctx) const {
+  const Tensor& loss_scale = *ctx->Input<Tensor>(0);
+  const Tensor& stable_steps = *ctx->Input<Tensor>(1);
+  const Tensor& is_all_finite = *ctx->Input<Tensor>(2);
+  ORT_RETURN_IF_NOT(loss_scale.Shape().Size() == 1 && stable_steps.Shape().Size() == 1 &&
+                        is_all_finite.Shape().Size() == 1,
+                    "The loss scale, stable steps and is_all_finite inputs must have a single element.");
+
+  Tensor& new_loss_scale = *ctx->Output(0, loss_scale.Shape());
+  Tensor& new_stable_steps = *ctx->Output(1, stable_steps.Shape());
+
+  DynamicLossScaleImpl(
+      loss_scale.template Data<float>(),
+      stable_steps.template Data<int64_t>(),
+      is_all_finite.template Data<bool>(),
+      up_scale_window_,
+      min_loss_scale_,
+      max_loss_scale_,
+      new_loss_scale.template MutableData<float>(),
+      new_stable_steps.template MutableData<int64_t>());
+
+  return Status::OK();
+}
+
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -51,5 +51,87 @@ SPECIALIZED_IMPL_InPlaceAccumulator(nv_bfloat16, nv_bfloat16)
 SPECIALIZED_IMPL_InPlaceAccumulator(nv_bfloat16, float)
 #endif
 
+template <typename T, typename T_GRAD>
+__global__ void _InPlaceAccumulatorMultiTensor(ChunkGroup<3> chunk_group) {
+  const int group_index = chunk_group.block_index_to_tensor_group_index[blockIdx.x];
+  const int tensor_size = chunk_group.tensor_sizes[group_index];
+  const int chunk_size = chunk_group.chunk_size;
+  const int chunk_start = chunk_group.block_index_to_chunk_start_index[blockIdx.x];
+
+  const T* old_sum = reinterpret_cast<const T*>(chunk_group.tensor_ptrs[0][group_index]) + chunk_start;
+  const T_GRAD* value = reinterpret_cast<const T_GRAD*>(chunk_group.tensor_ptrs[1][group_index]) + chunk_start;
+  T* new_sum = reinterpret_cast<T*>(chunk_group.tensor_ptrs[2][group_index]) + chunk_start;
+
+  for (int i = threadIdx.x; i < chunk_size && i + chunk_start < tensor_size; i += blockDim.x) {
+    new_sum[i] = old_sum[i] + T(value[i]);
+  }
+}
+
+template <typename T, typename T_GRAD>
+void InPlaceAccumulatorMultiTensorFunctor<T, T_GRAD>::operator()(ChunkGroup<3> chunk_group) {
+  const int thread_count = ChunkGroup<3>::thread_count_per_block;
+  const int block_count = chunk_group.chunk_count;
+  _InPlaceAccumulatorMultiTensor<T, T_GRAD><<<block_count, thread_count, 0>>>(chunk_group);
+}
+
+#define INSTANTIATE_IN_PLACE_ACCUMULATOR_MULTI_TENSOR_FUNCTOR(T, T_GRAD) \
+  template void InPlaceAccumulatorMultiTensorFunctor<T, T_GRAD>::operator()(ChunkGroup<3> chunk_group);
+
+INSTANTIATE_IN_PLACE_ACCUMULATOR_MULTI_TENSOR_FUNCTOR(float, float)
+INSTANTIATE_IN_PLACE_ACCUMULATOR_MULTI_TENSOR_FUNCTOR(float, half)
+INSTANTIATE_IN_PLACE_ACCUMULATOR_MULTI_TENSOR_FUNCTOR(half, half)
+INSTANTIATE_IN_PLACE_ACCUMULATOR_MULTI_TENSOR_FUNCTOR(half, float)
+#if CUDA_VERSION >= 11000 && (__CUDA_ARCH__ >= 800 || !defined(__CUDA_ARCH__))
+INSTANTIATE_IN_PLACE_ACCUMULATOR_MULTI_TENSOR_FUNCTOR(float, nv_bfloat16)
+INSTANTIATE_IN_PLACE_ACCUMULATOR_MULTI_TENSOR_FUNCTOR(nv_bfloat16, nv_bfloat16)
+INSTANTIATE_IN_PLACE_ACCUMULATOR_MULTI_TENSOR_FUNCTOR(nv_bfloat16, float)
+#endif
+
+// The update is a single scalar, so one thread updates it on the device without a copy of the state to the host.
+__global__ void _DynamicLossScale(
+    const float* loss_scale,
+    const int64_t* stable_steps,
+    const bool* is_all_finite,
+    int64_t up_scale_window,
+    float min_loss_scale,
+    float max_loss_scale,
+    float* new_loss_scale,
+    int64_t* new_stable_steps) {
+  float scale = *loss_scale;
+  int64_t steps = *stable_steps;
+  if (*is_all_finite) {
+    ++steps;
+    if (steps >= up_scale_window) {
+      scale = fminf(max_loss_scale, scale * 2.0f);
+      steps = 0;
+    }
+  } else {
+    scale = fmaxf(min_loss_scale, scale * 0.5f);
+    steps = 0;
+  }
+  *new_loss_scale = scale;
+  *new_stable_steps = steps;
+}
+
+void DynamicLossScaleImpl(
+    const float* loss_scale,
+    const int64_t* stable_steps,
+    const bool* is_all_finite,
+    int64_t up_scale_window,
+    float min_loss_scale,
+    float max_loss_scale,
+    float* new_loss_scale,
+    int64_t* new_stable_steps) {
+  _DynamicLossScale<<<1, 1, 0>>>(
+      loss_scale,
+      stable_steps,
+      is_all_finite,
+      up_scale_window,
+      min_loss_scale,
+      max_loss_scale,
+      new_loss_scale,
+      new_stable_steps);
+}
+
 }  // namespace cuda
 }  // namespace onnxruntime
\ No newline at end of file
@@ -4,6 +4,7 @@
 #pragma once
 #include "core/common/common.h"
 #include "core/providers/cuda/cuda_kernel.h"
+#include "core/providers/cuda/multi_tensor/common.cuh"
 
 namespace onnxruntime {
 namespace cuda {
@@ -30,5 +31,50 @@ void InPlaceAccumulatorImpl(
     T* accumulated_gradient,
     size_t count);
 
+// Adds the values to the old sums of the tensors of a chunk group in one launch.
+//  old_sum: chunk_group.tensor_ptrs[0][i]
+//  value: chunk_group.tensor_ptrs[1][i]
+//  new_sum: chunk_group.tensor_ptrs[2][i]
+template <typename T, typename T_GRAD>
+struct InPlaceAccumulatorMultiTensorFunctor {
+  void operator()(ChunkGroup<3> chunk_group);
+};
+
+// The InPlaceAccumulator of a list of tensors in a single node, see MultiTensorInPlaceAccumulator's schema.
+class MultiTensorInPlaceAccumulator final : public CudaKernel {
+ public:
+  MultiTensorInPlaceAccumulator(const OpKernelInfo& info) : CudaKernel(info) {}
+  Status ComputeInternal(OpKernelContext* context) const override;
+};
+
+class DynamicLossScale final : public CudaKernel {
+ public:
+  DynamicLossScale(const OpKernelInfo& info) : CudaKernel(info) {
+    up_scale_window_ = info.GetAttrOrDefault<int64_t>("up_scale_window", 2000);
+    min_loss_scale_ = info.GetAttrOrDefault<float>("min_loss_scale", 1.0f);
+    max_loss_scale_ = info.GetAttrOrDefault<float>("max_loss_scale", static_cast<float>(1 << 24));
+    ORT_ENFORCE(up_scale_window_ > 0, "up_scale_window must be positive.");
+    ORT_ENFORCE(min_loss_scale_ > 0.0f && min_loss_scale_ <= max_loss_scale_,
+                "min_loss_scale must be positive and no larger than max_loss_scale.");
+  }
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  int64_t up_scale_window_;
+  float min_loss_scale_;
+  float max_loss_scale_;
+};
+
+// Implementation can be found in cuda file, gradient_control.cu
+void DynamicLossScaleImpl(
+    const float* loss_scale,
+    const int64_t* stable_steps,
+    const bool* is_all_finite,
+    int64_t up_scale_window,
+    float min_loss_scale,
+    float max_loss_scale,
+    float* new_loss_scale,
+    int64_t* new_stable_steps);
+
 }  // namespace cuda
 }  // namespace onnxruntime
\ No newline at end of file
@@ -0,0 +1,411 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <sstream>
+
+#include "batcher.h"
+
+namespace onnxruntime {
+namespace server {
+
+namespace {
+
+// Size in bytes of an element of a tensor that can be batched by copying memory. 0 for other types.
+size_t ElementSize(ONNXTensorElementDataType type) {
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+      return 1;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+      return 2;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+      return 4;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+int64_t NumElements(const std::vector<int64_t>& shape, size_t first_dim = 0) {
+  return std::accumulate(shape.begin() + first_dim, shape.end(), int64_t{1}, std::multiplies<int64_t>());
+}
+
+// Copy src into dst where dst has the same rank and is at least as large in every dimension except the first.
+// dst_shape[0] is ignored. The rows of src are copied to the first rows of dst.
+void CopyPadded(const uint8_t* src, const std::vector<int64_t>& src_shape,
+                uint8_t* dst, const std::vector<int64_t>& dst_shape, size_t element_size) {
+  const size_t rank = src_shape.size();
+  if (NumElements(src_shape) == 0) {
+    return;
+  }
+
+  const size_t last_dim_bytes = static_cast<size_t>(src_shape[rank - 1]) * element_size;
+
+  // element strides of dst
+  std::vector<int64_t> dst_strides(rank, 1);
+  for (size_t i = rank - 1; i > 0; --i) {
+    dst_strides[i - 1] = dst_strides[i] * dst_shape[i];
+  }
+
+  // copy one run of the innermost dimension at a time
+  const int64_t num_runs = NumElements(src_shape) / src_shape[rank - 1];
+  for (int64_t run = 0; run < num_runs; ++run) {
+    int64_t remaining = run;
+    int64_t dst_offset = 0;
+    for (size_t i = rank - 1; i > 0; --i) {
+      const int64_t index = remaining % src_shape[i - 1];
+      remaining /= src_shape[i - 1];
+      dst_offset += index * dst_strides[i - 1];
+    }
+
+    memcpy(dst + dst_offset * element_size, src + run * last_dim_bytes, last_dim_bytes);
+  }
+}
+
+}  // namespace
+
+std::string BatchingMetricsToJson(const BatchingMetrics& metrics) {
+  std::ostringstream json;
+  json << "{\"numRequests\":" << metrics.num_requests
+       << ",\"numBatches\":" << metrics.num_batches
+       << ",\"averageQueueTimeUs\":"
+       << (metrics.num_requests == 0 ? 0 : metrics.total_queue_time_us / metrics.num_requests)
+       << ",\"maxQueueTimeUs\":" << metrics.max_queue_time_us
+       << ",\"batchSizeHistogram\":{";
+
+  bool first = true;
+  for (size_t i = 0; i < metrics.batch_size_histogram.size(); ++i) {
+    if (metrics.batch_size_histogram[i] == 0) {
+      continue;
+    }
+
+    json << (first ? "" : ",") << "\"" << i << "\":" << metrics.batch_size_histogram[i];
+    first = false;
+  }
+
+  json << "}}";
+  return json.str();
+}
+
+RequestBatcher::RequestBatcher(const BatchingOptions& options, RunFn run)
+    : options_(options), run_(std::move(run)) {
+  metrics_.batch_size_histogram.resize(options_.max_batch_size + 1, 0);
+  worker_ = std::thread(&RequestBatcher::WorkerLoop, this);
+}
+
+RequestBatcher::~RequestBatcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+
+  cv_.notify_all();
+  worker_.join();
+}
+
+std::vector<Ort::Value> RequestBatcher::Run(const std::vector<std::string>& input_names,
+                                            std::vector<Ort::Value> input_values,
+                                            const std::vector<std::string>& output_names) {
+  auto task = std::make_unique<Task>();
+
+  // order the inputs by name so requests that list their inputs in a different order can be batched together
+  std::vector<size_t> order(input_names.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::sort(order.begin(), order.end(), [&input_names](size_t a, size_t b) { return input_names[a] < input_names[b]; });
+  for (size_t i : order) {
+    task->input_names.push_back(input_names[i]);
+    task->input_values.push_back(std::move(input_values[i]));
+  }
+
+  task->output_names = output_names;
+
+  // a request can be batched if every input is a tensor of a fixed size type with the same number of rows
+  task->batchable = !task->input_values.empty();
+  for (const auto& value : task->input_values) {
+    if (!value.IsTensor()) {
+      task->batchable = false;
+      break;
+    }
+
+    auto type_and_shape = value.GetTensorTypeAndShapeInfo();
+    auto type = type_and_shape.GetElementType();
+    auto shape = type_and_shape.GetShape();
+    if (ElementSize(type) == 0 || shape.empty() || shape[0] <= 0 ||
+        (task->rows != 0 && shape[0] != task->rows)) {
+      task->batchable = false;
+      break;
+    }
+
+    task->rows = shape[0];
+    task->input_types.push_back(type);
+    task->input_shapes.push_back(std::move(shape));
+  }
+
+  if (!task->batchable) {
+    task->rows = 1;
+  }
+
+  auto result = task->result.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task->enqueue_time = std::chrono::steady_clock::now();
+    queued_rows_ += task->rows;
+    queue_.push_back(std::move(task));
+  }
+
+  cv_.notify_one();
+  return result.get();
+}
+
+BatchingMetrics RequestBatcher::GetMetrics() const {
+  std::lock_guard<std::mutex> lock(metrics_mutex_);
+  return metrics_;
+}
+
+bool RequestBatcher::CanBatch(const Task& first, const Task& other) const {
+  if (!first.batchable || !other.batchable ||
+      first.input_names != other.input_names || first.output_names != other.output_names ||
+      first.input_types != other.input_types) {
+    return false;
+  }
+
+  for (size_t i = 0; i < first.input_shapes.size(); ++i) {
+    const auto& a = first.input_shapes[i];
+    const auto& b = other.input_shapes[i];
+    if (a.size() != b.size()) {
+      return false;
+    }
+
+    if (options_.padding_policy == BatchPaddingPolicy::None && !std::equal(a.begin() + 1, a.end(), b.begin() + 1)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void RequestBatcher::WorkerLoop() {
+  const auto max_rows = static_cast<int64_t>(options_.max_batch_size);
+
+  for (;;) {
+    std::vector<std::unique_ptr<Task>> batch;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this]() { return shutdown_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        return;
+      }
+
+      // wait for the batch to fill up, or for the oldest request to reach its maximum delay
+      const auto deadline = queue_.front()->enqueue_time + options_.max_queue_delay;
+      cv_.wait_until(lock, deadline, [this, max_rows]() { return shutdown_ || queued_rows_ >= max_rows; });
+
+      batch.push_back(std::move(queue_.front()));
+      queue_.pop_front();
+      int64_t rows = batch.front()->rows;
+
+      // add compatible requests in arrival order. incompatible ones stay queued for a later batch.
+      for (auto it = queue_.begin(); it != queue_.end() && rows < max_rows;) {
+        if ((*it)->rows + rows <= max_rows && CanBatch(*batch.front(), **it)) {
+          rows += (*it)->rows;
+          batch.push_back(std::move(*it));
+          it = queue_.erase(it);
+        } else {
+          ++it;
+        }
+      }
+
+      queued_rows_ -= rows;
+    }
+
+    RunBatch(batch);
+  }
+}
+
+void RequestBatcher::UpdateMetrics(const std::vector<std::unique_ptr<Task>>& tasks, int64_t rows,
+                                   std::chrono::steady_clock::time_point start) {
+  std::lock_guard<std::mutex> lock(metrics_mutex_);
+  auto& histogram = metrics_.batch_size_histogram;
+  ++histogram[std::min(static_cast<size_t>(rows), histogram.size() - 1)];
+  ++metrics_.num_batches;
+
+  for (const auto& task : tasks) {
+    const auto queue_time = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(start - task->enqueue_time).count());
+    ++metrics_.num_requests;
+    metrics_.total_queue_time_us += queue_time;
+    metrics_.max_queue_time_us = std::max(metrics_.max_queue_time_us, queue_time);
+  }
+}
+
+void RequestBatcher::RunSingle(Task& task) {
+  try {
+    task.result.set_value(run_(task.input_names, task.input_values, task.output_names));
+  } catch (...) {
+    task.result.set_exception(std::current_exception());
+  }
+}
+
+void RequestBatcher::RunBatch(std::vector<std::unique_ptr<Task>>& tasks) {
+  std::vector<int64_t> rows;
+  for (const auto& task : tasks) {
+    rows.push_back(task->rows);
+  }
+
+  const int64_t total_rows = std::accumulate(rows.begin(), rows.end(), int64_t{0});
+  UpdateMetrics(tasks, total_rows, std::chrono::steady_clock::now());
+
+  if (tasks.size() == 1) {
+    RunSingle(*tasks.front());
+    return;
+  }
+
+  const Task& first = *tasks.front();
+  std::vector<std::vector<Ort::Value>> results(tasks.size());
+  bool batched = false;
+
+  try {
+    std::vector<Ort::Value> inputs;
+    for (size_t i = 0; i < first.input_values.size(); ++i) {
+      std::vector<const Ort::Value*> values;
+      for (const auto& task : tasks) {
+        values.push_back(&task->input_values[i]);
+      }
+
+      inputs.push_back(Concatenate(values, options_.padding_policy));
+    }
+
+    auto outputs = run_(first.input_names, inputs, first.output_names);
+
+    for (auto& output : outputs) {
+      auto parts = Split(output, rows);
+      for (size_t t = 0; t < tasks.size(); ++t) {
+        results[t].push_back(std::move(parts[t]));
+      }
+    }
+
+    batched = true;
+  } catch (const std::exception&) {
+    // the model may not support a dynamic batch dimension, produce outputs that can't be split,
+    // or one of the requests may be invalid. run them one at a time so each gets its own result.
+  }
+
+  if (!batched) {
+    for (auto& task : tasks) {
+      RunSingle(*task);
+    }
+
+    return;
+  }
+
+  for (size_t t = 0; t < tasks.size(); ++t) {
+    tasks[t]->result.set_value(std::move(results[t]));
+  }
+}
+
+Ort::Value RequestBatcher::Concatenate(const std::vector<const Ort::Value*>& values,
+                                       BatchPaddingPolicy padding_policy) {
+  auto first_info = values.front()->GetTensorTypeAndShapeInfo();
+  const auto type = first_info.GetElementType();
+  const size_t element_size = ElementSize(type);
+  if (element_size == 0) {
+    throw Ort::Exception("Tensors of this type can't be batched", ORT_INVALID_ARGUMENT);
+  }
+
+  std::vector<std::vector<int64_t>> shapes;
+  std::vector<int64_t> batch_shape = first_info.GetShape();
+  batch_shape[0] = 0;
+  bool padded = false;
+
+  for (const auto* value : values) {
+    auto info = value->GetTensorTypeAndShapeInfo();
+    auto shape = info.GetShape();
+    if (info.GetElementType() != type || shape.size() != batch_shape.size()) {
+      throw Ort::Exception("Tensors with different types or ranks can't be batched", ORT_INVALID_ARGUMENT);
+    }
+
+    batch_shape[0] += shape[0];
+    for (size_t i = 1; i < shape.size(); ++i) {
+      if (shape[i] != batch_shape[i]) {
+        if (padding_policy != BatchPaddingPolicy::PadToMax) {
+          throw Ort::Exception("Tensors with different shapes can't be batched without padding", ORT_INVALID_ARGUMENT);
+        }
+
+        padded = true;
+        batch_shape[i] = std::max(batch_shape[i], shape[i]);
+      }
+    }
+
+    shapes.push_back(std::move(shape));
+  }
+
+  Ort::AllocatorWithDefaultOptions allocator;
+  auto batch = Ort::Value::CreateTensor(allocator, batch_shape.data(), batch_shape.size(), type);
+  auto* dst = batch.GetTensorMutableData<uint8_t>();
+  const size_t row_bytes = static_cast<size_t>(NumElements(batch_shape, 1)) * element_size;
+
+  if (padded) {
+    memset(dst, 0, static_cast<size_t>(batch_shape[0]) * row_bytes);
+  }
+
+  for (size_t v = 0; v < values.size(); ++v) {
+    const auto* src = values[v]->GetTensorData<uint8_t>();
+    const auto& shape = shapes[v];
+    if (padded) {
+      CopyPadded(src, shape, dst, batch_shape, element_size);
+    } else {
+      memcpy(dst, src, static_cast<size_t>(shape[0]) * row_bytes);
+    }
+
+    dst += static_cast<size_t>(shape[0]) * row_bytes;
+  }
+
+  return batch;
+}
+
+std::vector<Ort::Value> RequestBatcher::Split(const Ort::Value& value, const std::vector<int64_t>& rows) {
+  if (!value.IsTensor()) {
+    throw Ort::Exception("Only tensors can be split", ORT_INVALID_ARGUMENT);
+  }
+
+  auto info = value.GetTensorTypeAndShapeInfo();
+  const auto type = info.GetElementType();
+  const size_t element_size = ElementSize(type);
+  auto shape = info.GetShape();
+  if (element_size == 0 || shape.empty() ||
+      shape[0] != std::accumulate(rows.begin(), rows.end(), int64_t{0})) {
+    throw Ort::Exception("Tensor can't be split into the requested number of rows", ORT_INVALID_ARGUMENT);
+  }
+
+  Ort::AllocatorWithDefaultOptions allocator;
+  const size_t row_bytes = static_cast<size_t>(NumElements(shape, 1)) * element_size;
+  const auto* src = value.GetTensorData<uint8_t>();
+
+  std::vector<Ort::Value> parts;
+  parts.reserve(rows.size());
+  for (int64_t num_rows : rows) {
+    shape[0] = num_rows;
+    auto part = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), type);
+    const size_t bytes = static_cast<size_t>(num_rows) * row_bytes;
+    memcpy(part.GetTensorMutableData<uint8_t>(), src, bytes);
+    src += bytes;
+    parts.push_back(std::move(part));
+  }
+
+  return parts;
+}
+
+}  // namespace server
+}  // namespace onnxruntime
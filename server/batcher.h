@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "onnxruntime_cxx_api.h"
+
+namespace onnxruntime {
+namespace server {
+
+// How requests whose inputs differ in the non-batch dimensions are handled
+enum class BatchPaddingPolicy {
+  None,      // only requests with identical non-batch dimensions are batched together
+  PadToMax,  // inputs are zero padded to the largest size of each non-batch dimension in the batch.
+             // outputs are returned with the padded shape.
+};
+
+struct BatchingOptions {
+  // Maximum number of rows (sum of the batch dimension of the requests) run together. 1 disables batching.
+  size_t max_batch_size = 1;
+  // Maximum time the first request in the queue waits for the batch to fill up
+  std::chrono::microseconds max_queue_delay{1000};
+  BatchPaddingPolicy padding_policy = BatchPaddingPolicy::None;
+};
+
+struct BatchingMetrics {
+  // Number of batches run for each batch size (in rows). The last bucket also counts larger batches,
+  // which happens when a single request exceeds max_batch_size.
+  std::vector<uint64_t> batch_size_histogram;
+  uint64_t num_requests = 0;
+  uint64_t num_batches = 0;
+  uint64_t total_queue_time_us = 0;
+  uint64_t max_queue_time_us = 0;
+};
+
+std::string BatchingMetricsToJson(const BatchingMetrics& metrics);
+
+// Groups concurrent requests for the same model into a single Session::Run.
+// Compatible requests are concatenated along the first (batch) dimension of every input, run once,
+// and the outputs are split along their first dimension and handed back to each request.
+// A request is only batched with others if it has the same inputs, element types and requested outputs.
+// Requests that can't be batched, or a batch whose run fails, are run one request at a time.
+class RequestBatcher {
+ public:
+  using RunFn = std::function<std::vector<Ort::Value>(const std::vector<std::string>& input_names,
+                                                      std::vector<Ort::Value>& input_values,
+                                                      const std::vector<std::string>& output_names)>;
+
+  RequestBatcher(const BatchingOptions& options, RunFn run);
+  ~RequestBatcher();
+  RequestBatcher(const RequestBatcher&) = delete;
+  RequestBatcher& operator=(const RequestBatcher&) = delete;
+
+  // Queue a request and wait for the batch containing it to be run.
+  // Returns the outputs for this request in the order of output_names. Throws Ort::Exception on failure.
+  std::vector<Ort::Value> Run(const std::vector<std::string>& input_names,
+                              std::vector<Ort::Value> input_values,
+                              const std::vector<std::string>& output_names);
+
+  BatchingMetrics GetMetrics() const;
+
+  // Concatenate tensors along the first dimension. All tensors must have the same element type and rank.
+  // With BatchPaddingPolicy::PadToMax the other dimensions are zero padded to the largest size.
+  static Ort::Value Concatenate(const std::vector<const Ort::Value*>& values, BatchPaddingPolicy padding_policy);
+
+  // Split a tensor along the first dimension into tensors with the given number of rows.
+  static std::vector<Ort::Value> Split(const Ort::Value& value, const std::vector<int64_t>& rows);
+
+ private:
+  struct Task {
+    std::vector<std::string> input_names;
+    std::vector<Ort::Value> input_values;
+    std::vector<std::string> output_names;
+    std::vector<ONNXTensorElementDataType> input_types;
+    std::vector<std::vector<int64_t>> input_shapes;
+    int64_t rows = 0;
+    bool batchable = false;
+    std::chrono::steady_clock::time_point enqueue_time;
+    std::promise<std::vector<Ort::Value>> result;
+  };
+
+  bool CanBatch(const Task& first, const Task& other) const;
+  void WorkerLoop();
+  void RunBatch(std::vector<std::unique_ptr<Task>>& tasks);
+  void RunSingle(Task& task);
+  void UpdateMetrics(const std::vector<std::unique_ptr<Task>>& tasks, int64_t rows,
+                     std::chrono::steady_clock::time_point start);
+
+  const BatchingOptions options_;
+  const RunFn run_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::unique_ptr<Task>> queue_;  // protected by mutex_
+  int64_t queued_rows_ = 0;                  // protected by mutex_
+  bool shutdown_ = false;                    // protected by mutex_
+
+  mutable std::mutex metrics_mutex_;
+  BatchingMetrics metrics_;  // protected by metrics_mutex_
+
+  std::thread worker_;
+};
+
+}  // namespace server
+}  // namespace onnxruntime
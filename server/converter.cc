@@ -1,6 +1,13 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <limits>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/wire_format_lite.h>
+
 #include "onnxruntime_cxx_api.h"
 
 #include "onnx-ml.pb.h"
@@ -54,6 +61,28 @@ onnx::TensorProto_DataType MLDataTypeToTensorProtoDataType(ONNXTensorElementData
   }
 }
 
+size_t RawDataElementSize(onnx::TensorProto_DataType data_type) {
+  switch (data_type) {
+    case onnx::TensorProto_DataType_BOOL:
+    case onnx::TensorProto_DataType_INT8:
+    case onnx::TensorProto_DataType_UINT8:
+      return 1;
+    case onnx::TensorProto_DataType_INT16:
+    case onnx::TensorProto_DataType_UINT16:
+      return 2;
+    case onnx::TensorProto_DataType_FLOAT:
+    case onnx::TensorProto_DataType_INT32:
+    case onnx::TensorProto_DataType_UINT32:
+      return 4;
+    case onnx::TensorProto_DataType_DOUBLE:
+    case onnx::TensorProto_DataType_INT64:
+    case onnx::TensorProto_DataType_UINT64:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
 void MLValueToTensorProto(Ort::Value& ml_value, bool using_raw_data,
                           const std::shared_ptr<spdlog::logger>& logger,
                           /* out */ onnx::TensorProto& tensor_proto) {
@@ -230,5 +259,99 @@ void MLValueToTensorProto(Ort::Value& ml_value, bool using_raw_data,
 
   return;
 }
+
+void MLValuesToPredictResponseBinary(const std::vector<std::string>& output_names,
+                                     std::vector<Ort::Value>& outputs,
+                                     const std::shared_ptr<spdlog::logger>& logger,
+                                     /* out */ std::string& out) {
+  using google::protobuf::io::CodedOutputStream;
+  using google::protobuf::internal::WireFormatLite;
+
+  const auto length_delimited = WireFormatLite::WIRETYPE_LENGTH_DELIMITED;
+  const uint32_t entry_tag = WireFormatLite::MakeTag(PredictResponse::kOutputsFieldNumber, length_delimited);
+  const uint32_t key_tag = WireFormatLite::MakeTag(1, length_delimited);
+  const uint32_t value_tag = WireFormatLite::MakeTag(2, length_delimited);
+  const uint32_t raw_data_tag = WireFormatLite::MakeTag(onnx::TensorProto::kRawDataFieldNumber, length_delimited);
+
+  auto check_size = [](size_t size) {
+    if (size > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+      throw Ort::Exception("Response exceeds the maximum protobuf message size", OrtErrorCode::ORT_FAIL);
+    }
+
+    return static_cast<uint32_t>(size);
+  };
+
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    if (std::find(output_names.begin() + i + 1, output_names.end(), output_names[i]) != output_names.end()) {
+      throw Ort::Exception("Cannot have two outputs with the same name", OrtErrorCode::ORT_INVALID_ARGUMENT);
+    }
+  }
+
+  out.clear();
+  google::protobuf::io::StringOutputStream stream(&out);
+  CodedOutputStream coded(&stream);
+
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    auto& output = outputs[i];
+    const auto& name = output_names[i];
+
+    // the tensor without its data, which is written separately
+    onnx::TensorProto tensor_proto;
+    const void* data = nullptr;
+    size_t data_size = 0;
+
+    size_t element_size = 0;
+    if (output.IsTensor()) {
+      auto type_and_shape = output.GetTensorTypeAndShapeInfo();
+      element_size = RawDataElementSize(MLDataTypeToTensorProtoDataType(type_and_shape.GetElementType()));
+      if (element_size != 0) {
+        for (const auto& dim : type_and_shape.GetShape()) {
+          tensor_proto.add_dims(dim);
+        }
+
+        tensor_proto.set_data_type(MLDataTypeToTensorProtoDataType(type_and_shape.GetElementType()));
+        tensor_proto.set_data_location(onnx::TensorProto_DataLocation_DEFAULT);
+        data = output.GetTensorData<uint8_t>();
+        data_size = type_and_shape.GetElementCount() * element_size;
+      }
+    }
+
+    if (element_size == 0) {
+      // strings can't be written to raw_data. throws for non-tensors and unsupported types.
+      MLValueToTensorProto(output, true, logger, tensor_proto);
+    }
+
+    const uint32_t proto_size = check_size(tensor_proto.ByteSizeLong());
+    const uint32_t data_field_size =
+        data == nullptr ? 0 : check_size(CodedOutputStream::VarintSize32(raw_data_tag) +
+                                         CodedOutputStream::VarintSize32(check_size(data_size)) + data_size);
+    const uint32_t tensor_size = check_size(size_t{proto_size} + data_field_size);
+    const uint32_t name_size = check_size(name.size());
+    const uint32_t entry_size = check_size(CodedOutputStream::VarintSize32(key_tag) +
+                                           CodedOutputStream::VarintSize32(name_size) + name_size +
+                                           CodedOutputStream::VarintSize32(value_tag) +
+                                           CodedOutputStream::VarintSize32(tensor_size) + tensor_size);
+
+    // map<string, TensorProto> entries are serialized as a message with the key in field 1 and the value in field 2
+    coded.WriteTag(entry_tag);
+    coded.WriteVarint32(entry_size);
+    coded.WriteTag(key_tag);
+    coded.WriteVarint32(name_size);
+    coded.WriteRaw(name.data(), static_cast<int>(name_size));
+    coded.WriteTag(value_tag);
+    coded.WriteVarint32(tensor_size);
+    tensor_proto.SerializeWithCachedSizes(&coded);
+    if (data != nullptr) {
+      coded.WriteTag(raw_data_tag);
+      coded.WriteVarint32(static_cast<uint32_t>(data_size));
+      coded.WriteRaw(data, static_cast<int>(data_size));
+    }
+  }
+
+  if (coded.HadError()) {
+    throw Ort::Exception("Failed to serialize the response", OrtErrorCode::ORT_FAIL);
+  }
+}
+
 }  // namespace server
 }  // namespace onnxruntime
@@ -12,6 +12,10 @@ namespace server {
 
 onnx::TensorProto_DataType MLDataTypeToTensorProtoDataType(ONNXTensorElementDataType cpp_type);
 
+// Size of an element of a tensor of this type in raw_data. 0 if the type can't be stored in raw_data,
+// or isn't supported by the server.
+size_t RawDataElementSize(onnx::TensorProto_DataType data_type);
+
 // Convert MLValue to TensorProto. Some fields are ignored:
 //   * name field: could not get from MLValue
 //   * doc_string: could not get from MLValue
@@ -22,5 +26,14 @@ void MLValueToTensorProto(Ort::Value& ml_value, bool using_raw_data,
                           const std::shared_ptr<spdlog::logger>& logger,
                           /* out */ onnx::TensorProto& tensor_proto);
 
+// Serialize a PredictResponse with the given outputs into out, in the protobuf binary format.
+// Equivalent to converting each output with MLValueToTensorProto and using_raw_data set, and serializing the
+// response, but the tensor data is written straight from the output buffers instead of being copied into
+// TensorProto::raw_data first.
+void MLValuesToPredictResponseBinary(const std::vector<std::string>& output_names,
+                                     std::vector<Ort::Value>& outputs,
+                                     const std::shared_ptr<spdlog::logger>& logger,
+                                     /* out */ std::string& out);
+
 }  // namespace server
 }  // namespace onnxruntime
@@ -1,9 +1,11 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <fstream>
 #include <memory>
 #include "environment.h"
 #include "onnxruntime_cxx_api.h"
+#include "onnxruntime_session_options_config_keys.h"
 
 #ifdef USE_DNNL
 
@@ -50,73 +52,255 @@ void ORT_API_CALL Log(void* param, OrtLoggingLevel severity, const char* categor
   return;
 }
 
-ServerEnvironment::ServerEnvironment(OrtLoggingLevel severity, spdlog::sinks_init_list sink) : severity_(severity),
-                                                                                               logger_id_("ServerApp"),
-                                                                                               sink_(sink),
-                                                                                               default_logger_(std::make_shared<spdlog::logger>(logger_id_, sink)),
-                                                                                               runtime_environment_(severity, logger_id_.c_str(), Log, default_logger_.get()) {
+static Ort::Env CreateRuntimeEnvironment(OrtLoggingLevel severity, const std::string& logger_id,
+                                         spdlog::logger* logger, const ServerEnvironmentOptions& options) {
+  const OrtApi& api = Ort::GetApi();
+  OrtThreadingOptions* threading_options = nullptr;
+  Ort::ThrowOnError(api.CreateThreadingOptions(&threading_options));
+  std::unique_ptr<OrtThreadingOptions, decltype(api.ReleaseThreadingOptions)> threading_options_holder(
+      threading_options, api.ReleaseThreadingOptions);
+
+  Ort::ThrowOnError(api.SetGlobalIntraOpNumThreads(threading_options, options.intra_op_num_threads));
+  Ort::ThrowOnError(api.SetGlobalInterOpNumThreads(threading_options, options.inter_op_num_threads));
+  return Ort::Env(threading_options, Log, logger, severity, logger_id.c_str());
+}
+
+static size_t GetFileSize(const std::string& path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.good()) {
+    return 0;
+  }
+
+  return static_cast<size_t>(file.tellg());
+}
+
+ServerEnvironment::ServerEnvironment(OrtLoggingLevel severity, spdlog::sinks_init_list sink,
+                                     const ServerEnvironmentOptions& options) : severity_(severity),
+                                                                                logger_id_("ServerApp"),
+                                                                                sink_(sink),
+                                                                                default_logger_(std::make_shared<spdlog::logger>(logger_id_, sink)),
+                                                                                runtime_environment_(CreateRuntimeEnvironment(severity, logger_id_, default_logger_.get(), options)) {
   spdlog::set_automatic_registration(false);
   spdlog::set_level(Convert(severity_));
   spdlog::initialize_logger(default_logger_);
+
+  // the sessions use the thread pools of the env and a CPU arena shared through it, so that the memory a model
+  // frees can be reused by the others
+  options_.DisablePerSessionThreads();
+  options_.AddConfigEntry(kOrtSessionOptionsConfigUseEnvAllocators, "1");
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  runtime_environment_.CreateAndRegisterAllocator(memory_info, nullptr);
+
+  RegisterExecutionProviders();
 }
 
-void ServerEnvironment::RegisterExecutionProviders(){
-  #ifdef USE_DNNL
+void ServerEnvironment::RegisterExecutionProviders() {
+  if (execution_providers_registered_) {
+    return;
+  }
+  execution_providers_registered_ = true;
+
+#ifdef USE_DNNL
   Ort::ThrowOnError(OrtSessionOptionsAppendExecutionProvider_Dnnl(options_, 1));
-  #endif
+#endif
 
-  #ifdef USE_NUPHAR
+#ifdef USE_NUPHAR
   Ort::ThrowOnError(OrtSessionOptionsAppendExecutionProvider_Nuphar(options_, 1, ""));
-  #endif
-  
-  #ifdef USE_OPENVINO
-  Ort::ThrowOnError(OrtSessionOptionsAppendExecutionProvider_OpenVINO(options_, ""));
-  #endif
-  
+#endif
 
+#ifdef USE_OPENVINO
+  Ort::ThrowOnError(OrtSessionOptionsAppendExecutionProvider_OpenVINO(options_, ""));
+#endif
 }
 
-void ServerEnvironment::InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version) {
-  RegisterExecutionProviders();
-  auto result = sessions_.emplace(std::piecewise_construct, std::forward_as_tuple(model_name, model_version), std::forward_as_tuple(runtime_environment_, model_path.c_str(), options_));
+void ServerEnvironment::RegisterModel(const std::string& model_path, const std::string& model_name,
+                                      const std::string& model_version) {
+  auto entry = std::make_shared<ModelEntry>();
+  entry->path = model_path;
+  entry->estimated_size = GetFileSize(model_path);
 
-  if (!result.second) {
+  std::lock_guard<std::mutex> lock(models_mutex_);
+  if (!models_.emplace(std::make_pair(model_name, model_version), std::move(entry)).second) {
     throw Ort::Exception("Model of that name already loaded.", ORT_INVALID_ARGUMENT);
   }
+}
+
+void ServerEnvironment::InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version) {
+  RegisterModel(model_path, model_name, model_version);
+  try {
+    GetModel(model_name, model_version);
+  } catch (const Ort::Exception&) {
+    std::lock_guard<std::mutex> lock(models_mutex_);
+    models_.erase(std::make_pair(model_name, model_version));
+    throw;
+  }
+}
 
-  auto iterator = result.first;
-  auto output_count = (iterator->second).session.GetOutputCount();
+std::shared_ptr<ServerEnvironment::SessionHolder> ServerEnvironment::LoadModel(const ModelEntry& entry,
+                                                                               const std::string& model_name,
+                                                                               const std::string& model_version) {
+  auto holder = std::make_shared<SessionHolder>(runtime_environment_, entry.path, options_);
+  auto output_count = holder->session.GetOutputCount();
 
   Ort::AllocatorWithDefaultOptions allocator;
   for (size_t i = 0; i < output_count; i++) {
-    auto name = (iterator->second).session.GetOutputName(i, allocator);
-    (iterator->second).output_names.push_back(name);
+    auto name = holder->session.GetOutputName(i, allocator);
+    holder->output_names.push_back(name);
     allocator.Free(name);
   }
+
+  if (batching_options_.max_batch_size > 1) {
+    InitializeBatcher(*holder, model_name, model_version);
+  }
+
+  default_logger_->info("Loaded model {} version {} from {}", model_name, model_version, entry.path);
+  return holder;
 }
 
-const std::vector<std::string>& ServerEnvironment::GetModelOutputNames(const std::string& model_name, const std::string& model_version) const {
+std::shared_ptr<ServerEnvironment::SessionHolder> ServerEnvironment::GetModel(const std::string& model_name,
+                                                                              const std::string& model_version) {
   auto identifier = std::make_pair(model_name, model_version);
-  auto it = sessions_.find(identifier);
-  if (it == sessions_.end()) {
-    throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
+  std::shared_ptr<ModelEntry> entry;
+  {
+    std::lock_guard<std::mutex> lock(models_mutex_);
+    auto it = models_.find(identifier);
+    if (it == models_.end()) {
+      throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
+    }
+
+    entry = it->second;
+    if (entry->holder != nullptr) {
+      lru_.splice(lru_.begin(), lru_, entry->lru_position);
+      return entry->holder;
+    }
   }
 
-  return it->second.output_names;
+  // the model is loaded without holding models_mutex_, and another request may have loaded it while this one waited
+  std::lock_guard<std::mutex> load_lock(entry->load_mutex);
+  {
+    std::lock_guard<std::mutex> lock(models_mutex_);
+    if (entry->holder != nullptr) {
+      lru_.splice(lru_.begin(), lru_, entry->lru_position);
+      return entry->holder;
+    }
+  }
+
+  auto holder = LoadModel(*entry, model_name, model_version);
+
+  std::vector<std::shared_ptr<SessionHolder>> evicted;
+  {
+    std::lock_guard<std::mutex> lock(models_mutex_);
+    auto it = models_.find(identifier);
+    if (it == models_.end() || it->second != entry) {
+      // unloaded while it was loading. the session is only used by this request.
+      return holder;
+    }
+
+    entry->holder = holder;
+    lru_.push_front(identifier);
+    entry->lru_position = lru_.begin();
+    loaded_size_ += entry->estimated_size;
+    evicted = EvictModels();
+  }
+
+  return holder;
 }
 
-OrtLoggingLevel ServerEnvironment::GetLogSeverity() const {
-  return severity_;
+void ServerEnvironment::SetMemoryBudget(size_t memory_budget_bytes) {
+  std::vector<std::shared_ptr<SessionHolder>> evicted;
+  std::lock_guard<std::mutex> lock(models_mutex_);
+  memory_budget_bytes_ = memory_budget_bytes;
+  evicted = EvictModels();
+}
+
+std::vector<std::shared_ptr<ServerEnvironment::SessionHolder>> ServerEnvironment::EvictModels() {
+  std::vector<std::shared_ptr<SessionHolder>> evicted;
+  if (memory_budget_bytes_ == 0) {
+    return evicted;
+  }
+
+  while (loaded_size_ > memory_budget_bytes_ && lru_.size() > 1) {
+    const auto identifier = lru_.back();
+    lru_.pop_back();
+
+    auto& entry = *models_.at(identifier);
+    evicted.push_back(std::move(entry.holder));
+    entry.holder = nullptr;
+    loaded_size_ -= entry.estimated_size;
+
+    default_logger_->info("Unloaded model {} version {} to stay within the memory budget of {} bytes",
+                          identifier.first, identifier.second, memory_budget_bytes_);
+  }
+
+  return evicted;
 }
 
-const Ort::Session& ServerEnvironment::GetSession(const std::string& model_name, const std::string& model_version) const {
+void ServerEnvironment::SetBatchingOptions(const BatchingOptions& options) {
+  batching_options_ = options;
+}
+
+void ServerEnvironment::InitializeBatcher(SessionHolder& holder, const std::string& model_name,
+                                          const std::string& model_version) {
+  // requests can only be concatenated if the first dimension of every input is dynamic
+  auto& session = holder.session;
+  for (size_t i = 0, end = session.GetInputCount(); i < end; ++i) {
+    auto type_info = session.GetInputTypeInfo(i);
+    if (type_info.GetONNXType() != ONNX_TYPE_TENSOR) {
+      default_logger_->warn("Batching disabled for model {} version {}: input {} is not a tensor",
+                            model_name, model_version, i);
+      return;
+    }
+
+    auto shape = type_info.GetTensorTypeAndShapeInfo().GetShape();
+    if (shape.empty() || shape[0] != -1) {
+      default_logger_->warn("Batching disabled for model {} version {}: input {} does not have a dynamic batch dimension",
+                            model_name, model_version, i);
+      return;
+    }
+  }
+
+  const auto severity = severity_;
+  holder.batcher = std::make_unique<RequestBatcher>(
+      batching_options_,
+      [&session, severity](const std::vector<std::string>& input_names, std::vector<Ort::Value>& input_values,
+                           const std::vector<std::string>& output_names) {
+        Ort::RunOptions run_options{};
+        run_options.SetRunLogVerbosityLevel(static_cast<int>(severity));
+        run_options.SetRunTag("batch");
+
+        std::vector<const char*> input_ptrs;
+        for (const auto& name : input_names) {
+          input_ptrs.push_back(name.c_str());
+        }
+
+        std::vector<const char*> output_ptrs;
+        for (const auto& name : output_names) {
+          output_ptrs.push_back(name.c_str());
+        }
+
+        return session.Run(run_options, input_ptrs.data(), input_values.data(), input_values.size(),
+                           output_ptrs.data(), output_ptrs.size());
+      });
+
+  default_logger_->info("Batching requests for model {} version {}: max batch size {}, max queue delay {}us",
+                        model_name, model_version, batching_options_.max_batch_size,
+                        batching_options_.max_queue_delay.count());
+}
+
+std::shared_ptr<ServerEnvironment::SessionHolder> ServerEnvironment::GetLoadedModel(const std::string& model_name,
+                                                                                    const std::string& model_version) const {
   auto identifier = std::make_pair(model_name, model_version);
-  auto it = sessions_.find(identifier);
-  if (it == sessions_.end()) {
+  std::lock_guard<std::mutex> lock(models_mutex_);
+  auto it = models_.find(identifier);
+  if (it == models_.end()) {
     throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
   }
 
-  return it->second.session;
+  return it->second->holder;
+}
+
+OrtLoggingLevel ServerEnvironment::GetLogSeverity() const {
+  return severity_;
 }
 
 std::shared_ptr<spdlog::logger> ServerEnvironment::GetLogger(const std::string& request_id) const {
@@ -131,12 +315,22 @@ std::shared_ptr<spdlog::logger> ServerEnvironment::GetAppLogger() const {
 
 void ServerEnvironment::UnloadModel(const std::string& model_name, const std::string& model_version) {
   auto identifier = std::make_pair(model_name, model_version);
-  auto it = sessions_.find(identifier);
-  if (it == sessions_.end()) {
+  // the session is released once the requests using it complete
+  std::shared_ptr<SessionHolder> holder;
+  std::lock_guard<std::mutex> lock(models_mutex_);
+  auto it = models_.find(identifier);
+  if (it == models_.end()) {
     throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
   }
 
-  sessions_.erase(it);
+  auto& entry = *it->second;
+  if (entry.holder != nullptr) {
+    lru_.erase(entry.lru_position);
+    loaded_size_ -= entry.estimated_size;
+    holder = std::move(entry.holder);
+    entry.holder = nullptr;
+  }
+  models_.erase(it);
 }
 
 }  // namespace server
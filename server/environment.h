@@ -3,10 +3,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <list>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "onnxruntime_cxx_api.h"
+#include "batcher.h"
 #include <spdlog/spdlog.h>
 #include <unordered_map>
 #include <boost/functional/hash.hpp>
@@ -14,23 +18,77 @@
 namespace onnxruntime {
 namespace server {
 
+struct ServerEnvironmentOptions {
+  // Size of the intra-op and inter-op thread pools shared by all the models. 0 uses the ORT default.
+  int intra_op_num_threads = 0;
+  int inter_op_num_threads = 0;
+};
+
+// Hosts the models of the server. All the sessions share the thread pools and the CPU arena of one Ort::Env.
 class ServerEnvironment {
  public:
-  explicit ServerEnvironment(OrtLoggingLevel severity, spdlog::sinks_init_list sink);
+  explicit ServerEnvironment(OrtLoggingLevel severity, spdlog::sinks_init_list sink,
+                             const ServerEnvironmentOptions& options = ServerEnvironmentOptions());
   ~ServerEnvironment() = default;
   ServerEnvironment(const ServerEnvironment&) = delete;
 
+  struct SessionHolder {
+    Ort::Session session;
+    std::vector<std::string> output_names;
+    // declared after session so it is destroyed first
+    std::unique_ptr<RequestBatcher> batcher;
+    explicit SessionHolder(Ort::Env& env, std::string path, const Ort::SessionOptions& options) : session(nullptr) {
+      session = Ort::Session(env, path.c_str(), options);
+    };
+    ~SessionHolder() = default;
+    SessionHolder(const SessionHolder&) = delete;
+    SessionHolder(const SessionHolder&&) = delete;
+    SessionHolder& operator=(const SessionHolder&) = delete;
+  };
+
   OrtLoggingLevel GetLogSeverity() const;
 
-  const Ort::Session& GetSession(const std::string& model_name, const std::string& model_version) const;
+  // Register a model that is loaded on its first request
+  void RegisterModel(const std::string& model_path, const std::string& model_name, const std::string& model_version);
+  // Register a model and load it now, so errors in the model are reported at startup
   void InitializeModel(const std::string& model_path, const std::string& model_name, const std::string& model_version);
-  const std::vector<std::string>& GetModelOutputNames(const std::string& model_name, const std::string& model_version) const;
+  // Unload and unregister a model
+  void UnloadModel(const std::string& model_name, const std::string& model_version);
+
+  // Returns the model, loading it if it isn't loaded. Throws ORT_NO_MODEL if the model isn't registered.
+  // The session stays valid while the returned pointer is held, even if the model is unloaded in the meantime.
+  std::shared_ptr<SessionHolder> GetModel(const std::string& model_name, const std::string& model_version);
+  // Returns nullptr if the registered model is not loaded at the moment
+  std::shared_ptr<SessionHolder> GetLoadedModel(const std::string& model_name, const std::string& model_version) const;
+
   std::shared_ptr<spdlog::logger> GetLogger(const std::string& request_id) const;
   std::shared_ptr<spdlog::logger> GetAppLogger() const;
-  void UnloadModel(const std::string& model_name, const std::string& model_version);
   void RegisterExecutionProviders();
 
+  // Batching options for models loaded after this call
+  void SetBatchingOptions(const BatchingOptions& options);
+  // Maximum estimated memory of the loaded models in bytes. Least recently used models are unloaded to stay within
+  // it and reloaded on their next request. 0 keeps all the models loaded, which is the default.
+  void SetMemoryBudget(size_t memory_budget_bytes);
+
+  // Whether the server is ready for traffic, which the health endpoints report. Requests are served either way.
+  // Ready by default, the server marks itself not ready while the models warm up.
+  void SetReady(bool ready) { ready_ = ready; }
+  bool IsReady() const { return ready_; }
+
  private:
+  using ModelKey = std::pair<std::string, std::string>;
+
+  struct ModelEntry {
+    std::string path;
+    // size of the model file, which is dominated by the initializers the session keeps in memory
+    size_t estimated_size = 0;
+    std::shared_ptr<SessionHolder> holder;  // nullptr while the model is unloaded
+    std::list<ModelKey>::iterator lru_position;  // valid while the model is loaded
+    // serializes the loads of this model, so they don't block the requests for other models
+    std::mutex load_mutex;
+  };
+
   const OrtLoggingLevel severity_;
   const std::string logger_id_;
   const std::vector<spdlog::sink_ptr> sink_;
@@ -38,20 +96,22 @@ class ServerEnvironment {
 
   Ort::Env runtime_environment_;
   Ort::SessionOptions options_;
+  bool execution_providers_registered_ = false;
+  BatchingOptions batching_options_;
+  std::atomic<bool> ready_{true};
 
-  struct SessionHolder {
-    Ort::Session session;
-    std::vector<std::string> output_names;
-    explicit SessionHolder(Ort::Env& env, std::string path, const Ort::SessionOptions& options) : session(nullptr) {
-      session = Ort::Session(env, path.c_str(), options);
-    };
-    ~SessionHolder() = default;
-    SessionHolder(const SessionHolder&) = delete;
-    SessionHolder(const SessionHolder&&) = delete;
-    SessionHolder& operator=(const SessionHolder&) = delete;
-  };
+  std::shared_ptr<SessionHolder> LoadModel(const ModelEntry& entry, const std::string& model_name,
+                                           const std::string& model_version);
+  void InitializeBatcher(SessionHolder& holder, const std::string& model_name, const std::string& model_version);
+  // Unload least recently used models until the loaded models fit in the memory budget, except for the most recently
+  // used one. The holders are returned so the sessions are released after models_mutex_ is unlocked.
+  std::vector<std::shared_ptr<SessionHolder>> EvictModels();
 
-  std::unordered_map<std::pair<std::string, std::string>, ServerEnvironment::SessionHolder, boost::hash<std::pair<std::string, std::string>>> sessions_;
+  mutable std::mutex models_mutex_;
+  std::unordered_map<ModelKey, std::shared_ptr<ModelEntry>, boost::hash<ModelKey>> models_;  // protected by models_mutex_
+  std::list<ModelKey> lru_;  // loaded models, most recently used first. protected by models_mutex_
+  size_t loaded_size_ = 0;   // protected by models_mutex_
+  size_t memory_budget_bytes_ = 0;  // protected by models_mutex_
 };
 
 }  // namespace server
@@ -17,12 +17,54 @@ namespace server {
 
 namespace protobufutil = google::protobuf::util;
 
+namespace {
+// raw_data can be used directly if it has the exact size of the tensor and is aligned for the element type.
+// Tensors are stored little endian so it must also be converted on big endian hosts.
+bool CanUseRawDataInPlace(const onnx::TensorProto& tensor) {
+  if (!tensor.has_raw_data() || !IsLittleEndianOrder() ||
+      tensor.data_location() == onnx::TensorProto_DataLocation_EXTERNAL ||
+      tensor.data_type() == onnx::TensorProto_DataType_STRING) {
+    return false;
+  }
+
+  int64_t elements = 1;
+  for (auto dim : tensor.dims()) {
+    if (dim < 0) {
+      return false;
+    }
+
+    elements *= dim;
+  }
+
+  const size_t element_size = RawDataElementSize(static_cast<onnx::TensorProto_DataType>(tensor.data_type()));
+  const auto& raw_data = tensor.raw_data();
+  return element_size != 0 &&
+         raw_data.size() == static_cast<size_t>(elements) * element_size &&
+         reinterpret_cast<uintptr_t>(raw_data.data()) % element_size == 0;
+}
+}  // namespace
+
 protobufutil::Status Executor::SetMLValue(const onnx::TensorProto& input_tensor,
                                           MemBufferArray& buffers,
                                           OrtMemoryInfo* cpu_memory_info,
                                           /* out */ Ort::Value& ml_value) {
   auto logger = env_->GetLogger(request_id_);
 
+  // Use raw_data in place if it is already in the layout ORT expects
+  if (CanUseRawDataInPlace(input_tensor)) {
+    const auto& raw_data = input_tensor.raw_data();
+    std::vector<int64_t> shape(input_tensor.dims().begin(), input_tensor.dims().end());
+    try {
+      ml_value = Ort::Value::CreateTensor(cpu_memory_info, const_cast<char*>(raw_data.data()), raw_data.size(),
+                                          shape.data(), shape.size(), GetTensorElementType(input_tensor));
+    } catch (const Ort::Exception& e) {
+      logger->error("CreateTensor() failed. Message: {}", e.what());
+      return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+    }
+
+    return protobufutil::Status::OK;
+  }
+
   size_t cpu_tensor_length = 0;
   try {
     onnxruntime::server::GetSizeInBytesFromTensorProto<0>(input_tensor, &cpu_tensor_length);
@@ -79,7 +121,7 @@ protobufutil::Status Executor::SetNameMLValueMap(std::vector<std::string>& input
   return protobufutil::Status::OK;
 }
 
-std::vector<Ort::Value> Run(const Ort::Session& session, const Ort::RunOptions& options, const std::vector<std::string>& input_names, const std::vector<Ort::Value>& input_values, const std::vector<std::string>& output_names) {
+static std::vector<Ort::Value> RunSession(const Ort::Session& session, const Ort::RunOptions& options, const std::vector<std::string>& input_names, const std::vector<Ort::Value>& input_values, const std::vector<std::string>& output_names) {
   size_t input_count = input_names.size();
   size_t output_count = output_names.size();
 
@@ -97,17 +139,30 @@ std::vector<Ort::Value> Run(const Ort::Session& session, const Ort::RunOptions&
   return const_cast<Ort::Session&>(session).Run(options, input_ptrs.data(), const_cast<Ort::Value*>(input_values.data()), input_count, output_ptrs.data(), output_count);
 }
 
-protobufutil::Status Executor::Predict(const std::string& model_name,
-                                       const std::string& model_version,
-                                       const onnxruntime::server::PredictRequest& request,
-                                       /* out */ onnxruntime::server::PredictResponse& response) {
-  auto logger = env_->GetLogger(request_id_);
+protobufutil::Status Executor::Run(const std::string& model_name,
+                                   const std::string& model_version,
+                                   const onnxruntime::server::PredictRequest& request,
+                                   /* out */ std::vector<std::string>& output_names,
+                                   /* out */ std::vector<Ort::Value>& outputs) {
+  // Holding the model keeps its session alive for this request even if the model is unloaded in the meantime
+  std::shared_ptr<ServerEnvironment::SessionHolder> model;
+  try {
+    model = env_->GetModel(model_name, model_version);
+  } catch (const Ort::Exception& e) {
+    return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+  }
 
+  return Run(model, request, output_names, outputs);
+}
+
+protobufutil::Status Executor::Run(const std::shared_ptr<ServerEnvironment::SessionHolder>& model,
+                                   const onnxruntime::server::PredictRequest& request,
+                                   /* out */ std::vector<std::string>& output_names,
+                                   /* out */ std::vector<Ort::Value>& outputs) {
   // Convert PredictRequest to NameMLValMap
-  MemBufferArray buffer_array;
   std::vector<std::string> input_names;
   std::vector<Ort::Value> input_values;
-  auto conversion_status = SetNameMLValueMap(input_names, input_values, request, buffer_array);
+  auto conversion_status = SetNameMLValueMap(input_names, input_values, request, buffers_);
   if (conversion_status != protobufutil::Status::OK) {
     return conversion_status;
   }
@@ -117,25 +172,61 @@ protobufutil::Status Executor::Predict(const std::string& model_name,
   run_options.SetRunTag(request_id_.c_str());
 
   // Prepare the output names
-  std::vector<std::string> output_names;
-
+  output_names.clear();
   if (!request.output_filter().empty()) {
     output_names.reserve(request.output_filter_size());
     for (const auto& name : request.output_filter()) {
       output_names.push_back(name);
     }
   } else {
-    output_names = env_->GetModelOutputNames(model_name, model_version);
+    output_names = model->output_names;
   }
 
-  std::vector<Ort::Value> outputs;
   try {
-    outputs = Run(env_->GetSession(model_name, model_version), run_options, input_names, input_values, output_names);
+    if (model->batcher != nullptr) {
+      outputs = model->batcher->Run(input_names, std::move(input_values), output_names);
+    } else {
+      outputs = RunSession(model->session, run_options, input_names, input_values, output_names);
+    }
   } catch (const Ort::Exception& e) {
     return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
   }
 
-  // Build the response
+  return protobufutil::Status::OK;
+}
+
+protobufutil::Status Executor::Predict(const std::string& model_name,
+                                       const std::string& model_version,
+                                       const onnxruntime::server::PredictRequest& request,
+                                       /* out */ onnxruntime::server::PredictResponse& response) {
+  std::vector<std::string> output_names;
+  std::vector<Ort::Value> outputs;
+  auto status = Run(model_name, model_version, request, output_names, outputs);
+  if (!status.ok()) {
+    return status;
+  }
+
+  return BuildResponse(output_names, outputs, response);
+}
+
+protobufutil::Status Executor::Predict(const std::shared_ptr<ServerEnvironment::SessionHolder>& model,
+                                       const onnxruntime::server::PredictRequest& request,
+                                       /* out */ onnxruntime::server::PredictResponse& response) {
+  std::vector<std::string> output_names;
+  std::vector<Ort::Value> outputs;
+  auto status = Run(model, request, output_names, outputs);
+  if (!status.ok()) {
+    return status;
+  }
+
+  return BuildResponse(output_names, outputs, response);
+}
+
+protobufutil::Status Executor::BuildResponse(const std::vector<std::string>& output_names,
+                                             std::vector<Ort::Value>& outputs,
+                                             /* out */ onnxruntime::server::PredictResponse& response) {
+  auto logger = env_->GetLogger(request_id_);
+
   for (size_t i = 0, sz = outputs.size(); i < sz; ++i) {
     onnx::TensorProto output_tensor{};
     try {
@@ -25,10 +25,37 @@ class Executor {
                                          const onnxruntime::server::PredictRequest& request,
                                          /* out */ onnxruntime::server::PredictResponse& response);
 
+  // Runs the model and returns the outputs without converting them to TensorProto.
+  // Inputs with raw_data may be used in place, so the request must outlive the outputs as an output can alias
+  // an input. Input buffers that had to be copied are owned by the executor.
+  google::protobuf::util::Status Run(const std::string& model_name,
+                                     const std::string& model_version,
+                                     const onnxruntime::server::PredictRequest& request,
+                                     /* out */ std::vector<std::string>& output_names,
+                                     /* out */ std::vector<Ort::Value>& outputs);
+
+  // Same as Run and Predict, for a model the caller holds, e.g. for all the requests of a stream
+  google::protobuf::util::Status Run(const std::shared_ptr<ServerEnvironment::SessionHolder>& model,
+                                     const onnxruntime::server::PredictRequest& request,
+                                     /* out */ std::vector<std::string>& output_names,
+                                     /* out */ std::vector<Ort::Value>& outputs);
+  google::protobuf::util::Status Predict(const std::shared_ptr<ServerEnvironment::SessionHolder>& model,
+                                         const onnxruntime::server::PredictRequest& request,
+                                         /* out */ onnxruntime::server::PredictResponse& response);
+
+  // Convert the outputs returned by Run to a PredictResponse
+  google::protobuf::util::Status BuildResponse(const std::vector<std::string>& output_names,
+                                               std::vector<Ort::Value>& outputs,
+                                               /* out */ onnxruntime::server::PredictResponse& response);
+
+  // True if all the inputs of the last request used raw_data, in which case the outputs are returned in raw_data
+  bool UsingRawData() const { return using_raw_data_; }
+
  private:
   ServerEnvironment* env_;
   const std::string request_id_;
   bool using_raw_data_;
+  MemBufferArray buffers_;
 
   google::protobuf::util::Status SetMLValue(const onnx::TensorProto& input_tensor,
                                             MemBufferArray& buffers,
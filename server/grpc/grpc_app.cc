@@ -18,7 +18,13 @@ GRPCApp::GRPCApp(const std::shared_ptr<onnxruntime::server::ServerEnvironment>&
   builder.AddListeningPort(host + ":" + std::to_string(port), ::grpc::InsecureServerCredentials());
 
   server_ = builder.BuildAndStart();
-  server_->GetHealthCheckService()->SetServingStatus(PredictionService::service_full_name(), true);
+  // not serving while the models warm up
+  SetServing(env->IsReady());
+}
+
+void GRPCApp::SetServing(bool serving) {
+  server_->GetHealthCheckService()->SetServingStatus(serving);
+  server_->GetHealthCheckService()->SetServingStatus(PredictionService::service_full_name(), serving);
 }
 
 void GRPCApp::Run() {
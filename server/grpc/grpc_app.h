@@ -20,6 +20,9 @@ class GRPCApp {
   //Block until the server shuts down.
   void Run();
 
+  // Set the status reported by the gRPC health check service
+  void SetServing(bool serving);
+
  private:
   grpc::PredictionServiceImpl prediction_service_implementation_;
   std::unique_ptr<::grpc::Server> server_;
@@ -8,19 +8,68 @@ namespace onnxruntime {
 namespace server {
 namespace grpc {
 
+namespace {
+// Client metadata that selects the model of a request, like the model name and version of the HTTP routes
+const char* const kModelNameMetadata = "model-name";
+const char* const kModelVersionMetadata = "model-version";
+
+std::string GetMetadata(::grpc::ServerContext* context, const char* key, const char* default_value) {
+  const auto& metadata = context->client_metadata();
+  auto search = metadata.find(key);
+  if (search == metadata.end()) {
+    return default_value;
+  }
+
+  return std::string(search->second.data(), search->second.length());
+}
+}  // namespace
+
 PredictionServiceImpl::PredictionServiceImpl(const std::shared_ptr<onnxruntime::server::ServerEnvironment>& env) : environment_(env) {}
 
 ::grpc::Status PredictionServiceImpl::Predict(::grpc::ServerContext* context, const ::onnxruntime::server::PredictRequest* request, ::onnxruntime::server::PredictResponse* response) {
   auto request_id = SetRequestContext(context);
   onnxruntime::server::Executor executor(environment_.get(), request_id);
-  //TODO: (csteegz) Add modelspec for both paths.
-  auto status = executor.Predict("default", "1", *request, *response);  // Currently only support one model so hard coded.
+  auto status = executor.Predict(GetMetadata(context, kModelNameMetadata, "default"),
+                                 GetMetadata(context, kModelVersionMetadata, "1"), *request, *response);
   if (!status.ok()) {
     return ::grpc::Status(::grpc::StatusCode(status.error_code()), status.error_message());
   }
   return ::grpc::Status::OK;
 }
 
+::grpc::Status PredictionServiceImpl::PredictStream(::grpc::ServerContext* context,
+                                                    ::grpc::ServerReaderWriter<::onnxruntime::server::PredictResponse, ::onnxruntime::server::PredictRequest>* stream) {
+  auto request_id = SetRequestContext(context);
+
+  // The stream holds the model, so its requests don't look it up and keep using the same session
+  // even if the model is unloaded in the meantime
+  std::shared_ptr<ServerEnvironment::SessionHolder> model;
+  try {
+    model = environment_->GetModel(GetMetadata(context, kModelNameMetadata, "default"),
+                                   GetMetadata(context, kModelVersionMetadata, "1"));
+  } catch (const Ort::Exception& e) {
+    auto status = GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+    return ::grpc::Status(::grpc::StatusCode(status.error_code()), status.error_message());
+  }
+
+  ::onnxruntime::server::PredictRequest request;
+  while (stream->Read(&request)) {
+    onnxruntime::server::Executor executor(environment_.get(), request_id);
+    ::onnxruntime::server::PredictResponse response;
+    auto status = executor.Predict(model, request, response);
+    if (!status.ok()) {
+      return ::grpc::Status(::grpc::StatusCode(status.error_code()), status.error_message());
+    }
+
+    if (!stream->Write(response)) {
+      // the client cancelled the stream
+      break;
+    }
+  }
+
+  return ::grpc::Status::OK;
+}
+
 std::string PredictionServiceImpl::SetRequestContext(::grpc::ServerContext* context) {
   auto metadata = context->client_metadata();
   auto request_id = util::InternalRequestId();
@@ -14,6 +14,8 @@ class PredictionServiceImpl final : public onnxruntime::server::PredictionServic
  public:
   PredictionServiceImpl(const std::shared_ptr<onnxruntime::server::ServerEnvironment>& env);
   ::grpc::Status Predict(::grpc::ServerContext* context, const ::onnxruntime::server::PredictRequest* request, ::onnxruntime::server::PredictResponse* response);
+  ::grpc::Status PredictStream(::grpc::ServerContext* context,
+                               ::grpc::ServerReaderWriter<::onnxruntime::server::PredictResponse, ::onnxruntime::server::PredictRequest>* stream);
 
  private:
   std::shared_ptr<onnxruntime::server::ServerEnvironment> environment_;
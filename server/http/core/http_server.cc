@@ -49,6 +49,11 @@ App& App::RegisterPost(const std::string& route, const HandlerFn& fn) {
   return *this;
 }
 
+App& App::RegisterGet(const std::string& route, const HandlerFn& fn) {
+  routes_.RegisterController(http::verb::get, route, fn);
+  return *this;
+}
+
 App& App::RegisterError(const ErrorFn& fn) {
   routes_.RegisterErrorCallback(fn);
   return *this;
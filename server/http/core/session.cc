@@ -35,7 +35,12 @@ void HttpSession::OnRead(beast::error_code ec, std::size_t bytes_transferred) {
 
   // This means they closed the connection
   if (ec == http::error::end_of_stream) {
-    return DoClose();
+    // answer the pipelined requests that were already read before closing
+    stop_reading_ = true;
+    if (responses_.empty()) {
+      DoClose();
+    }
+    return;
   }
 
   if (ec) {
@@ -45,6 +50,11 @@ void HttpSession::OnRead(beast::error_code ec, std::size_t bytes_transferred) {
 
   // Send the response
   HandleRequest(req_->release());
+
+  // Read the next pipelined request while the responses are written, unless too many of them are waiting
+  if (!stop_reading_ && responses_.size() < kMaxQueuedResponses) {
+    DoRead();
+  }
 }
 
 void HttpSession::OnWrite(beast::error_code ec, std::size_t bytes_transferred, bool close) {
@@ -62,10 +72,19 @@ void HttpSession::OnWrite(beast::error_code ec, std::size_t bytes_transferred, b
   }
 
   // We're done with the response so delete it
-  res_ = nullptr;
+  const bool was_full = responses_.size() == kMaxQueuedResponses;
+  responses_.pop_front();
 
-  // Read another request
-  DoRead();
+  if (!responses_.empty()) {
+    DoWrite();
+  } else if (stop_reading_) {
+    return DoClose();
+  }
+
+  // Read another request if reading stopped because the queue was full
+  if (was_full && !stop_reading_) {
+    DoRead();
+  }
 }
 
 void HttpSession::DoClose() {
@@ -76,17 +95,22 @@ void HttpSession::DoClose() {
   // At this point the connection is closed gracefully
 }
 
-template <class Msg>
-void HttpSession::Send(Msg&& msg) {
-  using item_type = std::remove_reference_t<decltype(msg)>;
+void HttpSession::Send(http::response<http::string_body>&& res) {
+  // no more requests are read after a response that closes the connection
+  stop_reading_ = stop_reading_ || res.need_eof();
 
-  auto ptr = std::make_shared<item_type>(std::move(msg));
-  auto self_ = shared_from_this();
-  self_->res_ = ptr;
+  responses_.push_back(std::move(res));
+  if (responses_.size() == 1) {
+    DoWrite();
+  }
+}
 
-  http::async_write(self_->socket_, *ptr,
+void HttpSession::DoWrite() {
+  auto self_ = shared_from_this();
+  auto& res = responses_.front();
+  http::async_write(socket_, res,
                     net::bind_executor(strand_,
-                                       [self_, close = ptr->need_eof()](beast::error_code ec, std::size_t bytes) {
+                                       [self_, close = res.need_eof()](beast::error_code ec, std::size_t bytes) {
                                          self_->OnWrite(ec, bytes, close);
                                        }));
 }
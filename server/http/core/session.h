@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <deque>
 #include <memory>
 #include <boost/beast/version.hpp>
 #include <boost/asio/bind_executor.hpp>
@@ -35,21 +36,29 @@ class HttpSession : public std::enable_shared_from_this<HttpSession> {
   }
 
  private:
+  // Number of pipelined requests whose responses may wait to be written before the session stops reading requests
+  static constexpr size_t kMaxQueuedResponses = 8;
+
   const Routes routes_;
   tcp::socket socket_;
   net::strand<net::io_context::executor_type> strand_;
   beast::flat_buffer buffer_;
   boost::optional<http::request_parser<http::string_body>> req_;
-  std::shared_ptr<void> res_{nullptr};
 
-  // Writes the message asynchronously back to the socket
-  // Stores the pointer to the message and the class itself so that
-  // They do not get destructed before the async process is finished
-  // If you pass shared_from_this() are guaranteed that the life time
-  // of your object will be extended to as long as the function needs it
+  // Responses in the order of their requests. The front one is being written.
+  std::deque<http::response<http::string_body>> responses_;
+  // True once the queued responses are the last ones of the connection
+  bool stop_reading_ = false;
+
+  // Queues the response and writes it once the responses of the previous requests are written, so that pipelined
+  // requests are answered in order. The next request is read while the responses are written.
+  void Send(http::response<http::string_body>&& res);
+
+  // Writes the front response asynchronously back to the socket
+  // Passing shared_from_this() to the handler guarantees that the life time
+  // of the session and the queued response is extended to as long as the write needs it
   // Most examples in boost::asio are based on this logic
-  template <class Msg>
-  void Send(Msg&& msg);
+  void DoWrite();
 
   // Called after the session is finished reading the message
   // Should set the response before calling Send
@@ -67,7 +76,7 @@ class HttpSession : public std::enable_shared_from_this<HttpSession> {
   // Perform error checking before handing off to HandleRequest
   void OnRead(beast::error_code ec, std::size_t bytes_transferred);
 
-  // After writing, make the session read another request
+  // After writing, write the next queued response and resume reading if the queue was full
   void OnWrite(beast::error_code ec, std::size_t bytes_transferred, bool close);
 
   // Close the connection
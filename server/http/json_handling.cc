@@ -1,13 +1,22 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#include <sstream>
+#include <algorithm>
+#include <cerrno>
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iomanip>
+#include <limits>
+#include <sstream>
 
 #include <boost/beast/core.hpp>
 #include <google/protobuf/util/json_util.h>
 
 #include "predict.pb.h"
+#include "converter.h"
 #include "json_handling.h"
 
 namespace protobufutil = google::protobuf::util;
@@ -15,7 +24,870 @@ namespace protobufutil = google::protobuf::util;
 namespace onnxruntime {
 namespace server {
 
+namespace {
+
+const char kBase64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// Value of each character in the standard or the web safe base64 alphabet, -1 for other characters
+struct Base64DecodingTable {
+  int8_t values[256];
+  Base64DecodingTable() {
+    std::fill(std::begin(values), std::end(values), int8_t{-1});
+    for (int i = 0; i < 64; ++i) {
+      values[static_cast<unsigned char>(kBase64Chars[i])] = static_cast<int8_t>(i);
+    }
+    values[static_cast<unsigned char>('-')] = 62;
+    values[static_cast<unsigned char>('_')] = 63;
+  }
+};
+
+const Base64DecodingTable kBase64Decoding;
+
+// Powers of ten from 1e-33 to 1e53, the range needed to scale any float to 9 significant digits
+const double kPowersOfTen[] = {
+    1e-33, 1e-32, 1e-31, 1e-30, 1e-29, 1e-28, 1e-27, 1e-26, 1e-25, 1e-24, 1e-23, 1e-22, 1e-21, 1e-20, 1e-19,
+    1e-18, 1e-17, 1e-16, 1e-15, 1e-14, 1e-13, 1e-12, 1e-11, 1e-10, 1e-9, 1e-8, 1e-7, 1e-6, 1e-5, 1e-4,
+    1e-3, 1e-2, 1e-1, 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22, 1e23, 1e24, 1e25, 1e26,
+    1e27, 1e28, 1e29, 1e30, 1e31, 1e32, 1e33, 1e34, 1e35, 1e36, 1e37, 1e38, 1e39, 1e40, 1e41,
+    1e42, 1e43, 1e44, 1e45, 1e46, 1e47, 1e48, 1e49, 1e50, 1e51, 1e52, 1e53};
+const int kMinPowerOfTen = -33;
+const int kMaxPowerOfTen = 53;
+
+double PowerOfTen(int exponent) {
+  return kPowersOfTen[exponent - kMinPowerOfTen];
+}
+
+// Parses the requests that only use the usual subset of the protobuf JSON mapping, straight into the PredictRequest.
+// Parse returns false for anything else, including malformed JSON, so the request can be parsed again by protobuf,
+// which gives the same result for the requests this parser accepts and reports the errors.
+class RequestParser {
+ public:
+  explicit RequestParser(const std::string& json) : p_(json.data()), end_(json.data() + json.size()) {}
+
+  bool Parse(/* out */ PredictRequest& request) {
+    bool seen_inputs = false;
+    bool seen_output_filter = false;
+    bool parsed = ParseObject([&](const std::string& key) {
+      if (key == "inputs" && !seen_inputs) {
+        seen_inputs = true;
+        return ParseInputs(*request.mutable_inputs());
+      }
+      if (key == "outputFilter" && !seen_output_filter) {
+        seen_output_filter = true;
+        return ParseArray([&]() { return ParseString(*request.add_output_filter()); });
+      }
+      // unknown fields and the alternative field names are left to protobuf
+      return false;
+    });
+
+    SkipWhitespace();
+    return parsed && p_ == end_;
+  }
+
+ private:
+  const char* p_;
+  const char* end_;
+
+  void SkipWhitespace() {
+    while (p_ != end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t')) {
+      ++p_;
+    }
+  }
+
+  bool Consume(char c) {
+    SkipWhitespace();
+    if (p_ == end_ || *p_ != c) {
+      return false;
+    }
+    ++p_;
+    return true;
+  }
+
+  bool Peek(char c) {
+    SkipWhitespace();
+    return p_ != end_ && *p_ == c;
+  }
+
+  // Calls parse_member(key) with p_ at the value of each member
+  template <typename ParseMember>
+  bool ParseObject(ParseMember parse_member) {
+    if (!Consume('{')) {
+      return false;
+    }
+    if (Consume('}')) {
+      return true;
+    }
+    std::string key;
+    do {
+      SkipWhitespace();
+      if (!ParseString(key) || !Consume(':') || !parse_member(key)) {
+        return false;
+      }
+    } while (Consume(','));
+    return Consume('}');
+  }
+
+  template <typename ParseElement>
+  bool ParseArray(ParseElement parse_element) {
+    if (!Consume('[')) {
+      return false;
+    }
+    if (Consume(']')) {
+      return true;
+    }
+    do {
+      SkipWhitespace();
+      if (!parse_element()) {
+        return false;
+      }
+    } while (Consume(','));
+    return Consume(']');
+  }
+
+  // ASCII strings with the usual escapes. protobuf validates UTF-8 and \u escapes.
+  bool ParseString(/* out */ std::string& value) {
+    if (!Consume('"')) {
+      return false;
+    }
+    value.clear();
+    for (;;) {
+      const char* start = p_;
+      while (p_ != end_ && *p_ != '"' && *p_ != '\\' && static_cast<unsigned char>(*p_) >= 0x20 &&
+             static_cast<unsigned char>(*p_) < 0x80) {
+        ++p_;
+      }
+      value.append(start, p_);
+      if (p_ == end_) {
+        return false;
+      }
+      if (*p_ == '"') {
+        ++p_;
+        return true;
+      }
+      if (*p_ != '\\' || ++p_ == end_) {
+        return false;
+      }
+      switch (*p_++) {
+        case '"':
+          value += '"';
+          break;
+        case '\\':
+          value += '\\';
+          break;
+        case '/':
+          value += '/';
+          break;
+        case 'b':
+          value += '\b';
+          break;
+        case 'f':
+          value += '\f';
+          break;
+        case 'n':
+          value += '\n';
+          break;
+        case 'r':
+          value += '\r';
+          break;
+        case 't':
+          value += '\t';
+          break;
+        default:
+          return false;
+      }
+    }
+  }
+
+  // Base64 in the standard or the web safe alphabet, with or without padding
+  bool ParseBase64(/* out */ std::string& value) {
+    if (!Consume('"')) {
+      return false;
+    }
+    const char* start = p_;
+    while (p_ != end_ && *p_ != '"') {
+      ++p_;
+    }
+    if (p_ == end_) {
+      return false;
+    }
+    const char* stop = p_++;
+
+    size_t length = stop - start;
+    if (length % 4 == 0 && length > 0 && stop[-1] == '=') {
+      length -= stop[-2] == '=' ? 2 : 1;
+    }
+    if (length % 4 == 1) {
+      return false;
+    }
+
+    value.resize(length / 4 * 3 + (length % 4 == 0 ? 0 : length % 4 - 1));
+    auto* out = &value[0];
+    uint32_t bits = 0;
+    for (size_t i = 0; i < length; ++i) {
+      const int8_t digit = kBase64Decoding.values[static_cast<unsigned char>(start[i])];
+      if (digit < 0) {
+        return false;
+      }
+      bits = (bits << 6) | static_cast<uint32_t>(digit);
+      if (i % 4 == 3) {
+        *out++ = static_cast<char>(bits >> 16);
+        *out++ = static_cast<char>(bits >> 8);
+        *out++ = static_cast<char>(bits);
+        bits = 0;
+      }
+    }
+
+    // the unused bits of the last digit must be 0
+    switch (length % 4) {
+      case 2:
+        if ((bits & 0xF) != 0) {
+          return false;
+        }
+        *out++ = static_cast<char>(bits >> 4);
+        break;
+      case 3:
+        if ((bits & 0x3) != 0) {
+          return false;
+        }
+        *out++ = static_cast<char>(bits >> 10);
+        *out++ = static_cast<char>(bits >> 2);
+        break;
+      default:
+        break;
+    }
+    return true;
+  }
+
+  // Scans a JSON number, and returns its digits without the leading zeros of the integer part, and the exponent of
+  // the last digit. integral is set if the number has neither a fraction nor an exponent.
+  bool ScanNumber(/* out */ bool& negative, /* out */ uint64_t& mantissa, /* out */ int& digit_count,
+                  /* out */ int& exponent, /* out */ bool& integral) {
+    negative = p_ != end_ && *p_ == '-';
+    if (negative) {
+      ++p_;
+    }
+    if (p_ == end_ || *p_ < '0' || *p_ > '9') {
+      return false;
+    }
+
+    mantissa = 0;
+    digit_count = 0;
+    exponent = 0;
+    auto add_digit = [&](char c) {
+      if (digit_count < 19) {
+        mantissa = mantissa * 10 + static_cast<uint64_t>(c - '0');
+        if (mantissa != 0) {
+          ++digit_count;
+        }
+      } else {
+        // the digits that don't fit only matter for long numbers, which are left to protobuf
+        ++digit_count;
+      }
+    };
+
+    if (*p_ == '0') {
+      ++p_;
+    } else {
+      while (p_ != end_ && *p_ >= '0' && *p_ <= '9') {
+        add_digit(*p_++);
+      }
+    }
+
+    integral = true;
+    if (p_ != end_ && *p_ == '.') {
+      integral = false;
+      ++p_;
+      if (p_ == end_ || *p_ < '0' || *p_ > '9') {
+        return false;
+      }
+      while (p_ != end_ && *p_ >= '0' && *p_ <= '9') {
+        add_digit(*p_++);
+        --exponent;
+      }
+    }
+
+    if (p_ != end_ && (*p_ == 'e' || *p_ == 'E')) {
+      integral = false;
+      ++p_;
+      bool negative_exponent = p_ != end_ && *p_ == '-';
+      if (p_ != end_ && (*p_ == '-' || *p_ == '+')) {
+        ++p_;
+      }
+      if (p_ == end_ || *p_ < '0' || *p_ > '9') {
+        return false;
+      }
+      int explicit_exponent = 0;
+      while (p_ != end_ && *p_ >= '0' && *p_ <= '9') {
+        if (explicit_exponent < 10000) {
+          explicit_exponent = explicit_exponent * 10 + (*p_ - '0');
+        }
+        ++p_;
+      }
+      exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+    }
+
+    return true;
+  }
+
+  // protobuf accepts integers as numbers or strings
+  template <typename T>
+  bool ParseInteger(/* out */ T& value) {
+    const bool quoted = Consume('"');
+    if (!quoted) {
+      SkipWhitespace();
+    }
+
+    bool negative;
+    uint64_t mantissa;
+    int digit_count;
+    int exponent;
+    bool integral;
+    if (!ScanNumber(negative, mantissa, digit_count, exponent, integral) || !integral || digit_count >= 19 ||
+        (quoted && !Consume('"'))) {
+      return false;
+    }
+
+    // a 18 digits mantissa fits in int64_t
+    const int64_t signed_value = negative ? -static_cast<int64_t>(mantissa) : static_cast<int64_t>(mantissa);
+    if (signed_value < static_cast<int64_t>(std::numeric_limits<T>::min()) ||
+        (signed_value > 0 && static_cast<uint64_t>(signed_value) > static_cast<uint64_t>(std::numeric_limits<T>::max()))) {
+      return false;
+    }
+    value = static_cast<T>(signed_value);
+    return true;
+  }
+
+  // Numbers, and the "NaN", "Infinity" and "-Infinity" strings of the protobuf JSON mapping
+  template <typename T>
+  bool ParseFloatingPoint(/* out */ T& value) {
+    if (Peek('"')) {
+      std::string special;
+      if (!ParseString(special)) {
+        return false;
+      }
+      if (special == "NaN") {
+        value = std::numeric_limits<T>::quiet_NaN();
+      } else if (special == "Infinity") {
+        value = std::numeric_limits<T>::infinity();
+      } else if (special == "-Infinity") {
+        value = -std::numeric_limits<T>::infinity();
+      } else {
+        return false;
+      }
+      return true;
+    }
+
+    const char* start = p_;
+    bool negative;
+    uint64_t mantissa;
+    int digit_count;
+    int exponent;
+    bool integral;
+    if (!ScanNumber(negative, mantissa, digit_count, exponent, integral)) {
+      return false;
+    }
+
+    double number;
+    if (integral) {
+      // protobuf parses these as integers, so -0 is 0
+      if (digit_count > 15) {
+        return false;
+      }
+      number = negative && mantissa != 0 ? -static_cast<double>(mantissa) : static_cast<double>(mantissa);
+    } else if (digit_count <= 15 && exponent >= -22 && exponent <= 22) {
+      // the mantissa and the power of ten are exact, so the result is correctly rounded
+      number = exponent < 0 ? static_cast<double>(mantissa) / PowerOfTen(-exponent)
+                            : static_cast<double>(mantissa) * PowerOfTen(exponent);
+      if (negative) {
+        number = -number;
+      }
+    } else {
+      std::string token(start, p_);
+      char* token_end = nullptr;
+      number = std::strtod(token.c_str(), &token_end);
+      if (token_end != token.c_str() + token.size() || std::isinf(number)) {
+        return false;
+      }
+    }
+
+    // protobuf rejects numbers out of the range of the type rather than rounding them to infinity
+    if (std::fabs(number) > static_cast<double>(std::numeric_limits<T>::max())) {
+      return false;
+    }
+    value = static_cast<T>(number);
+    return true;
+  }
+
+  template <typename Repeated, typename ParseElement>
+  bool ParseRepeated(Repeated& field, ParseElement parse_element) {
+    return ParseArray([&]() {
+      typename Repeated::value_type element;
+      if (!parse_element(element)) {
+        return false;
+      }
+      field.Add(element);
+      return true;
+    });
+  }
+
+  bool ParseInputs(google::protobuf::Map<std::string, onnx::TensorProto>& inputs) {
+    return ParseObject([&](const std::string& name) {
+      if (inputs.count(name) != 0) {
+        return false;
+      }
+      return ParseTensor(inputs[name]);
+    });
+  }
+
+  bool ParseTensor(onnx::TensorProto& tensor) {
+    // the tensor fields, which protobuf concatenates when they are repeated
+    uint32_t seen_fields = 0;
+    return ParseObject([&](const std::string& key) {
+      static const char* const kFieldNames[] = {"dims", "dataType", "floatData", "int32Data", "stringData", "int64Data",
+                                                "name", "rawData", "doubleData", "uint64Data", "docString"};
+      const auto* field = std::find_if(std::begin(kFieldNames), std::end(kFieldNames),
+                                       [&key](const char* field_name) { return key == field_name; });
+      const auto field_index = static_cast<uint32_t>(field - std::begin(kFieldNames));
+      if (field == std::end(kFieldNames) || (seen_fields & (1u << field_index)) != 0) {
+        return false;
+      }
+      seen_fields |= 1u << field_index;
+
+      switch (field_index) {
+        case 0:
+          return ParseRepeated(*tensor.mutable_dims(), [&](int64_t& v) { return ParseInteger(v); });
+        case 1: {
+          int32_t data_type;
+          if (!ParseInteger(data_type)) {
+            return false;
+          }
+          tensor.set_data_type(data_type);
+          return true;
+        }
+        case 2:
+          return ParseRepeated(*tensor.mutable_float_data(), [&](float& v) { return ParseFloatingPoint(v); });
+        case 3:
+          return ParseRepeated(*tensor.mutable_int32_data(), [&](int32_t& v) { return ParseInteger(v); });
+        case 4:
+          return ParseArray([&]() { return ParseBase64(*tensor.add_string_data()); });
+        case 5:
+          return ParseRepeated(*tensor.mutable_int64_data(), [&](int64_t& v) { return ParseInteger(v); });
+        case 6:
+          return ParseString(*tensor.mutable_name());
+        case 7:
+          return ParseBase64(*tensor.mutable_raw_data());
+        case 8:
+          return ParseRepeated(*tensor.mutable_double_data(), [&](double& v) { return ParseFloatingPoint(v); });
+        case 9:
+          return ParseRepeated(*tensor.mutable_uint64_data(), [&](uint64_t& v) { return ParseInteger(v); });
+        default:
+          return ParseString(*tensor.mutable_doc_string());
+      }
+    });
+  }
+};
+
+void AppendUnsigned(uint64_t value, std::string& out) {
+  char buffer[20];
+  char* p = std::end(buffer);
+  do {
+    *--p = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  out.append(p, std::end(buffer));
+}
+
+void AppendInteger(int64_t value, std::string& out) {
+  if (value < 0) {
+    out += '-';
+    AppendUnsigned(0 - static_cast<uint64_t>(value), out);
+  } else {
+    AppendUnsigned(static_cast<uint64_t>(value), out);
+  }
+}
+
+// Appends what printf("%.<precision>g") prints for the number with the given significant digits, i.e.
+// digits * 10^(exponent - digit_count + 1)
+void AppendGeneralFormat(uint64_t digits, int digit_count, int exponent, int precision, std::string& out) {
+  while (digit_count > 1 && digits % 10 == 0) {
+    digits /= 10;
+    --digit_count;
+  }
+  char digit_chars[20];
+  for (int i = digit_count - 1; i >= 0; --i) {
+    digit_chars[i] = static_cast<char>('0' + digits % 10);
+    digits /= 10;
+  }
+
+  if (exponent < -4 || exponent >= precision) {
+    out += digit_chars[0];
+    if (digit_count > 1) {
+      out += '.';
+      out.append(digit_chars + 1, digit_count - 1);
+    }
+    out += 'e';
+    out += exponent < 0 ? '-' : '+';
+    const int magnitude = exponent < 0 ? -exponent : exponent;
+    if (magnitude < 10) {
+      out += '0';
+    }
+    AppendUnsigned(static_cast<uint64_t>(magnitude), out);
+  } else if (exponent < 0) {
+    out += "0.";
+    out.append(static_cast<size_t>(-exponent - 1), '0');
+    out.append(digit_chars, digit_count);
+  } else if (digit_count <= exponent + 1) {
+    out.append(digit_chars, digit_count);
+    out.append(static_cast<size_t>(exponent + 1 - digit_count), '0');
+  } else {
+    out.append(digit_chars, exponent + 1);
+    out += '.';
+    out.append(digit_chars + exponent + 1, digit_count - exponent - 1);
+  }
+}
+
+// Rounds the positive, finite value to precision significant digits. Returns false if the value is too close to
+// halfway between two roundings for the double arithmetic to be sure which one printf would choose.
+bool RoundToSignificantDigits(double value, int precision, /* out */ uint64_t& digits, /* out */ int& exponent) {
+  const double lower = PowerOfTen(precision - 1);
+  const double upper = PowerOfTen(precision);
+  auto scale = [&](int e, double& scaled) {
+    const int power = precision - 1 - e;
+    if (power < kMinPowerOfTen || power > kMaxPowerOfTen) {
+      return false;
+    }
+    scaled = value * PowerOfTen(power);
+    return true;
+  };
+
+  // value is in [2^(binary_exponent - 1), 2^binary_exponent), so this is the decimal exponent or one less
+  int binary_exponent;
+  std::frexp(value, &binary_exponent);
+  exponent = static_cast<int>(std::floor((binary_exponent - 1) * 0.30102999566398120));
+  double scaled;
+  if (!scale(exponent, scaled)) {
+    return false;
+  }
+  if (scaled < lower) {
+    --exponent;
+  } else if (scaled >= upper) {
+    ++exponent;
+  }
+  if (!scale(exponent, scaled) || scaled < lower || scaled >= upper) {
+    return false;
+  }
+
+  const double integer_part = std::floor(scaled);
+  const double fraction = scaled - integer_part;
+  if (std::fabs(fraction - 0.5) < 1e-6) {
+    return false;
+  }
+  digits = static_cast<uint64_t>(integer_part) + (fraction > 0.5 ? 1 : 0);
+  if (static_cast<double>(digits) >= upper) {
+    digits /= 10;
+    ++exponent;
+  }
+  return true;
+}
+
+// Same as protobuf's SimpleFtoa, which the protobuf JSON printer uses for floats. Like protobuf's safe_strtof, the
+// check fails on the range errors strtof reports for subnormal numbers.
+void AppendFloatAsProtobuf(float value, std::string& out) {
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.*g", FLT_DIG, value);
+  errno = 0;
+  const float parsed = std::strtof(buffer, nullptr);
+  if (errno != 0 || parsed != value) {
+    snprintf(buffer, sizeof(buffer), "%.*g", FLT_DIG + 3, value);
+  }
+  out += buffer;
+}
+
+// Appends the float the way the protobuf JSON printer does: the shortest of the 6 and 9 significant digits forms
+// that parses back to the same float, or the NaN and infinity strings. The digits are computed with double
+// arithmetic, which is exact enough except close to rounding boundaries where printf is used.
+void AppendFloat(float value, std::string& out) {
+  if (!std::isfinite(value)) {
+    out += std::isnan(value) ? "\"NaN\"" : value > 0 ? "\"Infinity\"" : "\"-Infinity\"";
+    return;
+  }
+  if (value == 0) {
+    out += std::signbit(value) ? "-0" : "0";
+    return;
+  }
+
+  const double magnitude = std::fabs(static_cast<double>(value));
+  if (magnitude < FLT_MIN) {
+    AppendFloatAsProtobuf(value, out);
+    return;
+  }
+  if (magnitude < 1e6 && magnitude == std::floor(magnitude)) {
+    if (value < 0) {
+      out += '-';
+    }
+    AppendUnsigned(static_cast<uint64_t>(magnitude), out);
+    return;
+  }
+
+  uint64_t digits;
+  int exponent;
+  if (!RoundToSignificantDigits(magnitude, FLT_DIG, digits, exponent)) {
+    AppendFloatAsProtobuf(value, out);
+    return;
+  }
+
+  // the 6 digits parse back to the float if they are closer to it than to its neighbours
+  const double scale = PowerOfTen(FLT_DIG - 1 - exponent);
+  uint32_t bits;
+  const float positive = static_cast<float>(magnitude);
+  memcpy(&bits, &positive, sizeof(bits));
+  float next;
+  float previous;
+  ++bits;
+  memcpy(&next, &bits, sizeof(next));
+  bits -= 2;
+  memcpy(&previous, &bits, sizeof(previous));
+  const double upper_bound = (magnitude + next) / 2 * scale;
+  const double lower_bound = (magnitude + previous) / 2 * scale;
+  const auto candidate = static_cast<double>(digits);
+  if (std::fabs(candidate - upper_bound) < 1e-6 || std::fabs(candidate - lower_bound) < 1e-6) {
+    AppendFloatAsProtobuf(value, out);
+    return;
+  }
+  int precision = FLT_DIG;
+  if (candidate > upper_bound || candidate < lower_bound) {
+    precision = FLT_DIG + 3;
+    if (!RoundToSignificantDigits(magnitude, precision, digits, exponent)) {
+      AppendFloatAsProtobuf(value, out);
+      return;
+    }
+  }
+
+  if (value < 0) {
+    out += '-';
+  }
+  AppendGeneralFormat(digits, precision, exponent, precision, out);
+}
+
+// Same as protobuf's SimpleDtoa
+void AppendDouble(double value, std::string& out) {
+  if (!std::isfinite(value)) {
+    out += std::isnan(value) ? "\"NaN\"" : value > 0 ? "\"Infinity\"" : "\"-Infinity\"";
+    return;
+  }
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.*g", DBL_DIG, value);
+  if (std::strtod(buffer, nullptr) != value) {
+    snprintf(buffer, sizeof(buffer), "%.*g", DBL_DIG + 2, value);
+  }
+  out += buffer;
+}
+
+// Escapes the way the protobuf JSON printer does for ASCII. Other characters are copied.
+void AppendJsonString(const std::string& value, std::string& out) {
+  static const char kHexDigits[] = "0123456789abcdef";
+  out += '"';
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\b':
+        out += "\\b";
+        break;
+      case '\f':
+        out += "\\f";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if ((c >= '\x00' && c < '\x20') || c == '<' || c == '>' || c == '\x7f') {
+          out += "\\u00";
+          out += kHexDigits[(c >> 4) & 0xF];
+          out += kHexDigits[c & 0xF];
+        } else {
+          out += c;
+        }
+    }
+  }
+  out += '"';
+}
+
+void AppendBase64(const void* data, size_t size, std::string& out) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  const size_t start = out.size();
+  out.resize(start + (size + 2) / 3 * 4);
+  auto* p = &out[start];
+  size_t i = 0;
+  for (; i + 3 <= size; i += 3) {
+    const uint32_t bits = (uint32_t{bytes[i]} << 16) | (uint32_t{bytes[i + 1]} << 8) | bytes[i + 2];
+    *p++ = kBase64Chars[bits >> 18];
+    *p++ = kBase64Chars[(bits >> 12) & 0x3F];
+    *p++ = kBase64Chars[(bits >> 6) & 0x3F];
+    *p++ = kBase64Chars[bits & 0x3F];
+  }
+  if (i < size) {
+    const uint32_t bits = (uint32_t{bytes[i]} << 16) | (i + 1 < size ? uint32_t{bytes[i + 1]} << 8 : 0);
+    *p++ = kBase64Chars[bits >> 18];
+    *p++ = kBase64Chars[(bits >> 12) & 0x3F];
+    *p++ = i + 1 < size ? kBase64Chars[(bits >> 6) & 0x3F] : '=';
+    *p++ = '=';
+  }
+}
+
+template <typename T, typename AppendElement>
+void AppendArray(const char* field, const T* data, size_t count, AppendElement append_element, std::string& out) {
+  if (count == 0) {
+    return;
+  }
+  out += ",\"";
+  out += field;
+  out += "\":[";
+  for (size_t i = 0; i < count; ++i) {
+    if (i != 0) {
+      out += ',';
+    }
+    append_element(data[i], out);
+  }
+  out += ']';
+}
+
+// Appends the tensor in the same format as the protobuf JSON printer, with the fields in the order of their numbers
+void AppendTensor(Ort::Value& output, bool using_raw_data, const std::shared_ptr<spdlog::logger>& logger,
+                  std::string& out) {
+  onnx::TensorProto_DataType data_type = onnx::TensorProto_DataType_UNDEFINED;
+  if (output.IsTensor()) {
+    data_type = MLDataTypeToTensorProtoDataType(output.GetTensorTypeAndShapeInfo().GetElementType());
+  }
+
+  const size_t element_size = RawDataElementSize(data_type);
+  if (element_size == 0) {
+    // strings, which have no direct path. throws for non-tensors and unsupported types.
+    onnx::TensorProto tensor_proto;
+    MLValueToTensorProto(output, using_raw_data, logger, tensor_proto);
+
+    out += '{';
+    bool first = true;
+    if (tensor_proto.dims_size() > 0) {
+      out += "\"dims\":[";
+      for (int i = 0; i < tensor_proto.dims_size(); ++i) {
+        out += i == 0 ? "\"" : ",\"";
+        AppendInteger(tensor_proto.dims(i), out);
+        out += '"';
+      }
+      out += ']';
+      first = false;
+    }
+    out += first ? "\"dataType\":" : ",\"dataType\":";
+    AppendInteger(tensor_proto.data_type(), out);
+    if (tensor_proto.string_data_size() > 0) {
+      out += ",\"stringData\":[";
+      for (int i = 0; i < tensor_proto.string_data_size(); ++i) {
+        out += i == 0 ? "\"" : ",\"";
+        AppendBase64(tensor_proto.string_data(i).data(), tensor_proto.string_data(i).size(), out);
+        out += '"';
+      }
+      out += ']';
+    }
+    out += '}';
+    return;
+  }
+
+  const auto type_and_shape = output.GetTensorTypeAndShapeInfo();
+  const auto shape = type_and_shape.GetShape();
+  const size_t count = type_and_shape.GetElementCount();
+  const auto* data = output.GetTensorData<uint8_t>();
+
+  out += '{';
+  if (!shape.empty()) {
+    out += "\"dims\":[";
+    for (size_t i = 0; i < shape.size(); ++i) {
+      out += i == 0 ? "\"" : ",\"";
+      AppendInteger(shape[i], out);
+      out += '"';
+    }
+    out += "],";
+  }
+  out += "\"dataType\":";
+  AppendInteger(data_type, out);
+
+  if (using_raw_data) {
+    out += ",\"rawData\":\"";
+    AppendBase64(data, count * element_size, out);
+    out += "\",\"dataLocation\":\"DEFAULT\"}";
+    return;
+  }
+
+  auto append_int32 = [](int64_t value, std::string& o) { AppendInteger(value, o); };
+  auto append_quoted = [](int64_t value, std::string& o) {
+    o += '"';
+    AppendInteger(value, o);
+    o += '"';
+  };
+  auto append_quoted_unsigned = [](uint64_t value, std::string& o) {
+    o += '"';
+    AppendUnsigned(value, o);
+    o += '"';
+  };
+
+  switch (data_type) {
+    case onnx::TensorProto_DataType_FLOAT:
+      out.reserve(out.size() + count * 12);
+      AppendArray("floatData", reinterpret_cast<const float*>(data), count, AppendFloat, out);
+      break;
+    case onnx::TensorProto_DataType_INT32:
+      AppendArray("int32Data", reinterpret_cast<const int32_t*>(data), count, append_int32, out);
+      break;
+    case onnx::TensorProto_DataType_UINT8:
+      AppendArray("int32Data", reinterpret_cast<const uint8_t*>(data), count, append_int32, out);
+      break;
+    case onnx::TensorProto_DataType_INT8:
+      AppendArray("int32Data", reinterpret_cast<const int8_t*>(data), count, append_int32, out);
+      break;
+    case onnx::TensorProto_DataType_UINT16:
+      AppendArray("int32Data", reinterpret_cast<const uint16_t*>(data), count, append_int32, out);
+      break;
+    case onnx::TensorProto_DataType_INT16:
+      AppendArray("int32Data", reinterpret_cast<const int16_t*>(data), count, append_int32, out);
+      break;
+    case onnx::TensorProto_DataType_BOOL:
+      AppendArray("int32Data", reinterpret_cast<const bool*>(data), count, append_int32, out);
+      break;
+    case onnx::TensorProto_DataType_INT64:
+      AppendArray("int64Data", reinterpret_cast<const int64_t*>(data), count, append_quoted, out);
+      break;
+    case onnx::TensorProto_DataType_DOUBLE:
+      AppendArray("doubleData", reinterpret_cast<const double*>(data), count, AppendDouble, out);
+      break;
+    case onnx::TensorProto_DataType_UINT32:
+      AppendArray("uint64Data", reinterpret_cast<const uint32_t*>(data), count, append_quoted_unsigned, out);
+      break;
+    default:  // UINT64
+      AppendArray("uint64Data", reinterpret_cast<const uint64_t*>(data), count, append_quoted_unsigned, out);
+      break;
+  }
+  out += '}';
+}
+
+}  // namespace
+
 protobufutil::Status GetRequestFromJson(const std::string& json_string, /* out */ onnxruntime::server::PredictRequest& request) {
+  if (RequestParser(json_string).Parse(request)) {
+    return protobufutil::Status::OK;
+  }
+  request.Clear();
+
   protobufutil::JsonParseOptions options;
   options.ignore_unknown_fields = true;
 
@@ -34,6 +906,35 @@ protobufutil::Status GenerateResponseInJson(const onnxruntime::server::PredictRe
   return result;
 }
 
+void MLValuesToPredictResponseJson(const std::vector<std::string>& output_names,
+                                   std::vector<Ort::Value>& outputs,
+                                   bool using_raw_data,
+                                   const std::shared_ptr<spdlog::logger>& logger,
+                                   /* out */ std::string& json_string) {
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    if (std::find(output_names.begin() + i + 1, output_names.end(), output_names[i]) != output_names.end()) {
+      throw Ort::Exception("Cannot have two outputs with the same name", OrtErrorCode::ORT_INVALID_ARGUMENT);
+    }
+  }
+
+  json_string.clear();
+  if (outputs.empty()) {
+    json_string = "{}";
+    return;
+  }
+
+  json_string += "{\"outputs\":{";
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    if (i != 0) {
+      json_string += ',';
+    }
+    AppendJsonString(output_names[i], json_string);
+    json_string += ':';
+    AppendTensor(outputs[i], using_raw_data, logger, json_string);
+  }
+  json_string += "}}";
+}
+
 std::string CreateJsonError(const http::status error_code, const std::string& error_message) {
   auto escaped_message = escape_string(error_message);
   return R"({"error_code": )" + std::to_string(int(error_code)) + R"(, "error_message": ")" + escaped_message + R"("})" + "\n";
@@ -77,4 +978,4 @@ std::string escape_string(const std::string& message) {
 }
 
 }  // namespace server
-}  // namespace onnxruntime
\ No newline at end of file
+}  // namespace onnxruntime
@@ -3,9 +3,15 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include <google/protobuf/util/json_util.h>
 #include <boost/beast/http.hpp>
+#include <spdlog/spdlog.h>
 
+#include "onnxruntime_cxx_api.h"
 #include "predict.pb.h"
 
 namespace onnxruntime {
@@ -15,6 +21,8 @@ namespace http = boost::beast::http;
 
 // Deserialize Json input to PredictRequest.
 // Unknown fields in the json file will be ignored.
+// Requests are parsed straight into the PredictRequest, and those using the less common parts of the protobuf JSON
+// mapping (e.g. \u escapes or numbers in strings) and the invalid ones go through the protobuf JSON parser.
 google::protobuf::util::Status GetRequestFromJson(const std::string& json_string, /* out */ onnxruntime::server::PredictRequest& request);
 
 // Serialize PredictResponse to json string
@@ -22,6 +30,15 @@ google::protobuf::util::Status GetRequestFromJson(const std::string& json_string
 // 2. Enums will be printed as string, not int, to improve readability
 google::protobuf::util::Status GenerateResponseInJson(const onnxruntime::server::PredictResponse& response, /* out */ std::string& json_string);
 
+// Serialize a PredictResponse with the given outputs to json string, in the same format as GenerateResponseInJson.
+// Equivalent to converting each output with MLValueToTensorProto and calling GenerateResponseInJson, but the
+// tensor data is encoded straight from the output buffers. Throws Ort::Exception on the same errors.
+void MLValuesToPredictResponseJson(const std::vector<std::string>& output_names,
+                                   std::vector<Ort::Value>& outputs,
+                                   bool using_raw_data,
+                                   const std::shared_ptr<spdlog::logger>& logger,
+                                   /* out */ std::string& json_string);
+
 // Constructs JSON error message from error code object and error message
 std::string CreateJsonError(http::status error_code, const std::string& error_message);
 
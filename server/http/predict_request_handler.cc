@@ -6,6 +6,7 @@
 #include "environment.h"
 #include "http_server.h"
 #include "json_handling.h"
+#include "converter.h"
 #include "executor.h"
 #include "util.h"
 
@@ -31,6 +32,14 @@ namespace protobufutil = google::protobuf::util;
 static bool ParseRequestPayload(const HttpContext& context, SupportedContentType request_type,
                                 /* out */ PredictRequest& predictRequest, /* out */ http::status& error_code, /* out */ std::string& error_message);
 
+static void SetBinaryContentType(HttpContext& context) {
+  if (context.request.find("Accept") != context.request.end() && context.request["Accept"] != "*/*") {
+    context.response.set(http::field::content_type, context.request["Accept"].to_string());
+  } else {
+    context.response.set(http::field::content_type, "application/octet-stream");
+  }
+}
+
 void Predict(const std::string& name,
              const std::string& version,
              const std::string& action,
@@ -66,29 +75,50 @@ void Predict(const std::string& name,
 
   // Run Prediction
   Executor executor(env.get(), context.request_id);
-  PredictResponse predict_response{};
-  auto status = executor.Predict(effective_name, effective_version, predict_request, predict_response);
+  std::vector<std::string> output_names;
+  std::vector<Ort::Value> outputs;
+  auto status = executor.Run(effective_name, effective_version, predict_request, output_names, outputs);
   if (!status.ok()) {
     GenerateErrorResponse(logger, GetHttpStatusCode((status)), status.error_message(), context);
     return;
   }
 
+  // JSON responses, and binary responses with raw_data, are serialized straight from the output buffers
+  const bool json_response = response_type == SupportedContentType::Json;
+  const bool serialize_outputs_directly = json_response || executor.UsingRawData();
+
+  PredictResponse predict_response{};
+  if (!serialize_outputs_directly) {
+    status = executor.BuildResponse(output_names, outputs, predict_response);
+    if (!status.ok()) {
+      GenerateErrorResponse(logger, GetHttpStatusCode((status)), status.error_message(), context);
+      return;
+    }
+  }
+
   // Serialize to proper output format
   std::string response_body{};
-  if (response_type == SupportedContentType::Json) {
-    status = GenerateResponseInJson(predict_response, response_body);
-    if (!status.ok()) {
-      GenerateErrorResponse(logger, http::status::internal_server_error, status.error_message(), context);
+  if (serialize_outputs_directly) {
+    try {
+      if (json_response) {
+        MLValuesToPredictResponseJson(output_names, outputs, executor.UsingRawData(), logger, response_body);
+      } else {
+        MLValuesToPredictResponseBinary(output_names, outputs, logger, response_body);
+      }
+    } catch (const Ort::Exception& e) {
+      GenerateErrorResponse(logger, GetHttpStatusCode(GenerateProtobufStatus(e.GetOrtErrorCode(), e.what())),
+                            e.what(), context);
       return;
     }
-    context.response.set(http::field::content_type, "application/json");
-  } else {
-    response_body = predict_response.SerializeAsString();
-    if (context.request.find("Accept") != context.request.end() && context.request["Accept"] != "*/*") {
-      context.response.set(http::field::content_type, context.request["Accept"].to_string());
+
+    if (json_response) {
+      context.response.set(http::field::content_type, "application/json");
     } else {
-      context.response.set(http::field::content_type, "application/octet-stream");
+      SetBinaryContentType(context);
     }
+  } else {
+    response_body = predict_response.SerializeAsString();
+    SetBinaryContentType(context);
   }
 
   // Build HTTP response
@@ -96,10 +126,43 @@ void Predict(const std::string& name,
   if (!context.client_request_id.empty()) {
     context.response.insert(util::MS_CLIENT_REQUEST_ID_HEADER, context.client_request_id);
   }
-  context.response.body() = response_body;
+  context.response.body() = std::move(response_body);
   context.response.result(http::status::ok);
 };
 
+void Metrics(const std::string& name,
+             const std::string& version,
+             /* in, out */ HttpContext& context,
+             const std::shared_ptr<ServerEnvironment>& env) {
+  auto logger = env->GetLogger(context.request_id);
+  auto effective_version = version.empty() ? "1" : version;
+
+  // the metrics of a model that is not loaded are not reported, rather than loading it
+  std::shared_ptr<ServerEnvironment::SessionHolder> model;
+  try {
+    model = env->GetLoadedModel(name, effective_version);
+  } catch (const Ort::Exception& e) {
+    GenerateErrorResponse(logger, http::status::not_found, e.what(), context);
+    return;
+  }
+
+  context.response.insert(util::MS_REQUEST_ID_HEADER, context.request_id);
+  context.response.set(http::field::content_type, "application/json");
+  context.response.body() = model != nullptr && model->batcher != nullptr
+                                ? BatchingMetricsToJson(model->batcher->GetMetrics())
+                                : "{}";
+  context.response.result(http::status::ok);
+}
+
+void Health(/* in, out */ HttpContext& context,
+            const std::shared_ptr<ServerEnvironment>& env) {
+  const bool ready = env->IsReady();
+  context.response.insert(util::MS_REQUEST_ID_HEADER, context.request_id);
+  context.response.set(http::field::content_type, "application/json");
+  context.response.body() = ready ? R"({"status": "ready"})" : R"({"status": "warming up"})";
+  context.response.result(ready ? http::status::ok : http::status::service_unavailable);
+}
+
 static bool ParseRequestPayload(const HttpContext& context, SupportedContentType request_type, PredictRequest& predictRequest, http::status& error_code, std::string& error_message) {
   auto body = context.request.body();
   protobufutil::Status status;
@@ -19,5 +19,15 @@ void Predict(const std::string& name,
              /* in, out */ HttpContext& context,
              const std::shared_ptr<ServerEnvironment>& env);
 
+// Returns the request batching metrics of a model as JSON
+void Metrics(const std::string& name,
+             const std::string& version,
+             /* in, out */ HttpContext& context,
+             const std::shared_ptr<ServerEnvironment>& env);
+
+// Reports whether the server is ready for traffic: 200 once the models are warmed up, 503 before
+void Health(/* in, out */ HttpContext& context,
+            const std::shared_ptr<ServerEnvironment>& env);
+
 }  // namespace server
 }  // namespace onnxruntime
@@ -1,10 +1,13 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <thread>
+
 #include "environment.h"
 #include "http_server.h"
 #include "predict_request_handler.h"
 #include "server_configuration.h"
+#include "warmup.h"
 #include "grpc/grpc_app.h"
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/sink.h>
@@ -58,18 +61,42 @@ int main(int argc, char* argv[]) {
     exit(EXIT_FAILURE);
   }
 
-  const auto env = std::make_shared<server::ServerEnvironment>(config.logging_level, spdlog::sinks_init_list{std::make_shared<spdlog::sinks::stdout_sink_mt>(), std::make_shared<spdlog::sinks::syslog_sink_mt>()});
+  server::ServerEnvironmentOptions env_options;
+  env_options.intra_op_num_threads = config.intra_op_num_threads;
+  env_options.inter_op_num_threads = config.inter_op_num_threads;
+  const auto env = std::make_shared<server::ServerEnvironment>(config.logging_level, spdlog::sinks_init_list{std::make_shared<spdlog::sinks::stdout_sink_mt>(), std::make_shared<spdlog::sinks::syslog_sink_mt>()}, env_options);
   auto logger = env->GetAppLogger();
-  logger->info("Model path: {}, ", config.model_path);
-  logger->info("Model name: {}", config.model_name);
-  logger->info("Model version: {}", config.model_version);
-
-  try {
-    env->InitializeModel(config.model_path, config.model_name, config.model_version);
-    logger->debug("Initialize Model Successfully!");
-  } catch (const Ort::Exception& ex) {
-    logger->critical("Initialize Model Failed: {} ---- Error: [{}]", ex.GetOrtErrorCode(), ex.what());
-    exit(EXIT_FAILURE);
+
+  server::BatchingOptions batching_options;
+  batching_options.max_batch_size = config.max_batch_size;
+  batching_options.max_queue_delay = std::chrono::microseconds(config.max_batch_queue_delay_us);
+  batching_options.padding_policy = config.batch_padding_policy == "pad" ? server::BatchPaddingPolicy::PadToMax
+                                                                         : server::BatchPaddingPolicy::None;
+  env->SetBatchingOptions(batching_options);
+  env->SetMemoryBudget(config.memory_budget_mb * 1024 * 1024);
+
+  // Without a memory budget all the models are loaded now. Otherwise they are loaded on their first request,
+  // so the budget holds from the start.
+  for (const auto& model : config.models) {
+    logger->info("Model path: {}, ", model.path);
+    logger->info("Model name: {}", model.name);
+    logger->info("Model version: {}", model.version);
+    try {
+      if (config.memory_budget_mb == 0) {
+        env->InitializeModel(model.path, model.name, model.version);
+        logger->debug("Initialize Model Successfully!");
+      } else {
+        env->RegisterModel(model.path, model.name, model.version);
+      }
+    } catch (const Ort::Exception& ex) {
+      logger->critical("Initialize Model Failed: {} ---- Error: [{}]", ex.GetOrtErrorCode(), ex.what());
+      exit(EXIT_FAILURE);
+    }
+  }
+
+  // The health endpoints report not ready until the models are warmed up
+  if (config.HasWarmup()) {
+    env->SetReady(false);
   }
 
   //Setup GRPC Server
@@ -118,11 +145,46 @@ int main(int argc, char* argv[]) {
       }
   );
 
+  app.RegisterGet(
+      R"(/v1/models/([^/:]+)(?:/versions/(\d+))?/metrics())",
+      [&env](const auto& name, const auto& version, const auto& /*action*/, auto& context) -> void {
+        server::Metrics(name, version, context, env);
+      });
+
+  app.RegisterGet(
+      R"(/health()()())",
+      [&env](const auto& /*name*/, const auto& /*version*/, const auto& /*action*/, auto& context) -> void {
+        server::Health(context, env);
+      });
+
+  // Warm up once the servers listen, so the health endpoints can be polled meanwhile. A model that fails to warm
+  // up is logged and still served.
+  std::thread warmup_thread;
+  if (config.HasWarmup()) {
+    warmup_thread = std::thread([&config, &env, &grpc_app]() {
+      for (const auto& model : config.models) {
+        server::WarmupOptions options;
+        options.requests_path = model.warmup_requests_path;
+        options.batch_sizes = config.warmup_batch_sizes;
+        options.iterations = config.warmup_iterations;
+        server::WarmupModel(env.get(), model.name, model.version, options);
+      }
+
+      env->SetReady(true);
+      grpc_app.SetServing(true);
+      env->GetAppLogger()->info("Warmup is done, the server is ready");
+    });
+  }
+
   app.Bind(boost_address, config.http_port)
       .NumThreads(config.num_http_threads)
       .Run();
 
   grpc_app.Run();
 
+  if (warmup_thread.joinable()) {
+    warmup_thread.join();
+  }
+
   return EXIT_SUCCESS;
 }
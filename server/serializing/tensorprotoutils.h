@@ -15,6 +15,16 @@
 
 namespace onnxruntime {
 namespace server {
+#ifdef __GNUC__
+constexpr inline bool IsLittleEndianOrder() noexcept { return __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__; }
+#else
+// On Windows and Mac, this function should always return true
+inline bool IsLittleEndianOrder() noexcept {
+  static int n = 1;
+  return (*reinterpret_cast<char*>(&n) == 1);
+}
+#endif
+
 // How much memory it will need for putting the content of this tensor into a plain array
 // complex64/complex128 tensors are not supported.
 // The output value could be zero or -1.
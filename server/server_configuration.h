@@ -3,9 +3,12 @@
 
 #pragma once
 
+#include <algorithm>
 #include <thread>
 #include <fstream>
+#include <sstream>
 #include <unordered_map>
+#include <vector>
 
 #include "boost/program_options.hpp"
 #include "onnxruntime_cxx_api.h"
@@ -33,6 +36,14 @@ static std::unordered_map<std::string, OrtLoggingLevel> supported_log_levels{
     {"error", ORT_LOGGING_LEVEL_ERROR},
     {"fatal", ORT_LOGGING_LEVEL_FATAL}};
 
+struct ModelConfiguration {
+  std::string name;
+  std::string version;
+  std::string path;
+  // file with the sample requests to run before the server reports ready, empty if none
+  std::string warmup_requests_path;
+};
+
 // Wrapper around Boost program_options and should provide all the functionality for options parsing
 // Provides sane default values
 class ServerConfiguration {
@@ -46,17 +57,48 @@ class ServerConfiguration {
   unsigned short grpc_port = 50051;
   int num_http_threads = std::thread::hardware_concurrency();
   OrtLoggingLevel logging_level{};
+  size_t max_batch_size = 1;
+  int64_t max_batch_queue_delay_us = 1000;
+  std::string batch_padding_policy = "none";
+  std::vector<std::string> model_specs;
+  size_t memory_budget_mb = 0;
+  int intra_op_num_threads = 0;
+  int inter_op_num_threads = 0;
+  std::vector<std::string> warmup_specs;
+  std::string warmup_batch_sizes_str;
+  std::vector<int64_t> warmup_batch_sizes;
+  int warmup_iterations = 1;
+
+  // The models to host: the one from model_path, model_name and model_version first, followed by the --model ones
+  std::vector<ModelConfiguration> models;
+
+  // Whether any model is warmed up before the server reports ready
+  bool HasWarmup() const {
+    return !warmup_batch_sizes.empty() ||
+           std::any_of(models.begin(), models.end(),
+                       [](const ModelConfiguration& model) { return !model.warmup_requests_path.empty(); });
+  }
 
   ServerConfiguration() {
     desc.add_options()("help,h", "Shows a help message and exits");
     desc.add_options()("log_level", po::value(&log_level_str)->default_value(log_level_str), "Logging level. Allowed options (case sensitive): verbose, info, warning, error, fatal");
-    desc.add_options()("model_path", po::value(&model_path)->required(), "Path to ONNX model");
+    desc.add_options()("model_path", po::value(&model_path), "Path to ONNX model");
     desc.add_options()("model_name", po::value(&model_name)->default_value(model_name), "ONNX model name");
     desc.add_options()("model_version", po::value(&model_version)->default_value(model_version), "ONNX model version");
     desc.add_options()("address", po::value(&address)->default_value(address), "The base HTTP address");
     desc.add_options()("http_port", po::value(&http_port)->default_value(http_port), "HTTP port to listen to requests");
     desc.add_options()("num_http_threads", po::value(&num_http_threads)->default_value(num_http_threads), "Number of http threads");
     desc.add_options()("grpc_port", po::value(&grpc_port)->default_value(grpc_port), "GRPC port to listen to requests");
+    desc.add_options()("max_batch_size", po::value(&max_batch_size)->default_value(max_batch_size), "Maximum number of rows to batch together across requests. 1 disables batching");
+    desc.add_options()("max_batch_queue_delay_us", po::value(&max_batch_queue_delay_us)->default_value(max_batch_queue_delay_us), "Maximum time in microseconds a request waits for a batch to fill up");
+    desc.add_options()("batch_padding_policy", po::value(&batch_padding_policy)->default_value(batch_padding_policy), "How to batch requests with different non-batch dimensions. Allowed options: none, pad");
+    desc.add_options()("model", po::value(&model_specs)->composing(), "Additional model to host, as name:version:path. May be repeated");
+    desc.add_options()("memory_budget_mb", po::value(&memory_budget_mb)->default_value(memory_budget_mb), "Estimated memory for the loaded models in MB. Least recently used models are unloaded to stay within it and reloaded on their next request. 0 keeps all the models loaded");
+    desc.add_options()("intra_op_num_threads", po::value(&intra_op_num_threads)->default_value(intra_op_num_threads), "Number of threads of the intra-op thread pool shared by all the models. 0 uses the ORT default");
+    desc.add_options()("inter_op_num_threads", po::value(&inter_op_num_threads)->default_value(inter_op_num_threads), "Number of threads of the inter-op thread pool shared by all the models. 0 uses the ORT default");
+    desc.add_options()("warmup", po::value(&warmup_specs)->composing(), "Sample requests to run on a model before the server reports ready, as name:version:path of a file with a JSON predict request per line. May be repeated");
+    desc.add_options()("warmup_batch_sizes", po::value(&warmup_batch_sizes_str), "Comma separated batch sizes, e.g. 1,8,32, of the requests synthesized from the inputs of the models without warmup requests. Empty to only warm up the models with warmup requests");
+    desc.add_options()("warmup_iterations", po::value(&warmup_iterations)->default_value(warmup_iterations), "Number of times the warmup requests are run");
   }
 
   // Parses argc and argv and sets the values for the class
@@ -103,12 +145,108 @@ class ServerConfiguration {
     } else if (num_http_threads <= 0) {
       PrintHelp(std::cerr, "num_http_threads must be greater than 0");
       return Result::ExitFailure;
-    } else if (!file_exists(model_path)) {
+    } else if (max_batch_size == 0) {
+      PrintHelp(std::cerr, "max_batch_size must be greater than 0");
+      return Result::ExitFailure;
+    } else if (max_batch_queue_delay_us < 0) {
+      PrintHelp(std::cerr, "max_batch_queue_delay_us must not be negative");
+      return Result::ExitFailure;
+    } else if (batch_padding_policy != "none" && batch_padding_policy != "pad") {
+      PrintHelp(std::cerr, "batch_padding_policy must be one of none or pad");
+      return Result::ExitFailure;
+    } else if (intra_op_num_threads < 0 || inter_op_num_threads < 0) {
+      PrintHelp(std::cerr, "intra_op_num_threads and inter_op_num_threads must not be negative");
+      return Result::ExitFailure;
+    } else if (warmup_iterations <= 0) {
+      PrintHelp(std::cerr, "warmup_iterations must be greater than 0");
+      return Result::ExitFailure;
+    } else if (model_path.empty() && model_specs.empty()) {
+      PrintHelp(std::cerr, "model_path or model must be given");
+      return Result::ExitFailure;
+    } else if (!model_path.empty() && !file_exists(model_path)) {
       PrintHelp(std::cerr, "model_path must be the location of a valid file");
       return Result::ExitFailure;
     } else {
-      return Result::ContinueSuccess;
+      return ParseModels();
+    }
+  }
+
+  // Fill models from model_path and the name:version:path model specs
+  Result ParseModels() {
+    models.clear();
+    if (!model_path.empty()) {
+      models.push_back({model_name, model_version, model_path});
+    }
+
+    for (const auto& spec : model_specs) {
+      // the path is last as it may contain ':'
+      const auto name_end = spec.find(':');
+      const auto version_end = name_end == std::string::npos ? std::string::npos : spec.find(':', name_end + 1);
+      if (version_end == std::string::npos) {
+        PrintHelp(std::cerr, "model must be given as name:version:path, got " + spec);
+        return Result::ExitFailure;
+      }
+
+      ModelConfiguration model{spec.substr(0, name_end), spec.substr(name_end + 1, version_end - name_end - 1),
+                               spec.substr(version_end + 1)};
+      if (model.name.empty() || model.name.find('/') != std::string::npos) {
+        PrintHelp(std::cerr, "model name must not be empty or contain '/', got " + spec);
+        return Result::ExitFailure;
+      } else if (model.version.empty() ||
+                 model.version.find_first_not_of("0123456789") != std::string::npos) {
+        // the HTTP routes only match numeric versions
+        PrintHelp(std::cerr, "model version must be a number, got " + spec);
+        return Result::ExitFailure;
+      } else if (!file_exists(model.path)) {
+        PrintHelp(std::cerr, "model path must be the location of a valid file, got " + spec);
+        return Result::ExitFailure;
+      }
+
+      models.push_back(std::move(model));
+    }
+
+    return ParseWarmup();
+  }
+
+  // Set the warmup requests of the models from the name:version:path warmup specs, and parse the batch sizes
+  Result ParseWarmup() {
+    for (const auto& spec : warmup_specs) {
+      const auto name_end = spec.find(':');
+      const auto version_end = name_end == std::string::npos ? std::string::npos : spec.find(':', name_end + 1);
+      if (version_end == std::string::npos) {
+        PrintHelp(std::cerr, "warmup must be given as name:version:path, got " + spec);
+        return Result::ExitFailure;
+      }
+
+      const auto name = spec.substr(0, name_end);
+      const auto version = spec.substr(name_end + 1, version_end - name_end - 1);
+      auto model = std::find_if(models.begin(), models.end(), [&](const ModelConfiguration& m) {
+        return m.name == name && m.version == version;
+      });
+      if (model == models.end()) {
+        PrintHelp(std::cerr, "warmup must be for one of the models, got " + spec);
+        return Result::ExitFailure;
+      } else if (!file_exists(spec.substr(version_end + 1))) {
+        PrintHelp(std::cerr, "warmup path must be the location of a valid file, got " + spec);
+        return Result::ExitFailure;
+      }
+
+      model->warmup_requests_path = spec.substr(version_end + 1);
     }
+
+    warmup_batch_sizes.clear();
+    std::istringstream batch_sizes(warmup_batch_sizes_str);
+    std::string batch_size;
+    while (std::getline(batch_sizes, batch_size, ',')) {
+      if (batch_size.empty() || batch_size.size() > 9 || batch_size.find_first_not_of("0123456789") != std::string::npos ||
+          std::stoll(batch_size) == 0) {
+        PrintHelp(std::cerr, "warmup_batch_sizes must be comma separated positive numbers, got " + warmup_batch_sizes_str);
+        return Result::ExitFailure;
+      }
+      warmup_batch_sizes.push_back(std::stoll(batch_size));
+    }
+
+    return Result::ContinueSuccess;
   }
 
   // Checks if program options contains help
@@ -2,6 +2,7 @@
 # Licensed under the MIT License.
 
 import unittest
+import socket
 import subprocess
 import time
 import os
@@ -404,6 +405,23 @@ class HttpEndpointTests(unittest.TestCase):
         self.assertEqual(r.status_code, 200)
         self.assertEqual(r.content.decode('utf-8'), 'Healthy')
 
+    def test_pipelined_requests(self):
+        request = 'GET / HTTP/1.1\r\nHost: {0}\r\n\r\n'.format(self.server_ip)
+        with socket.create_connection((self.server_ip, self.server_port)) as s:
+            # send all the requests before reading any response
+            s.sendall((request * 3).encode('utf-8'))
+            s.shutdown(socket.SHUT_WR)
+
+            response = b''
+            while True:
+                data = s.recv(4096)
+                if not data:
+                    break
+                response += data
+
+        self.assertEqual(response.count(b'HTTP/1.1 200 OK'), 3)
+        self.assertEqual(response.count(b'Healthy'), 3)
+
 class GRPCTests(unittest.TestCase):
     server_ip = '127.0.0.1'
     server_port = 54321
@@ -467,6 +485,26 @@ class GRPCTests(unittest.TestCase):
         for i in range(0, count):
             self.assertTrue(test_util.compare_floats(actual_array[i], expected_array[i], rel_tol=0.001))
 
+    def test_mnist_stream(self):
+        input_data_file = os.path.join(self.test_data_path, 'mnist_test_data_set_0_input.pb')
+
+        with open(input_data_file, 'rb') as f:
+            request_payload = f.read()
+
+        request = predict_pb2.PredictRequest()
+        request.ParseFromString(request_payload)
+        uri = "{}:{}".format(self.server_ip, self.server_port)
+        test_util.test_log(uri)
+        with grpc.insecure_channel(uri) as channel:
+            stub = prediction_service_pb2_grpc.PredictionServiceStub(channel)
+            single_result = stub.Predict(request)
+            stream_results = list(stub.PredictStream(iter([request] * 4)))
+
+        self.assertEqual(len(stream_results), 4)
+        for result in stream_results:
+            self.assertEqual(result.outputs['Plus214_Output_0'].raw_data,
+                             single_result.outputs['Plus214_Output_0'].raw_data)
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,162 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <atomic>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+#include "batcher.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+namespace {
+
+Ort::Value CreateFloatTensor(std::vector<float>& data, const std::vector<int64_t>& shape) {
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+  return Ort::Value::CreateTensor<float>(memory_info, data.data(), data.size(), shape.data(), shape.size());
+}
+
+std::vector<float> GetData(const Ort::Value& value) {
+  auto count = value.GetTensorTypeAndShapeInfo().GetElementCount();
+  const auto* data = value.GetTensorData<float>();
+  return std::vector<float>(data, data + count);
+}
+
+// returns a single output that is the input multiplied by 2
+std::vector<Ort::Value> Double(std::vector<Ort::Value>& inputs) {
+  auto shape = inputs[0].GetTensorTypeAndShapeInfo().GetShape();
+  Ort::AllocatorWithDefaultOptions allocator;
+  auto output = Ort::Value::CreateTensor<float>(allocator, shape.data(), shape.size());
+  auto input_data = GetData(inputs[0]);
+  auto* output_data = output.GetTensorMutableData<float>();
+  for (size_t i = 0; i < input_data.size(); ++i) {
+    output_data[i] = input_data[i] * 2;
+  }
+
+  std::vector<Ort::Value> outputs;
+  outputs.push_back(std::move(output));
+  return outputs;
+}
+
+}  // namespace
+
+TEST(BatcherTests, ConcatenateAndSplit) {
+  std::vector<float> a{1, 2};
+  std::vector<float> b{3, 4, 5, 6};
+  auto value_a = CreateFloatTensor(a, {1, 2});
+  auto value_b = CreateFloatTensor(b, {2, 2});
+
+  auto batch = RequestBatcher::Concatenate({&value_a, &value_b}, BatchPaddingPolicy::None);
+  EXPECT_EQ(batch.GetTensorTypeAndShapeInfo().GetShape(), (std::vector<int64_t>{3, 2}));
+  EXPECT_EQ(GetData(batch), (std::vector<float>{1, 2, 3, 4, 5, 6}));
+
+  auto parts = RequestBatcher::Split(batch, {1, 2});
+  ASSERT_EQ(parts.size(), 2u);
+  EXPECT_EQ(parts[0].GetTensorTypeAndShapeInfo().GetShape(), (std::vector<int64_t>{1, 2}));
+  EXPECT_EQ(GetData(parts[0]), a);
+  EXPECT_EQ(parts[1].GetTensorTypeAndShapeInfo().GetShape(), (std::vector<int64_t>{2, 2}));
+  EXPECT_EQ(GetData(parts[1]), b);
+
+  EXPECT_THROW(RequestBatcher::Split(batch, {1, 1}), Ort::Exception);
+}
+
+TEST(BatcherTests, ConcatenateWithPadding) {
+  std::vector<float> a{1, 2};
+  std::vector<float> b{3, 4, 5};
+  auto value_a = CreateFloatTensor(a, {1, 2});
+  auto value_b = CreateFloatTensor(b, {1, 3});
+
+  EXPECT_THROW(RequestBatcher::Concatenate({&value_a, &value_b}, BatchPaddingPolicy::None), Ort::Exception);
+
+  auto batch = RequestBatcher::Concatenate({&value_a, &value_b}, BatchPaddingPolicy::PadToMax);
+  EXPECT_EQ(batch.GetTensorTypeAndShapeInfo().GetShape(), (std::vector<int64_t>{2, 3}));
+  EXPECT_EQ(GetData(batch), (std::vector<float>{1, 2, 0, 3, 4, 5}));
+}
+
+TEST(BatcherTests, BatchesConcurrentRequests) {
+  const int num_requests = 4;
+  std::atomic<int> num_runs{0};
+
+  BatchingOptions options;
+  options.max_batch_size = num_requests;
+  options.max_queue_delay = std::chrono::seconds(10);
+  RequestBatcher batcher(options, [&num_runs](const std::vector<std::string>&, std::vector<Ort::Value>& inputs,
+                                              const std::vector<std::string>&) {
+    ++num_runs;
+    return Double(inputs);
+  });
+
+  std::vector<std::vector<float>> results(num_requests);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_requests; ++i) {
+    threads.emplace_back([&batcher, &results, i]() {
+      std::vector<float> data{static_cast<float>(i), static_cast<float>(i + 1)};
+      std::vector<Ort::Value> inputs;
+      inputs.push_back(CreateFloatTensor(data, {1, 2}));
+      auto outputs = batcher.Run({"X"}, std::move(inputs), {"Y"});
+      results[i] = GetData(outputs[0]);
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(num_runs, 1);
+  for (int i = 0; i < num_requests; ++i) {
+    EXPECT_EQ(results[i], (std::vector<float>{2.f * i, 2.f * (i + 1)}));
+  }
+
+  auto metrics = batcher.GetMetrics();
+  EXPECT_EQ(metrics.num_requests, static_cast<uint64_t>(num_requests));
+  EXPECT_EQ(metrics.num_batches, 1u);
+  EXPECT_EQ(metrics.batch_size_histogram[num_requests], 1u);
+  EXPECT_NE(BatchingMetricsToJson(metrics).find("\"batchSizeHistogram\":{\"4\":1}"), std::string::npos);
+}
+
+TEST(BatcherTests, RunsRequestsSeparatelyIfBatchFails) {
+  const int num_requests = 2;
+  std::atomic<int> num_runs{0};
+
+  BatchingOptions options;
+  options.max_batch_size = num_requests;
+  options.max_queue_delay = std::chrono::seconds(10);
+  // simulates a model that only supports a batch size of 1
+  RequestBatcher batcher(options, [&num_runs](const std::vector<std::string>&, std::vector<Ort::Value>& inputs,
+                                              const std::vector<std::string>&) {
+    ++num_runs;
+    if (inputs[0].GetTensorTypeAndShapeInfo().GetShape()[0] != 1) {
+      throw Ort::Exception("Invalid batch size", ORT_INVALID_ARGUMENT);
+    }
+
+    return Double(inputs);
+  });
+
+  std::vector<std::vector<float>> results(num_requests);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_requests; ++i) {
+    threads.emplace_back([&batcher, &results, i]() {
+      std::vector<float> data{static_cast<float>(i)};
+      std::vector<Ort::Value> inputs;
+      inputs.push_back(CreateFloatTensor(data, {1}));
+      auto outputs = batcher.Run({"X"}, std::move(inputs), {"Y"});
+      results[i] = GetData(outputs[0]);
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(num_runs, 3);
+  for (int i = 0; i < num_requests; ++i) {
+    EXPECT_EQ(results[i], (std::vector<float>{2.f * i}));
+  }
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
@@ -0,0 +1,73 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+#include "environment.h"
+#include "test_server_environment.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+TEST(ServerEnvironmentTests, UnknownModel) {
+  ServerEnvironment* env = ServerEnv();
+  EXPECT_THROW(env->GetModel("not_registered", "1"), Ort::Exception);
+  EXPECT_THROW(env->GetLoadedModel("not_registered", "1"), Ort::Exception);
+  EXPECT_THROW(env->UnloadModel("not_registered", "1"), Ort::Exception);
+}
+
+TEST(ServerEnvironmentTests, LazyLoadingAndLeastRecentlyUsedUnloading) {
+  const static auto model_file = "testdata/mul_1.onnx";
+  std::ifstream file(model_file, std::ios::binary | std::ios::ate);
+  ASSERT_TRUE(file.good());
+  const auto model_size = static_cast<size_t>(file.tellg());
+
+  ServerEnvironment* env = ServerEnv();
+  env->RegisterModel(model_file, "first", "1");
+  env->RegisterModel(model_file, "second", "1");
+  EXPECT_THROW(env->RegisterModel(model_file, "first", "1"), Ort::Exception);
+
+  // registered models are loaded on their first request
+  EXPECT_EQ(env->GetLoadedModel("first", "1"), nullptr);
+  EXPECT_EQ(env->GetLoadedModel("second", "1"), nullptr);
+
+  // room for one model
+  env->SetMemoryBudget(model_size);
+
+  auto first = env->GetModel("first", "1");
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(env->GetModel("first", "1"), first);
+  EXPECT_EQ(env->GetLoadedModel("first", "1"), first);
+
+  auto second = env->GetModel("second", "1");
+  ASSERT_NE(second, nullptr);
+  EXPECT_EQ(env->GetLoadedModel("first", "1"), nullptr);
+  EXPECT_EQ(env->GetLoadedModel("second", "1"), second);
+
+  // a request that still holds an unloaded model can keep using its session
+  EXPECT_EQ(first->session.GetOutputCount(), 1u);
+  ASSERT_EQ(first->output_names.size(), 1u);
+  EXPECT_EQ(first->output_names[0], "Y");
+
+  // and the next request reloads it
+  auto reloaded = env->GetModel("first", "1");
+  EXPECT_NE(reloaded, first);
+  EXPECT_EQ(env->GetLoadedModel("second", "1"), nullptr);
+
+  // without a budget both stay loaded
+  env->SetMemoryBudget(0);
+  env->GetModel("second", "1");
+  EXPECT_NE(env->GetLoadedModel("first", "1"), nullptr);
+  EXPECT_NE(env->GetLoadedModel("second", "1"), nullptr);
+
+  env->UnloadModel("first", "1");
+  env->UnloadModel("second", "1");
+  EXPECT_THROW(env->GetModel("first", "1"), Ort::Exception);
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
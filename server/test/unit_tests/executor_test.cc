@@ -5,6 +5,7 @@
 
 #include "gtest/gtest.h"
 
+#include "converter.h"
 #include "executor.h"
 #include "http/json_handling.h"
 #include <spdlog/spdlog.h>
@@ -52,6 +53,42 @@ TEST_F(ExecutorTest, TestMul_1) {
   EXPECT_EQ(expected, body);
 }
 
+TEST_F(ExecutorTest, TestMul_1_RawData) {
+  // X is 1 to 6 as little endian floats
+  const static auto input_json = R"({"inputs":{"X":{"dims":[3,2],"dataType":1,"rawData":"AACAPwAAAEAAAEBAAACAQAAAoEAAAMBA"}},"outputFilter":["Y"]})";
+
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+
+  onnxruntime::server::Executor executor(env, "RequestId");
+  onnxruntime::server::PredictRequest request{};
+  auto protostatus = onnxruntime::server::GetRequestFromJson(input_json, request);
+  ASSERT_TRUE(protostatus.ok());
+
+  std::vector<std::string> output_names;
+  std::vector<Ort::Value> outputs;
+  auto run_res = executor.Run("Name", "version", request, output_names, outputs);
+  ASSERT_TRUE(run_res.ok());
+  EXPECT_TRUE(executor.UsingRawData());
+
+  // serializing directly from the outputs must match serializing the response built from them
+  std::string direct;
+  MLValuesToPredictResponseBinary(output_names, outputs, env->GetAppLogger(), direct);
+
+  onnxruntime::server::PredictResponse response{};
+  ASSERT_TRUE(executor.BuildResponse(output_names, outputs, response).ok());
+
+  onnxruntime::server::PredictResponse parsed{};
+  ASSERT_TRUE(parsed.ParseFromString(direct));
+  ASSERT_EQ(parsed.outputs().count("Y"), 1u);
+  EXPECT_EQ(parsed.outputs().at("Y").SerializeAsString(), response.outputs().at("Y").SerializeAsString());
+
+  const auto& y = parsed.outputs().at("Y");
+  ASSERT_EQ(y.raw_data().size(), 6 * sizeof(float));
+  std::vector<float> values(6);
+  memcpy(values.data(), y.raw_data().data(), y.raw_data().size());
+  EXPECT_EQ(values, (std::vector<float>{1, 4, 9, 16, 25, 36}));
+}
+
 }  // namespace test
 }  // namespace server
 }  // namespace onnxruntime
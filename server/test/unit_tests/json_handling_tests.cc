@@ -1,13 +1,18 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <cmath>
 #include <fstream>
+#include <limits>
 #include <google/protobuf/stubs/status.h>
+#include <google/protobuf/util/message_differencer.h>
 
 #include "gtest/gtest.h"
 
+#include "converter.h"
 #include "predict.pb.h"
 #include "http/json_handling.h"
+#include "test_server_environment.h"
 
 namespace onnxruntime {
 namespace server {
@@ -49,6 +54,39 @@ TEST(JsonDeserializationTests, InvalidJson) {
   EXPECT_EQ("Expected : between key:value pair.\n{inputs\":{\"Input3\":{\"dims\":\n       ^", status.error_message());
 }
 
+TEST(JsonDeserializationTests, MatchesProtobufParser) {
+  // requests parsed directly, and requests left to the protobuf parser
+  const std::vector<std::string> inputs = {
+      R"({"inputs":{"X":{"dims":[3,2],"dataType":1,"floatData":[1,2,3,4,5,6]}},"outputFilter":["Y"]})",
+      R"( { "inputs" : { "X" : { "dims" : [ "3" , "2" ] , "dataType" : "1" , "floatData" : [ 1.5, -0, -0.0, 1e-3, 2E+2, 0.1, 3.4028234e38, 1.4e-45, 1e-50, 0.10000000000000000000001, "Infinity" ] } } } )",
+      R"({"inputs":{"X":{"int32Data":[-2147483648,2147483647],"int64Data":["-9",12],"uint64Data":[1,"2"],"doubleData":[0.1,1e300,5e-324],"stringData":["YWIB/w==","","YQ"],"name":"x\n\"\\\/"},"Z":{"rawData":"AA-_"}}})",
+      R"({"inputs":{"X":{"floatData":[16777217,123456789012345678901234]}}})",
+      R"({"inputs":{"X":{"floatData":["1.5"],"data_type":1}},"output_filter":["\u0059"]})",
+      R"({"inputs":{"X":{"floatData":[1],"floatData":[2]}}})",
+      R"({"inputs":{"X":{"rawData":"AAA="}}})",
+      R"({})"};
+
+  for (const auto& input : inputs) {
+    onnxruntime::server::PredictRequest request;
+    protobufutil::Status status = onnxruntime::server::GetRequestFromJson(input, request);
+    EXPECT_TRUE(status.ok()) << input;
+
+    onnxruntime::server::PredictRequest expected;
+    protobufutil::JsonParseOptions options;
+    options.ignore_unknown_fields = true;
+    ASSERT_TRUE(JsonStringToMessage(input, &expected, options).ok());
+    EXPECT_TRUE(google::protobuf::util::MessageDifferencer::Equals(expected, request)) << input;
+  }
+
+  // errors are reported by the protobuf parser
+  onnxruntime::server::PredictRequest request;
+  for (const auto* input : {R"({"inputs":{"X":{"floatData":[1e39]}}})", R"({"inputs":{"X":{"int32Data":[1.5]}}})",
+                            R"({"inputs":{"X":{"dims":[1]},"X":{"dims":[2]}}})", R"({"inputs":{"X":{}}} x)"}) {
+    EXPECT_EQ(protobufutil::error::INVALID_ARGUMENT, onnxruntime::server::GetRequestFromJson(input, request).error_code())
+        << input;
+  }
+}
+
 TEST(JsonSerializationTests, HappyPath) {
   std::string test_data = "testdata/server/response_0.pb";
   std::string expected_json_string = R"({"outputs":{"Plus214_Output_0":{"dims":["1","10"],"dataType":1,"rawData":"4+pzRFWuGsSMdM1F2gEnRFdRZcRZ9NDEURj0xBIzdsJOS0LEA/GzxA=="}}})";
@@ -68,6 +106,62 @@ TEST(JsonSerializationTests, HappyPath) {
   EXPECT_EQ(expected_json_string, json_string);
 }
 
+TEST(JsonSerializationTests, FromOutputsMatchesResponse) {
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+  std::vector<float> floats{0.f, -0.f, 1.f, -2.5f, 0.1f, 1e6f, 123456.7f, 3.14159265f, 1e-45f, 3.4028235e38f,
+                            std::numeric_limits<float>::quiet_NaN(), -std::numeric_limits<float>::infinity()};
+  std::vector<int64_t> int64s{0, -1, std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()};
+  std::vector<uint8_t> uint8s{255};
+  std::vector<double> doubles{0.1, -1e300, 5e-324};
+  std::vector<int64_t> float_shape{3, 4};
+  std::vector<int64_t> vector_shape{4};
+  std::vector<int64_t> empty_shape{0, 2};
+  const char* strings[] = {"a", "", "<b>"};
+  std::vector<int64_t> string_shape{3};
+  Ort::AllocatorWithDefaultOptions allocator;
+
+  auto make_outputs = [&]() {
+    std::vector<Ort::Value> outputs;
+    outputs.push_back(Ort::Value::CreateTensor<float>(memory_info, floats.data(), floats.size(), float_shape.data(), 2));
+    outputs.push_back(Ort::Value::CreateTensor<int64_t>(memory_info, int64s.data(), int64s.size(), vector_shape.data(), 1));
+    // a scalar
+    outputs.push_back(Ort::Value::CreateTensor<uint8_t>(memory_info, uint8s.data(), uint8s.size(), nullptr, 0));
+    outputs.push_back(Ort::Value::CreateTensor<double>(memory_info, doubles.data(), 0, empty_shape.data(), 2));
+    outputs.push_back(Ort::Value::CreateTensor(allocator, string_shape.data(), 1, ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING));
+    outputs.back().FillStringTensor(strings, 3);
+    return outputs;
+  };
+
+  for (bool using_raw_data : {false, true}) {
+    auto outputs = make_outputs();
+    for (auto& output : outputs) {
+      std::vector<std::string> output_names{"output \"<name>\""};
+      std::vector<Ort::Value> single_output;
+      single_output.push_back(std::move(output));
+
+      std::string json_string;
+      MLValuesToPredictResponseJson(output_names, single_output, using_raw_data, ServerEnv()->GetAppLogger(), json_string);
+
+      onnxruntime::server::PredictResponse response;
+      MLValueToTensorProto(single_output[0], using_raw_data, ServerEnv()->GetAppLogger(),
+                           (*response.mutable_outputs())[output_names[0]]);
+      std::string expected;
+      ASSERT_TRUE(GenerateResponseInJson(response, expected).ok());
+      EXPECT_EQ(expected, json_string);
+    }
+  }
+
+  std::string json_string;
+  std::vector<Ort::Value> no_outputs;
+  MLValuesToPredictResponseJson({}, no_outputs, false, ServerEnv()->GetAppLogger(), json_string);
+  EXPECT_EQ("{}", json_string);
+
+  auto outputs = make_outputs();
+  outputs.erase(outputs.begin() + 2, outputs.end());
+  EXPECT_THROW(MLValuesToPredictResponseJson({"Y", "Y"}, outputs, false, ServerEnv()->GetAppLogger(), json_string),
+               Ort::Exception);
+}
+
 TEST(StringEscapingTests, SimpleString) {
   std::string unescaped = "This is an error message \" \n ";
   EXPECT_EQ("This is an error message \\\" \\n ", escape_string(unescaped));
@@ -131,6 +131,65 @@ TEST_F(PredictionServiceImplTest, InvalidInputClientID) {
   EXPECT_FALSE(status.ok());
 }
 
+TEST_F(PredictionServiceImplTest, Stream) {
+  auto env = GetEnvironment();
+  PredictionServiceImpl service{env};
+  ::grpc::ServerBuilder builder;
+  builder.RegisterService(&service);
+  auto server = builder.BuildAndStart();
+  auto stub = PredictionService::NewStub(server->InProcessChannel(::grpc::ChannelArguments()));
+
+  ::grpc::ClientContext context;
+  auto stream = stub->PredictStream(&context);
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(stream->Write(GetRequest()));
+    PredictResponse resp{};
+    ASSERT_TRUE(stream->Read(&resp));
+    EXPECT_EQ(resp.outputs().count("Y"), 1u);
+  }
+  stream->WritesDone();
+  EXPECT_TRUE(stream->Finish().ok());
+
+  server->Shutdown();
+}
+
+TEST_F(PredictionServiceImplTest, StreamEndsWithTheFirstError) {
+  auto env = GetEnvironment();
+  PredictionServiceImpl service{env};
+  ::grpc::ServerBuilder builder;
+  builder.RegisterService(&service);
+  auto server = builder.BuildAndStart();
+  auto stub = PredictionService::NewStub(server->InProcessChannel(::grpc::ChannelArguments()));
+
+  ::grpc::ClientContext context;
+  auto stream = stub->PredictStream(&context);
+  auto request = GetRequest();
+  (*request.mutable_inputs())["X"].add_dims(1);
+  ASSERT_TRUE(stream->Write(request));
+  PredictResponse resp{};
+  EXPECT_FALSE(stream->Read(&resp));
+  EXPECT_EQ(stream->Finish().error_code(), ::grpc::INVALID_ARGUMENT);
+
+  server->Shutdown();
+}
+
+TEST_F(PredictionServiceImplTest, StreamForUnknownModel) {
+  auto env = GetEnvironment();
+  PredictionServiceImpl service{env};
+  ::grpc::ServerBuilder builder;
+  builder.RegisterService(&service);
+  auto server = builder.BuildAndStart();
+  auto stub = PredictionService::NewStub(server->InProcessChannel(::grpc::ChannelArguments()));
+
+  ::grpc::ClientContext context;
+  context.AddMetadata("model-name", "not_registered");
+  auto stream = stub->PredictStream(&context);
+  stream->WritesDone();
+  EXPECT_EQ(stream->Finish().error_code(), ::grpc::INVALID_ARGUMENT);
+
+  server->Shutdown();
+}
+
 }  // namespace test
 }  // namespace grpc
 }  // namespace server
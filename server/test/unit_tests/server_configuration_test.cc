@@ -98,6 +98,75 @@ TEST(ConfigParsingTests, WrongLoggingLevel) {
   EXPECT_EQ(res, Result::ExitFailure);
 }
 
+TEST(ConfigParsingTests, MultipleModels) {
+  char* test_argv[] = {
+      const_cast<char*>("/path/to/binary"),
+      const_cast<char*>("--model_path"), const_cast<char*>("testdata/mul_1.onnx"),
+      const_cast<char*>("--model"), const_cast<char*>("mul:2:testdata/mul_1.onnx"),
+      const_cast<char*>("--model"), const_cast<char*>("other:1:testdata/mul_1.onnx"),
+      const_cast<char*>("--memory_budget_mb"), const_cast<char*>("64")};
+
+  onnxruntime::server::ServerConfiguration config{};
+  Result res = config.ParseInput(9, test_argv);
+  EXPECT_EQ(res, Result::ContinueSuccess);
+  EXPECT_EQ(config.memory_budget_mb, 64u);
+  ASSERT_EQ(config.models.size(), 3u);
+  EXPECT_EQ(config.models[0].name, "default");
+  EXPECT_EQ(config.models[0].version, "1");
+  EXPECT_EQ(config.models[1].name, "mul");
+  EXPECT_EQ(config.models[1].version, "2");
+  EXPECT_EQ(config.models[1].path, "testdata/mul_1.onnx");
+  EXPECT_EQ(config.models[2].name, "other");
+}
+
+TEST(ConfigParsingTests, InvalidModelSpec) {
+  for (const char* spec : {"mul:testdata/mul_1.onnx", "mul:v2:testdata/mul_1.onnx", ":1:testdata/mul_1.onnx",
+                           "mul:1:does/not/exist"}) {
+    char* test_argv[] = {
+        const_cast<char*>("/path/to/binary"),
+        const_cast<char*>("--model"), const_cast<char*>(spec)};
+
+    onnxruntime::server::ServerConfiguration config{};
+    Result res = config.ParseInput(3, test_argv);
+    EXPECT_EQ(res, Result::ExitFailure) << spec;
+  }
+}
+
+TEST(ConfigParsingTests, Warmup) {
+  char* test_argv[] = {
+      const_cast<char*>("/path/to/binary"),
+      const_cast<char*>("--model_path"), const_cast<char*>("testdata/mul_1.onnx"),
+      const_cast<char*>("--model"), const_cast<char*>("mul:2:testdata/mul_1.onnx"),
+      const_cast<char*>("--warmup"), const_cast<char*>("mul:2:testdata/mul_1.onnx"),
+      const_cast<char*>("--warmup_batch_sizes"), const_cast<char*>("1,8,32"),
+      const_cast<char*>("--warmup_iterations"), const_cast<char*>("3")};
+
+  onnxruntime::server::ServerConfiguration config{};
+  Result res = config.ParseInput(11, test_argv);
+  EXPECT_EQ(res, Result::ContinueSuccess);
+  EXPECT_TRUE(config.HasWarmup());
+  ASSERT_EQ(config.models.size(), 2u);
+  EXPECT_EQ(config.models[0].warmup_requests_path, "");
+  EXPECT_EQ(config.models[1].warmup_requests_path, "testdata/mul_1.onnx");
+  EXPECT_EQ(config.warmup_batch_sizes, (std::vector<int64_t>{1, 8, 32}));
+  EXPECT_EQ(config.warmup_iterations, 3);
+}
+
+TEST(ConfigParsingTests, InvalidWarmup) {
+  for (const char* spec : {"--warmup=default:testdata/mul_1.onnx", "--warmup=other:1:testdata/mul_1.onnx",
+                           "--warmup=default:1:does/not/exist", "--warmup_batch_sizes=1,,8",
+                           "--warmup_batch_sizes=0", "--warmup_batch_sizes=-1", "--warmup_iterations=0"}) {
+    char* test_argv[] = {
+        const_cast<char*>("/path/to/binary"),
+        const_cast<char*>("--model_path"), const_cast<char*>("testdata/mul_1.onnx"),
+        const_cast<char*>(spec)};
+
+    onnxruntime::server::ServerConfiguration config{};
+    Result res = config.ParseInput(4, test_argv);
+    EXPECT_EQ(res, Result::ExitFailure) << spec;
+  }
+}
+
 }  // namespace test
 }  // namespace server
 }  // namespace onnxruntime
\ No newline at end of file
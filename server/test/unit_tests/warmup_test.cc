@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cstdio>
+#include <fstream>
+
+#include "gtest/gtest.h"
+
+#include "environment.h"
+#include "warmup.h"
+#include "test_server_environment.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+namespace protobufutil = google::protobuf::util;
+
+TEST(WarmupTests, SynthesizedRequests) {
+  ServerEnvironment* env = ServerEnv();
+  env->InitializeModel("testdata/mul_1.onnx", "warmup", "1");
+  auto model = env->GetModel("warmup", "1");
+
+  // X has the fixed shape [3, 2], so there is a single request whatever the batch sizes
+  std::vector<PredictRequest> requests;
+  ASSERT_TRUE(SynthesizeWarmupRequests(model->session, {1, 8}, requests).ok());
+  ASSERT_EQ(requests.size(), 1u);
+  ASSERT_EQ(requests[0].inputs().count("X"), 1u);
+  const auto& x = requests[0].inputs().at("X");
+  EXPECT_EQ(std::vector<int64_t>(x.dims().begin(), x.dims().end()), (std::vector<int64_t>{3, 2}));
+  EXPECT_EQ(x.data_type(), onnx::TensorProto_DataType_FLOAT);
+  EXPECT_EQ(x.raw_data(), std::string(6 * sizeof(float), '\0'));
+
+  ASSERT_TRUE(SynthesizeWarmupRequests(model->session, {}, requests).ok());
+  EXPECT_TRUE(requests.empty());
+
+  WarmupOptions options;
+  options.batch_sizes = {1};
+  options.iterations = 2;
+  EXPECT_TRUE(WarmupModel(env, "warmup", "1", options).ok());
+
+  options.batch_sizes.clear();
+  EXPECT_TRUE(WarmupModel(env, "warmup", "1", options).ok());
+  EXPECT_EQ(WarmupModel(env, "not_registered", "1", WarmupOptions{"", {1}, 1}).error_code(),
+            protobufutil::error::INVALID_ARGUMENT);
+
+  env->UnloadModel("warmup", "1");
+}
+
+TEST(WarmupTests, RecordedRequests) {
+  const static auto path = "warmup_requests.jsonl";
+  {
+    std::ofstream file(path);
+    file << R"({"inputs":{"X":{"dims":[3,2],"dataType":1,"floatData":[1,2,3,4,5,6]}},"outputFilter":["Y"]})" << "\n\n";
+    file << R"({"inputs":{"X":{"dims":[3,2],"dataType":1,"rawData":"AACAPwAAAEAAAEBAAACAQAAAoEAAAMBA"}}})" << "\n";
+  }
+
+  std::vector<PredictRequest> requests;
+  ASSERT_TRUE(ReadWarmupRequests(path, requests).ok());
+  ASSERT_EQ(requests.size(), 2u);
+  EXPECT_EQ(requests[0].inputs().at("X").float_data_size(), 6);
+  EXPECT_TRUE(requests[1].inputs().at("X").has_raw_data());
+
+  ServerEnvironment* env = ServerEnv();
+  env->RegisterModel("testdata/mul_1.onnx", "warmup_recorded", "1");
+  WarmupOptions options;
+  options.requests_path = path;
+  EXPECT_TRUE(WarmupModel(env, "warmup_recorded", "1", options).ok());
+  // the warmup loads a model that was only registered
+  EXPECT_NE(env->GetLoadedModel("warmup_recorded", "1"), nullptr);
+
+  // a request the model rejects stops the warmup
+  {
+    std::ofstream file(path);
+    file << R"({"inputs":{"X":{"dims":[2],"dataType":1,"floatData":[1,2]}}})" << "\n";
+  }
+  EXPECT_FALSE(WarmupModel(env, "warmup_recorded", "1", options).ok());
+  env->UnloadModel("warmup_recorded", "1");
+
+  {
+    std::ofstream file(path);
+    file << "{not json\n";
+  }
+  auto status = ReadWarmupRequests(path, requests);
+  EXPECT_EQ(status.error_code(), protobufutil::error::INVALID_ARGUMENT);
+  EXPECT_NE(status.error_message().find("line 1"), std::string::npos);
+  std::remove(path);
+
+  EXPECT_FALSE(ReadWarmupRequests("not_a_file.jsonl", requests).ok());
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime
@@ -0,0 +1,182 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <chrono>
+#include <fstream>
+
+#include "onnxruntime_cxx_api.h"
+
+#include "onnx-ml.pb.h"
+#include "predict.pb.h"
+
+#include "converter.h"
+#include "executor.h"
+#include "http/json_handling.h"
+#include "util.h"
+#include "warmup.h"
+
+namespace onnxruntime {
+namespace server {
+
+namespace protobufutil = google::protobuf::util;
+
+protobufutil::Status ReadWarmupRequests(const std::string& path,
+                                        /* out */ std::vector<onnxruntime::server::PredictRequest>& requests) {
+  std::ifstream file(path);
+  if (!file.good()) {
+    return protobufutil::Status(protobufutil::error::Code::INVALID_ARGUMENT, "Cannot open warmup requests file " + path);
+  }
+
+  requests.clear();
+  std::string line;
+  for (size_t line_number = 1; std::getline(file, line); ++line_number) {
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+
+    PredictRequest request{};
+    auto status = GetRequestFromJson(line, request);
+    if (!status.ok()) {
+      return protobufutil::Status(status.error_code(), path + " line " + std::to_string(line_number) + ": " +
+                                                           status.error_message());
+    }
+    requests.push_back(std::move(request));
+  }
+
+  return protobufutil::Status::OK;
+}
+
+protobufutil::Status SynthesizeWarmupRequests(Ort::Session& session,
+                                              const std::vector<int64_t>& batch_sizes,
+                                              /* out */ std::vector<onnxruntime::server::PredictRequest>& requests) {
+  requests.clear();
+  if (batch_sizes.empty()) {
+    return protobufutil::Status::OK;
+  }
+
+  try {
+    Ort::AllocatorWithDefaultOptions allocator;
+    const size_t input_count = session.GetInputCount();
+    bool dynamic_batch = false;
+    for (size_t i = 0; i < input_count && !dynamic_batch; ++i) {
+      const auto type_info = session.GetInputTypeInfo(i);
+      if (type_info.GetONNXType() == ONNX_TYPE_TENSOR) {
+        const auto shape = type_info.GetTensorTypeAndShapeInfo().GetShape();
+        dynamic_batch = !shape.empty() && shape[0] < 0;
+      }
+    }
+
+    const size_t request_count = dynamic_batch ? batch_sizes.size() : 1;
+    requests.resize(request_count);
+    for (size_t i = 0; i < input_count; ++i) {
+      auto* name = session.GetInputName(i, allocator);
+      std::string input_name(name);
+      allocator.Free(name);
+
+      const auto type_info = session.GetInputTypeInfo(i);
+      if (type_info.GetONNXType() != ONNX_TYPE_TENSOR) {
+        return protobufutil::Status(protobufutil::error::Code::UNIMPLEMENTED,
+                                    "Cannot synthesize warmup data for the non-tensor input " + input_name);
+      }
+
+      const auto tensor_info = type_info.GetTensorTypeAndShapeInfo();
+      const auto data_type = MLDataTypeToTensorProtoDataType(tensor_info.GetElementType());
+      const size_t element_size = RawDataElementSize(data_type);
+      if (element_size == 0 && data_type != onnx::TensorProto_DataType_STRING) {
+        return protobufutil::Status(protobufutil::error::Code::UNIMPLEMENTED,
+                                    "Cannot synthesize warmup data for the type of input " + input_name);
+      }
+
+      for (size_t r = 0; r < request_count; ++r) {
+        auto shape = tensor_info.GetShape();
+        size_t element_count = 1;
+        for (size_t d = 0; d < shape.size(); ++d) {
+          if (shape[d] < 0) {
+            shape[d] = d == 0 ? batch_sizes[r] : 1;
+          }
+          element_count *= static_cast<size_t>(shape[d]);
+        }
+
+        auto& tensor = (*requests[r].mutable_inputs())[input_name];
+        for (auto dim : shape) {
+          tensor.add_dims(dim);
+        }
+        tensor.set_data_type(data_type);
+        if (data_type == onnx::TensorProto_DataType_STRING) {
+          for (size_t e = 0; e < element_count; ++e) {
+            tensor.add_string_data("");
+          }
+        } else {
+          // raw_data lets the executor use the zeros in place
+          tensor.mutable_raw_data()->assign(element_count * element_size, '\0');
+        }
+      }
+    }
+  } catch (const Ort::Exception& e) {
+    return GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+  }
+
+  return protobufutil::Status::OK;
+}
+
+protobufutil::Status WarmupModel(ServerEnvironment* env,
+                                 const std::string& model_name,
+                                 const std::string& model_version,
+                                 const WarmupOptions& options) {
+  auto logger = env->GetAppLogger();
+  using clock = std::chrono::steady_clock;
+  auto milliseconds = [](clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  };
+
+  std::vector<PredictRequest> requests;
+  protobufutil::Status status;
+  if (!options.requests_path.empty()) {
+    status = ReadWarmupRequests(options.requests_path, requests);
+  } else if (!options.batch_sizes.empty()) {
+    // loads the model if it was only registered
+    const auto load_start = clock::now();
+    try {
+      auto model = env->GetModel(model_name, model_version);
+      logger->info("Warmup of model {} version {}: getting the model took {:.1f} ms", model_name, model_version,
+                   milliseconds(clock::now() - load_start));
+      status = SynthesizeWarmupRequests(model->session, options.batch_sizes, requests);
+    } catch (const Ort::Exception& e) {
+      status = GenerateProtobufStatus(e.GetOrtErrorCode(), e.what());
+    }
+  }
+  if (!status.ok()) {
+    logger->error("Warmup of model {} version {} failed: {}", model_name, model_version, status.error_message());
+    return status;
+  }
+
+  const auto warmup_start = clock::now();
+  for (int iteration = 0; iteration < options.iterations; ++iteration) {
+    for (size_t i = 0; i < requests.size(); ++i) {
+      Executor executor(env, "warmup");
+      std::vector<std::string> output_names;
+      std::vector<Ort::Value> outputs;
+
+      const auto start = clock::now();
+      status = executor.Run(model_name, model_version, requests[i], output_names, outputs);
+      const auto duration = milliseconds(clock::now() - start);
+      if (!status.ok()) {
+        logger->error("Warmup of model {} version {}: request {} of {} failed after {:.1f} ms: {}", model_name,
+                      model_version, i + 1, requests.size(), duration, status.error_message());
+        return status;
+      }
+
+      logger->info("Warmup of model {} version {}: request {} of {} (iteration {}) took {:.1f} ms", model_name,
+                   model_version, i + 1, requests.size(), iteration + 1, duration);
+    }
+  }
+
+  if (!requests.empty()) {
+    logger->info("Warmed up model {} version {} in {:.1f} ms", model_name, model_version,
+                 milliseconds(clock::now() - warmup_start));
+  }
+  return protobufutil::Status::OK;
+}
+
+}  // namespace server
+}  // namespace onnxruntime
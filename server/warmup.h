@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <google/protobuf/stubs/status.h>
+
+#include "onnxruntime_cxx_api.h"
+#include "environment.h"
+#include "predict.pb.h"
+
+namespace onnxruntime {
+namespace server {
+
+struct WarmupOptions {
+  // File with the sample requests, one JSON predict request per line. Empty to synthesize the requests.
+  std::string requests_path;
+  // Batch sizes of the requests synthesized from the inputs of the model when there is no requests file.
+  // Empty to not warm up the model without a requests file.
+  std::vector<int64_t> batch_sizes;
+  // Number of times the requests are run
+  int iterations = 1;
+};
+
+// Runs the warmup requests of a model, so that arena growth, kernel algorithm searches, engine builds and memory
+// pattern creation happen before the server takes traffic rather than on the first requests. The duration of each
+// request is logged. Stops at the first request that fails and returns its error.
+google::protobuf::util::Status WarmupModel(ServerEnvironment* env,
+                                           const std::string& model_name,
+                                           const std::string& model_version,
+                                           const WarmupOptions& options);
+
+// Reads the requests of a file with one JSON predict request per line, in the format of the HTTP predict body.
+// Empty lines are skipped.
+google::protobuf::util::Status ReadWarmupRequests(const std::string& path,
+                                                  /* out */ std::vector<onnxruntime::server::PredictRequest>& requests);
+
+// Synthesizes a request for each batch size, with zeros (or empty strings) for all the inputs of the session.
+// Dynamic dimensions are the batch size for the first dimension and 1 for the others. A single request is returned
+// if no input has a dynamic first dimension.
+google::protobuf::util::Status SynthesizeWarmupRequests(Ort::Session& session,
+                                                        const std::vector<int64_t>& batch_sizes,
+                                                        /* out */ std::vector<onnxruntime::server::PredictRequest>& requests);
+
+}  // namespace server
+}  // namespace onnxruntime
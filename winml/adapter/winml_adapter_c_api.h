@@ -27,6 +27,7 @@ struct IMLOperatorRegistry;
 enum OrtProfilerEventCategory {
   SESSION_EVENT = 0,
   NODE_EVENT,
+  MEMORY_EVENT,
   EVENT_CATEGORY_MAX
 };
 
@@ -91,16 +91,29 @@ ComPtr<ID3D11Texture2D> ImageConverter::CreateTextureFromUnsupportedColorFormat(
     wgdx::DirectXPixelFormat newFormat) {
   assert(videoFrame != nullptr);
 
-  // Make sure we create the new video frame on the same device. We don't want the VideoFrame pipeline to implicitly share the texture between
-  // 2 devices since we will need to do it ourselves anyway.
-  auto device = _winmli::GetDeviceFromDirect3DSurface(videoFrame.Direct3DSurface());
+  // Reuse the video frame converted by the previous call if it has the same format, size and device, so neither its
+  // texture nor the texture shared with D3D12 that is cached on it are created again for every frame.
+  bool createNewVideoFrame = converted_surface_video_frame_ == nullptr;
+  if (!createNewVideoFrame) {
+    auto description = converted_surface_video_frame_.Direct3DSurface().Description();
+    createNewVideoFrame = description.Format != newFormat ||
+                          static_cast<uint32_t>(description.Width) != outputBounds.Width ||
+                          static_cast<uint32_t>(description.Height) != outputBounds.Height ||
+                          !_winmli::VideoFramesHaveSameDevice(videoFrame, converted_surface_video_frame_);
+  }
+
+  if (createNewVideoFrame) {
+    // Make sure we create the new video frame on the same device. We don't want the VideoFrame pipeline to implicitly share the texture between
+    // 2 devices since we will need to do it ourselves anyway.
+    auto device = _winmli::GetDeviceFromDirect3DSurface(videoFrame.Direct3DSurface());
 
-  auto spNewVideoFrame = wm::VideoFrame::CreateAsDirect3D11SurfaceBacked(newFormat, outputBounds.Width, outputBounds.Height, device);
-  videoFrame.as<wm::IVideoFrame2>().CopyToAsync(spNewVideoFrame, inputBounds, outputBounds).get();
+    converted_surface_video_frame_ = wm::VideoFrame::CreateAsDirect3D11SurfaceBacked(newFormat, outputBounds.Width, outputBounds.Height, device);
+  }
+  videoFrame.as<wm::IVideoFrame2>().CopyToAsync(converted_surface_video_frame_, inputBounds, outputBounds).get();
   
   using namespace Windows::Graphics::DirectX::Direct3D11;
 
-  auto spDxgiInterfaceAccess = spNewVideoFrame.Direct3DSurface().as<IDirect3DDxgiInterfaceAccess>();
+  auto spDxgiInterfaceAccess = converted_surface_video_frame_.Direct3DSurface().as<IDirect3DDxgiInterfaceAccess>();
   ComPtr<ID3D11Texture2D> d3d11Texture;
   WINML_THROW_IF_FAILED(spDxgiInterfaceAccess->GetInterface(IID_PPV_ARGS(&d3d11Texture)));
 
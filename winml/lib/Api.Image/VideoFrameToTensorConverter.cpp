@@ -487,11 +487,18 @@ void VideoFrameToTensorConverter::ConvertSoftwareBitmapToGPUTensor(
                                            ? videoFrame.SoftwareBitmap().BitmapPixelFormat()
                                            : _winmli::GetBitmapPixelFormatFromChannelType(tensorDesc.channelType);
 
-    convertedSoftwareBitmap = wgi::SoftwareBitmap(newPixelFormat, static_cast<int32_t>(tensorDesc.sizes[3]), static_cast<int32_t>(tensorDesc.sizes[2]));
-    wm::VideoFrame convertedVideoFrame = wm::VideoFrame::CreateWithSoftwareBitmap(convertedSoftwareBitmap);
-    videoFrame.as<wm::IVideoFrame2>().CopyToAsync(convertedVideoFrame, inputBounds, scaledBounds).get();
+    // Reuse the scaled video frame of the previous call if it has the same format and size
+    wgi::SoftwareBitmap cachedSoftwareBitmap = converted_video_frame_ != nullptr ? converted_video_frame_.SoftwareBitmap() : nullptr;
+    if (cachedSoftwareBitmap == nullptr ||
+        cachedSoftwareBitmap.BitmapPixelFormat() != newPixelFormat ||
+        cachedSoftwareBitmap.PixelWidth() != static_cast<int32_t>(tensorDesc.sizes[3]) ||
+        cachedSoftwareBitmap.PixelHeight() != static_cast<int32_t>(tensorDesc.sizes[2])) {
+      converted_video_frame_ = wm::VideoFrame::CreateWithSoftwareBitmap(
+          wgi::SoftwareBitmap(newPixelFormat, static_cast<int32_t>(tensorDesc.sizes[3]), static_cast<int32_t>(tensorDesc.sizes[2])));
+    }
+    videoFrame.as<wm::IVideoFrame2>().CopyToAsync(converted_video_frame_, inputBounds, scaledBounds).get();
 
-    convertedSoftwareBitmap = convertedVideoFrame.SoftwareBitmap();
+    convertedSoftwareBitmap = converted_video_frame_.SoftwareBitmap();
   } else if (!_winmli::SoftwareBitmapFormatSupported(videoFrame.SoftwareBitmap())) {
     convertedSoftwareBitmap = wgi::SoftwareBitmap::Convert(videoFrame.SoftwareBitmap(), _winmli::GetBitmapPixelFormatFromChannelType(tensorDesc.channelType));
   } else {
@@ -517,6 +524,11 @@ void VideoFrameToTensorConverter::ConvertSoftwareBitmapToGPUTensor(
         IID_PPV_ARGS(&upload_heap_)));
   }
 
+  // The upload heap is reused, so the copy out of it queued by the previous call must be complete before it is written
+  if (fence_completion_value_ > 0) {
+    device_cache.WaitForFenceValue(fence_completion_value_);
+  }
+
   void* pCPUTensorBuffer = nullptr;
   WINML_THROW_IF_FAILED(upload_heap_->Map(0, &CD3DX12_RANGE(0, 0), &pCPUTensorBuffer));
 
@@ -537,6 +549,7 @@ void VideoFrameToTensorConverter::ConvertSoftwareBitmapToGPUTensor(
   WINML_THROW_IF_FAILED(command_list_->Close());
   ID3D12CommandList* ppCommandLists[] = {command_list_.Get()};
   device_cache.GetCommandQueue()->ExecuteCommandLists(_countof(ppCommandLists), ppCommandLists);
+  fence_completion_value_ = device_cache.QueueFenceToD3D12();
 }
 
 void VideoFrameToTensorConverter::ConvertBuffersToBatchedGPUTensor(
@@ -555,6 +568,11 @@ void VideoFrameToTensorConverter::ConvertBuffersToBatchedGPUTensor(
         IID_PPV_ARGS(&upload_heap_)));
   }
 
+  // The upload heap is reused, so the copy out of it queued by the previous call must be complete before it is written
+  if (fence_completion_value_ > 0) {
+    device_cache.WaitForFenceValue(fence_completion_value_);
+  }
+
   byte* gpu_buffer = nullptr;
   WINML_THROW_IF_FAILED(upload_heap_->Map(0, &CD3DX12_RANGE(0, 0), reinterpret_cast<void**>(&gpu_buffer)));
   auto gpu_buffer_span = gsl::span<byte>(gpu_buffer, buffer_size_in_bytes);
@@ -581,6 +599,7 @@ void VideoFrameToTensorConverter::ConvertBuffersToBatchedGPUTensor(
   WINML_THROW_IF_FAILED(command_list_->Close());
   ID3D12CommandList* lists[] = {command_list_.Get()};
   device_cache.GetCommandQueue()->ExecuteCommandLists(_countof(lists), lists);
+  fence_completion_value_ = device_cache.QueueFenceToD3D12();
 }
 
 D3D12_UNORDERED_ACCESS_VIEW_DESC VideoFrameToTensorConverter::CreateUAVDescription(
@@ -36,7 +36,7 @@ struct ConstantBufferCS {
 
 class ImageConverter {
  public:
-  ImageConverter() : converted_video_frame_(nullptr) {}
+  ImageConverter() : converted_video_frame_(nullptr), converted_surface_video_frame_(nullptr) {}
   void ResetAllocator();
 
  protected:
@@ -56,6 +56,8 @@ class ImageConverter {
 
   Microsoft::WRL::ComPtr<ID3D11Texture2D> D3D11_cached_texture_;
   wm::VideoFrame converted_video_frame_;
+  // the D3D11 surface backed video frame of CreateTextureFromUnsupportedColorFormat
+  wm::VideoFrame converted_surface_video_frame_;
   CWinMLLock lock_;
 
   void SyncD3D11ToD3D12(_In_ _winml::D3DDeviceCache& device_cache, _In_ ID3D11Texture2D* D3D11_texture);